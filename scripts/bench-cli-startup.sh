@@ -0,0 +1,41 @@
+#!/usr/bin/env bash
+# bench-cli-startup.sh
+#
+# Time how long the thin CLI commands take to start and exit. None of them
+# loads a model, so none should pay for ggml backend discovery or engine
+# initialization; a regression here shows up as tens of milliseconds per
+# `recmeet --status` poll from the tray or a shell prompt.
+#
+# Usage:
+#   scripts/bench-cli-startup.sh [recmeet-binary] [runs]
+#
+# Defaults to build/recmeet and 20 runs. Prints mean and min wall time per
+# command in milliseconds. --status and --stop fail fast when no daemon is
+# running; their exit status is ignored, only the time is measured.
+
+set -u -o pipefail
+
+BIN="${1:-build/recmeet}"
+RUNS="${2:-20}"
+[ -x "$BIN" ] || { echo "usage: $(basename "$0") [recmeet-binary] [runs]" >&2; exit 2; }
+
+time_cmd() {
+    local label="$1"; shift
+    local total=0 min="" t0 t1 ms i
+    for ((i = 0; i < RUNS; i++)); do
+        t0=$(date +%s%N)
+        "$@" >/dev/null 2>&1
+        t1=$(date +%s%N)
+        ms=$(( (t1 - t0) / 1000 ))
+        total=$(( total + ms ))
+        if [ -z "$min" ] || [ "$ms" -lt "$min" ]; then min=$ms; fi
+    done
+    printf '  %-16s mean=%6.1f ms  min=%6.1f ms\n' "$label" \
+        "$(echo "scale=1; $total / $RUNS / 1000" | bc)" \
+        "$(echo "scale=1; $min / 1000" | bc)"
+}
+
+echo "=== bench-cli-startup: $BIN ($RUNS runs) ==="
+time_cmd "--version"      "$BIN" --version
+time_cmd "--status"       "$BIN" --status
+time_cmd "--list-sources" "$BIN" --list-sources
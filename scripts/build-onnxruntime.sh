@@ -13,6 +13,12 @@
 #   ./scripts/build-onnxruntime.sh              # defaults
 #   ORT_VERSION=1.23.2 ./scripts/build-onnxruntime.sh
 #   PREFIX=/opt/ort ./scripts/build-onnxruntime.sh
+#   ORT_USE_CUDA=1 CUDA_HOME=/opt/cuda ./scripts/build-onnxruntime.sh
+#
+# Execution providers: XNNPACK is built in unless ORT_USE_XNNPACK=0 (used by
+# diarization.provider auto on ARM and pre-AVX2 x86). ORT_USE_CUDA=1 adds the
+# CUDA EP as libonnxruntime_providers_cuda.so, which recmeet picks up at run
+# time when an NVIDIA device is present and ignores otherwise.
 
 set -euo pipefail
 
@@ -21,11 +27,23 @@ ORT_TAG="v${ORT_VERSION}"
 BUILD_DIR="${BUILD_DIR:-/tmp/onnxruntime-build}"
 PREFIX="${PREFIX:-$(cd "$(dirname "$0")/.." && pwd)/vendor/onnxruntime-local}"
 JOBS="${JOBS:-$(nproc)}"
+ORT_USE_XNNPACK="${ORT_USE_XNNPACK:-1}"
+ORT_USE_CUDA="${ORT_USE_CUDA:-0}"
+
+EP_ARGS=()
+if [ "${ORT_USE_XNNPACK}" = "1" ]; then
+    EP_ARGS+=(--use_xnnpack)
+fi
+if [ "${ORT_USE_CUDA}" = "1" ]; then
+    CUDA_HOME="${CUDA_HOME:-/usr/local/cuda}"
+    EP_ARGS+=(--use_cuda --cuda_home "${CUDA_HOME}" --cudnn_home "${CUDNN_HOME:-${CUDA_HOME}}")
+fi
 
 echo "=== Building onnxruntime ${ORT_VERSION} ==="
 echo "  Build dir:       ${BUILD_DIR}"
 echo "  Install prefix:  ${PREFIX}"
 echo "  Parallel jobs:   ${JOBS}"
+echo "  Providers:       CPU${EP_ARGS[*]:+ (${EP_ARGS[*]})}"
 echo "  Compiler:        $(c++ --version | head -1)"
 echo ""
 
@@ -50,8 +68,8 @@ if [ -f "${SEMVER_H}" ] && ! grep -q '<cstdint>' "${SEMVER_H}"; then
 fi
 
 # Build with the official build.sh — handles protobuf bundling, abseil, etc.
-# CPU only, shared lib, Release. No --minimal_build (requires ORT format models;
-# sherpa-onnx uses standard ONNX format).
+# Shared lib, Release, plus the providers selected above. No --minimal_build
+# (requires ORT format models; sherpa-onnx uses standard ONNX format).
 echo "--- Building (this takes 15-30 minutes) ---"
 ./build.sh \
     --config Release \
@@ -59,6 +77,7 @@ echo "--- Building (this takes 15-30 minutes) ---"
     --parallel "${JOBS}" \
     --skip_tests \
     --compile_no_warning_as_error \
+    ${EP_ARGS[@]+"${EP_ARGS[@]}"} \
     --cmake_extra_defines \
         CMAKE_INSTALL_PREFIX="${PREFIX}" \
         onnxruntime_BUILD_UNIT_TESTS=OFF \
@@ -0,0 +1,138 @@
+#!/usr/bin/env bash
+# replay-bench.sh
+#
+# Replay a recorded meeting through the daemon's full recording and
+# postprocessing path, with no audio device, and collect repeatable latency
+# and throughput numbers. The WAVs are fed through replay: sources
+# (src/capture_replay.h) on a jitter profile's schedule; the recording ends
+# by itself when they are delivered.
+#
+# Usage:
+#   scripts/replay-bench.sh [-s SPEED] [-j JITTER] [-m MONITOR_WAV] [-n RUNS]
+#                           [-o NAME] MIC_WAV [-- recmeet args...]
+#
+#   -s SPEED    replay pace; 4 = four times real time (default: 1)
+#   -j JITTER   steady, pipewire, bluetooth, or a profile a real device
+#               recorded with RECMEET_RECORD_JITTER=1 (default: pipewire)
+#   -m WAV      also replay WAV as the monitor (remote speakers)
+#   -n RUNS     repeat the run (default: 1)
+#   -o NAME     results go to bench-results/replay-<NAME>/ (default: date)
+#
+# 16 kHz WAVs only. A recmeet-daemon must be running; extra args after --
+# go to the recmeet client (e.g. --show-captions, --no-summary).
+#
+# Outputs (under bench-results/replay-<NAME>/):
+#   run-<i>.log        client stdout/stderr
+#   run-<i>.replay.json / run-<i>.perf.json   the meeting's reports
+#   summary.txt        key=value per run: stop_to_note_s, replay lateness,
+#                      ring drops, caption latency, per-stage RTF
+
+set -u -o pipefail
+
+PROG="$(basename "$0")"
+usage() { sed -n '11,19p' "$0" | sed 's/^# \{0,1\}//' >&2; exit 2; }
+
+SPEED=1
+JITTER=pipewire
+MONITOR=""
+RUNS=1
+NAME="$(date +%Y%m%d-%H%M%S)"
+while getopts "s:j:m:n:o:h" opt; do
+    case "$opt" in
+        s) SPEED="$OPTARG" ;;
+        j) JITTER="$OPTARG" ;;
+        m) MONITOR="$OPTARG" ;;
+        n) RUNS="$OPTARG" ;;
+        o) NAME="$OPTARG" ;;
+        *) usage ;;
+    esac
+done
+shift $((OPTIND - 1))
+MIC="${1:-}"
+[ -n "$MIC" ] || usage
+shift
+[ "${1:-}" = "--" ] && shift
+
+RECMEET="${RECMEET:-recmeet}"
+command -v "$RECMEET" >/dev/null || { echo "$PROG: $RECMEET not found" >&2; exit 2; }
+command -v python3 >/dev/null || { echo "$PROG: python3 is needed to read the reports" >&2; exit 2; }
+
+abspath() { python3 -c 'import os,sys; print(os.path.abspath(sys.argv[1]))' "$1"; }
+# A jitter profile file is passed by absolute path; a built-in by name.
+[ -f "$JITTER" ] && JITTER="$(abspath "$JITTER")"
+QUERY="?speed=$SPEED&jitter=$JITTER"
+
+ARGS=(--daemon --source "replay:$(abspath "$MIC")$QUERY")
+if [ -n "$MONITOR" ]; then
+    ARGS+=(--monitor "replay:$(abspath "$MONITOR")$QUERY")
+else
+    ARGS+=(--mic-only)
+fi
+
+OUTDIR="$(pwd)/bench-results/replay-$NAME"
+mkdir -p "$OUTDIR"
+: > "$OUTDIR/summary.txt"
+
+echo "=== replay-bench: $NAME ==="
+echo "    mic=$MIC monitor=${MONITOR:-none} speed=$SPEED jitter=$JITTER runs=$RUNS"
+echo "    output=$OUTDIR"
+
+EXIT=0
+for i in $(seq 1 "$RUNS"); do
+    LOG="$OUTDIR/run-$i.log"
+    "$RECMEET" "${ARGS[@]}" "$@" > "$LOG" 2>&1
+    rc=$?
+    DONE_MS=$(date +%s%3N)
+    [ "$rc" -eq 0 ] || { echo "run $i: recmeet exited $rc (see $LOG)" >&2; EXIT=$rc; continue; }
+
+    DIR="$(sed -n 's/^Output: //p' "$LOG" | tail -n 1)"
+    [ -d "$DIR" ] || { echo "run $i: no output directory in $LOG" >&2; EXIT=1; continue; }
+    # The daemon files perf_<ts>.json as the job finishes; give it a moment.
+    for _ in $(seq 1 50); do
+        ls "$DIR"/perf_*.json >/dev/null 2>&1 && break
+        sleep 0.1
+    done
+    cp "$DIR"/replay_*.json "$OUTDIR/run-$i.replay.json" 2>/dev/null
+    cp "$DIR"/perf_*.json "$OUTDIR/run-$i.perf.json" 2>/dev/null
+
+    python3 - "$i" "$DONE_MS" "$OUTDIR/run-$i.replay.json" "$OUTDIR/run-$i.perf.json" \
+        >> "$OUTDIR/summary.txt" <<'PY'
+import json, sys
+run, done_ms, replay_path, perf_path = sys.argv[1], int(sys.argv[2]), sys.argv[3], sys.argv[4]
+def load(path):
+    try:
+        with open(path) as f:
+            return json.load(f)
+    except (OSError, ValueError):
+        return {}
+replay, perf = load(replay_path), load(perf_path)
+out = [f"run={run}"]
+if "stopped_unix_ms" in replay:
+    out.append(f"stop_to_note_s={(done_ms - replay['stopped_unix_ms']) / 1000:.2f}")
+for label in ("mic", "monitor"):
+    if f"{label}.chunks" not in replay:
+        continue
+    for key in ("achieved_speed", "late_chunks", "late_p99_us", "late_max_us", "dropped_frames"):
+        out.append(f"{label}_{key}={replay[f'{label}.{key}']}")
+for kind in ("partial", "final"):
+    if replay.get(f"caption_{kind}_count"):
+        out.append(f"caption_{kind}_p50_ms={replay[f'caption_{kind}_p50_ms']}")
+        out.append(f"caption_{kind}_p95_ms={replay[f'caption_{kind}_p95_ms']}")
+if perf:
+    out.append(f"postprocess_wall_s={perf.get('wall_sec', 0):.1f}")
+    for n in range(int(perf.get("stages", 0))):
+        stage, index = perf.get(f"p{n}_stage", ""), perf.get(f"p{n}_index", -1)
+        if index >= 0 or stage.startswith("engine."):
+            continue
+        out.append(f"{stage}_wall_s={perf.get(f'p{n}_wall_sec', 0):.2f}")
+        if perf.get(f"p{n}_rtf"):
+            out.append(f"{stage}_rtf={perf[f'p{n}_rtf']:.3f}")
+print(" ".join(out))
+PY
+    echo "run $i: $(tail -n 1 "$OUTDIR/summary.txt")"
+done
+
+echo
+echo "--- $NAME summary ---"
+cat "$OUTDIR/summary.txt"
+exit "$EXIT"
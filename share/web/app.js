@@ -101,6 +101,10 @@ async function relabelSpeaker(meetingDir, clusterId, newLabel, updateProfile = t
   return result;
 }
 
+async function rerenderNote(meetingDir) {
+  return await api('POST', `/api/meetings/${encodeURIComponent(meetingDir)}/rerender`);
+}
+
 async function removeEmbedding(name, index) {
   return await api('POST', `/api/speakers/${encodeURIComponent(name)}/remove-embedding`, { index });
 }
@@ -115,6 +119,63 @@ async function batchReidentify() {
   return await api('POST', '/api/speakers/batch-reidentify');
 }
 
+async function fetchJob(jobId) {
+  return await api('GET', `/api/jobs/${encodeURIComponent(jobId)}`);
+}
+
+async function fetchSpeakerSegments(dirName, clusterId) {
+  return await api('GET', `/api/meetings/${encodeURIComponent(dirName)}/speakers/${clusterId}/segments`);
+}
+
+// ---------------------------------------------------------------------------
+// Speaker audition
+// ---------------------------------------------------------------------------
+
+// One player for the page: plays a speaker's segments back to back,
+// seeking over everyone else. The browser fetches only the ranges it plays.
+const auditionAudio = new Audio();
+let auditionStop = null;
+
+async function auditionSpeaker(dirName, clusterId, btn) {
+  const wasPlaying = auditionStop && auditionStop.btn === btn;
+  if (auditionStop) auditionStop();
+  if (wasPlaying) return;
+
+  let segs;
+  try {
+    segs = (await fetchSpeakerSegments(dirName, clusterId)).segments;
+  } catch (e) {
+    toast('Cannot play speaker: ' + e.message);
+    return;
+  }
+  if (segs.length === 0) { toast('No segments for this speaker'); return; }
+
+  const audio = auditionAudio;
+  let i = 0;
+  const onTime = () => {
+    if (audio.currentTime < segs[i].end) return;
+    if (++i >= segs.length) { stop(); return; }
+    audio.currentTime = segs[i].start;
+  };
+  const stop = () => {
+    audio.pause();
+    audio.removeEventListener('timeupdate', onTime);
+    btn.textContent = 'Play';
+    auditionStop = null;
+  };
+  stop.btn = btn;
+  auditionStop = stop;
+  audio.addEventListener('timeupdate', onTime);
+  audio.src = `/api/meetings/${encodeURIComponent(dirName)}/audio#t=${segs[0].start}`;
+  btn.textContent = 'Stop';
+  try {
+    await audio.play();
+  } catch (e) {
+    stop();
+    toast('Playback failed: ' + e.message);
+  }
+}
+
 // ---------------------------------------------------------------------------
 // Toast
 // ---------------------------------------------------------------------------
@@ -250,7 +311,13 @@ async function handleBatchReidentify() {
     'Re-identify speakers in all past meetings using the current speaker database. Manually corrected labels will be preserved.');
   if (!ok) return;
   try {
-    const result = await batchReidentify();
+    let result = await batchReidentify();
+    toast('Re-identifying speakers in past meetings...');
+    while (result.state === 'running') {
+      await new Promise(resolve => setTimeout(resolve, 1000));
+      result = await fetchJob(result.job_id);
+    }
+    if (result.state === 'failed') throw new Error(result.error || 'job failed');
     toast(`Updated ${result.meetings_updated} of ${result.meetings_scanned} meeting(s)`);
     // Invalidate all cached meeting speakers
     for (const key of Object.keys(meetingSpeakerCache)) {
@@ -393,9 +460,10 @@ function renderMeetings() {
         onclick: () => showReprocessDialog(mtg.name)
       }, 'Reprocess'),
       html('span', { className: 'card-date' },
-        mtg.has_speakers
+        (mtg.duration_sec > 0 ? formatDuration(mtg.duration_sec) + ' · ' : '') +
+        (mtg.has_speakers
           ? `${mtg.speaker_count} speaker(s)`
-          : 'No speaker data'
+          : 'No speaker data')
       )
     );
     const card = html('div', { className: 'card', id: `meeting-${mtg.name}` },
@@ -450,6 +518,12 @@ async function loadMeetingSpeakers(dirName, container) {
       // Duration
       row.appendChild(html('span', { className: 'speaker-duration' }, formatDuration(spk.duration_sec)));
 
+      const playBtn = html('button', {
+        className: 'btn btn-sm',
+        onclick: () => auditionSpeaker(dirName, spk.cluster_id, playBtn)
+      }, 'Play');
+      row.appendChild(playBtn);
+
       // Confidence badge
       if (spk.confidence > 0) {
         const confText = (spk.confidence * 100).toFixed(0) + '%';
@@ -534,6 +608,7 @@ function showReprocessDialog(dirName) {
             try {
               const result = await reprocessMeeting(dirName, num);
               toast(`Reprocessing started (job #${result.job_id})`);
+              watchSummary(result.job_id, dirName);
             } catch (e) {
               toast('Reprocess failed: ' + e.message);
             }
@@ -546,6 +621,49 @@ function showReprocessDialog(dirName) {
   input.focus();
 }
 
+// Show the job's summary as the daemon writes it. The dialog opens with the
+// first piece of text, so a job run without a summary shows nothing.
+function watchSummary(jobId, dirName) {
+  const source = new EventSource(API + '/api/summary/stream');
+  let overlay = null;
+  let heading = null;
+  let text = null;
+  const close = () => {
+    source.close();
+    if (overlay) overlay.remove();
+  };
+  const forJob = (ev) => {
+    const data = JSON.parse(ev.data);
+    return !jobId || data.job_id === jobId ? data : null;
+  };
+  source.addEventListener('delta', (ev) => {
+    const data = forJob(ev);
+    if (!data) return;
+    if (!overlay) {
+      heading = html('h3', null, `Summarizing "${dirName}"...`);
+      text = html('pre', { className: 'live-summary' });
+      overlay = html('div', { className: 'overlay' },
+        html('div', { className: 'dialog dialog-wide' },
+          heading,
+          text,
+          html('div', { className: 'dialog-actions' },
+            html('button', { className: 'btn', onclick: close }, 'Close')
+          )
+        )
+      );
+      document.body.appendChild(overlay);
+    }
+    text.textContent += data.text;
+    text.scrollTop = text.scrollHeight;
+  });
+  source.addEventListener('complete', (ev) => {
+    if (!forJob(ev)) return;
+    source.close();
+    if (heading) heading.textContent = `Summary of "${dirName}"`;
+  });
+  source.onerror = () => source.close();
+}
+
 function showRelabelForm(row, btn, dirName, spk, container) {
   btn.style.display = 'none';
   const input = html('input', {
@@ -566,7 +684,14 @@ function showRelabelForm(row, btn, dirName, spk, container) {
         saveBtn.disabled = true;
         saveBtn.textContent = '...';
         await relabelSpeaker(dirName, spk.cluster_id, name, updateChk.checked);
-        toast(`Relabeled to "${name}"`);
+        // The note follows the new label; meetings without a note stage
+        // keep the old one until they are reprocessed.
+        try {
+          await rerenderNote(dirName);
+          toast(`Relabeled to "${name}"; note updated`);
+        } catch (e) {
+          toast(`Relabeled to "${name}"; note not updated: ${e.message}`);
+        }
         await fetchSpeakers();
         await loadMeetingSpeakers(dirName, container);
       } catch (e) {
@@ -0,0 +1,125 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "action_ledger.h"
+#include "ipc_protocol.h"
+
+#include <fstream>
+#include <regex>
+
+#include <sys/stat.h>
+
+namespace recmeet {
+
+namespace {
+
+constexpr int LEDGER_VERSION = 1;
+
+std::string trim(const std::string& s) {
+    auto start = s.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) return "";
+    auto end = s.find_last_not_of(" \t\r\n");
+    return s.substr(start, end - start + 1);
+}
+
+// Flat-object parse via the IPC parser, as meeting_index.cpp does.
+bool parse_flat(const std::string& line, JsonMap& out) {
+    IpcMessage msg;
+    if (!parse_ipc_message("{\"id\":0,\"result\":" + line + "}", msg) ||
+        msg.type != IpcMessageType::Response)
+        return false;
+    out = std::move(msg.response.result);
+    return true;
+}
+
+} // anonymous namespace
+
+fs::path action_ledger_path() { return data_dir() / "action_items.ndjson"; }
+
+// The patterns match assigneeRe, noneRe and dueRe in
+// tools/meetingdata/actionitems.go; keep them in step.
+bool parse_ledger_item(const std::string& line, LedgerItem& out) {
+    static const std::regex none_re(R"(^none\b)", std::regex::icase);
+    static const std::regex assignee_re(R"(^\*\*\[([^\]]+)\]\*\*\s*[-:]\s*(.*)$)");
+
+    out = LedgerItem{};
+    out.text = trim(line);
+    if (std::regex_search(out.text, none_re)) return false;
+    std::smatch m;
+    if (std::regex_match(out.text, m, assignee_re)) {
+        out.assignee = m[1];
+        out.text = m[2];
+    }
+    out.due = extract_due_date(out.text);
+    return true;
+}
+
+std::string extract_due_date(const std::string& text) {
+    static const std::regex due_re(
+        R"(\b(?:by|before|due(?:\s+(?:by|on))?:?)\s+()"
+        R"(\d{4}-\d{2}-\d{2})"
+        R"(|(?:jan|feb|mar|apr|may|jun|jul|aug|sep|oct|nov|dec)[a-z]*\.?\s+\d{1,2}(?:st|nd|rd|th)?)"
+        R"(|(?:mon|tues|wednes|thurs|fri|satur|sun)day)"
+        R"(|end of (?:day|week|month|quarter))"
+        R"(|eod|eow|tomorrow|next week)\b)",
+        std::regex::icase);
+    std::smatch m;
+    return std::regex_search(text, m, due_re) ? m[1].str() : std::string();
+}
+
+void update_action_ledger(const fs::path& ledger, const fs::path& note,
+                          const std::string& meeting_date,
+                          const std::vector<LedgerItem>& items) {
+    const std::string note_key = note.lexically_normal().string();
+
+    // Keep every other note's records; drop the whole file if it is of
+    // another version, as the Go side will rebuild it.
+    std::string body;
+    {
+        std::ifstream in(ledger);
+        std::string line;
+        JsonMap m;
+        bool current = std::getline(in, line) && parse_flat(line, m) &&
+                       m.count("version") &&
+                       json_val_as_int(m["version"]) == LEDGER_VERSION;
+        while (current && std::getline(in, line)) {
+            if (line.empty() || !parse_flat(line, m)) continue;
+            auto it = m.find("note");
+            if (it != m.end() && json_val_as_string(it->second) == note_key) continue;
+            body += line + "\n";
+        }
+    }
+
+    struct stat st{};
+    if (::stat(note.c_str(), &st) != 0)
+        throw RecmeetError("Cannot stat meeting note: " + note.string());
+
+    JsonMap head;
+    head["version"] = static_cast<int64_t>(LEDGER_VERSION);
+    std::string out = serialize_json_map(head) + "\n" + body;
+
+    JsonMap rec;
+    rec["kind"] = std::string("note");
+    rec["note"] = note_key;
+    rec["mtime"] = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    rec["size"] = static_cast<int64_t>(st.st_size);
+    rec["date"] = meeting_date;
+    out += serialize_json_map(rec) + "\n";
+    for (const auto& item : items) {
+        JsonMap m;
+        m["kind"] = std::string("item");
+        m["note"] = note_key;
+        m["date"] = meeting_date;
+        m["text"] = item.text;
+        m["assignee"] = item.assignee;
+        m["due"] = item.due;
+        m["done"] = item.done;
+        out += serialize_json_map(m) + "\n";
+    }
+
+    std::error_code ec;
+    fs::create_directories(ledger.parent_path(), ec);
+    write_text_file_atomic(ledger, out);
+}
+
+} // namespace recmeet
@@ -0,0 +1,54 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Action-item ledger
+// ---------------------------------------------------------------------------
+//
+// `<data_dir>/action_items.ndjson` records every action item of every
+// meeting note, so the MCP server and agent (tools/meetingdata/ledger.go)
+// answer "what is open for Alice" from one file rather than by parsing
+// the whole archive. The first line is `{"version":1}`; then each note has
+// one `{"kind":"note","note":path,"mtime":ns,"size":bytes,"date":...}`
+// record followed by one `{"kind":"item",...}` record per item.
+//
+// write_meeting_note() replaces a note's records as it writes the note.
+// The Go side reconciles the rest by note mtime and size, so the ledger is
+// a cache: a lost or stale update only costs a re-parse of that note.
+
+/// One action item as the ledger records it.
+struct LedgerItem {
+    std::string text;
+    std::string assignee;  ///< from a leading `**[Name]** -`, or empty
+    std::string due;       ///< e.g. "March 18", "2026-03-20", "Friday", or empty
+    bool done = false;
+};
+
+/// `<data_dir>/action_items.ndjson`.
+fs::path action_ledger_path();
+
+/// An action item line as written under `## Action Items` (without the
+/// checkbox), split as the Go parser splits it. False for "None" lines.
+bool parse_ledger_item(const std::string& line, LedgerItem& out);
+
+/// The due date an item's text mentions ("by March 18", "due 2026-03-20",
+/// "before Friday"), or empty.
+std::string extract_due_date(const std::string& text);
+
+/// Replace the records of `note` in `ledger` with `items`, stamped with the
+/// note's current mtime and size. Throws RecmeetError when the ledger
+/// cannot be written.
+void update_action_ledger(const fs::path& ledger, const fs::path& note,
+                          const std::string& meeting_date,
+                          const std::vector<LedgerItem>& items);
+
+} // namespace recmeet
@@ -0,0 +1,530 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "artifact_transfer.h"
+#include "ipc_client.h"
+#include "ipc_server.h"
+#include "log.h"
+#include "metrics.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace recmeet {
+
+namespace {
+
+constexpr size_t kMaxLine = 256;           // a request or header line
+constexpr int kIoTimeoutSec = 30;          // a peer that stops reading or writing
+constexpr int kIdleTimeoutSec = 60;        // between requests on one connection
+constexpr int kMaxStalledAttempts = 3;     // fetch_artifact() reconnects without progress
+
+MetricCounter& artifact_sent_metric() {
+    static MetricCounter& c = metrics().counter("recmeet_artifact_sent_bytes",
+                                                "Bytes sent on the artifact port.");
+    return c;
+}
+
+int64_t steady_sec() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void set_timeout(int fd, int optname, int sec) {
+    struct timeval tv{};
+    tv.tv_sec = sec;
+    setsockopt(fd, SOL_SOCKET, optname, &tv, sizeof(tv));
+}
+
+bool write_all(int fd, const char* data, size_t n) {
+    while (n > 0) {
+        ssize_t w = send(fd, data, n, MSG_NOSIGNAL);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        data += w;
+        n -= static_cast<size_t>(w);
+    }
+    return true;
+}
+
+bool write_all(int fd, const std::string& s) { return write_all(fd, s.data(), s.size()); }
+
+// Fill `buf` until it holds `n` bytes. False on EOF, error or timeout.
+bool read_until(int fd, std::string& buf, size_t n) {
+    char tmp[64 * 1024];
+    while (buf.size() < n) {
+        ssize_t r = recv(fd, tmp, std::min(sizeof(tmp), n - buf.size()), 0);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        buf.append(tmp, static_cast<size_t>(r));
+    }
+    return true;
+}
+
+// The next '\n'-terminated line, read a byte at a time so nothing after it
+// is consumed. False on EOF, error, timeout or a line over kMaxLine.
+bool read_line(int fd, std::string& line) {
+    line.clear();
+    for (;;) {
+        char c;
+        ssize_t r = recv(fd, &c, 1, 0);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        if (c == '\n') return true;
+        if (line.size() >= kMaxLine) return false;
+        line += c;
+    }
+}
+
+int64_t mtime_ns(const fs::path& path, std::error_code& ec) {
+    auto t = fs::last_write_time(path, ec);
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+std::string random_token() {
+    static const char* hex = "0123456789abcdef";
+    std::random_device rd;
+    std::string out;
+    for (int i = 0; i < 8; ++i) {
+        uint32_t v = rd();
+        for (int b = 0; b < 4; ++b, v >>= 8) {
+            out += hex[(v >> 4) & 0xf];
+            out += hex[v & 0xf];
+        }
+    }
+    return out;
+}
+
+// Whether canonical `path` lies inside canonical `root`.
+bool under_root(const fs::path& path, const fs::path& root) {
+    auto r = root.begin();
+    auto p = path.begin();
+    for (; r != root.end(); ++r, ++p) {
+        if (r->empty()) continue;  // the trailing "" of "dir/"
+        if (p == path.end() || *p != *r) return false;
+    }
+    return p != path.end();
+}
+
+bool parse_u64(const std::string& s, uint64_t& out) {
+    if (s.empty() || s.size() > 20 ||
+        !std::all_of(s.begin(), s.end(), [](char c) { return c >= '0' && c <= '9'; }))
+        return false;
+    errno = 0;
+    unsigned long long v = std::strtoull(s.c_str(), nullptr, 10);
+    if (errno == ERANGE) return false;
+    out = v;
+    return true;
+}
+
+int connect_tcp(const std::string& host, uint16_t port) {
+    struct addrinfo hints{}, *res = nullptr;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    const std::string port_str = std::to_string(port);
+    if (getaddrinfo(host.c_str(), port_str.c_str(), &hints, &res) != 0 || !res) return -1;
+    int fd = socket(res->ai_family, res->ai_socktype | SOCK_CLOEXEC, res->ai_protocol);
+    if (fd >= 0) {
+        set_timeout(fd, SO_SNDTIMEO, kIoTimeoutSec);
+        set_timeout(fd, SO_RCVTIMEO, kIoTimeoutSec);
+        if (::connect(fd, res->ai_addr, res->ai_addrlen) < 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(res);
+    return fd;
+}
+
+uint64_t size_or_zero(const fs::path& path) {
+    std::error_code ec;
+    const uint64_t n = fs::file_size(path, ec);
+    return ec ? 0 : n;
+}
+
+} // anonymous namespace
+
+std::string format_artifact_request(const ArtifactRequest& req) {
+    return "fetch " + req.token + " " + std::to_string(req.offset) + " " +
+           std::to_string(req.length);
+}
+
+bool parse_artifact_request(const std::string& line, ArtifactRequest& out) {
+    std::vector<std::string> parts;
+    size_t start = 0;
+    while (start <= line.size()) {
+        size_t end = line.find(' ', start);
+        if (end == std::string::npos) end = line.size();
+        parts.push_back(line.substr(start, end - start));
+        start = end + 1;
+    }
+    ArtifactRequest req;
+    if (parts.size() != 4 || parts[0] != "fetch" || parts[1].empty() ||
+        !parse_u64(parts[2], req.offset) || !parse_u64(parts[3], req.length))
+        return false;
+    req.token = parts[1];
+    out = req;
+    return true;
+}
+
+uint16_t artifact_port_for(uint16_t control_port) {
+    return control_port == 65535 ? 0 : static_cast<uint16_t>(control_port + 1);
+}
+
+// ---------------------------------------------------------------------------
+// ArtifactServer
+// ---------------------------------------------------------------------------
+
+ArtifactServer::ArtifactServer(RootsFn roots) : roots_(std::move(roots)) {}
+
+ArtifactServer::~ArtifactServer() {
+    stop();
+}
+
+bool ArtifactServer::start(const std::string& host, uint16_t port) {
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        log_error("artifacts: socket() failed: %s", strerror(errno));
+        return false;
+    }
+    int yes = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (host.empty() || host == "0.0.0.0") {
+        addr.sin_addr.s_addr = INADDR_ANY;
+    } else if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) {
+        struct addrinfo hints{}, *res = nullptr;
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        if (getaddrinfo(host.c_str(), nullptr, &hints, &res) != 0 || !res) {
+            log_error("artifacts: cannot resolve host: %s", host.c_str());
+            close(listen_fd_); listen_fd_ = -1;
+            return false;
+        }
+        addr.sin_addr = reinterpret_cast<struct sockaddr_in*>(res->ai_addr)->sin_addr;
+        freeaddrinfo(res);
+    }
+    if (bind(listen_fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listen_fd_, 8) < 0) {
+        log_error("artifacts: cannot listen on %s:%d: %s", host.c_str(), port, strerror(errno));
+        close(listen_fd_); listen_fd_ = -1;
+        return false;
+    }
+    socklen_t len = sizeof(addr);
+    getsockname(listen_fd_, reinterpret_cast<struct sockaddr*>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+
+    running_ = true;
+    accept_thread_ = std::thread([this] { accept_loop(); });
+    log_info("artifacts: listening on %s:%d", host.empty() ? "0.0.0.0" : host.c_str(), port_);
+    return true;
+}
+
+void ArtifactServer::stop() {
+    if (!running_.exchange(false)) return;
+    if (accept_thread_.joinable()) accept_thread_.join();
+    close(listen_fd_);
+    listen_fd_ = -1;
+
+    std::vector<Transfer> transfers;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        transfers.swap(transfers_);
+        for (auto& t : transfers) shutdown(t.fd, SHUT_RDWR);  // wakes a blocked send/recv
+    }
+    for (auto& t : transfers) {
+        t.thread.join();
+        close(t.fd);
+    }
+}
+
+void ArtifactServer::accept_loop() {
+    while (running_) {
+        struct pollfd pfd = {listen_fd_, POLLIN, 0};
+        if (poll(&pfd, 1, 200) <= 0) continue;  // re-checks running_
+        int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) continue;
+        reap_finished();
+
+        std::lock_guard<std::mutex> lock(mu_);
+        if (transfers_.size() >= static_cast<size_t>(ARTIFACT_MAX_TRANSFERS)) {
+            ++stats_.rejected;
+            set_timeout(fd, SO_SNDTIMEO, 1);
+            write_all(fd, "err busy\n");
+            close(fd);
+            continue;
+        }
+        int yes = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        set_timeout(fd, SO_SNDTIMEO, kIoTimeoutSec);
+        set_timeout(fd, SO_RCVTIMEO, kIdleTimeoutSec);
+        auto done = std::make_shared<std::atomic<bool>>(false);
+        transfers_.push_back({fd, std::thread([this, fd, done] {
+            serve(fd);
+            done->store(true);
+        }), done});
+    }
+}
+
+void ArtifactServer::reap_finished() {
+    std::vector<Transfer> finished;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = std::partition(transfers_.begin(), transfers_.end(),
+                                 [](const Transfer& t) { return !t.done->load(); });
+        std::move(it, transfers_.end(), std::back_inserter(finished));
+        transfers_.erase(it, transfers_.end());
+    }
+    for (auto& t : finished) {
+        t.thread.join();
+        close(t.fd);
+    }
+}
+
+bool ArtifactServer::grant(const fs::path& path, ArtifactGrant& out, std::string& error) {
+    std::error_code ec;
+    const fs::path file = fs::canonical(path, ec);
+    if (ec || !fs::is_regular_file(file, ec)) {
+        error = "no such file: " + path.string();
+        return false;
+    }
+    bool allowed = false;
+    for (const auto& root : roots_ ? roots_() : std::vector<fs::path>{}) {
+        if (root.empty()) continue;
+        const fs::path r = fs::weakly_canonical(root, ec);
+        if (!ec && under_root(file, r)) { allowed = true; break; }
+    }
+    if (!allowed) {
+        error = "not a meeting artifact: " + path.string();
+        return false;
+    }
+    Token t;
+    t.path = file;
+    t.size = fs::file_size(file, ec);
+    if (!ec) t.mtime_ns = mtime_ns(file, ec);
+    if (ec) {
+        error = "cannot stat " + path.string();
+        return false;
+    }
+    t.last_used = steady_sec();
+
+    out.token = random_token();
+    out.size = t.size;
+    out.version = std::to_string(t.size) + "-" + std::to_string(t.mtime_ns);
+    std::lock_guard<std::mutex> lock(mu_);
+    for (auto it = tokens_.begin(); it != tokens_.end();) {
+        if (t.last_used - it->second.last_used > ARTIFACT_TOKEN_TTL_SEC) it = tokens_.erase(it);
+        else ++it;
+    }
+    tokens_[out.token] = std::move(t);
+    return true;
+}
+
+bool ArtifactServer::lookup(const std::string& token, Token& out, std::string& error) {
+    const int64_t now = steady_sec();
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = tokens_.find(token);
+        if (it == tokens_.end() || now - it->second.last_used > ARTIFACT_TOKEN_TTL_SEC) {
+            error = "unknown token";
+            return false;
+        }
+        it->second.last_used = now;
+        out = it->second;
+    }
+    std::error_code ec;
+    const uint64_t size = fs::file_size(out.path, ec);
+    if (ec || size != out.size || mtime_ns(out.path, ec) != out.mtime_ns || ec) {
+        error = "changed";
+        return false;
+    }
+    return true;
+}
+
+ArtifactStats ArtifactServer::stats() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return stats_;
+}
+
+void ArtifactServer::serve(int fd) {
+    std::string line;
+    std::vector<char> chunk(ARTIFACT_CHUNK_BYTES);
+    while (running_ && read_line(fd, line)) {
+        ArtifactRequest req;
+        Token t;
+        std::string error;
+        if (!parse_artifact_request(line, req)) error = "bad request";
+        else if (lookup(req.token, t, error) && req.offset > t.size) error = "offset past end";
+        if (!error.empty()) {
+            write_all(fd, "err " + error + "\n");
+            return;
+        }
+        int file = ::open(t.path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0) {
+            write_all(fd, "err cannot open\n");
+            return;
+        }
+        const uint64_t left = t.size - req.offset;
+        uint64_t remaining = req.length == 0 ? left : std::min(req.length, left);
+        uint64_t offset = req.offset;
+        bool ok = write_all(fd, "ok " + std::to_string(t.size) + "\n");
+        uint64_t sent = 0;
+        while (ok && remaining > 0) {
+            const size_t want = static_cast<size_t>(std::min<uint64_t>(remaining, chunk.size()));
+            ssize_t n = pread(file, chunk.data(), want, static_cast<off_t>(offset));
+            if (n <= 0) { ok = false; break; }  // shrank: the client's retry sees "changed"
+            const uint32_t len = static_cast<uint32_t>(n);
+            const char prefix[4] = {static_cast<char>(len >> 24), static_cast<char>(len >> 16),
+                                    static_cast<char>(len >> 8), static_cast<char>(len)};
+            ok = write_all(fd, prefix, 4) && write_all(fd, chunk.data(), len);
+            offset += len;
+            remaining -= len;
+            sent += len;
+        }
+        ::close(file);
+        if (ok) ok = write_all(fd, std::string(4, '\0'));
+        artifact_sent_metric().add(sent);
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            stats_.bytes_sent += sent;
+            if (ok) ++stats_.transfers;
+        }
+        if (!ok) return;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// artifact.open / fetch_artifact()
+// ---------------------------------------------------------------------------
+
+void register_artifact_methods(IpcServer& server, ArtifactServer& artifacts) {
+    server.on("artifact.open", [&artifacts](const IpcRequest& req, IpcResponse& resp,
+                                            IpcError& err) {
+        auto it = req.params.find("path");
+        const std::string path = it == req.params.end() ? "" : json_val_as_string(it->second);
+        if (path.empty()) {
+            err.code = static_cast<int>(IpcErrorCode::InvalidParams);
+            err.message = "Missing 'path' parameter";
+            return false;
+        }
+        ArtifactGrant grant;
+        std::string error;
+        if (!artifacts.grant(path, grant, error)) {
+            err.code = static_cast<int>(IpcErrorCode::InvalidParams);
+            err.message = error;
+            return false;
+        }
+        resp.result["token"] = grant.token;
+        resp.result["size"] = static_cast<int64_t>(grant.size);
+        resp.result["version"] = grant.version;
+        resp.result["port"] = static_cast<int64_t>(artifacts.port());
+        return true;
+    });
+}
+
+uint64_t fetch_artifact(IpcClient& client, const std::string& path, const fs::path& dest,
+                        const std::function<void(uint64_t, uint64_t)>& progress) {
+    if (!client.connected() || !client.is_remote())
+        throw RecmeetError("artifact fetch needs a connected TCP client");
+    IpcResponse resp;
+    IpcError err;
+    if (!client.call("artifact.open", {{"path", path}}, resp, err))
+        throw RecmeetError("artifact.open: " + err.message);
+    const std::string token = json_val_as_string(resp.result["token"]);
+    const uint64_t size = static_cast<uint64_t>(json_val_as_int(resp.result["size"]));
+    const std::string version = json_val_as_string(resp.result["version"]);
+    const auto port = static_cast<uint16_t>(json_val_as_int(resp.result["port"]));
+    if (token.empty() || version.empty() || port == 0)
+        throw RecmeetError("artifact.open: incomplete answer");
+
+    // <dest>.<version>.part; a partial of another version cannot be resumed.
+    std::error_code ec;
+    const fs::path dir = dest.parent_path().empty() ? fs::path(".") : dest.parent_path();
+    const std::string base = dest.filename().string() + ".";
+    const fs::path part = dir / (base + version + ".part");
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (entry.path() != part && name.size() > base.size() + 5 &&
+            name.compare(0, base.size(), base) == 0 &&
+            name.compare(name.size() - 5, 5, ".part") == 0)
+            fs::remove(entry.path(), ec);
+    }
+    uint64_t have = size_or_zero(part);
+    if (have > size) {
+        fs::remove(part, ec);
+        have = 0;
+    }
+    std::ofstream out(part, std::ios::binary | std::ios::app);
+    if (!out) throw RecmeetError("cannot write " + part.string());
+    if (progress) progress(have, size);
+
+    int stalled = 0;
+    std::string fail_reason = "cannot reach the artifact port";
+    while (have < size && stalled < kMaxStalledAttempts) {
+        if (stalled > 0) std::this_thread::sleep_for(std::chrono::milliseconds(250 * stalled));
+        int fd = connect_tcp(client.address().host, port);
+        if (fd < 0) { ++stalled; continue; }
+        const uint64_t before = have;
+        bool refused = false;
+        std::string line, buf;
+        while (have < size) {
+            ArtifactRequest req{token, have, std::min(ARTIFACT_WINDOW_BYTES, size - have)};
+            if (!write_all(fd, format_artifact_request(req) + "\n") || !read_line(fd, line)) break;
+            if (line.compare(0, 4, "err ") == 0) {
+                fail_reason = line.substr(4);
+                refused = fail_reason != "busy";  // busy: all transfer slots taken, retry
+                break;
+            }
+            if (line.compare(0, 3, "ok ") != 0) break;
+            bool frames_ok = true;
+            for (;;) {
+                buf.clear();
+                if (!read_until(fd, buf, 4)) { frames_ok = false; break; }
+                const auto* p = reinterpret_cast<const unsigned char*>(buf.data());
+                const size_t len = (size_t(p[0]) << 24) | (size_t(p[1]) << 16) |
+                                   (size_t(p[2]) << 8) | size_t(p[3]);
+                if (len == 0) break;
+                buf.clear();
+                if (len > ARTIFACT_CHUNK_BYTES || !read_until(fd, buf, len)) {
+                    frames_ok = false;
+                    break;
+                }
+                out.write(buf.data(), static_cast<std::streamsize>(len));
+                have += len;
+                if (progress) progress(have, size);
+            }
+            if (!out.flush()) { close(fd); throw RecmeetError("cannot write " + part.string()); }
+            if (!frames_ok) break;
+        }
+        close(fd);
+        if (refused) break;
+        if (have == before) ++stalled;
+        else stalled = 0;
+        if (have < size) fail_reason = "connection lost";
+    }
+    out.close();
+    if (have < size)
+        throw RecmeetError("artifact " + path + ": " + fail_reason + " after " +
+                           std::to_string(have) + " of " + std::to_string(size) + " bytes");
+    fs::rename(part, dest, ec);
+    if (ec) throw RecmeetError("cannot rename " + part.string() + ": " + ec.message());
+    return size;
+}
+
+} // namespace recmeet
@@ -0,0 +1,165 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace recmeet {
+
+class IpcClient;
+class IpcServer;
+
+// ---------------------------------------------------------------------------
+// Artifact transfer (artifact.open + the artifact port)
+// ---------------------------------------------------------------------------
+//
+// A remote client that wants a meeting's transcript, note or audio should
+// not push megabytes through the control connection: IpcServer::run()
+// serves every client and every event from one thread, and a large
+// response sits in front of the captions and progress of everyone else.
+// Files travel on a side connection instead:
+//
+//   1. `artifact.open {"path":"..."}` on the control connection. The path
+//      must be a regular file under the output or note directory. The
+//      answer is a token, the file's size, its version (size and mtime)
+//      and the artifact port. Nothing is read on the poll thread.
+//   2. A plain TCP connection to the artifact port, one request line per
+//      range the client wants:
+//
+//        fetch <token> <offset> <length>\n     (length 0: to the end)
+//
+//      answered with `ok <size>\n` and the range as frames, a 4-byte
+//      big-endian length then that many bytes (ARTIFACT_CHUNK_BYTES at
+//      most), ended by a zero-length frame; or with `err <message>\n`,
+//      after which the server closes the connection. Further requests may
+//      follow on the same connection.
+//
+// Each connection is served on its own thread with blocking writes, so a
+// slow client is held back by its TCP window, not by the daemon's buffers,
+// and asks for the next window when it is ready for it. A dropped transfer
+// resumes with a request from the bytes it already has. A token stays
+// valid for ARTIFACT_TOKEN_TTL_SEC after its last use; it fails with
+// "changed" once the file no longer has the size and mtime it was granted
+// with, so a resumed transfer never splices two versions together.
+
+inline constexpr size_t ARTIFACT_CHUNK_BYTES = 256 * 1024;
+inline constexpr uint64_t ARTIFACT_WINDOW_BYTES = 4 * 1024 * 1024;  ///< fetch_artifact()'s request
+inline constexpr int ARTIFACT_TOKEN_TTL_SEC = 600;
+inline constexpr int ARTIFACT_MAX_TRANSFERS = 4;  ///< connections served at once
+
+/// What artifact.open grants.
+struct ArtifactGrant {
+    std::string token;
+    uint64_t size = 0;
+    std::string version;  ///< `<size>-<mtime ns>`: what a resume must match
+};
+
+/// A parsed `fetch` request line (without its '\n').
+struct ArtifactRequest {
+    std::string token;
+    uint64_t offset = 0;
+    uint64_t length = 0;  ///< 0: to the end
+};
+
+std::string format_artifact_request(const ArtifactRequest& req);
+
+/// False for anything that is not a well-formed `fetch` line.
+bool parse_artifact_request(const std::string& line, ArtifactRequest& out);
+
+/// The artifact port of a daemon listening on TCP `control_port`: the
+/// next port up.
+uint16_t artifact_port_for(uint16_t control_port);
+
+struct ArtifactStats {
+    uint64_t transfers = 0;   ///< fetch requests answered `ok`
+    uint64_t bytes_sent = 0;
+    uint64_t rejected = 0;    ///< connections refused over ARTIFACT_MAX_TRANSFERS
+};
+
+class ArtifactServer {
+public:
+    /// The directories artifact.open may grant files under, read at each
+    /// grant (the config can be reloaded).
+    using RootsFn = std::function<std::vector<fs::path>()>;
+
+    explicit ArtifactServer(RootsFn roots);
+    ~ArtifactServer();
+
+    ArtifactServer(const ArtifactServer&) = delete;
+    ArtifactServer& operator=(const ArtifactServer&) = delete;
+
+    /// Listen on `host`:`port` (0: any free port) and start accepting.
+    /// False with a logged error when the port cannot be bound.
+    bool start(const std::string& host, uint16_t port);
+
+    /// Stop accepting, end the transfers in flight and join their threads.
+    void stop();
+
+    /// The bound port, 0 before start().
+    uint16_t port() const { return port_; }
+
+    /// A token for `path`. False with `error` set when it is not a regular
+    /// file under one of the roots. Thread-safe.
+    bool grant(const fs::path& path, ArtifactGrant& out, std::string& error);
+
+    ArtifactStats stats() const;
+
+private:
+    struct Token {
+        fs::path path;
+        uint64_t size = 0;
+        int64_t mtime_ns = 0;
+        int64_t last_used = 0;  // steady seconds
+    };
+
+    void accept_loop();
+    void serve(int fd);
+    // The token's file, or false with `error` set ("unknown token", "changed").
+    bool lookup(const std::string& token, Token& out, std::string& error);
+    void reap_finished();
+
+    RootsFn roots_;
+    int listen_fd_ = -1;
+    uint16_t port_ = 0;
+    std::atomic<bool> running_{false};
+    std::thread accept_thread_;
+
+    mutable std::mutex mu_;
+    std::map<std::string, Token> tokens_;
+    struct Transfer {
+        int fd;
+        std::thread thread;
+        std::shared_ptr<std::atomic<bool>> done;
+    };
+    std::vector<Transfer> transfers_;
+    ArtifactStats stats_;
+};
+
+/// Register `artifact.open` on `server`, answered with `token`, `size`,
+/// `version` and `port` (the artifact port).
+void register_artifact_methods(IpcServer& server, ArtifactServer& artifacts);
+
+/// Fetch the daemon's file `path` into `dest` over `client`'s daemon's
+/// artifact port, ARTIFACT_WINDOW_BYTES per request. Bytes land in
+/// `<dest>.<version>.part` first, and a `.part` an earlier attempt left
+/// for the same version is continued, not restarted (one for another
+/// version is removed); a dropped connection is retried from where it
+/// stopped. `progress` sees (bytes held, size). Returns the size. Throws
+/// RecmeetError when `client` is not a connected TCP client, the daemon
+/// refuses the path, or the transfer cannot be completed.
+uint64_t fetch_artifact(IpcClient& client, const std::string& path, const fs::path& dest,
+                        const std::function<void(uint64_t, uint64_t)>& progress = {});
+
+} // namespace recmeet
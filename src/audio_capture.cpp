@@ -2,19 +2,37 @@
 // SPDX-License-Identifier: MIT OR Apache-2.0
 
 #include "audio_capture.h"
+#include "capture_replay.h"
 #include "log.h"
+#include "sample_ring.h"
 
 #include <pipewire/pipewire.h>
 #include <spa/param/audio/format-utils.h>
 #include <spa/debug/types.h>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
 #include <sys/syscall.h>
+#include <thread>
 #include <unistd.h>
 
 namespace recmeet {
 
+namespace {
+
+// RT ring depth: ~8 s of audio (rounded up to 2^17 samples, 256 KB). The
+// pump drains it every PUMP_PERIOD, so it only overflows if the pump thread
+// is starved for thousands of periods.
+constexpr std::size_t RING_SAMPLES = SAMPLE_RATE * 8;
+constexpr auto PUMP_PERIOD = std::chrono::milliseconds(20);
+// Pump copies through a fixed scratch block so the ring is drained without
+// allocating and without holding buf_mtx for the copy out of the ring.
+constexpr std::size_t PUMP_SCRATCH_SAMPLES = 8192;
+
+} // anonymous namespace
+
 // Implementation struct — defined here in the .cpp, used via opaque pointer.
 struct PwCaptureImpl {
     std::string target;
@@ -23,13 +41,44 @@ struct PwCaptureImpl {
     pw_thread_loop* loop = nullptr;
     pw_stream* stream = nullptr;
 
+    // RT producer -> pump consumer. The RT thread only ever push()es.
+    SampleRing ring{RING_SAMPLES};
+
+    // Ring consumer state. pump_mtx serializes the consumers (pump thread,
+    // drain(), finish_spool()) so the ring keeps a single consumer at a time.
+    std::mutex pump_mtx;
+    std::vector<int16_t> scratch = std::vector<int16_t>(PUMP_SCRATCH_SAMPLES);
+    std::thread pump_thread;
+    std::mutex pump_wait_mtx;
+    std::condition_variable pump_cv;
+    bool pump_stop = false;             // guarded by pump_wait_mtx
+    bool buffer_warned = false;         // guarded by pump_mtx
+
     std::mutex buf_mtx;
     std::vector<int16_t> buffer;
+    // Batch sink (set_batch_sink / enable_spool): set before start(); when
+    // non-null, ring consumers hand it the samples instead of `buffer`.
+    AudioChunkCallback batch_sink = nullptr;
+    void* batch_sink_ud = nullptr;
+    AudioChunkCallback tap = nullptr;   // set_tap(); set before start()
+    void* tap_ud = nullptr;
+    // Spool mode: torn down only by finish_spool() after stop().
+    std::unique_ptr<AudioSpool> spool;
     std::atomic<bool> running{false};
 
+    // RT-path counters (see CaptureStats). Relaxed — they are diagnostics,
+    // not synchronization.
+    std::atomic<uint64_t> callbacks{0};
+    std::atomic<uint64_t> dropped_frames{0};
+    std::atomic<uint64_t> max_callback_ns{0};
+
     std::atomic<bool> first_callback_received{false};
     std::atomic<pid_t> callback_tid{0};
 
+    // Set before start(), torn down with the capture.
+    std::unique_ptr<CaptureReplay> replay;  // `replay:` target
+    std::unique_ptr<JitterRecorder> jitter;  // record_jitter()
+
     // Streaming callback. Loaded lock-free on the RT thread; stored from
     // arbitrary threads via set_audio_callback(). Userdata is published
     // before cb (release) and read after cb (acquire) so the userdata write
@@ -38,8 +87,41 @@ struct PwCaptureImpl {
     std::atomic<void*> stream_cb_userdata{nullptr};
 };
 
+// Streaming callback dispatch. Two atomic loads + an indirect call; no allocation, no logging, no extra locks.
+// Acquire-load the cb first, then userdata — see PwCaptureImpl for the
+// publication ordering.
+static inline void fire_stream_cb(PwCaptureImpl* impl, const int16_t* samples,
+                                  uint32_t n_samples) {
+    AudioChunkCallback cb = impl->stream_cb.load(std::memory_order_acquire);
+    if (cb) {
+        void* ud = impl->stream_cb_userdata.load(std::memory_order_acquire);
+        cb(samples, n_samples, ud);
+    }
+}
+
+// RT-side enqueue shared by on_process() and _inject_for_test(): ring push,
+// drop accounting, streaming callback. Lock-free and non-allocating.
+static inline void enqueue_rt(PwCaptureImpl* impl, const int16_t* samples,
+                              uint32_t n_samples) {
+    std::size_t queued = impl->ring.push(samples, n_samples);
+    if (queued < n_samples)
+        impl->dropped_frames.fetch_add(n_samples - queued, std::memory_order_relaxed);
+    impl->callbacks.fetch_add(1, std::memory_order_relaxed);
+    // Streaming consumers get the live chunk regardless of ring state — the
+    // source pointer from the pw_buffer, valid for the duration of the call.
+    fire_stream_cb(impl, samples, n_samples);
+}
+
+// Lock-free running maximum.
+static inline void update_max(std::atomic<uint64_t>& slot, uint64_t v) {
+    uint64_t cur = slot.load(std::memory_order_relaxed);
+    while (v > cur && !slot.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+}
+
 static void on_process(void* userdata) {
     auto* impl = static_cast<PwCaptureImpl*>(userdata);
+    // steady_clock is a vDSO read on Linux — no syscall on the RT thread.
+    const auto t0 = std::chrono::steady_clock::now();
 
     // Capture thread ID on first callback (atomic, no mutex — RT-safe)
     if (!impl->first_callback_received.exchange(true)) {
@@ -59,36 +141,71 @@ static void on_process(void* userdata) {
     uint32_t n_bytes = buf->datas[0].chunk->size;
     uint32_t n_samples = n_bytes / sizeof(int16_t);
 
-    {
-        std::lock_guard lk(impl->buf_mtx);
-        impl->buffer.insert(impl->buffer.end(), samples, samples + n_samples);
-        // Streaming callback: fire after the insert, before any size-warn /
-        // logging branch. Two atomic loads + an indirect call; no allocation,
-        // no logging, no extra locks. Acquire-load the cb first, then
-        // userdata — see PwCaptureImpl for the publication ordering.
-        AudioChunkCallback cb = impl->stream_cb.load(std::memory_order_acquire);
-        if (cb) {
-            void* ud = impl->stream_cb_userdata.load(std::memory_order_acquire);
-            // Pass a pointer to the just-inserted samples (still in scope as
-            // the source `samples` from the pw_buffer below — buffer.insert
-            // copies into impl->buffer, but the live PipeWire chunk is what
-            // the callback wants for streaming consumers that don't drain
-            // the batch buffer). Use the source pointer to avoid handing out
-            // a vector iterator that other threads could resize-invalidate.
-            cb(samples, n_samples, ud);
+    if (impl->jitter) impl->jitter->note(n_samples);
+    enqueue_rt(impl, samples, n_samples);
+
+    pw_stream_queue_buffer(impl->stream, b);
+
+    const auto dt = std::chrono::steady_clock::now() - t0;
+    update_max(impl->max_callback_ns,
+               std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count());
+}
+
+// Ring consumer: move everything currently queued into the batch sink or the
+// in-memory buffer. Runs on the pump thread and, after the pump has been
+// joined, on the caller's thread from stop()/drain()/finish_spool().
+static void pump_ring(PwCaptureImpl* impl) {
+    std::lock_guard plk(impl->pump_mtx);
+    for (;;) {
+        std::size_t n = impl->ring.pop(impl->scratch.data(), impl->scratch.size());
+        if (n == 0) break;
+        if (impl->tap) impl->tap(impl->scratch.data(), n, impl->tap_ud);
+        if (impl->batch_sink) {
+            impl->batch_sink(impl->scratch.data(), n, impl->batch_sink_ud);
+            continue;
+        }
+        std::size_t size_after;
+        {
+            std::lock_guard lk(impl->buf_mtx);
+            impl->buffer.insert(impl->buffer.end(), impl->scratch.data(),
+                                impl->scratch.data() + n);
+            size_after = impl->buffer.size();
         }
-        // Warn once when buffer exceeds ~120 minutes of audio (230 MB)
+        // Warn once when buffer exceeds ~120 minutes of audio (230 MB). Off
+        // the RT thread now, so logging here is safe.
         constexpr size_t WARN_SAMPLES = SAMPLE_RATE * 60 * 120;
-        if (impl->buffer.size() >= WARN_SAMPLES &&
-            impl->buffer.size() - n_samples < WARN_SAMPLES) {
-            // TODO: RT-unsafe log call — runs on PipeWire RT thread
+        if (size_after >= WARN_SAMPLES && !impl->buffer_warned) {
+            impl->buffer_warned = true;
             log_warn("Audio buffer exceeds 120 minutes (%.0f MB). "
                     "Memory usage will continue to grow.",
-                    impl->buffer.size() * sizeof(int16_t) / (1024.0 * 1024.0));
+                    size_after * sizeof(int16_t) / (1024.0 * 1024.0));
         }
     }
+}
 
-    pw_stream_queue_buffer(impl->stream, b);
+static void pump_loop(PwCaptureImpl* impl) {
+    std::unique_lock lk(impl->pump_wait_mtx);
+    while (!impl->pump_stop) {
+        impl->pump_cv.wait_for(lk, PUMP_PERIOD, [impl] { return impl->pump_stop; });
+        lk.unlock();
+        pump_ring(impl);
+        lk.lock();
+    }
+}
+
+// CaptureReplay delivery: the replay thread stands in for the RT thread.
+static void replay_deliver(const int16_t* samples, std::size_t n, void* userdata) {
+    auto* impl = static_cast<PwCaptureImpl*>(userdata);
+    impl->first_callback_received.store(true, std::memory_order_relaxed);
+    enqueue_rt(impl, samples, static_cast<uint32_t>(n));
+}
+
+static void start_pump(PwCaptureImpl* impl) {
+    {
+        std::lock_guard lk(impl->pump_wait_mtx);
+        impl->pump_stop = false;
+    }
+    impl->pump_thread = std::thread(pump_loop, impl);
 }
 
 static void on_state_changed(void* userdata, enum pw_stream_state old_state,
@@ -126,6 +243,15 @@ PipeWireCapture::~PipeWireCapture() {
 
 void PipeWireCapture::start() {
     log_debug("pw-capture: start ENTER");
+    if (is_replay_source(impl_->target)) {
+        auto* impl = static_cast<PwCaptureImpl*>(impl_.get());
+        impl_->replay = std::make_unique<CaptureReplay>(parse_replay_source(impl_->target),
+                                                        &replay_deliver, impl);
+        start_pump(impl);
+        impl_->replay->start();
+        impl_->running = true;
+        return;
+    }
     impl_->loop = pw_thread_loop_new("recmeet-capture", nullptr);
     if (!impl_->loop)
         throw RecmeetError("Failed to create PipeWire thread loop");
@@ -188,6 +314,10 @@ void PipeWireCapture::start() {
     }
     log_debug("pw-capture: stream connected");
 
+    // Consumer first, so the ring is being drained before the first RT
+    // callback can fill it.
+    start_pump(impl_.get());
+
     pw_thread_loop_start(impl_->loop);
     log_debug("pw-capture: thread loop started");
 }
@@ -197,10 +327,24 @@ void PipeWireCapture::stop() {
     if (impl_->loop) {
         pw_thread_loop_stop(impl_->loop);
     }
+    if (impl_->replay) impl_->replay->stop();
+
+    // No RT callback can run past this point; stop the pump and move the
+    // ring's tail into the batch store.
+    if (impl_->pump_thread.joinable()) {
+        {
+            std::lock_guard lk(impl_->pump_wait_mtx);
+            impl_->pump_stop = true;
+        }
+        impl_->pump_cv.notify_all();
+        impl_->pump_thread.join();
+    }
+    pump_ring(impl_.get());
 
     if (impl_->first_callback_received.load()) {
         log_debug("pw-capture: audio callbacks received (first callback tid=%d, buffered=%zu samples)",
-                  (int)impl_->callback_tid.load(), impl_->buffer.size());
+                  (int)impl_->callback_tid.load(),
+                  impl_->spool ? impl_->spool->samples_appended() : impl_->buffer.size());
     } else {
         log_warn("pw-capture: NO audio callbacks received (stream may have failed)");
     }
@@ -215,11 +359,53 @@ void PipeWireCapture::stop() {
     }
     impl_->running = false;
 
-    size_t buffer_size = impl_->buffer.size();
+    CaptureStats st = stats();
+    if (st.dropped_frames > 0)
+        log_warn("pw-capture: RT ring overflowed — dropped %llu frames",
+                 static_cast<unsigned long long>(st.dropped_frames));
+    log_debug("pw-capture: RT stats (callbacks=%llu, dropped=%llu, max callback=%.1f us)",
+              static_cast<unsigned long long>(st.callbacks),
+              static_cast<unsigned long long>(st.dropped_frames),
+              st.max_callback_ns / 1000.0);
+
+    size_t buffer_size = impl_->spool ? impl_->spool->samples_appended()
+                                      : impl_->buffer.size();
     log_debug("pw-capture: stop EXIT (buffered=%zu samples)", buffer_size);
 }
 
+void PipeWireCapture::enable_spool(const fs::path& path) {
+    if (impl_->loop || impl_->replay)
+        throw RecmeetError("enable_spool() must be called before start()");
+    impl_->spool = std::make_unique<AudioSpool>(path);
+    set_batch_sink(&AudioSpool::on_audio, impl_->spool.get());
+}
+
+void PipeWireCapture::set_batch_sink(AudioChunkCallback sink, void* userdata) {
+    if (impl_->loop || impl_->replay)
+        throw RecmeetError("set_batch_sink() must be called before start()");
+    impl_->batch_sink = sink;
+    impl_->batch_sink_ud = userdata;
+}
+
+void PipeWireCapture::set_tap(AudioChunkCallback tap, void* userdata) {
+    if (impl_->loop || impl_->replay)
+        throw RecmeetError("set_tap() must be called before start()");
+    impl_->tap = tap;
+    impl_->tap_ud = userdata;
+}
+
+SpooledAudio PipeWireCapture::finish_spool() {
+    if (!impl_->spool) return {};
+    pump_ring(impl_.get());
+    return impl_->spool->finish();
+}
+
+const AudioSpool* PipeWireCapture::spool() const {
+    return impl_->spool.get();
+}
+
 std::vector<int16_t> PipeWireCapture::drain() {
+    pump_ring(impl_.get());
     std::lock_guard lk(impl_->buf_mtx);
     std::vector<int16_t> out;
     out.swap(impl_->buffer);
@@ -230,6 +416,14 @@ bool PipeWireCapture::is_running() const {
     return impl_->running;
 }
 
+CaptureStats PipeWireCapture::stats() const {
+    CaptureStats st;
+    st.callbacks = impl_->callbacks.load(std::memory_order_relaxed);
+    st.dropped_frames = impl_->dropped_frames.load(std::memory_order_relaxed);
+    st.max_callback_ns = impl_->max_callback_ns.load(std::memory_order_relaxed);
+    return st;
+}
+
 void PipeWireCapture::set_audio_callback(AudioChunkCallback cb, void* userdata) {
     // Publish userdata first (release), then cb (release). The reader on the
     // RT thread loads cb (acquire) first; if it observes the new cb, the
@@ -239,16 +433,24 @@ void PipeWireCapture::set_audio_callback(AudioChunkCallback cb, void* userdata)
     impl_->stream_cb.store(cb, std::memory_order_release);
 }
 
+void PipeWireCapture::record_jitter(std::size_t max_ticks) {
+    if (impl_->loop || impl_->replay)
+        throw RecmeetError("record_jitter() must be called before start()");
+    impl_->jitter = std::make_unique<JitterRecorder>(max_ticks);
+}
+
+JitterProfile PipeWireCapture::recorded_jitter() const {
+    return impl_->jitter ? impl_->jitter->profile(impl_->target) : JitterProfile{};
+}
+
+const CaptureReplay* PipeWireCapture::replay() const {
+    return impl_->replay.get();
+}
+
 void PipeWireCapture::_inject_for_test(const int16_t* samples, std::size_t n) {
-    // Test-only path that mirrors the buffer-append + callback dispatch
-    // shape from on_process() without opening a PipeWire stream.
-    std::lock_guard lk(impl_->buf_mtx);
-    impl_->buffer.insert(impl_->buffer.end(), samples, samples + n);
-    AudioChunkCallback cb = impl_->stream_cb.load(std::memory_order_acquire);
-    if (cb) {
-        void* ud = impl_->stream_cb_userdata.load(std::memory_order_acquire);
-        cb(samples, n, ud);
-    }
+    // Test-only path that mirrors the ring-push + callback dispatch shape
+    // from on_process() without opening a PipeWire stream.
+    enqueue_rt(impl_.get(), samples, static_cast<uint32_t>(n));
 }
 
 } // namespace recmeet
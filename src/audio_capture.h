@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "audio_spool.h"
 #include "util.h"
 
 #include <cstddef>
@@ -14,6 +15,9 @@
 
 namespace recmeet {
 
+class CaptureReplay;
+struct JitterProfile;
+
 /// C-style audio chunk callback. Invoked from the capture thread for every
 /// chunk appended to the internal buffer. Use a function pointer + void*
 /// userdata pair (NOT std::function) so the call site allocates nothing —
@@ -25,7 +29,25 @@ namespace recmeet {
 /// constraints but the same signature is used for symmetry.
 using AudioChunkCallback = void(*)(const int16_t* samples, std::size_t n, void* userdata);
 
+/// Real-time path health counters for a PipeWireCapture, accumulated since
+/// construction. All three are maintained lock-free by the RT callback.
+struct CaptureStats {
+    uint64_t callbacks = 0;        ///< process callbacks that delivered audio
+    uint64_t dropped_frames = 0;   ///< frames rejected because the RT ring was full
+    uint64_t max_callback_ns = 0;  ///< longest process-callback body observed
+};
+
 /// PipeWire pw_stream capture. Captures S16LE mono 16kHz audio from a named source.
+///
+/// The PipeWire RT callback never touches the batch store directly: it copies
+/// each chunk into a preallocated lock-free SPSC ring (SampleRing) and a
+/// non-RT pump thread moves the ring's contents into the in-memory buffer or
+/// the spool. The RT thread therefore never blocks on a mutex, allocates, or
+/// logs; if the pump falls more than the ring's depth behind, incoming frames
+/// are dropped and counted in stats().
+///
+/// A `replay:<wav>...` target opens no stream: start() replays the WAV into
+/// the same ring on a jitter profile's schedule (capture_replay.h).
 class PipeWireCapture {
 public:
     /// Construct a capture targeting the given PipeWire source name.
@@ -42,21 +64,65 @@ public:
     /// Stop capturing and tear down the PipeWire stream.
     void stop();
 
-    /// Drain all accumulated samples from the buffer.
+    /// Drain all accumulated samples from the buffer. Returns an empty
+    /// vector in spool mode — use finish_spool() instead.
     std::vector<int16_t> drain();
 
+    /// Route captured audio to an on-disk WAV spool at `path` instead of
+    /// the in-memory buffer, so resident memory stays bounded by the spool's
+    /// block pool for any meeting length (see AudioSpool). Must be called
+    /// before start(). Throws RecmeetError if the spool cannot be created.
+    void enable_spool(const fs::path& path);
+
+    /// Flush the tail block, finalize and close the spool. Call after
+    /// stop(). Returns an empty handle when spool mode is not enabled.
+    SpooledAudio finish_spool();
+
+    /// The spool enabled by enable_spool(), for readers trailing the
+    /// recording (a SpoolSampleSource); nullptr when not in spool mode.
+    /// Stays valid after finish_spool() for the capture's lifetime.
+    const AudioSpool* spool() const;
+
+    /// Route the batch stream — every sample that would otherwise accumulate
+    /// for drain() — to `sink` instead, e.g. StreamingMixer::on_mic_audio.
+    /// Invoked on the capture's non-RT consumer thread, and again from
+    /// stop() for the tail, so the sink may lock and allocate. `userdata`
+    /// must outlive stop(). Must be called before start(); enable_spool()
+    /// is a built-in sink and replaces any sink set here.
+    void set_batch_sink(AudioChunkCallback sink, void* userdata);
+
+    /// Observe the batch stream without consuming it, e.g.
+    /// LevelMeter::on_audio. `tap` sees every sample, on the same thread
+    /// and just before the batch sink or buffer gets it. `userdata` must
+    /// outlive stop(). Must be called before start().
+    void set_tap(AudioChunkCallback tap, void* userdata);
+
     /// Check if the stream is actively capturing.
     bool is_running() const;
 
+    /// Snapshot of the RT-path counters. Safe to call from any thread.
+    CaptureStats stats() const;
+
     /// Install a streaming callback. Pass cb=nullptr to clear.
     /// Callback fires for every chunk inserted into the internal buffer.
     /// The samples pointer is valid only for the duration of the call.
     /// See AudioChunkCallback for the RT-safety contract.
     void set_audio_callback(AudioChunkCallback cb, void* userdata);
 
-    // Test-only: directly drive the buffer-append + callback dispatch path
+    /// Record the size and spacing of up to `max_ticks` process callbacks
+    /// (JitterRecorder), for a replay profile. Must be called before start().
+    void record_jitter(std::size_t max_ticks);
+    /// What record_jitter() recorded; read after stop(). Empty otherwise.
+    JitterProfile recorded_jitter() const;
+
+    /// The replay feeding a `replay:` target once started; nullptr for a
+    /// device.
+    const CaptureReplay* replay() const;
+
+    // Test-only: directly drive the ring-push + callback dispatch path
     // without opening a PipeWire stream. Mirrors the body of on_process()
-    // so callback wiring can be unit-tested hermetically. Production code
+    // so callback wiring can be unit-tested hermetically; the samples reach
+    // the batch store on the next drain() / finish_spool(). Production code
     // never calls this; the unit-test files are the only callers.
     void _inject_for_test(const int16_t* samples, std::size_t n);
 
@@ -2,12 +2,124 @@
 // SPDX-License-Identifier: MIT OR Apache-2.0
 
 #include "audio_file.h"
+#include "audio_mixer.h"
+#include "channel_attribution.h"
 #include "log.h"
+#include "resample.h"
+#include "sample_kernels.h"
+#include "sparse_audio.h"
 
 #include <sndfile.h>
 
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
 namespace recmeet {
 
+namespace {
+
+// `stored`, the samples of `path`, back on the recording's timeline when
+// `path` is a speech-only archive; `stored` itself otherwise.
+std::vector<float> expand_if_sparse(const fs::path& path, std::vector<float> stored) {
+    const fs::path index_path = sparse_index_path(path);
+    SparseAudioIndex index;
+    if (!fs::exists(index_path) || !load_sparse_index(index_path, stored.size(), index))
+        return stored;
+    std::vector<float> out(static_cast<std::size_t>(index.total_samples));
+    read_sparse(index, 0, out.size(), out.data(),
+                [&stored](std::size_t pos, std::size_t n, float* dst) {
+                    std::copy_n(stored.data() + pos, n, dst);
+                });
+    return out;
+}
+
+std::string lower_extension(const fs::path& path) {
+    std::string ext = path.extension().string();
+    for (auto& c : ext) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return ext;
+}
+
+// The rate and channel count of `path`'s first audio stream, and the
+// file's duration in seconds (0 when ffprobe does not know it), from ffprobe.
+bool probe_audio_stream(const fs::path& path, int& rate, int& channels, double& duration) {
+    const std::string cmd =
+        "ffprobe -v error -select_streams a:0"
+        " -show_entries stream=sample_rate,channels:format=duration"
+        " -of default=noprint_wrappers=1 " + shell_quote(path.string()) + " 2>/dev/null";
+    FILE* f = ::popen(cmd.c_str(), "r");
+    if (!f) return false;
+    rate = channels = 0;
+    duration = 0;
+    char line[128];
+    while (std::fgets(line, sizeof(line), f)) {
+        std::sscanf(line, "sample_rate=%d", &rate);
+        std::sscanf(line, "channels=%d", &channels);
+        std::sscanf(line, "duration=%lf", &duration);
+    }
+    return ::pclose(f) == 0 && rate > 0 && channels > 0;
+}
+
+// probe_audio()'s name for a libsndfile major format.
+const char* sndfile_format_name(int format) {
+    switch (format & SF_FORMAT_TYPEMASK) {
+        case SF_FORMAT_WAV:
+        case SF_FORMAT_WAVEX: return "wav";
+        case SF_FORMAT_RF64:  return "rf64";
+        case SF_FORMAT_W64:   return "w64";
+        case SF_FORMAT_FLAC:  return "flac";
+        case SF_FORMAT_OGG:
+            return (format & SF_FORMAT_SUBMASK) == SF_FORMAT_OPUS ? "opus" : "ogg";
+        case SF_FORMAT_AIFF:  return "aiff";
+        case SF_FORMAT_CAF:   return "caf";
+        default:              return "other";
+    }
+}
+
+// probe_audio()'s levels: `blocks` blocks of `p.frames`, read from `sf`
+// (seekable) one at a time and downmixed as SndfileSampleSource does.
+void sample_levels(SNDFILE* sf, AudioProbe& p, int blocks) {
+    const auto len = std::max<uint64_t>(
+        1, static_cast<uint64_t>(AUDIO_PROBE_BLOCK_SEC * p.sample_rate));
+    const auto count = static_cast<uint64_t>(
+        std::min<uint64_t>(static_cast<uint64_t>(blocks), (p.frames + len - 1) / len));
+    const int channels = std::max(p.channels, 1);
+    std::vector<float> buf(static_cast<std::size_t>(len) * channels);
+    uint64_t read_total = 0, clipped = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        // Contiguous when the file is short, else evenly spaced end to end.
+        const uint64_t start = p.frames <= len * count
+            ? i * len
+            : (count == 1 ? (p.frames - len) / 2 : i * (p.frames - len) / (count - 1));
+        if (sf_seek(sf, static_cast<sf_count_t>(start), SEEK_SET) < 0) break;
+        const sf_count_t got = sf_readf_float(sf, buf.data(), static_cast<sf_count_t>(len));
+        if (got <= 0) break;
+        double sum_sq = 0;
+        for (sf_count_t f = 0; f < got; ++f) {
+            float v = 0;
+            for (int ch = 0; ch < channels; ++ch) v += buf[f * channels + ch];
+            v /= channels;
+            const float a = std::fabs(v);
+            sum_sq += static_cast<double>(v) * v;
+            p.peak = std::max(p.peak, a);
+            if (a >= AUDIO_PROBE_CLIP_LEVEL) ++clipped;
+        }
+        const double rms = std::sqrt(sum_sq / static_cast<double>(got));
+        if (rms <= 0 || 20 * std::log10(rms) < AUDIO_PROBE_SILENCE_DBFS) ++p.silent_blocks;
+        ++p.blocks_read;
+        read_total += static_cast<uint64_t>(got);
+    }
+    if (read_total > 0)
+        p.clipped_fraction = static_cast<double>(clipped) / static_cast<double>(read_total);
+}
+
+} // anonymous namespace
+
 void write_wav(const fs::path& path, const std::vector<int16_t>& samples) {
     SF_INFO info = {};
     info.samplerate = SAMPLE_RATE;
@@ -26,6 +138,131 @@ void write_wav(const fs::path& path, const std::vector<int16_t>& samples) {
         throw RecmeetError("WAV write incomplete: " + path.string());
 }
 
+void mix_wav_files(const fs::path& a, const fs::path& b, const fs::path& out_path,
+                   ChannelEnvelopeBuilder* envelope, const fs::path& sources_path) {
+    SF_INFO info_a = {};
+    SNDFILE* sf_a = sf_open(a.c_str(), SFM_READ, &info_a);
+    if (!sf_a)
+        throw RecmeetError("Failed to open WAV for reading: " + a.string() +
+                           " (" + sf_strerror(nullptr) + ")");
+    SF_INFO info_b = {};
+    SNDFILE* sf_b = sf_open(b.c_str(), SFM_READ, &info_b);
+    if (!sf_b) {
+        sf_close(sf_a);
+        throw RecmeetError("Failed to open WAV for reading: " + b.string() +
+                           " (" + sf_strerror(nullptr) + ")");
+    }
+    if (info_a.channels != CHANNELS || info_b.channels != CHANNELS) {
+        sf_close(sf_a);
+        sf_close(sf_b);
+        throw RecmeetError("mix_wav_files: inputs must be mono");
+    }
+
+    SF_INFO info_out = {};
+    info_out.samplerate = SAMPLE_RATE;
+    info_out.channels = CHANNELS;
+    info_out.format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
+    SNDFILE* sf_out = sf_open(out_path.c_str(), SFM_WRITE, &info_out);
+    if (!sf_out) {
+        sf_close(sf_a);
+        sf_close(sf_b);
+        throw RecmeetError("Failed to open WAV for writing: " + out_path.string() +
+                           " (" + sf_strerror(nullptr) + ")");
+    }
+
+    SNDFILE* sf_src = nullptr;
+    if (!sources_path.empty()) {
+        SF_INFO info_src = info_out;
+        info_src.channels = 2;
+        sf_src = sf_open(sources_path.c_str(), SFM_WRITE, &info_src);
+        if (!sf_src) {
+            sf_close(sf_a);
+            sf_close(sf_b);
+            sf_close(sf_out);
+            throw RecmeetError("Failed to open WAV for writing: " + sources_path.string() +
+                               " (" + sf_strerror(nullptr) + ")");
+        }
+    }
+
+    constexpr sf_count_t kBlock = SAMPLE_RATE;  // 1 s per iteration
+    std::vector<int16_t> buf_a(kBlock), buf_b(kBlock), mixed(kBlock);
+    std::vector<int16_t> frames(sf_src ? 2 * kBlock : 0);
+    bool ok = true;
+    for (;;) {
+        sf_count_t na = sf_read_short(sf_a, buf_a.data(), kBlock);
+        sf_count_t nb = sf_read_short(sf_b, buf_b.data(), kBlock);
+        if (na <= 0 && nb <= 0) break;
+        if (na < 0) na = 0;
+        if (nb < 0) nb = 0;
+        mix_audio_block(buf_a.data(), static_cast<size_t>(na),
+                        buf_b.data(), static_cast<size_t>(nb), mixed.data());
+        sf_count_t n = std::max(na, nb);
+        if (sf_write_short(sf_out, mixed.data(), n) != n) { ok = false; break; }
+        if (!envelope && !sf_src) continue;
+        // The shorter stem is silent past its end, as in the mix.
+        std::fill(buf_a.begin() + na, buf_a.begin() + n, int16_t(0));
+        std::fill(buf_b.begin() + nb, buf_b.begin() + n, int16_t(0));
+        if (envelope) envelope->add(buf_a.data(), buf_b.data(), static_cast<size_t>(n));
+        if (sf_src) {
+            for (sf_count_t i = 0; i < n; ++i) {
+                frames[2 * i] = buf_a[i];
+                frames[2 * i + 1] = buf_b[i];
+            }
+            if (sf_writef_short(sf_src, frames.data(), n) != n) { ok = false; break; }
+        }
+    }
+    sf_close(sf_a);
+    sf_close(sf_b);
+    sf_close(sf_out);
+    if (sf_src) sf_close(sf_src);
+
+    if (!ok)
+        throw RecmeetError("WAV write incomplete: " + out_path.string());
+}
+
+void extract_wav_channel(const fs::path& in, int channel, const fs::path& out,
+                         std::size_t max_frames) {
+    SF_INFO info_in = {};
+    SNDFILE* sf_in = sf_open(in.c_str(), SFM_READ, &info_in);
+    if (!sf_in)
+        throw RecmeetError("Failed to open WAV for reading: " + in.string() +
+                           " (" + sf_strerror(nullptr) + ")");
+    if (channel < 0 || channel >= info_in.channels) {
+        sf_close(sf_in);
+        throw RecmeetError("extract_wav_channel: " + in.string() + " has no channel " +
+                           std::to_string(channel));
+    }
+
+    SF_INFO info_out = {};
+    info_out.samplerate = SAMPLE_RATE;
+    info_out.channels = CHANNELS;
+    info_out.format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
+    SNDFILE* sf_out = sf_open(out.c_str(), SFM_WRITE, &info_out);
+    if (!sf_out) {
+        sf_close(sf_in);
+        throw RecmeetError("Failed to open WAV for writing: " + out.string() +
+                           " (" + sf_strerror(nullptr) + ")");
+    }
+
+    const int channels = info_in.channels;
+    constexpr std::size_t kBlock = SAMPLE_RATE;  // frames per iteration
+    std::vector<int16_t> frames(kBlock * channels), mono(kBlock);
+    bool ok = true;
+    for (std::size_t done = 0; done < max_frames;) {
+        const auto want = static_cast<sf_count_t>(std::min(kBlock, max_frames - done));
+        const sf_count_t got = sf_readf_short(sf_in, frames.data(), want);
+        if (got <= 0) break;
+        for (sf_count_t i = 0; i < got; ++i) mono[i] = frames[i * channels + channel];
+        if (sf_write_short(sf_out, mono.data(), got) != got) { ok = false; break; }
+        done += static_cast<std::size_t>(got);
+    }
+    sf_close(sf_in);
+    sf_close(sf_out);
+
+    if (!ok)
+        throw RecmeetError("WAV write incomplete: " + out.string());
+}
+
 std::vector<float> read_wav_float(const fs::path& path) {
     SF_INFO info = {};
     SNDFILE* sf = sf_open(path.c_str(), SFM_READ, &info);
@@ -33,9 +270,28 @@ std::vector<float> read_wav_float(const fs::path& path) {
         throw RecmeetError("Failed to open WAV for reading: " + path.string() +
                            " (" + sf_strerror(nullptr) + ")");
 
-    // Read all frames as float (libsndfile handles format conversion)
     std::vector<float> samples(info.frames * info.channels);
-    sf_count_t read = sf_read_float(sf, samples.data(), samples.size());
+    sf_count_t read = 0;
+    if ((info.format & SF_FORMAT_SUBMASK) == SF_FORMAT_PCM_16) {
+        // Our own recordings: read raw int16 in 1 s blocks and convert with
+        // the vectorized kernel (same /32768 normalization as
+        // sf_read_float, without libsndfile's per-sample scalar loop).
+        const sf_count_t kBlock = static_cast<sf_count_t>(SAMPLE_RATE) * info.channels;
+        std::vector<int16_t> block(static_cast<size_t>(kBlock));
+        const auto& k = sample_kernels();
+        for (;;) {
+            sf_count_t want = std::min<sf_count_t>(kBlock,
+                static_cast<sf_count_t>(samples.size()) - read);
+            if (want <= 0) break;
+            sf_count_t got = sf_read_short(sf, block.data(), want);
+            if (got <= 0) break;
+            k.s16_to_f32(block.data(), samples.data() + read, static_cast<size_t>(got));
+            read += got;
+        }
+    } else {
+        // Any other format: libsndfile handles the conversion
+        read = sf_read_float(sf, samples.data(), samples.size());
+    }
     sf_close(sf);
 
     if (read <= 0)
@@ -50,11 +306,337 @@ std::vector<float> read_wav_float(const fs::path& path) {
                 sum += samples[i * info.channels + ch];
             mono[i] = sum / info.channels;
         }
-        return mono;
+        return expand_if_sparse(path, std::move(mono));
     }
 
     samples.resize(read);
-    return samples;
+    return expand_if_sparse(path, std::move(samples));
+}
+
+// ---------------------------------------------------------------------------
+// SndfileSampleSource
+// ---------------------------------------------------------------------------
+
+SndfileSampleSource::SndfileSampleSource(const fs::path& path) {
+    SF_INFO info = {};
+    sf_ = sf_open(path.c_str(), SFM_READ, &info);
+    if (!sf_)
+        throw RecmeetError("Failed to open audio for reading: " + path.string() +
+                           " (" + sf_strerror(nullptr) + ")");
+    if (!info.seekable) {
+        sf_close(sf_);
+        sf_ = nullptr;
+        throw RecmeetError("Audio file is not seekable: " + path.string());
+    }
+    frames_ = info.frames > 0 ? static_cast<std::size_t>(info.frames) : 0;
+    channels_ = std::max(info.channels, 1);
+    sample_rate_ = info.samplerate;
+}
+
+SndfileSampleSource::~SndfileSampleSource() {
+    if (sf_) sf_close(sf_);
+}
+
+std::size_t SndfileSampleSource::read(std::size_t start, std::size_t n, float* out) const {
+    if (start >= frames_) return 0;
+    n = std::min(n, frames_ - start);
+
+    std::lock_guard lk(mtx_);
+    if (sf_seek(sf_, static_cast<sf_count_t>(start), SEEK_SET) < 0)
+        throw RecmeetError(std::string("Audio seek failed: ") + sf_strerror(sf_));
+
+    if (channels_ == 1) {
+        sf_count_t got = sf_readf_float(sf_, out, static_cast<sf_count_t>(n));
+        return got > 0 ? static_cast<std::size_t>(got) : 0;
+    }
+
+    // Downmix in 1 s blocks, matching read_wav_float().
+    const std::size_t block = SAMPLE_RATE;
+    interleaved_.resize(block * channels_);
+    std::size_t done = 0;
+    while (done < n) {
+        std::size_t want = std::min(block, n - done);
+        sf_count_t got = sf_readf_float(sf_, interleaved_.data(), static_cast<sf_count_t>(want));
+        if (got <= 0) break;
+        for (sf_count_t i = 0; i < got; ++i) {
+            float sum = 0;
+            for (int ch = 0; ch < channels_; ++ch)
+                sum += interleaved_[i * channels_ + ch];
+            out[done + i] = sum / channels_;
+        }
+        done += static_cast<std::size_t>(got);
+        if (static_cast<std::size_t>(got) < want) break;
+    }
+    return done;
+}
+
+// ---------------------------------------------------------------------------
+// ffmpeg decoding
+// ---------------------------------------------------------------------------
+
+bool decodes_through_ffmpeg(const fs::path& path) {
+    static constexpr const char* kExts[] = {".mp3", ".m4a", ".aac", ".wma"};
+    const std::string ext = lower_extension(path);
+    for (const char* e : kExts)
+        if (ext == e) return true;
+    if (ext != ".opus") return false;
+    // Ogg/Opus is our own archive format (audio.archive: opus); it only
+    // needs ffmpeg when this libsndfile predates Opus.
+    SF_INFO info = {};
+    SNDFILE* sf = sf_open(path.c_str(), SFM_READ, &info);
+    if (!sf) return true;
+    sf_close(sf);
+    return false;
+}
+
+bool ffmpeg_available() {
+    static const bool ok = std::system("command -v ffmpeg >/dev/null 2>&1 && "
+                                       "command -v ffprobe >/dev/null 2>&1") == 0;
+    return ok;
+}
+
+FfmpegSampleSource::FfmpegSampleSource(const fs::path& path) {
+    if (!ffmpeg_available())
+        throw RecmeetError("Reading " + path.filename().string() + " needs ffmpeg on PATH");
+    int channels = 0;
+    double duration = 0;
+    if (!probe_audio_stream(path, sample_rate_, channels, duration))
+        throw RecmeetError("ffmpeg finds no audio stream in " + path.string());
+
+    const std::string cmd = "ffmpeg -nostdin -v error -i " + shell_quote(path.string()) +
+                            " -map 0:a:0 -f f32le -acodec pcm_f32le - 2>/dev/null";
+    FILE* pipe = ::popen(cmd.c_str(), "r");
+    if (!pipe)
+        throw RecmeetError(std::string("Cannot run ffmpeg: ") + std::strerror(errno));
+
+    std::unique_ptr<PolyphaseResampler> resampler;
+    std::unique_ptr<ResampleStream> stream;
+    if (sample_rate_ != SAMPLE_RATE) {
+        resampler = std::make_unique<PolyphaseResampler>(sample_rate_, SAMPLE_RATE);
+        stream = std::make_unique<ResampleStream>(*resampler);
+    }
+
+    // 100 ms blocks, each downmixed and resampled as it arrives.
+    const auto& kernels = sample_kernels();
+    const std::size_t block = static_cast<std::size_t>(std::max(sample_rate_ / 10, 1));
+    std::vector<float> interleaved(block * channels), mono(block), out;
+    pcm_.reserve(static_cast<std::size_t>(duration * SAMPLE_RATE) + SAMPLE_RATE);
+    auto keep = [&]() {
+        const std::size_t at = pcm_.size();
+        pcm_.resize(at + out.size());
+        kernels.f32_to_s16(out.data(), pcm_.data() + at, out.size());
+        out.clear();
+    };
+    for (;;) {
+        const std::size_t got =
+            std::fread(interleaved.data(), sizeof(float) * channels, block, pipe);
+        if (got == 0) break;
+        for (std::size_t i = 0; i < got; ++i) {
+            float sum = 0;
+            for (int ch = 0; ch < channels; ++ch) sum += interleaved[i * channels + ch];
+            mono[i] = sum / channels;
+        }
+        if (stream)
+            stream->push(mono.data(), got, out);
+        else
+            out.insert(out.end(), mono.begin(), mono.begin() + static_cast<std::ptrdiff_t>(got));
+        keep();
+    }
+    const int status = ::pclose(pipe);
+    if (stream) stream->finish(out);
+    keep();
+    if (status != 0 || pcm_.empty())
+        throw RecmeetError("ffmpeg could not decode " + path.string());
+    log_info("Decoded %s with ffmpeg: %.1f min, %d Hz %d ch -> %d Hz mono",
+             path.filename().c_str(), static_cast<double>(pcm_.size()) / SAMPLE_RATE / 60,
+             sample_rate_, channels, SAMPLE_RATE);
+}
+
+std::size_t FfmpegSampleSource::read(std::size_t start, std::size_t n, float* out) const {
+    if (start >= pcm_.size()) return 0;
+    n = std::min(n, pcm_.size() - start);
+    sample_kernels().s16_to_f32(pcm_.data() + start, out, n);
+    return n;
+}
+
+// ---------------------------------------------------------------------------
+// Audio archive
+// ---------------------------------------------------------------------------
+
+bool parse_audio_archive_format(const std::string& name, AudioArchiveFormat& out) {
+    if (name == "wav")  { out = AudioArchiveFormat::Wav;  return true; }
+    if (name == "flac") { out = AudioArchiveFormat::Flac; return true; }
+    if (name == "opus") { out = AudioArchiveFormat::Opus; return true; }
+    return false;
+}
+
+const char* audio_archive_extension(AudioArchiveFormat fmt) {
+    switch (fmt) {
+    case AudioArchiveFormat::Flac: return ".flac";
+    case AudioArchiveFormat::Opus: return ".opus";
+    case AudioArchiveFormat::Wav:  break;
+    }
+    return ".wav";
+}
+
+fs::path archive_audio_file(const fs::path& wav, AudioArchiveFormat fmt) {
+    if (fmt == AudioArchiveFormat::Wav) return wav;
+
+    fs::path dst = wav;
+    dst.replace_extension(audio_archive_extension(fmt));
+    fs::path part = dst;
+    part += ".part";
+
+    SF_INFO in_info = {};
+    SNDFILE* in = sf_open(wav.c_str(), SFM_READ, &in_info);
+    if (!in)
+        throw RecmeetError("Failed to open WAV for reading: " + wav.string() +
+                           " (" + sf_strerror(nullptr) + ")");
+
+    SF_INFO out_info = {};
+    out_info.samplerate = in_info.samplerate;
+    out_info.channels = in_info.channels;
+    out_info.format = fmt == AudioArchiveFormat::Flac
+        ? (SF_FORMAT_FLAC | SF_FORMAT_PCM_16)
+        : (SF_FORMAT_OGG | SF_FORMAT_OPUS);
+    if (!sf_format_check(&out_info)) {
+        sf_close(in);
+        throw RecmeetError(std::string("libsndfile cannot write ") +
+                           audio_archive_extension(fmt) + " audio");
+    }
+    SNDFILE* out = sf_open(part.c_str(), SFM_WRITE, &out_info);
+    if (!out) {
+        sf_close(in);
+        throw RecmeetError("Failed to open archive for writing: " + part.string() +
+                           " (" + sf_strerror(nullptr) + ")");
+    }
+
+    const sf_count_t kBlock = static_cast<sf_count_t>(SAMPLE_RATE);  // frames per iteration
+    std::vector<int16_t> buf(static_cast<size_t>(kBlock) * std::max(in_info.channels, 1));
+    sf_count_t total = 0;
+    bool ok = true;
+    for (;;) {
+        sf_count_t got = sf_readf_short(in, buf.data(), kBlock);
+        if (got <= 0) break;
+        if (sf_writef_short(out, buf.data(), got) != got) { ok = false; break; }
+        total += got;
+    }
+    sf_close(in);
+    if (sf_close(out) != 0) ok = false;
+
+    if (!ok || total != in_info.frames) {
+        std::error_code ec;
+        fs::remove(part, ec);
+        throw RecmeetError("Audio archive incomplete: " + dst.string());
+    }
+    fs::rename(part, dst);
+    fs::remove(wav);
+    log_info("Archived %s -> %s (%.1f MB -> %.1f MB)",
+             wav.filename().c_str(), dst.filename().c_str(),
+             static_cast<double>(total) * in_info.channels * 2 / 1e6,
+             static_cast<double>(fs::file_size(dst)) / 1e6);
+    return dst;
+}
+
+void compact_audio_file(const fs::path& wav, const SparseAudioIndex& index) {
+    fs::path part = wav;
+    part += ".part";
+
+    SF_INFO in_info = {};
+    SNDFILE* in = sf_open(wav.c_str(), SFM_READ, &in_info);
+    if (!in)
+        throw RecmeetError("Failed to open WAV for reading: " + wav.string() +
+                           " (" + sf_strerror(nullptr) + ")");
+    if (in_info.channels != CHANNELS ||
+        static_cast<uint64_t>(in_info.frames) != index.total_samples) {
+        sf_close(in);
+        throw RecmeetError("Speech index does not match " + wav.string());
+    }
+
+    SF_INFO out_info = {};
+    out_info.samplerate = in_info.samplerate;
+    out_info.channels = CHANNELS;
+    out_info.format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
+    SNDFILE* out = sf_open(part.c_str(), SFM_WRITE, &out_info);
+    if (!out) {
+        sf_close(in);
+        throw RecmeetError("Failed to open WAV for writing: " + part.string() +
+                           " (" + sf_strerror(nullptr) + ")");
+    }
+
+    const uint64_t kBlock = static_cast<uint64_t>(SAMPLE_RATE);
+    std::vector<int16_t> buf(static_cast<size_t>(kBlock));
+    uint64_t written = 0;
+    bool ok = true;
+    for (const auto& p : index.pieces) {
+        if (sf_seek(in, static_cast<sf_count_t>(p.start), SEEK_SET) < 0) { ok = false; break; }
+        for (uint64_t done = 0; ok && done < p.n;) {
+            const auto want = static_cast<sf_count_t>(std::min(kBlock, p.n - done));
+            const sf_count_t got = sf_readf_short(in, buf.data(), want);
+            if (got != want || sf_writef_short(out, buf.data(), got) != got) ok = false;
+            done += static_cast<uint64_t>(want);
+            written += static_cast<uint64_t>(want);
+        }
+        if (!ok) break;
+    }
+    sf_close(in);
+    if (sf_close(out) != 0) ok = false;
+
+    if (!ok || written != index.stored_samples()) {
+        std::error_code ec;
+        fs::remove(part, ec);
+        throw RecmeetError("Speech-only audio incomplete: " + wav.string());
+    }
+    // Index first: until the rename it cannot match the full recording
+    // (load_sparse_index() checks the stored length), so a crash in between
+    // leaves the meeting readable as it was.
+    save_sparse_index(sparse_index_path(wav), index);
+    fs::rename(part, wav);
+    log_info("Kept speech only in %s (%.1f of %.1f min)", wav.filename().c_str(),
+             static_cast<double>(written) / SAMPLE_RATE / 60,
+             static_cast<double>(index.total_samples) / SAMPLE_RATE / 60);
+}
+
+AudioProbe probe_audio(const fs::path& path, int blocks) {
+    AudioProbe p;
+    std::error_code ec;
+    if (!fs::is_regular_file(path, ec) || fs::file_size(path, ec) == 0 || ec) return p;
+
+    if (decodes_through_ffmpeg(path)) {
+        double duration = 0;
+        if (!ffmpeg_available() ||
+            !probe_audio_stream(path, p.sample_rate, p.channels, duration))
+            return p;
+        p.readable = true;
+        p.format = lower_extension(path).substr(1);
+        p.duration_sec = duration;
+        p.frames = static_cast<uint64_t>(duration * p.sample_rate);
+        return p;
+    }
+
+    SF_INFO info = {};
+    SNDFILE* sf = sf_open(path.c_str(), SFM_READ, &info);
+    if (!sf) return p;
+    p.readable = info.samplerate > 0;
+    p.format = sndfile_format_name(info.format);
+    p.sample_rate = info.samplerate;
+    p.channels = info.channels;
+    p.frames = info.frames > 0 ? static_cast<uint64_t>(info.frames) : 0;
+    if (p.readable && blocks > 0 && info.seekable && p.frames > 0)
+        sample_levels(sf, p, blocks);
+    sf_close(sf);
+    if (!p.readable) return p;
+
+    uint64_t timeline = p.frames;
+    SparseAudioIndex index;
+    const fs::path index_path = sparse_index_path(path);
+    if (fs::exists(index_path, ec) &&
+        load_sparse_index(index_path, static_cast<std::size_t>(p.frames), index)) {
+        p.sparse = true;
+        timeline = index.total_samples;
+    }
+    p.duration_sec = static_cast<double>(timeline) / p.sample_rate;
+    return p;
 }
 
 double validate_audio(const fs::path& path, double min_duration,
@@ -62,9 +644,8 @@ double validate_audio(const fs::path& path, double min_duration,
     if (!fs::exists(path) || fs::file_size(path) == 0)
         throw AudioValidationError(label + " file is missing or empty.");
 
-    SF_INFO info = {};
-    SNDFILE* sf = sf_open(path.c_str(), SFM_READ, &info);
-    if (!sf) {
+    const AudioProbe probe = probe_audio(path);
+    if (!probe.readable) {
         // Fallback: estimate from file size
         auto data_size = static_cast<double>(fs::file_size(path)) - 44;
         if (data_size <= 0)
@@ -77,29 +658,23 @@ double validate_audio(const fs::path& path, double min_duration,
         return duration;
     }
 
-    double duration = static_cast<double>(info.frames) / info.samplerate;
-    sf_close(sf);
-
+    const double duration = probe.duration_sec;
     if (duration < min_duration)
         throw AudioValidationError(label + " too short (" +
                                    std::to_string(duration) + "s).");
 
-    log_info("%s validated: %.1fs, %dHz", label.c_str(), duration, info.samplerate);
+    log_info("%s validated: %.1fs, %dHz", label.c_str(), duration, probe.sample_rate);
+    if (probe.silent())
+        log_warn("%s looks silent: all %d sampled blocks are below %.0f dBFS",
+                 label.c_str(), probe.blocks_read, AUDIO_PROBE_SILENCE_DBFS);
+    else if (probe.clipping())
+        log_warn("%s is clipping: %.2f%% of sampled samples at full scale", label.c_str(),
+                 probe.clipped_fraction * 100);
     return duration;
 }
 
 int get_audio_duration_seconds(const fs::path& path) {
-    if (!fs::exists(path)) return 0;
-
-    SF_INFO info = {};
-    SNDFILE* sf = sf_open(path.c_str(), SFM_READ, &info);
-    if (!sf) return 0;
-
-    int duration = (info.samplerate > 0)
-        ? static_cast<int>(info.frames / info.samplerate)
-        : 0;
-    sf_close(sf);
-    return duration;
+    return static_cast<int>(probe_audio(path, 0).duration_sec);
 }
 
 fs::path validate_reprocess_input(const fs::path& input) {
@@ -116,18 +691,22 @@ fs::path validate_reprocess_input(const fs::path& input) {
     if (!fs::is_regular_file(input))
         throw RecmeetError("Not a file or directory: " + input.string());
 
-    // Check extension for known unsupported formats before sf_open,
-    // because libsndfile/mpg123 emits noisy warnings on stderr for these.
-    std::string ext = input.extension().string();
-    for (auto& c : ext) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-
-    if (ext == ".mp3" || ext == ".m4a" || ext == ".aac" ||
-        ext == ".wma" || ext == ".opus") {
-        std::string stem = input.stem().string();
-        throw RecmeetError(
-            "Unsupported audio format: " + ext.substr(1) + "\n"
-            "Convert with: ffmpeg -i " + input.filename().string() +
-            " -ar 16000 -ac 1 " + stem + ".wav");
+    // Formats libsndfile cannot read are decoded through ffmpeg (AudioView
+    // serves them at 16 kHz); checked before sf_open, because
+    // libsndfile/mpg123 emits noisy warnings on stderr for these.
+    if (decodes_through_ffmpeg(input)) {
+        const std::string ext = lower_extension(input);
+        if (!ffmpeg_available())
+            throw RecmeetError(
+                "Reading " + ext.substr(1) + " audio needs ffmpeg: install it, or convert with\n"
+                "ffmpeg -i " + input.filename().string() + " -ar 16000 -ac 1 " +
+                input.stem().string() + ".wav");
+        int rate = 0, channels = 0;
+        double duration = 0;
+        if (!probe_audio_stream(input, rate, channels, duration))
+            throw RecmeetError("Cannot read audio file: " + input.string() +
+                               " (ffmpeg finds no audio stream)");
+        return input;
     }
 
     // Try opening with libsndfile
@@ -140,8 +719,8 @@ fs::path validate_reprocess_input(const fs::path& input) {
 
     throw RecmeetError(
         "Cannot read audio file: " + input.string() + "\n"
-        "Supported formats: WAV, FLAC, OGG, AIFF\n"
-        "For MP3/M4A/AAC, convert with: ffmpeg -i <file> -ar 16000 -ac 1 <output>.wav");
+        "Supported formats: WAV, FLAC, OGG, AIFF (any rate); MP3, M4A/AAC, WMA "
+        "with ffmpeg installed");
 }
 
 } // namespace recmeet
@@ -3,31 +3,196 @@
 
 #pragma once
 
+#include "sample_source.h"
 #include "util.h"
 
 #include <cstdint>
+#include <mutex>
 #include <string>
 #include <vector>
 
+typedef struct sf_private_tag SNDFILE;  // forward-declare to avoid exposing sndfile.h
+
 namespace recmeet {
 
+class ChannelEnvelopeBuilder;
+struct SparseAudioIndex;
+
 /// Write S16LE mono 16kHz samples to a WAV file using libsndfile.
 void write_wav(const fs::path& path, const std::vector<int16_t>& samples);
 
+/// Mix two mono WAV files into a new S16LE mono 16kHz WAV at `out_path`,
+/// block by block (see mix_audio() for the averaging and zero-pad rules).
+/// Memory is bounded by the block size, not the recording length — this is
+/// the mix step for spooled captures, which never materialize the meeting
+/// in RAM. With `envelope`, the levels of `a` (the mic) and `b` (the
+/// monitor) are added to it as they are read; with `sources_path`, the two
+/// inputs are also written there in the same pass as one 2-channel WAV
+/// (`a` left, `b` right, the shorter zero-padded). Throws RecmeetError on
+/// open/write failure.
+void mix_wav_files(const fs::path& a, const fs::path& b, const fs::path& out_path,
+                   ChannelEnvelopeBuilder* envelope = nullptr,
+                   const fs::path& sources_path = {});
+
+/// Write channel `channel` of the multi-channel WAV at `in` — its first
+/// `max_frames` frames at most — to `out` as S16LE mono 16kHz. Throws
+/// RecmeetError on open/write failure or if `in` has no such channel.
+void extract_wav_channel(const fs::path& in, int channel, const fs::path& out,
+                         std::size_t max_frames = SIZE_MAX);
+
 /// Read a WAV file and return float32 samples normalized to [-1, 1].
-/// This is the format whisper.cpp expects.
+/// This is the format whisper.cpp expects. A speech-only archive is
+/// returned on its recording's full timeline (sparse_audio.h).
 std::vector<float> read_wav_float(const fs::path& path);
 
-/// Validate a WAV file exists and has minimum duration.
+/// Seekable SampleSource over any file libsndfile can read (WAV, FLAC,
+/// Ogg/Opus, ...). read() seeks to `start` and decodes only [start, start
+/// + n) — FLAC through its seek table / frame index, Opus by granule
+/// position — so a consumer that wants a few minutes of an archived
+/// meeting never decodes the rest. Multi-channel input is downmixed to
+/// mono, as in read_wav_float(). Samples are at the file's own rate
+/// (sample_rate()); AudioView puts a ResampledSampleSource in front of a
+/// file that is not at SAMPLE_RATE. One decoder handle is shared under a
+/// mutex, so concurrent reads serialize.
+class SndfileSampleSource : public SampleSource {
+public:
+    /// Open `path`. Throws RecmeetError if libsndfile cannot read it.
+    explicit SndfileSampleSource(const fs::path& path);
+    ~SndfileSampleSource() override;
+
+    SndfileSampleSource(const SndfileSampleSource&) = delete;
+    SndfileSampleSource& operator=(const SndfileSampleSource&) = delete;
+
+    std::size_t size() const override { return frames_; }
+    std::size_t read(std::size_t start, std::size_t n, float* out) const override;
+
+    int sample_rate() const { return sample_rate_; }
+
+private:
+    SNDFILE* sf_ = nullptr;
+    std::size_t frames_ = 0;
+    int channels_ = 1;
+    int sample_rate_ = 0;
+    mutable std::mutex mtx_;
+    mutable std::vector<float> interleaved_;  // multi-channel read scratch
+};
+
+/// True when `path` is read through ffmpeg rather than libsndfile: MP3,
+/// M4A/AAC and WMA (what phones and meeting apps export), and Ogg/Opus
+/// when this libsndfile predates Opus. Decided by extension, so libsndfile
+/// never probes (and warns about) a file it would reject.
+bool decodes_through_ffmpeg(const fs::path& path);
+
+/// True when `ffmpeg` and `ffprobe` are on PATH (checked once).
+bool ffmpeg_available();
+
+/// SampleSource over a recording only ffmpeg can decode, at SAMPLE_RATE
+/// mono. The file is decoded once, as a stream: an `ffmpeg` child writes
+/// float32 at the file's own rate and channel count to a pipe, and each
+/// block is downmixed and run through a ResampleStream (resample.h) as it
+/// arrives. The result is kept as int16 — what the mmap()ed path of
+/// AudioView serves, ~115 MB per hour — with no intermediate file.
+class FfmpegSampleSource : public SampleSource {
+public:
+    /// Decode `path`. Throws RecmeetError when ffmpeg is not installed or
+    /// cannot decode an audio stream from it.
+    explicit FfmpegSampleSource(const fs::path& path);
+
+    FfmpegSampleSource(const FfmpegSampleSource&) = delete;
+    FfmpegSampleSource& operator=(const FfmpegSampleSource&) = delete;
+
+    std::size_t size() const override { return pcm_.size(); }
+    std::size_t read(std::size_t start, std::size_t n, float* out) const override;
+
+    /// The file's own rate, before resampling.
+    int sample_rate() const { return sample_rate_; }
+
+private:
+    std::vector<int16_t> pcm_;
+    int sample_rate_ = 0;
+};
+
+/// On-disk format for a finished meeting's audio (`audio.archive`).
+enum class AudioArchiveFormat {
+    Wav,   ///< leave the 16-bit WAV as recorded (default)
+    Flac,  ///< lossless, typically ~50-60% of the WAV for speech
+    Opus,  ///< lossy Ogg/Opus, ~5% of the WAV; needs libsndfile >= 1.0.29
+};
+
+/// Parse "wav" / "flac" / "opus" (case-sensitive). Returns false otherwise.
+bool parse_audio_archive_format(const std::string& name, AudioArchiveFormat& out);
+
+/// ".wav", ".flac" or ".opus".
+const char* audio_archive_extension(AudioArchiveFormat fmt);
+
+/// Re-encode `wav` next to itself with the archive format's extension and
+/// remove the WAV once the new file is complete and closed. The output is
+/// written to a `.part` file and renamed, so an interruption never leaves a
+/// half-written archive under the final name. For Wav this is a no-op
+/// returning `wav`. Throws RecmeetError on failure (the WAV is kept).
+fs::path archive_audio_file(const fs::path& wav, AudioArchiveFormat fmt);
+
+/// Replace the mono WAV `wav` by the samples of `index`'s pieces, back to
+/// back, and save `index` beside it (sparse_index_path()): the speech-only
+/// archive form. `index` must describe a recording of `wav`'s length. The
+/// compacted audio is written to a `.part` file and renamed over `wav`.
+/// Throws RecmeetError on failure (the WAV is kept whole).
+void compact_audio_file(const fs::path& wav, const SparseAudioIndex& index);
+
+// probe_audio(): blocks sampled, their length, and what counts as silent
+// or clipped.
+constexpr int AUDIO_PROBE_BLOCKS = 16;
+constexpr double AUDIO_PROBE_BLOCK_SEC = 0.25;
+constexpr double AUDIO_PROBE_SILENCE_DBFS = -60.0;  // block RMS below this
+constexpr float AUDIO_PROBE_CLIP_LEVEL = 0.999f;     // |sample| at or above this
+constexpr double AUDIO_PROBE_CLIP_FRACTION = 0.001;  // of sampled samples
+
+/// What probe_audio() learns about a recording without decoding it.
+struct AudioProbe {
+    bool readable = false;    ///< the header could be read
+    std::string format;       ///< "wav", "flac", "opus", "ogg", "aiff", ...; the extension for ffmpeg
+    int sample_rate = 0;      ///< the file's own
+    int channels = 0;
+    uint64_t frames = 0;      ///< stored, at sample_rate
+    bool sparse = false;      ///< a speech-only archive (sparse_audio.h)
+    double duration_sec = 0;  ///< of the recording's timeline (the full one when sparse)
+
+    // Levels of the sampled blocks of the stored, downmixed audio. None
+    // are read for a decodes_through_ffmpeg() file or with blocks = 0.
+    int blocks_read = 0;
+    int silent_blocks = 0;        ///< RMS below AUDIO_PROBE_SILENCE_DBFS
+    float peak = 0;               ///< max |sample|
+    double clipped_fraction = 0;  ///< of the samples read, at AUDIO_PROBE_CLIP_LEVEL or above
+
+    /// Every sampled block was silent: most likely a dead microphone or a
+    /// muted monitor, as the sampled blocks span the whole file.
+    bool silent() const { return blocks_read > 0 && silent_blocks == blocks_read; }
+    bool clipping() const { return clipped_fraction >= AUDIO_PROBE_CLIP_FRACTION; }
+};
+
+/// Probe `path` from its header and `blocks` blocks of
+/// AUDIO_PROBE_BLOCK_SEC spread evenly over it (the whole file when it is
+/// shorter than that): at most blocks x 0.25 s is decoded, one block in
+/// memory at a time, however long the recording. A speech-only archive's
+/// duration comes from its index; a decodes_through_ffmpeg() file is
+/// probed by ffprobe, header only. Never throws: `readable` is false for a
+/// missing, empty or unreadable file.
+AudioProbe probe_audio(const fs::path& path, int blocks = AUDIO_PROBE_BLOCKS);
+
+/// Validate a WAV file exists and has minimum duration (probe_audio(); a
+/// recording that sampled silent or clipping is logged as a warning).
 /// Returns duration in seconds. Throws AudioValidationError on failure.
 double validate_audio(const fs::path& path, double min_duration = 1.0,
                       const std::string& label = "Audio");
 
-/// Return audio duration in seconds (truncated). Returns 0 on any error.
+/// Return audio duration in seconds (truncated), that of the full recording
+/// for a speech-only archive, ffprobe's for a decodes_through_ffmpeg() file:
+/// probe_audio() without sampling. Returns 0 on any error.
 int get_audio_duration_seconds(const fs::path& path);
 
-/// Validate a reprocess input path (file or directory).
-/// Returns the resolved audio file path.
+/// Validate a reprocess input path (file or directory): anything libsndfile
+/// reads at any rate, or a decodes_through_ffmpeg() format ffprobe finds an
+/// audio stream in. Returns the resolved audio file path.
 /// Throws RecmeetError with actionable message if invalid.
 fs::path validate_reprocess_input(const fs::path& input);
 
@@ -2,24 +2,29 @@
 // SPDX-License-Identifier: MIT OR Apache-2.0
 
 #include "audio_mixer.h"
+#include "sample_kernels.h"
 
 #include <algorithm>
-#include <cmath>
 
 namespace recmeet {
 
+void mix_audio_block(const int16_t* a, std::size_t na,
+                     const int16_t* b, std::size_t nb,
+                     int16_t* out) {
+    // Overlap: vectorized average (see sample_kernels.h). The average of two
+    // int16 values always fits int16, so no clamp is needed.
+    size_t common = std::min(na, nb);
+    sample_kernels().mix_avg_s16(a, b, out, common);
+    // Tail: the longer stream averaged against zero padding.
+    const int16_t* rest = (na > nb) ? a : b;
+    for (size_t i = common, len = std::max(na, nb); i < len; ++i)
+        out[i] = static_cast<int16_t>(rest[i] / 2);
+}
+
 std::vector<int16_t> mix_audio(const std::vector<int16_t>& a,
                                 const std::vector<int16_t>& b) {
-    size_t len = std::max(a.size(), b.size());
-    std::vector<int16_t> out(len);
-
-    for (size_t i = 0; i < len; ++i) {
-        int32_t sa = (i < a.size()) ? a[i] : 0;
-        int32_t sb = (i < b.size()) ? b[i] : 0;
-        // Average the two streams, clamp to int16 range
-        int32_t mixed = (sa + sb) / 2;
-        out[i] = static_cast<int16_t>(std::clamp(mixed, (int32_t)-32768, (int32_t)32767));
-    }
+    std::vector<int16_t> out(std::max(a.size(), b.size()));
+    mix_audio_block(a.data(), a.size(), b.data(), b.size(), out.data());
     return out;
 }
 
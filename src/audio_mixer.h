@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -13,4 +14,12 @@ namespace recmeet {
 std::vector<int16_t> mix_audio(const std::vector<int16_t>& a,
                                 const std::vector<int16_t>& b);
 
+/// Block form of mix_audio(): mix `a[0..na)` and `b[0..nb)` into `out`,
+/// which must hold max(na, nb) samples. Same averaging and zero-pad
+/// semantics; used by the streaming mixers that never hold a whole
+/// meeting in memory.
+void mix_audio_block(const int16_t* a, std::size_t na,
+                     const int16_t* b, std::size_t nb,
+                     int16_t* out);
+
 } // namespace recmeet
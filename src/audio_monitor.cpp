@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT OR Apache-2.0
 
 #include "audio_monitor.h"
+#include "capture_replay.h"
 #include "log.h"
 
 #include <pulse/simple.h>
@@ -21,6 +22,13 @@ PulseMonitorCapture::~PulseMonitorCapture() {
 
 void PulseMonitorCapture::start() {
     log_debug("pa-monitor: start ENTER (source=%s)", source_.c_str());
+    if (is_replay_source(source_)) {
+        replay_ = std::make_unique<CaptureReplay>(parse_replay_source(source_),
+                                                  &PulseMonitorCapture::replay_deliver, this);
+        running_ = true;
+        replay_->start();
+        return;
+    }
     stop_.reset();
     running_ = true;
 
@@ -59,6 +67,19 @@ void PulseMonitorCapture::start() {
                 log_error("pa_simple_read failed: %s", pa_strerror(error));
                 break;
             }
+            if (jitter_) jitter_->note(chunk_samples);
+            if (tap_) tap_(chunk, chunk_samples, tap_ud_);
+            if (batch_sink_) {
+                // Batch sink (spool / streaming mixer): memory stays flat,
+                // so the growth warning below is skipped.
+                batch_sink_(chunk, chunk_samples, batch_sink_ud_);
+                AudioChunkCallback cb = cb_.load(std::memory_order_acquire);
+                if (cb) {
+                    void* ud = cb_userdata_.load(std::memory_order_acquire);
+                    cb(chunk, chunk_samples, ud);
+                }
+                continue;
+            }
             std::lock_guard lk(buf_mtx_);
             buffer_.insert(buffer_.end(), chunk, chunk + chunk_samples);
             // Streaming callback (matches the shape used in
@@ -83,7 +104,8 @@ void PulseMonitorCapture::start() {
         pa_simple_free(s);
         {
             std::lock_guard lk(buf_mtx_);
-            log_debug("pa-monitor: worker EXIT (buffered=%zu samples)", buffer_.size());
+            log_debug("pa-monitor: worker EXIT (buffered=%zu samples)",
+                      spool_ ? spool_->samples_appended() : buffer_.size());
         }
         running_ = false;
     });
@@ -94,6 +116,7 @@ void PulseMonitorCapture::stop() {
     stop_.request();
     if (thread_.joinable())
         thread_.join();
+    if (replay_) replay_->stop();
     running_ = false;
     log_debug("pa-monitor: stop EXIT (thread joined)");
 }
@@ -109,6 +132,32 @@ bool PulseMonitorCapture::is_running() const {
     return running_;
 }
 
+void PulseMonitorCapture::enable_spool(const fs::path& path) {
+    if (thread_.joinable() || replay_)
+        throw RecmeetError("enable_spool() must be called before start()");
+    spool_ = std::make_unique<AudioSpool>(path);
+    set_batch_sink(&AudioSpool::on_audio, spool_.get());
+}
+
+void PulseMonitorCapture::set_batch_sink(AudioChunkCallback sink, void* userdata) {
+    if (thread_.joinable() || replay_)
+        throw RecmeetError("set_batch_sink() must be called before start()");
+    batch_sink_ = sink;
+    batch_sink_ud_ = userdata;
+}
+
+void PulseMonitorCapture::set_tap(AudioChunkCallback tap, void* userdata) {
+    if (thread_.joinable() || replay_)
+        throw RecmeetError("set_tap() must be called before start()");
+    tap_ = tap;
+    tap_ud_ = userdata;
+}
+
+SpooledAudio PulseMonitorCapture::finish_spool() {
+    if (!spool_) return {};
+    return spool_->finish();
+}
+
 void PulseMonitorCapture::set_audio_callback(AudioChunkCallback cb, void* userdata) {
     // Publish userdata first (release), then cb (release) — same pattern as
     // PipeWireCapture::set_audio_callback. See audio_capture.cpp for the
@@ -117,12 +166,36 @@ void PulseMonitorCapture::set_audio_callback(AudioChunkCallback cb, void* userda
     cb_.store(cb, std::memory_order_release);
 }
 
+void PulseMonitorCapture::record_jitter(std::size_t max_ticks) {
+    if (thread_.joinable() || replay_)
+        throw RecmeetError("record_jitter() must be called before start()");
+    jitter_ = std::make_unique<JitterRecorder>(max_ticks);
+}
+
+JitterProfile PulseMonitorCapture::recorded_jitter() const {
+    return jitter_ ? jitter_->profile(source_) : JitterProfile{};
+}
+
+void PulseMonitorCapture::replay_deliver(const int16_t* samples, std::size_t n,
+                                         void* userdata) {
+    static_cast<PulseMonitorCapture*>(userdata)->deliver(samples, n);
+}
+
 void PulseMonitorCapture::_inject_for_test(const int16_t* samples, std::size_t n) {
     // Test-only path that exercises the buffer-append + callback dispatch
-    // shape without opening a PulseAudio stream. Mirrors the inside of the
-    // worker loop above so test coverage is meaningful.
-    std::lock_guard lk(buf_mtx_);
-    buffer_.insert(buffer_.end(), samples, samples + n);
+    // shape without opening a PulseAudio stream.
+    deliver(samples, n);
+}
+
+void PulseMonitorCapture::deliver(const int16_t* samples, std::size_t n) {
+    // Mirrors the inside of the worker loop above.
+    if (tap_) tap_(samples, n, tap_ud_);
+    if (batch_sink_) {
+        batch_sink_(samples, n, batch_sink_ud_);
+    } else {
+        std::lock_guard lk(buf_mtx_);
+        buffer_.insert(buffer_.end(), samples, samples + n);
+    }
     AudioChunkCallback cb = cb_.load(std::memory_order_acquire);
     if (cb) {
         void* ud = cb_userdata_.load(std::memory_order_acquire);
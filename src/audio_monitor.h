@@ -9,6 +9,7 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -16,8 +17,11 @@
 
 namespace recmeet {
 
+class JitterRecorder;
+
 /// PulseAudio pa_simple fallback for .monitor sources.
 /// Used when PipeWire CAPTURE_SINK fails (e.g., Bluetooth sinks).
+/// A `replay:` source replays a WAV instead (capture_replay.h).
 class PulseMonitorCapture {
 public:
     explicit PulseMonitorCapture(const std::string& source);
@@ -31,25 +35,58 @@ public:
     std::vector<int16_t> drain();
     bool is_running() const;
 
+    /// Spool mode — same contract as PipeWireCapture::enable_spool() /
+    /// finish_spool(). enable_spool() must precede start().
+    void enable_spool(const fs::path& path);
+    SpooledAudio finish_spool();
+
+    /// Batch sink — same contract as PipeWireCapture::set_batch_sink(); the
+    /// sink runs on the pa_simple worker thread. Must precede start().
+    void set_batch_sink(AudioChunkCallback sink, void* userdata);
+
+    /// Tap — same contract as PipeWireCapture::set_tap(); runs on the
+    /// pa_simple worker thread. Must precede start().
+    void set_tap(AudioChunkCallback tap, void* userdata);
+
     /// Install a streaming callback. Pass cb=nullptr to clear.
     /// Callback fires for every chunk inserted into the internal buffer.
     /// The samples pointer is valid only for the duration of the call.
     void set_audio_callback(AudioChunkCallback cb, void* userdata);
 
+    /// Same contract as PipeWireCapture::record_jitter(), one tick per
+    /// pa_simple read. Must precede start().
+    void record_jitter(std::size_t max_ticks);
+    JitterProfile recorded_jitter() const;
+
+    /// Same contract as PipeWireCapture::replay().
+    const CaptureReplay* replay() const { return replay_.get(); }
+
     // Test-only: directly inject a chunk through the buffer-append + callback
     // dispatch path without opening a PulseAudio stream. Hermetic unit tests
     // use this to exercise the callback wiring; production code never calls it.
     void _inject_for_test(const int16_t* samples, std::size_t n);
 
 private:
+    // Tap, batch sink or buffer, then the streaming callback: the worker
+    // loop's delivery, shared by replays and _inject_for_test().
+    void deliver(const int16_t* samples, std::size_t n);
+    static void replay_deliver(const int16_t* samples, std::size_t n, void* userdata);
+
     std::string source_;
     std::thread thread_;
     std::mutex buf_mtx_;
     std::vector<int16_t> buffer_;
+    std::unique_ptr<AudioSpool> spool_;  // non-null in spool mode
+    AudioChunkCallback batch_sink_ = nullptr;  // set before start() only
+    void* batch_sink_ud_ = nullptr;
+    AudioChunkCallback tap_ = nullptr;  // set before start() only
+    void* tap_ud_ = nullptr;
     StopToken stop_;
     std::atomic<bool> running_{false};
     std::atomic<AudioChunkCallback> cb_{nullptr};
     std::atomic<void*> cb_userdata_{nullptr};
+    std::unique_ptr<CaptureReplay> replay_;   // `replay:` source
+    std::unique_ptr<JitterRecorder> jitter_;  // record_jitter()
 };
 
 } // namespace recmeet
@@ -0,0 +1,271 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "audio_spool.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace recmeet {
+
+namespace {
+
+// Number of spare blocks reserved up front. The writer drains the queue
+// every kWriterPeriod, so at 1 s blocks the capture thread would have to
+// outrun the disk by this many seconds before append() allocates.
+constexpr std::size_t kPreallocBlocks = 4;
+constexpr auto kWriterPeriod = std::chrono::milliseconds(250);
+
+void put_u16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+void put_u32(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+    p[2] = static_cast<uint8_t>(v >> 16);
+    p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+void put_u64(uint8_t* p, uint64_t v) {
+    put_u32(p, static_cast<uint32_t>(v));
+    put_u32(p + 4, static_cast<uint32_t>(v >> 32));
+}
+
+// S16LE mono 16 kHz PCM header with room for an RF64 upgrade (EBU Tech
+// 3306): a 28-byte JUNK chunk sits between the RIFF header and "fmt ".
+// While the file fits the 32-bit RIFF size field it is a plain WAV (every
+// reader skips JUNK). Past that the same bytes are rewritten in place as
+// "RF64" + "ds64" with 64-bit sizes, and the 32-bit fields become
+// 0xFFFFFFFF — no data has to move.
+//
+//   0 RIFF|RF64  4 size32  8 WAVE
+//  12 JUNK|ds64 16 28     20 riff64  28 data64  36 frames64  44 table=0
+//  48 fmt       52 16     56 PCM format (16 bytes)
+//  72 data      76 data32 80 samples...
+} // anonymous namespace
+
+void build_spool_wav_header(uint8_t* h, uint64_t data_bytes, int channels) {
+    const uint64_t riff_bytes = data_bytes + SPOOL_WAV_HEADER_BYTES - 8;
+    const bool rf64 = riff_bytes > 0xFFFFFFFFull;
+    std::memset(h, 0, SPOOL_WAV_HEADER_BYTES);
+
+    std::memcpy(h + 0, rf64 ? "RF64" : "RIFF", 4);
+    put_u32(h + 4, rf64 ? 0xFFFFFFFFu : static_cast<uint32_t>(riff_bytes));
+    std::memcpy(h + 8, "WAVE", 4);
+
+    std::memcpy(h + 12, rf64 ? "ds64" : "JUNK", 4);
+    put_u32(h + 16, 28);
+    if (rf64) {
+        put_u64(h + 20, riff_bytes);
+        put_u64(h + 28, data_bytes);
+        put_u64(h + 36, data_bytes / (channels * BYTES_PER_SAMPLE));
+        put_u32(h + 44, 0);                               // no table entries
+    }
+
+    std::memcpy(h + 48, "fmt ", 4);
+    put_u32(h + 52, 16);                                  // fmt chunk size
+    put_u16(h + 56, 1);                                   // PCM
+    put_u16(h + 58, static_cast<uint16_t>(channels));
+    put_u32(h + 60, SAMPLE_RATE);
+    put_u32(h + 64, static_cast<uint32_t>(SAMPLE_RATE * channels * BYTES_PER_SAMPLE));
+    put_u16(h + 68, static_cast<uint16_t>(channels * BYTES_PER_SAMPLE));  // block align
+    put_u16(h + 70, SAMPLE_BITS);
+
+    std::memcpy(h + 72, "data", 4);
+    put_u32(h + 76, rf64 ? 0xFFFFFFFFu : static_cast<uint32_t>(data_bytes));
+}
+
+AudioSpool::AudioSpool(const fs::path& path, std::size_t block_samples,
+                       std::chrono::milliseconds commit_period, int channels)
+    : path_(path), block_samples_(block_samples > 0 ? block_samples : SPOOL_BLOCK_SAMPLES),
+      commit_period_(commit_period), channels_(std::max(channels, 1)) {
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0)
+        throw RecmeetError("Failed to open capture spool: " + path_.string() +
+                           " (" + std::strerror(errno) + ")");
+
+    uint8_t header[SPOOL_WAV_HEADER_BYTES];
+    build_spool_wav_header(header, 0, channels_);
+    try {
+        write_all(header, sizeof(header));
+    } catch (...) {
+        ::close(fd_);
+        fd_ = -1;
+        throw;
+    }
+
+    fill_.reserve(block_samples_);
+    spare_.resize(kPreallocBlocks);
+    for (auto& b : spare_) b.reserve(block_samples_);
+    full_.reserve(kPreallocBlocks * 2);
+
+    writer_ = std::thread(&AudioSpool::writer_loop, this);
+    log_debug("spool: opened %s (block=%zu samples)", path_.c_str(), block_samples_);
+}
+
+AudioSpool::~AudioSpool() {
+    try {
+        finish();
+    } catch (const std::exception& e) {
+        log_warn("spool: %s", e.what());
+    }
+}
+
+void AudioSpool::append(const int16_t* samples, std::size_t n) {
+    if (n == 0) return;
+    std::lock_guard lk(mtx_);
+    if (finished_) return;
+    while (n > 0) {
+        std::size_t room = block_samples_ - fill_.size();
+        std::size_t take = n < room ? n : room;
+        fill_.insert(fill_.end(), samples, samples + take);
+        samples += take;
+        n -= take;
+        appended_.fetch_add(take, std::memory_order_relaxed);
+        if (fill_.size() == block_samples_) {
+            full_.push_back(std::move(fill_));
+            if (!spare_.empty()) {
+                fill_ = std::move(spare_.back());
+                spare_.pop_back();
+            } else {
+                // Writer is behind — fall back to a fresh block.
+                fill_ = std::vector<int16_t>();
+                fill_.reserve(block_samples_);
+            }
+        }
+    }
+}
+
+void AudioSpool::writer_loop() {
+    std::vector<std::vector<int16_t>> batch;
+    auto last_commit = std::chrono::steady_clock::now();
+    std::size_t committed = 0;
+    std::unique_lock lk(mtx_);
+    while (!stop_) {
+        cv_.wait_for(lk, kWriterPeriod, [this] { return stop_; });
+        if (!full_.empty()) {
+            batch.swap(full_);
+            lk.unlock();
+            write_blocks(batch);
+            lk.lock();
+            for (auto& b : batch) {
+                b.clear();
+                spare_.push_back(std::move(b));
+            }
+            batch.clear();
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_commit >= commit_period_ && written_samples_ != committed) {
+            lk.unlock();
+            commit();
+            lk.lock();
+            committed = written_samples_;
+            last_commit = now;
+        }
+    }
+}
+
+bool AudioSpool::commit() {
+    // Data before header: once the new sizes are visible they only ever
+    // cover bytes that are already durable.
+    if (!error_.empty()) return false;
+    if (::fdatasync(fd_) != 0) {
+        error_ = "Capture spool sync failed: " + path_.string() +
+                 " (" + std::strerror(errno) + ")";
+        log_warn("spool: %s", error_.c_str());
+        return false;
+    }
+    uint8_t header[SPOOL_WAV_HEADER_BYTES];
+    build_spool_wav_header(header, static_cast<uint64_t>(written_samples_) * sizeof(int16_t),
+                               channels_);
+    if (::pwrite(fd_, header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+        error_ = "Capture spool header update failed: " + path_.string() +
+                 " (" + std::strerror(errno) + ")";
+        log_warn("spool: %s", error_.c_str());
+        return false;
+    }
+    return true;
+}
+
+void AudioSpool::write_blocks(std::vector<std::vector<int16_t>>& blocks) {
+    // After the first failure the remaining audio is dropped rather than
+    // retried — a full or failed disk will not recover mid-meeting, and the
+    // error surfaces from finish() so the caller can report it.
+    if (!error_.empty()) return;
+    for (const auto& b : blocks) {
+        if (b.empty()) continue;
+        try {
+            write_all(b.data(), b.size() * sizeof(int16_t));
+            written_samples_ += b.size();
+            readable_.store(written_samples_, std::memory_order_release);
+        } catch (const std::exception& e) {
+            error_ = e.what();
+            log_warn("spool: %s", e.what());
+            return;
+        }
+    }
+}
+
+void AudioSpool::write_all(const void* data, std::size_t bytes) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    while (bytes > 0) {
+        ssize_t w = ::write(fd_, p, bytes);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            throw RecmeetError("Capture spool write failed: " + path_.string() +
+                               " (" + std::strerror(errno) + ")");
+        }
+        p += w;
+        bytes -= static_cast<std::size_t>(w);
+    }
+}
+
+SpooledAudio AudioSpool::finish() {
+    {
+        std::lock_guard lk(mtx_);
+        if (finished_) return SpooledAudio{path_, written_samples_ / channels_, channels_};
+        finished_ = true;
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (writer_.joinable()) writer_.join();
+
+    // Writer has exited; the remaining queue and the partial tail block are
+    // owned exclusively by this thread now.
+    if (!fill_.empty()) full_.push_back(std::move(fill_));
+    write_blocks(full_);
+    full_.clear();
+    spare_.clear();
+
+    if (error_.empty()) {
+        // Final commit covers the tail, then sync the header itself.
+        if (commit() && ::fdatasync(fd_) != 0)
+            error_ = "Capture spool sync failed: " + path_.string() +
+                     " (" + std::strerror(errno) + ")";
+    } else {
+        // Patch the sizes even after a write failure so whatever audio did
+        // land on disk remains a readable WAV.
+        uint8_t header[SPOOL_WAV_HEADER_BYTES];
+        build_spool_wav_header(header, static_cast<uint64_t>(written_samples_) * sizeof(int16_t),
+                               channels_);
+        (void)!::pwrite(fd_, header, sizeof(header), 0);
+    }
+    ::close(fd_);
+    fd_ = -1;
+
+    log_debug("spool: closed %s (%zu samples, %.1fs)",
+              path_.c_str(), written_samples_,
+              static_cast<double>(written_samples_) / SAMPLE_RATE);
+    if (!error_.empty())
+        throw RecmeetError(error_);
+    return SpooledAudio{path_, written_samples_ / channels_, channels_};
+}
+
+} // namespace recmeet
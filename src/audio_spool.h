@@ -0,0 +1,151 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace recmeet {
+
+/// Samples per spool block — one second of S16LE mono 16 kHz audio (32 KB).
+/// The capture thread fills one block at a time; full blocks are handed to
+/// the spool's writer thread and written to disk, so the resident footprint
+/// of a capture stream is a handful of blocks regardless of meeting length.
+constexpr std::size_t SPOOL_BLOCK_SAMPLES = SAMPLE_RATE;
+
+/// Size of the spool's WAV header. Larger than the canonical 44 bytes: the
+/// header reserves space for an in-place RF64 upgrade (see audio_spool.cpp)
+/// so recordings past the 4 GB RIFF limit stay valid.
+constexpr std::size_t SPOOL_WAV_HEADER_BYTES = 80;
+
+/// Header-commit cadence. Every period the spool writer fdatasync()s the
+/// data written so far and then rewrites the size fields to cover it, so a
+/// killed process leaves a playable file missing at most about one period
+/// plus whatever was still queued — and finish() only has the tail to flush.
+constexpr std::chrono::milliseconds SPOOL_COMMIT_PERIOD{2000};
+
+/// Write the spool's 80-byte header for `data_bytes` of PCM into `h`. Plain
+/// RIFF/WAVE (with a 28-byte JUNK chunk) while the RIFF size fits 32 bits,
+/// RF64 with a ds64 chunk in the same bytes beyond that. `channels` are
+/// interleaved.
+void build_spool_wav_header(uint8_t* h, uint64_t data_bytes, int channels = CHANNELS);
+
+/// Handle to a finished capture spool. Returned by
+/// `PipeWireCapture::finish_spool()` / `PulseMonitorCapture::finish_spool()`
+/// in place of the in-memory `drain()` vector. The file at `path` is a
+/// complete 16 kHz S16LE WAV — mono unless the spool was opened with more
+/// channels — and a mono one can be handed straight to postprocessing
+/// (`PostprocessInput::audio_path`).
+struct SpooledAudio {
+    fs::path path;
+    std::size_t samples = 0;  ///< per channel
+    int channels = CHANNELS;
+
+    bool empty() const { return path.empty(); }
+    double duration_seconds() const {
+        return static_cast<double>(samples) / SAMPLE_RATE;
+    }
+};
+
+/// Streaming spill-to-disk buffer for one capture stream.
+///
+/// The file is opened (and a placeholder WAV header written) at
+/// construction. `append()` copies samples into a preallocated block under a
+/// short mutex; once a block is full it is queued for the writer thread,
+/// which performs the blocking write(2) calls off the capture thread. The
+/// writer wakes on its own timer rather than being notified, so `append()`
+/// never issues a syscall.
+///
+/// Crash safety: every couple of seconds the writer fdatasync()s the data
+/// and rewrites the RIFF/data size fields to cover it, so the file on disk
+/// is always a playable WAV — if the process dies mid-meeting only the last
+/// few seconds are lost. Files that outgrow the 32-bit RIFF size become
+/// RF64 in place. `finish()` stops the writer, flushes the tail block,
+/// commits the final sizes, and closes the file.
+///
+/// I/O errors on the writer thread are latched and re-thrown as
+/// RecmeetError from `finish()` — the capture thread never sees them.
+class AudioSpool {
+public:
+    /// Open `path` for writing (truncating any existing file). With
+    /// `channels` > 1, append() takes interleaved frames and the counts
+    /// below are of samples across all channels. Throws RecmeetError if the
+    /// file cannot be created.
+    explicit AudioSpool(const fs::path& path,
+                        std::size_t block_samples = SPOOL_BLOCK_SAMPLES,
+                        std::chrono::milliseconds commit_period = SPOOL_COMMIT_PERIOD,
+                        int channels = CHANNELS);
+    ~AudioSpool();
+
+    AudioSpool(const AudioSpool&) = delete;
+    AudioSpool& operator=(const AudioSpool&) = delete;
+
+    /// Append samples. Safe to call from the capture thread: takes only the
+    /// spool's internal mutex and allocates only when the writer thread has
+    /// fallen behind by more than the preallocated block pool.
+    void append(const int16_t* samples, std::size_t n);
+
+    /// AudioChunkCallback-compatible trampoline to append() — lets a spool
+    /// be installed directly as a capture's batch sink.
+    static void on_audio(const int16_t* samples, std::size_t n, void* spool) {
+        static_cast<AudioSpool*>(spool)->append(samples, n);
+    }
+
+    /// Flush all queued blocks, finalize the WAV header, close the file and
+    /// return the handle. Idempotent — a second call returns the same
+    /// handle. Throws RecmeetError if any write failed.
+    SpooledAudio finish();
+
+    /// Total samples accepted by append() so far.
+    std::size_t samples_appended() const {
+        return appended_.load(std::memory_order_relaxed);
+    }
+
+    /// Samples already written to the file (not necessarily synced). A
+    /// reader that opens path() can pread() this many samples past the
+    /// header — see SpoolSampleSource.
+    std::size_t samples_written() const {
+        return readable_.load(std::memory_order_acquire);
+    }
+
+    const fs::path& path() const { return path_; }
+
+private:
+    void writer_loop();
+    void write_blocks(std::vector<std::vector<int16_t>>& blocks);
+    void write_all(const void* data, std::size_t bytes);
+    bool commit();  // fdatasync + header rewrite; writer-thread / finish() only
+
+    fs::path path_;
+    std::size_t block_samples_;
+    std::chrono::milliseconds commit_period_;
+    int channels_;
+    int fd_ = -1;
+
+    std::mutex mtx_;
+    std::vector<int16_t> fill_;                 // block currently being filled
+    std::vector<std::vector<int16_t>> full_;    // blocks awaiting the writer
+    std::vector<std::vector<int16_t>> spare_;   // recycled, capacity-reserved blocks
+
+    std::condition_variable cv_;
+    bool stop_ = false;
+    std::thread writer_;
+
+    std::atomic<std::size_t> appended_{0};
+    std::atomic<std::size_t> readable_{0};  // mirrors written_samples_ for readers
+    std::size_t written_samples_ = 0;  // writer-thread / finish() only
+    std::string error_;                // writer-thread / finish() only
+    bool finished_ = false;
+};
+
+} // namespace recmeet
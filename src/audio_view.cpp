@@ -0,0 +1,206 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "audio_view.h"
+#include "audio_file.h"
+#include "log.h"
+#include "resample.h"
+#include "sample_kernels.h"
+#include "sparse_audio.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace recmeet {
+
+namespace {
+
+uint16_t get_u16(const uint8_t* p) { return uint16_t(p[0] | p[1] << 8); }
+
+uint32_t get_u32(const uint8_t* p) {
+    return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+}
+
+uint64_t get_u64(const uint8_t* p) {
+    return uint64_t(get_u32(p)) | uint64_t(get_u32(p + 4)) << 32;
+}
+
+constexpr uint16_t kFormatPcm = 1;
+constexpr uint16_t kFormatExtensible = 0xFFFE;
+
+/// Locate the PCM payload of a WAV image we can serve without decoding:
+/// RIFF or RF64, PCM (or extensible PCM) 16-bit mono at SAMPLE_RATE.
+/// Returns false for anything else so the caller falls back to libsndfile.
+bool find_pcm16_mono(const uint8_t* p, std::size_t len,
+                     std::size_t& data_off, std::size_t& data_len) {
+    if (len < 12 || std::memcmp(p + 8, "WAVE", 4) != 0) return false;
+    const bool rf64 = std::memcmp(p, "RF64", 4) == 0;
+    if (!rf64 && std::memcmp(p, "RIFF", 4) != 0) return false;
+
+    uint64_t ds64_data = 0;
+    bool fmt_ok = false;
+    std::size_t off = 12;
+    while (off + 8 <= len) {
+        const uint8_t* c = p + off;
+        uint64_t size = get_u32(c + 4);
+        const std::size_t body = off + 8;
+
+        if (std::memcmp(c, "ds64", 4) == 0 && size >= 24 && body + 24 <= len) {
+            ds64_data = get_u64(c + 16);
+        } else if (std::memcmp(c, "fmt ", 4) == 0 && size >= 16 && body + 16 <= len) {
+            uint16_t tag = get_u16(c + 8);
+            if (tag == kFormatExtensible && size >= 40 && body + 40 <= len)
+                tag = get_u16(c + 32);  // SubFormat GUID's first two bytes
+            fmt_ok = tag == kFormatPcm && get_u16(c + 10) == 1 &&
+                     get_u32(c + 12) == static_cast<uint32_t>(SAMPLE_RATE) &&
+                     get_u16(c + 22) == 16;
+        } else if (std::memcmp(c, "data", 4) == 0) {
+            if (!fmt_ok || body % 2 != 0) return false;
+            if (rf64 && size == 0xFFFFFFFFu) size = ds64_data;
+            // A header that outruns the file (crash before the final
+            // commit, copy in progress) is clamped to the bytes present.
+            data_off = body;
+            data_len = static_cast<std::size_t>(std::min<uint64_t>(size, len - body)) & ~std::size_t(1);
+            return true;
+        }
+        off = body + static_cast<std::size_t>(size) + (size & 1);  // chunks are word-aligned
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+AudioView::AudioView(const fs::path& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw RecmeetError("Failed to open WAV for reading: " + path.string() +
+                           " (" + std::strerror(errno) + ")");
+
+    struct stat st{};
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        map_len_ = static_cast<std::size_t>(st.st_size);
+        map_ = ::mmap(nullptr, map_len_, PROT_READ, MAP_SHARED, fd, 0);
+        if (map_ == MAP_FAILED) {
+            log_debug("audio_view: mmap %s failed (%s); decoding instead",
+                      path.c_str(), std::strerror(errno));
+            map_ = nullptr;
+            map_len_ = 0;
+        }
+    }
+    ::close(fd);
+
+    std::size_t data_off = 0, data_len = 0;
+    if (map_ && find_pcm16_mono(static_cast<const uint8_t*>(map_), map_len_,
+                                data_off, data_len) && data_len > 0) {
+        pcm_ = reinterpret_cast<const int16_t*>(static_cast<const uint8_t*>(map_) + data_off);
+        pcm_offset_ = data_off;
+        stored_ = size_ = data_len / sizeof(int16_t);
+        // Consumers walk the file front to back (VAD, whisper, chunked
+        // diarization): let the kernel read ahead and drop pages behind.
+        ::madvise(map_, map_len_, MADV_SEQUENTIAL);
+        log_debug("audio_view: mapped %s (%zu samples)", path.c_str(), size_);
+        attach_sparse_index(path);
+        return;
+    }
+
+    if (map_) {
+        ::munmap(map_, map_len_);
+        map_ = nullptr;
+        map_len_ = 0;
+    }
+    if (decodes_through_ffmpeg(path)) {
+        decoder_ = std::make_unique<FfmpegSampleSource>(path);
+        resampled_ = true;
+    } else if (auto sf = std::make_unique<SndfileSampleSource>(path);
+               sf->sample_rate() != SAMPLE_RATE) {
+        const int rate = sf->sample_rate();
+        decoder_ = std::make_unique<ResampledSampleSource>(std::move(sf), rate);
+        resampled_ = true;
+        log_info("Resampling %s from %d Hz to %d Hz", path.filename().c_str(), rate,
+                 SAMPLE_RATE);
+    } else {
+        decoder_ = std::move(sf);
+    }
+    stored_ = size_ = decoder_->size();
+    if (size_ == 0)
+        throw RecmeetError("WAV file contains no data: " + path.string());
+    log_debug("audio_view: decoding %s on demand (%zu samples, not S16LE mono WAV)",
+              path.c_str(), size_);
+    attach_sparse_index(path);
+}
+
+AudioView::~AudioView() {
+    if (map_) ::munmap(map_, map_len_);
+}
+
+void AudioView::attach_sparse_index(const fs::path& path) {
+    const fs::path index_path = sparse_index_path(path);
+    if (!fs::exists(index_path)) return;
+    auto index = std::make_unique<SparseAudioIndex>();
+    if (!load_sparse_index(index_path, stored_, *index)) {
+        log_warn("Ignoring %s: it does not describe %s",
+                 index_path.filename().c_str(), path.filename().c_str());
+        return;
+    }
+    sparse_ = std::move(index);
+    size_ = static_cast<std::size_t>(sparse_->total_samples);
+    log_debug("audio_view: %s is speech-only (%zu of %zu samples stored)",
+              path.c_str(), stored_, size_);
+}
+
+std::string AudioView::original_hash() const {
+    return sparse_ ? sparse_->audio_hash : std::string();
+}
+
+std::size_t AudioView::read_stored(std::size_t start, std::size_t n, float* out) const {
+    if (start >= stored_) return 0;
+    n = std::min(n, stored_ - start);
+    if (!pcm_)
+        return decoder_->read(start, n, out);
+    sample_kernels().s16_to_f32(pcm_ + start, out, n);
+    return n;
+}
+
+std::size_t AudioView::read(std::size_t start, std::size_t n, float* out) const {
+    if (!sparse_) return read_stored(start, n, out);
+    return read_sparse(*sparse_, start, n, out,
+                       [this](std::size_t pos, std::size_t count, float* dst) {
+                           read_stored(pos, count, dst);
+                       });
+}
+
+bool AudioView::stored_range(std::size_t start, std::size_t n,
+                             std::size_t& stored_start, std::size_t& stored_n) const {
+    if (start >= size_ || n == 0) return false;
+    n = std::min(n, size_ - start);
+    if (sparse_) {
+        auto it = std::upper_bound(sparse_->pieces.begin(), sparse_->pieces.end(), start,
+                                   [](std::size_t pos, const SparsePiece& p) {
+                                       return pos < p.start + p.n;
+                                   });
+        if (it == sparse_->pieces.end() || it->start >= start + n) return false;
+        const std::size_t a = std::max<std::size_t>(start, it->start);
+        const std::size_t b = std::min<std::size_t>(start + n, it->start + it->n);
+        start = static_cast<std::size_t>(it->offset) + (a - it->start);
+        n = b - a;
+    }
+    stored_start = start;
+    stored_n = n;
+    return true;
+}
+
+bool AudioView::byte_range(std::size_t start, std::size_t n,
+                           uint64_t& first, uint64_t& last) const {
+    if (!pcm_ || !stored_range(start, n, start, n)) return false;
+    first = pcm_offset_ + start * sizeof(int16_t);
+    last = first + n * sizeof(int16_t) - 1;
+    return true;
+}
+
+} // namespace recmeet
@@ -0,0 +1,98 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "sample_source.h"
+#include "util.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace recmeet {
+
+struct SparseAudioIndex;
+
+/// File-backed SampleSource: a recording's samples for postprocessing.
+///
+/// Our own recordings (S16LE mono 16 kHz, plain RIFF or the spool's RF64)
+/// are mmap()ed and converted to float32 only for the window a consumer
+/// asks for, so VAD, whisper and diarization read int16 PCM straight from
+/// the page cache instead of holding a private float copy of the whole
+/// meeting (a 4 h recording is ~460 MB mapped vs ~920 MB decoded). Any
+/// other file (an archived FLAC/Opus meeting, a foreign WAV) is decoded on
+/// demand through a SndfileSampleSource, one requested range at a time, so
+/// callers never need a second code path. A file at another rate (a 44.1
+/// or 48 kHz stereo export) is resampled on demand the same way, through a
+/// ResampledSampleSource (resample.h); one only ffmpeg can decode (a
+/// phone's M4A or MP3) is decoded once, streamed through the resampler,
+/// by a FfmpegSampleSource.
+///
+/// A speech-only archive (sparse_audio.h) is served on the recording's
+/// original timeline: size() is the full length and the dropped silence
+/// reads as zeros.
+///
+/// Float conversion is sample_kernels().s16_to_f32 — bit-identical to
+/// read_wav_float(). The view is immutable after construction.
+class AudioView : public SampleSource {
+public:
+    /// Map `path`. Throws RecmeetError if the file cannot be opened or
+    /// contains no samples.
+    explicit AudioView(const fs::path& path);
+    ~AudioView() override;
+
+    AudioView(const AudioView&) = delete;
+    AudioView& operator=(const AudioView&) = delete;
+
+    std::size_t size() const override { return size_; }
+    std::size_t read(std::size_t start, std::size_t n, float* out) const override;
+
+    /// True when samples come from the file mapping rather than a decoder.
+    bool mapped() const { return pcm_ != nullptr; }
+
+    /// True when the file is not at SAMPLE_RATE (or not a format libsndfile
+    /// reads) and is served converted: samples are not the file's frames.
+    bool resampled() const { return resampled_; }
+
+    /// True when the file is a speech-only archive expanded through its
+    /// index.
+    bool sparse() const { return sparse_ != nullptr; }
+
+    /// hash_samples() of the recording before its silence was dropped, as
+    /// the sparse index keeps it. Empty when the view is not sparse or the
+    /// index has no hash.
+    std::string original_hash() const;
+
+    /// Where samples [start, start + n) of the recording sit in the file,
+    /// clamped to the samples present: the stretch itself, or for a sparse
+    /// view the part of it in the first stored piece it overlaps (dropped
+    /// silence is not in the file). False when that is empty.
+    bool stored_range(std::size_t start, std::size_t n,
+                      std::size_t& stored_start, std::size_t& stored_n) const;
+
+    /// Inclusive file byte range holding samples [start, start + n) — their
+    /// stored_range() — what an HTTP Range request for that stretch of the
+    /// recording asks for. False when the view is decoded (no fixed byte
+    /// offset per sample) or the range is empty.
+    bool byte_range(std::size_t start, std::size_t n, uint64_t& first, uint64_t& last) const;
+
+private:
+    /// Samples [start, start + n) of the file itself, clamped.
+    std::size_t read_stored(std::size_t start, std::size_t n, float* out) const;
+    /// Expand through the sparse index beside `path`, if there is one.
+    void attach_sparse_index(const fs::path& path);
+
+    void* map_ = nullptr;
+    std::size_t map_len_ = 0;
+    std::size_t pcm_offset_ = 0;  ///< file offset of sample 0 when mapped
+    const int16_t* pcm_ = nullptr;
+    std::unique_ptr<SampleSource> decoder_;
+    bool resampled_ = false;
+    std::unique_ptr<SparseAudioIndex> sparse_;
+    std::size_t stored_ = 0;  ///< samples in the file
+    std::size_t size_ = 0;    ///< samples on the recording's timeline
+};
+
+} // namespace recmeet
@@ -0,0 +1,228 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "autotune.h"
+#include "audio_file.h"
+#include "backend_info.h"
+#include "log.h"
+#include "model_manager.h"
+#include "transcribe.h"
+#if RECMEET_USE_SHERPA
+#include "vad.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+namespace recmeet {
+
+namespace {
+
+constexpr const char* REFERENCE_CLIP = "biden_trump_debate_2020.wav";
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+// Rank by size: a quantized variant competes with its original.
+size_t model_rank(const std::string& model) {
+    const auto& models = autotune_models();
+    const std::string size = whisper_model_size(model);
+    return static_cast<size_t>(std::find(models.begin(), models.end(), size) - models.begin());
+}
+
+// Decode `pcm` once; language pinned so every trial does the same work.
+double time_decode(WhisperModel& model, const std::vector<float>& pcm, int threads) {
+    auto t0 = Clock::now();
+    transcribe(model, pcm.data(), pcm.size(), 0.0, "en", threads);
+    return seconds_since(t0);
+}
+
+} // anonymous namespace
+
+const std::vector<std::string>& autotune_models() {
+    static const std::vector<std::string> models = {"tiny", "base", "small", "medium", "large-v3"};
+    return models;
+}
+
+std::vector<int> autotune_thread_candidates(int hw) {
+    hw = std::max(hw, 1);
+    std::vector<int> out = {std::max(hw / 4, 1), std::max(hw / 2, 1), std::max(hw - 1, 1), hw};
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+TuneTrial pick_tuning(const std::vector<TuneTrial>& trials, double target_rtf) {
+    const TuneTrial* best = nullptr;
+    for (const auto& t : trials) {
+        if (t.rtf > target_rtf) continue;
+        if (!best || model_rank(t.model) > model_rank(best->model) ||
+            (model_rank(t.model) == model_rank(best->model) && t.rtf < best->rtf))
+            best = &t;
+    }
+    if (best) return *best;
+    best = &trials.front();
+    for (const auto& t : trials)
+        if (t.rtf < best->rtf) best = &t;
+    return *best;
+}
+
+std::string tune_profile_yaml(const TuneProfile& p) {
+    std::ostringstream out;
+    char rtf[64];
+    std::snprintf(rtf, sizeof(rtf), "RTF %.3f, target %.3f", p.rtf, p.target_rtf);
+    out << "# Written by `recmeet --autotune` on " << p.host << " (" << rtf << ").\n"
+        << "# Keys set in config.yaml or on the command line take precedence.\n"
+        << "transcription:\n"
+        << "  model: " << p.whisper_model << "\n"
+        << "  gpu: " << (p.gpu ? "true" : "false") << "\n"
+        << "\ngeneral:\n"
+        << "  threads: " << p.threads << "\n"
+        << "\nvad:\n"
+        << "  enabled: " << (p.vad ? "true" : "false") << "\n";
+    return out.str();
+}
+
+fs::path find_reference_clip() {
+    if (const char* env = std::getenv("RECMEET_AUTOTUNE_CLIP")) {
+        if (*env) return fs::exists(env) ? fs::path(env) : fs::path();
+    }
+    std::error_code ec;
+    fs::path self = fs::read_symlink("/proc/self/exe", ec);
+    std::vector<fs::path> candidates;
+    if (!ec && !self.empty()) {
+        const fs::path exe_dir = self.parent_path();
+        candidates.push_back((exe_dir / ".." / "share" / "recmeet" / REFERENCE_CLIP).lexically_normal());
+        candidates.push_back((exe_dir / ".." / "assets" / REFERENCE_CLIP).lexically_normal());
+    }
+    candidates.push_back(fs::path("assets") / REFERENCE_CLIP);
+    for (const auto& c : candidates)
+        if (fs::exists(c, ec)) return c;
+    return {};
+}
+
+TuneProfile run_autotune(const Config& cfg, const AutotuneOptions& opts) {
+    const fs::path clip = opts.clip.empty() ? find_reference_clip() : opts.clip;
+    if (clip.empty())
+        throw RecmeetError(std::string("Reference clip ") + REFERENCE_CLIP +
+                           " not found (set RECMEET_AUTOTUNE_CLIP)");
+    auto pcm = read_wav_float(clip);
+    pcm.resize(std::min(pcm.size(), static_cast<size_t>(AUTOTUNE_CLIP_SEC * SAMPLE_RATE)));
+    if (pcm.empty())
+        throw RecmeetError("Reference clip is empty: " + clip.string());
+    const double clip_sec = static_cast<double>(pcm.size()) / SAMPLE_RATE;
+    log_info("autotune: %.0fs of %s, target RTF %.2f", clip_sec, clip.filename().c_str(),
+             opts.target_rtf);
+
+    // Per size, its cached variants (original first).
+    std::vector<std::vector<std::string>> models;
+    for (const auto& size : autotune_models()) {
+        std::vector<std::string> cached;
+        for (const auto& name : whisper_model_variants(size))
+            if (is_whisper_model_cached(name)) cached.push_back(name);
+        if (!cached.empty()) models.push_back(std::move(cached));
+    }
+    if (models.empty()) models.push_back({"base"});
+
+    std::vector<bool> backends = {false};
+    if (active_backend_is_gpu()) backends.push_back(true);
+
+    const int hw = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+    std::vector<TuneTrial> trials;
+    auto run_trial = [&](const std::string& name, bool gpu, int threads) {
+        WhisperModel model(ensure_whisper_model(name), gpu);
+        TuneTrial t{name, gpu, threads, time_decode(model, pcm, threads) / clip_sec};
+        log_info("autotune: %s on %s, %d threads: RTF %.3f", name.c_str(),
+                 gpu ? "GPU" : "CPU", threads, t.rtf);
+        if (opts.on_trial) opts.on_trial(t);
+        trials.push_back(t);
+        return t;
+    };
+
+    for (bool gpu : backends) {
+        // Threads matter little with the GPU doing the work; on the CPU
+        // sweep them on the cheapest model and keep the fastest.
+        const auto thread_counts = gpu ? std::vector<int>{default_thread_count()}
+                                       : autotune_thread_candidates(hw);
+        TuneTrial fastest;
+        for (int threads : thread_counts) {
+            auto t = run_trial(models.front().front(), gpu, threads);
+            if (fastest.model.empty() || t.rtf < fastest.rtf) fastest = t;
+        }
+        // Each size's variants at that count. Larger sizes only get
+        // slower: stop after the first size none of whose variants meets
+        // the target.
+        bool met = fastest.rtf <= opts.target_rtf;
+        for (size_t v = 1; v < models.front().size(); ++v)
+            if (run_trial(models.front()[v], gpu, fastest.threads).rtf <= opts.target_rtf)
+                met = true;
+        for (size_t i = 1; i < models.size() && met; ++i) {
+            met = false;
+            for (const auto& name : models[i])
+                if (run_trial(name, gpu, fastest.threads).rtf <= opts.target_rtf) met = true;
+        }
+    }
+
+    const TuneTrial best = pick_tuning(trials, opts.target_rtf);
+    if (!best.gpu && whisper_model_variant(best.model) == "f16") {
+        const auto variants = whisper_model_variants(best.model);
+        if (variants.size() > 1)
+            log_info("autotune: %s runs on the CPU, where a quantized variant such as %s "
+                     "usually decodes faster; fetch it with `recmeet --model %s "
+                     "--download-models` and tune again",
+                     best.model.c_str(), variants[1].c_str(), variants[1].c_str());
+    }
+    TuneProfile profile;
+    profile.host = host_name();
+    profile.whisper_model = best.model;
+    profile.threads = best.threads;
+    profile.gpu = best.gpu;
+    profile.rtf = best.rtf;
+    profile.target_rtf = opts.target_rtf;
+
+#if RECMEET_USE_SHERPA
+    // VAD costs a Silero pass but spares whisper the silence; keep it
+    // unless detection plus decoding the speech is slower than one decode
+    // of everything.
+    try {
+        WhisperModel model(ensure_whisper_model(best.model), best.gpu);
+        const double full_sec = time_decode(model, pcm, best.threads);
+
+        VadConfig vad_cfg;
+        vad_cfg.threshold = cfg.vad_threshold;
+        vad_cfg.min_silence_duration = cfg.vad_min_silence;
+        vad_cfg.min_speech_duration = cfg.vad_min_speech;
+        vad_cfg.max_speech_duration = cfg.vad_max_speech;
+        auto t0 = Clock::now();
+        auto vad = detect_speech(pcm, vad_cfg, best.threads);
+        std::vector<TranscribeWindow> windows;
+        for (const auto& seg : vad.segments)
+            windows.push_back({static_cast<size_t>(seg.start_sample),
+                               static_cast<size_t>(seg.end_sample - seg.start_sample)});
+        MemorySampleSource source(pcm.data(), pcm.size());
+        TranscribeOptions topts;
+        topts.language = "en";
+        topts.threads = best.threads;
+        transcribe_windows(model, source, pack_windows(windows), cfg.whisper_workers, topts);
+        const double vad_sec = seconds_since(t0);
+        profile.vad = vad_sec <= full_sec;
+        log_info("autotune: VAD + %zu segments %.1fs vs whole clip %.1fs",
+                 windows.size(), vad_sec, full_sec);
+    } catch (const std::exception& e) {
+        log_warn("autotune: VAD comparison failed (%s); keeping VAD on", e.what());
+    }
+#else
+    (void)cfg;
+    profile.vad = false;
+#endif
+    return profile;
+}
+
+} // namespace recmeet
@@ -0,0 +1,88 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "config.h"
+#include "util.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Hardware autotuner (`recmeet --autotune`)
+//
+// Times whisper on a reference clip for the model sizes cached on this
+// host, on the CPU and (when one enumerates) the GPU backend, and over a
+// few thread counts. The best fit for a target real-time factor is written
+// to the host's tune profile (tune_profile_path()), which load_config()
+// layers under the user's config file: whatever config.yaml or the command
+// line sets explicitly still wins.
+// ---------------------------------------------------------------------------
+
+/// Default target real-time factor: a meeting is transcribed in a quarter
+/// of its length.
+constexpr double AUTOTUNE_TARGET_RTF = 0.25;
+
+/// Seconds of the reference clip each trial decodes.
+constexpr double AUTOTUNE_CLIP_SEC = 60.0;
+
+/// Whisper model sizes the tuner considers, smallest (fastest) first.
+const std::vector<std::string>& autotune_models();
+
+/// Thread counts worth timing on a host with `hw` hardware threads: a
+/// quarter, half, all but one and all of them, deduplicated, ascending,
+/// at least 1.
+std::vector<int> autotune_thread_candidates(int hw);
+
+/// One timed configuration.
+struct TuneTrial {
+    std::string model;
+    bool gpu = false;
+    int threads = 0;
+    double rtf = 0.0;  ///< decode seconds per second of audio
+};
+
+/// The recommendation among `trials` (not empty): the largest model
+/// (autotune_models() order) with a trial at or under `target_rtf`, by its
+/// fastest such trial; when none meets the target, the fastest trial.
+TuneTrial pick_tuning(const std::vector<TuneTrial>& trials, double target_rtf);
+
+/// What the tuner recommends for this host.
+struct TuneProfile {
+    std::string host;
+    std::string whisper_model;
+    int threads = 0;
+    bool gpu = true;
+    bool vad = true;
+    double rtf = 0.0;  ///< measured for the chosen model, backend and threads
+    double target_rtf = AUTOTUNE_TARGET_RTF;
+};
+
+/// The profile as a config.yaml fragment, as written to tune_profile_path().
+std::string tune_profile_yaml(const TuneProfile& profile);
+
+/// The reference clip: $RECMEET_AUTOTUNE_CLIP, else
+/// biden_trump_debate_2020.wav from <exe-dir>/../share/recmeet (install) or
+/// the source tree's assets/ (<exe-dir>/../assets, or ./assets). Empty when
+/// none exists.
+fs::path find_reference_clip();
+
+struct AutotuneOptions {
+    double target_rtf = AUTOTUNE_TARGET_RTF;
+    fs::path clip;                                   ///< empty = find_reference_clip()
+    std::function<void(const TuneTrial&)> on_trial;  ///< after each timed trial
+};
+
+/// Run the benchmark with the whisper models already cached (`base` is
+/// downloaded when none is). The thread count is swept on the smallest
+/// model; larger models are timed at the fastest count until one misses
+/// the target. With VAD compiled in, the chosen configuration is also timed
+/// over the clip's speech windows to decide whether VAD pays for itself.
+/// Call after load_backends(). Throws RecmeetError (no clip, load failure).
+TuneProfile run_autotune(const Config& cfg, const AutotuneOptions& opts);
+
+} // namespace recmeet
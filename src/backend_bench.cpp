@@ -0,0 +1,236 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "backend_bench.h"
+#include "backend_info.h"
+#include "ipc_protocol.h"
+#include "log.h"
+#include "model_manager.h"
+#include "sha256.h"
+#include "summarize.h"
+#include "transcribe.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+namespace recmeet {
+
+namespace {
+
+constexpr size_t FINGERPRINT_SPAN = 1 << 20;
+
+// Flat-object parse via the IPC parser, as stage_perf.cpp does.
+bool parse_bench_line(const std::string& line, BackendBench& out) {
+    IpcMessage msg;
+    if (!parse_ipc_message("{\"id\":0,\"result\":" + line + "}", msg) ||
+        msg.type != IpcMessageType::Response)
+        return false;
+    const JsonMap& m = msg.response.result;
+    auto str = [&m](const char* key) {
+        auto it = m.find(key);
+        return it == m.end() ? std::string() : json_val_as_string(it->second);
+    };
+    auto num = [&m](const char* key) {
+        auto it = m.find(key);
+        return it == m.end() ? 0.0 : json_val_as_double(it->second);
+    };
+    out.model = str("model");
+    out.fingerprint = str("fingerprint");
+    out.device = str("device");
+    out.cpu_sec = num("cpu_sec");
+    out.gpu_sec = num("gpu_sec");
+    return !out.fingerprint.empty() && !out.device.empty();
+}
+
+std::string bench_line(const BackendBench& b) {
+    JsonMap m;
+    m["model"] = b.model;
+    m["fingerprint"] = b.fingerprint;
+    m["device"] = b.device;
+    m["cpu_sec"] = b.cpu_sec;
+    m["gpu_sec"] = b.gpu_sec;
+    return serialize_json_map(m);
+}
+
+std::vector<BackendBench> read_benches(const fs::path& file) {
+    std::vector<BackendBench> out;
+    std::ifstream in(file);
+    std::string line;
+    while (std::getline(in, line)) {
+        BackendBench b;
+        if (!line.empty() && parse_bench_line(line, b)) out.push_back(std::move(b));
+    }
+    return out;
+}
+
+// Serializes measuring across processes (daemon, pp-workers, CLI), so a
+// model is benchmarked once and never while another benchmark loads the
+// same GPU. Best effort: without the lock, measuring still works.
+class BenchLock {
+public:
+    explicit BenchLock(const fs::path& file) {
+        std::error_code ec;
+        fs::create_directories(file.parent_path(), ec);
+        const fs::path path = file.parent_path() / ("." + file.filename().string() + ".lock");
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            log_warn("backend bench: cannot lock %s (%s)", path.c_str(), std::strerror(errno));
+            return;
+        }
+        while (::flock(fd_, LOCK_EX) < 0 && errno == EINTR) {}
+    }
+    ~BenchLock() {
+        if (fd_ >= 0) ::close(fd_);
+    }
+    BenchLock(const BenchLock&) = delete;
+    BenchLock& operator=(const BenchLock&) = delete;
+
+private:
+    int fd_ = -1;
+};
+
+#if RECMEET_USE_LLAMA
+fs::path cached_llama_model(const std::string& name) {
+    if (name.empty()) return {};
+    try {
+        return ensure_llama_model(name);
+    } catch (const RecmeetError&) {
+        return {};
+    }
+}
+#endif
+
+} // anonymous namespace
+
+fs::path backend_bench_path() {
+    return data_dir() / "backend_bench.ndjson";
+}
+
+std::string model_fingerprint(const fs::path& model_path) {
+    std::ifstream in(model_path, std::ios::binary);
+    std::error_code ec;
+    const uint64_t size = fs::file_size(model_path, ec);
+    if (!in || ec)
+        throw RecmeetError("Cannot read model for fingerprint: " + model_path.string());
+    Sha256 h;
+    const std::string size_text = std::to_string(size);
+    h.update(size_text.data(), size_text.size());
+    std::vector<char> buf(FINGERPRINT_SPAN);
+    auto span = [&](uint64_t offset) {
+        in.clear();
+        in.seekg(static_cast<std::streamoff>(offset));
+        in.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+        h.update(buf.data(), static_cast<size_t>(in.gcount()));
+    };
+    span(0);
+    if (size > FINGERPRINT_SPAN) span(std::max<uint64_t>(size - FINGERPRINT_SPAN, FINGERPRINT_SPAN));
+    return h.hex_digest();
+}
+
+bool find_backend_bench(const fs::path& file, const std::string& fingerprint,
+                        const std::string& device, BackendBench& out) {
+    for (auto& b : read_benches(file)) {
+        if (b.fingerprint == fingerprint && b.device == device) {
+            out = std::move(b);
+            return true;
+        }
+    }
+    return false;
+}
+
+void store_backend_bench(const fs::path& file, const BackendBench& bench) {
+    std::string body;
+    for (const auto& b : read_benches(file))
+        if (b.fingerprint != bench.fingerprint || b.device != bench.device)
+            body += bench_line(b) + "\n";
+    body += bench_line(bench) + "\n";
+    std::error_code ec;
+    fs::create_directories(file.parent_path(), ec);
+    write_text_file_atomic(file, body);
+}
+
+bool bench_prefers_gpu(const BackendBench& bench) {
+    return bench.gpu_sec <= bench.cpu_sec;
+}
+
+bool choose_gpu_backend(const fs::path& model_path, const std::string& device,
+                        const BackendTimeFn& time_fn, bool cached_only, const fs::path& file) {
+    if (device.empty()) return false;
+    BackendBench bench;
+    try {
+        bench.fingerprint = model_fingerprint(model_path);
+    } catch (const RecmeetError& e) {
+        log_warn("backend bench: %s; keeping the GPU", e.what());
+        return true;
+    }
+    if (find_backend_bench(file, bench.fingerprint, device, bench))
+        return bench_prefers_gpu(bench);
+    if (cached_only) return true;
+
+    BenchLock lock(file);
+    // Another process may have measured while this one waited.
+    if (find_backend_bench(file, bench.fingerprint, device, bench))
+        return bench_prefers_gpu(bench);
+    const std::string name = model_path.filename().string();
+    log_info("backend bench: timing %s on the GPU and the CPU (once per model and driver)",
+             name.c_str());
+    try {
+        bench.gpu_sec = time_fn(true);
+        bench.cpu_sec = time_fn(false);
+    } catch (const std::exception& e) {
+        log_warn("backend bench: %s failed (%s); keeping the GPU", name.c_str(), e.what());
+        return true;
+    }
+    bench.model = name;
+    bench.device = device;
+    try {
+        store_backend_bench(file, bench);
+    } catch (const std::exception& e) {
+        log_warn("backend bench: cannot save %s (%s)", file.c_str(), e.what());
+    }
+    const bool gpu = bench_prefers_gpu(bench);
+    log_info("backend bench: %s takes %.2fs on the GPU, %.2fs on the CPU; using the %s",
+             name.c_str(), bench.gpu_sec, bench.cpu_sec, gpu ? "GPU" : "CPU");
+    return gpu;
+}
+
+bool whisper_gpu_for(const Config& cfg, const fs::path& model_path, bool cached_only) {
+    if (!cfg.whisper_gpu) return false;
+    if (!cfg.backend_bench) return active_backend_is_gpu();
+    return choose_gpu_backend(model_path, active_device_signature(),
+                              [&model_path](bool gpu) {
+                                  return time_whisper_backend(model_path, gpu);
+                              },
+                              cached_only);
+}
+
+void bench_configured_backends(const Config& cfg) {
+    // A remote worker runs the models on its own hardware.
+    if (!cfg.backend_bench || !cfg.remote_worker.empty() || active_device_signature().empty())
+        return;
+    for (const auto* name : {&cfg.whisper_model, &cfg.whisper_draft_model}) {
+        if (name->empty() || !is_whisper_model_cached(*name)) continue;
+        try {
+            whisper_gpu_for(cfg, ensure_whisper_model(*name));
+        } catch (const RecmeetError& e) {
+            log_warn("backend bench: whisper %s: %s", name->c_str(), e.what());
+        }
+    }
+#if RECMEET_USE_LLAMA
+    if (!cfg.no_summary && cfg.llm_gpu_layers < 0) {
+        for (const auto* name : {&cfg.llm_model, &cfg.llm_draft_model}) {
+            const fs::path path = cached_llama_model(*name);
+            if (!path.empty()) llama_gpu_for(path);
+        }
+    }
+#endif
+}
+
+} // namespace recmeet
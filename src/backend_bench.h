@@ -0,0 +1,76 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "config.h"
+#include "util.h"
+
+#include <functional>
+#include <string>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Per-model backend choice
+//
+// A GPU is not always faster: on an integrated GPU, whisper-tiny decodes
+// slower on Vulkan than on the AVX2 CPU plugin. The first time a model is
+// used beside a GPU device, a short benchmark times it on both, and the
+// result is kept in backend_bench_path() keyed by the model's fingerprint
+// and the device's signature (active_device_signature()). From then on the
+// model goes to whichever backend was faster; a new model file, GPU or
+// driver measures again.
+// ---------------------------------------------------------------------------
+
+/// One measurement: seconds per benchmark pass on each backend.
+struct BackendBench {
+    std::string model;        ///< file name, for reading the cache
+    std::string fingerprint;  ///< model_fingerprint()
+    std::string device;       ///< active_device_signature()
+    double cpu_sec = 0.0;
+    double gpu_sec = 0.0;
+};
+
+/// `<data_dir>/backend_bench.ndjson`: one BackendBench per line.
+fs::path backend_bench_path();
+
+/// Content fingerprint of a model file: SHA-256 of its size and its first
+/// and last MiB, so even a multi-GB model is identified without reading it
+/// all. Throws RecmeetError when the file cannot be read.
+std::string model_fingerprint(const fs::path& model_path);
+
+/// The entry of `file` for `fingerprint` on `device`. False when none.
+bool find_backend_bench(const fs::path& file, const std::string& fingerprint,
+                        const std::string& device, BackendBench& out);
+
+/// Add `bench` to `file`, replacing the entry with the same key.
+void store_backend_bench(const fs::path& file, const BackendBench& bench);
+
+/// Whether `bench` favours the GPU: at least as fast as the CPU.
+bool bench_prefers_gpu(const BackendBench& bench);
+
+/// Times one benchmark pass of a model on the GPU (true) or the CPU.
+using BackendTimeFn = std::function<double(bool gpu)>;
+
+/// Whether `model_path` should run on the GPU `device` (empty = no GPU,
+/// false). The cached verdict when `file` has one; otherwise, unless
+/// `cached_only`, it is measured with `time_fn` and stored. A measurement
+/// that throws is logged and not stored, and the GPU is kept. Holds a lock
+/// beside `file` while measuring, so concurrent processes measure once.
+bool choose_gpu_backend(const fs::path& model_path, const std::string& device,
+                        const BackendTimeFn& time_fn, bool cached_only = false,
+                        const fs::path& file = backend_bench_path());
+
+/// Whether whisper `model_path` runs on the GPU under `cfg`: never with
+/// transcription.gpu off; with general.backend_bench, only when the GPU
+/// measured at least as fast (choose_gpu_backend()); otherwise whenever a
+/// GPU device is active.
+bool whisper_gpu_for(const Config& cfg, const fs::path& model_path, bool cached_only = false);
+
+/// Measure the configured whisper models and local LLM that are already
+/// cached and not measured yet, so the first job does not have to. For the
+/// daemon at startup, off the IPC thread.
+void bench_configured_backends(const Config& cfg);
+
+} // namespace recmeet
@@ -11,9 +11,12 @@
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
+#include <mutex>
 #include <string>
 #include <thread>
 
+#include <sys/utsname.h>
+
 namespace recmeet {
 
 namespace fs = std::filesystem;
@@ -58,7 +61,9 @@ std::string join_registry_names() {
     return out;
 }
 
-// Find the best enumerable device: GPU > IGPU > ACCEL > CPU.
+// Find the best enumerable device: GPU > IGPU > ACCEL > CPU. Does not load
+// the backends; callers outside log_backend_summary() go through
+// active_device().
 ggml_backend_dev_t pick_active_device() {
     ggml_backend_dev_t gpu = nullptr, igpu = nullptr, accel = nullptr, cpu = nullptr;
     const size_t n = ggml_backend_dev_count();
@@ -91,6 +96,27 @@ const char* find_unenumerable_non_cpu_backend() {
     return nullptr;
 }
 
+// What changes when the GPU driver does. ggml reports no driver version,
+// so this stands in for one.
+std::string driver_stamp(const char* reg_name) {
+    std::string stamp;
+    struct utsname uts{};
+    if (::uname(&uts) == 0) stamp = uts.release;
+    if (std::strcmp(reg_name, "Vulkan") != 0) return stamp;
+    for (const char* dir : {"/usr/share/vulkan/icd.d", "/etc/vulkan/icd.d"}) {
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(dir, ec)) {
+            std::error_code fec;
+            const auto size = fs::file_size(entry.path(), fec);
+            const auto mtime = fs::last_write_time(entry.path(), fec);
+            if (fec) continue;
+            stamp += " " + entry.path().filename().string() + ":" + std::to_string(size) + ":" +
+                     std::to_string(mtime.time_since_epoch().count());
+        }
+    }
+    return stamp;
+}
+
 // Banner output: log_info captures the line in the persistent log when
 // RECMEET_LOG_LEVEL >= info, and an unconditional fprintf to stderr makes
 // it visible under journalctl / interactive even at the default `error`
@@ -118,22 +144,39 @@ void banner_warn(const char* fmt, ...) {
     fprintf(stderr, "%s\n", buf);
 }
 
+std::once_flag g_load_once;
+std::once_flag g_summary_once;
+
+ggml_backend_dev_t active_device() {
+    ensure_backends();
+    return pick_active_device();
+}
+
 } // namespace
 
 void load_backends() {
-    const fs::path dir = resolve_plugin_dir();
-    if (!dir.empty()) {
-        ggml_backend_load_all_from_path(dir.c_str());
-    } else {
-        // Last-resort: let ggml try its baked-in search chain (GGML_BACKEND_DIR
-        // → executable dir → CWD). The compile-time GGML_BACKEND_DIR pin to
-        // $ORIGIN/../lib is dead string from dlopen's perspective but the
-        // executable-dir fallback may still strike paydirt on unusual layouts.
-        ggml_backend_load_all();
-    }
+    // A second load would register every plugin twice.
+    std::call_once(g_load_once, [] {
+        const fs::path dir = resolve_plugin_dir();
+        if (!dir.empty()) {
+            ggml_backend_load_all_from_path(dir.c_str());
+        } else {
+            // Last-resort: let ggml try its baked-in search chain (GGML_BACKEND_DIR
+            // → executable dir → CWD). The compile-time GGML_BACKEND_DIR pin to
+            // $ORIGIN/../lib is dead string from dlopen's perspective but the
+            // executable-dir fallback may still strike paydirt on unusual layouts.
+            ggml_backend_load_all();
+        }
+    });
+}
+
+void ensure_backends() {
+    load_backends();
+    std::call_once(g_summary_once, log_backend_summary);
 }
 
 void log_backend_summary() {
+    load_backends();
     const std::string regs = join_registry_names();
     banner_emit("ggml: backend registry: %s", regs.empty() ? "(none)" : regs.c_str());
 
@@ -171,4 +214,50 @@ void log_backend_summary() {
     }
 }
 
+bool active_backend_is_gpu() {
+    auto dev = active_device();
+    return dev && ggml_backend_dev_type(dev) != GGML_BACKEND_DEVICE_TYPE_CPU;
+}
+
+bool active_gpu_memory(size_t& free_bytes, size_t& total_bytes) {
+    auto dev = active_device();
+    if (!dev || ggml_backend_dev_type(dev) == GGML_BACKEND_DEVICE_TYPE_CPU) return false;
+    free_bytes = total_bytes = 0;
+    ggml_backend_dev_memory(dev, &free_bytes, &total_bytes);
+    return total_bytes > 0;
+}
+
+std::string active_device_signature() {
+    auto dev = active_device();
+    if (!dev || ggml_backend_dev_type(dev) == GGML_BACKEND_DEVICE_TYPE_CPU) return {};
+    ggml_backend_dev_props props{};
+    ggml_backend_dev_get_props(dev, &props);
+    const char* reg_name = "GPU";
+    if (auto reg = ggml_backend_dev_backend_reg(dev)) {
+        if (const char* n = ggml_backend_reg_name(reg)) reg_name = n;
+    }
+    const char* desc = props.description ? props.description
+                     : (props.name ? props.name : "(unknown device)");
+    return std::string(reg_name) + "|" + desc + "|" + driver_stamp(reg_name);
+}
+
+std::vector<GpuDevice> gpu_devices() {
+    ensure_backends();
+    std::vector<GpuDevice> out;
+    const size_t n = ggml_backend_dev_count();
+    for (size_t i = 0; i < n; ++i) {
+        auto dev = ggml_backend_dev_get(i);
+        if (ggml_backend_dev_type(dev) != GGML_BACKEND_DEVICE_TYPE_GPU) continue;
+        ggml_backend_dev_props props{};
+        ggml_backend_dev_get_props(dev, &props);
+        GpuDevice gpu;
+        gpu.index = static_cast<int>(out.size());
+        gpu.description = props.description ? props.description
+                        : (props.name ? props.name : "(unknown device)");
+        ggml_backend_dev_memory(dev, &gpu.free_bytes, &gpu.total_bytes);
+        out.push_back(std::move(gpu));
+    }
+    return out;
+}
+
 } // namespace recmeet
@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 namespace recmeet {
 
 // Discover and register the ggml backend plugins shipped alongside the
@@ -18,8 +22,16 @@ namespace recmeet {
 //   4. <exe-dir>         (alternate co-located layout)
 // Falls through to ggml_backend_load_all() (no explicit path) when none
 // match, preserving ggml's default executable-dir + CWD search chain.
+// Loads once per process; later calls return at once.
 void load_backends();
 
+// load_backends() plus, the first time, log_backend_summary(). Plugin
+// discovery dlopens every CPU variant and the Vulkan loader, which a thin
+// client (`recmeet --status`, `--list-sources`) should not pay for, so the
+// CLI leaves this to the first model load: WhisperModel, the llama model,
+// and the active_*() queries below all call it.
+void ensure_backends();
+
 // Enumerate ggml's registered backends after load_backends() and emit the
 // 2-line banner: (a) full registry list, (b) highest-priority enumerable
 // device (GPU > IGPU > ACCEL > CPU). When a non-CPU backend registered but
@@ -30,8 +42,40 @@ void load_backends();
 // Intended call order at process startup:
 //   recmeet::load_backends();
 //   recmeet::log_backend_summary();
+// (or ensure_backends(), which does both once).
 //
-// Once per process. Safe to call before any whisper context is created.
+// Safe to call before any whisper context is created.
 void log_backend_summary();
 
+// True when the device whisper will pick (same GPU > IGPU > ACCEL > CPU
+// order as the banner) is not the CPU. The pipeline uses this to decide
+// whether CPU-only diarization can overlap transcription. Call after
+// load_backends(); false when no device enumerates.
+bool active_backend_is_gpu();
+
+// Free and total memory, in bytes, of that device when it is not the CPU.
+// Local summarization sizes its llama layer offload from the free amount.
+// False for the CPU or a device that reports no memory.
+bool active_gpu_memory(size_t& free_bytes, size_t& total_bytes);
+
+// Identity of that device and its driver, for keying measurements made on
+// it: "<backend>|<description>|<driver stamp>". The stamp is the kernel
+// release plus, for Vulkan, the size and mtime of each installed ICD
+// manifest, which a driver upgrade rewrites. Empty for the CPU or when no
+// device enumerates.
+std::string active_device_signature();
+
+// One discrete GPU, numbered the way whisper_context_params::gpu_device
+// counts them: GPU-type devices in registry order.
+struct GpuDevice {
+    int index = 0;
+    std::string description;
+    size_t free_bytes = 0;   // 0 when the device does not report memory
+    size_t total_bytes = 0;
+};
+
+// Every discrete GPU ggml enumerates, for spreading transcription over
+// several (Config::whisper_gpu_devices). Empty on a CPU-only host.
+std::vector<GpuDevice> gpu_devices();
+
 } // namespace recmeet
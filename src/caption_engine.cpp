@@ -9,10 +9,16 @@
 //     a clear error message; no symbols from sherpa-onnx are referenced.
 
 #include "caption_engine.h"
+#include "cpu_topology.h"
 
 #include "log.h"
+#include "metrics.h"
+#include "model_memory.h"
+#include "sample_kernels.h"
+#include "trace.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
@@ -25,16 +31,28 @@
 
 #include <condition_variable>
 #include <filesystem>
+#include <set>
 #include <thread>
 #include <vector>
 
+#include <poll.h>
 #include <sched.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 #include <errno.h>
 #endif // RECMEET_USE_SHERPA
 
 namespace recmeet {
 
+#ifdef RECMEET_USE_SHERPA
+namespace {
+// Hand a stopped engine's recognizer, and the memory its load mapped, to
+// the warm slot (defined below).
+void keep_recognizer_warm(const std::string& key, const SherpaOnnxOnlineRecognizer* recognizer,
+                          ModelMemory memory);
+} // namespace
+#endif
+
 // ===========================================================================
 // Common Impl shape — declared regardless of build path so the header's
 // unique_ptr<Impl> sees a complete type when destructed.
@@ -49,37 +67,140 @@ struct CaptionEngine::Impl {
     std::atomic<std::size_t> degraded_emitted{0};
 
 #ifdef RECMEET_USE_SHERPA
-    // ----- Ring buffer (SPSC, lock-free for push/pop indices) ---------------
-    // Capacity is a power of two so the index mask is a single AND. Producer
-    // (capture thread) writes at `head_`; consumer (worker) reads at `tail_`.
-    // `samples_avail()` is a relaxed snapshot — both threads use it as a
-    // hint, never as a strict invariant.
-    std::vector<int16_t> ring;         // size == capacity, fixed at start()
-    std::size_t ring_mask = 0;
-    std::atomic<std::size_t> head{0};  // producer writes here
-    std::atomic<std::size_t> tail{0};  // consumer reads here
-    std::atomic<bool> overflow_seen{false};
+    // ----- One audio source: ring buffer + online stream --------------------
+    struct Source {
+        Impl* owner = nullptr;
+        CaptionSource id = CaptionSource::Mic;
+        bool active = false;           // decoded this run; fixed at start()
+
+        // Ring buffer (SPSC, lock-free for push/pop indices). Capacity is a
+        // power of two so the index mask is a single AND. Producer (this
+        // source's capture thread) writes at `head`; consumer (worker) reads
+        // at `tail`. `head - tail` is a relaxed snapshot — both threads use
+        // it as a hint, never as a strict invariant.
+        std::vector<int16_t> ring;         // size == capacity, fixed at start()
+        std::size_t ring_mask = 0;
+        std::atomic<std::size_t> head{0};  // producer writes here
+        std::atomic<std::size_t> tail{0};  // consumer reads here
+
+        // Arrival stamps, one per pushed chunk: the producer publishes a
+        // mark {head after the chunk, steady-clock ns} before the head
+        // itself. A full mark ring skips the stamp. Worker pops them as it
+        // drains to learn when the newest sample it fed arrived.
+        struct ChunkMark {
+            std::size_t end = 0;
+            int64_t arrival_ns = 0;
+        };
+        static constexpr std::size_t kMarks = 512;
+        std::array<ChunkMark, kMarks> marks{};
+        std::atomic<std::size_t> mark_head{0};  // producer
+        std::atomic<std::size_t> mark_tail{0};  // consumer
+        std::size_t marked_end = 0;             // worker-local: end of last mark popped
+        int64_t fed_arrival_ns = 0;             // worker-local: newest sample fed
+
+        const SherpaOnnxOnlineStream* stream = nullptr;
+        bool fed = false;                  // worker-local: accepted samples this pass
+
+        void mark(std::size_t end, int64_t arrival_ns) {
+            const std::size_t mh = mark_head.load(std::memory_order_relaxed);
+            if (mh - mark_tail.load(std::memory_order_acquire) >= kMarks) return;
+            marks[mh & (kMarks - 1)] = {end, arrival_ns};
+            mark_head.store(mh + 1, std::memory_order_release);
+        }
+
+        std::size_t queued() const {
+            return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+        }
+        std::size_t push(const int16_t* samples, std::size_t n);
+    };
+    // Indexed by CaptionSource; `order` lists the active ones, first source
+    // (on_audio_chunk's) first.
+    std::array<Source, 2> sources;
+    std::array<Source*, 2> order{};
+    std::size_t n_active = 0;
+    std::atomic<bool> overflow_seen{false};  // set by any producer
+
+    Source& first() { return *order[0]; }
+    const Source& first() const { return *order[0]; }
+
+    Impl() {
+        for (std::size_t i = 0; i < sources.size(); ++i) {
+            sources[i].owner = this;
+            sources[i].id = static_cast<CaptionSource>(i);
+            order[i] = &sources[i];
+        }
+    }
+
+    // Destroy every source's stream, then the recognizer they share, or
+    // keep it warm for the next start() (Options::keep_warm).
+    void release_recognizer() {
+        for (auto& src : sources) {
+            if (src.stream) SherpaOnnxDestroyOnlineStream(src.stream);
+            src.stream = nullptr;
+        }
+        memory.unlock();
+        if (recognizer && keep_warm) {
+            keep_recognizer_warm(recognizer_key, recognizer, std::move(memory));
+        } else if (recognizer) {
+            SherpaOnnxDestroyOnlineRecognizer(recognizer);
+        }
+        memory = ModelMemory{};
+        recognizer = nullptr;
+    }
+
+    // Worker side: true once some source has a feed's worth queued.
+    bool feed_ready() const {
+        for (std::size_t i = 0; i < n_active; ++i)
+            if (order[i]->queued() >= wake_samples) return true;
+        return false;
+    }
 
     // ----- Worker -----------------------------------------------------------
     std::thread worker;
     std::atomic<bool> worker_should_exit{false};
-    int worker_poll_ms = 5;            // overridable via Options for tests
+    int worker_poll_ms = 100;          // longest idle wait; overridable for tests
     int effective_num_threads = 1;     // after the min(2, ...) cap
 
-    // ----- Recognizer + stream ---------------------------------------------
+    // ----- Worker wakeup ----------------------------------------------------
+    // The worker blocks on `wake_fd` (an eventfd) while every source has
+    // fewer than `wake_samples` queued, with `worker_waiting` set; a
+    // producer writes to it once its source has that many. -1 = eventfd
+    // unavailable, the worker sleeps worker_poll_ms instead.
+    int wake_fd = -1;
+    std::size_t wake_samples = 1;
+    std::atomic<bool> worker_waiting{false};
+
+    // Producer side, after publishing `src`'s `head_now`: one non-blocking
+    // eventfd write when the worker waits and a feed's worth is queued.
+    // Never blocks, allocates or logs.
+    void notify_worker(const Source& src, std::size_t head_now) {
+        if (wake_fd < 0) return;
+        // Orders the head store before the worker_waiting load, against the
+        // worker's store-then-load in wait_for_samples(): one of the two
+        // sides sees the other's store, so no wakeup is lost.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!worker_waiting.load(std::memory_order_relaxed)) return;
+        if (head_now - src.tail.load(std::memory_order_relaxed) < wake_samples) return;
+        const uint64_t one = 1;
+        [[maybe_unused]] ssize_t rc = ::write(wake_fd, &one, sizeof(one));
+    }
+
+    // ----- Stats (worker records, any thread summarizes) ---------------------
+    LatencyHistogram partial_ms;
+    LatencyHistogram final_ms;
+    LatencyHistogram ring_ms;
+    std::atomic<int64_t> busy_ns{0};          // worker time spent in passes
+    std::atomic<int64_t> decoded_samples{0};  // audio those passes fed
+
+    // ----- Recognizer (shared by every source's stream) ---------------------
     const SherpaOnnxOnlineRecognizer* recognizer = nullptr;
-    const SherpaOnnxOnlineStream* stream = nullptr;
     int32_t sample_rate = 16000;
-
-    // Owned strings backing the C-config char* fields. Must outlive the
-    // SherpaOnnxCreateOnlineRecognizer call.
-    std::string encoder_path;
-    std::string decoder_path;
-    std::string joiner_path;
-    std::string tokens_path;
-    std::string decoding_method;
-    std::string provider;
-    std::string model_type;
+    std::string recognizer_key;  // RecognizerSpec::key() it was built for
+    bool keep_warm = false;      // Options::keep_warm
+    bool lock_memory = false;    // Options::lock_memory
+    ModelMemory memory;          // what loading the recognizer mapped
+    std::atomic<bool> int8{false};  // built from the int8 weights
+    std::atomic<uint8_t> overload_tier{0};  // CaptionOverloadTier, worker-set
 
     // ----- Callbacks --------------------------------------------------------
     CaptionResultCallback   on_result   = nullptr;
@@ -122,6 +243,27 @@ std::size_t CaptionEngine::_degraded_events_emitted_for_test() const {
     return impl_->degraded_emitted.load(std::memory_order_acquire);
 }
 
+// ===========================================================================
+// CaptionOverloadPolicy (both build paths)
+// ===========================================================================
+
+CaptionOverloadTier CaptionOverloadPolicy::update(double fill, bool overran, int64_t now_ms) {
+    CaptionOverloadTier floor = CaptionOverloadTier::Normal;
+    if (overran || fill >= 1.0) floor = CaptionOverloadTier::Dropping;
+    else if (fill >= kReducedDecodeFill) floor = CaptionOverloadTier::ReducedDecode;
+    else if (fill >= kFinalsOnlyFill) floor = CaptionOverloadTier::FinalsOnly;
+    if (floor > tier_) tier_ = floor;
+
+    if (floor != CaptionOverloadTier::Normal || fill >= kRecoverFill) {
+        calm_since_ms_ = -1;
+    } else if (calm_since_ms_ < 0) {
+        calm_since_ms_ = now_ms;
+    } else if (now_ms - calm_since_ms_ >= kRecoverMs) {
+        tier_ = CaptionOverloadTier::Normal;
+    }
+    return tier_;
+}
+
 // ===========================================================================
 // Stub build path (RECMEET_USE_SHERPA OFF)
 // ===========================================================================
@@ -141,27 +283,58 @@ void CaptionEngine::on_audio_chunk(const int16_t* /*samples*/, std::size_t /*n*/
     // even know the build flavor, so we accept the call and drop silently.
 }
 
+void CaptionEngine::on_source_audio(const int16_t* /*samples*/, std::size_t /*n*/, void* /*sink*/) {
+}
+
+void* CaptionEngine::audio_sink(CaptionSource /*source*/) {
+    return nullptr;
+}
+
 std::size_t CaptionEngine::_push_samples_for_test(const int16_t* /*samples*/, std::size_t /*n*/) {
     return 0;
 }
 
+std::size_t CaptionEngine::_push_samples_for_test(const int16_t* /*samples*/, std::size_t /*n*/,
+                                                  CaptionSource /*source*/) {
+    return 0;
+}
+
 std::size_t CaptionEngine::_ring_occupancy_for_test() const {
     return 0;
 }
 
+std::size_t CaptionEngine::_ring_occupancy_for_test(CaptionSource /*source*/) const {
+    return 0;
+}
+
 std::size_t CaptionEngine::_ring_capacity_for_test() const {
     return 0;
 }
 
+bool CaptionEngine::backlogged() const {
+    return false;
+}
+
 void CaptionEngine::stop() {
     std::lock_guard lk(impl_->lifecycle_mtx);
     impl_->running.store(false, std::memory_order_release);
 }
 
+bool CaptionEngine::prewarm(const Options& /*opts*/, std::string* error) {
+    if (error) *error = "captions require RECMEET_USE_SHERPA=ON build";
+    return false;
+}
+
+void CaptionEngine::drop_warm() {}
+
 int CaptionEngine::_effective_num_threads_for_test() const {
     return 0;
 }
 
+CaptionStats CaptionEngine::stats() const {
+    return {};
+}
+
 #else // RECMEET_USE_SHERPA — real implementation below
 
 // ===========================================================================
@@ -172,6 +345,30 @@ namespace {
 
 namespace fs = std::filesystem;
 
+// Process metrics (metrics.h). Producers and the worker update them
+// without locking.
+MetricCounter& caption_overrun_metric() {
+    static MetricCounter& c = metrics().counter(
+        "recmeet_caption_overruns", "Caption ring pushes that dropped queued audio.");
+    return c;
+}
+
+MetricHistogram& caption_latency_metric(bool partial) {
+    static const std::vector<double> bounds = {0.05, 0.1, 0.2, 0.5, 1, 2, 5, 10};
+    static MetricHistogram& p = metrics().histogram(
+        "recmeet_caption_latency_seconds", "Audio arrival to caption emitted.", bounds,
+        metric_label("kind", "partial"));
+    static MetricHistogram& f = metrics().histogram(
+        "recmeet_caption_latency_seconds", "Audio arrival to caption emitted.", bounds,
+        metric_label("kind", "final"));
+    return partial ? p : f;
+}
+
+// Samples per drain-and-feed cycle, the recognizer's chunk-size sweet
+// spot: 1600 = 100 ms @ 16 kHz. The producer wakes the worker once this
+// many are queued (or half the ring, if that is smaller).
+constexpr std::size_t FEED_CHUNK = 1600;
+
 /// Round up to the next power of two. Returns 1 for n==0 to avoid a 0-cap
 /// ring buffer (which would divide by zero in mask arithmetic).
 std::size_t next_pow2(std::size_t n) {
@@ -183,6 +380,13 @@ std::size_t next_pow2(std::size_t n) {
     return n + 1;
 }
 
+MetricCounter& caption_int8_fallback_metric() {
+    static MetricCounter& c = metrics().counter(
+        "recmeet_caption_int8_fallbacks",
+        "Caption engines that switched to the int8 weights after falling behind.");
+    return c;
+}
+
 /// Search `model_dir` for the first file whose name matches the given
 /// substring patterns. Returns empty path if no match.
 fs::path find_model_file(const fs::path& model_dir,
@@ -202,6 +406,206 @@ fs::path find_model_file(const fs::path& model_dir,
     return {};
 }
 
+bool is_int8_onnx(const fs::path& p) {
+    return p.filename().string().find(".int8.") != std::string::npos;
+}
+
+/// The `kind` (encoder, decoder, joiner) ONNX file in `model_dir`: its
+/// `*.int8.onnx` one when `int8`, else the other. The model zoo ships both
+/// side by side; a directory with only one precision yields that one.
+/// Among equals the first name sorts first, so the choice does not depend
+/// on directory order.
+fs::path find_onnx_file(const fs::path& model_dir, const char* kind, bool int8) {
+    fs::path wanted, other;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(model_dir, ec)) {
+        if (ec) break;
+        if (!entry.is_regular_file(ec)) continue;
+        const fs::path& p = entry.path();
+        const std::string name = p.filename().string();
+        if (name.find(kind) == std::string::npos || p.extension() != ".onnx") continue;
+        fs::path& slot = is_int8_onnx(p) == int8 ? wanted : other;
+        if (slot.empty() || p.filename() < slot.filename()) slot = p;
+    }
+    return wanted.empty() ? other : wanted;
+}
+
+// Model directories whose fp32 decode fell behind in this process
+// (Options::int8_fallback). Later starts load their int8 weights directly,
+// so each meeting does not lose its first seconds to the probe again.
+struct Int8Dirs {
+    std::mutex mu;
+    std::set<std::string> dirs;
+};
+
+Int8Dirs& int8_dirs() {
+    static Int8Dirs* d = new Int8Dirs;  // outlives static teardown
+    return *d;
+}
+
+bool fell_back_to_int8(const std::string& model_dir) {
+    auto& d = int8_dirs();
+    std::lock_guard<std::mutex> lk(d.mu);
+    return d.dirs.count(model_dir) > 0;
+}
+
+void remember_int8_fallback(const std::string& model_dir) {
+    auto& d = int8_dirs();
+    std::lock_guard<std::mutex> lk(d.mu);
+    d.dirs.insert(model_dir);
+}
+
+// The model files and settings one recognizer is built from. Two starts
+// with the same key() can share a recognizer.
+struct RecognizerSpec {
+    std::string encoder, decoder, joiner, tokens;
+    bool int8 = false;  // the encoder is the quantized one
+    std::string decoding_method;
+    int num_threads = 1;
+    int32_t sample_rate = 16000;
+    bool enable_endpoint = true;
+    std::vector<int> cpus;
+
+    std::string key() const {
+        std::string k = encoder + '\n' + decoder + '\n' + joiner + '\n' + tokens + '\n' +
+                        decoding_method + '\n' + std::to_string(num_threads) + '\n' +
+                        std::to_string(sample_rate) + (enable_endpoint ? "\nendpoint" : "\n");
+        for (int cpu : cpus) k += ',' + std::to_string(cpu);
+        return k;
+    }
+};
+
+// Fill `spec` from `opts`; false with `error` set when opts.model_dir lacks
+// one of the four model files.
+bool resolve_recognizer_spec(const CaptionEngine::Options& opts, RecognizerSpec& spec,
+                             std::string& error) {
+    const fs::path model_dir(opts.model_dir);
+    if (opts.model_dir.empty()) {
+        error = "caption_engine: Options::model_dir is empty";
+        return false;
+    }
+    std::error_code ec;
+    if (!fs::is_directory(model_dir, ec)) {
+        error = "caption_engine: model_dir is not a directory: " + opts.model_dir;
+        return false;
+    }
+
+    const bool int8 = opts.int8 || (opts.int8_fallback && fell_back_to_int8(opts.model_dir));
+    fs::path encoder = find_onnx_file(model_dir, "encoder", int8);
+    fs::path decoder = find_onnx_file(model_dir, "decoder", int8);
+    fs::path joiner  = find_onnx_file(model_dir, "joiner", int8);
+    fs::path tokens  = find_model_file(model_dir, {"tokens"});
+
+    if (encoder.empty() || decoder.empty() || joiner.empty() || tokens.empty()) {
+        error = "caption_engine: missing model files in " + opts.model_dir +
+                " (need encoder*.onnx, decoder*.onnx, joiner*.onnx, tokens*.txt)";
+        return false;
+    }
+
+    spec.encoder = encoder.string();
+    spec.decoder = decoder.string();
+    spec.joiner  = joiner.string();
+    spec.tokens  = tokens.string();
+    spec.int8    = is_int8_onnx(encoder);
+    spec.decoding_method = opts.decoding_method.empty() ? "greedy_search" : opts.decoding_method;
+    spec.num_threads = std::min(2, std::max(1, opts.num_threads));
+    spec.sample_rate = opts.sample_rate;
+    spec.enable_endpoint = opts.enable_endpoint;
+    spec.cpus = opts.cpus;
+    return true;
+}
+
+// Loads the encoder, decoder and joiner: most of a cold start()'s latency.
+// `memory` receives the mappings the load made when huge pages are on or
+// `track_memory` (Options::lock_memory) is set.
+const SherpaOnnxOnlineRecognizer* create_recognizer(const RecognizerSpec& spec,
+                                                    ModelMemory& memory, bool track_memory) {
+    SherpaOnnxOnlineRecognizerConfig cfg{};
+    cfg.feat_config.sample_rate = spec.sample_rate;
+    cfg.feat_config.feature_dim = 80;
+
+    cfg.model_config.transducer.encoder = spec.encoder.c_str();
+    cfg.model_config.transducer.decoder = spec.decoder.c_str();
+    cfg.model_config.transducer.joiner  = spec.joiner.c_str();
+    cfg.model_config.tokens             = spec.tokens.c_str();
+    cfg.model_config.num_threads        = spec.num_threads;
+    cfg.model_config.provider           = "cpu";
+    cfg.model_config.debug              = 0;
+    cfg.model_config.model_type         = "";
+
+    cfg.decoding_method            = spec.decoding_method.c_str();
+    cfg.max_active_paths           = 4;
+    cfg.enable_endpoint            = spec.enable_endpoint ? 1 : 0;
+    cfg.rule1_min_trailing_silence = 2.4f;
+    cfg.rule2_min_trailing_silence = 1.2f;
+    cfg.rule3_min_utterance_length = 20.0f;
+    cfg.hotwords_score             = 1.5f;
+
+    // The recognizer's intra-op pool starts here and keeps the
+    // worker's CPUs.
+    CpuPlacement placement;
+    placement.cpus = spec.cpus;
+    const ScopedCpuPlacement pinned(placement);
+    memory.begin("caption recognizer", {spec.encoder, spec.decoder, spec.joiner}, track_memory);
+    const SherpaOnnxOnlineRecognizer* recognizer = SherpaOnnxCreateOnlineRecognizer(&cfg);
+    if (recognizer) memory.finish();
+    return recognizer;
+}
+
+// The one recognizer kept warm per process. A start() takes it out, so two
+// engines never decode against the same one; its stop() puts it back.
+struct WarmRecognizer {
+    std::mutex mu;
+    std::string key;
+    const SherpaOnnxOnlineRecognizer* recognizer = nullptr;
+    ModelMemory memory;
+};
+
+WarmRecognizer& warm_recognizer() {
+    static WarmRecognizer* warm = new WarmRecognizer;  // outlives static teardown
+    return *warm;
+}
+
+// The warm recognizer when it was built for `key`, else nullptr. `memory`
+// receives its mappings.
+const SherpaOnnxOnlineRecognizer* take_warm_recognizer(const std::string& key,
+                                                       ModelMemory& memory) {
+    auto& warm = warm_recognizer();
+    std::lock_guard<std::mutex> lk(warm.mu);
+    if (!warm.recognizer || warm.key != key) return nullptr;
+    const auto* r = warm.recognizer;
+    warm.recognizer = nullptr;
+    warm.key.clear();
+    memory = std::move(warm.memory);
+    return r;
+}
+
+void keep_recognizer_warm(const std::string& key, const SherpaOnnxOnlineRecognizer* recognizer,
+                          ModelMemory memory) {
+    const SherpaOnnxOnlineRecognizer* old = nullptr;
+    ModelMemory old_memory;
+    {
+        auto& warm = warm_recognizer();
+        std::lock_guard<std::mutex> lk(warm.mu);
+        old = warm.recognizer;
+        old_memory = std::move(warm.memory);
+        warm.recognizer = recognizer;
+        warm.key = key;
+        warm.memory = std::move(memory);
+    }
+    if (old) SherpaOnnxDestroyOnlineRecognizer(old);
+}
+
+MetricCounter& caption_recognizer_start_metric(bool warm) {
+    static MetricCounter& hit = metrics().counter(
+        "recmeet_caption_recognizer_starts", "Caption engine starts, by recognizer source.",
+        metric_label("recognizer", "warm"));
+    static MetricCounter& cold = metrics().counter(
+        "recmeet_caption_recognizer_starts", "Caption engine starts, by recognizer source.",
+        metric_label("recognizer", "cold"));
+    return warm ? hit : cold;
+}
+
 /// Default scheduler-set: try SCHED_BATCH; fall back to nice(+10) on EPERM.
 /// Returns 0 on SCHED_BATCH applied, 1 on nice fallback, -1 on hard failure.
 int default_scheduler_setter(void* /*userdata*/) {
@@ -240,21 +644,46 @@ void CaptionEngine::on_audio_chunk(const int16_t* samples, std::size_t n, void*
     eng->_push_samples_for_test(samples, n);
 }
 
+void CaptionEngine::on_source_audio(const int16_t* samples, std::size_t n, void* sink) {
+    if (!sink || !samples || n == 0) return;
+    static_cast<Impl::Source*>(sink)->push(samples, n);
+}
+
+void* CaptionEngine::audio_sink(CaptionSource source) {
+    Impl::Source& src = impl_->sources[static_cast<std::size_t>(source)];
+    return src.active ? &src : nullptr;
+}
+
 std::size_t CaptionEngine::_push_samples_for_test(const int16_t* samples, std::size_t n) {
-    if (!impl_->running.load(std::memory_order_acquire)) {
+    if (!impl_->running.load(std::memory_order_acquire)) return n;
+    return impl_->first().push(samples, n);
+}
+
+std::size_t CaptionEngine::_push_samples_for_test(const int16_t* samples, std::size_t n,
+                                                  CaptionSource source) {
+    Impl::Source& src = impl_->sources[static_cast<std::size_t>(source)];
+    if (!src.active) return n;
+    return src.push(samples, n);
+}
+
+std::size_t CaptionEngine::Impl::Source::push(const int16_t* samples, std::size_t n) {
+    // vDSO clock read: no syscall, safe on the RT thread.
+    const int64_t arrival_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (!owner->running.load(std::memory_order_acquire)) {
         // Not started — drop silently. The producer should not have been
         // wired before start(), but we don't crash on misuse.
         return n;
     }
-    if (n == 0 || impl_->ring.empty()) return 0;
+    if (n == 0 || ring.empty()) return 0;
 
     // Lock-free SPSC push. Producer owns `head`; consumer owns `tail`. We
     // observe `tail` (acquire) to compute available space, then store `head`
     // (release) so the consumer's acquire-load sees our writes.
-    const std::size_t cap  = impl_->ring.size();
-    const std::size_t mask = impl_->ring_mask;
-    std::size_t head_local = impl_->head.load(std::memory_order_relaxed);
-    std::size_t tail_local = impl_->tail.load(std::memory_order_acquire);
+    const std::size_t cap  = ring.size();
+    const std::size_t mask = ring_mask;
+    std::size_t head_local = head.load(std::memory_order_relaxed);
+    std::size_t tail_local = tail.load(std::memory_order_acquire);
     std::size_t in_buf     = head_local - tail_local;       // mod 2^N — wraps fine
     std::size_t free_space = cap - in_buf;
 
@@ -273,10 +702,13 @@ std::size_t CaptionEngine::_push_samples_for_test(const int16_t* samples, std::s
         // head jumps by `cap` past `tail`, samples_avail() will report `cap`
         // which is fine (consumer reads at most cap samples, then loops).
         for (std::size_t i = 0; i < cap; ++i) {
-            impl_->ring[(head_local + i) & mask] = samples[n - cap + i];
+            ring[(head_local + i) & mask] = samples[n - cap + i];
         }
-        impl_->head.store(head_local + cap, std::memory_order_release);
-        impl_->overflow_seen.store(true, std::memory_order_release);
+        mark(head_local + cap, arrival_ns);
+        head.store(head_local + cap, std::memory_order_release);
+        owner->overflow_seen.store(true, std::memory_order_release);
+        caption_overrun_metric().add();
+        owner->notify_worker(*this, head_local + cap);
         return dropped;
     }
     if (n > free_space) {
@@ -291,54 +723,98 @@ std::size_t CaptionEngine::_push_samples_for_test(const int16_t* samples, std::s
         //   if (in_buf > cap) { tail = head - cap; }  // resync drop
         dropped = n - free_space;
         for (std::size_t i = 0; i < n; ++i) {
-            impl_->ring[(head_local + i) & mask] = samples[i];
+            ring[(head_local + i) & mask] = samples[i];
         }
-        impl_->head.store(head_local + n, std::memory_order_release);
-        impl_->overflow_seen.store(true, std::memory_order_release);
+        mark(head_local + n, arrival_ns);
+        head.store(head_local + n, std::memory_order_release);
+        owner->overflow_seen.store(true, std::memory_order_release);
+        caption_overrun_metric().add();
+        owner->notify_worker(*this, head_local + n);
         return dropped;
     }
 
     // Fast path — fits.
     for (std::size_t i = 0; i < n; ++i) {
-        impl_->ring[(head_local + i) & mask] = samples[i];
+        ring[(head_local + i) & mask] = samples[i];
     }
-    impl_->head.store(head_local + n, std::memory_order_release);
+    mark(head_local + n, arrival_ns);
+    head.store(head_local + n, std::memory_order_release);
+    owner->notify_worker(*this, head_local + n);
     return 0;
 }
 
-std::size_t CaptionEngine::_ring_occupancy_for_test() const {
-    if (impl_->ring.empty()) return 0;
-    std::size_t head_local = impl_->head.load(std::memory_order_acquire);
-    std::size_t tail_local = impl_->tail.load(std::memory_order_acquire);
+namespace {
+
+std::size_t ring_occupancy(const CaptionEngine::Impl::Source& src) {
+    if (src.ring.empty()) return 0;
+    std::size_t head_local = src.head.load(std::memory_order_acquire);
+    std::size_t tail_local = src.tail.load(std::memory_order_acquire);
     std::size_t diff = head_local - tail_local;
-    return std::min(diff, impl_->ring.size());
+    return std::min(diff, src.ring.size());
+}
+
+} // anonymous namespace
+
+std::size_t CaptionEngine::_ring_occupancy_for_test() const {
+    return ring_occupancy(impl_->first());
+}
+
+std::size_t CaptionEngine::_ring_occupancy_for_test(CaptionSource source) const {
+    return ring_occupancy(impl_->sources[static_cast<std::size_t>(source)]);
 }
 
 std::size_t CaptionEngine::_ring_capacity_for_test() const {
-    return impl_->ring.size();
+    return impl_->first().ring.size();
+}
+
+bool CaptionEngine::backlogged() const {
+    for (std::size_t i = 0; i < impl_->n_active; ++i) {
+        const Impl::Source& src = *impl_->order[i];
+        if (ring_occupancy(src) * 2 > src.ring.size()) return true;
+    }
+    return false;
 }
 
 int CaptionEngine::_effective_num_threads_for_test() const {
     return impl_->effective_num_threads;
 }
 
+CaptionStats CaptionEngine::stats() const {
+    CaptionStats st;
+    st.partial_ms = impl_->partial_ms.summary();
+    st.final_ms = impl_->final_ms.summary();
+    st.ring_ms = impl_->ring_ms.summary();
+    if (impl_->sample_rate > 0) {
+        st.ring_capacity_ms =
+            static_cast<int64_t>(impl_->first().ring.size() * 1000 / impl_->sample_rate);
+        const int64_t samples = impl_->decoded_samples.load(std::memory_order_relaxed);
+        if (samples > 0)
+            st.decode_rtf = static_cast<double>(impl_->busy_ns.load(std::memory_order_relaxed)) /
+                            (static_cast<double>(samples) * 1e9 / impl_->sample_rate);
+    }
+    st.int8 = impl_->int8.load(std::memory_order_acquire);
+    st.overload_tier =
+        static_cast<CaptionOverloadTier>(impl_->overload_tier.load(std::memory_order_relaxed));
+    return st;
+}
+
 // ===========================================================================
 // Worker thread main loop
 // ===========================================================================
 
 namespace {
 
-/// Pull up to `max_samples` from the ring, converting int16 → float in
+/// Pull up to `max_samples` from `src`'s ring, converting int16 → float in
 /// [-1.0, 1.0]. Returns the actual count copied. Updates the consumer's
 /// tail index.
-std::size_t drain_ring_to_float(CaptionEngine::Impl& impl,
+std::size_t drain_ring_to_float(CaptionEngine::Impl::Source& src,
                                 float* out, std::size_t max_samples) {
-    if (impl.ring.empty() || max_samples == 0) return 0;
+    if (src.ring.empty() || max_samples == 0) return 0;
 
-    const std::size_t cap = impl.ring.size();
-    const std::size_t mask = impl.ring_mask;
-    std::size_t head_local = impl.head.load(std::memory_order_acquire);
-    std::size_t tail_local = impl.tail.load(std::memory_order_relaxed);
+    const std::size_t cap = src.ring.size();
+    const std::size_t mask = src.ring_mask;
+    std::size_t head_local = src.head.load(std::memory_order_acquire);
+    std::size_t tail_local = src.tail.load(std::memory_order_relaxed);
 
     std::size_t avail = head_local - tail_local;
     if (avail > cap) {
@@ -348,15 +824,196 @@ std::size_t drain_ring_to_float(CaptionEngine::Impl& impl,
         avail = cap;
     }
     std::size_t to_copy = std::min(avail, max_samples);
-    for (std::size_t i = 0; i < to_copy; ++i) {
-        int16_t s = impl.ring[(tail_local + i) & mask];
-        out[i] = static_cast<float>(s) / 32768.0f;
-    }
-    impl.tail.store(tail_local + to_copy, std::memory_order_release);
+    ring_s16_to_f32(src.ring.data(), mask, tail_local, out, to_copy);
+    src.tail.store(tail_local + to_copy, std::memory_order_release);
     return to_copy;
 }
 
-void worker_main(CaptionEngine::Impl* impl) {
+/// Pop the arrival marks of the samples drained up to `tail_now` and keep
+/// the arrival of the newest one. A chunk drained only in part counts as
+/// fed: its samples all arrived together.
+void take_arrival(CaptionEngine::Impl::Source& src, std::size_t tail_now) {
+    std::size_t mt = src.mark_tail.load(std::memory_order_relaxed);
+    const std::size_t mh = src.mark_head.load(std::memory_order_acquire);
+    while (mt != mh) {
+        const auto& m = src.marks[mt & (src.kMarks - 1)];
+        if (m.end > tail_now) {
+            if (src.marked_end < tail_now) src.fed_arrival_ns = m.arrival_ns;
+            break;
+        }
+        src.fed_arrival_ns = m.arrival_ns;
+        src.marked_end = m.end;
+        ++mt;
+    }
+    src.mark_tail.store(mt, std::memory_order_release);
+}
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// The lighter recognizer on the worker thread: greedy search, with the
+/// int8 weights under Options::int8_fallback. Loaded on a helper thread
+/// while the current one keeps decoding, then swapped in between passes,
+/// when the ReducedDecode overload tier asks for it (reduce()) or when the
+/// int8 probe finds the fp32 decode behind: its real-time factor over the
+/// first int8_probe_ms of audio.
+class DecodeFallback {
+public:
+    /// Disarmed when `lighter` names what is already loaded (or is empty).
+    /// `probe` runs the int8 probe (Options::int8_fallback).
+    DecodeFallback(const CaptionEngine::Impl& I, std::string model_dir, RecognizerSpec lighter,
+                   bool probe, int probe_ms, double max_rtf)
+        : model_dir_(std::move(model_dir)), spec_(std::move(lighter)), max_rtf_(max_rtf) {
+        armed_ = I.recognizer && !spec_.encoder.empty() && spec_.key() != I.recognizer_key;
+        probing_ = armed_ && probe && spec_.int8 && !I.int8.load(std::memory_order_acquire);
+        probe_samples_ = static_cast<std::size_t>(std::max(1, probe_ms)) *
+                         static_cast<std::size_t>(I.sample_rate) / 1000;
+    }
+
+    // Joins a load still running; a recognizer never swapped in is freed.
+    ~DecodeFallback() {
+        if (loader_.joinable()) loader_.join();
+        if (recognizer_) SherpaOnnxDestroyOnlineRecognizer(recognizer_);
+    }
+
+    /// After each pass: `busy_ns` it took to feed and decode `samples` of
+    /// the most-fed source.
+    void after_pass(CaptionEngine::Impl& I, int64_t busy_ns, std::size_t samples) {
+        if (probing_) probe(I, busy_ns, samples);
+        if (loader_.joinable() && loaded_.load(std::memory_order_acquire)) {
+            loader_.join();
+            if (recognizer_) swap_in(I);
+            else log_warn("captions: the lighter recognizer failed to load; keeping this one");
+        }
+    }
+
+    /// The ReducedDecode tier: load the lighter recognizer, once.
+    void reduce(const CaptionEngine::Impl& I) {
+        if (!armed_) return;
+        log_info("captions: falling behind; loading a lighter recognizer (%s%s)",
+                 spec_.decoding_method.c_str(), spec_.int8 && !I.int8 ? ", int8" : "");
+        load(I);
+    }
+
+private:
+    void probe(CaptionEngine::Impl& I, int64_t busy_ns, std::size_t samples) {
+        busy_ns_ += busy_ns;
+        samples_ += samples;
+        const bool overran = I.overflow_seen.load(std::memory_order_acquire);
+        if (!overran && samples_ < probe_samples_) return;
+        probing_ = false;
+        if (!armed_) return;
+        const double audio_ns = static_cast<double>(samples_) * 1e9 / I.sample_rate;
+        const double rtf = audio_ns > 0 ? static_cast<double>(busy_ns_) / audio_ns : 0.0;
+        if (!overran && rtf <= max_rtf_) {
+            log_debug("captions: decode RTF %.2f over the first %.1f s; keeping fp32",
+                      rtf, audio_ns / 1e9);
+            return;
+        }
+        log_info("captions: fp32 decode %s (RTF %.2f over %.1f s); loading the int8 weights",
+                 overran ? "overran its ring" : "is falling behind", rtf, audio_ns / 1e9);
+        load(I);
+    }
+
+    void load(const CaptionEngine::Impl& I) {
+        armed_ = false;
+        probing_ = false;
+        loader_ = std::thread([this, track = I.lock_memory]() {
+            recognizer_ = create_recognizer(spec_, memory_, track);
+            loaded_.store(true, std::memory_order_release);
+        });
+    }
+
+    // Finalize each source's utterance against the current recognizer,
+    // then give every source a fresh stream of the lighter one.
+    void swap_in(CaptionEngine::Impl& I) {
+        const int64_t ts_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - I.start_time).count();
+        for (std::size_t i = 0; i < I.n_active; ++i) {
+            CaptionEngine::Impl::Source& src = *I.order[i];
+            if (!src.stream) continue;
+            const SherpaOnnxOnlineRecognizerResult* res =
+                SherpaOnnxGetOnlineStreamResult(I.recognizer, src.stream);
+            if (res && res->text && res->text[0] && I.on_result) {
+                CaptionResult cr;
+                cr.text = res->text;
+                cr.is_partial = false;
+                cr.timestamp_ms = ts_ms;
+                cr.source = src.id;
+                I.on_result(cr, I.on_result_ud);
+            }
+            if (res) SherpaOnnxDestroyOnlineRecognizerResult(res);
+            SherpaOnnxDestroyOnlineStream(src.stream);
+            src.stream = nullptr;
+        }
+        I.memory.unlock();
+        SherpaOnnxDestroyOnlineRecognizer(I.recognizer);
+        I.recognizer = recognizer_;
+        recognizer_ = nullptr;
+        I.memory = std::move(memory_);
+        if (I.lock_memory) I.memory.lock();
+        I.recognizer_key = spec_.key();
+        for (std::size_t i = 0; i < I.n_active; ++i) {
+            CaptionEngine::Impl::Source& src = *I.order[i];
+            src.stream = SherpaOnnxCreateOnlineStream(I.recognizer);
+            if (!src.stream)
+                log_warn("captions: no stream of the lighter recognizer for the %s; "
+                         "its captions stop", caption_source_name(src.id));
+        }
+        // A greedy-only swap was reported as the ReducedDecode tier.
+        if (!spec_.int8 || I.int8.load(std::memory_order_acquire)) return;
+        I.int8.store(true, std::memory_order_release);
+        remember_int8_fallback(model_dir_);
+        caption_int8_fallback_metric().add();
+        I.degraded_emitted.fetch_add(1, std::memory_order_acq_rel);
+        if (I.on_degraded) I.on_degraded(CaptionDegradedReason::Int8Fallback, I.on_degraded_ud);
+    }
+
+    std::string model_dir_;
+    RecognizerSpec spec_;
+    double max_rtf_;
+    bool armed_ = false;    // a lighter recognizer is there to load
+    bool probing_ = false;  // the int8 probe is still measuring
+    std::size_t probe_samples_ = 0;
+    int64_t busy_ns_ = 0;
+    std::size_t samples_ = 0;
+    std::thread loader_;
+    std::atomic<bool> loaded_{false};
+    const SherpaOnnxOnlineRecognizer* recognizer_ = nullptr;
+    ModelMemory memory_;
+};
+
+/// Block until a producer reports a feed's worth of samples, stop()
+/// signals exit, or worker_poll_ms passes, which picks up a partial chunk
+/// when the audio stops arriving.
+void wait_for_samples(CaptionEngine::Impl& impl) {
+    if (impl.wake_fd < 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(impl.worker_poll_ms));
+        return;
+    }
+    impl.worker_waiting.store(true, std::memory_order_relaxed);
+    // Pairs with the fence in notify_worker().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!impl.feed_ready() && !impl.worker_should_exit.load(std::memory_order_acquire)) {
+        pollfd pfd{impl.wake_fd, POLLIN, 0};
+        ::poll(&pfd, 1, impl.worker_poll_ms);
+    }
+    impl.worker_waiting.store(false, std::memory_order_relaxed);
+    uint64_t count = 0;  // reset the counter; EAGAIN when it was not written
+    [[maybe_unused]] ssize_t rc = ::read(impl.wake_fd, &count, sizeof(count));
+}
+
+CaptionDegradedReason overload_reason(CaptionOverloadTier tier) {
+    switch (tier) {
+    case CaptionOverloadTier::FinalsOnly: return CaptionDegradedReason::FinalsOnly;
+    case CaptionOverloadTier::ReducedDecode: return CaptionDegradedReason::ReducedDecode;
+    default: return CaptionDegradedReason::BufferOverrun;
+    }
+}
+
+void worker_main(CaptionEngine::Impl* impl, DecodeFallback* fallback) {
     auto& I = *impl;
 
     // (No mutex grab here — stop() holds lifecycle_mtx during join(), so the
@@ -364,29 +1021,77 @@ void worker_main(CaptionEngine::Impl* impl) {
     // state before std::thread::thread launches the worker, which provides
     // the needed happens-before via the thread's start synchronization.)
 
-    // Buffer for one drain-and-feed cycle. Size to match the recognizer's
-    // chunk-size sweet-spot; 1600 = 100ms @ 16 kHz.
-    constexpr std::size_t FEED_CHUNK = 1600;
+    // Buffer for one drain-and-feed cycle, and the streams ready to decode.
     std::vector<float> feed(FEED_CHUNK);
+    std::array<const SherpaOnnxOnlineStream*, 2> ready{};
 
     auto last_endpoint_text_emitted = std::string{};
 
+    CaptionOverloadPolicy policy;
+    // The highest tier reported since the last return to Normal.
+    CaptionOverloadTier reported = CaptionOverloadTier::Normal;
+    bool finals_only = false;  // the tier in force as this pass began
+
     while (!I.worker_should_exit.load(std::memory_order_acquire)) {
-        // ----- Drain ring → recognizer ------------------------------------
-        std::size_t got = drain_ring_to_float(I, feed.data(), feed.size());
-        if (got > 0 && I.recognizer && I.stream) {
-            SherpaOnnxOnlineStreamAcceptWaveform(I.stream, I.sample_rate,
-                                                 feed.data(),
-                                                 static_cast<int32_t>(got));
-            // Decode while ready.
-            while (SherpaOnnxIsOnlineStreamReady(I.recognizer, I.stream)) {
-                SherpaOnnxDecodeOnlineStream(I.recognizer, I.stream);
+        // ----- Wait for a feed's worth -------------------------------------
+        // Woken by the producers rather than polling, so silence costs no
+        // wakeups beyond the audio itself and a chunk is fed as soon as it
+        // is complete.
+        if (!I.feed_ready()) wait_for_samples(I);
+        const int64_t pass_start_ns = now_ns();
+        std::size_t pass_samples = 0;  // of the most-fed source
+        double fill = 0;               // of the fullest ring, as the pass began
+
+        // ----- Drain each ring → its stream --------------------------------
+        for (std::size_t i = 0; i < I.n_active; ++i) {
+            CaptionEngine::Impl::Source& src = *I.order[i];
+            const std::size_t queued = src.queued();
+            if (!src.ring.empty())
+                fill = std::max(fill, static_cast<double>(queued) / src.ring.size());
+            I.ring_ms.record(static_cast<int64_t>(
+                std::min(queued, src.ring.size()) * 1000 / I.sample_rate));
+            std::size_t got = drain_ring_to_float(src, feed.data(), feed.size());
+            pass_samples = std::max(pass_samples, got);
+            if (got > 0) take_arrival(src, src.tail.load(std::memory_order_relaxed));
+            if (got > 0 && I.recognizer && src.stream) {
+                SherpaOnnxOnlineStreamAcceptWaveform(src.stream, I.sample_rate,
+                                                     feed.data(),
+                                                     static_cast<int32_t>(got));
+                src.fed = true;
             }
+        }
+        // (When recognizer is absent — test mode — got>0 just discards the
+        // float buffer; ring drain still advances `tail`.)
 
-            // ----- Pull result + endpoint check ---------------------------
+        // ----- Decode the ready streams together ---------------------------
+        // One batched call per pass runs the encoder once over every ready
+        // stream, so a second source costs little more than the first.
+        TraceSpan decode_span("caption_decode");
+        for (;;) {
+            int32_t n_ready = 0;
+            for (std::size_t i = 0; i < I.n_active; ++i) {
+                CaptionEngine::Impl::Source& src = *I.order[i];
+                if (src.fed && SherpaOnnxIsOnlineStreamReady(I.recognizer, src.stream))
+                    ready[n_ready++] = src.stream;
+            }
+            if (n_ready == 0) break;
+            if (n_ready == 1)
+                SherpaOnnxDecodeOnlineStream(I.recognizer, ready[0]);
+            else
+                SherpaOnnxDecodeMultipleOnlineStreams(I.recognizer, ready.data(), n_ready);
+        }
+        decode_span.end();
+
+        // ----- Pull results + endpoint check, per source -------------------
+        for (std::size_t i = 0; i < I.n_active; ++i) {
+            CaptionEngine::Impl::Source& src = *I.order[i];
+            if (!src.fed) continue;
+            src.fed = false;
+            int is_endpoint = SherpaOnnxOnlineStreamIsEndpoint(I.recognizer, src.stream);
+            // Overloaded: the hypothesis is read only once it is final.
+            if (is_endpoint == 0 && finals_only) continue;
             const SherpaOnnxOnlineRecognizerResult* res =
-                SherpaOnnxGetOnlineStreamResult(I.recognizer, I.stream);
-            int is_endpoint = SherpaOnnxOnlineStreamIsEndpoint(I.recognizer, I.stream);
+                SherpaOnnxGetOnlineStreamResult(I.recognizer, src.stream);
 
             if (res) {
                 std::string text = res->text ? res->text : "";
@@ -395,21 +1100,46 @@ void worker_main(CaptionEngine::Impl* impl) {
                 cr.is_partial = (is_endpoint == 0);
                 cr.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                     std::chrono::steady_clock::now() - I.start_time).count();
+                cr.source = src.id;
                 if (I.on_result && !text.empty()) {
                     I.on_result(cr, I.on_result_ud);
+                    if (src.fed_arrival_ns > 0) {
+                        const int64_t ms = (now_ns() - src.fed_arrival_ns) / 1000000;
+                        (cr.is_partial ? I.partial_ms : I.final_ms).record(ms);
+                        caption_latency_metric(cr.is_partial).observe(ms / 1000.0);
+                    }
                 }
                 SherpaOnnxDestroyOnlineRecognizerResult(res);
             }
 
             if (is_endpoint != 0) {
-                SherpaOnnxOnlineStreamReset(I.recognizer, I.stream);
+                SherpaOnnxOnlineStreamReset(I.recognizer, src.stream);
             }
         }
-        // (When recognizer is absent — test mode — got>0 just discards the
-        // float buffer; ring drain still advances `tail`.)
 
-        // ----- Backpressure observation (rate-limited 1/s) -----------------
-        if (I.overflow_seen.exchange(false, std::memory_order_acq_rel)) {
+        // ----- Decode speed, and the int8 fallback -------------------------
+        const int64_t busy_ns = now_ns() - pass_start_ns;
+        I.busy_ns.fetch_add(busy_ns, std::memory_order_relaxed);
+        I.decoded_samples.fetch_add(static_cast<int64_t>(pass_samples),
+                                    std::memory_order_relaxed);
+        if (fallback) fallback->after_pass(I, busy_ns, pass_samples);
+
+        // ----- Overload tiers (CaptionOverloadPolicy) ----------------------
+        const bool overran = I.overflow_seen.exchange(false, std::memory_order_acq_rel);
+        const CaptionOverloadTier tier = policy.update(fill, overran, now_ns() / 1000000);
+        I.overload_tier.store(static_cast<uint8_t>(tier), std::memory_order_relaxed);
+        if (tier >= CaptionOverloadTier::ReducedDecode && fallback) fallback->reduce(I);
+        if (finals_only != (tier >= CaptionOverloadTier::FinalsOnly)) {
+            finals_only = !finals_only;
+            if (finals_only) log_info("captions: falling behind (ring %.0f%% full); "
+                                      "partials suppressed", fill * 100);
+            else log_info("captions: caught up; partials resume");
+        }
+        if (tier == CaptionOverloadTier::Normal) reported = CaptionOverloadTier::Normal;
+
+        // ----- Degraded events (rate-limited 1/s) --------------------------
+        // Each tier as it is entered; a drop every time one happens.
+        if (overran || (tier > reported && tier < CaptionOverloadTier::Dropping)) {
             auto now = std::chrono::steady_clock::now();
             bool emit = true;
             if (I.last_degraded_emit_set) {
@@ -417,24 +1147,22 @@ void worker_main(CaptionEngine::Impl* impl) {
                     now - I.last_degraded_emit).count();
                 if (since < 1000) {
                     emit = false;
-                    // Re-arm the flag so the next eligible tick still fires.
-                    I.overflow_seen.store(true, std::memory_order_release);
+                    // Re-arm the flag so the next eligible tick still fires;
+                    // an unreported tier is retried on every pass.
+                    if (overran) I.overflow_seen.store(true, std::memory_order_release);
                 }
             }
             if (emit) {
+                const CaptionOverloadTier shown = overran ? CaptionOverloadTier::Dropping : tier;
+                reported = std::max(reported, shown);
                 I.last_degraded_emit = now;
                 I.last_degraded_emit_set = true;
                 I.degraded_emitted.fetch_add(1, std::memory_order_acq_rel);
                 if (I.on_degraded) {
-                    I.on_degraded(CaptionDegradedReason::BufferOverrun, I.on_degraded_ud);
+                    I.on_degraded(overload_reason(shown), I.on_degraded_ud);
                 }
             }
         }
-
-        // ----- Idle pacing -----------------------------------------------
-        if (got == 0) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(I.worker_poll_ms));
-        }
     }
 }
 
@@ -456,93 +1184,94 @@ bool CaptionEngine::start(const Options& opts,
 
     impl_->last_error.clear();
 
+    RecognizerSpec spec;
+    if (!opts._no_recognizer_for_test &&
+        !resolve_recognizer_spec(opts, spec, impl_->last_error))
+        return false;
+    // What DecodeFallback would load: greedy search, int8 under
+    // int8_fallback. The same as `spec` when there is nothing lighter.
+    RecognizerSpec lighter_spec;
     if (!opts._no_recognizer_for_test) {
-        // ----- Resolve model files in opts.model_dir ---------------------
-        const fs::path model_dir(opts.model_dir);
-        if (opts.model_dir.empty()) {
-            impl_->last_error = "caption_engine: Options::model_dir is empty";
-            return false;
-        }
-        std::error_code ec;
-        if (!fs::is_directory(model_dir, ec)) {
-            impl_->last_error = "caption_engine: model_dir is not a directory: " + opts.model_dir;
-            return false;
-        }
-
-        fs::path encoder = find_model_file(model_dir, {"encoder"});
-        fs::path decoder = find_model_file(model_dir, {"decoder"});
-        fs::path joiner  = find_model_file(model_dir, {"joiner"});
-        fs::path tokens  = find_model_file(model_dir, {"tokens"});
-
-        if (encoder.empty() || decoder.empty() || joiner.empty() || tokens.empty()) {
-            impl_->last_error = "caption_engine: missing model files in " + opts.model_dir +
-                                " (need encoder*.onnx, decoder*.onnx, joiner*.onnx, tokens*.txt)";
-            return false;
-        }
-
-        impl_->encoder_path = encoder.string();
-        impl_->decoder_path = decoder.string();
-        impl_->joiner_path  = joiner.string();
-        impl_->tokens_path  = tokens.string();
+        Options lighter = opts;
+        lighter.int8 = opts.int8 || opts.int8_fallback;
+        lighter.decoding_method = "greedy_search";
+        std::string unused;
+        resolve_recognizer_spec(lighter, lighter_spec, unused);
     }
 
-    impl_->decoding_method = opts.decoding_method.empty() ? "greedy_search" : opts.decoding_method;
-    impl_->provider        = "cpu";
-    impl_->model_type      = "";
-
     // ----- Cap thread count -----------------------------------------------
     int requested = std::max(1, opts.num_threads);
     impl_->effective_num_threads = std::min(2, requested);
 
     impl_->sample_rate = opts.sample_rate;
 
+    // ----- Sources, first (on_audio_chunk's) first ------------------------
+    impl_->n_active = 0;
+    bool seen[2] = {false, false};
+    for (CaptionSource id : opts.sources) {
+        const std::size_t i = static_cast<std::size_t>(id);
+        if (i >= impl_->sources.size() || seen[i]) continue;
+        seen[i] = true;
+        impl_->order[impl_->n_active++] = &impl_->sources[i];
+    }
+    if (impl_->n_active == 0)
+        impl_->order[impl_->n_active++] =
+            &impl_->sources[static_cast<std::size_t>(CaptionSource::Mic)];
+
     if (!opts._no_recognizer_for_test) {
-        // ----- Build sherpa-onnx config ---------------------------------
-        SherpaOnnxOnlineRecognizerConfig cfg{};
-        cfg.feat_config.sample_rate = opts.sample_rate;
-        cfg.feat_config.feature_dim = 80;
-
-        cfg.model_config.transducer.encoder = impl_->encoder_path.c_str();
-        cfg.model_config.transducer.decoder = impl_->decoder_path.c_str();
-        cfg.model_config.transducer.joiner  = impl_->joiner_path.c_str();
-        cfg.model_config.tokens             = impl_->tokens_path.c_str();
-        cfg.model_config.num_threads        = impl_->effective_num_threads;
-        cfg.model_config.provider           = impl_->provider.c_str();
-        cfg.model_config.debug              = 0;
-        cfg.model_config.model_type         = impl_->model_type.c_str();
-
-        cfg.decoding_method            = impl_->decoding_method.c_str();
-        cfg.max_active_paths           = 4;
-        cfg.enable_endpoint            = opts.enable_endpoint ? 1 : 0;
-        cfg.rule1_min_trailing_silence = 2.4f;
-        cfg.rule2_min_trailing_silence = 1.2f;
-        cfg.rule3_min_utterance_length = 20.0f;
-        cfg.hotwords_score             = 1.5f;
-
-        impl_->recognizer = SherpaOnnxCreateOnlineRecognizer(&cfg);
+        // ----- Recognizer: the warm one when it matches -----------------
+        impl_->recognizer_key = spec.key();
+        impl_->keep_warm = opts.keep_warm;
+        impl_->lock_memory = opts.lock_memory;
+        impl_->recognizer = take_warm_recognizer(impl_->recognizer_key, impl_->memory);
+        caption_recognizer_start_metric(impl_->recognizer != nullptr).add();
+        if (!impl_->recognizer)
+            impl_->recognizer = create_recognizer(spec, impl_->memory, opts.lock_memory);
+        else log_debug("caption_engine: reusing the warm recognizer");
         if (!impl_->recognizer) {
             impl_->last_error = "caption_engine: SherpaOnnxCreateOnlineRecognizer failed";
             return false;
         }
-        impl_->stream = SherpaOnnxCreateOnlineStream(impl_->recognizer);
-        if (!impl_->stream) {
-            SherpaOnnxDestroyOnlineRecognizer(impl_->recognizer);
-            impl_->recognizer = nullptr;
-            impl_->last_error = "caption_engine: SherpaOnnxCreateOnlineStream failed";
-            return false;
+        // Locked while this engine decodes; release_recognizer() unlocks.
+        if (opts.lock_memory) impl_->memory.lock();
+        // One stream per source, all against this recognizer.
+        for (std::size_t i = 0; i < impl_->n_active; ++i) {
+            Impl::Source& src = *impl_->order[i];
+            src.stream = SherpaOnnxCreateOnlineStream(impl_->recognizer);
+            if (!src.stream) {
+                impl_->release_recognizer();
+                impl_->last_error = "caption_engine: SherpaOnnxCreateOnlineStream failed";
+                return false;
+            }
         }
     }
 
-    // ----- Allocate ring buffer ------------------------------------------
+    // ----- Allocate ring buffers ------------------------------------------
     std::size_t requested_cap =
         opts.ring_capacity_override > 0 ? opts.ring_capacity_override
                                         : 32768;  // ~2s @ 16 kHz mono int16
     std::size_t cap = next_pow2(requested_cap);
-    impl_->ring.assign(cap, int16_t{0});
-    impl_->ring_mask = cap - 1;
-    impl_->head.store(0, std::memory_order_relaxed);
-    impl_->tail.store(0, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < impl_->n_active; ++i) {
+        Impl::Source& src = *impl_->order[i];
+        src.ring.assign(cap, int16_t{0});
+        src.ring_mask = cap - 1;
+        src.head.store(0, std::memory_order_relaxed);
+        src.tail.store(0, std::memory_order_relaxed);
+        src.fed = false;
+        src.mark_head.store(0, std::memory_order_relaxed);
+        src.mark_tail.store(0, std::memory_order_relaxed);
+        src.marked_end = 0;
+        src.fed_arrival_ns = 0;
+        src.active = true;
+    }
+    impl_->partial_ms.reset();
+    impl_->final_ms.reset();
+    impl_->ring_ms.reset();
+    impl_->busy_ns.store(0, std::memory_order_relaxed);
+    impl_->decoded_samples.store(0, std::memory_order_relaxed);
+    impl_->int8.store(spec.int8, std::memory_order_relaxed);
     impl_->overflow_seen.store(false, std::memory_order_relaxed);
+    impl_->overload_tier.store(0, std::memory_order_relaxed);
 
     // ----- Wire callbacks + state for worker -----------------------------
     impl_->on_result    = on_result;
@@ -550,7 +1279,13 @@ bool CaptionEngine::start(const Options& opts,
     impl_->on_degraded  = on_degraded;
     impl_->on_degraded_ud = degraded_userdata;
     impl_->worker_poll_ms = opts.worker_poll_ms_override > 0
-                                ? opts.worker_poll_ms_override : 5;
+                                ? opts.worker_poll_ms_override : 100;
+    impl_->wake_samples = std::max<std::size_t>(1, std::min(FEED_CHUNK, cap / 2));
+    impl_->worker_waiting.store(false, std::memory_order_relaxed);
+    impl_->wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (impl_->wake_fd < 0)
+        log_debug("caption_engine: eventfd unavailable; worker polls every %d ms",
+                  impl_->worker_poll_ms);
     impl_->last_degraded_emit_set = false;
     impl_->degraded_emitted.store(0, std::memory_order_relaxed);
     impl_->start_time = std::chrono::steady_clock::now();
@@ -569,14 +1304,22 @@ bool CaptionEngine::start(const Options& opts,
     // realistic semantics, but we also retain the fact that the test seam is
     // the one observed.
     auto* impl_ptr = impl_.get();
-    impl_->worker = std::thread([impl_ptr, setter, setter_ud]() {
+    impl_->worker = std::thread([impl_ptr, setter, setter_ud, cpus = opts.cpus,
+                                 probe = opts.int8_fallback, model_dir = opts.model_dir,
+                                 lighter_spec = std::move(lighter_spec),
+                                 probe_ms = opts.int8_probe_ms,
+                                 max_rtf = opts.int8_max_rtf]() mutable {
+        if (!pin_current_thread(cpus))
+            log_debug("caption_engine: could not pin the worker to %zu CPUs", cpus.size());
         int rc = setter(setter_ud);
         if (rc == 1) {
             log_debug("caption_engine: SCHED_BATCH unavailable (EPERM); using nice(+10)");
         } else if (rc < 0) {
             log_debug("caption_engine: scheduler tweak unavailable; using default");
         }
-        worker_main(impl_ptr);
+        DecodeFallback fallback(*impl_ptr, std::move(model_dir), std::move(lighter_spec),
+                                probe, probe_ms, max_rtf);
+        worker_main(impl_ptr, &fallback);
     });
 
     return true;
@@ -591,23 +1334,27 @@ void CaptionEngine::stop() {
     }
 
     impl_->worker_should_exit.store(true, std::memory_order_release);
+    if (impl_->wake_fd >= 0) {
+        const uint64_t one = 1;
+        [[maybe_unused]] ssize_t rc = ::write(impl_->wake_fd, &one, sizeof(one));
+    }
     if (impl_->worker.joinable()) {
         impl_->worker.join();
     }
-
-    if (impl_->stream) {
-        SherpaOnnxDestroyOnlineStream(impl_->stream);
-        impl_->stream = nullptr;
-    }
-    if (impl_->recognizer) {
-        SherpaOnnxDestroyOnlineRecognizer(impl_->recognizer);
-        impl_->recognizer = nullptr;
+    if (impl_->wake_fd >= 0) {
+        ::close(impl_->wake_fd);
+        impl_->wake_fd = -1;
     }
 
-    impl_->ring.clear();
-    impl_->ring_mask = 0;
-    impl_->head.store(0, std::memory_order_relaxed);
-    impl_->tail.store(0, std::memory_order_relaxed);
+    impl_->release_recognizer();
+
+    for (auto& src : impl_->sources) {
+        src.active = false;
+        src.ring.clear();
+        src.ring_mask = 0;
+        src.head.store(0, std::memory_order_relaxed);
+        src.tail.store(0, std::memory_order_relaxed);
+    }
     impl_->overflow_seen.store(false, std::memory_order_relaxed);
 
     impl_->on_result = nullptr;
@@ -618,6 +1365,39 @@ void CaptionEngine::stop() {
     impl_->running.store(false, std::memory_order_release);
 }
 
+bool CaptionEngine::prewarm(const Options& opts, std::string* error) {
+    RecognizerSpec spec;
+    std::string err;
+    if (!resolve_recognizer_spec(opts, spec, err)) {
+        if (error) *error = err;
+        return false;
+    }
+    const std::string key = spec.key();
+    ModelMemory memory;
+    const SherpaOnnxOnlineRecognizer* recognizer = take_warm_recognizer(key, memory);
+    if (!recognizer) recognizer = create_recognizer(spec, memory, opts.lock_memory);
+    if (!recognizer) {
+        if (error) *error = "caption_engine: SherpaOnnxCreateOnlineRecognizer failed";
+        return false;
+    }
+    keep_recognizer_warm(key, recognizer, std::move(memory));
+    return true;
+}
+
+void CaptionEngine::drop_warm() {
+    const SherpaOnnxOnlineRecognizer* old = nullptr;
+    ModelMemory old_memory;
+    {
+        auto& warm = warm_recognizer();
+        std::lock_guard<std::mutex> lk(warm.mu);
+        old = warm.recognizer;
+        old_memory = std::move(warm.memory);
+        warm.recognizer = nullptr;
+        warm.key.clear();
+    }
+    if (old) SherpaOnnxDestroyOnlineRecognizer(old);
+}
+
 #endif // RECMEET_USE_SHERPA
 
 } // namespace recmeet
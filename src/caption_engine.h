@@ -3,22 +3,30 @@
 //
 // Phase 2 — Streaming ASR engine.
 //
-// Owns a sherpa-onnx streaming recognizer + a single-producer / single-consumer
-// ring buffer + an ASR worker thread. Producer is the audio capture thread
-// (PipeWire RT-promoted); consumer is the worker thread that feeds the
-// recognizer and emits CaptionResult callbacks.
+// Owns a sherpa-onnx streaming recognizer + one online stream and one
+// single-producer / single-consumer ring buffer per audio source + an ASR
+// worker thread. Producers are the audio capture threads (PipeWire
+// RT-promoted); the consumer is the worker thread that feeds every stream,
+// decodes the ready ones in one batched call, and emits CaptionResult
+// callbacks tagged with their source.
 //
 // Lifecycle:
 //   CaptionEngine eng;
 //   eng.start(opts, on_result, ud, on_degraded, ud);   // spawns worker
 //   capture.set_audio_callback(&CaptionEngine::on_audio_chunk, &eng);  // wire producer
 //   ... audio flows ...
+//   // dual mode: opts.sources = {Monitor, Mic}, then one sink per capture
+//   mic.set_audio_callback(&CaptionEngine::on_source_audio,
+//                          eng.audio_sink(CaptionSource::Mic));
 //   capture.set_audio_callback(nullptr, nullptr);      // stop the producer first
 //   eng.stop();                                        // joins worker, frees recognizer
 //
 // Threading contract:
-//   - `on_audio_chunk()` (producer) is lock-free, non-allocating, non-logging.
-//     Safe to call from a PipeWire RT-promoted thread.
+//   - `on_audio_chunk()` / `on_source_audio()` (producers) are lock-free,
+//     non-allocating, non-logging, one producer thread per source. Safe to
+//     call from a PipeWire RT-promoted thread. It wakes the worker
+//     with one non-blocking eventfd write once a feed chunk (100 ms) is
+//     queued; the worker does not poll.
 //   - `start()` / `stop()` / dtor serialize via an internal mutex and are
 //     re-entrant safe (second `stop()` is a no-op).
 //   - `is_running()` / `last_error()` are safe to call concurrently with
@@ -31,13 +39,28 @@
 
 #pragma once
 
+#include "latency_histogram.h"
+
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace recmeet {
 
+/// Audio source of a caption. In dual-mode recordings the engine decodes
+/// both; otherwise only the mic.
+enum class CaptionSource : uint8_t {
+    Mic,      ///< the local user's microphone
+    Monitor,  ///< the remote side (system audio monitor)
+};
+
+/// Wire / sidecar label for a source: "mic" or "monitor".
+inline const char* caption_source_name(CaptionSource s) {
+    return s == CaptionSource::Monitor ? "monitor" : "mic";
+}
+
 /// One recognizer output. `text` is the engine's raw hypothesis (ALL-CAPS for
 /// the default sherpa-onnx-streaming-zipformer-en-2023-06-26 zipformer locked
 /// in Phase 0.2). `is_partial=true` means a hypothesis update mid-utterance;
@@ -47,12 +70,66 @@ struct CaptionResult {
     std::string text;
     bool is_partial = true;
     int64_t timestamp_ms = 0;  ///< wall-clock since CaptionEngine::start()
+    CaptionSource source = CaptionSource::Mic;  ///< stream the text was decoded from
 };
 
-/// Reasons we may emit a degraded-mode signal. Producer-side overflow is the
-/// only one wired in Phase 2; future causes (ModelStarvation, etc.) may join.
+/// Reasons we may emit a degraded-mode signal: each overload tier as the
+/// worker enters it (CaptionOverloadPolicy; BufferOverrun is the last, when
+/// a producer dropped audio), and the switch to the int8 weights when fp32
+/// decoding fell behind (Options::int8_fallback).
 enum class CaptionDegradedReason {
     BufferOverrun,
+    Int8Fallback,
+    FinalsOnly,     ///< tier 1: partial results suppressed
+    ReducedDecode,  ///< tier 2: and a lighter recognizer, if there is one
+};
+
+/// How far the caption worker has fallen behind, mildest first.
+enum class CaptionOverloadTier : uint8_t {
+    Normal = 0,
+    FinalsOnly = 1,     ///< hypotheses are read only at endpoints
+    ReducedDecode = 2,  ///< and the recognizer is swapped for a lighter one
+    Dropping = 3,       ///< a ring overran: audio was lost
+};
+
+/// The worker's overload policy, fed once per pass. A source whose ring
+/// fills past kFinalsOnlyFill stops producing partials; past
+/// kReducedDecodeFill the worker also loads a lighter recognizer (greedy
+/// search, and the int8 weights with Options::int8_fallback); only a full
+/// ring drops audio. The tier falls back to Normal once every ring has
+/// stayed under kRecoverFill, with no overrun, for kRecoverMs.
+class CaptionOverloadPolicy {
+public:
+    static constexpr double kFinalsOnlyFill = 0.25;
+    static constexpr double kReducedDecodeFill = 0.5;
+    static constexpr double kRecoverFill = 0.125;
+    static constexpr int64_t kRecoverMs = 2000;
+
+    /// After a pass: `fill` is the fullest source's queued audio as a
+    /// fraction of its ring when the pass began (1 or more is a full ring),
+    /// `overran` whether a producer dropped audio since the last pass, and
+    /// `now_ms` a steady clock. Returns the tier now in force.
+    CaptionOverloadTier update(double fill, bool overran, int64_t now_ms);
+
+    CaptionOverloadTier tier() const { return tier_; }
+
+private:
+    CaptionOverloadTier tier_ = CaptionOverloadTier::Normal;
+    int64_t calm_since_ms_ = -1;  // when the rings last went under kRecoverFill
+};
+
+/// Latency and backlog since CaptionEngine::start(), across every source.
+/// Latencies run from the arrival of the newest audio a result reflects
+/// (stamped as on_audio_chunk() / on_source_audio() receive the chunk) to
+/// the result's callback. Ring occupancy is sampled once per worker pass.
+struct CaptionStats {
+    LatencySummary partial_ms;     ///< audio arrival -> partial emitted
+    LatencySummary final_ms;       ///< audio arrival -> final emitted
+    LatencySummary ring_ms;        ///< queued audio per source, in ms
+    int64_t ring_capacity_ms = 0;  ///< one source's ring, in ms
+    double decode_rtf = 0;         ///< worker busy time / audio it decoded
+    bool int8 = false;             ///< decoding with the int8 weights
+    CaptionOverloadTier overload_tier = CaptionOverloadTier::Normal;
 };
 
 using CaptionResultCallback   = void(*)(const CaptionResult& r, void* userdata);
@@ -79,6 +156,44 @@ public:
         int32_t sample_rate = 16000;
         bool enable_endpoint = true;
 
+        /// Load model_dir's quantized `*.int8.onnx` weights instead of the
+        /// fp32 ones. A directory with only one precision loads that one.
+        bool int8 = false;
+
+        /// Measure the decode's real-time factor over the first
+        /// int8_probe_ms of audio and, when it is above int8_max_rtf or a
+        /// ring overran, switch to model_dir's int8 weights rather than
+        /// keep dropping audio. The ReducedDecode overload tier switches to
+        /// them too. The int8 recognizer loads beside the
+        /// running decode and is swapped in between passes; each source's
+        /// utterance in progress is emitted as a final first. A directory
+        /// that fell back starts on int8 for the rest of the process.
+        bool int8_fallback = false;
+        int int8_probe_ms = 5000;
+        double int8_max_rtf = 0.8;
+
+        /// Sources to decode, each with its own online stream and ring
+        /// buffer against the one recognizer (one model load). The first is
+        /// fed by on_audio_chunk(); every one by on_source_audio() with its
+        /// audio_sink(). Duplicates are ignored; empty means {Mic}.
+        std::vector<CaptionSource> sources{CaptionSource::Mic};
+
+        /// CPUs the worker (and the recognizer's pool) is pinned to, e.g.
+        /// a hybrid CPU's efficiency cores. Empty = unpinned.
+        std::vector<int> cpus;
+
+        /// Keep the recognizer when the engine stops, so the next start()
+        /// with the same model and settings reuses it instead of loading
+        /// the encoder, decoder and joiner again (see prewarm()). One
+        /// recognizer is kept per process; a different one replaces it.
+        bool keep_warm = false;
+
+        /// mlock() the recognizer's weights while this engine runs, so
+        /// memory pressure cannot page them out mid-meeting
+        /// (Config::caption_mlock, model_memory.h). A refused lock is
+        /// logged and the engine runs unlocked.
+        bool lock_memory = false;
+
         /// Test seam — when non-null, used in place of the default
         /// sched_setscheduler/nice fallback. The engine is the sole caller.
         SchedulerSetter scheduler_setter = nullptr;
@@ -89,9 +204,10 @@ public:
         /// 16 kHz mono = 32768 samples.
         std::size_t ring_capacity_override = 0;
 
-        /// Test seam — when > 0, the worker uses this many milliseconds as
-        /// its idle/poll interval instead of the default. Lets tests drive
-        /// the consumer loop on a tight cadence.
+        /// Test seam — when > 0, the worker waits at most this many
+        /// milliseconds for the producer's wakeup before draining a
+        /// partial chunk, instead of the default 100. Lets tests drive the
+        /// consumer loop on a tight cadence.
         int worker_poll_ms_override = 0;
 
         /// Test seam — when true, start() skips creating the sherpa-onnx
@@ -113,20 +229,45 @@ public:
                CaptionResultCallback on_result, void* result_userdata,
                CaptionDegradedCallback on_degraded, void* degraded_userdata);
 
+    /// Build the recognizer for `opts` now and keep it warm, so the first
+    /// start() with matching options begins decoding without the model
+    /// load. For the daemon at startup, off the IPC thread. False with
+    /// `error` set when the model cannot be loaded (or in a sherpa-OFF
+    /// build).
+    static bool prewarm(const Options& opts, std::string* error = nullptr);
+
+    /// Destroy the recognizer kept warm, if any.
+    static void drop_warm();
+
     /// Producer-side audio sink. Compatible with AudioChunkCallback. Call as:
     ///   capture.set_audio_callback(&CaptionEngine::on_audio_chunk, engine_ptr);
     /// Lock-free, non-allocating, non-logging. Drops oldest samples on
     /// overflow and sets an atomic flag the worker reads.
     static void on_audio_chunk(const int16_t* samples, std::size_t n, void* engine_ptr);
 
+    /// Producer-side sink for one source. `sink` is audio_sink(source):
+    ///   mic.set_audio_callback(&CaptionEngine::on_source_audio,
+    ///                          engine.audio_sink(CaptionSource::Mic));
+    /// Same contract as on_audio_chunk(); a null sink drops the samples.
+    static void on_source_audio(const int16_t* samples, std::size_t n, void* sink);
+
+    /// Userdata for on_source_audio() that feeds `source`'s stream, or null
+    /// when start() was not asked to decode it. Stable for the engine's
+    /// lifetime.
+    void* audio_sink(CaptionSource source);
+
     /// Test-only: same body as on_audio_chunk() but on an instance, returns
     /// the number of samples dropped due to overflow. Production code must
     /// use on_audio_chunk() so its address is stable for set_audio_callback.
     std::size_t _push_samples_for_test(const int16_t* samples, std::size_t n);
+    /// Test-only: as above, into `source`'s ring.
+    std::size_t _push_samples_for_test(const int16_t* samples, std::size_t n,
+                                       CaptionSource source);
 
-    /// Test-only: number of samples currently sitting in the ring buffer.
-    /// Atomic, safe to call from any thread.
+    /// Test-only: number of samples currently sitting in the ring buffer of
+    /// the first source (or `source`). Atomic, safe to call from any thread.
     std::size_t _ring_occupancy_for_test() const;
+    std::size_t _ring_occupancy_for_test(CaptionSource source) const;
 
     /// Test-only: ring buffer capacity (in samples).
     std::size_t _ring_capacity_for_test() const;
@@ -139,9 +280,18 @@ public:
     /// True between start() success and stop().
     bool is_running() const;
 
+    /// True while any source's ring buffer is more than half full — the worker is
+    /// falling behind real time. Atomic, safe to call from any thread;
+    /// lower-priority work (live transcription) backs off while it holds.
+    bool backlogged() const;
+
     /// Last error message; empty if no error has been observed.
     std::string last_error() const;
 
+    /// Latency histograms and ring occupancy since start(). Safe to call
+    /// from any thread while the engine runs; all zero in the stub build.
+    CaptionStats stats() const;
+
     /// Number of degraded events emitted since start(). Test introspection.
     std::size_t _degraded_events_emitted_for_test() const;
 
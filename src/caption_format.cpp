@@ -125,9 +125,11 @@ std::string normalize_caption(std::string_view raw) {
 
 std::string format_caption_for_cli(std::string_view raw,
                                    bool is_partial,
-                                   bool apply_normalize) {
+                                   bool apply_normalize,
+                                   std::string_view source) {
     std::string text = apply_normalize ? normalize_caption(raw) : std::string(raw);
     std::string indicator = is_partial ? "(partial)" : "(final)  ";
+    if (!source.empty()) text = std::string(source) + ": " + text;
     return "[captions] " + indicator + " " + text;
 }
 
@@ -43,13 +43,16 @@ std::string normalize_caption(std::string_view raw);
 ///
 ///   "[captions] (partial) hello world"
 ///   "[captions] (final)   Hello world."
+///   "[captions] (final)   mic: Hello world."   (with a `source`)
 ///
 /// `apply_normalize` gates `normalize_caption()`. When false, the raw
 /// engine text is rendered verbatim — useful for transcript fidelity
-/// debugging.
+/// debugging. A non-empty `source` (the event's `source` field) labels the
+/// line with the stream it came from.
 std::string format_caption_for_cli(std::string_view raw,
                                    bool is_partial,
-                                   bool apply_normalize);
+                                   bool apply_normalize,
+                                   std::string_view source = {});
 
 /// Format a `caption.degraded` line for the CLI stderr renderer.
 std::string format_caption_degraded_for_cli(std::string_view reason);
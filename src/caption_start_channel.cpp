@@ -5,6 +5,7 @@
 
 #include "caption_start_channel.h"
 
+#include "caption_engine.h"
 #include "log.h"
 
 #include <mutex>
@@ -21,6 +22,9 @@ struct ChannelState {
     bool request_pending = false;
     bool is_worker_active = false;
     std::string pending_model_override;
+
+    std::mutex stats_mu;                    // guards `engine` alone
+    const CaptionEngine* engine = nullptr;
 };
 
 ChannelState g_chan;
@@ -118,6 +122,8 @@ void reset_caption_start_channel() {
     g_chan.request_pending = false;
     g_chan.is_worker_active = false;
     g_chan.pending_model_override.clear();
+    std::lock_guard<std::mutex> stats_lk(g_chan.stats_mu);
+    g_chan.engine = nullptr;
 }
 
 bool is_recording_loop_active() {
@@ -125,4 +131,16 @@ bool is_recording_loop_active() {
     return g_chan.is_worker_active;
 }
 
+void publish_caption_engine(const CaptionEngine* engine) {
+    std::lock_guard<std::mutex> lk(g_chan.stats_mu);
+    g_chan.engine = engine;
+}
+
+bool caption_engine_stats(CaptionStats& out) {
+    std::lock_guard<std::mutex> lk(g_chan.stats_mu);
+    if (!g_chan.engine) return false;
+    out = g_chan.engine->stats();
+    return true;
+}
+
 } // namespace recmeet
@@ -34,6 +34,9 @@
 
 namespace recmeet {
 
+class CaptionEngine;
+struct CaptionStats;
+
 /// Result of a verb-side request to start the caption engine.
 enum class CaptionStartRequestResult {
     AlreadyRunning,   ///< engine already running for this recording.
@@ -92,7 +95,8 @@ void mark_worker_active();
 void clear_worker_active();
 
 /// Reset all three flags (`engine_running`, `request_pending`,
-/// `is_worker_active`) to false and clear the pending model override.
+/// `is_worker_active`) to false, clear the pending model override and
+/// withdraw the published engine.
 /// Called at `run_recording` entry AND exit, and also by tests in a
 /// Catch2 fixture to clear cross-test state. No CV signaling — the
 /// channel has no waiters.
@@ -109,4 +113,14 @@ void reset_caption_start_channel();
 /// own `pipeline_loop_state.h` module.
 bool is_recording_loop_active();
 
+/// Worker-side: make `engine`'s stats visible to caption_engine_stats(),
+/// or withdraw them with nullptr. The engine must be published only while
+/// it runs; withdraw it before stop(). Guarded by its own mutex, so a
+/// caption callback on the engine's worker may read the stats.
+void publish_caption_engine(const CaptionEngine* engine);
+
+/// Stats of the published engine (`status.get`, `caption.degraded`).
+/// False when no engine is published.
+bool caption_engine_stats(CaptionStats& out);
+
 } // namespace recmeet
@@ -9,10 +9,15 @@
 #include "log.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <fcntl.h>
 #include <unistd.h>
@@ -68,75 +73,230 @@ std::string format_vtt_timestamp(std::int64_t ms) {
 }
 
 std::string format_vtt_cue(std::int64_t start_ms, std::int64_t end_ms,
-                           std::string_view text) {
+                           std::string_view text, std::string_view voice) {
     std::string body;
     body.reserve(text.size() + 64);
     body.append(format_vtt_timestamp(start_ms));
     body.append(" --> ");
     body.append(format_vtt_timestamp(end_ms));
     body.push_back('\n');
+    if (!voice.empty()) {
+        body.append("<v ");
+        body.append(voice);
+        body.push_back('>');
+    }
     body.append(escape_vtt_arrow(text));
     body.push_back('\n');
     body.push_back('\n');
     return body;
 }
 
+std::int64_t parse_vtt_timestamp(std::string_view ts) {
+    // Up to three ':'-separated fields, the last with ".mmm".
+    std::int64_t fields[3] = {0, 0, 0};
+    int n = 0;
+    std::size_t i = 0;
+    for (;;) {
+        std::size_t start = i;
+        std::int64_t v = 0;
+        while (i < ts.size() && ts[i] >= '0' && ts[i] <= '9') v = v * 10 + (ts[i++] - '0');
+        if (i == start || n == 3) return -1;
+        fields[n++] = v;
+        if (i < ts.size() && ts[i] == ':') { ++i; continue; }
+        break;
+    }
+    if (n < 2 || i + 4 != ts.size() || ts[i] != '.') return -1;
+    std::int64_t millis = 0;
+    for (std::size_t k = i + 1; k < ts.size(); ++k) {
+        if (ts[k] < '0' || ts[k] > '9') return -1;
+        millis = millis * 10 + (ts[k] - '0');
+    }
+    const std::int64_t h = n == 3 ? fields[0] : 0;
+    const std::int64_t m = fields[n - 2];
+    const std::int64_t sec = fields[n - 1];
+    if (m > 59 || sec > 59) return -1;
+    return ((h * 60 + m) * 60 + sec) * 1000 + millis;
+}
+
+std::vector<VttCue> parse_vtt_cues(std::string_view vtt) {
+    std::vector<VttCue> cues;
+    std::vector<std::string_view> block;
+    auto finish_block = [&] {
+        // [id line] timing line, then text lines.
+        std::size_t t = 0;
+        while (t < block.size() && block[t].find("-->") == std::string_view::npos) ++t;
+        if (t + 1 >= block.size()) { block.clear(); return; }
+        std::string_view timing = block[t];
+        const std::size_t arrow = timing.find("-->");
+        auto trim = [](std::string_view v) {
+            while (!v.empty() && (v.front() == ' ' || v.front() == '\t')) v.remove_prefix(1);
+            while (!v.empty() && (v.back() == ' ' || v.back() == '\t')) v.remove_suffix(1);
+            return v;
+        };
+        std::string_view end = trim(timing.substr(arrow + 3));
+        end = end.substr(0, end.find_first_of(" \t"));  // drop cue settings
+        VttCue cue;
+        cue.start_ms = parse_vtt_timestamp(trim(timing.substr(0, arrow)));
+        cue.end_ms = parse_vtt_timestamp(end);
+        if (cue.start_ms >= 0 && cue.end_ms >= 0) {
+            for (std::size_t k = t + 1; k < block.size(); ++k) {
+                if (!cue.text.empty()) cue.text.push_back(' ');
+                cue.text.append(block[k]);
+            }
+            if (cue.text.compare(0, 3, "<v ") == 0) {
+                const std::size_t close = cue.text.find('>');
+                if (close != std::string::npos) {
+                    cue.voice = cue.text.substr(3, close - 3);
+                    cue.text.erase(0, close + 1);
+                }
+            }
+            for (std::size_t p; (p = cue.text.find("--&gt;")) != std::string::npos;)
+                cue.text.replace(p, 6, "-->");
+            if (!cue.text.empty()) cues.push_back(std::move(cue));
+        }
+        block.clear();
+    };
+
+    bool header = true;
+    std::size_t pos = 0;
+    while (pos <= vtt.size()) {
+        std::size_t nl = vtt.find('\n', pos);
+        if (nl == std::string_view::npos) nl = vtt.size();
+        std::string_view line = vtt.substr(pos, nl - pos);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        pos = nl + 1;
+        if (header) {  // WEBVTT line and any header text up to a blank line
+            if (line.empty()) header = false;
+            continue;
+        }
+        if (line.empty())
+            finish_block();
+        else
+            block.push_back(line);
+    }
+    finish_block();
+    return cues;
+}
+
 // ---------------------------------------------------------------------------
-// VttWriter — owns an O_APPEND fd and a "header written" flag
+// VttWriter — a cue queue drained by a writer thread that owns the fd
 // ---------------------------------------------------------------------------
 
 struct VttWriter::Impl {
+    struct Cue {
+        std::int64_t start_ms;
+        std::int64_t end_ms;
+        std::string text;
+        std::string voice;
+    };
+
     std::filesystem::path path;
     bool normalize_display = true;
+
+    // Writer thread only (and close(), after the join).
     int fd = -1;
-    bool header_written = false;
-    std::string last_error;
+    std::atomic<bool> open{false};
+    std::atomic<bool> header_written{false};
+
+    std::mutex mu;
+    std::condition_variable cv;        // cue queued, or stopping
+    std::condition_variable done_cv;   // a batch handled
+    std::vector<Cue> queue;            // guarded by mu
+    std::uint64_t queued = 0;          // cues accepted, guarded by mu
+    std::uint64_t handled = 0;         // cues written or failed, guarded by mu
+    bool stopping = false;             // guarded by mu
+    bool closed = false;               // guarded by mu
+    bool failing = false;              // last batch failed, guarded by mu
+    std::string last_error;            // guarded by mu
+    std::thread worker;
 
     explicit Impl(std::filesystem::path p, bool normalize)
-        : path(std::move(p)), normalize_display(normalize) {}
+        : path(std::move(p)), normalize_display(normalize) {
+        worker = std::thread([this] { run(); });
+    }
 
-    ~Impl() { close_fd(); }
+    ~Impl() { close(); }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            closed = true;
+            stopping = true;
+        }
+        cv.notify_all();
+        if (worker.joinable()) worker.join();
+        close_fd();
+    }
 
     void close_fd() {
         if (fd >= 0) {
             ::close(fd);
             fd = -1;
         }
+        open.store(false, std::memory_order_release);
     }
 
-    // Open the file (O_APPEND | O_CREAT | O_WRONLY) and write the WEBVTT
-    // header in a single write(2). Returns true on success; on failure sets
-    // last_error and leaves fd in its prior state (closed if it was closed).
-    bool ensure_open_and_header_written() {
-        if (header_written) return true;
+    void run() {
+        std::vector<Cue> batch;
+        std::unique_lock<std::mutex> lock(mu);
+        for (;;) {
+            cv.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;  // stopping, and everything written
+            batch.swap(queue);
+            lock.unlock();
+            std::string err = write_batch(batch);
+            const std::size_t n = batch.size();
+            batch.clear();
+            lock.lock();
+            handled += n;
+            failing = !err.empty();
+            if (failing) last_error = std::move(err);
+            done_cv.notify_all();
+        }
+    }
+
+    // Format `batch` and write it, header first when the file has none yet,
+    // in one write(2). Returns an error message, empty on success.
+    std::string write_batch(const std::vector<Cue>& batch) {
+        std::string buf;
+        const bool header = !header_written.load(std::memory_order_relaxed);
+        if (header) buf.append("WEBVTT\n\n");
+        for (const auto& cue : batch) {
+            // `format_vtt_cue` handles `-->` escaping and the trailing
+            // blank-line terminator; only normalization is applied here
+            // (the caller passes raw engine text for V1).
+            if (normalize_display)
+                buf.append(format_vtt_cue(cue.start_ms, cue.end_ms,
+                                          normalize_caption(cue.text), cue.voice));
+            else
+                buf.append(format_vtt_cue(cue.start_ms, cue.end_ms, cue.text, cue.voice));
+        }
+
         if (fd < 0) {
-            fd = ::open(path.c_str(),
-                        O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC,
-                        0644);
-            if (fd < 0) {
-                last_error = std::string("open() failed: ") + std::strerror(errno);
-                return false;
-            }
+            fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+            if (fd < 0) return std::string("open() failed: ") + std::strerror(errno);
+            open.store(true, std::memory_order_release);
         }
-        // Write the header. A short write on an 8-byte payload to a regular
-        // file is essentially impossible, but loop for paranoia.
-        static constexpr std::string_view kHeader{"WEBVTT\n\n"};
-        const char* p = kHeader.data();
-        std::size_t remaining = kHeader.size();
+        // Loop on EINTR / short writes for paranoia.
+        const char* p = buf.data();
+        std::size_t remaining = buf.size();
         while (remaining > 0) {
             ssize_t n = ::write(fd, p, remaining);
             if (n < 0) {
                 if (errno == EINTR) continue;
-                last_error = std::string("write(header) failed: ")
-                             + std::strerror(errno);
-                close_fd();
-                return false;
+                std::string err = std::string(header ? "write(header) failed: "
+                                                     : "write(cue) failed: ")
+                                  + std::strerror(errno);
+                // Without its header the file is reopened and headed by the
+                // next batch.
+                if (header) close_fd();
+                return err;
             }
             p += n;
             remaining -= static_cast<std::size_t>(n);
         }
-        header_written = true;
-        return true;
+        header_written.store(true, std::memory_order_release);
+        return {};
     }
 };
 
@@ -146,62 +306,59 @@ VttWriter::VttWriter(std::filesystem::path path, bool normalize_display)
 VttWriter::~VttWriter() = default;
 
 bool VttWriter::append(std::int64_t start_ms, std::int64_t end_ms,
-                       std::string_view text, bool is_partial) {
+                       std::string_view text, bool is_partial,
+                       std::string_view voice) {
     if (!impl_) return false;
     // Defense in depth: partials are never persisted. The daemon already
     // filters before reaching the writer in production; this guard makes
     // the writer self-contained and unit-testable.
     if (is_partial) return true;
 
-    if (!impl_->ensure_open_and_header_written()) {
-        // last_error already populated.
-        return false;
-    }
-
-    // Format the cue. `format_vtt_cue` handles `-->` escaping and the
-    // trailing blank-line terminator; we only need to apply normalization
-    // here (the caller passes raw engine text for V1).
-    std::string normalized;
-    std::string_view body = text;
-    if (impl_->normalize_display) {
-        normalized = normalize_caption(text);
-        body = normalized;
-    }
-    std::string cue = format_vtt_cue(start_ms, end_ms, body);
-
-    // Single write(2). On Linux, O_APPEND writes up to one filesystem block
-    // are atomic against concurrent writers; a typical cue (~100 B) fits
-    // well within that. We still loop on EINTR / short writes for paranoia.
-    const char* p = cue.data();
-    std::size_t remaining = cue.size();
-    while (remaining > 0) {
-        ssize_t n = ::write(impl_->fd, p, remaining);
-        if (n < 0) {
-            if (errno == EINTR) continue;
-            impl_->last_error = std::string("write(cue) failed: ")
-                                + std::strerror(errno);
+    bool ok;
+    {
+        std::lock_guard<std::mutex> lock(impl_->mu);
+        if (impl_->closed) {
+            impl_->last_error = "writer closed";
+            return false;
+        }
+        // Drop rather than wait: the caller is the caption worker.
+        if (impl_->queue.size() >= kMaxQueuedCues) {
+            impl_->last_error = "writer " + std::to_string(kMaxQueuedCues)
+                                + " cues behind; cue dropped";
             return false;
         }
-        p += n;
-        remaining -= static_cast<std::size_t>(n);
+        impl_->queue.push_back({start_ms, end_ms, std::string(text), std::string(voice)});
+        ++impl_->queued;
+        ok = !impl_->failing;
     }
-    return true;
+    impl_->cv.notify_one();
+    return ok;
+}
+
+bool VttWriter::flush() {
+    if (!impl_) return false;
+    std::unique_lock<std::mutex> lock(impl_->mu);
+    const std::uint64_t target = impl_->queued;
+    impl_->done_cv.wait(lock, [&] { return impl_->handled >= target; });
+    return !impl_->failing;
 }
 
 void VttWriter::close() {
-    if (impl_) impl_->close_fd();
+    if (impl_) impl_->close();
 }
 
 bool VttWriter::is_open() const {
-    return impl_ && impl_->fd >= 0;
+    return impl_ && impl_->open.load(std::memory_order_acquire);
 }
 
 std::string VttWriter::last_error() const {
-    return impl_ ? impl_->last_error : std::string{};
+    if (!impl_) return {};
+    std::lock_guard<std::mutex> lock(impl_->mu);
+    return impl_->last_error;
 }
 
 bool VttWriter::_header_written_for_test() const {
-    return impl_ && impl_->header_written;
+    return impl_ && impl_->header_written.load(std::memory_order_acquire);
 }
 
 } // namespace recmeet
@@ -11,12 +11,15 @@
 //     depth on top of the daemon's existing partial filter).
 //   - Lazy file creation. The header `WEBVTT\n\n` is written on the first
 //     finalized append, so silent sessions produce no `.vtt` at all.
-//   - Single `write(2)` per cue. On Linux, `O_APPEND` writes up to one
-//     filesystem block (~4 KiB on btrfs/ext4) are atomic against concurrent
-//     writers — well above WebVTT's ~100 B per cue. We do NOT call `fsync`;
-//     the file is non-authoritative and the FS writeback window (≤30 s) is
-//     acceptable. On crash mid-recording the file is valid up to the last
-//     fully-flushed cue (parsers tolerate trailing garbage).
+//   - Off the caption path. append() only queues the cue; a writer thread
+//     formats whatever is queued and writes it with a single `write(2)`
+//     per batch, so a slow filesystem (NFS home, SD card) never stalls the
+//     caption worker or backs up its ring. The queue is bounded: when the
+//     writer falls kMaxQueuedCues behind, append() drops the cue and
+//     returns false rather than wait. close() writes what is queued.
+//   - No `fsync`; the file is non-authoritative and the FS writeback window
+//     (≤30 s) is acceptable. On crash mid-recording the file is valid up to
+//     the last fully-flushed cue (parsers tolerate trailing garbage).
 //   - No cue identifiers. Each cue block is self-contained; the writer
 //     never has to renumber.
 //   - No UTF-8 validation. Raw bytes pass through to `write()`.
@@ -26,17 +29,26 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 namespace recmeet {
 
+/// The sidecar's name in a meeting directory.
+inline constexpr const char* CAPTIONS_VTT_NAME = "captions.vtt";
+
 class VttWriter {
 public:
+    /// Cues append() may queue ahead of the writer thread (~10 min of
+    /// speech at typical cue rates).
+    static constexpr std::size_t kMaxQueuedCues = 256;
+
     /// Construct without opening — `path` is where the sidecar will live.
     /// File is NOT created until the first append() call (silent sessions
     /// produce no `.vtt` at all). When `normalize_display` is true (the
@@ -49,15 +61,24 @@ public:
     VttWriter(const VttWriter&) = delete;
     VttWriter& operator=(const VttWriter&) = delete;
 
-    /// Append a finalized caption cue. Lazily opens the file and writes
-    /// the `WEBVTT\n\n` header on first call. Subsequent calls append cue
-    /// blocks. Caller must NOT call this with partial captions; partials
-    /// are silently dropped (defense in depth — daemon already filters).
-    /// Returns false on I/O error; sets last_error().
+    /// Queue a finalized caption cue for the writer thread, which lazily
+    /// opens the file and writes the `WEBVTT\n\n` header with the first
+    /// batch. Never blocks on I/O. Caller must NOT call this with partial
+    /// captions; partials are silently dropped (defense in depth — daemon
+    /// already filters). A non-empty `voice` tags the cue with its speaker
+    /// (`<v voice>`). Returns false, with last_error() set, when the cue
+    /// was dropped (queue full, writer closed) or the last batch failed to
+    /// write.
     bool append(std::int64_t start_ms, std::int64_t end_ms,
-                std::string_view text, bool is_partial);
+                std::string_view text, bool is_partial,
+                std::string_view voice = {});
 
-    /// Optional explicit close — destructor closes too.
+    /// Block until every cue queued so far is written (or failed). Returns
+    /// false when the last batch failed.
+    bool flush();
+
+    /// Write what is queued, stop the writer thread and close the file.
+    /// Idempotent; the destructor closes too.
     void close();
 
     bool is_open() const;
@@ -84,9 +105,28 @@ std::string format_vtt_timestamp(std::int64_t ms);
 /// The trailing blank line is part of the cue terminator — every cue ends
 /// with two `\n`s. If `text` contains the literal `-->` substring it is
 /// replaced with `--&gt;` so a stray arrow never confuses a WebVTT parser.
-/// `text` is otherwise byte-transparent (no UTF-8 validation).
+/// `text` is otherwise byte-transparent (no UTF-8 validation). A non-empty
+/// `voice` prefixes the text with a WebVTT voice span, `<v voice>TEXT`.
 std::string format_vtt_cue(std::int64_t start_ms, std::int64_t end_ms,
-                           std::string_view text);
+                           std::string_view text, std::string_view voice = {});
+
+/// One cue read back from a sidecar by parse_vtt_cues().
+struct VttCue {
+    std::int64_t start_ms = 0;
+    std::int64_t end_ms = 0;
+    std::string text;   ///< cue lines joined by spaces, `--&gt;` restored
+    std::string voice;  ///< from a leading `<v voice>` span, else empty
+};
+
+/// Parse WebVTT `HH:MM:SS.mmm` (hours may run past two digits) or
+/// `MM:SS.mmm`. Returns -1 when `ts` is neither. Pure.
+std::int64_t parse_vtt_timestamp(std::string_view ts);
+
+/// The cues of a WebVTT document, in file order. Understands what
+/// VttWriter writes plus cue identifiers and `\r\n` line ends; a cue
+/// without a valid timing line or without text (a crash mid-write) is
+/// skipped. Pure.
+std::vector<VttCue> parse_vtt_cues(std::string_view vtt);
 
 /// Pair-tracking helper used by the daemon's caption fan-out adapter to
 /// turn the engine's single `timestamp_ms` per result into a (start, end)
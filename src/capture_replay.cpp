@@ -0,0 +1,305 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "capture_replay.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include <sndfile.h>
+
+namespace recmeet {
+
+namespace {
+
+constexpr const char* REPLAY_REPORT_PREFIX = "replay_";
+
+int64_t steady_ns(std::chrono::steady_clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+int64_t now_ns() { return steady_ns(std::chrono::steady_clock::now()); }
+
+// The WAV as 16 kHz mono S16, downmixed like read_wav_float().
+std::vector<int16_t> read_replay_wav(const fs::path& path) {
+    SF_INFO info = {};
+    SNDFILE* sf = sf_open(path.c_str(), SFM_READ, &info);
+    if (!sf)
+        throw RecmeetError("replay: cannot open " + path.string() + " (" +
+                           sf_strerror(nullptr) + ")");
+    if (info.samplerate != SAMPLE_RATE || info.channels < 1) {
+        sf_close(sf);
+        throw RecmeetError("replay: " + path.string() + " is " +
+                           std::to_string(info.samplerate) + " Hz; replay needs " +
+                           std::to_string(SAMPLE_RATE) + " Hz");
+    }
+    std::vector<int16_t> frames(static_cast<std::size_t>(info.frames) * info.channels);
+    const sf_count_t got = sf_read_short(sf, frames.data(), static_cast<sf_count_t>(frames.size()));
+    sf_close(sf);
+    if (got <= 0) throw RecmeetError("replay: " + path.string() + " holds no audio");
+    frames.resize(static_cast<std::size_t>(got));
+    if (info.channels == 1) return frames;
+
+    std::vector<int16_t> mono(frames.size() / info.channels);
+    for (std::size_t i = 0; i < mono.size(); ++i) {
+        int32_t sum = 0;
+        for (int ch = 0; ch < info.channels; ++ch) sum += frames[i * info.channels + ch];
+        mono[i] = static_cast<int16_t>(sum / info.channels);
+    }
+    return mono;
+}
+
+} // anonymous namespace
+
+double JitterProfile::frames_per_sec() const {
+    uint64_t frames = 0, us = 0;
+    for (const auto& t : ticks) {
+        frames += t.frames;
+        us += t.interval_us;
+    }
+    return us > 0 ? static_cast<double>(frames) * 1e6 / static_cast<double>(us) : 0.0;
+}
+
+JitterProfile builtin_jitter_profile(const std::string& name) {
+    JitterProfile p;
+    p.name = name;
+    if (name == "steady") {
+        p.ticks = {{320, 20000}};
+    } else if (name == "pipewire") {
+        // 1024 frames at 48 kHz is 341.33 frames at 16 kHz every 21.33 ms.
+        // One wakeup in 48 comes 4 ms late and the next one early, as the
+        // graph catches up; the cycle is 1.024 s of audio.
+        for (int i = 0; i < 48; ++i) {
+            const bool third = i % 3 == 2;
+            JitterTick t{third ? 342u : 341u, third ? 21334u : 21333u};
+            if (i == 20) t.interval_us += 4000;
+            if (i == 21) t.interval_us -= 4000;
+            p.ticks.push_back(t);
+        }
+    } else if (name == "bluetooth") {
+        // Three 20 ms chunks arrive together every 60 ms on average, with
+        // an uneven gap now and then.
+        for (uint32_t gap : {60000u, 60000u, 90000u, 30000u}) {
+            p.ticks.push_back({320, gap});
+            p.ticks.push_back({320, 0});
+            p.ticks.push_back({320, 0});
+        }
+    } else {
+        throw RecmeetError("replay: unknown jitter profile '" + name +
+                           "' (steady, pipewire, bluetooth or a profile file)");
+    }
+    return p;
+}
+
+JitterProfile load_jitter_profile(const fs::path& path) {
+    std::ifstream in(path);
+    if (!in) throw RecmeetError("replay: cannot read jitter profile " + path.string());
+    JitterProfile p;
+    p.name = path.filename().string();
+    std::string line;
+    while (std::getline(in, line)) {
+        const auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        std::istringstream fields(line);
+        int64_t frames = 0, interval = 0;
+        if (!(fields >> frames >> interval)) continue;
+        if (frames < 0 || interval < 0 || frames > std::numeric_limits<uint32_t>::max() ||
+            interval > std::numeric_limits<uint32_t>::max())
+            continue;
+        p.ticks.push_back({static_cast<uint32_t>(frames), static_cast<uint32_t>(interval)});
+    }
+    if (p.ticks.empty())
+        throw RecmeetError("replay: jitter profile " + path.string() + " holds no ticks");
+    return p;
+}
+
+void save_jitter_profile(const fs::path& path, const JitterProfile& profile) {
+    std::ostringstream out;
+    out << "# recmeet jitter profile: " << profile.name << "\n"
+        << "# " << profile.ticks.size() << " callbacks, "
+        << std::lround(profile.frames_per_sec()) << " frames/s\n"
+        << "# frames interval_us\n";
+    for (const auto& t : profile.ticks) out << t.frames << ' ' << t.interval_us << '\n';
+    write_text_file_atomic(path, out.str());
+}
+
+JitterProfile resolve_jitter_profile(const std::string& name_or_path) {
+    JitterProfile p = name_or_path.find('/') == std::string::npos &&
+                              !fs::exists(name_or_path)
+        ? builtin_jitter_profile(name_or_path)
+        : load_jitter_profile(name_or_path);
+    uint64_t frames = 0;
+    for (const auto& t : p.ticks) frames += t.frames;
+    if (frames == 0)
+        throw RecmeetError("replay: jitter profile " + p.name + " delivers no frames");
+    return p;
+}
+
+bool is_replay_source(const std::string& source) {
+    return source.rfind(REPLAY_SOURCE_PREFIX, 0) == 0;
+}
+
+ReplaySpec parse_replay_source(const std::string& source) {
+    if (!is_replay_source(source))
+        throw RecmeetError("not a replay source: " + source);
+    std::string rest = source.substr(std::string(REPLAY_SOURCE_PREFIX).size());
+    std::string query;
+    const auto q = rest.find('?');
+    if (q != std::string::npos) {
+        query = rest.substr(q + 1);
+        rest.erase(q);
+    }
+    if (rest.empty()) throw RecmeetError("replay source without a WAV path: " + source);
+
+    ReplaySpec spec;
+    spec.wav = rest;
+    std::istringstream params(query);
+    std::string param;
+    while (std::getline(params, param, '&')) {
+        if (param.empty()) continue;
+        const auto eq = param.find('=');
+        const std::string key = param.substr(0, eq);
+        const std::string value = eq == std::string::npos ? "" : param.substr(eq + 1);
+        if (key == "speed") {
+            char* end = nullptr;
+            spec.speed = std::strtod(value.c_str(), &end);
+            if (value.empty() || *end != '\0' || !(spec.speed > 0) || !std::isfinite(spec.speed))
+                throw RecmeetError("replay: speed must be a positive number, not '" + value + "'");
+        } else if (key == "jitter") {
+            if (value.empty()) throw RecmeetError("replay: empty jitter profile");
+            spec.jitter = value;
+        } else {
+            throw RecmeetError("replay: unknown parameter '" + key + "' (speed, jitter)");
+        }
+    }
+    return spec;
+}
+
+double ReplayStats::achieved_speed() const {
+    return wall_sec > 0 ? static_cast<double>(samples) / SAMPLE_RATE / wall_sec : 0.0;
+}
+
+CaptureReplay::CaptureReplay(const ReplaySpec& spec, AudioChunkCallback deliver, void* userdata)
+    : spec_(spec), profile_(resolve_jitter_profile(spec.jitter)),
+      samples_(read_replay_wav(spec.wav)), deliver_(deliver), userdata_(userdata) {}
+
+CaptureReplay::~CaptureReplay() { stop(); }
+
+void CaptureReplay::start() {
+    if (thread_.joinable()) return;
+    log_info("replay: %s (%.1fs) at %.2gx, jitter %s", spec_.wav.c_str(),
+             static_cast<double>(samples_.size()) / SAMPLE_RATE, spec_.speed,
+             profile_.name.c_str());
+    stop_.reset();
+    thread_ = std::thread(&CaptureReplay::run, this);
+}
+
+void CaptureReplay::stop() {
+    stop_.request();
+    if (thread_.joinable()) thread_.join();
+}
+
+void CaptureReplay::run() {
+    const auto t0 = std::chrono::steady_clock::now();
+    started_ns_.store(steady_ns(t0), std::memory_order_relaxed);
+    // Deliveries keep to an absolute schedule, so one late wakeup does not
+    // slow the rest of the replay.
+    double due_us = 0;
+    std::size_t pos = 0;
+    for (std::size_t i = 0; pos < samples_.size() && !stop_.stop_requested(); ++i) {
+        const JitterTick& tick = profile_.ticks[i % profile_.ticks.size()];
+        due_us += tick.interval_us / spec_.speed;
+        const auto due = t0 + std::chrono::microseconds(std::llround(due_us));
+        std::this_thread::sleep_until(due);
+        if (stop_.stop_requested()) break;
+
+        const auto now = std::chrono::steady_clock::now();
+        const int64_t late =
+            std::chrono::duration_cast<std::chrono::microseconds>(now - due).count();
+        late_us_.record(late);
+        if (late > REPLAY_LATE_US) late_chunks_.fetch_add(1, std::memory_order_relaxed);
+
+        const std::size_t n = std::min<std::size_t>(tick.frames, samples_.size() - pos);
+        if (n > 0) deliver_(samples_.data() + pos, n, userdata_);
+        pos += n;
+        delivered_.fetch_add(n, std::memory_order_relaxed);
+        chunks_.fetch_add(1, std::memory_order_relaxed);
+        last_ns_.store(steady_ns(now), std::memory_order_relaxed);
+    }
+    if (pos >= samples_.size()) {
+        finished_.store(true, std::memory_order_release);
+        log_info("replay: %s delivered", spec_.wav.filename().c_str());
+    }
+}
+
+ReplayStats CaptureReplay::stats() const {
+    ReplayStats s;
+    s.chunks = chunks_.load(std::memory_order_relaxed);
+    s.samples = delivered_.load(std::memory_order_relaxed);
+    s.late_chunks = late_chunks_.load(std::memory_order_relaxed);
+    s.late_us = late_us_.summary();
+    s.audio_sec = static_cast<double>(samples_.size()) / SAMPLE_RATE;
+    s.finished = finished();
+    const int64_t start = started_ns_.load(std::memory_order_relaxed);
+    if (start != 0) {
+        const int64_t end = s.finished ? last_ns_.load(std::memory_order_relaxed) : now_ns();
+        s.wall_sec = static_cast<double>(end - start) / 1e9;
+    }
+    return s;
+}
+
+JitterRecorder::JitterRecorder(std::size_t max_ticks) : ticks_(max_ticks) {}
+
+void JitterRecorder::note(uint32_t frames) noexcept {
+    const int64_t now = now_ns();
+    const int64_t gap_us = last_ns_ == 0 ? 0 : (now - last_ns_) / 1000;
+    last_ns_ = now;
+    const std::size_t i = count_.load(std::memory_order_relaxed);
+    if (i >= ticks_.size()) return;
+    ticks_[i].frames = frames;
+    ticks_[i].interval_us = static_cast<uint32_t>(
+        std::min<int64_t>(gap_us, std::numeric_limits<uint32_t>::max()));
+    count_.store(i + 1, std::memory_order_release);
+}
+
+JitterProfile JitterRecorder::profile(const std::string& name) const {
+    JitterProfile p;
+    p.name = name;
+    const std::size_t n = std::min(count_.load(std::memory_order_acquire), ticks_.size());
+    p.ticks.assign(ticks_.begin(), ticks_.begin() + static_cast<std::ptrdiff_t>(n));
+    return p;
+}
+
+bool jitter_recording_requested() {
+    const char* env = std::getenv("RECMEET_RECORD_JITTER");
+    return env && *env && std::string(env) != "0";
+}
+
+void add_replay_stats(JsonMap& m, const std::string& label, const ReplayStats& stats) {
+    const std::string p = label + ".";
+    m[p + "chunks"] = static_cast<int64_t>(stats.chunks);
+    m[p + "samples"] = static_cast<int64_t>(stats.samples);
+    m[p + "audio_sec"] = stats.audio_sec;
+    m[p + "wall_sec"] = stats.wall_sec;
+    m[p + "achieved_speed"] = stats.achieved_speed();
+    m[p + "finished"] = stats.finished;
+    m[p + "late_chunks"] = static_cast<int64_t>(stats.late_chunks);
+    m[p + "late_p50_us"] = stats.late_us.p50;
+    m[p + "late_p99_us"] = stats.late_us.p99;
+    m[p + "late_max_us"] = stats.late_us.max;
+}
+
+fs::path replay_report_path(const fs::path& audio_path) {
+    std::string stem = audio_path.stem().string();
+    const std::string prefix = AUDIO_PREFIX;
+    if (stem.compare(0, prefix.size(), prefix) == 0)
+        stem.erase(0, prefix.size());
+    return audio_path.parent_path() / (std::string(REPLAY_REPORT_PREFIX) + stem + ".json");
+}
+
+} // namespace recmeet
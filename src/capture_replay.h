@@ -0,0 +1,179 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "audio_capture.h"  // for AudioChunkCallback
+#include "ipc_protocol.h"
+#include "latency_histogram.h"
+#include "util.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Capture replay (source `replay:<wav>[?speed=<x>&jitter=<profile>]`)
+// ---------------------------------------------------------------------------
+//
+// A replay source stands in for a PipeWire or PulseAudio device so that
+// the recording path can be measured without one. PipeWireCapture and
+// PulseMonitorCapture recognize the `replay:` prefix in start(): instead of
+// opening a stream, a CaptureReplay thread reads the WAV and hands it to
+// the same enqueue/delivery path the device callback uses, chunk by chunk,
+// on the schedule of a jitter profile:
+//
+//   steady     320 frames every 20 ms
+//   pipewire   a 1024-frame 48 kHz quantum resampled to 16 kHz: 341 or
+//              342 frames every 21.33 ms, with a few delayed wakeups
+//   bluetooth  A2DP-style bursts: three chunks at once, then a gap
+//   <path>     a profile recorded from a real device (RECMEET_RECORD_JITTER)
+//
+// A profile is cycled for as long as the WAV lasts, so a replay is the
+// same sequence of chunks every run. `speed` divides every interval. 4
+// replays an hour in 15 minutes. The daemon's recording loop ends by
+// itself when every replay source has delivered its WAV. It then writes
+// replay_<ts>.json beside the audio: per capture, what was delivered and
+// how late, plus the caption latencies (see replay_report_path()).
+//
+// With RECMEET_RECORD_JITTER=1 in the environment, real captures record
+// their callback sizes and intervals (JitterRecorder) into jitter_mic.txt
+// and jitter_monitor.txt in the meeting directory, in the profile format.
+
+constexpr const char* REPLAY_SOURCE_PREFIX = "replay:";
+
+/// A delivery later than this behind its schedule counts as late.
+constexpr int64_t REPLAY_LATE_US = 1000;
+
+/// Most callbacks a JitterRecorder keeps (~23 min at PipeWire's 21 ms).
+constexpr std::size_t JITTER_RECORD_MAX_TICKS = std::size_t(1) << 16;
+
+/// One capture callback: `frames` samples, `interval_us` after the one
+/// before it.
+struct JitterTick {
+    uint32_t frames = 0;
+    uint32_t interval_us = 0;
+};
+
+struct JitterProfile {
+    std::string name;
+    std::vector<JitterTick> ticks;
+
+    /// Frames per second the profile delivers at speed 1; 0 when empty.
+    double frames_per_sec() const;
+};
+
+/// "steady", "pipewire" or "bluetooth". Throws RecmeetError otherwise.
+JitterProfile builtin_jitter_profile(const std::string& name);
+
+/// The profile format: `#` comments, then one "<frames> <interval_us>"
+/// line per callback. Throws RecmeetError when `path` cannot be read or
+/// holds no tick.
+JitterProfile load_jitter_profile(const fs::path& path);
+void save_jitter_profile(const fs::path& path, const JitterProfile& profile);
+
+/// A built-in profile by name, else a profile file.
+JitterProfile resolve_jitter_profile(const std::string& name_or_path);
+
+struct ReplaySpec {
+    fs::path wav;
+    double speed = 1.0;
+    std::string jitter = "pipewire";
+};
+
+bool is_replay_source(const std::string& source);
+
+/// Parse `replay:<wav>[?speed=<x>&jitter=<profile>]`. Throws RecmeetError
+/// for a source without the prefix, an empty path, an unknown key or a
+/// speed that is not positive.
+ReplaySpec parse_replay_source(const std::string& source);
+
+/// What a replay delivered, and how far behind its schedule.
+struct ReplayStats {
+    uint64_t chunks = 0;
+    uint64_t samples = 0;
+    uint64_t late_chunks = 0;   ///< delivered over REPLAY_LATE_US late
+    LatencySummary late_us;     ///< delivery lateness per chunk
+    double audio_sec = 0;       ///< the WAV's length
+    double wall_sec = 0;        ///< first chunk to the last (or to now)
+    bool finished = false;      ///< the whole WAV was delivered
+
+    /// audio / wall: the pace achieved; 0 before any wall time.
+    double achieved_speed() const;
+};
+
+/// Feeds a WAV to `deliver` on a jitter profile's schedule from its own
+/// thread. The WAV (any format libsndfile reads, downmixed to 16 kHz mono
+/// S16) is loaded by the constructor, which throws RecmeetError when it
+/// cannot be read or the profile cannot be resolved.
+class CaptureReplay {
+public:
+    CaptureReplay(const ReplaySpec& spec, AudioChunkCallback deliver, void* userdata);
+    ~CaptureReplay();
+
+    CaptureReplay(const CaptureReplay&) = delete;
+    CaptureReplay& operator=(const CaptureReplay&) = delete;
+
+    void start();
+    /// Stop delivering and join the thread. Idempotent.
+    void stop();
+
+    bool finished() const { return finished_.load(std::memory_order_acquire); }
+    ReplayStats stats() const;
+    const ReplaySpec& spec() const { return spec_; }
+
+private:
+    void run();
+
+    ReplaySpec spec_;
+    JitterProfile profile_;
+    std::vector<int16_t> samples_;
+    AudioChunkCallback deliver_;
+    void* userdata_;
+
+    std::thread thread_;
+    StopToken stop_;
+    std::atomic<bool> finished_{false};
+    std::atomic<uint64_t> chunks_{0};
+    std::atomic<uint64_t> delivered_{0};
+    std::atomic<uint64_t> late_chunks_{0};
+    std::atomic<int64_t> started_ns_{0};   // steady clock; 0 = not started
+    std::atomic<int64_t> last_ns_{0};
+    LatencyHistogram late_us_;
+};
+
+/// Records the size and spacing of capture callbacks into a preallocated
+/// buffer. note() is called from the capture's (RT) callback and never
+/// allocates, locks or logs; one thread notes at a time. Callbacks past
+/// `max_ticks` are not kept.
+class JitterRecorder {
+public:
+    explicit JitterRecorder(std::size_t max_ticks = JITTER_RECORD_MAX_TICKS);
+
+    void note(uint32_t frames) noexcept;
+    /// The ticks so far; read once the callbacks have stopped.
+    JitterProfile profile(const std::string& name) const;
+
+private:
+    std::vector<JitterTick> ticks_;
+    std::atomic<std::size_t> count_{0};
+    int64_t last_ns_ = 0;  // touched by the noting thread only
+};
+
+/// Whether RECMEET_RECORD_JITTER asks captures for a JitterRecorder.
+bool jitter_recording_requested();
+
+/// Flat map of one capture's stats, keys prefixed `<label>.`.
+void add_replay_stats(JsonMap& m, const std::string& label, const ReplayStats& stats);
+
+/// `<dir>/audio_<ts>.<ext>` -> `<dir>/replay_<ts>.json`.
+fs::path replay_report_path(const fs::path& audio_path);
+
+} // namespace recmeet
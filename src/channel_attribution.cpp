@@ -0,0 +1,168 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "channel_attribution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace recmeet {
+
+namespace {
+
+// envelope_*.bin: magic, then little-endian u32 frame size in samples and
+// u32 frame count, then the mic levels and the monitor levels.
+constexpr char kEnvelopeMagic[8] = {'R', 'M', 'E', 'N', 'V', '1', '\0', '\0'};
+constexpr std::size_t kEnvelopeHeaderBytes = sizeof(kEnvelopeMagic) + 8;
+
+void put_u32(std::string& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out += static_cast<char>((v >> (8 * i)) & 0xff);
+}
+
+uint32_t get_u32(const std::string& in, std::size_t at) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= uint32_t(static_cast<uint8_t>(in[at + i])) << (8 * i);
+    return v;
+}
+
+} // anonymous namespace
+
+uint8_t envelope_level(double mean_square) {
+    if (mean_square <= 0) return 0;
+    const double db = 10.0 * std::log10(mean_square / (32768.0 * 32768.0));
+    return static_cast<uint8_t>(std::lround(
+        std::clamp(db + ENVELOPE_FLOOR_DB, 0.0, static_cast<double>(ENVELOPE_FLOOR_DB))));
+}
+
+void ChannelEnvelopeBuilder::add(const int16_t* mic, const int16_t* monitor, std::size_t n) {
+    while (n > 0) {
+        const std::size_t k = std::min(n, ENVELOPE_FRAME_SAMPLES - fill_);
+        for (std::size_t i = 0; mic && i < k; ++i) mic_energy_ += double(mic[i]) * mic[i];
+        for (std::size_t i = 0; monitor && i < k; ++i)
+            monitor_energy_ += double(monitor[i]) * monitor[i];
+        fill_ += k;
+        n -= k;
+        if (mic) mic += k;
+        if (monitor) monitor += k;
+        if (fill_ == ENVELOPE_FRAME_SAMPLES) {
+            env_.mic.push_back(envelope_level(mic_energy_ / ENVELOPE_FRAME_SAMPLES));
+            env_.monitor.push_back(envelope_level(monitor_energy_ / ENVELOPE_FRAME_SAMPLES));
+            mic_energy_ = monitor_energy_ = 0;
+            fill_ = 0;
+        }
+    }
+}
+
+ChannelEnvelope ChannelEnvelopeBuilder::finish() const {
+    ChannelEnvelope env = env_;
+    if (fill_ > 0) {
+        env.mic.push_back(envelope_level(mic_energy_ / fill_));
+        env.monitor.push_back(envelope_level(monitor_energy_ / fill_));
+    }
+    return env;
+}
+
+fs::path channel_envelope_path(const fs::path& audio_path) {
+    std::string stem = audio_path.stem().string();
+    const std::string prefix = AUDIO_PREFIX;
+    if (stem.compare(0, prefix.size(), prefix) == 0)
+        stem.erase(0, prefix.size());
+    return audio_path.parent_path() / (std::string(ENVELOPE_PREFIX) + stem + ".bin");
+}
+
+void save_channel_envelope(const fs::path& path, const ChannelEnvelope& env) {
+    if (env.monitor.size() != env.mic.size())
+        throw RecmeetError("Channel envelope sources differ in length");
+    std::string out(kEnvelopeMagic, sizeof(kEnvelopeMagic));
+    out.reserve(kEnvelopeHeaderBytes + 2 * env.frames());
+    put_u32(out, static_cast<uint32_t>(ENVELOPE_FRAME_SAMPLES));
+    put_u32(out, static_cast<uint32_t>(env.frames()));
+    out.append(env.mic.begin(), env.mic.end());
+    out.append(env.monitor.begin(), env.monitor.end());
+    write_text_file_atomic(path, out);
+}
+
+bool load_channel_envelope(const fs::path& path, ChannelEnvelope& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < kEnvelopeHeaderBytes ||
+        std::memcmp(data.data(), kEnvelopeMagic, sizeof(kEnvelopeMagic)) != 0 ||
+        get_u32(data, sizeof(kEnvelopeMagic)) != ENVELOPE_FRAME_SAMPLES)
+        return false;
+    const std::size_t frames = get_u32(data, sizeof(kEnvelopeMagic) + 4);
+    if (data.size() != kEnvelopeHeaderBytes + 2 * frames) return false;
+    const auto* levels = reinterpret_cast<const uint8_t*>(data.data()) + kEnvelopeHeaderBytes;
+    out.mic.assign(levels, levels + frames);
+    out.monitor.assign(levels + frames, levels + 2 * frames);
+    return true;
+}
+
+std::vector<std::pair<double, double>> local_speech_spans(const ChannelEnvelope& env,
+                                                          const LocalSpeechParams& params) {
+    std::vector<std::pair<double, double>> spans;
+    const std::size_t frames = std::min(env.mic.size(), env.monitor.size());
+    if (frames == 0) return spans;
+
+    // The mic's noise floor: room tone and the remote side leaking out of
+    // the speakers sit below it most of the meeting.
+    std::vector<uint8_t> sorted(env.mic.begin(), env.mic.begin() + frames);
+    auto tenth = sorted.begin() + frames / 10;
+    std::nth_element(sorted.begin(), tenth, sorted.end());
+    const int active = *tenth + params.active_db;
+
+    const double frame_sec = static_cast<double>(ENVELOPE_FRAME_SAMPLES) / SAMPLE_RATE;
+    const auto bridge = static_cast<std::size_t>(std::lround(params.bridge_sec / frame_sec));
+    const auto min_frames = static_cast<std::size_t>(std::lround(params.min_sec / frame_sec));
+    auto local = [&](std::size_t f) {
+        return env.mic[f] >= active && env.mic[f] >= env.monitor[f] + params.dominance_db;
+    };
+
+    std::size_t f = 0;
+    while (f < frames) {
+        if (!local(f)) { ++f; continue; }
+        const std::size_t begin = f;
+        std::size_t end = f + 1;  // one past the last local frame
+        for (std::size_t g = end; g < frames && g - end <= bridge; ++g)
+            if (local(g)) end = g + 1;
+        if (end - begin >= min_frames)
+            spans.emplace_back(begin * frame_sec, end * frame_sec);
+        f = end;
+    }
+    return spans;
+}
+
+std::vector<VadSegment> subtract_spans(const std::vector<VadSegment>& segments,
+                                       const std::vector<std::pair<double, double>>& spans,
+                                       std::size_t min_samples) {
+    std::vector<VadSegment> out;
+    out.reserve(segments.size() + spans.size());
+    auto emit = [&](int64_t start, int64_t end) {
+        if (end - start < static_cast<int64_t>(min_samples)) return;
+        out.push_back({static_cast<int32_t>(start), static_cast<int32_t>(end),
+                       static_cast<double>(start) / SAMPLE_RATE,
+                       static_cast<double>(end) / SAMPLE_RATE});
+    };
+    std::size_t s = 0;
+    for (const auto& seg : segments) {
+        int64_t pos = seg.start_sample;
+        const int64_t stop = seg.end_sample;
+        // Spans that ended before this segment are done with.
+        while (s < spans.size() && spans[s].second * SAMPLE_RATE <= pos) ++s;
+        for (std::size_t i = s; i < spans.size() && pos < stop; ++i) {
+            const auto cut_start = static_cast<int64_t>(std::llround(spans[i].first * SAMPLE_RATE));
+            const auto cut_end = static_cast<int64_t>(std::llround(spans[i].second * SAMPLE_RATE));
+            if (cut_start >= stop) break;
+            emit(pos, std::min(cut_start, stop));
+            pos = std::max(pos, cut_end);
+        }
+        if (pos < stop) emit(pos, stop);
+    }
+    return out;
+}
+
+} // namespace recmeet
@@ -0,0 +1,101 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+#include "vad.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Channel attribution (diarization.local_speaker)
+// ---------------------------------------------------------------------------
+//
+// In dual mode the mic is the local participant and the monitor is
+// everyone else, but the meeting audio is their mix. The mixer keeps a
+// level envelope of each input — one byte per 100 ms frame and source —
+// saved beside the audio as envelope_YYYY-MM-DD_HH-MM.bin. Postprocessing
+// reads the stretches where the mic clearly dominates as the local user's
+// and leaves only the rest to diarization, so the local speaker costs no
+// segmentation or embedding work and cannot be split or merged by the
+// clustering.
+
+/// Samples per envelope frame: 100 ms.
+constexpr std::size_t ENVELOPE_FRAME_SAMPLES = static_cast<std::size_t>(SAMPLE_RATE) / 10;
+
+/// Frame levels are dBFS + ENVELOPE_FLOOR_DB, in 1 dB steps: 0 is
+/// -ENVELOPE_FLOOR_DB dBFS or quieter (digital silence included), 100 is
+/// full scale.
+constexpr int ENVELOPE_FLOOR_DB = 100;
+
+/// Per-frame levels of the two inputs of a dual-source recording, aligned
+/// with the mixed audio.
+struct ChannelEnvelope {
+    std::vector<uint8_t> mic;
+    std::vector<uint8_t> monitor;
+
+    std::size_t frames() const { return mic.size(); }
+};
+
+/// Builds a ChannelEnvelope from sample-aligned mic / monitor blocks, as
+/// the mixer produces them. Not thread-safe; the mixer calls it under its
+/// lock.
+class ChannelEnvelopeBuilder {
+public:
+    /// `n` aligned samples of each input; a null input is silent for them.
+    void add(const int16_t* mic, const int16_t* monitor, std::size_t n);
+
+    /// The envelope so far, the partial last frame included.
+    ChannelEnvelope finish() const;
+
+private:
+    ChannelEnvelope env_;
+    double mic_energy_ = 0, monitor_energy_ = 0;  // sums of squares, current frame
+    std::size_t fill_ = 0;                        // samples in the current frame
+};
+
+/// Level of a frame with mean square `mean_square` (of int16 samples), as
+/// stored in a ChannelEnvelope.
+uint8_t envelope_level(double mean_square);
+
+/// Path of the envelope for `audio_path`: the `audio_` prefix (if any) of
+/// the file stem is replaced by `envelope_`, in the same directory.
+fs::path channel_envelope_path(const fs::path& audio_path);
+
+/// Write `env` to `path`. Throws RecmeetError if it cannot be written.
+void save_channel_envelope(const fs::path& path, const ChannelEnvelope& env);
+
+/// Load the envelope at `path` into `out`. False, leaving `out` untouched,
+/// when it is missing or malformed.
+bool load_channel_envelope(const fs::path& path, ChannelEnvelope& out);
+
+struct LocalSpeechParams {
+    /// Mic level over the monitor's for a frame to be the local user's.
+    int dominance_db = 10;
+    /// Mic level over its own noise floor (10th percentile) for a frame to
+    /// be speech at all.
+    int active_db = 12;
+    /// Gaps up to this long inside a local stretch are bridged.
+    double bridge_sec = 0.3;
+    /// Stretches shorter than this are left to diarization.
+    double min_sec = 1.0;
+};
+
+/// The [start, end) seconds where the local user speaks and the remote
+/// side does not, in order.
+std::vector<std::pair<double, double>> local_speech_spans(const ChannelEnvelope& env,
+                                                          const LocalSpeechParams& params = {});
+
+/// `segments` with `spans` (ordered seconds) cut out; pieces shorter than
+/// `min_samples` are dropped.
+std::vector<VadSegment> subtract_spans(const std::vector<VadSegment>& segments,
+                                       const std::vector<std::pair<double, double>>& spans,
+                                       std::size_t min_samples = static_cast<std::size_t>(SAMPLE_RATE) / 4);
+
+} // namespace recmeet
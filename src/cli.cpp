@@ -2,10 +2,16 @@
 // SPDX-License-Identifier: MIT OR Apache-2.0
 
 #include "cli.h"
+#include "audio_file.h"
+#include "diarize_sweep.h"
+#include "embedding_set.h"
+#include "onnx_provider.h"
+#include "power_policy.h"
 
 #include <cstdio>
 #include <cstdlib>
 #include <getopt.h>
+#include <sstream>
 
 namespace recmeet {
 
@@ -27,7 +33,16 @@ CliResult parse_cli(int argc, char* argv[]) {
         {"monitor",        required_argument, nullptr, 'm'},
         {"mic-only",       no_argument,       nullptr, 'M'},
         {"keep-sources",   no_argument,       nullptr, 'K'},
+        {"audio-archive",  required_argument, nullptr, 1042},
         {"model",          required_argument, nullptr, 'W'},
+        {"whisper-workers", required_argument, nullptr, 1043},
+        {"live-transcribe", no_argument,      nullptr, 1047},
+        {"draft-model",    required_argument, nullptr, 1052},
+        {"draft-logprob",  required_argument, nullptr, 1053},
+        {"language-pin-sec", required_argument, nullptr, 1054},
+        {"no-gpu",         no_argument,       nullptr, 1055},
+        {"autotune",       no_argument,       nullptr, 1056},
+        {"autotune-rtf",   required_argument, nullptr, 1057},
         {"output-dir",     required_argument, nullptr, 'o'},
         {"api-key",        required_argument, nullptr, 'k'},
         {"api-url",        required_argument, nullptr, 'u'},
@@ -44,7 +59,22 @@ CliResult parse_cli(int argc, char* argv[]) {
         {"cluster-threshold", required_argument, nullptr, 'C'},
         {"no-vad",         no_argument,       nullptr, 'V'},
         {"vad-threshold",  required_argument, nullptr, 'B'},
+        {"no-vad-pack",    no_argument,       nullptr, 1044},
+        {"no-diarize-overlap", no_argument,   nullptr, 1045},
+        {"overlap-memory-mb", required_argument, nullptr, 1046},
+        {"diarize-parallel", required_argument, nullptr, 1058},
+        {"live-diarize",    no_argument,       nullptr, 1059},
+        {"diarize-share-overlap", no_argument, nullptr, 1097},
+        {"recluster",       required_argument, nullptr, 1060},
+        {"diarize-sweep",   required_argument, nullptr, 1061},
+        {"sweep-cluster",   required_argument, nullptr, 1062},
+        {"sweep-stitch",    required_argument, nullptr, 1063},
+        {"sweep-collapse",  required_argument, nullptr, 1064},
+        {"diarize-speech-only", no_argument,   nullptr, 1065},
         {"threads",        required_argument, nullptr, 'T'},
+        {"pp-worker-jobs", required_argument, nullptr, 1049},
+        {"pp-worker-rss-mb", required_argument, nullptr, 1050},
+        {"no-stage-cache", no_argument,       nullptr, 1051},
         {"log-level",      required_argument, nullptr, 'E'},
         {"note-dir",       required_argument, nullptr, 'n'},
         {"log-dir",        required_argument, nullptr, 'F'},
@@ -61,12 +91,29 @@ CliResult parse_cli(int argc, char* argv[]) {
         {"speakers",       no_argument,       nullptr, 1010},
         {"remove-speaker", required_argument, nullptr, 1011},
         {"identify",       required_argument, nullptr, 1012},
+        {"rerender",       required_argument, nullptr, 1085},
+        {"trace-out",      required_argument, nullptr, 1086},
+        {"local-speaker",  required_argument, nullptr, 1087},
+        {"archive-speech-only", no_argument, nullptr, 1088},
+        {"pp-on-battery",  required_argument, nullptr, 1089},
+        {"diarize-provider", required_argument, nullptr, 1090},
         {"no-speaker-id",  no_argument,       nullptr, 1013},
         {"speaker-threshold", required_argument, nullptr, 1014},
         {"speaker-db",     required_argument, nullptr, 1015},
+        {"speaker-ann",    no_argument,       nullptr, 1067},
+        {"speaker-participants", no_argument, nullptr, 1099},
+        {"embedding-precision", required_argument, nullptr, 1098},
         {"reset-speakers", no_argument,       nullptr, 1016},
+        {"export-speakers", required_argument, nullptr, 1066},
         {"mmap",           no_argument,       nullptr, 1017},
         {"no-mmap",        no_argument,       nullptr, 1018},
+        {"summary-chunk-tokens", required_argument, nullptr, 1068},
+        {"llm-draft-model", required_argument, nullptr, 1069},
+        {"llm-kv-type", required_argument, nullptr, 1070},
+        {"llm-batch", required_argument, nullptr, 1071},
+        {"llm-ubatch", required_argument, nullptr, 1072},
+        {"llm-gpu-layers", required_argument, nullptr, 1073},
+        {"rolling-summary-minutes", required_argument, nullptr, 1074},
         {"vocab",          required_argument, nullptr, 1019},
         {"list-vocab",     no_argument,       nullptr, 1020},
         {"add-vocab",      required_argument, nullptr, 1021},
@@ -77,6 +124,7 @@ CliResult parse_cli(int argc, char* argv[]) {
         {"daemon-addr",    required_argument, nullptr, 1028},
         {"progress-json",  no_argument,       nullptr, 1025},
         {"config-json",    required_argument, nullptr, 1026},
+        {"pp-worker",      no_argument,       nullptr, 1048},
         {"diarize-chunk-minutes",     required_argument, nullptr, 1029},
         {"diarize-chunk-overlap-sec", required_argument, nullptr, 1030},
         {"diarize-stitch-threshold",  required_argument, nullptr, 1031},
@@ -90,6 +138,22 @@ CliResult parse_cli(int argc, char* argv[]) {
         {"list-caption-models", no_argument,      nullptr, 1035},
         {"no-captions",        no_argument,       nullptr, 1036},
         {"show-captions",      no_argument,       nullptr, 1037},
+        {"caption-partial-hz", required_argument, nullptr, 1075},
+        {"caption-transcript", no_argument,       nullptr, 1076},
+        {"caption-threads",    required_argument, nullptr, 1082},
+        {"no-caption-warm",    no_argument,       nullptr, 1083},
+        {"no-pin-threads",     no_argument,       nullptr, 1077},
+        {"no-backend-bench",   no_argument,       nullptr, 1084},
+        {"hugepages",          no_argument,       nullptr, 1091},
+        {"caption-mlock",      no_argument,       nullptr, 1092},
+        {"no-caption-int8-fallback", no_argument, nullptr, 1096},
+        {"gpu-devices",        required_argument, nullptr, 1093},
+        {"no-summary-compact", no_argument,       nullptr, 1094},
+        {"perf-counters",      no_argument,       nullptr, 1095},
+        {"batch-daemons",      required_argument, nullptr, 1078},
+        {"jobs",               required_argument, nullptr, 1079},
+        {"refresh",            no_argument,       nullptr, 1080},
+        {"pipeline",           no_argument,       nullptr, 1081},
         {"help",           no_argument,       nullptr, 'h'},
         {"version",        no_argument,       nullptr, 'v'},
         {nullptr, 0, nullptr, 0},
@@ -139,12 +203,25 @@ CliResult parse_cli(int argc, char* argv[]) {
             case 1010: result.list_speakers = true; break;
             case 1011: result.remove_speaker = optarg; break;
             case 1012: result.identify_dir = optarg; break;
+            case 1085: result.rerender_dir = optarg; break;
+            case 1086: result.trace_out = optarg; break;
             case 1013: result.cfg.speaker_id = false; break;
             case 1014: result.cfg.speaker_threshold = std::atof(optarg); break;
             case 1015: result.cfg.speaker_db = optarg; break;
+            case 1067: result.cfg.speaker_ann = true; break;
+            case 1099: result.cfg.speaker_participants_first = true; break;
+            case 1098: result.cfg.speaker_embedding_precision = optarg; break;
             case 1016: result.reset_speakers = true; break;
+            case 1066: result.export_speakers = optarg; break;
             case 1017: result.cfg.llm_mmap = true; break;
             case 1018: result.cfg.llm_mmap = false; break;
+            case 1068: result.cfg.summary_chunk_tokens = std::atoi(optarg); break;
+            case 1069: result.cfg.llm_draft_model = optarg; break;
+            case 1070: result.cfg.llm_kv_type = optarg; break;
+            case 1071: result.cfg.llm_batch = std::atoi(optarg); break;
+            case 1072: result.cfg.llm_ubatch = std::atoi(optarg); break;
+            case 1073: result.cfg.llm_gpu_layers = std::atoi(optarg); break;
+            case 1074: result.cfg.rolling_summary_minutes = std::atoi(optarg); break;
             case 1019: result.cfg.vocabulary = optarg; break;
             case 1020: result.list_vocab = true; break;
             case 1021: result.add_vocab = optarg; break;
@@ -156,8 +233,10 @@ CliResult parse_cli(int argc, char* argv[]) {
             case 1027: result.cfg.log_retention_hours = std::atoi(optarg); break;
             case 1028: result.daemon_addr = optarg;
                        result.daemon_mode = DaemonMode::Force; break;
-            case 1029: result.cfg.chunk_minutes = static_cast<float>(std::atof(optarg)); break;
-            case 1030: result.cfg.chunk_overlap_sec = static_cast<float>(std::atof(optarg)); break;
+            case 1029: result.cfg.chunk_minutes = static_cast<float>(std::atof(optarg));
+                       result.cfg.diarize_auto_chunk = false; break;
+            case 1030: result.cfg.chunk_overlap_sec = static_cast<float>(std::atof(optarg));
+                       result.cfg.diarize_auto_chunk = false; break;
             case 1031: result.cfg.stitch_threshold = static_cast<float>(std::atof(optarg)); break;
             case 1032: result.cfg.reprocess_batch_dir = optarg; break;
             case 1033: result.cfg.reprocess_batch_dry_run = true; break;
@@ -166,10 +245,73 @@ CliResult parse_cli(int argc, char* argv[]) {
             case 1036: result.caption_force_off = true; break;
             case 1037: result.caption_force_on = true;
                        result.caption_show_on_stderr = true; break;
+            case 1075: result.cfg.caption_partial_hz = std::atoi(optarg); break;
+            case 1076: result.cfg.caption_transcript = true; break;
+            case 1082: result.cfg.caption_threads = std::atoi(optarg); break;
+            case 1083: result.cfg.caption_keep_warm = false; break;
+            case 1077: result.cfg.pin_threads = false; break;
+            case 1084: result.cfg.backend_bench = false; break;
+            case 1078: {
+                std::stringstream list(optarg);
+                std::string addr;
+                while (std::getline(list, addr, ','))
+                    if (!addr.empty()) result.batch_daemons.push_back(addr);
+                break;
+            }
+            case 1079: result.batch_jobs = std::atoi(optarg); break;
+            case 1080: result.cfg.reprocess_batch_refresh = true; break;
+            case 1081: result.batch_pipeline = true; break;
             case 1038: result.cfg.debug_dump_centroids_path = optarg; break;
             case 1039: result.cfg.max_auto_speakers = std::atoi(optarg); break;
             case 1040: result.cfg.collapse_threshold = static_cast<float>(std::atof(optarg)); break;
             case 1041: result.cfg.min_cluster_duration_sec = static_cast<float>(std::atof(optarg)); break;
+            case 1042: result.cfg.audio_archive = optarg; break;
+            case 1043: result.cfg.whisper_workers = std::atoi(optarg); break;
+            case 1044: result.cfg.vad_pack = false; break;
+            case 1045: result.cfg.diarize_overlap = false; break;
+            case 1046: result.cfg.overlap_memory_mb = std::atoi(optarg); break;
+            case 1047: result.cfg.live_transcribe = true; break;
+            case 1048: result.pp_worker = true; break;
+            case 1049: result.cfg.pp_worker_jobs = std::atoi(optarg); break;
+            case 1050: result.cfg.pp_worker_rss_mb = std::atoi(optarg); break;
+            case 1051: result.cfg.stage_cache = false; break;
+            case 1052: result.cfg.whisper_draft_model = optarg; break;
+            case 1053: result.cfg.draft_logprob = std::atof(optarg); break;
+            case 1054: result.cfg.language_pin_sec = std::atoi(optarg); break;
+            case 1055: result.cfg.whisper_gpu = false; break;
+            case 1056: result.autotune = true; break;
+            case 1057: result.autotune_rtf = std::atof(optarg); break;
+            case 1058: result.cfg.diarize_parallel_chunks = std::atoi(optarg); break;
+            case 1059: result.cfg.live_diarize = true; break;
+            case 1097: result.cfg.diarize_share_overlap = true; break;
+            case 1060:
+                result.cfg.reprocess_dir = optarg;
+                result.cfg.recluster = true;
+                break;
+            case 1061: result.sweep_dirs.push_back(optarg); break;
+            case 1065: result.cfg.diarize_speech_only = true; break;
+            case 1087: result.cfg.local_speaker = optarg; break;
+            case 1088: result.cfg.archive_speech_only = true; break;
+            case 1089: result.cfg.pp_on_battery = optarg; break;
+            case 1090: result.cfg.diarize_provider = optarg; break;
+            case 1091: result.cfg.model_hugepages = true; break;
+            case 1092: result.cfg.caption_mlock = true; break;
+            case 1096: result.cfg.caption_int8_fallback = false; break;
+            case 1093: result.cfg.whisper_gpu_devices = std::atoi(optarg); break;
+            case 1094: result.cfg.summary_compact = false; break;
+            case 1095: result.cfg.perf_counters = true; break;
+            case 1062:
+            case 1063:
+            case 1064:
+                try {
+                    auto& list = opt == 1062 ? result.sweep_cluster
+                               : opt == 1063 ? result.sweep_stitch
+                                             : result.sweep_collapse;
+                    list = parse_sweep_values(optarg);
+                } catch (const RecmeetError& e) {
+                    if (result.parse_error.empty()) result.parse_error = e.what();
+                }
+                break;
             case 'v': result.show_version = true; return result;
             case 'h': result.show_help = true; return result;
             default:  result.show_help = true; return result;
@@ -195,6 +337,37 @@ CliResult parse_cli(int argc, char* argv[]) {
         }
     }
 
+    {
+        AudioArchiveFormat fmt;
+        if (!parse_audio_archive_format(result.cfg.audio_archive, fmt)
+            && result.parse_error.empty()) {
+            result.parse_error = "--audio-archive must be wav, flac or opus (got '" +
+                                 result.cfg.audio_archive + "')";
+        }
+    }
+
+    {
+        EmbeddingPrecision precision;
+        if (!parse_embedding_precision(result.cfg.speaker_embedding_precision, precision)
+            && result.parse_error.empty()) {
+            result.parse_error = "--embedding-precision must be f32, f16 or int8 (got '" +
+                                 result.cfg.speaker_embedding_precision + "')";
+        }
+    }
+
+    {
+        BatteryPolicy policy;
+        if (!parse_battery_policy(result.cfg.pp_on_battery, policy)
+            && result.parse_error.empty()) {
+            result.parse_error = "--pp-on-battery must be run, reduce or defer (got '" +
+                                 result.cfg.pp_on_battery + "')";
+        }
+    }
+    if (!valid_onnx_provider(result.cfg.diarize_provider) && result.parse_error.empty()) {
+        result.parse_error = "--diarize-provider must be auto, cpu, cuda or xnnpack (got '" +
+                             result.cfg.diarize_provider + "')";
+    }
+
     // Mutual exclusion: --reprocess (single dir) and --reprocess-batch (parent
     // dir) target different code paths and cannot be combined. Reject early
     // with a clear message so the operator picks one. Mirrors the surfacing
@@ -209,6 +382,52 @@ CliResult parse_cli(int argc, char* argv[]) {
             "pass exactly one";
     }
 
+    // --recluster reads nothing but the stage cache.
+    if (result.cfg.recluster && !result.cfg.stage_cache
+        && result.parse_error.empty()) {
+        result.parse_error =
+            "--recluster needs the stage cache (no --no-stage-cache or stage_cache: false)";
+    }
+    if (result.cfg.recluster && !result.cfg.diarize
+        && result.parse_error.empty()) {
+        result.parse_error = "--recluster and --no-diarize cannot be combined";
+    }
+
+    if (!result.batch_daemons.empty() && result.cfg.reprocess_batch_dir.empty()
+        && result.parse_error.empty()) {
+        result.parse_error = "--batch-daemons needs --reprocess-batch DIR";
+    }
+    if (result.cfg.reprocess_batch_refresh && result.cfg.reprocess_batch_dir.empty()
+        && result.parse_error.empty()) {
+        result.parse_error = "--refresh needs --reprocess-batch DIR";
+    }
+    if (result.batch_jobs != 1 && result.parse_error.empty()) {
+        if (result.batch_jobs < 1)
+            result.parse_error = "--jobs must be at least 1";
+        else if (result.cfg.reprocess_batch_dir.empty())
+            result.parse_error = "--jobs needs --reprocess-batch DIR";
+        else if (!result.batch_daemons.empty())
+            result.parse_error = "--jobs and --batch-daemons cannot be combined "
+                                 "(list a daemon twice to run two meetings on it)";
+    }
+    if (result.batch_pipeline && result.parse_error.empty()) {
+        if (result.cfg.reprocess_batch_dir.empty())
+            result.parse_error = "--pipeline needs --reprocess-batch DIR";
+        else if (result.batch_jobs > 1 || !result.batch_daemons.empty())
+            result.parse_error = "--pipeline cannot be combined with --jobs or --batch-daemons";
+        else if (!result.cfg.stage_cache)
+            result.parse_error =
+                "--pipeline needs the stage cache (no --no-stage-cache or stage_cache: false)";
+    }
+
+    if (result.sweep_dirs.empty()
+        && !(result.sweep_cluster.empty() && result.sweep_stitch.empty()
+             && result.sweep_collapse.empty())
+        && result.parse_error.empty()) {
+        result.parse_error = "--sweep-cluster/--sweep-stitch/--sweep-collapse "
+                             "need --diarize-sweep DIR";
+    }
+
     // ----------------------------------------------------------------
     // Phase 4 — caption flag precedence + language guard.
     //
@@ -5,6 +5,9 @@
 
 #include "config.h"
 
+#include <string>
+#include <vector>
+
 namespace recmeet {
 
 enum class DaemonMode { Auto, Force, Disable };
@@ -18,8 +21,13 @@ struct CliResult {
     bool send_stop = false;
     bool download_models = false;
     bool update_models = false;
+    bool autotune = false;              // --autotune
+    double autotune_rtf = 0.25;         // --autotune-rtf F (AUTOTUNE_TARGET_RTF)
     DaemonMode daemon_mode = DaemonMode::Auto;
     std::string daemon_addr;  // --daemon-addr ADDRESS (host:port or socket path)
+    std::vector<std::string> batch_daemons;  // --batch-daemons LIST (comma-separated, repeatable)
+    int batch_jobs = 1;  // --jobs N (standalone --reprocess-batch meetings at once)
+    bool batch_pipeline = false;  // --pipeline (standalone batch stages overlap across meetings)
 
     // Speaker enrollment
     std::string enroll_name;     // --enroll "Name"
@@ -29,6 +37,16 @@ struct CliResult {
     std::string remove_speaker;  // --remove-speaker "Name"
     std::string identify_dir;    // --identify <meeting_dir>
     bool reset_speakers = false;  // --reset-speakers
+    std::string export_speakers;  // --export-speakers DIR
+    std::string rerender_dir;     // --rerender <meeting_dir>
+    std::string trace_out;        // --trace-out FILE (trace.h)
+
+    // Diarization tuning (--diarize-sweep DIR, repeatable). Empty grid
+    // lists stand for the config's own threshold.
+    std::vector<std::string> sweep_dirs;
+    std::vector<float> sweep_cluster;    // --sweep-cluster LIST
+    std::vector<float> sweep_stitch;     // --sweep-stitch LIST
+    std::vector<float> sweep_collapse;   // --sweep-collapse LIST
 
     // Vocabulary management
     bool list_vocab = false;         // --list-vocab
@@ -39,6 +57,7 @@ struct CliResult {
     // Subprocess mode (daemon-internal, undocumented)
     bool progress_json = false;          // --progress-json
     std::string config_json_path;        // --config-json <path>
+    bool pp_worker = false;              // --pp-worker (warm worker, jobs on stdin)
 
     // Live caption flags (Phase 4). The boolean tri-state is encoded as two
     // explicit bool fields to make precedence visible at the call site:
@@ -0,0 +1,108 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "clip_transcribe.h"
+#include "log.h"
+#include "model_manager.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace recmeet {
+
+namespace {
+
+std::mutex g_tap_mutex;
+const SampleSource* g_tap = nullptr;  // owned by the live ClipSourceTap
+
+} // anonymous namespace
+
+ClipSourceTap::ClipSourceTap(std::unique_ptr<SampleSource> source)
+    : source_(std::move(source)) {
+    std::lock_guard<std::mutex> lock(g_tap_mutex);
+    g_tap = source_.get();
+}
+
+ClipSourceTap::~ClipSourceTap() {
+    std::lock_guard<std::mutex> lock(g_tap_mutex);
+    if (g_tap == source_.get()) g_tap = nullptr;
+}
+
+bool read_recording_tail(double seconds, std::vector<float>& out, double& start_sec) {
+    std::lock_guard<std::mutex> lock(g_tap_mutex);
+    if (!g_tap) return false;
+    const std::size_t total = g_tap->size();
+    const std::size_t want = seconds > 0
+        ? static_cast<std::size_t>(std::llround(seconds * SAMPLE_RATE)) : 0;
+    const std::size_t n = std::min(want, total);
+    const std::size_t start = total - n;
+    out = g_tap->window(start, n);
+    start_sec = static_cast<double>(start) / SAMPLE_RATE;
+    return true;
+}
+
+std::string clip_text(const TranscriptResult& result) {
+    std::string text;
+    for (const auto& seg : result.segments) {
+        const auto first = seg.text.find_first_not_of(" \t\n");
+        if (first == std::string::npos) continue;
+        const auto last = seg.text.find_last_not_of(" \t\n");
+        if (!text.empty()) text += ' ';
+        text.append(seg.text, first, last - first + 1);
+    }
+    return text;
+}
+
+void ClipTranscriber::warm(const std::string& model_name, bool use_gpu) {
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (model_ && name_ == model_name) return;
+        generation = generation_;
+    }
+    if (!is_whisper_model_cached(model_name)) {
+        log_info("clip: model %s not downloaded; clips will load it on demand",
+                 model_name.c_str());
+        return;
+    }
+    std::shared_ptr<WhisperModel> model;
+    try {
+        model = std::make_shared<WhisperModel>(ensure_whisper_model(model_name), use_gpu);
+    } catch (const std::exception& e) {
+        log_warn("clip: cannot load %s: %s", model_name.c_str(), e.what());
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    if (generation != generation_) return;  // the recording ended meanwhile
+    model_ = std::move(model);
+    name_ = model_name;
+    log_info("clip: %s ready", model_name.c_str());
+}
+
+void ClipTranscriber::release() {
+    std::lock_guard<std::mutex> lock(mu_);
+    ++generation_;
+    model_.reset();
+    name_.clear();
+}
+
+bool ClipTranscriber::is_warm() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return model_ != nullptr;
+}
+
+TranscriptResult ClipTranscriber::transcribe(const std::string& model_name, bool use_gpu,
+                                             const float* samples, std::size_t n,
+                                             double offset_sec, const std::string& language,
+                                             int threads) {
+    std::shared_ptr<WhisperModel> model;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (model_ && name_ == model_name) model = model_;
+    }
+    if (!model)
+        model = std::make_shared<WhisperModel>(ensure_whisper_model(model_name), use_gpu);
+    return recmeet::transcribe(*model, samples, n, offset_sec, language, threads);
+}
+
+} // namespace recmeet
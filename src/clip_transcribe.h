@@ -0,0 +1,85 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "sample_source.h"
+#include "transcribe.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Clip transcription (`transcribe.clip`)
+// ---------------------------------------------------------------------------
+//
+// "What did they just say?" without a postprocessing job: the daemon
+// transcribes the last few seconds of the recording in progress, or a
+// range of a meeting's audio file, on a small whisper model
+// (`transcription.clip_model`) that it loads when a recording starts and
+// drops when it ends. A 30 s clip on `base` decodes in about a second.
+//
+// The recording publishes its growing spool through a ClipSourceTap for as
+// long as its loop runs; read_recording_tail() copies from it.
+
+/// Default and largest clip, in seconds. One whisper window is 30 s.
+constexpr double CLIP_DEFAULT_SECONDS = 30.0;
+constexpr double CLIP_MAX_SECONDS = 120.0;
+
+/// Publishes a recording's audio for read_recording_tail() while it lives.
+/// One at a time; a second tap replaces the first.
+class ClipSourceTap {
+public:
+    explicit ClipSourceTap(std::unique_ptr<SampleSource> source);
+    ~ClipSourceTap();
+
+    ClipSourceTap(const ClipSourceTap&) = delete;
+    ClipSourceTap& operator=(const ClipSourceTap&) = delete;
+
+private:
+    std::unique_ptr<SampleSource> source_;
+};
+
+/// Copy the last `seconds` (at most what was recorded) of the published
+/// recording into `out`; `start_sec` receives where the copy begins in the
+/// recording. False when no recording is published.
+bool read_recording_tail(double seconds, std::vector<float>& out, double& start_sec);
+
+/// The segments' text, trimmed and joined by single spaces.
+std::string clip_text(const TranscriptResult& result);
+
+/// The small whisper model clip requests decode on.
+class ClipTranscriber {
+public:
+    /// Load `model_name` and keep it until release(). Blocks for the
+    /// load; run it off the IPC thread. Does nothing when the model is not
+    /// downloaded (a recording never waits for a download) or already
+    /// loaded. Logs and returns on a load failure.
+    void warm(const std::string& model_name, bool use_gpu);
+
+    /// Forget the warm model. A clip decoding on it keeps it until done,
+    /// and a warm() still loading discards what it loads.
+    void release();
+
+    bool is_warm() const;
+
+    /// Transcribe `n` samples on the warm model, or on `model_name` loaded
+    /// for this call only when it is not the warm one. Timestamps are
+    /// offset by `offset_sec`. Throws RecmeetError.
+    TranscriptResult transcribe(const std::string& model_name, bool use_gpu,
+                                const float* samples, std::size_t n, double offset_sec,
+                                const std::string& language, int threads);
+
+private:
+    mutable std::mutex mu_;
+    std::shared_ptr<WhisperModel> model_;
+    std::string name_;
+    uint64_t generation_ = 0;  // bumped by release()
+};
+
+} // namespace recmeet
@@ -4,6 +4,7 @@
 #include "config.h"
 #include "log.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <fstream>
 #include <sstream>
@@ -113,9 +114,18 @@ std::string resolve_api_key(const ProviderInfo& provider,
     return legacy_key;
 }
 
+fs::path tune_profile_path() {
+    return data_dir() / "autotune" / (host_name() + ".yaml");
+}
+
 Config load_config(const fs::path& config_path) {
+    if (config_path.empty())
+        return load_config(config_dir() / "config.yaml", tune_profile_path());
+    return load_config(config_path, {});
+}
+
+Config load_config(const fs::path& path, const fs::path& tune_profile) {
     Config cfg;
-    fs::path path = config_path.empty() ? config_dir() / "config.yaml" : config_path;
 
     // Check for API key in environment (try provider-specific, then XAI_API_KEY for compat)
     for (size_t i = 0; i < NUM_PROVIDERS; ++i) {
@@ -125,27 +135,48 @@ Config load_config(const fs::path& config_path) {
         }
     }
 
-    if (!fs::exists(path))
+    // get_val() takes the first match, so the profile's entries, appended
+    // after the file's, only fill keys the file leaves unset.
+    std::vector<YamlEntry> entries;
+    bool any = false;
+    for (const fs::path& p : {path, tune_profile}) {
+        if (p.empty() || !fs::exists(p)) continue;
+        std::ifstream in(p);
+        if (!in) continue;
+        std::ostringstream buf;
+        buf << in.rdbuf();
+        auto layer = parse_yaml(buf.str());
+        entries.insert(entries.end(), layer.begin(), layer.end());
+        any = true;
+    }
+    if (!any)
         return cfg;
 
-    std::ifstream in(path);
-    if (!in) return cfg;
-
-    std::ostringstream buf;
-    buf << in.rdbuf();
-    auto entries = parse_yaml(buf.str());
-
     // Audio section
     cfg.device_pattern = get_val(entries, "audio", "device_pattern", cfg.device_pattern);
     cfg.mic_source = get_val(entries, "audio", "mic_source", "");
     cfg.monitor_source = get_val(entries, "audio", "monitor_source", "");
     cfg.mic_only = get_bool(entries, "audio", "mic_only", false);
     cfg.keep_sources = get_bool(entries, "audio", "keep_sources", false);
+    cfg.spool_capture = get_bool(entries, "audio", "spool_capture", true);
+    cfg.audio_archive = get_val(entries, "audio", "archive", cfg.audio_archive);
+    cfg.archive_speech_only = get_bool(entries, "audio", "archive_speech_only", false);
 
     // Transcription section
     cfg.whisper_model = get_val(entries, "transcription", "model", cfg.whisper_model);
     cfg.language = get_val(entries, "transcription", "language", "");
     cfg.vocabulary = get_val(entries, "transcription", "vocabulary", "");
+    cfg.whisper_workers = std::atoi(get_val(entries, "transcription", "workers", "0").c_str());
+    cfg.live_transcribe = get_bool(entries, "transcription", "live", false);
+    cfg.whisper_draft_model = get_val(entries, "transcription", "draft_model", "");
+    std::string dlp = get_val(entries, "transcription", "draft_logprob", "");
+    if (!dlp.empty()) cfg.draft_logprob = std::atof(dlp.c_str());
+    cfg.clip_model = get_val(entries, "transcription", "clip_model", cfg.clip_model);
+    cfg.language_pin_sec = std::atoi(
+        get_val(entries, "transcription", "language_pin_sec", "30").c_str());
+    cfg.whisper_gpu = get_bool(entries, "transcription", "gpu", true);
+    cfg.whisper_gpu_devices = std::atoi(
+        get_val(entries, "transcription", "gpu_devices", "1").c_str());
 
     // Summary section
     cfg.provider = get_val(entries, "summary", "provider", cfg.provider);
@@ -157,6 +188,19 @@ Config load_config(const fs::path& config_path) {
     cfg.no_summary = get_bool(entries, "summary", "disabled", false);
     cfg.llm_model = get_val(entries, "summary", "llm_model", "");
     cfg.llm_mmap = get_bool(entries, "summary", "llm_mmap", false);
+    cfg.llm_draft_model = get_val(entries, "summary", "llm_draft_model", "");
+    std::string sct = get_val(entries, "summary", "chunk_tokens", "");
+    if (!sct.empty()) cfg.summary_chunk_tokens = std::atoi(sct.c_str());
+    cfg.summary_compact = get_bool(entries, "summary", "compact", true);
+    cfg.llm_kv_type = get_val(entries, "summary", "llm_kv_type", cfg.llm_kv_type);
+    std::string lb = get_val(entries, "summary", "llm_batch", "");
+    if (!lb.empty()) cfg.llm_batch = std::atoi(lb.c_str());
+    std::string lub = get_val(entries, "summary", "llm_ubatch", "");
+    if (!lub.empty()) cfg.llm_ubatch = std::atoi(lub.c_str());
+    std::string lgl = get_val(entries, "summary", "llm_gpu_layers", "");
+    if (!lgl.empty()) cfg.llm_gpu_layers = std::atoi(lgl.c_str());
+    std::string rsm = get_val(entries, "summary", "rolling_minutes", "");
+    if (!rsm.empty()) cfg.rolling_summary_minutes = std::atoi(rsm.c_str());
 
     // Per-provider API keys
     for (size_t i = 0; i < NUM_PROVIDERS; ++i) {
@@ -180,6 +224,16 @@ Config load_config(const fs::path& config_path) {
     // Short-audio min-cluster-duration filter (follow-up to Phase A.3).
     std::string mcd = get_val(entries, "diarization", "min_cluster_duration_sec", "");
     if (!mcd.empty()) cfg.min_cluster_duration_sec = std::atof(mcd.c_str());
+    cfg.diarize_overlap = get_bool(entries, "diarization", "overlap", true);
+    std::string omb = get_val(entries, "diarization", "overlap_memory_mb", "");
+    if (!omb.empty()) cfg.overlap_memory_mb = std::atoi(omb.c_str());
+    cfg.live_diarize = get_bool(entries, "diarization", "live", false);
+    cfg.diarize_share_overlap = get_bool(entries, "diarization", "share_overlap", false);
+    cfg.diarize_speech_only = get_bool(entries, "diarization", "speech_only", false);
+    cfg.local_speaker = get_val(entries, "diarization", "local_speaker", "");
+    cfg.diarize_provider = get_val(entries, "diarization", "provider", cfg.diarize_provider);
+    std::string dpc = get_val(entries, "diarization", "parallel_chunks", "");
+    if (!dpc.empty()) cfg.diarize_parallel_chunks = std::atoi(dpc.c_str());
 
     // Chunked diarization parameters (T2.1/T2.2 — same [diarization] section,
     // single source of truth per M-3'). Validate `chunk_minutes * 60 >
@@ -197,6 +251,7 @@ Config load_config(const fs::path& config_path) {
         if (!st_s.empty()) st_thr = static_cast<float>(std::atof(st_s.c_str()));
 
         bool any_loaded = !cm_s.empty() || !co_s.empty();
+        cfg.diarize_auto_chunk = get_bool(entries, "diarization", "auto_chunk", !any_loaded);
         if (any_loaded && cm * 60.0f <= co + 60.0f) {
             log_warn("config: invalid chunked-diarize values "
                      "(chunk_minutes=%.3f, chunk_overlap_sec=%.3f); "
@@ -220,6 +275,11 @@ Config load_config(const fs::path& config_path) {
     if (!st.empty()) cfg.speaker_threshold = std::atof(st.c_str());
     std::string sdb = get_val(entries, "speaker_id", "database", "");
     if (!sdb.empty()) cfg.speaker_db = sdb;
+    cfg.speaker_ann = get_bool(entries, "speaker_id", "ann", false);
+    cfg.speaker_participants_first =
+        get_bool(entries, "speaker_id", "participants_first", false);
+    cfg.speaker_embedding_precision = get_val(entries, "speaker_id", "embedding_precision",
+                                              cfg.speaker_embedding_precision);
 
     // VAD section
     cfg.vad = get_bool(entries, "vad", "enabled", true);
@@ -231,6 +291,7 @@ Config load_config(const fs::path& config_path) {
     if (!vmsp.empty()) cfg.vad_min_speech = std::atof(vmsp.c_str());
     std::string vmxs = get_val(entries, "vad", "max_speech", "");
     if (!vmxs.empty()) cfg.vad_max_speech = std::atof(vmxs.c_str());
+    cfg.vad_pack = get_bool(entries, "vad", "pack", true);
 
     // Live captions section (Phase 4 — global preference; tray reads this
     // for its checkbox initial state). Both keys are optional; a missing
@@ -241,10 +302,39 @@ Config load_config(const fs::path& config_path) {
     cfg.caption_model = get_val(entries, "captions", "model", "");
     cfg.caption_normalize_display =
         get_bool(entries, "captions", "normalize_display", true);
+    auto cphz = get_val(entries, "captions", "partial_hz");
+    if (!cphz.empty()) cfg.caption_partial_hz = std::atoi(cphz.c_str());
+    cfg.caption_transcript = get_bool(entries, "captions", "as_transcript", false);
+    auto cthreads = get_val(entries, "captions", "threads");
+    if (!cthreads.empty()) cfg.caption_threads = std::atoi(cthreads.c_str());
+    cfg.caption_keep_warm = get_bool(entries, "captions", "keep_warm", true);
+    cfg.caption_mlock = get_bool(entries, "captions", "mlock", false);
+    cfg.caption_int8_fallback = get_bool(entries, "captions", "int8_fallback", true);
 
     // General section
     std::string threads_str = get_val(entries, "general", "threads", "0");
     cfg.threads = std::atoi(threads_str.c_str());
+    cfg.pin_threads = get_bool(entries, "general", "pin_threads", true);
+    cfg.backend_bench = get_bool(entries, "general", "backend_bench", true);
+    cfg.model_hugepages = get_bool(entries, "general", "hugepages", false);
+    cfg.perf_counters = get_bool(entries, "general", "perf_counters", false);
+
+    // Postprocess section (daemon warm worker)
+    std::string pwj = get_val(entries, "postprocess", "worker_jobs", "");
+    if (!pwj.empty()) cfg.pp_worker_jobs = std::atoi(pwj.c_str());
+    std::string pwr = get_val(entries, "postprocess", "worker_rss_mb", "");
+    if (!pwr.empty()) cfg.pp_worker_rss_mb = std::atoi(pwr.c_str());
+    std::string pmj = get_val(entries, "postprocess", "max_jobs", "");
+    if (!pmj.empty()) cfg.pp_max_jobs = std::atoi(pmj.c_str());
+    cfg.pp_yield_to_recording = get_bool(entries, "postprocess", "yield_to_recording", true);
+    cfg.pp_on_battery = get_val(entries, "postprocess", "on_battery", cfg.pp_on_battery);
+    cfg.pp_battery_model = get_val(entries, "postprocess", "battery_model", "");
+    cfg.stage_cache = get_bool(entries, "postprocess", "stage_cache", true);
+    cfg.remote_worker = get_val(entries, "postprocess", "remote_worker", "");
+    std::string wdir = get_val(entries, "postprocess", "watch_dir", "");
+    if (!wdir.empty()) cfg.watch_dir = wdir;
+    std::string wsettle = get_val(entries, "postprocess", "watch_settle_sec", "");
+    if (!wsettle.empty()) cfg.watch_settle_sec = std::atoi(wsettle.c_str());
 
     // Logging section
     cfg.log_level_str = get_val(entries, "logging", "level", "error");
@@ -274,6 +364,10 @@ Config load_config(const fs::path& config_path) {
     std::string port_str = get_val(entries, "web", "port", "8384");
     cfg.web_port = std::atoi(port_str.c_str());
     cfg.web_bind = get_val(entries, "web", "bind", "127.0.0.1");
+    std::string hw = get_val(entries, "web", "heavy_workers", "");
+    if (!hw.empty()) cfg.web_heavy_workers = std::max(1, std::atoi(hw.c_str()));
+    std::string hq = get_val(entries, "web", "heavy_queue", "");
+    if (!hq.empty()) cfg.web_heavy_queue = std::max(0, std::atoi(hq.c_str()));
 
     return cfg;
 }
@@ -304,6 +398,12 @@ void save_config(const Config& cfg, const fs::path& config_path) {
         out << "  mic_only: true\n";
     if (cfg.keep_sources)
         out << "  keep_sources: true\n";
+    if (!cfg.spool_capture)
+        out << "  spool_capture: false\n";
+    if (cfg.audio_archive != "wav")
+        out << "  archive: " << cfg.audio_archive << "\n";
+    if (cfg.archive_speech_only)
+        out << "  archive_speech_only: true\n";
 
     out << "\ntranscription:\n"
         << "  model: " << cfg.whisper_model << "\n";
@@ -311,6 +411,22 @@ void save_config(const Config& cfg, const fs::path& config_path) {
         out << "  language: " << cfg.language << "\n";
     if (!cfg.vocabulary.empty())
         out << "  vocabulary: \"" << cfg.vocabulary << "\"\n";
+    if (cfg.whisper_workers > 0)
+        out << "  workers: " << cfg.whisper_workers << "\n";
+    if (cfg.live_transcribe)
+        out << "  live: true\n";
+    if (!cfg.whisper_draft_model.empty())
+        out << "  draft_model: " << cfg.whisper_draft_model << "\n";
+    if (cfg.draft_logprob != -0.5f)
+        out << "  draft_logprob: " << cfg.draft_logprob << "\n";
+    if (cfg.clip_model != "base")
+        out << "  clip_model: \"" << cfg.clip_model << "\"\n";
+    if (cfg.language_pin_sec != 30)
+        out << "  language_pin_sec: " << cfg.language_pin_sec << "\n";
+    if (!cfg.whisper_gpu)
+        out << "  gpu: false\n";
+    if (cfg.whisper_gpu_devices != 1)
+        out << "  gpu_devices: " << cfg.whisper_gpu_devices << "\n";
 
     out << "\nsummary:\n"
         << "  provider: " << cfg.provider << "\n";
@@ -323,6 +439,22 @@ void save_config(const Config& cfg, const fs::path& config_path) {
         out << "  llm_model: \"" << cfg.llm_model << "\"\n";
     if (cfg.llm_mmap)
         out << "  llm_mmap: true\n";
+    if (!cfg.llm_draft_model.empty())
+        out << "  llm_draft_model: \"" << cfg.llm_draft_model << "\"\n";
+    if (cfg.summary_chunk_tokens != 0)
+        out << "  chunk_tokens: " << cfg.summary_chunk_tokens << "\n";
+    if (!cfg.summary_compact)
+        out << "  compact: false\n";
+    if (cfg.llm_kv_type != "f16")
+        out << "  llm_kv_type: " << cfg.llm_kv_type << "\n";
+    if (cfg.llm_batch != 0)
+        out << "  llm_batch: " << cfg.llm_batch << "\n";
+    if (cfg.llm_ubatch != 0)
+        out << "  llm_ubatch: " << cfg.llm_ubatch << "\n";
+    if (cfg.llm_gpu_layers != -1)
+        out << "  llm_gpu_layers: " << cfg.llm_gpu_layers << "\n";
+    if (cfg.rolling_summary_minutes != 0)
+        out << "  rolling_minutes: " << cfg.rolling_summary_minutes << "\n";
 
     // Per-provider API keys (never write legacy api_key)
     {
@@ -343,7 +475,11 @@ void save_config(const Config& cfg, const fs::path& config_path) {
         cfg.chunk_minutes != 15.0f || cfg.chunk_overlap_sec != 30.0f ||
         cfg.stitch_threshold != 0.6f ||
         cfg.max_auto_speakers != 8 || cfg.collapse_threshold != 0.65f ||
-        cfg.min_cluster_duration_sec != 3.0f) {
+        cfg.min_cluster_duration_sec != 3.0f ||
+        !cfg.diarize_overlap || cfg.overlap_memory_mb != 10240 ||
+        cfg.diarize_parallel_chunks != 0 || !cfg.diarize_auto_chunk || cfg.live_diarize ||
+        cfg.diarize_share_overlap || cfg.diarize_speech_only || !cfg.local_speaker.empty() ||
+        cfg.diarize_provider != "auto") {
         out << "\ndiarization:\n";
         if (!cfg.diarize)
             out << "  enabled: false\n";
@@ -363,9 +499,29 @@ void save_config(const Config& cfg, const fs::path& config_path) {
             out << "  collapse_threshold: " << cfg.collapse_threshold << "\n";
         if (cfg.min_cluster_duration_sec != 3.0f)
             out << "  min_cluster_duration_sec: " << cfg.min_cluster_duration_sec << "\n";
+        if (!cfg.diarize_overlap)
+            out << "  overlap: false\n";
+        if (cfg.overlap_memory_mb != 10240)
+            out << "  overlap_memory_mb: " << cfg.overlap_memory_mb << "\n";
+        if (cfg.diarize_parallel_chunks != 0)
+            out << "  parallel_chunks: " << cfg.diarize_parallel_chunks << "\n";
+        if (!cfg.diarize_auto_chunk)
+            out << "  auto_chunk: false\n";
+        if (cfg.live_diarize)
+            out << "  live: true\n";
+        if (cfg.diarize_share_overlap)
+            out << "  share_overlap: true\n";
+        if (cfg.diarize_speech_only)
+            out << "  speech_only: true\n";
+        if (!cfg.local_speaker.empty())
+            out << "  local_speaker: \"" << cfg.local_speaker << "\"\n";
+        if (cfg.diarize_provider != "auto")
+            out << "  provider: " << cfg.diarize_provider << "\n";
     }
 
-    if (!cfg.speaker_id || cfg.speaker_threshold != 0.6f || !cfg.speaker_db.empty()) {
+    if (!cfg.speaker_id || cfg.speaker_threshold != 0.6f || !cfg.speaker_db.empty() ||
+        cfg.speaker_ann || cfg.speaker_participants_first ||
+        cfg.speaker_embedding_precision != "f32") {
         out << "\nspeaker_id:\n";
         if (!cfg.speaker_id)
             out << "  enabled: false\n";
@@ -373,10 +529,16 @@ void save_config(const Config& cfg, const fs::path& config_path) {
             out << "  threshold: " << cfg.speaker_threshold << "\n";
         if (!cfg.speaker_db.empty())
             out << "  database: \"" << cfg.speaker_db.string() << "\"\n";
+        if (cfg.speaker_ann)
+            out << "  ann: true\n";
+        if (cfg.speaker_participants_first)
+            out << "  participants_first: true\n";
+        if (cfg.speaker_embedding_precision != "f32")
+            out << "  embedding_precision: " << cfg.speaker_embedding_precision << "\n";
     }
 
     if (!cfg.vad || cfg.vad_threshold != 0.5f || cfg.vad_min_silence != 0.5f ||
-        cfg.vad_min_speech != 0.25f || cfg.vad_max_speech != 30.0f) {
+        cfg.vad_min_speech != 0.25f || cfg.vad_max_speech != 30.0f || !cfg.vad_pack) {
         out << "\nvad:\n";
         if (!cfg.vad)
             out << "  enabled: false\n";
@@ -388,6 +550,8 @@ void save_config(const Config& cfg, const fs::path& config_path) {
             out << "  min_speech: " << cfg.vad_min_speech << "\n";
         if (cfg.vad_max_speech != 30.0f)
             out << "  max_speech: " << cfg.vad_max_speech << "\n";
+        if (!cfg.vad_pack)
+            out << "  pack: false\n";
     }
 
     // Live captions (Phase 4 + 5.5) — only emitted when non-default to keep
@@ -396,7 +560,9 @@ void save_config(const Config& cfg, const fs::path& config_path) {
     // emit only when the user has explicitly turned it off so the YAML
     // round-trip preserves the negation.
     if (cfg.captions_enabled || !cfg.caption_model.empty()
-        || !cfg.caption_normalize_display) {
+        || !cfg.caption_normalize_display || cfg.caption_partial_hz != 10
+        || cfg.caption_transcript || cfg.caption_threads != 1 || !cfg.caption_keep_warm
+        || cfg.caption_mlock || !cfg.caption_int8_fallback) {
         out << "\ncaptions:\n";
         if (cfg.captions_enabled)
             out << "  enabled: true\n";
@@ -404,14 +570,63 @@ void save_config(const Config& cfg, const fs::path& config_path) {
             out << "  model: " << cfg.caption_model << "\n";
         if (!cfg.caption_normalize_display)
             out << "  normalize_display: false\n";
+        if (cfg.caption_partial_hz != 10)
+            out << "  partial_hz: " << cfg.caption_partial_hz << "\n";
+        if (cfg.caption_transcript)
+            out << "  as_transcript: true\n";
+        if (cfg.caption_threads != 1)
+            out << "  threads: " << cfg.caption_threads << "\n";
+        if (!cfg.caption_keep_warm)
+            out << "  keep_warm: false\n";
+        if (cfg.caption_mlock)
+            out << "  mlock: true\n";
+        if (!cfg.caption_int8_fallback)
+            out << "  int8_fallback: false\n";
     }
 
     out << "\noutput:\n"
         << "  directory: \"" << cfg.output_dir.string() << "\"\n";
 
-    if (cfg.threads > 0) {
-        out << "\ngeneral:\n"
-            << "  threads: " << cfg.threads << "\n";
+    if (cfg.threads > 0 || !cfg.pin_threads || !cfg.backend_bench || cfg.model_hugepages ||
+        cfg.perf_counters) {
+        out << "\ngeneral:\n";
+        if (cfg.threads > 0)
+            out << "  threads: " << cfg.threads << "\n";
+        if (!cfg.pin_threads)
+            out << "  pin_threads: false\n";
+        if (!cfg.backend_bench)
+            out << "  backend_bench: false\n";
+        if (cfg.model_hugepages)
+            out << "  hugepages: true\n";
+        if (cfg.perf_counters)
+            out << "  perf_counters: true\n";
+    }
+
+    if (cfg.pp_worker_jobs != 8 || cfg.pp_worker_rss_mb != 6144 || cfg.pp_max_jobs != 1 ||
+        !cfg.pp_yield_to_recording || cfg.pp_on_battery != "reduce" ||
+        !cfg.pp_battery_model.empty() || !cfg.stage_cache || !cfg.remote_worker.empty() ||
+        !cfg.watch_dir.empty() || cfg.watch_settle_sec != 30) {
+        out << "\npostprocess:\n";
+        if (cfg.pp_worker_jobs != 8)
+            out << "  worker_jobs: " << cfg.pp_worker_jobs << "\n";
+        if (cfg.pp_worker_rss_mb != 6144)
+            out << "  worker_rss_mb: " << cfg.pp_worker_rss_mb << "\n";
+        if (cfg.pp_max_jobs != 1)
+            out << "  max_jobs: " << cfg.pp_max_jobs << "\n";
+        if (!cfg.pp_yield_to_recording)
+            out << "  yield_to_recording: false\n";
+        if (cfg.pp_on_battery != "reduce")
+            out << "  on_battery: " << cfg.pp_on_battery << "\n";
+        if (!cfg.pp_battery_model.empty())
+            out << "  battery_model: " << cfg.pp_battery_model << "\n";
+        if (!cfg.stage_cache)
+            out << "  stage_cache: false\n";
+        if (!cfg.remote_worker.empty())
+            out << "  remote_worker: \"" << cfg.remote_worker << "\"\n";
+        if (!cfg.watch_dir.empty())
+            out << "  watch_dir: \"" << cfg.watch_dir.string() << "\"\n";
+        if (cfg.watch_settle_sec != 30)
+            out << "  watch_settle_sec: " << cfg.watch_settle_sec << "\n";
     }
 
     if (cfg.log_level_str != "error" || !cfg.log_dir.empty() || cfg.log_retention_hours != 4) {
@@ -428,12 +643,17 @@ void save_config(const Config& cfg, const fs::path& config_path) {
     if (!cfg.note_dir.empty())
         out << "  directory: \"" << cfg.note_dir.string() << "\"\n";
 
-    if (cfg.web_port != 8384 || cfg.web_bind != "127.0.0.1") {
+    if (cfg.web_port != 8384 || cfg.web_bind != "127.0.0.1" || cfg.web_heavy_workers != 2 ||
+        cfg.web_heavy_queue != 4) {
         out << "\nweb:\n";
         if (cfg.web_port != 8384)
             out << "  port: " << cfg.web_port << "\n";
         if (cfg.web_bind != "127.0.0.1")
             out << "  bind: \"" << cfg.web_bind << "\"\n";
+        if (cfg.web_heavy_workers != 2)
+            out << "  heavy_workers: " << cfg.web_heavy_workers << "\n";
+        if (cfg.web_heavy_queue != 4)
+            out << "  heavy_queue: " << cfg.web_heavy_queue << "\n";
     }
 
     out.close();
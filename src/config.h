@@ -34,12 +34,67 @@ struct Config {
     std::string mic_source;     // empty = auto-detect
     std::string monitor_source; // empty = auto-detect
     bool mic_only = false;
-    bool keep_sources = false;  // Keep mic.wav and monitor.wav after mixing
+    bool keep_sources = false;  // Keep mic + monitor as a 2-channel sources.wav after mixing
+    // Stream capture audio to disk while recording (mic-only: straight to
+    // the meeting WAV; dual: through StreamingMixer) instead of holding the
+    // whole meeting in RAM until stop. Daemon RSS stays flat for any
+    // meeting length and stopping only flushes the tail block. Persisted as
+    // `audio.spool_capture: false` to opt out.
+    bool spool_capture = true;
+    // On-disk format for a finished meeting's audio (and kept sources):
+    // "wav" (as recorded), "flac" (lossless) or "opus" (lossy). Re-encoded
+    // after the meeting note is written; readers (reprocess, enroll,
+    // identify) decode archived files range by range. Persisted as
+    // `audio.archive`.
+    std::string audio_archive = "wav";
+    // Archive only the speech of the meeting audio: the VAD regions padded
+    // by half a second, with a sparse_<ts>.bin index that readers use to
+    // restore the original timeline (dropped silence reads as zeros).
+    // Needs the VAD index postprocessing leaves; kept sources are archived
+    // whole. Persisted as `audio.archive_speech_only`.
+    bool archive_speech_only = false;
 
     // Transcription
     std::string whisper_model = "base";
     std::string language; // empty = auto-detect, otherwise ISO 639-1 code (e.g. "en")
     std::string vocabulary; // comma-separated vocabulary hints for whisper initial_prompt
+    // Concurrent whisper calls over VAD segments, each on its own
+    // whisper_state sharing the loaded weights; `threads` is split between
+    // them. 0 = auto (about one per 4 threads, at most 8). Persisted as
+    // `transcription.workers`.
+    int whisper_workers = 0;
+    // Decode finished VAD segments with whisper while the meeting is still
+    // recording (spool capture + VAD only), on an idle-priority worker that
+    // yields to the caption engine. Results accumulate in `live_<ts>.ndjson`
+    // and postprocessing decodes only what the worker had not reached.
+    // Opt-in: the whisper model stays loaded for the whole recording.
+    // Persisted as `transcription.live`.
+    bool live_transcribe = false;
+    // Two-pass transcription: when set (e.g. "base" under a "medium"
+    // whisper_model), this smaller model decodes every VAD window first and
+    // only windows with a segment below `draft_logprob` mean token
+    // log-probability (or likely no speech) are decoded again with
+    // whisper_model. Needs VAD. Persisted as `transcription.draft_model` /
+    // `transcription.draft_logprob`.
+    std::string whisper_draft_model;
+    float draft_logprob = -0.5f;
+    // Model for `transcribe.clip` (clip_transcribe.h): the daemon loads it
+    // when a recording starts, if downloaded, so transcripts of the last
+    // few seconds come back within a second or two. Empty disables
+    // transcribe.clip. Persisted as `transcription.clip_model`.
+    std::string clip_model = "base";
+    // With `language` empty: detect the language once on the first this
+    // many seconds of speech and decode every window in it, instead of
+    // letting whisper detect it per window. 0 = detect per window.
+    // Persisted as `transcription.language_pin_sec`.
+    int language_pin_sec = 30;
+    // Run whisper on the GPU backend when one enumerates; false keeps it on
+    // the CPU. Persisted as `transcription.gpu`.
+    bool whisper_gpu = true;
+    // GPUs VAD windows are spread over, one loaded copy of the model on
+    // each, drawing from one queue. 1 = the first GPU only, 0 = every GPU
+    // ggml enumerates. Persisted as `transcription.gpu_devices`.
+    int whisper_gpu_devices = 1;
 
     // Summarization
     std::string provider = "xai";
@@ -54,6 +109,38 @@ struct Config {
     // Local LLM
     std::string llm_model; // path or name, empty = use HTTP API
     bool llm_mmap = false;  // use mmap for model loading (default: off to avoid swap thrashing)
+    // Small GGUF sharing llm_model's vocabulary, used to draft tokens for
+    // speculative decoding. Empty = no draft. Persisted as
+    // `summary.llm_draft_model`.
+    std::string llm_draft_model;
+    // KV cache element type for local summaries: "f16", "q8_0" or "q4_0".
+    // The quantized types halve or quarter KV memory and turn on flash
+    // attention. Persisted as `summary.llm_kv_type`.
+    std::string llm_kv_type = "f16";
+    // Prompt tokens per llama_decode call (n_batch) and per compute pass
+    // within it (n_ubatch). 0 = 2048 and 512. Persisted as
+    // `summary.llm_batch` and `summary.llm_ubatch`.
+    int llm_batch = 0;
+    int llm_ubatch = 0;
+    // Layers of llm_model offloaded to the active GPU backend: -1 = as
+    // many as fit its free memory, 0 = CPU only. Persisted as
+    // `summary.llm_gpu_layers`.
+    int llm_gpu_layers = -1;
+    // Fold the live transcript into running notes every N minutes while
+    // recording (needs live_transcribe), so postprocessing summarizes those
+    // notes and the transcript after them instead of the whole meeting.
+    // 0 = off. Persisted as `summary.rolling_minutes`.
+    int rolling_summary_minutes = 0;
+    // Prompt tokens past which a transcript is summarized in parts and the
+    // parts' notes combined (map-reduce) instead of truncated. 0 = the
+    // local model's context, or HTTP_SUMMARY_CHUNK_TOKENS for an API.
+    // Persisted as `summary.chunk_tokens`.
+    int summary_chunk_tokens = 0;
+    // Compact the transcript before it is summarized: merge a speaker's
+    // consecutive lines into turns and drop fillers and repeats
+    // (compact_transcript). The saved transcript is untouched. Persisted as
+    // `summary.compact`.
+    bool summary_compact = true;
 
     // Diarization (on by default when built with RECMEET_USE_SHERPA)
     bool diarize = true;
@@ -103,14 +190,74 @@ struct Config {
     // values violate this invariant.
     float chunk_minutes = 15.0f;
     float chunk_overlap_sec = 30.0f;
+    // Size chunks to the host's memory ceiling instead (cgroup MemoryMax,
+    // RECMEET_RSS_LIMIT_MB or physical RAM; see plan_diarize_chunking).
+    // Setting either value above, in the file or on the command line, turns
+    // this off. Persisted as [diarization] auto_chunk = BOOL.
+    bool diarize_auto_chunk = true;
     /// Cosine-similarity floor for stitching chunk-local centroids into the
     /// global registry (matches the SherpaOnnxSpeakerEmbeddingManager metric).
     float stitch_threshold = 0.6f;
+    // Run diarization on the CPU while whisper transcribes on a GPU backend
+    // instead of after it. Engaged only when the projected peak (current
+    // RSS + the diarize estimate, see plan_diarize_overlap) fits under
+    // `overlap_memory_mb` and MemAvailable; otherwise the stages run in
+    // sequence as before. The default budget matches the unit's
+    // MemoryHigh=10G. Persisted as [diarization] overlap / overlap_memory_mb.
+    bool diarize_overlap = true;
+    int overlap_memory_mb = 10240;
+    // Chunks of a long recording diarized at once, each on its own sherpa
+    // session pair (see plan_diarize_parallel). 0 = as many as fit in
+    // `overlap_memory_mb` above the current RSS, 1 = one at a time, N = at
+    // most N. Output is identical either way. Persisted as
+    // [diarization] parallel_chunks = N.
+    int diarize_parallel_chunks = 0;
+    // Diarize each chunk of a long recording as soon as it is final
+    // (spool capture + VAD only), on an idle-priority worker with its own
+    // sherpa sessions. Results accumulate in `live_diarize_<ts>.ndjson` and
+    // postprocessing diarizes only the chunks after them. Opt-in: a chunk
+    // costs several GB while it runs. Persisted as [diarization] live.
+    bool live_diarize = false;
+    // Embed the PCM adjacent chunks share once, on fixed windows both
+    // chunks look up, instead of once per chunk; centroids blend each
+    // speaker's private speech with the windows it owns. Lets the overlap
+    // grow without a second extraction over it. Persisted as
+    // [diarization] share_overlap.
+    bool diarize_share_overlap = false;
+    // Diarize only the VAD speech regions, back to back with the long
+    // silences cut to half a second (CompactedSampleSource), and map the
+    // segments back to the recording's timeline. Cost follows speech time.
+    // Needs VAD; takes the place of live diarization. Persisted as
+    // [diarization] speech_only.
+    bool diarize_speech_only = false;
+    // Name for the local participant in dual-source recordings: stretches
+    // where the mic dominates the monitor (channel_attribution.h) are
+    // labelled with it and only the rest is diarized. Empty = off. Persisted
+    // as [diarization] local_speaker.
+    std::string local_speaker;
+    // onnxruntime execution provider for the segmentation and embedding
+    // sessions: auto, cpu, cuda or xnnpack (onnx_provider.h). Unavailable
+    // providers fall back to the CPU. Persisted as [diarization] provider.
+    std::string diarize_provider = "auto";
 
     // Speaker identification (cross-session voiceprint matching)
     bool speaker_id = true;  // enabled when speaker DB exists
     float speaker_threshold = 0.6f;  // cosine similarity threshold
     fs::path speaker_db;  // empty = default (~/.local/share/recmeet/speakers/)
+    // Search databases of SPEAKER_ANN_MIN_ROWS (512) or more speakers
+    // through an approximate IVF index, kept in speakers.ivf next to
+    // speakers.bin. Matches score exactly; a few may be missed. YAML:
+    // [speaker_id] ann.
+    bool speaker_ann = false;
+    // Match clusters against the enrolled profiles of the context's
+    // Participants first, and against the whole database only for clusters
+    // none of them matches. YAML: [speaker_id] participants_first.
+    bool speaker_participants_first = false;
+    // Precision of the embeddings in speakers_<ts>.json and in
+    // --export-speakers profiles: "f32", "f16" or "int8" (see
+    // embedding_set.h). speakers.bin stays float32. YAML: [speaker_id]
+    // embedding_precision.
+    std::string speaker_embedding_precision = "f32";
 
     // VAD (on by default when built with RECMEET_USE_SHERPA)
     bool vad = true;
@@ -118,6 +265,10 @@ struct Config {
     float vad_min_silence = 0.5f;
     float vad_min_speech = 0.25f;
     float vad_max_speech = 30.0f;
+    // Pack consecutive speech segments into ~30 s windows (whisper's fixed
+    // encoder length) with short silence between them, one decode per
+    // window, instead of one decode per segment. Persisted as `vad.pack`.
+    bool vad_pack = true;
 
     // Live captions (Phase 3 daemon wiring + Phase 4 surface). When
     // `captions_enabled` is true on a `record.start`, pipeline.cpp wires a
@@ -142,8 +293,108 @@ struct Config {
     // true. Disable for transcript-fidelity debugging.
     bool caption_normalize_display = true;
 
+    // Daemon: most partial `caption` events each client gets per second,
+    // per caption source (YAML `captions.partial_hz`; 0 = every one).
+    // Newer partials replace held ones; finals are always sent at once. A
+    // client may set its own rate with `captions.configure`.
+    int caption_partial_hz = 10;
+
+    // Postprocessing takes the finalized live captions in `captions.vtt`
+    // as the transcript and skips whisper (YAML `captions.as_transcript`).
+    // Much faster, at streaming-Zipformer accuracy; diarization and speaker
+    // identification still run. Falls back to whisper when the recording
+    // left no captions.
+    bool caption_transcript = false;
+
+    // ONNX threads of the caption recognizer, 1 or 2 (YAML
+    // `captions.threads`). A second thread halves decode time on a slow
+    // core at the cost of a core the capture shares.
+    int caption_threads = 1;
+
+    // Keep the caption recognizer loaded between recordings, and have the
+    // daemon load it at startup when captions are on, so captions begin
+    // without the model load (YAML `captions.keep_warm`). Costs the
+    // model's memory while idle.
+    bool caption_keep_warm = true;
+    // mlock() the caption recognizer's weights while an engine decodes, so
+    // a memory-pressured host never pages them out mid-meeting (YAML
+    // `captions.mlock`, see model_memory.h). Needs RLIMIT_MEMLOCK above the
+    // model's size; a failed lock is logged and captions run unlocked.
+    bool caption_mlock = false;
+    // Switch the caption recognizer to the model's int8 weights when the
+    // fp32 decode falls behind real time over its first seconds (YAML
+    // `captions.int8_fallback`), instead of dropping audio. An `-int8`
+    // caption_model loads them from the start.
+    bool caption_int8_fallback = true;
+
     // Performance
     int threads = 0;  // 0 = auto-detect (hardware_concurrency - 1)
+    // Place inference by CPU topology (YAML `general.pin_threads`, see
+    // cpu_topology.h): whisper, llama and offline sherpa on the performance
+    // cores of one NUMA node, one thread per physical core when `threads`
+    // is 0; VAD and live captions on a hybrid CPU's efficiency cores.
+    bool pin_threads = true;
+    // Choose each whisper and LLM model's backend by a one-time benchmark
+    // against the CPU (YAML `general.backend_bench`, see backend_bench.h)
+    // instead of always taking the GPU.
+    bool backend_bench = true;
+    // Advise transparent huge pages (MADV_HUGEPAGE) for the memory each
+    // whisper, llama and ONNX model load maps, and log how much of it is
+    // backed by huge pages (YAML `general.hugepages`, see model_memory.h).
+    bool model_hugepages = false;
+    // Count cycles, instructions, cache and branch misses per pipeline stage
+    // and engine call with perf_event_open() (YAML `general.perf_counters`,
+    // see perf_counters.h).
+    bool perf_counters = false;
+
+    // Daemon postprocessing worker. Jobs run in a `recmeet --pp-worker`
+    // subprocess that stays alive between jobs with its whisper, sherpa and
+    // llama models loaded, so back-to-back meetings skip the reload. The
+    // daemon starts a fresh worker after `pp_worker_jobs` jobs, once a job
+    // leaves it above `pp_worker_rss_mb`, after a failed or cancelled job,
+    // and after 10 idle minutes. pp_worker_jobs = 0 launches one subprocess
+    // per job. Persisted as [postprocess] worker_jobs / worker_rss_mb.
+    int pp_worker_jobs = 8;
+    int pp_worker_rss_mb = 6144;
+    // Postprocessing jobs the daemon runs at once, each in its own worker.
+    // A job beyond the first starts only when its estimated memory and
+    // threads (estimate_pp_footprint) fit beside the running ones under the
+    // unit's memory budget and the host's cores. Read at daemon start.
+    // Persisted as [postprocess] max_jobs.
+    int pp_max_jobs = 1;
+    // Run a postprocessing job's threads at SCHED_IDLE while a recording is
+    // active, so the capture and caption threads keep their CPUs, and at
+    // normal priority again once it stops (cpu_topology.h). Persisted as
+    // [postprocess] yield_to_recording.
+    bool pp_yield_to_recording = true;
+    // Postprocessing on battery (power_policy.h): "run" as on AC, "reduce"
+    // to a quarter of the threads and pp_battery_model, or "defer" to hold
+    // the daemon's queued jobs until AC power returns. A thermal zone at its
+    // throttling point halves the threads either way. Persisted as
+    // [postprocess] on_battery / battery_model.
+    std::string pp_on_battery = "reduce";
+    // Whisper model for a job the daemon starts in the reduced profile;
+    // empty = transcription.model.
+    std::string pp_battery_model;
+    // Save each stage's output (raw transcript, diarization + centroids,
+    // summary) next to the audio, keyed by its inputs, and reuse it when a
+    // later pass over the meeting has the same inputs (stage_cache.h).
+    // false neither reads nor writes these files. Persisted as
+    // [postprocess] stage_cache.
+    bool stage_cache = true;
+    // A recmeet-daemon started with --worker (host:port) that runs this
+    // daemon's postprocessing stages, such as a GPU host (remote_worker.h).
+    // The stages come back through the stage cache; speaker identification
+    // and the note stay here. Empty = run everything locally. Persisted as
+    // [postprocess] remote_worker.
+    std::string remote_worker;
+    // Watch folder (watch_folder.h): the daemon ingests each audio file that
+    // appears under watch_dir once its size and mtime have held still for
+    // watch_settle_sec — moved into a new meeting directory under output_dir
+    // and queued as a batch job. Empty = off. Persisted as [postprocess]
+    // watch_dir / watch_settle_sec.
+    fs::path watch_dir;
+    int watch_settle_sec = 30;
 
     // Logging
     std::string log_level_str = "error";  // "none", "error", "warn", "info", "debug"
@@ -174,8 +425,16 @@ struct Config {
 
     // Reprocess
     fs::path reprocess_dir;
+    // --recluster: redo only stitching and collapse over reprocess_dir's
+    // clustering stage, failing instead of re-running whisper or sherpa.
+    // Command-line only; never persisted to YAML.
+    bool recluster = false;
     fs::path reprocess_batch_dir;
     bool reprocess_batch_dry_run = false;
+    // --refresh: the batch also reprocesses meetings whose note was written
+    // from other inputs than the current config would use (the meeting
+    // manifest, stage_cache.h). Command-line only; never persisted to YAML.
+    bool reprocess_batch_refresh = false;
 
     // Batch mode flag — propagates through IPC + subprocess JSON; daemon stores
     // per-job; tray reads via job.complete event. Suppresses per-meeting
@@ -183,14 +442,36 @@ struct Config {
     // end-of-batch summary notification.
     bool batch_mode = false;
 
+    // Pipelined batch (run_pipelined_batch, reprocess_batch.h): stop
+    // run_postprocessing once this stage (STAGE_TRANSCRIPT or
+    // STAGE_DIARIZATION) is in the stage cache, without writing a note.
+    // In-process only; never persisted or sent over IPC.
+    std::string prepare_stage;
+
     // Web server
     int web_port = 8384;
     std::string web_bind = "127.0.0.1";
+    // Heavy endpoints (enroll, relabel, rerender, reprocess, speaker
+    // deletes) run at most web_heavy_workers at once with web_heavy_queue
+    // more waiting; past that recmeet-web answers 429 (heavy_work.h). YAML:
+    // [web] heavy_workers, heavy_queue.
+    int web_heavy_workers = 2;
+    int web_heavy_queue = 4;
 };
 
-/// Load config. Uses path if provided, otherwise ~/.config/recmeet/config.yaml.
+/// Load config. Uses path if provided, otherwise ~/.config/recmeet/config.yaml
+/// layered over this host's tune profile (tune_profile_path()).
 Config load_config(const fs::path& config_path = {});
 
+/// Load `config_path` layered over `tune_profile`: a key the config file
+/// does not set is taken from the profile, then from the defaults. Either
+/// file may be missing.
+Config load_config(const fs::path& config_path, const fs::path& tune_profile);
+
+/// Per-host recommendations written by `recmeet --autotune` (autotune.h):
+/// ~/.local/share/recmeet/autotune/<hostname>.yaml, a config.yaml fragment.
+fs::path tune_profile_path();
+
 /// Save config. Uses path if provided, otherwise ~/.config/recmeet/config.yaml.
 void save_config(const Config& cfg, const fs::path& config_path = {});
 
@@ -18,10 +18,21 @@ JsonMap config_to_map(const Config& cfg) {
     m["monitor_source"]  = cfg.monitor_source;
     m["mic_only"]        = cfg.mic_only;
     m["keep_sources"]    = cfg.keep_sources;
+    m["spool_capture"]   = cfg.spool_capture;
+    m["audio_archive"]   = cfg.audio_archive;
+    m["archive_speech_only"] = cfg.archive_speech_only;
 
     // Transcription
     m["whisper_model"]   = cfg.whisper_model;
+    m["whisper_workers"] = static_cast<int64_t>(cfg.whisper_workers);
+    m["live_transcribe"] = cfg.live_transcribe;
+    m["whisper_draft_model"] = cfg.whisper_draft_model;
+    m["whisper_clip_model"] = cfg.clip_model;
+    m["draft_logprob"]   = static_cast<double>(cfg.draft_logprob);
     m["language"]        = cfg.language;
+    m["language_pin_sec"] = static_cast<int64_t>(cfg.language_pin_sec);
+    m["whisper_gpu"]     = cfg.whisper_gpu;
+    m["whisper_gpu_devices"] = static_cast<int64_t>(cfg.whisper_gpu_devices);
     m["vocabulary"]      = cfg.vocabulary;
 
     // Summarization
@@ -32,6 +43,14 @@ JsonMap config_to_map(const Config& cfg) {
     m["no_summary"]      = cfg.no_summary;
     m["llm_model"]       = cfg.llm_model;
     m["llm_mmap"]        = cfg.llm_mmap;
+    m["llm_draft_model"] = cfg.llm_draft_model;
+    m["summary_chunk_tokens"] = static_cast<int64_t>(cfg.summary_chunk_tokens);
+    m["summary_compact"] = cfg.summary_compact;
+    m["llm_kv_type"]     = cfg.llm_kv_type;
+    m["llm_batch"]       = static_cast<int64_t>(cfg.llm_batch);
+    m["llm_ubatch"]      = static_cast<int64_t>(cfg.llm_ubatch);
+    m["llm_gpu_layers"]  = static_cast<int64_t>(cfg.llm_gpu_layers);
+    m["rolling_summary_minutes"] = static_cast<int64_t>(cfg.rolling_summary_minutes);
 
     // Diarization
     m["diarize"]             = cfg.diarize;
@@ -45,11 +64,23 @@ JsonMap config_to_map(const Config& cfg) {
     m["collapse_threshold"]  = static_cast<double>(cfg.collapse_threshold);
     // Short-audio min-cluster-duration filter (Phase A.3 follow-up):
     m["min_cluster_duration_sec"] = static_cast<double>(cfg.min_cluster_duration_sec);
+    m["diarize_overlap"]     = cfg.diarize_overlap;
+    m["overlap_memory_mb"]   = static_cast<int64_t>(cfg.overlap_memory_mb);
+    m["diarize_parallel_chunks"] = static_cast<int64_t>(cfg.diarize_parallel_chunks);
+    m["diarize_auto_chunk"]  = cfg.diarize_auto_chunk;
+    m["live_diarize"]        = cfg.live_diarize;
+    m["diarize_share_overlap"] = cfg.diarize_share_overlap;
+    m["diarize_speech_only"] = cfg.diarize_speech_only;
+    m["local_speaker"]       = cfg.local_speaker;
+    m["diarize_provider"]    = cfg.diarize_provider;
 
     // Speaker identification
     m["speaker_id"]          = cfg.speaker_id;
     m["speaker_threshold"]   = static_cast<double>(cfg.speaker_threshold);
     m["speaker_db"]          = cfg.speaker_db.string();
+    m["speaker_ann"]         = cfg.speaker_ann;
+    m["speaker_participants_first"] = cfg.speaker_participants_first;
+    m["speaker_embedding_precision"] = cfg.speaker_embedding_precision;
 
     // VAD
     m["vad"]              = cfg.vad;
@@ -57,6 +88,7 @@ JsonMap config_to_map(const Config& cfg) {
     m["vad_min_silence"]  = static_cast<double>(cfg.vad_min_silence);
     m["vad_min_speech"]   = static_cast<double>(cfg.vad_min_speech);
     m["vad_max_speech"]   = static_cast<double>(cfg.vad_max_speech);
+    m["vad_pack"]         = cfg.vad_pack;
 
     // Live captions (Phase 3 — opt-in per recording via record.start params;
     // Phase 5.5 added `caption_normalize_display`, a client-only knob — the
@@ -65,9 +97,29 @@ JsonMap config_to_map(const Config& cfg) {
     m["captions_enabled"]          = cfg.captions_enabled;
     m["caption_model"]             = cfg.caption_model;
     m["caption_normalize_display"] = cfg.caption_normalize_display;
+    m["caption_partial_hz"]        = static_cast<int64_t>(cfg.caption_partial_hz);
+    m["caption_transcript"]        = cfg.caption_transcript;
+    m["caption_threads"]           = static_cast<int64_t>(cfg.caption_threads);
+    m["caption_keep_warm"]         = cfg.caption_keep_warm;
+    m["caption_mlock"]             = cfg.caption_mlock;
+    m["caption_int8_fallback"]     = cfg.caption_int8_fallback;
 
     // Performance
     m["threads"]          = static_cast<int64_t>(cfg.threads);
+    m["pin_threads"]      = cfg.pin_threads;
+    m["model_hugepages"]  = cfg.model_hugepages;
+    m["perf_counters"]    = cfg.perf_counters;
+    m["backend_bench"]    = cfg.backend_bench;
+    m["pp_worker_jobs"]   = static_cast<int64_t>(cfg.pp_worker_jobs);
+    m["pp_worker_rss_mb"] = static_cast<int64_t>(cfg.pp_worker_rss_mb);
+    m["pp_max_jobs"]      = static_cast<int64_t>(cfg.pp_max_jobs);
+    m["pp_yield_to_recording"] = cfg.pp_yield_to_recording;
+    m["pp_on_battery"]    = cfg.pp_on_battery;
+    m["pp_battery_model"] = cfg.pp_battery_model;
+    m["stage_cache"]      = cfg.stage_cache;
+    m["remote_worker"]    = cfg.remote_worker;
+    m["watch_dir"]        = cfg.watch_dir.string();
+    m["watch_settle_sec"] = static_cast<int64_t>(cfg.watch_settle_sec);
 
     // Logging
     m["log_level"]        = cfg.log_level_str;
@@ -78,8 +130,10 @@ JsonMap config_to_map(const Config& cfg) {
     m["output_dir"]       = cfg.output_dir.string();
     m["note_dir"]         = cfg.note_dir.string();
     m["reprocess_dir"]    = cfg.reprocess_dir.string();
+    m["recluster"]        = cfg.recluster;
     m["reprocess_batch_dir"]     = cfg.reprocess_batch_dir.string();
     m["reprocess_batch_dry_run"] = cfg.reprocess_batch_dry_run;
+    m["reprocess_batch_refresh"] = cfg.reprocess_batch_refresh;
     m["batch_mode"]              = cfg.batch_mode;
 
     // Context
@@ -150,9 +204,20 @@ Config config_from_map(const JsonMap& m) {
     str("monitor_source", cfg.monitor_source);
     b("mic_only", cfg.mic_only);
     b("keep_sources", cfg.keep_sources);
+    b("spool_capture", cfg.spool_capture);
+    str("audio_archive", cfg.audio_archive);
+    b("archive_speech_only", cfg.archive_speech_only);
 
     str("whisper_model", cfg.whisper_model);
+    i("whisper_workers", cfg.whisper_workers);
+    b("live_transcribe", cfg.live_transcribe);
+    str("whisper_draft_model", cfg.whisper_draft_model);
+    str("whisper_clip_model", cfg.clip_model);
+    f("draft_logprob", cfg.draft_logprob);
     str("language", cfg.language);
+    i("language_pin_sec", cfg.language_pin_sec);
+    b("whisper_gpu", cfg.whisper_gpu);
+    i("whisper_gpu_devices", cfg.whisper_gpu_devices);
     str("vocabulary", cfg.vocabulary);
 
     str("provider", cfg.provider);
@@ -162,6 +227,14 @@ Config config_from_map(const JsonMap& m) {
     b("no_summary", cfg.no_summary);
     str("llm_model", cfg.llm_model);
     b("llm_mmap", cfg.llm_mmap);
+    str("llm_draft_model", cfg.llm_draft_model);
+    i("summary_chunk_tokens", cfg.summary_chunk_tokens);
+    b("summary_compact", cfg.summary_compact);
+    str("llm_kv_type", cfg.llm_kv_type);
+    i("llm_batch", cfg.llm_batch);
+    i("llm_ubatch", cfg.llm_ubatch);
+    i("llm_gpu_layers", cfg.llm_gpu_layers);
+    i("rolling_summary_minutes", cfg.rolling_summary_minutes);
 
     b("diarize", cfg.diarize);
     i("num_speakers", cfg.num_speakers);
@@ -174,22 +247,55 @@ Config config_from_map(const JsonMap& m) {
     f("collapse_threshold", cfg.collapse_threshold);
     // Short-audio min-cluster-duration filter (Phase A.3 follow-up):
     f("min_cluster_duration_sec", cfg.min_cluster_duration_sec);
+    b("diarize_overlap", cfg.diarize_overlap);
+    i("overlap_memory_mb", cfg.overlap_memory_mb);
+    i("diarize_parallel_chunks", cfg.diarize_parallel_chunks);
+    b("diarize_auto_chunk", cfg.diarize_auto_chunk);
+    b("live_diarize", cfg.live_diarize);
+    b("diarize_share_overlap", cfg.diarize_share_overlap);
+    b("diarize_speech_only", cfg.diarize_speech_only);
+    str("local_speaker", cfg.local_speaker);
+    str("diarize_provider", cfg.diarize_provider);
 
     b("speaker_id", cfg.speaker_id);
     f("speaker_threshold", cfg.speaker_threshold);
     path("speaker_db", cfg.speaker_db);
+    b("speaker_ann", cfg.speaker_ann);
+    b("speaker_participants_first", cfg.speaker_participants_first);
+    str("speaker_embedding_precision", cfg.speaker_embedding_precision);
 
     b("vad", cfg.vad);
     f("vad_threshold", cfg.vad_threshold);
     f("vad_min_silence", cfg.vad_min_silence);
     f("vad_min_speech", cfg.vad_min_speech);
     f("vad_max_speech", cfg.vad_max_speech);
+    b("vad_pack", cfg.vad_pack);
 
     b("captions_enabled", cfg.captions_enabled);
     str("caption_model", cfg.caption_model);
     b("caption_normalize_display", cfg.caption_normalize_display);
+    i("caption_partial_hz", cfg.caption_partial_hz);
+    b("caption_transcript", cfg.caption_transcript);
+    i("caption_threads", cfg.caption_threads);
+    b("caption_keep_warm", cfg.caption_keep_warm);
+    b("caption_mlock", cfg.caption_mlock);
+    b("caption_int8_fallback", cfg.caption_int8_fallback);
 
     i("threads", cfg.threads);
+    b("pin_threads", cfg.pin_threads);
+    b("model_hugepages", cfg.model_hugepages);
+    b("perf_counters", cfg.perf_counters);
+    b("backend_bench", cfg.backend_bench);
+    i("pp_worker_jobs", cfg.pp_worker_jobs);
+    i("pp_worker_rss_mb", cfg.pp_worker_rss_mb);
+    i("pp_max_jobs", cfg.pp_max_jobs);
+    b("pp_yield_to_recording", cfg.pp_yield_to_recording);
+    str("pp_on_battery", cfg.pp_on_battery);
+    str("pp_battery_model", cfg.pp_battery_model);
+    b("stage_cache", cfg.stage_cache);
+    str("remote_worker", cfg.remote_worker);
+    path("watch_dir", cfg.watch_dir);
+    i("watch_settle_sec", cfg.watch_settle_sec);
 
     str("log_level", cfg.log_level_str);
     path("log_dir", cfg.log_dir);
@@ -198,8 +304,10 @@ Config config_from_map(const JsonMap& m) {
     path("output_dir", cfg.output_dir);
     path("note_dir", cfg.note_dir);
     path("reprocess_dir", cfg.reprocess_dir);
+    b("recluster", cfg.recluster);
     path("reprocess_batch_dir", cfg.reprocess_batch_dir);
     b("reprocess_batch_dry_run", cfg.reprocess_batch_dry_run);
+    b("reprocess_batch_refresh", cfg.reprocess_batch_refresh);
     b("batch_mode", cfg.batch_mode);
 
     path("context_file", cfg.context_file);
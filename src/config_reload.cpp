@@ -0,0 +1,103 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "config_reload.h"
+#include "config_json.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <set>
+
+namespace recmeet {
+
+namespace {
+
+// The config_to_map keys each engine is loaded from.
+struct EngineKeys {
+    const char* engine;
+    bool worker;  // a warm worker's model kind (ModelSlot)
+    const char* keys[7];  // up to the first nullptr
+};
+
+const EngineKeys kEngines[] = {
+    {"captions", false, {"captions_enabled", "caption_model", "caption_threads",
+                         "caption_keep_warm", "caption_mlock", "caption_int8_fallback",
+                         "pin_threads"}},
+    {"clip", false, {"whisper_clip_model", "whisper_gpu"}},
+    {"whisper", true, {"whisper_model", "whisper_draft_model", "whisper_gpu",
+                       "whisper_gpu_devices", "whisper_workers", "pp_battery_model"}},
+    {"sherpa", true, {"threads", "diarize_parallel_chunks", "diarize_provider"}},
+    {"llama", true, {"llm_model", "llm_draft_model", "llm_mmap", "llm_gpu_layers"}},
+};
+
+constexpr const char* kEveryEngineKey = "model_hugepages";
+constexpr const char* kReleasePrefix = "release ";
+
+std::string join_commas(const std::vector<std::string>& items) {
+    std::string out;
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (i) out += ',';
+        out += items[i];
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+bool ConfigReloadPlan::invalidates(const std::string& engine) const {
+    return std::find(engines.begin(), engines.end(), engine) != engines.end();
+}
+
+std::vector<std::string> ConfigReloadPlan::worker_kinds() const {
+    std::vector<std::string> out;
+    for (const auto& e : kEngines)
+        if (e.worker && invalidates(e.engine)) out.push_back(e.engine);
+    return out;
+}
+
+ConfigReloadPlan plan_config_reload(const Config& before, const Config& after) {
+    const JsonMap a = config_to_map(before);
+    const JsonMap b = config_to_map(after);
+    ConfigReloadPlan plan;
+    std::set<std::string> changed;
+    for (const auto& [key, val] : a) {
+        auto it = b.find(key);
+        if (it == b.end() || it->second != val) changed.insert(key);
+    }
+    for (const auto& [key, val] : b)
+        if (!a.count(key)) changed.insert(key);
+    plan.changed.assign(changed.begin(), changed.end());
+
+    const bool all = changed.count(kEveryEngineKey) > 0;
+    for (const auto& e : kEngines) {
+        bool hit = all;
+        for (const char* key : e.keys) hit = hit || (key && changed.count(key) > 0);
+        if (hit) plan.engines.push_back(e.engine);
+    }
+    return plan;
+}
+
+void add_config_reload(JsonMap& m, const ConfigReloadPlan& plan) {
+    m["changed"] = join_commas(plan.changed);
+    m["invalidated"] = join_commas(plan.engines);
+}
+
+std::string pp_worker_release_line(const std::vector<std::string>& kinds) {
+    return kReleasePrefix + join_commas(kinds);
+}
+
+bool parse_pp_worker_release(const std::string& line, std::vector<std::string>& kinds) {
+    const std::string prefix = kReleasePrefix;
+    if (line.compare(0, prefix.size(), prefix) != 0) return false;
+    kinds.clear();
+    size_t start = prefix.size();
+    while (start <= line.size()) {
+        size_t end = line.find(',', start);
+        if (end == std::string::npos) end = line.size();
+        if (end > start) kinds.push_back(line.substr(start, end - start));
+        start = end + 1;
+    }
+    return true;
+}
+
+} // namespace recmeet
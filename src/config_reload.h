@@ -0,0 +1,61 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "config.h"
+#include "ipc_protocol.h"
+
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Config hot-reload (config.reload, config.update, SIGHUP)
+// ---------------------------------------------------------------------------
+//
+// The daemon keeps engines loaded between meetings: the caption
+// recognizer (captions.keep_warm), the transcribe.clip model while
+// recording, and each warm postprocessing worker's whisper, sherpa and
+// llama models (model_cache.h). A reload diffs the old config against the
+// new one and invalidates only the engines whose load parameters changed,
+// so changing note_dir or the log level reloads nothing:
+//
+//   captions  the caption model, its threads, keep_warm, mlock, the int8
+//             fallback, pinning
+//   clip      transcribe.clip's model and GPU use
+//   whisper   transcription and draft models, GPU use and devices, the
+//             battery model
+//   sherpa    diarization and embedding sessions: threads, parallel
+//             chunks, onnxruntime provider
+//   llama     the summary model and its draft, mmap, GPU layers
+//
+// model_hugepages changes how every model is mapped, so it invalidates all
+// of them. A warm worker drops an invalidated kind on a release line
+// (pp_worker_release_line()) read between jobs; its other models stay.
+
+/// What a config change invalidates.
+struct ConfigReloadPlan {
+    std::vector<std::string> changed;  ///< config_to_map keys, sorted
+    std::vector<std::string> engines;  ///< invalidated, in the order above
+
+    bool invalidates(const std::string& engine) const;
+    /// The worker model kinds among `engines` (whisper, sherpa, llama).
+    std::vector<std::string> worker_kinds() const;
+};
+
+ConfigReloadPlan plan_config_reload(const Config& before, const Config& after);
+
+/// The plan as a reload's response: `changed` and `invalidated`, each a
+/// comma-separated list (empty for none).
+void add_config_reload(JsonMap& m, const ConfigReloadPlan& plan);
+
+/// `release <kind>,<kind>...`: tells a warm worker to drop those models.
+/// Job lines are absolute paths, so the two cannot be confused.
+std::string pp_worker_release_line(const std::vector<std::string>& kinds);
+
+/// The kinds of a release line; false for any other line (a job path).
+bool parse_pp_worker_release(const std::string& line, std::vector<std::string>& kinds);
+
+} // namespace recmeet
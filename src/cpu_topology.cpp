@@ -0,0 +1,306 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "cpu_topology.h"
+#include "log.h"
+
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+namespace recmeet {
+
+namespace {
+
+std::string read_line(const fs::path& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+int read_int(const fs::path& path, int fallback) {
+    const std::string s = read_line(path);
+    char* end = nullptr;
+    const long v = std::strtol(s.c_str(), &end, 10);
+    return end == s.c_str() ? fallback : static_cast<int>(v);
+}
+
+std::vector<int> current_affinity() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    std::vector<int> out;
+    if (::sched_getaffinity(0, sizeof(set), &set) != 0) return out;
+    for (int i = 0; i < CPU_SETSIZE; ++i)
+        if (CPU_ISSET(i, &set)) out.push_back(i);
+    return out;
+}
+
+bool set_affinity(const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c : cpus)
+        if (c >= 0 && c < CPU_SETSIZE) CPU_SET(c, &set);
+    return ::sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+// set_mempolicy(2) without libnuma. Applies to the calling thread and the
+// threads it starts afterwards.
+bool set_preferred_node(int node) {
+    if (node < 0) return ::syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0) == 0;
+    constexpr int BITS = 8 * sizeof(unsigned long);
+    if (node >= 16 * BITS) return false;
+    unsigned long mask[16] = {};
+    mask[node / BITS] = 1UL << (node % BITS);
+    return ::syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask, 16 * BITS) == 0;
+}
+
+// The tightest cpu.max of this process's cgroup and its ancestors, as
+// read_memory_ceiling_bytes() walks memory.max.
+double read_cpu_quota() {
+    double quota = 0;
+    std::ifstream cg("/proc/self/cgroup");
+    std::string line;
+    while (std::getline(cg, line)) {
+        if (line.compare(0, 3, "0::") != 0) continue;
+        const std::string root = "/sys/fs/cgroup";
+        for (fs::path dir = fs::path(root + line.substr(3)).lexically_normal();
+             dir.string().size() > root.size() + 1; dir = dir.parent_path()) {
+            const double q = parse_cgroup_cpu_max(read_line(dir / "cpu.max"));
+            if (q > 0 && (quota == 0 || q < quota)) quota = q;
+        }
+        break;
+    }
+    return quota;
+}
+
+} // anonymous namespace
+
+bool CpuTopology::hybrid() const {
+    const auto eff = std::count_if(cpus.begin(), cpus.end(),
+                                   [](const CpuInfo& c) { return c.efficiency; });
+    return eff > 0 && static_cast<size_t>(eff) < cpus.size();
+}
+
+int CpuTopology::node_count() const {
+    std::set<int> nodes;
+    for (const auto& c : cpus) nodes.insert(c.node);
+    return static_cast<int>(nodes.size());
+}
+
+std::vector<int> parse_cpu_list(const std::string& text) {
+    std::vector<int> out;
+    std::stringstream ss(text);
+    std::string part;
+    while (std::getline(ss, part, ',')) {
+        int lo = 0, hi = 0;
+        char dash = 0;
+        std::istringstream ps(part);
+        if (!(ps >> lo) || lo < 0) continue;
+        hi = lo;
+        if (ps >> dash && (dash != '-' || !(ps >> hi) || hi < lo)) continue;
+        for (int i = lo; i <= hi; ++i) out.push_back(i);
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+double parse_cgroup_cpu_max(const std::string& text) {
+    std::istringstream in(text);
+    std::string quota;
+    long period = 0;
+    if (!(in >> quota) || quota == "max" || !(in >> period) || period <= 0) return 0;
+    char* end = nullptr;
+    const double q = std::strtod(quota.c_str(), &end);
+    if (end == quota.c_str() || q <= 0) return 0;
+    return q / static_cast<double>(period);
+}
+
+CpuTopology read_cpu_topology(const fs::path& sys_root, const std::vector<int>& allowed) {
+    const fs::path cpu_dir = sys_root / "devices/system/cpu";
+    std::vector<int> ids = parse_cpu_list(read_line(cpu_dir / "online"));
+    if (ids.empty()) {
+        const int n = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+        for (int i = 0; i < n; ++i) ids.push_back(i);
+    }
+    if (!allowed.empty()) {
+        std::vector<int> kept;
+        std::set_intersection(ids.begin(), ids.end(), allowed.begin(), allowed.end(),
+                              std::back_inserter(kept));
+        if (!kept.empty()) ids = std::move(kept);
+    }
+
+    std::map<int, int> node_of;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(sys_root / "devices/system/node", ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.compare(0, 4, "node") != 0 || name.size() == 4) continue;
+        const int node = std::atoi(name.c_str() + 4);
+        for (int c : parse_cpu_list(read_line(entry.path() / "cpulist"))) node_of[c] = node;
+    }
+
+    // Intel hybrid parts list their E-cores under cpu_atom; ARM reports a
+    // relative cpu_capacity instead.
+    const std::vector<int> atom = parse_cpu_list(read_line(sys_root / "devices/cpu_atom/cpus"));
+    std::map<int, int> capacity;
+    int max_capacity = 0;
+    for (int id : ids) {
+        const int cap = read_int(cpu_dir / ("cpu" + std::to_string(id)) / "cpu_capacity", 0);
+        capacity[id] = cap;
+        max_capacity = std::max(max_capacity, cap);
+    }
+
+    CpuTopology topo;
+    for (int id : ids) {
+        const fs::path t = cpu_dir / ("cpu" + std::to_string(id)) / "topology";
+        CpuInfo c;
+        c.id = id;
+        c.core = read_int(t / "core_id", id);
+        c.package = read_int(t / "physical_package_id", 0);
+        auto n = node_of.find(id);
+        c.node = n == node_of.end() ? 0 : n->second;
+        c.efficiency = std::binary_search(atom.begin(), atom.end(), id) ||
+                       (capacity[id] > 0 && capacity[id] < max_capacity);
+        topo.cpus.push_back(c);
+    }
+    return topo;
+}
+
+const CpuTopology& host_cpu_topology() {
+    static const CpuTopology topo = [] {
+        CpuTopology t = read_cpu_topology("/sys", current_affinity());
+        t.quota_cpus = read_cpu_quota();
+        log_debug("cpu_topology: %zu CPUs, %d node(s)%s, quota %.2f", t.cpus.size(),
+                  t.node_count(), t.hybrid() ? ", hybrid" : "", t.quota_cpus);
+        return t;
+    }();
+    return topo;
+}
+
+CpuPlacement plan_cpu_placement(const CpuTopology& topo, CpuClass cls) {
+    CpuPlacement plan;
+    auto cap = [&topo](int threads) {
+        if (topo.quota_cpus > 0)
+            threads = std::min(threads, static_cast<int>(std::floor(topo.quota_cpus)));
+        return std::max(threads, 1);
+    };
+    if (topo.cpus.empty()) return plan;
+
+    if (cls == CpuClass::Light) {
+        if (topo.hybrid())
+            for (const auto& c : topo.cpus)
+                if (c.efficiency) plan.cpus.push_back(c.id);
+        const size_t n = plan.cpus.empty() ? topo.cpus.size() : plan.cpus.size();
+        plan.threads = cap(static_cast<int>(std::min<size_t>(n, 2)));
+        return plan;
+    }
+
+    std::vector<CpuInfo> pool;
+    for (const auto& c : topo.cpus)
+        if (!c.efficiency || !topo.hybrid()) pool.push_back(c);
+
+    // Physical cores per node; the node with the most wins, the lowest on a tie.
+    std::map<int, std::set<std::pair<int, int>>> cores_by_node;
+    for (const auto& c : pool) cores_by_node[c.node].insert({c.package, c.core});
+    if (cores_by_node.size() > 1) {
+        size_t most = 0;
+        for (const auto& [node, cores] : cores_by_node)
+            if (cores.size() > most) { most = cores.size(); plan.node = node; }
+        pool.erase(std::remove_if(pool.begin(), pool.end(),
+                                  [&plan](const CpuInfo& c) { return c.node != plan.node; }),
+                   pool.end());
+    }
+
+    const size_t cores = cores_by_node[plan.node < 0 ? pool.front().node : plan.node].size();
+    int threads = static_cast<int>(cores);
+    if (pool.size() == topo.cpus.size()) {
+        // Nothing left over for the capture threads: no efficiency cores,
+        // no other node. Without SMT siblings to absorb them, keep a core.
+        if (cores == pool.size() && threads > 1) --threads;
+    } else {
+        for (const auto& c : pool) plan.cpus.push_back(c.id);
+    }
+    plan.threads = cap(threads);
+    return plan;
+}
+
+ScopedCpuPlacement::ScopedCpuPlacement(const CpuPlacement& plan) {
+    if (plan.cpus.empty()) return;
+    std::vector<int> saved = current_affinity();
+    if (saved.empty() || !set_affinity(plan.cpus)) {
+        log_debug("cpu_topology: could not pin to %zu CPUs", plan.cpus.size());
+        return;
+    }
+    saved_cpus_ = std::move(saved);
+    if (plan.node >= 0) {
+        set_node_ = set_preferred_node(plan.node);
+        if (!set_node_)
+            log_debug("cpu_topology: could not prefer memory node %d", plan.node);
+    }
+}
+
+ScopedCpuPlacement::~ScopedCpuPlacement() {
+    if (saved_cpus_.empty()) return;
+    if (set_node_) set_preferred_node(-1);
+    set_affinity(saved_cpus_);
+}
+
+bool pin_current_thread(const std::vector<int>& cpus) {
+    return cpus.empty() || set_affinity(cpus);
+}
+
+const char* pp_cpu_priority_name(PpCpuPriority p) {
+    return p == PpCpuPriority::Yield ? "yield" : "normal";
+}
+
+std::vector<pid_t> list_process_threads(pid_t pid, const fs::path& proc_root) {
+    std::vector<pid_t> out;
+    std::error_code ec;
+    for (fs::directory_iterator it(proc_root / std::to_string(pid) / "task", ec), end;
+         !ec && it != end; it.increment(ec)) {
+        const std::string name = it->path().filename().string();
+        char* stop = nullptr;
+        const long tid = std::strtol(name.c_str(), &stop, 10);
+        if (tid > 0 && stop != name.c_str() && *stop == '\0') out.push_back(static_cast<pid_t>(tid));
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+CpuPriorityChange set_process_cpu_priority(pid_t pid, PpCpuPriority p) {
+    CpuPriorityChange change;
+    const int policy = p == PpCpuPriority::Yield ? SCHED_IDLE : SCHED_OTHER;
+    sched_param param{};
+    for (pid_t tid : list_process_threads(pid)) {
+        // sched_setscheduler() on a tid changes that one thread.
+        if (::sched_getscheduler(tid) == policy || ::sched_setscheduler(tid, policy, &param) == 0)
+            ++change.threads;
+        else if (errno == EPERM)
+            ++change.refused;
+    }
+    return change;
+}
+
+bool can_restore_cpu_priority() {
+    if (::geteuid() == 0) return true;
+    rlimit rl{};
+    return ::getrlimit(RLIMIT_NICE, &rl) == 0 &&
+           (rl.rlim_cur == RLIM_INFINITY || rl.rlim_cur >= 20);
+}
+
+} // namespace recmeet
@@ -0,0 +1,149 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+
+#include <sys/types.h>
+
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// CPU topology and thread placement
+// ---------------------------------------------------------------------------
+//
+// read_cpu_topology() lists the CPUs this process may run on, from sysfs:
+// each one's physical core, package and NUMA node, and whether it is an
+// efficiency core (Intel hybrid `cpu_atom`, or an ARM `cpu_capacity` below
+// the largest). plan_cpu_placement() turns that into a thread count and a
+// CPU set for a class of work:
+//
+//   Inference (whisper, llama, offline sherpa): the performance cores, one
+//     thread per physical core, on the NUMA node that has the most of them.
+//   Light (VAD, live captions): the efficiency cores of a hybrid CPU.
+//
+// ScopedCpuPlacement pins the calling thread to a plan and prefers its
+// node's memory. Threads started meanwhile inherit both, which is how the
+// engines' own thread pools land there. Placement is advisory: on a
+// uniform single-node host every plan leaves the affinity alone.
+
+struct CpuInfo {
+    int id = 0;
+    int core = 0;              ///< topology/core_id, unique within the package
+    int package = 0;           ///< topology/physical_package_id
+    int node = 0;              ///< NUMA node; 0 without NUMA
+    bool efficiency = false;   ///< E-core / LITTLE core
+};
+
+struct CpuTopology {
+    std::vector<CpuInfo> cpus;  ///< online and allowed, ascending id
+    double quota_cpus = 0;      ///< cgroup cpu.max quota / period; 0 = unlimited
+
+    /// Some, but not all, of the CPUs are efficiency cores.
+    bool hybrid() const;
+    int node_count() const;
+};
+
+/// Parse a kernel CPU list ("0-3,8,10-11"). Malformed parts are skipped.
+std::vector<int> parse_cpu_list(const std::string& text);
+
+/// Parse the body of a cgroup v2 `cpu.max` file ("400000 100000"): the
+/// quota in CPUs, or 0 for "max" (no limit) and malformed input.
+double parse_cgroup_cpu_max(const std::string& text);
+
+/// Read the topology under `sys_root` (normally "/sys"), keeping the CPUs
+/// in `allowed` (empty = every online CPU). The quota is left at 0. Falls
+/// back to hardware_concurrency() CPUs, one core each, without sysfs.
+CpuTopology read_cpu_topology(const fs::path& sys_root, const std::vector<int>& allowed = {});
+
+/// This process's topology: /sys, its sched_getaffinity() mask and the
+/// tightest cpu.max of its cgroup and ancestors. Read on first use and
+/// cached, so call it before pinning anything.
+const CpuTopology& host_cpu_topology();
+
+enum class CpuClass { Inference, Light };
+
+struct CpuPlacement {
+    int threads = 1;
+    std::vector<int> cpus;  ///< empty = leave the affinity alone
+    int node = -1;          ///< memory node to prefer; -1 = none
+};
+
+/// Threads and CPUs for `cls` on `topo`, capped by its quota. Inference
+/// leaves one core free when nothing else would be left for the capture
+/// threads (no efficiency cores, SMT siblings or other nodes).
+CpuPlacement plan_cpu_placement(const CpuTopology& topo, CpuClass cls);
+
+/// Pin the calling thread to `plan.cpus` and prefer `plan.node`'s memory
+/// until destroyed, when the previous affinity and the default memory
+/// policy are restored. A plan without CPUs does nothing; failures are
+/// logged at debug level and ignored.
+class ScopedCpuPlacement {
+public:
+    explicit ScopedCpuPlacement(const CpuPlacement& plan);
+    ~ScopedCpuPlacement();
+
+    ScopedCpuPlacement(const ScopedCpuPlacement&) = delete;
+    ScopedCpuPlacement& operator=(const ScopedCpuPlacement&) = delete;
+
+private:
+    std::vector<int> saved_cpus_;  ///< empty = nothing was changed
+    bool set_node_ = false;
+};
+
+/// Pin the calling thread to `cpus` for the rest of its life (a worker
+/// thread's own placement). Empty does nothing. False on failure.
+bool pin_current_thread(const std::vector<int>& cpus);
+
+// ---------------------------------------------------------------------------
+// Postprocessing CPU priority
+// ---------------------------------------------------------------------------
+//
+// A postprocessing child that runs while the next meeting records keeps
+// every core busy with whisper, ONNX and llama threads, and the caption
+// engine's worker (SCHED_BATCH) and the capture threads then wait for a
+// CPU. While a recording is active the daemon moves each of the child's
+// threads to SCHED_IDLE, which runs only on a CPU nothing else wants, and
+// back to SCHED_OTHER once the recording ends. Threads the child starts
+// meanwhile inherit the policy of the thread that starts them, and the
+// daemon re-applies it periodically for the ones that raced a change.
+//
+// Lowering is always allowed for a process of the same user. Returning
+// from SCHED_IDLE needs RLIMIT_NICE of 20 or more (systemd LimitNICE=+0,
+// which the shipped unit sets) or CAP_SYS_NICE; without it a yielded
+// worker keeps SCHED_IDLE until it is replaced, which still lets it use
+// every idle CPU.
+
+enum class PpCpuPriority { Normal, Yield };
+
+/// "normal" or "yield".
+const char* pp_cpu_priority_name(PpCpuPriority p);
+
+/// The priority a postprocessing child runs at: Yield while a recording
+/// is active, when `yield_to_recording` is on.
+inline PpCpuPriority pp_cpu_priority(bool yield_to_recording, bool recording) {
+    return yield_to_recording && recording ? PpCpuPriority::Yield : PpCpuPriority::Normal;
+}
+
+/// Thread ids of process `pid`, from `proc_root`/<pid>/task (normally
+/// "/proc"), ascending. Empty when the process is gone.
+std::vector<pid_t> list_process_threads(pid_t pid, const fs::path& proc_root = "/proc");
+
+struct CpuPriorityChange {
+    int threads = 0;  ///< threads now at the requested priority
+    int refused = 0;  ///< threads the kernel would not move (EPERM)
+};
+
+/// Move every thread of `pid` to SCHED_IDLE (Yield) or SCHED_OTHER
+/// (Normal). Threads that exit meanwhile are skipped.
+CpuPriorityChange set_process_cpu_priority(pid_t pid, PpCpuPriority p);
+
+/// True when this process may return a SCHED_IDLE thread to SCHED_OTHER
+/// (RLIMIT_NICE of 20 or more, or running as root).
+bool can_restore_cpu_priority();
+
+} // namespace recmeet
@@ -1,36 +1,60 @@
 // Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
 // SPDX-License-Identifier: MIT OR Apache-2.0
 
+#include "backend_bench.h"
 #include "backend_info.h"
 #include "caption_start_channel.h"
+#include "artifact_transfer.h"
+#include "audio_view.h"
+#include "clip_transcribe.h"
 #include "config.h"
 #include "config_json.h"
+#include "config_reload.h"
+#include "cpu_topology.h"
 #include "device_enum.h"
 #include "ipc_protocol.h"
 #include "ipc_server.h"
+#include "json_util.h"
+#include "level_feed.h"
 #include "ndjson_parse.h"
 #include "speaker_id.h"
+#include "stage_cache.h"
+#include "stage_perf.h"
 #include "summarize.h"
+#include "thread_budget.h"
 #include "log.h"
+#include "trace.h"
+#include "metrics.h"
 #include "model_manager.h"
+#include "model_memory.h"
+#include "model_prefetch.h"
 #include "notify.h"
 #include "pipeline.h"
+#include "power_policy.h"
+#include "remote_worker.h"
 #include "util.h"
 #include "version.h"
+#include "watch_folder.h"
 
 #include <whisper.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <climits>
+#include <cmath>
 #include <condition_variable>
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
+#include <fcntl.h>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <deque>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <poll.h>
 #include <sys/file.h>
@@ -53,9 +77,9 @@ static std::mutex g_state_mu;  // guards multi-flag transitions
 static Config g_config;
 static std::mutex g_config_mu;
 
-// Stop tokens — separate for independent cancellation
+// Stop tokens — separate for independent cancellation (each postprocessing
+// slot has its own, see PpSlot)
 static StopToken g_rec_stop;
-static StopToken g_pp_stop;
 // Operator-issued cancel signal (record.cancel verb). Observed inside
 // run_recording's loop; on signalling the cancel branch discards the
 // freshly-minted output directory and returns PostprocessInput{cancelled=true}.
@@ -63,8 +87,23 @@ static StopToken g_rec_cancel;
 
 // Worker threads
 static std::thread g_rec_worker;
-static std::thread g_pp_worker;   // long-lived, drains job queue
+static std::vector<std::thread> g_pp_workers;  // long-lived, one per PpSlot
 static std::thread g_dl_worker;
+// Reads the next job's models into the page cache while recording.
+static std::thread g_prefetch_worker;
+static std::atomic<bool> g_prefetch_stop{false};
+static std::atomic<bool> g_prefetch_running{false};
+// Loads the caption recognizer at startup (captions.keep_warm).
+static std::thread g_caption_warm_worker;
+// transcribe.clip: the model stays warm while recording, one clip decodes
+// at a time.
+static ClipTranscriber g_clip;
+static std::thread g_clip_warm_worker;
+static std::thread g_clip_worker;
+static std::atomic<bool> g_clip_busy{false};
+static std::atomic<int64_t> g_next_clip_id{1};
+// Times new models on the GPU and the CPU at startup (general.backend_bench).
+static std::thread g_backend_bench_worker;
 
 // Postprocessing job queue
 static std::atomic<int64_t> g_next_job_id{1};
@@ -73,12 +112,22 @@ struct PostprocessJob {
     int64_t job_id;
     PostprocessInput input;
     Config cfg;
+    PpFootprint footprint;  // estimate_pp_footprint() at enqueue
+    PpJobClass job_class = PpJobClass::Interactive;
+    int attempt = 1;        // > 1: resumed after an interrupted run
+    bool deferred = false;  // its child deferred once (PP_EXIT_DEFERRED)
+    // expected_meeting_manifest() of a reprocess, to tell whether a later
+    // request for the meeting asks for the same run (pp_coalesce).
+    MeetingManifest inputs;
 };
 
 static std::mutex g_queue_mu;
-static std::queue<PostprocessJob> g_job_queue;
-static std::condition_variable g_queue_cv;
+static std::deque<PostprocessJob> g_job_queue;  // by class, then FIFO (enqueue_pp_job)
+static std::condition_variable g_queue_cv;  // queue, slot or shutdown changed
 static bool g_queue_shutdown{false};
+// Set as the daemon starts stopping, before its jobs are cancelled: they
+// stay journaled (restore_pp_journal) rather than ending for good.
+static std::atomic<bool> g_pp_draining{false};
 
 // Whether the current recording is a reprocess (poll-thread-only variable,
 // set via server.post() from the recording worker)
@@ -90,12 +139,105 @@ static std::string g_pending_context;
 static std::string g_pending_vocab;
 
 // Subprocess postprocessing state
-static std::atomic<pid_t> g_pp_child_pid{-1};
 static std::string g_self_exe;  // resolved at startup
 
+// --trace-out: the daemon's own trace, and a numbered sibling per
+// postprocessing child (`daemon.json` -> `daemon.pp1.json`, ...).
+static fs::path g_trace_out;
+static std::atomic<int> g_trace_children{0};
+
+struct PpChild {
+    pid_t pid = -1;
+    int stdin_fd = -1;   // job paths; -1 for a one-shot subprocess
+    int stdout_fd = -1;
+    int stderr_fd = -1;
+    int jobs = 0;        // jobs completed (warm worker)
+    PpCpuPriority priority = PpCpuPriority::Normal;  // last applied to its threads
+};
+
+// One concurrent postprocessing job (see pp_slot_loop). The running job's
+// pid, stop token and paused flag are shared with the cancel and shutdown
+// paths; `busy`, `warm`, `footprint` and `job_class` are guarded by
+// g_queue_mu for admission, and `paused` changes only under it.
+struct PpSlot {
+    int index = 0;
+    PpChild proc;                      // owned by the slot's thread
+    StopToken stop;
+    std::atomic<pid_t> child_pid{-1};
+    std::atomic<int64_t> job_id{0};    // 0 = idle
+    std::atomic<bool> paused{false};   // child SIGSTOPped for an interactive job
+    bool busy = false;
+    bool warm = false;                 // idle with a warm worker
+    PpFootprint footprint;             // running job's, last job's while warm
+    PpJobClass job_class = PpJobClass::Interactive;
+    fs::path out_dir;                  // running job's meeting and inputs
+    MeetingManifest inputs;
+    // Model kinds a config reload invalidated, for the worker to drop
+    // before its next job (config_reload.h).
+    std::vector<std::string> stale_models;
+};
+
+// postprocess.max_jobs running slots plus one that only an interactive job
+// pausing a batch one fills. Fixed at startup, before the signal handlers
+// are installed.
+static std::vector<std::unique_ptr<PpSlot>> g_pp_slots;
+static int g_pp_max_jobs = 1;
+// What admission measures jobs against: the unit's MemoryHigh when set,
+// else read_memory_ceiling_bytes() (0 = unknown), and the host's cores.
+static uint64_t g_pp_budget_bytes = 0;
+static int g_pp_cores = 1;
+
+// Cancel running postprocessing jobs: `job_id`'s, or all for 0. Requests
+// each slot's stop and, with `signal_child`, SIGTERMs its process (and
+// continues a paused one so the signal lands). Only atomics and kill(), so
+// the signal handler may call it. Returns the number of jobs signalled.
+static int cancel_running_pp_jobs(int64_t job_id, bool signal_child) {
+    int n = 0;
+    for (auto& slot : g_pp_slots) {
+        const int64_t running = slot->job_id.load();
+        if (running == 0 || (job_id != 0 && running != job_id)) continue;
+        slot->stop.request();
+        if (signal_child) {
+            pid_t child = slot->child_pid.load();
+            if (child > 0) kill(child, SIGTERM);
+            if (child > 0 && slot->paused.load()) kill(child, SIGCONT);
+        }
+        ++n;
+    }
+    return n;
+}
+
 // Global server pointer for signal handler
 static IpcServer* g_server = nullptr;
 
+// Live audio levels for local clients (`levels.info`); null when the
+// segment could not be created.
+static std::unique_ptr<LevelFeed> g_levels;
+
+// The cached device list (`sources.list`, record.start's detection) and
+// its hotplug feed (`sources.changed`); null when it could not start.
+static std::unique_ptr<SourceRegistry> g_sources;
+
+// The postprocess.watch_dir inbox (watch_folder.h); null when unset.
+// Replaced by start_watch_folder() on a reload that changes it.
+static std::unique_ptr<WatchFolder> g_watch;
+static void start_watch_folder(IpcServer& server, const Config& cfg);  // below
+
+// `sources` as sources.list and sources.changed carry it: a JSON array
+// string and its length.
+static void fill_sources(JsonMap& out, const std::vector<AudioSource>& sources) {
+    std::string arr = "[";
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (i > 0) arr += ",";
+        arr += "{\"name\":\"" + json_escape(sources[i].name)
+            + "\",\"description\":\"" + json_escape(sources[i].description)
+            + "\",\"is_monitor\":" + (sources[i].is_monitor ? "true" : "false") + "}";
+    }
+    arr += "]";
+    out["sources"] = arr;
+    out["count"] = static_cast<int64_t>(sources.size());
+}
+
 // ---------------------------------------------------------------------------
 // State helpers
 // ---------------------------------------------------------------------------
@@ -147,6 +289,108 @@ static void broadcast_state_inline(IpcServer& server, const std::string& error =
     server.broadcast(ev);
 }
 
+// A job that ended without a note, cancelled included: the counterpart of
+// job.complete for clients following one job (reprocess-batch cluster mode).
+static void broadcast_job_failed(IpcServer& server, int64_t job_id, const std::string& error) {
+    server.post([&server, job_id, error]() {
+        IpcEvent ev;
+        ev.event = "job.failed";
+        ev.data["job_id"] = job_id;
+        ev.data["error"] = error;
+        server.broadcast(ev);
+    });
+}
+
+// ---------------------------------------------------------------------------
+// Config reload
+// ---------------------------------------------------------------------------
+
+// With captions on, load their recognizer in the background so the next
+// recording's captions start without the model load.
+static void prewarm_captions(const Config& cfg) {
+    if (!cfg.captions_enabled || !cfg.caption_keep_warm || !is_caption_model_cached(cfg.caption_model))
+        return;
+    if (g_caption_warm_worker.joinable()) g_caption_warm_worker.join();
+    g_caption_warm_worker = std::thread([opts = caption_engine_options(cfg)]() {
+        std::string error;
+        if (CaptionEngine::prewarm(opts, &error))
+            log_info("daemon: caption model loaded and kept warm");
+        else
+            log_warn("daemon: cannot prewarm the caption model: %s", error.c_str());
+    });
+}
+
+// The config file as the daemon runs it: with the provider's API key
+// resolved when no local model is set. Throws like load_config().
+static Config load_daemon_config() {
+    Config cfg = load_config();
+    if (cfg.llm_model.empty()) {
+        const auto* prov = find_provider(cfg.provider);
+        if (prov) {
+            std::string key = resolve_api_key(*prov, cfg.api_keys, cfg.api_key);
+            if (!key.empty()) cfg.api_key = key;
+        }
+    }
+    return cfg;
+}
+
+// Make `cfg` the running config (poll thread). Only the resident engines
+// whose load parameters changed are dropped (config_reload.h): the warm
+// caption recognizer is rebuilt for the new settings, a clip model warm
+// for a recording is replaced, and each warm worker drops the invalidated
+// model kinds before its next job. Everything else stays loaded.
+static ConfigReloadPlan apply_config(IpcServer& server, const Config& cfg, const char* how) {
+    ConfigReloadPlan plan;
+    {
+        std::lock_guard<std::mutex> lock(g_config_mu);
+        plan = plan_config_reload(g_config, cfg);
+        g_config = cfg;
+    }
+    server.set_partial_rate(cfg.caption_partial_hz);
+
+    // A recording's engine holds its recognizer; the next start() after
+    // it builds one for the new settings.
+    if (plan.invalidates("captions") && !g_recording.load()) {
+        CaptionEngine::drop_warm();
+        prewarm_captions(cfg);
+    }
+    // transcribe.clip reads g_config, so the new model is the one to warm.
+    if (plan.invalidates("clip") && g_recording.load()) {
+        g_clip.release();
+        if (!cfg.clip_model.empty()) {
+            if (g_clip_warm_worker.joinable()) g_clip_warm_worker.join();
+            g_clip_warm_worker = std::thread([model = cfg.clip_model, gpu = cfg.whisper_gpu]() {
+                g_clip.warm(model, gpu);
+            });
+        }
+    }
+    if (std::any_of(plan.changed.begin(), plan.changed.end(), [](const std::string& key) {
+            return key == "watch_dir" || key == "watch_settle_sec";
+        }))
+        start_watch_folder(server, cfg);
+    const std::vector<std::string> kinds = plan.worker_kinds();
+    if (!kinds.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(g_queue_mu);
+            for (auto& slot : g_pp_slots) {
+                if (!slot->warm && !slot->busy) continue;
+                for (const auto& kind : kinds)
+                    if (std::find(slot->stale_models.begin(), slot->stale_models.end(), kind) ==
+                        slot->stale_models.end())
+                        slot->stale_models.push_back(kind);
+            }
+        }
+        g_queue_cv.notify_all();
+    }
+
+    JsonMap report;
+    add_config_reload(report, plan);
+    log_info("daemon: config reloaded via %s (%zu key(s) changed; invalidated: %s)", how,
+             plan.changed.size(),
+             plan.engines.empty() ? "none" : json_val_as_string(report["invalidated"]).c_str());
+    return plan;
+}
+
 // ---------------------------------------------------------------------------
 // Signal handling
 // ---------------------------------------------------------------------------
@@ -157,17 +401,7 @@ static void signal_handler(int sig) {
         if (g_server) {
             g_server->post([] {
                 try {
-                    Config cfg = load_config();
-                    if (cfg.llm_model.empty()) {
-                        const auto* prov = find_provider(cfg.provider);
-                        if (prov) {
-                            std::string key = resolve_api_key(*prov, cfg.api_keys, cfg.api_key);
-                            if (!key.empty()) cfg.api_key = key;
-                        }
-                    }
-                    std::lock_guard<std::mutex> lock(g_config_mu);
-                    g_config = cfg;
-                    log_info("daemon: config reloaded via SIGHUP");
+                    apply_config(*g_server, load_daemon_config(), "SIGHUP");
                 } catch (const std::exception& e) {
                     log_error("daemon: config reload failed: %s", e.what());
                 }
@@ -177,24 +411,49 @@ static void signal_handler(int sig) {
     }
     // SIGINT/SIGTERM → stop all workers, then exit
     g_rec_stop.request();
-    g_pp_stop.request();
+    g_pp_draining.store(true);
+    cancel_running_pp_jobs(0, false);
     if (g_server) g_server->stop();
 }
 
 // Suppress whisper log output in daemon mode
 static void whisper_null_log(enum ggml_log_level, const char*, void*) {}
 
+// model.downloading {file, status: "progress", bytes, total, percent?} for
+// the file a download worker is fetching (fetch_model_file).
+static ModelDownloadProgress download_progress_broadcaster(IpcServer& server) {
+    return [&server](const std::string& file, uint64_t done, uint64_t total) {
+        server.post([&server, file, done, total]() {
+            IpcEvent ev;
+            ev.event = "model.downloading";
+            ev.data["file"] = file;
+            ev.data["status"] = std::string("progress");
+            ev.data["bytes"] = static_cast<int64_t>(done);
+            ev.data["total"] = static_cast<int64_t>(total);
+            if (total > 0) ev.data["percent"] = static_cast<int64_t>(done * 100 / total);
+            server.broadcast(ev);
+        });
+    };
+}
+
 // ---------------------------------------------------------------------------
 // Helper: ensure models are ready (non-interactive)
 // ---------------------------------------------------------------------------
 
 static bool ensure_models(Config& cfg) {
-    try {
-        ensure_whisper_model(cfg.whisper_model);
-    } catch (const RecmeetError& e) {
-        log_error("daemon: whisper model: %s", e.what());
-        return false;
-    }
+    // First-run downloads run side by side; see fetch_models_parallel().
+    std::vector<ModelFetch> fetches;
+    fetches.push_back({"whisper", [&cfg] { ensure_whisper_model(cfg.whisper_model); }});
+#if RECMEET_USE_SHERPA
+    if (cfg.diarize && !is_sherpa_model_cached())
+        fetches.push_back({"sherpa", [] { ensure_sherpa_models(); }});
+    if (cfg.vad && !is_vad_model_cached())
+        fetches.push_back({"VAD", [] { ensure_vad_model(); }});
+#endif
+    const auto failed = fetch_models_parallel(fetches);
+    for (const auto& [label, error] : failed)
+        log_error("daemon: %s model: %s", label.c_str(), error.c_str());
+    if (failed.count("whisper")) return false;
 
     if (!cfg.no_summary && !cfg.llm_model.empty()) {
         try {
@@ -206,22 +465,8 @@ static bool ensure_models(Config& cfg) {
     }
 
 #if RECMEET_USE_SHERPA
-    if (cfg.diarize && !is_sherpa_model_cached()) {
-        try {
-            ensure_sherpa_models();
-        } catch (const RecmeetError& e) {
-            log_error("daemon: sherpa models: %s", e.what());
-            cfg.diarize = false;
-        }
-    }
-    if (cfg.vad && !is_vad_model_cached()) {
-        try {
-            ensure_vad_model();
-        } catch (const RecmeetError& e) {
-            log_error("daemon: VAD model: %s", e.what());
-            cfg.vad = false;
-        }
-    }
+    if (failed.count("sherpa")) cfg.diarize = false;
+    if (failed.count("VAD")) cfg.vad = false;
 #else
     cfg.diarize = false;
     cfg.vad = false;
@@ -241,6 +486,168 @@ static fs::path write_job_config(const PostprocessJob& job) {
     return path;
 }
 
+// ---------------------------------------------------------------------------
+// Interrupted jobs
+// ---------------------------------------------------------------------------
+//
+// run_postprocessing() checkpoints every stage (stage_cache.h), so a job
+// whose child was killed mid-way — the RSS self-limit, the cgroup's
+// MemoryMax, a crash, the stall watchdog — loses only the stage it was in.
+// Such a job is queued again, up to PP_MAX_ATTEMPTS runs, and resumes from
+// the last completed stage. A user cancel is final. A child that defers its
+// summary to a fresh process (PP_EXIT_DEFERRED, memory_governor.h) is
+// rerun the same way, once per job, without spending an attempt; its
+// worker retires on the nonzero exit, so the rerun gets a new process.
+//
+// Every queued or running job is also journaled as its config, reprocess_dir
+// set, in data_dir()/pp-pending/. A job leaves the journal when it ends for
+// good; whatever the daemon was stopped or killed with is queued again at
+// the next start (restore_pp_journal).
+
+constexpr int PP_MAX_ATTEMPTS = 2;
+
+// Whether a job that did not succeed was interrupted rather than failed.
+static bool pp_job_interrupted(int status, const std::string& last_stderr_line) {
+    if (WIFSIGNALED(status)) return true;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 1 &&
+           last_stderr_line.find("RSS limit exceeded") != std::string::npos;
+}
+
+static fs::path pp_journal_dir() { return data_dir() / "pp-pending"; }
+
+static fs::path pp_journal_path(const fs::path& out_dir) {
+    return pp_journal_dir() / (hash_text(out_dir.string()) + ".json");
+}
+
+static void journal_pp_job(const PostprocessJob& job) {
+    Config cfg = job.cfg;
+    cfg.reprocess_dir = job.input.out_dir;
+    try {
+        fs::create_directories(pp_journal_dir());
+        write_text_file_atomic(pp_journal_path(job.input.out_dir), config_to_json(cfg));
+    } catch (const std::exception& e) {
+        log_warn("daemon: could not journal job=%ld: %s", (long)job.job_id, e.what());
+    }
+}
+
+static void unjournal_pp_job(const PostprocessJob& job) {
+    std::error_code ec;
+    fs::remove(pp_journal_path(job.input.out_dir), ec);
+}
+
+// ---------------------------------------------------------------------------
+// Remote worker (remote_worker.h)
+// ---------------------------------------------------------------------------
+//
+// With --worker the daemon also runs jobs other daemons send it. Each is an
+// ordinary queued job over its copy in remote_jobs_dir(), tracked here by
+// the sender's id until worker.release. They are not journaled: after a
+// restart the sender sees "unknown" and runs the job itself.
+
+struct WorkerJob {
+    int64_t job_id = 0;
+    std::string state = "queued";  // RemoteJobStatus::state
+    std::string error;
+};
+
+static std::mutex g_worker_jobs_mu;
+static std::map<std::string, WorkerJob> g_worker_jobs;  // by remote job id
+
+// Record where local job `job_id` stands, if it is a worker job.
+static void set_worker_job_state(int64_t job_id, const char* state,
+                                 const std::string& error = {}) {
+    std::lock_guard<std::mutex> lock(g_worker_jobs_mu);
+    for (auto& [id, wj] : g_worker_jobs) {
+        if (wj.job_id != job_id) continue;
+        wj.state = state;
+        wj.error = error;
+        return;
+    }
+}
+
+static void count_remote_offload(const char* outcome) {
+    metrics().counter("recmeet_pp_remote_jobs",
+                      "Postprocessing jobs offered to postprocess.remote_worker, by outcome.",
+                      metric_label("outcome", outcome)).add();
+}
+
+// ---------------------------------------------------------------------------
+// Stage telemetry (stage_perf.h)
+// ---------------------------------------------------------------------------
+
+static std::mutex g_perf_history_mu;  // slots finish concurrently
+
+// Process metrics (metrics.h) kept for `metrics.get`. Each is updated once
+// per job, so the registry lookup is not worth caching.
+static void count_pp_outcome(const char* outcome) {
+    metrics().counter("recmeet_pp_jobs", "Postprocessing jobs ended, by outcome.",
+                      metric_label("outcome", outcome)).add();
+}
+
+static void observe_child_peak_rss(long peak_rss_kb) {
+    static const std::vector<double> bounds = {
+        256.0 * (1 << 20), 512.0 * (1 << 20), 1024.0 * (1 << 20), 2048.0 * (1 << 20),
+        4096.0 * (1 << 20), 6144.0 * (1 << 20), 8192.0 * (1 << 20), 12288.0 * (1 << 20),
+        16384.0 * (1 << 20)};
+    if (peak_rss_kb <= 0) return;
+    metrics().histogram("recmeet_pp_child_peak_rss_bytes",
+                        "Peak RSS of the postprocessing child, per job.", bounds)
+        .observe(static_cast<double>(peak_rss_kb) * 1024);
+}
+
+// File a finished job's stage.perf records as perf_<ts>.json beside its
+// audio and a line of the rolling history. Failures are logged only.
+static void file_job_perf(const PostprocessJob& job, const std::vector<StagePerf>& stages,
+                          double wall_sec, long peak_rss_kb) {
+    if (stages.empty()) return;
+    for (const auto& s : stages)
+        if (!s.cached)
+            metrics().histogram("recmeet_pp_stage_duration_seconds",
+                                "Wall time of each postprocessing stage computed.",
+                                metric_duration_buckets(), metric_label("stage", s.stage))
+                .observe(s.wall_sec);
+    PerfRun run;
+    run.version = RECMEET_VERSION;
+    run.host = host_name();
+    run.meeting = job.input.out_dir.filename().string();
+    run.finished_unix = static_cast<int64_t>(std::time(nullptr));
+    run.whisper_model = job.cfg.whisper_model;
+    if (!job.cfg.no_summary) run.llm_model = job.cfg.llm_model;
+    run.attempt = job.attempt;
+    run.wall_sec = wall_sec;
+    run.peak_rss_kb = peak_rss_kb;
+
+    const fs::path audio = job.input.audio_path.empty()
+        ? find_audio_file(job.input.out_dir) : job.input.audio_path;
+    try {
+        if (!audio.empty()) save_meeting_perf(perf_path(audio), run, stages);
+        std::lock_guard lk(g_perf_history_mu);
+        append_perf_history(perf_history_path(), run, stages);
+    } catch (const RecmeetError& e) {
+        log_warn("daemon: could not save stage telemetry for job=%ld: %s",
+                 (long)job.job_id, e.what());
+    }
+    for (const auto& s : stages) {
+        if (s.index >= 0) continue;
+        if (s.stage.compare(0, 8, "threads.") == 0)
+            log_info("daemon: job=%ld %s: %d lease(s), %d thread(s) for %.1fs, %.0f%% busy",
+                     (long)job.job_id, s.stage.c_str(), s.calls, s.threads, s.wall_sec,
+                     s.utilization() * 100);
+        else if (s.calls > 0)
+            log_info("daemon: job=%ld %s: %d call(s), %.1fs wall,%s", (long)job.job_id,
+                     s.stage.c_str(), s.calls, s.wall_sec, perf_counters_summary(s).c_str());
+        else if (s.stage.compare(0, 8, "release.") == 0)
+            log_info("daemon: job=%ld %s: RSS %ld -> %ld MB in %.0f ms", (long)job.job_id,
+                     s.stage.c_str(), s.peak_rss_kb / 1024,
+                     (s.peak_rss_kb - s.released_kb) / 1024, s.wall_sec * 1000);
+        else
+            log_info("daemon: job=%ld %s: %.1fs wall, %.2f RTF, %.0f%% of %d thread(s), "
+                     "peak %ld MB%s%s", (long)job.job_id, s.stage.c_str(), s.wall_sec, s.rtf(),
+                     s.utilization() * 100, s.threads, s.peak_rss_kb / 1024,
+                     perf_counters_summary(s).c_str(), s.cached ? " (cached)" : "");
+    }
+}
+
 // ---------------------------------------------------------------------------
 // T1C.2 helpers — cgroup-aware kill grace machine
 // ---------------------------------------------------------------------------
@@ -296,15 +703,18 @@ static bool poll_child_alive(pid_t pid) {
     return false;                      // ECHILD or error → treat as dead
 }
 
-// Helpers for the deferred-restore guard on the MemoryHigh bump.
-// pp_worker_loop is currently single-threaded sequential, so checking
-// queue + child running covers all in-flight postprocess work.
+// Helpers for the deferred-restore guard on the MemoryHigh bump: queued
+// jobs and every other slot's running child count as in-flight work.
 static bool pp_queue_empty() {
     std::lock_guard<std::mutex> lk(g_queue_mu);
     return g_job_queue.empty();
 }
-static bool pp_child_running() {
-    return g_pp_child_pid.load() > 0;
+static bool pp_other_child_running(pid_t pid) {
+    for (auto& slot : g_pp_slots) {
+        pid_t child = slot->child_pid.load();
+        if (child > 0 && child != pid) return true;
+    }
+    return false;
 }
 
 // Kill the postprocess child with the cgroup-aware grace ladder.
@@ -349,7 +759,7 @@ static void kill_pp_child_with_grace(pid_t pid) {
     // job would suddenly hit reclaim throttling. If we can't safely restore
     // now, leave it at infinity; the cgroup MemoryMax (hard cap) still
     // bounds the unit.
-    if (original_high > 0 && pp_queue_empty() && !pp_child_running()) {
+    if (original_high > 0 && pp_queue_empty() && !pp_other_child_running(pid)) {
         if (original_high == LONG_MAX) {
             rc = set_systemd_memory_property("MemoryHigh", "infinity");
         } else {
@@ -360,7 +770,7 @@ static void kill_pp_child_with_grace(pid_t pid) {
         if (rc != 0) log_warn("daemon: restore MemoryHigh rc=%d", rc);
     } else {
         log_info("daemon: deferring MemoryHigh restore (queue_nonempty=%d, child_running=%d)",
-                 (int)!pp_queue_empty(), (int)pp_child_running());
+                 (int)!pp_queue_empty(), (int)pp_other_child_running(pid));
     }
 
     if (!reaped) {
@@ -373,31 +783,529 @@ static void kill_pp_child_with_grace(pid_t pid) {
 }
 
 // ---------------------------------------------------------------------------
-// Postprocessing worker loop (long-lived thread, fork/exec subprocess)
+// Postprocessing subprocess (warm `--pp-worker` or one-shot `--reprocess`)
+// ---------------------------------------------------------------------------
+//
+// By default jobs go to a warm worker: one `recmeet --pp-worker` process
+// that reads a pp-*.json path per stdin line, keeps its models loaded
+// between jobs (model_cache.h), and ends each job's NDJSON with a
+// `job.exit` event. It keeps the crash isolation of the fork-per-job model
+// (a crash or watchdog kill takes out only the worker, which is started
+// again for the next job) and is replaced per pp_worker_should_retire() and
+// after PP_WORKER_IDLE_TIMEOUT without work, which hands its memory back
+// between meetings. pp_worker_jobs = 0 restores one subprocess per job.
+// Each PpSlot has its own worker.
+
+constexpr auto PP_WORKER_IDLE_TIMEOUT = std::chrono::minutes(10);
+
+// Fork/exec `argv` with stdout/stderr pipes (and a stdin pipe when `warm`).
+// Returns nullptr on success, else a short reason for the state broadcast.
+static const char* spawn_pp_child(std::vector<std::string> argv, bool warm, PpChild& out) {
+    if (!g_trace_out.empty()) {
+        const int n = ++g_trace_children;
+        argv.push_back("--trace-out");
+        argv.push_back((g_trace_out.parent_path() /
+                        (g_trace_out.stem().string() + ".pp" + std::to_string(n) +
+                         g_trace_out.extension().string())).string());
+    }
+    std::vector<char*> argv_ptrs;
+    for (auto& a : argv) argv_ptrs.push_back(a.data());
+    argv_ptrs.push_back(nullptr);
+
+    int stdin_pipe[2] = {-1, -1}, stdout_pipe[2], stderr_pipe[2];
+    if ((warm && pipe2(stdin_pipe, O_CLOEXEC) < 0) || pipe(stdout_pipe) < 0 ||
+        pipe(stderr_pipe) < 0) {
+        log_error("daemon: pipe() failed: %s", strerror(errno));
+        return "pipe() failed";
+    }
+
+    log_debug("daemon: forking subprocess (%s)", warm ? "warm worker" : "one-shot");
+    pid_t pid = fork();
+
+    if (pid == 0) {
+        // Child — reset signal handlers immediately
+        signal(SIGINT, SIG_DFL);
+        signal(SIGTERM, SIG_DFL);
+        signal(SIGHUP, SIG_DFL);
+        signal(SIGPIPE, SIG_DFL);
+
+        if (warm) dup2(stdin_pipe[0], STDIN_FILENO);
+        close(stdout_pipe[0]);
+        close(stderr_pipe[0]);
+        dup2(stdout_pipe[1], STDOUT_FILENO);
+        dup2(stderr_pipe[1], STDERR_FILENO);
+        close(stdout_pipe[1]);
+        close(stderr_pipe[1]);
+
+        // Close leaked daemon FDs (pid lock, log, IPC sockets)
+        closefrom(3);
+
+        execv(argv_ptrs[0], argv_ptrs.data());
+        _exit(127);
+    }
+
+    if (warm) close(stdin_pipe[0]);
+    close(stdout_pipe[1]);
+    close(stderr_pipe[1]);
+    if (pid < 0) {
+        log_error("daemon: fork() failed: %s", strerror(errno));
+        if (warm) close(stdin_pipe[1]);
+        close(stdout_pipe[0]);
+        close(stderr_pipe[0]);
+        return "fork() failed";
+    }
+
+    out = PpChild{};
+    out.pid = pid;
+    out.stdin_fd = warm ? stdin_pipe[1] : -1;
+    out.stdout_fd = stdout_pipe[0];
+    out.stderr_fd = stderr_pipe[0];
+    if (warm) log_info("daemon: pp worker started (pid=%d)", (int)pid);
+    return nullptr;
+}
+
+// Move the child's threads to `want` (see cpu_topology.h). Logs changes;
+// the periodic re-apply for threads started since is silent.
+static void apply_pp_cpu_priority(PpChild& w, PpCpuPriority want) {
+    const CpuPriorityChange change = set_process_cpu_priority(w.pid, want);
+    if (want != w.priority) {
+        if (change.refused > 0)
+            log_warn("daemon: pp child pid=%d: %d thread(s) kept %s CPU priority%s", (int)w.pid,
+                     change.refused, pp_cpu_priority_name(w.priority),
+                     want == PpCpuPriority::Normal ? " (needs LimitNICE=+0)" : "");
+        log_info("daemon: pp child pid=%d at %s CPU priority (%d thread(s))", (int)w.pid,
+                 pp_cpu_priority_name(want), change.threads);
+    }
+    w.priority = want;
+}
+
+// Hand a job path (or a release line) to the warm worker. False if it has
+// gone away (EPIPE).
+static bool send_pp_line(const PpChild& w, const std::string& text) {
+    std::string line = text + "\n";
+    size_t off = 0;
+    while (off < line.size()) {
+        ssize_t n = write(w.stdin_fd, line.data() + off, line.size() - off);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            log_warn("daemon: pp worker pid=%d not accepting jobs (%s)",
+                     (int)w.pid, strerror(errno));
+            return false;
+        }
+        off += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Close the warm worker's stdin so it exits, reap it and forget it. An
+// idle worker is blocked reading stdin, so this takes milliseconds; one
+// that does not exit within 5 s goes through the kill grace ladder.
+static void retire_pp_worker(PpChild& w, const char* why) {
+    if (w.pid <= 0) return;
+    log_info("daemon: retiring pp worker pid=%d after %d job(s) (%s)",
+             (int)w.pid, w.jobs, why);
+    for (int fd : {w.stdin_fd, w.stdout_fd, w.stderr_fd})
+        if (fd >= 0) close(fd);
+    bool gone = false;
+    for (int i = 0; i < 50 && !gone; ++i) {
+        gone = !poll_child_alive(w.pid);
+        if (!gone) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    if (!gone) {
+        log_warn("daemon: pp worker pid=%d ignored EOF on stdin", (int)w.pid);
+        kill_pp_child_with_grace(w.pid);
+    }
+    w = PpChild{};
+}
+
+// ---------------------------------------------------------------------------
+// Postprocessing slots (one long-lived thread each)
 // ---------------------------------------------------------------------------
+//
+// The queue is ordered by PpJobClass, FIFO within a class, and the slots
+// take jobs from its front. A free slot starts the front job once
+// admit_pp_job() accepts its footprint beside the other slots' jobs and
+// idle warm workers, and re-checks whenever a job is queued or ends or a
+// worker retires (g_queue_cv). With one slot and one class this is the
+// serial queue it replaced.
+//
+// An interactive job that finds every running slot taken may pause a batch
+// job (pp_may_preempt) if it fits beside it: the batch child is SIGSTOPped
+// in place, keeping its memory and progress, and continued once the
+// running jobs leave room for it again. One job is paused at a time.
+
+// Whether two paths name the same meeting directory.
+static bool same_meeting_dir(const fs::path& a, const fs::path& b) {
+    if (a.empty() || b.empty()) return false;
+    std::error_code ec_a, ec_b;
+    const fs::path ca = fs::weakly_canonical(a, ec_a);
+    const fs::path cb = fs::weakly_canonical(b, ec_b);
+    return (ec_a ? a.lexically_normal() : ca) == (ec_b ? b.lexically_normal() : cb);
+}
+
+// The running slot of the meeting in `dir`, or nullptr. Caller holds
+// g_queue_mu.
+static PpSlot* pp_slot_running(const fs::path& dir) {
+    for (const auto& slot : g_pp_slots)
+        if (slot->busy && same_meeting_dir(slot->out_dir, dir)) return slot.get();
+    return nullptr;
+}
+
+// The queued job the slots start next: the first whose meeting no slot is
+// running, so one meeting is never processed twice at once. Caller holds
+// g_queue_mu.
+static std::deque<PostprocessJob>::iterator pp_next_job() {
+    return std::find_if(g_job_queue.begin(), g_job_queue.end(), [](const PostprocessJob& job) {
+        return !pp_slot_running(job.input.out_dir);
+    });
+}
+
+// Queue `job` behind every job of its class or a more urgent one. Caller
+// holds g_queue_mu.
+static void enqueue_pp_job(PostprocessJob job) {
+    auto it = std::find_if(g_job_queue.begin(), g_job_queue.end(),
+                           [&job](const PostprocessJob& queued) {
+                               return queued.job_class > job.job_class;
+                           });
+    g_job_queue.insert(it, std::move(job));
+}
+
+// Drop queued job `job_id`. Ends postprocessing when nothing else is queued
+// or running; `idle` says whether it did. Caller does not hold g_queue_mu.
+static bool drop_queued_pp_job(int64_t job_id, bool& idle) {
+    bool dropped = false;
+    std::lock_guard<std::mutex> lock(g_queue_mu);
+    for (auto it = g_job_queue.begin(); it != g_job_queue.end(); ++it) {
+        if (it->job_id != job_id) continue;
+        log_info("Postprocessing cancelled for queued job %ld (audio kept at %s)",
+                 (long)job_id, it->input.out_dir.c_str());
+        // The journal entry is per meeting; a run of it in progress keeps it.
+        if (!pp_slot_running(it->input.out_dir)) unjournal_pp_job(*it);
+        g_job_queue.erase(it);
+        dropped = true;
+        break;
+    }
+    idle = g_job_queue.empty();
+    for (const auto& slot : g_pp_slots) idle = idle && !slot->busy;
+    if (dropped && idle) {
+        std::lock_guard<std::mutex> state_lock(g_state_mu);
+        g_postprocessing.store(false);
+    }
+    return dropped;
+}
+
+// Queue every journaled job as a reprocess of its output directory; one
+// whose directory or audio is gone is dropped. Returns the number queued.
+static int restore_pp_journal() {
+    std::error_code ec;
+    if (!fs::is_directory(pp_journal_dir(), ec)) return 0;
+    std::vector<PostprocessJob> jobs;
+    for (const auto& entry : fs::directory_iterator(pp_journal_dir(), ec)) {
+        if (entry.path().extension() != ".json") continue;
+        std::ifstream in(entry.path());
+        std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        PostprocessJob job;
+        job.cfg = config_from_json(json);
+        job.input.out_dir = job.cfg.reprocess_dir;
+        job.input.audio_path = find_audio_file(job.input.out_dir);
+        if (job.cfg.reprocess_dir.empty() || job.input.audio_path.empty()) {
+            log_warn("daemon: dropping journaled job %s (no audio at %s)",
+                     entry.path().filename().c_str(), job.cfg.reprocess_dir.c_str());
+            std::error_code rm_ec;
+            fs::remove(entry.path(), rm_ec);
+            continue;
+        }
+        job.job_id = g_next_job_id.fetch_add(1);
+        job.footprint = estimate_job_footprint(job.cfg, job.input.audio_path);
+        job.job_class = pp_job_class(job.cfg);
+        job.attempt = 2;
+        log_info("daemon: resuming interrupted job=%ld (%s, dir=%s)", (long)job.job_id,
+                 pp_job_class_name(job.job_class), job.input.out_dir.c_str());
+        jobs.push_back(std::move(job));
+    }
+    if (jobs.empty()) return 0;
+    {
+        std::lock_guard<std::mutex> lock(g_queue_mu);
+        for (auto& job : jobs) enqueue_pp_job(std::move(job));
+        std::lock_guard<std::mutex> state_lock(g_state_mu);
+        g_postprocessing.store(true);
+    }
+    g_queue_cv.notify_all();
+    return static_cast<int>(jobs.size());
+}
+
+// Ingest the files the watch folder found ready together (watcher thread)
+// and queue each as a batch-class reprocess of its new meeting, journaled
+// like any job. They go in back to back with the same config, so the warm
+// workers run them one after another with the models still loaded.
+static void queue_watched_files(IpcServer& server, const std::vector<fs::path>& files) {
+    Config base;
+    {
+        std::lock_guard<std::mutex> lock(g_config_mu);
+        base = g_config;
+    }
+    std::vector<PostprocessJob> jobs;
+    for (const auto& file : files) {
+        fs::path dir;
+        try {
+            dir = ingest_watch_file(file, base.output_dir);
+        } catch (const std::exception& e) {
+            log_error("daemon: watch folder: %s", e.what());
+            continue;
+        }
+        PostprocessJob job;
+        job.job_id = g_next_job_id.fetch_add(1);
+        job.input.out_dir = dir;
+        job.input.audio_path = find_audio_file(dir);
+        job.input.timestamp = derive_meeting_timestamp(dir);
+        job.cfg = base;
+        job.cfg.reprocess_dir = dir;
+        job.cfg.batch_mode = true;
+        job.footprint = estimate_job_footprint(job.cfg, job.input.audio_path);
+        job.job_class = pp_job_class(job.cfg);
+        job.inputs = expected_meeting_manifest(job.cfg, dir, "");
+        log_info("daemon: watch folder job=%ld: %s -> %s", (long)job.job_id,
+                 file.filename().c_str(), dir.c_str());
+        journal_pp_job(job);
+        jobs.push_back(std::move(job));
+    }
+    if (jobs.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(g_queue_mu);
+        for (auto& job : jobs) enqueue_pp_job(std::move(job));
+        std::lock_guard<std::mutex> state_lock(g_state_mu);
+        g_postprocessing.store(true);
+    }
+    g_queue_cv.notify_all();
+    log_info("daemon: watch folder queued %zu meeting(s)", jobs.size());
+    broadcast_state(server);
+}
+
+// (Re)start watching `cfg.watch_dir`, or stop when it is unset.
+static void start_watch_folder(IpcServer& server, const Config& cfg) {
+    g_watch.reset();
+    if (cfg.watch_dir.empty()) return;
+    std::error_code ec;
+    fs::create_directories(cfg.watch_dir, ec);
+    if (ec) {
+        log_warn("daemon: cannot create watch folder %s (%s)", cfg.watch_dir.c_str(),
+                 ec.message().c_str());
+        return;
+    }
+    g_watch = std::make_unique<WatchFolder>(
+        cfg.watch_dir, cfg.watch_settle_sec,
+        [&server](const std::vector<fs::path>& files) { queue_watched_files(server, files); });
+    g_watch->start();
+}
+
+// Everything but `self`, for admission. Caller holds g_queue_mu.
+static PpLoad pp_load_except(const PpSlot& self) {
+    PpLoad others;
+    for (const auto& slot : g_pp_slots) {
+        if (slot.get() == &self) continue;
+        if (slot->busy) {
+            if (slot->paused.load()) {
+                ++others.paused;
+            } else {
+                ++others.jobs;
+                others.threads += slot->footprint.threads;
+            }
+            others.bytes += slot->footprint.bytes;
+        } else if (slot->warm) {
+            others.idle_warm = true;
+            others.bytes += slot->footprint.model_bytes;
+        }
+    }
+    return others;
+}
 
-static void pp_worker_loop(IpcServer& server) {
-    log_debug("daemon: pp_worker_loop ENTER (tid=%d)", (int)syscall(SYS_gettid));
+// postprocess.on_battery: defer holds queued jobs while the host runs on
+// battery. The power state is read at most every PP_POWER_POLL_INTERVAL,
+// and idle slots wake that often to see AC power come back.
+constexpr auto PP_POWER_POLL_INTERVAL = std::chrono::seconds(30);
+static PowerState g_power_state;
+static std::chrono::steady_clock::time_point g_power_read_at{};
+static bool g_power_holding = false;
+
+// Whether `job` waits for AC power. Caller holds g_queue_mu.
+static bool pp_power_holds(const PostprocessJob& job) {
+    BatteryPolicy policy = BatteryPolicy::Reduce;
+    parse_battery_policy(job.cfg.pp_on_battery, policy);
+    if (policy != BatteryPolicy::Defer) return false;
+    const auto now = std::chrono::steady_clock::now();
+    if (g_power_read_at == std::chrono::steady_clock::time_point{} ||
+        now - g_power_read_at >= PP_POWER_POLL_INTERVAL) {
+        g_power_state = read_power_state();
+        g_power_read_at = now;
+    }
+    const bool hold = power_defers(g_power_state, policy);
+    if (hold != g_power_holding) {
+        if (hold)
+            log_info("daemon: on battery (%d%%); holding %zu queued job(s) until AC power",
+                     g_power_state.battery_percent, g_job_queue.size());
+        else
+            log_info("daemon: on AC power; starting held jobs");
+        g_power_holding = hold;
+    }
+    return hold;
+}
+
+// postprocess.battery_model: the smaller whisper model for a job started
+// in the reduced profile. A remote worker is not on this host's battery.
+static void apply_battery_model(PostprocessJob& job) {
+    if (job.cfg.pp_battery_model.empty() || job.cfg.pp_battery_model == job.cfg.whisper_model ||
+        !job.cfg.remote_worker.empty())
+        return;
+    BatteryPolicy policy = BatteryPolicy::Reduce;
+    parse_battery_policy(job.cfg.pp_on_battery, policy);
+    if (!power_reduced(read_power_state(), policy)) return;
+    log_info("daemon: on battery; job=%ld transcribes with %s instead of %s", (long)job.job_id,
+             job.cfg.pp_battery_model.c_str(), job.cfg.whisper_model.c_str());
+    job.cfg.whisper_model = job.cfg.pp_battery_model;
+}
+
+// Whether `self` may start the front job. Caller holds g_queue_mu.
+static bool pp_slot_may_start(const PpSlot& self) {
+    const auto next = pp_next_job();
+    if (next == g_job_queue.end() || pp_power_holds(*next)) return false;
+    return admit_pp_job(next->footprint, pp_load_except(self), self.warm,
+                        g_pp_max_jobs, g_pp_budget_bytes, g_pp_cores);
+}
+
+// The running job `self` may pause to start the front job, or nullptr.
+// Caller holds g_queue_mu.
+static PpSlot* pp_preempt_victim(const PpSlot& self) {
+    const auto it = pp_next_job();
+    if (it == g_job_queue.end() || pp_power_holds(*it)) return nullptr;
+    const PostprocessJob& next = *it;
+    PpSlot* victim = nullptr;
+    for (const auto& slot : g_pp_slots) {
+        if (slot->paused.load()) return nullptr;
+        if (slot.get() != &self && slot->busy && slot->child_pid.load() > 0 &&
+            pp_may_preempt(next.job_class, slot->job_class))
+            victim = slot.get();
+    }
+    if (!victim) return nullptr;
+    PpLoad others = pp_load_except(self);
+    --others.jobs;
+    ++others.paused;
+    others.threads -= victim->footprint.threads;
+    return admit_pp_job(next.footprint, others, self.warm, g_pp_max_jobs, g_pp_budget_bytes,
+                        g_pp_cores) ? victim : nullptr;
+}
+
+// Continue the paused job once it fits among the running ones again,
+// unless the front job is an interactive one that fits beside it still
+// paused. Caller holds g_queue_mu.
+static void pp_resume_paused() {
+    for (const auto& slot : g_pp_slots) {
+        if (!slot->paused.load()) continue;
+        const auto next = pp_next_job();
+        if (next != g_job_queue.end() && pp_may_preempt(next->job_class, slot->job_class)) {
+            bool next_fits = false;
+            for (const auto& free_slot : g_pp_slots)
+                if (!free_slot->busy && pp_slot_may_start(*free_slot)) next_fits = true;
+            if (next_fits) return;
+        }
+        if (!admit_pp_job(slot->footprint, pp_load_except(*slot), true, g_pp_max_jobs,
+                          g_pp_budget_bytes, g_pp_cores))
+            return;
+        slot->paused.store(false);
+        const pid_t child = slot->child_pid.load();
+        if (child > 0) kill(child, SIGCONT);
+        log_info("daemon: resumed job=%ld (pid=%d)", (long)slot->job_id.load(), (int)child);
+    }
+}
+
+// Retire `slot`'s worker and let the other slots count its memory as free.
+static void retire_slot_worker(PpSlot& slot, const char* why) {
+    retire_pp_worker(slot.proc, why);
+    {
+        std::lock_guard<std::mutex> lock(g_queue_mu);
+        slot.warm = false;
+    }
+    g_queue_cv.notify_all();
+}
+
+static void pp_slot_loop(IpcServer& server, PpSlot& slot) {
+    log_debug("daemon: pp slot %d ENTER (tid=%d)", slot.index, (int)syscall(SYS_gettid));
     while (true) {
         PostprocessJob job;
         bool already_flagged = false;
+        bool interrupted = false;  // queue it again (PP_MAX_ATTEMPTS)
         {
             std::unique_lock<std::mutex> lock(g_queue_mu);
-            g_queue_cv.wait(lock, [] {
-                return !g_job_queue.empty() || g_queue_shutdown;
-            });
+            auto ready = [&slot] {
+                return g_queue_shutdown || pp_slot_may_start(slot) || pp_preempt_victim(slot) ||
+                       (slot.proc.pid > 0 && !slot.stale_models.empty());
+            };
+            // Wake every PP_POWER_POLL_INTERVAL: a job held for AC power
+            // starts without a notify.
+            if (slot.proc.pid > 0) {
+                const auto idle_until = std::chrono::steady_clock::now() + PP_WORKER_IDLE_TIMEOUT;
+                bool woken = true;
+                while (!ready()) {
+                    const auto now = std::chrono::steady_clock::now();
+                    if (now >= idle_until) { woken = false; break; }
+                    g_queue_cv.wait_for(lock, std::min<std::chrono::steady_clock::duration>(
+                                                  idle_until - now, PP_POWER_POLL_INTERVAL));
+                }
+                if (!woken) {
+                    lock.unlock();
+                    retire_slot_worker(slot, "idle");
+                    continue;
+                }
+            } else {
+                while (!ready()) g_queue_cv.wait_for(lock, PP_POWER_POLL_INTERVAL);
+            }
             if (g_queue_shutdown) {
-                log_debug("daemon: pp_worker_loop EXIT (shutdown)");
+                lock.unlock();
+                retire_pp_worker(slot.proc, "shutdown");
+                log_debug("daemon: pp slot %d EXIT (shutdown)", slot.index);
                 return;
             }
-            job = std::move(g_job_queue.front());
-            g_job_queue.pop();
-            log_debug("daemon: pp_worker dequeued job=%ld (queue_size=%zu)", (long)job.job_id, g_job_queue.size());
+            if (!slot.stale_models.empty()) {
+                std::vector<std::string> kinds;
+                kinds.swap(slot.stale_models);
+                if (slot.proc.pid > 0) {
+                    lock.unlock();
+                    if (!send_pp_line(slot.proc, pp_worker_release_line(kinds)))
+                        retire_slot_worker(slot, "worker gone");
+                    continue;
+                }
+            }
+            const auto next = pp_next_job();
+            if (!pp_slot_may_start(slot)) {
+                PpSlot* victim = pp_preempt_victim(slot);
+                victim->paused.store(true);
+                const pid_t child = victim->child_pid.load();
+                kill(child, SIGSTOP);
+                log_info("daemon: paused batch job=%ld (pid=%d) for interactive job=%ld",
+                         (long)victim->job_id.load(), (int)child, (long)next->job_id);
+            }
+            job = std::move(*next);
+            g_job_queue.erase(next);
+            slot.busy = true;
+            slot.warm = false;
+            slot.footprint = job.footprint;
+            slot.job_class = job.job_class;
+            slot.out_dir = job.input.out_dir;
+            slot.inputs = job.inputs;
+            slot.stop.reset();
+            slot.job_id.store(job.job_id);
+            set_worker_job_state(job.job_id, "running");
+            log_debug("daemon: pp slot %d dequeued %s job=%ld (attempt=%d, est=%llu MB, "
+                      "threads=%d, queue_size=%zu)",
+                      slot.index, pp_job_class_name(job.job_class), (long)job.job_id, job.attempt,
+                      (unsigned long long)(job.footprint.bytes >> 20), job.footprint.threads,
+                      g_job_queue.size());
 
             // Check if recording worker already set g_postprocessing
             // (atomic handoff — avoids transient idle)
             already_flagged = g_postprocessing.load();
         }
+        // The next job may fit beside this one.
+        g_queue_cv.notify_all();
 
         if (!already_flagged) {
             {
@@ -407,7 +1315,8 @@ static void pp_worker_loop(IpcServer& server) {
             }
             broadcast_state(server);
         }
-        g_pp_stop.reset();
+
+        apply_battery_model(job);
 
         // Subprocess must always reprocess (never record new audio).
         // The daemon already captured the audio; point the subprocess at it.
@@ -417,73 +1326,108 @@ static void pp_worker_loop(IpcServer& server) {
         log_debug("daemon: writing job config (reprocess_dir=%s)", job.cfg.reprocess_dir.c_str());
         auto config_path = write_job_config(job);
 
-        // Build argv
+        // Paths handed to the subprocess
         std::string out_dir_str = job.input.out_dir.string();
         std::string config_path_str = config_path.string();
 
-        std::vector<std::string> argv_strs = {
-            g_self_exe,
-            "--reprocess", out_dir_str,
-            "--config-json", config_path_str,
-            "--progress-json",
-            "--no-daemon"
-        };
-        std::vector<char*> argv_ptrs;
-        for (auto& s : argv_strs) argv_ptrs.push_back(s.data());
-        argv_ptrs.push_back(nullptr);
-
-        // Create pipes
-        int stdout_pipe[2], stderr_pipe[2];
-        if (pipe(stdout_pipe) < 0 || pipe(stderr_pipe) < 0) {
-            log_error("daemon: pipe() failed: %s", strerror(errno));
-            notify("Postprocessing failed", "Could not create pipes");
-            broadcast_state(server, "pipe() failed");
-            std::error_code ec;
-            fs::remove(config_path, ec);
-            goto clear_state;
-        }
-
         {
-            log_debug("daemon: forking subprocess");
-            pid_t pid = fork();
-
-            if (pid == 0) {
-                // Child — reset signal handlers immediately
-                signal(SIGINT, SIG_DFL);
-                signal(SIGTERM, SIG_DFL);
-                signal(SIGHUP, SIG_DFL);
-
-                close(stdout_pipe[0]);
-                close(stderr_pipe[0]);
-                dup2(stdout_pipe[1], STDOUT_FILENO);
-                dup2(stderr_pipe[1], STDERR_FILENO);
-                close(stdout_pipe[1]);
-                close(stderr_pipe[1]);
-
-                // Close leaked daemon FDs (pid lock, log, IPC sockets)
-                closefrom(3);
-
-                execv(g_self_exe.c_str(), argv_ptrs.data());
-                _exit(127);
+            // Remote worker first: the stages it returns are stage cache
+            // hits for the local run below, which otherwise computes them.
+            if (!job.cfg.remote_worker.empty() && job.cfg.stage_cache) {
+                RemoteOffload offload;
+                offload.address = job.cfg.remote_worker;
+                offload.job_id = remote_job_id(host_name(), job.input.out_dir);
+                offload.stop = &slot.stop;
+                std::string last_phase;
+                int last_sent = -1;
+                const int64_t jid = job.job_id;
+                offload.on_progress = [&](const std::string& phase, int percent) {
+                    if (phase != last_phase) {
+                        last_phase = phase;
+                        last_sent = -1;
+                        server.post([&server, phase, jid]() {
+                            IpcEvent ev;
+                            ev.event = "phase";
+                            ev.data["name"] = phase;
+                            ev.data["job_id"] = jid;
+                            server.broadcast(ev);
+                        });
+                    }
+                    if (last_sent >= 0 && percent - last_sent < 10 && percent < 100) return;
+                    last_sent = percent;
+                    server.post([&server, phase, percent, jid]() {
+                        IpcEvent ev;
+                        ev.event = "progress";
+                        ev.data["phase"] = phase;
+                        ev.data["percent"] = static_cast<int64_t>(percent);
+                        ev.data["job_id"] = jid;
+                        server.broadcast(ev);
+                    });
+                };
+                try {
+                    const size_t stages = offload_postprocessing(offload, job.cfg, job.input.out_dir);
+                    log_info("daemon: job=%ld got %zu stage(s) from %s", (long)job.job_id, stages,
+                             offload.address.c_str());
+                    count_remote_offload("offloaded");
+                } catch (const std::exception& e) {
+                    if (slot.stop.stop_requested()) {
+                        log_info("Postprocessing cancelled for job %ld", (long)job.job_id);
+                        count_pp_outcome("cancelled");
+                        broadcast_job_failed(server, job.job_id, "Cancelled");
+                        std::error_code ec;
+                        fs::remove(config_path, ec);
+                        goto clear_state;
+                    }
+                    log_warn("daemon: job=%ld runs locally; remote worker %s: %s",
+                             (long)job.job_id, offload.address.c_str(), e.what());
+                    count_remote_offload("local");
+                }
             }
 
-            if (pid < 0) {
-                log_error("daemon: fork() failed: %s", strerror(errno));
+            // Warm worker unless the job opts out; a dead worker (EPIPE on
+            // the job line) is replaced once.
+            const bool warm = job.cfg.pp_worker_jobs > 0;
+            const char* launch_error = nullptr;
+            if (warm) {
+                bool sent = false;
+                for (int attempt = 0; attempt < 2 && !sent && !launch_error; ++attempt) {
+                    if (slot.proc.pid < 0)
+                        launch_error = spawn_pp_child(
+                            {g_self_exe, "--pp-worker", "--no-daemon"}, true, slot.proc);
+                    if (!launch_error) {
+                        sent = send_pp_line(slot.proc, config_path_str);
+                        if (!sent) retire_pp_worker(slot.proc, "worker gone");
+                    }
+                }
+                if (!sent && !launch_error) launch_error = "pp worker not accepting jobs";
+            } else {
+                retire_pp_worker(slot.proc, "one-shot job");
+                launch_error = spawn_pp_child({
+                    g_self_exe,
+                    "--reprocess", out_dir_str,
+                    "--config-json", config_path_str,
+                    "--progress-json",
+                    "--no-daemon"
+                }, false, slot.proc);
+            }
+
+            if (launch_error) {
                 notify("Postprocessing failed", "Could not launch subprocess");
-                broadcast_state(server, "fork() failed");
-                close(stdout_pipe[0]); close(stdout_pipe[1]);
-                close(stderr_pipe[0]); close(stderr_pipe[1]);
+                broadcast_state(server, launch_error);
+                count_pp_outcome("failed");
+                set_worker_job_state(job.job_id, "failed", launch_error);
+                broadcast_job_failed(server, job.job_id, launch_error);
                 std::error_code ec;
                 fs::remove(config_path, ec);
                 goto clear_state;
             }
 
-            // Parent
-            close(stdout_pipe[1]);
-            close(stderr_pipe[1]);
-            g_pp_child_pid.store(pid);
-            log_info("daemon: subprocess launched (pid=%d, job=%ld, dir=%s)",
-                     (int)pid, (long)job.job_id, out_dir_str.c_str());
+            const pid_t pid = slot.proc.pid;
+            slot.child_pid.store(pid);
+            log_info("daemon: %s (pid=%d, slot=%d, job=%ld, dir=%s)",
+                     warm ? "job sent to pp worker" : "subprocess launched",
+                     (int)pid, slot.index, (long)job.job_id, out_dir_str.c_str());
+            const auto job_started = std::chrono::steady_clock::now();
 
             // Per-job progress throttle state
             auto last_broadcast = std::chrono::steady_clock::time_point{};
@@ -499,8 +1443,10 @@ static void pp_worker_loop(IpcServer& server) {
             // a child that has actually stopped emitting heartbeats.
             std::string last_known_phase;
             bool killed_stale = false;
+            bool cancelled = false;
             std::string captured_note_path;
             std::string captured_output_dir;
+            std::vector<StagePerf> job_perf;  // stage.perf events, for file_job_perf()
 
             // RSS tracking from heartbeat events — thresholded logging only,
             // no behavior change. The cgroup MemoryMax= in the systemd unit
@@ -515,23 +1461,67 @@ static void pp_worker_loop(IpcServer& server) {
 
             // Poll loop on both pipes
             struct pollfd pfds[2] = {
-                {stdout_pipe[0], POLLIN, 0},
-                {stderr_pipe[0], POLLIN, 0}
+                {slot.proc.stdout_fd, POLLIN, 0},
+                {slot.proc.stderr_fd, POLLIN, 0}
             };
             int nfds = 2;
             std::string stdout_buf, stderr_buf;
             int poll_iter = 0;
+            // Warm worker: the job ends at its job.exit event rather than EOF.
+            bool job_exited = false;
+            int exit_code = -1;
+            int64_t exit_rss_kb = 0;
+            int64_t exit_peak_rss_kb = 0;
+
+            // Relay complete stderr lines to the log; returns read()'s result.
+            auto read_stderr = [&](int fd) {
+                char buf[4096];
+                ssize_t n = read(fd, buf, sizeof(buf));
+                if (n > 0) {
+                    stderr_buf.append(buf, n);
+                    size_t pos = 0;
+                    size_t nl;
+                    while ((nl = stderr_buf.find('\n', pos)) != std::string::npos) {
+                        std::string line = stderr_buf.substr(pos, nl - pos);
+                        pos = nl + 1;
+                        if (!line.empty()) {
+                            log_info("pp-child: %s", line.c_str());
+                            last_stderr_line = line;
+                        }
+                    }
+                    stderr_buf.erase(0, pos);
+                }
+                return n;
+            };
 
-            while (nfds > 0) {
+            while (nfds > 0 && !job_exited) {
                 int ret = poll(pfds, nfds, 1000);
                 ++poll_iter;
 
                 // Check cancel
-                if (g_pp_stop.stop_requested()) {
+                if (slot.stop.stop_requested()) {
+                    cancelled = true;
                     kill(pid, SIGTERM);
-                    g_pp_stop.reset();
+                    if (slot.paused.load()) kill(pid, SIGCONT);
+                    slot.stop.reset();
                 }
 
+                // Yield the CPU to a recording that is running, and take it
+                // back when it stops; every 10th pass also catches threads
+                // started since the last change.
+                {
+                    const PpCpuPriority want = pp_cpu_priority(job.cfg.pp_yield_to_recording,
+                                                               g_recording.load());
+                    if (want != slot.proc.priority ||
+                        (want == PpCpuPriority::Yield && poll_iter % 10 == 0))
+                        apply_pp_cpu_priority(slot.proc, want);
+                }
+
+                // A paused child emits nothing; its watchdogs start over
+                // when it is continued.
+                if (slot.paused.load())
+                    last_heartbeat = last_progress = std::chrono::steady_clock::now();
+
                 // Staleness watchdog — two checks:
                 // 1. No events at all for 120s → pipe/process dead
                 // 2. No progress/phase for 300s → processing stuck (heartbeat alive but no work)
@@ -582,11 +1572,17 @@ static void pp_worker_loop(IpcServer& server) {
                             std::string event = parse_ndjson_string(line, "event");
                             // Any event proves pipe is alive
                             last_heartbeat = std::chrono::steady_clock::now();
-                            // Phase/progress events prove forward motion
-                            if (event == "phase" || event == "progress")
+                            // Phase/progress events prove forward motion,
+                            // and so does summary text being written
+                            if (event == "phase" || event == "progress" ||
+                                event == "summary.delta")
                                 last_progress = last_heartbeat;
                             if (event == "heartbeat") {
                                 int64_t rss_kb = parse_ndjson_int(line, "rss_kb");
+                                // The child's own high-water mark catches
+                                // spikes between heartbeats, e.g. a prefill.
+                                int64_t child_peak_kb = parse_ndjson_int(line, "peak_rss_kb");
+                                if (child_peak_kb > peak_rss_kb) peak_rss_kb = child_peak_kb;
                                 if (rss_kb > 0) {
                                     last_rss_kb = rss_kb;
                                     if (rss_kb > peak_rss_kb) peak_rss_kb = rss_kb;
@@ -626,10 +1622,12 @@ static void pp_worker_loop(IpcServer& server) {
                                 last_percent = -1;  // Reset throttle on phase change
                                 std::string name = parse_ndjson_string(line, "name");
                                 last_known_phase = name;  // T1C.1
-                                server.post([&server, name]() {
+                                int64_t jid = job.job_id;
+                                server.post([&server, name, jid]() {
                                     IpcEvent ev;
                                     ev.event = "phase";
                                     ev.data["name"] = name;
+                                    ev.data["job_id"] = jid;
                                     server.broadcast(ev);
                                 });
                             } else if (event == "progress") {
@@ -644,17 +1642,53 @@ static void pp_worker_loop(IpcServer& server) {
                                 if (last_percent < 0 || elapsed >= 120 || jump >= 10) {
                                     last_broadcast = now;
                                     last_percent = static_cast<int>(percent);
-                                    server.post([&server, phase, percent]() {
+                                    int64_t jid = job.job_id;
+                                    server.post([&server, phase, percent, jid]() {
                                         IpcEvent ev;
                                         ev.event = "progress";
                                         ev.data["phase"] = phase;
                                         ev.data["percent"] = percent;
+                                        ev.data["job_id"] = jid;
                                         server.broadcast(ev);
                                     });
                                 }
+                            } else if (event == "summary.delta") {
+                                // Not throttled: the child already batches
+                                // tokens into pieces.
+                                std::string text = json_extract_string(line, "text");
+                                int64_t jid = job.job_id;
+                                server.post([&server, text, jid]() {
+                                    IpcEvent ev;
+                                    ev.event = "summary.delta";
+                                    ev.data["text"] = text;
+                                    ev.data["job_id"] = jid;
+                                    server.broadcast(ev);
+                                });
+                            } else if (event == "transcribe.draft") {
+                                log_info("daemon: two-pass transcription re-decoded %lld of %lld "
+                                         "windows, ~%llds saved",
+                                         (long long)parse_ndjson_int(line, "redecoded"),
+                                         (long long)parse_ndjson_int(line, "windows"),
+                                         (long long)parse_ndjson_int(line, "saved_sec"));
+                            } else if (event == "transcribe.stats") {
+                                log_info("daemon: repetition watchdog stopped %lld looping "
+                                         "decode(s)",
+                                         (long long)parse_ndjson_int(line, "repetition_aborts"));
+                            } else if (event == "stage.perf") {
+                                IpcMessage msg;
+                                StagePerf perf;
+                                if (parse_ipc_message(line, msg) &&
+                                    msg.type == IpcMessageType::Event &&
+                                    stage_perf_from_map(msg.event.data, perf))
+                                    job_perf.push_back(std::move(perf));
                             } else if (event == "job.complete") {
                                 captured_note_path = parse_ndjson_string(line, "note_path");
                                 captured_output_dir = parse_ndjson_string(line, "output_dir");
+                            } else if (event == "job.exit") {
+                                job_exited = true;
+                                exit_code = static_cast<int>(parse_ndjson_int(line, "code"));
+                                exit_rss_kb = parse_ndjson_int(line, "rss_kb");
+                                exit_peak_rss_kb = parse_ndjson_int(line, "peak_rss_kb");
                             } else if (event.empty() && !line.empty()) {
                                 log_debug("daemon: subprocess stdout unparseable: %.*s",
                                           (int)std::min(line.size(), (size_t)200), line.c_str());
@@ -670,22 +1704,7 @@ static void pp_worker_loop(IpcServer& server) {
 
                 // Process stderr
                 if (pfds[1].fd >= 0 && (pfds[1].revents & (POLLIN | POLLHUP))) {
-                    char buf[4096];
-                    ssize_t n = read(pfds[1].fd, buf, sizeof(buf));
-                    if (n > 0) {
-                        stderr_buf.append(buf, n);
-                        size_t pos = 0;
-                        size_t nl;
-                        while ((nl = stderr_buf.find('\n', pos)) != std::string::npos) {
-                            std::string line = stderr_buf.substr(pos, nl - pos);
-                            pos = nl + 1;
-                            if (!line.empty()) {
-                                log_info("pp-child: %s", line.c_str());
-                                last_stderr_line = line;
-                            }
-                        }
-                        stderr_buf.erase(0, pos);
-                    } else if (n == 0) {
+                    if (read_stderr(pfds[1].fd) == 0) {
                         close(pfds[1].fd);
                         pfds[1].fd = -1;
                         pfds[1].events = 0;
@@ -704,16 +1723,42 @@ static void pp_worker_loop(IpcServer& server) {
                 }
             }
 
-            // Reap child
+            // Reap child (a warm worker that reported job.exit lives on)
             int status;
-            waitpid(pid, &status, 0);
-            g_pp_child_pid.store(-1);
-            if (WIFEXITED(status))
-                log_info("daemon: subprocess exited (pid=%d, exit=%d, job=%ld)",
-                         (int)pid, WEXITSTATUS(status), (long)job.job_id);
-            else if (WIFSIGNALED(status))
-                log_info("daemon: subprocess killed (pid=%d, signal=%d, job=%ld)",
-                         (int)pid, WTERMSIG(status), (long)job.job_id);
+            if (job_exited) {
+                // stderr may still hold the job's last lines.
+                struct pollfd perr = {slot.proc.stderr_fd, POLLIN, 0};
+                while (nfds == 2 && poll(&perr, 1, 50) > 0 && (perr.revents & POLLIN) &&
+                       read_stderr(perr.fd) > 0) {}
+                status = W_EXITCODE(exit_code & 0xff, 0);
+                slot.child_pid.store(-1);
+                ++slot.proc.jobs;
+                log_info("daemon: pp worker finished job=%ld (pid=%d, exit=%d, rss=%lld MB, "
+                         "peak=%lld MB, jobs=%d)",
+                         (long)job.job_id, (int)pid, exit_code, (long long)(exit_rss_kb / 1024),
+                         (long long)(std::max(exit_peak_rss_kb, peak_rss_kb) / 1024),
+                         slot.proc.jobs);
+                if (nfds != 2)
+                    retire_pp_worker(slot.proc, "output closed");
+                else if (pp_worker_should_retire(slot.proc.jobs, job.cfg.pp_worker_jobs, exit_code,
+                                                 static_cast<long>(exit_rss_kb),
+                                                 job.cfg.pp_worker_rss_mb))
+                    retire_pp_worker(slot.proc, exit_code != 0 ? "job failed"
+                                     : slot.proc.jobs >= job.cfg.pp_worker_jobs ? "job limit"
+                                     : "RSS limit");
+            } else {
+                waitpid(pid, &status, 0);
+                slot.child_pid.store(-1);
+                if (slot.proc.stdin_fd >= 0) close(slot.proc.stdin_fd);
+                slot.proc = PpChild{};
+                if (WIFEXITED(status))
+                    log_info("daemon: subprocess exited (pid=%d, exit=%d, job=%ld, peak=%lld MB)",
+                             (int)pid, WEXITSTATUS(status), (long)job.job_id,
+                             (long long)(peak_rss_kb / 1024));
+                else if (WIFSIGNALED(status))
+                    log_info("daemon: subprocess killed (pid=%d, signal=%d, job=%ld)",
+                             (int)pid, WTERMSIG(status), (long)job.job_id);
+            }
 
             // Clean up config file
             {
@@ -722,7 +1767,14 @@ static void pp_worker_loop(IpcServer& server) {
             }
 
             // Interpret result
+            observe_child_peak_rss(static_cast<long>(std::max(exit_peak_rss_kb, peak_rss_kb)));
             if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+                count_pp_outcome("succeeded");
+                set_worker_job_state(job.job_id, "done");
+                file_job_perf(job, job_perf,
+                              std::chrono::duration<double>(
+                                  std::chrono::steady_clock::now() - job_started).count(),
+                              static_cast<long>(std::max(exit_peak_rss_kb, peak_rss_kb)));
                 int64_t jid = job.job_id;
                 bool batch_job = job.cfg.batch_mode;
                 server.post([&server, captured_note_path, captured_output_dir, jid, batch_job]() {
@@ -736,6 +1788,25 @@ static void pp_worker_loop(IpcServer& server) {
                 });
             } else if (WIFEXITED(status) && WEXITSTATUS(status) == 2) {
                 log_info("Postprocessing cancelled for job %ld", (long)job.job_id);
+                count_pp_outcome("cancelled");
+                set_worker_job_state(job.job_id, "cancelled");
+                broadcast_job_failed(server, job.job_id, "Cancelled");
+            } else if (!cancelled && !job.deferred && WIFEXITED(status) &&
+                       WEXITSTATUS(status) == PP_EXIT_DEFERRED) {
+                log_info("daemon: job=%ld deferred its summary; queued to finish in a fresh "
+                         "process", (long)job.job_id);
+                job.deferred = true;
+                interrupted = true;
+                count_pp_outcome("deferred");
+            } else if (!cancelled && job.attempt < PP_MAX_ATTEMPTS &&
+                       pp_job_interrupted(status, last_stderr_line)) {
+                log_warn("daemon: job=%ld interrupted (%s); queued to resume from its last "
+                         "completed stage", (long)job.job_id,
+                         killed_stale ? "stalled" : WIFSIGNALED(status) ? strsignal(WTERMSIG(status))
+                                                                          : "RSS limit");
+                ++job.attempt;
+                interrupted = true;
+                count_pp_outcome("interrupted");
             } else {
                 std::string msg;
                 if (killed_stale) {
@@ -759,15 +1830,46 @@ static void pp_worker_loop(IpcServer& server) {
                 log_error("daemon: %s", msg.c_str());
                 notify("Postprocessing failed", msg);
                 broadcast_state(server, msg);
+                count_pp_outcome("failed");
+                set_worker_job_state(job.job_id, "failed", msg);
+                broadcast_job_failed(server, job.job_id, msg);
             }
         }
 
     clear_state:
+        slot.child_pid.store(-1);
+        slot.job_id.store(0);
         {
-            std::lock_guard<std::mutex> lock(g_state_mu);
-            g_postprocessing.store(false);
-            log_debug("daemon: state postprocessing=false");
+            // Postprocessing ends with the last running job and an empty
+            // queue; g_state_mu nests inside g_queue_mu.
+            std::lock_guard<std::mutex> lock(g_queue_mu);
+            slot.busy = false;
+            slot.warm = slot.proc.pid > 0;
+            slot.paused.store(false);
+            slot.out_dir.clear();
+            slot.inputs = MeetingManifest{};
+            // A job cut short by shutdown stays journaled for the next start,
+            // and so does one whose meeting has another run queued.
+            const bool draining = g_pp_draining.load();
+            const bool meeting_queued =
+                std::any_of(g_job_queue.begin(), g_job_queue.end(), [&job](const PostprocessJob& q) {
+                    return same_meeting_dir(q.input.out_dir, job.input.out_dir);
+                });
+            if (interrupted && !draining) {
+                enqueue_pp_job(std::move(job));
+            } else if (!draining && !meeting_queued) {
+                unjournal_pp_job(job);
+            }
+            pp_resume_paused();
+            bool idle = g_job_queue.empty();
+            for (const auto& other : g_pp_slots) idle = idle && !other->busy;
+            if (idle) {
+                std::lock_guard<std::mutex> state_lock(g_state_mu);
+                g_postprocessing.store(false);
+                log_debug("daemon: state postprocessing=false");
+            }
         }
+        g_queue_cv.notify_all();
         broadcast_state(server);
     }
 }
@@ -788,6 +1890,12 @@ static void print_usage() {
         "  --log-level LEVEL   Log level: none, error, warn, info, debug (default: info)\n"
         "  --log-dir DIR       Log file directory\n"
         "  --log-retention N   Log retention in hours (default: 4)\n"
+        "  --pp-max-jobs N     Postprocessing jobs run at once, memory permitting\n"
+        "                      (default: postprocess.max_jobs)\n"
+        "  --worker            Run postprocessing for other daemons' remote_worker\n"
+        "                      (use with a TCP --listen address)\n"
+        "  --trace-out FILE    Write a Perfetto/Chrome trace of this run to FILE on exit\n"
+        "                      (postprocessing children write FILE's .ppN siblings)\n"
         "  -h, --help          Show this help\n"
         "  -v, --version       Show version\n"
     );
@@ -802,6 +1910,8 @@ int main(int argc, char* argv[]) {
     std::string log_level_str = "info";
     fs::path log_dir;
     int log_retention_hours = 4;
+    int pp_max_jobs = 0;  // 0 = postprocess.max_jobs
+    bool worker = false;  // serve worker.* (remote_worker.h)
 
     // Env var override (between default and CLI)
     if (const char* env = std::getenv("RECMEET_LOG_LEVEL"))
@@ -816,6 +1926,9 @@ int main(int argc, char* argv[]) {
         if (arg == "--log-level" && i + 1 < argc) { log_level_str = argv[++i]; continue; }
         if (arg == "--log-dir" && i + 1 < argc) { log_dir = argv[++i]; continue; }
         if (arg == "--log-retention" && i + 1 < argc) { log_retention_hours = std::atoi(argv[++i]); continue; }
+        if (arg == "--pp-max-jobs" && i + 1 < argc) { pp_max_jobs = std::atoi(argv[++i]); continue; }
+        if (arg == "--worker") { worker = true; continue; }
+        if (arg == "--trace-out" && i + 1 < argc) { g_trace_out = argv[++i]; continue; }
         fprintf(stderr, "Unknown option: %s\n", arg.c_str());
         return 1;
     }
@@ -856,14 +1969,14 @@ int main(int argc, char* argv[]) {
     auto log_level = parse_log_level(log_level_str);
     log_init(log_level, log_dir, log_retention_hours, true);
     log_info("daemon: starting (socket=%s)", socket_path.c_str());
+    if (!g_trace_out.empty()) trace_start(g_trace_out);
 
     // Discover runtime-loadable ggml backends (libggml-vulkan.so / libggml-cpu-*.so
     // installed alongside the binary) and surface which device the daemon will
     // use, so `journalctl --user -u recmeet-daemon.service` answers the GPU-or-CPU
     // question without an `ldd` round-trip. See agentctx/tasks/runtime-loadable-
     // gpu-backends.md (Step 4) and auto-detect-vulkan-backend.md (Step 5).
-    load_backends();
-    log_backend_summary();
+    ensure_backends();
 
     // Suppress whisper output
     whisper_log_set(whisper_null_log, nullptr);
@@ -900,6 +2013,40 @@ int main(int argc, char* argv[]) {
     // Create server
     IpcServer server(socket_path);
     g_server = &server;
+    server.set_partial_rate(g_config.caption_partial_hz);
+
+    try {
+        g_levels = std::make_unique<LevelFeed>(LevelFeed::default_name());
+    } catch (const RecmeetError& e) {
+        log_warn("daemon: no live level feed (%s)", e.what());
+    }
+
+    // Follow device hotplug; record.start and sources.list then read the
+    // cache instead of enumerating.
+    g_sources = std::make_unique<SourceRegistry>(
+        [&server](const std::vector<AudioSource>& sources, const std::string& default_source) {
+            IpcEvent ev;
+            ev.event = "sources.changed";
+            fill_sources(ev.data, sources);
+            ev.data["default"] = default_source;
+            server.post([&server, ev]() { server.broadcast(ev); });
+        });
+    if (!g_sources->start()) {
+        log_warn("daemon: cannot watch audio devices; enumerating them per request");
+        g_sources.reset();
+    }
+
+    set_model_hugepages(g_config.model_hugepages);
+    set_thread_budget(g_config.threads);  // live whisper / diarization lease from it
+
+    // With captions on, load their recognizer now, so the first recording's
+    // captions start without the model load.
+    prewarm_captions(g_config);
+
+    // Settle which backend each configured model runs on before the first
+    // job asks; a model measured before costs only a cache lookup.
+    if (g_config.backend_bench && active_backend_is_gpu())
+        g_backend_bench_worker = std::thread([cfg = g_config]() { bench_configured_backends(cfg); });
 
     // --- Method handlers ---
 
@@ -908,24 +2055,53 @@ int main(int argc, char* argv[]) {
         {
             std::lock_guard<std::mutex> lock(g_queue_mu);
             resp.result["queue_depth"] = static_cast<int64_t>(g_job_queue.size());
+            int64_t running = 0;
+            int64_t paused = 0;
+            for (const auto& slot : g_pp_slots) {
+                if (!slot->busy) continue;
+                if (slot->paused.load()) ++paused;
+                else ++running;
+            }
+            resp.result["pp_jobs_running"] = running;
+            resp.result["pp_jobs_paused"] = paused;
+        }
+        CaptionStats caption_stats;
+        if (caption_engine_stats(caption_stats))
+            add_caption_stats(resp.result, caption_stats);
+        return true;
+    });
+
+    // OpenMetrics text of metrics() (metrics.h), for recmeet-web's /metrics.
+    // The queue gauges are read at each call.
+    server.on("metrics.get", [](const IpcRequest&, IpcResponse& resp, IpcError&) {
+        static MetricGauge& depth = metrics().gauge("recmeet_pp_queue_depth",
+                                                    "Postprocessing jobs waiting for a slot.");
+        static MetricGauge& running = metrics().gauge("recmeet_pp_jobs_running",
+                                                      "Postprocessing jobs running.");
+        static MetricGauge& paused = metrics().gauge("recmeet_pp_jobs_paused",
+                                                     "Batch jobs paused for a live meeting.");
+        {
+            std::lock_guard<std::mutex> lock(g_queue_mu);
+            depth.set(static_cast<int64_t>(g_job_queue.size()));
+            int64_t n_running = 0;
+            int64_t n_paused = 0;
+            for (const auto& slot : g_pp_slots) {
+                if (!slot->busy) continue;
+                if (slot->paused.load()) ++n_paused;
+                else ++n_running;
+            }
+            running.set(n_running);
+            paused.set(n_paused);
         }
+        resp.result["text"] = metrics().render();
+        resp.result["content_type"] = std::string(OPENMETRICS_CONTENT_TYPE);
         return true;
     });
 
     server.on("sources.list", [](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
         try {
-            auto sources = list_sources();
-            // Return as a JSON array string in result
-            std::string arr = "[";
-            for (size_t i = 0; i < sources.size(); ++i) {
-                if (i > 0) arr += ",";
-                arr += "{\"name\":\"" + json_escape(sources[i].name)
-                    + "\",\"description\":\"" + json_escape(sources[i].description)
-                    + "\",\"is_monitor\":" + (sources[i].is_monitor ? "true" : "false") + "}";
-            }
-            arr += "]";
-            resp.result["sources"] = arr;
-            resp.result["count"] = static_cast<int64_t>(sources.size());
+            // From g_sources' cache while it is connected.
+            fill_sources(resp.result, list_sources());
             return true;
         } catch (const std::exception& e) {
             err.code = static_cast<int>(IpcErrorCode::InternalError);
@@ -934,19 +2110,11 @@ int main(int argc, char* argv[]) {
         }
     });
 
-    server.on("config.reload", [](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
+    server.on("config.reload", [&server](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
         try {
-            Config cfg = load_config();
-            if (cfg.llm_model.empty()) {
-                const auto* prov = find_provider(cfg.provider);
-                if (prov) {
-                    std::string key = resolve_api_key(*prov, cfg.api_keys, cfg.api_key);
-                    if (!key.empty()) cfg.api_key = key;
-                }
-            }
-            std::lock_guard<std::mutex> lock(g_config_mu);
-            g_config = cfg;
+            const ConfigReloadPlan plan = apply_config(server, load_daemon_config(), "config.reload");
             resp.result["ok"] = true;
+            add_config_reload(resp.result, plan);
             return true;
         } catch (const std::exception& e) {
             err.code = static_cast<int>(IpcErrorCode::InternalError);
@@ -955,14 +2123,18 @@ int main(int argc, char* argv[]) {
         }
     });
 
-    server.on("config.update", [](const IpcRequest& req, IpcResponse& resp, IpcError&) {
-        std::lock_guard<std::mutex> lock(g_config_mu);
+    server.on("config.update", [&server](const IpcRequest& req, IpcResponse& resp, IpcError&) {
         // Apply params as config overrides
-        JsonMap merged = config_to_map(g_config);
+        JsonMap merged;
+        {
+            std::lock_guard<std::mutex> lock(g_config_mu);
+            merged = config_to_map(g_config);
+        }
         for (const auto& [k, v] : req.params)
             merged[k] = v;
-        g_config = config_from_map(merged);
+        const ConfigReloadPlan plan = apply_config(server, config_from_map(merged), "config.update");
         resp.result["ok"] = true;
+        add_config_reload(resp.result, plan);
         return true;
     });
 
@@ -1015,6 +2187,66 @@ int main(int argc, char* argv[]) {
             return false;
         }
 
+        // A reprocess of a meeting that already has a job joins it: the
+        // queued one takes this config, or the running one computing the
+        // same inputs is followed. Either way the client gets its job_id.
+        MeetingManifest reprocess_inputs;
+        if (is_reprocess) {
+            reprocess_inputs = expected_meeting_manifest(cfg, cfg.reprocess_dir, "");
+            const PpFootprint footprint =
+                estimate_job_footprint(cfg, find_audio_file(cfg.reprocess_dir));
+            int64_t joined = 0;
+            const char* how = "";
+            {
+                std::lock_guard<std::mutex> lock(g_queue_mu);
+                auto queued = std::find_if(g_job_queue.begin(), g_job_queue.end(),
+                                           [&cfg](const PostprocessJob& job) {
+                                               return same_meeting_dir(job.input.out_dir,
+                                                                       cfg.reprocess_dir);
+                                           });
+                const PpSlot* running = pp_slot_running(cfg.reprocess_dir);
+                switch (pp_coalesce(queued != g_job_queue.end(), running != nullptr,
+                                    running && same_manifest_inputs(running->inputs,
+                                                                    reprocess_inputs))) {
+                case PpCoalesce::Queued: {
+                    PostprocessJob job = std::move(*queued);
+                    g_job_queue.erase(queued);
+                    job.cfg = cfg;
+                    job.inputs = reprocess_inputs;
+                    job.footprint = footprint;
+                    job.job_class = std::min(job.job_class, pp_job_class(cfg));
+                    joined = job.job_id;
+                    how = "queued";
+                    journal_pp_job(job);
+                    enqueue_pp_job(std::move(job));
+                    break;
+                }
+                case PpCoalesce::Running:
+                    joined = running->job_id.load();
+                    how = "running";
+                    break;
+                case PpCoalesce::Enqueue:
+                    break;
+                }
+            }
+            if (joined != 0) {
+                {
+                    std::lock_guard<std::mutex> lock(g_state_mu);
+                    g_recording.store(false);
+                }
+                log_info("daemon: record.start (mode=reprocess) joins %s job=%ld for %s", how,
+                         (long)joined, cfg.reprocess_dir.c_str());
+                metrics().counter("recmeet_pp_coalesced",
+                                  "Reprocess requests folded into a job for the same meeting.",
+                                  metric_label("job", how)).add();
+                g_queue_cv.notify_all();
+                resp.result["ok"] = true;
+                resp.result["job_id"] = joined;
+                resp.result["coalesced"] = std::string(how);
+                return true;
+            }
+        }
+
         // Assign job_id for this recording
         int64_t job_id = g_next_job_id.fetch_add(1);
         log_info("daemon: record.start (mode=%s, job=%ld)",
@@ -1030,8 +2262,36 @@ int main(int argc, char* argv[]) {
         // Join any previous recording worker
         if (g_rec_worker.joinable()) g_rec_worker.join();
 
-        g_rec_worker = std::thread([&server, cfg, is_reprocess, job_id]() {
+        // The recording's postprocessing starts the moment it stops; have
+        // its models in the page cache by then. One still running from the
+        // last recording is left to finish (its files are most likely the
+        // same) rather than joined on this thread.
+        if (!is_reprocess && !g_prefetch_running.load()) {
+            if (g_prefetch_worker.joinable()) g_prefetch_worker.join();
+            g_prefetch_running.store(true);
+            g_prefetch_worker = std::thread([files = postprocess_model_files(cfg)]() {
+                prefetch_model_files(files, g_prefetch_stop);
+                g_prefetch_running.store(false);
+            });
+        }
+
+        // transcribe.clip answers in a second or two only with its model
+        // loaded; load it now, beside the capture. Dropped as the
+        // recording ends (the rec_worker's ClipRelease).
+        set_model_hugepages(cfg.model_hugepages);
+        set_thread_budget(cfg.threads);
+        if (!is_reprocess && !cfg.clip_model.empty()) {
+            if (g_clip_warm_worker.joinable()) g_clip_warm_worker.join();
+            g_clip_warm_worker = std::thread([model = cfg.clip_model, gpu = cfg.whisper_gpu]() {
+                g_clip.warm(model, gpu);
+            });
+        }
+
+        g_rec_worker = std::thread([&server, cfg, is_reprocess, job_id, reprocess_inputs]() {
             log_debug("daemon: rec_worker ENTER (tid=%d, job=%ld)", (int)syscall(SYS_gettid), (long)job_id);
+            struct ClipRelease {
+                ~ClipRelease() { g_clip.release(); }
+            } clip_release;
             auto on_phase = [&server](const std::string& phase) {
                 server.post([&server, phase]() {
                     IpcEvent ev;
@@ -1067,22 +2327,35 @@ int main(int argc, char* argv[]) {
                 std::string text = r.text;
                 bool is_partial = r.is_partial;
                 int64_t ts = r.timestamp_ms;
-                s->post([s, jid, text, is_partial, ts]() {
-                    s->broadcast(make_caption_event(jid, text, is_partial, ts));
-                });
+                std::string source = caption_source_name(r.source);
+                // Partials supersede each other; see IpcServer::post_partial().
+                std::string key = std::to_string(jid) + ":" + source;
+                IpcEvent ev = make_caption_event(jid, text, is_partial, ts, source);
+                if (is_partial)
+                    s->post_partial(key, std::move(ev));
+                else
+                    s->post_final(key, std::move(ev));
             };
             hooks.on_degraded = +[](CaptionDegradedReason reason, void* ud) {
                 auto* c = static_cast<CaptionBroadcastCtx*>(ud);
                 IpcServer* s = c->server;
                 int64_t jid = c->job_id;
                 const char* reason_str =
-                    (reason == CaptionDegradedReason::BufferOverrun) ? "buffer_overrun"
-                                                                     : "unknown";
+                    (reason == CaptionDegradedReason::BufferOverrun)  ? "buffer_overrun"
+                    : (reason == CaptionDegradedReason::Int8Fallback) ? "int8_fallback"
+                    : (reason == CaptionDegradedReason::FinalsOnly)   ? "finals_only"
+                    : (reason == CaptionDegradedReason::ReducedDecode) ? "reduced_decode"
+                                                                      : "unknown";
                 int64_t ts = std::chrono::duration_cast<std::chrono::milliseconds>(
                     std::chrono::steady_clock::now().time_since_epoch()).count();
                 std::string r_str(reason_str);
-                s->post([s, jid, r_str, ts]() {
-                    s->broadcast(make_caption_degraded_event(jid, r_str, ts));
+                // Runs on the engine's worker, while the engine is published.
+                CaptionStats stats;
+                const bool have_stats = caption_engine_stats(stats);
+                s->post([s, jid, r_str, ts, stats, have_stats]() {
+                    IpcEvent ev = make_caption_degraded_event(jid, r_str, ts);
+                    if (have_stats) add_caption_stats(ev.data, stats);
+                    s->broadcast(ev);
                 });
             };
             hooks.on_engine_error = +[](const std::string& msg, void* ud) {
@@ -1121,7 +2394,7 @@ int main(int argc, char* argv[]) {
                 // handler + caption_start_channel gate engine startup, not
                 // the hook pointer's presence.
                 auto input = run_recording(cfg, g_rec_stop, g_rec_cancel,
-                                           on_phase, &hooks);
+                                           on_phase, &hooks, g_levels.get());
 
                 // Cancel branch (rev 4 / cancel-recording-and-discard): the
                 // operator issued `record.cancel`, run_recording stopped
@@ -1173,11 +2446,16 @@ int main(int argc, char* argv[]) {
                 job.job_id = job_id;
                 job.input = std::move(input);
                 job.cfg = job_cfg;
+                job.footprint = estimate_job_footprint(job.cfg, job.input.audio_path);
+                job.job_class = pp_job_class(job.cfg);
+                job.inputs = reprocess_inputs;
 
-                log_debug("daemon: rec_worker handoff to pp (job=%ld)", (long)job_id);
+                log_debug("daemon: rec_worker handoff to pp (job=%ld, class=%s)", (long)job_id,
+                          pp_job_class_name(job.job_class));
+                journal_pp_job(job);
                 {
                     std::lock_guard<std::mutex> qlock(g_queue_mu);
-                    g_job_queue.push(std::move(job));
+                    enqueue_pp_job(std::move(job));
                 }
 
                 // Atomic handoff: set postprocessing BEFORE clearing recording
@@ -1194,8 +2472,8 @@ int main(int argc, char* argv[]) {
                 });
                 broadcast_state(server);
 
-                // Wake the pp worker
-                g_queue_cv.notify_one();
+                // Wake the pp slots
+                g_queue_cv.notify_all();
                 log_debug("daemon: rec_worker EXIT (job=%ld)", (long)job_id);
 
             } catch (const std::exception& e) {
@@ -1210,6 +2488,7 @@ int main(int argc, char* argv[]) {
                     g_is_reprocess = false;
                 });
                 broadcast_state(server, e.what());
+                broadcast_job_failed(server, job_id, e.what());
                 log_debug("daemon: rec_worker EXIT (job=%ld)", (long)job_id);
             }
         });
@@ -1219,7 +2498,7 @@ int main(int argc, char* argv[]) {
         return true;
     });
 
-    server.on("record.stop", [](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
+    server.on("record.stop", [&server](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
         // Parse optional target param: "recording", "postprocessing", "all" (default)
         std::string target = "all";
         {
@@ -1252,16 +2531,32 @@ int main(int argc, char* argv[]) {
                 err.message = "Not postprocessing";
                 return false;
             }
-            g_pp_stop.request();
-            { pid_t child = g_pp_child_pid.load(); if (child > 0) kill(child, SIGTERM); }
+            // Optional job_id: that job only, running or still queued.
+            // Without it every running job stops; queued ones still run.
+            int64_t job_id = 0;
+            auto job_it = req.params.find("job_id");
+            if (job_it != req.params.end()) {
+                job_id = json_val_as_int(job_it->second, -1);
+                if (job_id <= 0) {
+                    err.code = static_cast<int>(IpcErrorCode::InvalidParams);
+                    err.message = "job_id must be a positive integer";
+                    return false;
+                }
+            }
+            if (cancel_running_pp_jobs(job_id, true) == 0 && job_id != 0) {
+                bool idle = false;
+                if (!drop_queued_pp_job(job_id, idle)) {
+                    err.code = static_cast<int>(IpcErrorCode::InvalidParams);
+                    err.message = "No postprocessing job " + std::to_string(job_id);
+                    return false;
+                }
+                broadcast_job_failed(server, job_id, "Cancelled");
+                if (idle) broadcast_state_inline(server);
+            }
         } else {
             // "all" — stop everything
             if (rec) g_rec_stop.request();
-            if (pp) {
-                g_pp_stop.request();
-                pid_t child = g_pp_child_pid.load();
-                if (child > 0) kill(child, SIGTERM);
-            }
+            if (pp) cancel_running_pp_jobs(0, true);
         }
 
         resp.result["ok"] = true;
@@ -1332,6 +2627,184 @@ int main(int argc, char* argv[]) {
         return true;
     });
 
+    // captions.configure — per-connection caption delivery. `max_partial_hz`
+    // caps the partials this client gets per caption source (0 = every
+    // one); `partial_format` "delta" sends each partial as the bytes to
+    // keep from the previous one plus the new tail. Finals are unaffected.
+    server.on("captions.configure",
+              [&server](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
+        int max_hz = -1;
+        auto hz_it = req.params.find("max_partial_hz");
+        if (hz_it != req.params.end()) {
+            max_hz = static_cast<int>(json_val_as_int(hz_it->second, -1));
+            if (max_hz < 0) {
+                err.code = static_cast<int>(IpcErrorCode::InvalidParams);
+                err.message = "max_partial_hz must be a non-negative integer";
+                return false;
+            }
+        }
+        std::string format = "full";
+        auto fmt_it = req.params.find("partial_format");
+        if (fmt_it != req.params.end()) format = json_val_as_string(fmt_it->second);
+        if (format != "full" && format != "delta") {
+            err.code = static_cast<int>(IpcErrorCode::InvalidParams);
+            err.message = "partial_format must be \"full\" or \"delta\"";
+            return false;
+        }
+        server.configure_partials(server.current_client(), max_hz, format == "delta");
+        resp.result["ok"] = true;
+        return true;
+    });
+
+    // events.subscribe — per-connection event filter. `topics` is a
+    // comma-separated list or JSON array of event names or prefixes
+    // ("caption" also covers "caption.degraded"); omitted, every event.
+    // `job_id` > 0 also drops events about other jobs. Replaces the
+    // connection's previous filter.
+    server.on("events.subscribe",
+              [&server](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
+        std::vector<std::string> topics{"*"};
+        auto topics_it = req.params.find("topics");
+        if (topics_it != req.params.end()) {
+            if (!std::holds_alternative<std::string>(topics_it->second)) {
+                err.code = static_cast<int>(IpcErrorCode::InvalidParams);
+                err.message = "topics must be a list of event names";
+                return false;
+            }
+            topics.clear();
+            std::string topic;
+            for (char c : json_val_as_string(topics_it->second) + ",") {
+                if (c == ',') {
+                    if (!topic.empty()) topics.push_back(topic);
+                    topic.clear();
+                } else if (c != '[' && c != ']' && c != '"' && c != ' ') {
+                    topic += c;
+                }
+            }
+        }
+        int64_t job_id = 0;
+        auto job_it = req.params.find("job_id");
+        if (job_it != req.params.end()) {
+            job_id = json_val_as_int(job_it->second, -1);
+            if (job_id < 0) {
+                err.code = static_cast<int>(IpcErrorCode::InvalidParams);
+                err.message = "job_id must be a non-negative integer";
+                return false;
+            }
+        }
+        server.subscribe(server.current_client(), std::move(topics), job_id);
+        resp.result["ok"] = true;
+        return true;
+    });
+
+    server.on("levels.info", [](const IpcRequest&, IpcResponse& resp, IpcError& err) {
+        if (!g_levels) {
+            err.code = static_cast<int>(IpcErrorCode::InternalError);
+            err.message = "level feed unavailable";
+            return false;
+        }
+        resp.result["shm"] = g_levels->name();
+        resp.result["version"] = static_cast<int64_t>(LEVEL_FEED_VERSION);
+        resp.result["sources"] = std::string("mic,monitor");
+        resp.result["bands"] = static_cast<int64_t>(LEVEL_BANDS);
+        return true;
+    });
+
+    // Transcribe the last `seconds` of the recording in progress, or
+    // `duration_sec` of the file `path` from `start_sec`. Answers with the
+    // clip's id; the text follows as a clip.transcribed event.
+    server.on("transcribe.clip", [&server](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
+        Config cfg;
+        {
+            std::lock_guard<std::mutex> lock(g_config_mu);
+            cfg = g_config;
+        }
+        if (cfg.clip_model.empty()) {
+            err.code = static_cast<int>(IpcErrorCode::InvalidRequest);
+            err.message = "transcribe.clip is off (transcription.clip_model is empty)";
+            return false;
+        }
+        auto param = [&req](const char* key) -> const JsonVal* {
+            auto it = req.params.find(key);
+            return it != req.params.end() ? &it->second : nullptr;
+        };
+        const std::string path = param("path") ? json_val_as_string(*param("path")) : "";
+        const double seconds = path.empty()
+            ? (param("seconds") ? json_val_as_double(*param("seconds")) : CLIP_DEFAULT_SECONDS)
+            : (param("duration_sec") ? json_val_as_double(*param("duration_sec"))
+                                     : CLIP_DEFAULT_SECONDS);
+        const double from = param("start_sec") ? json_val_as_double(*param("start_sec")) : 0.0;
+        if (!(seconds > 0 && seconds <= CLIP_MAX_SECONDS) || !(from >= 0)) {
+            err.code = static_cast<int>(IpcErrorCode::InvalidParams);
+            err.message = "clip length must be in (0, " +
+                          std::to_string(static_cast<int>(CLIP_MAX_SECONDS)) + "] seconds";
+            return false;
+        }
+
+        std::vector<float> samples;
+        double start_sec = 0;
+        if (path.empty()) {
+            if (!read_recording_tail(seconds, samples, start_sec)) {
+                err.code = static_cast<int>(IpcErrorCode::NotRecording);
+                err.message = "No active recording (pass path to transcribe a file)";
+                return false;
+            }
+        } else {
+            try {
+                AudioView audio(path);
+                const auto first = static_cast<size_t>(std::llround(from * SAMPLE_RATE));
+                samples = audio.window(first, static_cast<size_t>(std::llround(seconds * SAMPLE_RATE)));
+                start_sec = static_cast<double>(first) / SAMPLE_RATE;
+            } catch (const std::exception& e) {
+                err.code = static_cast<int>(IpcErrorCode::InvalidParams);
+                err.message = e.what();
+                return false;
+            }
+        }
+        if (samples.empty()) {
+            err.code = static_cast<int>(IpcErrorCode::InvalidParams);
+            err.message = "No audio in the requested range";
+            return false;
+        }
+
+        if (g_clip_busy.exchange(true)) {
+            err.code = static_cast<int>(IpcErrorCode::Busy);
+            err.message = "A clip is already being transcribed";
+            return false;
+        }
+        if (g_clip_worker.joinable()) g_clip_worker.join();  // done: busy was clear
+
+        const int64_t clip_id = g_next_clip_id.fetch_add(1);
+        const double duration_sec = static_cast<double>(samples.size()) / SAMPLE_RATE;
+        g_clip_worker = std::thread([&server, cfg, clip_id, start_sec, duration_sec,
+                                     samples = std::move(samples)]() {
+            const auto t0 = std::chrono::steady_clock::now();
+            IpcEvent ev;
+            try {
+                const auto result = g_clip.transcribe(cfg.clip_model, cfg.whisper_gpu,
+                                                      samples.data(), samples.size(), start_sec,
+                                                      cfg.language, cfg.threads);
+                const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - t0).count();
+                log_info("daemon: clip %ld: %.1f s transcribed in %ld ms", (long)clip_id,
+                         duration_sec, (long)elapsed_ms);
+                ev = make_clip_transcribed_event(clip_id, clip_text(result), start_sec,
+                                                 duration_sec, elapsed_ms);
+            } catch (const std::exception& e) {
+                log_warn("daemon: clip %ld failed: %s", (long)clip_id, e.what());
+                ev = make_clip_failed_event(clip_id, e.what());
+            }
+            server.post([&server, ev]() { server.broadcast(ev); });
+            g_clip_busy.store(false);
+        });
+
+        resp.result["ok"] = true;
+        resp.result["clip_id"] = clip_id;
+        resp.result["start_sec"] = start_sec;
+        resp.result["duration_sec"] = duration_sec;
+        return true;
+    });
+
     server.on("job.context", [](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
         if (!g_recording.load()) {
             err.code = static_cast<int>(IpcErrorCode::NotRecording);
@@ -1423,6 +2896,37 @@ int main(int argc, char* argv[]) {
         }
     });
 
+    // Rewrite a meeting's note with its current speaker labels, from the
+    // note stage. Runs on the IPC thread: it loads no model and takes
+    // milliseconds.
+    server.on("note.rerender", [](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
+        auto it = req.params.find("dir");
+        if (it == req.params.end() || json_val_as_string(it->second).empty()) {
+            err.code = static_cast<int>(IpcErrorCode::InvalidParams);
+            err.message = "Missing 'dir' parameter";
+            return false;
+        }
+        const fs::path dir = json_val_as_string(it->second);
+        Config cfg;
+        {
+            std::lock_guard<std::mutex> lock(g_config_mu);
+            cfg = g_config;
+        }
+        try {
+            resp.result["note"] = rerender_meeting_note(cfg, dir).string();
+            resp.result["ok"] = true;
+            return true;
+        } catch (const RecmeetError& e) {
+            err.code = static_cast<int>(IpcErrorCode::InvalidParams);
+            err.message = e.what();
+            return false;
+        } catch (const std::exception& e) {
+            err.code = static_cast<int>(IpcErrorCode::InternalError);
+            err.message = e.what();
+            return false;
+        }
+    });
+
     // --- Model management handlers ---
 
     server.on("models.list", [](const IpcRequest&, IpcResponse& resp, IpcError&) {
@@ -1432,6 +2936,7 @@ int main(int argc, char* argv[]) {
             if (i > 0) arr += ",";
             arr += "{\"name\":\"" + json_escape(models[i].name)
                 + "\",\"category\":\"" + json_escape(models[i].category)
+                + "\",\"variant\":\"" + json_escape(models[i].variant)
                 + "\",\"cached\":" + (models[i].cached ? "true" : "false")
                 + ",\"size_bytes\":" + std::to_string(models[i].size_bytes)
                 + ",\"path\":\"" + json_escape(models[i].path) + "\"}";
@@ -1471,6 +2976,7 @@ int main(int argc, char* argv[]) {
 
         g_dl_worker = std::thread([&server, whisper_model, want_sherpa, want_vad]() {
             log_debug("daemon: dl_worker ENTER (tid=%d)", (int)syscall(SYS_gettid));
+            const ScopedDownloadProgress progress(download_progress_broadcaster(server));
             auto broadcast_dl = [&server](const std::string& model, const std::string& status) {
                 server.post([&server, model, status]() {
                     IpcEvent ev;
@@ -1481,35 +2987,39 @@ int main(int argc, char* argv[]) {
                 });
             };
 
-            try {
-                if (!is_whisper_model_cached(whisper_model)) {
-                    broadcast_dl("whisper/" + whisper_model, "downloading");
-                    ensure_whisper_model(whisper_model);
-                    broadcast_dl("whisper/" + whisper_model, "complete");
-                }
-
-#if RECMEET_USE_SHERPA
-                if (want_sherpa && !is_sherpa_model_cached()) {
-                    broadcast_dl("sherpa/diarization", "downloading");
-                    ensure_sherpa_models();
-                    broadcast_dl("sherpa/diarization", "complete");
-                }
-                if (want_vad && !is_vad_model_cached()) {
-                    broadcast_dl("vad", "downloading");
-                    ensure_vad_model();
-                    broadcast_dl("vad", "complete");
-                }
-#endif
-            } catch (const std::exception& e) {
-                log_error("daemon: model download failed: %s", e.what());
-                server.post([&server, what = std::string(e.what())]() {
+            auto broadcast_error = [&server](const std::string& model, const std::string& what) {
+                log_error("daemon: model download failed: %s", what.c_str());
+                server.post([&server, model, what]() {
                     IpcEvent ev;
                     ev.event = "model.downloading";
+                    if (!model.empty()) ev.data["model"] = model;
                     ev.data["status"] = std::string("error");
                     ev.data["error"] = what;
                     server.broadcast(ev);
                 });
+            };
+
+            // The missing models download side by side.
+            std::vector<ModelFetch> fetches;
+            try {
+                if (!is_whisper_model_cached(whisper_model))
+                    fetches.push_back({"whisper/" + whisper_model,
+                                       [whisper_model] { ensure_whisper_model(whisper_model); }});
+#if RECMEET_USE_SHERPA
+                if (want_sherpa && !is_sherpa_model_cached())
+                    fetches.push_back({"sherpa/diarization", [] { ensure_sherpa_models(); }});
+                if (want_vad && !is_vad_model_cached())
+                    fetches.push_back({"vad", [] { ensure_vad_model(); }});
+#endif
+            } catch (const std::exception& e) {
+                broadcast_error("", e.what());
             }
+            for (const auto& f : fetches) broadcast_dl(f.label, "downloading");
+            fetch_models_parallel(fetches, MODEL_FETCH_PARALLEL,
+                                  [&](const std::string& label, const std::string& error) {
+                                      if (error.empty()) broadcast_dl(label, "complete");
+                                      else broadcast_error(label, error);
+                                  });
 
             {
                 std::lock_guard<std::mutex> lock(g_state_mu);
@@ -1541,6 +3051,7 @@ int main(int argc, char* argv[]) {
 
         g_dl_worker = std::thread([&server]() {
             log_debug("daemon: dl_worker ENTER (tid=%d)", (int)syscall(SYS_gettid));
+            const ScopedDownloadProgress progress(download_progress_broadcaster(server));
             auto broadcast_dl = [&server](const std::string& model, const std::string& status) {
                 server.post([&server, model, status]() {
                     IpcEvent ev;
@@ -1551,42 +3062,41 @@ int main(int argc, char* argv[]) {
                 });
             };
 
-            auto models = list_cached_models();
+            // Every cached model downloads again, side by side.
+            std::vector<ModelFetch> fetches;
             bool sherpa_updated = false;
-
-            for (const auto& m : models) {
+            for (const auto& m : list_cached_models()) {
                 if (!m.cached) continue;
-
-                try {
-                    std::string label = m.category + "/" + m.name;
-                    if (m.category == "whisper") {
-                        broadcast_dl(label, "downloading");
-                        download_whisper_model(m.name);
-                        broadcast_dl(label, "complete");
-                    }
+                if (m.category == "whisper") {
+                    fetches.push_back({m.category + "/" + m.name,
+                                       [name = m.name] { download_whisper_model(name); }});
+                }
 #if RECMEET_USE_SHERPA
-                    else if (m.category == "sherpa" && !sherpa_updated) {
-                        broadcast_dl("sherpa/diarization", "downloading");
-                        download_sherpa_models();
-                        broadcast_dl("sherpa/diarization", "complete");
-                        sherpa_updated = true;
-                    } else if (m.category == "vad") {
-                        broadcast_dl("vad", "downloading");
-                        download_vad_model();
-                        broadcast_dl("vad", "complete");
-                    }
-#endif
-                } catch (const std::exception& e) {
-                    log_error("daemon: model update failed: %s", e.what());
-                    server.post([&server, what = std::string(e.what())]() {
-                        IpcEvent ev;
-                        ev.event = "model.downloading";
-                        ev.data["status"] = std::string("error");
-                        ev.data["error"] = what;
-                        server.broadcast(ev);
-                    });
+                else if (m.category == "sherpa" && !sherpa_updated) {
+                    fetches.push_back({"sherpa/diarization", [] { download_sherpa_models(); }});
+                    sherpa_updated = true;
+                } else if (m.category == "vad") {
+                    fetches.push_back({"vad", [] { download_vad_model(); }});
                 }
+#endif
             }
+            for (const auto& f : fetches) broadcast_dl(f.label, "downloading");
+            fetch_models_parallel(fetches, MODEL_FETCH_PARALLEL,
+                                  [&](const std::string& label, const std::string& error) {
+                if (error.empty()) {
+                    broadcast_dl(label, "complete");
+                    return;
+                }
+                log_error("daemon: model update failed: %s", error.c_str());
+                server.post([&server, label, error]() {
+                    IpcEvent ev;
+                    ev.event = "model.downloading";
+                    ev.data["model"] = label;
+                    ev.data["status"] = std::string("error");
+                    ev.data["error"] = error;
+                    server.broadcast(ev);
+                });
+            });
 
             {
                 std::lock_guard<std::mutex> lock(g_state_mu);
@@ -1600,6 +3110,93 @@ int main(int argc, char* argv[]) {
         return true;
     });
 
+    if (worker) {
+        WorkerHooks hooks;
+        hooks.run = [&server](const std::string& id, Config cfg, const fs::path& dir,
+                              std::string&) {
+            {
+                std::lock_guard<std::mutex> lock(g_worker_jobs_mu);
+                auto it = g_worker_jobs.find(id);
+                // A retried worker.run for a job it already has.
+                if (it != g_worker_jobs.end() &&
+                    (it->second.state == "queued" || it->second.state == "running"))
+                    return true;
+            }
+            PostprocessJob job;
+            job.job_id = g_next_job_id.fetch_add(1);
+            job.input.out_dir = dir;
+            job.input.audio_path = find_audio_file(dir);
+            {
+                std::lock_guard<std::mutex> lock(g_config_mu);
+                apply_worker_config(cfg, g_config, dir);
+            }
+            job.cfg = std::move(cfg);
+            job.footprint = estimate_job_footprint(job.cfg, job.input.audio_path);
+            job.job_class = pp_job_class(job.cfg);
+            log_info("daemon: worker job=%ld for %s (%s)", (long)job.job_id, id.c_str(),
+                     pp_job_class_name(job.job_class));
+            {
+                std::lock_guard<std::mutex> lock(g_worker_jobs_mu);
+                g_worker_jobs[id] = WorkerJob{job.job_id, "queued", {}};
+            }
+            {
+                std::lock_guard<std::mutex> lock(g_queue_mu);
+                enqueue_pp_job(std::move(job));
+                std::lock_guard<std::mutex> state_lock(g_state_mu);
+                g_postprocessing.store(true);
+            }
+            g_queue_cv.notify_all();
+            broadcast_state_inline(server);
+            return true;
+        };
+        hooks.status = [](const std::string& id) {
+            RemoteJobStatus st;
+            std::lock_guard<std::mutex> lock(g_worker_jobs_mu);
+            auto it = g_worker_jobs.find(id);
+            if (it != g_worker_jobs.end()) {
+                st.state = it->second.state;
+                st.error = it->second.error;
+            }
+            return st;
+        };
+        // Stop the job and forget it.
+        hooks.cancel = [&server](const std::string& id) {
+            int64_t job_id = 0;
+            {
+                std::lock_guard<std::mutex> lock(g_worker_jobs_mu);
+                auto it = g_worker_jobs.find(id);
+                if (it == g_worker_jobs.end()) return;
+                job_id = it->second.job_id;
+                g_worker_jobs.erase(it);
+            }
+            bool idle = false;
+            if (cancel_running_pp_jobs(job_id, true) == 0 && drop_queued_pp_job(job_id, idle) &&
+                idle)
+                broadcast_state_inline(server);
+        };
+        register_worker_methods(server, remote_jobs_dir(), std::move(hooks));
+        log_info("daemon: accepting remote postprocessing jobs in %s",
+                 remote_jobs_dir().c_str());
+    }
+
+    // Remote clients fetch transcripts, notes and audio on the artifact
+    // port (artifact_transfer.h), so large files never queue behind the
+    // control connection's events.
+    std::unique_ptr<ArtifactServer> artifacts;
+    if (listen_addr.transport == IpcTransport::Tcp) {
+        artifacts = std::make_unique<ArtifactServer>([] {
+            std::lock_guard<std::mutex> lock(g_config_mu);
+            return std::vector<fs::path>{g_config.output_dir, g_config.note_dir};
+        });
+        const uint16_t port = artifact_port_for(listen_addr.port);
+        if (port != 0 && artifacts->start(listen_addr.host, port)) {
+            register_artifact_methods(server, *artifacts);
+        } else {
+            log_warn("daemon: no artifact port; remote clients cannot fetch files");
+            artifacts.reset();
+        }
+    }
+
     // --- Start server ---
 
     if (!server.start()) {
@@ -1609,8 +3206,40 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    // Start the long-lived postprocessing worker
-    g_pp_worker = std::thread([&server]() { pp_worker_loop(server); });
+    // Start the long-lived postprocessing slots. Admission measures jobs
+    // against the unit's MemoryHigh (the soft cap where reclaim throttling
+    // starts) when set, else the tightest hard ceiling.
+    {
+        g_pp_max_jobs = std::max(pp_max_jobs > 0 ? pp_max_jobs : g_config.pp_max_jobs, 1);
+        const int slots = g_pp_max_jobs + 1;
+        g_pp_budget_bytes = read_memory_ceiling_bytes();
+        const long high = read_systemd_memory_property("MemoryHigh");
+        if (high > 0 && high != LONG_MAX &&
+            (g_pp_budget_bytes == 0 || static_cast<uint64_t>(high) < g_pp_budget_bytes))
+            g_pp_budget_bytes = static_cast<uint64_t>(high);
+        g_pp_cores = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+        for (int i = 0; i < slots; ++i) {
+            g_pp_slots.push_back(std::make_unique<PpSlot>());
+            g_pp_slots.back()->index = i;
+        }
+        for (auto& slot : g_pp_slots) {
+            PpSlot* s = slot.get();
+            g_pp_workers.emplace_back([&server, s]() { pp_slot_loop(server, *s); });
+        }
+        log_info("daemon: %d postprocessing job(s) at once, budget=%llu MB, cores=%d", g_pp_max_jobs,
+                 (unsigned long long)(g_pp_budget_bytes >> 20), g_pp_cores);
+        if (restore_pp_journal() > 0) broadcast_state(server);
+    }
+
+    // Recordings dropped into postprocess.watch_dir are queued as batch jobs.
+    {
+        Config cfg;
+        {
+            std::lock_guard<std::mutex> lock(g_config_mu);
+            cfg = g_config;
+        }
+        start_watch_folder(server, cfg);
+    }
 
     // Signal handlers
     struct sigaction sa{};
@@ -1619,6 +3248,9 @@ int main(int argc, char* argv[]) {
     sigaction(SIGINT, &sa, nullptr);
     sigaction(SIGTERM, &sa, nullptr);
     sigaction(SIGHUP, &sa, nullptr);
+    // A write to a warm pp worker that has died must fail with EPIPE
+    // rather than kill the daemon. Children restore the default.
+    signal(SIGPIPE, SIG_IGN);
 
     log_info("daemon: listening on %s", socket_path.c_str());
     fprintf(stderr, "recmeet-daemon %s listening on %s\n", RECMEET_VERSION, socket_path.c_str());
@@ -1628,23 +3260,36 @@ int main(int argc, char* argv[]) {
 
     // Cleanup — shut down all workers
     log_info("daemon: shutting down");
+    if (artifacts) artifacts->stop();
+    g_watch.reset();
+    g_sources.reset();
     g_rec_stop.request();
-    g_pp_stop.request();
-    { pid_t child = g_pp_child_pid.load(); if (child > 0) kill(child, SIGTERM); }
+    g_pp_draining.store(true);
+    cancel_running_pp_jobs(0, true);
 
-    // Shut down the pp worker queue
+    // Shut down the pp slots
     {
         std::lock_guard<std::mutex> lock(g_queue_mu);
         g_queue_shutdown = true;
     }
-    g_queue_cv.notify_one();
+    g_queue_cv.notify_all();
 
     log_debug("daemon: shutdown: joining rec_worker...");
     if (g_rec_worker.joinable()) g_rec_worker.join();
-    log_debug("daemon: shutdown: joining pp_worker...");
-    if (g_pp_worker.joinable()) g_pp_worker.join();
+    log_debug("daemon: shutdown: joining pp slots...");
+    for (auto& worker : g_pp_workers)
+        if (worker.joinable()) worker.join();
     if (g_dl_worker.joinable()) g_dl_worker.join();
+    g_prefetch_stop.store(true);
+    if (g_prefetch_worker.joinable()) g_prefetch_worker.join();
+    if (g_caption_warm_worker.joinable()) g_caption_warm_worker.join();
+    if (g_clip_worker.joinable()) g_clip_worker.join();
+    if (g_clip_warm_worker.joinable()) g_clip_warm_worker.join();
+    g_clip.release();
+    if (g_backend_bench_worker.joinable()) g_backend_bench_worker.join();
+    CaptionEngine::drop_warm();
     g_server = nullptr;
+    g_levels.reset();
 
     // Clean up PID file
     if (pid_fd >= 0) {
@@ -1652,6 +3297,7 @@ int main(int argc, char* argv[]) {
         close(pid_fd);
     }
 
+    trace_stop();
     log_shutdown();
     notify_cleanup();
     return 0;
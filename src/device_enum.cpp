@@ -2,10 +2,12 @@
 // SPDX-License-Identifier: MIT OR Apache-2.0
 
 #include "device_enum.h"
+#include "log.h"
 #include "util.h"
 
 #include <pulse/pulseaudio.h>
 #include <cstring>
+#include <mutex>
 #include <regex>
 
 namespace recmeet {
@@ -110,9 +112,232 @@ bool is_monitor_source(const AudioSource& src) {
     return src.is_monitor || has_monitor_suffix;
 }
 
+std::mutex g_registry_mutex;
+const SourceRegistry* g_registry = nullptr;  // the live cache, if any
+
+bool cached_sources(std::vector<AudioSource>& sources, std::string& default_source) {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    return g_registry && g_registry->snapshot(sources, default_source);
+}
+
 } // anonymous namespace
 
+// Everything but the cache runs on the mainloop thread, under its lock.
+struct SourceRegistry::Impl {
+    ChangeCallback on_change;
+    pa_threaded_mainloop* mainloop = nullptr;
+    pa_context* context = nullptr;
+    pa_time_event* retry = nullptr;
+
+    bool listing = false;  // a refresh is in flight
+    bool dirty = false;    // an event arrived during it
+    std::vector<AudioSource> pending;
+
+    mutable std::mutex mu;  // the cache
+    bool ready = false;
+    std::vector<AudioSource> sources;
+    std::string default_source;
+
+    void connect();
+    void schedule_retry();
+    void refresh();
+    void commit(std::string default_name);
+    void drop_cache();
+};
+
+namespace {
+
+void registry_server_cb(pa_context*, const pa_server_info* info, void* userdata) {
+    auto* impl = static_cast<SourceRegistry::Impl*>(userdata);
+    impl->commit(info && info->default_source_name ? info->default_source_name : "");
+}
+
+void registry_source_cb(pa_context* c, const pa_source_info* info, int eol, void* userdata) {
+    auto* impl = static_cast<SourceRegistry::Impl*>(userdata);
+    if (eol != 0) {
+        // The list is complete (or failed); the default source finishes it.
+        pa_operation* op = pa_context_get_server_info(c, registry_server_cb, userdata);
+        if (op) pa_operation_unref(op);
+        else impl->commit("");
+        return;
+    }
+    if (!info) return;
+    AudioSource src;
+    src.name = info->name;
+    src.description = info->description ? info->description : "";
+    src.is_monitor = (info->monitor_of_sink != PA_INVALID_INDEX);
+    impl->pending.push_back(std::move(src));
+}
+
+void registry_event_cb(pa_context*, pa_subscription_event_type_t type, uint32_t,
+                       void* userdata) {
+    const auto facility = type & PA_SUBSCRIPTION_EVENT_FACILITY_MASK;
+    if (facility != PA_SUBSCRIPTION_EVENT_SOURCE && facility != PA_SUBSCRIPTION_EVENT_SERVER)
+        return;
+    static_cast<SourceRegistry::Impl*>(userdata)->refresh();
+}
+
+void registry_state_cb(pa_context* c, void* userdata) {
+    auto* impl = static_cast<SourceRegistry::Impl*>(userdata);
+    switch (pa_context_get_state(c)) {
+        case PA_CONTEXT_READY: {
+            pa_context_set_subscribe_callback(c, registry_event_cb, userdata);
+            const auto mask = static_cast<pa_subscription_mask_t>(PA_SUBSCRIPTION_MASK_SOURCE |
+                                                                  PA_SUBSCRIPTION_MASK_SERVER);
+            pa_operation* op = pa_context_subscribe(c, mask, nullptr, nullptr);
+            if (op) pa_operation_unref(op);
+            log_info("sources: watching the sound server for device changes");
+            impl->refresh();
+            break;
+        }
+        case PA_CONTEXT_FAILED:
+            log_warn("sources: lost the sound server (%s); retrying every %ds",
+                     pa_strerror(pa_context_errno(c)), SOURCE_REGISTRY_RETRY_SEC);
+            impl->drop_cache();
+            impl->schedule_retry();
+            break;
+        default:
+            break;
+    }
+}
+
+void registry_retry_cb(pa_mainloop_api* api, pa_time_event* e, const struct timeval*,
+                       void* userdata) {
+    auto* impl = static_cast<SourceRegistry::Impl*>(userdata);
+    api->time_free(e);
+    impl->retry = nullptr;
+    impl->connect();
+}
+
+} // anonymous namespace
+
+void SourceRegistry::Impl::connect() {
+    if (context) {
+        pa_context_set_state_callback(context, nullptr, nullptr);
+        pa_context_set_subscribe_callback(context, nullptr, nullptr);
+        pa_context_disconnect(context);
+        pa_context_unref(context);
+    }
+    listing = false;
+    dirty = false;
+    context = pa_context_new(pa_threaded_mainloop_get_api(mainloop), "recmeet-registry");
+    if (!context) {
+        schedule_retry();
+        return;
+    }
+    pa_context_set_state_callback(context, registry_state_cb, this);
+    if (pa_context_connect(context, nullptr, PA_CONTEXT_NOFLAGS, nullptr) < 0)
+        schedule_retry();
+}
+
+void SourceRegistry::Impl::schedule_retry() {
+    if (retry) return;
+    pa_mainloop_api* api = pa_threaded_mainloop_get_api(mainloop);
+    struct timeval when;
+    pa_timeval_add(pa_gettimeofday(&when),
+                   static_cast<pa_usec_t>(SOURCE_REGISTRY_RETRY_SEC) * PA_USEC_PER_SEC);
+    retry = api->time_new(api, &when, registry_retry_cb, this);
+}
+
+void SourceRegistry::Impl::refresh() {
+    if (listing) {
+        dirty = true;
+        return;
+    }
+    pending.clear();
+    pa_operation* op = pa_context_get_source_info_list(context, registry_source_cb, this);
+    if (!op) return;
+    pa_operation_unref(op);
+    listing = true;
+}
+
+void SourceRegistry::Impl::commit(std::string default_name) {
+    listing = false;
+    if (dirty) {  // the list may already be stale
+        dirty = false;
+        refresh();
+        return;
+    }
+    bool changed;
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        changed = !ready || sources != pending || default_source != default_name;
+        ready = true;
+        sources = pending;
+        default_source = std::move(default_name);
+    }
+    if (changed) {
+        log_debug("sources: %zu source(s), default '%s'", pending.size(),
+                  default_source.c_str());
+        if (on_change) on_change(pending, default_source);
+    }
+}
+
+void SourceRegistry::Impl::drop_cache() {
+    std::lock_guard<std::mutex> lock(mu);
+    ready = false;
+}
+
+SourceRegistry::SourceRegistry(ChangeCallback on_change) : impl_(std::make_unique<Impl>()) {
+    impl_->on_change = std::move(on_change);
+}
+
+SourceRegistry::~SourceRegistry() {
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        if (g_registry == this) g_registry = nullptr;
+    }
+    if (!impl_->mainloop) return;
+    pa_threaded_mainloop_lock(impl_->mainloop);
+    if (impl_->retry) {
+        pa_threaded_mainloop_get_api(impl_->mainloop)->time_free(impl_->retry);
+        impl_->retry = nullptr;
+    }
+    if (impl_->context) {
+        pa_context_set_state_callback(impl_->context, nullptr, nullptr);
+        pa_context_set_subscribe_callback(impl_->context, nullptr, nullptr);
+        pa_context_disconnect(impl_->context);
+        pa_context_unref(impl_->context);
+        impl_->context = nullptr;
+    }
+    pa_threaded_mainloop_unlock(impl_->mainloop);
+    pa_threaded_mainloop_stop(impl_->mainloop);
+    pa_threaded_mainloop_free(impl_->mainloop);
+}
+
+bool SourceRegistry::start() {
+    if (impl_->mainloop) return true;
+    impl_->mainloop = pa_threaded_mainloop_new();
+    if (!impl_->mainloop) return false;
+    pa_threaded_mainloop_lock(impl_->mainloop);
+    const bool started = pa_threaded_mainloop_start(impl_->mainloop) == 0;
+    if (started) impl_->connect();
+    pa_threaded_mainloop_unlock(impl_->mainloop);
+    if (!started) {
+        pa_threaded_mainloop_free(impl_->mainloop);
+        impl_->mainloop = nullptr;
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    g_registry = this;
+    return true;
+}
+
+bool SourceRegistry::snapshot(std::vector<AudioSource>& sources,
+                              std::string& default_source) const {
+    std::lock_guard<std::mutex> lock(impl_->mu);
+    if (!impl_->ready) return false;
+    sources = impl_->sources;
+    default_source = impl_->default_source;
+    return true;
+}
+
 std::vector<AudioSource> list_sources() {
+    {
+        std::vector<AudioSource> sources;
+        std::string default_source;
+        if (cached_sources(sources, default_source)) return sources;
+    }
     EnumContext ectx;
 
     pa_mainloop* ml = pa_mainloop_new();
@@ -152,6 +377,11 @@ std::vector<AudioSource> list_sources() {
 }
 
 std::string get_default_source_name() {
+    {
+        std::vector<AudioSource> sources;
+        std::string default_source;
+        if (cached_sources(sources, default_source)) return default_source;
+    }
     ServerInfoContext sctx;
 
     pa_mainloop* ml = pa_mainloop_new();
@@ -185,8 +415,19 @@ std::string get_default_source_name() {
 }
 
 DetectedSources detect_sources(const std::string& pattern) {
+    std::vector<AudioSource> all;
+    std::string default_name;
+    if (!cached_sources(all, default_name)) {
+        all = list_sources();
+        if (pattern.empty()) default_name = get_default_source_name();
+    }
+    return pick_sources(all, default_name, pattern);
+}
+
+DetectedSources pick_sources(const std::vector<AudioSource>& all,
+                             const std::string& default_name, const std::string& pattern) {
     DetectedSources result;
-    result.all = list_sources();
+    result.all = all;
 
     if (!pattern.empty()) {
         // Explicit regex path
@@ -208,8 +449,6 @@ DetectedSources detect_sources(const std::string& pattern) {
     }
 
     // Empty pattern: use system default source
-    std::string default_name = get_default_source_name();
-
     if (!default_name.empty()) {
         for (const auto& src : result.all) {
             if (src.name == default_name) {
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -14,6 +16,11 @@ struct AudioSource {
     bool is_monitor;       // true if .monitor suffix
 };
 
+inline bool operator==(const AudioSource& a, const AudioSource& b) {
+    return a.name == b.name && a.description == b.description && a.is_monitor == b.is_monitor;
+}
+inline bool operator!=(const AudioSource& a, const AudioSource& b) { return !(a == b); }
+
 struct DetectedSources {
     std::string mic;       // empty if not found
     std::string monitor;   // empty if not found
@@ -21,14 +28,66 @@ struct DetectedSources {
 };
 
 /// List all PulseAudio/PipeWire sources via pa_context introspection.
+/// Served from the live SourceRegistry when one is connected.
 std::vector<AudioSource> list_sources();
 
 /// Query PulseAudio/PipeWire for the server's default source name.
-/// Returns empty string on failure (never throws).
+/// Returns empty string on failure (never throws). Served from the live
+/// SourceRegistry when one is connected.
 std::string get_default_source_name();
 
 /// Auto-detect mic and monitor sources matching regex pattern.
 /// Empty pattern means "use system default source."
 DetectedSources detect_sources(const std::string& pattern);
 
+/// detect_sources() over a known list: the first mic and monitor matching
+/// `pattern`, or for an empty pattern the server's `default_name` in its
+/// slot and the first source of each kind in the other.
+DetectedSources pick_sources(const std::vector<AudioSource>& all,
+                             const std::string& default_name, const std::string& pattern);
+
+// ---------------------------------------------------------------------------
+// Source registry (the daemon's cached device list)
+// ---------------------------------------------------------------------------
+//
+// Connecting a context and enumerating takes a round trip to the sound
+// server per call. A SourceRegistry keeps one context open on a threaded
+// mainloop, subscribed to source and server events, and re-lists the
+// sources and the default source whenever one fires. While a registry is
+// connected, list_sources(), get_default_source_name() and so
+// detect_sources() read its cache instead of enumerating. When the server
+// goes away the cache is dropped (callers enumerate as before) and the
+// registry reconnects every SOURCE_REGISTRY_RETRY_SEC.
+//
+// One registry at a time; a second one replaces the first as the cache.
+
+constexpr int SOURCE_REGISTRY_RETRY_SEC = 5;
+
+class SourceRegistry {
+public:
+    /// `on_change` gets the new list after every change (and the first
+    /// listing), on the registry's thread.
+    using ChangeCallback = std::function<void(const std::vector<AudioSource>& sources,
+                                              const std::string& default_source)>;
+
+    explicit SourceRegistry(ChangeCallback on_change = nullptr);
+    ~SourceRegistry();
+
+    SourceRegistry(const SourceRegistry&) = delete;
+    SourceRegistry& operator=(const SourceRegistry&) = delete;
+
+    /// Start the mainloop and connect. False when the mainloop cannot
+    /// start; a server that is not running yet is retried.
+    bool start();
+
+    /// A snapshot of the cache; false before the first listing and while
+    /// disconnected.
+    bool snapshot(std::vector<AudioSource>& sources, std::string& default_source) const;
+
+    struct Impl;
+
+private:
+    std::unique_ptr<Impl> impl_;
+};
+
 } // namespace recmeet
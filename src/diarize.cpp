@@ -2,17 +2,26 @@
 // SPDX-License-Identifier: MIT OR Apache-2.0
 
 #include "diarize.h"
+#include "embedding_set.h"
 #include "log.h"
+#include "model_cache.h"
+#include "onnx_provider.h"
+#include "perf_counters.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdio>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <limits>
 #include <map>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <thread>
 
 #if RECMEET_USE_SHERPA
 #include "audio_file.h"
@@ -82,60 +91,83 @@ std::vector<TranscriptSegment> merge_speakers(
     const std::vector<TranscriptSegment>& transcript,
     const DiarizeResult& diarization,
     const std::map<int, std::string>& speaker_names) {
+    return label_speakers(transcript, assign_speakers(transcript, diarization), speaker_names);
+}
 
-    std::vector<TranscriptSegment> result;
+std::vector<int> assign_speakers(const std::vector<TranscriptSegment>& transcript,
+                                 const DiarizeResult& diarization) {
+    std::vector<int> result;
     result.reserve(transcript.size());
 
-    for (const auto& seg : transcript) {
-        TranscriptSegment out = seg;
+    // Interval index: diarization turns by start, with the running maximum
+    // end. A transcript segment [s, e) can only overlap the turns between
+    // the first whose running end passes s and the last that starts before
+    // e, so each lookup is two binary searches plus the turns it actually
+    // touches instead of a scan of the whole meeting. Turns may overlap
+    // each other (chunk boundaries), which the running end handles.
+    const auto& turns = diarization.segments;
+    std::vector<size_t> order(turns.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return turns[a].start < turns[b].start;
+    });
+    std::vector<double> starts(order.size()), running_end(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        starts[i] = turns[order[i]].start;
+        running_end[i] = i ? std::max(running_end[i - 1], turns[order[i]].end)
+                           : turns[order[i]].end;
+    }
 
-        // Find diarization segment with maximum temporal overlap
+    for (const auto& seg : transcript) {
+        // Find diarization segment with maximum temporal overlap; on a tie
+        // the earliest in `diarization.segments` wins, as a linear scan would.
         int best_speaker = 0;
         double best_overlap = 0.0;
-
-        for (const auto& d : diarization.segments) {
+        size_t best_index = turns.size();
+
+        const size_t lo = static_cast<size_t>(
+            std::upper_bound(running_end.begin(), running_end.end(), seg.start) -
+            running_end.begin());
+        const size_t hi = static_cast<size_t>(
+            std::lower_bound(starts.begin(), starts.end(), seg.end) - starts.begin());
+        for (size_t i = lo; i < hi; ++i) {
+            const auto& d = turns[order[i]];
             double overlap = std::min(seg.end, d.end) - std::max(seg.start, d.start);
-            if (overlap > best_overlap) {
+            if (overlap > best_overlap ||
+                (overlap == best_overlap && best_index < turns.size() && order[i] < best_index)) {
                 best_overlap = overlap;
                 best_speaker = d.speaker;
+                best_index = order[i];
             }
         }
 
-        // Use enrolled name if available, otherwise fall back to Speaker_XX
-        auto it = speaker_names.find(best_speaker);
-        std::string name = (it != speaker_names.end()) ? it->second
-                                                       : format_speaker(best_speaker);
-        out.text = name + ": " + seg.text;
-        result.push_back(std::move(out));
+        result.push_back(best_speaker);
     }
 
     return result;
 }
 
-namespace {
-
-// Centroid-dump cosine similarity. Independent of stitch's cosine_sim_raw so
-// that the dump helper compiles even when RECMEET_USE_SHERPA is OFF (the
-// stitch path's cosine_sim_raw lives inside the sherpa-gated anonymous
-// namespace below).
-double dump_cosine_similarity(const std::vector<float>& a,
-                              const std::vector<float>& b) {
-    if (a.size() != b.size() || a.empty()) return 0.0;
-    double dot = 0.0;
-    double norm_a_sq = 0.0;
-    double norm_b_sq = 0.0;
-    for (size_t i = 0; i < a.size(); ++i) {
-        double ai = static_cast<double>(a[i]);
-        double bi = static_cast<double>(b[i]);
-        dot += ai * bi;
-        norm_a_sq += ai * ai;
-        norm_b_sq += bi * bi;
+std::vector<TranscriptSegment> label_speakers(
+    const std::vector<TranscriptSegment>& transcript, const std::vector<int>& speakers,
+    const std::map<int, std::string>& speaker_names) {
+    std::vector<TranscriptSegment> result;
+    result.reserve(transcript.size());
+    for (size_t i = 0; i < transcript.size(); ++i) {
+        TranscriptSegment out = transcript[i];
+        if (i < speakers.size()) {
+            // Use enrolled name if available, otherwise fall back to Speaker_XX
+            auto it = speaker_names.find(speakers[i]);
+            std::string name = (it != speaker_names.end()) ? it->second
+                                                           : format_speaker(speakers[i]);
+            out.text = name + ": " + out.text;
+        }
+        result.push_back(std::move(out));
     }
-    double denom = std::sqrt(norm_a_sq) * std::sqrt(norm_b_sq);
-    if (denom < 1e-12) return 0.0;
-    return dot / denom;
+    return result;
 }
 
+namespace {
+
 // JSON-escape a string. Minimal — we only emit ASCII labels and timestamps in
 // the dump file so we just escape \, ", control chars.
 std::string dump_json_escape(const std::string& s) {
@@ -262,14 +294,15 @@ void dump_centroids_json(
     os << "],\n";
 
     // similarity matrix
+    EmbeddingSet dump_set(N > 0 ? centroids[0].size() : 0);
+    for (const auto& c : centroids) dump_set.add(c);
     os << "  \"similarity\": [";
     for (size_t i = 0; i < N; ++i) {
         if (i) os << ", ";
         os << "[";
         for (size_t j = 0; j < N; ++j) {
             if (j) os << ", ";
-            double sim = (i == j) ? 1.0
-                       : dump_cosine_similarity(centroids[i], centroids[j]);
+            double sim = (i == j) ? 1.0 : dump_set.cosine(i, j);
             char buf[32];
             std::snprintf(buf, sizeof(buf), "%.6f", sim);
             os << buf;
@@ -308,11 +341,11 @@ void dump_centroids_json(
 namespace {
 
 // Build a full SherpaOnnxOfflineSpeakerDiarizationConfig. The returned struct
-// holds non-owning C-string pointers into `model_paths`; caller must ensure
-// `model_paths` outlives any sherpa call that reads the config.
+// holds non-owning C-string pointers into `model_paths` and `provider`;
+// caller must ensure both outlive any sherpa call that reads the config.
 SherpaOnnxOfflineSpeakerDiarizationConfig
 make_diarize_config(const SherpaModelPaths& model_paths, int threads,
-                    int num_clusters, float threshold) {
+                    int num_clusters, float threshold, const std::string& provider) {
     SherpaOnnxOfflineSpeakerSegmentationPyannoteModelConfig pyannote{};
     pyannote.model = model_paths.segmentation.c_str();
 
@@ -321,13 +354,13 @@ make_diarize_config(const SherpaModelPaths& model_paths, int threads,
     int t = std::min(threads > 0 ? threads : default_thread_count(), 4);
     seg_cfg.num_threads = t;
     seg_cfg.debug = 0;
-    seg_cfg.provider = "cpu";
+    seg_cfg.provider = provider.c_str();
 
     SherpaOnnxSpeakerEmbeddingExtractorConfig emb_cfg{};
     emb_cfg.model = model_paths.embedding.c_str();
     emb_cfg.num_threads = t;
     emb_cfg.debug = 0;
-    emb_cfg.provider = "cpu";
+    emb_cfg.provider = provider.c_str();
 
     SherpaOnnxFastClusteringConfig cluster_cfg{};
     cluster_cfg.num_clusters = num_clusters;
@@ -350,11 +383,17 @@ DiarizeSession::DiarizeSession(int threads) : threads_(threads) {
     // threshold; callers must invoke set_clustering() before each Process to
     // pin per-call params. We build with sane defaults so the session is
     // immediately usable for tests that exercise the construction path alone.
-    auto config = make_diarize_config(model_paths_, threads_, -1, 1.18f);
-    log_debug("DiarizeSession: creating sherpa diarization (threads=%d)", threads_);
-    sd_ = SherpaOnnxCreateOfflineSpeakerDiarization(&config);
+    memory_.begin("diarization", {model_paths_.segmentation, model_paths_.embedding});
+    sd_ = static_cast<const SherpaOnnxOfflineSpeakerDiarization*>(create_on_onnx_provider(
+        "DiarizeSession", provider_, [&](const std::string& provider) -> const void* {
+            auto config = make_diarize_config(model_paths_, threads_, -1, 1.18f, provider);
+            log_debug("DiarizeSession: creating sherpa diarization (threads=%d, provider=%s)",
+                      threads_, provider.c_str());
+            return SherpaOnnxCreateOfflineSpeakerDiarization(&config);
+        }));
     if (!sd_)
         throw RecmeetError("Failed to create sherpa-onnx speaker diarization");
+    memory_.finish();
 }
 
 DiarizeSession::~DiarizeSession() {
@@ -364,7 +403,9 @@ DiarizeSession::~DiarizeSession() {
 DiarizeSession::DiarizeSession(DiarizeSession&& other) noexcept
     : sd_(other.sd_),
       model_paths_(std::move(other.model_paths_)),
-      threads_(other.threads_) {
+      threads_(other.threads_),
+      provider_(std::move(other.provider_)),
+      memory_(std::move(other.memory_)) {
     other.sd_ = nullptr;
 }
 
@@ -374,15 +415,24 @@ DiarizeSession& DiarizeSession::operator=(DiarizeSession&& other) noexcept {
         sd_ = other.sd_;
         model_paths_ = std::move(other.model_paths_);
         threads_ = other.threads_;
+        provider_ = std::move(other.provider_);
+        memory_ = std::move(other.memory_);
         other.sd_ = nullptr;
     }
     return *this;
 }
 
+std::shared_ptr<DiarizeSession> acquire_diarize_session(int threads) {
+    static ModelSlot<DiarizeSession> slot{"sherpa"};
+    return slot.get(std::to_string(threads) + "#" + onnx_provider(), [&] {
+        return std::make_unique<DiarizeSession>(threads);
+    });
+}
+
 void DiarizeSession::set_clustering(int num_clusters, float threshold) {
     if (!sd_)
         throw RecmeetError("DiarizeSession::set_clustering on moved-from session");
-    auto config = make_diarize_config(model_paths_, threads_, num_clusters, threshold);
+    auto config = make_diarize_config(model_paths_, threads_, num_clusters, threshold, provider_);
     SherpaOnnxOfflineSpeakerDiarizationSetConfig(sd_, &config);
     log_debug("DiarizeSession::set_clustering(num_clusters=%d, threshold=%.3f)",
               num_clusters, threshold);
@@ -401,6 +451,8 @@ DiarizeResult diarize_with_session(DiarizeSession& session,
              num_samples, num_samples / 16000.0);
 
     const SherpaOnnxOfflineSpeakerDiarizationResult* raw_result;
+    // onnxruntime's intra-op pool outlives the call: count every thread.
+    const EngineCounterScope counters("sherpa_diarize", PerfScope::Process);
     if (on_progress) {
         auto c_callback = [](int32_t done, int32_t total, void* arg) -> int32_t {
             auto* fn = static_cast<DiarizeProgressCallback*>(arg);
@@ -455,9 +507,9 @@ DiarizeResult diarize(const float* samples, size_t num_samples,
               num_samples, num_speakers, threads);
     if (!samples || num_samples == 0)
         throw RecmeetError("Cannot diarize: empty audio buffer");
-    DiarizeSession session(threads);
-    session.set_clustering(num_speakers > 0 ? num_speakers : -1, threshold);
-    return diarize_with_session(session, samples, num_samples, std::move(on_progress));
+    auto session = acquire_diarize_session(threads);
+    session->set_clustering(num_speakers > 0 ? num_speakers : -1, threshold);
+    return diarize_with_session(*session, samples, num_samples, std::move(on_progress));
 }
 
 DiarizeResult diarize(const fs::path& audio_path, int num_speakers, int threads,
@@ -480,6 +532,8 @@ DiarizeResult diarize(const fs::path& audio_path, int num_speakers, int threads,
 //     the legacy single-call path (H1, line 16).
 //   - Cosine similarity is computed transiently in step 5 and step 8 by
 //     L2-normalizing both operands at comparison time only (line 397, 409).
+//     EmbeddingSet (`src/embedding_set.h`) caches each centroid's norm
+//     next to the raw vector, which is the same computation.
 //
 // Step 7 emits each owned segment at its full global extent (no trim-to-core)
 // so sherpa's per-chunk VAD jitter cannot drop boundary speech (M-1', line
@@ -488,29 +542,11 @@ DiarizeResult diarize(const fs::path& audio_path, int num_speakers, int threads,
 
 namespace {
 
-constexpr float kStitchEps = 1e-9f;
-
-float l2_norm(const std::vector<float>& v) {
-    double sum_sq = 0.0;
-    for (float x : v) sum_sq += static_cast<double>(x) * static_cast<double>(x);
-    return static_cast<float>(std::sqrt(sum_sq));
-}
-
-float cosine_sim_raw(const std::vector<float>& a, const std::vector<float>& b) {
-    if (a.size() != b.size() || a.empty()) return 0.0f;
-    double dot = 0.0;
-    double norm_a_sq = 0.0;
-    double norm_b_sq = 0.0;
-    for (size_t i = 0; i < a.size(); ++i) {
-        double ai = static_cast<double>(a[i]);
-        double bi = static_cast<double>(b[i]);
-        dot += ai * bi;
-        norm_a_sq += ai * ai;
-        norm_b_sq += bi * bi;
-    }
-    double denom = std::sqrt(norm_a_sq) * std::sqrt(norm_b_sq);
-    if (denom < static_cast<double>(kStitchEps)) return 0.0f;
-    return static_cast<float>(dot / denom);
+// Dimension of a centroid list: the first non-empty one's size.
+size_t embedding_dim(const std::vector<GlobalEntry>& globals) {
+    for (const auto& g : globals)
+        if (!g.raw.empty()) return g.raw.size();
+    return 0;
 }
 
 // Sample-weighted mean of raw vectors. count_a + count_b > 0 by construction.
@@ -592,6 +628,19 @@ CollapseResult apply_collapse(
     float collapse_threshold,
     bool enforce_floor) {
 
+    // Pairwise similarities, computed once and kept current as clusters
+    // merge: a merge recomputes only the survivor's row. `slot[k]` is the
+    // matrix row of globals[k]; a dropped entry's row is simply unused.
+    const size_t n0 = globals.size();
+    EmbeddingSet set(embedding_dim(globals));
+    for (const auto& g : globals) set.add(g.raw);
+    std::vector<float> sims(n0 * n0, 0.0f);
+    for (size_t a = 0; a < n0; ++a)
+        for (size_t b = a + 1; b < n0; ++b)
+            sims[a * n0 + b] = sims[b * n0 + a] = static_cast<float>(set.cosine(a, b));
+    std::vector<size_t> slot(n0);
+    for (size_t k = 0; k < n0; ++k) slot[k] = k;
+
     // Unified greedy-merge loop: find the highest-similarity pair, merge
     // when EITHER `ceiling_hit` OR `threshold_ok`. Stop when both are false
     // OR when `at_floor` short-circuits (Phase 1a floor branch).
@@ -601,8 +650,9 @@ CollapseResult apply_collapse(
         int best_min_id = std::numeric_limits<int>::max();
 
         for (size_t a = 0; a < globals.size(); ++a) {
+            const float* row = &sims[slot[a] * n0];
             for (size_t b = a + 1; b < globals.size(); ++b) {
-                float sim = cosine_sim_raw(globals[a].raw, globals[b].raw);
+                float sim = row[slot[b]];
                 int min_id = std::min(globals[a].id, globals[b].id);
                 bool take = false;
                 if (sim > best_sim) {
@@ -649,7 +699,15 @@ CollapseResult apply_collapse(
         int drop_idx = (id_a == merged_id) ? best_b_idx : best_a_idx;
         globals[keep_idx].raw = std::move(merged_raw);
         globals[keep_idx].sample_count = merged_count;
+        const size_t keep_slot = slot[keep_idx];
+        set.set(keep_slot, globals[keep_idx].raw);
         globals.erase(globals.begin() + drop_idx);
+        slot.erase(slot.begin() + drop_idx);
+        for (size_t s : slot) {
+            if (s == keep_slot) continue;
+            sims[keep_slot * n0 + s] = sims[s * n0 + keep_slot] =
+                static_cast<float>(set.cosine(keep_slot, s));
+        }
 
         // Rewrite emitted segments: dropped_id -> merged_id.
         for (auto& seg : diar_inout.segments) {
@@ -717,20 +775,46 @@ std::vector<GlobalEntry> build_short_audio_globals(
     const float* samples, size_t num_samples,
     const DiarizeResult& diar, int threads) {
 
-    std::vector<GlobalEntry> globals;
-    if (!samples || num_samples == 0 || diar.segments.empty()) return globals;
+    return globals_from_centroids(
+        diar, extract_cluster_centroids(samples, num_samples, diar, threads));
+}
+
+std::map<int, std::vector<float>> extract_cluster_centroids(
+    const float* samples, size_t num_samples,
+    const DiarizeResult& diar, int threads) {
+
+    std::map<int, std::vector<float>> centroids;
+    if (!samples || num_samples == 0 || diar.segments.empty()) return centroids;
 
     auto model_paths = ensure_sherpa_models();
-    SpeakerEmbeddingSession emb_session(model_paths.embedding, threads);
+    auto emb_ref = acquire_embedding_session(model_paths.embedding, threads);
+    SpeakerEmbeddingSession& emb_session = *emb_ref;
+
+    const std::vector<int> ids = unique_local_ids(diar);
+    std::vector<std::vector<DiarizeSegment>> requests;
+    requests.reserve(ids.size());
+    for (int sid : ids) requests.push_back(select_speaker_segments(diar, sid, 0.0));
+    auto raws = extract_speaker_embeddings(
+        emb_session, MemorySampleSource(samples, num_samples), requests);
+    for (size_t i = 0; i < ids.size(); ++i)
+        if (!raws[i].empty()) centroids[ids[i]] = std::move(raws[i]);
+    return centroids;
+}
+
+std::vector<GlobalEntry> globals_from_centroids(
+    const DiarizeResult& diar,
+    const std::map<int, std::vector<float>>& centroids) {
+
+    std::vector<GlobalEntry> globals;
 
     // Unique cluster IDs in ascending order for deterministic ordering.
     std::vector<int> uniq_ids = unique_local_ids(diar);
 
     int id_seq = 0;
     for (int sid : uniq_ids) {
-        std::vector<float> raw = extract_speaker_embedding(
-            emb_session, samples, num_samples, diar, sid);
-        if (raw.empty()) continue;
+        auto it = centroids.find(sid);
+        if (it == centroids.end() || it->second.empty()) continue;
+        std::vector<float> raw = it->second;
 
         // Sample-count weight: total duration of all segments tagged with sid.
         double sec = 0.0;
@@ -779,6 +863,15 @@ DiarizeChunkedResult stitch_chunks(
     std::vector<GlobalEntry> globals;
     int id_seq = 0;
 
+    // globals[k].raw with cached norms, so the nearest-global scan in step 5
+    // is one dot product per global.
+    size_t dim = 0;
+    for (const auto& centroids_i : chunk_centroids)
+        for (const auto& kv : centroids_i)
+            if (!dim && !kv.second.empty()) dim = kv.second.size();
+    EmbeddingSet gset(dim);
+    std::vector<double> sims;
+
     // Per-chunk local-id -> global-id map, captured during step 5 so that
     // step 7 can rewrite emitted segments without recomputing the match.
     std::vector<std::map<int, int>> local_to_global(chunk_results.size());
@@ -803,24 +896,25 @@ DiarizeChunkedResult stitch_chunks(
             // Step 5: nearest global by cosine similarity. Scan in ascending
             // global-ID order; ties resolve to the smaller ID.
             int best_id = -1;
+            size_t best_k = 0;
             float best_sim = -1.0f;
-            for (const auto& g : globals) {
-                float sim = cosine_sim_raw(local_raw, g.raw);
+            gset.similarities(local_raw, sims);
+            for (size_t k = 0; k < globals.size(); ++k) {
+                float sim = static_cast<float>(sims[k]);
                 if (sim > best_sim) {
                     best_sim = sim;
-                    best_id = g.id;
+                    best_id = globals[k].id;
+                    best_k = k;
                 }
             }
 
             if (best_id >= 0 && best_sim >= cfg.stitch_threshold) {
                 // Step 6: weighted-mean update of matched global.
-                for (auto& g : globals) {
-                    if (g.id != best_id) continue;
-                    g.raw = weighted_mean_raw(g.raw, g.sample_count,
-                                              local_raw, local_count);
-                    g.sample_count += local_count;
-                    break;
-                }
+                auto& g = globals[best_k];
+                g.raw = weighted_mean_raw(g.raw, g.sample_count,
+                                          local_raw, local_count);
+                g.sample_count += local_count;
+                gset.set(best_k, g.raw);
                 local_to_global[i][local_sid] = best_id;
             } else {
                 GlobalEntry ge;
@@ -828,6 +922,7 @@ DiarizeChunkedResult stitch_chunks(
                 ge.raw = local_raw;
                 ge.sample_count = local_count;
                 globals.push_back(ge);
+                gset.add(ge.raw);
                 local_to_global[i][local_sid] = ge.id;
             }
         }
@@ -914,7 +1009,7 @@ DiarizeChunkedResult stitch_chunks(
             int best_k = 0;
             float best_sim = -2.0f;
             for (const auto& [post_id, post_raw] : collapsed.centroids) {
-                float s = cosine_sim_raw(g_pre.raw, post_raw);
+                float s = static_cast<float>(cosine_similarity(g_pre.raw, post_raw));
                 if (s > best_sim) {
                     best_sim = s;
                     best_k = post_id;
@@ -968,14 +1063,28 @@ DiarizeChunkedResult stitch_chunks(
     return out;
 }
 
-DiarizeChunkedResult diarize_chunked(
-    const float* samples, size_t num_samples,
-    int target_speakers, int threads, float threshold,
-    const DiarizeChunkConfig& chunk_cfg,
-    bool enforce_floor,
-    DiarizeProgressCallback on_progress) {
+DiarizeChunkedResult stitch_diarized_chunks(const std::vector<DiarizedChunk>& chunks,
+                                            const DiarizeChunkConfig& cfg,
+                                            int target_speakers,
+                                            bool enforce_floor) {
+    std::vector<DiarizeResult> chunk_results;
+    std::vector<std::map<int, std::vector<float>>> chunk_centroids;
+    std::vector<ChunkExtents> extents;
+    chunk_results.reserve(chunks.size());
+    chunk_centroids.reserve(chunks.size());
+    extents.reserve(chunks.size());
+    for (const auto& c : chunks) {
+        chunk_results.push_back(c.diar);
+        chunk_centroids.push_back(c.centroids);
+        extents.push_back(c.extents);
+    }
+    return stitch_chunks(chunk_results, chunk_centroids, extents,
+                         cfg, target_speakers, enforce_floor);
+}
 
-    if (!samples || num_samples == 0)
+std::vector<ChunkExtents> plan_chunk_extents(size_t num_samples,
+                                             const DiarizeChunkConfig& chunk_cfg) {
+    if (num_samples == 0)
         throw RecmeetError("diarize_chunked: empty audio buffer");
 
     // M-5' validation: positive spacing with ≥ 60 s of core.
@@ -1036,72 +1145,411 @@ DiarizeChunkedResult diarize_chunked(
 
     if (extents.empty())
         throw RecmeetError("diarize_chunked: failed to build any chunk extents");
+    return extents;
+}
 
-    log_info("diarize_chunked: %zu chunks, total=%.1fs, spacing=%.1fs, overlap=%.1fs",
-             extents.size(), total_seconds, spacing_sec,
-             static_cast<double>(chunk_cfg.overlap_seconds));
+namespace {
 
-    // Single shared sessions reused across chunks (T2.0).
-    DiarizeSession diar_session(threads);
-    auto model_paths = ensure_sherpa_models();
-    SpeakerEmbeddingSession emb_session(model_paths.embedding, threads);
+void tile_overlap_span(size_t begin, size_t end, std::vector<OverlapWindow>& out) {
+    const auto width = static_cast<size_t>(OVERLAP_WINDOW_SEC * SAMPLE_RATE);
+    if (end <= begin || end - begin < width / 2) return;
+    const size_t n = std::max<size_t>(1, (end - begin) / width);
+    for (size_t k = 0; k < n; ++k)
+        out.push_back({begin + k * width, k + 1 == n ? end : begin + (k + 1) * width});
+}
 
-    std::vector<DiarizeResult> chunk_results;
-    chunk_results.reserve(extents.size());
-    std::vector<std::map<int, std::vector<float>>> chunk_centroids;
-    chunk_centroids.reserve(extents.size());
+// Samples of [begin, end) (global) that `speaker`'s segments of a chunk
+// starting at `pcm_start` cover.
+size_t covered_samples(const DiarizeResult& diar, int speaker, size_t pcm_start,
+                       size_t begin, size_t end) {
+    size_t covered = 0;
+    for (const auto& s : diar.segments) {
+        if (s.speaker != speaker || s.end <= s.start) continue;
+        const size_t lo = std::max(begin, pcm_start + static_cast<size_t>(s.start * SAMPLE_RATE));
+        const size_t hi = std::min(end, pcm_start + static_cast<size_t>(s.end * SAMPLE_RATE));
+        if (hi > lo) covered += hi - lo;
+    }
+    return covered;
+}
 
-    // Track total embedding extractions for progress denominator. We don't
-    // know the per-chunk speaker count up front so denominator is rough but
-    // monotone; granularity matters more than absolute accuracy here.
-    int extractions_done = 0;
-    int extractions_estimate = std::max<int>(1, static_cast<int>(extents.size()) * 2);
+// share_overlap: see diarize_chunk(). The private-PCM requests go through
+// the chunk's own PCM, the windows through `shared` over the whole source.
+std::map<int, std::vector<float>> shared_overlap_centroids(
+    SpeakerEmbeddingSession& emb_session, const SampleSource& audio,
+    const float* chunk_pcm, size_t chunk_n, const ChunkExtents& ext,
+    const DiarizeResult& diar, const std::vector<int>& ids,
+    const ChunkOverlap& overlap, OverlapEmbeddings& shared,
+    const std::function<void()>& on_speaker) {
+
+    const std::vector<int> owners = overlap_window_owners(diar, ext, overlap.windows);
+    std::vector<OverlapWindow> owned;
+    std::vector<int> owned_by;
+    for (size_t w = 0; w < owners.size(); ++w) {
+        if (owners[w] < 0) continue;
+        owned.push_back(overlap.windows[w]);
+        owned_by.push_back(owners[w]);
+    }
+    const auto window_raws = shared.get(emb_session, audio, owned, on_speaker);
+
+    // Weighted sums of raw vectors per speaker, in double.
+    std::map<int, std::pair<std::vector<double>, double>> sums;
+    auto accumulate = [&](int sid, const std::vector<float>& raw, double weight) {
+        if (raw.empty() || weight <= 0.0) return;
+        auto& [sum, total] = sums[sid];
+        if (sum.empty()) sum.assign(raw.size(), 0.0);
+        if (sum.size() != raw.size()) return;
+        for (size_t d = 0; d < raw.size(); ++d) sum[d] += weight * static_cast<double>(raw[d]);
+        total += weight;
+    };
+    for (size_t w = 0; w < owned.size(); ++w)
+        accumulate(owned_by[w], window_raws[w],
+                   static_cast<double>(covered_samples(diar, owned_by[w], ext.pcm_start_samples,
+                                                       owned[w].begin, owned[w].end)));
+
+    const double priv_lo = static_cast<double>(overlap.private_begin - ext.pcm_start_samples)
+                         / SAMPLE_RATE;
+    const double priv_hi = static_cast<double>(overlap.private_end - ext.pcm_start_samples)
+                         / SAMPLE_RATE;
+    std::vector<int> request_ids;
+    std::vector<std::vector<DiarizeSegment>> requests;
+    std::vector<double> weights;
+    for (int sid : ids) {
+        std::vector<DiarizeSegment> segs = select_speaker_segments(diar, sid, 0.0);
+        std::vector<DiarizeSegment> priv;
+        double speech = 0.0;
+        for (const auto& s : segs) {
+            const double lo = std::max(s.start, priv_lo), hi = std::min(s.end, priv_hi);
+            if (hi <= lo) continue;
+            priv.push_back({lo, hi, sid});
+            speech += hi - lo;
+        }
+        if (priv.empty() && sums.count(sid)) continue;  // its windows alone
+        request_ids.push_back(sid);
+        weights.push_back(priv.empty() ? -1.0 : speech * SAMPLE_RATE);
+        requests.push_back(priv.empty() ? std::move(segs) : std::move(priv));
+    }
+    auto raws = extract_speaker_embeddings(
+        emb_session, MemorySampleSource(chunk_pcm, chunk_n), requests, on_speaker);
+
+    std::map<int, std::vector<float>> centroids;
+    for (size_t r = 0; r < request_ids.size(); ++r) {
+        if (weights[r] < 0.0) {  // neither private speech nor a window
+            if (!raws[r].empty()) centroids[request_ids[r]] = std::move(raws[r]);
+            continue;
+        }
+        accumulate(request_ids[r], raws[r], weights[r]);
+    }
+    for (auto& [sid, acc] : sums) {
+        const auto& [sum, total] = acc;
+        std::vector<float> mean(sum.size());
+        for (size_t d = 0; d < sum.size(); ++d) mean[d] = static_cast<float>(sum[d] / total);
+        centroids[sid] = std::move(mean);
+    }
+    return centroids;
+}
 
-    for (size_t i = 0; i < extents.size(); ++i) {
-        const auto& ext = extents[i];
+} // namespace
+
+ChunkOverlap plan_chunk_overlap(const std::vector<ChunkExtents>& extents, size_t i) {
+    ChunkOverlap out;
+    const ChunkExtents& ext = extents.at(i);
+    out.private_begin = ext.pcm_start_samples;
+    out.private_end = ext.pcm_end_samples;
+    if (i > 0) {
+        const size_t end = std::min(ext.pcm_end_samples, extents[i - 1].pcm_end_samples);
+        tile_overlap_span(ext.pcm_start_samples, end, out.windows);
+        out.private_begin = std::max(out.private_begin, end);
+    }
+    if (i + 1 < extents.size()) {
+        const size_t begin = std::max(ext.pcm_start_samples, extents[i + 1].pcm_start_samples);
+        tile_overlap_span(begin, ext.pcm_end_samples, out.windows);
+        out.private_end = std::min(out.private_end, begin);
+    }
+    if (out.private_end < out.private_begin) out.private_end = out.private_begin;
+    return out;
+}
+
+std::vector<int> overlap_window_owners(const DiarizeResult& diar, const ChunkExtents& ext,
+                                       const std::vector<OverlapWindow>& windows) {
+    const std::vector<int> ids = unique_local_ids(diar);
+    std::vector<int> owners;
+    owners.reserve(windows.size());
+    for (const auto& w : windows) {
+        int owner = -1;
+        size_t best = (w.end - w.begin) / 2;
+        for (int sid : ids) {
+            const size_t covered = covered_samples(diar, sid, ext.pcm_start_samples,
+                                                   w.begin, w.end);
+            if (covered > best) {
+                best = covered;
+                owner = sid;
+            }
+        }
+        owners.push_back(owner);
+    }
+    return owners;
+}
 
-        // Per-chunk -1 (auto-detect) per Q1/C1 resolution (line 361).
-        diar_session.set_clustering(-1, threshold);
-
-        // L-1': non-owning view into the caller's buffer.
-        const float* chunk_pcm = samples + ext.pcm_start_samples;
-        size_t chunk_n = ext.pcm_end_samples - ext.pcm_start_samples;
-
-        DiarizeResult cr = diarize_with_session(diar_session, chunk_pcm, chunk_n,
-                                                /*progress*/nullptr);
-
-        // Step 3c-d: extract one raw centroid per chunk-local speaker.
-        std::map<int, std::vector<float>> centroids_i;
-        for (int local_sid : unique_local_ids(cr)) {
-            // Step 3e: emit a sub-chunk progress tick so the watchdog sees
-            // activity through the long extraction phase.
-            if (on_progress) {
-                int overall = static_cast<int>(
-                    100.0 * (static_cast<double>(extractions_done)
-                             / static_cast<double>(extractions_estimate)));
-                if (overall < 0) overall = 0;
-                if (overall > 99) overall = 99;
-                on_progress(overall, 100);
+std::vector<std::vector<float>> OverlapEmbeddings::get(
+    SpeakerEmbeddingSession& session, const SampleSource& audio,
+    const std::vector<OverlapWindow>& windows, const std::function<void()>& on_window) {
+
+    std::vector<std::shared_future<std::vector<float>>> futures;
+    std::vector<std::promise<std::vector<float>>> claimed;
+    std::vector<std::vector<DiarizeSegment>> requests;
+    {
+        std::lock_guard lk(mu_);
+        for (const auto& w : windows) {
+            auto [it, fresh] = windows_.try_emplace({w.begin, w.end});
+            if (fresh) {
+                claimed.emplace_back();
+                it->second = claimed.back().get_future().share();
+                requests.push_back({{static_cast<double>(w.begin) / SAMPLE_RATE,
+                                     static_cast<double>(w.end) / SAMPLE_RATE, 0}});
+                ++embedded_;
+            } else {
+                ++shared_;
             }
+            futures.push_back(it->second);
+        }
+    }
+    if (!requests.empty()) {
+        try {
+            auto raws = extract_speaker_embeddings(session, audio, requests, on_window);
+            for (size_t r = 0; r < claimed.size(); ++r) claimed[r].set_value(std::move(raws[r]));
+        } catch (...) {
+            for (auto& p : claimed) p.set_exception(std::current_exception());
+        }
+    }
+    std::vector<std::vector<float>> out;
+    out.reserve(futures.size());
+    for (auto& f : futures) out.push_back(f.get());
+    return out;
+}
 
-            std::vector<float> raw = extract_speaker_embedding(
-                emb_session, chunk_pcm, chunk_n, cr, local_sid);
-            ++extractions_done;
-            if (extractions_done > extractions_estimate)
-                extractions_estimate = extractions_done + 1;
+void OverlapEmbeddings::forget_before(size_t sample) {
+    std::lock_guard lk(mu_);
+    windows_.erase(windows_.begin(), windows_.lower_bound({sample, 0}));
+}
 
-            if (!raw.empty()) centroids_i[local_sid] = std::move(raw);
+size_t OverlapEmbeddings::embedded() const {
+    std::lock_guard lk(mu_);
+    return embedded_;
+}
+
+size_t OverlapEmbeddings::shared() const {
+    std::lock_guard lk(mu_);
+    return shared_;
+}
+
+DiarizedChunk diarize_chunk(DiarizeSession& diar_session,
+                            SpeakerEmbeddingSession& emb_session,
+                            const SampleSource& audio, const ChunkExtents& ext,
+                            float threshold, std::vector<float>& scratch,
+                            const std::function<void()>& on_speaker,
+                            OverlapEmbeddings* shared, const ChunkOverlap* overlap) {
+    // Per-chunk -1 (auto-detect) per Q1/C1 resolution (line 361).
+    diar_session.set_clustering(-1, threshold);
+
+    // L-1': a view into the source's PCM when it is already float in
+    // memory, else this chunk alone converted into `scratch`.
+    size_t chunk_n = 0;
+    const float* chunk_pcm = audio.view(
+        ext.pcm_start_samples, ext.pcm_end_samples - ext.pcm_start_samples,
+        scratch, chunk_n);
+
+    DiarizedChunk out;
+    out.extents = ext;
+    out.diar = diarize_with_session(diar_session, chunk_pcm, chunk_n,
+                                    /*progress*/nullptr);
+
+    // Step 3c-d: extract one raw centroid per chunk-local speaker, all of
+    // the chunk's speakers in one batch.
+    const std::vector<int> ids = unique_local_ids(out.diar);
+    if (shared && overlap) {
+        out.centroids = shared_overlap_centroids(emb_session, audio, chunk_pcm, chunk_n, ext,
+                                                 out.diar, ids, *overlap, *shared, on_speaker);
+        return out;
+    }
+    std::vector<std::vector<DiarizeSegment>> requests;
+    requests.reserve(ids.size());
+    for (int local_sid : ids) requests.push_back(select_speaker_segments(out.diar, local_sid, 0.0));
+    auto raws = extract_speaker_embeddings(
+        emb_session, MemorySampleSource(chunk_pcm, chunk_n), requests, on_speaker);
+    for (size_t i = 0; i < ids.size(); ++i)
+        if (!raws[i].empty()) out.centroids[ids[i]] = std::move(raws[i]);
+    return out;
+}
+
+std::vector<DiarizedChunk> diarize_chunks(
+    const SampleSource& audio, int threads, float threshold,
+    const DiarizeChunkConfig& chunk_cfg,
+    DiarizeProgressCallback on_progress,
+    const std::vector<DiarizedChunk>* reuse) {
+
+    const size_t num_samples = audio.size();
+    const std::vector<ChunkExtents> extents = plan_chunk_extents(num_samples, chunk_cfg);
+
+    log_info("diarize_chunked: %zu chunks, total=%.1fs, spacing=%.1fs, overlap=%.1fs",
+             extents.size(), static_cast<double>(num_samples) / SAMPLE_RATE,
+             static_cast<double>(chunk_cfg.chunk_minutes * 60.0f - chunk_cfg.overlap_seconds),
+             static_cast<double>(chunk_cfg.overlap_seconds));
+
+    // Indexed by chunk so stitching sees the serial order whichever worker
+    // finished first.
+    std::vector<DiarizedChunk> chunks(extents.size());
+    for (size_t i = 0; i < extents.size(); ++i) chunks[i].extents = extents[i];
+
+    // Chunks diarized during recording (live_diarize.h) are taken as they
+    // are when they cover the same PCM as the chunk planned here.
+    size_t reused = 0;
+    if (reuse) {
+        for (; reused < reuse->size() && reused < extents.size(); ++reused) {
+            const auto& r = (*reuse)[reused];
+            if (r.extents.pcm_start_samples != extents[reused].pcm_start_samples ||
+                r.extents.pcm_end_samples != extents[reused].pcm_end_samples)
+                break;
+            chunks[reused].diar = r.diar;
+            chunks[reused].centroids = r.centroids;
         }
+        if (reused > 0)
+            log_info("diarize_chunked: reusing %zu of %zu chunks diarized during recording",
+                     reused, extents.size());
+    }
+    const size_t remaining = extents.size() - reused;
 
-        chunk_results.push_back(std::move(cr));
-        chunk_centroids.push_back(std::move(centroids_i));
+    // Track total embedding extractions for progress denominator. We don't
+    // know the per-chunk speaker count up front so denominator is rough but
+    // monotone; granularity matters more than absolute accuracy here.
+    int extractions_done = 0;
+    int extractions_estimate = std::max<int>(1, static_cast<int>(remaining) * 2);
+    std::mutex progress_mtx;
+    std::atomic<size_t> next{reused};
+    std::atomic<bool> failed{false};
+    std::exception_ptr first_error;
+
+    // Step 3e: a sub-chunk progress tick per extraction so the watchdog
+    // sees activity through the long extraction phase.
+    auto on_speaker = [&] {
+        std::lock_guard lk(progress_mtx);
+        if (on_progress) {
+            int overall = static_cast<int>(
+                100.0 * (static_cast<double>(extractions_done)
+                         / static_cast<double>(extractions_estimate)));
+            if (overall < 0) overall = 0;
+            if (overall > 99) overall = 99;
+            on_progress(overall, 100);
+        }
+        ++extractions_done;
+        if (extractions_done > extractions_estimate)
+            extractions_estimate = extractions_done + 1;
+    };
+
+    // One session pair per worker, reused across the chunks it pulls
+    // (T2.0). Worker 0 takes the resident pair; the others are built here
+    // and freed on return, so their memory lasts only as long as the pass.
+    const int n_workers = remaining == 0 ? 0
+        : std::max(1, std::min(chunk_cfg.parallel_chunks, static_cast<int>(remaining)));
+    const int per_worker = n_workers > 1 ? std::max(1, threads / n_workers) : threads;
+    std::vector<std::shared_ptr<DiarizeSession>> diar_sessions;
+    std::vector<std::shared_ptr<SpeakerEmbeddingSession>> emb_sessions;
+    if (n_workers > 0) {
+        auto model_paths = ensure_sherpa_models();
+        diar_sessions.push_back(acquire_diarize_session(per_worker));
+        emb_sessions.push_back(acquire_embedding_session(model_paths.embedding, per_worker));
+        for (int w = 1; w < n_workers; ++w) {
+            diar_sessions.push_back(std::make_shared<DiarizeSession>(per_worker));
+            emb_sessions.push_back(std::make_shared<SpeakerEmbeddingSession>(
+                model_paths.embedding, per_worker));
+        }
+    }
+    if (n_workers > 1)
+        log_info("diarize_chunked: %d chunks at once, %d threads each",
+                 n_workers, per_worker);
+
+    // share_overlap: one window cache for every worker, so whichever of two
+    // neighbours gets to a shared window first embeds it for both.
+    OverlapEmbeddings overlap_cache;
+
+    auto run = [&](size_t w) {
+        std::vector<float> scratch;
+        for (;;) {
+            if (failed.load(std::memory_order_relaxed)) return;
+            if (w > 0 && chunk_cfg.shed_worker && chunk_cfg.shed_worker()) {
+                log_info("diarize_chunked: worker %zu retired to save memory", w);
+                diar_sessions[w].reset();
+                emb_sessions[w].reset();
+                return;
+            }
+            const size_t i = next.fetch_add(1);
+            if (i >= extents.size()) return;
+            try {
+                const auto started = std::chrono::steady_clock::now();
+                ChunkOverlap overlap;
+                if (chunk_cfg.share_overlap) overlap = plan_chunk_overlap(extents, i);
+                auto chunk = diarize_chunk(*diar_sessions[w], *emb_sessions[w], audio,
+                                           extents[i], threshold, scratch, on_speaker,
+                                           chunk_cfg.share_overlap ? &overlap_cache : nullptr,
+                                           &overlap);
+                chunks[i].diar = std::move(chunk.diar);
+                chunks[i].centroids = std::move(chunk.centroids);
+                if (chunk_cfg.on_chunk_done)
+                    chunk_cfg.on_chunk_done(i, extents[i], std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - started).count(), per_worker);
+            } catch (...) {
+                std::lock_guard lk(progress_mtx);
+                if (!first_error) first_error = std::current_exception();
+                failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    };
+
+    if (n_workers == 1) {
+        run(0);
+    } else if (n_workers > 1) {
+        std::vector<std::thread> pool;
+        for (int w = 1; w < n_workers; ++w)
+            pool.emplace_back(run, static_cast<size_t>(w));
+        run(0);
+        for (auto& t : pool) t.join();
     }
+    if (first_error)
+        std::rethrow_exception(first_error);
+    if (chunk_cfg.share_overlap && overlap_cache.embedded() > 0)
+        log_info("diarize_chunked: %zu overlap windows embedded, %zu shared between chunks",
+                 overlap_cache.embedded(), overlap_cache.shared());
 
     // Final progress tick at 100 %.
     if (on_progress) on_progress(100, 100);
+    return chunks;
+}
 
-    return stitch_chunks(chunk_results, chunk_centroids, extents,
-                         chunk_cfg, target_speakers, enforce_floor);
+DiarizeChunkedResult diarize_chunked(
+    const SampleSource& audio,
+    int target_speakers, int threads, float threshold,
+    const DiarizeChunkConfig& chunk_cfg,
+    bool enforce_floor,
+    DiarizeProgressCallback on_progress,
+    const std::vector<DiarizedChunk>* reuse) {
+
+    return stitch_diarized_chunks(
+        diarize_chunks(audio, threads, threshold, chunk_cfg, std::move(on_progress), reuse),
+        chunk_cfg, target_speakers, enforce_floor);
+}
+
+DiarizeChunkedResult diarize_chunked(
+    const float* samples, size_t num_samples,
+    int target_speakers, int threads, float threshold,
+    const DiarizeChunkConfig& chunk_cfg,
+    bool enforce_floor,
+    DiarizeProgressCallback on_progress) {
+
+    if (!samples)
+        throw RecmeetError("diarize_chunked: empty audio buffer");
+    return diarize_chunked(MemorySampleSource(samples, num_samples),
+                           target_speakers, threads, threshold, chunk_cfg,
+                           enforce_floor, std::move(on_progress));
 }
 #endif
 
@@ -3,12 +3,17 @@
 
 #pragma once
 
+#include "model_memory.h"
+#include "sample_source.h"
 #include "transcribe.h"
 #include "util.h"
 
 #include <functional>
+#include <future>
 #include <map>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #if RECMEET_USE_SHERPA
@@ -52,6 +57,8 @@ size_t apply_short_audio_min_duration_filter(DiarizeResult& diar,
 /// Progress callback for diarization: (num_processed_chunks, num_total_chunks).
 using DiarizeProgressCallback = std::function<void(int, int)>;
 
+class SpeakerEmbeddingSession;  // speaker_id.h
+
 /// RAII wrapper around `SherpaOnnxOfflineSpeakerDiarization`. Loads the
 /// pyannote segmentation and embedding models on construction and keeps them
 /// loaded across multiple diarize calls — `set_clustering()` mutates only the
@@ -83,8 +90,15 @@ private:
     const SherpaOnnxOfflineSpeakerDiarization* sd_ = nullptr;
     SherpaModelPaths model_paths_;
     int threads_ = 0;
+    std::string provider_;  // onnxruntime EP the session runs on
+    ModelMemory memory_;
 };
 
+/// Build a DiarizeSession, or return the one left resident by an earlier
+/// job for the same thread count and onnx_provider() when the model cache is on
+/// (model_cache.h). Callers set_clustering() before use either way.
+std::shared_ptr<DiarizeSession> acquire_diarize_session(int threads = 0);
+
 /// Run speaker diarization on a pre-loaded audio buffer (16kHz float32 mono)
 /// using a pre-built session. Caller must invoke `session.set_clustering()`
 /// at least once before this call to set the desired num_clusters/threshold.
@@ -96,6 +110,8 @@ DiarizeResult diarize_with_session(DiarizeSession& session,
 // T2.1 — chunked diarization with stitching
 // ---------------------------------------------------------------------------
 
+struct ChunkExtents;
+
 /// Configuration for chunked diarization. Defaults sized to keep each chunk's
 /// peak working set well under the iter-110 ~10 GB single-call boundary while
 /// still giving each chunk enough audio to produce well-separated clusters.
@@ -112,6 +128,27 @@ struct DiarizeChunkConfig {
     /// are merged ONLY when the ceiling (`target_speakers`) is already
     /// exceeded. Phase A.2 chose 0.55 empirically (M-4 floor).
     float collapse_threshold = 0.65f;
+    /// Chunks diarized at once, each on its own session pair with
+    /// `threads / parallel_chunks` threads (clamped to the chunk count).
+    /// Results are stitched in chunk order, so the output matches the
+    /// serial path. 1 = serial; the caller sizes it to the memory budget
+    /// (plan_diarize_parallel()).
+    int parallel_chunks = 1;
+    /// Embed the PCM adjacent chunks share once instead of once per chunk
+    /// (OverlapEmbeddings): centroids become the sample-weighted mean of
+    /// each speaker's private-PCM embedding and the overlap windows it owns,
+    /// so a wider overlap costs sherpa's segmentation pass but not a second
+    /// extraction.
+    bool share_overlap = false;
+    /// Asked by each worker but the first before it pulls another chunk;
+    /// true retires that worker and frees its sessions, so the remaining
+    /// chunks run on fewer (the memory governor). Unset = never.
+    std::function<bool()> shed_worker;
+    /// Called by the worker that diarized chunk `index` (not for live
+    /// chunks taken as they are), with its wall time and thread count.
+    /// Workers call it concurrently.
+    std::function<void(size_t index, const ChunkExtents& extents, double wall_sec,
+                       int threads)> on_chunk_done;
 
     /// Phase A instrumentation: when non-empty, `stitch_chunks` writes a JSON
     /// artifact at the end of stitching containing all global centroids, the
@@ -153,6 +190,111 @@ struct ChunkExtents {
     double offset_sec;          // == pcm_start_samples / SAMPLE_RATE
 };
 
+/// The chunk layout `diarize_chunked` uses for `num_samples` of audio.
+/// Every chunk but the last depends only on its index and `cfg`, so the
+/// leading chunks of a recording still in progress are already final (see
+/// live_diarize.h). Throws `RecmeetError` on empty audio or when
+/// `cfg.chunk_minutes * 60 <= cfg.overlap_seconds + 60` (M-5').
+std::vector<ChunkExtents> plan_chunk_extents(size_t num_samples,
+                                             const DiarizeChunkConfig& cfg);
+
+// ---------------------------------------------------------------------------
+// Shared overlap embeddings (DiarizeChunkConfig::share_overlap)
+// ---------------------------------------------------------------------------
+//
+// Adjacent chunks share overlap_seconds of PCM, so without sharing both
+// extract embeddings over it. With share_overlap each shared span is cut
+// into OVERLAP_WINDOW_SEC windows laid out from the span's start, which
+// both chunks compute identically; each window is embedded once and each
+// chunk assigns it to the local speaker covering most of it. sherpa's
+// segmentation and clustering still run over the whole chunk — its C API
+// takes PCM and returns segments, nothing in between to reuse.
+
+/// Width of one shared overlap window. Long enough for a stable embedding,
+/// short enough that most windows hold one speaker.
+inline constexpr double OVERLAP_WINDOW_SEC = 2.0;
+
+/// Global samples [begin, end) of one shared window.
+struct OverlapWindow {
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+/// How chunk `i` of a layout splits its PCM under share_overlap: the span
+/// only it holds, and the windows of the spans it shares with chunk i-1
+/// and chunk i+1 (in that order). Global samples.
+struct ChunkOverlap {
+    size_t private_begin = 0;
+    size_t private_end = 0;
+    std::vector<OverlapWindow> windows;
+};
+
+/// Chunk `i` of `extents` (plan_chunk_extents()). A shared span is tiled
+/// with OVERLAP_WINDOW_SEC windows from its start; a tail shorter than a
+/// window widens the last one, and a span shorter than half a window gets
+/// none. Both chunks sharing a span get the same windows.
+ChunkOverlap plan_chunk_overlap(const std::vector<ChunkExtents>& extents, size_t i);
+
+/// The chunk-local speaker of `diar` (chunk `ext`) whose segments cover
+/// more than half of each of `windows`, or -1 (silence, crosstalk).
+std::vector<int> overlap_window_owners(const DiarizeResult& diar, const ChunkExtents& ext,
+                                       const std::vector<OverlapWindow>& windows);
+
+/// Raw embeddings of overlap windows, shared by the chunks of one pass.
+/// Each window is embedded once: a chunk asking for windows another chunk
+/// is still embedding waits for them. Thread-safe.
+class OverlapEmbeddings {
+public:
+    /// The raw embedding of each of `windows` of `audio`, empty where none.
+    /// Those nobody has asked for yet are embedded here in one
+    /// extract_speaker_embeddings() batch; `on_window` runs before each of
+    /// them. An error reaches every chunk waiting on the batch.
+    std::vector<std::vector<float>> get(SpeakerEmbeddingSession& session,
+                                        const SampleSource& audio,
+                                        const std::vector<OverlapWindow>& windows,
+                                        const std::function<void()>& on_window = nullptr);
+
+    /// Drop the windows starting before `sample`, which no chunk still to
+    /// come reaches (the live diarizer, once a chunk is done).
+    void forget_before(size_t sample);
+
+    size_t embedded() const;  ///< windows embedded so far
+    size_t shared() const;    ///< lookups answered by a window already asked for
+
+private:
+    mutable std::mutex mu_;
+    std::map<std::pair<size_t, size_t>, std::shared_future<std::vector<float>>> windows_;
+    size_t embedded_ = 0;
+    size_t shared_ = 0;
+};
+
+/// One diarized chunk: chunk-local segments (relative to the chunk PCM
+/// start) and one raw centroid per chunk-local speaker, as `stitch_chunks`
+/// takes them.
+struct DiarizedChunk {
+    ChunkExtents extents;
+    DiarizeResult diar;
+    std::map<int, std::vector<float>> centroids;
+};
+
+/// Diarize chunk `ext` of `audio` with auto-detected clustering at
+/// `threshold` and extract its centroids. `scratch` holds the chunk's PCM
+/// when the source is not float in memory. The centroids are extracted in
+/// one extract_speaker_embeddings() batch; `on_speaker` runs before each
+/// (progress, cancellation by throwing), possibly on a batch worker.
+///
+/// With `shared` and `overlap` (share_overlap), each speaker's centroid is
+/// the sample-weighted mean of its speech in the private PCM and the
+/// `overlap` windows it owns, the windows taken from `shared`. A speaker
+/// with neither is embedded from all of its segments.
+DiarizedChunk diarize_chunk(DiarizeSession& diar_session,
+                            SpeakerEmbeddingSession& emb_session,
+                            const SampleSource& audio, const ChunkExtents& ext,
+                            float threshold, std::vector<float>& scratch,
+                            const std::function<void()>& on_speaker = nullptr,
+                            OverlapEmbeddings* shared = nullptr,
+                            const ChunkOverlap* overlap = nullptr);
+
 /// Stitch a sequence of per-chunk DiarizeResult objects into one global
 /// DiarizeChunkedResult. Each `chunk_results[i]` carries chunk-local segment
 /// times (relative to the chunk PCM start) and chunk-local speaker IDs.
@@ -201,6 +343,14 @@ DiarizeChunkedResult stitch_chunks(
     int target_speakers,
     bool enforce_floor);
 
+/// `stitch_chunks` over `chunks`: their chunk-local results, centroids and
+/// extents, as diarize_chunks() returns them or a clustering stage
+/// (stage_cache.h) stores them.
+DiarizeChunkedResult stitch_diarized_chunks(const std::vector<DiarizedChunk>& chunks,
+                                            const DiarizeChunkConfig& cfg,
+                                            int target_speakers,
+                                            bool enforce_floor);
+
 /// Run chunked diarization on a pre-loaded audio buffer (16kHz float32 mono).
 /// Slices the audio into overlapping chunks of `cfg.chunk_minutes` width with
 /// `cfg.overlap_seconds` of shared audio between adjacent chunks, runs one
@@ -227,6 +377,8 @@ DiarizeChunkedResult stitch_chunks(
 /// Throws `RecmeetError` if `cfg.chunk_minutes * 60 <= cfg.overlap_seconds + 60`
 /// (M-5'). Emits one `on_progress("diarizing", overall_pct)` call per
 /// `extract_speaker_embedding` invocation (M-3'/L-4' progress granularity).
+/// With `cfg.parallel_chunks > 1` chunks are pulled from a shared queue by
+/// that many workers; the first worker error is rethrown after all join.
 DiarizeChunkedResult diarize_chunked(
     const float* samples, size_t num_samples,
     int target_speakers, int threads, float threshold,
@@ -234,6 +386,29 @@ DiarizeChunkedResult diarize_chunked(
     bool enforce_floor,
     DiarizeProgressCallback on_progress = nullptr);
 
+/// The per-chunk half of `diarize_chunked`: every planned chunk of `audio`
+/// diarized (or taken from `reuse`, as below), unstitched. Stitching and
+/// collapse never read the audio, so these are all a later pass with other
+/// stitch/collapse settings needs.
+std::vector<DiarizedChunk> diarize_chunks(
+    const SampleSource& audio, int threads, float threshold,
+    const DiarizeChunkConfig& chunk_cfg,
+    DiarizeProgressCallback on_progress = nullptr,
+    const std::vector<DiarizedChunk>* reuse = nullptr);
+
+/// Same, pulling each chunk's PCM from `audio` (the `ChunkExtents` are the
+/// windows). Unless the source is already float in memory, only one chunk
+/// is held per worker as float32 (~chunk_minutes of audio). Leading entries
+/// of `reuse` are taken instead of diarizing their chunk while their PCM
+/// extents match the planned ones.
+DiarizeChunkedResult diarize_chunked(
+    const SampleSource& audio,
+    int target_speakers, int threads, float threshold,
+    const DiarizeChunkConfig& chunk_cfg,
+    bool enforce_floor,
+    DiarizeProgressCallback on_progress = nullptr,
+    const std::vector<DiarizedChunk>* reuse = nullptr);
+
 /// Run speaker diarization on a pre-loaded audio buffer (16kHz float32 mono).
 /// `num_speakers` here is forwarded to sherpa's clustering: 0 = auto-detect,
 /// >0 = force N clusters via `set_clustering(num_speakers)`. **Distinct
@@ -342,6 +517,20 @@ std::vector<GlobalEntry> build_short_audio_globals(
     const float* samples, size_t num_samples,
     const DiarizeResult& diar, int threads);
 
+/// The extraction half of `build_short_audio_globals`: one raw centroid per
+/// cluster ID of `diar`. Clusters whose audio yields no embedding are absent.
+std::map<int, std::vector<float>> extract_cluster_centroids(
+    const float* samples, size_t num_samples,
+    const DiarizeResult& diar, int threads);
+
+/// The other half: a globals entry for each cluster of `diar` that has a
+/// non-empty centroid in `centroids`, in ascending ID order, weighted by the
+/// cluster's total segment duration. Clusters missing from `diar` (e.g.
+/// dropped by `apply_short_audio_min_duration_filter`) are skipped.
+std::vector<GlobalEntry> globals_from_centroids(
+    const DiarizeResult& diar,
+    const std::map<int, std::vector<float>>& centroids);
+
 /// Phase B.3 — short-audio dump helper. Mirrors the centroid/sample-count
 /// vectors stored in `globals` into the JSON-dump arrays for the
 /// `dump_centroids_json` instrumentation call site in the short-audio path.
@@ -360,6 +549,17 @@ std::vector<TranscriptSegment> merge_speakers(
     const DiarizeResult& diarization,
     const std::map<int, std::string>& speaker_names = {});
 
+/// The two halves of merge_speakers(): the diarization speaker of each
+/// transcript segment (the one overlapping it most, 0 if none does), and
+/// the segments with those speakers' names prepended. The note stage
+/// (stage_cache.h) keeps the speakers so a relabel can re-run the second
+/// half alone.
+std::vector<int> assign_speakers(const std::vector<TranscriptSegment>& transcript,
+                                 const DiarizeResult& diarization);
+std::vector<TranscriptSegment> label_speakers(
+    const std::vector<TranscriptSegment>& transcript, const std::vector<int>& speakers,
+    const std::map<int, std::string>& speaker_names = {});
+
 /// Format a 0-based speaker ID as "Speaker_01", "Speaker_02", etc.
 std::string format_speaker(int speaker_id);
 
@@ -0,0 +1,237 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "diarize_sweep.h"
+#include "embedding_set.h"
+#include "log.h"
+
+#if RECMEET_USE_SHERPA
+#include "audio_view.h"
+#include "pipeline.h"
+#include "stage_cache.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <thread>
+
+namespace recmeet {
+
+std::vector<float> parse_sweep_values(const std::string& list) {
+    std::vector<float> values;
+    size_t pos = 0;
+    while (pos <= list.size()) {
+        size_t comma = list.find(',', pos);
+        if (comma == std::string::npos) comma = list.size();
+        const std::string item = list.substr(pos, comma - pos);
+        char* end = nullptr;
+        const float v = std::strtof(item.c_str(), &end);
+        if (item.empty() || *end != '\0' || !(v > 0.0f))
+            throw RecmeetError("Invalid threshold '" + item + "' in '" + list +
+                               "' (expected positive numbers separated by commas)");
+        values.push_back(v);
+        pos = comma + 1;
+    }
+    return values;
+}
+
+std::vector<SweepPoint> expand_sweep_grid(const std::vector<float>& cluster,
+                                          const std::vector<float>& stitch,
+                                          const std::vector<float>& collapse,
+                                          const Config& cfg) {
+    auto or_default = [](const std::vector<float>& v, float d) {
+        return v.empty() ? std::vector<float>{d} : v;
+    };
+    std::vector<SweepPoint> grid;
+    for (float c : or_default(cluster, cfg.cluster_threshold))
+        for (float s : or_default(stitch, cfg.stitch_threshold))
+            for (float k : or_default(collapse, cfg.collapse_threshold))
+                grid.push_back({c, s, k});
+    return grid;
+}
+
+SimilarityStats centroid_similarity_stats(const std::map<int, std::vector<float>>& centroids) {
+    SimilarityStats stats;
+    if (centroids.size() < 2) return stats;
+    const size_t dim = centroids.begin()->second.size();
+    EmbeddingSet set(dim);
+    for (const auto& [speaker, centroid] : centroids) set.add(centroid);
+
+    double sum = 0.0;
+    for (size_t i = 0; i < set.size(); ++i) {
+        for (size_t j = i + 1; j < set.size(); ++j) {
+            const double sim = set.cosine(i, j);
+            if (stats.pairs == 0 || sim < stats.min) stats.min = sim;
+            if (stats.pairs == 0 || sim > stats.max) stats.max = sim;
+            sum += sim;
+            ++stats.pairs;
+        }
+    }
+    stats.mean = sum / static_cast<double>(stats.pairs);
+    return stats;
+}
+
+#if RECMEET_USE_SHERPA
+
+namespace {
+
+struct SweepRow {
+    int speakers = 0;
+    size_t segments = 0;
+    SimilarityStats sims;
+    std::string error;  ///< non-empty when this point's clustering threw
+};
+
+void print_sweep_header() {
+    printf("%-24s %7s %7s %8s %8s %8s %8s %8s %8s\n",
+           "meeting", "cluster", "stitch", "collapse", "speakers", "segments",
+           "min_sim", "mean_sim", "max_sim");
+}
+
+void print_sweep_row(const std::string& meeting, const SweepPoint& p, const SweepRow& row) {
+    if (!row.error.empty()) {
+        printf("%-24s %7.3f %7.3f %8.3f  failed: %s\n", meeting.c_str(), p.cluster_threshold,
+               p.stitch_threshold, p.collapse_threshold, row.error.c_str());
+        return;
+    }
+    if (row.sims.pairs == 0) {
+        printf("%-24s %7.3f %7.3f %8.3f %8d %8zu %8s %8s %8s\n", meeting.c_str(),
+               p.cluster_threshold, p.stitch_threshold, p.collapse_threshold,
+               row.speakers, row.segments, "-", "-", "-");
+        return;
+    }
+    printf("%-24s %7.3f %7.3f %8.3f %8d %8zu %8.3f %8.3f %8.3f\n", meeting.c_str(),
+           p.cluster_threshold, p.stitch_threshold, p.collapse_threshold,
+           row.speakers, row.segments, row.sims.min, row.sims.mean, row.sims.max);
+}
+
+// cluster_diarization() for each of `points` over one sherpa pass, at most
+// `threads` at once. Stitching and collapse are single-threaded and touch
+// only their arguments.
+std::vector<SweepRow> cluster_points(const Config& base, const PostprocessInput& input,
+                                     const ClusteringStage& stage,
+                                     const CompactedSampleSource* speech,
+                                     const std::string& context_text,
+                                     const std::vector<SweepPoint>& points, int threads) {
+    std::vector<SweepRow> rows(points.size());
+    std::atomic<size_t> next{0};
+    auto run = [&]() {
+        for (;;) {
+            const size_t i = next.fetch_add(1);
+            if (i >= points.size()) return;
+            Config cfg = base;
+            cfg.stitch_threshold = points[i].stitch_threshold;
+            cfg.collapse_threshold = points[i].collapse_threshold;
+            try {
+                auto out = cluster_diarization(cfg, input, stage, context_text);
+                if (speech) uncompact_diarization(*speech, out.diar);
+                rows[i].speakers = out.diar.num_speakers;
+                rows[i].segments = out.diar.segments.size();
+                rows[i].sims = centroid_similarity_stats(out.centroids);
+            } catch (const std::exception& e) {
+                rows[i].error = e.what();
+            }
+        }
+    };
+    const int n = std::max(1, std::min(threads, static_cast<int>(points.size())));
+    std::vector<std::thread> pool;
+    for (int w = 1; w < n; ++w) pool.emplace_back(run);
+    run();
+    for (auto& t : pool) t.join();
+    return rows;
+}
+
+// The sherpa pass for `cfg` over `audio`, from the clustering stage when
+// its key matches. Saved back only at the configured threshold.
+ClusteringStage sherpa_pass(const Config& cfg, bool own_threshold,
+                            const PostprocessInput& input, const SampleSource& audio,
+                            const std::string& audio_hash, int threads) {
+    const fs::path path = stage_cache_path(input.audio_path, STAGE_CLUSTERING);
+    const std::string key = audio_hash.empty() ? std::string()
+        : clustering_stage_key(cfg, audio_hash, diarize_uses_chunks(cfg, audio.size()));
+    ClusteringStage stage;
+    if (!key.empty() && load_clustering_stage(path, key, stage)) {
+        fprintf(stderr, "  cluster_threshold %.3f: reusing %s\n",
+                cfg.cluster_threshold, path.filename().c_str());
+        return stage;
+    }
+
+    fprintf(stderr, "  cluster_threshold %.3f: diarizing...\n", cfg.cluster_threshold);
+    stage = diarize_for_clustering(cfg, input, audio, threads, nullptr);
+    stage.audio_hash = audio_hash;
+    if (own_threshold && !key.empty() && !stage.chunks.empty() &&
+        (stage.chunked || !stage.chunks.front().centroids.empty())) {
+        try {
+            save_clustering_stage(path, key, stage);
+        } catch (const RecmeetError& e) {
+            log_warn("Could not save clustering stage: %s", e.what());
+        }
+    }
+    return stage;
+}
+
+} // anonymous namespace
+
+int run_diarize_sweep(const Config& cfg, const std::vector<fs::path>& meetings,
+                      const std::vector<SweepPoint>& grid) {
+    const int threads = cfg.threads > 0 ? cfg.threads : default_thread_count();
+    Config base = cfg;
+    base.debug_dump_centroids_path.clear();  // one dump per point would collide
+
+    int failures = 0;
+    print_sweep_header();
+    for (const auto& dir : meetings) {
+        const std::string name = dir.filename().empty()
+            ? dir.parent_path().filename().string() : dir.filename().string();
+        try {
+            PostprocessInput input;
+            input.out_dir = dir;
+            input.audio_path = find_audio_file(dir);
+            if (input.audio_path.empty())
+                throw RecmeetError("No audio file in " + dir.string());
+            input.timestamp = derive_meeting_timestamp(dir);
+            const std::string context_text = resolve_context_text(base, dir);
+
+            AudioView audio(input.audio_path);
+            fprintf(stderr, "Sweeping %s (%.1f min, %zu points)\n", name.c_str(),
+                    audio.size() / (60.0 * SAMPLE_RATE), grid.size());
+            const std::string audio_hash = base.stage_cache ? hash_samples(audio) : "";
+            const auto speech = speech_only_source(base, input, audio, threads);
+            const SampleSource& diar_audio = speech
+                ? static_cast<const SampleSource&>(*speech) : audio;
+
+            for (size_t begin = 0; begin < grid.size();) {
+                size_t end = begin;
+                while (end < grid.size() &&
+                       grid[end].cluster_threshold == grid[begin].cluster_threshold)
+                    ++end;
+                Config pass_cfg = base;
+                pass_cfg.cluster_threshold = grid[begin].cluster_threshold;
+                const ClusteringStage stage = sherpa_pass(
+                    pass_cfg, pass_cfg.cluster_threshold == cfg.cluster_threshold,
+                    input, diar_audio, audio_hash, threads);
+
+                const std::vector<SweepPoint> points(grid.begin() + begin, grid.begin() + end);
+                const auto rows = cluster_points(pass_cfg, input, stage, speech.get(),
+                                                 context_text, points, threads);
+                for (size_t i = 0; i < rows.size(); ++i) {
+                    print_sweep_row(name, points[i], rows[i]);
+                    if (!rows[i].error.empty()) ++failures;
+                }
+                fflush(stdout);
+                begin = end;
+            }
+        } catch (const std::exception& e) {
+            fprintf(stderr, "Error: %s: %s\n", name.c_str(), e.what());
+            ++failures;
+        }
+    }
+    return failures > 0 ? 1 : 0;
+}
+
+#endif
+
+} // namespace recmeet
@@ -0,0 +1,68 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "config.h"
+#include "util.h"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Diarization threshold sweep (`--diarize-sweep`)
+// ---------------------------------------------------------------------------
+//
+// Diarizes each meeting once per cluster_threshold in the grid, then runs
+// stitching and collapse (cluster_diarization()) for every stitch/collapse
+// pair over that one sherpa pass, in parallel. Prints one row per meeting
+// and grid point: the speaker count and the pairwise cosine similarity of
+// the final centroids, the numbers the phase-a/phase-d centroid dumps were
+// diffed for.
+
+/// One point of the grid.
+struct SweepPoint {
+    float cluster_threshold = 0.0f;
+    float stitch_threshold = 0.0f;
+    float collapse_threshold = 0.0f;
+};
+
+/// Comma-separated thresholds ("0.9,1.0,1.18") in the order given.
+/// Throws RecmeetError on an empty list, a non-number or a value <= 0.
+std::vector<float> parse_sweep_values(const std::string& list);
+
+/// Every combination of the three lists, cluster_threshold outermost so the
+/// points sharing a sherpa pass are adjacent. An empty list stands for the
+/// value in `cfg`.
+std::vector<SweepPoint> expand_sweep_grid(const std::vector<float>& cluster,
+                                          const std::vector<float>& stitch,
+                                          const std::vector<float>& collapse,
+                                          const Config& cfg);
+
+/// Cosine similarity over every pair of distinct centroids. All zero with
+/// `pairs == 0` below two centroids.
+struct SimilarityStats {
+    size_t pairs = 0;
+    double min = 0.0;
+    double mean = 0.0;
+    double max = 0.0;
+};
+
+SimilarityStats centroid_similarity_stats(const std::map<int, std::vector<float>>& centroids);
+
+#if RECMEET_USE_SHERPA
+/// Sweep `grid` over each of `meetings` (meeting directories) with the rest
+/// of `cfg` as the baseline, printing the table to stdout. The sherpa pass
+/// at cfg.cluster_threshold is loaded from, and saved to, the meeting's
+/// clustering stage when the stage cache is on; other thresholds are never
+/// saved, so a later reprocess still finds its own. Returns 0, or 1 when a
+/// meeting could not be swept (the others still are).
+int run_diarize_sweep(const Config& cfg, const std::vector<fs::path>& meetings,
+                      const std::vector<SweepPoint>& grid);
+#endif
+
+} // namespace recmeet
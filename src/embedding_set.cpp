@@ -0,0 +1,165 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "embedding_set.h"
+#include "sample_kernels.h"
+#include "util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace recmeet {
+
+namespace {
+
+constexpr double kNormEps = 1e-9;
+
+double norm_of(const float* v, std::size_t n) {
+    return std::sqrt(sample_kernels().dot_f32(v, v, n));
+}
+
+double cosine_of(const float* a, double norm_a, const float* b, double norm_b,
+                 std::size_t n) {
+    const double denom = norm_a * norm_b;
+    if (n == 0 || denom < kNormEps) return 0.0;
+    return sample_kernels().dot_f32(a, b, n) / denom;
+}
+
+// Round-to-nearest-even float32 -> binary16; overflow goes to inf.
+uint16_t f32_to_f16(float f) {
+    uint32_t x;
+    std::memcpy(&x, &f, sizeof x);
+    const uint16_t sign = uint16_t((x >> 16) & 0x8000u);
+    const uint32_t abs = x & 0x7fffffffu;
+    if (abs >= 0x7f800000u)  // inf, NaN (kept quiet)
+        return sign | 0x7c00u | (abs > 0x7f800000u ? 0x200u : 0u);
+    if (abs >= 0x477ff000u) return sign | 0x7c00u;  // rounds past 65504
+    if (abs < 0x38800000u) {  // below 2^-14: subnormal or zero
+        if (abs < 0x33000000u) return sign;  // under half the smallest subnormal
+        const uint32_t man = (abs & 0x7fffffu) | 0x800000u;
+        const int shift = 126 - int(abs >> 23);  // 14..24
+        uint32_t h = man >> shift;
+        const uint32_t rest = man & ((1u << shift) - 1);
+        const uint32_t half = 1u << (shift - 1);
+        if (rest > half || (rest == half && (h & 1))) ++h;
+        return sign | uint16_t(h);
+    }
+    uint32_t h = ((abs >> 13) - (112u << 10));
+    const uint32_t rest = abs & 0x1fffu;
+    if (rest > 0x1000u || (rest == 0x1000u && (h & 1))) ++h;  // may carry into exp
+    return sign | uint16_t(h);
+}
+
+} // anonymous namespace
+
+double cosine_similarity(const std::vector<float>& a, const std::vector<float>& b) {
+    if (a.size() != b.size() || a.empty()) return 0.0;
+    return cosine_of(a.data(), norm_of(a.data(), a.size()),
+                     b.data(), norm_of(b.data(), b.size()), a.size());
+}
+
+std::size_t EmbeddingSet::add(const std::vector<float>& raw) {
+    const std::size_t i = size();
+    data_.resize((i + 1) * stride_, 0.0f);
+    norm_.push_back(0.0);
+    store(i, raw);
+    return i;
+}
+
+void EmbeddingSet::set(std::size_t i, const std::vector<float>& raw) {
+    store(i, raw);
+}
+
+void EmbeddingSet::store(std::size_t i, const std::vector<float>& raw) {
+    float* dst = data_.data() + i * stride_;
+    if (raw.size() != dim_ || dim_ == 0) {
+        std::fill(dst, dst + stride_, 0.0f);
+        norm_[i] = 0.0;
+        return;
+    }
+    std::copy(raw.begin(), raw.end(), dst);
+    norm_[i] = norm_of(dst, dim_);
+}
+
+double EmbeddingSet::cosine(std::size_t i, std::size_t j) const {
+    return cosine_of(row(i), norm_[i], row(j), norm_[j], dim_);
+}
+
+void EmbeddingSet::similarities(const std::vector<float>& query,
+                                std::vector<double>& out) const {
+    out.assign(size(), 0.0);
+    if (query.size() != dim_ || dim_ == 0) return;
+    const double qn = norm_of(query.data(), dim_);
+    for (std::size_t i = 0; i < size(); ++i)
+        out[i] = cosine_of(query.data(), qn, row(i), norm_[i], dim_);
+}
+
+const char* embedding_precision_name(EmbeddingPrecision p) {
+    switch (p) {
+    case EmbeddingPrecision::F16: return "f16";
+    case EmbeddingPrecision::Int8: return "int8";
+    default: return "f32";
+    }
+}
+
+bool parse_embedding_precision(const std::string& name, EmbeddingPrecision& out) {
+    for (auto p : {EmbeddingPrecision::F32, EmbeddingPrecision::F16, EmbeddingPrecision::Int8}) {
+        if (name == embedding_precision_name(p)) {
+            out = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string encode_embedding(const std::vector<float>& raw, EmbeddingPrecision p) {
+    std::string bytes;
+    if (p == EmbeddingPrecision::F16) {
+        bytes.reserve(raw.size() * 2);
+        for (float f : raw) {
+            const uint16_t h = f32_to_f16(f);
+            bytes += char(h & 0xff);
+            bytes += char(h >> 8);
+        }
+    } else if (p == EmbeddingPrecision::Int8) {
+        float max_abs = 0.0f;
+        for (float f : raw) max_abs = std::max(max_abs, std::fabs(f));
+        const float scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+        uint32_t bits;
+        std::memcpy(&bits, &scale, sizeof bits);
+        for (int b = 0; b < 4; ++b) bytes += char((bits >> (8 * b)) & 0xff);
+        for (float f : raw)
+            bytes += char(int8_t(std::clamp(std::lround(f / scale), -127L, 127L)));
+    }
+    return base64_encode(bytes);
+}
+
+bool decode_embedding(const std::string& text, EmbeddingPrecision p, std::vector<float>& out) {
+    std::string bytes;
+    if (!base64_decode(text, bytes)) return false;
+    const auto* u = reinterpret_cast<const unsigned char*>(bytes.data());
+    if (p == EmbeddingPrecision::F16) {
+        if (bytes.size() % 2) return false;
+        std::vector<uint16_t> halves(bytes.size() / 2);
+        for (std::size_t i = 0; i < halves.size(); ++i)
+            halves[i] = uint16_t(u[2 * i] | (u[2 * i + 1] << 8));
+        out.resize(halves.size());
+        sample_kernels().f16_to_f32(halves.data(), out.data(), halves.size());
+        return true;
+    }
+    if (p == EmbeddingPrecision::Int8) {
+        if (bytes.size() < 4) return false;
+        const uint32_t bits = u[0] | (u[1] << 8) | (u[2] << 16) | (uint32_t(u[3]) << 24);
+        float scale;
+        std::memcpy(&scale, &bits, sizeof scale);
+        out.resize(bytes.size() - 4);
+        for (std::size_t i = 0; i < out.size(); ++i)
+            out[i] = float(int8_t(u[4 + i])) * scale;
+        return true;
+    }
+    return false;
+}
+
+} // namespace recmeet
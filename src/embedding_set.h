@@ -0,0 +1,98 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+/// Cosine similarity of two raw (non-L2-normalized) embeddings: the
+/// sample_kernels() dot product over the product of the norms, in double.
+/// 0 when the sizes differ, either is empty, or the norm product is below
+/// 1e-9.
+double cosine_similarity(const std::vector<float>& a, const std::vector<float>& b);
+
+/// A set of raw speaker embeddings of one dimension, stored contiguously in
+/// 32-byte-aligned rows with their L2 norms cached, so comparing two rows
+/// costs one vectorized dot product instead of a dot and two norms.
+/// Similarities are cosine_similarity() exactly. Rows whose size is not
+/// `dim` are kept (indices stay aligned with the caller's list) but compare
+/// as 0 with everything, as cosine_similarity() treats mismatched operands.
+class EmbeddingSet {
+public:
+    explicit EmbeddingSet(std::size_t dim) : dim_(dim), stride_((dim + 7) / 8 * 8) {}
+
+    std::size_t dim() const { return dim_; }
+    std::size_t size() const { return norm_.size(); }
+
+    /// Append `raw`; returns its index.
+    std::size_t add(const std::vector<float>& raw);
+    /// Replace row `i` with `raw`.
+    void set(std::size_t i, const std::vector<float>& raw);
+
+    /// Cosine similarity of rows `i` and `j`.
+    double cosine(std::size_t i, std::size_t j) const;
+
+    /// out[i] = cosine similarity of `query` and row i, for every row.
+    void similarities(const std::vector<float>& query, std::vector<double>& out) const;
+
+private:
+    template <class T>
+    struct AlignedAllocator {
+        using value_type = T;
+        AlignedAllocator() = default;
+        template <class U> AlignedAllocator(const AlignedAllocator<U>&) {}
+        T* allocate(std::size_t n) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{32}));
+        }
+        void deallocate(T* p, std::size_t) { ::operator delete(p, std::align_val_t{32}); }
+        template <class U> bool operator==(const AlignedAllocator<U>&) const { return true; }
+        template <class U> bool operator!=(const AlignedAllocator<U>&) const { return false; }
+    };
+
+    const float* row(std::size_t i) const { return data_.data() + i * stride_; }
+    void store(std::size_t i, const std::vector<float>& raw);
+
+    std::size_t dim_;
+    std::size_t stride_;  ///< dim_ rounded up to 8 floats, so rows stay aligned
+    std::vector<float, AlignedAllocator<float>> data_;
+    std::vector<double> norm_;  ///< 0 for a row of the wrong size
+};
+
+// ---------------------------------------------------------------------------
+// Reduced-precision storage
+// ---------------------------------------------------------------------------
+//
+// Meeting speakers (speakers_<ts>.json) and exported profiles can carry
+// their embeddings at half or a quarter of float32's size. The text form
+// is base64 of little-endian bytes:
+//
+//   f16   one IEEE binary16 per element, rounded to nearest even
+//   int8  a float32 scale (max |x| / 127), then one code per element;
+//         x ~= code * scale
+//
+// Decoding gives back float32, so every comparison still runs in
+// cosine_similarity(). See docs/ARCHITECTURE.md for the similarity error
+// each adds against the 0.6 identification threshold.
+
+enum class EmbeddingPrecision { F32, F16, Int8 };
+
+/// "f32", "f16", "int8".
+const char* embedding_precision_name(EmbeddingPrecision p);
+
+/// The precision named `name`; false for anything else.
+bool parse_embedding_precision(const std::string& name, EmbeddingPrecision& out);
+
+/// `raw` as base64 at `p` (F16 or Int8; F32 is stored as a JSON array and
+/// has no text form here).
+std::string encode_embedding(const std::vector<float>& raw, EmbeddingPrecision p);
+
+/// Inverse of encode_embedding(). False when `text` is not base64 or its
+/// length does not fit `p`.
+bool decode_embedding(const std::string& text, EmbeddingPrecision p, std::vector<float>& out);
+
+} // namespace recmeet
@@ -0,0 +1,81 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "heavy_work.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace recmeet {
+
+namespace {
+
+constexpr double kMeanWeight = 0.2;  // of the newest task in mean_sec_
+constexpr int kMaxRetryAfterSec = 60;
+
+} // anonymous namespace
+
+HeavyWorkGate::HeavyWorkGate(size_t slots, size_t queue_depth)
+    : slots_(std::max<size_t>(slots, 1)), queue_depth_(queue_depth) {}
+
+bool HeavyWorkGate::run(const std::function<void()>& task) {
+    {
+        std::unique_lock<std::mutex> lock(mu_);
+        if (running_ >= slots_ || waiting_ > 0) {
+            if (waiting_ >= queue_depth_) {
+                ++rejected_;
+                return false;
+            }
+            const uint64_t ticket = next_ticket_++;
+            ++waiting_;
+            cv_.wait(lock, [&] { return running_ < slots_ && serving_ == ticket; });
+            --waiting_;
+            ++serving_;
+            cv_.notify_all();  // the next ticket may fit a second free slot
+        }
+        ++running_;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    auto finish = [&] {
+        const double sec = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        std::lock_guard<std::mutex> lock(mu_);
+        --running_;
+        ++completed_;
+        mean_sec_ = completed_ == 1 ? sec : mean_sec_ + kMeanWeight * (sec - mean_sec_);
+        cv_.notify_all();
+    };
+    try {
+        task();
+    } catch (...) {
+        finish();
+        throw;
+    }
+    finish();
+    return true;
+}
+
+int HeavyWorkGate::retry_after_sec() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    const double mean = completed_ > 0 ? mean_sec_ : 1.0;
+    const double backlog = static_cast<double>(running_ + waiting_) / static_cast<double>(slots_);
+    const int sec = static_cast<int>(std::ceil(mean * std::max(backlog, 1.0)));
+    return std::clamp(sec, 1, kMaxRetryAfterSec);
+}
+
+HeavyWorkStats HeavyWorkGate::stats() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return {running_, waiting_, completed_, rejected_};
+}
+
+size_t web_request_threads(const HeavyWorkGate& gate, size_t base, size_t fast) {
+    return std::max(base, gate.slots() + gate.queue_depth() + fast);
+}
+
+std::string heavy_work_busy_json(int retry_after_sec) {
+    return R"({"error":"server busy","retry_after":)" + std::to_string(retry_after_sec) + "}";
+}
+
+} // namespace recmeet
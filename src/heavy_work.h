@@ -0,0 +1,86 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Admission control for recmeet-web's heavy endpoints
+// ---------------------------------------------------------------------------
+//
+// Enrollment, relabel write-backs, note re-renders and reprocess dispatch
+// read meeting files, rewrite the speaker database or wait on the daemon.
+// Run unbounded on cpp-httplib's request threads, a burst of them can use
+// every thread (and, with a model loaded per request, the memory cgroup).
+// A HeavyWorkGate runs at most `slots` of them at once and lets at most
+// `queue_depth` more wait, in arrival order; past that a request is refused
+// at once, and the server answers 429 with retry_after_sec() as
+// Retry-After. The server's thread pool is sized above slots + queue_depth
+// (web_request_threads()), so health checks, listings and static files
+// always find a free thread.
+
+/// Counters for /api/health.
+struct HeavyWorkStats {
+    size_t running = 0;
+    size_t waiting = 0;
+    uint64_t completed = 0;
+    uint64_t rejected = 0;
+};
+
+class HeavyWorkGate {
+public:
+    /// `slots` is raised to 1; `queue_depth` may be 0 (refuse when busy).
+    HeavyWorkGate(size_t slots, size_t queue_depth);
+
+    HeavyWorkGate(const HeavyWorkGate&) = delete;
+    HeavyWorkGate& operator=(const HeavyWorkGate&) = delete;
+
+    /// Run `task` on the calling thread once a slot is free, waiting behind
+    /// earlier callers. False, without running it, when every slot is busy
+    /// and `queue_depth` callers already wait. An exception from `task`
+    /// frees the slot and propagates.
+    bool run(const std::function<void()>& task);
+
+    /// Seconds a refused client should wait before retrying: the mean
+    /// task time (1 s before any completes) times the backlog per slot,
+    /// rounded up, in [1, 60].
+    int retry_after_sec() const;
+
+    HeavyWorkStats stats() const;
+
+    size_t slots() const { return slots_; }
+    size_t queue_depth() const { return queue_depth_; }
+
+private:
+    const size_t slots_;
+    const size_t queue_depth_;
+
+    mutable std::mutex mu_;
+    std::condition_variable cv_;  ///< a slot was freed
+    size_t running_ = 0;
+    size_t waiting_ = 0;
+    uint64_t next_ticket_ = 0;  ///< handed to the next caller to wait
+    uint64_t serving_ = 0;      ///< the waiting ticket admitted next
+    uint64_t completed_ = 0;
+    uint64_t rejected_ = 0;
+    double mean_sec_ = 0.0;     ///< moving average of task time
+};
+
+/// cpp-httplib request threads for a server whose heavy endpoints go
+/// through `gate`: every slot and queue place, plus `fast` threads that
+/// only fast-path requests can use, and never fewer than httplib's own
+/// default of `base`.
+size_t web_request_threads(const HeavyWorkGate& gate, size_t base, size_t fast = 4);
+
+/// The 429 body: {"error":"server busy","retry_after":N}.
+std::string heavy_work_busy_json(int retry_after_sec);
+
+} // namespace recmeet
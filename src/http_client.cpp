@@ -2,12 +2,22 @@
 // SPDX-License-Identifier: MIT OR Apache-2.0
 
 #include "http_client.h"
+#include "log.h"
 #include "util.h"
 #include "version.h"
 
 #include <curl/curl.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
 #include <cstring>
+#include <exception>
+#include <mutex>
+#include <random>
 #include <string>
+#include <thread>
 
 namespace recmeet {
 
@@ -20,20 +30,96 @@ size_t write_callback(void* contents, size_t size, size_t nmemb, void* userp) {
     return total;
 }
 
-struct CurlInit {
-    CurlInit() { curl_global_init(CURL_GLOBAL_DEFAULT); }
-    ~CurlInit() { curl_global_cleanup(); }
+struct StreamSink {
+    CURL* curl;
+    std::string* response;
+    const std::function<void(const char*, size_t)>* on_data;
+    bool delivered = false;  // on_data has seen part of a response
 };
 
-CurlInit& ensure_curl() {
-    static CurlInit init;
-    return init;
+// Only a successful response is streamed; an error body is kept for the
+// exception, and leaves the request free to be retried.
+size_t stream_callback(void* contents, size_t size, size_t nmemb, void* userp) {
+    size_t total = size * nmemb;
+    auto* sink = static_cast<StreamSink*>(userp);
+    sink->response->append(static_cast<char*>(contents), total);
+    long code = 0;
+    curl_easy_getinfo(sink->curl, CURLINFO_RESPONSE_CODE, &code);
+    if (code < 400) {
+        sink->delivered = true;
+        (*sink->on_data)(static_cast<char*>(contents), total);
+    }
+    return total;
+}
+
+// Process-wide curl state. The share handle holds the DNS cache, TLS
+// sessions and open connections for every request, so a request to a host
+// that was reached before reuses its connection instead of a new TCP and
+// TLS handshake.
+class CurlGlobal {
+public:
+    CurlGlobal() {
+        curl_global_init(CURL_GLOBAL_DEFAULT);
+        share_ = curl_share_init();
+        if (share_) {
+            curl_share_setopt(share_, CURLSHOPT_LOCKFUNC, lock);
+            curl_share_setopt(share_, CURLSHOPT_UNLOCKFUNC, unlock);
+            curl_share_setopt(share_, CURLSHOPT_USERDATA, this);
+            curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+            curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+        }
+    }
+    ~CurlGlobal() {
+        if (share_) curl_share_cleanup(share_);
+        curl_global_cleanup();
+    }
+
+    CURLSH* share() const { return share_; }
+
+    // At most HTTP_MAX_IN_FLIGHT requests run at once; the rest wait here.
+    void acquire() {
+        std::unique_lock<std::mutex> lock(slots_mu_);
+        slots_cv_.wait(lock, [this] { return in_flight_ < HTTP_MAX_IN_FLIGHT; });
+        ++in_flight_;
+    }
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(slots_mu_);
+            --in_flight_;
+        }
+        slots_cv_.notify_one();
+    }
+
+private:
+    static void lock(CURL*, curl_lock_data data, curl_lock_access, void* userp) {
+        static_cast<CurlGlobal*>(userp)->locks_[data % CURL_LOCK_DATA_LAST].lock();
+    }
+    static void unlock(CURL*, curl_lock_data data, void* userp) {
+        static_cast<CurlGlobal*>(userp)->locks_[data % CURL_LOCK_DATA_LAST].unlock();
+    }
+
+    CURLSH* share_ = nullptr;
+    std::mutex locks_[CURL_LOCK_DATA_LAST];
+    std::mutex slots_mu_;
+    std::condition_variable slots_cv_;
+    size_t in_flight_ = 0;  // guarded by slots_mu_
+};
+
+CurlGlobal& ensure_curl() {
+    static CurlGlobal global;
+    return global;
 }
 
+struct InFlightSlot {
+    InFlightSlot() { ensure_curl().acquire(); }
+    ~InFlightSlot() { ensure_curl().release(); }
+};
+
 // Common curl setup: init handle, set URL, write callback, user agent, follow redirects.
 // Returns the CURL handle. Caller owns it and must call curl_easy_cleanup().
 CURL* curl_setup(const std::string& url, std::string& response, long timeout) {
-    ensure_curl();
+    CurlGlobal& global = ensure_curl();
 
     CURL* curl = curl_easy_init();
     if (!curl) throw RecmeetError("curl_easy_init failed");
@@ -46,35 +132,184 @@ CURL* curl_setup(const std::string& url, std::string& response, long timeout) {
     curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout);
     curl_easy_setopt(curl, CURLOPT_USERAGENT, ua.c_str());
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    if (global.share()) curl_easy_setopt(curl, CURLOPT_SHARE, global.share());
 
     return curl;
 }
 
-// Perform request, check result, cleanup handle. Returns HTTP status code.
-long curl_perform(CURL* curl, const std::string& method, const std::string& url,
-                  struct curl_slist* hdr_list = nullptr) {
-    CURLcode res = curl_easy_perform(curl);
-    if (hdr_list) curl_slist_free_all(hdr_list);
+// Failures that say nothing about the request itself: the connection
+// could not be made or broke. Timeouts are not among them; a request
+// that ran out its timeout would likely do so again.
+bool transient_curl_error(CURLcode res) {
+    switch (res) {
+        case CURLE_COULDNT_CONNECT:
+        case CURLE_SEND_ERROR:
+        case CURLE_RECV_ERROR:
+        case CURLE_GOT_NOTHING:
+        case CURLE_SSL_CONNECT_ERROR:
+        case CURLE_HTTP2:
+        case CURLE_HTTP2_STREAM:
+            return true;
+        default:
+            return false;
+    }
+}
+
+struct Request {
+    const char* method;            // "GET" or "POST", for messages
+    const std::string& url;
+    const std::string* json_body;  // POST body, or nullptr for a GET
+    std::map<std::string, std::string> headers;
+    long timeout;
+    const std::function<void(const char*, size_t)>* on_data = nullptr;
+};
+
+// Perform `req`, retrying per http_retryable_status() and transient
+// connection errors. Returns the response body of the final attempt and
+// sets `http_code`; throws RecmeetError when the transfer itself failed.
+std::string perform(const Request& req, long& http_code) {
+    InFlightSlot slot;
+    static thread_local std::minstd_rand jitter(std::random_device{}());
+    for (int attempt = 0;; ++attempt) {
+        std::string response;
+        CURL* curl = curl_setup(req.url, response, req.timeout);
+        StreamSink sink{curl, &response, req.on_data};
+        if (req.on_data) {
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, stream_callback);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &sink);
+        }
+
+        struct curl_slist* hdr_list = nullptr;
+        if (req.json_body) {
+            hdr_list = curl_slist_append(hdr_list, "Content-Type: application/json");
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, req.json_body->c_str());
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, req.json_body->size());
+        }
+        if (req.on_data)
+            hdr_list = curl_slist_append(hdr_list, "Accept: text/event-stream");
+        for (const auto& [key, val] : req.headers)
+            hdr_list = curl_slist_append(hdr_list, (key + ": " + val).c_str());
+        if (hdr_list)
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, hdr_list);
 
-    if (res != CURLE_OK) {
-        std::string err = curl_easy_strerror(res);
+        CURLcode res = curl_easy_perform(curl);
+        if (hdr_list) curl_slist_free_all(hdr_list);
+        http_code = 0;
+        curl_off_t retry_after = 0;
+        if (res == CURLE_OK) {
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+#if LIBCURL_VERSION_NUM >= 0x074200
+            curl_easy_getinfo(curl, CURLINFO_RETRY_AFTER, &retry_after);
+#endif
+        }
         curl_easy_cleanup(curl);
-        throw RecmeetError("HTTP " + method + " failed: " + err + " (" + url + ")");
+
+        const bool retry = !sink.delivered && attempt + 1 < HTTP_MAX_ATTEMPTS &&
+            (res == CURLE_OK ? http_retryable_status(http_code) : transient_curl_error(res));
+        if (!retry) {
+            if (res != CURLE_OK)
+                throw RecmeetError(std::string("HTTP ") + req.method + " failed: " +
+                                   curl_easy_strerror(res) + " (" + req.url + ")");
+            return response;
+        }
+
+        long delay_ms = http_retry_delay_ms(attempt, static_cast<long>(retry_after));
+        delay_ms += static_cast<long>(jitter() % static_cast<unsigned>(delay_ms / 4 + 1));
+        log_warn("HTTP %s %s: %s; retrying in %ld ms (attempt %d of %d)", req.method,
+                 req.url.c_str(),
+                 res == CURLE_OK ? ("status " + std::to_string(http_code)).c_str()
+                                 : curl_easy_strerror(res),
+                 delay_ms, attempt + 2, HTTP_MAX_ATTEMPTS);
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
     }
+}
 
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-    curl_easy_cleanup(curl);
-    return http_code;
+// http_download()'s write target. The file is opened on the first byte of
+// a 200 or 206 body, so an error response or a redirect leaves it as it was.
+struct FileSink {
+    CURL* curl;
+    const std::string* path;
+    uint64_t offset;  // bytes kept from before this attempt
+    const DownloadProgressFn* on_progress;
+    const DownloadDataFn* on_data;
+    std::FILE* file = nullptr;
+    uint64_t written = 0;
+    uint64_t total = 0;
+    bool write_failed = false;
+    std::exception_ptr data_error;  // thrown by on_data
+};
+
+size_t file_callback(void* contents, size_t size, size_t nmemb, void* userp) {
+    const size_t n = size * nmemb;
+    auto* sink = static_cast<FileSink*>(userp);
+    long code = 0;
+    curl_easy_getinfo(sink->curl, CURLINFO_RESPONSE_CODE, &code);
+    if (code == 0) code = 200;  // file:// and other non-HTTP URLs
+    if (code != 200 && code != 206) return n;  // error body, discarded
+    if (!sink->file) {
+        if (code == 200) sink->offset = 0;  // the whole file, not the range
+        sink->file = std::fopen(sink->path->c_str(), code == 206 ? "ab" : "wb");
+        if (!sink->file) {
+            sink->write_failed = true;
+            return 0;
+        }
+        curl_off_t len = -1;
+        curl_easy_getinfo(sink->curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &len);
+        if (len >= 0) sink->total = sink->offset + static_cast<uint64_t>(len);
+    }
+    if (std::fwrite(contents, 1, n, sink->file) != n) {
+        sink->write_failed = true;
+        return 0;
+    }
+    if (*sink->on_data) {
+        try {
+            (*sink->on_data)(sink->offset + sink->written, static_cast<const char*>(contents), n);
+        } catch (...) {
+            sink->data_error = std::current_exception();
+            return 0;
+        }
+    }
+    sink->written += n;
+    if (*sink->on_progress) (*sink->on_progress)(sink->offset + sink->written, sink->total);
+    return n;
+}
+
+// Picks Hugging Face's X-Linked-Etag (a quoted SHA-256) out of any
+// response on the way, the redirect to the CDN included.
+size_t linked_etag_callback(char* buffer, size_t size, size_t nitems, void* userp) {
+    const size_t n = size * nitems;
+    static const char name[] = "x-linked-etag:";
+    const size_t name_len = sizeof(name) - 1;
+    if (n <= name_len) return n;
+    for (size_t i = 0; i < name_len; ++i)
+        if (std::tolower(static_cast<unsigned char>(buffer[i])) != name[i]) return n;
+    std::string value;
+    for (size_t i = name_len; i < n; ++i) {
+        const char c = static_cast<char>(std::tolower(static_cast<unsigned char>(buffer[i])));
+        if (std::isxdigit(static_cast<unsigned char>(c))) value += c;
+        else if (c != ' ' && c != '"' && c != '\r' && c != '\n') return n;
+    }
+    if (value.size() == 64) *static_cast<std::string*>(userp) = value;
+    return n;
 }
 
 } // anonymous namespace
 
-std::string http_get(const std::string& url) {
-    std::string response;
-    CURL* curl = curl_setup(url, response, 300L);
+bool http_retryable_status(long code) {
+    return code == 429 || (code >= 500 && code != 501 && code != 505 && code < 600);
+}
 
-    long code = curl_perform(curl, "GET", url);
+long http_retry_delay_ms(int attempt, long retry_after_s) {
+    if (retry_after_s > 0) return std::min(retry_after_s * 1000, HTTP_MAX_RETRY_DELAY_MS);
+    return std::min(HTTP_RETRY_BASE_MS << std::min(std::max(attempt, 0), 16),
+                    HTTP_MAX_RETRY_DELAY_MS);
+}
+
+std::string http_get(const std::string& url) {
+    long code = 0;
+    std::string response = perform({"GET", url, nullptr, {}, 300L}, code);
     if (code >= 400)
         throw RecmeetError("HTTP GET " + std::to_string(code) + ": " + url);
 
@@ -83,16 +318,8 @@ std::string http_get(const std::string& url) {
 
 std::string http_get(const std::string& url,
                       const std::map<std::string, std::string>& headers) {
-    std::string response;
-    CURL* curl = curl_setup(url, response, 15L);
-
-    struct curl_slist* hdr_list = nullptr;
-    for (const auto& [key, val] : headers)
-        hdr_list = curl_slist_append(hdr_list, (key + ": " + val).c_str());
-    if (hdr_list)
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, hdr_list);
-
-    long code = curl_perform(curl, "GET", url, hdr_list);
+    long code = 0;
+    std::string response = perform({"GET", url, nullptr, headers, 15L}, code);
     if (code >= 400)
         throw RecmeetError("HTTP GET " + std::to_string(code) + ": " + url);
 
@@ -102,19 +329,109 @@ std::string http_get(const std::string& url,
 std::string http_post_json(const std::string& url,
                             const std::string& json_body,
                             const std::map<std::string, std::string>& headers) {
-    std::string response;
-    CURL* curl = curl_setup(url, response, 120L);
+    long code = 0;
+    std::string response = perform({"POST", url, &json_body, headers, 120L}, code);
+    if (code >= 400)
+        throw RecmeetError("API error (" + std::to_string(code) + "): " + response);
+
+    return response;
+}
+
+DownloadResult http_download(const std::string& url, const std::string& path,
+                             const DownloadProgressFn& on_progress,
+                             const DownloadDataFn& on_data) {
+    InFlightSlot slot;
+    static thread_local std::minstd_rand jitter(std::random_device{}());
+    DownloadResult result;
+    bool restarted = false;
+    for (int attempt = 0;; ++attempt) {
+        std::error_code ec;
+        uint64_t have = fs::exists(path, ec) ? fs::file_size(path, ec) : 0;
+        if (ec) have = 0;
 
-    struct curl_slist* hdr_list = nullptr;
-    hdr_list = curl_slist_append(hdr_list, "Content-Type: application/json");
-    for (const auto& [key, val] : headers)
-        hdr_list = curl_slist_append(hdr_list, (key + ": " + val).c_str());
+        std::string unused;
+        CURL* curl = curl_setup(url, unused, 0L);
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 30L);
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1024L);
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, 60L);
+        // CURLOPT_RANGE rather than RESUME_FROM: a server that ignores the
+        // range is not an error, its full body just replaces the file.
+        const std::string range = std::to_string(have) + "-";
+        const bool ranged = have > 0 && url.compare(0, 4, "http") == 0;
+        if (ranged) curl_easy_setopt(curl, CURLOPT_RANGE, range.c_str());
+        FileSink sink{curl, &path, have, &on_progress, &on_data};
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, file_callback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &sink);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, linked_etag_callback);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &result.linked_sha256);
 
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, hdr_list);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json_body.c_str());
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, json_body.size());
+        const CURLcode res = curl_easy_perform(curl);
+        long http_code = 0;
+        curl_off_t retry_after = 0;
+        if (res == CURLE_OK || sink.file) {
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+#if LIBCURL_VERSION_NUM >= 0x074200
+            curl_easy_getinfo(curl, CURLINFO_RETRY_AFTER, &retry_after);
+#endif
+        }
+        curl_easy_cleanup(curl);
+        if (sink.file && std::fclose(sink.file) != 0) sink.write_failed = true;
+        result.fetched += sink.written;
+
+        if (sink.data_error) std::rethrow_exception(sink.data_error);
+        if (sink.write_failed) throw RecmeetError("Cannot write to: " + path);
+        if (http_code == 0 && res == CURLE_OK) http_code = 200;
+        if (res == CURLE_OK && (http_code == 200 || http_code == 206)) {
+            if (!sink.file) {  // an empty body still leaves an (empty) file
+                std::FILE* f = std::fopen(path.c_str(), http_code == 206 ? "ab" : "wb");
+                if (!f) throw RecmeetError("Cannot write to: " + path);
+                std::fclose(f);
+                if (http_code == 200) sink.offset = 0;
+            }
+            result.bytes = sink.offset + sink.written;
+            return result;
+        }
+        // 416: the kept bytes do not match the file any more. Start over once.
+        if (res == CURLE_OK && http_code == 416 && have > 0 && !restarted) {
+            log_warn("HTTP GET %s: partial download does not fit; starting over", url.c_str());
+            fs::remove(path, ec);
+            restarted = true;
+            --attempt;
+            continue;
+        }
+
+        // A broken transfer resumes from where it stopped; one that made
+        // progress does not use up an attempt.
+        const bool transient = res != CURLE_OK &&
+            (transient_curl_error(res) || res == CURLE_OPERATION_TIMEDOUT ||
+             res == CURLE_PARTIAL_FILE);
+        const bool retry = attempt + 1 < HTTP_MAX_ATTEMPTS &&
+            (res == CURLE_OK ? http_retryable_status(http_code) : transient);
+        if (!retry) {
+            if (res != CURLE_OK)
+                throw RecmeetError(std::string("HTTP GET failed: ") + curl_easy_strerror(res) +
+                                   " (" + url + ")");
+            throw RecmeetError("HTTP GET " + std::to_string(http_code) + ": " + url);
+        }
+        if (sink.written > 0) attempt = -1;
+
+        long delay_ms = http_retry_delay_ms(std::max(attempt, 0), static_cast<long>(retry_after));
+        delay_ms += static_cast<long>(jitter() % static_cast<unsigned>(delay_ms / 4 + 1));
+        log_warn("HTTP GET %s: %s after %llu bytes; resuming in %ld ms", url.c_str(),
+                 res == CURLE_OK ? ("status " + std::to_string(http_code)).c_str()
+                                 : curl_easy_strerror(res),
+                 (unsigned long long)(sink.offset + sink.written), delay_ms);
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+    }
+}
 
-    long code = curl_perform(curl, "POST", url, hdr_list);
+std::string http_post_json_stream(const std::string& url,
+                                   const std::string& json_body,
+                                   const std::map<std::string, std::string>& headers,
+                                   const std::function<void(const char*, size_t)>& on_data) {
+    long code = 0;
+    std::string response =
+        perform({"POST", url, &json_body, headers, 120L, &on_data}, code);
     if (code >= 400)
         throw RecmeetError("API error (" + std::to_string(code) + "): " + response);
 
@@ -3,11 +3,40 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <string>
 
 namespace recmeet {
 
+// Every request below goes through one libcurl share handle, so DNS
+// lookups, TLS sessions and open connections (HTTP/2 where the server
+// offers it) are reused from one request to the next. At most
+// HTTP_MAX_IN_FLIGHT run at once across threads; others wait their turn.
+// A 429 or 5xx response, or a connection that fails or breaks, is retried
+// up to HTTP_MAX_ATTEMPTS times in all, after http_retry_delay_ms(). A
+// streamed response is retried only if none of it was handed over yet.
+
+/// Concurrent requests across the process.
+inline constexpr size_t HTTP_MAX_IN_FLIGHT = 8;
+/// Attempts per request, the first included.
+inline constexpr int HTTP_MAX_ATTEMPTS = 4;
+/// Backoff before the first retry; it doubles for each one after.
+inline constexpr long HTTP_RETRY_BASE_MS = 500;
+/// Longest wait before a retry, Retry-After included.
+inline constexpr long HTTP_MAX_RETRY_DELAY_MS = 30000;
+
+/// Whether a response with HTTP status `code` is worth retrying: 429 and
+/// the 5xx codes other than 501 and 505.
+bool http_retryable_status(long code);
+
+/// Milliseconds to wait before retry `attempt` (0 = the first retry): the
+/// server's Retry-After (`retry_after_s` > 0) or exponential backoff from
+/// HTTP_RETRY_BASE_MS, at most HTTP_MAX_RETRY_DELAY_MS. Callers add jitter.
+long http_retry_delay_ms(int attempt, long retry_after_s);
+
 /// HTTP GET — returns response body. Throws RecmeetError on failure.
 std::string http_get(const std::string& url);
 
@@ -20,4 +49,39 @@ std::string http_post_json(const std::string& url,
                             const std::string& json_body,
                             const std::map<std::string, std::string>& headers = {});
 
+/// HTTP POST JSON, handing the response body to `on_data` as it arrives
+/// (e.g. a text/event-stream), and returning all of it. Throws RecmeetError
+/// on failure, as http_post_json() does.
+std::string http_post_json_stream(const std::string& url,
+                                   const std::string& json_body,
+                                   const std::map<std::string, std::string>& headers,
+                                   const std::function<void(const char*, size_t)>& on_data);
+
+/// Bytes of a download on disk so far and its full size (0 while unknown).
+using DownloadProgressFn = std::function<void(uint64_t done, uint64_t total)>;
+
+/// Each piece of the body as it is written to the file, with its offset
+/// there. After a resume or a restart the offsets can go back or start
+/// past what this call has seen, so a consumer tracks its own position.
+/// An exception it throws aborts the download and is rethrown as is.
+using DownloadDataFn = std::function<void(uint64_t offset, const char* data, size_t n)>;
+
+struct DownloadResult {
+    uint64_t bytes = 0;         ///< size of the file when done
+    uint64_t fetched = 0;       ///< bytes transferred by this call (fewer when resumed)
+    std::string linked_sha256;  ///< the server's SHA-256 of the file, when it sent one
+};
+
+/// Download `url` into the file at `path`, streaming the body straight to
+/// disk. What is already in the file is kept and the rest requested with
+/// a Range header; a server that answers with the whole file instead
+/// overwrites it. A transfer that fails or stalls (under 1 KiB/s for a
+/// minute) resumes from where it stopped, per the retry rules above, with
+/// no overall timeout. `linked_sha256` is Hugging Face's X-Linked-Etag,
+/// the digest of an LFS file. Throws RecmeetError on failure, leaving the
+/// partial file for a later call to resume.
+DownloadResult http_download(const std::string& url, const std::string& path,
+                             const DownloadProgressFn& on_progress = nullptr,
+                             const DownloadDataFn& on_data = nullptr);
+
 } // namespace recmeet
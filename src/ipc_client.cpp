@@ -115,6 +115,8 @@ void IpcClient::close_connection() {
         fd_ = -1;
     }
     read_buf_.clear();
+    read_pos_ = 0;
+    framing_ = IpcFraming::Json;
 }
 
 bool IpcClient::call(const std::string& method, const JsonMap& params,
@@ -130,7 +132,7 @@ bool IpcClient::call(const std::string& method, const JsonMap& params,
     req.method = method;
     req.params = params;
 
-    std::string wire = serialize(req) + "\n";
+    std::string wire = encode_ipc_frame(req, framing_);
     ssize_t n = write(fd_, wire.data(), wire.size());
     if (n < 0) {
         err.code = static_cast<int>(IpcErrorCode::InternalError);
@@ -188,6 +190,20 @@ bool IpcClient::call(const std::string& method, IpcResponse& resp, IpcError& err
     return call(method, {}, resp, err, timeout_ms);
 }
 
+bool IpcClient::negotiate_framing(IpcFraming want, int timeout_ms) {
+    if (framing_ == want) return true;
+    JsonMap params;
+    params["framing"] = std::string(ipc_framing_name(want));
+    IpcResponse resp;
+    IpcError err;
+    // process_message() switches framing_ as it takes the response, before
+    // whatever the daemon sent after it is parsed.
+    hello_pending_ = true;
+    call("hello", params, resp, err, timeout_ms);
+    hello_pending_ = false;
+    return framing_ == want;
+}
+
 bool IpcClient::read_events(const std::string& until_event, int timeout_ms) {
     until_event_ = until_event;
     event_matched_ = false;
@@ -216,14 +232,34 @@ bool IpcClient::read_events(const std::string& until_event, int timeout_ms) {
     }
 }
 
-bool IpcClient::read_and_dispatch(int timeout_ms) {
-    // First, process ALL complete lines already in the buffer
-    size_t nl;
-    while ((nl = read_buf_.find('\n')) != std::string::npos) {
-        std::string line = read_buf_.substr(0, nl);
-        read_buf_.erase(0, nl + 1);
-        if (!line.empty()) process_line(line);
+bool IpcClient::dispatch_buffered() {
+    // Messages are parsed in place and erased together, once none is left
+    // complete. read_pos_ is taken past a message before it is dispatched:
+    // a callback may call() and so re-enter here.
+    for (;;) {
+        std::string_view body;
+        size_t used = 0;
+        switch (next_ipc_frame(std::string_view(read_buf_).substr(read_pos_), framing_,
+                               body, used)) {
+            case IpcFrameStatus::Incomplete:
+                read_buf_.erase(0, read_pos_);
+                read_pos_ = 0;
+                return true;
+            case IpcFrameStatus::Invalid:
+                close_connection();
+                return false;
+            case IpcFrameStatus::Complete:
+                read_pos_ += used;
+                if (!body.empty()) process_message(body);
+                if (fd_ < 0) return false;  // callback closed connection
+                break;
+        }
     }
+}
+
+bool IpcClient::read_and_dispatch(int timeout_ms) {
+    // First, process ALL complete messages already in the buffer
+    if (!dispatch_buffered() && !pending_done_) return false;
     if (pending_done_) return true;
     if (fd_ < 0) return false;  // callback closed connection
 
@@ -234,7 +270,10 @@ bool IpcClient::read_and_dispatch(int timeout_ms) {
 
     int ret = poll(&pfd, 1, timeout_ms);
     if (ret <= 0) return ret == 0;  // timeout → true, error → false
-    if (pfd.revents & (POLLHUP | POLLERR)) return false;
+    if (pfd.revents & (POLLHUP | POLLERR)) {
+        close_connection();
+        return false;
+    }
 
     char buf[4096];
     ssize_t n = read(fd_, buf, sizeof(buf));
@@ -245,19 +284,12 @@ bool IpcClient::read_and_dispatch(int timeout_ms) {
 
     read_buf_.append(buf, n);
 
-    while ((nl = read_buf_.find('\n')) != std::string::npos) {
-        std::string line = read_buf_.substr(0, nl);
-        read_buf_.erase(0, nl + 1);
-        if (!line.empty()) process_line(line);
-    }
-    if (pending_done_) return true;
-
-    return true;
+    return dispatch_buffered() || pending_done_;
 }
 
-void IpcClient::process_line(const std::string& line) {
+void IpcClient::process_message(std::string_view body) {
     IpcMessage msg;
-    if (!parse_ipc_message(line, msg)) return;
+    if (!parse_ipc_message(body, framing_, msg)) return;
 
     if (msg.type == IpcMessageType::Event) {
         if (!until_event_.empty() && msg.event.event == until_event_)
@@ -270,6 +302,11 @@ void IpcClient::process_line(const std::string& line) {
     if (pending_id_ > 0) {
         if ((msg.type == IpcMessageType::Response && msg.response.id == pending_id_) ||
             (msg.type == IpcMessageType::Error && msg.error.id == pending_id_)) {
+            if (hello_pending_ && msg.type == IpcMessageType::Response) {
+                auto it = msg.response.result.find("framing");
+                if (it != msg.response.result.end())
+                    parse_ipc_framing(json_val_as_string(it->second), framing_);
+            }
             pending_result_ = msg;
             pending_done_ = true;
         }
@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <string>
+#include <string_view>
 
 namespace recmeet {
 
@@ -38,6 +39,14 @@ public:
     bool call(const std::string& method, IpcResponse& resp, IpcError& err,
               int timeout_ms = 30000);
 
+    // Ask the daemon for `want` framing on this connection (`hello`).
+    // Returns true when the connection now uses it; otherwise it stays on
+    // NDJSON, e.g. with a daemon that predates `hello`. Reset by
+    // close_connection(), so call it again after each connect().
+    bool negotiate_framing(IpcFraming want, int timeout_ms = 2000);
+
+    IpcFraming framing() const { return framing_; }
+
     // Set event callback. Called on the calling thread during call() or read_events().
     void set_event_callback(EventCallback cb) { event_cb_ = std::move(cb); }
 
@@ -54,6 +63,8 @@ public:
     // Whether this client targets a remote (TCP) daemon.
     bool is_remote() const { return addr_.transport == IpcTransport::Tcp; }
 
+    const IpcAddress& address() const { return addr_; }
+
     // Get the underlying fd (for integration with external event loops).
     int fd() const { return fd_; }
 
@@ -62,7 +73,8 @@ public:
     bool read_and_dispatch(int timeout_ms);
 
 private:
-    void process_line(const std::string& line);
+    bool dispatch_buffered();
+    void process_message(std::string_view body);
     bool connect_unix();
     bool connect_tcp();
 
@@ -70,6 +82,9 @@ private:
     int fd_ = -1;
     int64_t next_id_ = 1;
     std::string read_buf_;
+    size_t read_pos_ = 0;  // start of the first message not yet dispatched
+    IpcFraming framing_ = IpcFraming::Json;
+    bool hello_pending_ = false;  // the pending call is `hello`
     EventCallback event_cb_;
 
     // For blocking call(): stores the response/error for the pending request ID.
@@ -2,9 +2,12 @@
 // SPDX-License-Identifier: MIT OR Apache-2.0
 
 #include "ipc_protocol.h"
+#include "caption_engine.h"
 #include "json_util.h"
 
+#include <charconv>
 #include <cstdlib>
+#include <cstring>
 #include <unistd.h>
 
 namespace recmeet {
@@ -78,12 +81,23 @@ std::string serialize(const IpcEvent& ev) {
 
 // ---------------------------------------------------------------------------
 // Minimal JSON parser — enough for our NDJSON protocol
+//
+// One pass over a string_view: the top-level object's known members are
+// decoded straight into the IpcMessage, strings into the JsonVal that
+// holds them. A nested object or array below that level is kept as its
+// raw JSON text.
+//
+// Parsing into a message that was parsed into before reuses its map nodes
+// and string buffers, so a stream of same-shaped messages (caption and
+// progress events) is parsed without allocating.
 // ---------------------------------------------------------------------------
 
 namespace {
 
+constexpr size_t npos = std::string_view::npos;
+
 // Skip whitespace, return current position
-size_t skip_ws(const std::string& s, size_t pos) {
+size_t skip_ws(std::string_view s, size_t pos) {
     while (pos < s.size() && (s[pos] == ' ' || s[pos] == '\t' || s[pos] == '\r' || s[pos] == '\n'))
         ++pos;
     return pos;
@@ -91,45 +105,70 @@ size_t skip_ws(const std::string& s, size_t pos) {
 
 // Parse a JSON string starting at pos (which must point to '"').
 // Returns end position (past closing '"'), or npos on error.
-size_t parse_json_string(const std::string& s, size_t pos, std::string& out) {
-    if (pos >= s.size() || s[pos] != '"') return std::string::npos;
+size_t parse_json_string(std::string_view s, size_t pos, std::string& out) {
+    if (pos >= s.size() || s[pos] != '"') return npos;
     ++pos;
     out.clear();
-    while (pos < s.size()) {
-        char c = s[pos];
-        if (c == '"') return pos + 1;
-        if (c == '\\' && pos + 1 < s.size()) {
-            ++pos;
-            switch (s[pos]) {
-                case '"':  out += '"';  break;
-                case '\\': out += '\\'; break;
-                case 'n':  out += '\n'; break;
-                case 'r':  out += '\r'; break;
-                case 't':  out += '\t'; break;
-                case '/':  out += '/';  break;
-                default:   out += '\\'; out += s[pos]; break;
-            }
-        } else {
-            out += c;
+    for (;;) {
+        // Copy the run up to the next quote or backslash in one go.
+        size_t stop = pos;
+        while (stop < s.size() && s[stop] != '"' && s[stop] != '\\') ++stop;
+        if (stop == s.size()) return npos;
+        out.append(s.data() + pos, stop - pos);
+        if (s[stop] == '"') return stop + 1;
+        if (stop + 1 >= s.size()) return npos;
+        const char c = s[stop + 1];
+        switch (c) {
+            case '"':  out += '"';  break;
+            case '\\': out += '\\'; break;
+            case 'n':  out += '\n'; break;
+            case 'r':  out += '\r'; break;
+            case 't':  out += '\t'; break;
+            case '/':  out += '/';  break;
+            default:   out += '\\'; out += c; break;
         }
-        ++pos;
+        pos = stop + 2;
     }
-    return std::string::npos;
 }
 
-// Parse a JSON value starting at pos. Returns end position or npos.
-size_t parse_json_value(const std::string& s, size_t pos, JsonVal& out) {
+// Skip a nested object or array starting at pos. Returns end position or npos.
+size_t skip_json_container(std::string_view s, size_t pos) {
+    int depth = 0;
+    bool in_str = false;
+    for (; pos < s.size(); ++pos) {
+        const char c = s[pos];
+        if (in_str) {
+            if (c == '\\') ++pos;
+            else if (c == '"') in_str = false;
+        } else if (c == '"') {
+            in_str = true;
+        } else if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}' || c == ']') {
+            if (--depth == 0) return pos + 1;
+        }
+    }
+    return npos;
+}
+
+// Parse a JSON value starting at pos. A nested object or array is stored
+// as its raw text. Returns end position or npos.
+size_t parse_json_value(std::string_view s, size_t pos, JsonVal& out) {
     pos = skip_ws(s, pos);
-    if (pos >= s.size()) return std::string::npos;
+    if (pos >= s.size()) return npos;
 
     char c = s[pos];
 
-    // String
+    // String, into the string `out` may already hold
     if (c == '"') {
-        std::string str;
-        size_t end = parse_json_string(s, pos, str);
-        if (end == std::string::npos) return end;
-        out = std::move(str);
+        auto* str = std::get_if<std::string>(&out);
+        return parse_json_string(s, pos, str ? *str : out.emplace<std::string>());
+    }
+
+    // Nested object or array
+    if (c == '{' || c == '[') {
+        size_t end = skip_json_container(s, pos);
+        if (end != npos) out.emplace<std::string>(s.substr(pos, end - pos));
         return end;
     }
 
@@ -165,78 +204,90 @@ size_t parse_json_value(const std::string& s, size_t pos, JsonVal& out) {
             if (pos < s.size() && (s[pos] == '+' || s[pos] == '-')) ++pos;
             while (pos < s.size() && s[pos] >= '0' && s[pos] <= '9') ++pos;
         }
-        std::string num_str = s.substr(start, pos - start);
-        if (is_float)
-            out = std::stod(num_str);
-        else
-            out = static_cast<int64_t>(std::stoll(num_str));
+        const char* first = s.data() + start;
+        const char* last = s.data() + pos;
+        if (!is_float) {
+            int64_t i = 0;
+            auto r = std::from_chars(first, last, i);
+            if (r.ec == std::errc() && r.ptr == last) {
+                out = i;
+                return pos;
+            }
+            // Out of int64 range: keep it as a double.
+        }
+        double d = 0.0;
+        auto r = std::from_chars(first, last, d);
+        if (r.ec != std::errc() || r.ptr != last) return npos;
+        out = d;
         return pos;
     }
 
-    return std::string::npos;
+    return npos;
 }
 
-// Parse a JSON object into a flat map. Does not recurse into nested objects;
-// nested objects/arrays are stored as their raw JSON string.
-size_t parse_json_object(const std::string& s, size_t pos, JsonMap& out) {
+// Parse a JSON object into a flat map, replacing what `out` held. Does not
+// recurse into nested objects; nested objects/arrays are stored as their
+// raw JSON string. The old entries' nodes are reused for the new ones.
+size_t parse_json_object(std::string_view s, size_t pos, JsonMap& out) {
+    JsonMap spare;
+    spare.swap(out);
+
     pos = skip_ws(s, pos);
-    if (pos >= s.size() || s[pos] != '{') return std::string::npos;
+    if (pos >= s.size() || s[pos] != '{') return npos;
     ++pos;
     pos = skip_ws(s, pos);
     if (pos < s.size() && s[pos] == '}') return pos + 1;
 
+    std::string key;
     while (pos < s.size()) {
         pos = skip_ws(s, pos);
-        std::string key;
         pos = parse_json_string(s, pos, key);
-        if (pos == std::string::npos) return pos;
+        if (pos == npos) return pos;
 
         pos = skip_ws(s, pos);
-        if (pos >= s.size() || s[pos] != ':') return std::string::npos;
+        if (pos >= s.size() || s[pos] != ':') return npos;
         ++pos;
-        pos = skip_ws(s, pos);
 
-        // Check for nested object or array — store as raw string
-        if (pos < s.size() && (s[pos] == '{' || s[pos] == '[')) {
-            size_t start = pos;
-            int depth = 1;
-            char open = s[pos], close = (open == '{') ? '}' : ']';
-            ++pos;
-            bool in_str = false;
-            while (pos < s.size() && depth > 0) {
-                if (in_str) {
-                    if (s[pos] == '\\') { ++pos; }
-                    else if (s[pos] == '"') in_str = false;
-                } else {
-                    if (s[pos] == '"') in_str = true;
-                    else if (s[pos] == open) ++depth;
-                    else if (s[pos] == close) --depth;
-                }
-                ++pos;
-            }
-            out[key] = s.substr(start, pos - start);
+        auto it = out.find(key);
+        if (it != out.end()) {
+            pos = parse_json_value(s, pos, it->second);  // repeated key: last wins
+        } else if (!spare.empty()) {
+            auto node = spare.extract(spare.begin());
+            node.key() = key;
+            pos = parse_json_value(s, pos, node.mapped());
+            out.insert(std::move(node));
         } else {
-            JsonVal val;
-            pos = parse_json_value(s, pos, val);
-            if (pos == std::string::npos) return pos;
-            out[key] = std::move(val);
+            pos = parse_json_value(s, pos, out[key]);
         }
+        if (pos == npos) return pos;
 
         pos = skip_ws(s, pos);
         if (pos < s.size() && s[pos] == ',') { ++pos; continue; }
         if (pos < s.size() && s[pos] == '}') return pos + 1;
-        return std::string::npos;
+        return npos;
     }
-    return std::string::npos;
+    return npos;
 }
 
-// Parse a nested error object: {"code": N, "message": "..."}
-bool parse_error_object(const std::string& raw, int& code, std::string& message) {
-    JsonMap map;
-    if (parse_json_object(raw, 0, map) == std::string::npos) return false;
-    code = static_cast<int>(json_val_as_int(map["code"]));
-    message = json_val_as_string(map["message"]);
-    return true;
+// A top-level member that should hold an object: parsed into `out` when
+// it does, skipped (leaving `out` empty) otherwise. Returns end position
+// or npos.
+size_t parse_member_object(std::string_view s, size_t pos, JsonMap& out) {
+    pos = skip_ws(s, pos);
+    if (pos < s.size() && s[pos] == '{') return parse_json_object(s, pos, out);
+    out.clear();
+    JsonVal ignored;
+    return parse_json_value(s, pos, ignored);
+}
+
+// A top-level member that should hold a string: parsed into `out` when it
+// does; otherwise `out` is left empty. Returns end position or npos.
+size_t parse_member_string(std::string_view s, size_t pos, std::string& out) {
+    pos = skip_ws(s, pos);
+    if (pos < s.size() && s[pos] == '"') return parse_json_string(s, pos, out);
+    out.clear();
+    JsonVal ignored;
+    return parse_json_value(s, pos, ignored);
 }
 
 } // anonymous namespace
@@ -245,58 +296,448 @@ bool parse_error_object(const std::string& raw, int& code, std::string& message)
 // Public parse
 // ---------------------------------------------------------------------------
 
-bool parse_ipc_message(const std::string& line, IpcMessage& out) {
-    JsonMap top;
-    if (parse_json_object(line, 0, top) == std::string::npos)
+bool parse_ipc_message(std::string_view line, IpcMessage& out) {
+    out.type = IpcMessageType::Unknown;
+    out.error.code = 0;
+    out.error.message.clear();
+
+    JsonVal id;
+    bool has_method = false, has_result = false, has_error = false, has_event = false;
+    bool has_params = false, has_data = false;
+
+    size_t pos = skip_ws(line, 0);
+    if (pos >= line.size() || line[pos] != '{') return false;
+    pos = skip_ws(line, pos + 1);
+    if (pos < line.size() && line[pos] == '}') return false;  // no known fields
+
+    std::string key;
+    for (;;) {
+        pos = parse_json_string(line, skip_ws(line, pos), key);
+        if (pos == npos) return false;
+        pos = skip_ws(line, pos);
+        if (pos >= line.size() || line[pos] != ':') return false;
+        ++pos;
+
+        if (key == "params") {
+            pos = parse_member_object(line, pos, out.request.params);
+            has_params = true;
+        } else if (key == "result") {
+            pos = parse_member_object(line, pos, out.response.result);
+            has_result = true;
+        } else if (key == "data") {
+            pos = parse_member_object(line, pos, out.event.data);
+            has_data = true;
+        } else if (key == "method") {
+            pos = parse_member_string(line, pos, out.request.method);
+            has_method = true;
+        } else if (key == "event") {
+            pos = parse_member_string(line, pos, out.event.event);
+            has_event = true;
+        } else if (key == "error") {
+            JsonMap err;
+            pos = parse_member_object(line, pos, err);
+            out.error.code = static_cast<int>(json_val_as_int(err["code"]));
+            out.error.message = json_val_as_string(err["message"]);
+            has_error = true;
+        } else {
+            JsonVal scratch;
+            pos = parse_json_value(line, pos, key == "id" ? id : scratch);
+        }
+        if (pos == npos) return false;
+
+        pos = skip_ws(line, pos);
+        if (pos < line.size() && line[pos] == ',') { ++pos; continue; }
+        if (pos < line.size() && line[pos] == '}') break;
         return false;
+    }
+    // What this message lacks is cleared, not left from the last one.
+    if (!has_params) out.request.params.clear();
+    if (!has_result) out.response.result.clear();
+    if (!has_data) out.event.data.clear();
+    if (!has_method) out.request.method.clear();
+    if (!has_event) out.event.event.clear();
 
     // Determine type by which keys are present
-    bool has_method = top.count("method");
-    bool has_result = top.count("result");
-    bool has_error  = top.count("error");
-    bool has_event  = top.count("event");
-
     if (has_method) {
         out.type = IpcMessageType::Request;
-        out.request.id = json_val_as_int(top["id"]);
-        out.request.method = json_val_as_string(top["method"]);
-        // Parse params sub-object if present
-        std::string params_raw = json_val_as_string(top["params"]);
-        if (!params_raw.empty() && params_raw[0] == '{')
-            parse_json_object(params_raw, 0, out.request.params);
+        out.request.id = json_val_as_int(id);
+    } else if (has_result) {
+        out.type = IpcMessageType::Response;
+        out.response.id = json_val_as_int(id);
+    } else if (has_error) {
+        out.type = IpcMessageType::Error;
+        out.error.id = json_val_as_int(id);
+    } else if (has_event) {
+        out.type = IpcMessageType::Event;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// MessagePack framing
+// ---------------------------------------------------------------------------
+
+namespace {
+
+void put_be(std::string& out, uint64_t v, int bytes) {
+    for (int i = bytes - 1; i >= 0; --i)
+        out += static_cast<char>((v >> (8 * i)) & 0xff);
+}
+
+void mp_map(std::string& out, size_t n) {
+    if (n < 16) {
+        out += static_cast<char>(0x80 | n);
+    } else if (n <= 0xffff) {
+        out += '\xde';
+        put_be(out, n, 2);
+    } else {
+        out += '\xdf';
+        put_be(out, n, 4);
+    }
+}
+
+void mp_str(std::string& out, const std::string& s) {
+    const size_t n = s.size();
+    if (n < 32) {
+        out += static_cast<char>(0xa0 | n);
+    } else if (n <= 0xff) {
+        out += '\xd9';
+        put_be(out, n, 1);
+    } else if (n <= 0xffff) {
+        out += '\xda';
+        put_be(out, n, 2);
+    } else {
+        out += '\xdb';
+        put_be(out, n, 4);
+    }
+    out += s;
+}
+
+// Smallest encoding: fixints, then uint8..64 for non-negative values and
+// int8..64 for negative ones.
+void mp_int(std::string& out, int64_t v) {
+    if (v >= 0) {
+        const uint64_t u = static_cast<uint64_t>(v);
+        if (u < 0x80)             { out += static_cast<char>(u); }
+        else if (u <= 0xff)       { out += '\xcc'; put_be(out, u, 1); }
+        else if (u <= 0xffff)     { out += '\xcd'; put_be(out, u, 2); }
+        else if (u <= 0xffffffff) { out += '\xce'; put_be(out, u, 4); }
+        else                      { out += '\xcf'; put_be(out, u, 8); }
+        return;
+    }
+    const uint64_t bits = static_cast<uint64_t>(v);
+    if (v >= -32)              { out += static_cast<char>(bits & 0xff); }
+    else if (v >= INT8_MIN)    { out += '\xd0'; put_be(out, bits, 1); }
+    else if (v >= INT16_MIN)   { out += '\xd1'; put_be(out, bits, 2); }
+    else if (v >= INT32_MIN)   { out += '\xd2'; put_be(out, bits, 4); }
+    else                       { out += '\xd3'; put_be(out, bits, 8); }
+}
+
+void mp_val(std::string& out, const JsonVal& val) {
+    struct Visitor {
+        std::string& out;
+        void operator()(std::monostate) const { out += '\xc0'; }
+        void operator()(bool b) const { out += b ? '\xc3' : '\xc2'; }
+        void operator()(int64_t i) const { mp_int(out, i); }
+        void operator()(double d) const {
+            uint64_t bits;
+            std::memcpy(&bits, &d, sizeof(bits));
+            out += '\xcb';
+            put_be(out, bits, 8);
+        }
+        void operator()(const std::string& s) const { mp_str(out, s); }
+    };
+    std::visit(Visitor{out}, val);
+}
+
+void mp_json_map(std::string& out, const JsonMap& map) {
+    mp_map(out, map.size());
+    for (const auto& [k, v] : map) {
+        mp_str(out, k);
+        mp_val(out, v);
+    }
+}
+
+// Length prefix, then whatever `write_body` appends.
+template <typename WriteBody>
+std::string msgpack_frame(WriteBody&& write_body) {
+    std::string out(4, '\0');
+    write_body(out);
+    const uint64_t n = out.size() - 4;
+    for (int i = 0; i < 4; ++i)
+        out[i] = static_cast<char>((n >> (8 * (3 - i))) & 0xff);
+    return out;
+}
+
+// Reads the subset of MessagePack msgpack_frame() writes, plus the other
+// int and float widths a peer may pick. Every read fails cleanly on a
+// truncated body.
+class MsgPackReader {
+public:
+    explicit MsgPackReader(std::string_view s) : s_(s) {}
+
+    bool at_end() const { return pos_ == s_.size(); }
+
+    bool map_header(size_t& n) {
+        uint8_t b;
+        if (!byte(b)) return false;
+        uint64_t v = 0;
+        if ((b & 0xf0) == 0x80) n = b & 0x0f;
+        else if (b == 0xde && be(2, v)) n = static_cast<size_t>(v);
+        else if (b == 0xdf && be(4, v)) n = static_cast<size_t>(v);
+        else return false;
         return true;
     }
 
-    if (has_result) {
-        out.type = IpcMessageType::Response;
-        out.response.id = json_val_as_int(top["id"]);
-        std::string result_raw = json_val_as_string(top["result"]);
-        if (!result_raw.empty() && result_raw[0] == '{')
-            parse_json_object(result_raw, 0, out.response.result);
+    bool str(std::string& out) {
+        uint8_t b;
+        if (!byte(b)) return false;
+        return str_body(b, out);
+    }
+
+    // A scalar value; a nested map or array fails.
+    bool scalar(JsonVal& out) {
+        uint8_t b;
+        if (!byte(b)) return false;
+        if (b < 0x80) { out = static_cast<int64_t>(b); return true; }
+        if (b >= 0xe0) { out = static_cast<int64_t>(static_cast<int8_t>(b)); return true; }
+        if ((b & 0xe0) == 0xa0 || (b >= 0xd9 && b <= 0xdb)) {
+            std::string s;
+            if (!str_body(b, s)) return false;
+            out = std::move(s);
+            return true;
+        }
+        uint64_t v = 0;
+        switch (b) {
+            case 0xc0: out = std::monostate{}; return true;
+            case 0xc2: out = false; return true;
+            case 0xc3: out = true; return true;
+            case 0xca: {
+                if (!be(4, v)) return false;
+                const uint32_t bits = static_cast<uint32_t>(v);
+                float f;
+                std::memcpy(&f, &bits, sizeof(f));
+                out = static_cast<double>(f);
+                return true;
+            }
+            case 0xcb: {
+                if (!be(8, v)) return false;
+                double d;
+                std::memcpy(&d, &v, sizeof(d));
+                out = d;
+                return true;
+            }
+            case 0xcc: case 0xcd: case 0xce: case 0xcf:
+                if (!be(1 << (b - 0xcc), v) || v > static_cast<uint64_t>(INT64_MAX)) return false;
+                out = static_cast<int64_t>(v);
+                return true;
+            case 0xd0: case 0xd1: case 0xd2: case 0xd3: {
+                const int bytes = 1 << (b - 0xd0);
+                if (!be(bytes, v)) return false;
+                // Sign-extend from the encoded width.
+                const int shift = 64 - 8 * bytes;
+                out = static_cast<int64_t>(v << shift) >> shift;
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    bool map(JsonMap& out) {
+        size_t n;
+        if (!map_header(n)) return false;
+        for (size_t i = 0; i < n; ++i) {
+            std::string key;
+            JsonVal val;
+            if (!str(key) || !scalar(val)) return false;
+            out[std::move(key)] = std::move(val);
+        }
         return true;
     }
 
-    if (has_error) {
-        out.type = IpcMessageType::Error;
-        out.error.id = json_val_as_int(top["id"]);
-        std::string err_raw = json_val_as_string(top["error"]);
-        if (!err_raw.empty())
-            parse_error_object(err_raw, out.error.code, out.error.message);
+private:
+    bool byte(uint8_t& b) {
+        if (pos_ >= s_.size()) return false;
+        b = static_cast<uint8_t>(s_[pos_++]);
         return true;
     }
 
-    if (has_event) {
-        out.type = IpcMessageType::Event;
-        out.event.event = json_val_as_string(top["event"]);
-        std::string data_raw = json_val_as_string(top["data"]);
-        if (!data_raw.empty() && data_raw[0] == '{')
-            parse_json_object(data_raw, 0, out.event.data);
+    bool be(int bytes, uint64_t& v) {
+        if (s_.size() - pos_ < static_cast<size_t>(bytes)) return false;
+        v = 0;
+        for (int i = 0; i < bytes; ++i)
+            v = (v << 8) | static_cast<uint8_t>(s_[pos_++]);
+        return true;
+    }
+
+    bool str_body(uint8_t b, std::string& out) {
+        uint64_t n = 0;
+        if ((b & 0xe0) == 0xa0) n = b & 0x1f;
+        else if (b < 0xd9 || b > 0xdb || !be(1 << (b - 0xd9), n)) return false;
+        if (s_.size() - pos_ < n) return false;
+        out.assign(s_.data() + pos_, static_cast<size_t>(n));
+        pos_ += static_cast<size_t>(n);
         return true;
     }
 
+    std::string_view s_;
+    size_t pos_ = 0;
+};
+
+bool parse_msgpack_message(std::string_view body, IpcMessage& out) {
+    MsgPackReader r(body);
+    size_t n;
+    if (!r.map_header(n)) return false;
+
+    JsonMap top;
+    IpcMessage msg;
+    bool has_result = false, has_error = false;
+    for (size_t i = 0; i < n; ++i) {
+        std::string key;
+        if (!r.str(key)) return false;
+        if (key == "params") {
+            if (!r.map(msg.request.params)) return false;
+        } else if (key == "result") {
+            if (!r.map(msg.response.result)) return false;
+            has_result = true;
+        } else if (key == "data") {
+            if (!r.map(msg.event.data)) return false;
+        } else if (key == "error") {
+            JsonMap err;
+            if (!r.map(err)) return false;
+            msg.error.code = static_cast<int>(json_val_as_int(err["code"]));
+            msg.error.message = json_val_as_string(err["message"]);
+            has_error = true;
+        } else {
+            JsonVal val;
+            if (!r.scalar(val)) return false;
+            top[key] = std::move(val);
+        }
+    }
+    if (!r.at_end()) return false;
+
+    // Same precedence as the JSON form.
+    const int64_t id = json_val_as_int(top["id"]);
+    if (top.count("method")) {
+        msg.type = IpcMessageType::Request;
+        msg.request.id = id;
+        msg.request.method = json_val_as_string(top["method"]);
+    } else if (has_result) {
+        msg.type = IpcMessageType::Response;
+        msg.response.id = id;
+    } else if (has_error) {
+        msg.type = IpcMessageType::Error;
+        msg.error.id = id;
+    } else if (top.count("event")) {
+        msg.type = IpcMessageType::Event;
+        msg.event.event = json_val_as_string(top["event"]);
+    } else {
+        return false;
+    }
+    out = std::move(msg);
+    return true;
+}
+
+} // anonymous namespace
+
+const char* ipc_framing_name(IpcFraming framing) {
+    return framing == IpcFraming::MsgPack ? "msgpack" : "json";
+}
+
+bool parse_ipc_framing(const std::string& name, IpcFraming& out) {
+    if (name == "json") { out = IpcFraming::Json; return true; }
+    if (name == "msgpack") { out = IpcFraming::MsgPack; return true; }
     return false;
 }
 
+std::string encode_ipc_frame(const IpcRequest& req, IpcFraming framing) {
+    if (framing == IpcFraming::Json) return serialize(req) + "\n";
+    return msgpack_frame([&](std::string& out) {
+        mp_map(out, 3);
+        mp_str(out, "id");
+        mp_int(out, req.id);
+        mp_str(out, "method");
+        mp_str(out, req.method);
+        mp_str(out, "params");
+        mp_json_map(out, req.params);
+    });
+}
+
+std::string encode_ipc_frame(const IpcResponse& resp, IpcFraming framing) {
+    if (framing == IpcFraming::Json) return serialize(resp) + "\n";
+    return msgpack_frame([&](std::string& out) {
+        mp_map(out, 2);
+        mp_str(out, "id");
+        mp_int(out, resp.id);
+        mp_str(out, "result");
+        mp_json_map(out, resp.result);
+    });
+}
+
+std::string encode_ipc_frame(const IpcError& err, IpcFraming framing) {
+    if (framing == IpcFraming::Json) return serialize(err) + "\n";
+    return msgpack_frame([&](std::string& out) {
+        mp_map(out, 2);
+        mp_str(out, "id");
+        mp_int(out, err.id);
+        mp_str(out, "error");
+        mp_map(out, 2);
+        mp_str(out, "code");
+        mp_int(out, err.code);
+        mp_str(out, "message");
+        mp_str(out, err.message);
+    });
+}
+
+std::string encode_ipc_frame(const IpcEvent& ev, IpcFraming framing) {
+    if (framing == IpcFraming::Json) return serialize(ev) + "\n";
+    return msgpack_frame([&](std::string& out) {
+        mp_map(out, 2);
+        mp_str(out, "event");
+        mp_str(out, ev.event);
+        mp_str(out, "data");
+        mp_json_map(out, ev.data);
+    });
+}
+
+IpcFrameStatus next_ipc_frame(std::string_view buf, IpcFraming framing,
+                              std::string_view& body, size_t& used) {
+    if (framing == IpcFraming::Json) {
+        const size_t nl = buf.find('\n');
+        if (nl == std::string_view::npos) return IpcFrameStatus::Incomplete;
+        body = buf.substr(0, nl);
+        used = nl + 1;
+        return IpcFrameStatus::Complete;
+    }
+    if (buf.size() < 4) return IpcFrameStatus::Incomplete;
+    size_t len = 0;
+    for (int i = 0; i < 4; ++i)
+        len = (len << 8) | static_cast<uint8_t>(buf[i]);
+    if (len > IPC_MAX_FRAME) return IpcFrameStatus::Invalid;
+    if (buf.size() - 4 < len) return IpcFrameStatus::Incomplete;
+    body = buf.substr(4, len);
+    used = 4 + len;
+    return IpcFrameStatus::Complete;
+}
+
+IpcFrameStatus take_ipc_frame(std::string& buf, IpcFraming framing, std::string& body) {
+    std::string_view view;
+    size_t used = 0;
+    IpcFrameStatus status = next_ipc_frame(buf, framing, view, used);
+    if (status != IpcFrameStatus::Complete) return status;
+    body.assign(view);
+    buf.erase(0, used);
+    return status;
+}
+
+bool parse_ipc_message(std::string_view body, IpcFraming framing, IpcMessage& out) {
+    if (framing == IpcFraming::Json) return parse_ipc_message(body, out);
+    return parse_msgpack_message(body, out);
+}
+
 // ---------------------------------------------------------------------------
 // JsonVal helpers
 // ---------------------------------------------------------------------------
@@ -391,13 +832,15 @@ IpcAddress default_ipc_address() {
 IpcEvent make_caption_event(int64_t job_id,
                             const std::string& text,
                             bool is_partial,
-                            int64_t timestamp_ms) {
+                            int64_t timestamp_ms,
+                            const std::string& source) {
     IpcEvent ev;
     ev.event = "caption";
     ev.data["job_id"]       = job_id;
     ev.data["text"]         = text;
     ev.data["is_partial"]   = is_partial;
     ev.data["timestamp_ms"] = timestamp_ms;
+    if (!source.empty()) ev.data["source"] = source;
     return ev;
 }
 
@@ -412,6 +855,23 @@ IpcEvent make_caption_degraded_event(int64_t job_id,
     return ev;
 }
 
+void add_caption_stats(JsonMap& data, const CaptionStats& stats) {
+    auto put = [&data](const std::string& name, const LatencySummary& s) {
+        data["caption_" + name + "_count"]  = static_cast<int64_t>(s.count);
+        data["caption_" + name + "_p50_ms"] = s.p50;
+        data["caption_" + name + "_p95_ms"] = s.p95;
+        data["caption_" + name + "_p99_ms"] = s.p99;
+        data["caption_" + name + "_max_ms"] = s.max;
+    };
+    put("partial", stats.partial_ms);
+    put("final", stats.final_ms);
+    put("ring", stats.ring_ms);
+    data["caption_ring_capacity_ms"] = stats.ring_capacity_ms;
+    data["caption_decode_rtf"] = stats.decode_rtf;
+    data["caption_int8"] = stats.int8;
+    data["caption_overload_tier"] = static_cast<int64_t>(stats.overload_tier);
+}
+
 IpcEvent make_caption_started_event(int64_t job_id, int64_t ts_ms) {
     IpcEvent ev;
     ev.event = "caption.started";
@@ -420,4 +880,27 @@ IpcEvent make_caption_started_event(int64_t job_id, int64_t ts_ms) {
     return ev;
 }
 
+IpcEvent make_clip_transcribed_event(int64_t clip_id,
+                                     const std::string& text,
+                                     double start_sec,
+                                     double duration_sec,
+                                     int64_t elapsed_ms) {
+    IpcEvent ev;
+    ev.event = "clip.transcribed";
+    ev.data["clip_id"]      = clip_id;
+    ev.data["text"]         = text;
+    ev.data["start_sec"]    = start_sec;
+    ev.data["duration_sec"] = duration_sec;
+    ev.data["elapsed_ms"]   = elapsed_ms;
+    return ev;
+}
+
+IpcEvent make_clip_failed_event(int64_t clip_id, const std::string& error) {
+    IpcEvent ev;
+    ev.event = "clip.transcribed";
+    ev.data["clip_id"] = clip_id;
+    ev.data["error"]   = error;
+    return ev;
+}
+
 } // namespace recmeet
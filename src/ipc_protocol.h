@@ -3,16 +3,21 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <string>
+#include <string_view>
 #include <variant>
 
 namespace recmeet {
 
+struct CaptionStats;
+
 // ---------------------------------------------------------------------------
 // IPC message types for daemon ↔ client communication
-// Wire format: newline-delimited JSON (NDJSON)
+// Wire format: newline-delimited JSON (NDJSON), or length-prefixed
+// MessagePack once a connection has negotiated it (see IpcFraming).
 // ---------------------------------------------------------------------------
 
 // JSON value: string, int64, double, bool, or null (monostate)
@@ -84,7 +89,61 @@ struct IpcMessage {
     IpcEvent event;
 };
 
-bool parse_ipc_message(const std::string& line, IpcMessage& out);
+bool parse_ipc_message(std::string_view line, IpcMessage& out);
+
+// ---------------------------------------------------------------------------
+// Framing
+//
+// Every connection starts in NDJSON. A client may send
+//   {"method":"hello","params":{"framing":"msgpack"}}
+// and the server answers, still in NDJSON, with the framing it will use,
+// {"framing":"msgpack"} or {"framing":"json"} when it declines. Each side
+// switches right after that response: the server for everything it sends
+// next, the client for its next request. A client sends nothing more until
+// the response arrives. A server without `hello` answers MethodNotFound and
+// the connection stays NDJSON.
+//
+// A MessagePack frame is a 4-byte big-endian body length, then a body
+// holding the same top-level map the JSON form does, with `params`,
+// `result`, `data` and `error` as nested maps of scalars. As in the JSON
+// form, a nested object or array travels as a string of its JSON text.
+// ---------------------------------------------------------------------------
+
+enum class IpcFraming { Json, MsgPack };
+
+// Largest MessagePack body accepted; a longer length prefix is treated as
+// a corrupt stream.
+inline constexpr size_t IPC_MAX_FRAME = 16 * 1024 * 1024;
+
+// "json" / "msgpack".
+const char* ipc_framing_name(IpcFraming framing);
+
+// Inverse of ipc_framing_name(). False, leaving `out` alone, for anything else.
+bool parse_ipc_framing(const std::string& name, IpcFraming& out);
+
+// `msg` as it goes on the wire in `framing`: the JSON line with its '\n',
+// or the length prefix and MessagePack body.
+std::string encode_ipc_frame(const IpcRequest& req, IpcFraming framing);
+std::string encode_ipc_frame(const IpcResponse& resp, IpcFraming framing);
+std::string encode_ipc_frame(const IpcError& err, IpcFraming framing);
+std::string encode_ipc_frame(const IpcEvent& ev, IpcFraming framing);
+
+enum class IpcFrameStatus { Complete, Incomplete, Invalid };
+
+// Find the next message at the front of `buf` without copying it. On
+// Complete, `body` views its body inside `buf` and `used` is the bytes the
+// message and its framing take. Invalid means the stream cannot be
+// resynchronized (a MessagePack length over IPC_MAX_FRAME). An NDJSON body
+// may be empty (a blank line).
+IpcFrameStatus next_ipc_frame(std::string_view buf, IpcFraming framing,
+                              std::string_view& body, size_t& used);
+
+// next_ipc_frame(), moving the body out of `buf` into `body`.
+// Incomplete leaves `buf` as it was.
+IpcFrameStatus take_ipc_frame(std::string& buf, IpcFraming framing, std::string& body);
+
+// Parse a body from next_ipc_frame(). Same contract as the NDJSON overload.
+bool parse_ipc_message(std::string_view body, IpcFraming framing, IpcMessage& out);
 
 // ---------------------------------------------------------------------------
 // JsonVal helpers
@@ -132,24 +191,39 @@ IpcAddress default_ipc_address();
 // its own worker thread. These helpers build IPC events with a stable wire
 // shape so daemon and clients agree on the field set:
 //
-//   {"event":"caption","data":{"job_id":N,"text":"...","is_partial":true|false,"timestamp_ms":N}}
+//   {"event":"caption","data":{"job_id":N,"text":"...","is_partial":true|false,"timestamp_ms":N,"source":"mic"|"monitor"}}
 //   {"event":"caption.degraded","data":{"job_id":N,"reason":"buffer_overrun","timestamp_ms":N}}
 //
+// `reason` is an overload tier as the engine enters it (finals_only:
+// partials suppressed; reduced_decode: and a lighter recognizer;
+// buffer_overrun: audio dropped), int8_fallback (decoding switched to the
+// quantized weights to keep up) or engine_error. The engine's stats carry
+// the tier in force as `caption_overload_tier` (0 normal .. 3 dropping).
+//
 // `text` is the recognizer's raw hypothesis (ALL-CAPS for the en-2023-06-26
 // streaming zipformer); rendering normalization is Phase 5's job.
 // `timestamp_ms` is wall-clock since the caption engine started; clients
 // treat it as a monotonic ordering hint, not an absolute meeting time.
+// `source` names the audio stream the text came from (caption_source_name());
+// it is omitted when empty. Partials of different sources interleave.
 // ---------------------------------------------------------------------------
 
 IpcEvent make_caption_event(int64_t job_id,
                             const std::string& text,
                             bool is_partial,
-                            int64_t timestamp_ms);
+                            int64_t timestamp_ms,
+                            const std::string& source = "");
 
 IpcEvent make_caption_degraded_event(int64_t job_id,
                                      const std::string& reason,
                                      int64_t timestamp_ms);
 
+// Flatten CaptionEngine::stats() into `data` (the `status.get` result or a
+// `caption.degraded` event) as `caption_{partial,final,ring}_{count,p50_ms,
+// p95_ms,p99_ms,max_ms}` plus `caption_ring_capacity_ms`, `caption_decode_rtf`,
+// `caption_int8` and `caption_overload_tier`.
+void add_caption_stats(JsonMap& data, const CaptionStats& stats);
+
 // Emitted by the recording worker once it has successfully wired a
 // CaptionEngine into the in-flight recording (whether at record.start or
 // mid-recording in response to the `captions.start_engine` verb). The
@@ -160,4 +234,26 @@ IpcEvent make_caption_degraded_event(int64_t job_id,
 //   {"event":"caption.started","data":{"job_id":N,"timestamp_ms":N}}
 IpcEvent make_caption_started_event(int64_t job_id, int64_t ts_ms);
 
+// ---------------------------------------------------------------------------
+// Clip transcription (`transcribe.clip`, clip_transcribe.h)
+//
+// The method answers at once with the clip's id; the transcript follows as
+// an event when the decode finishes, so the daemon's IPC loop never waits
+// on whisper:
+//
+//   {"event":"clip.transcribed","data":{"clip_id":N,"text":"...","start_sec":F,"duration_sec":F,"elapsed_ms":N}}
+//   {"event":"clip.transcribed","data":{"clip_id":N,"error":"..."}}
+//
+// `start_sec` is where the clip begins in the recording (or file);
+// `text` is the segments' text joined by spaces.
+// ---------------------------------------------------------------------------
+
+IpcEvent make_clip_transcribed_event(int64_t clip_id,
+                                     const std::string& text,
+                                     double start_sec,
+                                     double duration_sec,
+                                     int64_t elapsed_ms);
+
+IpcEvent make_clip_failed_event(int64_t clip_id, const std::string& error);
+
 } // namespace recmeet
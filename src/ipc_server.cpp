@@ -3,7 +3,10 @@
 
 #include "ipc_server.h"
 #include "log.h"
+#include "metrics.h"
+#include "trace.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <sys/stat.h>
@@ -15,11 +18,26 @@
 #include <netdb.h>
 #include <unistd.h>
 #include <fcntl.h>
-#include <poll.h>
+#include <sys/epoll.h>
 #include <sys/syscall.h>
 
 namespace recmeet {
 
+namespace {
+
+MetricGauge& ipc_clients_metric() {
+    static MetricGauge& g = metrics().gauge("recmeet_ipc_clients", "Connected IPC clients.");
+    return g;
+}
+
+MetricCounter& ipc_sent_metric() {
+    static MetricCounter& c = metrics().counter("recmeet_ipc_sent_bytes",
+                                                "Bytes written to IPC clients.");
+    return c;
+}
+
+} // anonymous namespace
+
 IpcServer::IpcServer(const std::string& socket_path) {
     if (!parse_ipc_address(socket_path, addr_)) {
         addr_ = default_ipc_address();
@@ -29,9 +47,11 @@ IpcServer::IpcServer(const std::string& socket_path) {
 IpcServer::~IpcServer() {
     stop();
     if (listen_fd_ >= 0) { close(listen_fd_); listen_fd_ = -1; }
+    if (epoll_fd_ >= 0) { close(epoll_fd_); epoll_fd_ = -1; }
     if (wakeup_read_ >= 0) { close(wakeup_read_); wakeup_read_ = -1; }
     if (wakeup_write_ >= 0) { close(wakeup_write_); wakeup_write_ = -1; }
     for (auto& [fd, _] : clients_) close(fd);
+    ipc_clients_metric().add(-static_cast<int64_t>(clients_.size()));
     clients_.clear();
     if (addr_.transport == IpcTransport::Unix)
         unlink(addr_.socket_path.c_str());
@@ -53,9 +73,28 @@ bool IpcServer::start() {
     fcntl(wakeup_read_, F_SETFL, O_NONBLOCK);
     fcntl(wakeup_write_, F_SETFL, O_NONBLOCK);
 
-    if (addr_.transport == IpcTransport::Tcp)
-        return start_tcp();
-    return start_unix();
+    if (!(addr_.transport == IpcTransport::Tcp ? start_tcp() : start_unix()))
+        return false;
+
+    // The wakeup pipe and the listen socket are level-triggered; clients
+    // are registered edge-triggered by accept_client().
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+        log_error("ipc_server: epoll_create1() failed: %s", strerror(errno));
+        running_ = false;
+        return false;
+    }
+    for (int fd : {wakeup_read_, listen_fd_}) {
+        struct epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            log_error("ipc_server: epoll_ctl() failed: %s", strerror(errno));
+            running_ = false;
+            return false;
+        }
+    }
+    return true;
 }
 
 bool IpcServer::start_unix() {
@@ -151,37 +190,41 @@ bool IpcServer::start_tcp() {
 
 void IpcServer::run() {
     log_debug("ipc: event loop ENTER (tid=%d)", (int)syscall(SYS_gettid));
+    struct epoll_event events[kMaxEvents];
     while (running_) {
-        // Build pollfd array: [wakeup_read, listen_fd, ...clients]
-        std::vector<struct pollfd> fds;
-        fds.push_back({wakeup_read_, POLLIN, 0});
-        fds.push_back({listen_fd_, POLLIN, 0});
-        for (auto& [fd, _] : clients_)
-            fds.push_back({fd, POLLIN, 0});
-
-        int ret = poll(fds.data(), fds.size(), -1);
+        int ret = epoll_wait(epoll_fd_, events, kMaxEvents, poll_timeout_ms());
         if (ret < 0) {
             if (errno == EINTR) continue;
-            log_error("ipc_server: poll() error: %s", strerror(errno));
+            log_error("ipc_server: epoll_wait() error: %s", strerror(errno));
             break;
         }
+        TraceSpan dispatch("ipc_dispatch");
+
+        bool woken = false;
+        for (int i = 0; i < ret; ++i) {
+            const int fd = events[i].data.fd;
+            const uint32_t what = events[i].events;
+            if (fd == wakeup_read_) {
+                woken = true;
+            } else if (fd == listen_fd_) {
+                accept_client();
+            } else {
+                // An earlier event in this batch may have dropped the client.
+                if ((what & EPOLLOUT) && clients_.count(fd))
+                    flush_client(fd);
+                if ((what & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) && clients_.count(fd))
+                    handle_client_data(fd);
+            }
+        }
 
-        // Check wakeup pipe
-        if (fds[0].revents & POLLIN) {
+        // Everything posted since the last wakeup runs as one batch.
+        if (woken) {
             drain_wakeup();
             run_posted();
             if (!running_) break;
         }
-
-        // Check listen socket
-        if (fds[1].revents & POLLIN)
-            accept_client();
-
-        // Check client sockets
-        for (size_t i = 2; i < fds.size(); ++i) {
-            if (fds[i].revents & (POLLIN | POLLHUP | POLLERR))
-                handle_client_data(fds[i].fd);
-        }
+        flush_held_partials();
+        trace_counter("ipc_clients", static_cast<double>(clients_.size()));
     }
     log_debug("ipc: event loop EXIT");
 }
@@ -195,13 +238,48 @@ void IpcServer::stop() {
     }
 }
 
+// The job an event is about, or 0 when its data names none.
+static int64_t event_job_id(const IpcEvent& ev) {
+    auto it = ev.data.find("job_id");
+    return it != ev.data.end() ? json_val_as_int(it->second) : 0;
+}
+
+bool IpcServer::wants(const ClientState& c, const IpcEvent& ev, int64_t job_id) {
+    if (!c.filtered) return true;
+    if (c.job_filter > 0 && job_id > 0 && job_id != c.job_filter) return false;
+    for (const std::string& topic : c.topics) {
+        if (topic == "*") return true;
+        if (ev.event.size() < topic.size() ||
+            ev.event.compare(0, topic.size(), topic) != 0)
+            continue;
+        if (ev.event.size() == topic.size() || ev.event[topic.size()] == '.') return true;
+    }
+    return false;
+}
+
+void IpcServer::subscribe(int fd, std::vector<std::string> topics, int64_t job_id) {
+    auto it = clients_.find(fd);
+    if (it == clients_.end()) return;
+    ClientState& c = it->second;
+    c.filtered = true;
+    c.topics = std::move(topics);
+    c.job_filter = std::max<int64_t>(job_id, 0);
+    c.partials.clear();  // held partials may no longer be wanted
+}
+
 void IpcServer::broadcast(const IpcEvent& ev) {
-    std::string wire = serialize(ev) + "\n";
-    // Copy client fds in case send_to removes one
-    std::vector<int> fds;
-    for (auto& [fd, _] : clients_) fds.push_back(fd);
-    for (int fd : fds)
-        send_to(fd, wire);
+    // Encoded once per framing in use, and only if a client wants it.
+    // Copy client fds in case send_to removes one.
+    std::string wire[2];
+    const int64_t job_id = event_job_id(ev);
+    std::vector<std::pair<int, IpcFraming>> fds;
+    for (auto& [fd, c] : clients_)
+        if (wants(c, ev, job_id)) fds.emplace_back(fd, c.framing);
+    for (auto [fd, framing] : fds) {
+        std::string& w = wire[static_cast<int>(framing)];
+        if (w.empty()) w = encode_ipc_frame(ev, framing);
+        send_to(fd, w);
+    }
 }
 
 void IpcServer::post(std::function<void()> fn) {
@@ -216,10 +294,165 @@ void IpcServer::post(std::function<void()> fn) {
     }
 }
 
+void IpcServer::post_partial(const std::string& key, IpcEvent ev) {
+    {
+        std::lock_guard<std::mutex> lock(post_mu_);
+        auto it = queued_partials_.find(key);
+        if (it != queued_partials_.end()) {
+            it->second->ev = std::move(ev);
+            return;  // already queued, and the loop already woken
+        }
+        auto queued = std::make_shared<QueuedPartial>();
+        queued->ev = std::move(ev);
+        queued_partials_[key] = queued;
+        posted_.push_back([this, key, queued] {
+            if (!queued->superseded) broadcast_partial(key, queued->ev);
+        });
+    }
+    if (wakeup_write_ >= 0) {
+        char c = 'P';
+        (void)write(wakeup_write_, &c, 1);
+    }
+}
+
+void IpcServer::post_final(const std::string& key, IpcEvent ev) {
+    {
+        std::lock_guard<std::mutex> lock(post_mu_);
+        auto it = queued_partials_.find(key);
+        if (it != queued_partials_.end()) {
+            it->second->superseded = true;
+            queued_partials_.erase(it);
+        }
+        posted_.push_back([this, key, ev = std::move(ev)] { broadcast_final(key, ev); });
+    }
+    if (wakeup_write_ >= 0) {
+        char c = 'P';
+        (void)write(wakeup_write_, &c, 1);
+    }
+}
+
+void IpcServer::set_partial_rate(int max_hz) {
+    partial_hz_ = std::max(max_hz, 0);
+}
+
+void IpcServer::configure_partials(int fd, int max_hz, bool delta) {
+    auto it = clients_.find(fd);
+    if (it == clients_.end()) return;
+    ClientState& c = it->second;
+    c.max_partial_hz = max_hz;
+    if (c.partial_delta != delta) {
+        c.partial_delta = delta;
+        for (auto& [_, p] : c.partials) p.last_text.clear();
+    }
+}
+
+std::chrono::nanoseconds IpcServer::partial_interval(int client_hz) const {
+    const int hz = std::min(client_hz >= 0 ? client_hz : partial_hz_, 1000);
+    if (hz <= 0) return std::chrono::nanoseconds(0);
+    return std::chrono::nanoseconds(1000000000 / hz);
+}
+
+void IpcServer::broadcast_partial(const std::string& key, const IpcEvent& ev) {
+    const auto now = std::chrono::steady_clock::now();
+    const int64_t job_id = event_job_id(ev);
+    std::vector<int> fds;
+    for (auto& [fd, c] : clients_)
+        if (wants(c, ev, job_id)) fds.push_back(fd);
+    for (int fd : fds) {
+        auto it = clients_.find(fd);
+        if (it == clients_.end()) continue;
+        PartialState& p = it->second.partials[key];
+        if (!it->second.write_buf.empty() ||
+            now - p.last_sent < partial_interval(it->second.max_partial_hz)) {
+            p.pending = ev;
+            p.held = true;
+            continue;
+        }
+        send_partial(fd, key, ev, now);
+    }
+}
+
+void IpcServer::broadcast_final(const std::string& key, const IpcEvent& ev) {
+    for (auto& [_, c] : clients_) c.partials.erase(key);
+    broadcast(ev);
+}
+
+void IpcServer::send_partial(int fd, const std::string& key, const IpcEvent& ev,
+                             std::chrono::steady_clock::time_point now) {
+    auto it = clients_.find(fd);
+    if (it == clients_.end()) return;
+    PartialState& p = it->second.partials[key];
+    p.last_sent = now;
+    p.held = false;
+    p.pending = {};
+    const IpcFraming framing = it->second.framing;
+    if (!it->second.partial_delta) {
+        send_to(fd, encode_ipc_frame(ev, framing));
+        return;
+    }
+
+    auto text_it = ev.data.find("text");
+    const std::string text =
+        text_it != ev.data.end() ? json_val_as_string(text_it->second) : std::string();
+    size_t keep = 0;
+    const size_t limit = std::min(p.last_text.size(), text.size());
+    while (keep < limit && p.last_text[keep] == text[keep]) ++keep;
+    // Never split a UTF-8 sequence: back off to the start of a character.
+    while (keep > 0 && keep < text.size() && (text[keep] & 0xC0) == 0x80) --keep;
+
+    IpcEvent out = ev;
+    out.data["text"] = text.substr(keep);
+    out.data["keep"] = static_cast<int64_t>(keep);
+    out.data["format"] = std::string("delta");
+    p.last_text = text;
+    send_to(fd, encode_ipc_frame(out, framing));
+}
+
+void IpcServer::flush_held_partials() {
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<std::pair<int, std::string>> due;
+    for (auto& [fd, c] : clients_) {
+        if (!c.write_buf.empty()) continue;  // sent once the backlog drains
+        const auto interval = partial_interval(c.max_partial_hz);
+        for (auto& [key, p] : c.partials)
+            if (p.held && now - p.last_sent >= interval) due.emplace_back(fd, key);
+    }
+    for (const auto& [fd, key] : due) {
+        auto it = clients_.find(fd);
+        if (it == clients_.end()) continue;
+        auto p = it->second.partials.find(key);
+        if (p == it->second.partials.end() || !p->second.held) continue;
+        IpcEvent ev = std::move(p->second.pending);
+        send_partial(fd, key, ev, now);
+    }
+}
+
+int IpcServer::poll_timeout_ms() const {
+    const auto now = std::chrono::steady_clock::now();
+    int timeout = -1;
+    for (const auto& [_, c] : clients_) {
+        if (!c.write_buf.empty()) continue;  // POLLOUT wakes the loop
+        const auto interval = partial_interval(c.max_partial_hz);
+        for (const auto& [key, p] : c.partials) {
+            if (!p.held) continue;
+            auto wait = std::chrono::ceil<std::chrono::milliseconds>(
+                p.last_sent + interval - now).count();
+            int ms = static_cast<int>(std::max<int64_t>(wait, 0));
+            if (timeout < 0 || ms < timeout) timeout = ms;
+        }
+    }
+    return timeout;
+}
+
 void IpcServer::accept_client() {
-    int fd = accept(listen_fd_, nullptr, nullptr);
-    if (fd < 0) return;
-    fcntl(fd, F_SETFL, O_NONBLOCK);
+    for (;;) {
+        int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;  // EAGAIN: backlog empty
+        add_client(fd);
+    }
+}
+
+void IpcServer::add_client(int fd) {
 
     if (addr_.transport == IpcTransport::Tcp) {
         int yes = 1;
@@ -233,49 +466,87 @@ void IpcServer::accept_client() {
         setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &cnt, sizeof(cnt));
     }
 
+    // Edge-triggered: handle_client_data() reads until EAGAIN, and
+    // EPOLLOUT fires each time a full socket buffer drains.
+    struct epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    ev.data.fd = fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        log_error("ipc_server: epoll_ctl(fd=%d) failed: %s", fd, strerror(errno));
+        close(fd);
+        return;
+    }
     clients_[fd] = {};
+    ipc_clients_metric().add(1);
     log_info("ipc_server: client connected (fd=%d, total=%zu)", fd, clients_.size());
 }
 
 void IpcServer::handle_client_data(int fd) {
-    char buf[4096];
-    ssize_t n = read(fd, buf, sizeof(buf));
-    if (n <= 0) {
-        remove_client(fd);
-        return;
-    }
-
     auto it = clients_.find(fd);
     if (it == clients_.end()) return;
-    it->second.read_buf.append(buf, n);
 
-    // Process complete lines (NDJSON)
-    std::string& rbuf = it->second.read_buf;
-    size_t pos;
-    while ((pos = rbuf.find('\n')) != std::string::npos) {
-        std::string line = rbuf.substr(0, pos);
-        rbuf.erase(0, pos + 1);
+    // Edge-triggered: take everything the socket holds. Requests that
+    // arrived before an EOF are still answered (a half-closed client may
+    // be waiting for them).
+    char buf[16384];
+    bool eof = false;
+    for (;;) {
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n > 0) {
+            it->second.read_buf.append(buf, static_cast<size_t>(n));
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        eof = true;
+        break;
+    }
+
+    // Process complete messages in place; what they took is erased from
+    // read_buf once, at the end. A reply can drop the client (a backlog
+    // over kMaxClientBacklog) or change its framing (`hello`), so it is
+    // looked up per message.
+    size_t done = 0;
+    IpcMessage msg;
+    for (;;) {
+        it = clients_.find(fd);
+        if (it == clients_.end()) return;
+        const IpcFraming framing = it->second.framing;
+        std::string_view body;
+        size_t used = 0;
+        IpcFrameStatus status = next_ipc_frame(
+            std::string_view(it->second.read_buf).substr(done), framing, body, used);
+        if (status == IpcFrameStatus::Incomplete) break;
+        if (status == IpcFrameStatus::Invalid) {
+            log_warn("ipc_server: client fd=%d sent a corrupt frame; disconnecting", fd);
+            remove_client(fd);
+            return;
+        }
+        done += used;
 
-        if (line.empty()) continue;
+        if (body.empty()) continue;
 
-        IpcMessage msg;
-        if (!parse_ipc_message(line, msg) || msg.type != IpcMessageType::Request) {
+        if (!parse_ipc_message(body, framing, msg) || msg.type != IpcMessageType::Request) {
             IpcError err;
             err.id = 0;
             err.code = static_cast<int>(IpcErrorCode::InvalidRequest);
             err.message = "Invalid request";
-            send_to(fd, serialize(err) + "\n");
+            send_to(fd, encode_ipc_frame(err, framing));
             continue;
         }
 
         log_debug("ipc: handling '%s' from fd=%d", msg.request.method.c_str(), fd);
+        if (msg.request.method == "hello") {
+            handle_hello(fd, msg.request);
+            continue;
+        }
         auto handler_it = handlers_.find(msg.request.method);
         if (handler_it == handlers_.end()) {
             IpcError err;
             err.id = msg.request.id;
             err.code = static_cast<int>(IpcErrorCode::MethodNotFound);
             err.message = "Method not found: " + msg.request.method;
-            send_to(fd, serialize(err) + "\n");
+            send_to(fd, encode_ipc_frame(err, framing));
             continue;
         }
 
@@ -284,30 +555,95 @@ void IpcServer::handle_client_data(int fd) {
         resp.id = msg.request.id;
         err.id = msg.request.id;
 
-        if (handler_it->second(msg.request, resp, err))
-            send_to(fd, serialize(resp) + "\n");
+        current_client_ = fd;
+        const bool ok = handler_it->second(msg.request, resp, err);
+        current_client_ = -1;
+        if (ok)
+            send_to(fd, encode_ipc_frame(resp, framing));
         else
-            send_to(fd, serialize(err) + "\n");
+            send_to(fd, encode_ipc_frame(err, framing));
     }
+    it->second.read_buf.erase(0, done);
+    if (eof) remove_client(fd);
+}
+
+void IpcServer::handle_hello(int fd, const IpcRequest& req) {
+    auto it = clients_.find(fd);
+    if (it == clients_.end()) return;
+    // An unknown or missing framing is declined, not an error: the client
+    // learns from the answer what it gets.
+    IpcFraming next = IpcFraming::Json;
+    auto p = req.params.find("framing");
+    if (p != req.params.end()) parse_ipc_framing(json_val_as_string(p->second), next);
+
+    IpcResponse resp;
+    resp.id = req.id;
+    resp.result["framing"] = std::string(ipc_framing_name(next));
+    send_to(fd, encode_ipc_frame(resp, it->second.framing));
+    it = clients_.find(fd);
+    if (it == clients_.end()) return;
+    if (it->second.framing != next)
+        log_debug("ipc_server: client fd=%d switches to %s framing", fd, ipc_framing_name(next));
+    it->second.framing = next;
 }
 
 void IpcServer::remove_client(int fd) {
     log_info("ipc_server: client disconnected (fd=%d)", fd);
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
     close(fd);
-    clients_.erase(fd);
+    if (clients_.erase(fd)) ipc_clients_metric().add(-1);
+}
+
+// Write what the non-blocking socket takes now. Returns the byte count,
+// or -1 on an error other than a full socket buffer.
+static ssize_t write_available(int fd, const char* data, size_t size) {
+    size_t total = 0;
+    while (total < size) {
+        ssize_t n = write(fd, data + total, size - total);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return -1;
+        }
+        total += static_cast<size_t>(n);
+    }
+    ipc_sent_metric().add(total);
+    return static_cast<ssize_t>(total);
 }
 
 void IpcServer::send_to(int fd, const std::string& msg) {
-    ssize_t total = 0;
-    while (total < static_cast<ssize_t>(msg.size())) {
-        ssize_t n = write(fd, msg.data() + total, msg.size() - total);
+    auto it = clients_.find(fd);
+    if (it == clients_.end()) return;
+    std::string& out = it->second.write_buf;
+    size_t sent = 0;
+    if (out.empty()) {  // nothing ahead of msg: write it directly
+        ssize_t n = write_available(fd, msg.data(), msg.size());
         if (n < 0) {
-            if (errno == EAGAIN || errno == EWOULDBLOCK) continue;
             remove_client(fd);
             return;
         }
-        total += n;
+        sent = static_cast<size_t>(n);
+        if (sent == msg.size()) return;
+    }
+    if (out.size() + (msg.size() - sent) > kMaxClientBacklog) {
+        log_warn("ipc_server: client fd=%d has %zu bytes unread; disconnecting",
+                 fd, out.size());
+        remove_client(fd);
+        return;
+    }
+    out.append(msg, sent, std::string::npos);
+}
+
+void IpcServer::flush_client(int fd) {
+    auto it = clients_.find(fd);
+    if (it == clients_.end()) return;
+    std::string& out = it->second.write_buf;
+    ssize_t n = write_available(fd, out.data(), out.size());
+    if (n < 0) {
+        remove_client(fd);
+        return;
     }
+    out.erase(0, static_cast<size_t>(n));
 }
 
 void IpcServer::drain_wakeup() {
@@ -320,6 +656,7 @@ void IpcServer::run_posted() {
     {
         std::lock_guard<std::mutex> lock(post_mu_);
         fns.swap(posted_);
+        queued_partials_.clear();
     }
     if (!fns.empty())
         log_debug("ipc: executing %zu posted callbacks", fns.size());
@@ -5,7 +5,9 @@
 
 #include "ipc_protocol.h"
 
+#include <chrono>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -22,6 +24,11 @@ using MethodHandler = std::function<bool(const IpcRequest& req,
 
 class IpcServer {
 public:
+    // Output a client may leave unread before it is disconnected. Client
+    // sockets are non-blocking: what the socket does not take is kept and
+    // written on POLLOUT, so a stalled client never stalls the loop.
+    static constexpr size_t kMaxClientBacklog = 4 * 1024 * 1024;
+
     explicit IpcServer(const std::string& socket_path);
     ~IpcServer();
 
@@ -34,46 +41,128 @@ public:
     // Start listening. Returns false on bind/listen failure.
     bool start();
 
-    // Run the poll() loop. Blocks until stop() is called.
+    // Run the epoll loop. Blocks until stop() is called.
     void run();
 
     // Signal the poll loop to exit (thread-safe via self-pipe).
     void stop();
 
-    // Broadcast an event to all connected clients.
+    // Broadcast an event to every client subscribed to it (all clients,
+    // unless they called subscribe()). Encoded at most once per framing.
     void broadcast(const IpcEvent& ev);
 
+    // Event filter for client `fd` (`events.subscribe`). The client gets
+    // only events named in `topics`, or named by one of them plus a
+    // '.'-separated suffix ("caption" covers "caption.degraded"); "*"
+    // is every event and an empty list none. With `job_id` > 0, an event whose data
+    // carries a different `job_id` is skipped too; an event without one
+    // still arrives. Responses are never filtered. Poll thread.
+    void subscribe(int fd, std::vector<std::string> topics, int64_t job_id);
+
     // Wake the poll loop from a worker thread (e.g., after job completion).
     // The callback will be invoked on the poll thread.
     void post(std::function<void()> fn);
 
+    // --- Superseding events (live caption partials) ---
+    //
+    // A partial stands for the text of an utterance so far, so only the
+    // newest one per `key` (e.g. "<job>:<source>") is worth sending. Each
+    // client gets at most its max partial rate per key; a partial that
+    // arrives sooner, or while the client has unsent output, waits,
+    // replaced by any newer one, until the client's interval is up and its
+    // output drained. A final is never coalesced, throttled or dropped.
+
+    // Thread-safe. Queue partial `ev` for the poll thread, replacing a
+    // partial for the same key still waiting in this tick.
+    void post_partial(const std::string& key, IpcEvent ev);
+
+    // Thread-safe. Queue final `ev`, in order with post() and
+    // post_partial(). Partials for `key` queued or held back for a client
+    // before it are superseded and not sent.
+    void post_final(const std::string& key, IpcEvent ev);
+
+    // Default per-client partial rate, per key (0 = unlimited). Poll thread.
+    void set_partial_rate(int max_hz);
+
+    // Per-client partial settings (`captions.configure`). max_hz < 0 keeps
+    // the server default. With `delta`, a partial carries only what changed
+    // since the last caption the client got for its key: "keep" bytes of
+    // the previous text, then "text"; finals always carry the full text.
+    // Poll thread.
+    void configure_partials(int fd, int max_hz, bool delta);
+
+    // The fd of the client whose request is being handled, or -1 outside a
+    // handler. Poll thread.
+    int current_client() const { return current_client_; }
+
     int listen_fd() const { return listen_fd_; }
 
 private:
     void accept_client();
+    void add_client(int fd);
     void handle_client_data(int fd);
+    void handle_hello(int fd, const IpcRequest& req);
     void remove_client(int fd);
     void send_to(int fd, const std::string& msg);
+    void flush_client(int fd);
     void drain_wakeup();
     void run_posted();
+    void broadcast_partial(const std::string& key, const IpcEvent& ev);
+    void broadcast_final(const std::string& key, const IpcEvent& ev);
+    void send_partial(int fd, const std::string& key, const IpcEvent& ev,
+                      std::chrono::steady_clock::time_point now);
+    void flush_held_partials();
+    int poll_timeout_ms() const;
+    std::chrono::nanoseconds partial_interval(int client_hz) const;
     bool start_unix();
     bool start_tcp();
 
     IpcAddress addr_;
+    static constexpr int kMaxEvents = 64;  // per epoll_wait()
+
     int listen_fd_ = -1;
+    int epoll_fd_ = -1;
     int wakeup_read_ = -1;   // self-pipe read end
     int wakeup_write_ = -1;  // self-pipe write end
     bool running_ = false;
 
+    // What a client was last sent for one partial key.
+    struct PartialState {
+        std::chrono::steady_clock::time_point last_sent{};
+        std::string last_text;         // delta base
+        bool held = false;             // `pending` waits for the interval
+        IpcEvent pending;
+    };
+
     struct ClientState {
-        std::string read_buf;  // accumulates data until \n
+        std::string read_buf;  // accumulates data until a complete message
+        IpcFraming framing = IpcFraming::Json;  // switched by `hello`
+        std::string write_buf;         // output the socket has not taken yet
+        bool filtered = false;         // subscribe() was called
+        std::vector<std::string> topics;
+        int64_t job_filter = 0;        // 0: any job
+        int max_partial_hz = -1;       // < 0: partial_hz_
+        bool partial_delta = false;
+        std::unordered_map<std::string, PartialState> partials;
     };
     std::unordered_map<int, ClientState> clients_;
+    // Whether `c` is subscribed to `ev`; `job_id` is ev's, 0 when it has none.
+    static bool wants(const ClientState& c, const IpcEvent& ev, int64_t job_id);
+    int current_client_ = -1;
+    int partial_hz_ = 0;
 
     std::unordered_map<std::string, MethodHandler> handlers_;
 
+    // A queued partial; post_partial() replaces `ev` while it waits.
+    struct QueuedPartial {
+        IpcEvent ev;
+        bool superseded = false;
+    };
+
     std::mutex post_mu_;
     std::vector<std::function<void()>> posted_;
+    // Partials queued since the last run_posted(), by key.
+    std::unordered_map<std::string, std::shared_ptr<QueuedPartial>> queued_partials_;
 };
 
 } // namespace recmeet
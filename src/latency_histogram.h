@@ -0,0 +1,98 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace recmeet {
+
+/// Percentiles of a LatencyHistogram, in the unit its values were recorded
+/// in. All zero while `count` is 0.
+struct LatencySummary {
+    uint64_t count = 0;
+    int64_t p50 = 0;
+    int64_t p95 = 0;
+    int64_t p99 = 0;
+    int64_t max = 0;
+};
+
+/// Fixed-bucket histogram of non-negative integers (milliseconds, samples).
+///
+/// Values below 8 get a bucket each; above, every power of two is split
+/// into 8 buckets, so a reported percentile is within 1/16 of the recorded
+/// value. Values from 2^kMaxExp up share the last bucket; `max` stays exact.
+///
+/// One thread records and any thread may summarize: record() is a few
+/// relaxed atomic increments, never allocates, locks or logs. A summary
+/// taken while values are recorded may miss the newest of them.
+class LatencyHistogram {
+public:
+    static constexpr int kMaxExp = 24;  // ~4.6 h in ms, 17 min of 16 kHz samples
+    static constexpr std::size_t kBuckets = (kMaxExp - 2) * 8;
+
+    void record(int64_t value) {
+        const uint64_t v = value > 0 ? static_cast<uint64_t>(value) : 0;
+        counts_[bucket_of(v)].fetch_add(1, std::memory_order_relaxed);
+        if (static_cast<int64_t>(v) > max_.load(std::memory_order_relaxed))
+            max_.store(static_cast<int64_t>(v), std::memory_order_relaxed);
+    }
+
+    LatencySummary summary() const {
+        std::array<uint64_t, kBuckets> counts;
+        LatencySummary s;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            counts[i] = counts_[i].load(std::memory_order_relaxed);
+            s.count += counts[i];
+        }
+        if (s.count == 0) return s;
+        s.max = max_.load(std::memory_order_relaxed);
+        s.p50 = percentile(counts, s.count, 50, s.max);
+        s.p95 = percentile(counts, s.count, 95, s.max);
+        s.p99 = percentile(counts, s.count, 99, s.max);
+        return s;
+    }
+
+    /// Not safe against a concurrent record().
+    void reset() {
+        for (auto& c : counts_) c.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    /// Bucket holding `v`. Exposed for tests.
+    static std::size_t bucket_of(uint64_t v) {
+        if (v < 8) return static_cast<std::size_t>(v);
+        int e = 63 - __builtin_clzll(v);
+        if (e >= kMaxExp) return kBuckets - 1;
+        return static_cast<std::size_t>((e - 2) * 8) + ((v >> (e - 3)) & 7);
+    }
+
+    /// Midpoint of bucket `i`, the value a percentile falling in it reports.
+    static int64_t bucket_value(std::size_t i) {
+        if (i < 8) return static_cast<int64_t>(i);
+        const int e = static_cast<int>(i / 8) + 2;
+        const uint64_t width = uint64_t{1} << (e - 3);
+        return static_cast<int64_t>((8 + i % 8) * width + width / 2);
+    }
+
+private:
+    static int64_t percentile(const std::array<uint64_t, kBuckets>& counts, uint64_t total,
+                              unsigned pct, int64_t max) {
+        const uint64_t rank = std::max<uint64_t>(1, (total * pct + 99) / 100);
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += counts[i];
+            if (seen >= rank) return std::min(bucket_value(i), max);
+        }
+        return max;
+    }
+
+    std::array<std::atomic<uint64_t>, kBuckets> counts_{};
+    std::atomic<int64_t> max_{0};
+};
+
+} // namespace recmeet
@@ -0,0 +1,165 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "level_feed.h"
+#include "util.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace recmeet {
+
+namespace {
+
+constexpr uint32_t kLevelMagic = 0x4c564c52;  // "RLVL"
+constexpr int kReadRetries = 64;
+
+// A reading travels as 32-bit words so that both sides touch the shared
+// bytes only through atomics.
+constexpr std::size_t kWords = sizeof(LevelReading) / sizeof(uint32_t);
+static_assert(sizeof(LevelReading) % sizeof(uint32_t) == 0, "LevelReading must pack into words");
+static_assert(std::is_trivially_copyable<LevelReading>::value, "LevelReading is copied as bytes");
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "the seqlock is shared between processes");
+
+// Even `seq`: the words are stable. Odd: a publish is in progress.
+struct LevelSlot {
+    std::atomic<uint32_t> seq;
+    std::atomic<uint32_t> words[kWords];
+};
+
+struct LevelSegment {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sources;
+    uint32_t bands;
+    LevelSlot slots[LEVEL_SOURCES];
+};
+
+bool map_valid(const LevelSegment* seg) {
+    return seg->magic == kLevelMagic && seg->version == LEVEL_FEED_VERSION &&
+           seg->sources == LEVEL_SOURCES && seg->bands == LEVEL_BANDS;
+}
+
+} // anonymous namespace
+
+const char* level_source_name(LevelSource source) {
+    return source == LevelSource::Mic ? "mic" : "monitor";
+}
+
+// ---------------------------------------------------------------------------
+// LevelFeed
+// ---------------------------------------------------------------------------
+
+LevelFeed::LevelFeed(std::string name) : name_(std::move(name)) {
+    int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        // Left by a crashed daemon whose pid we were given again.
+        ::shm_unlink(name_.c_str());
+        fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    }
+    if (fd < 0)
+        throw RecmeetError("shm_open(" + name_ + "): " + std::strerror(errno));
+    if (::ftruncate(fd, sizeof(LevelSegment)) < 0) {
+        const int e = errno;
+        ::close(fd);
+        ::shm_unlink(name_.c_str());
+        throw RecmeetError("ftruncate(" + name_ + "): " + std::strerror(e));
+    }
+    void* p = ::mmap(nullptr, sizeof(LevelSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int e = errno;
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        ::shm_unlink(name_.c_str());
+        throw RecmeetError("mmap(" + name_ + "): " + std::strerror(e));
+    }
+    // ftruncate zero-filled it: every slot starts stable and empty.
+    auto* seg = new (p) LevelSegment;
+    seg->sources = LEVEL_SOURCES;
+    seg->bands = LEVEL_BANDS;
+    seg->version = LEVEL_FEED_VERSION;
+    std::atomic_thread_fence(std::memory_order_release);
+    seg->magic = kLevelMagic;
+    map_ = p;
+}
+
+LevelFeed::~LevelFeed() {
+    ::munmap(map_, sizeof(LevelSegment));
+    ::shm_unlink(name_.c_str());
+}
+
+void LevelFeed::publish(LevelSource source, const LevelReading& reading) {
+    LevelSlot& slot = static_cast<LevelSegment*>(map_)->slots[static_cast<std::size_t>(source)];
+    uint32_t words[kWords];
+    std::memcpy(words, &reading, sizeof(words));
+    const uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < kWords; ++i)
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    slot.seq.store(seq + 2, std::memory_order_release);
+}
+
+std::string LevelFeed::default_name() {
+    return "/recmeet-levels-" + std::to_string(::getpid());
+}
+
+// ---------------------------------------------------------------------------
+// LevelFeedReader
+// ---------------------------------------------------------------------------
+
+LevelFeedReader::~LevelFeedReader() { close(); }
+
+bool LevelFeedReader::open(const std::string& name) {
+    close();
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    struct stat st{};
+    void* p = MAP_FAILED;
+    if (::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= sizeof(LevelSegment))
+        p = ::mmap(nullptr, sizeof(LevelSegment), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return false;
+    const auto* seg = static_cast<const LevelSegment*>(p);
+    if (!map_valid(seg)) {
+        ::munmap(p, sizeof(LevelSegment));
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    map_ = p;
+    return true;
+}
+
+void LevelFeedReader::close() {
+    if (!map_) return;
+    ::munmap(const_cast<void*>(map_), sizeof(LevelSegment));
+    map_ = nullptr;
+}
+
+bool LevelFeedReader::read(LevelSource source, LevelReading& out) const {
+    if (!map_) return false;
+    const LevelSlot& slot =
+        static_cast<const LevelSegment*>(map_)->slots[static_cast<std::size_t>(source)];
+    uint32_t words[kWords];
+    for (int attempt = 0; attempt < kReadRetries; ++attempt) {
+        const uint32_t before = slot.seq.load(std::memory_order_acquire);
+        if (before & 1) continue;
+        for (std::size_t i = 0; i < kWords; ++i)
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != before) continue;
+        std::memcpy(&out, words, sizeof(words));
+        return true;
+    }
+    return false;
+}
+
+} // namespace recmeet
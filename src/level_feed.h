@@ -0,0 +1,94 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Audio level feed (shared memory)
+// ---------------------------------------------------------------------------
+//
+// The daemon publishes each capture source's level meter (level_meter.h)
+// into a POSIX shared-memory segment whose name `levels.info` hands out. A
+// reader on the same host maps it once and then polls it at display rate
+// with plain loads: no syscalls, no IPC traffic. Every source slot is a
+// seqlock with a single writer (its capture's consumer thread).
+
+/// Capture sources, in slot order.
+enum class LevelSource { Mic = 0, Monitor = 1 };
+inline constexpr std::size_t LEVEL_SOURCES = 2;
+
+/// Spectrum bands per source, log-spaced from 62.5 Hz to 8 kHz.
+inline constexpr std::size_t LEVEL_BANDS = 16;
+
+/// Bumped on any layout change; a reader refuses other versions.
+inline constexpr uint32_t LEVEL_FEED_VERSION = 1;
+
+/// "mic" / "monitor".
+const char* level_source_name(LevelSource source);
+
+/// One source's latest meter reading. Levels are linear, 1.0 = full scale.
+struct LevelReading {
+    uint64_t frames = 0;      ///< samples metered so far; unchanged = no new audio
+    int64_t updated_ms = 0;   ///< CLOCK_MONOTONIC ms of the update, 0 = never
+    float rms = 0;
+    float peak = 0;
+    float bands[LEVEL_BANDS] = {};  ///< loudest bin per band, as a sine amplitude
+};
+
+/// Writer side: creates the segment (mode 0600) and unlinks it on
+/// destruction. Throws RecmeetError when it cannot be created.
+class LevelFeed {
+public:
+    /// `name` is a shm_open() name ("/recmeet-levels-<pid>"); a stale
+    /// segment of that name is replaced.
+    explicit LevelFeed(std::string name);
+    ~LevelFeed();
+
+    LevelFeed(const LevelFeed&) = delete;
+    LevelFeed& operator=(const LevelFeed&) = delete;
+
+    const std::string& name() const { return name_; }
+
+    /// Replace `source`'s reading. Lock-free and allocation-free; one
+    /// thread per source.
+    void publish(LevelSource source, const LevelReading& reading);
+
+    /// The default name for this process.
+    static std::string default_name();
+
+private:
+    std::string name_;
+    void* map_ = nullptr;
+};
+
+/// Reader side. Maps the segment read-only; read() never enters the kernel.
+class LevelFeedReader {
+public:
+    LevelFeedReader() = default;
+    ~LevelFeedReader();
+
+    LevelFeedReader(const LevelFeedReader&) = delete;
+    LevelFeedReader& operator=(const LevelFeedReader&) = delete;
+
+    /// Map segment `name`. False, with nothing mapped, when it is missing
+    /// or of another layout.
+    bool open(const std::string& name);
+    void close();
+    bool is_open() const { return map_ != nullptr; }
+
+    /// Copy `source`'s reading. False when the writer kept it busy for
+    /// every retry (the caller keeps its previous reading) or nothing is
+    /// mapped.
+    bool read(LevelSource source, LevelReading& out) const;
+
+private:
+    const void* map_ = nullptr;
+};
+
+} // namespace recmeet
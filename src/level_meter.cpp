@@ -0,0 +1,117 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "level_meter.h"
+#include "sample_kernels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace recmeet {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr std::size_t kFftBits = 8;
+static_assert(std::size_t{1} << kFftBits == LEVEL_FFT_SIZE, "kFftBits must match the FFT size");
+
+int64_t monotonic_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // anonymous namespace
+
+LevelMeter::LevelMeter(LevelFeed* feed, LevelSource source) : feed_(feed), source_(source) {
+    double window_sum = 0;
+    for (std::size_t i = 0; i < LEVEL_FFT_SIZE; ++i) {
+        window_[i] = static_cast<float>(0.5 - 0.5 * std::cos(2 * kPi * i / LEVEL_FFT_SIZE));
+        window_sum += window_[i];
+        std::size_t r = 0;
+        for (std::size_t b = 0; b < kFftBits; ++b)
+            if (i & (std::size_t{1} << b)) r |= std::size_t{1} << (kFftBits - 1 - b);
+        bitrev_[i] = static_cast<uint16_t>(r);
+    }
+    for (std::size_t k = 0; k < twiddle_.size(); ++k)
+        twiddle_[k] = std::polar(1.0f, static_cast<float>(-2 * kPi * k / LEVEL_FFT_SIZE));
+    // A bin-centred sine of amplitude A has |X| = A * sum(w) / 2.
+    magnitude_scale_ = static_cast<float>(2.0 / window_sum);
+
+    // Bin 1 (62.5 Hz) up to the Nyquist bin, spaced by 2^(7/16) and at
+    // least one bin wide.
+    const std::size_t nyquist = LEVEL_FFT_SIZE / 2;
+    band_edges_[0] = 1;
+    for (std::size_t b = 1; b <= LEVEL_BANDS; ++b) {
+        const double edge = std::pow(static_cast<double>(nyquist),
+                                     static_cast<double>(b) / LEVEL_BANDS);
+        band_edges_[b] = static_cast<uint16_t>(
+            std::max<std::size_t>(band_edges_[b - 1] + 1, static_cast<std::size_t>(edge)));
+    }
+    band_edges_[LEVEL_BANDS] = static_cast<uint16_t>(nyquist + 1);
+}
+
+LevelMeter::~LevelMeter() {
+    if (!feed_) return;
+    LevelReading quiet;
+    quiet.frames = last_.frames;
+    quiet.updated_ms = monotonic_ms();
+    feed_->publish(source_, quiet);
+}
+
+void LevelMeter::on_audio(const int16_t* samples, std::size_t n, void* meter) {
+    static_cast<LevelMeter*>(meter)->process(samples, n);
+}
+
+void LevelMeter::process(const int16_t* samples, std::size_t n) {
+    if (!feed_ || n == 0) return;
+    uint64_t sum_sq = 0;
+    uint32_t peak = 0;
+    sample_kernels().energy_s16(samples, n, &sum_sq, &peak);
+    last_.frames += n;
+    last_.updated_ms = monotonic_ms();
+    last_.rms = static_cast<float>(std::sqrt(static_cast<double>(sum_sq) / n) / 32768.0);
+    last_.peak = static_cast<float>(peak) / 32768.0f;
+
+    const std::size_t keep = std::min(n, LEVEL_FFT_SIZE);
+    for (std::size_t i = n - keep; i < n; ++i) {
+        history_[history_pos_] = samples[i];
+        history_pos_ = (history_pos_ + 1) % LEVEL_FFT_SIZE;
+    }
+    history_len_ = std::min(history_len_ + keep, LEVEL_FFT_SIZE);
+    spectrum(last_.bands);
+
+    feed_->publish(source_, last_);
+}
+
+void LevelMeter::spectrum(float* bands) {
+    // Windowed history in bit-reversed order; a short history is
+    // zero-padded at the front.
+    const std::size_t pad = LEVEL_FFT_SIZE - history_len_;
+    for (std::size_t i = 0; i < LEVEL_FFT_SIZE; ++i) {
+        float v = 0;
+        if (i >= pad) {
+            const std::size_t at = (history_pos_ + i) % LEVEL_FFT_SIZE;
+            v = window_[i] * (static_cast<float>(history_[at]) / 32768.0f);
+        }
+        fft_[bitrev_[i]] = {v, 0.0f};
+    }
+    for (std::size_t len = 2; len <= LEVEL_FFT_SIZE; len <<= 1) {
+        const std::size_t half = len / 2, step = LEVEL_FFT_SIZE / len;
+        for (std::size_t start = 0; start < LEVEL_FFT_SIZE; start += len) {
+            for (std::size_t k = 0; k < half; ++k) {
+                const std::complex<float> t = twiddle_[k * step] * fft_[start + k + half];
+                fft_[start + k + half] = fft_[start + k] - t;
+                fft_[start + k] += t;
+            }
+        }
+    }
+    for (std::size_t b = 0; b < LEVEL_BANDS; ++b) {
+        float power = 0;
+        for (std::size_t k = band_edges_[b]; k < band_edges_[b + 1]; ++k)
+            power = std::max(power, std::norm(fft_[k]));
+        bands[b] = std::sqrt(power) * magnitude_scale_;
+    }
+}
+
+} // namespace recmeet
@@ -0,0 +1,68 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "level_feed.h"
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+namespace recmeet {
+
+/// Samples in each spectrum frame: 16 ms at 16 kHz, 62.5 Hz per bin.
+inline constexpr std::size_t LEVEL_FFT_SIZE = 256;
+
+/// Level meter for one capture source, publishing into a LevelFeed.
+///
+/// Every chunk updates the RMS and peak of that chunk (energy_s16 from
+/// sample_kernels()) and a spectrum of its last LEVEL_FFT_SIZE samples
+/// (Hann window, radix-2 FFT, the loudest bin of each of LEVEL_BANDS
+/// log-spaced bands). A full-scale sine reads 0.707 RMS, 1.0 peak and
+/// about 1.0 in its band. Nothing allocates after construction.
+///
+/// Wire on_audio() with a capture's set_tap(): the capture's consumer
+/// thread runs it, about every 20 ms. The meter must outlive the capture's
+/// stop(); destruction publishes silence, so a reader sees the source go
+/// quiet when the recording ends.
+class LevelMeter {
+public:
+    LevelMeter(LevelFeed* feed, LevelSource source);
+    ~LevelMeter();
+
+    LevelMeter(const LevelMeter&) = delete;
+    LevelMeter& operator=(const LevelMeter&) = delete;
+
+    /// Meter `n` samples and publish. A nullptr feed meters nothing.
+    void process(const int16_t* samples, std::size_t n);
+
+    /// AudioChunkCallback-compatible trampoline to process().
+    static void on_audio(const int16_t* samples, std::size_t n, void* meter);
+
+    /// The last reading published. Test seam.
+    const LevelReading& last() const { return last_; }
+
+private:
+    void spectrum(float* bands);
+
+    LevelFeed* feed_;
+    LevelSource source_;
+    LevelReading last_;
+
+    // The newest LEVEL_FFT_SIZE samples, oldest first once `history_len_`
+    // is full.
+    std::array<int16_t, LEVEL_FFT_SIZE> history_{};
+    std::size_t history_pos_ = 0;
+    std::size_t history_len_ = 0;
+
+    std::array<float, LEVEL_FFT_SIZE> window_{};
+    std::array<std::complex<float>, LEVEL_FFT_SIZE / 2> twiddle_{};
+    std::array<uint16_t, LEVEL_FFT_SIZE> bitrev_{};
+    std::array<uint16_t, LEVEL_BANDS + 1> band_edges_{};  // bin ranges [e[b], e[b+1])
+    std::array<std::complex<float>, LEVEL_FFT_SIZE> fft_{};
+    float magnitude_scale_ = 0;
+};
+
+} // namespace recmeet
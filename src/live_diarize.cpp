@@ -0,0 +1,239 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "live_diarize.h"
+
+#if RECMEET_USE_SHERPA
+
+#include "ipc_protocol.h"
+#include "log.h"
+#include "model_manager.h"
+#include "speaker_id.h"
+#include "stage_cache.h"
+
+#include <sched.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <fstream>
+#include <memory>
+
+namespace recmeet {
+
+namespace {
+
+constexpr int64_t kLiveDiarizeVersion = 1;
+constexpr const char* LIVE_DIARIZE_PREFIX = "live_diarize_";
+
+// Flat-object parse via the IPC parser, as config_from_json() does.
+bool parse_flat_json(const std::string& line, JsonMap& out) {
+    IpcMessage msg;
+    if (!parse_ipc_message("{\"id\":0,\"result\":" + line + "}", msg) ||
+        msg.type != IpcMessageType::Response)
+        return false;
+    out = std::move(msg.response.result);
+    return true;
+}
+
+void append_line(const fs::path& path, const std::string& line, std::ios::openmode mode) {
+    std::ofstream out(path, mode);
+    if (!out)
+        throw RecmeetError("Failed to write file: " + path.string());
+    out << line << '\n' << std::flush;
+    if (!out)
+        throw RecmeetError("Write error: " + path.string());
+}
+
+// Below the capture threads and the caption engine, as the live
+// transcriber. Threads onnxruntime spawns inherit the policy.
+void lower_worker_priority() {
+    sched_param param{};
+    if (::sched_setscheduler(0, SCHED_IDLE, &param) == 0) return;
+    errno = 0;
+    if (::nice(19) == -1 && errno != 0)
+        log_debug("live_diarize: scheduler tweak unavailable; using default");
+    else
+        log_debug("live_diarize: SCHED_IDLE unavailable; using nice(+19)");
+}
+
+} // anonymous namespace
+
+fs::path live_diarization_path(const fs::path& audio_path) {
+    std::string stem = audio_path.stem().string();
+    const std::string prefix = AUDIO_PREFIX;
+    if (stem.compare(0, prefix.size(), prefix) == 0)
+        stem.erase(0, prefix.size());
+    return audio_path.parent_path() / (std::string(LIVE_DIARIZE_PREFIX) + stem + ".ndjson");
+}
+
+void begin_live_diarization(const fs::path& path, const LiveDiarizeKey& key) {
+    JsonMap m;
+    m["version"]           = kLiveDiarizeVersion;
+    m["chunk_minutes"]     = static_cast<double>(key.chunk_minutes);
+    m["overlap_sec"]       = static_cast<double>(key.overlap_sec);
+    m["cluster_threshold"] = static_cast<double>(key.cluster_threshold);
+    m["share_overlap"]     = key.share_overlap;
+    append_line(path, serialize_json_map(m), std::ios::out | std::ios::trunc);
+}
+
+void append_live_chunk(const fs::path& path, const DiarizedChunk& chunk) {
+    JsonMap m;
+    put_diarized_chunk(m, "", chunk);
+    append_line(path, serialize_json_map(m), std::ios::out | std::ios::app);
+}
+
+bool load_live_diarization(const fs::path& path, const LiveDiarizeKey& key,
+                           std::vector<DiarizedChunk>& out) {
+    std::ifstream in(path);
+    if (!in) return false;
+
+    std::string line;
+    JsonMap head;
+    if (!std::getline(in, line) || !parse_flat_json(line, head) ||
+        json_val_as_int(head["version"]) != kLiveDiarizeVersion) {
+        log_debug("live_diarize: ignoring %s (unreadable header)", path.c_str());
+        return false;
+    }
+    if (static_cast<float>(json_val_as_double(head["chunk_minutes"])) != key.chunk_minutes ||
+        static_cast<float>(json_val_as_double(head["overlap_sec"])) != key.overlap_sec ||
+        static_cast<float>(json_val_as_double(head["cluster_threshold"])) !=
+            key.cluster_threshold ||
+        json_val_as_bool(head["share_overlap"]) != key.share_overlap) {
+        log_debug("live_diarize: ignoring %s (diarized with different chunk settings)",
+                  path.c_str());
+        return false;
+    }
+
+    std::vector<DiarizedChunk> chunks;
+    while (std::getline(in, line)) {
+        JsonMap m;
+        DiarizedChunk c;
+        if (!parse_flat_json(line, m) || !get_diarized_chunk(m, "", c)) {
+            log_debug("live_diarize: %s ends in a torn line after %zu chunks",
+                      path.c_str(), chunks.size());
+            break;
+        }
+        chunks.push_back(std::move(c));
+    }
+    out = std::move(chunks);
+    return true;
+}
+
+size_t stable_chunk_count(size_t chunks) {
+    return chunks > 0 ? chunks - 1 : 0;
+}
+
+// ---------------------------------------------------------------------------
+// LiveDiarizer
+// ---------------------------------------------------------------------------
+
+LiveDiarizer::LiveDiarizer(const SampleSource& audio, const fs::path& path, Options opts)
+    : audio_(audio), path_(path), opts_(std::move(opts)) {
+    worker_ = std::thread([this] { run(); });
+}
+
+LiveDiarizer::~LiveDiarizer() {
+    stop(false);
+}
+
+void LiveDiarizer::offer(size_t samples) {
+    {
+        std::lock_guard lk(mu_);
+        if (samples <= samples_) return;
+        samples_ = samples;
+    }
+    cv_.notify_one();
+}
+
+size_t LiveDiarizer::stop(bool finish_chunk) {
+    {
+        std::lock_guard lk(mu_);
+        stopping_ = true;
+    }
+    if (!finish_chunk) abort_.store(true, std::memory_order_relaxed);
+    cv_.notify_one();
+    if (worker_.joinable()) worker_.join();
+    return chunks_done();
+}
+
+void LiveDiarizer::run() {
+    lower_worker_priority();
+
+    DiarizeChunkConfig chunk_cfg;
+    chunk_cfg.chunk_minutes = opts_.key.chunk_minutes;
+    chunk_cfg.overlap_seconds = opts_.key.overlap_sec;
+    chunk_cfg.share_overlap = opts_.key.share_overlap;
+
+    std::unique_ptr<DiarizeSession> diar;
+    std::unique_ptr<SpeakerEmbeddingSession> emb;
+    try {
+        // Private sessions: the model cache's resident pair belongs to the
+        // postprocessing that may still be running for the last meeting.
+        diar = std::make_unique<DiarizeSession>(opts_.threads);
+        emb = std::make_unique<SpeakerEmbeddingSession>(ensure_sherpa_models().embedding,
+                                                        opts_.threads);
+        plan_chunk_extents(1, chunk_cfg);  // rejects an invalid layout up front
+        begin_live_diarization(path_, opts_.key);
+    } catch (const std::exception& e) {
+        log_warn("Live diarization unavailable (%s); diarizing after recording", e.what());
+        return;
+    }
+    log_debug("live_diarize: worker ready (%.1f min chunks, %d threads)",
+              opts_.key.chunk_minutes, opts_.threads);
+
+    auto on_speaker = [this] {
+        if (abort_.load(std::memory_order_relaxed)) throw RecmeetError("Cancelled");
+    };
+
+    size_t next = 0;
+    std::vector<float> scratch;
+    // share_overlap: chunk `next` leaves its trailing windows here for the
+    // chunk after it.
+    OverlapEmbeddings shared;
+    for (;;) {
+        ChunkExtents ext;
+        ChunkOverlap overlap;
+        {
+            std::unique_lock lk(mu_);
+            cv_.wait(lk, [&] {
+                if (stopping_) return true;
+                if (samples_ == 0) return false;
+                auto extents = plan_chunk_extents(samples_, chunk_cfg);
+                if (stable_chunk_count(extents.size()) <= next) return false;
+                ext = extents[next];
+                if (chunk_cfg.share_overlap) overlap = plan_chunk_overlap(extents, next);
+                return true;
+            });
+            if (stopping_) break;
+        }
+
+        const uint64_t available = static_cast<uint64_t>(read_mem_available_kb()) * 1024;
+        if (available > 0 && available < opts_.chunk_peak_bytes) {
+            log_warn("Live diarization stopped: %llu MB available, a chunk needs %llu MB; "
+                     "the rest is diarized after recording",
+                     (unsigned long long)(available >> 20),
+                     (unsigned long long)(opts_.chunk_peak_bytes >> 20));
+            break;
+        }
+
+        try {
+            auto chunk = diarize_chunk(*diar, *emb, audio_, ext, opts_.key.cluster_threshold,
+                                       scratch, on_speaker,
+                                       chunk_cfg.share_overlap ? &shared : nullptr, &overlap);
+            append_live_chunk(path_, chunk);
+            shared.forget_before(overlap.private_end);
+        } catch (const std::exception& e) {
+            if (!abort_.load(std::memory_order_relaxed))
+                log_warn("Live diarization stopped (%s); the rest is diarized after "
+                         "recording", e.what());
+            break;
+        }
+        ++next;
+        done_.store(next, std::memory_order_release);
+    }
+    log_debug("live_diarize: worker exiting (%zu chunks written)", next);
+}
+
+} // namespace recmeet
+
+#endif
@@ -0,0 +1,122 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "diarize.h"
+#include "sample_source.h"
+#include "util.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace recmeet {
+
+#if RECMEET_USE_SHERPA
+
+// ---------------------------------------------------------------------------
+// Live diarization file (`live_diarize_<ts>.ndjson`)
+// ---------------------------------------------------------------------------
+//
+// Written while recording by LiveDiarizer, read by run_postprocessing(),
+// which hands the chunks to diarize_chunked() so only the chunks after
+// them (usually just the last) and stitching remain after stop. Same
+// layout as the live transcript: a settings header, then one line per
+// diarized chunk appended with a single write; a torn last line is
+// dropped.
+
+/// Settings the chunks were diarized with. Postprocessing reuses them only
+/// when all match its own.
+struct LiveDiarizeKey {
+    float chunk_minutes = 15.0f;
+    float overlap_sec = 30.0f;
+    float cluster_threshold = 1.18f;
+    bool share_overlap = false;  ///< DiarizeChunkConfig::share_overlap
+};
+
+/// `<dir>/audio_<ts>.<ext>` -> `<dir>/live_diarize_<ts>.ndjson`.
+fs::path live_diarization_path(const fs::path& audio_path);
+
+/// Create (or truncate) `path` with a header for `key`. Throws RecmeetError.
+void begin_live_diarization(const fs::path& path, const LiveDiarizeKey& key);
+
+/// Append one diarized chunk. Segment times and centroids round-trip
+/// exactly. Throws RecmeetError.
+void append_live_chunk(const fs::path& path, const DiarizedChunk& chunk);
+
+/// Read the chunks of `path` into `out`, in order. Returns false when the
+/// file is missing, unreadable or was written with a different `key`. A
+/// malformed line ends the list; the chunks before it are kept.
+bool load_live_diarization(const fs::path& path, const LiveDiarizeKey& key,
+                           std::vector<DiarizedChunk>& out);
+
+/// Chunks of plan_chunk_extents() over the audio recorded so far that more
+/// audio can no longer change: all but the last.
+size_t stable_chunk_count(size_t chunks);
+
+// ---------------------------------------------------------------------------
+// LiveDiarizer
+// ---------------------------------------------------------------------------
+
+/// Background diarization worker for the recording loop (`--live-diarize`).
+///
+/// The loop reports how many samples the spool holds every tick; a worker
+/// thread at SCHED_IDLE diarizes each chunk that is final (see
+/// stable_chunk_count()) on its own session pair and appends it to the live
+/// diarization file. It gives up when MemAvailable falls below a chunk's
+/// estimated peak. A chunk's sherpa pass cannot be interrupted, so stop()
+/// lets the chunk in progress finish (it is final, and postprocessing
+/// reuses it); the destructor abandons it at the next speaker instead.
+///
+/// Best-effort: if the models cannot be loaded or a chunk fails, the worker
+/// logs a warning and exits; postprocessing diarizes the rest. `audio` (the
+/// growing spool) must outlive this object.
+class LiveDiarizer {
+public:
+    struct Options {
+        LiveDiarizeKey key;
+        int threads = 1;
+        uint64_t chunk_peak_bytes = 0;  ///< estimate_diarize_peak_bytes() of one chunk
+    };
+
+    LiveDiarizer(const SampleSource& audio, const fs::path& path, Options opts);
+    ~LiveDiarizer();
+
+    LiveDiarizer(const LiveDiarizer&) = delete;
+    LiveDiarizer& operator=(const LiveDiarizer&) = delete;
+
+    /// The spool now holds `samples` samples. Only ever grows.
+    void offer(size_t samples);
+
+    /// Join the worker once the chunk in progress is written
+    /// (`finish_chunk`) or abandoned at its next speaker. Idempotent.
+    /// Returns the number of chunks written.
+    size_t stop(bool finish_chunk = true);
+
+    /// Chunks diarized and written so far.
+    size_t chunks_done() const { return done_.load(std::memory_order_acquire); }
+
+private:
+    void run();
+
+    const SampleSource& audio_;
+    fs::path path_;
+    Options opts_;
+
+    std::mutex mu_;
+    std::condition_variable cv_;
+    size_t samples_ = 0;
+    bool stopping_ = false;
+
+    std::atomic<bool> abort_{false};
+    std::atomic<size_t> done_{0};
+    std::thread worker_;
+};
+
+#endif
+
+} // namespace recmeet
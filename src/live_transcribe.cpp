@@ -0,0 +1,319 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "live_transcribe.h"
+#include "ipc_protocol.h"
+#include "log.h"
+#include "model_manager.h"
+
+#include <sched.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+
+namespace recmeet {
+
+namespace {
+
+constexpr int64_t kLiveTranscriptVersion = 1;
+constexpr const char* LIVE_PREFIX = "live_";
+
+// Flat-object parse via the IPC parser, as config_from_json() does.
+bool parse_flat_json(const std::string& line, JsonMap& out) {
+    IpcMessage msg;
+    if (!parse_ipc_message("{\"id\":0,\"result\":" + line + "}", msg) ||
+        msg.type != IpcMessageType::Response)
+        return false;
+    out = std::move(msg.response.result);
+    return true;
+}
+
+// Pieces as "start+n@offset" joined by ';' — one flat string field.
+std::string encode_pieces(const PackedWindow& w) {
+    std::string out;
+    char buf[80];
+    for (const auto& p : w.pieces) {
+        std::snprintf(buf, sizeof(buf), "%s%zu+%zu@%zu",
+                      out.empty() ? "" : ";", p.start, p.n, p.offset);
+        out += buf;
+    }
+    return out;
+}
+
+bool decode_pieces(const std::string& s, PackedWindow& w) {
+    const char* p = s.c_str();
+    while (*p) {
+        char* end = nullptr;
+        PackedWindow::Piece piece{};
+        piece.start = std::strtoull(p, &end, 10);
+        if (end == p || *end != '+') return false;
+        p = end + 1;
+        piece.n = std::strtoull(p, &end, 10);
+        if (end == p || *end != '@') return false;
+        p = end + 1;
+        piece.offset = std::strtoull(p, &end, 10);
+        if (end == p || (*end != ';' && *end != '\0')) return false;
+        p = *end ? end + 1 : end;
+        w.pieces.push_back(piece);
+    }
+    return !w.pieces.empty();
+}
+
+int64_t to_ms(double seconds) { return static_cast<int64_t>(std::llround(seconds * 1000.0)); }
+
+std::string segment_key(size_t i, const char* field) {
+    return "s" + std::to_string(i) + "_" + field;
+}
+
+void append_line(const fs::path& path, const std::string& line, std::ios::openmode mode) {
+    std::ofstream out(path, mode);
+    if (!out)
+        throw RecmeetError("Failed to write file: " + path.string());
+    out << line << '\n' << std::flush;
+    if (!out)
+        throw RecmeetError("Write error: " + path.string());
+}
+
+// Below the caption engine's SCHED_BATCH worker. Threads whisper spawns
+// inherit the policy from this one.
+void lower_worker_priority() {
+    sched_param param{};
+    if (::sched_setscheduler(0, SCHED_IDLE, &param) == 0) return;
+    errno = 0;
+    if (::nice(19) == -1 && errno != 0)
+        log_debug("live_transcribe: scheduler tweak unavailable; using default");
+    else
+        log_debug("live_transcribe: SCHED_IDLE unavailable; using nice(+19)");
+}
+
+} // anonymous namespace
+
+fs::path live_transcript_path(const fs::path& audio_path) {
+    std::string stem = audio_path.stem().string();
+    const std::string prefix = AUDIO_PREFIX;
+    if (stem.compare(0, prefix.size(), prefix) == 0)
+        stem.erase(0, prefix.size());
+    return audio_path.parent_path() / (std::string(LIVE_PREFIX) + stem + ".ndjson");
+}
+
+void begin_live_transcript(const fs::path& path, const LiveTranscriptKey& key) {
+    JsonMap m;
+    m["version"]  = kLiveTranscriptVersion;
+    m["model"]    = key.model;
+    m["language"] = key.language;
+    m["prompt"]   = key.initial_prompt;
+    append_line(path, serialize_json_map(m), std::ios::out | std::ios::trunc);
+}
+
+void append_live_window(const fs::path& path, const LiveWindow& window) {
+    JsonMap m;
+    m["pieces"]   = encode_pieces(window.window);
+    m["length"]   = static_cast<int64_t>(window.window.length);
+    m["language"] = window.language;
+    m["segments"] = static_cast<int64_t>(window.segments.size());
+    for (size_t i = 0; i < window.segments.size(); ++i) {
+        const auto& seg = window.segments[i];
+        m[segment_key(i, "start_ms")] = to_ms(seg.start);
+        m[segment_key(i, "end_ms")]   = to_ms(seg.end);
+        m[segment_key(i, "text")]     = seg.text;
+    }
+    append_line(path, serialize_json_map(m), std::ios::out | std::ios::app);
+}
+
+bool load_live_transcript(const fs::path& path, const LiveTranscriptKey& key,
+                          std::vector<LiveWindow>& out) {
+    std::ifstream in(path);
+    if (!in) return false;
+
+    std::string line;
+    JsonMap head;
+    if (!std::getline(in, line) || !parse_flat_json(line, head) ||
+        json_val_as_int(head["version"]) != kLiveTranscriptVersion) {
+        log_debug("live_transcribe: ignoring %s (unreadable header)", path.c_str());
+        return false;
+    }
+    if (json_val_as_string(head["model"]) != key.model ||
+        json_val_as_string(head["language"]) != key.language ||
+        json_val_as_string(head["prompt"]) != key.initial_prompt) {
+        log_debug("live_transcribe: ignoring %s (decoded with different whisper settings)",
+                  path.c_str());
+        return false;
+    }
+
+    std::vector<LiveWindow> windows;
+    while (std::getline(in, line)) {
+        JsonMap m;
+        LiveWindow w;
+        if (!parse_flat_json(line, m) ||
+            !decode_pieces(json_val_as_string(m["pieces"]), w.window)) {
+            log_debug("live_transcribe: %s ends in a torn line after %zu windows",
+                      path.c_str(), windows.size());
+            break;
+        }
+        w.window.length = static_cast<size_t>(json_val_as_int(m["length"]));
+        w.language = json_val_as_string(m["language"]);
+        const int64_t n = json_val_as_int(m["segments"], -1);
+        bool complete = n >= 0;
+        for (int64_t i = 0; complete && i < n; ++i) {
+            auto text = m.find(segment_key(i, "text"));
+            if (text == m.end()) {
+                complete = false;
+                break;
+            }
+            w.segments.push_back({json_val_as_int(m[segment_key(i, "start_ms")]) / 1000.0,
+                                  json_val_as_int(m[segment_key(i, "end_ms")]) / 1000.0,
+                                  json_val_as_string(text->second)});
+        }
+        if (!complete) break;
+        windows.push_back(std::move(w));
+    }
+    out = std::move(windows);
+    return true;
+}
+
+size_t count_live_prefix(const std::vector<LiveWindow>& live,
+                         const std::vector<PackedWindow>& windows) {
+    size_t n = 0;
+    for (; n < live.size() && n < windows.size(); ++n) {
+        const auto& a = live[n].window.pieces;
+        const auto& b = windows[n].pieces;
+        if (a.size() != b.size()) break;
+        bool same = true;
+        for (size_t i = 0; i < a.size() && same; ++i)
+            same = a[i].start == b[i].start && a[i].n == b[i].n && a[i].offset == b[i].offset;
+        if (!same) break;
+    }
+    return n;
+}
+
+TranscriptResult merge_live_prefix(const std::vector<LiveWindow>& live, size_t n,
+                                   TranscriptResult rest) {
+    TranscriptResult merged{};
+    merged.language = rest.language;
+    merged.language_prob = rest.language_prob;
+    merged.repetition_aborts = rest.repetition_aborts;
+    for (size_t i = 0; i < n && i < live.size(); ++i) {
+        merged.segments.insert(merged.segments.end(),
+                               live[i].segments.begin(), live[i].segments.end());
+        if (merged.language.empty()) merged.language = live[i].language;
+    }
+    merged.segments.insert(merged.segments.end(),
+                           std::make_move_iterator(rest.segments.begin()),
+                           std::make_move_iterator(rest.segments.end()));
+    return merged;
+}
+
+size_t stable_window_count(size_t windows, bool pack) {
+    if (!pack) return windows;
+    return windows > 0 ? windows - 1 : 0;
+}
+
+// ---------------------------------------------------------------------------
+// LiveTranscriber
+// ---------------------------------------------------------------------------
+
+LiveTranscriber::LiveTranscriber(const SampleSource& audio, const fs::path& path,
+                                 Options opts)
+    : audio_(audio), path_(path), opts_(std::move(opts)) {
+    worker_ = std::thread([this] { run(); });
+}
+
+LiveTranscriber::~LiveTranscriber() {
+    stop();
+}
+
+void LiveTranscriber::offer(const std::vector<TranscribeWindow>& segments) {
+    {
+        std::lock_guard lk(mu_);
+        if (segments.size() == segments_.size()) return;
+        segments_ = segments;
+    }
+    cv_.notify_one();
+}
+
+void LiveTranscriber::set_paused(bool paused) {
+    {
+        std::lock_guard lk(mu_);
+        if (paused == paused_) return;
+        paused_ = paused;
+    }
+    if (paused)
+        log_debug("live_transcribe: caption engine behind; pausing");
+    cv_.notify_one();
+}
+
+size_t LiveTranscriber::stop() {
+    {
+        std::lock_guard lk(mu_);
+        stopping_ = true;
+    }
+    abort_.request();
+    cv_.notify_one();
+    if (worker_.joinable()) worker_.join();
+    return windows_done();
+}
+
+void LiveTranscriber::run() {
+    lower_worker_priority();
+
+    std::unique_ptr<WhisperModel> model;
+    try {
+        model = std::make_unique<WhisperModel>(ensure_whisper_model(opts_.key.model),
+                                               opts_.gpu);
+        begin_live_transcript(path_, opts_.key);
+    } catch (const std::exception& e) {
+        log_warn("Live transcription unavailable (%s); transcribing after recording",
+                 e.what());
+        return;
+    }
+    log_debug("live_transcribe: worker ready (model %s, %d threads)",
+              opts_.key.model.c_str(), opts_.threads);
+
+    TranscribeOptions topts;
+    topts.language = opts_.key.language;
+    topts.initial_prompt = opts_.key.initial_prompt;
+    topts.threads = opts_.threads;
+    topts.stop = &abort_;
+
+    size_t next = 0;
+    for (;;) {
+        PackedWindow window;
+        {
+            std::unique_lock lk(mu_);
+            std::vector<PackedWindow> windows;
+            cv_.wait(lk, [&] {
+                if (stopping_) return true;
+                if (paused_) return false;
+                windows = opts_.pack ? pack_windows(segments_) : single_windows(segments_);
+                return stable_window_count(windows.size(), opts_.pack) > next;
+            });
+            if (stopping_) break;
+            window = windows[next];
+        }
+
+        LiveWindow done;
+        try {
+            auto r = transcribe_windows(*model, audio_, std::vector<PackedWindow>{window},
+                                        1, topts);
+            done.window = std::move(window);
+            done.segments = std::move(r.segments);
+            done.language = std::move(r.language);
+            append_live_window(path_, done);
+        } catch (const std::exception& e) {
+            if (!abort_.stop_requested())
+                log_warn("Live transcription stopped (%s); the rest is transcribed "
+                         "after recording", e.what());
+            break;
+        }
+        ++next;
+        done_.store(next, std::memory_order_release);
+    }
+    log_debug("live_transcribe: worker exiting (%zu windows written)", next);
+}
+
+} // namespace recmeet
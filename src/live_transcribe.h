@@ -0,0 +1,141 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "sample_source.h"
+#include "transcribe.h"
+#include "util.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Live transcript file (`live_<ts>.ndjson`)
+// ---------------------------------------------------------------------------
+//
+// Written while recording by LiveTranscriber, read by run_postprocessing().
+// The first line records the whisper settings; each further line is one
+// decoded window and its segments, appended with a single write so a crash
+// leaves at most one torn line at the end, which load_live_transcript()
+// drops.
+
+/// Whisper settings a live transcript was decoded with. Postprocessing
+/// reuses a transcript only when all of them match its own.
+struct LiveTranscriptKey {
+    std::string model;           ///< whisper model name (cfg.whisper_model)
+    std::string language;        ///< configured language, "" = auto-detect
+    std::string initial_prompt;
+};
+
+/// One decoded window and its segments (source-relative seconds).
+struct LiveWindow {
+    PackedWindow window;
+    std::vector<TranscriptSegment> segments;
+    std::string language;  ///< language whisper reported for the window
+};
+
+/// `<dir>/audio_<ts>.<ext>` -> `<dir>/live_<ts>.ndjson`.
+fs::path live_transcript_path(const fs::path& audio_path);
+
+/// Create (or truncate) `path` with a header for `key`. Throws RecmeetError.
+void begin_live_transcript(const fs::path& path, const LiveTranscriptKey& key);
+
+/// Append one decoded window. Throws RecmeetError.
+void append_live_window(const fs::path& path, const LiveWindow& window);
+
+/// Read the windows of `path` into `out`. Returns false when the file is
+/// missing, unreadable or was written with a different `key`. A malformed
+/// line ends the list; the windows before it are kept.
+bool load_live_transcript(const fs::path& path, const LiveTranscriptKey& key,
+                          std::vector<LiveWindow>& out);
+
+/// Number of leading `windows` that `live` already decoded: the same
+/// pieces, in the same order.
+size_t count_live_prefix(const std::vector<LiveWindow>& live,
+                         const std::vector<PackedWindow>& windows);
+
+/// Segments of the first `n` live windows followed by `rest`, the result of
+/// decoding the remaining windows. Keeps `rest`'s language unless it is
+/// empty (nothing left to decode).
+TranscriptResult merge_live_prefix(const std::vector<LiveWindow>& live, size_t n,
+                                   TranscriptResult rest);
+
+/// Windows of `windows`, built from the speech segments closed so far,
+/// that later segments can no longer change. Packing is greedy, so only
+/// the last packed window may still grow; unpacked windows are final.
+size_t stable_window_count(size_t windows, bool pack);
+
+// ---------------------------------------------------------------------------
+// LiveTranscriber
+// ---------------------------------------------------------------------------
+
+/// Background whisper worker for the recording loop (`--live-transcribe`).
+///
+/// The loop hands it the speech segments closed so far (from StreamingVad)
+/// every tick; a worker thread loads the whisper model, decodes each window
+/// that can no longer change and appends it to the live transcript. The
+/// thread runs under SCHED_IDLE (nice 19 when that is refused), below the
+/// caption engine's SCHED_BATCH worker and the capture threads, and
+/// set_paused() holds it between windows while the caption engine has a
+/// backlog. stop() aborts the window in progress, which postprocessing then
+/// decodes along with the rest.
+///
+/// Best-effort: if the model cannot be loaded or a decode fails, the worker
+/// logs a warning and exits; the recording is unaffected. `audio` (the
+/// growing spool) must outlive this object.
+class LiveTranscriber {
+public:
+    struct Options {
+        LiveTranscriptKey key;
+        bool pack = true;  ///< cfg.vad_pack — must match postprocessing
+        int threads = 1;
+        bool gpu = true;   ///< cfg.whisper_gpu
+    };
+
+    LiveTranscriber(const SampleSource& audio, const fs::path& path, Options opts);
+    ~LiveTranscriber();
+
+    LiveTranscriber(const LiveTranscriber&) = delete;
+    LiveTranscriber& operator=(const LiveTranscriber&) = delete;
+
+    /// Replace the list of closed speech segments. Segments only ever get
+    /// appended, so each call extends the previous list.
+    void offer(const std::vector<TranscribeWindow>& segments);
+
+    /// Hold (true) or resume (false) decoding between windows.
+    void set_paused(bool paused);
+
+    /// Abort the window in progress and join the worker. Idempotent.
+    /// Returns the number of windows written.
+    size_t stop();
+
+    /// Windows decoded and written so far.
+    size_t windows_done() const { return done_.load(std::memory_order_acquire); }
+
+private:
+    void run();
+
+    const SampleSource& audio_;
+    fs::path path_;
+    Options opts_;
+
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::vector<TranscribeWindow> segments_;
+    bool paused_ = false;
+    bool stopping_ = false;
+
+    StopToken abort_;
+    std::atomic<size_t> done_{0};
+    std::thread worker_;
+};
+
+} // namespace recmeet
@@ -4,25 +4,195 @@
 #include "log.h"
 #include "util.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <csignal>
 #include <cstdarg>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <ctime>
 #include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
 #include <sys/syscall.h>
 #include <unistd.h>
 
 namespace recmeet {
 
+// ---------------------------------------------------------------------------
+// Asynchronous logging
+// ---------------------------------------------------------------------------
+//
+// A log call never takes a lock or makes a system call. The caller formats
+// its message on its own stack, stamps it with the clock and its thread ID
+// and copies it into a ring of its own (one single-producer ring per
+// thread, claimed on the thread's first log call). If the ring is full the
+// record is dropped and counted; the caller never waits for the disk.
+//
+// One writer thread empties every ring every WRITER_PERIOD, orders the
+// batch by time, formats the headers and hands the batch to one write(2)
+// per destination. It also owns the hourly file rotation and the purge.
+// log_shutdown() drains the rings before it returns, so a log line is on
+// disk once the logger is shut down.
+//
+// A fatal signal (SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT) writes the
+// records still in the rings -- the last ones logged before the crash --
+// straight to the log file with write(2) before the default action runs.
+
 namespace {
 
-LogLevel g_level = LogLevel::NONE;
-FILE* g_file = nullptr;
-std::mutex g_mutex;
+constexpr size_t RING_BYTES = 32 * 1024;  // per thread; power of two
+constexpr size_t MAX_RINGS = 128;
+constexpr size_t BODY_MAX = 2048;
+constexpr auto WRITER_PERIOD = std::chrono::milliseconds(50);
+
+/// Fixed part of a record in a ring; `len` body bytes follow.
+struct RecordHeader {
+    int64_t ns;      // system_clock since epoch
+    int32_t tid;
+    uint16_t len;
+    uint8_t level;
+    uint8_t pad;
+};
+
+enum RingState : int { RING_OWNED = 0, RING_ABANDONED = 1 };
+
+/// Single-producer, single-consumer byte ring. The owning thread advances
+/// `head`, the writer thread advances `tail`; both only ever grow.
+struct Ring {
+    alignas(64) std::atomic<uint64_t> head{0};
+    alignas(64) std::atomic<uint64_t> tail{0};
+    alignas(64) std::atomic<int> state{RING_OWNED};
+    std::atomic<uint64_t> dropped{0};
+    char buf[RING_BYTES];
+
+    void copy_in(uint64_t pos, const void* src, size_t n) {
+        size_t off = pos & (RING_BYTES - 1);
+        size_t first = std::min(n, RING_BYTES - off);
+        memcpy(buf + off, src, first);
+        memcpy(buf, static_cast<const char*>(src) + first, n - first);
+    }
+
+    void copy_out(uint64_t pos, void* dst, size_t n) const {
+        size_t off = pos & (RING_BYTES - 1);
+        size_t first = std::min(n, RING_BYTES - off);
+        memcpy(dst, buf + off, first);
+        memcpy(static_cast<char*>(dst) + first, buf, n - first);
+    }
+};
+
+// Rings are never freed: a thread that exits marks its ring abandoned and
+// a new thread takes it over once the writer has drained it, so a process
+// allocates about as many rings as it ever had logging threads at once.
+std::atomic<Ring*> g_rings[MAX_RINGS];
+std::atomic<size_t> g_ring_count{0};
+std::atomic<uint64_t> g_unringed_dropped{0};  // threads beyond MAX_RINGS
+
+std::atomic<LogLevel> g_level{LogLevel::NONE};
+
+// Writer state. g_fd and g_stderr are written only while the writer thread
+// is stopped; g_crash_fd mirrors g_fd for the signal handler.
+int g_fd = -1;
 bool g_stderr = false;
 fs::path g_log_dir;
 int g_retention_hours = 4;
 int g_current_hour = -1;
+std::atomic<int> g_crash_fd{-1};
+std::atomic<bool> g_crash_stderr{false};
+std::atomic<long> g_utc_offset{0};  // seconds east of UTC, for the handler
+
+std::mutex g_writer_mu;
+std::condition_variable g_writer_cv;
+bool g_writer_stop = false;
+std::thread g_writer;
+
+const char* level_tag(uint8_t level) {
+    switch (static_cast<LogLevel>(level)) {
+        case LogLevel::ERROR: return "ERROR";
+        case LogLevel::WARN:  return "WARN";
+        case LogLevel::INFO:  return "INFO";
+        case LogLevel::DEBUG: return "DEBUG";
+        default:              return "NONE";
+    }
+}
+
+int current_tid() {
+    // Thread ID via syscall for broad glibc compatibility, once per thread
+    thread_local int tid = static_cast<int>(syscall(SYS_gettid));
+    return tid;
+}
+
+/// The calling thread's ring, claimed on first use.
+struct RingLease {
+    Ring* ring = nullptr;
+
+    RingLease() {
+        size_t n = g_ring_count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < n && i < MAX_RINGS; ++i) {
+            // Only a drained ring: one still holding its last owner's
+            // records would leave the new owner less than a full ring.
+            Ring* r = g_rings[i].load(std::memory_order_acquire);
+            if (!r || r->state.load(std::memory_order_acquire) != RING_ABANDONED ||
+                r->tail.load(std::memory_order_acquire) != r->head.load(std::memory_order_relaxed))
+                continue;
+            int expected = RING_ABANDONED;
+            if (r->state.compare_exchange_strong(expected, RING_OWNED,
+                                                 std::memory_order_acq_rel)) {
+                ring = r;
+                return;
+            }
+        }
+        size_t idx = g_ring_count.fetch_add(1, std::memory_order_acq_rel);
+        if (idx >= MAX_RINGS) return;
+        ring = new (std::nothrow) Ring;
+        g_rings[idx].store(ring, std::memory_order_release);
+    }
+
+    ~RingLease() {
+        if (ring) ring->state.store(RING_ABANDONED, std::memory_order_release);
+    }
+};
+
+Ring* thread_ring() {
+    thread_local RingLease lease;
+    return lease.ring;
+}
+
+void enqueue(LogLevel level, const char* fmt, va_list args) {
+    RecordHeader h{};
+    h.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    h.tid = current_tid();
+    h.level = static_cast<uint8_t>(level);
+
+    char body[BODY_MAX];
+    int blen = vsnprintf(body, sizeof(body), fmt, args);
+    if (blen < 0) blen = 0;
+    h.len = static_cast<uint16_t>(std::min<size_t>(blen, sizeof(body) - 1));
+
+    Ring* r = thread_ring();
+    if (!r) {
+        g_unringed_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const size_t need = sizeof(h) + h.len;
+    uint64_t head = r->head.load(std::memory_order_relaxed);
+    uint64_t tail = r->tail.load(std::memory_order_acquire);
+    if (RING_BYTES - (head - tail) < need) {
+        r->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    r->copy_in(head, &h, sizeof(h));
+    r->copy_in(head + sizeof(h), body, h.len);
+    r->head.store(head + need, std::memory_order_release);
+}
 
 /// Parse YYYY-MM-DD-HH from a log filename and return the timepoint.
 /// Returns epoch (time_t 0) on parse failure.
@@ -58,62 +228,236 @@ void purge_old_logs() {
 
 /// Open the hourly log file for the given time. Closes any existing file.
 void open_hourly_file(const std::tm& tm) {
-    if (g_file) {
-        fclose(g_file);
-        g_file = nullptr;
+    if (g_fd >= 0) {
+        g_crash_fd.store(-1, std::memory_order_relaxed);
+        ::close(g_fd);
+        g_fd = -1;
     }
     char buf[32];
     snprintf(buf, sizeof(buf), "recmeet-%04d-%02d-%02d-%02d.log",
              tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour);
     fs::path log_path = g_log_dir / buf;
-    g_file = fopen(log_path.c_str(), "a");
+    g_fd = ::open(log_path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
     g_current_hour = tm.tm_hour;
+    g_utc_offset.store(tm.tm_gmtoff, std::memory_order_relaxed);
+    g_crash_fd.store(g_fd, std::memory_order_relaxed);
 }
 
-void write_log(const char* level_str, const char* fmt, va_list args) {
-    std::lock_guard<std::mutex> lock(g_mutex);
-    if (!g_file && !g_stderr) return;
+void write_all(int fd, const char* data, size_t n) {
+    while (n > 0) {
+        ssize_t w = ::write(fd, data, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += w;
+        n -= static_cast<size_t>(w);
+    }
+}
 
-    // Timestamp with milliseconds
-    auto now = std::chrono::system_clock::now();
-    auto time_t_now = std::chrono::system_clock::to_time_t(now);
-    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) .count() % 1000;
+struct Pending {
+    RecordHeader h;
+    std::string body;
+};
+
+/// Writer-thread state for one batch.
+struct Batch {
+    std::vector<Pending> records;
+    std::string out;
+    time_t last_sec = -1;
     std::tm tm{};
-    localtime_r(&time_t_now, &tm);
 
-    // Hourly rotation
-    if (g_file && tm.tm_hour != g_current_hour) {
-        open_hourly_file(tm);
-        purge_old_logs();
+    void flush() {
+        if (out.empty()) return;
+        if (g_fd >= 0) write_all(g_fd, out.data(), out.size());
+        if (g_stderr) write_all(STDERR_FILENO, out.data(), out.size());
+        out.clear();
     }
 
-    // Thread ID via syscall for broad glibc compatibility
-    pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+    void format(const RecordHeader& h, const char* body, size_t len) {
+        time_t sec = static_cast<time_t>(h.ns / 1000000000);
+        if (sec != last_sec) {
+            localtime_r(&sec, &tm);
+            last_sec = sec;
+        }
+        // Hourly rotation, at the first record of the new hour
+        if (g_fd >= 0 && tm.tm_hour != g_current_hour) {
+            flush();
+            open_hourly_file(tm);
+            purge_old_logs();
+        }
+        char header[128];
+        int hlen = snprintf(header, sizeof(header),
+            "%04d-%02d-%02d %02d:%02d:%02d.%03d [%s] [tid=%d] ",
+            tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+            tm.tm_hour, tm.tm_min, tm.tm_sec, static_cast<int>(h.ns / 1000000 % 1000),
+            level_tag(h.level), h.tid);
+        out.append(header, hlen);
+        out.append(body, len);
+        out.push_back('\n');
+    }
+};
 
-    // Format the complete line into a stack buffer
-    char header[128];
-    int hlen = snprintf(header, sizeof(header),
-        "%04d-%02d-%02d %02d:%02d:%02d.%03d [%s] [tid=%d] ",
-        tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
-        tm.tm_hour, tm.tm_min, tm.tm_sec, (int)millis,
-        level_str, (int)tid);
+/// Move every record out of every ring and write them in time order.
+void drain(Batch& b) {
+    b.records.clear();
+    uint64_t dropped = g_unringed_dropped.exchange(0, std::memory_order_relaxed);
+    size_t n = std::min(g_ring_count.load(std::memory_order_acquire), MAX_RINGS);
+    for (size_t i = 0; i < n; ++i) {
+        Ring* r = g_rings[i].load(std::memory_order_acquire);
+        if (!r) continue;
+        uint64_t tail = r->tail.load(std::memory_order_relaxed);
+        uint64_t head = r->head.load(std::memory_order_acquire);
+        while (tail < head) {
+            Pending p;
+            r->copy_out(tail, &p.h, sizeof(p.h));
+            p.body.resize(p.h.len);
+            r->copy_out(tail + sizeof(p.h), &p.body[0], p.h.len);
+            tail += sizeof(p.h) + p.h.len;
+            b.records.push_back(std::move(p));
+        }
+        r->tail.store(tail, std::memory_order_release);
+        dropped += r->dropped.exchange(0, std::memory_order_relaxed);
+    }
 
-    char body[2048];
-    int blen = vsnprintf(body, sizeof(body), fmt, args);
-    if (blen < 0) blen = 0;
+    // Each ring is in order already; merge them by time.
+    std::stable_sort(b.records.begin(), b.records.end(),
+                     [](const Pending& a, const Pending& c) { return a.h.ns < c.h.ns; });
+    for (const auto& p : b.records) b.format(p.h, p.body.data(), p.body.size());
+    if (dropped > 0) {
+        RecordHeader h{};
+        h.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        h.tid = current_tid();
+        h.level = static_cast<uint8_t>(LogLevel::WARN);
+        char msg[96];
+        int len = snprintf(msg, sizeof(msg), "log: dropped %llu records (ring full)",
+                           static_cast<unsigned long long>(dropped));
+        b.format(h, msg, static_cast<size_t>(len));
+    }
+    b.flush();
+}
 
-    if (g_file) {
-        fwrite(header, 1, hlen, g_file);
-        fwrite(body, 1, blen, g_file);
-        fputc('\n', g_file);
-        fflush(g_file);
+void writer_main() {
+    Batch b;
+    std::unique_lock<std::mutex> lock(g_writer_mu);
+    while (!g_writer_stop) {
+        g_writer_cv.wait_for(lock, WRITER_PERIOD);
+        lock.unlock();
+        drain(b);
+        lock.lock();
     }
-    if (g_stderr) {
-        fwrite(header, 1, hlen, stderr);
-        fwrite(body, 1, blen, stderr);
-        fputc('\n', stderr);
+    lock.unlock();
+    drain(b);
+}
+
+// --- Fatal-signal flush (async-signal-safe: no locks, no allocation) ---
+
+constexpr int FATAL_SIGNALS[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+struct sigaction g_prev_actions[sizeof(FATAL_SIGNALS) / sizeof(FATAL_SIGNALS[0])];
+bool g_handlers_installed = false;
+
+char* put_uint(char* p, uint64_t v, int width) {
+    char tmp[20];
+    int n = 0;
+    do { tmp[n++] = static_cast<char>('0' + v % 10); v /= 10; } while (v > 0);
+    while (n < width) tmp[n++] = '0';
+    while (n > 0) *p++ = tmp[--n];
+    return p;
+}
+
+char* put_str(char* p, const char* s) {
+    while (*s) *p++ = *s++;
+    return p;
+}
+
+/// Local time from the offset the writer last saw; days-to-civil per
+/// Howard Hinnant's algorithm, since localtime_r may lock.
+char* put_timestamp(char* p, int64_t ns) {
+    int64_t ms = ns / 1000000 + g_utc_offset.load(std::memory_order_relaxed) * 1000;
+    int64_t secs = ms / 1000;
+    int64_t days = secs / 86400;
+    int64_t sod = secs % 86400;
+    int64_t z = days + 719468;
+    int64_t era = z / 146097;
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int64_t d = doy - (153 * mp + 2) / 5 + 1;
+    int64_t m = mp < 10 ? mp + 3 : mp - 9;
+    int64_t y = yoe + era * 400 + (m <= 2);
+    p = put_uint(p, y, 4); *p++ = '-';
+    p = put_uint(p, m, 2); *p++ = '-';
+    p = put_uint(p, d, 2); *p++ = ' ';
+    p = put_uint(p, sod / 3600, 2); *p++ = ':';
+    p = put_uint(p, sod / 60 % 60, 2); *p++ = ':';
+    p = put_uint(p, sod % 60, 2); *p++ = '.';
+    return put_uint(p, ms % 1000, 3);
+}
+
+void crash_write(const char* data, size_t n) {
+    int fd = g_crash_fd.load(std::memory_order_relaxed);
+    if (fd >= 0) write_all(fd, data, n);
+    if (g_crash_stderr.load(std::memory_order_relaxed)) write_all(STDERR_FILENO, data, n);
+}
+
+void fatal_signal_handler(int sig) {
+    // Records are written ring by ring rather than merged, and the writer
+    // may have been part-way through one; a duplicate line beats a lost one.
+    size_t n = std::min(g_ring_count.load(std::memory_order_acquire), MAX_RINGS);
+    for (size_t i = 0; i < n; ++i) {
+        Ring* r = g_rings[i].load(std::memory_order_acquire);
+        if (!r) continue;
+        uint64_t tail = r->tail.load(std::memory_order_acquire);
+        uint64_t head = r->head.load(std::memory_order_acquire);
+        while (tail < head) {
+            RecordHeader h;
+            char line[BODY_MAX + 128];
+            r->copy_out(tail, &h, sizeof(h));
+            char* p = put_timestamp(line, h.ns);
+            p = put_str(p, " [");
+            p = put_str(p, level_tag(h.level));
+            p = put_str(p, "] [tid=");
+            p = put_uint(p, static_cast<uint64_t>(h.tid), 1);
+            p = put_str(p, "] ");
+            r->copy_out(tail + sizeof(h), p, h.len);
+            p += h.len;
+            *p++ = '\n';
+            crash_write(line, static_cast<size_t>(p - line));
+            tail += sizeof(h) + h.len;
+        }
+    }
+    char line[64];
+    char* p = put_str(line, "log: fatal signal ");
+    p = put_uint(p, static_cast<uint64_t>(sig), 1);
+    p = put_str(p, "\n");
+    crash_write(line, static_cast<size_t>(p - line));
+
+    for (size_t i = 0; i < sizeof(FATAL_SIGNALS) / sizeof(FATAL_SIGNALS[0]); ++i)
+        if (FATAL_SIGNALS[i] == sig) sigaction(sig, &g_prev_actions[i], nullptr);
+    raise(sig);
+}
+
+void install_fatal_handlers() {
+    if (g_handlers_installed) return;
+    struct sigaction sa{};
+    sa.sa_handler = fatal_signal_handler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESETHAND | SA_NODEFER;
+    for (size_t i = 0; i < sizeof(FATAL_SIGNALS) / sizeof(FATAL_SIGNALS[0]); ++i)
+        sigaction(FATAL_SIGNALS[i], &sa, &g_prev_actions[i]);
+    g_handlers_installed = true;
+}
+
+void stop_writer() {
+    if (!g_writer.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(g_writer_mu);
+        g_writer_stop = true;
     }
+    g_writer_cv.notify_one();
+    g_writer.join();
 }
 
 } // anonymous namespace
@@ -139,11 +483,11 @@ const char* log_level_name(LogLevel level) {
 
 void log_init(LogLevel level, const fs::path& dir,
               int retention_hours, bool stderr_output) {
-    g_level = level;
-    g_stderr = stderr_output && level != LogLevel::NONE;
+    log_shutdown();
     g_retention_hours = retention_hours;
     if (level == LogLevel::NONE) return;
 
+    g_stderr = stderr_output;
     g_log_dir = dir.empty() ? (data_dir() / "logs") : dir;
     fs::create_directories(g_log_dir);
 
@@ -154,49 +498,67 @@ void log_init(LogLevel level, const fs::path& dir,
 
     open_hourly_file(tm);
     purge_old_logs();
+
+    g_crash_stderr.store(g_stderr, std::memory_order_relaxed);
+    install_fatal_handlers();
+    g_writer_stop = false;
+    g_writer = std::thread(writer_main);
+    g_level.store(level, std::memory_order_release);
 }
 
 void log_shutdown() {
-    std::lock_guard<std::mutex> lock(g_mutex);
-    if (g_file) {
-        fclose(g_file);
-        g_file = nullptr;
+    g_level.store(LogLevel::NONE, std::memory_order_release);
+    stop_writer();
+    g_crash_fd.store(-1, std::memory_order_relaxed);
+    g_crash_stderr.store(false, std::memory_order_relaxed);
+    if (g_fd >= 0) {
+        ::close(g_fd);
+        g_fd = -1;
     }
-    g_level = LogLevel::NONE;
     g_stderr = false;
     g_current_hour = -1;
 }
 
 void log_error(const char* fmt, ...) {
-    if (g_level < LogLevel::ERROR) return;
+    if (g_level.load(std::memory_order_relaxed) < LogLevel::ERROR) return;
     va_list args;
     va_start(args, fmt);
-    write_log("ERROR", fmt, args);
+    enqueue(LogLevel::ERROR, fmt, args);
     va_end(args);
 }
 
 void log_warn(const char* fmt, ...) {
-    if (g_level < LogLevel::WARN) return;
+    if (g_level.load(std::memory_order_relaxed) < LogLevel::WARN) return;
     va_list args;
     va_start(args, fmt);
-    write_log("WARN", fmt, args);
+    enqueue(LogLevel::WARN, fmt, args);
     va_end(args);
 }
 
 void log_info(const char* fmt, ...) {
-    if (g_level < LogLevel::INFO) return;
+    if (g_level.load(std::memory_order_relaxed) < LogLevel::INFO) return;
     va_list args;
     va_start(args, fmt);
-    write_log("INFO", fmt, args);
+    enqueue(LogLevel::INFO, fmt, args);
     va_end(args);
 }
 
 void log_debug(const char* fmt, ...) {
-    if (g_level < LogLevel::DEBUG) return;
+    if (g_level.load(std::memory_order_relaxed) < LogLevel::DEBUG) return;
     va_list args;
     va_start(args, fmt);
-    write_log("DEBUG", fmt, args);
+    enqueue(LogLevel::DEBUG, fmt, args);
     va_end(args);
 }
 
+namespace {
+
+// Drain the rings of a program that exits without log_shutdown(); defined
+// last so it is destroyed before the writer's thread and mutex.
+struct ShutdownAtExit {
+    ~ShutdownAtExit() { log_shutdown(); }
+} g_shutdown_at_exit;
+
+} // anonymous namespace
+
 } // namespace recmeet
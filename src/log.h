@@ -26,9 +26,16 @@ const char* log_level_name(LogLevel level);
 void log_init(LogLevel level, const fs::path& dir = "",
               int retention_hours = 4, bool stderr_output = false);
 
-/// Flush and close the log file.
+/// Write out every record logged so far and close the log file. Joins the
+/// writer thread; calling log_init() again starts a new one.
 void log_shutdown();
 
+// The log_* calls format on the caller's stack and copy the record into a
+// per-thread ring that a writer thread empties; they never lock, block or
+// make a system call, and a record that does not fit is dropped and
+// counted. A thread's first call allocates its ring, so an RT thread
+// should log once during setup before it logs from its hot path.
+
 /// Log at ERROR level. No-op when level < ERROR.
 __attribute__((format(printf, 1, 2)))
 void log_error(const char* fmt, ...);
@@ -2,20 +2,33 @@
 // SPDX-License-Identifier: MIT OR Apache-2.0
 
 #include "audio_file.h"
+#include "audio_view.h"
+#include "autotune.h"
 #include "backend_info.h"
 #include "cli.h"
 #include "config.h"
 #include "config_json.h"
+#include "config_reload.h"
 #include "device_enum.h"
+#include "diarize_sweep.h"
 #include "ipc_client.h"
 #include "ipc_protocol.h"
+#include "json_util.h"
 #include "log.h"
+#include "memory_governor.h"
+#include "model_cache.h"
 #include "model_manager.h"
+#include "model_memory.h"
 #include "ndjson_parse.h"
 #include "notify.h"
+#include "onnx_provider.h"
 #include "pipeline.h"
 #include "reprocess_batch.h"
 #include "speaker_id.h"
+#include "stage_cache.h"
+#include "stage_perf.h"
+#include "thread_budget.h"
+#include "trace.h"
 #include "util.h"
 #include "version.h"
 
@@ -30,6 +43,7 @@
 #include <cstring>
 #include <cstdio>
 #include <fstream>
+#include <iostream>
 #include <sstream>
 #include <thread>
 #include <unistd.h>
@@ -62,8 +76,12 @@ static void print_usage() {
         "  --source NAME        PipeWire/PulseAudio mic source (auto-detect if omitted)\n"
         "  --monitor NAME       Monitor/speaker source (auto-detect if omitted)\n"
         "  --mic-only           Record mic only (skip monitor capture)\n"
-        "  --keep-sources       Keep separate mic.wav and monitor.wav after mixing\n"
+        "  --keep-sources       Keep mic and monitor as one 2-channel sources.wav after mixing\n"
+        "  --audio-archive FMT  Store finished meeting audio as wav, flac or opus (default: wav)\n"
+        "  --archive-speech-only  Archive only the meeting's speech, with an index that\n"
+        "                       restores the original timeline on read\n"
         "  --model NAME         Whisper model: tiny/base/small/medium/large-v3 (default: base)\n"
+        "                       or a quantized variant, e.g. medium-q5_0, small-q8_0\n"
         "  --language CODE      Force whisper language (e.g. en, de, ja; default: auto-detect)\n"
         "  --vocab WORDS        Comma-separated vocabulary hints for transcription (names, terms)\n"
         "  --list-vocab         List persistent vocabulary words and exit\n"
@@ -83,12 +101,41 @@ static void print_usage() {
         "  --llm-model PATH     Local GGUF model for summarization (instead of API)\n"
         "  --mmap               Use mmap for LLM model loading (faster load, may cause swap)\n"
         "  --no-mmap            Disable mmap for LLM model loading (default, avoids swap thrashing)\n"
+        "  --llm-draft-model PATH  Small GGUF with the same vocabulary that drafts tokens\n"
+        "                       for --llm-model (speculative decoding)\n"
+        "  --summary-chunk-tokens N  Summarize transcripts over N prompt tokens in parts,\n"
+        "                       then combine the parts' notes (0 = auto: the local\n"
+        "                       model's context, 32000 for an API; default: 0)\n"
+        "  --no-summary-compact  Summarize the transcript as written, without merging\n"
+        "                       turns or dropping fillers and repeats first\n"
+        "  --llm-kv-type T      KV cache type for --llm-model: f16, q8_0 or q4_0\n"
+        "                       (default: f16; quantized types need less memory)\n"
+        "  --llm-batch N        Prompt tokens per decode call (0 = auto: 2048)\n"
+        "  --llm-ubatch N       Prompt tokens per compute pass (0 = auto: 512)\n"
+        "  --llm-gpu-layers N   --llm-model layers to offload to the GPU (-1 = as many\n"
+        "                       as fit free VRAM, 0 = CPU only; default: -1)\n"
+        "  --rolling-summary-minutes N  Fold the live transcript into running notes\n"
+        "                       every N minutes while recording (needs\n"
+        "                       --live-transcribe; 0 = off, default: 0)\n"
         "  --no-diarize         Disable speaker diarization\n"
         "  --num-speakers N     Number of speakers (0 = auto-detect, default: 0).\n"
         "                       For long audio that runs the chunked path, this is\n"
         "                       enforced post-stitch as a global count limit via\n"
         "                       sample-weighted greedy-merge (not per-chunk).\n"
         "  --cluster-threshold F  Clustering distance threshold (default: 1.18, higher = fewer speakers)\n"
+        "  --no-diarize-overlap Diarize after transcription even when whisper runs on a GPU\n"
+        "  --overlap-memory-mb N  Memory budget for diarizing during GPU transcription\n"
+        "                       (default: 10240; falls back to sequential above it)\n"
+        "  --diarize-parallel N Chunks diarized at once (default: 0 = as many as fit the\n"
+        "                       --overlap-memory-mb budget; 1 = one at a time)\n"
+        "  --live-diarize       Diarize each finished chunk of a long meeting while recording\n"
+        "                       (needs VAD + spool capture)\n"
+        "  --diarize-share-overlap  Embed the audio adjacent chunks share once, not per chunk\n"
+        "  --diarize-speech-only  Diarize only the VAD speech regions (cost follows speech time)\n"
+        "  --local-speaker NAME Label mic-dominated speech NAME in dual-source recordings and\n"
+        "                       diarize only the rest\n"
+        "  --diarize-provider NAME  onnxruntime provider for diarization: auto, cpu, cuda,\n"
+        "                       xnnpack (default: auto = GPU when present, else CPU)\n"
         "  --debug-dump-centroids PATH  Phase A diarize instrumentation: write a JSON dump of\n"
         "                       post-stitch global centroids, the pairwise cosine-similarity\n"
         "                       matrix, per-chunk local→global mapping (long-audio only), and\n"
@@ -98,29 +145,83 @@ static void print_usage() {
         "                       2026-05-18_09-36 writes /tmp/c_2026-05-18_09-36.json).\n"
         "  --no-vad             Disable VAD segmentation (transcribe full audio)\n"
         "  --vad-threshold F    VAD speech detection threshold (default: 0.5)\n"
+        "  --no-vad-pack        Transcribe each VAD segment separately instead of packing\n"
+        "                       consecutive segments into 30 s whisper windows\n"
         "  --threads N          Number of CPU threads for inference (0 = auto-detect, default: 0)\n"
+        "  --no-pin-threads     Do not place inference on performance cores / one NUMA node\n"
+        "  --no-backend-bench   Always run whisper and the LLM on the GPU when one is present,\n"
+        "                       instead of the backend a one-time benchmark found faster\n"
+        "  --hugepages          Advise transparent huge pages for model weights and log coverage\n"
+        "  --perf-counters      Count cycles, instructions, cache and branch misses per stage\n"
+        "  --whisper-workers N  Transcribe N VAD segments at once, splitting --threads\n"
+        "                       between them (0 = auto, default: 0)\n"
+        "  --live-transcribe    Transcribe finished speech segments while recording so the\n"
+        "                       note is ready soon after stop (needs VAD + spool capture)\n"
+        "  --draft-model NAME   Two-pass transcription: decode with NAME first, then re-decode\n"
+        "                       low-confidence VAD windows with --model (needs VAD)\n"
+        "  --draft-logprob F    Re-decode a draft window with a segment below this mean\n"
+        "                       token log-probability (default: -0.5)\n"
+        "  --language-pin-sec N Without --language, detect the language once on the first\n"
+        "                       N s of speech and keep it (0 = per window, default: 30)\n"
+        "  --pp-worker-jobs N   Daemon: reuse a warm postprocessing worker for N jobs\n"
+        "                       (0 = one subprocess per job, default: 8)\n"
+        "  --pp-worker-rss-mb N Daemon: retire the warm worker above N MB RSS (default: 6144)\n"
+        "  --pp-on-battery MODE Postprocessing on battery: run, reduce (a quarter of the\n"
+        "                       threads, default) or defer (daemon waits for AC power)\n"
         "  --reprocess PATH     Reprocess audio file or directory containing audio\n"
+        "  --no-stage-cache     Recompute every stage instead of reusing the transcript,\n"
+        "                       diarization and summary saved by an earlier pass\n"
+        "  --recluster DIR      Reprocess DIR redoing only diarization's stitching and\n"
+        "                       collapse from its stage cache (no whisper or sherpa pass)\n"
+        "  --diarize-sweep DIR  Diarize meeting DIR over a threshold grid and print speaker\n"
+        "                       counts and centroid similarity per point (repeatable)\n"
+        "  --sweep-cluster LIST, --sweep-stitch LIST, --sweep-collapse LIST\n"
+        "                       Comma-separated grid values for --diarize-sweep\n"
+        "                       (default: the configured threshold)\n"
         "  --reprocess-batch DIR  Reprocess every meeting subdir under DIR that has\n"
         "                       no corresponding note (skip-detection vs note-dir).\n"
         "                       Mutually exclusive with --reprocess.\n"
         "  --dry-run            With --reprocess-batch: print the would-process list\n"
         "                       (per-meeting reason: SKIP-note-exists / SKIP-no-audio /\n"
         "                       WILL-REPROCESS) and exit without doing any work.\n"
+        "  --batch-daemons LIST With --reprocess-batch: share the meetings across these\n"
+        "                       daemons (comma-separated host:port, repeatable)\n"
+        "  --refresh            With --reprocess-batch: also redo meetings whose note\n"
+        "                       was written from other inputs (model, settings, audio)\n"
+        "  --jobs N             With --reprocess-batch --no-daemon: reprocess up to N\n"
+        "                       meetings at once, as memory and cores allow (default: 1)\n"
+        "  --pipeline           With --reprocess-batch --no-daemon: overlap transcription,\n"
+        "                       diarization and summaries across consecutive meetings\n"
         "  --log-level LEVEL    Log level: none, error, warn, info (default: none)\n"
         "  --log-dir DIR        Log file directory (default: ~/.local/share/recmeet/logs/)\n"
+        "  --trace-out FILE     Write a Perfetto/Chrome trace of this run to FILE on exit\n"
         "  --list-sources       List available audio sources and exit\n"
         "  --download-models    Download required models and exit\n"
         "  --update-models      Re-download all cached models and exit\n"
+        "  --autotune           Benchmark whisper models, backends and thread counts on\n"
+        "                       this host, save the recommendation and exit\n"
+        "  --autotune-rtf F     Target real-time factor for --autotune (default: 0.25)\n"
+        "  --no-gpu             Run whisper on the CPU even when a GPU is available\n"
+        "  --gpu-devices N      Spread transcription over N GPUs, one model copy each\n"
+        "                       (0 = every GPU, default: 1)\n"
         "  --no-speaker-id      Disable speaker identification\n"
         "  --speaker-threshold F  Speaker identification similarity threshold (default: 0.6)\n"
         "  --speaker-db DIR     Speaker database directory (default: ~/.local/share/recmeet/speakers/)\n"
+        "  --speaker-ann        Search large speaker databases through an approximate index\n"
+        "  --speaker-participants  Match the context's Participants before the whole\n"
+        "                       speaker database\n"
+        "  --embedding-precision P  Store meeting and exported embeddings as f32, f16 or\n"
+        "                       int8 (default: f32)\n"
         "  --enroll NAME        Enroll a speaker from an existing recording\n"
         "  --from DIR           Meeting directory for enrollment (use with --enroll)\n"
         "  --speaker N          Speaker number to enroll (1-based; omit for interactive)\n"
         "  --speakers           List enrolled speakers and exit\n"
         "  --remove-speaker NAME  Remove an enrolled speaker and exit\n"
         "  --reset-speakers     Remove all enrolled speakers and exit\n"
+        "  --export-speakers DIR  Write each enrolled speaker to DIR/<Name>.json and exit\n"
         "  --identify DIR       Identify speakers in a recording (dry-run) and exit\n"
+        "  --rerender DIR       Rewrite DIR's note with its current speaker labels and\n"
+        "                       exit (no transcription, diarization or summary)\n"
         "  --daemon             Force client mode (require running daemon)\n"
         "  --no-daemon          Force standalone mode (skip daemon detection)\n"
         "  --status             Query daemon status and exit\n"
@@ -130,6 +231,12 @@ static void print_usage() {
         "  --show-captions      Force-enable live captions for this recording\n"
         "                       (V1: English only; ignored with --language != en)\n"
         "  --no-captions        Force-disable live captions for this recording\n"
+        "  --caption-partial-hz N  Daemon: max partial captions/s per client (default: 10, 0 = all)\n"
+        "  --caption-transcript Use the live captions as the transcript; skip whisper\n"
+        "  --caption-threads N  ONNX threads for live captions, 1 or 2 (default: 1)\n"
+        "  --no-caption-warm    Unload the caption model between recordings\n"
+        "  --caption-mlock      Lock the caption model in RAM while captions run\n"
+        "  --no-caption-int8-fallback  Keep fp32 captions even when they fall behind\n"
         "  -h, --help           Show this help\n"
         "  -v, --version        Show version\n"
     );
@@ -155,6 +262,11 @@ static int client_status(const std::string& addr = "") {
     }
     IpcResponse resp;
     IpcError err;
+    // Only the reply is wanted, not the event stream (an older daemon
+    // without events.subscribe just keeps sending it).
+    JsonMap no_events;
+    no_events["topics"] = std::string();
+    client.call("events.subscribe", no_events, resp, err, 2000);
     if (!client.call("status.get", resp, err)) {
         fprintf(stderr, "Error: %s\n", err.message.c_str());
         return 1;
@@ -246,6 +358,10 @@ int main(int argc, char* argv[]) {
     if (!cli.parse_warning.empty()) {
         fprintf(stderr, "Warning: %s\n", cli.parse_warning.c_str());
     }
+    set_onnx_provider(cli.cfg.diarize_provider);
+    set_model_hugepages(cli.cfg.model_hugepages);
+    set_perf_counters(cli.cfg.perf_counters);
+    set_thread_budget(cli.cfg.threads);
 
     // Phase 4 — `--list-caption-models` prints the curated list and exits.
     // Cache status (cached / not cached) is shown so operators know which
@@ -282,34 +398,15 @@ int main(int argc, char* argv[]) {
     if (cli.download_models) {
         Config cfg = cli.cfg;
         fprintf(stderr, "Downloading models...\n");
-        bool ok = true;
-        try {
-            fprintf(stderr, "  Whisper model '%s'... ", cfg.whisper_model.c_str());
-            ensure_whisper_model(cfg.whisper_model);
-            fprintf(stderr, "ready\n");
-        } catch (const std::exception& e) {
-            fprintf(stderr, "FAILED: %s\n", e.what());
-            ok = false;
-        }
+        // The models download side by side; each line prints as one finishes.
+        const std::string whisper_label = "Whisper model '" + cfg.whisper_model + "'";
+        std::vector<ModelFetch> fetches;
+        fetches.push_back({whisper_label, [&cfg] { ensure_whisper_model(cfg.whisper_model); }});
 #if RECMEET_USE_SHERPA
-        if (cfg.diarize) {
-            try {
-                fprintf(stderr, "  Diarization models... ");
-                ensure_sherpa_models();
-                fprintf(stderr, "ready\n");
-            } catch (const std::exception& e) {
-                fprintf(stderr, "FAILED: %s\n", e.what());
-            }
-        }
-        if (cfg.vad) {
-            try {
-                fprintf(stderr, "  VAD model... ");
-                ensure_vad_model();
-                fprintf(stderr, "ready\n");
-            } catch (const std::exception& e) {
-                fprintf(stderr, "FAILED: %s\n", e.what());
-            }
-        }
+        if (cfg.diarize)
+            fetches.push_back({"Diarization models", [] { ensure_sherpa_models(); }});
+        if (cfg.vad)
+            fetches.push_back({"VAD model", [] { ensure_vad_model(); }});
         // Phase 4 — opportunistically download the caption model alongside
         // the rest when captions are enabled in config (or when CLI
         // forced-on via --show-captions). Operators with captions disabled
@@ -317,15 +414,17 @@ int main(int argc, char* argv[]) {
         if (cfg.captions_enabled) {
             std::string canonical = cfg.caption_model.empty()
                 ? std::string("en-2023-06-26") : cfg.caption_model;
-            try {
-                fprintf(stderr, "  Caption model '%s'... ", canonical.c_str());
-                ensure_caption_model(cfg.caption_model);
-                fprintf(stderr, "ready\n");
-            } catch (const std::exception& e) {
-                fprintf(stderr, "FAILED: %s\n", e.what());
-            }
+            fetches.push_back({"Caption model '" + canonical + "'",
+                               [&cfg] { ensure_caption_model(cfg.caption_model); }});
         }
 #endif
+        const auto failed = fetch_models_parallel(
+            fetches, MODEL_FETCH_PARALLEL,
+            [](const std::string& label, const std::string& error) {
+                if (error.empty()) fprintf(stderr, "  %s... ready\n", label.c_str());
+                else fprintf(stderr, "  %s... FAILED: %s\n", label.c_str(), error.c_str());
+            });
+        const bool ok = failed.count(whisper_label) == 0;
         fprintf(stderr, ok ? "Done.\n" : "Done (with errors).\n");
         return ok ? 0 : 1;
     }
@@ -371,6 +470,32 @@ int main(int argc, char* argv[]) {
         return any_error ? 1 : 0;
     }
 
+    // Hardware autotune — standalone: benchmark, then write this host's profile
+    if (cli.autotune) {
+        ensure_backends();
+        AutotuneOptions opts;
+        opts.target_rtf = cli.autotune_rtf;
+        opts.on_trial = [](const TuneTrial& t) {
+            fprintf(stderr, "  %-9s %s %3d threads  RTF %.3f\n", t.model.c_str(),
+                    t.gpu ? "GPU" : "CPU", t.threads, t.rtf);
+        };
+        try {
+            fprintf(stderr, "Benchmarking whisper (target RTF %.2f)...\n", opts.target_rtf);
+            auto profile = run_autotune(cli.cfg, opts);
+            fs::path path = tune_profile_path();
+            fs::create_directories(path.parent_path());
+            write_text_file(path, tune_profile_yaml(profile));
+            fprintf(stderr, "Recommended: model %s on %s, %d threads, VAD %s (RTF %.3f)\n"
+                            "Written to %s\n",
+                    profile.whisper_model.c_str(), profile.gpu ? "GPU" : "CPU",
+                    profile.threads, profile.vad ? "on" : "off", profile.rtf, path.c_str());
+        } catch (const std::exception& e) {
+            fprintf(stderr, "Autotune failed: %s\n", e.what());
+            return 1;
+        }
+        return 0;
+    }
+
     // Vocabulary management commands — standalone, no daemon needed
     if (cli.list_vocab) {
         if (cli.cfg.vocabulary.empty()) {
@@ -463,21 +588,29 @@ int main(int argc, char* argv[]) {
     if (cli.list_speakers) {
         fs::path db_dir = cli.cfg.speaker_db.empty()
             ? default_speaker_db_dir() : cli.cfg.speaker_db;
-        auto names = list_speakers(db_dir);
-        if (names.empty()) {
+        auto profiles = load_speaker_db(db_dir);
+        if (profiles.empty()) {
             printf("No enrolled speakers. Use --enroll to add one.\n");
         } else {
-            printf("Enrolled speakers (%zu):\n", names.size());
-            for (const auto& name : names) {
-                auto profiles = load_speaker_db(db_dir);
-                for (const auto& p : profiles) {
-                    if (p.name == name) {
-                        printf("  %-20s  %zu enrollment(s)  updated: %s\n",
-                               p.name.c_str(), p.embeddings.size(), p.updated.c_str());
-                        break;
-                    }
-                }
-            }
+            printf("Enrolled speakers (%zu):\n", profiles.size());
+            for (const auto& p : profiles)
+                printf("  %-20s  %zu enrollment(s)  updated: %s\n",
+                       p.name.c_str(), p.embeddings.size(), p.updated.c_str());
+        }
+        return 0;
+    }
+
+    if (!cli.export_speakers.empty()) {
+        fs::path db_dir = cli.cfg.speaker_db.empty()
+            ? default_speaker_db_dir() : cli.cfg.speaker_db;
+        try {
+            EmbeddingPrecision precision = EmbeddingPrecision::F32;
+            parse_embedding_precision(cli.cfg.speaker_embedding_precision, precision);
+            int count = export_speaker_json(db_dir, cli.export_speakers, precision);
+            printf("Exported %d speaker profile(s) to %s\n", count, cli.export_speakers.c_str());
+        } catch (const std::exception& e) {
+            fprintf(stderr, "Error: %s\n", e.what());
+            return 1;
         }
         return 0;
     }
@@ -502,6 +635,17 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+    if (!cli.rerender_dir.empty()) {
+        try {
+            fs::path note = rerender_meeting_note(cli.cfg, cli.rerender_dir);
+            printf("Re-rendered %s\n", note.c_str());
+        } catch (const std::exception& e) {
+            fprintf(stderr, "Error: %s\n", e.what());
+            return 1;
+        }
+        return 0;
+    }
+
 #if RECMEET_USE_SHERPA
     if (!cli.enroll_name.empty()) {
         if (cli.enroll_from.empty()) {
@@ -516,16 +660,30 @@ int main(int argc, char* argv[]) {
         }
 
         auto model_paths = ensure_sherpa_models();
-        auto samples = read_wav_float(audio_path);
-        if (samples.empty()) {
+        std::unique_ptr<AudioView> audio;
+        try {
+            audio = std::make_unique<AudioView>(audio_path);
+        } catch (const RecmeetError&) {
             fprintf(stderr, "Error: Cannot read audio from %s\n", audio_path.c_str());
             return 1;
         }
 
-        // Run diarization to identify speaker clusters
-        fprintf(stderr, "Diarizing %s...\n", audio_path.c_str());
-        auto diar = diarize(samples.data(), samples.size(),
-                            cli.cfg.num_speakers, 0, cli.cfg.cluster_threshold);
+        // The meeting's saved diarization numbers speakers as its transcript
+        // does and spares a pass over the whole recording; only the chosen
+        // speaker's segments are read below.
+        DiarizeResult diar;
+        std::map<int, std::vector<float>> saved_centroids;
+        const fs::path diar_stage = stage_cache_path(audio_path, STAGE_DIARIZATION);
+        if (cli.cfg.stage_cache &&
+            load_saved_diarization_stage(diar_stage, diar, saved_centroids) &&
+            diar.num_speakers > 0) {
+            fprintf(stderr, "Using the saved diarization (%s)\n", diar_stage.filename().c_str());
+        } else {
+            fprintf(stderr, "Diarizing %s...\n", audio_path.c_str());
+            auto samples = read_wav_float(audio_path);
+            diar = diarize(samples.data(), samples.size(),
+                           cli.cfg.num_speakers, 0, cli.cfg.cluster_threshold);
+        }
 
         if (diar.num_speakers == 0) {
             fprintf(stderr, "Error: No speakers found in recording.\n");
@@ -564,9 +722,9 @@ int main(int argc, char* argv[]) {
         // Extract embedding
         fprintf(stderr, "Extracting voiceprint for '%s' from speaker %d...\n",
                 cli.enroll_name.c_str(), target_speaker + 1);
-        auto embedding = extract_speaker_embedding(
-            samples.data(), samples.size(), diar, target_speaker,
-            model_paths.embedding);
+        SpeakerEmbeddingSession session(model_paths.embedding);
+        auto embedding = extract_speaker_embedding(session, *audio, diar, target_speaker,
+                                                   ENROLL_MAX_SPEECH_SEC);
 
         if (embedding.empty()) {
             fprintf(stderr, "Error: Could not extract embedding (insufficient audio?).\n");
@@ -649,6 +807,13 @@ int main(int argc, char* argv[]) {
         }
         return 0;
     }
+
+    if (!cli.sweep_dirs.empty()) {
+        std::vector<fs::path> meetings(cli.sweep_dirs.begin(), cli.sweep_dirs.end());
+        return run_diarize_sweep(cli.cfg, meetings,
+                                 expand_sweep_grid(cli.sweep_cluster, cli.sweep_stitch,
+                                                   cli.sweep_collapse, cli.cfg));
+    }
 #endif // RECMEET_USE_SHERPA
 
     Config cfg = cli.cfg;
@@ -669,6 +834,7 @@ int main(int argc, char* argv[]) {
     // Initialize logging (stderr only on interactive TTY, not subprocess pipe)
     auto log_level = parse_log_level(cfg.log_level_str);
     log_init(log_level, cfg.log_dir, cfg.log_retention_hours, isatty(STDERR_FILENO));
+    const TraceSession trace(cli.trace_out);
 
     // Early validation: reject unsupported audio formats before daemon dispatch
     if (!cfg.reprocess_dir.empty()) {
@@ -723,26 +889,11 @@ int main(int argc, char* argv[]) {
 // Writes NDJSON progress to stdout, exit 0=ok, 1=error, 2=cancelled.
 // ---------------------------------------------------------------------------
 
-static int subprocess_main(CliResult& cli) {
+static void subprocess_setup() {
     // Subprocess must NOT log to file or stderr — output goes through NDJSON
     // stdout and parent captures stderr for relay
     log_shutdown();
 
-    // Load full config from JSON file
-    std::string json_content;
-    {
-        std::ifstream in(cli.config_json_path);
-        if (!in) {
-            fprintf(stderr, "Cannot open config file: %s\n", cli.config_json_path.c_str());
-            return 1;
-        }
-        std::ostringstream ss;
-        ss << in.rdbuf();
-        json_content = ss.str();
-    }
-
-    Config cfg = config_from_json(json_content);
-
     // Suppress whisper log noise
     whisper_log_set([](enum ggml_log_level, const char*, void*) {}, nullptr);
 
@@ -756,6 +907,29 @@ static int subprocess_main(CliResult& cli) {
     sigaction(SIGINT, &sa, nullptr);
     sigaction(SIGTERM, &sa, nullptr);
 
+    // The daemon reruns a deferred job in a fresh process.
+    set_postprocess_deferral(true);
+}
+
+// One postprocessing job from the daemon's pp-*.json at `config_path`.
+// Returns the subprocess exit code and removes the config file.
+static int run_subprocess_job(const std::string& config_path) {
+    // Load full config from JSON file
+    std::string json_content;
+    {
+        std::ifstream in(config_path);
+        if (!in) {
+            fprintf(stderr, "Cannot open config file: %s\n", config_path.c_str());
+            return 1;
+        }
+        std::ostringstream ss;
+        ss << in.rdbuf();
+        json_content = ss.str();
+    }
+
+    Config cfg = config_from_json(json_content);
+    set_thread_budget(cfg.threads);  // this job's engines share it (thread_budget.h)
+
     // Heartbeat thread — writes periodic NDJSON so the daemon knows we're alive
     // and can observe RSS growth. Any real progress/phase event also serves as a
     // heartbeat, so the interval here (10 s) is just a fallback for long-running
@@ -782,7 +956,7 @@ static int subprocess_main(CliResult& cli) {
             if (heartbeat_stop.load(std::memory_order_relaxed)) break;
 
             long rss_kb = read_self_rss_kb();
-            write_heartbeat_ndjson(STDOUT_FILENO, rss_kb);
+            write_heartbeat_ndjson(STDOUT_FILENO, rss_kb, read_self_peak_rss_kb());
 
             if (limit_kb > 0 && rss_kb > limit_kb) {
                 // Daemon's stderr-capture concatenates this line onto the
@@ -811,6 +985,28 @@ static int subprocess_main(CliResult& cli) {
         write_ndjson("progress", buf);
     };
 
+    // Summary text is relayed in pieces of a few hundred bytes or every
+    // 100 ms, whichever comes first, not a line per token.
+    std::string summary_pending;
+    auto summary_flushed = std::chrono::steady_clock::now();
+    auto flush_summary = [&]() {
+        if (summary_pending.empty()) return;
+        std::string data = "{\"text\":\"" + json_escape(summary_pending) + "\"}";
+        write_ndjson("summary.delta", data.c_str());
+        summary_pending.clear();
+        summary_flushed = std::chrono::steady_clock::now();
+    };
+    auto on_summary_delta = [&](const std::string& text) {
+        summary_pending += text;
+        if (summary_pending.size() >= 256 ||
+            std::chrono::steady_clock::now() - summary_flushed >= std::chrono::milliseconds(100))
+            flush_summary();
+    };
+
+    auto on_stage_perf = [](const StagePerf& perf) {
+        write_ndjson("stage.perf", serialize_json_map(stage_perf_to_map(perf)).c_str());
+    };
+
     try {
         // subprocess_main is reached only with cfg.reprocess_dir set (the
         // daemon writes a pp-*.json config). run_recording enters the
@@ -820,7 +1016,27 @@ static int subprocess_main(CliResult& cli) {
         // reprocess context would delete the operator's source data.
         StopToken dummy_cancel;
         auto input = run_recording(cfg, g_stop, dummy_cancel, on_phase);
-        auto result = run_postprocessing(cfg, input, on_phase, on_progress, &g_stop);
+        auto result = run_postprocessing(cfg, input, on_phase, on_progress, &g_stop,
+                                         on_summary_delta, on_stage_perf);
+        flush_summary();
+
+        // Two-pass transcription outcome; full_estimate_sec / saved_sec
+        // are -1 / 0 when no window was re-decoded.
+        if (result.draft.windows > 0) {
+            char buf[256];
+            snprintf(buf, sizeof(buf),
+                     "{\"windows\":%zu,\"redecoded\":%zu,\"draft_sec\":%.1f,"
+                     "\"redecode_sec\":%.1f,\"full_estimate_sec\":%.1f,\"saved_sec\":%.1f}",
+                     result.draft.windows, result.draft.redecoded, result.draft.draft_sec,
+                     result.draft.redecode_sec, result.draft.full_estimate_sec(),
+                     result.draft.saved_sec());
+            write_ndjson("transcribe.draft", buf);
+        }
+        if (result.repetition_aborts > 0) {
+            char buf[64];
+            snprintf(buf, sizeof(buf), "{\"repetition_aborts\":%d}", result.repetition_aborts);
+            write_ndjson("transcribe.stats", buf);
+        }
 
         // Emit job.complete
         std::string data = "{\"note_path\":\"";
@@ -841,46 +1057,90 @@ static int subprocess_main(CliResult& cli) {
 
         // Clean up config file
         std::error_code ec;
-        fs::remove(cli.config_json_path, ec);
+        fs::remove(config_path, ec);
 
         stop_heartbeat();
         return 0;
+    } catch (const PostprocessDeferred& e) {
+        stop_heartbeat();
+        fprintf(stderr, "%s\n", e.what());
+        std::error_code ec;
+        fs::remove(config_path, ec);
+        return PP_EXIT_DEFERRED;
     } catch (const RecmeetError& e) {
         stop_heartbeat();
         std::string msg = e.what();
         if (msg == "Cancelled") {
             std::error_code ec;
-            fs::remove(cli.config_json_path, ec);
+            fs::remove(config_path, ec);
             return 2;
         }
         fprintf(stderr, "%s\n", e.what());
         std::error_code ec;
-        fs::remove(cli.config_json_path, ec);
+        fs::remove(config_path, ec);
         return 1;
     } catch (const std::exception& e) {
         stop_heartbeat();
         fprintf(stderr, "%s\n", e.what());
         std::error_code ec;
-        fs::remove(cli.config_json_path, ec);
+        fs::remove(config_path, ec);
         return 1;
     }
 }
 
+static int subprocess_main(CliResult& cli) {
+    subprocess_setup();
+    return run_subprocess_job(cli.config_json_path);
+}
+
+// Warm worker (`--pp-worker`): the daemon keeps this process alive across
+// jobs so the models loaded by one meeting are still resident for the next.
+// Reads one pp-*.json path per stdin line, runs it like subprocess_main, and
+// follows each job's NDJSON with a `job.exit` event carrying the exit code,
+// RSS and the job's peak RSS. A `release <kinds>` line between jobs drops
+// the models a config reload invalidated (config_reload.h). Exits on EOF,
+// which is how the daemon recycles it.
+static int pp_worker_main() {
+    subprocess_setup();
+    set_model_cache_enabled(true);
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (line.empty()) continue;
+        std::vector<std::string> kinds;
+        if (parse_pp_worker_release(line, kinds)) {
+            size_t released = 0;
+            for (const auto& kind : kinds) released += release_resident_models(kind);
+            release_free_heap();
+            log_info("pp worker: %zu model(s) dropped for a config reload (%s)", released,
+                     line.c_str());
+            continue;
+        }
+        g_stop.reset();
+        reset_self_peak_rss();  // heartbeats then report this job's peak
+        int rc = run_subprocess_job(line);
+        char buf[128];
+        snprintf(buf, sizeof(buf), "{\"code\":%d,\"rss_kb\":%ld,\"peak_rss_kb\":%ld}", rc,
+                 read_self_rss_kb(), read_self_peak_rss_kb());
+        write_ndjson("job.exit", buf);
+    }
+    return 0;
+}
+
 static int standalone_main(CliResult& cli) {
-    // Discover runtime-loadable ggml backends and surface the active device.
-    // Fires for both standalone recording and the subprocess postprocessing
-    // child (launched via execv by the daemon) — the child's banner is what
-    // tells the operator the subprocess inherited the same GPU plugin
-    // discovery as the parent daemon. See agentctx/tasks/runtime-loadable-
-    // gpu-backends.md (Step 4 + Step 9 T6) and auto-detect-vulkan-backend.md
-    // (Step 5).
-    load_backends();
-    log_backend_summary();
+    // ggml backends are discovered at the first model load (ensure_backends()),
+    // not here: --list-sources never needs them, and a recording starts
+    // capturing without waiting on plugin discovery. The subprocess
+    // postprocessing child still prints the active-backend banner when it
+    // loads whisper.
 
     // Subprocess mode: daemon launched us with --progress-json --config-json
     if (cli.progress_json && !cli.config_json_path.empty()) {
         return subprocess_main(cli);
     }
+    if (cli.pp_worker) {
+        return pp_worker_main();
+    }
 
     Config cfg = cli.cfg;
 
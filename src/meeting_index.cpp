@@ -0,0 +1,356 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "meeting_index.h"
+#include "audio_file.h"
+#include "ipc_protocol.h"
+#include "log.h"
+#include "speaker_id.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <set>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace recmeet {
+
+namespace {
+
+constexpr int CACHE_VERSION = 2;
+constexpr uint32_t ROOT_MASK = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+constexpr uint32_t MEETING_MASK =
+    IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ONLYDIR;
+
+// Modification time in ns, or -1 when `path` is missing.
+int64_t mtime_ns(const fs::path& path) {
+    struct stat st{};
+    if (::stat(path.c_str(), &st) != 0) return -1;
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+// Flat-object parse via the IPC parser, as backend_bench.cpp does.
+bool parse_flat(const std::string& line, JsonMap& out) {
+    IpcMessage msg;
+    if (!parse_ipc_message("{\"id\":0,\"result\":" + line + "}", msg) ||
+        msg.type != IpcMessageType::Response)
+        return false;
+    out = std::move(msg.response.result);
+    return true;
+}
+
+} // anonymous namespace
+
+bool scan_meeting(const fs::path& dir, MeetingInfo& out) {
+    const fs::path audio = find_audio_file(dir);
+    if (audio.empty()) return false;
+    out = MeetingInfo{};
+    out.name = dir.filename().string();
+    out.duration_sec = probe_audio(audio, 0).duration_sec;
+    out.has_speakers = !find_speakers_file(dir).empty();
+#if RECMEET_USE_SHERPA
+    if (out.has_speakers)
+        out.speaker_count = static_cast<int>(load_meeting_speakers(dir).size());
+#endif
+    // Date from the directory name (YYYY-MM-DD_HH-MM format)
+    const auto& n = out.name;
+    if (n.size() >= 10 && n[4] == '-' && n[7] == '-') out.date = n.substr(0, 10);
+    return true;
+}
+
+fs::path meeting_index_cache_path() {
+    return data_dir() / "web_meetings.ndjson";
+}
+
+std::vector<MeetingInfo> select_meetings(const std::vector<MeetingInfo>& meetings,
+                                         const MeetingQuery& q, std::string& next) {
+    std::vector<MeetingInfo> out;
+    next.clear();
+    // Most recent first, so the page after `cursor` holds smaller names.
+    auto it = q.cursor.empty()
+        ? meetings.begin()
+        : std::find_if(meetings.begin(), meetings.end(),
+                       [&q](const MeetingInfo& m) { return m.name < q.cursor; });
+    for (; it != meetings.end(); ++it) {
+        const MeetingInfo& m = *it;
+        if (!q.text.empty() && m.name.find(q.text) == std::string::npos) continue;
+        if (!q.from.empty() && (m.date.empty() || m.date < q.from)) continue;
+        if (!q.to.empty() && (m.date.empty() || m.date > q.to)) continue;
+        if (q.has_speakers >= 0 && m.has_speakers != (q.has_speakers == 1)) continue;
+        if (q.limit > 0 && out.size() == q.limit) {
+            next = out.back().name;
+            break;
+        }
+        out.push_back(m);
+    }
+    return out;
+}
+
+MeetingIndex::MeetingIndex(fs::path output_dir, fs::path cache_file)
+    : output_dir_(std::move(output_dir)), cache_file_(std::move(cache_file)) {
+    if (!cache_file_.empty()) load_cache();
+}
+
+MeetingIndex::~MeetingIndex() {
+    stop_ = true;
+    if (watcher_.joinable()) watcher_.join();
+    if (inotify_fd_ >= 0) ::close(inotify_fd_);
+    std::lock_guard<std::mutex> lock(mu_);
+    if (dirty_) save_cache();
+}
+
+MeetingIndex::Entry MeetingIndex::read_entry(const fs::path& dir) {
+    ++scans_;
+    Entry e;
+    e.dir_mtime = mtime_ns(dir);
+    try {
+        e.is_meeting = scan_meeting(dir, e.info);
+    } catch (const std::exception& ex) {
+        // An unreadable speakers file still lists the meeting, with no count.
+        log_warn("meeting index: %s: %s", dir.filename().c_str(), ex.what());
+        e.is_meeting = !find_audio_file(dir).empty();
+        e.info.name = dir.filename().string();
+    }
+    const fs::path spk = find_speakers_file(dir);
+    if (!spk.empty()) {
+        e.speakers = spk.filename().string();
+        e.speakers_mtime = mtime_ns(spk);
+    }
+    return e;
+}
+
+bool MeetingIndex::is_current(const std::string& name, const Entry& e) const {
+    const fs::path dir = output_dir_ / name;
+    if (mtime_ns(dir) != e.dir_mtime) return false;
+    // A speakers file rewritten in place leaves the directory mtime alone.
+    return e.speakers.empty() || mtime_ns(dir / e.speakers) == e.speakers_mtime;
+}
+
+void MeetingIndex::rescan() {
+    std::vector<std::string> names;
+    std::error_code ec;
+    for (fs::directory_iterator it(output_dir_, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code dec;
+        if (it->is_directory(dec)) names.push_back(it->path().filename().string());
+    }
+
+    std::map<std::string, Entry> fresh;
+    bool changed;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        for (const auto& name : names) {
+            auto it = entries_.find(name);
+            if (it != entries_.end()) fresh.emplace(name, it->second);
+        }
+        changed = fresh.size() != entries_.size();  // some directory is gone
+    }
+    for (const auto& name : names) {
+        auto it = fresh.find(name);
+        if (it != fresh.end() && is_current(name, it->second)) continue;
+        fresh[name] = read_entry(output_dir_ / name);
+        changed = true;
+    }
+
+    std::lock_guard<std::mutex> lock(mu_);
+    entries_ = std::move(fresh);
+    if (changed) {
+        ++generation_;
+        dirty_ = true;
+        save_cache();
+    }
+}
+
+void MeetingIndex::refresh(const std::string& name) {
+    const fs::path dir = output_dir_ / name;
+    std::error_code ec;
+    const bool exists = fs::is_directory(dir, ec);
+    Entry e;
+    if (exists) e = read_entry(dir);
+    std::lock_guard<std::mutex> lock(mu_);
+    if (exists)
+        entries_[name] = std::move(e);
+    else
+        entries_.erase(name);
+    ++generation_;
+    dirty_ = true;
+}
+
+std::vector<MeetingInfo> MeetingIndex::list() const {
+    std::vector<MeetingInfo> out;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        out.reserve(entries_.size());
+        for (const auto& [name, e] : entries_)
+            if (e.is_meeting) out.push_back(e.info);
+    }
+    std::reverse(out.begin(), out.end());
+    return out;
+}
+
+void MeetingIndex::load_cache() {
+    std::ifstream in(cache_file_);
+    std::string line;
+    JsonMap m;
+    if (!std::getline(in, line) || !parse_flat(line, m)) return;
+    auto str = [&m](const char* key) {
+        auto it = m.find(key);
+        return it == m.end() ? std::string() : json_val_as_string(it->second);
+    };
+    auto num = [&m](const char* key) {
+        auto it = m.find(key);
+        return it == m.end() ? int64_t(0) : json_val_as_int(it->second);
+    };
+    // Written for another output directory or format: start over.
+    if (num("version") != CACHE_VERSION || str("output_dir") != output_dir_.string()) return;
+
+    while (std::getline(in, line)) {
+        if (line.empty() || !parse_flat(line, m)) continue;
+        Entry e;
+        e.info.name = str("name");
+        if (e.info.name.empty()) continue;
+        auto flag = [&m](const char* key) {
+            auto it = m.find(key);
+            return it != m.end() && json_val_as_bool(it->second);
+        };
+        e.is_meeting = flag("meeting");
+        e.info.has_speakers = flag("has_speakers");
+        e.info.speaker_count = static_cast<int>(num("speaker_count"));
+        e.info.date = str("date");
+        auto dur = m.find("duration_sec");
+        e.info.duration_sec = dur == m.end() ? 0.0 : json_val_as_double(dur->second);
+        e.dir_mtime = num("dir_mtime");
+        e.speakers = str("speakers");
+        e.speakers_mtime = num("speakers_mtime");
+        entries_[e.info.name] = std::move(e);
+    }
+}
+
+// Caller holds mu_.
+void MeetingIndex::save_cache() {
+    dirty_ = false;
+    if (cache_file_.empty()) return;
+    JsonMap head;
+    head["version"] = static_cast<int64_t>(CACHE_VERSION);
+    head["output_dir"] = output_dir_.string();
+    std::string body = serialize_json_map(head) + "\n";
+    for (const auto& [name, e] : entries_) {
+        JsonMap m;
+        m["name"] = name;
+        m["meeting"] = e.is_meeting;
+        m["has_speakers"] = e.info.has_speakers;
+        m["speaker_count"] = static_cast<int64_t>(e.info.speaker_count);
+        m["date"] = e.info.date;
+        m["duration_sec"] = e.info.duration_sec;
+        m["dir_mtime"] = e.dir_mtime;
+        m["speakers"] = e.speakers;
+        m["speakers_mtime"] = e.speakers_mtime;
+        body += serialize_json_map(m) + "\n";
+    }
+    try {
+        std::error_code ec;
+        fs::create_directories(cache_file_.parent_path(), ec);
+        write_text_file_atomic(cache_file_, body);
+    } catch (const std::exception& ex) {
+        log_warn("meeting index: cannot save %s (%s)", cache_file_.c_str(), ex.what());
+    }
+}
+
+void MeetingIndex::add_watch(const std::string& name) {
+    if (inotify_fd_ < 0) return;
+    const fs::path dir = output_dir_ / name;
+    const int wd = ::inotify_add_watch(inotify_fd_, dir.c_str(), MEETING_MASK);
+    if (wd >= 0) {
+        watches_[wd] = name;
+    } else if (errno == ENOSPC) {
+        // fs.inotify.max_user_watches exhausted: fall back to polling.
+        log_warn("meeting index: inotify watch limit reached; polling %s instead",
+                 output_dir_.c_str());
+        ::close(inotify_fd_);
+        inotify_fd_ = -1;
+        watches_.clear();
+    }
+}
+
+void MeetingIndex::start(int poll_sec) {
+    if (watcher_.joinable()) return;
+    inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ >= 0) {
+        root_wd_ = ::inotify_add_watch(inotify_fd_, output_dir_.c_str(), ROOT_MASK);
+        if (root_wd_ < 0) {
+            ::close(inotify_fd_);
+            inotify_fd_ = -1;
+        }
+    }
+    if (inotify_fd_ >= 0) {
+        std::error_code ec;
+        for (fs::directory_iterator it(output_dir_, ec), end;
+             !ec && it != end && inotify_fd_ >= 0; it.increment(ec)) {
+            std::error_code dec;
+            if (it->is_directory(dec)) add_watch(it->path().filename().string());
+        }
+    }
+    if (inotify_fd_ < 0)
+        log_info("meeting index: polling %s every %ds", output_dir_.c_str(), poll_sec);
+    rescan();
+    watcher_ = std::thread([this, poll_sec] { watch_loop(poll_sec); });
+}
+
+void MeetingIndex::drain_events() {
+    alignas(struct inotify_event) char buf[16384];
+    std::set<std::string> touched;
+    bool overflow = false;
+    for (;;) {
+        const ssize_t n = ::read(inotify_fd_, buf, sizeof(buf));
+        if (n <= 0) break;
+        for (ssize_t off = 0; off < n;) {
+            const auto* ev = reinterpret_cast<const struct inotify_event*>(buf + off);
+            off += static_cast<ssize_t>(sizeof(struct inotify_event) + ev->len);
+            if (ev->mask & IN_Q_OVERFLOW) {
+                overflow = true;
+            } else if (ev->wd == root_wd_) {
+                if (!(ev->mask & IN_ISDIR) || ev->len == 0) continue;
+                const std::string name = ev->name;
+                if (ev->mask & (IN_CREATE | IN_MOVED_TO)) add_watch(name);
+                touched.insert(name);
+            } else if (ev->mask & IN_IGNORED) {
+                watches_.erase(ev->wd);
+            } else {
+                auto it = watches_.find(ev->wd);
+                if (it != watches_.end()) touched.insert(it->second);
+            }
+        }
+    }
+    if (overflow) {
+        rescan();
+        return;
+    }
+    for (const auto& name : touched) refresh(name);
+}
+
+void MeetingIndex::watch_loop(int poll_sec) {
+    using clock = std::chrono::steady_clock;
+    auto last_sweep = clock::now();
+    while (!stop_) {
+        if (inotify_fd_ >= 0) {
+            struct pollfd pfd{inotify_fd_, POLLIN, 0};
+            if (::poll(&pfd, 1, 250) > 0) drain_events();
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        }
+        const int period = inotify_fd_ >= 0 ? std::max(poll_sec, kInotifyPollSec) : poll_sec;
+        if (clock::now() - last_sweep >= std::chrono::seconds(period)) {
+            rescan();
+            last_sweep = clock::now();
+        }
+        std::lock_guard<std::mutex> lock(mu_);
+        if (dirty_) save_cache();
+    }
+}
+
+} // namespace recmeet
@@ -0,0 +1,139 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Meeting index (recmeet-web)
+// ---------------------------------------------------------------------------
+//
+// `GET /api/meetings` lists every meeting directory under the output
+// directory with its speaker count. Finding the audio file and parsing the
+// speakers file of each one per request takes seconds with a few thousand
+// meetings on network storage, so the server keeps the listing in memory.
+// It is built once, kept current by inotify (or, where inotify is not
+// available, by comparing directory and speakers-file mtimes on a timer),
+// and saved to a cache file so a restart only has to stat each meeting.
+
+/// One meeting as `GET /api/meetings` lists it.
+struct MeetingInfo {
+    std::string name;
+    bool has_speakers = false;
+    int speaker_count = 0;
+    std::string date;         ///< YYYY-MM-DD from the directory name, or empty
+    double duration_sec = 0;  ///< recording length, 0 when its header is unreadable
+};
+
+/// Read meeting directory `dir` into `out`. False when it holds no audio
+/// file, i.e. is not a meeting. The length comes from the audio's header
+/// (probe_audio() without sampling), so no audio is decoded.
+bool scan_meeting(const fs::path& dir, MeetingInfo& out);
+
+/// `<data_dir>/web_meetings.ndjson`.
+fs::path meeting_index_cache_path();
+
+/// Filter and page of `GET /api/meetings`.
+struct MeetingQuery {
+    std::string cursor;     ///< start after this name: the previous page's last
+    size_t limit = 0;       ///< meetings per page; 0 = all
+    std::string text;       ///< substring of the name
+    std::string from;       ///< inclusive YYYY-MM-DD bounds on the date;
+    std::string to;         ///< a meeting without a date fails either
+    int has_speakers = -1;  ///< -1 either, 0 without, 1 with a speakers file
+};
+
+/// The page of `meetings` (most recent first, as MeetingIndex::list()
+/// returns them) that `q` selects. `next` is the cursor of the following
+/// page, or empty on the last page.
+std::vector<MeetingInfo> select_meetings(const std::vector<MeetingInfo>& meetings,
+                                         const MeetingQuery& q, std::string& next);
+
+class MeetingIndex {
+public:
+    /// Index of `output_dir`. Loads `cache_file` when it was written for the
+    /// same directory; an empty path keeps the index in memory only.
+    explicit MeetingIndex(fs::path output_dir, fs::path cache_file = {});
+    /// Stops watching and saves pending changes.
+    ~MeetingIndex();
+
+    MeetingIndex(const MeetingIndex&) = delete;
+    MeetingIndex& operator=(const MeetingIndex&) = delete;
+
+    /// Bring every entry up to date: stat each directory, re-read those
+    /// whose directory or speakers file changed since they were read, and
+    /// drop those that are gone. Saves the cache when anything changed.
+    void rescan();
+
+    /// Re-read meeting `name` now, e.g. after the server rewrote its
+    /// speakers file.
+    void refresh(const std::string& name);
+
+    /// Meetings, most recent first (names are date-based).
+    std::vector<MeetingInfo> list() const;
+
+    /// Bumped whenever list() would return something different, so a
+    /// response built from it can be tagged and revalidated cheaply.
+    uint64_t generation() const { return generation_; }
+
+    /// Watch the output directory on a background thread: inotify events
+    /// re-read the meeting they name, and rescan() runs every `poll_sec`
+    /// (every kInotifyPollSec as a safety net while inotify works). Adds
+    /// the watches before a first rescan(), so no change is missed.
+    void start(int poll_sec = kPollSec);
+
+    /// Whether the watcher is using inotify rather than polling alone.
+    bool inotify_active() const { return inotify_fd_ >= 0; }
+
+    /// Meeting directories read from disk so far. Test seam.
+    size_t scans() const { return scans_; }
+
+    static constexpr int kPollSec = 10;
+    static constexpr int kInotifyPollSec = 300;
+
+private:
+    struct Entry {
+        MeetingInfo info;
+        bool is_meeting = false;   ///< has an audio file
+        int64_t dir_mtime = 0;     ///< ns, when read
+        std::string speakers;      ///< speakers file name, or empty
+        int64_t speakers_mtime = 0;
+    };
+
+    Entry read_entry(const fs::path& dir);
+    bool is_current(const std::string& name, const Entry& e) const;
+    void load_cache();
+    void save_cache();
+    void add_watch(const std::string& name);
+    void watch_loop(int poll_sec);
+    void drain_events();
+
+    const fs::path output_dir_;
+    const fs::path cache_file_;
+
+    mutable std::mutex mu_;
+    std::map<std::string, Entry> entries_;  ///< every subdirectory, by name
+    bool dirty_ = false;                    ///< changed since the cache was saved
+    std::atomic<size_t> scans_{0};
+    std::atomic<uint64_t> generation_{0};
+
+    std::atomic<int> inotify_fd_{-1};
+    int root_wd_ = -1;
+    std::map<int, std::string> watches_;  ///< inotify wd -> meeting name
+    std::thread watcher_;
+    std::atomic<bool> stop_{false};
+};
+
+} // namespace recmeet
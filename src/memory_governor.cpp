@@ -0,0 +1,112 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "memory_governor.h"
+#include "util.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace recmeet {
+
+namespace {
+
+std::atomic<bool> g_deferral{false};
+
+// The avg10 field of a PSI line, or -1 when it has none.
+double avg10_field(const std::string& line) {
+    const auto at = line.find("avg10=");
+    if (at == std::string::npos) return -1;
+    char* end = nullptr;
+    const char* p = line.c_str() + at + 6;
+    const double v = std::strtod(p, &end);
+    return end == p ? -1 : v;
+}
+
+std::string read_file(const fs::path& path) {
+    std::ifstream in(path);
+    if (!in) return {};
+    std::ostringstream buf;
+    buf << in.rdbuf();
+    return buf.str();
+}
+
+} // anonymous namespace
+
+const char* memory_level_name(MemoryLevel level) {
+    switch (level) {
+        case MemoryLevel::Tight:    return "tight";
+        case MemoryLevel::Critical: return "critical";
+        default:                    return "normal";
+    }
+}
+
+bool parse_memory_pressure(const std::string& text, MemoryPressure& out) {
+    std::istringstream in(text);
+    std::string line;
+    bool found = false;
+    MemoryPressure p;
+    while (std::getline(in, line)) {
+        const double v = avg10_field(line);
+        if (v < 0) continue;
+        if (line.compare(0, 5, "some ") == 0) {
+            p.some_avg10 = v;
+            found = true;
+        } else if (line.compare(0, 5, "full ") == 0) {
+            p.full_avg10 = v;
+            found = true;
+        }
+    }
+    if (found) out = p;
+    return found;
+}
+
+MemorySample sample_memory() {
+    MemorySample s;
+    s.rss_bytes = static_cast<uint64_t>(std::max(read_self_rss_kb(), 0L)) * 1024;
+    s.ceiling_bytes = read_memory_ceiling_bytes();
+
+    std::string body;
+    std::ifstream cg("/proc/self/cgroup");
+    std::string line;
+    while (std::getline(cg, line)) {
+        if (line.compare(0, 3, "0::") != 0) continue;
+        body = read_file(fs::path("/sys/fs/cgroup" + line.substr(3)) / "memory.pressure");
+        break;
+    }
+    if (body.empty()) body = read_file("/proc/pressure/memory");
+    parse_memory_pressure(body, s.pressure);
+    return s;
+}
+
+MemoryLevel classify_memory(const MemorySample& sample) {
+    const double share = sample.ceiling_bytes > 0
+        ? static_cast<double>(sample.rss_bytes) / static_cast<double>(sample.ceiling_bytes)
+        : 0.0;
+    if (share >= MEMORY_CRITICAL_SHARE ||
+        sample.pressure.full_avg10 >= MEMORY_CRITICAL_FULL_AVG10)
+        return MemoryLevel::Critical;
+    if (share >= MEMORY_TIGHT_SHARE || sample.pressure.some_avg10 >= MEMORY_TIGHT_SOME_AVG10)
+        return MemoryLevel::Tight;
+    return MemoryLevel::Normal;
+}
+
+bool memory_fits(const MemorySample& sample, uint64_t extra_bytes) {
+    if (sample.ceiling_bytes == 0) return true;
+    return static_cast<double>(sample.rss_bytes + extra_bytes) <
+           MEMORY_CRITICAL_SHARE * static_cast<double>(sample.ceiling_bytes);
+}
+
+int governed_threads(int threads, MemoryLevel level) {
+    threads = std::max(threads, 1);
+    return level == MemoryLevel::Normal ? threads : std::max(threads / 2, 1);
+}
+
+void set_postprocess_deferral(bool enabled) { g_deferral.store(enabled); }
+
+bool postprocess_deferral_enabled() { return g_deferral.load(); }
+
+} // namespace recmeet
@@ -0,0 +1,80 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Memory governor (postprocessing)
+// ---------------------------------------------------------------------------
+//
+// The postprocessing child runs under a hard ceiling: RECMEET_RSS_LIMIT_MB,
+// which its heartbeat thread enforces by exiting, and the unit's MemoryMax=.
+// run_postprocessing() samples the process against that ceiling before each
+// step that grows it, and sheds work as the ceiling nears instead of dying
+// at it:
+//
+//   Tight     no diarization alongside transcription; diarization and
+//             speaker identification get half the threads; diarization
+//             chunk workers beyond the first retire between chunks
+//   Critical  as Tight, and a local summary that would not fit is deferred
+//             to a fresh process (PostprocessDeferred) when one is coming
+//
+// The level is the RSS as a share of read_memory_ceiling_bytes() or the
+// cgroup's PSI (memory.pressure), whichever is worse: time stalled on
+// reclaim means memory is short before the RSS shows it.
+
+enum class MemoryLevel { Normal = 0, Tight = 1, Critical = 2 };
+
+/// "normal", "tight" or "critical".
+const char* memory_level_name(MemoryLevel level);
+
+/// RSS share of the ceiling at which each level starts.
+constexpr double MEMORY_TIGHT_SHARE = 0.70;
+constexpr double MEMORY_CRITICAL_SHARE = 0.85;
+/// PSI avg10 (percent of the last 10 s stalled) at which each level starts:
+/// `some` task stalled for Tight, `full` (every task) for Critical.
+constexpr double MEMORY_TIGHT_SOME_AVG10 = 10.0;
+constexpr double MEMORY_CRITICAL_FULL_AVG10 = 5.0;
+
+/// The avg10 figures of a PSI memory.pressure file.
+struct MemoryPressure {
+    double some_avg10 = 0;
+    double full_avg10 = 0;
+};
+
+/// Parse a memory.pressure body ("some avg10=1.50 avg60=... total=...",
+/// then the "full" line). False when neither line is there.
+bool parse_memory_pressure(const std::string& text, MemoryPressure& out);
+
+/// One reading of this process against its ceiling.
+struct MemorySample {
+    uint64_t rss_bytes = 0;
+    uint64_t ceiling_bytes = 0;  ///< 0 = unknown: the level then follows PSI alone
+    MemoryPressure pressure;     ///< zero when PSI cannot be read
+};
+
+/// Read the RSS, read_memory_ceiling_bytes() and the PSI of this
+/// process's cgroup (the host's /proc/pressure/memory without one).
+MemorySample sample_memory();
+
+MemoryLevel classify_memory(const MemorySample& sample);
+
+/// Whether `extra_bytes` more keeps the RSS below the Critical share of the
+/// ceiling. True when the ceiling is unknown.
+bool memory_fits(const MemorySample& sample, uint64_t extra_bytes);
+
+/// `threads` for a step started at `level`: halved from Tight on, at least 1.
+int governed_threads(int threads, MemoryLevel level);
+
+/// Whether run_postprocessing() may throw PostprocessDeferred: set in a
+/// daemon child, whose daemon reruns a deferred job in a fresh process.
+/// Off by default, so a standalone run never defers.
+void set_postprocess_deferral(bool enabled);
+bool postprocess_deferral_enabled();
+
+} // namespace recmeet
@@ -0,0 +1,170 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "metrics.h"
+#include "util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace recmeet {
+
+namespace {
+
+std::atomic<std::size_t> g_next_shard{0};
+
+std::string format_value(double v) {
+    if (std::isinf(v)) return v > 0 ? "+Inf" : "-Inf";
+    char buf[40];
+    if (std::fabs(v) < 1e15 && v == std::floor(v))
+        std::snprintf(buf, sizeof(buf), "%.1f", v);
+    else
+        std::snprintf(buf, sizeof(buf), "%.15g", v);
+    return buf;
+}
+
+// `name{labels,extra}`, leaving out the braces when both are empty.
+std::string series(const std::string& name, const std::string& labels,
+                   const std::string& extra = "") {
+    std::string all = labels;
+    if (!extra.empty()) all += (all.empty() ? "" : ",") + extra;
+    return all.empty() ? name : name + "{" + all + "}";
+}
+
+} // anonymous namespace
+
+std::size_t metric_shard() {
+    thread_local const std::size_t shard =
+        g_next_shard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+    return shard;
+}
+
+uint64_t MetricCounter::value() const {
+    uint64_t total = 0;
+    for (const auto& s : slots_) total += s.v.load(std::memory_order_relaxed);
+    return total;
+}
+
+MetricHistogram::MetricHistogram(std::vector<double> bounds) : bounds_(std::move(bounds)) {
+    std::sort(bounds_.begin(), bounds_.end());
+    for (auto& s : shards_) {
+        s.counts = std::make_unique<std::atomic<uint64_t>[]>(bounds_.size() + 1);
+        for (std::size_t i = 0; i <= bounds_.size(); ++i) s.counts[i].store(0);
+    }
+}
+
+void MetricHistogram::observe(double v) {
+    Shard& s = shards_[metric_shard()];
+    const std::size_t i = static_cast<std::size_t>(
+        std::lower_bound(bounds_.begin(), bounds_.end(), v) - bounds_.begin());
+    s.counts[i].fetch_add(1, std::memory_order_relaxed);
+    // Only this shard's threads add here, so the exchange rarely retries.
+    double sum = s.sum.load(std::memory_order_relaxed);
+    while (!s.sum.compare_exchange_weak(sum, sum + v, std::memory_order_relaxed)) {}
+}
+
+MetricHistogram::Snapshot MetricHistogram::snapshot() const {
+    Snapshot snap;
+    snap.bounds = bounds_;
+    snap.cumulative.assign(bounds_.size() + 1, 0);
+    for (const auto& s : shards_) {
+        for (std::size_t i = 0; i <= bounds_.size(); ++i)
+            snap.cumulative[i] += s.counts[i].load(std::memory_order_relaxed);
+        snap.sum += s.sum.load(std::memory_order_relaxed);
+    }
+    for (std::size_t i = 1; i < snap.cumulative.size(); ++i)
+        snap.cumulative[i] += snap.cumulative[i - 1];
+    snap.count = snap.cumulative.back();
+    return snap;
+}
+
+std::string metric_label(const std::string& key, const std::string& value) {
+    std::string out = key + "=\"";
+    for (char c : value) {
+        if (c == '\\') out += "\\\\";
+        else if (c == '"') out += "\\\"";
+        else if (c == '\n') out += "\\n";
+        else out += c;
+    }
+    return out + "\"";
+}
+
+MetricsRegistry::Family& MetricsRegistry::family(const std::string& name, Type type,
+                                                 const std::string& help) {
+    auto it = families_.find(name);
+    if (it == families_.end())
+        it = families_.emplace(name, Family{type, help, {}, {}, {}, {}}).first;
+    else if (it->second.type != type)
+        throw RecmeetError("metric " + name + " is already registered with another type");
+    return it->second;
+}
+
+MetricCounter& MetricsRegistry::counter(const std::string& name, const std::string& help,
+                                        const std::string& labels) {
+    std::lock_guard lk(mu_);
+    auto& slot = family(name, Type::Counter, help).counters[labels];
+    if (!slot) slot = std::make_unique<MetricCounter>();
+    return *slot;
+}
+
+MetricGauge& MetricsRegistry::gauge(const std::string& name, const std::string& help,
+                                    const std::string& labels) {
+    std::lock_guard lk(mu_);
+    auto& slot = family(name, Type::Gauge, help).gauges[labels];
+    if (!slot) slot = std::make_unique<MetricGauge>();
+    return *slot;
+}
+
+MetricHistogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                            const std::vector<double>& bounds,
+                                            const std::string& labels) {
+    std::lock_guard lk(mu_);
+    Family& f = family(name, Type::Histogram, help);
+    if (f.histograms.empty() && f.bounds.empty()) f.bounds = bounds;
+    auto& slot = f.histograms[labels];
+    if (!slot) slot = std::make_unique<MetricHistogram>(f.bounds);
+    return *slot;
+}
+
+std::string MetricsRegistry::render() const {
+    std::lock_guard lk(mu_);
+    std::string out;
+    for (const auto& [name, f] : families_) {
+        static const char* const kTypes[] = {"counter", "gauge", "histogram"};
+        out += "# TYPE " + name + " " + kTypes[static_cast<int>(f.type)] + "\n";
+        if (!f.help.empty()) out += "# HELP " + name + " " + f.help + "\n";
+        for (const auto& [labels, c] : f.counters)
+            out += series(name + "_total", labels) + " " +
+                   std::to_string(c->value()) + "\n";
+        for (const auto& [labels, g] : f.gauges)
+            out += series(name, labels) + " " + std::to_string(g->value()) + "\n";
+        for (const auto& [labels, h] : f.histograms) {
+            const auto snap = h->snapshot();
+            for (std::size_t i = 0; i < snap.cumulative.size(); ++i) {
+                const double le = i < snap.bounds.size()
+                    ? snap.bounds[i] : std::numeric_limits<double>::infinity();
+                out += series(name + "_bucket", labels, metric_label("le", format_value(le))) +
+                       " " + std::to_string(snap.cumulative[i]) + "\n";
+            }
+            out += series(name + "_count", labels) + " " + std::to_string(snap.count) + "\n";
+            out += series(name + "_sum", labels) + " " + format_value(snap.sum) + "\n";
+        }
+    }
+    return out + "# EOF\n";
+}
+
+MetricsRegistry& metrics() {
+    // Never destroyed: threads may still count while the process exits.
+    static auto* registry = new MetricsRegistry;
+    return *registry;
+}
+
+const std::vector<double>& metric_duration_buckets() {
+    static const std::vector<double> bounds = {
+        0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60, 120, 300, 600, 1200, 1800, 3600};
+    return bounds;
+}
+
+} // namespace recmeet
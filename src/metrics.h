@@ -0,0 +1,136 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Process metrics (OpenMetrics)
+// ---------------------------------------------------------------------------
+//
+// Counters, gauges and histograms registered by name in metrics(), the
+// process-wide registry, and rendered in the OpenMetrics text format by
+// render(): the daemon's `metrics.get`, which recmeet-web serves at
+// /metrics for Prometheus.
+//
+// Updates never lock or allocate. A counter or histogram keeps one
+// cache-line-sized slot per shard and each thread updates the shard it was
+// given on first use, so threads counting into the same metric do not
+// bounce a cache line between them; a read sums the shards. Registration
+// takes the registry lock: look a metric up once and keep the reference.
+// Metrics live as long as the process.
+
+inline constexpr std::size_t METRIC_SHARDS = 16;
+
+/// The calling thread's shard, assigned round-robin on its first update.
+std::size_t metric_shard();
+
+class MetricCounter {
+public:
+    void add(uint64_t n = 1) {
+        slots_[metric_shard()].v.fetch_add(n, std::memory_order_relaxed);
+    }
+    uint64_t value() const;
+
+private:
+    struct alignas(64) Slot { std::atomic<uint64_t> v{0}; };
+    std::array<Slot, METRIC_SHARDS> slots_;
+};
+
+/// A value set rather than counted (queue depth, connected clients).
+class MetricGauge {
+public:
+    void set(int64_t v) { v_.store(v, std::memory_order_relaxed); }
+    void add(int64_t n) { v_.fetch_add(n, std::memory_order_relaxed); }
+    int64_t value() const { return v_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> v_{0};
+};
+
+/// Counts observations at or below each upper bound, plus their sum.
+class MetricHistogram {
+public:
+    /// `bounds` ascending; an implicit +Inf bucket follows the last.
+    explicit MetricHistogram(std::vector<double> bounds);
+
+    void observe(double v);
+
+    struct Snapshot {
+        std::vector<double> bounds;
+        std::vector<uint64_t> cumulative;  ///< per bound, then +Inf (== count)
+        uint64_t count = 0;
+        double sum = 0;
+    };
+    Snapshot snapshot() const;
+
+    const std::vector<double>& bounds() const { return bounds_; }
+
+private:
+    struct alignas(64) Shard {
+        std::unique_ptr<std::atomic<uint64_t>[]> counts;  // bounds + 1
+        std::atomic<double> sum{0};
+    };
+    std::vector<double> bounds_;
+    std::array<Shard, METRIC_SHARDS> shards_;
+};
+
+/// Label set text for a series: `key="value"` with the value escaped.
+/// Join several with ','.
+std::string metric_label(const std::string& key, const std::string& value);
+
+/// Content-Type of render()'s output.
+inline constexpr const char* OPENMETRICS_CONTENT_TYPE =
+    "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+class MetricsRegistry {
+public:
+    /// Series of family `name` with `labels` (metric_label()), created on
+    /// first use. Counter names omit `_total`; render() adds it. Throws
+    /// RecmeetError when `name` is already a family of another type.
+    MetricCounter& counter(const std::string& name, const std::string& help,
+                           const std::string& labels = "");
+    MetricGauge& gauge(const std::string& name, const std::string& help,
+                       const std::string& labels = "");
+    /// Every series of a family uses the bounds it was first registered with.
+    MetricHistogram& histogram(const std::string& name, const std::string& help,
+                               const std::vector<double>& bounds,
+                               const std::string& labels = "");
+
+    /// Every family, in name order, ending with "# EOF".
+    std::string render() const;
+
+private:
+    enum class Type { Counter, Gauge, Histogram };
+    struct Family {
+        Type type;
+        std::string help;
+        std::vector<double> bounds;
+        std::map<std::string, std::unique_ptr<MetricCounter>> counters;
+        std::map<std::string, std::unique_ptr<MetricGauge>> gauges;
+        std::map<std::string, std::unique_ptr<MetricHistogram>> histograms;
+    };
+    Family& family(const std::string& name, Type type, const std::string& help);
+
+    mutable std::mutex mu_;
+    std::map<std::string, Family> families_;
+};
+
+/// The process-wide registry.
+MetricsRegistry& metrics();
+
+/// Bucket bounds for durations in seconds, 0.05 s to 1 h.
+const std::vector<double>& metric_duration_buckets();
+
+} // namespace recmeet
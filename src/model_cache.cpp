@@ -0,0 +1,71 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "model_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace recmeet {
+
+namespace {
+std::atomic<bool> g_model_cache_enabled{false};
+
+// Every live ModelSlot. Leaked so a slot destroyed during static teardown
+// never outlives it.
+struct SlotRegistry {
+    std::mutex mu;
+    std::vector<detail::ModelSlotBase*> slots;
+};
+
+SlotRegistry& slot_registry() {
+    static auto* registry = new SlotRegistry;
+    return *registry;
+}
+} // anonymous namespace
+
+namespace detail {
+
+ModelSlotBase::ModelSlotBase(const char* kind) : kind_(kind) {
+    auto& r = slot_registry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    r.slots.push_back(this);
+}
+
+ModelSlotBase::~ModelSlotBase() {
+    auto& r = slot_registry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    r.slots.erase(std::remove(r.slots.begin(), r.slots.end(), this), r.slots.end());
+}
+
+} // namespace detail
+
+size_t release_resident_models() {
+    auto& r = slot_registry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    size_t released = 0;
+    for (auto* slot : r.slots)
+        if (slot->release()) ++released;
+    return released;
+}
+
+size_t release_resident_models(const std::string& kind) {
+    auto& r = slot_registry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    size_t released = 0;
+    for (auto* slot : r.slots)
+        if (kind == slot->kind() && slot->release()) ++released;
+    return released;
+}
+
+void set_model_cache_enabled(bool enabled) {
+    g_model_cache_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool model_cache_enabled() {
+    return g_model_cache_enabled.load(std::memory_order_relaxed);
+}
+
+} // namespace recmeet
@@ -0,0 +1,110 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace recmeet {
+
+// Keep loaded models resident between postprocessing jobs. Off by default:
+// every load returns a fresh model that is freed when its last user lets go,
+// which is what one-shot processes want. The daemon's warm worker
+// (`recmeet --pp-worker`) turns it on once at startup so the whisper,
+// llama and sherpa models survive from one meeting to the next; the daemon
+// recycles the worker to bound what that costs (see Config::pp_worker_jobs).
+void set_model_cache_enabled(bool enabled);
+bool model_cache_enabled();
+
+/// Drop the model every ModelSlot holds, now rather than at each slot's
+/// next get(). A model still in use stays alive until its caller lets go.
+/// Returns how many slots held one. For a long-running process that keeps
+/// models resident and needs the memory back between jobs.
+size_t release_resident_models();
+
+/// The same for the slots of one engine kind only ("whisper", "sherpa",
+/// "llama"; see ModelSlot's constructor), leaving the others resident.
+size_t release_resident_models(const std::string& kind);
+
+namespace detail {
+// Registers each ModelSlot for release_resident_models().
+class ModelSlotBase {
+public:
+    ModelSlotBase(const ModelSlotBase&) = delete;
+    ModelSlotBase& operator=(const ModelSlotBase&) = delete;
+    /// Drop the cached model; true when there was one.
+    virtual bool release() = 0;
+
+    const char* kind() const { return kind_; }
+
+protected:
+    explicit ModelSlotBase(const char* kind);
+    virtual ~ModelSlotBase();
+
+private:
+    const char* kind_;  // a literal
+};
+} // namespace detail
+
+/// Holds the most recently loaded model of one kind. get() returns the
+/// cached model while `key` (model path plus any load-time parameters)
+/// matches and the cache is enabled; otherwise it frees the old model
+/// first, then calls `load()`, which returns a std::unique_ptr<T> or throws.
+/// With the cache disabled nothing new is kept, and a model left from
+/// while it was enabled is dropped. A failed load leaves the slot empty.
+/// Holding the returned pointer keeps the model alive across a concurrent
+/// replacement.
+///
+/// One slot per call site, as a function-local or file-scope static.
+/// `kind` names the engine it holds, for release_resident_models(kind).
+template <typename T>
+class ModelSlot : public detail::ModelSlotBase {
+public:
+    explicit ModelSlot(const char* kind = "") : ModelSlotBase(kind) {}
+
+    template <typename Load>
+    std::shared_ptr<T> get(const std::string& key, Load&& load) {
+        if (!model_cache_enabled()) {
+            clear();
+            return std::shared_ptr<T>(load());
+        }
+        std::lock_guard<std::mutex> lk(mu_);
+        if (model_ && key_ == key) {
+            ++hits_;
+            return model_;
+        }
+        model_.reset();
+        key_.clear();
+        model_ = std::shared_ptr<T>(load());
+        key_ = key;
+        return model_;
+    }
+
+    /// Drop the cached model (it stays alive while a caller still holds it).
+    void clear() { release(); }
+
+    bool release() override {
+        std::lock_guard<std::mutex> lk(mu_);
+        const bool held = model_ != nullptr;
+        model_.reset();
+        key_.clear();
+        return held;
+    }
+
+    /// get() calls served from the cache.
+    size_t hits() const {
+        std::lock_guard<std::mutex> lk(mu_);
+        return hits_;
+    }
+
+private:
+    mutable std::mutex mu_;
+    std::string key_;
+    std::shared_ptr<T> model_;
+    size_t hits_ = 0;
+};
+
+} // namespace recmeet
@@ -4,10 +4,23 @@
 #include "model_manager.h"
 #include "http_client.h"
 #include "log.h"
-
+#include "metrics.h"
+#include "sha256.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <pthread.h>
 
 namespace recmeet {
 
@@ -18,89 +31,408 @@ struct ModelInfo {
     std::string filename;
 };
 
-// Whisper GGUF models hosted on Hugging Face
+// Whisper GGUF models hosted on Hugging Face: the f16 originals under the
+// size's name, and the quantized variants whisper.cpp publishes beside
+// them as <size>-<type>.
 const std::map<std::string, ModelInfo> WHISPER_MODELS = {
-    {"tiny",     {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-tiny.bin",     "ggml-tiny.bin"}},
-    {"base",     {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-base.bin",     "ggml-base.bin"}},
-    {"small",    {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-small.bin",    "ggml-small.bin"}},
-    {"medium",   {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-medium.bin",   "ggml-medium.bin"}},
-    {"large-v3", {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-large-v3.bin", "ggml-large-v3.bin"}},
+    {"tiny",           {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-tiny.bin",           "ggml-tiny.bin"}},
+    {"tiny-q5_1",      {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-tiny-q5_1.bin",      "ggml-tiny-q5_1.bin"}},
+    {"tiny-q8_0",      {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-tiny-q8_0.bin",      "ggml-tiny-q8_0.bin"}},
+    {"base",           {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-base.bin",           "ggml-base.bin"}},
+    {"base-q5_1",      {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-base-q5_1.bin",      "ggml-base-q5_1.bin"}},
+    {"base-q8_0",      {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-base-q8_0.bin",      "ggml-base-q8_0.bin"}},
+    {"small",          {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-small.bin",          "ggml-small.bin"}},
+    {"small-q5_1",     {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-small-q5_1.bin",     "ggml-small-q5_1.bin"}},
+    {"small-q8_0",     {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-small-q8_0.bin",     "ggml-small-q8_0.bin"}},
+    {"medium",         {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-medium.bin",         "ggml-medium.bin"}},
+    {"medium-q5_0",    {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-medium-q5_0.bin",    "ggml-medium-q5_0.bin"}},
+    {"medium-q8_0",    {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-medium-q8_0.bin",    "ggml-medium-q8_0.bin"}},
+    {"large-v3",       {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-large-v3.bin",       "ggml-large-v3.bin"}},
+    {"large-v3-q5_0",  {"https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-large-v3-q5_0.bin",  "ggml-large-v3-q5_0.bin"}},
 };
 
-void download_file(const std::string& url, const fs::path& dest) {
-    log_info("Downloading %s ...", url.c_str());
+const ModelInfo& whisper_model_info(const std::string& model_name) {
+    auto it = WHISPER_MODELS.find(model_name);
+    if (it == WHISPER_MODELS.end()) {
+        std::string names;
+        for (const auto& name : whisper_model_names()) names += (names.empty() ? "" : ", ") + name;
+        throw RecmeetError("Unknown whisper model: " + model_name + ". Available: " + names);
+    }
+    return it->second;
+}
+
+// Throughput is rate(bytes) over rate(seconds_sum).
+void count_download(bool ok, size_t bytes, double seconds) {
+    static MetricCounter& ok_total = metrics().counter(
+        "recmeet_model_downloads", "Model downloads, by outcome.", metric_label("outcome", "ok"));
+    static MetricCounter& failed_total = metrics().counter(
+        "recmeet_model_downloads", "Model downloads, by outcome.",
+        metric_label("outcome", "failed"));
+    static MetricCounter& bytes_total = metrics().counter(
+        "recmeet_model_download_bytes", "Bytes of models downloaded.");
+    static MetricHistogram& duration = metrics().histogram(
+        "recmeet_model_download_seconds", "Time each model download took.",
+        metric_duration_buckets());
+    (ok ? ok_total : failed_total).add();
+    bytes_total.add(bytes);
+    duration.observe(seconds);
+}
 
-    // Use libcurl to download with progress
-    auto data = http_get(url);
+thread_local ModelDownloadProgress t_download_progress;
 
-    std::ofstream out(dest, std::ios::binary);
-    if (!out)
-        throw RecmeetError("Cannot write to: " + dest.string());
-    out.write(data.data(), data.size());
-    out.close();
+// fetch_model_file(), also handing the body to `on_data` as it arrives.
+void fetch_verified(const std::string& url, const fs::path& dest,
+                    const std::string& expected_sha256, const DownloadDataFn& on_data);
 
-    log_info("Downloaded: %s (%.1f MB)", dest.filename().c_str(),
-            data.size() / (1024.0 * 1024.0));
+void download_file(const std::string& url, const fs::path& dest) {
+    fetch_model_file(url, dest);
 }
 
-void download_and_extract_tarball(const std::string& url, const fs::path& dest_dir) {
-    fs::path tarball = dest_dir / "download.tar.bz2";
-    download_file(url, tarball);
+// Feeds a downloading tarball to `tar xjf -`, so unpacking overlaps the
+// transfer instead of following it. On a resume it first replays the bytes
+// an earlier run left in the .part file; bytes a restarted transfer sends
+// again are skipped. If tar gives up, the rest of the download still
+// finishes and finish() returns false.
+class TarExtract {
+public:
+    TarExtract(const fs::path& into, fs::path part) : part_(std::move(part)) {
+        // A tar that exits early must not kill us with SIGPIPE; the write
+        // just fails. Blocked on this thread only, until finish().
+        sigemptyset(&sigpipe_);
+        sigaddset(&sigpipe_, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &sigpipe_, &old_mask_);
+        const std::string cmd = "tar xjf - -C " + shell_quote(into.string()) + " 2>/dev/null";
+        pipe_ = ::popen(cmd.c_str(), "w");
+        if (!pipe_) {
+            pthread_sigmask(SIG_SETMASK, &old_mask_, nullptr);
+            throw RecmeetError(std::string("Cannot run tar: ") + std::strerror(errno));
+        }
+    }
+    ~TarExtract() { finish(); }
+    TarExtract(const TarExtract&) = delete;
+    TarExtract& operator=(const TarExtract&) = delete;
+
+    void feed(uint64_t offset, const char* data, size_t n) {
+        if (failed_) return;
+        if (offset > fed_ && !replay(offset)) return;
+        if (offset + n <= fed_) return;
+        const size_t skip = static_cast<size_t>(fed_ - offset);
+        write(data + skip, n - skip);
+    }
 
+    /// Close tar's input and wait for it; true when it unpacked everything.
+    bool finish() {
+        if (!pipe_) return ok_;
+        const int status = ::pclose(pipe_);
+        pipe_ = nullptr;
+        const timespec none{0, 0};
+        while (sigtimedwait(&sigpipe_, nullptr, &none) == SIGPIPE) {}
+        pthread_sigmask(SIG_SETMASK, &old_mask_, nullptr);
+        ok_ = !failed_ && status == 0;
+        return ok_;
+    }
+
+private:
+    bool replay(uint64_t upto) {
+        std::ifstream in(part_, std::ios::binary);
+        in.seekg(static_cast<std::streamoff>(fed_));
+        std::vector<char> buf(1 << 16);
+        while (!failed_ && fed_ < upto) {
+            const auto want = static_cast<std::streamsize>(
+                std::min<uint64_t>(buf.size(), upto - fed_));
+            if (!in.read(buf.data(), want)) failed_ = true;
+            else write(buf.data(), static_cast<size_t>(want));
+        }
+        return !failed_;
+    }
+
+    void write(const char* data, size_t n) {
+        if (std::fwrite(data, 1, n, pipe_) != n) failed_ = true;
+        else fed_ += n;
+    }
+
+    fs::path part_;
+    std::FILE* pipe_ = nullptr;
+    sigset_t sigpipe_;
+    sigset_t old_mask_;
+    uint64_t fed_ = 0;
+    bool failed_ = false;
+    bool ok_ = false;
+};
+
+// Unpacks into dest_dir/.extract while downloading, then moves the files
+// into dest_dir, out of the archive's single top-level directory when it
+// has one. A streamed unpack that fails is retried from the downloaded
+// file before giving up.
+void download_and_extract_tarball(const std::string& url, const fs::path& dest_dir) {
     fs::create_directories(dest_dir);
-    std::string cmd = "tar xjf " + tarball.string() +
-                      " -C " + dest_dir.string() +
-                      " --strip-components=1 2>/dev/null";
-    int ret = std::system(cmd.c_str());
-    if (ret != 0) {
-        // Try without --strip-components (for single-file downloads)
-        cmd = "tar xjf " + tarball.string() +
-              " -C " + dest_dir.string() + " 2>/dev/null";
-        std::system(cmd.c_str());
+    const fs::path tarball = dest_dir / "download.tar.bz2";
+    const fs::path staging = dest_dir / ".extract";
+    fs::path part = tarball;
+    part += ".part";
+    std::error_code ec;
+    fs::remove_all(staging, ec);
+    fs::create_directories(staging);
+
+    bool streamed = false;
+    {
+        TarExtract tar(staging, part);
+        try {
+            fetch_verified(url, tarball, "", [&tar](uint64_t offset, const char* data, size_t n) {
+                tar.feed(offset, data, n);
+            });
+        } catch (...) {
+            tar.finish();
+            fs::remove_all(staging, ec);
+            throw;
+        }
+        streamed = tar.finish();
+    }
+    if (!streamed) {
+        log_warn("Unpacking %s while downloading failed; unpacking the download",
+                 tarball.filename().c_str());
+        fs::remove_all(staging, ec);
+        fs::create_directories(staging);
+        const std::string cmd = "tar xjf " + shell_quote(tarball.string()) + " -C " +
+                                shell_quote(staging.string()) + " 2>/dev/null";
+        if (std::system(cmd.c_str()) != 0) {
+            fs::remove_all(staging, ec);
+            fs::remove(tarball, ec);
+            throw RecmeetError("Cannot unpack " + url);
+        }
     }
 
-    fs::remove(tarball);
+    fs::path top = staging;
+    std::vector<fs::path> entries;
+    for (const auto& entry : fs::directory_iterator(staging)) entries.push_back(entry.path());
+    if (entries.size() == 1 && fs::is_directory(entries[0])) top = entries[0];
+    for (const auto& entry : fs::directory_iterator(top)) {
+        const fs::path target = dest_dir / entry.path().filename();
+        fs::remove_all(target, ec);
+        fs::rename(entry.path(), target, ec);
+        if (ec) {
+            fs::remove_all(staging, ec);
+            throw RecmeetError("Cannot move " + entry.path().string() + " into place: " +
+                               ec.message());
+        }
+    }
+    fs::remove_all(staging, ec);
+    fs::remove(tarball, ec);
+}
+
+// Joins fetch_models_parallel() failures into one error.
+void throw_if_failed(const std::map<std::string, std::string>& failed) {
+    if (failed.empty()) return;
+    std::string what;
+    for (const auto& [label, error] : failed) {
+        if (!what.empty()) what += "; ";
+        what += label + ": " + error;
+    }
+    throw RecmeetError(what);
 }
 
 } // anonymous namespace
 
+std::map<std::string, std::string> parse_sha256sums(const std::string& text) {
+    std::map<std::string, std::string> sums;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.size() < 66 || line[64] != ' ') continue;
+        std::string hex = line.substr(0, 64);
+        bool ok = true;
+        for (auto& c : hex) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            if (!std::isxdigit(static_cast<unsigned char>(c))) ok = false;
+        }
+        size_t name_at = 65;
+        if (line[name_at] == ' ' || line[name_at] == '*') ++name_at;
+        if (ok && name_at < line.size()) sums[line.substr(name_at)] = hex;
+    }
+    return sums;
+}
+
+ScopedDownloadProgress::ScopedDownloadProgress(ModelDownloadProgress cb)
+    : prev_(std::move(t_download_progress)) {
+    t_download_progress = std::move(cb);
+}
+
+ScopedDownloadProgress::~ScopedDownloadProgress() {
+    t_download_progress = std::move(prev_);
+}
+
+void fetch_model_file(const std::string& url, const fs::path& dest,
+                      const std::string& expected_sha256) {
+    fetch_verified(url, dest, expected_sha256, nullptr);
+}
+
+std::map<std::string, std::string> fetch_models_parallel(const std::vector<ModelFetch>& fetches,
+                                                         size_t max_parallel,
+                                                         const ModelFetchDone& on_done) {
+    std::map<std::string, std::string> failed;
+    std::mutex mu;
+    size_t next = 0;
+    const ModelDownloadProgress progress = t_download_progress;
+    auto worker = [&] {
+        const ScopedDownloadProgress scoped(progress);
+        for (;;) {
+            size_t i;
+            {
+                std::lock_guard<std::mutex> lk(mu);
+                if (next == fetches.size()) return;
+                i = next++;
+            }
+            std::string error;
+            try {
+                fetches[i].fetch();
+            } catch (const std::exception& e) {
+                error = *e.what() ? e.what() : "failed";
+            } catch (...) {
+                error = "failed";
+            }
+            std::lock_guard<std::mutex> lk(mu);
+            if (!error.empty()) failed[fetches[i].label] = error;
+            if (on_done) on_done(fetches[i].label, error);
+        }
+    };
+
+    const size_t threads = std::min(std::max<size_t>(max_parallel, 1), fetches.size());
+    std::vector<std::thread> helpers;
+    for (size_t t = 1; t < threads; ++t) helpers.emplace_back(worker);
+    worker();
+    for (auto& t : helpers) t.join();
+    return failed;
+}
+
+namespace {
+
+void fetch_verified(const std::string& url, const fs::path& dest,
+                    const std::string& expected_sha256, const DownloadDataFn& on_data) {
+    const std::string name = url.substr(url.find_last_of('/') + 1);
+    std::string pinned = expected_sha256;
+    if (pinned.empty()) {
+        std::ifstream sums_file(models_dir() / MODEL_SHA256SUMS);
+        if (sums_file) {
+            std::stringstream text;
+            text << sums_file.rdbuf();
+            const auto sums = parse_sha256sums(text.str());
+            if (auto it = sums.find(name); it != sums.end()) pinned = it->second;
+        }
+    }
+
+    fs::path part = dest;
+    part += ".part";
+    std::error_code ec;
+    const uint64_t resumed = fs::exists(part, ec) ? fs::file_size(part, ec) : 0;
+    if (resumed > 0)
+        log_info("Resuming %s from %.1f MB ...", url.c_str(), resumed / (1024.0 * 1024.0));
+    else
+        log_info("Downloading %s ...", url.c_str());
+
+    const auto started = std::chrono::steady_clock::now();
+    auto elapsed = [&started] {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    };
+    DownloadProgressFn progress;
+    if (t_download_progress) {
+        progress = [name, last = -1, last_bytes = uint64_t(0)](uint64_t done,
+                                                               uint64_t total) mutable {
+            // Once per percent, or per 8 MiB while the size is unknown.
+            const int pct = total > 0 ? static_cast<int>(done * 100 / total) : -1;
+            if (total > 0 ? pct == last : done - last_bytes < (8u << 20)) return;
+            last = pct;
+            last_bytes = done;
+            t_download_progress(name, done, total);
+        };
+    }
+    DownloadResult got;
+    try {
+        got = http_download(url, part.string(), progress, on_data);
+    } catch (...) {
+        count_download(false, 0, elapsed());
+        throw;
+    }
+
+    const std::string& expected = pinned.empty() ? got.linked_sha256 : pinned;
+    const std::string actual = sha256_file(part);
+    if (!expected.empty() && actual != expected) {
+        fs::remove(part, ec);
+        count_download(false, got.fetched, elapsed());
+        throw RecmeetError("Checksum mismatch for " + name + ": expected " + expected +
+                           ", got " + actual + " (download discarded)");
+    }
+    if (expected.empty())
+        log_info("%s: SHA-256 %s (no pin in %s to check against)", name.c_str(),
+                 actual.c_str(), MODEL_SHA256SUMS);
+
+    fs::rename(part, dest, ec);
+    if (ec) {
+        count_download(false, got.fetched, elapsed());
+        throw RecmeetError("Cannot move " + part.string() + " into place: " + ec.message());
+    }
+    count_download(true, got.fetched, elapsed());
+    log_info("Downloaded: %s (%.1f MB, SHA-256 %s)", dest.filename().c_str(),
+             got.bytes / (1024.0 * 1024.0), expected.empty() ? "unchecked" : "verified");
+}
+
+} // anonymous namespace
+
+std::vector<std::string> whisper_model_names() {
+    // Size order, each size's f16 original before its variants.
+    std::vector<std::string> names;
+    for (const char* size : {"tiny", "base", "small", "medium", "large-v3"})
+        for (const auto& name : whisper_model_variants(size)) names.push_back(name);
+    return names;
+}
+
+std::string whisper_model_size(const std::string& model_name) {
+    const auto dash = model_name.rfind('-');
+    if (dash != std::string::npos && model_name.compare(dash + 1, 1, "q") == 0)
+        return model_name.substr(0, dash);
+    return model_name;
+}
+
+std::string whisper_model_variant(const std::string& model_name) {
+    const std::string size = whisper_model_size(model_name);
+    return size.size() == model_name.size() ? "f16" : model_name.substr(size.size() + 1);
+}
+
+std::vector<std::string> whisper_model_variants(const std::string& size) {
+    std::vector<std::string> out;
+    if (WHISPER_MODELS.count(size)) out.push_back(size);
+    for (const auto& [name, info] : WHISPER_MODELS)
+        if (name != size && whisper_model_size(name) == size) out.push_back(name);
+    return out;
+}
+
 bool is_whisper_model_cached(const std::string& model_name) {
-    auto it = WHISPER_MODELS.find(model_name);
-    if (it == WHISPER_MODELS.end())
-        throw RecmeetError("Unknown whisper model: " + model_name +
-                           ". Available: tiny, base, small, medium, large-v3");
-    fs::path model_path = models_dir() / "whisper" / it->second.filename;
+    fs::path model_path = models_dir() / "whisper" / whisper_model_info(model_name).filename;
     return fs::exists(model_path) && fs::file_size(model_path) > 0;
 }
 
 fs::path ensure_whisper_model(const std::string& model_name) {
-    auto it = WHISPER_MODELS.find(model_name);
-    if (it == WHISPER_MODELS.end())
-        throw RecmeetError("Unknown whisper model: " + model_name +
-                           ". Available: tiny, base, small, medium, large-v3");
+    const ModelInfo& info = whisper_model_info(model_name);
 
     fs::path model_dir = models_dir() / "whisper";
     fs::create_directories(model_dir);
 
-    fs::path model_path = model_dir / it->second.filename;
+    fs::path model_path = model_dir / info.filename;
     if (fs::exists(model_path) && fs::file_size(model_path) > 0)
         return model_path;
 
-    download_file(it->second.url, model_path);
+    download_file(info.url, model_path);
     return model_path;
 }
 
 fs::path download_whisper_model(const std::string& model_name) {
-    auto it = WHISPER_MODELS.find(model_name);
-    if (it == WHISPER_MODELS.end())
-        throw RecmeetError("Unknown whisper model: " + model_name +
-                           ". Available: tiny, base, small, medium, large-v3");
+    const ModelInfo& info = whisper_model_info(model_name);
 
     fs::path model_dir = models_dir() / "whisper";
     fs::create_directories(model_dir);
 
-    fs::path model_path = model_dir / it->second.filename;
-    download_file(it->second.url, model_path);
+    fs::path model_path = model_dir / info.filename;
+    download_file(info.url, model_path);
     return model_path;
 }
 
@@ -156,40 +488,41 @@ bool is_sherpa_model_cached() {
            fs::exists(emb) && fs::file_size(emb) > 0;
 }
 
-SherpaModelPaths ensure_sherpa_models() {
+namespace {
+
+// The segmentation tarball and the embedding model download side by side.
+SherpaModelPaths fetch_sherpa_models(bool force) {
     auto seg = sherpa_seg_path();
     auto emb = sherpa_emb_path();
 
-    if (!fs::exists(seg) || fs::file_size(seg) == 0) {
-        fs::path seg_dir = seg.parent_path();
-        fs::create_directories(seg_dir);
-        download_and_extract_tarball(SHERPA_SEGMENTATION_URL, seg_dir);
-        if (!fs::exists(seg))
-            throw RecmeetError("Segmentation model not found after extraction: " + seg.string());
+    std::vector<ModelFetch> fetches;
+    if (force || !fs::exists(seg) || fs::file_size(seg) == 0) {
+        fetches.push_back({"segmentation", [&seg] {
+            fs::create_directories(seg.parent_path());
+            download_and_extract_tarball(SHERPA_SEGMENTATION_URL, seg.parent_path());
+            if (!fs::exists(seg))
+                throw RecmeetError("Segmentation model not found after extraction: " +
+                                   seg.string());
+        }});
     }
-
-    if (!fs::exists(emb) || fs::file_size(emb) == 0) {
-        fs::path emb_dir = emb.parent_path();
-        fs::create_directories(emb_dir);
-        download_file(SHERPA_EMBEDDING_URL, emb);
+    if (force || !fs::exists(emb) || fs::file_size(emb) == 0) {
+        fetches.push_back({"embedding", [&emb] {
+            fs::create_directories(emb.parent_path());
+            download_file(SHERPA_EMBEDDING_URL, emb);
+        }});
     }
-
+    throw_if_failed(fetch_models_parallel(fetches));
     return {seg, emb};
 }
 
-SherpaModelPaths download_sherpa_models() {
-    auto seg = sherpa_seg_path();
-    auto emb = sherpa_emb_path();
-
-    fs::create_directories(seg.parent_path());
-    fs::create_directories(emb.parent_path());
+} // anonymous namespace
 
-    download_and_extract_tarball(SHERPA_SEGMENTATION_URL, seg.parent_path());
-    if (!fs::exists(seg))
-        throw RecmeetError("Segmentation model not found after extraction: " + seg.string());
+SherpaModelPaths ensure_sherpa_models() {
+    return fetch_sherpa_models(false);
+}
 
-    download_file(SHERPA_EMBEDDING_URL, emb);
-    return {seg, emb};
+SherpaModelPaths download_sherpa_models() {
+    return fetch_sherpa_models(true);
 }
 
 // --- VAD (Silero) ---
@@ -254,6 +587,11 @@ fs::path download_vad_model() {
 //   * en-small      — 20 M-param fast Zipformer, low-end-host fallback.
 //                     Same dual-precision packaging; ~128 MB download.
 //
+// Each has an `-int8` variant that loads the quantized weights from the
+// same tarball and directory: one download serves both precisions. The
+// plain names load fp32; the caption engine falls back to the int8 weights
+// when fp32 decoding cannot keep up (Config::caption_int8_fallback).
+//
 // `is_caption_model_cached()` is deliberately resilient: model-zoo entries
 // don't all use the same `encoder-epoch-99-avg-1.onnx` filename, so we
 // prefix-match on `encoder/decoder/joiner` and accept any `*.onnx`
@@ -265,8 +603,11 @@ namespace {
 struct CaptionModelInfo {
     std::string url;        // tarball URL (sherpa-onnx asr-models GH release)
     std::string size_hint;  // human-readable download size for the prompt
+    std::string base;       // int8 variant: the model whose files it shares
 };
 
+constexpr const char* kInt8Suffix = "-int8";
+
 const std::map<std::string, CaptionModelInfo>& caption_models_table() {
     static const std::map<std::string, CaptionModelInfo> models = {
         {"en-2023-06-26",
@@ -278,7 +619,13 @@ const std::map<std::string, CaptionModelInfo>& caption_models_table() {
              "asr-models/sherpa-onnx-streaming-zipformer-en-20M-2023-02-17.tar.bz2",
              "~128 MB"}},
     };
-    return models;
+    static const std::map<std::string, CaptionModelInfo> with_variants = [] {
+        std::map<std::string, CaptionModelInfo> all = models;
+        for (const auto& [name, info] : models)
+            all[name + kInt8Suffix] = {info.url, info.size_hint, name};
+        return all;
+    }();
+    return with_variants;
 }
 
 constexpr const char* DEFAULT_CAPTION_MODEL = "en-2023-06-26";
@@ -287,6 +634,18 @@ std::string resolve_caption_model_name(const std::string& name) {
     return name.empty() ? std::string(DEFAULT_CAPTION_MODEL) : name;
 }
 
+// The model whose directory `canonical` loads from: itself, or an int8
+// variant's base.
+std::string caption_model_files_name(const std::string& canonical) {
+    const auto& table = caption_models_table();
+    auto it = table.find(canonical);
+    return it == table.end() || it->second.base.empty() ? canonical : it->second.base;
+}
+
+bool is_int8_onnx(const std::string& filename) {
+    return filename.find(".int8.") != std::string::npos;
+}
+
 } // anonymous namespace
 
 std::vector<std::string> known_caption_models() {
@@ -305,11 +664,26 @@ std::string caption_model_size_hint(const std::string& name) {
 }
 
 fs::path caption_model_dir(const std::string& name) {
-    return models_dir() / "sherpa" / "online" / resolve_caption_model_name(name);
+    return models_dir() / "sherpa" / "online" /
+           caption_model_files_name(resolve_caption_model_name(name));
+}
+
+bool caption_model_is_int8(const std::string& name) {
+    const auto& table = caption_models_table();
+    auto it = table.find(resolve_caption_model_name(name));
+    return it != table.end() && !it->second.base.empty();
+}
+
+std::string caption_model_int8_variant(const std::string& name) {
+    const std::string canonical = resolve_caption_model_name(name);
+    if (caption_model_is_int8(canonical)) return canonical;
+    const std::string variant = canonical + kInt8Suffix;
+    return caption_models_table().count(variant) ? variant : std::string{};
 }
 
 bool is_caption_model_cached(const std::string& name) {
     fs::path dir = caption_model_dir(name);
+    const bool int8 = caption_model_is_int8(name);
     std::error_code ec;
     if (!fs::is_directory(dir, ec)) return false;
 
@@ -320,7 +694,8 @@ bool is_caption_model_cached(const std::string& name) {
         if (fs::file_size(e.path()) == 0) continue;
         std::string n = e.path().filename().string();
         bool is_onnx = n.size() >= 5 &&
-                       n.compare(n.size() - 5, 5, ".onnx") == 0;
+                       n.compare(n.size() - 5, 5, ".onnx") == 0 &&
+                       (!int8 || is_int8_onnx(n));
         if (is_onnx && n.compare(0, 7, "encoder") == 0) has_enc = true;
         if (is_onnx && n.compare(0, 7, "decoder") == 0) has_dec = true;
         if (is_onnx && n.compare(0, 6, "joiner")  == 0) has_join = true;
@@ -388,11 +763,12 @@ fs::path ensure_caption_model(const std::string& /*name*/) {
 std::vector<ModelStatus> list_cached_models() {
     std::vector<ModelStatus> result;
 
-    for (const auto& [name, info] : WHISPER_MODELS) {
+    for (const auto& name : whisper_model_names()) {
         ModelStatus s;
         s.name = name;
         s.category = "whisper";
-        s.path = (models_dir() / "whisper" / info.filename).string();
+        s.variant = whisper_model_variant(name);
+        s.path = (models_dir() / "whisper" / WHISPER_MODELS.at(name).filename).string();
         if (fs::exists(s.path) && fs::file_size(s.path) > 0) {
             s.cached = true;
             s.size_bytes = static_cast<int64_t>(fs::file_size(s.path));
@@ -6,6 +6,8 @@
 #include "util.h"
 
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -15,20 +17,114 @@ namespace recmeet {
 struct ModelStatus {
     std::string name;        // e.g. "base", "segmentation"
     std::string category;    // "whisper", "sherpa", "vad"
+    std::string variant;     // whisper weight type: "f16", "q5_0", "q5_1", "q8_0"
     bool cached = false;
     int64_t size_bytes = 0;  // file size if cached
     std::string path;        // full path
 };
 
+// ---------------------------------------------------------------------------
+// Downloads. Each file streams into `<dest>.part` and is renamed into place
+// once complete and verified, so a model path never holds a partial file.
+// An interrupted download, in this process or an earlier one, resumes from
+// its .part file. The SHA-256 is checked against the pin for the file's
+// published name in `<models_dir>/SHA256SUMS` (sha256sum format), or else
+// against the digest the server sends (Hugging Face LFS files); a mismatch
+// removes the .part file and throws. A tarball (the segmentation and
+// caption models) is unpacked by tar as it streams in, into a staging
+// directory whose files move into place once the checksum checks out.
+// ---------------------------------------------------------------------------
+
+/// Name of the pinned-digest manifest in models_dir().
+inline constexpr const char* MODEL_SHA256SUMS = "SHA256SUMS";
+
+/// Parse sha256sum output ("<hex>  <name>" per line, `*` binary marker
+/// allowed) into name -> lowercase digest. Lines that do not parse are
+/// skipped.
+std::map<std::string, std::string> parse_sha256sums(const std::string& text);
+
+/// Download progress: the file's published name, bytes so far and the full
+/// size (0 while unknown). Reported about once per percent.
+using ModelDownloadProgress =
+    std::function<void(const std::string& file, uint64_t done, uint64_t total)>;
+
+/// Reports the model downloads this thread makes while it is alive (the
+/// daemon's models.ensure worker broadcasts them), then restores the
+/// previous callback.
+class ScopedDownloadProgress {
+public:
+    explicit ScopedDownloadProgress(ModelDownloadProgress cb);
+    ~ScopedDownloadProgress();
+    ScopedDownloadProgress(const ScopedDownloadProgress&) = delete;
+    ScopedDownloadProgress& operator=(const ScopedDownloadProgress&) = delete;
+
+private:
+    ModelDownloadProgress prev_;
+};
+
+/// Download `url` to `dest` as described above. `expected_sha256` (hex)
+/// overrides the SHA256SUMS pin when not empty. Throws RecmeetError on a
+/// failed transfer (the .part file is kept for next time) or a checksum
+/// mismatch.
+void fetch_model_file(const std::string& url, const fs::path& dest,
+                      const std::string& expected_sha256 = "");
+
+/// One model to provision: a label for messages ("whisper/base") and the
+/// ensure_*() or download_*() call that fetches it.
+struct ModelFetch {
+    std::string label;
+    std::function<void()> fetch;
+};
+
+/// Threads fetch_models_parallel() runs by default. Downloads are bound by
+/// the network rather than the CPU, so a few at once keep the pipe full;
+/// the HTTP client's own limit (HTTP_MAX_IN_FLIGHT) caps the total.
+inline constexpr size_t MODEL_FETCH_PARALLEL = 4;
+
+/// Called as each fetch finishes, one call at a time, with an empty
+/// `error` on success.
+using ModelFetchDone = std::function<void(const std::string& label, const std::string& error)>;
+
+/// Run `fetches` on up to `max_parallel` threads, the caller's included,
+/// so first-run setup takes about as long as the largest model rather
+/// than the sum of them. The workers report through the caller's
+/// ScopedDownloadProgress. Every fetch runs whatever the others do;
+/// returns label -> error message for the ones that threw.
+std::map<std::string, std::string> fetch_models_parallel(
+    const std::vector<ModelFetch>& fetches, size_t max_parallel = MODEL_FETCH_PARALLEL,
+    const ModelFetchDone& on_done = nullptr);
+
 /// List all known models and their cache status.
 std::vector<ModelStatus> list_cached_models();
 
+// ---------------------------------------------------------------------------
+// Whisper models come in sizes (tiny, base, small, medium, large-v3), each
+// as the f16 original under the size's name and as quantized variants
+// named <size>-<type> ("medium-q5_0"). The variants download
+// pre-quantized from the same repository. On a CPU they take about a
+// third of the memory and decode faster, with little loss of accuracy;
+// `recmeet --autotune` times the cached ones against the original.
+// ---------------------------------------------------------------------------
+
+/// Every whisper model name: by size, each size's original first.
+std::vector<std::string> whisper_model_names();
+
+/// The size of a model name ("medium-q5_0" -> "medium").
+std::string whisper_model_size(const std::string& model_name);
+
+/// The weight type of a model name: "f16" for an original, else the
+/// quantization ("q5_0").
+std::string whisper_model_variant(const std::string& model_name);
+
+/// The model names of one size, the original first.
+std::vector<std::string> whisper_model_variants(const std::string& size);
+
 /// Check whether a whisper model is already cached locally.
 bool is_whisper_model_cached(const std::string& model_name);
 
 /// Ensure a whisper model is available locally, downloading if needed.
-/// Returns the path to the GGUF model file.
-/// Model names: tiny, base, small, medium, large-v3
+/// Returns the path to the GGUF model file. Throws RecmeetError for a name
+/// whisper_model_names() does not list.
 fs::path ensure_whisper_model(const std::string& model_name);
 
 /// Force (re-)download a whisper model even if already cached.
@@ -99,14 +195,22 @@ std::string caption_model_size_hint(const std::string& name);
 
 /// Resolve the on-disk directory for a streaming caption model. If `name`
 /// is empty, returns the directory for the default model
-/// (`en-2023-06-26`). Existence is NOT checked — see
-/// `is_caption_model_cached()` for that.
+/// (`en-2023-06-26`). An `-int8` variant shares its base model's directory.
+/// Existence is NOT checked — see `is_caption_model_cached()` for that.
 fs::path caption_model_dir(const std::string& name);
 
+/// True for the `-int8` variants, which load the quantized `*.int8.onnx`
+/// weights from their base model's download.
+bool caption_model_is_int8(const std::string& name);
+
+/// The int8 variant of `name` (itself when it is one), or empty when the
+/// registry has none.
+std::string caption_model_int8_variant(const std::string& name);
+
 /// Return true if the caption model directory contains the four required
-/// file shapes (encoder-*, decoder-*, joiner-*.onnx + tokens.txt). Empty
-/// `name` resolves to the default. Resilient to filename variation in the
-/// sherpa-onnx model zoo.
+/// file shapes (encoder-*, decoder-*, joiner-*.onnx + tokens.txt; the
+/// `*.int8.onnx` ones for an int8 variant). Empty `name` resolves to the
+/// default. Resilient to filename variation in the sherpa-onnx model zoo.
 bool is_caption_model_cached(const std::string& name);
 
 #if RECMEET_USE_SHERPA
@@ -0,0 +1,274 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "model_memory.h"
+#include "log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#include <sys/mman.h>
+
+namespace recmeet {
+
+namespace {
+
+std::atomic<bool> g_hugepages{false};
+
+struct LiveModel {
+    std::string what;
+    std::vector<MemoryRegion> regions;
+};
+
+std::mutex g_registry_mu;
+std::map<std::uint64_t, LiveModel> g_registry;
+std::uint64_t g_next_id = 1;
+
+std::vector<MemoryRegion> read_self_maps() {
+    std::ifstream in("/proc/self/maps");
+    return parse_memory_maps(in);
+}
+
+MemoryCoverage read_self_coverage(const std::vector<MemoryRegion>& regions) {
+    std::ifstream in("/proc/self/smaps");
+    return parse_smaps_coverage(in, regions);
+}
+
+std::size_t total_bytes(const std::vector<MemoryRegion>& regions) {
+    std::size_t n = 0;
+    for (const auto& r : regions) n += r.bytes();
+    return n;
+}
+
+double mb(std::uint64_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); }
+
+void log_coverage(const std::string& what, const std::vector<MemoryRegion>& regions) {
+    const MemoryCoverage c = read_self_coverage(regions);
+    log_info("model memory: %s %.0f MB mapped in %zu regions, %.0f MB resident, "
+             "%.0f MB on huge pages (%.0f%%), %.0f MB locked",
+             what.c_str(), mb(total_bytes(regions)), regions.size(), mb(c.rss), mb(c.huge),
+             c.rss > 0 ? 100.0 * static_cast<double>(c.huge) / static_cast<double>(c.rss) : 0.0,
+             mb(c.locked));
+}
+
+} // anonymous namespace
+
+std::vector<MemoryRegion> parse_memory_maps(std::istream& in) {
+    std::vector<MemoryRegion> out;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string range, perms, offset, dev, inode;
+        if (!(fields >> range >> perms >> offset >> dev >> inode)) continue;
+        const auto dash = range.find('-');
+        if (dash == std::string::npos) continue;
+        MemoryRegion r;
+        try {
+            r.start = static_cast<std::uintptr_t>(std::stoull(range.substr(0, dash), nullptr, 16));
+            r.end = static_cast<std::uintptr_t>(std::stoull(range.substr(dash + 1), nullptr, 16));
+        } catch (const std::exception&) {
+            continue;
+        }
+        std::getline(fields, r.path);
+        const auto first = r.path.find_first_not_of(' ');
+        r.path = first == std::string::npos ? "" : r.path.substr(first);
+        if (r.end > r.start) out.push_back(std::move(r));
+    }
+    return out;
+}
+
+std::vector<MemoryRegion> model_regions(const std::vector<MemoryRegion>& before,
+                                        const std::vector<MemoryRegion>& after,
+                                        const std::vector<std::string>& files,
+                                        std::size_t min_bytes) {
+    std::vector<MemoryRegion> out;
+    for (const auto& r : after) {
+        const bool existed = std::any_of(before.begin(), before.end(), [&](const MemoryRegion& b) {
+            return b.start == r.start && b.end == r.end;
+        });
+        if (existed) continue;
+        const bool owned = r.path.empty()
+            ? r.bytes() >= min_bytes
+            : std::find(files.begin(), files.end(), r.path) != files.end();
+        if (owned) out.push_back(r);
+    }
+    return out;
+}
+
+MemoryCoverage parse_smaps_coverage(std::istream& in, const std::vector<MemoryRegion>& regions) {
+    MemoryCoverage c;
+    bool counting = false;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        if (!(fields >> key) || key.empty()) continue;
+        if (key.back() != ':') {
+            // A mapping's header line: "start-end perms ...".
+            const auto dash = key.find('-');
+            counting = false;
+            if (dash == std::string::npos) continue;
+            std::uintptr_t start = 0;
+            try {
+                start = static_cast<std::uintptr_t>(std::stoull(key.substr(0, dash), nullptr, 16));
+            } catch (const std::exception&) {
+                continue;
+            }
+            counting = std::any_of(regions.begin(), regions.end(), [&](const MemoryRegion& r) {
+                return start >= r.start && start < r.end;
+            });
+            continue;
+        }
+        if (!counting) continue;
+        std::uint64_t kb = 0;
+        if (!(fields >> kb)) continue;
+        const std::uint64_t bytes = kb * 1024;
+        if (key == "Rss:") c.rss += bytes;
+        else if (key == "AnonHugePages:" || key == "FilePmdMapped:") c.huge += bytes;
+        else if (key == "Locked:") c.locked += bytes;
+    }
+    return c;
+}
+
+std::string transparent_hugepage_mode(const fs::path& sys_root) {
+    std::ifstream in(sys_root / "kernel/mm/transparent_hugepage/enabled");
+    std::string line;
+    std::getline(in, line);
+    const auto open = line.find('[');
+    const auto close = line.find(']', open);
+    if (open == std::string::npos || close == std::string::npos) return "";
+    return line.substr(open + 1, close - open - 1);
+}
+
+void set_model_hugepages(bool on) {
+    if (on && !g_hugepages.load()) {
+        const std::string mode = transparent_hugepage_mode();
+        if (mode == "never")
+            log_warn("model memory: huge pages requested but transparent_hugepage is 'never'");
+        else
+            log_info("model memory: advising huge pages for model weights (THP mode: %s)",
+                     mode.empty() ? "unknown" : mode.c_str());
+    }
+    g_hugepages.store(on);
+}
+
+bool model_hugepages() { return g_hugepages.load(); }
+
+ModelMemory::~ModelMemory() { forget(); }
+
+ModelMemory::ModelMemory(ModelMemory&& other) noexcept
+    : what_(std::move(other.what_)), files_(std::move(other.files_)),
+      before_(std::move(other.before_)), regions_(std::move(other.regions_)),
+      tracking_(other.tracking_), locked_(other.locked_), id_(other.id_) {
+    other.tracking_ = false;
+    other.locked_ = false;
+    other.id_ = 0;
+    other.regions_.clear();
+}
+
+ModelMemory& ModelMemory::operator=(ModelMemory&& other) noexcept {
+    if (this != &other) {
+        forget();
+        what_ = std::move(other.what_);
+        files_ = std::move(other.files_);
+        before_ = std::move(other.before_);
+        regions_ = std::move(other.regions_);
+        tracking_ = other.tracking_;
+        locked_ = other.locked_;
+        id_ = other.id_;
+        other.tracking_ = false;
+        other.locked_ = false;
+        other.id_ = 0;
+        other.regions_.clear();
+    }
+    return *this;
+}
+
+void ModelMemory::forget() {
+    unlock();
+    if (id_ != 0) {
+        std::lock_guard<std::mutex> lock(g_registry_mu);
+        g_registry.erase(id_);
+        id_ = 0;
+    }
+    regions_.clear();
+}
+
+void ModelMemory::begin(std::string what, const std::vector<fs::path>& files, bool track) {
+    if (!track && !model_hugepages()) return;
+    what_ = std::move(what);
+    files_.clear();
+    for (const auto& f : files) {
+        std::error_code ec;
+        const fs::path canon = fs::weakly_canonical(f, ec);
+        files_.push_back((ec ? f : canon).string());
+    }
+    before_ = read_self_maps();
+    tracking_ = true;
+}
+
+void ModelMemory::finish() {
+    if (!tracking_) return;
+    tracking_ = false;
+    regions_ = model_regions(before_, read_self_maps(), files_);
+    before_.clear();
+    before_.shrink_to_fit();
+    if (regions_.empty()) return;
+
+    if (model_hugepages()) {
+        std::size_t refused = 0;
+        for (const auto& r : regions_)
+            if (::madvise(reinterpret_cast<void*>(r.start), r.bytes(), MADV_HUGEPAGE) != 0)
+                ++refused;
+        if (refused > 0)
+            log_debug("model memory: %s: %zu of %zu regions refused MADV_HUGEPAGE",
+                      what_.c_str(), refused, regions_.size());
+        log_coverage(what_, regions_);
+    }
+    std::lock_guard<std::mutex> lock(g_registry_mu);
+    id_ = g_next_id++;
+    g_registry[id_] = LiveModel{what_, regions_};
+}
+
+bool ModelMemory::lock() {
+    if (locked_ || regions_.empty()) return locked_;
+    for (std::size_t i = 0; i < regions_.size(); ++i) {
+        const auto& r = regions_[i];
+        if (::mlock(reinterpret_cast<void*>(r.start), r.bytes()) != 0) {
+            const int e = errno;
+            for (std::size_t j = 0; j < i; ++j)
+                ::munlock(reinterpret_cast<void*>(regions_[j].start), regions_[j].bytes());
+            log_warn("model memory: cannot lock %s (%.0f MB) in RAM: %s; raise RLIMIT_MEMLOCK "
+                     "(ulimit -l, or LimitMEMLOCK= in the service unit)",
+                     what_.c_str(), mb(total_bytes(regions_)), std::strerror(e));
+            return false;
+        }
+    }
+    locked_ = true;
+    log_info("model memory: %s locked (%.0f MB)", what_.c_str(), mb(total_bytes(regions_)));
+    return true;
+}
+
+void ModelMemory::unlock() {
+    if (!locked_) return;
+    for (const auto& r : regions_)
+        ::munlock(reinterpret_cast<void*>(r.start), r.bytes());
+    locked_ = false;
+}
+
+void log_model_memory() {
+    std::vector<LiveModel> live;
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mu);
+        for (const auto& [id, m] : g_registry) live.push_back(m);
+    }
+    for (const auto& m : live) log_coverage(m.what, m.regions);
+}
+
+} // namespace recmeet
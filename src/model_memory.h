@@ -0,0 +1,125 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Model weight memory (general.hugepages, captions.mlock)
+// ---------------------------------------------------------------------------
+//
+// whisper.cpp, llama.cpp and onnxruntime allocate their weight buffers
+// themselves, so recmeet cannot ask for huge pages when they are allocated.
+// Those buffers are ggml backend buffers, llama's file mapping and ORT
+// initializers. A ModelMemory snapshots /proc/self/maps before a load, and
+// afterwards it takes the mappings the load created: anonymous ones of at
+// least MODEL_REGION_MIN_BYTES, and mappings of the model's own files.
+//
+//   general.hugepages  madvise(MADV_HUGEPAGE) on those regions, so that
+//                      khugepaged backs them with 2 MB pages when the
+//                      kernel's THP mode is "madvise" or "always". Their
+//                      huge-page coverage is logged from /proc/self/smaps
+//   captions.mlock     mlock() the caption recognizer's regions while an
+//                      engine decodes (CaptionEngine::Options::lock_memory)
+//
+// log_model_memory() reports the coverage of every live model. Huge pages
+// appear as khugepaged collapses the regions, so postprocessing reports
+// again when it finishes. Loads that overlap in time may claim each
+// other's mappings. The advice is harmless, but the report then counts
+// those mappings twice.
+
+/// Smallest anonymous mapping counted as part of a model load.
+constexpr std::size_t MODEL_REGION_MIN_BYTES = std::size_t(1) << 20;
+
+/// One line of /proc/self/maps.
+struct MemoryRegion {
+    std::uintptr_t start = 0;
+    std::uintptr_t end = 0;
+    std::string path;  ///< backing file; empty for anonymous memory
+    std::size_t bytes() const { return static_cast<std::size_t>(end - start); }
+};
+
+/// Parse /proc/<pid>/maps text.
+std::vector<MemoryRegion> parse_memory_maps(std::istream& in);
+
+/// The mappings of `after` absent from `before` that a load between the
+/// two owns: anonymous ones of at least `min_bytes`, and any of `files`
+/// (as written in the maps file).
+std::vector<MemoryRegion> model_regions(const std::vector<MemoryRegion>& before,
+                                        const std::vector<MemoryRegion>& after,
+                                        const std::vector<std::string>& files,
+                                        std::size_t min_bytes = MODEL_REGION_MIN_BYTES);
+
+/// Resident, huge-page and locked bytes of some regions.
+struct MemoryCoverage {
+    std::uint64_t rss = 0;
+    std::uint64_t huge = 0;    ///< AnonHugePages + FilePmdMapped
+    std::uint64_t locked = 0;
+};
+
+/// Sum the /proc/<pid>/smaps entries of `in` that start inside one of
+/// `regions`.
+MemoryCoverage parse_smaps_coverage(std::istream& in, const std::vector<MemoryRegion>& regions);
+
+/// The kernel's transparent huge page mode ("always", "madvise" or
+/// "never"), or "" when `sys_root` does not say.
+std::string transparent_hugepage_mode(const fs::path& sys_root = "/sys");
+
+/// Whether loads from now on advise huge pages (Config::model_hugepages).
+void set_model_hugepages(bool on);
+bool model_hugepages();
+
+/// The memory one model load mapped. Move-only; unlocks on destruction.
+class ModelMemory {
+public:
+    ModelMemory() = default;
+    ~ModelMemory();
+
+    ModelMemory(ModelMemory&& other) noexcept;
+    ModelMemory& operator=(ModelMemory&& other) noexcept;
+    ModelMemory(const ModelMemory&) = delete;
+    ModelMemory& operator=(const ModelMemory&) = delete;
+
+    /// Snapshot the mappings before loading `what` from `files`. Does
+    /// nothing unless model_hugepages() or `track` (a caller that may
+    /// lock()).
+    void begin(std::string what, const std::vector<fs::path>& files, bool track = false);
+
+    /// After the load: keep the regions it mapped, advise huge pages when
+    /// on and log the coverage. No-op without begin().
+    void finish();
+
+    /// mlock() the regions. Logs and returns false when the kernel refuses
+    /// (RLIMIT_MEMLOCK), leaving nothing locked.
+    bool lock();
+    void unlock();
+    bool locked() const { return locked_; }
+
+    const std::vector<MemoryRegion>& regions() const { return regions_; }
+
+private:
+    void forget();
+
+    std::string what_;
+    std::vector<std::string> files_;
+    std::vector<MemoryRegion> before_;
+    std::vector<MemoryRegion> regions_;
+    bool tracking_ = false;
+    bool locked_ = false;
+    std::uint64_t id_ = 0;  ///< registration with log_model_memory(); 0 = none
+};
+
+/// Log the size, huge-page coverage and locked bytes of every live model
+/// that finish() registered while tracking.
+void log_model_memory();
+
+} // namespace recmeet
@@ -0,0 +1,164 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "model_prefetch.h"
+#include "log.h"
+#include "model_manager.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace recmeet {
+
+namespace {
+
+// ioprio_set(2) has no glibc wrapper.
+constexpr int IOPRIO_WHO_PROCESS = 1;
+constexpr int IOPRIO_CLASS_IDLE = 3;
+constexpr int IOPRIO_CLASS_SHIFT = 13;
+
+void add_if_present(std::vector<fs::path>& out, const fs::path& p) {
+    std::error_code ec;
+    if (!p.empty() && fs::is_regular_file(p, ec) &&
+        std::find(out.begin(), out.end(), p) == out.end())
+        out.push_back(p);
+}
+
+} // anonymous namespace
+
+std::vector<fs::path> postprocess_model_files(const Config& cfg) {
+    std::vector<fs::path> files;
+    if (!cfg.remote_worker.empty()) return files;
+    auto whisper = [&files](const std::string& name) {
+        try {
+            if (!name.empty() && is_whisper_model_cached(name))
+                add_if_present(files, ensure_whisper_model(name));
+        } catch (const RecmeetError&) {}
+    };
+    whisper(cfg.whisper_model);
+    whisper(cfg.whisper_draft_model);
+#if RECMEET_USE_SHERPA
+    if (cfg.vad && is_vad_model_cached()) add_if_present(files, ensure_vad_model());
+    if (cfg.diarize && is_sherpa_model_cached()) {
+        const auto sherpa = ensure_sherpa_models();
+        add_if_present(files, sherpa.segmentation);
+        add_if_present(files, sherpa.embedding);
+    }
+#endif
+#if RECMEET_USE_LLAMA
+    if (!cfg.no_summary) {
+        for (const auto* name : {&cfg.llm_model, &cfg.llm_draft_model}) {
+            if (name->empty()) continue;
+            try {
+                add_if_present(files, ensure_llama_model(*name));
+            } catch (const RecmeetError&) {}
+        }
+    }
+#endif
+    return files;
+}
+
+std::vector<fs::path> plan_model_prefetch(const std::vector<PrefetchFile>& files,
+                                          uint64_t budget_bytes) {
+    std::vector<fs::path> chosen;
+    for (const auto& f : files) {
+        if (f.uncached_bytes == 0 || f.uncached_bytes > budget_bytes) continue;
+        budget_bytes -= f.uncached_bytes;
+        chosen.push_back(f.path);
+    }
+    return chosen;
+}
+
+uint64_t uncached_file_bytes(const fs::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+    struct stat st{};
+    uint64_t uncached = 0;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        const auto size = static_cast<size_t>(st.st_size);
+        uncached = size;
+        void* map = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (map != MAP_FAILED) {
+            const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            std::vector<unsigned char> resident((size + page - 1) / page);
+            if (::mincore(map, size, resident.data()) == 0) {
+                uint64_t held = 0;
+                for (unsigned char r : resident) held += r & 1;
+                uncached = size - std::min<uint64_t>(size, held * page);
+            }
+            ::munmap(map, size);
+        }
+    }
+    ::close(fd);
+    return uncached;
+}
+
+uint64_t prefetch_budget_bytes() {
+    uint64_t room = static_cast<uint64_t>(read_mem_free_kb()) * 1024;
+    if (const uint64_t ceiling = read_memory_ceiling_bytes()) {
+        const uint64_t rss = static_cast<uint64_t>(read_self_rss_kb()) * 1024;
+        const uint64_t under = ceiling > rss ? ceiling - rss : 0;
+        room = room > 0 ? std::min(room, under) : under;
+    }
+    return room > PREFETCH_RESERVE_BYTES ? room - PREFETCH_RESERVE_BYTES : 0;
+}
+
+uint64_t prefetch_model_files(const std::vector<fs::path>& files, const std::atomic<bool>& stop) {
+    std::vector<PrefetchFile> sized;
+    for (const auto& p : files) sized.push_back({p, uncached_file_bytes(p)});
+    const uint64_t budget = prefetch_budget_bytes();
+    const auto chosen = plan_model_prefetch(sized, budget);
+    for (const auto& f : sized) {
+        if (f.uncached_bytes > 0 &&
+            std::find(chosen.begin(), chosen.end(), f.path) == chosen.end())
+            log_info("prefetch: skipping %s (%.0f MB not cached, %.0f MB to spare)",
+                     f.path.filename().c_str(), f.uncached_bytes / 1048576.0,
+                     budget / 1048576.0);
+    }
+    if (chosen.empty()) return 0;
+
+    // Idle class: only uses the disk when nothing else wants it.
+    if (::syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0,
+                  IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT) != 0)
+        log_debug("prefetch: ioprio_set failed; reading at normal priority");
+
+    // Plain reads rather than readahead(2) or POSIX_FADV_WILLNEED: the
+    // kernel caps those at the device's readahead window and may drop the
+    // rest, while a read is sure to leave the pages cached.
+    const auto started = std::chrono::steady_clock::now();
+    std::vector<char> buf(1 << 20);
+    uint64_t read = 0;
+    for (const auto& path : chosen) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) continue;
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        uint64_t since_check = PREFETCH_CHUNK_BYTES;  // check before the first read
+        for (;;) {
+            if (since_check >= PREFETCH_CHUNK_BYTES) {
+                since_check = 0;
+                if (stop.load() || prefetch_budget_bytes() == 0) {
+                    ::close(fd);
+                    log_info("prefetch: stopped after %.0f MB", read / 1048576.0);
+                    return read;
+                }
+            }
+            const ssize_t n = ::read(fd, buf.data(), buf.size());
+            if (n <= 0) break;
+            read += static_cast<uint64_t>(n);
+            since_check += static_cast<uint64_t>(n);
+        }
+        ::close(fd);
+    }
+    log_info("prefetch: read ahead %.0f MB of %zu model file(s) in %.1f s",
+             read / 1048576.0, chosen.size(),
+             std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count());
+    return read;
+}
+
+} // namespace recmeet
@@ -0,0 +1,59 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "config.h"
+#include "util.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace recmeet {
+
+// Page-cache prefetch of the models a recording's postprocessing will load.
+// The daemon starts it on record.start, so by the time the recording stops
+// the whisper, sherpa and LLM files are read from memory rather than from a
+// spinning disk or network home directory. It only fills memory that holds
+// nothing (MemFree, and room under the memory ceiling), so it never pushes
+// out another process's pages, and reads at idle I/O priority so capture
+// is not disturbed.
+
+/// Memory left untouched by prefetch_budget_bytes().
+inline constexpr uint64_t PREFETCH_RESERVE_BYTES = 512ull << 20;
+/// Bytes read between checks of the budget and the stop flag.
+inline constexpr uint64_t PREFETCH_CHUNK_BYTES = 32ull << 20;
+
+/// Model files postprocessing with `cfg` will load, in the order it loads
+/// them. Only files already on disk are listed; nothing is downloaded.
+/// Empty when the stages run on a remote worker.
+std::vector<fs::path> postprocess_model_files(const Config& cfg);
+
+struct PrefetchFile {
+    fs::path path;
+    uint64_t uncached_bytes = 0;  ///< not in the page cache yet
+};
+
+/// The files to read ahead: in order, each one whose uncached bytes still
+/// fit in what is left of `budget_bytes`. A file that does not fit is
+/// skipped; a smaller one after it may still go. Fully cached files are
+/// left out. Pure, for testing.
+std::vector<fs::path> plan_model_prefetch(const std::vector<PrefetchFile>& files,
+                                          uint64_t budget_bytes);
+
+/// Bytes of `path` not in the page cache (mincore()). The file's size when
+/// that cannot be checked, 0 when the file cannot be opened.
+uint64_t uncached_file_bytes(const fs::path& path);
+
+/// Memory prefetch may fill: the smaller of MemFree and the room left under
+/// read_memory_ceiling_bytes(), less PREFETCH_RESERVE_BYTES. 0 when neither
+/// can be read.
+uint64_t prefetch_budget_bytes();
+
+/// Plan with the current budget, then read the chosen files through on the
+/// calling thread at idle I/O priority, giving up when `stop` is set or the
+/// budget runs out partway. Returns the bytes read ahead.
+uint64_t prefetch_model_files(const std::vector<fs::path>& files, const std::atomic<bool>& stop);
+
+} // namespace recmeet
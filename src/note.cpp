@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT OR Apache-2.0
 
 #include "note.h"
+#include "action_ledger.h"
 #include "log.h"
 
 #include <algorithm>
@@ -11,6 +12,7 @@
 #include <iomanip>
 #include <set>
 #include <sstream>
+#include <string_view>
 
 namespace recmeet {
 
@@ -279,10 +281,12 @@ fs::path write_meeting_note(const NoteConfig& config, const MeetingData& data) {
     // --- Transcript (foldable) ---
     if (!data.transcript_text.empty()) {
         out << "> [!abstract]- Full Transcript\n";
-        std::istringstream tx_stream(data.transcript_text);
-        std::string line;
-        while (std::getline(tx_stream, line))
-            out << "> " << line << "\n";
+        const std::string_view tx = data.transcript_text;
+        for (size_t pos = 0; pos < tx.size();) {
+            const size_t nl = std::min(tx.find('\n', pos), tx.size());
+            out << "> " << tx.substr(pos, nl - pos) << "\n";
+            pos = nl + 1;
+        }
         out << "\n";
     }
 
@@ -294,6 +298,20 @@ fs::path write_meeting_note(const NoteConfig& config, const MeetingData& data) {
 
     out.close();
     log_info("Meeting note: %s", note_path.c_str());
+
+    if (!config.action_ledger.empty()) {
+        std::vector<LedgerItem> items;
+        for (const auto& line : actions) {
+            LedgerItem item;
+            if (parse_ledger_item(line, item)) items.push_back(std::move(item));
+        }
+        try {
+            update_action_ledger(config.action_ledger, note_path, data.date, items);
+        } catch (const std::exception& e) {
+            // The ledger is reconciled from the notes; the next reader re-parses this one.
+            log_warn("Action ledger not updated: %s", e.what());
+        }
+    }
     return note_path;
 }
 
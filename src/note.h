@@ -13,6 +13,7 @@ namespace recmeet {
 struct NoteConfig {
     std::string domain = "general";
     std::vector<std::string> tags;
+    fs::path action_ledger;  // record the note's action items here; empty = don't
 };
 
 struct MeetingMetadata {
@@ -0,0 +1,181 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "onnx_provider.h"
+#include "log.h"
+
+#if RECMEET_HAVE_ORT_API
+#include <onnxruntime_c_api.h>
+#endif
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+
+#include <dlfcn.h>
+
+namespace recmeet {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Plugin suffix (libonnxruntime_providers_<suffix>.so) and the EP it
+// provides. XNNPACK and the CPU EP are built into libonnxruntime itself.
+struct ProviderPlugin {
+    const char* suffix;
+    const char* ep;
+};
+constexpr ProviderPlugin kPlugins[] = {
+    {"cuda",     "CUDAExecutionProvider"},
+    {"tensorrt", "TensorrtExecutionProvider"},
+    {"rocm",     "ROCMExecutionProvider"},
+    {"migraphx", "MIGraphXExecutionProvider"},
+    {"openvino", "OpenVINOExecutionProvider"},
+};
+
+bool has(const std::vector<std::string>& available, const char* ep) {
+    return std::find(available.begin(), available.end(), ep) != available.end();
+}
+
+// Directory of the libonnxruntime this process runs: where its provider
+// plugins are installed. Empty when it is not loaded as a shared library
+// (sherpa-onnx's static prebuilt, a CPU-only build).
+fs::path onnxruntime_dir() {
+    void* sym = ::dlsym(RTLD_DEFAULT, "OrtGetApiBase");
+    Dl_info info{};
+    if (!sym || ::dladdr(sym, &info) == 0 || !info.dli_fname) return {};
+    const fs::path lib(info.dli_fname);
+    if (lib.filename().string().compare(0, 14, "libonnxruntime") != 0) return {};
+    return lib.parent_path();
+}
+
+std::vector<std::string> read_available_providers() {
+    std::vector<std::string> out;
+#if RECMEET_HAVE_ORT_API
+    if (const OrtApi* api = OrtGetApiBase()->GetApi(ORT_API_VERSION)) {
+        char** names = nullptr;
+        int n = 0;
+        if (OrtStatus* status = api->GetAvailableProviders(&names, &n)) {
+            api->ReleaseStatus(status);
+        } else {
+            out.assign(names, names + n);
+            api->ReleaseAvailableProviders(names, n);
+        }
+    }
+#endif
+    if (out.empty()) {
+        // No usable C API: the shared EPs are plugins, found by file name.
+        const fs::path dir = onnxruntime_dir();
+        std::error_code ec;
+        for (const auto& plugin : kPlugins) {
+            if (dir.empty()) break;
+            const fs::path so = dir / ("libonnxruntime_providers_" + std::string(plugin.suffix) + ".so");
+            if (fs::exists(so, ec)) out.push_back(plugin.ep);
+        }
+    }
+    if (!has(out, "CPUExecutionProvider")) out.push_back("CPUExecutionProvider");
+    return out;
+}
+
+OnnxHost read_host() {
+    OnnxHost host;
+    std::error_code ec;
+    host.nvidia_device = fs::exists("/dev/nvidia0", ec) ||
+                         fs::exists("/proc/driver/nvidia/version", ec);
+#if defined(__aarch64__) || defined(__arm__)
+    host.weak_simd = true;
+#elif defined(__x86_64__) || defined(__i386__)
+    host.weak_simd = !__builtin_cpu_supports("avx2");
+#endif
+    return host;
+}
+
+std::mutex g_mutex;
+std::string g_requested = "auto";
+bool g_failed = false;    // the selected provider failed; use the CPU
+std::string g_logged;     // request last announced
+
+} // anonymous namespace
+
+bool valid_onnx_provider(const std::string& name) {
+    return name == "auto" || name == "cpu" || name == "cuda" || name == "xnnpack";
+}
+
+std::string choose_onnx_provider(const std::string& requested,
+                                 const std::vector<std::string>& available,
+                                 const OnnxHost& host) {
+    const bool cuda = has(available, "CUDAExecutionProvider") && host.nvidia_device;
+    const bool xnnpack = has(available, "XnnpackExecutionProvider");
+    if (requested == "cuda") return cuda ? "cuda" : "cpu";
+    if (requested == "xnnpack") return xnnpack ? "xnnpack" : "cpu";
+    if (requested == "auto") {
+        if (cuda) return "cuda";
+        if (xnnpack && host.weak_simd) return "xnnpack";
+    }
+    return "cpu";
+}
+
+const std::vector<std::string>& onnx_available_providers() {
+    static const std::vector<std::string> providers = read_available_providers();
+    return providers;
+}
+
+const OnnxHost& onnx_host() {
+    static const OnnxHost host = read_host();
+    return host;
+}
+
+void set_onnx_provider(const std::string& requested) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (requested == g_requested) return;
+    g_requested = requested;
+    g_failed = false;
+}
+
+std::string onnx_provider() {
+    std::string requested;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if (g_failed) return "cpu";
+        requested = g_requested;
+    }
+    const std::string chosen =
+        choose_onnx_provider(requested, onnx_available_providers(), onnx_host());
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (g_logged != requested) {
+        g_logged = requested;
+        std::string list;
+        for (const auto& ep : onnx_available_providers())
+            list += (list.empty() ? "" : ", ") + ep;
+        log_info("onnxruntime: provider %s for diarization (requested %s; available: %s)",
+                 chosen.c_str(), requested.c_str(), list.c_str());
+        if (chosen != requested && requested != "auto")
+            log_warn("onnxruntime: %s provider not available, using the CPU", requested.c_str());
+    }
+    return chosen;
+}
+
+const void* create_on_onnx_provider(const char* what, std::string& provider,
+                                    const std::function<const void*(const std::string&)>& create) {
+    provider = onnx_provider();
+    if (provider != "cpu") {
+        const void* obj = nullptr;
+        try {
+            obj = create(provider);
+        } catch (const std::exception& e) {
+            log_warn("%s: %s provider threw: %s", what, provider.c_str(), e.what());
+        }
+        if (obj) return obj;
+        log_warn("%s: %s provider failed, falling back to the CPU", what, provider.c_str());
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            g_failed = true;
+        }
+        provider = "cpu";
+    }
+    return create(provider);
+}
+
+} // namespace recmeet
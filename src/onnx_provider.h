@@ -0,0 +1,71 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// onnxruntime execution providers (diarization.provider)
+// ---------------------------------------------------------------------------
+//
+// sherpa-onnx's segmentation and embedding sessions run on whichever
+// onnxruntime execution provider (EP) they are created with. The EPs an
+// onnxruntime build offers are listed through its C API when recmeet was
+// built against its headers. Otherwise recmeet looks for the provider
+// plugins (libonnxruntime_providers_<ep>.so) beside libonnxruntime, much as
+// backend_info.h discovers the ggml plugins. `diarization.provider` picks one:
+//
+//   auto     CUDA when its EP is present and an NVIDIA device is, else
+//            XNNPACK on hosts where its kernels beat the default CPU EP
+//            (ARM, x86 without AVX2), else the CPU
+//   cpu      the default CPU EP
+//   cuda     CUDA, falling back to the CPU when it is not available
+//   xnnpack  XNNPACK, likewise
+//
+// A session that fails to build on the chosen EP is rebuilt on the CPU,
+// and later sessions in the process go straight to the CPU.
+
+/// True for "auto", "cpu", "cuda" and "xnnpack".
+bool valid_onnx_provider(const std::string& name);
+
+/// What the host offers beyond the EP list.
+struct OnnxHost {
+    bool nvidia_device = false;  ///< /dev/nvidia0 or the NVIDIA kernel driver is present
+    bool weak_simd = false;      ///< ARM, or x86 without AVX2
+};
+
+/// The sherpa provider name ("cpu", "cuda" or "xnnpack") for `requested`
+/// given onnxruntime's EP names (`available`, e.g. "CUDAExecutionProvider")
+/// and `host`. A provider that is not available resolves to "cpu".
+std::string choose_onnx_provider(const std::string& requested,
+                                 const std::vector<std::string>& available,
+                                 const OnnxHost& host);
+
+/// onnxruntime's EP names, read once per process. Always includes
+/// "CPUExecutionProvider".
+const std::vector<std::string>& onnx_available_providers();
+
+/// This host, read once per process.
+const OnnxHost& onnx_host();
+
+/// Select the provider for sessions created from now on in this process,
+/// from Config::diarize_provider. Cheap when unchanged.
+void set_onnx_provider(const std::string& requested);
+
+/// The sherpa provider name new sessions use: choose_onnx_provider() for
+/// the selected request, or "cpu" once that provider failed.
+std::string onnx_provider();
+
+/// Create a sherpa object through `create(provider)` on onnx_provider().
+/// When it returns null or throws on another EP, log it, switch the
+/// process to the CPU and create it again there. `provider` receives the
+/// EP the object was created on. Returns what the last `create` returned.
+const void* create_on_onnx_provider(const char* what, std::string& provider,
+                                    const std::function<const void*(const std::string&)>& create);
+
+} // namespace recmeet
@@ -0,0 +1,228 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "perf_counters.h"
+#include "log.h"
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace recmeet {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// The PerfCounts fields, in order; the group leader first.
+constexpr uint64_t kEvents[] = {
+    PERF_COUNT_HW_CPU_CYCLES,       PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES,
+};
+constexpr int kNumEvents = sizeof(kEvents) / sizeof(kEvents[0]);
+
+int64_t PerfCounts::* const kFields[kNumEvents] = {
+    &PerfCounts::cycles,     &PerfCounts::instructions, &PerfCounts::cache_refs,
+    &PerfCounts::cache_misses, &PerfCounts::branches,   &PerfCounts::branch_misses,
+};
+
+std::atomic<bool> g_enabled{false};
+std::atomic<bool> g_refused{false};  // perf_event_open() not permitted
+std::atomic<unsigned> g_missing{0};  // bit per event the PMU lacks
+
+std::mutex g_engine_mu;
+std::map<std::string, EngineCounts> g_engines;
+
+int open_counter(uint64_t config, pid_t tid, int group_fd) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.disabled = group_fd == -1 ? 1 : 0;  // the leader starts the group
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, tid, -1, group_fd,
+                                      PERF_FLAG_FD_CLOEXEC));
+}
+
+// Note why counting failed, once: refusal turns the mode off, a missing
+// event only drops that event.
+void note_open_failure(int event, int err) {
+    if (err == EACCES || err == EPERM) {
+        if (!g_refused.exchange(true)) {
+            const int32_t paranoid = perf_event_paranoid();
+            log_warn("perf counters: perf_event_open refused (%s; perf_event_paranoid=%s); "
+                     "stages are reported without counters. Lower it with "
+                     "`sysctl kernel.perf_event_paranoid=2` or grant CAP_PERFMON",
+                     std::strerror(err),
+                     paranoid == INT32_MIN ? "unknown" : std::to_string(paranoid).c_str());
+        }
+        return;
+    }
+    const unsigned bit = 1u << event;
+    if (!(g_missing.fetch_or(bit) & bit))
+        log_warn("perf counters: hardware event %d unavailable (%s); left out", event,
+                 std::strerror(err));
+}
+
+// The process's thread ids, at most `max`.
+std::vector<pid_t> process_threads(int max) {
+    std::vector<pid_t> out;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator("/proc/self/task", ec)) {
+        if (static_cast<int>(out.size()) >= max) break;
+        try {
+            out.push_back(static_cast<pid_t>(std::stol(entry.path().filename().string())));
+        } catch (const std::exception&) {
+        }
+    }
+    if (out.empty()) out.push_back(static_cast<pid_t>(::syscall(SYS_gettid)));
+    return out;
+}
+
+} // anonymous namespace
+
+bool PerfCounts::any() const {
+    for (auto field : kFields)
+        if (this->*field >= 0) return true;
+    return false;
+}
+
+double PerfCounts::ipc() const {
+    return cycles > 0 && instructions >= 0
+        ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0.0;
+}
+
+double PerfCounts::cache_miss_rate() const {
+    return cache_refs > 0 && cache_misses >= 0
+        ? static_cast<double>(cache_misses) / static_cast<double>(cache_refs) : 0.0;
+}
+
+double PerfCounts::branch_miss_rate() const {
+    return branches > 0 && branch_misses >= 0
+        ? static_cast<double>(branch_misses) / static_cast<double>(branches) : 0.0;
+}
+
+double PerfCounts::miss_mb_per_sec(double wall_sec) const {
+    if (cache_misses < 0 || wall_sec <= 0) return 0.0;
+    return static_cast<double>(cache_misses) * PERF_CACHE_LINE_BYTES / (1024.0 * 1024.0) /
+           wall_sec;
+}
+
+PerfCounts& PerfCounts::operator+=(const PerfCounts& other) {
+    for (auto field : kFields) {
+        if (other.*field < 0) continue;
+        this->*field = (this->*field < 0 ? 0 : this->*field) + other.*field;
+    }
+    return *this;
+}
+
+int64_t scale_perf_count(uint64_t value, uint64_t time_enabled, uint64_t time_running) {
+    if (time_running == 0) return -1;
+    if (time_running >= time_enabled) return static_cast<int64_t>(value);
+    return static_cast<int64_t>(static_cast<double>(value) * static_cast<double>(time_enabled) /
+                                static_cast<double>(time_running));
+}
+
+int32_t perf_event_paranoid() {
+    std::ifstream in("/proc/sys/kernel/perf_event_paranoid");
+    int32_t level = 0;
+    return in >> level ? level : INT32_MIN;
+}
+
+void set_perf_counters(bool on) {
+    if (on && !g_enabled.load())
+        log_info("perf counters: counting cycles, instructions, cache and branch misses per "
+                 "stage (perf_event_paranoid=%d)", perf_event_paranoid());
+    g_enabled.store(on);
+}
+
+bool perf_counters_enabled() { return g_enabled.load() && !g_refused.load(); }
+
+PerfCounterSet::PerfCounterSet(PerfScope scope) {
+    if (!perf_counters_enabled()) return;
+    const std::vector<pid_t> tids = scope == PerfScope::Process
+        ? process_threads(PERF_MAX_THREADS)
+        : std::vector<pid_t>{static_cast<pid_t>(::syscall(SYS_gettid))};
+    std::vector<int> leaders;
+    for (pid_t tid : tids) {
+        int leader = -1;
+        for (int e = 0; e < kNumEvents; ++e) {
+            if (g_missing.load() & (1u << e)) continue;
+            const int fd = open_counter(kEvents[e], tid, leader);
+            if (fd < 0) {
+                const int err = errno;
+                // A thread that exited since the listing is no failure.
+                if (err == ESRCH) break;
+                note_open_failure(e, err);
+                if (g_refused.load()) {
+                    for (const auto& [kind, open_fd] : fds_) ::close(open_fd);
+                    fds_.clear();
+                    return;
+                }
+                continue;
+            }
+            if (leader == -1) {
+                leader = fd;
+                leaders.push_back(fd);
+            }
+            fds_.emplace_back(e, fd);
+        }
+    }
+    for (int leader : leaders) ::ioctl(leader, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+PerfCounterSet::~PerfCounterSet() {
+    for (const auto& [kind, fd] : fds_) ::close(fd);
+}
+
+PerfCounts PerfCounterSet::read() const {
+    PerfCounts out;
+    for (const auto& [kind, fd] : fds_) {
+        uint64_t buf[3] = {0, 0, 0};  // value, time enabled, time running
+        if (::read(fd, buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf))) continue;
+        const int64_t n = scale_perf_count(buf[0], buf[1], buf[2]);
+        if (n < 0) continue;
+        int64_t& field = out.*kFields[kind];
+        field = (field < 0 ? 0 : field) + n;
+    }
+    return out;
+}
+
+EngineCounterScope::EngineCounterScope(const char* engine, PerfScope scope)
+    : engine_(engine), start_(std::chrono::steady_clock::now()) {
+    if (perf_counters_enabled()) counters_ = std::make_unique<PerfCounterSet>(scope);
+}
+
+EngineCounterScope::~EngineCounterScope() {
+    if (!counters_) return;
+    const PerfCounts counts = counters_->read();
+    const double wall =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    std::lock_guard<std::mutex> lock(g_engine_mu);
+    EngineCounts& tally = g_engines[engine_];
+    ++tally.calls;
+    tally.wall_sec += wall;
+    tally.counts += counts;
+}
+
+std::map<std::string, EngineCounts> take_engine_counts() {
+    std::lock_guard<std::mutex> lock(g_engine_mu);
+    std::map<std::string, EngineCounts> out;
+    out.swap(g_engines);
+    return out;
+}
+
+} // namespace recmeet
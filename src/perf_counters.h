@@ -0,0 +1,129 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Hardware performance counters (--perf-counters, general.perf_counters)
+// ---------------------------------------------------------------------------
+//
+// With the mode on, each StageTimer also counts cycles, instructions,
+// cache references and misses, and branches and branch misses over its
+// stage. perf_event_open() opens one group of six counters per thread, in
+// user space only (exclude_kernel), so perf_event_paranoid up to 2 allows
+// it. Each group counts its thread and the threads it starts (inherit).
+//
+//   PerfScope::Process  every thread of the process when the scope opens
+//                       (stages; persistent pools such as onnxruntime's
+//                       are counted), up to PERF_MAX_THREADS of them
+//   PerfScope::Thread   the calling thread only (an engine call whose
+//                       worker threads are started per call: whisper_full,
+//                       a llama completion)
+//
+// Engine calls are also counted as a whole, one tally per engine
+// (EngineCounterScope / take_engine_counts), which run_postprocessing() reports
+// as `engine.<name>` records. A counter the kernel multiplexed is scaled by
+// enabled / running time. When perf_event_open() is refused the mode turns
+// itself off with a single warning naming perf_event_paranoid; a counter
+// the PMU lacks (common in VMs) is left out, and the others still count.
+
+/// Most threads a Process scope opens counters on; ~6 descriptors each.
+constexpr int PERF_MAX_THREADS = 128;
+
+/// Bytes a last-level cache miss moves, for the bandwidth estimate.
+constexpr double PERF_CACHE_LINE_BYTES = 64.0;
+
+/// Counter totals; -1 = not counted.
+struct PerfCounts {
+    int64_t cycles = -1;
+    int64_t instructions = -1;
+    int64_t cache_refs = -1;
+    int64_t cache_misses = -1;
+    int64_t branches = -1;
+    int64_t branch_misses = -1;
+
+    bool any() const;
+    /// instructions / cycles; 0 unless both were counted.
+    double ipc() const;
+    /// cache_misses / cache_refs and branch_misses / branches; 0 unless
+    /// both were counted.
+    double cache_miss_rate() const;
+    double branch_miss_rate() const;
+    /// Memory traffic the cache misses imply over `wall_sec`, in MB/s. An
+    /// estimate: prefetches and write-backs are not counted.
+    double miss_mb_per_sec(double wall_sec) const;
+
+    /// Field-wise sum; a counter missing on either side stays missing
+    /// only when it is missing on both.
+    PerfCounts& operator+=(const PerfCounts& other);
+};
+
+/// A multiplexed counter's estimate: `value` scaled by enabled / running.
+/// 0 running time means the counter never ran: -1.
+int64_t scale_perf_count(uint64_t value, uint64_t time_enabled, uint64_t time_running);
+
+/// /proc/sys/kernel/perf_event_paranoid, or INT32_MIN when unreadable.
+int32_t perf_event_paranoid();
+
+/// Whether counters are opened from now on (Config::perf_counters).
+void set_perf_counters(bool on);
+bool perf_counters_enabled();
+
+enum class PerfScope { Process, Thread };
+
+/// Counter groups opened on construction and read by read(). Inert when
+/// the mode is off or was refused.
+class PerfCounterSet {
+public:
+    explicit PerfCounterSet(PerfScope scope = PerfScope::Process);
+    ~PerfCounterSet();
+
+    PerfCounterSet(const PerfCounterSet&) = delete;
+    PerfCounterSet& operator=(const PerfCounterSet&) = delete;
+
+    bool active() const { return !fds_.empty(); }
+    /// Totals so far; all -1 when inactive.
+    PerfCounts read() const;
+
+private:
+    // One descriptor per counter kind and thread; the kind is the index
+    // into the PerfCounts fields.
+    std::vector<std::pair<int, int>> fds_;
+};
+
+/// Counts one engine call (`whisper_full`, `sherpa_diarize`,
+/// `llama_complete`) into its tally, from construction to destruction.
+class EngineCounterScope {
+public:
+    EngineCounterScope(const char* engine, PerfScope scope);
+    ~EngineCounterScope();
+
+    EngineCounterScope(const EngineCounterScope&) = delete;
+    EngineCounterScope& operator=(const EngineCounterScope&) = delete;
+
+private:
+    const char* engine_;
+    std::unique_ptr<PerfCounterSet> counters_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/// One engine's tally.
+struct EngineCounts {
+    int calls = 0;
+    double wall_sec = 0;  ///< summed over calls; overlapping calls add up
+    PerfCounts counts;
+};
+
+/// The tallies since the last call, by engine, and reset them.
+std::map<std::string, EngineCounts> take_engine_counts();
+
+} // namespace recmeet
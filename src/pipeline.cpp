@@ -4,31 +4,61 @@
 #include "pipeline.h"
 #include "pipeline_cleanup.h"
 #include "pipeline_exit.h"
+#include "action_ledger.h"
+#include "backend_bench.h"
+#include "backend_info.h"
 #include "caption_engine.h"
 #include "caption_start_channel.h"
 #include "caption_vtt.h"
+#include "capture_replay.h"
+#include "channel_attribution.h"
+#include "clip_transcribe.h"
 #include "config.h"
+#include "cpu_topology.h"
 #include "diarize.h"
 #include "ipc_protocol.h"
+#include "level_meter.h"
+#include "live_diarize.h"
+#include "live_transcribe.h"
+#include "memory_governor.h"
+#include "model_memory.h"
+#include "onnx_provider.h"
+#include "power_policy.h"
+#include "rolling_summary.h"
 #include "speaker_id.h"
+#include "sparse_audio.h"
+#include "stage_cache.h"
+#include "trace.h"
 #include "vad.h"
 #include "device_enum.h"
 #include "audio_capture.h"
 #include "audio_monitor.h"
 #include "audio_file.h"
 #include "audio_mixer.h"
+#include "audio_view.h"
+#include "sample_source.h"
+#include "streaming_mixer.h"
 #include "log.h"
 #include "model_manager.h"
 #include "transcribe.h"
+#include "transcript_store.h"
 #include "summarize.h"
+#include "thread_budget.h"
 #include "note.h"
 #include "notify.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <future>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <regex>
 #include <set>
 #include <sstream>
@@ -161,7 +191,12 @@ std::vector<std::string> split_icase(const std::string& s, const std::string& de
 }  // namespace
 
 int parse_context_participants(const std::string& context) {
-    if (context.empty()) return 0;
+    return static_cast<int>(parse_context_participant_names(context).size());
+}
+
+std::vector<std::string> parse_context_participant_names(const std::string& context) {
+    std::vector<std::string> names;
+    if (context.empty()) return names;
 
     // Anchored line regex: leading/trailing whitespace tolerated; singular
     // "Participant:" matched defensively; capture group is the list payload.
@@ -171,8 +206,6 @@ int parse_context_participants(const std::string& context) {
         R"(^\s*Participants?\s*:\s*(.+?)\s*$)",
         std::regex::icase | std::regex::ECMAScript);
 
-    int total = 0;
-
     // Tokenize on '\n'. The final segment (possibly without a trailing
     // newline) is still emitted by this loop because we walk past end().
     size_t pos = 0;
@@ -204,7 +237,8 @@ int parse_context_participants(const std::string& context) {
                 for (const std::string& sub_a : a) {
                     std::vector<std::string> b = split_icase(sub_a, " & ");
                     for (const std::string& tok : b) {
-                        if (!trim_ws(tok).empty()) ++total;
+                        std::string name = trim_ws(tok);
+                        if (!name.empty()) names.push_back(std::move(name));
                     }
                 }
             }
@@ -213,7 +247,7 @@ int parse_context_participants(const std::string& context) {
         if (nl == std::string::npos) break;
         pos = nl + 1;
     }
-    return total;
+    return names;
 }
 
 int resolve_target_speakers(int cli_num_speakers,
@@ -238,6 +272,472 @@ int resolve_target_speakers(int cli_num_speakers,
 
 namespace {
 
+// T2.2 dispatch: chunked path triggers when audio is large enough to
+// actually produce ≥ 2 real chunks plus 2 minutes of headroom. Threshold
+// formula pinned in plan rev 7 line 429.
+size_t diarize_chunk_threshold_samples(float chunk_minutes, float chunk_overlap_sec) {
+    return static_cast<size_t>(
+        (chunk_minutes * 60.0f + chunk_overlap_sec + 120.0f)
+        * static_cast<float>(SAMPLE_RATE));
+}
+
+#if RECMEET_USE_SHERPA
+// Speech-only diarization depends on the regions VAD found as well, and
+// diarization.local_speaker cuts the local user's stretches out of them.
+void add_speech_only_key(StageKey& key, const Config& cfg) {
+    if (!cfg.local_speaker.empty()) key.add("local_speaker", 1);
+    if (!diarize_speech_only(cfg)) return;
+    key.add("speech_only", 1)
+       .add("vad_threshold", cfg.vad_threshold)
+       .add("vad_min_silence", cfg.vad_min_silence)
+       .add("vad_min_speech", cfg.vad_min_speech)
+       .add("vad_max_speech", cfg.vad_max_speech);
+}
+#endif
+
+constexpr uint64_t DIARIZE_SESSION_BYTES = 512ull << 20;   // models + onnxruntime arenas
+constexpr uint64_t DIARIZE_BYTES_PER_SECOND = 4ull << 20;  // iter-114: ~3 MB/s observed
+
+} // anonymous namespace
+
+uint64_t estimate_diarize_peak_bytes(size_t audio_samples, float chunk_minutes,
+                                     float chunk_overlap_sec) {
+    size_t held = audio_samples;
+    if (audio_samples > diarize_chunk_threshold_samples(chunk_minutes, chunk_overlap_sec))
+        held = static_cast<size_t>((chunk_minutes * 60.0f + chunk_overlap_sec)
+                                   * static_cast<float>(SAMPLE_RATE));
+    return DIARIZE_SESSION_BYTES + held * DIARIZE_BYTES_PER_SECOND / SAMPLE_RATE;
+}
+
+DiarizeChunking plan_diarize_chunking(uint64_t ceiling_bytes) {
+    DiarizeChunking plan;
+    if (ceiling_bytes == 0) return plan;
+    constexpr double MAX_OVERLAP_SEC = 60.0;
+    const uint64_t budget = ceiling_bytes / 2;
+    const double held_sec = budget > DIARIZE_SESSION_BYTES
+        ? static_cast<double>(budget - DIARIZE_SESSION_BYTES) / DIARIZE_BYTES_PER_SECOND
+        : 0.0;
+    const double minutes = std::floor((held_sec - MAX_OVERLAP_SEC) / 60.0 / 5.0) * 5.0;
+    plan.chunk_minutes = static_cast<float>(std::clamp(minutes, 5.0, 60.0));
+    plan.overlap_sec = std::clamp(plan.chunk_minutes * 2.0f, 20.0f, 60.0f);
+    return plan;
+}
+
+DiarizeChunking resolve_diarize_chunking(const Config& cfg) {
+    if (!cfg.diarize_auto_chunk) return {cfg.chunk_minutes, cfg.chunk_overlap_sec};
+    return plan_diarize_chunking(read_memory_ceiling_bytes());
+}
+
+DiarizeOverlapPlan plan_diarize_overlap(bool enabled, bool whisper_on_gpu, int threads,
+                                        uint64_t diarize_peak_bytes, uint64_t rss_bytes,
+                                        uint64_t available_bytes, uint64_t budget_bytes) {
+    DiarizeOverlapPlan plan;
+    plan.whisper_threads = std::max(threads, 1);
+    plan.diarize_threads = std::max(threads, 1);
+    if (!enabled) {
+        plan.reason = "disabled";
+    } else if (!whisper_on_gpu) {
+        plan.reason = "whisper runs on the CPU";
+    } else if (threads < 2) {
+        plan.reason = "only one CPU thread";
+    } else if (rss_bytes + diarize_peak_bytes > budget_bytes) {
+        plan.reason = "projected peak exceeds the memory budget";
+    } else if (available_bytes > 0 && diarize_peak_bytes > available_bytes) {
+        plan.reason = "not enough available memory";
+    } else {
+        plan.overlap = true;
+        plan.whisper_threads = std::clamp(threads / 4, 1, 4);
+        plan.diarize_threads = threads - plan.whisper_threads;
+    }
+    return plan;
+}
+
+std::vector<int> plan_transcribe_gpus(int requested, const std::vector<GpuDevice>& gpus,
+                                      uint64_t model_bytes, size_t windows) {
+    std::vector<int> out;
+    if (gpus.empty()) return out;
+    out.push_back(gpus.front().index);
+    const size_t want = requested > 0 ? static_cast<size_t>(requested) : gpus.size();
+    for (size_t g = 1; g < gpus.size() && out.size() < want && out.size() < windows; ++g) {
+        const auto& gpu = gpus[g];
+        if (gpu.total_bytes > 0 && gpu.free_bytes < model_bytes + model_bytes / 4) {
+            log_info("GPU %d (%s): %zu MB free, too little for another whisper model",
+                     gpu.index, gpu.description.c_str(), gpu.free_bytes >> 20);
+            continue;
+        }
+        out.push_back(gpu.index);
+    }
+    return out;
+}
+
+int plan_diarize_parallel(int requested, int threads, uint64_t chunk_peak_bytes,
+                          uint64_t rss_bytes, uint64_t available_bytes,
+                          uint64_t budget_bytes) {
+    threads = std::max(threads, 1);
+    uint64_t k = static_cast<uint64_t>(requested > 0 ? std::min(requested, threads)
+                                                     : std::max(threads / 2, 1));
+    if (chunk_peak_bytes > 0) {
+        const uint64_t room = budget_bytes > rss_bytes ? budget_bytes - rss_bytes : 0;
+        k = std::min(k, room / chunk_peak_bytes);
+        if (available_bytes > 0) k = std::min(k, available_bytes / chunk_peak_bytes);
+    }
+    return static_cast<int>(std::max<uint64_t>(k, 1));
+}
+
+namespace {
+
+// Whisper compute buffers, onnxruntime and heap outside the models.
+constexpr uint64_t PP_PROCESS_BYTES = 768ull << 20;
+
+#if RECMEET_USE_LLAMA
+// A local summary's KV cache at the default context: 1 GiB at f16.
+uint64_t llm_kv_bytes(const Config& cfg) {
+    constexpr uint64_t PP_LLM_KV_BYTES = 1ull << 30;
+    const uint64_t kv_div = cfg.llm_kv_type == "q4_0" ? 4 : cfg.llm_kv_type == "q8_0" ? 2 : 1;
+    return PP_LLM_KV_BYTES / kv_div;
+}
+#endif
+
+// `threads` for `step`, about to start, under the power policy: reduced
+// on battery, halved while the host is thermally throttled.
+int powered_step_threads(const Config& cfg, const char* step, int threads) {
+    BatteryPolicy policy = BatteryPolicy::Reduce;
+    parse_battery_policy(cfg.pp_on_battery, policy);
+    const PowerState power = read_power_state();
+    const int n = power_threads(threads, power, policy);
+    if (n != threads)
+        log_info("%s%s: %s on %d of %d threads",
+                 power_reduced(power, policy) ? "On battery" : "Thermal throttling",
+                 power_reduced(power, policy) && power.thermal_throttled
+                     ? ", thermal throttling" : "",
+                 step, n, threads);
+    return n;
+}
+
+#if RECMEET_USE_SHERPA
+// `threads` for `step`, about to start, halved while memory is tight.
+int governed_step_threads(const char* step, int threads) {
+    const MemoryLevel level = classify_memory(sample_memory());
+    const int n = governed_threads(threads, level);
+    if (n != threads)
+        log_info("Memory %s: %s on %d of %d threads", memory_level_name(level), step, n, threads);
+    return n;
+}
+#endif
+
+#if RECMEET_USE_LLAMA
+// Throw PostprocessDeferred when the local summary would not fit beside
+// what this process holds but would in a fresh one. Only with a fresh
+// process coming (postprocess_deferral_enabled()) and the stage cache on
+// (`summary_key` set), so the rerun skips every stage done here.
+void defer_summary_if_short(const Config& cfg, const std::string& summary_key) {
+    if (!postprocess_deferral_enabled() || summary_key.empty()) return;
+    const MemorySample mem = sample_memory();
+    uint64_t need = llm_kv_bytes(cfg);
+    for (const std::string& name : {cfg.llm_model, cfg.llm_draft_model}) {
+        if (name.empty()) continue;
+        try {
+            std::error_code ec;
+            const uintmax_t size = fs::file_size(ensure_llama_model(name), ec);
+            if (!ec) need += size;
+        } catch (const RecmeetError&) {
+        }
+    }
+    MemorySample fresh = mem;
+    fresh.rss_bytes = PP_PROCESS_BYTES;
+    if (memory_fits(mem, need) || !memory_fits(fresh, need)) return;
+    log_warn("Memory %s: the summary needs ~%llu MB beside %llu MB of %llu MB; "
+             "finishing in a fresh process", memory_level_name(classify_memory(mem)),
+             (unsigned long long)(need >> 20), (unsigned long long)(mem.rss_bytes >> 20),
+             (unsigned long long)(mem.ceiling_bytes >> 20));
+    throw PostprocessDeferred("Summary deferred to a fresh process");
+}
+#endif
+
+} // anonymous namespace
+
+PpFootprint estimate_pp_footprint(const Config& cfg, size_t audio_samples,
+                                  uint64_t model_bytes) {
+    PpFootprint fp;
+    fp.model_bytes = model_bytes;
+    fp.threads = cfg.threads > 0 ? cfg.threads : default_thread_count();
+    fp.bytes = PP_PROCESS_BYTES + model_bytes + audio_samples * sizeof(float);
+#if RECMEET_USE_SHERPA
+    if (cfg.diarize) {
+        const DiarizeChunking chunking = resolve_diarize_chunking(cfg);
+        uint64_t peak = estimate_diarize_peak_bytes(audio_samples, chunking.chunk_minutes,
+                                                     chunking.overlap_sec);
+        if (diarize_uses_chunks(cfg, audio_samples) && cfg.diarize_parallel_chunks > 1)
+            peak *= static_cast<uint64_t>(cfg.diarize_parallel_chunks);
+        fp.bytes += peak;
+    }
+#endif
+#if RECMEET_USE_LLAMA
+    if (!cfg.no_summary && !cfg.llm_model.empty())
+        fp.bytes += llm_kv_bytes(cfg);
+#endif
+    return fp;
+}
+
+PpFootprint estimate_job_footprint(const Config& cfg, const fs::path& audio_path) {
+    // The 16 kHz samples the recording decodes to, from its header. Its
+    // size misleads: a FLAC, Opus or speech-only archive is far smaller on
+    // disk, a 48 kHz stereo import far larger. The size as 16-bit samples
+    // is the fallback for a header that cannot be read.
+    const AudioProbe probe = probe_audio(audio_path, 0);
+    std::error_code ec;
+    size_t audio_samples = static_cast<size_t>(probe.duration_sec * SAMPLE_RATE);
+    if (!probe.readable) {
+        const uintmax_t audio_bytes = fs::file_size(audio_path, ec);
+        audio_samples = ec ? 0 : static_cast<size_t>(audio_bytes / sizeof(int16_t));
+    }
+    uint64_t model_bytes = 0;
+    for (const auto& m : list_cached_models()) {
+        if (m.category == "whisper" && m.cached &&
+            (m.name == cfg.whisper_model || m.name == cfg.whisper_draft_model))
+            model_bytes += static_cast<uint64_t>(m.size_bytes);
+    }
+#if RECMEET_USE_LLAMA
+    if (!cfg.no_summary) {
+        for (const std::string& name : {cfg.llm_model, cfg.llm_draft_model}) {
+            if (name.empty()) continue;
+            try {
+                const uintmax_t size = fs::file_size(ensure_llama_model(name), ec);
+                if (!ec) model_bytes += size;
+            } catch (const RecmeetError&) {
+            }
+        }
+    }
+#endif
+    return estimate_pp_footprint(cfg, audio_samples, model_bytes);
+}
+
+bool admit_pp_job(const PpFootprint& next, const PpLoad& others, bool slot_warm,
+                  int max_jobs, uint64_t budget_bytes, int cores) {
+    if (others.jobs + 1 > std::max(max_jobs, 1)) return false;
+    if (others.jobs == 0 && others.paused == 0 && (slot_warm || !others.idle_warm)) return true;
+    if (budget_bytes > 0 && others.bytes + next.bytes > budget_bytes) return false;
+    return others.jobs == 0 || others.threads + next.threads <= std::max(cores, 1);
+}
+
+const char* pp_job_class_name(PpJobClass cls) {
+    switch (cls) {
+    case PpJobClass::Interactive: return "interactive";
+    case PpJobClass::Reprocess: return "reprocess";
+    case PpJobClass::Batch: return "batch";
+    }
+    return "interactive";
+}
+
+PpJobClass pp_job_class(const Config& cfg) {
+    if (cfg.batch_mode) return PpJobClass::Batch;
+    if (!cfg.reprocess_dir.empty()) return PpJobClass::Reprocess;
+    return PpJobClass::Interactive;
+}
+
+bool pp_may_preempt(PpJobClass next, PpJobClass running) {
+    return next == PpJobClass::Interactive && running == PpJobClass::Batch;
+}
+
+PpCoalesce pp_coalesce(bool queued, bool running, bool same_inputs) {
+    if (queued) return PpCoalesce::Queued;
+    if (running && same_inputs) return PpCoalesce::Running;
+    return PpCoalesce::Enqueue;
+}
+
+std::string transcript_stage_key(const Config& cfg, const std::string& audio_hash,
+                                 const std::string& initial_prompt) {
+    StageKey key(STAGE_TRANSCRIPT);
+    key.add("audio", audio_hash)
+       .add("model", cfg.whisper_model)
+       .add("language", cfg.language)
+       .add("prompt", initial_prompt);
+    if (cfg.language.empty())
+        key.add("language_pin_sec", cfg.language_pin_sec);
+    if (!cfg.whisper_draft_model.empty())
+        key.add("draft_model", cfg.whisper_draft_model)
+           .add("draft_logprob", cfg.draft_logprob);
+#if RECMEET_USE_SHERPA
+    // VAD decides which windows whisper sees.
+    key.add("vad", cfg.vad ? 1 : 0);
+    if (cfg.vad) {
+        key.add("vad_threshold", cfg.vad_threshold)
+           .add("vad_min_silence", cfg.vad_min_silence)
+           .add("vad_min_speech", cfg.vad_min_speech)
+           .add("vad_max_speech", cfg.vad_max_speech)
+           .add("vad_pack", cfg.vad_pack ? 1 : 0);
+    }
+#endif
+    return key.digest();
+}
+
+std::string diarization_stage_key(const Config& cfg, const std::string& audio_hash,
+                                  const std::string& context_text) {
+    // The resolved speaker target covers --num-speakers, the context's
+    // participant count and max_auto_speakers, as run_diarization() sees them.
+    const char* target_source = "";
+    int target = resolve_target_speakers(cfg.num_speakers,
+                                         parse_context_participants(context_text),
+                                         cfg.max_auto_speakers, &target_source);
+    const DiarizeChunking chunking = resolve_diarize_chunking(cfg);
+    StageKey key(STAGE_DIARIZATION);
+    key.add("audio", audio_hash)
+       .add("num_speakers", cfg.num_speakers)
+       .add("target_speakers", target)
+       .add("target_source", target_source)
+       .add("cluster_threshold", cfg.cluster_threshold)
+       .add("chunk_minutes", chunking.chunk_minutes)
+       .add("chunk_overlap_sec", chunking.overlap_sec)
+       .add("stitch_threshold", cfg.stitch_threshold)
+       .add("collapse_threshold", cfg.collapse_threshold)
+       .add("min_cluster_duration_sec", cfg.min_cluster_duration_sec);
+#if RECMEET_USE_SHERPA
+    add_speech_only_key(key, cfg);
+#endif
+    return key.digest();
+}
+
+std::string clustering_stage_key(const Config& cfg, const std::string& audio_hash,
+                                 bool chunked) {
+    // Only what sherpa itself sees; stitching, collapse and the duration
+    // filter are redone from the stage (cluster_diarization()).
+    const DiarizeChunking chunking = resolve_diarize_chunking(cfg);
+    StageKey key(STAGE_CLUSTERING);
+    key.add("audio", audio_hash)
+       .add("cluster_threshold", cfg.cluster_threshold)
+       .add("chunked", chunked ? 1 : 0);
+    if (chunked) {
+        key.add("chunk_minutes", chunking.chunk_minutes)
+           .add("chunk_overlap_sec", chunking.overlap_sec);
+        // Shared overlap windows change the centroids, not the segments;
+        // keys without it stay those of earlier runs.
+        if (cfg.diarize_share_overlap) key.add("share_overlap", 1);
+    } else
+        key.add("num_speakers", cfg.num_speakers);  // sherpa's cluster count
+#if RECMEET_USE_SHERPA
+    add_speech_only_key(key, cfg);
+#endif
+    return key.digest();
+}
+
+std::string summary_stage_key(const Config& cfg, const std::string& transcript_text,
+                              const std::string& context_text,
+                              const std::string& rolling_notes) {
+    StageKey key(STAGE_SUMMARY);
+    // Speaker labels by their order of appearance only: a relabel keeps the
+    // key, and the cached summary gets the new names (rename_speakers()).
+    key.add("prompt", hash_text(std::string(summary_system_prompt()) + "\n" +
+                                build_user_prompt(anonymize_speakers(transcript_text),
+                                                  context_text)));
+    if (!rolling_notes.empty())  // refined from notes taken while recording
+        key.add("rolling", hash_text(rolling_notes));
+    if (cfg.summary_chunk_tokens > 0)  // where a long transcript is split
+        key.add("chunk_tokens", cfg.summary_chunk_tokens);
+#if RECMEET_USE_LLAMA
+    if (!cfg.llm_model.empty())
+        return key.add("llm_model", cfg.llm_model).digest();
+#endif
+    return key.add("provider", cfg.provider)
+              .add("api_url", cfg.api_url)
+              .add("api_model", cfg.api_model)
+              .digest();
+}
+
+namespace {
+
+// SummaryCheckpoint on the STAGE_SUMMARY_PARTS file, installed for one
+// summary. Each step is saved as it completes, so a child killed partway
+// through a long map loses only the steps in flight.
+class StageSummaryCheckpoint : public SummaryCheckpoint {
+public:
+    StageSummaryCheckpoint(fs::path path, std::string key)
+        : path_(std::move(path)), key_(std::move(key)) {
+        if (load_summary_parts_stage(path_, key_, responses_) && !responses_.empty())
+            log_info("Summary: resuming with %zu step(s) from %s", responses_.size(),
+                     path_.filename().c_str());
+        set_summary_checkpoint(this);
+    }
+    ~StageSummaryCheckpoint() override { set_summary_checkpoint(nullptr); }
+
+    StageSummaryCheckpoint(const StageSummaryCheckpoint&) = delete;
+    StageSummaryCheckpoint& operator=(const StageSummaryCheckpoint&) = delete;
+
+    bool find(const std::string& prompt, std::string& response) override {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = responses_.find(hash_text(prompt));
+        if (it == responses_.end()) return false;
+        response = it->second;
+        return true;
+    }
+
+    void put(const std::string& prompt, const std::string& response) override {
+        std::lock_guard<std::mutex> lock(mu_);
+        responses_[hash_text(prompt)] = response;
+        try {
+            save_summary_parts_stage(path_, key_, responses_);
+        } catch (const RecmeetError& e) {
+            log_warn("Could not save summary checkpoint: %s", e.what());
+        }
+    }
+
+    // The summary stage holds the result now.
+    void discard() {
+        std::error_code ec;
+        fs::remove(path_, ec);
+    }
+
+private:
+    fs::path path_;
+    std::string key_;
+    std::mutex mu_;
+    std::map<std::string, std::string> responses_;
+};
+
+} // anonymous namespace
+
+namespace {
+
+// Where API summaries are sent: api_url, else the provider's endpoint.
+std::string summary_api_url(const Config& cfg) {
+    if (!cfg.api_url.empty()) return cfg.api_url;
+    const auto* prov = find_provider(cfg.provider);
+    if (prov) return std::string(prov->base_url) + "/chat/completions";
+    return "https://api.x.ai/v1/chat/completions";
+}
+
+// Prompt tokens of a rolling step or the refine after it.
+int rolling_summary_tokens(const Config& cfg) {
+    return cfg.summary_chunk_tokens > 0 ? cfg.summary_chunk_tokens : ROLLING_SUMMARY_TOKENS;
+}
+
+// A completer over the summary backend `cfg` selects, as the summary step
+// picks it: the local model, else the API; empty when there is neither.
+// `draft` adds the speculative-decoding draft model to a local one.
+SummaryCompleter summary_completer(const Config& cfg, int threads, bool draft) {
+#if RECMEET_USE_LLAMA
+    if (!cfg.llm_model.empty()) {
+        fs::path draft_path;
+        if (draft && !cfg.llm_draft_model.empty()) {
+            try {
+                draft_path = ensure_llama_model(cfg.llm_draft_model);
+            } catch (const std::exception& e) {
+                log_warn("Draft model unavailable, generating without it: %s", e.what());
+            }
+        }
+        return local_summary_completer(ensure_llama_model(cfg.llm_model), threads, cfg.llm_mmap,
+                                       rolling_summary_tokens(cfg), draft_path,
+                                       {cfg.llm_kv_type, cfg.llm_batch, cfg.llm_ubatch,
+                                        cfg.llm_gpu_layers, cfg.backend_bench});
+    }
+#else
+    (void)threads;
+    (void)draft;
+#endif
+    if (!cfg.api_key.empty())
+        return http_summary_completer(summary_api_url(cfg), cfg.api_key, cfg.api_model);
+    return {};
+}
+
 void display_elapsed(StopToken& stop) {
     if (!isatty(STDERR_FILENO)) return;  // no timer under systemd/journald
     auto start = std::chrono::steady_clock::now();
@@ -255,17 +755,22 @@ void display_elapsed(StopToken& stop) {
 } // anonymous namespace
 
 fs::path resolve_caption_model_dir(const std::string& name) {
-    // Default model directory name pinned by Phase 0.2. Phase 4 will
-    // expand this into proper config plumbing; for now this string is the
-    // single source of truth.
-    constexpr const char* kDefaultCaptionModel = "en-2023-06-26";
-    std::string subdir = name.empty() ? std::string(kDefaultCaptionModel) : name;
+    // The directory ensure_caption_model() downloads into, so an `-int8`
+    // variant resolves to its base model's files.
+    return caption_model_dir(name);
+}
 
-    const char* home = std::getenv("HOME");
-    fs::path base = home && home[0]
-        ? fs::path(home) / ".local" / "share" / "recmeet"
-        : fs::path("/tmp") / "recmeet";
-    return base / "models" / "sherpa" / "online" / subdir;
+CaptionEngine::Options caption_engine_options(const Config& cfg) {
+    CaptionEngine::Options opts;
+    opts.model_dir = resolve_caption_model_dir(cfg.caption_model).string();
+    opts.int8 = caption_model_is_int8(cfg.caption_model);
+    opts.int8_fallback = cfg.caption_int8_fallback && !opts.int8;
+    opts.num_threads = cfg.caption_threads;
+    opts.keep_warm = cfg.caption_keep_warm;
+    opts.lock_memory = cfg.caption_mlock;
+    if (cfg.pin_threads)
+        opts.cpus = plan_cpu_placement(host_cpu_topology(), CpuClass::Light).cpus;
+    return opts;
 }
 
 namespace {
@@ -276,9 +781,11 @@ namespace {
 // ordering: the producer-side callback is unsubscribed first, THEN the
 // engine is stopped (which joins its worker after draining the ring).
 //
-// In dual-mode recordings the engine is wired to the **monitor** capture
-// (remote-speaker comprehension); in mic-only recordings it falls back
-// to the mic capture. The template parameter resolves the bifurcation.
+// In dual-mode recordings the engine decodes both captures, the
+// **monitor** (remote speakers) through on_audio_chunk and the mic through
+// its on_source_audio sink, as two streams against one recognizer; results
+// carry their CaptionSource. In mic-only recordings only the mic is
+// wired. The template parameter resolves the monitor-capture bifurcation.
 //
 // Phase 6 — the engine's single result callback is fanned out via a
 // `CaptionFanoutAdapter` heap-owned by this RAII wrapper: it forwards every
@@ -296,8 +803,12 @@ struct CaptionFanoutAdapter {
     // Sidecar writer + per-cue (start_ms, end_ms) tracker. The writer is
     // owned by the adapter so the destruction order is deterministic:
     // engine.stop() (joins the worker) -> adapter dtor (closes the file).
+    // Cues are timed per source, so one side's final never shortens the
+    // other's cue. `label_sources` voice-tags cues with their source when
+    // the engine decodes more than one.
     std::unique_ptr<VttWriter> vtt;
-    VttCueTimer cue_timer;
+    VttCueTimer cue_timer[2];
+    bool label_sources = false;
 };
 
 // Engine result callback installed by try_start_caption_engine when the
@@ -310,12 +821,15 @@ inline void caption_fanout_on_result(const CaptionResult& r, void* ud) {
         a->downstream_on_result(r, a->downstream_result_ud);
     }
     if (!r.is_partial && a->vtt) {
-        auto [start_ms, end_ms] = a->cue_timer.next(r.timestamp_ms);
-        // append() returns false on I/O error and sets last_error(); we
-        // log and continue — captions are non-critical and must never abort
-        // recording.
-        if (!a->vtt->append(start_ms, end_ms, r.text, /*is_partial=*/false)) {
-            log_warn("captions: VTT append failed (%s) — continuing without sidecar",
+        auto [start_ms, end_ms] =
+            a->cue_timer[static_cast<size_t>(r.source) & 1].next(r.timestamp_ms);
+        // append() only queues (the writer thread does the I/O) and
+        // returns false when the cue was dropped or the sidecar is failing;
+        // we log and continue — captions are non-critical and must never
+        // abort recording.
+        if (!a->vtt->append(start_ms, end_ms, r.text, /*is_partial=*/false,
+                            a->label_sources ? caption_source_name(r.source) : "")) {
+            log_warn("captions: VTT sidecar not keeping up (%s) — continuing",
                      a->vtt->last_error().c_str());
         }
     }
@@ -324,13 +838,23 @@ inline void caption_fanout_on_result(const CaptionResult& r, void* ud) {
 template <typename Capture>
 class ActiveCaptionEngine {
 public:
+    /// `mic`, in dual mode, feeds the engine's Mic stream alongside
+    /// `capture`'s (the engine's first source).
     ActiveCaptionEngine(std::unique_ptr<CaptionEngine> engine, Capture* capture,
-                        std::unique_ptr<CaptionFanoutAdapter> adapter = nullptr)
-        : engine_(std::move(engine)), capture_(capture),
+                        std::unique_ptr<CaptionFanoutAdapter> adapter = nullptr,
+                        PipeWireCapture* mic = nullptr)
+        : engine_(std::move(engine)), capture_(capture), mic_(mic),
           adapter_(std::move(adapter)) {
         if (capture_ && engine_) {
             capture_->set_audio_callback(&CaptionEngine::on_audio_chunk, engine_.get());
         }
+        if (engine_) publish_caption_engine(engine_.get());
+        void* mic_sink = engine_ ? engine_->audio_sink(CaptionSource::Mic) : nullptr;
+        if (mic_ && mic_sink) {
+            mic_->set_audio_callback(&CaptionEngine::on_source_audio, mic_sink);
+        } else {
+            mic_ = nullptr;
+        }
     }
     ~ActiveCaptionEngine() {
         // Belt-and-braces — capture has already been .stop()'d at the
@@ -340,20 +864,27 @@ public:
         if (capture_) {
             capture_->set_audio_callback(nullptr, nullptr);
         }
+        if (mic_) {
+            mic_->set_audio_callback(nullptr, nullptr);
+        }
         if (engine_) {
+            publish_caption_engine(nullptr);
             engine_->stop();
         }
-        // Adapter (and its VttWriter, if any) destroyed last — closes the
-        // sidecar fd after the engine worker has joined.
+        // Adapter (and its VttWriter, if any) destroyed last — writes the
+        // queued cues and closes the sidecar after the engine worker has
+        // joined.
     }
     ActiveCaptionEngine(const ActiveCaptionEngine&) = delete;
     ActiveCaptionEngine& operator=(const ActiveCaptionEngine&) = delete;
 
     bool engine_running() const { return engine_ && engine_->is_running(); }
+    bool engine_backlogged() const { return engine_ && engine_->backlogged(); }
 
 private:
     std::unique_ptr<CaptionEngine> engine_;
     Capture* capture_ = nullptr;
+    PipeWireCapture* mic_ = nullptr;
     std::unique_ptr<CaptionFanoutAdapter> adapter_;
 };
 
@@ -367,16 +898,19 @@ private:
 // so the caller can hand its lifetime to ActiveCaptionEngine. When
 // `meeting_dir` is empty (e.g. a test that doesn't want a sidecar) the
 // engine is wired directly to the daemon's hooks — no adapter, no writer.
+//
+// `dual` decodes the monitor (first) and the mic as two streams of the one
+// recognizer; otherwise the engine decodes the mic alone.
 std::unique_ptr<CaptionEngine> try_start_caption_engine(
         const Config& cfg, const CaptionHooks* hooks,
         const fs::path& meeting_dir,
-        std::unique_ptr<CaptionFanoutAdapter>& out_adapter) {
+        std::unique_ptr<CaptionFanoutAdapter>& out_adapter,
+        bool dual = false) {
     out_adapter.reset();
     if (!hooks) return nullptr;
     auto engine = std::make_unique<CaptionEngine>();
-    CaptionEngine::Options opts;
-    opts.model_dir = resolve_caption_model_dir(cfg.caption_model).string();
-    opts.num_threads = 1;  // Phase 4 will surface a config knob.
+    CaptionEngine::Options opts = caption_engine_options(cfg);
+    if (dual) opts.sources = {CaptionSource::Monitor, CaptionSource::Mic};
 
     // Choose the result-callback wiring: direct (no sidecar) or fan-out.
     CaptionResultCallback result_cb = hooks->on_result;
@@ -387,7 +921,8 @@ std::unique_ptr<CaptionEngine> try_start_caption_engine(
         adapter->downstream_on_result = hooks->on_result;
         adapter->downstream_result_ud = hooks->result_ud;
         adapter->vtt = std::make_unique<VttWriter>(
-            meeting_dir / "captions.vtt", cfg.caption_normalize_display);
+            meeting_dir / CAPTIONS_VTT_NAME, cfg.caption_normalize_display);
+        adapter->label_sources = dual;
         result_cb = &caption_fanout_on_result;
         result_ud = adapter.get();
     }
@@ -404,8 +939,8 @@ std::unique_ptr<CaptionEngine> try_start_caption_engine(
         }
         return nullptr;
     }
-    log_info("captions: streaming engine started (model=%s)",
-             opts.model_dir.c_str());
+    log_info("captions: streaming engine started (model=%s, %s)",
+             opts.model_dir.c_str(), dual ? "mic + monitor" : "mic");
     // Phase 2: notify the daemon that the engine + adapter are constructed so
     // it can broadcast `caption.started` to all subscribed clients. Mirrors
     // the on_engine_error null-check pattern above so test harnesses that
@@ -417,19 +952,867 @@ std::unique_ptr<CaptionEngine> try_start_caption_engine(
     return engine;
 }
 
+// Cancel-path helper: finalize a capture's spool or a streaming mixer
+// without letting an I/O error escape — the directory is about to be
+// discarded anyway.
+void close_spool_quietly(PipeWireCapture& cap) {
+    try {
+        cap.finish_spool();
+    } catch (const std::exception& e) {
+        log_debug("pipeline: spool close on cancel: %s", e.what());
+    }
+}
+
+void close_spool_quietly(StreamingMixer& mixer) {
+    try {
+        mixer.finish();
+    } catch (const std::exception& e) {
+        log_debug("pipeline: spool close on cancel: %s", e.what());
+    }
+}
+
+// One capture of a recording, as the replay report sees it.
+struct ReplayCapture {
+    const char* label;
+    const CaptureReplay* replay;  // nullptr for a device
+    uint64_t dropped_frames;      // RT ring overflow; 0 for pa_simple
+};
+
+// Whether every replayed capture has delivered its WAV: the recording has
+// no more audio coming. False when nothing replays.
+bool replays_finished(std::initializer_list<const CaptureReplay*> replays) {
+    bool any = false;
+    for (const auto* r : replays) {
+        if (!r) continue;
+        if (!r->finished()) return false;
+        any = true;
+    }
+    return any;
+}
+
+// replay_<ts>.json: what each replay delivered and how late, the ring
+// drops, and the caption latencies. Called after the captures stop and
+// before the caption engine is torn down.
+void save_replay_report(const fs::path& audio_path, std::initializer_list<ReplayCapture> captures) {
+    JsonMap m;
+    for (const auto& c : captures) {
+        if (!c.replay) continue;
+        const ReplayStats s = c.replay->stats();
+        add_replay_stats(m, c.label, s);
+        m[std::string(c.label) + ".dropped_frames"] = static_cast<int64_t>(c.dropped_frames);
+        log_info("replay: %s %.1fs of audio in %.1fs (%.2fx), %llu chunks, %llu late "
+                 "(p99 %lld us), %llu frames dropped", c.label, s.audio_sec, s.wall_sec,
+                 s.achieved_speed(), static_cast<unsigned long long>(s.chunks),
+                 static_cast<unsigned long long>(s.late_chunks),
+                 static_cast<long long>(s.late_us.p99),
+                 static_cast<unsigned long long>(c.dropped_frames));
+    }
+    if (m.empty()) return;
+    m["stopped_unix_ms"] = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    CaptionStats captions;
+    if (caption_engine_stats(captions)) add_caption_stats(m, captions);
+    try {
+        write_text_file_atomic(replay_report_path(audio_path), serialize_json_map(m) + "\n");
+    } catch (const std::exception& e) {
+        log_warn("Could not save the replay report: %s", e.what());
+    }
+}
+
+// RECMEET_RECORD_JITTER: the callback profile a device delivered, for
+// later replays (`replay:<wav>?jitter=<file>`).
+template <typename Capture>
+void save_recorded_jitter(const Capture* cap, const fs::path& path) {
+    if (!cap) return;
+    const JitterProfile profile = cap->recorded_jitter();
+    if (profile.ticks.empty()) return;
+    try {
+        save_jitter_profile(path, profile);
+        log_info("Recorded %zu capture callbacks to %s", profile.ticks.size(), path.c_str());
+    } catch (const std::exception& e) {
+        log_warn("Could not save the jitter profile: %s", e.what());
+    }
+}
+
+// The channel envelope only serves diarization.local_speaker; a meeting
+// without it is diarized from the mix as before.
+void save_envelope_quietly(const fs::path& audio_path, const ChannelEnvelope& envelope) {
+    try {
+        save_channel_envelope(channel_envelope_path(audio_path), envelope);
+    } catch (const std::exception& e) {
+        log_warn("Could not save channel envelope: %s", e.what());
+    }
+}
+
+VadConfig vad_config_from(const Config& cfg) {
+    VadConfig vad_cfg;
+    vad_cfg.threshold = cfg.vad_threshold;
+    vad_cfg.min_silence_duration = cfg.vad_min_silence;
+    vad_cfg.min_speech_duration = cfg.vad_min_speech;
+    vad_cfg.max_speech_duration = cfg.vad_max_speech;
+    return vad_cfg;
+}
+
+// Whisper's initial_prompt: enrolled speaker names + vocabulary hints.
+std::string whisper_initial_prompt(const Config& cfg) {
+    std::vector<std::string> names;
+    if (cfg.speaker_id) {
+        fs::path db_dir = cfg.speaker_db.empty()
+            ? default_speaker_db_dir() : cfg.speaker_db;
+        names = list_speakers(db_dir);
+    }
+    return build_initial_prompt(names, cfg.vocabulary);
+}
+
+// The manifest's keys from the prompt and context run_postprocessing()
+// resolved for the meeting.
+MeetingManifest manifest_inputs(const Config& cfg, const std::string& audio_hash,
+                                const std::string& initial_prompt,
+                                const std::string& context_text) {
+    MeetingManifest m;
+    m.audio_hash = audio_hash;
+    m.transcript_key = transcript_stage_key(cfg, audio_hash, initial_prompt);
+#if RECMEET_USE_SHERPA
+    if (cfg.diarize)
+        m.diarization_key = diarization_stage_key(cfg, audio_hash, context_text);
+#endif
+    if (!cfg.no_summary)
+        m.summary_key = summary_stage_key(cfg, "", context_text);
+    return m;
+}
+
+// Without a configured language, detect it once on the first
+// cfg.language_pin_sec seconds of speech in `windows`, for every window to
+// be decoded in (Config::language_pin_sec). Empty guess when pinning is off.
+LanguageGuess pin_language(const Config& cfg, WhisperModel& model, const SampleSource& audio,
+                           const std::vector<TranscribeWindow>& windows, int threads) {
+    if (!cfg.language.empty() || cfg.language_pin_sec <= 0) return {};
+    auto guess = detect_language(model, audio, windows,
+                                 static_cast<size_t>(cfg.language_pin_sec) * SAMPLE_RATE,
+                                 threads);
+    if (!guess.language.empty())
+        log_info("Language: %s (p=%.2f), pinned for the meeting",
+                 guess.language.c_str(), guess.prob);
+    return guess;
+}
+
+// Two-pass decode of `windows` (Config::whisper_draft_model): the draft
+// model decodes every window, then `model` re-decodes the ones the draft
+// was unsure of (draft_window_confident) and its results replace the
+// draft's. opts.on_progress sees the draft pass as 0-50 % and the
+// re-decode as 50-100 %.
+TranscriptResult transcribe_two_pass(const Config& cfg, WhisperModel& model,
+                                     const SampleSource& audio,
+                                     const std::vector<PackedWindow>& windows,
+                                     const TranscribeOptions& opts, DraftPassStats& stats) {
+    using clock = std::chrono::steady_clock;
+    auto seconds_since = [](clock::time_point t0) {
+        return std::chrono::duration<double>(clock::now() - t0).count();
+    };
+    auto scaled = [&opts](int base) {
+        std::function<void(int)> cb;
+        if (opts.on_progress)
+            cb = [&opts, base](int pct) { opts.on_progress(base + pct / 2); };
+        return cb;
+    };
+
+    stats = DraftPassStats{};
+    stats.windows = windows.size();
+    for (const auto& w : windows) stats.samples += w.length;
+
+    auto t0 = clock::now();
+    std::vector<TranscriptResult> results;
+    {   // draft model scope
+        const fs::path draft_path = ensure_whisper_model(cfg.whisper_draft_model);
+        auto draft = acquire_whisper_draft_model(draft_path, whisper_gpu_for(cfg, draft_path));
+        TranscribeOptions draft_opts = opts;
+        draft_opts.on_progress = scaled(0);
+        results = transcribe_each_window(*draft, audio, windows, cfg.whisper_workers, draft_opts);
+    }
+    stats.draft_sec = seconds_since(t0);
+
+    std::vector<size_t> unsure;
+    std::vector<PackedWindow> redo;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (draft_window_confident(results[i], cfg.draft_logprob)) continue;
+        unsure.push_back(i);
+        redo.push_back(windows[i]);
+        stats.redecoded_samples += windows[i].length;
+    }
+    stats.redecoded = redo.size();
+    log_info("Draft pass (%s): %zu of %zu windows below confidence, re-decoding with %s",
+             cfg.whisper_draft_model.c_str(), redo.size(), windows.size(),
+             cfg.whisper_model.c_str());
+
+    t0 = clock::now();
+    TranscribeOptions redo_opts = opts;
+    redo_opts.on_progress = scaled(50);
+    auto redone = transcribe_each_window(model, audio, redo, cfg.whisper_workers, redo_opts);
+    stats.redecode_sec = seconds_since(t0);
+    for (size_t k = 0; k < unsure.size(); ++k)
+        results[unsure[k]] = std::move(redone[k]);
+    if (opts.on_progress) opts.on_progress(100);
+
+    TranscriptResult merged{};
+    for (auto& r : results) {
+        for (auto& seg : r.segments)
+            merged.segments.push_back(std::move(seg));
+        if (merged.language.empty())
+            merged.language = r.language;
+        merged.repetition_aborts += r.repetition_aborts;
+    }
+    merged.language_prob = 0.0f;
+
+    if (stats.full_estimate_sec() >= 0.0)
+        log_info("Two-pass transcription: %.1fs draft + %.1fs re-decode, ~%.1fs saved "
+                 "vs decoding everything with %s",
+                 stats.draft_sec, stats.redecode_sec, stats.saved_sec(),
+                 cfg.whisper_model.c_str());
+    else
+        log_info("Two-pass transcription: %.1fs draft, nothing to re-decode",
+                 stats.draft_sec);
+    return merged;
+}
+
+// Streaming VAD over the meeting audio spool while recording (cfg.vad in
+// spool mode). The recording loop pumps it every tick, and finish() writes
+// the speech-segment index next to the audio so postprocessing skips its
+// VAD pass. With cfg.live_transcribe it also feeds each closed segment to
+// a LiveTranscriber, whose transcript a RollingSummarizer folds into notes
+// with cfg.rolling_summary_minutes, and with cfg.live_diarize the spool's
+// length to a LiveDiarizer. Best-effort throughout: any failure disables it with a
+// warning and postprocessing runs VAD (and whisper, and diarization) over
+// the finished file as before.
+class RecordingVad {
+public:
+    void start(const Config& cfg, const AudioSpool& spool, const fs::path& audio_path) {
+#if RECMEET_USE_SHERPA
+        try {
+            cfg_ = vad_config_from(cfg);
+            src_ = std::make_unique<SpoolSampleSource>(spool);
+            // One thread: Silero keeps up with real time on a single core
+            // and must not compete with the capture threads.
+            vad_ = std::make_unique<StreamingVad>(*src_, cfg_, 1);
+            if (cfg.pin_threads)
+                vad_cpus_ = plan_cpu_placement(host_cpu_topology(), CpuClass::Light);
+            log_debug("pipeline: streaming VAD started");
+        } catch (const std::exception& e) {
+            log_warn("Streaming VAD unavailable (%s); VAD will run after recording", e.what());
+            reset();
+            return;
+        }
+        if (cfg.live_transcribe) {
+            LiveTranscriber::Options opts;
+            opts.key = {cfg.whisper_model, cfg.language, whisper_initial_prompt(cfg)};
+            opts.pack = cfg.vad_pack;
+            // A couple of threads at idle priority: enough to keep pace
+            // with speech on most hosts without crowding the captures.
+            int threads = cfg.threads > 0 ? cfg.threads : default_thread_count();
+            leases_.push_back(lease_threads("live_whisper", std::clamp(threads / 4, 1, 2)));
+            opts.threads = leases_.back().threads();
+            // No benchmark mid-recording: a model not measured yet keeps the GPU.
+            opts.gpu = is_whisper_model_cached(cfg.whisper_model)
+                ? whisper_gpu_for(cfg, ensure_whisper_model(cfg.whisper_model), true)
+                : cfg.whisper_gpu;
+            live_ = std::make_unique<LiveTranscriber>(
+                *src_, live_transcript_path(audio_path), std::move(opts));
+            log_info("Live transcription started (model %s)", cfg.whisper_model.c_str());
+        }
+        if (cfg.rolling_summary_minutes > 0 && !cfg.no_summary) {
+            if (!live_) {
+                log_info("Rolling summary off: it summarizes the live transcript "
+                         "(transcription.live)");
+            } else {
+                try {
+                    // Idle priority and few threads, as for live transcription.
+                    int threads = cfg.threads > 0 ? cfg.threads : default_thread_count();
+                    ThreadLease lease =
+                        lease_threads("rolling_summary", std::clamp(threads / 4, 1, 2));
+                    SummaryCompleter complete = summary_completer(cfg, lease.threads(), false);
+                    if (complete) leases_.push_back(std::move(lease));
+                    if (!complete) {
+                        log_info("Rolling summary off: no API key and no local LLM");
+                    } else {
+                        RollingSummarizer::Options opts;
+                        opts.key = {cfg.whisper_model, cfg.language, whisper_initial_prompt(cfg)};
+                        opts.interval_sec = cfg.rolling_summary_minutes * 60;
+                        opts.context = resolve_context_text(cfg, audio_path.parent_path());
+                        rolling_ = std::make_unique<RollingSummarizer>(
+                            live_transcript_path(audio_path), rolling_summary_path(audio_path),
+                            std::move(complete), std::move(opts));
+                        log_info("Rolling summary started (every %d min)",
+                                 cfg.rolling_summary_minutes);
+                    }
+                } catch (const std::exception& e) {
+                    log_warn("Rolling summary unavailable: %s", e.what());
+                }
+            }
+        }
+        if (cfg.live_diarize && cfg.diarize && diarize_speech_only(cfg)) {
+            log_info("Live diarization off: diarization.speech_only diarizes after recording");
+        } else if (cfg.live_diarize && cfg.diarize) {
+            const DiarizeChunking chunking = resolve_diarize_chunking(cfg);
+            LiveDiarizer::Options opts;
+            opts.key = {chunking.chunk_minutes, chunking.overlap_sec, cfg.cluster_threshold,
+                        cfg.diarize_share_overlap};
+            int threads = cfg.threads > 0 ? cfg.threads : default_thread_count();
+            leases_.push_back(lease_threads("live_diarize", std::clamp(threads / 4, 1, 2)));
+            opts.threads = leases_.back().threads();
+            opts.chunk_peak_bytes = estimate_diarize_peak_bytes(
+                std::numeric_limits<size_t>::max(), chunking.chunk_minutes, chunking.overlap_sec);
+            set_onnx_provider(cfg.diarize_provider);
+            set_model_hugepages(cfg.model_hugepages);
+            live_diar_ = std::make_unique<LiveDiarizer>(
+                *src_, live_diarization_path(audio_path), std::move(opts));
+            log_info("Live diarization started (%.0f min chunks)", chunking.chunk_minutes);
+        }
+#else
+        (void)cfg;
+        (void)spool;
+        (void)audio_path;
+#endif
+    }
+
+    /// `captions_backlogged`: the caption engine is behind real time, so
+    /// live transcription holds off until it catches up.
+    void pump(bool captions_backlogged) {
+#if RECMEET_USE_SHERPA
+        if (!vad_) return;
+        try {
+            // Silero runs on the pumping thread: on the efficiency cores
+            // of a hybrid CPU for the pump's length.
+            ScopedCpuPlacement pinned(vad_cpus_);
+            vad_->pump();
+        } catch (const std::exception& e) {
+            log_warn("Streaming VAD failed (%s); VAD will run after recording", e.what());
+            reset();
+            return;
+        }
+        if (live_) {
+            const auto& segs = vad_->segments();
+            if (segs.size() != offered_) {
+                std::vector<TranscribeWindow> windows;
+                windows.reserve(segs.size());
+                for (const auto& seg : segs)
+                    windows.push_back({static_cast<size_t>(seg.start_sample),
+                                       static_cast<size_t>(seg.end_sample - seg.start_sample)});
+                live_->offer(windows);
+                offered_ = segs.size();
+            }
+            live_->set_paused(captions_backlogged);
+        }
+        if (live_diar_) live_diar_->offer(src_->size());
+#else
+        (void)captions_backlogged;
+#endif
+    }
+
+    /// Finish over the finalized spool and write the index for `audio_path`.
+    void finish(const fs::path& audio_path) {
+#if RECMEET_USE_SHERPA
+        if (!vad_) return;
+        // Whatever the workers have not finished is left to postprocessing.
+        if (rolling_) {
+            size_t steps = rolling_->stop();
+            log_info("Rolling summary: %zu step(s) during recording", steps);
+            rolling_.reset();  // a local model is unloaded before postprocessing
+        }
+        if (live_) {
+            size_t done = live_->stop();
+            log_info("Live transcription: %zu whisper window(s) decoded during recording",
+                     done);
+        }
+        if (live_diar_) {
+            size_t done = live_diar_->stop();
+            log_info("Live diarization: %zu chunk(s) diarized during recording", done);
+        }
+        try {
+            auto result = vad_->finish();
+            fs::path index = vad_index_path(audio_path);
+            save_vad_index(index, result, src_->size(), cfg_);
+            log_debug("pipeline: wrote %s (%zu speech segments)",
+                      index.c_str(), result.segments.size());
+        } catch (const std::exception& e) {
+            log_warn("Streaming VAD failed (%s); VAD will run after recording", e.what());
+        }
+        reset();
+#else
+        (void)audio_path;
+#endif
+    }
+
+    void reset() {
+#if RECMEET_USE_SHERPA
+        rolling_.reset();
+        live_.reset();  // reads src_
+        live_diar_.reset();
+        vad_.reset();
+        src_.reset();
+        leases_.clear();
+        offered_ = 0;
+#endif
+    }
+
+private:
+#if RECMEET_USE_SHERPA
+    VadConfig cfg_;
+    std::unique_ptr<SpoolSampleSource> src_;
+    std::unique_ptr<StreamingVad> vad_;
+    CpuPlacement vad_cpus_;
+    std::unique_ptr<LiveTranscriber> live_;
+    std::unique_ptr<RollingSummarizer> rolling_;
+    std::unique_ptr<LiveDiarizer> live_diar_;
+    std::vector<ThreadLease> leases_;  // the live workers' threads
+    size_t offered_ = 0;
+#endif
+};
+
+// Publish the growing spool for `transcribe.clip` while the recording
+// loop runs. Null when clips are off or the spool cannot be opened.
+std::unique_ptr<ClipSourceTap> open_clip_tap(const Config& cfg, const AudioSpool& spool) {
+    if (cfg.clip_model.empty()) return nullptr;
+    try {
+        return std::make_unique<ClipSourceTap>(std::make_unique<SpoolSampleSource>(spool));
+    } catch (const std::exception& e) {
+        log_warn("clip: cannot read the recording spool: %s", e.what());
+        return nullptr;
+    }
+}
+
+template <typename Capture>
+bool captions_backlogged(const std::unique_ptr<ActiveCaptionEngine<Capture>>& caption) {
+    return caption && caption->engine_backlogged();
+}
+
+#if RECMEET_USE_SHERPA
+// The speech regions of `audio`: the index written during recording (or by
+// an earlier pass) when it matches this audio and config, else a fresh VAD
+// pass, saved as the index.
+VadResult load_or_detect_speech(const Config& cfg, const fs::path& audio_path,
+                                const SampleSource& audio, int threads) {
+    const VadConfig vad_cfg = vad_config_from(cfg);
+    const fs::path vad_index = vad_index_path(audio_path);
+    VadResult vad_result;
+    if (load_vad_index(vad_index, audio.size(), vad_cfg, vad_result)) {
+        log_info("VAD: reusing %s (%zu segments)",
+                 vad_index.filename().c_str(), vad_result.segments.size());
+        return vad_result;
+    }
+    log_debug("pipeline: running VAD");
+    vad_result = detect_speech(audio, vad_cfg, threads);
+    try {
+        save_vad_index(vad_index, vad_result, audio.size(), vad_cfg);
+    } catch (const RecmeetError& e) {
+        log_warn("Could not save VAD index: %s", e.what());
+    }
+    return vad_result;
+}
+#endif
+
 } // anonymous namespace
 
+MeetingManifest expected_meeting_manifest(const Config& cfg, const fs::path& out_dir,
+                                          const std::string& audio_hash) {
+    return manifest_inputs(cfg, audio_hash, whisper_initial_prompt(cfg),
+                           resolve_context_text(cfg, out_dir));
+}
+
+#if RECMEET_USE_SHERPA
+bool diarize_uses_chunks(const Config& cfg, size_t samples) {
+    const DiarizeChunking chunking = resolve_diarize_chunking(cfg);
+    return samples > diarize_chunk_threshold_samples(chunking.chunk_minutes,
+                                                     chunking.overlap_sec);
+}
+
+bool diarize_speech_only(const Config& cfg) {
+    return cfg.diarize_speech_only && cfg.vad;
+}
+
+std::unique_ptr<CompactedSampleSource> speech_only_source(
+        const Config& cfg, const PostprocessInput& input, const SampleSource& audio,
+        int threads, const std::vector<std::pair<double, double>>& local_spans) {
+    if (!diarize_speech_only(cfg) && local_spans.empty()) return nullptr;
+    std::vector<VadSegment> segments;
+    if (diarize_speech_only(cfg)) {
+        segments = load_or_detect_speech(cfg, input.audio_path, audio, threads).segments;
+    } else {
+        segments.push_back({0, static_cast<int32_t>(audio.size()), 0.0,
+                            static_cast<double>(audio.size()) / SAMPLE_RATE});
+    }
+    if (!local_spans.empty()) segments = subtract_spans(segments, local_spans);
+    if (segments.empty()) return nullptr;
+    auto compacted = std::make_unique<CompactedSampleSource>(audio, segments);
+    log_info("Diarization: %s, %.1f of %.1f min",
+             local_spans.empty() ? "speech only"
+             : diarize_speech_only(cfg) ? "speech only, local speaker cut out"
+             : "local speaker cut out",
+             compacted->size() / (60.0 * SAMPLE_RATE),
+             audio.size() / (60.0 * SAMPLE_RATE));
+    return compacted;
+}
+
+std::vector<std::pair<double, double>> local_speaker_spans(const Config& cfg,
+                                                           const fs::path& audio_path,
+                                                           size_t samples) {
+    if (cfg.local_speaker.empty()) return {};
+    ChannelEnvelope env;
+    const fs::path path = channel_envelope_path(audio_path);
+    if (!load_channel_envelope(path, env)) {
+        log_info("Local speaker: no channel envelope for %s; diarizing the whole mix",
+                 audio_path.filename().c_str());
+        return {};
+    }
+    const size_t expected = (samples + ENVELOPE_FRAME_SAMPLES - 1) / ENVELOPE_FRAME_SAMPLES;
+    if (env.frames() != expected) {
+        log_warn("Local speaker: %s covers %zu frames, the audio %zu; ignoring it",
+                 path.filename().c_str(), env.frames(), expected);
+        return {};
+    }
+    auto spans = local_speech_spans(env);
+    double sec = 0;
+    for (const auto& [start, end] : spans) sec += end - start;
+    log_info("Local speaker: %.1f min in %zu stretches attributed to %s from the mic",
+             sec / 60.0, spans.size(), cfg.local_speaker.c_str());
+    return spans;
+}
+
+int add_local_speaker(DiarizeResult& diar,
+                      const std::vector<std::pair<double, double>>& local_spans) {
+    int id = 0;
+    for (const auto& seg : diar.segments) id = std::max(id, seg.speaker + 1);
+    for (const auto& [start, end] : local_spans)
+        diar.segments.push_back({start, end, id});
+    std::stable_sort(diar.segments.begin(), diar.segments.end(),
+                     [](const DiarizeSegment& a, const DiarizeSegment& b) {
+                         return a.start < b.start;
+                     });
+    ++diar.num_speakers;
+    return id;
+}
+
+void uncompact_diarization(const CompactedSampleSource& speech, DiarizeResult& diar) {
+    std::vector<DiarizeSegment> segments;
+    segments.reserve(diar.segments.size());
+    for (const auto& seg : diar.segments)
+        for (const auto& [start, end] : speech.to_source_spans(seg.start, seg.end))
+            segments.push_back({start, end, seg.speaker});
+    diar.segments = std::move(segments);
+}
+
+namespace {
+
+DiarizeChunkConfig diarize_chunk_config(const Config& cfg, const PostprocessInput& input) {
+    DiarizeChunkConfig chunk_cfg;
+    const DiarizeChunking chunking = resolve_diarize_chunking(cfg);
+    chunk_cfg.chunk_minutes = chunking.chunk_minutes;
+    chunk_cfg.overlap_seconds = chunking.overlap_sec;
+    chunk_cfg.share_overlap = cfg.diarize_share_overlap;
+    chunk_cfg.stitch_threshold = cfg.stitch_threshold;
+    chunk_cfg.collapse_threshold = cfg.collapse_threshold;
+    // Phase A instrumentation: pass dump path + meeting timestamp
+    // into stitch_chunks. Empty path = no-op (hot-path negligible).
+    chunk_cfg.debug_dump_centroids_path =
+        cfg.debug_dump_centroids_path.string();
+    chunk_cfg.meeting_timestamp = input.timestamp;
+    return chunk_cfg;
+}
+
+} // anonymous namespace
+
+ClusteringStage diarize_for_clustering(const Config& cfg, const PostprocessInput& input,
+                                       const SampleSource& audio, int threads,
+                                       DiarizeProgressCallback diar_progress,
+                                       StagePerfCallback on_chunk) {
+    // T2.2 dispatch: below the chunking threshold the single-call path
+    // runs unchanged.
+    DiarizeChunkConfig chunk_cfg = diarize_chunk_config(cfg, input);
+    ClusteringStage stage;
+    stage.samples = audio.size();
+    stage.chunked = diarize_uses_chunks(cfg, audio.size());
+
+    if (stage.chunked) {
+        if (cfg.diarize_auto_chunk)
+            log_info("Diarization chunks sized to this host's memory: %.0f min, %.0f s overlap",
+                     chunk_cfg.chunk_minutes, chunk_cfg.overlap_seconds);
+        // Chunks are independent until stitching, so as many as fit in the
+        // memory budget over what the process already holds run at once.
+        // Workers beyond the first retire once memory turns tight.
+        const MemoryLevel mem_level = classify_memory(sample_memory());
+        if (cfg.diarize_parallel_chunks != 1 && mem_level != MemoryLevel::Normal) {
+            log_info("Memory %s: diarizing one chunk at a time", memory_level_name(mem_level));
+        } else if (cfg.diarize_parallel_chunks != 1) {
+            const uint64_t chunk_peak = estimate_diarize_peak_bytes(
+                audio.size(), chunk_cfg.chunk_minutes, chunk_cfg.overlap_seconds);
+            chunk_cfg.parallel_chunks = plan_diarize_parallel(
+                cfg.diarize_parallel_chunks, threads, chunk_peak,
+                static_cast<uint64_t>(read_self_rss_kb()) * 1024,
+                static_cast<uint64_t>(read_mem_available_kb()) * 1024,
+                static_cast<uint64_t>(std::max(cfg.overlap_memory_mb, 0)) << 20);
+            if (chunk_cfg.parallel_chunks > 1)
+                chunk_cfg.shed_worker = [] {
+                    return classify_memory(sample_memory()) != MemoryLevel::Normal;
+                };
+        }
+        log_debug("pipeline: diarizing chunked "
+                  "(%.1f min chunks, %.1f s overlap, threshold %.2f, %d at once)",
+                  chunk_cfg.chunk_minutes, chunk_cfg.overlap_seconds,
+                  cfg.cluster_threshold, chunk_cfg.parallel_chunks);
+        if (on_chunk)
+            chunk_cfg.on_chunk_done = [&on_chunk](size_t index, const ChunkExtents& extents,
+                                                  double wall_sec, int chunk_threads) {
+                StagePerf p;
+                p.stage = "diarize_chunk";
+                p.index = static_cast<int>(index);
+                p.wall_sec = wall_sec;
+                p.audio_sec = static_cast<double>(extents.pcm_end_samples -
+                                                  extents.pcm_start_samples) / SAMPLE_RATE;
+                p.threads = chunk_threads;
+                p.peak_rss_kb = read_self_rss_kb();
+                on_chunk(p);
+            };
+        // Chunks diarized while recording (--live-diarize) are taken as
+        // they are; diarize_chunks() checks each covers its planned PCM.
+        // They are cut from the whole recording, not a compacted view.
+        std::vector<DiarizedChunk> live_chunks;
+        if (!dynamic_cast<const CompactedSampleSource*>(&audio))
+            load_live_diarization(live_diarization_path(input.audio_path),
+                                  {chunk_cfg.chunk_minutes, chunk_cfg.overlap_seconds,
+                                   cfg.cluster_threshold, chunk_cfg.share_overlap},
+                                  live_chunks);
+        stage.chunks = diarize_chunks(audio, threads, cfg.cluster_threshold,
+                                      chunk_cfg, diar_progress, &live_chunks);
+        return stage;
+    }
+
+    log_debug("pipeline: diarizing single-shot");
+    // Phase B.4 design note: the free `diarize()` call's
+    // `num_speakers` param is forwarded to sherpa's
+    // FastClustering (the CLUSTER count knob), distinct from
+    // our post-stitch unified merge target. We pass
+    // `cfg.num_speakers` unchanged here — the operator's
+    // explicit --num-speakers wins (auto-detect = 0). Our
+    // own ceiling is applied by `apply_collapse` in
+    // cluster_diarization().
+    // Below the chunking threshold, so one float copy is
+    // bounded by chunk_minutes of audio.
+    auto samples = audio.to_float();
+    DiarizedChunk whole{};
+    whole.extents = {0, audio.size(), 0.0,
+                     static_cast<double>(audio.size()) / SAMPLE_RATE, 0.0};
+    whole.diar = diarize(samples.data(), samples.size(),
+                         cfg.num_speakers, threads, cfg.cluster_threshold,
+                         diar_progress);
+    log_debug("pipeline: single-shot diarization complete "
+              "(%zu segments, %d speakers pre-collapse)",
+              whole.diar.segments.size(), whole.diar.num_speakers);
+
+    // Phase B.3: one centroid per cluster over the cluster's segment
+    // audio, for the short-audio collapse. Extracted for every cluster,
+    // ghosts included, so a later --recluster with a lower
+    // min_cluster_duration_sec finds them; the filter only ever drops
+    // whole clusters, so the survivors' centroids are the same.
+    if (!whole.diar.segments.empty()) {
+        try {
+            whole.centroids = extract_cluster_centroids(
+                samples.data(), samples.size(), whole.diar, threads);
+        } catch (const std::exception& e) {
+            log_warn("pipeline: short-audio collapse failed: %s", e.what());
+        }
+    }
+    stage.chunks.push_back(std::move(whole));
+    return stage;
+}
+
+DiarizationOutput cluster_diarization(const Config& cfg, const PostprocessInput& input,
+                                      const ClusteringStage& stage,
+                                      const std::string& context_text) {
+    DiarizeChunkConfig chunk_cfg = diarize_chunk_config(cfg, input);
+
+    // Phase B.2: resolve `target_speakers` from the precedence
+    // chain BEFORE invoking diarize (helper exposed in
+    // pipeline.h so unit tests can exercise the formula
+    // without running the full pipeline). Order:
+    //   1. cfg.num_speakers (--num-speakers, explicit operator
+    //      override wins everything)
+    //   2. context_speaker_count (Phase C parser; stub returns 0
+    //      until Phase C lands; reads the resolved context_text
+    //      lifted up by Phase B.0)
+    //   3. cfg.max_auto_speakers (default cap, 8 unless overridden)
+    int context_speaker_count =
+        parse_context_participants(context_text);
+    const char* target_source = nullptr;
+    int target_speakers = resolve_target_speakers(
+        cfg.num_speakers, context_speaker_count,
+        cfg.max_auto_speakers, &target_source);
+    log_info("Speaker target: %d (source: %s; "
+             "cli=%d, context=%d, max_auto=%d)",
+             target_speakers, target_source,
+             cfg.num_speakers, context_speaker_count,
+             cfg.max_auto_speakers);
+    // Phase 1a (diarize-apply-collapse-over-merges): the floor
+    // branch of `apply_collapse` only fires for CLI-explicit
+    // `--num-speakers N`. `target_source` was populated by
+    // `resolve_target_speakers` above; treat its label
+    // verbatim.
+    const bool enforce_floor = (target_source != nullptr
+        && std::string(target_source) == "--num-speakers");
+
+    DiarizationOutput out;
+    DiarizeResult& diar = out.diar;
+    std::map<int, std::vector<float>>& chunked_centroids = out.centroids;
+    if (stage.chunked) {
+        log_debug("pipeline: stitching %zu chunks "
+                  "(target %d speakers, stitch %.2f, collapse %.2f)",
+                  stage.chunks.size(), target_speakers,
+                  chunk_cfg.stitch_threshold, chunk_cfg.collapse_threshold);
+        // The stage keeps only each chunk's PCM span; the core bounds and
+        // offsets come from the same plan the sherpa pass used.
+        const auto planned = plan_chunk_extents(stage.samples, chunk_cfg);
+        if (planned.size() != stage.chunks.size())
+            throw RecmeetError("Diarization chunks do not match the chunk plan");
+        std::vector<DiarizedChunk> chunks = stage.chunks;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            if (chunks[i].extents.pcm_start_samples != planned[i].pcm_start_samples ||
+                chunks[i].extents.pcm_end_samples != planned[i].pcm_end_samples)
+                throw RecmeetError("Diarization chunk " + std::to_string(i) +
+                                   " does not cover its planned audio");
+            chunks[i].extents = planned[i];
+        }
+        auto chunked = stitch_diarized_chunks(chunks, chunk_cfg,
+                                              target_speakers, enforce_floor);
+        diar = std::move(chunked.diar);
+        chunked_centroids = std::move(chunked.centroids);
+        log_debug("pipeline: chunked diarization complete "
+                  "(%zu segments, %zu centroids)",
+                  diar.segments.size(), chunked_centroids.size());
+        return out;
+    }
+
+    const DiarizedChunk& whole = stage.chunks.front();
+    diar = whole.diar;
+
+    // Short-audio ghost-cluster defense (Phase A.3 follow-up
+    // to iter 194). Drop sub-threshold clusters BEFORE
+    // building globals so `apply_collapse` never sees them.
+    // Guarded by `!stage.chunked` (this branch already is)
+    // and a >0 threshold so `--min-cluster-duration 0`
+    // disables the filter.
+    apply_short_audio_min_duration_filter(
+        diar, cfg.min_cluster_duration_sec);
+
+    // Phase B.3: short-audio post-collapse wiring. A synthetic
+    // globals vector holds one centroid per surviving cluster
+    // ID; the unified greedy-merge loop then runs with the
+    // precedence-resolved target_speakers ceiling and the
+    // collapse_threshold floor. Same machinery as the
+    // long-audio path (apply_collapse owns both). No
+    // centroids means extraction failed in the sherpa pass;
+    // identification then re-extracts from the audio.
+    //
+    // Phase A.1 instrumentation: dump TWICE when
+    // --debug-dump-centroids is set — pre-collapse and
+    // post-collapse, distinguished by the JSON `source`
+    // field. An investigator wants both: the pre-collapse
+    // state is what an over-count looks like before the
+    // fix; the post-collapse state is what an operator
+    // actually sees.
+    if (!diar.segments.empty() && !whole.centroids.empty()) {
+        const DiarizeResult uncollapsed = diar;
+        try {
+            auto globals = globals_from_centroids(diar, whole.centroids);
+
+            if (!cfg.debug_dump_centroids_path.empty()
+                && !globals.empty()) {
+                std::vector<std::vector<float>> dump_c;
+                std::vector<long> dump_w;
+                copy_globals_for_dump(globals, dump_c, dump_w);
+                dump_centroids_json(
+                    cfg.debug_dump_centroids_path.string(),
+                    input.timestamp + "_pre",
+                    dump_c, dump_w,
+                    /*local_to_global=*/{},
+                    "diarize_short_audio_pre_collapse");
+            }
+
+            // Run the unified merge loop on the synthetic
+            // globals view. `apply_collapse` rewrites
+            // diar.segments[i].speaker by the merge map +
+            // compaction so downstream consumers
+            // (`identify_speakers_with_centroids`,
+            // meeting_speakers loop) see 0..M-1 contiguous
+            // IDs.
+            auto collapsed = apply_collapse(
+                diar, globals, target_speakers,
+                cfg.collapse_threshold, enforce_floor);
+            chunked_centroids = collapsed.centroids;
+            log_debug("pipeline: short-audio apply_collapse "
+                      "complete (%d speakers post-collapse, "
+                      "%zu centroids)",
+                      diar.num_speakers,
+                      chunked_centroids.size());
+
+            if (!cfg.debug_dump_centroids_path.empty()
+                && !globals.empty()) {
+                std::vector<std::vector<float>> dump_c;
+                std::vector<long> dump_w;
+                copy_globals_for_dump(globals, dump_c, dump_w);
+                dump_centroids_json(
+                    cfg.debug_dump_centroids_path.string(),
+                    input.timestamp + "_post",
+                    dump_c, dump_w,
+                    /*local_to_global=*/{},
+                    "diarize_short_audio_post_collapse");
+            }
+        } catch (const std::exception& e) {
+            log_warn("pipeline: short-audio collapse failed: %s",
+                     e.what());
+            diar = uncollapsed;
+            chunked_centroids.clear();
+        }
+        // Without a collapse, identification still matches the
+        // sherpa pass's centroids of the surviving clusters rather
+        // than running the embedding model over the audio again.
+        if (chunked_centroids.empty()) {
+            for (auto& g : globals_from_centroids(diar, whole.centroids))
+                chunked_centroids[g.id] = std::move(g.raw);
+        }
+    }
+    return out;
+}
+
+namespace {
+
+/// Diarize `audio`: the sherpa pass, then clustering with the current
+/// settings. Reads only its arguments, so run_postprocessing() can run it
+/// on its own thread while whisper transcribes (plan_diarize_overlap()).
+DiarizationOutput run_diarization(const Config& cfg, const PostprocessInput& input,
+                                  const SampleSource& audio, const std::string& context_text,
+                                  int threads, DiarizeProgressCallback diar_progress,
+                                  StagePerfCallback on_chunk) {
+    ClusteringStage stage = diarize_for_clustering(cfg, input, audio, threads,
+                                                   std::move(diar_progress),
+                                                   std::move(on_chunk));
+    DiarizationOutput out = cluster_diarization(cfg, input, stage, context_text);
+    out.clustering = std::move(stage);
+    return out;
+}
+
+} // anonymous namespace
+#endif
+
 PostprocessInput run_recording(const Config& cfg,
                                StopToken& stop,
                                StopToken& cancel,
                                PhaseCallback on_phase,
-                               const CaptionHooks* caption_hooks) {
+                               const CaptionHooks* caption_hooks,
+                               LevelFeed* levels) {
     // Phase 2: belt-and-braces clear of the caption-start channel so any
     // stale state from a prior recording's race window (between
     // `g_rec_stop.request()` and `g_recording.store(false)`) cannot leak in.
     // The matching cleanup at the bottom of this function covers the normal
     // exit path; this one covers re-entry on the next recording.
     reset_caption_start_channel();
+    const TraceSpan trace_span("run_recording");
 
     log_debug("pipeline: run_recording ENTER (mic=%s, monitor=%s)",
               cfg.mic_source.c_str(), cfg.monitor_source.c_str());
@@ -513,7 +1896,8 @@ PostprocessInput run_recording(const Config& cfg,
         phase("recording");
 
         // Phase 3: caption engine is opt-in per recording. Wired to the mic
-        // capture only — monitor audio is recorded but not captioned in V1.
+        // capture, and in dual mode to the monitor too (one recognizer, one
+        // stream per capture).
         // We instantiate AFTER the capture is constructed and started but
         // BEFORE the recording loop, so the producer-side callback is in
         // place for the full recording duration. Teardown is the inverse:
@@ -538,9 +1922,32 @@ PostprocessInput run_recording(const Config& cfg,
         if (dual_mode) {
             notify("Recording started", "Mic: " + mic_source + "\nMonitor: " + monitor_source);
 
+            // Per-stream WAV files. In spool mode both captures feed a
+            // StreamingMixer that writes the mixed meeting audio while the
+            // recording runs, plus the mic stem — or, with keep_sources,
+            // sources.wav: mic and monitor interleaved as they were mixed.
+            // Otherwise the stems are written from the drained buffers after
+            // stop and mixed from disk, sources.wav in the same pass.
+            fs::path mic_path = pp.out_dir / "mic.wav";
+            fs::path mon_path = pp.out_dir / "monitor.wav";
+            fs::path sources_path = pp.out_dir / SOURCES_NAME;
+            std::unique_ptr<StreamingMixer> mixer;
+            if (cfg.spool_capture)
+                mixer = std::make_unique<StreamingMixer>(
+                    pp.audio_path, cfg.keep_sources ? fs::path{} : mic_path,
+                    cfg.keep_sources ? sources_path : fs::path{});
+
+            // Level meters outlive the captures that feed them.
+            LevelMeter mic_meter(levels, LevelSource::Mic);
+            LevelMeter mon_meter(levels, LevelSource::Monitor);
+
             // Start mic capture via PipeWire
+            const bool record_jitter = jitter_recording_requested();
             PipeWireCapture mic_cap(mic_source);
             log_debug("pipeline: PipeWireCapture created");
+            if (mixer) mic_cap.set_batch_sink(&StreamingMixer::on_mic_audio, mixer.get());
+            if (levels) mic_cap.set_tap(&LevelMeter::on_audio, &mic_meter);
+            if (record_jitter) mic_cap.record_jitter(JITTER_RECORD_MAX_TICKS);
             mic_cap.start();
             log_debug("pipeline: capture start (mic)");
 
@@ -556,38 +1963,50 @@ PostprocessInput run_recording(const Config& cfg,
             if (is_pa_monitor) {
                 log_debug("pipeline: falling back to PulseMonitorCapture");
                 mon_pa = std::make_unique<PulseMonitorCapture>(monitor_source);
+                if (mixer) mon_pa->set_batch_sink(&StreamingMixer::on_monitor_audio, mixer.get());
+                if (levels) mon_pa->set_tap(&LevelMeter::on_audio, &mon_meter);
+                if (record_jitter) mon_pa->record_jitter(JITTER_RECORD_MAX_TICKS);
                 mon_pa->start();
                 log_debug("pipeline: capture start (monitor)");
             } else {
                 try {
                     mon_pw = std::make_unique<PipeWireCapture>(monitor_source, /*capture_sink=*/true);
+                    if (mixer) mon_pw->set_batch_sink(&StreamingMixer::on_monitor_audio, mixer.get());
+                    if (levels) mon_pw->set_tap(&LevelMeter::on_audio, &mon_meter);
+                    if (record_jitter) mon_pw->record_jitter(JITTER_RECORD_MAX_TICKS);
                     mon_pw->start();
                     log_debug("pipeline: capture start (monitor)");
                 } catch (const RecmeetError& e) {
                     log_warn("PipeWire monitor failed (%s), falling back to pa_simple", e.what());
                     log_debug("pipeline: falling back to PulseMonitorCapture");
+                    // Drop the failed capture first: every downstream
+                    // consumer selects "mon_pw if set, else mon_pa".
+                    mon_pw.reset();
                     mon_pa = std::make_unique<PulseMonitorCapture>(monitor_source);
+                    if (mixer) mon_pa->set_batch_sink(&StreamingMixer::on_monitor_audio, mixer.get());
+                    if (levels) mon_pa->set_tap(&LevelMeter::on_audio, &mon_meter);
+                    if (record_jitter) mon_pa->record_jitter(JITTER_RECORD_MAX_TICKS);
                     mon_pa->start();
                     log_debug("pipeline: capture start (monitor)");
                 }
             }
 
-            // Caption engine — wired to monitor in dual mode (remote-speaker
-            // comprehension). Mic audio is recorded and transcribed in
-            // post-processing but not live-captioned. Lifetime: from here through
+            // Caption engine — one recognizer decoding the monitor (remote
+            // speakers) and the mic (the local user) as two streams, each
+            // caption tagged with its source. Lifetime: from here through
             // the explicit `caption_*.reset()` after the captures stop.
             std::unique_ptr<ActiveCaptionEngine<PipeWireCapture>>     caption_pw;
             std::unique_ptr<ActiveCaptionEngine<PulseMonitorCapture>> caption_pa;
             if (want_captions) {
                 std::unique_ptr<CaptionFanoutAdapter> adapter;
                 if (auto eng = try_start_caption_engine(cfg, caption_hooks,
-                                                        pp.out_dir, adapter)) {
+                                                        pp.out_dir, adapter, /*dual=*/true)) {
                     if (mon_pw) {
                         caption_pw = std::make_unique<ActiveCaptionEngine<PipeWireCapture>>(
-                            std::move(eng), mon_pw.get(), std::move(adapter));
+                            std::move(eng), mon_pw.get(), std::move(adapter), &mic_cap);
                     } else {
                         caption_pa = std::make_unique<ActiveCaptionEngine<PulseMonitorCapture>>(
-                            std::move(eng), mon_pa.get(), std::move(adapter));
+                            std::move(eng), mon_pa.get(), std::move(adapter), &mic_cap);
                     }
                     // Phase 2: the channel only reports `engine_running=true`
                     // once both the engine AND the audio callback are wired
@@ -601,8 +2020,8 @@ PostprocessInput run_recording(const Config& cfg,
             }
 
             // Phase 2: mid-recording engine-start closure. Captures the
-            // monitor-side captures (mon_pw / mon_pa) — the engine wires to
-            // the monitor in dual mode, NOT the mic — plus both
+            // monitor-side captures (mon_pw / mon_pa) and the mic capture —
+            // the engine decodes both in dual mode — plus both
             // ActiveCaptionEngine slots, the output dir, the hooks pointer,
             // and the per-recording cfg snapshot. The closure runs on this
             // worker thread when the 200ms loop drains a pending verb
@@ -610,7 +2029,7 @@ PostprocessInput run_recording(const Config& cfg,
             // poll_and_handle_caption_start_request handles the atomic
             // (F,T,T) → (T,F,T) transition after start_fn returns true.
             auto start_fn = [&caption_hooks, &cfg, &pp,
-                             &mon_pw, &mon_pa,
+                             &mic_cap, &mon_pw, &mon_pa,
                              &caption_pw, &caption_pa]
                             (const std::string& model_override) -> bool {
                 Config local_cfg = cfg;
@@ -619,18 +2038,24 @@ PostprocessInput run_recording(const Config& cfg,
                 }
                 std::unique_ptr<CaptionFanoutAdapter> adapter;
                 auto eng = try_start_caption_engine(local_cfg, caption_hooks,
-                                                    pp.out_dir, adapter);
+                                                    pp.out_dir, adapter, /*dual=*/true);
                 if (!eng) return false;
                 if (mon_pw) {
                     caption_pw = std::make_unique<ActiveCaptionEngine<PipeWireCapture>>(
-                        std::move(eng), mon_pw.get(), std::move(adapter));
+                        std::move(eng), mon_pw.get(), std::move(adapter), &mic_cap);
                 } else {
                     caption_pa = std::make_unique<ActiveCaptionEngine<PulseMonitorCapture>>(
-                        std::move(eng), mon_pa.get(), std::move(adapter));
+                        std::move(eng), mon_pa.get(), std::move(adapter), &mic_cap);
                 }
                 return true;
             };
 
+            // Streaming VAD trails the mixed spool; started after the
+            // captures so model loading never delays the first samples.
+            RecordingVad rec_vad;
+            if (mixer && cfg.vad) rec_vad.start(cfg, mixer->mixed_spool(), pp.audio_path);
+            auto clip_tap = mixer ? open_clip_tap(cfg, mixer->mixed_spool()) : nullptr;
+
             // Phase 2: open the verb-side gate IMMEDIATELY before entering
             // the polling loop. After this, request_caption_engine_start is
             // willing to return Queued. Paired with clear_worker_active()
@@ -642,13 +2067,17 @@ PostprocessInput run_recording(const Config& cfg,
             StopToken timer_stop;
             std::thread timer_thread(display_elapsed, std::ref(timer_stop));
 
-            while (!stop.stop_requested() && !cancel.stop_requested()) {
+            // A replayed recording also ends once its WAVs are delivered.
+            const CaptureReplay* mon_replay = mon_pw ? mon_pw->replay() : mon_pa->replay();
+            while (!stop.stop_requested() && !cancel.stop_requested() &&
+                   !replays_finished({mic_cap.replay(), mon_replay})) {
                 // Phase 2: drain any pending captions.start_engine request
                 // before sleeping. start_fn blocks 1-2 s on engine init;
                 // that's documented as Risk R10 (stop-token check delayed
                 // for the duration of start_fn — same property as the
                 // record.start-time engine init).
                 poll_and_handle_caption_start_request(start_fn);
+                rec_vad.pump(captions_backlogged(caption_pw) || captions_backlogged(caption_pa));
                 std::this_thread::sleep_for(std::chrono::milliseconds(200));
             }
 
@@ -658,6 +2087,7 @@ PostprocessInput run_recording(const Config& cfg,
             // see WorkerNotReady and the daemon maps that to NotRecording
             // with the "Recording is ending..." message.
             clear_worker_active();
+            clip_tap.reset();
             timer_stop.request();
             timer_thread.join();
             fprintf(stderr, "Recording stopped.\n");
@@ -676,6 +2106,10 @@ PostprocessInput run_recording(const Config& cfg,
                 if (mon_pa) mon_pa->stop();
                 caption_pw.reset();
                 caption_pa.reset();
+                // Close the mixer's spools so no writer thread is still
+                // touching the directory when it is removed.
+                rec_vad.reset();
+                if (mixer) close_spool_quietly(*mixer);
                 cleanup_cancelled_recording_dir(pp.out_dir);
                 reset_caption_start_channel();
                 log_debug("pipeline: run_recording EXIT cancelled");
@@ -688,6 +2122,13 @@ PostprocessInput run_recording(const Config& cfg,
             mic_cap.stop();
             if (mon_pw) mon_pw->stop();
             if (mon_pa) mon_pa->stop();
+            save_replay_report(pp.audio_path,
+                               {{"mic", mic_cap.replay(), mic_cap.stats().dropped_frames},
+                                {"monitor", mon_replay,
+                                 mon_pw ? mon_pw->stats().dropped_frames : 0}});
+            save_recorded_jitter(&mic_cap, pp.out_dir / "jitter_mic.txt");
+            save_recorded_jitter(mon_pw.get(), pp.out_dir / "jitter_monitor.txt");
+            save_recorded_jitter(mon_pa.get(), pp.out_dir / "jitter_monitor.txt");
 
             // Phase 3 teardown ordering: capture.stop() -> caption engine
             // teardown -> capture.drain(). The engine is wired to the monitor
@@ -697,46 +2138,98 @@ PostprocessInput run_recording(const Config& cfg,
             caption_pw.reset();
             caption_pa.reset();
 
-            // Drain and write
-            auto mic_samples = mic_cap.drain();
-            auto mon_samples = mon_pw ? mon_pw->drain() : mon_pa->drain();
-            log_debug("pipeline: drained audio (%.1fs)",
-                      mic_samples.size() / (float)SAMPLE_RATE);
+            if (mixer) {
+                // Spool mode: the mix is already on disk — finish() only
+                // pads the tail and finalizes the headers.
+                auto mix = mixer->finish();
+                log_debug("pipeline: streaming mix finished (mic %.1fs, monitor %.1fs)",
+                          mix.mic.duration_seconds(),
+                          static_cast<double>(mix.monitor_samples) / SAMPLE_RATE);
+
+                // Validate mic (fatal). With keep_sources there is no mic
+                // stem; the mixer counted what it took.
+                if (!mix.mic.empty()) {
+                    validate_audio(mic_path, 1.0, "Mic audio");
+                } else if (mix.mic_samples < static_cast<std::size_t>(SAMPLE_RATE)) {
+                    throw AudioValidationError("Mic audio too short (" +
+                        std::to_string(static_cast<double>(mix.mic_samples) / SAMPLE_RATE) +
+                        "s).");
+                }
 
-            fs::path mic_path = pp.out_dir / "mic.wav";
-            fs::path mon_path = pp.out_dir / "monitor.wav";
-            write_wav(mic_path, mic_samples);
-            log_debug("pipeline: wrote %s", mic_path.c_str());
-            write_wav(mon_path, mon_samples);
-            log_debug("pipeline: wrote %s", mon_path.c_str());
+                // Validate monitor (non-fatal). Same 1 s floor as the file
+                // check in the RAM-buffered path; there is no monitor stem,
+                // so check the mixer's count.
+                if (mix.monitor_samples >= static_cast<std::size_t>(SAMPLE_RATE)) {
+                    log_info("Mixed audio saved: %s", pp.audio_path.c_str());
+                    rec_vad.finish(pp.audio_path);
+                    save_envelope_quietly(pp.audio_path, mix.envelope);
+                } else {
+                    log_warn("Monitor audio unusable (too short, %.1fs). Using mic only.",
+                             static_cast<double>(mix.monitor_samples) / SAMPLE_RATE);
+                    // The VAD ran over the mix being replaced; discard it,
+                    // and any windows decoded or chunks diarized from it.
+                    rec_vad.reset();
+                    std::error_code ec;
+                    fs::remove(live_transcript_path(pp.audio_path), ec);
+#if RECMEET_USE_SHERPA
+                    fs::remove(live_diarization_path(pp.audio_path), ec);
+#endif
+                    if (!mix.mic.empty())
+                        fs::copy_file(mic_path, pp.audio_path,
+                                      fs::copy_options::overwrite_existing);
+                    else
+                        extract_wav_channel(sources_path, 0, pp.audio_path, mix.mic_samples);
+                }
+                log_debug("pipeline: wrote %s", pp.audio_path.c_str());
+            } else {
+                // Drain and write. Scoped so the buffers are released before
+                // the mix pass below.
+                {
+                    auto mic_samples = mic_cap.drain();
+                    auto mon_samples = mon_pw ? mon_pw->drain() : mon_pa->drain();
+                    log_debug("pipeline: drained audio (%.1fs)",
+                              mic_samples.size() / (float)SAMPLE_RATE);
+                    write_wav(mic_path, mic_samples);
+                    log_debug("pipeline: wrote %s", mic_path.c_str());
+                    write_wav(mon_path, mon_samples);
+                    log_debug("pipeline: wrote %s", mon_path.c_str());
+                }
 
-            // Validate mic (fatal)
-            validate_audio(mic_path, 1.0, "Mic audio");
+                // Validate mic (fatal)
+                validate_audio(mic_path, 1.0, "Mic audio");
 
-            // Validate monitor (non-fatal)
-            try {
-                validate_audio(mon_path, 1.0, "Monitor audio");
-                // Mix
-                auto mixed = mix_audio(mic_samples, mon_samples);
-                write_wav(pp.audio_path, mixed);
-                log_info("Mixed audio saved: %s", pp.audio_path.c_str());
-                log_debug("pipeline: wrote %s", pp.audio_path.c_str());
-            } catch (const AudioValidationError& e) {
-                log_warn("Monitor audio unusable (%s). Using mic only.", e.what());
-                write_wav(pp.audio_path, mic_samples);
-                log_debug("pipeline: wrote %s", pp.audio_path.c_str());
+                // Validate monitor (non-fatal). The mix streams both stems
+                // from disk block by block.
+                try {
+                    validate_audio(mon_path, 1.0, "Monitor audio");
+                    ChannelEnvelopeBuilder envelope;
+                    mix_wav_files(mic_path, mon_path, pp.audio_path, &envelope,
+                                  cfg.keep_sources ? sources_path : fs::path{});
+                    log_info("Mixed audio saved: %s", pp.audio_path.c_str());
+                    save_envelope_quietly(pp.audio_path, envelope.finish());
+                    log_debug("pipeline: wrote %s", pp.audio_path.c_str());
+                } catch (const AudioValidationError& e) {
+                    log_warn("Monitor audio unusable (%s). Using mic only.", e.what());
+                    fs::copy_file(mic_path, pp.audio_path, fs::copy_options::overwrite_existing);
+                    log_debug("pipeline: wrote %s", pp.audio_path.c_str());
+                }
             }
 
-            // Clean up source files unless --keep-sources
-            if (!cfg.keep_sources) {
-                fs::remove(mic_path);
-                fs::remove(mon_path);
-            }
+            // The mono stems are intermediate; --keep-sources keeps
+            // sources.wav instead.
+            fs::remove(mic_path);
+            fs::remove(mon_path);
         } else {
             notify("Recording started", "Source: " + mic_source);
 
+            LevelMeter mic_meter(levels, LevelSource::Mic);
             PipeWireCapture cap(mic_source);
             log_debug("pipeline: PipeWireCapture created");
+            // Spool mode writes the meeting audio file directly — there is
+            // nothing to mix in mic-only recordings.
+            if (cfg.spool_capture) cap.enable_spool(pp.audio_path);
+            if (levels) cap.set_tap(&LevelMeter::on_audio, &mic_meter);
+            if (jitter_recording_requested()) cap.record_jitter(JITTER_RECORD_MAX_TICKS);
             cap.start();
             log_debug("pipeline: capture start (mic)");
 
@@ -776,6 +2269,10 @@ PostprocessInput run_recording(const Config& cfg,
                 return true;
             };
 
+            RecordingVad rec_vad;
+            if (cfg.spool_capture && cfg.vad) rec_vad.start(cfg, *cap.spool(), pp.audio_path);
+            auto clip_tap = cfg.spool_capture ? open_clip_tap(cfg, *cap.spool()) : nullptr;
+
             // Phase 2: see dual-mode branch above for the worker-active
             // gating rationale.
             mark_worker_active();
@@ -783,13 +2280,16 @@ PostprocessInput run_recording(const Config& cfg,
             StopToken timer_stop;
             std::thread timer_thread(display_elapsed, std::ref(timer_stop));
 
-            while (!stop.stop_requested() && !cancel.stop_requested()) {
+            while (!stop.stop_requested() && !cancel.stop_requested() &&
+                   !replays_finished({cap.replay()})) {
                 poll_and_handle_caption_start_request(start_fn);
+                rec_vad.pump(captions_backlogged(caption));
                 std::this_thread::sleep_for(std::chrono::milliseconds(200));
             }
 
             log_debug("pipeline: stop requested, draining audio");
             clear_worker_active();
+            clip_tap.reset();
             timer_stop.request();
             timer_thread.join();
             fprintf(stderr, "Recording stopped.\n");
@@ -800,6 +2300,8 @@ PostprocessInput run_recording(const Config& cfg,
                     == RecordingExitAction::CancelCleanup) {
                 cap.stop();
                 caption.reset();
+                rec_vad.reset();
+                close_spool_quietly(cap);
                 cleanup_cancelled_recording_dir(pp.out_dir);
                 reset_caption_start_channel();
                 log_debug("pipeline: run_recording EXIT cancelled");
@@ -807,14 +2309,22 @@ PostprocessInput run_recording(const Config& cfg,
             }
 
             cap.stop();
+            save_replay_report(pp.audio_path, {{"mic", cap.replay(), cap.stats().dropped_frames}});
+            save_recorded_jitter(&cap, pp.out_dir / "jitter_mic.txt");
             // Phase 3 teardown ordering: cap.stop() -> engine teardown ->
             // cap.drain(). See dual_mode branch above for the rationale.
             caption.reset();
-            auto samples = cap.drain();
-            log_debug("pipeline: drained audio (%.1fs)",
-                      samples.size() / (float)SAMPLE_RATE);
-            write_wav(pp.audio_path, samples);
-            log_debug("pipeline: wrote %s", pp.audio_path.c_str());
+            if (cfg.spool_capture) {
+                auto sp = cap.finish_spool();
+                log_debug("pipeline: finalized spool (%.1fs)", sp.duration_seconds());
+                rec_vad.finish(pp.audio_path);
+            } else {
+                auto samples = cap.drain();
+                log_debug("pipeline: drained audio (%.1fs)",
+                          samples.size() / (float)SAMPLE_RATE);
+                write_wav(pp.audio_path, samples);
+                log_debug("pipeline: wrote %s", pp.audio_path.c_str());
+            }
             validate_audio(pp.audio_path);
         }
 
@@ -872,10 +2382,121 @@ std::string build_initial_prompt(const std::vector<std::string>& speaker_names,
     return result;
 }
 
+bool load_caption_transcript(const fs::path& vtt_path, TranscriptResult& out) {
+    std::ifstream in(vtt_path, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream buf;
+    buf << in.rdbuf();
+    auto cues = parse_vtt_cues(buf.str());
+    if (cues.empty()) return false;
+
+    // Dual-mode sidecars interleave the two sources' cues.
+    std::stable_sort(cues.begin(), cues.end(), [](const VttCue& a, const VttCue& b) {
+        return a.start_ms < b.start_ms;
+    });
+    TranscriptResult r{};
+    r.language = "en";  // captions are English-only (V1)
+    r.language_prob = 1.0f;
+    r.segments.reserve(cues.size());
+    for (const auto& cue : cues)
+        // Leading space, as whisper's segment text has.
+        r.segments.push_back({cue.start_ms / 1000.0, cue.end_ms / 1000.0, " " + cue.text});
+    out = std::move(r);
+    return true;
+}
+
+/// Record what `note_path` was written from (MeetingManifest), after the
+/// audio is archived so the recorded stat is the final file's. A previous
+/// note of this meeting under another name (a new title) is removed, as
+/// long as it is still the note that manifest recorded, untouched.
+static void write_meeting_manifest(const Config& cfg, const PostprocessInput& input,
+                                   const std::string& audio_hash,
+                                   const std::string& initial_prompt,
+                                   const std::string& context_text,
+                                   const fs::path& note_path) {
+    try {
+        fs::path audio = find_audio_file(input.out_dir);
+        if (audio.empty()) audio = input.audio_path;
+        const fs::path path = meeting_manifest_path(audio);
+        MeetingManifest previous;
+        if (load_meeting_manifest(path, previous) && !previous.note_path.empty() &&
+            previous.note_path != note_path && fs::exists(previous.note_path) &&
+            hash_file(previous.note_path) == previous.note_hash) {
+            fs::remove(previous.note_path);
+            log_info("Replaced the previous note %s", previous.note_path.filename().c_str());
+        }
+        MeetingManifest m = manifest_inputs(cfg, audio_hash, initial_prompt, context_text);
+        stat_manifest_audio(audio, m.audio_bytes, m.audio_mtime);
+        m.note_path = note_path;
+        m.note_hash = hash_file(note_path);
+        save_meeting_manifest(path, m);
+    } catch (const std::exception& e) {
+        log_warn("Meeting manifest not written: %s", e.what());
+    }
+}
+
+/// audio.archive_speech_only: cut the meeting WAV down to its padded VAD
+/// regions (sparse_audio.h). `audio_hash` is the recording's hash_samples()
+/// if the stage cache computed it. Skipped without a VAD index for the
+/// recording as it is, so an already compacted meeting is left alone, and
+/// for a WAV at another rate, whose VAD timeline is the resampled one.
+static void compact_meeting_audio(const Config& cfg, const fs::path& wav,
+                                  const std::string& audio_hash) {
+    if (wav.extension() != ".wav" || !fs::exists(wav)) return;
+    try {
+        SparseAudioIndex index;
+        {   // unmapped before the WAV is replaced
+            const AudioView audio(wav);
+            if (audio.sparse() || audio.resampled()) return;
+            VadResult vad;
+            if (!load_vad_index(vad_index_path(wav), audio.size(), vad_config_from(cfg), vad)) {
+                log_info("No VAD index for %s — archiving all of it", wav.filename().c_str());
+                return;
+            }
+            index.total_samples = audio.size();
+            index.audio_hash = audio_hash;
+            index.pieces = sparse_pieces(vad.segments, audio.size());
+        }
+        if (index.pieces.empty() || index.stored_samples() == index.total_samples) return;
+        compact_audio_file(wav, index);
+    } catch (const std::exception& e) {
+        log_warn("Speech-only archive failed for %s: %s", wav.c_str(), e.what());
+    }
+}
+
+/// Re-encode the meeting audio (and any kept sources.wav, or the mic/monitor
+/// stems older recordings kept) to `cfg.audio_archive`, the meeting audio
+/// cut to its speech first with audio.archive_speech_only. WAV input only —
+/// reprocessing an already archived meeting leaves it alone.
+static void archive_meeting_audio(const Config& cfg, const PostprocessInput& input,
+                                  const std::string& audio_hash) {
+    AudioArchiveFormat fmt;
+    if (!parse_audio_archive_format(cfg.audio_archive, fmt)) {
+        log_warn("Unknown audio.archive '%s' — keeping WAV", cfg.audio_archive.c_str());
+        return;
+    }
+    if (cfg.archive_speech_only) compact_meeting_audio(cfg, input.audio_path, audio_hash);
+    if (fmt == AudioArchiveFormat::Wav) return;
+
+    for (const fs::path& wav : {input.audio_path,
+                                input.out_dir / SOURCES_NAME,
+                                input.out_dir / "mic.wav",
+                                input.out_dir / "monitor.wav"}) {
+        if (wav.extension() != ".wav" || !fs::exists(wav)) continue;
+        try {
+            archive_audio_file(wav, fmt);
+        } catch (const std::exception& e) {
+            log_warn("Audio archive failed for %s: %s", wav.c_str(), e.what());
+        }
+    }
+}
+
 PipelineResult run_postprocessing(const Config& cfg, const PostprocessInput& input,
                                   PhaseCallback on_phase, ProgressCallback on_progress,
-                                  StopToken* stop) {
+                                  StopToken* stop, SummaryDeltaCallback on_summary_delta,
+                                  StagePerfCallback on_stage_perf) {
     log_debug("pipeline: run_postprocessing ENTER (dir=%s)", input.out_dir.c_str());
+    const TraceSpan trace_span("run_postprocessing");
 
     auto phase = [&](const std::string& name) {
         if (on_phase) on_phase(name);
@@ -886,21 +2507,52 @@ PipelineResult run_postprocessing(const Config& cfg, const PostprocessInput& inp
             throw RecmeetError("Cancelled");
     };
 
-    int threads = cfg.threads > 0 ? cfg.threads : default_thread_count();
+    // Whisper, sherpa and llama on the performance cores of one node
+    // (cpu_topology.h); the pools they start while pinned stay there.
+    const CpuPlacement inference = cfg.pin_threads
+        ? plan_cpu_placement(host_cpu_topology(), CpuClass::Inference) : CpuPlacement{};
+    const ScopedCpuPlacement pinned(inference);
+    if (!inference.cpus.empty())
+        log_info("Inference placed on %zu CPUs (NUMA node %d)", inference.cpus.size(),
+                 inference.node);
+    const int full_threads = cfg.threads > 0 ? cfg.threads
+                           : cfg.pin_threads ? inference.threads : default_thread_count();
+    int threads = powered_step_threads(cfg, "postprocessing", full_threads);
+    // The engines below lease their threads from the process's budget
+    // (thread_budget.h), set once by the process, not per job: pipelined
+    // and parallel batch run several of these at once.
+    take_thread_usage();  // as take_engine_counts(): an earlier job's tallies
+    set_onnx_provider(cfg.diarize_provider);
+    set_model_hugepages(cfg.model_hugepages);
+    set_perf_counters(cfg.perf_counters);
+    take_engine_counts();  // drop what an earlier, failed job left behind
+
+    // Stage records (stage_perf.h). The overlapped diarization thread and
+    // the chunk workers report too, so they are taken one at a time.
+    std::mutex perf_mu;
+    std::vector<StagePerf> stage_perf;
+    auto report = [&](const StagePerf& p) {
+        std::lock_guard lk(perf_mu);
+        stage_perf.push_back(p);
+        if (!p.cached) trace_completed(p.stage, p.wall_sec, p.index);
+        if (on_stage_perf) on_stage_perf(p);
+    };
+
+    // cfg.prepare_stage: the stage is cached, the rest of the job is left
+    // to a later pass over the meeting.
+    auto prepared = [&]() {
+        log_info("Prepared the %s stage", cfg.prepare_stage.c_str());
+        PipelineResult r;
+        r.output_dir = input.out_dir;
+        std::lock_guard lk(perf_mu);
+        r.stages = std::move(stage_perf);
+        return r;
+    };
 
     // Build initial_prompt from enrolled speaker names + vocabulary hints
-    std::string initial_prompt;
-    {
-        std::vector<std::string> names;
-        if (cfg.speaker_id) {
-            fs::path db_dir = cfg.speaker_db.empty()
-                ? default_speaker_db_dir() : cfg.speaker_db;
-            names = list_speakers(db_dir);
-        }
-        initial_prompt = build_initial_prompt(names, cfg.vocabulary);
-        if (!initial_prompt.empty())
-            log_info("Vocabulary hints: %s", initial_prompt.c_str());
-    }
+    std::string initial_prompt = whisper_initial_prompt(cfg);
+    if (!initial_prompt.empty())
+        log_info("Vocabulary hints: %s", initial_prompt.c_str());
 
     // Phase B.0: resolve the full context-text up front so Phase C's
     // `parse_context_participants` can feed the diarize-side target_speakers
@@ -912,74 +2564,329 @@ PipelineResult run_postprocessing(const Config& cfg, const PostprocessInput& inp
 
     // --- Transcribe + Diarize (if not pre-computed) ---
     std::string transcript_text = input.transcript_text;
+    std::string manifest_audio_hash;  // set when the stage cache hashed the recording
+    DraftPassStats draft_stats;
+    int repetition_aborts = 0;
+    bool from_captions = false;  // captions.as_transcript stood in for whisper
+    NoteStage note_stage;        // what the note is written from, for a re-render
+    TranscriptStore transcript;  // the segments transcript_text is rendered from
+
+    // Notes taken while recording (--rolling-summary-minutes); the summary
+    // is refined from them and the transcript after them, `rolling_tail`.
+    RollingSummary rolling;
+    bool use_rolling = cfg.rolling_summary_minutes > 0 && !cfg.no_summary &&
+        transcript_text.empty() && !input.audio_path.empty() &&
+        load_rolling_summary(rolling_summary_path(input.audio_path), rolling);
+    std::string rolling_tail;
 
     if (transcript_text.empty()) {
         log_info("Using %d threads for inference.", threads);
 
         TranscriptResult result;
-        {   // --- audio buffer scope --- freed after diarization, before summarization
-            auto samples = read_wav_float(input.audio_path);
-            log_info("Audio: %.1fs (%zu samples)",
-                    samples.size() / (float)SAMPLE_RATE, samples.size());
-            log_debug("pipeline: loaded audio (%.1fs, %zu samples)",
-                      samples.size() / (float)SAMPLE_RATE, samples.size());
-
-            {   // --- whisper model scope --- freed before diarization
+        {   // --- audio view scope --- unmapped after diarization, before summarization
+            // mmap-backed: consumers convert the windows they need to float
+            // instead of sharing one decoded copy of the whole recording.
+            AudioView audio(input.audio_path);
+            const double audio_sec = static_cast<double>(audio.size()) / SAMPLE_RATE;
+            log_info("Audio: %.1fs (%zu samples)", audio_sec, audio.size());
+            log_debug("pipeline: loaded audio (%.1fs, %zu samples, %s)",
+                      audio.size() / (float)SAMPLE_RATE, audio.size(),
+                      audio.mapped() ? "mapped" : "decoded");
+
+            // Stages whose inputs match an earlier pass over this meeting
+            // (stage_cache.h) are loaded instead of recomputed.
+            std::string audio_hash;
+#if RECMEET_USE_SHERPA
+            // --recluster trusts the hash the clustering stage was saved
+            // under instead of reading the whole recording to recompute it.
+            const fs::path clustering_stage =
+                stage_cache_path(input.audio_path, STAGE_CLUSTERING);
+            if (cfg.recluster) {
+                audio_hash = clustering_stage_audio_hash(clustering_stage);
+                if (audio_hash.empty())
+                    throw RecmeetError("--recluster needs " +
+                                       clustering_stage.filename().string() +
+                                       " from an earlier diarization pass");
+            }
+#else
+            if (cfg.recluster)
+                throw RecmeetError("--recluster requires diarization support");
+#endif
+            // A speech-only archive keeps the hash of the recording it was
+            // cut from, so stages saved before the cut still match.
+            if (cfg.stage_cache && audio_hash.empty()) audio_hash = audio.original_hash();
+            if (cfg.stage_cache && audio_hash.empty()) {
+                audio_hash = hash_samples(audio);
+                log_debug("pipeline: audio hash %s", audio_hash.c_str());
+            }
+            if (cfg.stage_cache) manifest_audio_hash = audio_hash;
+            const fs::path transcript_stage =
+                stage_cache_path(input.audio_path, STAGE_TRANSCRIPT);
+            const std::string transcript_key = audio_hash.empty()
+                ? std::string() : transcript_stage_key(cfg, audio_hash, initial_prompt);
+            const bool transcript_cached = !transcript_key.empty() &&
+                load_transcript_stage(transcript_stage, transcript_key, result);
+            if (transcript_cached) {
+                log_info("Transcript: reusing %s (%zu segments)",
+                         transcript_stage.filename().c_str(), result.segments.size());
+                report(StageTimer("transcribe", audio_sec).finish(true));
+            }
+            else if (cfg.recluster)
+                throw RecmeetError("--recluster needs the cached transcript (" +
+                                   transcript_stage.filename().string() +
+                                   "); the transcription settings changed");
+
+            // captions.as_transcript: the caption engine's finals stand in
+            // for whisper. Not saved as the transcript stage, which is keyed
+            // on the whisper settings.
+            if (!transcript_cached && cfg.caption_transcript) {
+                from_captions = load_caption_transcript(
+                    input.out_dir / CAPTIONS_VTT_NAME, result);
+                if (from_captions)
+                    log_info("Transcript: %zu live caption cue(s) from %s; whisper skipped",
+                             result.segments.size(), CAPTIONS_VTT_NAME);
+                else
+                    log_info("Transcript: no live captions in %s; transcribing with whisper",
+                             input.out_dir.c_str());
+            }
+
+#if RECMEET_USE_SHERPA
+            // The centroid dump is only written by a real diarization pass.
+            const fs::path diarization_stage =
+                stage_cache_path(input.audio_path, STAGE_DIARIZATION);
+            const std::string diarization_key =
+                audio_hash.empty() || !cfg.debug_dump_centroids_path.empty()
+                ? std::string() : diarization_stage_key(cfg, audio_hash, context_text);
+            DiarizationOutput cached_diarization;
+            const bool diarization_cached = cfg.diarize && !diarization_key.empty() &&
+                !cfg.recluster &&
+                load_diarization_stage(diarization_stage, diarization_key,
+                                       cached_diarization.diar, cached_diarization.centroids);
+            if (diarization_cached)
+                log_info("Diarization: reusing %s (%zu segments, %zu speakers)",
+                         diarization_stage.filename().c_str(),
+                         cached_diarization.diar.segments.size(),
+                         cached_diarization.centroids.size());
+
+            // diarization.speech_only: sherpa sees the speech regions back
+            // to back; the result is mapped back to the recording below.
+            // diarization.local_speaker: the mic-dominated stretches are the
+            // local user's and are cut out of it as well.
+            const auto local_spans = cfg.diarize
+                ? local_speaker_spans(cfg, input.audio_path, audio.size())
+                : std::vector<std::pair<double, double>>{};
+            std::unique_ptr<CompactedSampleSource> speech_audio;
+            if (cfg.diarize && !diarization_cached)
+                speech_audio = speech_only_source(cfg, input, audio, threads, local_spans);
+            const SampleSource& diar_audio = speech_audio
+                ? static_cast<const SampleSource&>(*speech_audio) : audio;
+
+            // A sherpa pass saved with the same segmentation settings only
+            // needs stitching and collapse redone (cluster_diarization()).
+            const std::string clustering_key = audio_hash.empty()
+                ? std::string()
+                : clustering_stage_key(cfg, audio_hash,
+                                       diarize_uses_chunks(cfg, diar_audio.size()));
+            ClusteringStage cached_clustering;
+            const bool clustering_cached = cfg.diarize && !diarization_cached &&
+                !clustering_key.empty() &&
+                load_clustering_stage(clustering_stage, clustering_key, cached_clustering);
+            if (clustering_cached)
+                log_info("Diarization: re-clustering from %s (%zu chunks)",
+                         clustering_stage.filename().c_str(),
+                         cached_clustering.chunks.size());
+            else if (cfg.recluster && cfg.diarize)
+                throw RecmeetError("--recluster: " + clustering_stage.filename().string() +
+                                   " does not match cluster_threshold or the chunk "
+                                   "settings; those need a full diarization pass");
+
+            // Overlapped diarization (plan_diarize_overlap). Declared after
+            // `audio` so the future's destructor, which waits for the task,
+            // runs before the view is unmapped on every exit path.
+            std::atomic<int> overlap_progress{-1};
+            StagePerf overlap_perf;
+            std::future<DiarizationOutput> overlapped_diarization;
+#endif
+            int whisper_threads = threads;
+
+            if (!transcript_cached && !from_captions) {
+                // --- whisper model scope --- freed before diarization (kept by a warm worker)
                 log_debug("pipeline: loading whisper model '%s'...", cfg.whisper_model.c_str());
                 fs::path model_path = ensure_whisper_model(cfg.whisper_model);
-                WhisperModel model(model_path);
+                const bool whisper_gpu = whisper_gpu_for(cfg, model_path);
+                auto whisper = acquire_whisper_model(model_path, whisper_gpu);
+                WhisperModel& model = *whisper;
                 log_debug("pipeline: whisper model loaded");
+                std::optional<StageTimer> transcribe_timer;
+
+#if RECMEET_USE_SHERPA
+                // sherpa-onnx diarization is CPU-only. With whisper on a GPU
+                // the two can run at once, finishing in roughly the longer
+                // of the two instead of their sum, provided the current RSS
+                // plus the diarize estimate stays inside the memory budget.
+                if (cfg.diarize && !diarization_cached && !clustering_cached) {
+                    const MemoryLevel mem_level = classify_memory(sample_memory());
+                    const DiarizeChunking chunking = resolve_diarize_chunking(cfg);
+                    const uint64_t diar_peak = estimate_diarize_peak_bytes(
+                        diar_audio.size(), chunking.chunk_minutes, chunking.overlap_sec);
+                    const uint64_t rss = static_cast<uint64_t>(read_self_rss_kb()) * 1024;
+                    const auto plan = plan_diarize_overlap(
+                        cfg.diarize_overlap && mem_level == MemoryLevel::Normal,
+                        whisper_gpu, threads, diar_peak, rss,
+                        static_cast<uint64_t>(read_mem_available_kb()) * 1024,
+                        static_cast<uint64_t>(std::max(cfg.overlap_memory_mb, 0)) << 20);
+                    if (plan.overlap) {
+                        log_info("Diarizing alongside transcription (%d CPU threads, "
+                                 "whisper keeps %d; projected peak %llu MB of %d MB)",
+                                 plan.diarize_threads, plan.whisper_threads,
+                                 (unsigned long long)((rss + diar_peak) >> 20),
+                                 cfg.overlap_memory_mb);
+                        whisper_threads = plan.whisper_threads;
+                        // Leased here, before whisper leases the rest.
+                        overlapped_diarization = std::async(std::launch::async,
+                            [&, lease = lease_threads("diarize", plan.diarize_threads)]() mutable {
+                                const int diar_threads = lease.threads();
+                                const StageTimer timer(
+                                    "diarize",
+                                    static_cast<double>(diar_audio.size()) / SAMPLE_RATE,
+                                    diar_threads);
+                                auto out = run_diarization(
+                                    cfg, input, diar_audio, context_text, diar_threads,
+                                    [&overlap_progress](int done, int total) {
+                                        overlap_progress.store(total > 0 ? done * 100 / total : 0,
+                                                               std::memory_order_relaxed);
+                                    },
+                                    report);
+                                overlap_perf = timer.finish();
+                                lease.release();
+                                return out;
+                            });
+                    } else if (cfg.diarize_overlap && mem_level != MemoryLevel::Normal) {
+                        log_info("Memory %s: diarizing after transcription",
+                                 memory_level_name(mem_level));
+                    } else if (cfg.diarize_overlap) {
+                        log_debug("pipeline: diarizing after transcription (%s)", plan.reason);
+                    }
+                }
+#endif
+
+                // What the budget leaves after an overlapped diarization.
+                ThreadLease whisper_lease;
+                auto lease_whisper = [&]() {
+                    whisper_lease = lease_threads("whisper", whisper_threads);
+                    whisper_threads = whisper_lease.threads();
+                };
 
 #if RECMEET_USE_SHERPA
                 if (cfg.vad) {
                     phase("detecting speech");
                     notify("Detecting speech...", "VAD segmentation");
 
-                    VadConfig vad_cfg;
-                    vad_cfg.threshold = cfg.vad_threshold;
-                    vad_cfg.min_silence_duration = cfg.vad_min_silence;
-                    vad_cfg.min_speech_duration = cfg.vad_min_speech;
-                    vad_cfg.max_speech_duration = cfg.vad_max_speech;
-
-                    log_debug("pipeline: running VAD");
-                    auto vad_result = detect_speech(samples, vad_cfg, threads);
+                    ThreadLease vad_lease = lease_threads("vad", whisper_threads);
+                    const StageTimer vad_timer("vad", audio_sec, vad_lease.threads());
+                    VadResult vad_result = load_or_detect_speech(
+                        cfg, input.audio_path, audio, vad_lease.threads());
+                    vad_lease.release();
+                    report(vad_timer.finish());
                     log_debug("pipeline: VAD complete (%zu speech segments)",
                               vad_result.segments.size());
 
                     if (!vad_result.segments.empty()) {
                         phase("transcribing");
+                        lease_whisper();
+                        transcribe_timer.emplace("transcribe", audio_sec, whisper_threads);
                         notify("Transcribing...", "Model: " + cfg.whisper_model +
                                " (" + std::to_string(vad_result.segments.size()) + " segments)");
 
-                        // Build sample counts for weighted progress
-                        std::vector<size_t> seg_samples;
+                        std::vector<TranscribeWindow> windows;
+                        windows.reserve(vad_result.segments.size());
                         for (const auto& seg : vad_result.segments)
-                            seg_samples.push_back(static_cast<size_t>(seg.end_sample - seg.start_sample));
-
-                        log_debug("pipeline: transcribing...");
-                        for (size_t si = 0; si < vad_result.segments.size(); ++si) {
-                            check_cancel();
-                            const auto& seg = vad_result.segments[si];
-                            size_t n = seg_samples[si];
-
-                            TranscribeOptions opts;
-                            opts.language = cfg.language;
-                            opts.initial_prompt = initial_prompt;
-                            opts.threads = threads;
-                            opts.stop = stop;
-                            if (on_progress) {
-                                opts.on_progress = [&, si](int pct) {
-                                    int overall = vad_weighted_progress(si, pct, seg_samples);
-                                    on_progress("transcribing", overall);
-                                };
-                            }
+                            windows.push_back({static_cast<size_t>(seg.start_sample),
+                                               static_cast<size_t>(seg.end_sample - seg.start_sample)});
+
+                        TranscribeOptions opts;
+                        opts.language = cfg.language;
+                        opts.initial_prompt = initial_prompt;
+                        opts.threads = whisper_threads;
+                        opts.stop = stop;
+                        if (on_progress) {
+                            opts.on_progress = [&](int pct) {
+                                on_progress("transcribing", pct);
+                            };
+                        }
+
+                        // Whisper encodes a full 30 s window per call however
+                        // short the input, so consecutive segments are packed
+                        // into windows of up to 30 s and decoded together.
+                        // Windows decode concurrently on per-worker whisper
+                        // states over the one loaded model; results come back
+                        // in source order.
+                        check_cancel();
+                        auto packed = cfg.vad_pack ? pack_windows(windows)
+                                                   : single_windows(windows);
+                        if (cfg.vad_pack)
+                            log_info("VAD: packed %zu segments into %zu whisper windows",
+                                     windows.size(), packed.size());
+
+                        // Windows already decoded while recording
+                        // (--live-transcribe) are taken as they are.
+                        std::vector<LiveWindow> live;
+                        size_t reused = 0;
+                        if (load_live_transcript(live_transcript_path(input.audio_path),
+                                                 {cfg.whisper_model, cfg.language, initial_prompt},
+                                                 live)) {
+                            reused = count_live_prefix(live, packed);
+                            log_info("Live transcript covers %zu of %zu whisper windows",
+                                     reused, packed.size());
+                            packed.erase(packed.begin(), packed.begin() + reused);
+                        }
 
-                            auto seg_result = transcribe(model, samples.data() + seg.start_sample,
-                                                         n, seg.start, opts);
-                            for (auto& s : seg_result.segments)
-                                result.segments.push_back(std::move(s));
-                            if (result.language.empty())
-                                result.language = seg_result.language;
+                        LanguageGuess pinned;
+                        if (!packed.empty()) {
+                            pinned = pin_language(cfg, model, audio, windows, whisper_threads);
+                            if (!pinned.language.empty())
+                                opts.language = pinned.language;
+                        }
+
+                        log_debug("pipeline: transcribing (%d worker(s))...",
+                                  resolve_transcribe_workers(cfg.whisper_workers, whisper_threads,
+                                                             packed.size()));
+                        const bool two_pass = !cfg.whisper_draft_model.empty() &&
+                            cfg.whisper_draft_model != cfg.whisper_model && !packed.empty();
+
+                        // Copies of the model on further GPUs share the
+                        // window queue (transcription.gpu_devices).
+                        std::vector<std::unique_ptr<WhisperModel>> gpu_copies;
+                        std::vector<WhisperModel*> models{&model};
+                        if (whisper_gpu && cfg.whisper_gpu_devices != 1 && !two_pass) {
+                            std::error_code size_ec;
+                            const uint64_t model_bytes = fs::file_size(model_path, size_ec);
+                            const auto gpus = plan_transcribe_gpus(
+                                cfg.whisper_gpu_devices, gpu_devices(),
+                                size_ec ? 0 : model_bytes, packed.size());
+                            for (size_t g = 1; g < gpus.size(); ++g) {
+                                try {
+                                    gpu_copies.push_back(
+                                        std::make_unique<WhisperModel>(model_path, true, gpus[g]));
+                                    models.push_back(gpu_copies.back().get());
+                                } catch (const RecmeetError& e) {
+                                    log_warn("GPU %d: %s; transcribing without it", gpus[g],
+                                             e.what());
+                                }
+                            }
+                            if (models.size() > 1)
+                                log_info("Transcribing %zu windows on %zu GPUs", packed.size(),
+                                         models.size());
+                        }
+                        result = merge_live_prefix(
+                            live, reused,
+                            two_pass ? transcribe_two_pass(cfg, model, audio, packed, opts,
+                                                           draft_stats)
+                                     : transcribe_windows(models, audio, packed,
+                                                          cfg.whisper_workers, opts));
+                        if (!pinned.language.empty()) {
+                            result.language = pinned.language;
+                            result.language_prob = pinned.prob;
                         }
                         log_info("Transcribed %zu segments across %zu VAD regions",
                                 result.segments.size(), vad_result.segments.size());
@@ -992,12 +2899,14 @@ PipelineResult run_postprocessing(const Config& cfg, const PostprocessInput& inp
 #endif
                 {
                     phase("transcribing");
+                    lease_whisper();
+                    transcribe_timer.emplace("transcribe", audio_sec, whisper_threads);
                     notify("Transcribing...", "Model: " + cfg.whisper_model);
 
                     TranscribeOptions opts;
                     opts.language = cfg.language;
                     opts.initial_prompt = initial_prompt;
-                    opts.threads = threads;
+                    opts.threads = whisper_threads;
                     opts.stop = stop;
                     if (on_progress) {
                         opts.on_progress = [&](int pct) {
@@ -1005,207 +2914,124 @@ PipelineResult run_postprocessing(const Config& cfg, const PostprocessInput& inp
                         };
                     }
 
+                    if (!cfg.whisper_draft_model.empty())
+                        log_warn("Two-pass transcription needs VAD; using %s only",
+                                 cfg.whisper_model.c_str());
                     log_debug("pipeline: transcribing...");
-                    result = transcribe(model, samples.data(), samples.size(), 0.0, opts);
+                    const auto pinned = pin_language(cfg, model, audio, {{0, audio.size()}},
+                                                     whisper_threads);
+                    if (!pinned.language.empty())
+                        opts.language = pinned.language;
+                    // Without VAD whisper sees the whole recording as one
+                    // window; the float copy lives only for this call.
+                    result = transcribe(model, audio, 0, audio.size(), opts);
+                    if (!pinned.language.empty())
+                        result.language_prob = pinned.prob;
                     log_info("Transcribed %d segments (language: %s)",
                             (int)result.segments.size(), result.language.c_str());
                     log_debug("pipeline: transcription complete (%zu segments)",
                               result.segments.size());
                 }
+
+                if (transcribe_timer) report(transcribe_timer->finish());
+                repetition_aborts = result.repetition_aborts;
+                if (repetition_aborts > 0)
+                    log_info("Repetition watchdog stopped %d looping decode(s)",
+                             repetition_aborts);
+                if (!transcript_key.empty()) {
+                    try {
+                        save_transcript_stage(transcript_stage, transcript_key, result);
+                    } catch (const RecmeetError& e) {
+                        log_warn("Could not save transcript stage: %s", e.what());
+                    }
+                }
             }   // whisper model freed
+            if (!transcript_cached && !from_captions) report(release_stage_memory("whisper"));
+            if (cfg.prepare_stage == STAGE_TRANSCRIPT) return prepared();
 
 #if RECMEET_USE_SHERPA
             check_cancel();
             if (cfg.diarize && !result.segments.empty()) {
                 phase("diarizing");
                 notify("Diarizing...", "Identifying speakers");
-                DiarizeProgressCallback diar_progress;
-                if (on_progress) {
-                    diar_progress = [&on_progress](int done, int total) {
-                        on_progress("diarizing", total > 0 ? done * 100 / total : 0);
+                StageTimer diarize_timer("diarize",
+                                         static_cast<double>(diar_audio.size()) / SAMPLE_RATE);
+                DiarizationOutput diarization;
+                if (overlapped_diarization.valid()) {
+                    // Started when the whisper model loaded; forward its
+                    // progress from this thread while it finishes.
+                    int last_pct = -1;
+                    auto forward = [&]() {
+                        int pct = overlap_progress.load(std::memory_order_relaxed);
+                        if (on_progress && pct > last_pct) on_progress("diarizing", pct);
+                        last_pct = std::max(last_pct, pct);
                     };
-                }
-
-                // T2.2 dispatch: chunked path triggers when audio is large
-                // enough to actually produce ≥ 2 real chunks plus 2 minutes
-                // of headroom. Below the threshold the single-call path runs
-                // unchanged. Threshold formula pinned in plan rev 7 line 429.
-                DiarizeChunkConfig chunk_cfg;
-                chunk_cfg.chunk_minutes = cfg.chunk_minutes;
-                chunk_cfg.overlap_seconds = cfg.chunk_overlap_sec;
-                chunk_cfg.stitch_threshold = cfg.stitch_threshold;
-                chunk_cfg.collapse_threshold = cfg.collapse_threshold;
-                // Phase A instrumentation: pass dump path + meeting timestamp
-                // into stitch_chunks. Empty path = no-op (hot-path negligible).
-                chunk_cfg.debug_dump_centroids_path =
-                    cfg.debug_dump_centroids_path.string();
-                chunk_cfg.meeting_timestamp = input.timestamp;
-                const size_t chunk_threshold_samples = static_cast<size_t>(
-                    (chunk_cfg.chunk_minutes * 60.0f
-                     + chunk_cfg.overlap_seconds + 120.0f)
-                    * static_cast<float>(SAMPLE_RATE));
-                const bool use_chunked =
-                    samples.size() > chunk_threshold_samples;
-
-                // Phase B.2: resolve `target_speakers` from the precedence
-                // chain BEFORE invoking diarize (helper exposed in
-                // pipeline.h so unit tests can exercise the formula
-                // without running the full pipeline). Order:
-                //   1. cfg.num_speakers (--num-speakers, explicit operator
-                //      override wins everything)
-                //   2. context_speaker_count (Phase C parser; stub returns 0
-                //      until Phase C lands; reads the resolved context_text
-                //      lifted up by Phase B.0)
-                //   3. cfg.max_auto_speakers (default cap, 8 unless overridden)
-                int context_speaker_count =
-                    parse_context_participants(context_text);
-                const char* target_source = nullptr;
-                int target_speakers = resolve_target_speakers(
-                    cfg.num_speakers, context_speaker_count,
-                    cfg.max_auto_speakers, &target_source);
-                log_info("Speaker target: %d (source: %s; "
-                         "cli=%d, context=%d, max_auto=%d)",
-                         target_speakers, target_source,
-                         cfg.num_speakers, context_speaker_count,
-                         cfg.max_auto_speakers);
-
-                DiarizeResult diar;
-                std::map<int, std::vector<float>> chunked_centroids;
-                if (use_chunked) {
-                    log_debug("pipeline: diarizing chunked "
-                              "(target %d speakers, %.1f min chunks, %.1f s "
-                              "overlap, stitch %.2f, collapse %.2f, threshold "
-                              "%.2f)",
-                              target_speakers, chunk_cfg.chunk_minutes,
-                              chunk_cfg.overlap_seconds,
-                              chunk_cfg.stitch_threshold,
-                              chunk_cfg.collapse_threshold,
-                              cfg.cluster_threshold);
-                    // Phase 1a (diarize-apply-collapse-over-merges): the floor
-                    // branch of `apply_collapse` only fires for CLI-explicit
-                    // `--num-speakers N`. `target_source` was populated by
-                    // `resolve_target_speakers` above; treat its label
-                    // verbatim.
-                    bool enforce_floor = (target_source != nullptr
-                        && std::string(target_source) == "--num-speakers");
-                    auto chunked = diarize_chunked(
-                        samples.data(), samples.size(),
-                        target_speakers, threads, cfg.cluster_threshold,
-                        chunk_cfg, enforce_floor, diar_progress);
-                    diar = std::move(chunked.diar);
-                    chunked_centroids = std::move(chunked.centroids);
-                    log_debug("pipeline: chunked diarization complete "
-                              "(%zu segments, %zu centroids)",
-                              diar.segments.size(), chunked_centroids.size());
+                    while (overlapped_diarization.wait_for(std::chrono::milliseconds(200))
+                           != std::future_status::ready)
+                        forward();
+                    forward();
+                    diarization = overlapped_diarization.get();
+                    report(overlap_perf);
+                } else if (diarization_cached) {
+                    diarization = std::move(cached_diarization);
+                    report(diarize_timer.finish(true));
+                } else if (clustering_cached) {
+                    diarization = cluster_diarization(cfg, input, cached_clustering,
+                                                      context_text);
+                    report(diarize_timer.finish());
                 } else {
-                    log_debug("pipeline: diarizing single-shot "
-                              "(target %d speakers)", target_speakers);
-                    // Phase B.4 design note: the free `diarize()` call's
-                    // `num_speakers` param is forwarded to sherpa's
-                    // FastClustering (the CLUSTER count knob), distinct from
-                    // our post-stitch unified merge target. We pass
-                    // `cfg.num_speakers` unchanged here — the operator's
-                    // explicit --num-speakers wins (auto-detect = 0). Our
-                    // own ceiling is applied below by `apply_collapse`.
-                    diar = diarize(samples.data(), samples.size(),
-                                   cfg.num_speakers, threads, cfg.cluster_threshold,
-                                   diar_progress);
-                    log_debug("pipeline: single-shot diarization complete "
-                              "(%zu segments, %d speakers pre-collapse)",
-                              diar.segments.size(), diar.num_speakers);
-
-                    // Short-audio ghost-cluster defense (Phase A.3 follow-up
-                    // to iter 194). Drop sub-threshold clusters BEFORE
-                    // centroid extraction so `build_short_audio_globals`
-                    // never embeds them and `apply_collapse` never sees
-                    // them. Guarded by `!use_chunked` (this branch already
-                    // is) and a >0 threshold so
-                    // `--min-cluster-duration 0` disables the filter.
-                    apply_short_audio_min_duration_filter(
-                        diar, cfg.min_cluster_duration_sec);
-
-                    // Phase B.3: short-audio post-collapse wiring. Build a
-                    // synthetic globals vector by extracting one centroid per
-                    // unique cluster ID over the cluster's segment audio,
-                    // then run the unified greedy-merge loop with the
-                    // precedence-resolved target_speakers ceiling and the
-                    // collapse_threshold floor. Same machinery as the
-                    // long-audio path (apply_collapse owns both).
-                    //
-                    // Phase A.1 instrumentation: dump TWICE when
-                    // --debug-dump-centroids is set — pre-collapse and
-                    // post-collapse, distinguished by the JSON `source`
-                    // field. An investigator wants both: the pre-collapse
-                    // state is what an over-count looks like before the
-                    // fix; the post-collapse state is what an operator
-                    // actually sees.
-                    if (!diar.segments.empty()) {
-                        try {
-                            auto globals = build_short_audio_globals(
-                                samples.data(), samples.size(), diar, threads);
-
-                            if (!cfg.debug_dump_centroids_path.empty()
-                                && !globals.empty()) {
-                                std::vector<std::vector<float>> dump_c;
-                                std::vector<long> dump_w;
-                                copy_globals_for_dump(globals, dump_c, dump_w);
-                                dump_centroids_json(
-                                    cfg.debug_dump_centroids_path.string(),
-                                    input.timestamp + "_pre",
-                                    dump_c, dump_w,
-                                    /*local_to_global=*/{},
-                                    "diarize_short_audio_pre_collapse");
-                            }
-
-                            // Run the unified merge loop on the synthetic
-                            // globals view. `apply_collapse` rewrites
-                            // diar.segments[i].speaker by the merge map +
-                            // compaction so downstream consumers
-                            // (`identify_speakers_with_centroids`,
-                            // meeting_speakers loop) see 0..M-1 contiguous
-                            // IDs.
-                            // Phase 1a (diarize-apply-collapse-over-merges):
-                            // floor branch fires only for CLI-explicit
-                            // `--num-speakers`. `target_source` came from
-                            // `resolve_target_speakers` above.
-                            bool enforce_floor = (target_source != nullptr
-                                && std::string(target_source) == "--num-speakers");
-                            auto collapsed = apply_collapse(
-                                diar, globals, target_speakers,
-                                cfg.collapse_threshold, enforce_floor);
-                            chunked_centroids = collapsed.centroids;
-                            log_debug("pipeline: short-audio apply_collapse "
-                                      "complete (%d speakers post-collapse, "
-                                      "%zu centroids)",
-                                      diar.num_speakers,
-                                      chunked_centroids.size());
-
-                            if (!cfg.debug_dump_centroids_path.empty()
-                                && !globals.empty()) {
-                                std::vector<std::vector<float>> dump_c;
-                                std::vector<long> dump_w;
-                                copy_globals_for_dump(globals, dump_c, dump_w);
-                                dump_centroids_json(
-                                    cfg.debug_dump_centroids_path.string(),
-                                    input.timestamp + "_post",
-                                    dump_c, dump_w,
-                                    /*local_to_global=*/{},
-                                    "diarize_short_audio_post_collapse");
-                            }
-                        } catch (const std::exception& e) {
-                            log_warn("pipeline: short-audio collapse failed: %s",
-                                     e.what());
-                        }
+                    DiarizeProgressCallback diar_progress;
+                    if (on_progress) {
+                        diar_progress = [&on_progress](int done, int total) {
+                            on_progress("diarizing", total > 0 ? done * 100 / total : 0);
+                        };
                     }
+                    const ThreadLease lease = lease_threads(
+                        "diarize", governed_step_threads("diarization",
+                                                         powered_step_threads(cfg, "diarization",
+                                                                              full_threads)));
+                    diarize_timer.threads = lease.threads();
+                    diarization = run_diarization(
+                        cfg, input, diar_audio, context_text, diarize_timer.threads,
+                        diar_progress, report);
+                    report(diarize_timer.finish());
                 }
+                if (speech_audio)
+                    uncompact_diarization(*speech_audio, diarization.diar);
+                if (!diarization_cached && !diarization_key.empty()) {
+                    try {
+                        save_diarization_stage(diarization_stage, diarization_key,
+                                               diarization.diar, diarization.centroids);
+                    } catch (const RecmeetError& e) {
+                        log_warn("Could not save diarization stage: %s", e.what());
+                    }
+                }
+                // Single-shot passes whose centroid extraction failed are not
+                // kept: reclustering them could never run the collapse.
+                auto& pass = diarization.clustering;
+                pass.audio_hash = audio_hash;
+                if (!pass.chunks.empty() && !clustering_key.empty() &&
+                    (pass.chunked || !pass.chunks.front().centroids.empty())) {
+                    try {
+                        save_clustering_stage(clustering_stage, clustering_key, pass);
+                    } catch (const RecmeetError& e) {
+                        log_warn("Could not save clustering stage: %s", e.what());
+                    }
+                }
+                if (cfg.prepare_stage == STAGE_DIARIZATION) return prepared();
+                const DiarizeResult& diar = diarization.diar;
+                const auto& chunked_centroids = diarization.centroids;
 
                 // Speaker identification + embedding extraction
                 std::map<int, std::string> speaker_names;
                 {
                     fs::path db_dir = cfg.speaker_db.empty()
                         ? default_speaker_db_dir() : cfg.speaker_db;
-                    auto db = cfg.speaker_id ? load_speaker_db(db_dir)
-                                             : std::vector<SpeakerProfile>{};
+                    // Resident across jobs in the warm postprocessing
+                    // worker; reloaded only when speakers.bin changed.
+                    const auto index = cfg.speaker_id
+                        ? acquire_speaker_index(db_dir, cfg.speaker_ann)
+                        : std::make_shared<SpeakerIndex>(std::vector<SpeakerProfile>{});
 
                     // Phase event fires regardless of db state — the embedding
                     // extraction call below is the long-running step and the
@@ -1214,18 +3040,32 @@ PipelineResult run_postprocessing(const Config& cfg, const PostprocessInput& inp
                     // heartbeat-as-liveness rule (T1C.1).
                     phase("identifying speakers");
                     if (on_progress) on_progress("identifying speakers", 0);
-                    if (!db.empty()) {
+                    StageTimer identify_timer("identify", audio_sec);
+                    if (!index->empty()) {
                         notify("Identifying speakers...",
-                               std::to_string(db.size()) + " enrolled");
+                               std::to_string(index->size()) + " enrolled");
+                    }
+                    // The meeting's attendees, matched before everyone else
+                    // (speaker_id.participants_first).
+                    std::unique_ptr<SpeakerIndex> participants;
+                    if (cfg.speaker_participants_first && !index->empty()) {
+                        const auto names = parse_context_participant_names(context_text);
+                        if (!names.empty()) {
+                            participants = index->participants(names);
+                            log_info("Speaker ID: %zu of %zu participant(s) enrolled; "
+                                     "matching them first", participants->size(),
+                                     names.size());
+                        }
                     }
                     // Phase B.3: both code paths now populate
                     // `chunked_centroids` post-collapse — the long-audio path
                     // via stitch_chunks, the short-audio path via the
-                    // apply_collapse wiring above. When centroids are
+                    // apply_collapse wiring in run_diarization(). When centroids are
                     // available, use the bypass entry point (no second pass
                     // over audio); otherwise fall back to the legacy audio
-                    // re-extract path (e.g. if the short-audio B.3 wiring
-                    // bailed via the catch block above).
+                    // re-extract path (only when the sherpa pass extracted
+                    // no centroid at all; a failed short-audio collapse
+                    // still hands over the uncollapsed clusters' own).
                     const bool centroid_bypass = !chunked_centroids.empty();
                     log_debug("pipeline: identifying speakers (%s)",
                               centroid_bypass ? "centroid bypass"
@@ -1238,13 +3078,21 @@ PipelineResult run_postprocessing(const Config& cfg, const PostprocessInput& inp
                         // skips the ~10 GB working-set spike of the
                         // per-cluster re-extraction.
                         id_result = identify_speakers_with_centroids(
-                            chunked_centroids, db, cfg.speaker_threshold);
+                            chunked_centroids, *index, cfg.speaker_threshold,
+                            participants.get());
                     } else {
                         auto model_paths = ensure_sherpa_models();
+                        const ThreadLease lease = lease_threads(
+                            "identify", governed_step_threads(
+                                            "speaker identification",
+                                            powered_step_threads(cfg, "speaker identification",
+                                                                 full_threads)));
+                        identify_timer.threads = lease.threads();
                         id_result = identify_speakers(
-                            samples.data(), samples.size(), diar, db,
-                            model_paths.embedding, cfg.speaker_threshold, threads);
+                            audio, diar, *index, model_paths.embedding, cfg.speaker_threshold,
+                            identify_timer.threads, participants.get());
                     }
+                    report(identify_timer.finish());
                     if (on_progress) on_progress("identifying speakers", 100);
                     log_debug("pipeline: speaker ID complete");
                     speaker_names = id_result.names;
@@ -1278,7 +3126,10 @@ PipelineResult run_postprocessing(const Config& cfg, const PostprocessInput& inp
 
                     if (!meeting_speakers.empty()) {
                         try {
-                            save_meeting_speakers(input.out_dir, meeting_speakers, input.timestamp);
+                            EmbeddingPrecision precision = EmbeddingPrecision::F32;
+                            parse_embedding_precision(cfg.speaker_embedding_precision, precision);
+                            save_meeting_speakers(input.out_dir, meeting_speakers, input.timestamp,
+                                                  precision);
                             log_info("Saved speakers.json with %zu speaker(s)",
                                      meeting_speakers.size());
                         } catch (const std::exception& e) {
@@ -1287,20 +3138,52 @@ PipelineResult run_postprocessing(const Config& cfg, const PostprocessInput& inp
                     }
                 }
 
-                result.segments = merge_speakers(result.segments, diar, speaker_names);
+                if (local_spans.empty()) {
+                    note_stage.speakers = assign_speakers(result.segments, diar);
+                } else {
+                    DiarizeResult with_local = diar;
+                    const int local_id = add_local_speaker(with_local, local_spans);
+                    speaker_names[local_id] = cfg.local_speaker;
+                    note_stage.speakers = assign_speakers(result.segments, with_local);
+                }
+                for (int sid : note_stage.speakers) {
+                    auto it = speaker_names.find(sid);
+                    note_stage.labels[sid] =
+                        it != speaker_names.end() ? it->second : format_speaker(sid);
+                }
             }
 #endif
-        }   // audio buffer freed
-
-        transcript_text = result.to_string();
+            if (!cfg.prepare_stage.empty()) return prepared();
+        }   // audio view unmapped
+        report(release_stage_memory("audio"));
+
+        // One buffer of text from here on; the labels are added as it is
+        // rendered (transcript_store.h).
+        transcript = TranscriptStore(result.segments);
+        std::vector<TranscriptSegment>().swap(result.segments);
+        if (!note_stage.speakers.empty())
+            transcript.set_speakers(note_stage.speakers, note_stage.labels);
+        transcript_text = transcript.render();
         if (transcript_text.empty())
             throw RecmeetError("Transcription produced no text.");
+        if (use_rolling) {
+            rolling_tail = transcript.render_after(rolling.covered_sec);
+            const size_t budget =
+                static_cast<size_t>(rolling_summary_tokens(cfg)) * SUMMARY_CHARS_PER_TOKEN;
+            if (rolling.notes.size() + rolling_tail.size() > budget) {
+                log_info("Rolling summary covers too little of the meeting; "
+                         "summarizing the whole transcript");
+                use_rolling = false;
+            }
+        }
     }
 
     // --- Summarize ---
     check_cancel();
     PipelineResult pipe_result;
     pipe_result.output_dir = input.out_dir;
+    pipe_result.draft = draft_stats;
+    pipe_result.repetition_aborts = repetition_aborts;
 
     std::string summary_text;
     // Context text was resolved early via `resolve_context_text(cfg, input.out_dir)`
@@ -1311,60 +3194,157 @@ PipelineResult run_postprocessing(const Config& cfg, const PostprocessInput& inp
 
     if (!cfg.no_summary) {
         phase("summarizing");
+        threads = powered_step_threads(cfg, "summarization", full_threads);
+        ThreadLease llama_lease;
+        if (!cfg.llm_model.empty()) {
+            llama_lease = lease_threads("llama", threads);
+            threads = llama_lease.threads();
+        }
+        StageTimer summary_timer("summarize", 0, cfg.llm_model.empty() ? 0 : threads);
+        bool summary_cached = false;
+
+        // The prompt gets the compacted transcript; the saved one is untouched.
+        std::string summary_input = transcript_text;
+        if (cfg.summary_compact) {
+            CompactionStats cs;
+            summary_input = compact_transcript(transcript_text, &cs);
+            if (cs.chars_out < cs.chars_in)
+                log_info("Summary: compacted the transcript %zu -> %zu chars (~%zu tokens saved): "
+                         "%zu lines into %zu turns, %zu fillers and %zu repeats dropped",
+                         cs.chars_in, cs.chars_out,
+                         (cs.chars_in - cs.chars_out) / SUMMARY_CHARS_PER_TOKEN,
+                         cs.lines, cs.turns, cs.fillers, cs.repeats);
+        }
 
-#if RECMEET_USE_LLAMA
-        if (!cfg.llm_model.empty()) {  // NOLINT(readability-misleading-indentation)
-            // Local summarization
-            if (!cfg.batch_mode) notify("Summarizing...", "Local LLM");
-            log_debug("pipeline: summarizing (provider=local)");
-            try {
-                fs::path llm_path = ensure_llama_model(cfg.llm_model);
-                summary_text = summarize_local(transcript_text, llm_path, context_text, threads, cfg.llm_mmap);
-                log_debug("pipeline: summary complete");
-            } catch (const std::exception& e) {
-                log_warn("Local summary failed: %s", e.what());
+        const fs::path summary_stage = stage_cache_path(input.audio_path, STAGE_SUMMARY);
+        const std::string summary_key = cfg.stage_cache && !input.audio_path.empty()
+            ? summary_stage_key(cfg, summary_input, context_text,
+                                use_rolling ? rolling.notes : std::string())
+            : std::string();
+        const std::vector<std::string> speakers = transcript_speakers(transcript_text);
+        std::vector<std::string> cached_speakers;
+        if (!summary_key.empty() &&
+            load_summary_stage(summary_stage, summary_key, summary_text, &cached_speakers)) {
+            summary_cached = true;
+            size_t renamed = 0;
+            for (size_t i = 0; i < speakers.size() && i < cached_speakers.size(); ++i)
+                if (speakers[i] != cached_speakers[i]) ++renamed;
+            if (renamed == 0) {
+                log_info("Summary: reusing %s", summary_stage.filename().c_str());
+            } else {
+                summary_text = rename_speakers(summary_text, cached_speakers, speakers);
+                log_info("Summary: reusing %s with %zu speaker(s) renamed",
+                         summary_stage.filename().c_str(), renamed);
+                try {
+                    save_summary_stage(summary_stage, summary_key, summary_text, speakers);
+                } catch (const RecmeetError& e) {
+                    log_warn("Could not save summary stage: %s", e.what());
+                }
             }
-        } else
+        } else {
+            // A map-reduce summary cut short by a killed child resumes from
+            // the steps it had finished.
+            std::unique_ptr<StageSummaryCheckpoint> checkpoint;
+            if (!summary_key.empty())
+                checkpoint = std::make_unique<StageSummaryCheckpoint>(
+                    stage_cache_path(input.audio_path, STAGE_SUMMARY_PARTS), summary_key);
+
+            // The rolling notes are refined with the backend below; if that
+            // fails, the whole transcript is summarized as without them.
+            if (use_rolling) {
+                if (!cfg.batch_mode) notify("Summarizing...", "Refining the rolling summary");
+                log_info("Summary: refining the rolling summary (up to %.0fs) with %zu chars "
+                         "of transcript after it", rolling.covered_sec, rolling_tail.size());
+                try {
+                    SummaryCompleter complete = summary_completer(cfg, threads, true);
+                    if (complete)
+                        summary_text = complete(build_refine_prompt(rolling.notes, rolling_tail,
+                                                                    context_text),
+                                                on_summary_delta);
+                } catch (const std::exception& e) {
+                    log_warn("Rolling summary refine failed (%s); summarizing the whole "
+                             "transcript", e.what());
+                }
+            }
+            if (!summary_text.empty()) {
+                log_debug("pipeline: summary complete (rolling)");
+            } else
+#if RECMEET_USE_LLAMA
+            if (!cfg.llm_model.empty()) {  // NOLINT(readability-misleading-indentation)
+                // Local summarization
+                defer_summary_if_short(cfg, summary_key);
+                if (!cfg.batch_mode) notify("Summarizing...", "Local LLM");
+                log_debug("pipeline: summarizing (provider=local)");
+                try {
+                    fs::path llm_path = ensure_llama_model(cfg.llm_model);
+                    fs::path draft_path;
+                    if (!cfg.llm_draft_model.empty()) {
+                        try {
+                            draft_path = ensure_llama_model(cfg.llm_draft_model);
+                        } catch (const std::exception& e) {
+                            log_warn("Draft model unavailable, generating without it: %s",
+                                     e.what());
+                        }
+                    }
+                    summary_text = summarize_local(summary_input, llm_path, context_text, threads,
+                                                   cfg.llm_mmap, cfg.summary_chunk_tokens,
+                                                   on_summary_delta, draft_path,
+                                                   {cfg.llm_kv_type, cfg.llm_batch,
+                                                    cfg.llm_ubatch, cfg.llm_gpu_layers,
+                                                    cfg.backend_bench});
+                    log_debug("pipeline: summary complete");
+                } catch (const std::exception& e) {
+                    log_warn("Local summary failed: %s", e.what());
+                }
+            } else
 #endif
-        if (!cfg.api_key.empty()) {
-            std::string url = cfg.api_url;
-            if (url.empty()) {
-                const auto* prov = find_provider(cfg.provider);
-                if (prov) url = std::string(prov->base_url) + "/chat/completions";
-                else url = "https://api.x.ai/v1/chat/completions";
+            if (!cfg.api_key.empty()) {
+                const std::string url = summary_api_url(cfg);
+                if (!cfg.batch_mode) notify("Summarizing...", "Sending to " + cfg.api_model);
+                log_debug("pipeline: summarizing (provider=%s)", cfg.provider.c_str());
+                try {
+                    summary_text = summarize_http(summary_input, url,
+                                                   cfg.api_key, cfg.api_model, context_text,
+                                                   cfg.summary_chunk_tokens, on_summary_delta);
+                    log_debug("pipeline: summary complete");
+                } catch (const std::exception& e) {
+                    log_warn("Summary failed: %s", e.what());
+                    log_warn("Transcript is still available.");
+                }
+            } else {
+                log_warn("No API key and no local LLM — skipping summary.");
             }
-            if (!cfg.batch_mode) notify("Summarizing...", "Sending to " + cfg.api_model);
-            log_debug("pipeline: summarizing (provider=%s)", cfg.provider.c_str());
-            try {
-                summary_text = summarize_http(transcript_text, url,
-                                               cfg.api_key, cfg.api_model, context_text);
-                log_debug("pipeline: summary complete");
-            } catch (const std::exception& e) {
-                log_warn("Summary failed: %s", e.what());
-                log_warn("Transcript is still available.");
+
+            if (!summary_text.empty() && !summary_key.empty()) {
+                try {
+                    save_summary_stage(summary_stage, summary_key, summary_text, speakers);
+                    checkpoint->discard();
+                } catch (const RecmeetError& e) {
+                    log_warn("Could not save summary stage: %s", e.what());
+                }
             }
-        } else {
-            log_warn("No API key and no local LLM — skipping summary.");
         }
 
         if (!summary_text.empty()) {  // NOLINT(readability-misleading-indentation)
             metadata = extract_meeting_metadata(summary_text);
             summary_text = strip_metadata_block(summary_text);
+            report(summary_timer.finish(summary_cached));
         }
+        report(release_stage_memory("summarize"));
     } else {
         log_info("Summary skipped (--no-summary).");
     }
 
     // --- Meeting note output ---
+    pipe_result.transcript_text = std::move(transcript_text);
     try {
+        const StageTimer note_timer("note");
         auto [date_str, time_str] = resolve_meeting_time(input.out_dir, input.audio_path);
 
         MeetingData md;
         md.date = date_str;
         md.time = time_str;
         md.summary_text = summary_text;
-        md.transcript_text = transcript_text;
-        pipe_result.transcript_text = transcript_text;
         md.context_text = context_text;
         md.output_dir = input.out_dir;
         if (!cfg.note_dir.empty()) {
@@ -1380,13 +3360,53 @@ PipelineResult run_postprocessing(const Config& cfg, const PostprocessInput& inp
         md.ai_tags = metadata.tags;
         md.participants = metadata.participants;
         md.duration_seconds = get_audio_duration_seconds(input.audio_path);
-        md.whisper_model = cfg.whisper_model;
-
-        pipe_result.note_path = write_meeting_note(cfg.note, md);
+        if (!from_captions) md.whisper_model = cfg.whisper_model;
+
+        NoteConfig note_cfg = cfg.note;
+        note_cfg.action_ledger = action_ledger_path();
+        // The note borrows the transcript, which goes back to the result
+        // however the write ends.
+        md.transcript_text.swap(pipe_result.transcript_text);
+        try {
+            pipe_result.note_path = write_meeting_note(note_cfg, md);
+        } catch (...) {
+            pipe_result.transcript_text.swap(md.transcript_text);
+            throw;
+        }
+        pipe_result.transcript_text.swap(md.transcript_text);
+        if (cfg.stage_cache && !input.audio_path.empty() && !transcript.empty()) {
+            note_stage.segments = transcript.segments();
+            note_stage.data = std::move(md);
+            note_stage.data.output_dir.clear();
+            note_stage.note_path = pipe_result.note_path;
+            try {
+                save_note_stage(stage_cache_path(input.audio_path, STAGE_NOTE), note_stage);
+            } catch (const RecmeetError& e) {
+                log_warn("Could not save note stage: %s", e.what());
+            }
+        }
+        report(note_timer.finish());
     } catch (const std::exception& e) {
         log_warn("Meeting note failed: %s", e.what());
     }
 
+    // --- Archive audio --- after the note, so nothing above reads a file
+    // that is being re-encoded. Failure keeps the WAV.
+    archive_meeting_audio(cfg, input, manifest_audio_hash);
+    if (!manifest_audio_hash.empty() && !pipe_result.note_path.empty())
+        write_meeting_manifest(cfg, input, manifest_audio_hash, initial_prompt, context_text,
+                               pipe_result.note_path);
+    // Engine tallies are whole-job totals, not stages: no trace span.
+    std::vector<StagePerf> totals = engine_perf_records(take_engine_counts());
+    for (auto& p : thread_perf_records(take_thread_usage())) totals.push_back(std::move(p));
+    for (const auto& p : totals) {
+        std::lock_guard lk(perf_mu);
+        stage_perf.push_back(p);
+        if (on_stage_perf) on_stage_perf(p);
+    }
+    pipe_result.stages = std::move(stage_perf);
+    if (model_hugepages()) log_model_memory();
+
     // --- Done ---
     phase("complete");
     if (!cfg.batch_mode) notify("Meeting complete", input.out_dir.string());
@@ -1413,4 +3433,68 @@ PipelineResult run_pipeline(const Config& cfg, StopToken& stop, PhaseCallback on
     return run_postprocessing(cfg, input, on_phase);
 }
 
+fs::path rerender_meeting_note(const Config& cfg, const fs::path& meeting_dir) {
+    const fs::path audio = find_audio_file(meeting_dir);
+    if (audio.empty())
+        throw RecmeetError("No audio file in " + meeting_dir.string());
+    NoteStage stage;
+    if (!load_note_stage(stage_cache_path(audio, STAGE_NOTE), stage))
+        throw RecmeetError("No note stage in " + meeting_dir.string() +
+                           "; reprocess the meeting once with the stage cache on");
+
+    // Labels as the speakers file has them now; the renamed ones are
+    // renamed in the summary and metadata as well.
+    std::map<int, std::string> labels = stage.labels;
+    for (const auto& s : load_meeting_speakers(meeting_dir))
+        if (labels.count(s.cluster_id)) labels[s.cluster_id] = s.label;
+    std::vector<std::string> from, to;
+    for (const auto& [sid, old_label] : stage.labels) {
+        if (labels[sid] == old_label) continue;
+        from.push_back(old_label);
+        to.push_back(labels[sid]);
+    }
+
+    MeetingData md = std::move(stage.data);
+    md.output_dir = meeting_dir;
+    if (md.note_dir.empty()) md.note_dir = meeting_dir;
+    fs::create_directories(md.note_dir);
+    if (!from.empty()) {
+        md.summary_text = rename_speakers(md.summary_text, from, to);
+        md.title = rename_speakers(md.title, from, to);
+        md.description = rename_speakers(md.description, from, to);
+        for (auto& item : md.action_items) item = rename_speakers(item, from, to);
+        for (auto& p : md.participants) p = rename_speakers(p, from, to);
+    }
+    TranscriptStore transcript(stage.segments);
+    transcript.set_speakers(stage.speakers, labels);
+    md.transcript_text = transcript.render();
+
+    NoteConfig note_cfg = cfg.note;
+    note_cfg.action_ledger = action_ledger_path();
+    const fs::path note = write_meeting_note(note_cfg, md);
+    log_info("Re-rendered %s (%zu speaker(s) renamed)", note.filename().c_str(), from.size());
+
+    // A renamed title renames the note: drop the old one if the manifest
+    // still records it untouched, as a reprocess does.
+    const fs::path manifest_path = meeting_manifest_path(audio);
+    MeetingManifest manifest;
+    const bool have_manifest = load_meeting_manifest(manifest_path, manifest);
+    if (have_manifest && manifest.note_path != note && fs::exists(manifest.note_path) &&
+        hash_file(manifest.note_path) == manifest.note_hash)
+        fs::remove(manifest.note_path);
+
+    md.transcript_text.clear();
+    md.output_dir.clear();
+    stage.data = std::move(md);
+    stage.labels = std::move(labels);
+    stage.note_path = note;
+    save_note_stage(stage_cache_path(audio, STAGE_NOTE), stage);
+    if (have_manifest) {
+        manifest.note_path = note;
+        manifest.note_hash = hash_file(note);
+        save_meeting_manifest(manifest_path, manifest);
+    }
+    return note;
+}
+
 } // namespace recmeet
@@ -4,10 +4,21 @@
 #pragma once
 
 #include "util.h"
+#include "backend_info.h"  // GpuDevice
 #include "config.h"
 #include "caption_engine.h"  // CaptionResult / CaptionDegradedReason callback typedefs
+#include "level_feed.h"
+#include "stage_perf.h"
+#include "summarize.h"  // SummaryDeltaCallback
+#include "transcribe.h"
+
+#if RECMEET_USE_SHERPA
+#include "stage_cache.h"  // ClusteringStage
+#include "vad.h"          // CompactedSampleSource
+#endif
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -54,6 +65,9 @@ struct PipelineResult {
     fs::path note_path;
     fs::path output_dir;
     std::string transcript_text;  ///< Raw timestamped transcript (empty if transcription skipped).
+    DraftPassStats draft;         ///< Two-pass transcription; windows == 0 when it did not run.
+    int repetition_aborts = 0;    ///< Whisper decodes stopped on a repetition loop.
+    std::vector<StagePerf> stages;  ///< Every stage's record, in completion order.
 };
 
 /// Input for post-processing phase (output of recording phase).
@@ -97,6 +111,13 @@ void save_meeting_context(const fs::path& out_dir, const std::string& context_in
 /// Returns empty if file doesn't exist.
 std::string load_meeting_context(const fs::path& out_dir);
 
+/// `captions.as_transcript`: the finalized live captions a recording left in
+/// `vtt_path` (`<meeting_dir>/captions.vtt`) as transcript segments, in time
+/// order, language "en". Cue times are the caption engine's, measured from
+/// its start. False, leaving `out` alone, when the sidecar is missing or
+/// holds no cues.
+bool load_caption_transcript(const fs::path& vtt_path, TranscriptResult& out);
+
 /// Resolve the full meeting context string from all sources, in precedence
 /// order:
 ///   1. `cfg.context_inline` (highest — operator-typed inline / `--context-text`)
@@ -142,12 +163,262 @@ int resolve_target_speakers(int cli_num_speakers,
 /// precedence chain — see `resolve_target_speakers`.
 int parse_context_participants(const std::string& context);
 
+/// The entries parse_context_participants() counts, trimmed, in order.
+/// Seeds participant-first speaker identification
+/// (Config::speaker_participants_first, SpeakerIndex::participants()).
+std::vector<std::string> parse_context_participant_names(const std::string& context);
+
+/// Resident memory one diarization pass is expected to peak at: the
+/// sherpa-onnx sessions plus a working set proportional to the audio it
+/// holds at once — the whole recording below the chunking threshold, one
+/// chunk (`chunk_minutes` + overlap) above it. The per-second rate is
+/// sized from the iter-114 single-call baseline (~11 GB for 60 min) with
+/// margin, so the estimate errs high.
+uint64_t estimate_diarize_peak_bytes(size_t audio_samples, float chunk_minutes,
+                                     float chunk_overlap_sec);
+
+/// Chunk length and overlap for diarize_chunked() (DiarizeChunkConfig).
+struct DiarizeChunking {
+    float chunk_minutes = 15.0f;
+    float overlap_sec = 30.0f;
+};
+
+/// Chunking sized to a host whose memory ceiling is `ceiling_bytes`
+/// (read_memory_ceiling_bytes(); 0 = unknown, the 15 min / 30 s defaults).
+/// One chunk may use half the ceiling under the estimate_diarize_peak_bytes()
+/// model, leaving the rest to whisper, the summary model and the process;
+/// chunk length is rounded down to 5 minutes within 5-60 minutes so small
+/// changes in the ceiling don't move it. Overlap is 2 s per chunk minute
+/// (20-60 s). Larger chunks mean fewer cross-chunk stitches.
+DiarizeChunking plan_diarize_chunking(uint64_t ceiling_bytes);
+
+/// The chunking run_postprocessing() uses: `cfg.chunk_minutes` /
+/// `chunk_overlap_sec` as set, or plan_diarize_chunking() of this host's
+/// ceiling when `cfg.diarize_auto_chunk`.
+DiarizeChunking resolve_diarize_chunking(const Config& cfg);
+
+/// Outcome of plan_diarize_overlap(). `reason` is a static string for the
+/// log line when `overlap` is false.
+struct DiarizeOverlapPlan {
+    bool overlap = false;
+    int whisper_threads = 1;  ///< CPU threads left to whisper (it runs on the GPU)
+    int diarize_threads = 1;  ///< CPU threads given to diarization
+    const char* reason = "";
+};
+
+/// Decide whether diarization may run concurrently with transcription.
+/// Requires `enabled`, whisper on a GPU device, at least two CPU threads,
+/// and that `rss_bytes + diarize_peak_bytes` stays within `budget_bytes`
+/// and the diarize peak fits in `available_bytes` (0 = unknown, not
+/// checked). Whisper keeps a quarter of `threads` (1..4) to feed the GPU;
+/// diarization gets the rest.
+DiarizeOverlapPlan plan_diarize_overlap(bool enabled, bool whisper_on_gpu, int threads,
+                                        uint64_t diarize_peak_bytes, uint64_t rss_bytes,
+                                        uint64_t available_bytes, uint64_t budget_bytes);
+
+/// The GPUs (GpuDevice::index) that a transcription of `windows` windows
+/// loads a copy of a `model_bytes` whisper model on, for
+/// Config::whisper_gpu_devices `requested` (0 = all of `gpus`). The first
+/// GPU always comes first. Each further one needs a window of its own
+/// and must report model_bytes plus a quarter free, or no memory at all.
+/// Empty when `gpus` is.
+std::vector<int> plan_transcribe_gpus(int requested, const std::vector<GpuDevice>& gpus,
+                                      uint64_t model_bytes, size_t windows);
+
+/// How many chunks diarize_chunked() may diarize at once
+/// (DiarizeChunkConfig::parallel_chunks). `requested` > 0 is a ceiling,
+/// 0 = as many as fit with at least two threads per chunk. Each chunk adds
+/// `chunk_peak_bytes` (estimate_diarize_peak_bytes()), so the count is
+/// capped by what `budget_bytes` leaves above `rss_bytes` and by
+/// `available_bytes` (0 = unknown, not checked). Never below 1 or above
+/// `threads`.
+int plan_diarize_parallel(int requested, int threads, uint64_t chunk_peak_bytes,
+                          uint64_t rss_bytes, uint64_t available_bytes,
+                          uint64_t budget_bytes);
+
+/// What one postprocessing job is expected to hold at its peak, for the
+/// daemon's admission control (admit_pp_job()).
+struct PpFootprint {
+    uint64_t bytes = 0;        ///< peak resident memory
+    uint64_t model_bytes = 0;  ///< part of `bytes` a warm worker keeps after the job
+    int threads = 1;           ///< CPU threads it keeps busy
+};
+
+/// Estimate postprocessing `audio_samples` of audio under `cfg`, erring
+/// high: `model_bytes` (the whisper and local summary model files, all
+/// resident at once in a warm worker), the audio as float samples, the
+/// diarization peak when `cfg.diarize` (estimate_diarize_peak_bytes()
+/// under resolve_diarize_chunking(), so a chunked recording counts its
+/// parallel chunks, not the whole meeting), a local summary's KV cache
+/// and the process itself. Threads are cfg.threads or
+/// default_thread_count().
+PpFootprint estimate_pp_footprint(const Config& cfg, size_t audio_samples,
+                                  uint64_t model_bytes);
+
+/// estimate_pp_footprint() for the recording at `audio_path` (its duration
+/// at SAMPLE_RATE from probe_audio()'s header, or its size as 16-bit
+/// samples when that is unreadable) with the on-disk size of the whisper and local summary
+/// models `cfg` loads, 0 for any not found.
+PpFootprint estimate_job_footprint(const Config& cfg, const fs::path& audio_path);
+
+/// Postprocessing already in the daemon, as seen by one slot deciding
+/// whether to start a job (everything but that slot).
+struct PpLoad {
+    int jobs = 0;            ///< jobs running, not counting paused ones
+    int threads = 0;         ///< threads of those jobs
+    int paused = 0;          ///< jobs paused for a more urgent one
+    uint64_t bytes = 0;      ///< running and paused footprints, idle warm workers' models
+    bool idle_warm = false;  ///< an idle slot keeps a warm worker
+};
+
+/// Whether a slot may start a job of footprint `next` beside `others`. Never
+/// past `max_jobs` running. Always when nothing else runs or is paused and
+/// no other slot keeps a warm worker, or this one does (`slot_warm`): one
+/// job at a time is never refused, whatever its estimate. Otherwise when
+/// the bytes fit in `budget_bytes` (0 = unknown, not checked) and the
+/// threads in `cores`.
+bool admit_pp_job(const PpFootprint& next, const PpLoad& others, bool slot_warm,
+                  int max_jobs, uint64_t budget_bytes, int cores);
+
+/// Scheduling class of a postprocessing job, most urgent first. The daemon
+/// queues a job behind those of its class and ahead of less urgent ones.
+enum class PpJobClass {
+    Interactive = 0,  ///< a live recording just stopped
+    Reprocess = 1,    ///< a reprocess the operator asked for
+    Batch = 2,        ///< one meeting of a --reprocess-batch backlog
+};
+
+/// "interactive", "reprocess" or "batch".
+const char* pp_job_class_name(PpJobClass cls);
+
+/// The class of a job queued with `cfg`: Batch under `batch_mode`, else
+/// Reprocess when `reprocess_dir` is set, else Interactive.
+PpJobClass pp_job_class(const Config& cfg);
+
+/// Whether a queued job of class `next` may pause a running job of class
+/// `running` to take its place: only an interactive job, and only a batch
+/// one.
+bool pp_may_preempt(PpJobClass next, PpJobClass running);
+
+/// What the daemon does with a reprocess of a meeting it already has a job
+/// for. Reprocess requests from the web UI, the CLI and batch runs are
+/// folded into one execution per meeting directory.
+enum class PpCoalesce {
+    Enqueue,  ///< no other job, or a running one with other stage inputs
+    Queued,   ///< the queued job takes the request's config and runs once
+    Running,  ///< the running job computes the same inputs; follow it
+};
+
+/// `queued` / `running`: the meeting has a queued / running job;
+/// `same_inputs`: the running one's stage inputs (same_manifest_inputs())
+/// match the request's. A queued job absorbs the request even while
+/// another runs, so at most one more run is ever pending.
+PpCoalesce pp_coalesce(bool queued, bool running, bool same_inputs);
+
+#if RECMEET_USE_SHERPA
+/// Diarization of one meeting as run_postprocessing() uses it.
+struct DiarizationOutput {
+    DiarizeResult diar;
+    /// One centroid per cluster, post-collapse (the uncollapsed clusters'
+    /// own when the short-audio collapse bailed); empty only when the sherpa
+    /// pass extracted none and identification must re-extract from audio.
+    std::map<int, std::vector<float>> centroids;
+    /// The sherpa pass this came from, saved as the clustering stage. No
+    /// chunks when it was itself loaded from that stage.
+    ClusteringStage clustering;
+};
+
+/// True when `samples` of audio take the chunked diarization path
+/// (resolve_diarize_chunking() plus two minutes of headroom).
+bool diarize_uses_chunks(const Config& cfg, size_t samples);
+
+/// diarization.speech_only, which needs VAD on.
+bool diarize_speech_only(const Config& cfg);
+
+/// The speech-only diarization input over `audio`, built from the VAD index
+/// (or a fresh VAD pass, saved as the index), with `local_spans` (seconds,
+/// in order) cut out of it; with diarize_speech_only() off, the whole
+/// recording minus `local_spans`. nullptr when neither applies or nothing
+/// is left: diarize `audio`.
+std::unique_ptr<CompactedSampleSource> speech_only_source(
+        const Config& cfg, const PostprocessInput& input, const SampleSource& audio,
+        int threads, const std::vector<std::pair<double, double>>& local_spans = {});
+
+/// diarization.local_speaker: the stretches of the recording at
+/// `audio_path` that its channel envelope attributes to the local user
+/// (local_speech_spans()). Empty when the option is off, or there is no
+/// envelope (mic-only recordings) or it does not cover `samples`.
+std::vector<std::pair<double, double>> local_speaker_spans(const Config& cfg,
+                                                           const fs::path& audio_path,
+                                                           size_t samples);
+
+/// Add `local_spans` to `diar` as one more speaker, numbered after its
+/// highest, keeping the segments in start order. Returns the new ID.
+int add_local_speaker(DiarizeResult& diar,
+                      const std::vector<std::pair<double, double>>& local_spans);
+
+/// Map `diar`'s segments from the compacted timeline of `speech` back to
+/// the recording's, split where a cut silence fell; parts inside an
+/// inserted gap are dropped. Speaker IDs and centroids are unchanged.
+void uncompact_diarization(const CompactedSampleSource& speech, DiarizeResult& diar);
+
+/// The sherpa half of diarization: segmentation, per-chunk clustering at
+/// cluster_threshold and centroid extraction, with the pipeline's
+/// chunked/single-shot dispatch. Reuses chunks diarized while recording.
+/// `on_chunk` gets a "diarize_chunk" record per chunk computed, from the
+/// chunk's worker thread.
+ClusteringStage diarize_for_clustering(const Config& cfg, const PostprocessInput& input,
+                                       const SampleSource& audio, int threads,
+                                       DiarizeProgressCallback diar_progress,
+                                       StagePerfCallback on_chunk = nullptr);
+
+/// Stitching (or the short-audio duration filter) and collapse over a
+/// sherpa pass, with the current settings. Never reads the audio, so a
+/// clustering stage is enough to redo it (--recluster, --diarize-sweep).
+/// Reads only its arguments; safe to run concurrently.
+DiarizationOutput cluster_diarization(const Config& cfg, const PostprocessInput& input,
+                                      const ClusteringStage& stage,
+                                      const std::string& context_text);
+#endif
+
+/// Stage cache keys (stage_cache.h) used by run_postprocessing(): the hash
+/// of the audio (hash_samples()) or of the summary prompt, plus every
+/// setting the stage's output depends on. Settings that only change speed
+/// (threads, workers, overlap) are left out.
+std::string transcript_stage_key(const Config& cfg, const std::string& audio_hash,
+                                 const std::string& initial_prompt);
+std::string diarization_stage_key(const Config& cfg, const std::string& audio_hash,
+                                  const std::string& context_text);
+/// The sherpa pass alone (STAGE_CLUSTERING): segmentation and per-chunk
+/// clustering depend on the audio, cluster_threshold and the chunk plan
+/// (chunked) or --num-speakers (single-shot), nothing after them.
+std::string clustering_stage_key(const Config& cfg, const std::string& audio_hash,
+                                 bool chunked);
+/// `rolling_notes`: the rolling summary the summary is refined from
+/// (rolling_summary.h), empty when it is written from the transcript.
+std::string summary_stage_key(const Config& cfg, const std::string& transcript_text,
+                              const std::string& context_text,
+                              const std::string& rolling_notes = "");
+
+struct MeetingManifest;
+
+/// The inputs run_postprocessing() would record in the manifest
+/// (stage_cache.h) for `cfg` over the meeting in `out_dir` whose recording
+/// hashes to `audio_hash`: the stage keys, with the vocabulary prompt and
+/// the context that `cfg` resolves for that meeting. The audio stat and
+/// note fields are left empty.
+MeetingManifest expected_meeting_manifest(const Config& cfg, const fs::path& out_dir,
+                                          const std::string& audio_hash);
+
 /// Record audio. Phase: "recording". For --reprocess, resolves paths only.
 ///
 /// `caption_hooks` (Phase 3) is consulted only when `cfg.captions_enabled`
 /// is true and a real recording is being performed (i.e. not reprocess).
 /// Pass nullptr (default) for the existing pre-Phase-3 behaviour.
 ///
+/// `levels`, when set, gets each capture's level meter (level_meter.h)
+/// for the length of the recording.
+///
 /// `cancel` is observed alongside `stop` inside the recording loop. When
 /// `cancel.stop_requested()` is true on loop exit (or both tokens are set
 /// — cancel wins), the function stops captures, resets the caption slots,
@@ -162,23 +433,45 @@ PostprocessInput run_recording(const Config& cfg,
                                StopToken& stop,
                                StopToken& cancel,
                                PhaseCallback on_phase = nullptr,
-                               const CaptionHooks* caption_hooks = nullptr);
+                               const CaptionHooks* caption_hooks = nullptr,
+                               LevelFeed* levels = nullptr);
 
 /// Resolve a streaming caption model directory. If `name` is non-empty it
-/// names a subdir under `~/.local/share/recmeet/models/sherpa/online/`;
-/// otherwise falls back to "en-2023-06-26" (the Phase-0 pinned default).
-/// Returns the absolute path; existence is NOT checked here — the engine's
-/// `start()` resolves files inside and reports a clear error if missing.
+/// names a subdir under `~/.local/share/recmeet/models/sherpa/online/`
+/// (its base model's for an `-int8` variant); otherwise falls back to
+/// "en-2023-06-26" (the Phase-0 pinned default). Returns the absolute path;
+/// existence is NOT checked here — the engine's `start()` resolves files
+/// inside and reports a clear error if missing.
 fs::path resolve_caption_model_dir(const std::string& name);
 
+/// The caption engine settings `cfg` asks for: model directory and
+/// precision, the int8 fallback, threads, CPU placement and
+/// Config::caption_keep_warm. Sources are left at the
+/// default (mic only). The daemon's CaptionEngine::prewarm() uses the same
+/// options, so its recognizer matches the one a recording starts.
+CaptionEngine::Options caption_engine_options(const Config& cfg);
+
 /// Transcribe + diarize + summarize + note.
 /// Phases: "transcribing", "diarizing", "summarizing", "complete".
+/// `on_summary_delta` receives the summary as it is generated (not when it
+/// comes from the stage cache). `on_stage_perf` receives each stage's
+/// record (stage_perf.h) as it completes, one call at a time; the same
+/// records come back in PipelineResult::stages.
 PipelineResult run_postprocessing(const Config& cfg, const PostprocessInput& input,
                                   PhaseCallback on_phase = nullptr,
                                   ProgressCallback on_progress = nullptr,
-                                  StopToken* stop = nullptr);
+                                  StopToken* stop = nullptr,
+                                  SummaryDeltaCallback on_summary_delta = nullptr,
+                                  StagePerfCallback on_stage_perf = nullptr);
 
 /// Run the full pipeline: record → validate → mix → transcribe → summarize → note output.
 PipelineResult run_pipeline(const Config& cfg, StopToken& stop, PhaseCallback on_phase = nullptr);
 
+/// Rewrite the note of `meeting_dir` from its note stage (stage_cache.h)
+/// with the speaker labels now in its speakers file, renaming relabelled
+/// speakers in the summary and metadata too. Loads no model; run after a
+/// relabel instead of a reprocess. Returns the note's path. Throws
+/// RecmeetError when the meeting has no audio or no note stage.
+fs::path rerender_meeting_note(const Config& cfg, const fs::path& meeting_dir);
+
 } // namespace recmeet
@@ -0,0 +1,122 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "power_policy.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+namespace recmeet {
+
+namespace {
+
+/// Without a passive or hot trip point, a zone counts as throttled this
+/// far below its critical one (millidegrees).
+constexpr long kCriticalMarginMilliC = 15000;
+
+std::string read_line(const fs::path& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+long read_long(const fs::path& path, long fallback) {
+    const std::string s = read_line(path);
+    char* end = nullptr;
+    const long v = std::strtol(s.c_str(), &end, 10);
+    return end == s.c_str() ? fallback : v;
+}
+
+// Temperature at which the kernel starts throttling zone `zone`, in
+// millidegrees; 0 when it has no usable trip point.
+long throttle_trip(const fs::path& zone) {
+    long passive = 0, critical = 0;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(zone, ec)) {
+        const std::string name = entry.path().filename().string();
+        static const std::string prefix = "trip_point_", suffix = "_type";
+        if (name.compare(0, prefix.size(), prefix) != 0 || name.size() <= suffix.size() ||
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0)
+            continue;
+        const std::string type = read_line(entry.path());
+        const fs::path temp_path =
+            zone / (name.substr(0, name.size() - suffix.size()) + "_temp");
+        const long temp = read_long(temp_path, 0);
+        if (temp <= 0) continue;  // disabled trip point
+        if (type == "passive" || type == "hot")
+            passive = passive > 0 ? std::min(passive, temp) : temp;
+        else if (type == "critical")
+            critical = critical > 0 ? std::min(critical, temp) : temp;
+    }
+    if (passive > 0) return passive;
+    return critical > kCriticalMarginMilliC ? critical - kCriticalMarginMilliC : 0;
+}
+
+} // anonymous namespace
+
+PowerState read_power_state(const fs::path& sys_root) {
+    PowerState state;
+    std::error_code ec;
+    bool mains_online = false, discharging = false;
+    for (const auto& entry : fs::directory_iterator(sys_root / "class/power_supply", ec)) {
+        const fs::path dev = entry.path();
+        const std::string type = read_line(dev / "type");
+        if (type == "Mains" || type == "USB") {
+            if (read_long(dev / "online", 0) > 0) mains_online = true;
+        } else if (type == "Battery") {
+            // A mouse or headset battery is scope "Device"; only the
+            // system's own count.
+            if (read_line(dev / "scope") == "Device") continue;
+            if (read_line(dev / "status") == "Discharging") discharging = true;
+            const long capacity = read_long(dev / "capacity", -1);
+            if (capacity >= 0)
+                state.battery_percent = state.battery_percent < 0
+                    ? static_cast<int>(capacity)
+                    : std::min(state.battery_percent, static_cast<int>(capacity));
+        }
+    }
+    state.on_battery = discharging && !mains_online;
+
+    for (const auto& entry : fs::directory_iterator(sys_root / "class/thermal", ec)) {
+        const fs::path zone = entry.path();
+        if (zone.filename().string().compare(0, 12, "thermal_zone") != 0) continue;
+        const long temp = read_long(zone / "temp", 0);
+        const long trip = throttle_trip(zone);
+        if (temp > 0 && trip > 0 && temp >= trip) state.thermal_throttled = true;
+    }
+    return state;
+}
+
+bool parse_battery_policy(const std::string& name, BatteryPolicy& out) {
+    if (name == "run")    { out = BatteryPolicy::Run;    return true; }
+    if (name == "reduce") { out = BatteryPolicy::Reduce; return true; }
+    if (name == "defer")  { out = BatteryPolicy::Defer;  return true; }
+    return false;
+}
+
+const char* battery_policy_name(BatteryPolicy policy) {
+    switch (policy) {
+        case BatteryPolicy::Run:   return "run";
+        case BatteryPolicy::Defer: return "defer";
+        default:                   return "reduce";
+    }
+}
+
+bool power_reduced(const PowerState& state, BatteryPolicy policy) {
+    return state.on_battery && policy != BatteryPolicy::Run;
+}
+
+bool power_defers(const PowerState& state, BatteryPolicy policy) {
+    return state.on_battery && policy == BatteryPolicy::Defer;
+}
+
+int power_threads(int threads, const PowerState& state, BatteryPolicy policy) {
+    threads = std::max(threads, 1);
+    if (power_reduced(state, policy)) threads = std::max(threads / 4, 1);
+    if (state.thermal_throttled) threads = std::max(threads / 2, 1);
+    return threads;
+}
+
+} // namespace recmeet
@@ -0,0 +1,59 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+
+#include <string>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Power policy (postprocessing on laptops)
+// ---------------------------------------------------------------------------
+//
+// Postprocessing right after a meeting keeps every core busy for minutes,
+// which on battery costs a large share of the charge. The power state is
+// read from sysfs (/sys/class/power_supply, as UPower reads it, and
+// /sys/class/thermal) and postprocessing follows `postprocess.on_battery`:
+//
+//   run     as on AC power
+//   reduce  a quarter of the threads, and postprocess.battery_model (if
+//           set) for transcription instead of transcription.model
+//   defer   the daemon holds queued jobs until AC power returns; a job run
+//           anyway (the CLI, or one already running) is reduced
+//
+// Whatever the power source, a thermal zone at its throttling trip point
+// halves the threads of the steps that start while it stays there.
+
+/// One reading of the host's power supply and temperature.
+struct PowerState {
+    bool on_battery = false;     ///< a system battery is discharging with no mains online
+    int battery_percent = -1;    ///< lowest system battery charge; -1 = no battery
+    bool thermal_throttled = false;  ///< a thermal zone is at its throttling trip point
+};
+
+/// Read the power state under `sys_root` (normally "/sys"). A host without
+/// batteries or thermal zones reads as on AC power and cool.
+PowerState read_power_state(const fs::path& sys_root = "/sys");
+
+enum class BatteryPolicy { Run, Reduce, Defer };
+
+/// Parse "run" / "reduce" / "defer". Returns false otherwise.
+bool parse_battery_policy(const std::string& name, BatteryPolicy& out);
+
+/// "run", "reduce" or "defer".
+const char* battery_policy_name(BatteryPolicy policy);
+
+/// Whether the reduced profile applies: on battery under Reduce or Defer.
+bool power_reduced(const PowerState& state, BatteryPolicy policy);
+
+/// Whether the daemon should hold a queued job: on battery under Defer.
+bool power_defers(const PowerState& state, BatteryPolicy policy);
+
+/// `threads` for a step started in `state`: a quarter in the reduced
+/// profile, halved while thermally throttled, at least 1.
+int power_threads(int threads, const PowerState& state, BatteryPolicy policy);
+
+} // namespace recmeet
@@ -0,0 +1,175 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "reidentify_jobs.h"
+#include "json_util.h"
+#include "log.h"
+#include "speaker_id.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <sstream>
+#include <vector>
+
+namespace recmeet {
+
+std::string reidentify_status_json(const ReidentifyJobStatus& s) {
+    std::ostringstream out;
+    out << "{\"ok\":true,\"job_id\":\"" << json_escape(s.id) << "\""
+        << ",\"state\":\"" << s.state << "\""
+        << ",\"meetings_total\":" << s.meetings_total
+        << ",\"meetings_done\":" << s.meetings_done
+        << ",\"meetings_scanned\":" << s.meetings_scanned
+        << ",\"meetings_updated\":" << s.meetings_updated
+        << ",\"meetings_failed\":" << s.meetings_failed;
+    if (!s.error.empty()) out << ",\"error\":\"" << json_escape(s.error) << "\"";
+    out << "}";
+    return out.str();
+}
+
+#if RECMEET_USE_SHERPA
+
+struct ReidentifyJobs::Job {
+    std::string id;
+    bool running = true;          // guarded by mu_
+    std::string error;            // guarded by mu_
+    size_t total = 0;             // guarded by mu_
+    std::atomic<size_t> done{0};
+    std::atomic<size_t> scanned{0};
+    std::atomic<size_t> updated{0};
+    std::atomic<size_t> failed{0};
+};
+
+ReidentifyJobs::ReidentifyJobs(fs::path speaker_db_dir, fs::path output_dir, bool ann,
+                               float threshold, int threads, std::mutex& write_mu)
+    : speaker_db_dir_(std::move(speaker_db_dir)), output_dir_(std::move(output_dir)),
+      ann_(ann), threshold_(threshold),
+      threads_(threads > 0 ? threads : default_thread_count()), write_mu_(write_mu),
+      id_prefix_(std::to_string(std::chrono::duration_cast<std::chrono::seconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count())) {}
+
+ReidentifyJobs::~ReidentifyJobs() {
+    stop_ = true;
+    if (runner_.joinable()) runner_.join();
+}
+
+ReidentifyJobStatus ReidentifyJobs::start() {
+    std::string id;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (!jobs_.empty() && jobs_.back()->running) {
+            id = jobs_.back()->id;
+            log_info("batch-reidentify: job %s already running", id.c_str());
+        } else {
+            // The previous runner cleared `running` as its last use of mu_.
+            if (runner_.joinable()) runner_.join();
+            auto job = std::make_shared<Job>();
+            id = job->id = id_prefix_ + "-" + std::to_string(next_id_++);
+            jobs_.push_back(job);
+            while (jobs_.size() > kMaxFinished + 1) jobs_.pop_front();
+            runner_ = std::thread([this, job] { run(job); });
+        }
+    }
+    ReidentifyJobStatus out;
+    status(id, out);
+    return out;
+}
+
+bool ReidentifyJobs::status(const std::string& id, ReidentifyJobStatus& out) const {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = std::find_if(jobs_.begin(), jobs_.end(),
+                           [&](const std::shared_ptr<Job>& j) { return j->id == id; });
+    if (it == jobs_.end()) return false;
+    const Job& job = **it;
+    out.id = job.id;
+    out.state = job.running ? "running" : job.error.empty() ? "done" : "failed";
+    out.error = job.error;
+    out.meetings_total = job.total;
+    out.meetings_done = job.done;
+    out.meetings_scanned = job.scanned;
+    out.meetings_updated = job.updated;
+    out.meetings_failed = job.failed;
+    return true;
+}
+
+void ReidentifyJobs::wait(const std::string& id) const {
+    std::unique_lock<std::mutex> lock(mu_);
+    cv_.wait(lock, [&] {
+        return std::none_of(jobs_.begin(), jobs_.end(), [&](const std::shared_ptr<Job>& j) {
+            return j->id == id && j->running;
+        });
+    });
+}
+
+void ReidentifyJobs::run(const std::shared_ptr<Job>& job) {
+    std::string error;
+    try {
+        // Shared with every other request; registered once, not per meeting.
+        const auto index = acquire_speaker_index(speaker_db_dir_, ann_);
+        std::vector<fs::path> meetings;
+        if (!index->empty() && fs::is_directory(output_dir_)) {
+            for (const auto& entry : fs::directory_iterator(output_dir_))
+                if (entry.is_directory() && !find_speakers_file(entry.path()).empty())
+                    meetings.push_back(entry.path());
+            std::sort(meetings.begin(), meetings.end());
+        }
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            job->total = meetings.size();
+        }
+        log_info("batch-reidentify: job %s over %zu meeting(s)", job->id.c_str(), meetings.size());
+
+        std::atomic<size_t> next{0};
+        auto work = [&]() {
+            while (!stop_) {
+                const size_t i = next.fetch_add(1);
+                if (i >= meetings.size()) return;
+                const fs::path& dir = meetings[i];
+                try {
+                    auto spks = load_meeting_speakers(dir);
+                    if (!spks.empty()) {
+                        ++job->scanned;
+                        // Matching runs unlocked; only a meeting that changes is
+                        // re-read and rewritten under the lock, so a relabel that
+                        // landed in between is kept (it is confidence 1.0).
+                        if (!re_identify_meeting(spks, *index, threshold_).empty()) {
+                            std::lock_guard<std::mutex> lock(write_mu_);
+                            EmbeddingPrecision precision;
+                            auto result = re_identify_meeting(
+                                load_meeting_speakers(dir, &precision), *index, threshold_);
+                            if (!result.empty()) {
+                                save_meeting_speakers(dir, result, derive_meeting_timestamp(dir),
+                                                      precision);
+                                ++job->updated;
+                            }
+                        }
+                    }
+                } catch (const std::exception& e) {
+                    log_warn("batch-reidentify: %s: %s", dir.filename().c_str(), e.what());
+                    ++job->failed;
+                }
+                ++job->done;
+            }
+        };
+        const int n = std::max(1, std::min(threads_, static_cast<int>(meetings.size())));
+        std::vector<std::thread> pool;
+        for (int w = 1; w < n; ++w) pool.emplace_back(work);
+        work();
+        for (auto& t : pool) t.join();
+        if (stop_ && job->done < meetings.size()) error = "server stopped";
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+
+    log_info("batch-reidentify: job %s %s (%zu updated of %zu scanned)", job->id.c_str(),
+             error.empty() ? "done" : "failed", job->updated.load(), job->scanned.load());
+    std::lock_guard<std::mutex> lock(mu_);
+    job->error = error;
+    job->running = false;
+    cv_.notify_all();
+}
+
+#endif
+
+} // namespace recmeet
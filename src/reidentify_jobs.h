@@ -0,0 +1,93 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Background batch re-identification (recmeet-web)
+// ---------------------------------------------------------------------------
+//
+// `POST /api/speakers/batch-reidentify` starts a job here and returns its
+// ID; `GET /api/jobs/<id>` reports its progress. A job re-identifies every
+// meeting under the output directory that has a speakers file against the
+// shared SpeakerIndex (acquire_speaker_index()), on a pool of worker
+// threads over meetings.
+
+/// Snapshot of one job.
+struct ReidentifyJobStatus {
+    std::string id;
+    std::string state;            ///< "running", "done" or "failed"
+    std::string error;            ///< why the job failed
+    size_t meetings_total = 0;    ///< meetings with a speakers file
+    size_t meetings_done = 0;     ///< of those, finished so far
+    size_t meetings_scanned = 0;  ///< finished with at least one speaker
+    size_t meetings_updated = 0;  ///< rewritten with new labels
+    size_t meetings_failed = 0;   ///< could not be read or written
+};
+
+/// JSON body for a status, `{"ok":true,"job_id":...}`.
+std::string reidentify_status_json(const ReidentifyJobStatus& status);
+
+#if RECMEET_USE_SHERPA
+class ReidentifyJobs {
+public:
+    /// Jobs re-identify meetings under `output_dir` against `speaker_db_dir`
+    /// at `threshold`, on `threads` workers (0 = default_thread_count()).
+    /// `write_mu` is held around each meeting-file rewrite — the mutex the
+    /// server's relabel and enroll handlers hold.
+    ReidentifyJobs(fs::path speaker_db_dir, fs::path output_dir, bool ann,
+                   float threshold, int threads, std::mutex& write_mu);
+    /// Stops the running job after the meetings already started, and waits.
+    ~ReidentifyJobs();
+
+    ReidentifyJobs(const ReidentifyJobs&) = delete;
+    ReidentifyJobs& operator=(const ReidentifyJobs&) = delete;
+
+    /// Start a job and return its status. While a job runs, a second start
+    /// returns the running one instead of scanning twice.
+    ReidentifyJobStatus start();
+
+    /// Status of job `id`; false when no such job is remembered (the last
+    /// kMaxFinished finished jobs are).
+    bool status(const std::string& id, ReidentifyJobStatus& out) const;
+
+    /// Block until job `id` is no longer running. Test seam.
+    void wait(const std::string& id) const;
+
+    static constexpr size_t kMaxFinished = 16;
+
+private:
+    struct Job;
+    void run(const std::shared_ptr<Job>& job);
+
+    const fs::path speaker_db_dir_;
+    const fs::path output_dir_;
+    const bool ann_;
+    const float threshold_;
+    const int threads_;
+    std::mutex& write_mu_;
+
+    mutable std::mutex mu_;
+    mutable std::condition_variable cv_;     ///< a job finished
+    std::deque<std::shared_ptr<Job>> jobs_;  ///< oldest first
+    std::thread runner_;
+    std::atomic<bool> stop_{false};
+    const std::string id_prefix_;  ///< server start time, so IDs never repeat
+    unsigned long long next_id_ = 1;
+};
+#endif
+
+} // namespace recmeet
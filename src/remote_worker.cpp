@@ -0,0 +1,428 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "remote_worker.h"
+#include "config_json.h"
+#include "ipc_client.h"
+#include "ipc_server.h"
+#include "log.h"
+#include "pipeline.h"
+#include "speaker_id.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+namespace recmeet {
+
+namespace {
+
+constexpr const char* STAGE_PREFIX = "stage_";
+constexpr const char* SPEAKER_DB_PREFIX = "speakers/";
+
+bool plain_name_ok(const std::string& name) {
+    return !name.empty() && name.size() <= 255 && name[0] != '.' &&
+           name.find('/') == std::string::npos && name.find('\0') == std::string::npos;
+}
+
+bool starts_with(const std::string& s, const char* prefix) {
+    return s.compare(0, std::char_traits<char>::length(prefix), prefix) == 0;
+}
+
+uint64_t size_or_zero(const fs::path& path) {
+    std::error_code ec;
+    const uint64_t n = fs::file_size(path, ec);
+    return ec ? 0 : n;
+}
+
+// Up to `max` bytes of `path` from `offset` into `out`. False when the file
+// cannot be read there.
+bool read_chunk(const fs::path& path, uint64_t offset, size_t max, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    in.seekg(static_cast<std::streamoff>(offset));
+    if (!in) return false;
+    out.resize(max);
+    in.read(out.data(), static_cast<std::streamsize>(max));
+    out.resize(static_cast<size_t>(in.gcount()));
+    return true;
+}
+
+bool fail(IpcError& err, IpcErrorCode code, const std::string& message) {
+    err.code = static_cast<int>(code);
+    err.message = message;
+    return false;
+}
+
+std::string param(const IpcRequest& req, const char* key) {
+    auto it = req.params.find(key);
+    return it == req.params.end() ? std::string() : json_val_as_string(it->second);
+}
+
+int64_t int_param(const IpcRequest& req, const char* key) {
+    auto it = req.params.find(key);
+    return it == req.params.end() ? -1 : json_val_as_int(it->second, -1);
+}
+
+// The job directory for `req`'s "job", or empty with `err` set.
+fs::path job_dir(const fs::path& root, const IpcRequest& req, IpcError& err) {
+    const std::string id = param(req, "job");
+    if (!remote_job_id_ok(id)) {
+        fail(err, IpcErrorCode::InvalidParams, "invalid job id");
+        return {};
+    }
+    return root / id;
+}
+
+// The file `req` names inside `dir`, or empty with `err` set.
+fs::path job_file(const fs::path& dir, const IpcRequest& req, IpcError& err) {
+    const std::string name = param(req, "name");
+    if (!remote_file_name_ok(name)) {
+        fail(err, IpcErrorCode::InvalidParams, "invalid file name");
+        return {};
+    }
+    return dir / name;
+}
+
+} // anonymous namespace
+
+fs::path remote_jobs_dir() {
+    return data_dir() / "remote-jobs";
+}
+
+std::string remote_job_id(const std::string& host, const fs::path& out_dir) {
+    std::string id = host + "_" + out_dir.filename().string();
+    for (char& c : id)
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '.' && c != '_' && c != '-')
+            c = '_';
+    if (id[0] == '.') id[0] = '_';
+    return id.substr(0, 128);
+}
+
+bool remote_job_id_ok(const std::string& id) {
+    if (id.empty() || id.size() > 128 || id[0] == '.') return false;
+    return std::all_of(id.begin(), id.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '.' || c == '_' || c == '-';
+    });
+}
+
+bool remote_file_name_ok(const std::string& name) {
+    if (starts_with(name, SPEAKER_DB_PREFIX))
+        return plain_name_ok(name.substr(std::char_traits<char>::length(SPEAKER_DB_PREFIX)));
+    return plain_name_ok(name);
+}
+
+std::vector<std::pair<std::string, fs::path>>
+remote_upload_files(const Config& cfg, const fs::path& out_dir) {
+    std::vector<std::pair<std::string, fs::path>> files;
+    auto add_dir = [&files](const fs::path& dir, const std::string& prefix, bool meeting) {
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(dir, ec)) {
+            if (!entry.is_regular_file(ec)) continue;
+            const std::string name = entry.path().filename().string();
+            if (!plain_name_ok(name)) continue;
+            if (meeting && (entry.path().extension() == ".md" || starts_with(name, "perf_") ||
+                            name == SOURCES_NAME || name == "mic.wav" ||
+                            name == "monitor.wav"))
+                continue;
+            files.emplace_back(prefix + name, entry.path());
+        }
+    };
+    add_dir(out_dir, "", true);
+    if (cfg.speaker_id)
+        add_dir(cfg.speaker_db.empty() ? default_speaker_db_dir() : cfg.speaker_db,
+                SPEAKER_DB_PREFIX, false);
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+Config remote_job_config(const Config& cfg, const fs::path& out_dir) {
+    Config job = cfg;
+    job.context_inline = resolve_context_text(cfg, out_dir);
+    job.remote_worker.clear();
+    job.note_dir.clear();
+    job.context_file.clear();
+    job.speaker_db.clear();
+    job.log_dir.clear();
+    job.reprocess_dir.clear();
+    job.reprocess_batch_dir.clear();
+    job.debug_dump_centroids_path.clear();
+    job.batch_mode = false;
+    // A model file on this host is not on the worker: summarize locally.
+    if (job.llm_model.find('/') != std::string::npos) job.no_summary = true;
+    return job;
+}
+
+void apply_worker_config(Config& job, const Config& worker, const fs::path& dir) {
+    job.remote_worker.clear();
+    job.reprocess_dir = dir;
+    job.output_dir = dir.parent_path();
+    std::error_code ec;
+    if (fs::is_directory(dir / "speakers", ec)) job.speaker_db = dir / "speakers";
+    job.threads = worker.threads;
+    job.pin_threads = worker.pin_threads;
+    job.backend_bench = worker.backend_bench;
+    job.whisper_gpu = worker.whisper_gpu;
+    job.llm_gpu_layers = worker.llm_gpu_layers;
+    job.pp_worker_jobs = worker.pp_worker_jobs;
+    job.pp_worker_rss_mb = worker.pp_worker_rss_mb;
+    job.stage_cache = true;  // the stages are what goes back
+}
+
+void register_worker_methods(IpcServer& server, const fs::path& root, WorkerHooks hooks) {
+    server.on("worker.stat", [root](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
+        const fs::path dir = job_dir(root, req, err);
+        if (dir.empty()) return false;
+        const fs::path file = job_file(dir, req, err);
+        if (file.empty()) return false;
+        resp.result["size"] = static_cast<int64_t>(size_or_zero(file));
+        return true;
+    });
+
+    // Appends at `offset`, which must not pass the bytes already held; a
+    // smaller one drops the tail first.
+    server.on("worker.upload", [root](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
+        const fs::path dir = job_dir(root, req, err);
+        if (dir.empty()) return false;
+        const fs::path file = job_file(dir, req, err);
+        if (file.empty()) return false;
+        const int64_t offset = int_param(req, "offset");
+        std::string data;
+        if (offset < 0 || !base64_decode(param(req, "data"), data) ||
+            data.size() > REMOTE_CHUNK_BYTES)
+            return fail(err, IpcErrorCode::InvalidParams, "invalid offset or data");
+        const uint64_t have = size_or_zero(file);
+        if (static_cast<uint64_t>(offset) > have)
+            return fail(err, IpcErrorCode::InvalidParams,
+                        "offset " + std::to_string(offset) + " past " + std::to_string(have));
+        std::error_code ec;
+        fs::create_directories(file.parent_path(), ec);
+        if (static_cast<uint64_t>(offset) < have) fs::resize_file(file, offset, ec);
+        std::ofstream out(file, std::ios::binary | std::ios::app);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!out.flush())
+            return fail(err, IpcErrorCode::InternalError, "cannot write " + file.filename().string());
+        resp.result["size"] = static_cast<int64_t>(offset) + static_cast<int64_t>(data.size());
+        return true;
+    });
+
+    server.on("worker.run", [root, hooks](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
+        const fs::path dir = job_dir(root, req, err);
+        if (dir.empty()) return false;
+        if (find_audio_file(dir).empty())
+            return fail(err, IpcErrorCode::InvalidParams, "no audio uploaded");
+        Config cfg;
+        try {
+            cfg = config_from_json(param(req, "config"));
+        } catch (const std::exception& e) {
+            return fail(err, IpcErrorCode::InvalidParams, std::string("config: ") + e.what());
+        }
+        std::string error;
+        if (!hooks.run(dir.filename().string(), std::move(cfg), dir, error))
+            return fail(err, IpcErrorCode::Busy, error);
+        resp.result["ok"] = true;
+        return true;
+    });
+
+    server.on("worker.status", [root, hooks](const IpcRequest& req, IpcResponse& resp,
+                                             IpcError& err) {
+        const fs::path dir = job_dir(root, req, err);
+        if (dir.empty()) return false;
+        const RemoteJobStatus st = hooks.status(dir.filename().string());
+        resp.result["state"] = st.state;
+        if (!st.error.empty()) resp.result["error"] = st.error;
+        return true;
+    });
+
+    // The stage files, as f<i>_name / f<i>_size.
+    server.on("worker.files", [root](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
+        const fs::path dir = job_dir(root, req, err);
+        if (dir.empty()) return false;
+        std::vector<std::string> names;
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(dir, ec)) {
+            const std::string name = entry.path().filename().string();
+            if (entry.is_regular_file(ec) && starts_with(name, STAGE_PREFIX) &&
+                entry.path().extension() == ".json")
+                names.push_back(name);
+        }
+        std::sort(names.begin(), names.end());
+        for (size_t i = 0; i < names.size(); ++i) {
+            const std::string key = "f" + std::to_string(i) + "_";
+            resp.result[key + "name"] = names[i];
+            resp.result[key + "size"] = static_cast<int64_t>(size_or_zero(dir / names[i]));
+        }
+        resp.result["count"] = static_cast<int64_t>(names.size());
+        return true;
+    });
+
+    server.on("worker.fetch", [root](const IpcRequest& req, IpcResponse& resp, IpcError& err) {
+        const fs::path dir = job_dir(root, req, err);
+        if (dir.empty()) return false;
+        const fs::path file = job_file(dir, req, err);
+        if (file.empty()) return false;
+        const int64_t offset = int_param(req, "offset");
+        std::string data;
+        if (offset < 0 || !read_chunk(file, static_cast<uint64_t>(offset), REMOTE_CHUNK_BYTES, data))
+            return fail(err, IpcErrorCode::InvalidParams, "cannot read " + file.filename().string());
+        resp.result["data"] = base64_encode(data);
+        resp.result["size"] = static_cast<int64_t>(size_or_zero(file));
+        return true;
+    });
+
+    server.on("worker.cancel", [root, hooks](const IpcRequest& req, IpcResponse& resp,
+                                             IpcError& err) {
+        const fs::path dir = job_dir(root, req, err);
+        if (dir.empty()) return false;
+        hooks.cancel(dir.filename().string());
+        resp.result["ok"] = true;
+        return true;
+    });
+
+    server.on("worker.release", [root, hooks](const IpcRequest& req, IpcResponse& resp,
+                                              IpcError& err) {
+        const fs::path dir = job_dir(root, req, err);
+        if (dir.empty()) return false;
+        hooks.cancel(dir.filename().string());
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+        resp.result["ok"] = true;
+        return true;
+    });
+}
+
+size_t offload_postprocessing(const RemoteOffload& opts, const Config& cfg,
+                              const fs::path& out_dir) {
+    IpcClient client(opts.address);
+    auto connect = [&] {
+        if (!client.connect()) throw RecmeetError("cannot reach " + opts.address);
+        client.negotiate_framing(IpcFraming::MsgPack);
+    };
+    connect();
+
+    // One reconnect per call: a dropped connection costs a retry, not the
+    // upload so far.
+    auto call = [&](const std::string& method, JsonMap params) {
+        params["job"] = opts.job_id;
+        IpcResponse resp;
+        IpcError err;
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            if (!client.connected()) connect();
+            if (client.call(method, params, resp, err)) return resp.result;
+            if (client.connected()) break;  // the worker answered with an error
+        }
+        throw RecmeetError(method + ": " + err.message);
+    };
+    auto progress = [&opts](const std::string& phase, uint64_t done, uint64_t total) {
+        if (opts.on_progress)
+            opts.on_progress(phase, total ? static_cast<int>(done * 100 / total) : 100);
+    };
+    auto stopped = [&opts] { return opts.stop && opts.stop->stop_requested(); };
+    auto cancel_remote = [&] {
+        try {
+            call("worker.release", {});
+        } catch (const std::exception& e) {
+            log_warn("remote_worker: could not release %s: %s", opts.job_id.c_str(), e.what());
+        }
+        throw RecmeetError("Cancelled");
+    };
+
+    // --- Upload, resuming each file where the worker has it ---
+    const auto files = remote_upload_files(cfg, out_dir);
+    uint64_t total = 0, sent = 0;
+    for (const auto& f : files) total += size_or_zero(f.second);
+    for (const auto& [name, path] : files) {
+        const uint64_t size = size_or_zero(path);
+        JsonMap p;
+        p["name"] = name;
+        uint64_t offset = static_cast<uint64_t>(json_val_as_int(call("worker.stat", p)["size"]));
+        if (offset > size) offset = 0;
+        sent += offset;
+        std::string chunk;
+        while (offset < size || (size == 0 && offset == 0)) {
+            if (stopped()) cancel_remote();
+            if (!read_chunk(path, offset, REMOTE_CHUNK_BYTES, chunk))
+                throw RecmeetError("cannot read " + path.string());
+            p["offset"] = static_cast<int64_t>(offset);
+            p["data"] = base64_encode(chunk);
+            call("worker.upload", p);
+            offset += chunk.size();
+            sent += chunk.size();
+            progress("uploading", sent, total);
+            if (chunk.empty()) break;
+        }
+    }
+    log_info("remote_worker: uploaded %zu files (%llu MB) to %s", files.size(),
+             (unsigned long long)(total >> 20), opts.address.c_str());
+
+    // --- Run, then wait for it ---
+    JsonMap run;
+    run["config"] = config_to_json(remote_job_config(cfg, out_dir));
+    call("worker.run", run);
+    const std::string waiting = "processing on " + opts.address;
+    progress(waiting, 0, 1);
+    RemoteJobStatus st;
+    while (true) {
+        if (stopped()) cancel_remote();
+        const JsonMap r = call("worker.status", {});
+        st.state = json_val_as_string(r.count("state") ? r.at("state") : JsonVal{});
+        st.error = json_val_as_string(r.count("error") ? r.at("error") : JsonVal{});
+        if (st.state == "done" || st.state == "failed" || st.state == "cancelled") break;
+        if (st.state != "queued" && st.state != "running")
+            throw RecmeetError("worker lost the job (" + st.state + ")");
+        std::this_thread::sleep_for(std::chrono::milliseconds(opts.poll_ms));
+    }
+    if (st.state != "done")
+        log_warn("remote_worker: job %s %s on %s%s%s", opts.job_id.c_str(), st.state.c_str(),
+                 opts.address.c_str(), st.error.empty() ? "" : ": ", st.error.c_str());
+
+    // --- Fetch the stages it wrote ---
+    const JsonMap list = call("worker.files", {});
+    const int64_t count = json_val_as_int(list.count("count") ? list.at("count") : JsonVal{});
+    uint64_t want = 0, got = 0;
+    std::vector<std::string> names;
+    for (int64_t i = 0; i < count; ++i) {
+        const std::string key = "f" + std::to_string(i) + "_";
+        auto name = list.find(key + "name");
+        auto size = list.find(key + "size");
+        if (name == list.end() || size == list.end()) continue;
+        const std::string n = json_val_as_string(name->second);
+        if (!starts_with(n, STAGE_PREFIX) || !plain_name_ok(n)) continue;
+        names.push_back(n);
+        want += static_cast<uint64_t>(json_val_as_int(size->second));
+    }
+    for (const auto& name : names) {
+        std::string body, data;
+        JsonMap p;
+        p["name"] = name;
+        int64_t size = -1;
+        while (size < 0 || static_cast<int64_t>(body.size()) < size) {
+            if (stopped()) cancel_remote();
+            p["offset"] = static_cast<int64_t>(body.size());
+            const JsonMap r = call("worker.fetch", p);
+            size = json_val_as_int(r.count("size") ? r.at("size") : JsonVal{});
+            if (!base64_decode(json_val_as_string(r.count("data") ? r.at("data") : JsonVal{}),
+                               data))
+                throw RecmeetError("worker.fetch: corrupt data for " + name);
+            if (data.empty() && static_cast<int64_t>(body.size()) < size)
+                throw RecmeetError("worker.fetch: " + name + " ended early");
+            body += data;
+            got += data.size();
+            progress("downloading", got, want);
+        }
+        write_text_file_atomic(out_dir / name, body);
+    }
+    if (names.empty())
+        throw RecmeetError("worker " + st.state + " without a stage" +
+                           (st.error.empty() ? "" : ": " + st.error));
+
+    try {
+        call("worker.release", {});
+    } catch (const std::exception& e) {
+        log_warn("remote_worker: could not release %s: %s", opts.job_id.c_str(), e.what());
+    }
+    return names.size();
+}
+
+} // namespace recmeet
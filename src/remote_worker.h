@@ -0,0 +1,111 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "config.h"
+#include "util.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace recmeet {
+
+class IpcServer;
+
+// ---------------------------------------------------------------------------
+// Remote postprocessing worker
+// ---------------------------------------------------------------------------
+//
+// A daemon with `postprocess.remote_worker` set hands a job's heavy stages
+// to another recmeet-daemon started with --worker, such as a GPU host:
+//
+//   1. worker.stat / worker.upload: the meeting directory's inputs (audio,
+//      context, captions, live and stage files) and the speaker database,
+//      REMOTE_CHUNK_BYTES at a time. A file resumes from the size the
+//      worker already holds, so a dropped upload is not sent again.
+//   2. worker.run: the job's config. The worker queues it as its own job.
+//   3. worker.status until it ends; then worker.files / worker.fetch for
+//      the stage_*.json files it wrote, back into the meeting directory.
+//      A failed job still returns the stages it finished.
+//   4. worker.release: the worker deletes its copy.
+//
+// The local job then runs as before and loads those stages from the stage
+// cache instead of computing them, so speaker identification and the note
+// stay local. If the worker is unreachable or fails, the local pass simply
+// computes everything.
+
+inline constexpr size_t REMOTE_CHUNK_BYTES = 1 << 20;
+
+/// `<data_dir>/remote-jobs`: a worker's copies, one directory per job.
+fs::path remote_jobs_dir();
+
+/// The id a worker files `out_dir` under: `<host>_<meeting dir name>`, with
+/// anything outside [A-Za-z0-9._-] replaced by '_'.
+std::string remote_job_id(const std::string& host, const fs::path& out_dir);
+
+/// A usable job id: [A-Za-z0-9._-], 1-128 characters, no leading '.'.
+bool remote_job_id_ok(const std::string& id);
+
+/// A file a job may hold: a plain name without a leading '.', or
+/// `speakers/<plain name>` for the speaker database.
+bool remote_file_name_ok(const std::string& name);
+
+/// (remote name, local path) of every file uploaded for `out_dir`: its
+/// regular files except notes (*.md), perf records and the raw mic /
+/// monitor captures, then the speaker database as `speakers/<name>` when
+/// speaker identification is on.
+std::vector<std::pair<std::string, fs::path>>
+remote_upload_files(const Config& cfg, const fs::path& out_dir);
+
+/// The config sent with worker.run for `out_dir`: `cfg` without this
+/// host's paths and without remote_worker, its context resolved into
+/// context_inline so the stage keys match. A summary model given as a path
+/// stays local (no_summary on the worker).
+Config remote_job_config(const Config& cfg, const fs::path& out_dir);
+
+/// The worker's side of remote_job_config(): point `job` at `dir` and take
+/// the hardware settings (threads, GPU, placement, warm worker) from
+/// `worker`, the worker's own config.
+void apply_worker_config(Config& job, const Config& worker, const fs::path& dir);
+
+struct RemoteJobStatus {
+    std::string state = "unknown";  ///< queued, running, done, failed, cancelled, unknown
+    std::string error;
+};
+
+/// What a worker daemon does with a job; register_worker_methods() handles
+/// the files.
+struct WorkerHooks {
+    /// Queue a job over `dir` with `cfg` (remote_job_config()). False with
+    /// `error` set when it cannot.
+    std::function<bool(const std::string& id, Config cfg, const fs::path& dir,
+                       std::string& error)> run;
+    std::function<RemoteJobStatus(const std::string& id)> status;
+    /// Stop the job, running or queued. Unknown ids are ignored.
+    std::function<void(const std::string& id)> cancel;
+};
+
+/// Register the worker.* methods on `server`, keeping jobs under `root`.
+void register_worker_methods(IpcServer& server, const fs::path& root, WorkerHooks hooks);
+
+struct RemoteOffload {
+    std::string address;  ///< the worker, host:port (parse_ipc_address)
+    std::string job_id;   ///< remote_job_id()
+    const StopToken* stop = nullptr;
+    /// "uploading" / "processing on <address>" / "downloading", 0-100.
+    std::function<void(const std::string& phase, int percent)> on_progress;
+    int poll_ms = 2000;   ///< worker.status interval
+};
+
+/// Run `cfg`'s job over `out_dir` on the worker and fetch its stage files
+/// into `out_dir`. Returns the number fetched. Throws RecmeetError when the
+/// worker cannot be reached, fails before writing any stage, or `stop` is
+/// requested (the remote job is cancelled first).
+size_t offload_postprocessing(const RemoteOffload& opts, const Config& cfg,
+                              const fs::path& out_dir);
+
+} // namespace recmeet
@@ -3,6 +3,7 @@
 
 #include "reprocess_batch.h"
 
+#include "audio_file.h"
 #include "caption_format.h"
 #include "cli.h"
 #include "config.h"
@@ -10,9 +11,14 @@
 #include "ipc_client.h"
 #include "ipc_protocol.h"
 #include "log.h"
+#include "model_cache.h"
 #include "model_manager.h"
 #include "notify.h"
 #include "pipeline.h"
+#include "stage_cache.h"
+#include "audio_view.h"
+#include "backend_bench.h"
+#include "backend_info.h"
 #include "util.h"
 
 #include <whisper.h>
@@ -20,13 +26,18 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <csignal>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <exception>
+#include <mutex>
+#include <optional>
 #include <regex>
 #include <string>
 #include <system_error>
+#include <thread>
 #include <unistd.h>
 #include <vector>
 
@@ -206,8 +217,11 @@ int client_record_no_sigaction(const Config& cfg, const std::string& addr,
         } else if (ev.event == "caption" && show_captions_on_stderr) {
             std::string text = json_val_as_string(ev.data.at("text"));
             bool is_partial = json_val_as_bool(ev.data.at("is_partial"));
+            auto src_it = ev.data.find("source");
+            std::string source = src_it != ev.data.end()
+                ? json_val_as_string(src_it->second) : std::string();
             std::string line = format_caption_for_cli(
-                text, is_partial, normalize_caption_display);
+                text, is_partial, normalize_caption_display, source);
             // Don't tangle with the elapsed-time / progress \r line.
             if (cli_tty && last_cli_progress >= 0) {
                 fprintf(stderr, "\r\033[K");
@@ -264,6 +278,9 @@ int client_record_no_sigaction(const Config& cfg, const std::string& addr,
         }
     });
 
+    // Progress and caption events are most of this connection's traffic.
+    client.negotiate_framing(IpcFraming::MsgPack);
+
     // Publish the live client to the batch-level SIGINT handler. Stored
     // unconditionally for simplicity; the single-meeting wrapper's handler
     // also reads this same atomic to forward Ctrl-C to the daemon.
@@ -307,6 +324,9 @@ int client_record_no_sigaction(const Config& cfg, const std::string& addr,
 
 static std::atomic<bool> g_batch_stop_requested{false};
 static std::atomic<StopToken*> g_active_iter_stop{nullptr};
+// The meetings in flight of a concurrent standalone batch, one entry per
+// run_parallel_batch worker slot (null while the slot is idle).
+static std::atomic<StopToken*> g_parallel_iter_stops[MAX_BATCH_JOBS];
 // External linkage — set by client_record_no_sigaction (in main.cpp).
 std::atomic<IpcClient*> g_active_ipc_client{nullptr};
 
@@ -337,6 +357,10 @@ extern "C" void batch_sigint_handler(int) {
     g_batch_stop_requested.store(true, std::memory_order_release);
     StopToken* tok = g_active_iter_stop.load(std::memory_order_acquire);
     if (tok) tok->request();
+    for (auto& slot : g_parallel_iter_stops) {
+        StopToken* t = slot.load(std::memory_order_acquire);
+        if (t) t->request();
+    }
 }
 
 // Test-only hooks. Defined here so the Catch2 binary can invoke the handler
@@ -408,6 +432,32 @@ bool note_exists_for(const fs::path& note_parent, const std::string& timestamp)
     return false;
 }
 
+// --refresh: how a meeting whose note exists compares with its manifest.
+BatchEntryKind refresh_kind(const Config& cfg, const fs::path& dir, const fs::path& audio) {
+    MeetingManifest recorded;
+    if (!load_meeting_manifest(meeting_manifest_path(audio), recorded))
+        return BatchEntryKind::SkipNoteExists;
+    std::string audio_hash = recorded.audio_hash;
+    uint64_t bytes = 0;
+    int64_t mtime = 0;
+    if (!stat_manifest_audio(audio, bytes, mtime) || bytes != recorded.audio_bytes ||
+        mtime != recorded.audio_mtime) {
+        try {
+            AudioView view(audio);
+            audio_hash = view.original_hash();
+            if (audio_hash.empty()) audio_hash = hash_samples(view);
+        } catch (const std::exception& e) {
+            log_warn("reprocess-batch: cannot hash %s: %s", audio.c_str(), e.what());
+            return BatchEntryKind::SkipNoteExists;
+        }
+    }
+    if (same_manifest_inputs(expected_meeting_manifest(cfg, dir, audio_hash), recorded))
+        return BatchEntryKind::SkipNoteExists;
+    if (recorded.note_path.empty() || hash_file(recorded.note_path) != recorded.note_hash)
+        return BatchEntryKind::SkipNoteEdited;
+    return BatchEntryKind::WillRefresh;
+}
+
 } // anonymous namespace
 
 std::vector<BatchEntry> classify_batch_entries(
@@ -430,14 +480,19 @@ std::vector<BatchEntry> classify_batch_entries(
         be.timestamp = m[1].str();  // canonical YYYY-MM-DD_HH-MM (suffix stripped)
 
         fs::path audio = find_audio_file(be.dir);
-        if (audio.empty()) {
-            be.kind = BatchEntryKind::SkipNoAudio;
-        } else {
+        if (!audio.empty()) {
             fs::path note_parent = resolve_note_parent(cfg, be.dir, be.timestamp);
-            if (note_exists_for(note_parent, be.timestamp)) {
-                be.kind = BatchEntryKind::SkipNoteExists;
+            const bool noted = note_exists_for(note_parent, be.timestamp);
+            const AudioProbe probe = probe_audio(audio, noted ? 0 : AUDIO_PROBE_BLOCKS);
+            be.audio_seconds = probe.duration_sec;
+            if (!probe.readable) {
+                be.kind = BatchEntryKind::SkipNoAudio;
+            } else if (noted) {
+                be.kind = cfg.reprocess_batch_refresh ? refresh_kind(cfg, be.dir, audio)
+                                                      : BatchEntryKind::SkipNoteExists;
             } else {
                 be.kind = BatchEntryKind::WillReprocess;
+                be.audio_silent = probe.silent();
             }
         }
         entries.push_back(std::move(be));
@@ -536,11 +591,90 @@ Outcome dispatch_one_reprocess_standalone(const Config& cfg, StopToken& iter_sto
     return o;
 }
 
+// One meeting on one cluster node. Unlike client_record_no_sigaction this
+// keeps no process-wide state, so one runs per node at once, and it prints
+// nothing: the driver reports each meeting on its own line. The job is
+// followed by its job_id (events.subscribe), ending at its job.complete or
+// job.failed event. A connection that fails or drops before then is
+// DaemonUnreachable, so the meeting is run elsewhere.
+Outcome dispatch_one_reprocess_cluster(const Config& cfg, const std::string& addr) {
+    Outcome o;
+    auto t0 = std::chrono::steady_clock::now();
+    auto finish = [&o, t0](Outcome::Kind kind, std::string message) {
+        o.kind = kind;
+        o.error_message = std::move(message);
+        o.duration_seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t0).count();
+        return o;
+    };
+    auto stopping = [] { return g_batch_stop_requested.load(std::memory_order_acquire); };
+
+    IpcClient client(addr);
+    if (!client.connect())
+        return finish(Outcome::Kind::DaemonUnreachable, "daemon connect failed");
+    client.negotiate_framing(IpcFraming::MsgPack);
+
+    // A reprocess holds the daemon's recording side only until its job is
+    // queued, so Busy from a concurrent record.start clears in moments.
+    IpcResponse resp;
+    IpcError err;
+    const JsonMap params = config_to_map(cfg);
+    for (int attempt = 0; !client.call("record.start", params, resp, err); ++attempt) {
+        if (!client.connected())
+            return finish(Outcome::Kind::DaemonUnreachable, "record.start: " + err.message);
+        if (err.code != static_cast<int>(IpcErrorCode::Busy) || attempt >= 120 || stopping())
+            return finish(Outcome::Kind::Failed, err.message);
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    auto jid_it = resp.result.find("job_id");
+    const int64_t job_id = jid_it == resp.result.end() ? 0 : json_val_as_int(jid_it->second);
+    if (job_id <= 0) return finish(Outcome::Kind::Failed, "daemon returned no job_id");
+
+    bool done = false;
+    client.set_event_callback([&](const IpcEvent& ev) {
+        auto it = ev.data.find("job_id");
+        if (it == ev.data.end() || json_val_as_int(it->second) != job_id) return;
+        if (ev.event == "job.complete") {
+            auto note = ev.data.find("note_path");
+            if (note != ev.data.end()) o.note_path = json_val_as_string(note->second);
+            o.kind = Outcome::Kind::Ok;
+            done = true;
+        } else if (ev.event == "job.failed") {
+            auto msg = ev.data.find("error");
+            o.error_message = msg == ev.data.end() ? "" : json_val_as_string(msg->second);
+            o.kind = Outcome::Kind::Failed;
+            done = true;
+        }
+    });
+    JsonMap sub;
+    sub["topics"] = std::string("job.complete,job.failed");
+    sub["job_id"] = job_id;
+    client.call("events.subscribe", sub, resp, err);
+
+    bool stop_sent = false;
+    while (!done) {
+        if (!client.connected())
+            return finish(Outcome::Kind::DaemonUnreachable, "connection lost");
+        if (stopping() && !stop_sent) {
+            JsonMap stop;
+            stop["target"] = std::string("postprocessing");
+            stop["job_id"] = job_id;
+            client.call("record.stop", stop, resp, err, 5000);
+            stop_sent = true;
+        }
+        client.read_events("", 500);
+    }
+    return finish(o.kind, o.error_message);
+}
+
 Outcome dispatch_one_reprocess(const Config& cfg, BatchDispatchMode mode,
                                const std::string& addr, StopToken& iter_stop) {
     if (mode == BatchDispatchMode::Daemon) {
         return dispatch_one_reprocess_daemon(cfg, addr);
     }
+    if (mode == BatchDispatchMode::Cluster) {
+        return dispatch_one_reprocess_cluster(cfg, addr);
+    }
     return dispatch_one_reprocess_standalone(cfg, iter_stop);
 }
 
@@ -549,6 +683,8 @@ const char* kind_label(BatchEntryKind k) {
         case BatchEntryKind::WillReprocess:  return "WILL-REPROCESS";
         case BatchEntryKind::SkipNoteExists: return "SKIP-note-exists";
         case BatchEntryKind::SkipNoAudio:    return "SKIP-no-audio";
+        case BatchEntryKind::WillRefresh:    return "WILL-REFRESH";
+        case BatchEntryKind::SkipNoteEdited: return "SKIP-note-edited";
     }
     return "?";
 }
@@ -564,6 +700,263 @@ std::string format_duration(double seconds) {
 
 } // anonymous namespace
 
+// ---------------------------------------------------------------------------
+// Cluster mode — one worker thread per `--batch-daemons` address sharing a
+// single queue. A node takes the next meeting whenever it is free, so work
+// follows throughput without any static split.
+// ---------------------------------------------------------------------------
+
+ClusterBatchResult run_cluster_batch(const std::vector<const BatchEntry*>& work,
+                                     const std::vector<std::string>& nodes,
+                                     const ClusterDispatchFn& dispatch,
+                                     const std::atomic<bool>* stop) {
+    ClusterBatchResult result;
+    const auto t0 = std::chrono::steady_clock::now();
+    std::mutex mu;
+    std::condition_variable cv;
+    std::deque<const BatchEntry*> queue(work.begin(), work.end());
+    size_t in_flight = 0;
+    for (const auto& n : nodes) result.nodes.push_back({n});
+    auto stopping = [stop] { return stop && stop->load(std::memory_order_acquire); };
+
+    auto node_loop = [&](size_t index) {
+        const std::string node = nodes[index];
+        std::unique_lock<std::mutex> lock(mu);
+        while (true) {
+            // An empty queue may still refill from a node that is lost.
+            cv.wait(lock, [&] { return !queue.empty() || in_flight == 0 || stopping(); });
+            if (queue.empty() || stopping()) break;
+            const BatchEntry* entry = queue.front();
+            queue.pop_front();
+            ++in_flight;
+            lock.unlock();
+            Outcome o = dispatch(*entry, node);
+            lock.lock();
+            --in_flight;
+            ClusterNodeReport& report = result.nodes[index];
+            report.busy_seconds += o.duration_seconds;
+            if (o.kind == Outcome::Kind::DaemonUnreachable) {
+                queue.push_front(entry);
+                report.lost = true;
+                cv.notify_all();
+                break;
+            }
+            if (o.kind == Outcome::Kind::Ok) ++report.ok;
+            else if (o.kind == Outcome::Kind::Cancelled) ++report.cancelled;
+            else ++report.failed;
+            result.items.push_back({entry, std::move(o), node});
+            cv.notify_all();
+        }
+        cv.notify_all();
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nodes.size(); ++i) threads.emplace_back(node_loop, i);
+    for (auto& t : threads) t.join();
+
+    result.not_started = queue.size();
+    result.wall_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - t0).count();
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Concurrent standalone mode — `--jobs N` meetings in this process at once,
+// admitted by footprint the way the daemon's slots admit jobs.
+// ---------------------------------------------------------------------------
+
+bool should_release_resident_models(uint64_t rss_bytes, uint64_t rss_limit_bytes,
+                                    const PpFootprint& next, uint64_t budget_bytes) {
+    if (rss_bytes == 0) return false;
+    if (rss_limit_bytes > 0 && rss_bytes > rss_limit_bytes) return true;
+    if (budget_bytes == 0) return false;
+    const uint64_t working = next.bytes > next.model_bytes ? next.bytes - next.model_bytes : 0;
+    return rss_bytes + working > budget_bytes;
+}
+
+std::vector<Outcome> run_parallel_batch(
+        const std::vector<const BatchEntry*>& work, const std::vector<PpFootprint>& footprints,
+        const ParallelBatchLimits& limits, const StandaloneDispatchFn& dispatch,
+        const std::function<void(size_t index)>& on_start,
+        const std::function<void(size_t index, const Outcome& outcome)>& on_done) {
+    const int jobs = std::clamp(limits.jobs, 1, MAX_BATCH_JOBS);
+    std::mutex mu;
+    std::condition_variable cv;
+    std::vector<Outcome> outcomes(work.size());
+    std::vector<bool> finished(work.size(), false);
+    size_t reported = 0;
+
+    struct Slot {
+        std::thread thread;
+        StopToken stop;
+        const PpFootprint* footprint = nullptr;  ///< null while idle
+    };
+    std::vector<Slot> slots(static_cast<size_t>(jobs));
+    auto stopping = [] { return g_batch_stop_requested.load(std::memory_order_acquire); };
+    auto load = [&slots] {
+        PpLoad l;
+        for (const auto& s : slots) {
+            if (!s.footprint) continue;
+            ++l.jobs;
+            l.threads += s.footprint->threads;
+            l.bytes += s.footprint->bytes;
+        }
+        return l;
+    };
+    auto free_slot = [&slots]() -> Slot* {
+        for (auto& s : slots)
+            if (!s.footprint) return &s;
+        return nullptr;
+    };
+
+    size_t started = 0;
+    std::unique_lock<std::mutex> lock(mu);
+    while (started < work.size()) {
+        // Polled as well as notified: a signal handler cannot notify.
+        const PpFootprint& next = footprints[started];
+        cv.wait_for(lock, std::chrono::milliseconds(100), [&] {
+            return stopping() || (free_slot()
+                && admit_pp_job(next, load(), false, jobs, limits.budget_bytes, limits.cores));
+        });
+        if (stopping()) break;
+        Slot* slot = free_slot();
+        if (!slot || !admit_pp_job(next, load(), false, jobs, limits.budget_bytes, limits.cores))
+            continue;
+
+        const size_t index = started++;
+        const size_t slot_index = static_cast<size_t>(slot - slots.data());
+        if (slot->thread.joinable()) slot->thread.join();  // done with its last meeting
+        slot->footprint = &next;
+        slot->stop.reset();
+        if (on_start) on_start(index);
+        slot->thread = std::thread([&, slot, slot_index, index] {
+            g_parallel_iter_stops[slot_index].store(&slot->stop, std::memory_order_release);
+            if (stopping()) slot->stop.request();  // the handler ran before we were visible
+            Outcome o = dispatch(*work[index], slot->stop);
+            g_parallel_iter_stops[slot_index].store(nullptr, std::memory_order_release);
+
+            std::lock_guard<std::mutex> done_lock(mu);
+            outcomes[index] = std::move(o);
+            finished[index] = true;
+            slot->footprint = nullptr;
+            while (reported < work.size() && finished[reported]) {
+                if (on_done) on_done(reported, outcomes[reported]);
+                ++reported;
+            }
+            cv.notify_all();
+        });
+    }
+    lock.unlock();
+    for (auto& s : slots)
+        if (s.thread.joinable()) s.thread.join();
+
+    outcomes.resize(started);
+    return outcomes;
+}
+
+// ---------------------------------------------------------------------------
+// Pipelined standalone mode — `--pipeline`: transcription, diarization and
+// the rest of each meeting run as stages that overlap across meetings.
+// ---------------------------------------------------------------------------
+
+std::vector<Outcome> run_pipelined_batch(
+        const std::vector<const BatchEntry*>& work, const std::vector<BatchStage>& stages,
+        const std::function<void(size_t index)>& on_start,
+        const std::function<void(size_t index, const Outcome& outcome)>& on_done) {
+    const size_t n_stages = std::min(stages.size(), static_cast<size_t>(MAX_BATCH_JOBS));
+    if (n_stages == 0) return {};
+    std::mutex mu;
+    std::condition_variable cv;
+    std::mutex report_mu;
+    std::vector<Outcome> outcomes(work.size());
+    // inbox[s]: the meeting handed to stage s (stage 0 reads `work`);
+    // drained[s]: the stage before it will hand on no more.
+    std::vector<std::optional<size_t>> inbox(n_stages);
+    std::vector<bool> drained(n_stages, false);
+    unsigned held = 0;  // BatchResource bits of the stages running
+    size_t started = 0;
+    auto stopping = [] { return g_batch_stop_requested.load(std::memory_order_acquire); };
+    // Waits are polled as well as notified: a signal handler cannot notify.
+    auto wait = [&cv](std::unique_lock<std::mutex>& lock) {
+        cv.wait_for(lock, std::chrono::milliseconds(100));
+    };
+
+    auto stage_loop = [&](size_t s) {
+        const BatchStage& stage = stages[s];
+        StopToken stop;
+        for (;;) {
+            size_t index;
+            {
+                std::unique_lock<std::mutex> lock(mu);
+                if (s == 0) {
+                    if (started >= work.size() || stopping()) break;
+                    index = started++;
+                } else {
+                    while (!inbox[s] && !drained[s]) wait(lock);
+                    if (!inbox[s]) break;
+                    index = *inbox[s];
+                    inbox[s].reset();
+                    cv.notify_all();
+                }
+            }
+            if (s == 0 && on_start) {
+                std::lock_guard<std::mutex> report_lock(report_mu);
+                on_start(index);
+            }
+
+            // Only this stage touches the meeting until it is handed on.
+            Outcome& o = outcomes[index];
+            if (s == 0 || o.kind == Outcome::Kind::Ok) {
+                bool run;
+                {
+                    std::unique_lock<std::mutex> lock(mu);
+                    while ((held & stage.resources) != 0 && !stopping()) wait(lock);
+                    run = !stopping();
+                    if (run) held |= stage.resources;
+                }
+                if (run) {
+                    stop.reset();
+                    g_parallel_iter_stops[s].store(&stop, std::memory_order_release);
+                    if (stopping()) stop.request();  // the handler ran before we were visible
+                    const double before = o.duration_seconds;
+                    o = stage.run(*work[index], stop);
+                    o.duration_seconds += before;
+                    g_parallel_iter_stops[s].store(nullptr, std::memory_order_release);
+                    std::lock_guard<std::mutex> lock(mu);
+                    held &= ~stage.resources;
+                    cv.notify_all();
+                } else {
+                    o.kind = Outcome::Kind::Cancelled;
+                    o.note_path.clear();
+                }
+            }
+
+            if (s + 1 < n_stages) {
+                std::unique_lock<std::mutex> lock(mu);
+                while (inbox[s + 1]) wait(lock);
+                inbox[s + 1] = index;
+                cv.notify_all();
+            } else if (on_done) {
+                std::lock_guard<std::mutex> report_lock(report_mu);
+                on_done(index, o);
+            }
+        }
+        if (s + 1 < n_stages) {
+            std::lock_guard<std::mutex> lock(mu);
+            drained[s + 1] = true;
+            cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_stages);
+    for (size_t s = 0; s < n_stages; ++s) threads.emplace_back(stage_loop, s);
+    for (auto& t : threads) t.join();
+
+    outcomes.resize(started);
+    return outcomes;
+}
+
 // ---------------------------------------------------------------------------
 // Batch driver
 // ---------------------------------------------------------------------------
@@ -600,22 +993,33 @@ int run_reprocess_batch(const CliResult& cli) {
     auto entries = classify_batch_entries(parent_dir, orig_cfg);
 
     // 4. Tally counts up front for the header line.
-    size_t will_count = 0, skip_note = 0, skip_audio = 0;
+    //    Refreshed meetings count as to-process; edited ones as done.
+    size_t will_count = 0, skip_note = 0, skip_audio = 0, refresh = 0, edited = 0;
     for (const auto& e : entries) {
         switch (e.kind) {
             case BatchEntryKind::WillReprocess:  ++will_count; break;
             case BatchEntryKind::SkipNoteExists: ++skip_note; break;
             case BatchEntryKind::SkipNoAudio:    ++skip_audio; break;
+            case BatchEntryKind::WillRefresh:    ++will_count; ++refresh; break;
+            case BatchEntryKind::SkipNoteEdited: ++skip_note; ++edited; break;
         }
     }
 
-    fprintf(stderr, "Reprocess batch: %s (%zu meetings to process, %zu already done, %zu anomalous)\n\n",
+    fprintf(stderr, "Reprocess batch: %s (%zu meetings to process, %zu already done, %zu anomalous)\n",
             parent_dir.c_str(), will_count, skip_note, skip_audio);
+    if (orig_cfg.reprocess_batch_refresh) {
+        fprintf(stderr, "Refresh: %zu notes out of date, %zu of them edited by hand (kept)\n",
+                refresh + edited, edited);
+    }
+    fprintf(stderr, "\n");
 
     // 5. Dry-run path: print classification table + counts, exit 0.
     if (orig_cfg.reprocess_batch_dry_run) {
         for (const auto& e : entries) {
-            fprintf(stderr, "  %-16s  %s\n", kind_label(e.kind), e.dir.c_str());
+            const std::string length =
+                e.audio_seconds > 0 ? format_duration(e.audio_seconds) : "";
+            fprintf(stderr, "  %-16s  %9s  %s%s\n", kind_label(e.kind), length.c_str(),
+                    e.dir.c_str(), e.audio_silent ? "  (sampled silent)" : "");
         }
         fprintf(stderr, "\nDry run — no meetings reprocessed.\n");
         return 0;
@@ -628,7 +1032,8 @@ int run_reprocess_batch(const CliResult& cli) {
 
     // 6. Once-per-batch model precheck. Operates on orig_cfg (which still
     // mirrors what each iteration's pipeline will see, modulo `batch_mode`).
-    {
+    // Cluster nodes check their own models at record.start.
+    if (cli.batch_daemons.empty()) {
         std::string err = ensure_models_cached_or_fail(orig_cfg);
         if (!err.empty()) {
             fprintf(stderr, "Error: %s\n", err.c_str());
@@ -639,7 +1044,9 @@ int run_reprocess_batch(const CliResult& cli) {
     // 7. Lock the dispatcher mode at batch entry. Mid-batch daemon up/down
     //    is treated as DaemonUnreachable rather than silently switching.
     BatchDispatchMode mode;
-    if (cli.daemon_mode == DaemonMode::Force) {
+    if (!cli.batch_daemons.empty()) {
+        mode = BatchDispatchMode::Cluster;
+    } else if (cli.daemon_mode == DaemonMode::Force) {
         mode = BatchDispatchMode::Daemon;
     } else if (cli.daemon_mode == DaemonMode::Disable) {
         mode = BatchDispatchMode::Standalone;
@@ -648,14 +1055,43 @@ int run_reprocess_batch(const CliResult& cli) {
                                                : BatchDispatchMode::Standalone;
     }
 
+    if (mode == BatchDispatchMode::Daemon && (cli.batch_jobs > 1 || cli.batch_pipeline)) {
+        fprintf(stderr, "Note: %s applies to a standalone batch (--no-daemon); "
+                        "the daemon gets one meeting at a time\n\n",
+                cli.batch_pipeline ? "--pipeline" : "--jobs");
+    }
+    const bool parallel = mode == BatchDispatchMode::Standalone && cli.batch_jobs > 1;
+    const bool pipelined = mode == BatchDispatchMode::Standalone && cli.batch_pipeline;
+
     // 8. Standalone-mode prelude. Daemon mode skips whisper_log + notify_init
     //    here because notifications come from the batch driver's own end-of-
     //    batch notify() (see step 14) and per-iteration whisper logs come
     //    from the daemon's subprocess (which deliberately silences whisper).
-    if (mode == BatchDispatchMode::Standalone) {
+    //    Concurrent meetings and stages silence it too: their progress lines
+    //    would overwrite each other.
+    if (parallel || pipelined) {
+        whisper_log_set([](enum ggml_log_level, const char*, void*) {}, nullptr);
+    } else if (mode == BatchDispatchMode::Standalone) {
         whisper_log_set(whisper_cli_log_shim, nullptr);
     }
 
+    //    Standalone iterations run back to back in this process, as the warm
+    //    worker's jobs do, so keep the models resident between them too:
+    //    whisper, sherpa and the LLM with its cached system prompt
+    //    (summarize.h) load once per batch instead of once per meeting.
+    //    Not with --jobs: a resident session serves one meeting at a time,
+    //    so concurrent meetings each load their own. --pipeline keeps them:
+    //    each model belongs to one stage, which runs one meeting at a time.
+    struct ModelCacheGuard {
+        const bool prev = model_cache_enabled();
+        explicit ModelCacheGuard(bool enable) {
+            if (enable) set_model_cache_enabled(true);
+        }
+        ~ModelCacheGuard() { set_model_cache_enabled(prev); }
+        ModelCacheGuard(const ModelCacheGuard&) = delete;
+        ModelCacheGuard& operator=(const ModelCacheGuard&) = delete;
+    } model_cache_guard(mode == BatchDispatchMode::Standalone && !parallel);
+
     // 9. notify_init for end-of-batch summary notification (step 14).
     //    This runs in the operator's terminal `recmeet` process regardless of
     //    mode — the daemon subprocess never sees this code path.
@@ -665,6 +1101,10 @@ int run_reprocess_batch(const CliResult& cli) {
     //     propagates through IPC + subprocess JSON for this run.
     Config cfg_for_iter = orig_cfg;
     cfg_for_iter.batch_mode = true;
+    //     Concurrent meetings split the default thread count between them,
+    //     so admission's core check lets the second one in.
+    if (parallel && cfg_for_iter.threads <= 0)
+        cfg_for_iter.threads = std::max(1, default_thread_count() / cli.batch_jobs);
 
     // 11. Install batch-level SIGINT/SIGTERM handler for standalone mode.
     //     Daemon mode's `dispatch_one_reprocess` installs the hybrid daemon
@@ -704,7 +1144,7 @@ int run_reprocess_batch(const CliResult& cli) {
     // Reset the batch-stop flag so a re-entrant call (e.g. tests, or a
     // future daemonised batch driver) sees a clean slate.
     g_batch_stop_requested.store(false, std::memory_order_release);
-    SigGuard sig_guard(mode == BatchDispatchMode::Standalone);
+    SigGuard sig_guard(mode != BatchDispatchMode::Daemon);
 
     // 12. Loop over WILL-REPROCESS meetings.
     struct IterReport {
@@ -717,80 +1157,320 @@ int run_reprocess_batch(const CliResult& cli) {
     size_t idx = 0;
     bool any_started = false;
 
-    for (auto& e : entries) {
-        if (e.kind != BatchEntryKind::WillReprocess) continue;
-        ++idx;
-
-        if (g_batch_stop_requested.load(std::memory_order_acquire)) {
-            // Phase 3 path. Phase 2 never sets the flag from the standalone
-            // side, but the daemon-mode handler can. Bail cleanly.
-            break;
+    // Cluster mode: the nodes share the meetings out (run_cluster_batch);
+    // each line names the daemon that ran the meeting.
+    ClusterBatchResult cluster;
+    if (mode == BatchDispatchMode::Cluster) {
+        std::vector<const BatchEntry*> work;
+        for (const auto& e : entries)
+            if (batch_entry_runs(e.kind)) work.push_back(&e);
+        fprintf(stderr, "Sharing %zu meetings across %zu daemons\n\n", work.size(),
+                cli.batch_daemons.size());
+        std::mutex print_mu;
+        cluster = run_cluster_batch(work, cli.batch_daemons,
+            [&](const BatchEntry& e, const std::string& node) {
+                Config iter_cfg = cfg_for_iter;
+                iter_cfg.reprocess_dir = e.dir;
+                iter_cfg.reprocess_batch_dir.clear();
+                {
+                    std::lock_guard<std::mutex> lock(print_mu);
+                    fprintf(stderr, "%s — reprocessing on %s...\n", e.timestamp.c_str(),
+                            node.c_str());
+                }
+                StopToken unused;
+                Outcome o = dispatch_one_reprocess(iter_cfg, mode, node, unused);
+                if (o.kind == Outcome::Kind::Failed
+                    && g_batch_stop_requested.load(std::memory_order_acquire)) {
+                    o.kind = Outcome::Kind::Cancelled;
+                }
+                std::lock_guard<std::mutex> lock(print_mu);
+                if (o.kind == Outcome::Kind::DaemonUnreachable) {
+                    fprintf(stderr, "%s — %s unreachable (%s); dropping it and requeueing\n\n",
+                            e.timestamp.c_str(), node.c_str(), o.error_message.c_str());
+                    return o;
+                }
+                ++idx;
+                if (o.kind == Outcome::Kind::Ok) {
+                    fprintf(stderr, "[%zu/%zu] %s — DONE on %s", idx, will_count,
+                            e.timestamp.c_str(), node.c_str());
+                    if (!o.note_path.empty()) fprintf(stderr, " -> %s", o.note_path.c_str());
+                    fprintf(stderr, " (%s)\n\n", format_duration(o.duration_seconds).c_str());
+                } else if (o.kind == Outcome::Kind::Cancelled) {
+                    fprintf(stderr, "[%zu/%zu] %s — CANCELLED on %s (%s)\n\n", idx, will_count,
+                            e.timestamp.c_str(), node.c_str(),
+                            format_duration(o.duration_seconds).c_str());
+                } else {
+                    fprintf(stderr, "[%zu/%zu] %s — FAIL on %s: %s (%s)\n\n", idx, will_count,
+                            e.timestamp.c_str(), node.c_str(),
+                            o.error_message.empty() ? "unknown error" : o.error_message.c_str(),
+                            format_duration(o.duration_seconds).c_str());
+                }
+                return o;
+            },
+            &g_batch_stop_requested);
+        for (auto& item : cluster.items) {
+            if (item.outcome.kind == Outcome::Kind::Ok) ++ok;
+            else if (item.outcome.kind == Outcome::Kind::Cancelled) ++cancelled;
+            else ++failed;
+            reports.push_back({item.entry, std::move(item.outcome)});
         }
+        if (cluster.not_started > 0 && !g_batch_stop_requested.load(std::memory_order_acquire)) {
+            fprintf(stderr, "Error: every daemon became unreachable with %zu meetings left\n",
+                    cluster.not_started);
+            aborted_daemon_unreachable = true;
+        }
+    } else if (pipelined) {
+        // Pipelined standalone mode: transcription, diarization and the
+        // rest (speaker identification, summary, note) each run on their
+        // own thread, a meeting apart. The first two stop once their stage
+        // is in the stage cache; the next stage loads it. Stages needing
+        // the same resource take turns, so only whisper on a GPU or a
+        // remote summary actually overlaps the CPU work.
+        std::vector<const BatchEntry*> work;
+        for (const auto& e : entries)
+            if (batch_entry_runs(e.kind)) work.push_back(&e);
+
+        // Measured now, when the model is new to this GPU, rather than
+        // inside the first meeting's transcribe stage.
+        const bool whisper_gpu = is_whisper_model_cached(cfg_for_iter.whisper_model)
+            ? whisper_gpu_for(cfg_for_iter, ensure_whisper_model(cfg_for_iter.whisper_model))
+            : cfg_for_iter.whisper_gpu && active_backend_is_gpu();
+        bool local_summary = false;
+#if RECMEET_USE_LLAMA
+        local_summary = !cfg_for_iter.no_summary && !cfg_for_iter.llm_model.empty();
+#endif
+        // Whisper on the GPU keeps a few threads to feed it, as when
+        // diarization overlaps it within a meeting (plan_diarize_overlap).
+        int whisper_threads = 0, cpu_threads = 0;
+        if (whisper_gpu) {
+            const int threads = cfg_for_iter.threads > 0 ? cfg_for_iter.threads
+                                                         : default_thread_count();
+            const auto plan = plan_diarize_overlap(true, true, threads, 0, 0, 0, 0);
+            if (plan.overlap) {
+                whisper_threads = plan.whisper_threads;
+                cpu_threads = plan.diarize_threads;
+            }
+        }
+        auto stage = [&cfg_for_iter](const char* prepare, int threads, bool diarize) {
+            return [&cfg_for_iter, prepare, threads, diarize](const BatchEntry& e,
+                                                              StopToken& iter_stop) {
+                Config iter_cfg = cfg_for_iter;
+                iter_cfg.reprocess_dir = e.dir;
+                iter_cfg.reprocess_batch_dir.clear();
+                iter_cfg.prepare_stage = prepare;
+                iter_cfg.diarize = diarize;
+                if (threads > 0) iter_cfg.threads = threads;
+                Outcome o = dispatch_one_reprocess_standalone(iter_cfg, iter_stop);
+                if (o.kind == Outcome::Kind::Failed
+                    && (iter_stop.stop_requested()
+                        || g_batch_stop_requested.load(std::memory_order_acquire))) {
+                    o.kind = Outcome::Kind::Cancelled;
+                }
+                return o;
+            };
+        };
+        std::vector<BatchStage> stages;
+        stages.push_back({"transcribe", whisper_gpu ? BATCH_RESOURCE_GPU : BATCH_RESOURCE_CPU,
+                          stage(STAGE_TRANSCRIPT, whisper_threads, false)});
+#if RECMEET_USE_SHERPA
+        if (cfg_for_iter.diarize)
+            stages.push_back({"diarize", BATCH_RESOURCE_CPU,
+                              stage(STAGE_DIARIZATION, cpu_threads, true)});
+#endif
+        // Identification is cheap from the cached centroids; a local summary
+        // is CPU (and GPU, when layers are offloaded) work.
+        unsigned finish_resources = 0;
+        if (local_summary)
+            finish_resources = BATCH_RESOURCE_CPU | (whisper_gpu ? BATCH_RESOURCE_GPU : 0u);
+        stages.push_back({"summarize", finish_resources,
+                          stage("", cpu_threads, cfg_for_iter.diarize)});
+
+        fprintf(stderr, "Pipelining %zu stages across meetings (%s)\n\n", stages.size(),
+                whisper_gpu ? "whisper on the GPU" : "whisper on the CPU, taking turns "
+                                                     "with diarization");
+        run_pipelined_batch(work, stages,
+            [&](size_t i) {
+                any_started = true;
+                fprintf(stderr, "[%zu/%zu] %s — reprocessing...\n",
+                        i + 1, will_count, work[i]->timestamp.c_str());
+            },
+            [&](size_t i, const Outcome& o) {
+                const char* ts = work[i]->timestamp.c_str();
+                if (o.kind == Outcome::Kind::Ok) {
+                    ++ok;
+                    fprintf(stderr, "[%zu/%zu] %s — DONE", i + 1, will_count, ts);
+                    if (!o.note_path.empty()) fprintf(stderr, " -> %s", o.note_path.c_str());
+                    fprintf(stderr, " (%s)\n\n", format_duration(o.duration_seconds).c_str());
+                } else if (o.kind == Outcome::Kind::Cancelled) {
+                    ++cancelled;
+                    fprintf(stderr, "[%zu/%zu] %s — CANCELLED (%s)\n\n", i + 1, will_count, ts,
+                            format_duration(o.duration_seconds).c_str());
+                } else {
+                    ++failed;
+                    fprintf(stderr, "[%zu/%zu] %s — FAIL: %s (%s)\n\n", i + 1, will_count, ts,
+                            o.error_message.empty() ? "unknown error" : o.error_message.c_str(),
+                            format_duration(o.duration_seconds).c_str());
+                }
+                reports.push_back({work[i], o});
+            });
+    } else if (parallel) {
+        // Concurrent standalone mode: up to --jobs meetings at once, started
+        // in order as memory and cores allow (run_parallel_batch), and
+        // reported in order as the earliest still running finishes.
+        std::vector<const BatchEntry*> work;
+        std::vector<PpFootprint> footprints;
+        for (const auto& e : entries) {
+            if (!batch_entry_runs(e.kind)) continue;
+            work.push_back(&e);
+            footprints.push_back(estimate_job_footprint(cfg_for_iter, find_audio_file(e.dir)));
+        }
+        ParallelBatchLimits limits;
+        limits.jobs = cli.batch_jobs;
+        limits.budget_bytes = read_memory_ceiling_bytes();
+        limits.cores = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+        fprintf(stderr, "Running up to %d meetings at once, %d threads each "
+                        "(memory budget %llu MB)\n\n",
+                std::min(limits.jobs, MAX_BATCH_JOBS), cfg_for_iter.threads,
+                (unsigned long long)(limits.budget_bytes >> 20));
+        run_parallel_batch(work, footprints, limits,
+            [&cfg_for_iter](const BatchEntry& e, StopToken& iter_stop) {
+                Config iter_cfg = cfg_for_iter;
+                iter_cfg.reprocess_dir = e.dir;
+                iter_cfg.reprocess_batch_dir.clear();
+                Outcome o = dispatch_one_reprocess_standalone(iter_cfg, iter_stop);
+                if (o.kind == Outcome::Kind::Failed
+                    && (iter_stop.stop_requested()
+                        || g_batch_stop_requested.load(std::memory_order_acquire))) {
+                    o.kind = Outcome::Kind::Cancelled;
+                }
+                return o;
+            },
+            [&](size_t i) {
+                any_started = true;
+                fprintf(stderr, "[%zu/%zu] %s — reprocessing...\n",
+                        i + 1, will_count, work[i]->timestamp.c_str());
+            },
+            [&](size_t i, const Outcome& o) {
+                const char* ts = work[i]->timestamp.c_str();
+                if (o.kind == Outcome::Kind::Ok) {
+                    ++ok;
+                    fprintf(stderr, "[%zu/%zu] %s — DONE", i + 1, will_count, ts);
+                    if (!o.note_path.empty()) fprintf(stderr, " -> %s", o.note_path.c_str());
+                    fprintf(stderr, " (%s)\n\n", format_duration(o.duration_seconds).c_str());
+                } else if (o.kind == Outcome::Kind::Cancelled) {
+                    ++cancelled;
+                    fprintf(stderr, "[%zu/%zu] %s — CANCELLED (%s)\n\n", i + 1, will_count, ts,
+                            format_duration(o.duration_seconds).c_str());
+                } else {
+                    ++failed;
+                    fprintf(stderr, "[%zu/%zu] %s — FAIL: %s (%s)\n\n", i + 1, will_count, ts,
+                            o.error_message.empty() ? "unknown error" : o.error_message.c_str(),
+                            format_duration(o.duration_seconds).c_str());
+                }
+                reports.push_back({work[i], o});
+            });
+    } else {
+        const uint64_t budget_bytes =
+            mode == BatchDispatchMode::Standalone ? read_memory_ceiling_bytes() : 0;
+        for (size_t ei = 0; ei < entries.size(); ++ei) {
+            auto& e = entries[ei];
+            if (!batch_entry_runs(e.kind)) continue;
+            ++idx;
+
+            if (g_batch_stop_requested.load(std::memory_order_acquire)) {
+                // Phase 3 path. Phase 2 never sets the flag from the standalone
+                // side, but the daemon-mode handler can. Bail cleanly.
+                break;
+            }
 
-        any_started = true;
-        Config iter_cfg = cfg_for_iter;
-        iter_cfg.reprocess_dir = e.dir;
-        iter_cfg.reprocess_batch_dir.clear();  // single-meeting semantics inside dispatch
-
-        StopToken iter_stop;
-        g_active_iter_stop.store(&iter_stop, std::memory_order_release);
-
-        fprintf(stderr, "[%zu/%zu] %s — reprocessing...\n",
-                idx, will_count, e.timestamp.c_str());
+            any_started = true;
+            Config iter_cfg = cfg_for_iter;
+            iter_cfg.reprocess_dir = e.dir;
+            iter_cfg.reprocess_batch_dir.clear();  // single-meeting semantics inside dispatch
 
-        Outcome o = dispatch_one_reprocess(iter_cfg, mode, cli.daemon_addr, iter_stop);
+            StopToken iter_stop;
+            g_active_iter_stop.store(&iter_stop, std::memory_order_release);
 
-        g_active_iter_stop.store(nullptr, std::memory_order_release);
+            fprintf(stderr, "[%zu/%zu] %s — reprocessing...\n",
+                    idx, will_count, e.timestamp.c_str());
 
-        if (mode == BatchDispatchMode::Standalone) {
-            whisper_flush_line_shim();
-        }
+            Outcome o = dispatch_one_reprocess(iter_cfg, mode, cli.daemon_addr, iter_stop);
+
+            g_active_iter_stop.store(nullptr, std::memory_order_release);
+
+            if (mode == BatchDispatchMode::Standalone) {
+                whisper_flush_line_shim();
+                // The models stay loaded for the next meeting; this one's
+                // audio, diarization and KV buffers do not. Return them to
+                // the kernel, then drop the models too if what is left
+                // would crowd the next meeting out of the memory ceiling.
+                release_free_heap();
+                const BatchEntry* next = nullptr;
+                for (size_t ni = ei + 1; ni < entries.size() && !next; ++ni)
+                    if (batch_entry_runs(entries[ni].kind)) next = &entries[ni];
+                if (next && model_cache_enabled()) {
+                    const uint64_t rss = uint64_t(std::max(read_self_rss_kb(), 0L)) * 1024;
+                    const uint64_t rss_limit =
+                        uint64_t(std::max(cfg_for_iter.pp_worker_rss_mb, 0)) << 20;
+                    if (should_release_resident_models(
+                            rss, rss_limit,
+                            estimate_job_footprint(cfg_for_iter, find_audio_file(next->dir)),
+                            budget_bytes)) {
+                        size_t n = release_resident_models();
+                        release_free_heap();
+                        fprintf(stderr, "Note: released %zu resident models at %llu MB RSS; "
+                                        "the next meeting reloads them\n\n",
+                                n, (unsigned long long)(rss >> 20));
+                    }
+                }
+            }
 
-        if (o.kind == Outcome::Kind::DaemonUnreachable) {
-            fprintf(stderr,
-                    "Error: daemon disappeared mid-batch (iteration %zu/%zu); "
-                    "run `recmeet --status` to investigate\n",
-                    idx, will_count);
-            aborted_daemon_unreachable = true;
-            reports.push_back({&e, std::move(o)});
-            break;
-        }
+            if (o.kind == Outcome::Kind::DaemonUnreachable) {
+                fprintf(stderr,
+                        "Error: daemon disappeared mid-batch (iteration %zu/%zu); "
+                        "run `recmeet --status` to investigate\n",
+                        idx, will_count);
+                aborted_daemon_unreachable = true;
+                reports.push_back({&e, std::move(o)});
+                break;
+            }
 
-        // If SIGINT tripped iter_stop mid-flight, the dispatch path will have
-        // returned Failed (run_pipeline throws RecmeetError("Cancelled"); the
-        // daemon path returns the exit code from client_record_no_sigaction).
-        // Re-classify those as Cancelled so the summary reads correctly and
-        // exit code 130 is reported, not 1. Note: this checks BOTH the
-        // per-iteration token AND the batch flag — either being tripped
-        // implies the user hit Ctrl-C during this iteration.
-        if (o.kind == Outcome::Kind::Failed
-            && (iter_stop.stop_requested()
-                || g_batch_stop_requested.load(std::memory_order_acquire))) {
-            o.kind = Outcome::Kind::Cancelled;
-        }
+            // If SIGINT tripped iter_stop mid-flight, the dispatch path will have
+            // returned Failed (run_pipeline throws RecmeetError("Cancelled"); the
+            // daemon path returns the exit code from client_record_no_sigaction).
+            // Re-classify those as Cancelled so the summary reads correctly and
+            // exit code 130 is reported, not 1. Note: this checks BOTH the
+            // per-iteration token AND the batch flag — either being tripped
+            // implies the user hit Ctrl-C during this iteration.
+            if (o.kind == Outcome::Kind::Failed
+                && (iter_stop.stop_requested()
+                    || g_batch_stop_requested.load(std::memory_order_acquire))) {
+                o.kind = Outcome::Kind::Cancelled;
+            }
 
-        if (o.kind == Outcome::Kind::Ok) {
-            ++ok;
-            fprintf(stderr, "[%zu/%zu] %s — DONE",
-                    idx, will_count, e.timestamp.c_str());
-            if (!o.note_path.empty()) {
-                fprintf(stderr, " -> %s", o.note_path.c_str());
+            if (o.kind == Outcome::Kind::Ok) {
+                ++ok;
+                fprintf(stderr, "[%zu/%zu] %s — DONE",
+                        idx, will_count, e.timestamp.c_str());
+                if (!o.note_path.empty()) {
+                    fprintf(stderr, " -> %s", o.note_path.c_str());
+                }
+                fprintf(stderr, " (%s)\n\n", format_duration(o.duration_seconds).c_str());
+            } else if (o.kind == Outcome::Kind::Cancelled) {
+                ++cancelled;
+                fprintf(stderr, "[%zu/%zu] %s — CANCELLED (%s)\n\n",
+                        idx, will_count, e.timestamp.c_str(),
+                        format_duration(o.duration_seconds).c_str());
+            } else {
+                ++failed;
+                fprintf(stderr, "[%zu/%zu] %s — FAIL: %s (%s)\n\n",
+                        idx, will_count, e.timestamp.c_str(),
+                        o.error_message.empty() ? "unknown error" : o.error_message.c_str(),
+                        format_duration(o.duration_seconds).c_str());
             }
-            fprintf(stderr, " (%s)\n\n", format_duration(o.duration_seconds).c_str());
-        } else if (o.kind == Outcome::Kind::Cancelled) {
-            ++cancelled;
-            fprintf(stderr, "[%zu/%zu] %s — CANCELLED (%s)\n\n",
-                    idx, will_count, e.timestamp.c_str(),
-                    format_duration(o.duration_seconds).c_str());
-        } else {
-            ++failed;
-            fprintf(stderr, "[%zu/%zu] %s — FAIL: %s (%s)\n\n",
-                    idx, will_count, e.timestamp.c_str(),
-                    o.error_message.empty() ? "unknown error" : o.error_message.c_str(),
-                    format_duration(o.duration_seconds).c_str());
-        }
 
-        reports.push_back({&e, std::move(o)});
+            reports.push_back({&e, std::move(o)});
+        }
     }
 
     (void)any_started;
@@ -810,6 +1490,19 @@ int run_reprocess_batch(const CliResult& cli) {
             "Summary: %zu ok, %zu failed, %zu cancelled, %zu skipped "
             "(out of %zu to process)\n",
             ok, failed, cancelled, not_started, will_count);
+    if (mode == BatchDispatchMode::Cluster) {
+        const double hours = cluster.wall_seconds / 3600.0;
+        fprintf(stderr, "Throughput: %zu meetings in %s across %zu daemons (%.1f per hour)\n",
+                ok, format_duration(cluster.wall_seconds).c_str(), cluster.nodes.size(),
+                hours > 0 ? static_cast<double>(ok) / hours : 0.0);
+        for (const auto& n : cluster.nodes) {
+            const int busy = cluster.wall_seconds > 0
+                ? static_cast<int>(100.0 * n.busy_seconds / cluster.wall_seconds + 0.5) : 0;
+            fprintf(stderr, "  %s — %zu ok, %zu failed, %zu cancelled, busy %d%%%s\n",
+                    n.address.c_str(), n.ok, n.failed, n.cancelled, busy,
+                    n.lost ? " (unreachable, dropped)" : "");
+        }
+    }
     if (failed > 0) {
         fprintf(stderr, "Failed:\n");
         for (const auto& r : reports) {
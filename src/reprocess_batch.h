@@ -5,9 +5,11 @@
 
 #include "cli.h"
 #include "config.h"
+#include "pipeline.h"
 #include "util.h"
 
 #include <atomic>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -21,13 +23,22 @@ class IpcClient;
 enum class BatchEntryKind {
     WillReprocess,      ///< matches naming pattern, has audio, no existing note
     SkipNoteExists,     ///< matches naming pattern, has audio, note already on disk
-    SkipNoAudio,        ///< matches naming pattern but no audio file present
+    SkipNoAudio,        ///< matches naming pattern but no audio file present, or none probe_audio() can read
+    WillRefresh,        ///< --refresh: note's manifest inputs differ from the config's
+    SkipNoteEdited,     ///< --refresh: inputs differ, but the note was edited since
 };
 
+/// Whether the batch runs an entry of this kind (WillReprocess, WillRefresh).
+inline bool batch_entry_runs(BatchEntryKind k) {
+    return k == BatchEntryKind::WillReprocess || k == BatchEntryKind::WillRefresh;
+}
+
 struct BatchEntry {
     fs::path dir;                  ///< absolute path to the meeting directory
     std::string timestamp;         ///< canonical "YYYY-MM-DD_HH-MM" (collision suffix stripped)
     BatchEntryKind kind = BatchEntryKind::SkipNoAudio;
+    double audio_seconds = 0;      ///< recording length from probe_audio()'s header
+    bool audio_silent = false;     ///< WillReprocess whose sampled blocks are all silent
 };
 
 /// Per-iteration outcome reported by `dispatch_one_reprocess`. Used by the
@@ -49,14 +60,136 @@ struct Outcome {
 
 /// Locked-once dispatcher mode for the batch run (resolved at batch entry from
 /// `cli.daemon_mode` + `daemon_running(addr)` and held constant through every
-/// iteration).
-enum class BatchDispatchMode { Daemon, Standalone };
+/// iteration). `Cluster` is `--batch-daemons`: the meetings are shared out
+/// over several daemons (run_cluster_batch).
+enum class BatchDispatchMode { Daemon, Standalone, Cluster };
+
+/// One daemon's share of a cluster batch.
+struct ClusterNodeReport {
+    std::string address;
+    size_t ok = 0, failed = 0, cancelled = 0;
+    double busy_seconds = 0.0;  ///< summed meeting durations
+    bool lost = false;          ///< unreachable; dropped for the rest of the batch
+};
+
+struct ClusterBatchResult {
+    struct Item {
+        const BatchEntry* entry = nullptr;
+        Outcome outcome;
+        std::string node;       ///< the daemon that ran it last
+    };
+    std::vector<Item> items;    ///< in completion order
+    std::vector<ClusterNodeReport> nodes;
+    size_t not_started = 0;     ///< left when the batch stopped or every node was lost
+    double wall_seconds = 0.0;
+};
+
+/// Runs one meeting on one daemon. Called concurrently, once per node.
+using ClusterDispatchFn =
+    std::function<Outcome(const BatchEntry& entry, const std::string& node)>;
+
+/// Share `work` out over `nodes`, one thread per node pulling the next
+/// meeting from a common queue as it frees up, so fast daemons take more.
+/// A node listed twice keeps two meetings in flight. A DaemonUnreachable
+/// outcome puts the meeting back at the front of the queue for another
+/// node and drops the one that failed. `stop` (may be null) ends the
+/// batch after the meetings in flight.
+ClusterBatchResult run_cluster_batch(const std::vector<const BatchEntry*>& work,
+                                     const std::vector<std::string>& nodes,
+                                     const ClusterDispatchFn& dispatch,
+                                     const std::atomic<bool>* stop = nullptr);
+
+/// Most `--jobs` meetings a standalone batch runs at once.
+inline constexpr int MAX_BATCH_JOBS = 64;
+
+/// Runs one meeting of a standalone batch on its own `iter_stop`. Called
+/// concurrently, once per meeting in flight.
+using StandaloneDispatchFn =
+    std::function<Outcome(const BatchEntry& entry, StopToken& iter_stop)>;
+
+/// Admission for a concurrent standalone batch, as admit_pp_job() weighs it.
+struct ParallelBatchLimits {
+    int jobs = 1;               ///< meetings at once, capped at MAX_BATCH_JOBS
+    uint64_t budget_bytes = 0;  ///< memory ceiling (0 = unknown, not checked)
+    int cores = 1;
+};
+
+/// Run `work` in this process, up to `limits.jobs` meetings at once. The
+/// meetings start in order, each once admit_pp_job() lets its
+/// `footprints[i]` (estimate_job_footprint()) in beside those running, the
+/// same test a daemon's postprocessing slots apply. `on_start(i)` runs as
+/// meeting i starts; `on_done(i, outcome)` runs in work order, whatever
+/// order they finish in, so the caller's report stays deterministic. Both
+/// are called one at a time.
+///
+/// Each meeting gets its own StopToken. The batch SIGINT handler requests
+/// every one in flight, and once it has run no further meeting starts.
+/// Returns the outcomes of the meetings that ran, in work order: all of
+/// `work` unless the batch was stopped.
+std::vector<Outcome> run_parallel_batch(
+    const std::vector<const BatchEntry*>& work, const std::vector<PpFootprint>& footprints,
+    const ParallelBatchLimits& limits, const StandaloneDispatchFn& dispatch,
+    const std::function<void(size_t index)>& on_start = nullptr,
+    const std::function<void(size_t index, const Outcome& outcome)>& on_done = nullptr);
+
+/// What a pipelined batch stage occupies while it runs. Stages that need a
+/// common resource take turns; the others run at once.
+enum BatchResource : unsigned {
+    BATCH_RESOURCE_CPU = 1u << 0,  ///< the inference cores
+    BATCH_RESOURCE_GPU = 1u << 1,  ///< the GPU and its memory
+};
+
+/// One stage of a pipelined batch. `run` takes a meeting through it; an
+/// Ok outcome hands the meeting on to the next stage.
+struct BatchStage {
+    std::string name;
+    unsigned resources = 0;  ///< BatchResource bits held while `run` runs
+    StandaloneDispatchFn run;
+};
+
+/// Run `work` through `stages` in this process, one thread per stage, so
+/// the stages overlap across meetings: while meeting N is in stage 2,
+/// meeting N+1 can be in stage 1. Each meeting passes through the stages
+/// in order. A stage starts a meeting once nothing running holds any of
+/// its `resources`, and hands it on only when the next stage's queue (one
+/// meeting long) is free, so no stage runs more than two meetings ahead of
+/// the one after it. A meeting that fails a stage skips the rest.
+///
+/// `on_start(i)` runs as meeting i enters the first stage and
+/// `on_done(i, outcome)` as it leaves the last (the stages after a failed
+/// one pass it straight through); both are called one at a time, in work
+/// order. An outcome's duration is
+/// the time its stages ran. The batch SIGINT handler stops every stage in
+/// flight, and once it has run no stage starts another meeting. Returns
+/// the outcomes of the meetings that started, in work order.
+std::vector<Outcome> run_pipelined_batch(
+    const std::vector<const BatchEntry*>& work, const std::vector<BatchStage>& stages,
+    const std::function<void(size_t index)>& on_start = nullptr,
+    const std::function<void(size_t index, const Outcome& outcome)>& on_done = nullptr);
+
+/// Between two meetings of a serial standalone batch, which keeps the
+/// models resident: whether to release them (release_resident_models())
+/// before `next` starts. True once the process's `rss_bytes` is above
+/// `rss_limit_bytes` (postprocess.worker_rss_mb, where the daemon would
+/// replace its warm worker), or when that RSS plus what `next` needs beyond
+/// its models would not fit `budget_bytes`, the memory ceiling. A limit of
+/// 0 is not checked, nor is an unread RSS of 0.
+bool should_release_resident_models(uint64_t rss_bytes, uint64_t rss_limit_bytes,
+                                    const PpFootprint& next, uint64_t budget_bytes);
 
 /// Enumerate immediate subdirectories of `parent_dir` matching
 /// `^YYYY-MM-DD_HH-MM(_N)?$`, classify each as WillReprocess / SkipNoteExists
 /// / SkipNoAudio, and return them sorted chronologically by timestamp. The
 /// classification consults `cfg.note_dir` and `find_audio_file()` exactly as
-/// the production pipeline does. Exposed for unit testing.
+/// the production pipeline does. The audio is not decoded: its length comes
+/// from probe_audio()'s header, and only a meeting to reprocess has a few
+/// blocks sampled, for `audio_silent`. With `cfg.reprocess_batch_refresh`, a
+/// meeting whose note exists is checked against its manifest
+/// (stage_cache.h): WillRefresh when expected_meeting_manifest() differs and
+/// the note is the one the manifest recorded, SkipNoteEdited when it has
+/// been changed since. A meeting without a manifest, or whose inputs match,
+/// stays SkipNoteExists. The recording is hashed again only when its size
+/// or mtime differ from the manifest's. Exposed for unit testing.
 std::vector<BatchEntry> classify_batch_entries(
     const fs::path& parent_dir, const Config& cfg);
 
@@ -0,0 +1,180 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "resample.h"
+#include "sample_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace recmeet {
+
+namespace {
+
+constexpr double kZeroCrossings = 16;  // sinc lobes on each side of a tap's centre
+constexpr double kRolloff = 0.90;      // cutoff as a fraction of the lower Nyquist
+constexpr double kKaiserBeta = 8.0;    // ~80 dB stopband
+
+// ResampledSampleSource::read(): output samples computed per inner read.
+constexpr std::size_t kReadBlock = 8 * SAMPLE_RATE;
+
+// Modified Bessel function of the first kind, order 0 (power series).
+double bessel_i0(double x) {
+    double sum = 1, term = 1;
+    const double q = x * x / 4;
+    for (int k = 1; k < 64 && term > sum * 1e-17; ++k) {
+        term *= q / (static_cast<double>(k) * k);
+        sum += term;
+    }
+    return sum;
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// PolyphaseResampler
+// ---------------------------------------------------------------------------
+
+PolyphaseResampler::PolyphaseResampler(int in_rate, int out_rate)
+    : in_rate_(in_rate), out_rate_(out_rate) {
+    if (in_rate <= 0 || out_rate <= 0)
+        throw RecmeetError("Invalid resampling rates: " + std::to_string(in_rate) +
+                           " Hz -> " + std::to_string(out_rate) + " Hz");
+    const int g = std::gcd(in_rate, out_rate);
+    up_ = static_cast<uint64_t>(out_rate / g);
+    down_ = static_cast<uint64_t>(in_rate / g);
+
+    // Cutoff in cycles per input sample; the kernel reaches its last zero
+    // crossing `half` input samples either side of the output's time.
+    const double fc = 0.5 * kRolloff * std::min(1.0, static_cast<double>(up_) / down_);
+    const double half = kZeroCrossings / (2 * fc);
+    taps_ = 2 * static_cast<std::size_t>(std::ceil(half));
+
+    const double i0_beta = bessel_i0(kKaiserBeta);
+    bank_.resize(static_cast<std::size_t>(up_) * taps_);
+    for (uint64_t p = 0; p < up_; ++p) {
+        float* phase = bank_.data() + p * taps_;
+        double sum = 0;
+        for (std::size_t i = 0; i < taps_; ++i) {
+            // Tap i reads input base + i - taps/2 + 1 for an output at
+            // input time base + p / up.
+            const double d = static_cast<double>(i) - static_cast<double>(taps_ / 2) + 1 -
+                             static_cast<double>(p) / static_cast<double>(up_);
+            double h = 0;
+            if (std::fabs(d) < half) {
+                const double x = 2 * fc * d;
+                const double sinc = x == 0 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+                const double r = d / half;
+                h = 2 * fc * sinc * bessel_i0(kKaiserBeta * std::sqrt(1 - r * r)) / i0_beta;
+            }
+            phase[i] = static_cast<float>(h);
+            sum += h;
+        }
+        for (std::size_t i = 0; i < taps_; ++i)
+            phase[i] = static_cast<float>(phase[i] / sum);
+    }
+}
+
+uint64_t PolyphaseResampler::output_length(uint64_t in_n) const {
+    return (in_n * up_ + down_ - 1) / down_;
+}
+
+void PolyphaseResampler::input_span(uint64_t k, std::size_t n,
+                                    int64_t& first, int64_t& last) const {
+    const int64_t lead = static_cast<int64_t>(taps_ / 2) - 1;
+    first = static_cast<int64_t>(k * down_ / up_) - lead;
+    last = n == 0 ? first
+                  : static_cast<int64_t>((k + n - 1) * down_ / up_) + lead + 2;
+}
+
+void PolyphaseResampler::process(uint64_t k, std::size_t n, const float* span,
+                                 float* out) const {
+    const auto& kernels = sample_kernels();
+    const uint64_t base0 = k * down_ / up_;
+    for (std::size_t j = 0; j < n; ++j) {
+        const uint64_t t = (k + j) * down_;
+        const uint64_t phase = t % up_;
+        const std::size_t offset = static_cast<std::size_t>(t / up_ - base0);
+        out[j] = static_cast<float>(
+            kernels.dot_f32(bank_.data() + phase * taps_, span + offset, taps_));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ResampleStream
+// ---------------------------------------------------------------------------
+
+ResampleStream::ResampleStream(const PolyphaseResampler& r) : r_(r) {
+    int64_t last;
+    r_.input_span(0, 1, buf_start_, last);
+    buf_.assign(static_cast<std::size_t>(-buf_start_), 0.0f);  // before sample 0
+}
+
+void ResampleStream::push(const float* in, std::size_t n, std::vector<float>& out) {
+    buf_.insert(buf_.end(), in, in + n);
+    in_n_ += n;
+    // Output k is complete once input up to base(k) + taps/2 is here.
+    const int64_t last_base = buf_start_ + static_cast<int64_t>(buf_.size()) -
+                              static_cast<int64_t>(r_.taps() / 2) - 1;
+    if (last_base < 0) return;
+    const uint64_t end = (static_cast<uint64_t>(last_base + 1) * r_.up() + r_.down() - 1) /
+                         r_.down();
+    emit(end, out);
+}
+
+void ResampleStream::finish(std::vector<float>& out) {
+    const uint64_t end = r_.output_length(in_n_);
+    if (end <= next_) return;
+    int64_t first, last;
+    r_.input_span(next_, static_cast<std::size_t>(end - next_), first, last);
+    const int64_t have = buf_start_ + static_cast<int64_t>(buf_.size());
+    if (last > have) buf_.resize(buf_.size() + static_cast<std::size_t>(last - have), 0.0f);
+    emit(end, out);
+}
+
+void ResampleStream::emit(uint64_t end, std::vector<float>& out) {
+    if (end <= next_) return;
+    const auto n = static_cast<std::size_t>(end - next_);
+    int64_t first, last;
+    r_.input_span(next_, n, first, last);
+    const std::size_t at = out.size();
+    out.resize(at + n);
+    r_.process(next_, n, buf_.data() + (first - buf_start_), out.data() + at);
+    next_ = end;
+
+    r_.input_span(next_, 1, first, last);
+    buf_.erase(buf_.begin(), buf_.begin() + (first - buf_start_));
+    buf_start_ = first;
+}
+
+// ---------------------------------------------------------------------------
+// ResampledSampleSource
+// ---------------------------------------------------------------------------
+
+ResampledSampleSource::ResampledSampleSource(std::unique_ptr<SampleSource> inner, int in_rate)
+    : inner_(std::move(inner)), resampler_(in_rate, SAMPLE_RATE),
+      in_size_(inner_->size()),
+      size_(static_cast<std::size_t>(resampler_.output_length(in_size_))) {}
+
+std::size_t ResampledSampleSource::read(std::size_t start, std::size_t n, float* out) const {
+    if (start >= size_) return 0;
+    n = std::min(n, size_ - start);
+    std::vector<float> span;
+    for (std::size_t done = 0; done < n;) {
+        const std::size_t count = std::min(kReadBlock, n - done);
+        int64_t first, last;
+        resampler_.input_span(start + done, count, first, last);
+        span.assign(static_cast<std::size_t>(last - first), 0.0f);
+        const int64_t lo = std::max<int64_t>(first, 0);
+        const int64_t hi = std::min<int64_t>(last, static_cast<int64_t>(in_size_));
+        if (hi > lo)
+            inner_->read(static_cast<std::size_t>(lo), static_cast<std::size_t>(hi - lo),
+                         span.data() + (lo - first));
+        resampler_.process(start + done, count, span.data(), out + done);
+        done += count;
+    }
+    return n;
+}
+
+} // namespace recmeet
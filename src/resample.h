@@ -0,0 +1,109 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "sample_source.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace recmeet {
+
+/// Rational polyphase resampler from `in_rate` to `out_rate`, the ratio
+/// reduced to up / down by their gcd (44.1 kHz -> 16 kHz is 160 / 441,
+/// 48 kHz -> 16 kHz is 1 / 3).
+///
+/// Output sample k sits at input time k * down / up. Its value is the dot
+/// product of the up input samples around that time with the taps() of
+/// phase (k * down) mod up of a Kaiser-windowed sinc low-pass (16 zero
+/// crossings a side, cut off at 90% of the lower Nyquist, each phase
+/// normalized to unity DC gain), computed with sample_kernels().dot_f32.
+/// Nothing is stateful, so any range of the output can be computed from
+/// the input around it: ResampledSampleSource serves a seekable file at
+/// 16 kHz window by window, and ResampleStream converts a pipe as it
+/// arrives, with bit-identical results.
+class PolyphaseResampler {
+public:
+    /// Throws RecmeetError unless both rates are positive.
+    PolyphaseResampler(int in_rate, int out_rate);
+
+    int in_rate() const { return in_rate_; }
+    int out_rate() const { return out_rate_; }
+    uint64_t up() const { return up_; }
+    uint64_t down() const { return down_; }
+    std::size_t taps() const { return taps_; }
+
+    /// Output samples for `in_n` input samples: ceil(in_n * up / down).
+    uint64_t output_length(uint64_t in_n) const;
+
+    /// The input span [first, last) output samples [k, k + n) are computed
+    /// from. `first` is negative near the start; positions outside the
+    /// signal read as zeros.
+    void input_span(uint64_t k, std::size_t n, int64_t& first, int64_t& last) const;
+
+    /// Output samples [k, k + n) into `out`, from `span`: the input over
+    /// input_span(k, n), zero-padded outside the signal.
+    void process(uint64_t k, std::size_t n, const float* span, float* out) const;
+
+private:
+    int in_rate_;
+    int out_rate_;
+    uint64_t up_ = 1;
+    uint64_t down_ = 1;
+    std::size_t taps_ = 0;
+    std::vector<float> bank_;  // up_ phases of taps_ coefficients
+};
+
+/// A PolyphaseResampler over input that arrives in order (a decoder's
+/// pipe). Holds only the input the next outputs still need.
+class ResampleStream {
+public:
+    /// `r` must outlive the stream.
+    explicit ResampleStream(const PolyphaseResampler& r);
+
+    /// Append `n` input samples, and to `out` every output sample whose
+    /// input span is now complete.
+    void push(const float* in, std::size_t n, std::vector<float>& out);
+
+    /// End of input: append the remaining output_length() samples.
+    void finish(std::vector<float>& out);
+
+private:
+    // Produce outputs [next_, end) from buf_, which must cover their span.
+    void emit(uint64_t end, std::vector<float>& out);
+
+    const PolyphaseResampler& r_;
+    std::vector<float> buf_;  // input from position buf_start_ on
+    int64_t buf_start_ = 0;
+    uint64_t in_n_ = 0;       // input samples pushed
+    uint64_t next_ = 0;       // next output sample
+};
+
+/// Serves a mono SampleSource recorded at `in_rate` at SAMPLE_RATE.
+/// read() resamples just the requested window (in blocks, so scratch
+/// memory is bounded whatever the caller asks for) from the input around
+/// it; `inner` must have a fixed size and is only read. Thread-safe when
+/// `inner` is.
+class ResampledSampleSource : public SampleSource {
+public:
+    ResampledSampleSource(std::unique_ptr<SampleSource> inner, int in_rate);
+
+    ResampledSampleSource(const ResampledSampleSource&) = delete;
+    ResampledSampleSource& operator=(const ResampledSampleSource&) = delete;
+
+    std::size_t size() const override { return size_; }
+    std::size_t read(std::size_t start, std::size_t n, float* out) const override;
+
+    int in_rate() const { return resampler_.in_rate(); }
+
+private:
+    std::unique_ptr<SampleSource> inner_;
+    PolyphaseResampler resampler_;
+    std::size_t in_size_;
+    std::size_t size_;
+};
+
+} // namespace recmeet
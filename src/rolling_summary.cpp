@@ -0,0 +1,179 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "rolling_summary.h"
+#include "ipc_protocol.h"
+#include "log.h"
+
+#include <sched.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <sstream>
+
+namespace recmeet {
+
+namespace {
+
+constexpr int64_t kRollingSummaryVersion = 1;
+constexpr const char* ROLLING_PREFIX = "rolling_";
+
+// Flat-object parse via the IPC parser, as config_from_json() does.
+bool parse_flat_json(const std::string& json, JsonMap& out) {
+    IpcMessage msg;
+    if (!parse_ipc_message("{\"id\":0,\"result\":" + json + "}", msg) ||
+        msg.type != IpcMessageType::Response)
+        return false;
+    out = std::move(msg.response.result);
+    return true;
+}
+
+// Alongside the live transcriber: a local model's threads inherit the policy.
+void lower_worker_priority() {
+    sched_param param{};
+    if (::sched_setscheduler(0, SCHED_IDLE, &param) == 0) return;
+    errno = 0;
+    if (::nice(19) == -1 && errno != 0)
+        log_debug("rolling_summary: scheduler tweak unavailable; using default");
+    else
+        log_debug("rolling_summary: SCHED_IDLE unavailable; using nice(+19)");
+}
+
+} // anonymous namespace
+
+fs::path rolling_summary_path(const fs::path& audio_path) {
+    std::string stem = audio_path.stem().string();
+    const std::string prefix = AUDIO_PREFIX;
+    if (stem.compare(0, prefix.size(), prefix) == 0)
+        stem.erase(0, prefix.size());
+    return audio_path.parent_path() / (std::string(ROLLING_PREFIX) + stem + ".json");
+}
+
+void save_rolling_summary(const fs::path& path, const RollingSummary& summary) {
+    JsonMap m;
+    m["version"]     = kRollingSummaryVersion;
+    m["windows"]     = static_cast<int64_t>(summary.windows);
+    m["covered_sec"] = summary.covered_sec;
+    m["notes"]       = summary.notes;
+    fs::path tmp = path;
+    tmp += ".tmp";
+    write_text_file(tmp, serialize_json_map(m) + "\n");
+    fs::rename(tmp, path);
+}
+
+bool load_rolling_summary(const fs::path& path, RollingSummary& out) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::ostringstream buf;
+    buf << in.rdbuf();
+
+    JsonMap m;
+    if (!parse_flat_json(buf.str(), m) ||
+        json_val_as_int(m["version"]) != kRollingSummaryVersion) {
+        log_debug("rolling_summary: ignoring %s (unreadable)", path.c_str());
+        return false;
+    }
+    RollingSummary rs;
+    rs.windows = static_cast<size_t>(std::max<int64_t>(0, json_val_as_int(m["windows"])));
+    rs.covered_sec = json_val_as_double(m["covered_sec"]);
+    rs.notes = json_val_as_string(m["notes"]);
+    if (rs.notes.empty()) return false;
+    out = std::move(rs);
+    return true;
+}
+
+std::string format_live_windows(const std::vector<LiveWindow>& live, size_t first, size_t last) {
+    TranscriptResult r{};
+    for (size_t i = first; i < last && i < live.size(); ++i)
+        r.segments.insert(r.segments.end(), live[i].segments.begin(), live[i].segments.end());
+    return r.to_string();
+}
+
+std::string transcript_after(const TranscriptResult& result, double after_sec) {
+    TranscriptResult tail{};
+    // Live segments are stored to the millisecond.
+    for (const auto& seg : result.segments)
+        if (seg.start >= after_sec - 0.001) tail.segments.push_back(seg);
+    return tail.to_string();
+}
+
+// ---------------------------------------------------------------------------
+// RollingSummarizer
+// ---------------------------------------------------------------------------
+
+RollingSummarizer::RollingSummarizer(fs::path live_path, fs::path path,
+                                     SummaryCompleter complete, Options opts)
+    : live_path_(std::move(live_path)), path_(std::move(path)),
+      complete_(std::move(complete)), opts_(std::move(opts)) {
+    opts_.interval_sec = std::max(opts_.interval_sec, 1);
+    // A file left by an earlier recording to the same path is not ours.
+    std::error_code ec;
+    fs::remove(path_, ec);
+    worker_ = std::thread([this] { run(); });
+}
+
+RollingSummarizer::~RollingSummarizer() { stop(); }
+
+size_t RollingSummarizer::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+    return done_.load(std::memory_order_acquire);
+}
+
+void RollingSummarizer::run() {
+    lower_worker_priority();
+    RollingSummary state;
+    std::unique_lock<std::mutex> lock(mu_);
+    for (;;) {
+        if (cv_.wait_for(lock, std::chrono::seconds(opts_.interval_sec),
+                         [this] { return stopping_; }))
+            return;
+        lock.unlock();
+        step(state);
+        lock.lock();
+    }
+}
+
+void RollingSummarizer::step(RollingSummary& state) {
+    std::vector<LiveWindow> live;
+    if (!load_live_transcript(live_path_, opts_.key, live) || live.size() <= state.windows)
+        return;
+
+    RollingSummary next = state;
+    next.windows = live.size();
+    for (size_t i = state.windows; i < live.size(); ++i)
+        for (const auto& seg : live[i].segments)
+            next.covered_sec = std::max(next.covered_sec, seg.end);
+    const std::string text = format_live_windows(live, state.windows, live.size());
+    if (!text.empty()) {
+        try {
+            next.notes = complete_(build_rolling_prompt(state.notes, text, opts_.context),
+                                   nullptr);
+        } catch (const std::exception& e) {
+            log_warn("Rolling summary step failed (%s); retrying at the next interval",
+                     e.what());
+            return;
+        }
+    }
+    state = std::move(next);
+    if (state.notes.empty()) return;  // no speech decoded yet
+    try {
+        save_rolling_summary(path_, state);
+    } catch (const std::exception& e) {
+        log_warn("Could not save rolling summary: %s", e.what());
+        return;
+    }
+    const size_t n = done_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    log_info("Rolling summary: step %zu covers %zu live window(s), up to %.0fs",
+             n, state.windows, state.covered_sec);
+}
+
+} // namespace recmeet
@@ -0,0 +1,114 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "live_transcribe.h"
+#include "summarize.h"
+#include "transcribe.h"
+#include "util.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Rolling summary file (`rolling_<ts>.json`)
+// ---------------------------------------------------------------------------
+//
+// Written while recording by RollingSummarizer, read by run_postprocessing().
+// Each step replaces the whole file (written beside it, then renamed), so
+// a reader sees one complete step or the one before it.
+
+/// Prompt tokens a rolling step or the final refine may carry when
+/// `summary.chunk_tokens` is 0. Also bounds a local model's context.
+inline constexpr int ROLLING_SUMMARY_TOKENS = 8192;
+
+/// Notes on the live transcript up to `covered_sec`.
+struct RollingSummary {
+    size_t windows = 0;       ///< live transcript windows folded in
+    double covered_sec = 0;   ///< end of the last segment folded in
+    std::string notes;
+};
+
+/// `<dir>/audio_<ts>.<ext>` -> `<dir>/rolling_<ts>.json`.
+fs::path rolling_summary_path(const fs::path& audio_path);
+
+/// Replace `path` with `summary`. Throws on a write error.
+void save_rolling_summary(const fs::path& path, const RollingSummary& summary);
+
+/// Read `path` into `out`. False when it is missing, unreadable, of
+/// another version or holds no notes.
+bool load_rolling_summary(const fs::path& path, RollingSummary& out);
+
+/// Segments of live windows [`first`, `last`) in TranscriptResult::to_string()
+/// format.
+std::string format_live_windows(const std::vector<LiveWindow>& live, size_t first, size_t last);
+
+/// The segments of `result` that start at or after `after_sec`, in
+/// TranscriptResult::to_string() format: what a rolling summary up to
+/// `after_sec` does not cover.
+std::string transcript_after(const TranscriptResult& result, double after_sec);
+
+// ---------------------------------------------------------------------------
+// RollingSummarizer
+// ---------------------------------------------------------------------------
+
+/// Background summary worker for the recording loop
+/// (`--rolling-summary-minutes`).
+///
+/// Every `interval_sec` a worker thread reads the live transcript that
+/// LiveTranscriber writes, folds the windows added since the last step into
+/// the running notes (build_rolling_prompt()) through `complete`, and
+/// replaces the rolling summary file. The thread runs under SCHED_IDLE
+/// (nice 19 when that is refused), as the live transcriber does.
+///
+/// Best-effort: a step that fails is logged and tried again, with the
+/// windows added meanwhile, at the next interval; the recording is
+/// unaffected.
+class RollingSummarizer {
+public:
+    struct Options {
+        LiveTranscriptKey key;  ///< the live transcript's whisper settings
+        int interval_sec = 600;
+        std::string context;    ///< pre-meeting context for the prompts
+    };
+
+    RollingSummarizer(fs::path live_path, fs::path path, SummaryCompleter complete,
+                      Options opts);
+    ~RollingSummarizer();
+
+    RollingSummarizer(const RollingSummarizer&) = delete;
+    RollingSummarizer& operator=(const RollingSummarizer&) = delete;
+
+    /// Join the worker once the step in progress, if any, is written.
+    /// Idempotent. Returns the number of steps written.
+    size_t stop();
+
+    /// Steps written so far.
+    size_t steps_done() const { return done_.load(std::memory_order_acquire); }
+
+private:
+    void run();
+    void step(RollingSummary& state);
+
+    fs::path live_path_;
+    fs::path path_;
+    SummaryCompleter complete_;
+    Options opts_;
+
+    std::mutex mu_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+
+    std::atomic<size_t> done_{0};
+    std::thread worker_;
+};
+
+} // namespace recmeet
@@ -0,0 +1,576 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "sample_kernels.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RECMEET_KERNELS_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define RECMEET_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace recmeet {
+
+namespace {
+
+constexpr float kS16Scale = 1.0f / 32768.0f;  // exact: power of two
+
+// ---------------------------------------------------------------------------
+// Scalar reference. Also handles the tails of every SIMD variant.
+// ---------------------------------------------------------------------------
+
+void mix_avg_s16_scalar(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = static_cast<int16_t>((int32_t(a[i]) + int32_t(b[i])) / 2);
+}
+
+void add_sat_s16_scalar(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = static_cast<int16_t>(
+            std::clamp(int32_t(a[i]) + int32_t(b[i]), int32_t(-32768), int32_t(32767)));
+}
+
+void s16_to_f32_scalar(const int16_t* in, float* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = static_cast<float>(in[i]) * kS16Scale;
+}
+
+void f32_to_s16_scalar(const float* in, int16_t* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        float v = std::clamp(in[i] * 32768.0f, -32768.0f, 32767.0f);
+        out[i] = static_cast<int16_t>(std::lrintf(v));
+    }
+}
+
+// Adds the tail a[i..n) to `sum` in order.
+double dot_f32_tail(const float* a, const float* b, std::size_t i, std::size_t n, double sum) {
+    for (; i < n; ++i)
+        sum += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+    return sum;
+}
+
+double dot_f32_scalar(const float* a, const float* b, std::size_t n) {
+    double l[4] = {0.0, 0.0, 0.0, 0.0};
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        for (int k = 0; k < 4; ++k)
+            l[k] += static_cast<double>(a[i + k]) * static_cast<double>(b[i + k]);
+    return dot_f32_tail(a, b, i, n, (l[0] + l[1]) + (l[2] + l[3]));
+}
+
+// Accumulates into *sum_sq / *peak, so the SIMD variants can finish their
+// tails with it.
+void energy_s16_tail(const int16_t* in, std::size_t n, uint64_t* sum_sq, uint32_t* peak) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const int32_t v = in[i];
+        *sum_sq += static_cast<uint64_t>(v * v);
+        *peak = std::max(*peak, static_cast<uint32_t>(v < 0 ? -v : v));
+    }
+}
+
+void energy_s16_scalar(const int16_t* in, std::size_t n, uint64_t* sum_sq, uint32_t* peak) {
+    *sum_sq = 0;
+    *peak = 0;
+    energy_s16_tail(in, n, sum_sq, peak);
+}
+
+int32_t dot_s8_scalar(const int8_t* a, const int8_t* b, std::size_t n) {
+    int32_t sum = 0;
+    for (std::size_t i = 0; i < n; ++i) sum += int32_t(a[i]) * int32_t(b[i]);
+    return sum;
+}
+
+float f16_to_f32_one(uint16_t h) {
+    const uint32_t sign = uint32_t(h & 0x8000u) << 16;
+    const uint32_t exp = (h >> 10) & 0x1fu;
+    uint32_t man = h & 0x3ffu;
+    uint32_t bits;
+    if (exp == 0x1f) {
+        bits = sign | 0x7f800000u | (man << 13);  // inf, NaN
+    } else if (exp != 0) {
+        bits = sign | ((exp + 112) << 23) | (man << 13);
+    } else if (man == 0) {
+        bits = sign;
+    } else {  // subnormal: shift the leading 1 into the implicit bit
+        uint32_t e = 113;
+        while (!(man & 0x400u)) {
+            man <<= 1;
+            --e;
+        }
+        bits = sign | (e << 23) | ((man & 0x3ffu) << 13);
+    }
+    float f;
+    std::memcpy(&f, &bits, sizeof f);
+    return f;
+}
+
+void f16_to_f32_scalar(const uint16_t* in, float* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = f16_to_f32_one(in[i]);
+}
+
+constexpr SampleKernels kScalar = {
+    KernelIsa::Scalar, "scalar",
+    mix_avg_s16_scalar, add_sat_s16_scalar, s16_to_f32_scalar, f32_to_s16_scalar,
+    dot_f32_scalar, energy_s16_scalar, dot_s8_scalar, f16_to_f32_scalar,
+};
+
+#if RECMEET_KERNELS_X86
+
+// ---------------------------------------------------------------------------
+// SSE4.2 (the oldest ISA our x86 fleet runs; the kernels only need SSE4.1's
+// pmovsx, but the tier is named after the ggml CPU variant it pairs with).
+// ---------------------------------------------------------------------------
+
+// (s - (s >> 31)) >> 1 == s / 2 truncated toward zero.
+__attribute__((target("sse4.2")))
+inline __m128i half_toward_zero_epi32(__m128i s) {
+    return _mm_srai_epi32(_mm_sub_epi32(s, _mm_srai_epi32(s, 31)), 1);
+}
+
+__attribute__((target("sse4.2")))
+void mix_avg_s16_sse42(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        __m128i lo = _mm_add_epi32(_mm_cvtepi16_epi32(va), _mm_cvtepi16_epi32(vb));
+        __m128i hi = _mm_add_epi32(_mm_cvtepi16_epi32(_mm_srli_si128(va, 8)),
+                                   _mm_cvtepi16_epi32(_mm_srli_si128(vb, 8)));
+        __m128i r = _mm_packs_epi32(half_toward_zero_epi32(lo), half_toward_zero_epi32(hi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+    }
+    mix_avg_s16_scalar(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("sse4.2")))
+void add_sat_s16_sse42(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_adds_epi16(va, vb));
+    }
+    add_sat_s16_scalar(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("sse4.2")))
+void s16_to_f32_sse42(const int16_t* in, float* out, std::size_t n) {
+    const __m128 scale = _mm_set1_ps(kS16Scale);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128 lo = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(v));
+        __m128 hi = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(v, 8)));
+        _mm_storeu_ps(out + i, _mm_mul_ps(lo, scale));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(hi, scale));
+    }
+    s16_to_f32_scalar(in + i, out + i, n - i);
+}
+
+__attribute__((target("sse4.2")))
+void f32_to_s16_sse42(const float* in, int16_t* out, std::size_t n) {
+    const __m128 scale = _mm_set1_ps(32768.0f);
+    const __m128 lo_lim = _mm_set1_ps(-32768.0f);
+    const __m128 hi_lim = _mm_set1_ps(32767.0f);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        // Clamp in float first: cvtps returns INT_MIN for out-of-range
+        // values, which packs would saturate to the wrong rail.
+        __m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(in + i), scale), lo_lim), hi_lim);
+        __m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(in + i + 4), scale), lo_lim), hi_lim);
+        __m128i r = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+    }
+    f32_to_s16_scalar(in + i, out + i, n - i);
+}
+
+// Lanes 0-1 and 2-3 in two accumulators, the scalar lane layout.
+__attribute__((target("sse4.2")))
+double dot_f32_sse42(const float* a, const float* b, std::size_t n) {
+    __m128d l01 = _mm_setzero_pd(), l23 = _mm_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 va = _mm_loadu_ps(a + i);
+        __m128 vb = _mm_loadu_ps(b + i);
+        l01 = _mm_add_pd(l01, _mm_mul_pd(_mm_cvtps_pd(va), _mm_cvtps_pd(vb)));
+        l23 = _mm_add_pd(l23, _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(va, va)),
+                                         _mm_cvtps_pd(_mm_movehl_ps(vb, vb))));
+    }
+    double l[4];
+    _mm_storeu_pd(l, l01);
+    _mm_storeu_pd(l + 2, l23);
+    return dot_f32_tail(a, b, i, n, (l[0] + l[1]) + (l[2] + l[3]));
+}
+
+// pmaddwd sums two squares per lane; (-32768)^2 * 2 = 2^31 only fits
+// unsigned, so the lanes widen to 64 bits with zero extension. pabsw leaves
+// -32768 as 0x8000, which is 32768 read unsigned.
+__attribute__((target("sse4.2")))
+void energy_s16_sse42(const int16_t* in, std::size_t n, uint64_t* sum_sq, uint32_t* peak) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = zero, pk = zero;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i sq = _mm_madd_epi16(v, v);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(sq, zero));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(sq, zero));
+        pk = _mm_max_epu16(pk, _mm_abs_epi16(v));
+    }
+    uint64_t sums[2];
+    uint16_t peaks[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(sums), acc);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(peaks), pk);
+    *sum_sq = sums[0] + sums[1];
+    *peak = *std::max_element(peaks, peaks + 8);
+    energy_s16_tail(in + i, n - i, sum_sq, peak);
+}
+
+// pmovsxbw widens 8 codes to int16; pmaddwd sums adjacent products into
+// int32 lanes.
+__attribute__((target("sse4.2")))
+int32_t dot_s8_sse42(const int8_t* a, const int8_t* b, std::size_t n) {
+    __m128i acc = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i va = _mm_cvtepi8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + i)));
+        __m128i vb = _mm_cvtepi8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b + i)));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(va, vb));
+    }
+    int32_t l[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(l), acc);
+    return l[0] + l[1] + l[2] + l[3] + dot_s8_scalar(a + i, b + i, n - i);
+}
+
+constexpr SampleKernels kSse42 = {
+    KernelIsa::Sse42, "sse4.2",
+    mix_avg_s16_sse42, add_sat_s16_sse42, s16_to_f32_sse42, f32_to_s16_sse42,
+    dot_f32_sse42, energy_s16_sse42, dot_s8_sse42, f16_to_f32_scalar,
+};
+
+// ---------------------------------------------------------------------------
+// AVX2
+// ---------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+inline __m256i half_toward_zero_epi32_avx2(__m256i s) {
+    return _mm256_srai_epi32(_mm256_sub_epi32(s, _mm256_srai_epi32(s, 31)), 1);
+}
+
+// _mm256_packs_epi32 packs within 128-bit lanes; restore sample order.
+__attribute__((target("avx2")))
+inline __m256i packs_epi32_ordered(__m256i lo, __m256i hi) {
+    return _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8);
+}
+
+__attribute__((target("avx2")))
+void mix_avg_s16_avx2(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 8));
+        __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 8));
+        __m256i lo = _mm256_add_epi32(_mm256_cvtepi16_epi32(a0), _mm256_cvtepi16_epi32(b0));
+        __m256i hi = _mm256_add_epi32(_mm256_cvtepi16_epi32(a1), _mm256_cvtepi16_epi32(b1));
+        __m256i r = packs_epi32_ordered(half_toward_zero_epi32_avx2(lo),
+                                        half_toward_zero_epi32_avx2(hi));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+    }
+    mix_avg_s16_scalar(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void add_sat_s16_avx2(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_adds_epi16(va, vb));
+    }
+    add_sat_s16_scalar(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void s16_to_f32_avx2(const int16_t* in, float* out, std::size_t n) {
+    const __m256 scale = _mm256_set1_ps(kS16Scale);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v0)), scale));
+        _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v1)), scale));
+    }
+    s16_to_f32_scalar(in + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void f32_to_s16_avx2(const float* in, int16_t* out, std::size_t n) {
+    const __m256 scale = _mm256_set1_ps(32768.0f);
+    const __m256 lo_lim = _mm256_set1_ps(-32768.0f);
+    const __m256 hi_lim = _mm256_set1_ps(32767.0f);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 a = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i), scale), lo_lim), hi_lim);
+        __m256 b = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i + 8), scale), lo_lim), hi_lim);
+        __m256i r = packs_epi32_ordered(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+    }
+    f32_to_s16_scalar(in + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+double dot_f32_avx2(const float* a, const float* b, std::size_t n) {
+    __m256d acc = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(a + i)),
+                                               _mm256_cvtps_pd(_mm_loadu_ps(b + i))));
+    double l[4];
+    _mm256_storeu_pd(l, acc);
+    return dot_f32_tail(a, b, i, n, (l[0] + l[1]) + (l[2] + l[3]));
+}
+
+// As energy_s16_sse42; lane order does not matter for a sum or a max.
+__attribute__((target("avx2")))
+void energy_s16_avx2(const int16_t* in, std::size_t n, uint64_t* sum_sq, uint32_t* peak) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero, pk = zero;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i sq = _mm256_madd_epi16(v, v);
+        acc = _mm256_add_epi64(acc, _mm256_unpacklo_epi32(sq, zero));
+        acc = _mm256_add_epi64(acc, _mm256_unpackhi_epi32(sq, zero));
+        pk = _mm256_max_epu16(pk, _mm256_abs_epi16(v));
+    }
+    uint64_t sums[4];
+    uint16_t peaks[16];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums), acc);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(peaks), pk);
+    *sum_sq = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    *peak = *std::max_element(peaks, peaks + 16);
+    energy_s16_tail(in + i, n - i, sum_sq, peak);
+}
+
+__attribute__((target("avx2")))
+int32_t dot_s8_avx2(const int8_t* a, const int8_t* b, std::size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i va = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        __m256i vb = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(va, vb));
+    }
+    int32_t l[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(l), acc);
+    int32_t sum = 0;
+    for (int32_t v : l) sum += v;
+    return sum + dot_s8_scalar(a + i, b + i, n - i);
+}
+
+// vcvtph2ps converts every half exactly, subnormals included.
+__attribute__((target("avx2,f16c")))
+void f16_to_f32_avx2(const uint16_t* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))));
+    f16_to_f32_scalar(in + i, out + i, n - i);
+}
+
+constexpr SampleKernels kAvx2 = {
+    KernelIsa::Avx2, "avx2",
+    mix_avg_s16_avx2, add_sat_s16_avx2, s16_to_f32_avx2, f32_to_s16_avx2,
+    dot_f32_avx2, energy_s16_avx2, dot_s8_avx2, f16_to_f32_avx2,
+};
+
+bool have_avx2() {
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c");
+}
+
+#endif // RECMEET_KERNELS_X86
+
+#if RECMEET_KERNELS_NEON
+
+// ---------------------------------------------------------------------------
+// NEON (baseline on aarch64 — no runtime check needed)
+// ---------------------------------------------------------------------------
+
+inline int32x4_t half_toward_zero_s32(int32x4_t s) {
+    return vshrq_n_s32(vsubq_s32(s, vshrq_n_s32(s, 31)), 1);
+}
+
+void mix_avg_s16_neon(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t va = vld1q_s16(a + i);
+        int16x8_t vb = vld1q_s16(b + i);
+        int32x4_t lo = vaddl_s16(vget_low_s16(va), vget_low_s16(vb));
+        int32x4_t hi = vaddl_s16(vget_high_s16(va), vget_high_s16(vb));
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(half_toward_zero_s32(lo)),
+                                        vqmovn_s32(half_toward_zero_s32(hi))));
+    }
+    mix_avg_s16_scalar(a + i, b + i, out + i, n - i);
+}
+
+void add_sat_s16_neon(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        vst1q_s16(out + i, vqaddq_s16(vld1q_s16(a + i), vld1q_s16(b + i)));
+    add_sat_s16_scalar(a + i, b + i, out + i, n - i);
+}
+
+void s16_to_f32_neon(const int16_t* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t v = vld1q_s16(in + i);
+        vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), kS16Scale));
+        vst1q_f32(out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), kS16Scale));
+    }
+    s16_to_f32_scalar(in + i, out + i, n - i);
+}
+
+void f32_to_s16_neon(const float* in, int16_t* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        // vcvtnq rounds half-to-even and saturates; vqmovn saturates again.
+        int32x4_t lo = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(in + i), 32768.0f));
+        int32x4_t hi = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(in + i + 4), 32768.0f));
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+    }
+    f32_to_s16_scalar(in + i, out + i, n - i);
+}
+
+double dot_f32_neon(const float* a, const float* b, std::size_t n) {
+    float64x2_t l01 = vdupq_n_f64(0.0), l23 = vdupq_n_f64(0.0);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t va = vld1q_f32(a + i);
+        float32x4_t vb = vld1q_f32(b + i);
+        l01 = vaddq_f64(l01, vmulq_f64(vcvt_f64_f32(vget_low_f32(va)),
+                                       vcvt_f64_f32(vget_low_f32(vb))));
+        l23 = vaddq_f64(l23, vmulq_f64(vcvt_high_f64_f32(va), vcvt_high_f64_f32(vb)));
+    }
+    double l[4];
+    vst1q_f64(l, l01);
+    vst1q_f64(l + 2, l23);
+    return dot_f32_tail(a, b, i, n, (l[0] + l[1]) + (l[2] + l[3]));
+}
+
+// A square fits int32 (at most 2^30); vpadal widens pairs into int64.
+// vabs leaves -32768 as 0x8000, which is 32768 read unsigned.
+void energy_s16_neon(const int16_t* in, std::size_t n, uint64_t* sum_sq, uint32_t* peak) {
+    int64x2_t acc = vdupq_n_s64(0);
+    uint16x8_t pk = vdupq_n_u16(0);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t v = vld1q_s16(in + i);
+        acc = vpadalq_s32(acc, vmull_s16(vget_low_s16(v), vget_low_s16(v)));
+        acc = vpadalq_s32(acc, vmull_s16(vget_high_s16(v), vget_high_s16(v)));
+        pk = vmaxq_u16(pk, vreinterpretq_u16_s16(vabsq_s16(v)));
+    }
+    *sum_sq = static_cast<uint64_t>(vaddvq_s64(acc));
+    *peak = vmaxvq_u16(pk);
+    energy_s16_tail(in + i, n - i, sum_sq, peak);
+}
+
+// vmull_s8 widens 8 products to int16 (each fits); vpadal sums pairs into
+// int32 lanes.
+int32_t dot_s8_neon(const int8_t* a, const int8_t* b, std::size_t n) {
+    int32x4_t acc = vdupq_n_s32(0);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        acc = vpadalq_s16(acc, vmull_s8(vld1_s8(a + i), vld1_s8(b + i)));
+    return vaddvq_s32(acc) + dot_s8_scalar(a + i, b + i, n - i);
+}
+
+void f16_to_f32_neon(const uint16_t* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(out + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(in + i))));
+    f16_to_f32_scalar(in + i, out + i, n - i);
+}
+
+constexpr SampleKernels kNeon = {
+    KernelIsa::Neon, "neon",
+    mix_avg_s16_neon, add_sat_s16_neon, s16_to_f32_neon, f32_to_s16_neon,
+    dot_f32_neon, energy_s16_neon, dot_s8_neon, f16_to_f32_neon,
+};
+
+#endif // RECMEET_KERNELS_NEON
+
+// Highest-preference variant the host supports.
+const SampleKernels& best_supported() {
+#if RECMEET_KERNELS_X86
+    if (have_avx2()) return kAvx2;
+    if (__builtin_cpu_supports("sse4.2")) return kSse42;
+#elif RECMEET_KERNELS_NEON
+    return kNeon;
+#endif
+    return kScalar;
+}
+
+const SampleKernels& resolve() {
+    const SampleKernels* chosen = &best_supported();
+    if (const char* env = std::getenv("RECMEET_AUDIO_KERNELS"); env && *env) {
+        const SampleKernels* forced = nullptr;
+        for (KernelIsa isa : {KernelIsa::Scalar, KernelIsa::Sse42,
+                              KernelIsa::Avx2, KernelIsa::Neon}) {
+            const SampleKernels* k = sample_kernels_variant(isa);
+            if (k && std::strcmp(k->name, env) == 0) forced = k;
+        }
+        if (forced)
+            chosen = forced;
+        else
+            log_warn("RECMEET_AUDIO_KERNELS=%s not supported on this host; using %s",
+                     env, chosen->name);
+    }
+    log_debug("audio kernels: %s", chosen->name);
+    return *chosen;
+}
+
+} // anonymous namespace
+
+const SampleKernels* sample_kernels_variant(KernelIsa isa) {
+    switch (isa) {
+    case KernelIsa::Scalar:
+        return &kScalar;
+#if RECMEET_KERNELS_X86
+    case KernelIsa::Sse42:
+        return __builtin_cpu_supports("sse4.2") ? &kSse42 : nullptr;
+    case KernelIsa::Avx2:
+        return have_avx2() ? &kAvx2 : nullptr;
+#endif
+#if RECMEET_KERNELS_NEON
+    case KernelIsa::Neon:
+        return &kNeon;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+const SampleKernels& sample_kernels() {
+    static const SampleKernels& active = resolve();
+    return active;
+}
+
+void ring_s16_to_f32(const int16_t* ring, std::size_t mask, std::size_t pos,
+                     float* out, std::size_t n) {
+    const std::size_t off = pos & mask;
+    const std::size_t first = std::min(n, mask + 1 - off);
+    const auto& k = sample_kernels();
+    k.s16_to_f32(ring + off, out, first);
+    k.s16_to_f32(ring, out + first, n - first);
+}
+
+} // namespace recmeet
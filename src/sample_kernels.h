@@ -0,0 +1,73 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace recmeet {
+
+/// Instruction-set variants of the per-sample audio and embedding kernels,
+/// in ascending preference order within an architecture.
+enum class KernelIsa {
+    Scalar,
+    Sse42,
+    Avx2,
+    Neon,
+};
+
+/// One variant's kernel table. Every variant is bit-exact with the scalar
+/// reference for all inputs except NaN in f32_to_s16 and dot_f32
+/// (unspecified) and in f16_to_f32 (a NaN, payload unspecified).
+struct SampleKernels {
+    KernelIsa isa;
+    const char* name;  ///< "scalar", "sse4.2", "avx2", "neon"
+
+    /// out[i] = (a[i] + b[i]) / 2, truncated toward zero — mix_audio()'s
+    /// averaging rule (the result always fits int16).
+    void (*mix_avg_s16)(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n);
+    /// out[i] = clamp(a[i] + b[i], -32768, 32767).
+    void (*add_sat_s16)(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n);
+    /// out[i] = in[i] / 32768.0f — libsndfile's normalized-read convention.
+    void (*s16_to_f32)(const int16_t* in, float* out, std::size_t n);
+    /// out[i] = round-half-even(clamp(in[i] * 32768, -32768, 32767)).
+    void (*f32_to_s16)(const float* in, int16_t* out, std::size_t n);
+    /// sum(a[i] * b[i]) in double. Each product is exact; the sums run in
+    /// four lanes (i mod 4, over the first n - n % 4 elements) combined as
+    /// (l0 + l1) + (l2 + l3), then the tail adds in order. Embedding
+    /// similarity (see embedding_set.h).
+    double (*dot_f32)(const float* a, const float* b, std::size_t n);
+    /// *sum_sq = sum(in[i]^2) (exact), *peak = max |in[i]| (32768 for
+    /// -32768; 0 when n is 0). Level metering (see level_meter.h).
+    void (*energy_s16)(const int16_t* in, std::size_t n, uint64_t* sum_sq, uint32_t* peak);
+    /// sum(a[i] * b[i]) of int8 codes, exact (n below 2^17 cannot overflow).
+    /// The approximate scan of speaker_ann.h.
+    int32_t (*dot_s8)(const int8_t* a, const int8_t* b, std::size_t n);
+    /// out[i] = in[i] read as IEEE binary16 — exact, every half is a float.
+    /// Embeddings stored at f16 (embedding_set.h).
+    void (*f16_to_f32)(const uint16_t* in, float* out, std::size_t n);
+};
+
+/// Active kernel table. Resolved once per process, the same way ggml's
+/// CPU_ALL_VARIANTS build picks a libggml-cpu-*.so: every variant is compiled
+/// into the binary (per-function target attributes, no global -m flags) and
+/// the highest-scoring one the host CPU supports wins (the AVX2 table also
+/// needs F16C, which every AVX2 part has). The
+/// RECMEET_AUDIO_KERNELS environment variable ("scalar", "sse4.2", "avx2",
+/// "neon") forces a variant for benchmarking; an unsupported value falls
+/// back to auto-selection.
+const SampleKernels& sample_kernels();
+
+/// A specific variant, or nullptr when it is not compiled for this
+/// architecture or the host CPU lacks the instructions. Test / bench seam.
+const SampleKernels* sample_kernels_variant(KernelIsa isa);
+
+/// Convert `n` samples of a power-of-two int16 ring (`mask` = capacity - 1),
+/// starting at free-running index `pos`, to float with the active
+/// s16_to_f32: two contiguous runs at most, either side of the wrap. The
+/// caption engine's ring drain; `n` must not exceed the capacity.
+void ring_s16_to_f32(const int16_t* ring, std::size_t mask, std::size_t pos,
+                     float* out, std::size_t n);
+
+} // namespace recmeet
@@ -0,0 +1,100 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace recmeet {
+
+/// Fixed-capacity single-producer / single-consumer ring of int16 samples.
+///
+/// The storage is allocated once in the constructor; push() and pop() never
+/// allocate, lock, or log, so the producer side is safe on a PipeWire
+/// RT-promoted thread. The producer owns `head_`, the consumer owns `tail_`;
+/// each publishes its index with a release store and observes the other's
+/// with an acquire load.
+///
+/// Unlike the caption engine's ring (which drops the oldest audio so the
+/// recognizer stays live), a full SampleRing drops the *incoming* samples:
+/// the batch store wants every sample it does get to be contiguous with the
+/// previous one, and the caller counts what was rejected.
+///
+/// Exactly one thread may call push() and exactly one (possibly different)
+/// thread may call pop() at a time. Callers that pop from more than one
+/// thread must serialize those calls themselves.
+class SampleRing {
+public:
+    /// `capacity` is rounded up to a power of two (minimum 2).
+    explicit SampleRing(std::size_t capacity) {
+        std::size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        buf_.resize(cap);
+        mask_ = cap - 1;
+    }
+
+    SampleRing(const SampleRing&) = delete;
+    SampleRing& operator=(const SampleRing&) = delete;
+
+    /// Producer: copy up to `n` samples in. Returns the number accepted;
+    /// `n - return` samples were dropped because the ring was full.
+    std::size_t push(const int16_t* samples, std::size_t n) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        const std::size_t free_space = buf_.size() - (head - tail);
+        const std::size_t take = std::min(n, free_space);
+        copy_in(head, samples, take);
+        head_.store(head + take, std::memory_order_release);
+        return take;
+    }
+
+    /// Consumer: copy up to `max` samples out. Returns the number copied.
+    std::size_t pop(int16_t* out, std::size_t max) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        const std::size_t take = std::min(max, head - tail);
+        copy_out(tail, out, take);
+        tail_.store(tail + take, std::memory_order_release);
+        return take;
+    }
+
+    /// Samples currently queued. Exact from the consumer thread; a snapshot
+    /// from anywhere else.
+    std::size_t size() const {
+        return head_.load(std::memory_order_acquire) -
+               tail_.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return buf_.size(); }
+
+private:
+    // Split each copy at the wrap point so both sides are two memcpy calls
+    // at most, rather than a per-sample masked loop.
+    void copy_in(std::size_t pos, const int16_t* src, std::size_t n) {
+        const std::size_t off = pos & mask_;
+        const std::size_t first = std::min(n, buf_.size() - off);
+        std::memcpy(buf_.data() + off, src, first * sizeof(int16_t));
+        std::memcpy(buf_.data(), src + first, (n - first) * sizeof(int16_t));
+    }
+
+    void copy_out(std::size_t pos, int16_t* dst, std::size_t n) const {
+        const std::size_t off = pos & mask_;
+        const std::size_t first = std::min(n, buf_.size() - off);
+        std::memcpy(dst, buf_.data() + off, first * sizeof(int16_t));
+        std::memcpy(dst + first, buf_.data(), (n - first) * sizeof(int16_t));
+    }
+
+    std::vector<int16_t> buf_;
+    std::size_t mask_ = 0;
+    // Separate cache lines so producer and consumer index stores do not
+    // false-share.
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+};
+
+} // namespace recmeet
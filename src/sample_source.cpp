@@ -0,0 +1,95 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "sample_source.h"
+#include "audio_spool.h"
+#include "sample_kernels.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace recmeet {
+
+namespace {
+
+// SpoolSampleSource converts through a stack block of this many samples.
+constexpr std::size_t kSpoolReadBlock = 4096;
+
+} // anonymous namespace
+
+const float* SampleSource::view(std::size_t start, std::size_t n,
+                               std::vector<float>& scratch, std::size_t& n_out) const {
+    const std::size_t total = size();
+    n_out = start < total ? std::min(n, total - start) : 0;
+    if (const float* p = data())
+        return p + std::min(start, total);
+    scratch.resize(n_out);
+    n_out = read(start, n_out, scratch.data());
+    return scratch.data();
+}
+
+std::vector<float> SampleSource::window(std::size_t start, std::size_t n) const {
+    const std::size_t total = size();
+    std::vector<float> out(start < total ? std::min(n, total - start) : 0);
+    out.resize(read(start, out.size(), out.data()));
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// MemorySampleSource
+// ---------------------------------------------------------------------------
+
+std::size_t MemorySampleSource::read(std::size_t start, std::size_t n, float* out) const {
+    if (start >= size_) return 0;
+    n = std::min(n, size_ - start);
+    std::copy_n(samples_ + start, n, out);
+    return n;
+}
+
+// ---------------------------------------------------------------------------
+// SpoolSampleSource
+// ---------------------------------------------------------------------------
+
+SpoolSampleSource::SpoolSampleSource(const AudioSpool& spool) : spool_(spool) {
+    fd_ = ::open(spool.path().c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0)
+        throw RecmeetError("Failed to open capture spool for reading: " +
+                           spool.path().string() + " (" + std::strerror(errno) + ")");
+}
+
+SpoolSampleSource::~SpoolSampleSource() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+std::size_t SpoolSampleSource::size() const {
+    return spool_.samples_written();
+}
+
+std::size_t SpoolSampleSource::read(std::size_t start, std::size_t n, float* out) const {
+    const std::size_t total = size();
+    if (start >= total) return 0;
+    n = std::min(n, total - start);
+
+    const auto& k = sample_kernels();
+    int16_t block[kSpoolReadBlock];
+    std::size_t done = 0;
+    while (done < n) {
+        std::size_t want = std::min(n - done, kSpoolReadBlock);
+        off_t off = static_cast<off_t>(SPOOL_WAV_HEADER_BYTES +
+                                       (start + done) * sizeof(int16_t));
+        ssize_t got = ::pread(fd_, block, want * sizeof(int16_t), off);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+        std::size_t samples = static_cast<std::size_t>(got) / sizeof(int16_t);
+        k.s16_to_f32(block, out + done, samples);
+        done += samples;
+        if (samples < want) break;
+    }
+    return done;
+}
+
+} // namespace recmeet
@@ -0,0 +1,105 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace recmeet {
+
+class AudioSpool;
+
+/// Random-access source of 16 kHz mono float32 samples that postprocessing
+/// stages pull windows from, so their working set is bounded by the window
+/// they need rather than by the meeting length.
+///
+/// Implementations: MemorySampleSource (a float buffer already in RAM),
+/// AudioView (a WAV file, mmap-backed — see audio_view.h) and
+/// SpoolSampleSource (a capture spool that may still be recording).
+///
+/// size() may grow between calls for a live source; it never shrinks.
+/// read() must be safe to call from several threads at once.
+class SampleSource {
+public:
+    virtual ~SampleSource() = default;
+
+    /// Samples currently available.
+    virtual std::size_t size() const = 0;
+
+    /// Convert samples [start, start + n) into `out`, clamped to size().
+    /// Returns the number of samples written.
+    virtual std::size_t read(std::size_t start, std::size_t n, float* out) const = 0;
+
+    /// Pointer to all size() samples when the source already holds them as
+    /// contiguous float32, else nullptr. Lets view() skip the copy.
+    virtual const float* data() const { return nullptr; }
+
+    /// Samples [start, start + n) (clamped), valid until `scratch` is
+    /// modified or the source is destroyed: points straight into data()
+    /// when available, otherwise reads into `scratch`. `n_out` receives
+    /// the clamped length.
+    const float* view(std::size_t start, std::size_t n, std::vector<float>& scratch,
+                      std::size_t& n_out) const;
+
+    /// Samples [start, start + n) as an owned float buffer (clamped).
+    std::vector<float> window(std::size_t start, std::size_t n) const;
+
+    /// The whole source as floats — for consumers that need one contiguous
+    /// buffer. Scope the result to that consumer.
+    std::vector<float> to_float() const { return window(0, size()); }
+
+    double duration_seconds() const {
+        return static_cast<double>(size()) / SAMPLE_RATE;
+    }
+};
+
+/// Float samples in RAM: either a borrowed [samples, samples + n) range
+/// (the caller keeps it alive) or an owned vector. This is how the
+/// pointer-based stage entry points reach the SampleSource implementations
+/// without copying.
+class MemorySampleSource : public SampleSource {
+public:
+    MemorySampleSource(const float* samples, std::size_t n)
+        : samples_(samples), size_(n) {}
+    explicit MemorySampleSource(std::vector<float> samples)
+        : owned_(std::move(samples)), samples_(owned_.data()), size_(owned_.size()) {}
+
+    MemorySampleSource(const MemorySampleSource&) = delete;
+    MemorySampleSource& operator=(const MemorySampleSource&) = delete;
+
+    std::size_t size() const override { return size_; }
+    std::size_t read(std::size_t start, std::size_t n, float* out) const override;
+    const float* data() const override { return samples_; }
+
+private:
+    std::vector<float> owned_;
+    const float* samples_;
+    std::size_t size_;
+};
+
+/// Reads a capture spool's file while it is being written. size() follows
+/// AudioSpool::samples_written(), so a consumer can trail the recording by
+/// a few seconds; after AudioSpool::finish() it stays readable at its final
+/// length. The spool must outlive this source.
+class SpoolSampleSource : public SampleSource {
+public:
+    /// Open the spool's file for reading. Throws RecmeetError on failure.
+    explicit SpoolSampleSource(const AudioSpool& spool);
+    ~SpoolSampleSource() override;
+
+    SpoolSampleSource(const SpoolSampleSource&) = delete;
+    SpoolSampleSource& operator=(const SpoolSampleSource&) = delete;
+
+    std::size_t size() const override;
+    std::size_t read(std::size_t start, std::size_t n, float* out) const override;
+
+private:
+    const AudioSpool& spool_;
+    int fd_ = -1;
+};
+
+} // namespace recmeet
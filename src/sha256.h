@@ -0,0 +1,40 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace recmeet {
+
+/// Incremental SHA-256 (FIPS 180-4), for checking downloaded models against
+/// their published digests. Feed bytes with update(), then take hex_digest()
+/// once.
+class Sha256 {
+public:
+    Sha256();
+    void update(const void* data, size_t len);
+    /// Lowercase hex digest of everything fed so far. Ends the hash.
+    std::string hex_digest();
+
+private:
+    void block(const uint8_t* p);
+
+    uint32_t h_[8];
+    uint8_t buf_[64];
+    size_t buf_len_ = 0;
+    uint64_t total_ = 0;
+};
+
+/// SHA-256 of `text`, in lowercase hex.
+std::string sha256_hex(const std::string& text);
+
+/// SHA-256 of the file at `path`, in lowercase hex. Throws RecmeetError
+/// when it cannot be read.
+std::string sha256_file(const fs::path& path);
+
+} // namespace recmeet
@@ -0,0 +1,127 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "sparse_audio.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace recmeet {
+
+namespace {
+
+// sparse_*.bin: magic, then little-endian u32 sample rate, u64 recording
+// samples, u32 hash length, u32 piece count, the hash, and each piece as u64
+// start and u64 length. Offsets follow from the lengths.
+constexpr char kSparseMagic[8] = {'R', 'M', 'S', 'P', 'R', 'S', '1', '\0'};
+constexpr std::size_t kSparseHeaderBytes = sizeof(kSparseMagic) + 20;
+constexpr std::size_t kSparseMaxHash = 256;
+
+void put_u32(std::string& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out += static_cast<char>((v >> (8 * i)) & 0xff);
+}
+
+void put_u64(std::string& out, uint64_t v) {
+    put_u32(out, static_cast<uint32_t>(v));
+    put_u32(out, static_cast<uint32_t>(v >> 32));
+}
+
+uint32_t get_u32(const std::string& in, std::size_t at) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= uint32_t(static_cast<uint8_t>(in[at + i])) << (8 * i);
+    return v;
+}
+
+uint64_t get_u64(const std::string& in, std::size_t at) {
+    return uint64_t(get_u32(in, at)) | uint64_t(get_u32(in, at + 4)) << 32;
+}
+
+} // anonymous namespace
+
+std::vector<SparsePiece> sparse_pieces(const std::vector<VadSegment>& segments,
+                                       std::size_t total, std::size_t pad) {
+    std::vector<SparsePiece> pieces;
+    uint64_t stored = 0;
+    for (const auto& seg : segments) {
+        const auto s0 = static_cast<std::size_t>(std::max(seg.start_sample, 0));
+        const auto e0 = static_cast<std::size_t>(std::max(seg.end_sample, 0));
+        const std::size_t s = std::min(s0 > pad ? s0 - pad : 0, total);
+        const std::size_t e = std::min(e0 + pad, total);
+        if (e <= s) continue;
+        if (!pieces.empty() && s <= pieces.back().start + pieces.back().n) {
+            SparsePiece& last = pieces.back();
+            if (e > last.start + last.n) {
+                stored += e - (last.start + last.n);
+                last.n = e - last.start;
+            }
+            continue;
+        }
+        pieces.push_back({s, e - s, stored});
+        stored += e - s;
+    }
+    return pieces;
+}
+
+fs::path sparse_index_path(const fs::path& audio_path) {
+    std::string stem = audio_path.stem().string();
+    const std::string prefix = AUDIO_PREFIX;
+    if (stem.compare(0, prefix.size(), prefix) == 0)
+        stem.erase(0, prefix.size());
+    return audio_path.parent_path() / (std::string(SPARSE_PREFIX) + stem + ".bin");
+}
+
+void save_sparse_index(const fs::path& path, const SparseAudioIndex& index) {
+    if (index.audio_hash.size() > kSparseMaxHash)
+        throw RecmeetError("Sparse audio index hash too long");
+    std::string out(kSparseMagic, sizeof(kSparseMagic));
+    out.reserve(kSparseHeaderBytes + index.audio_hash.size() + 16 * index.pieces.size());
+    put_u32(out, static_cast<uint32_t>(SAMPLE_RATE));
+    put_u64(out, index.total_samples);
+    put_u32(out, static_cast<uint32_t>(index.audio_hash.size()));
+    put_u32(out, static_cast<uint32_t>(index.pieces.size()));
+    out += index.audio_hash;
+    for (const auto& p : index.pieces) {
+        put_u64(out, p.start);
+        put_u64(out, p.n);
+    }
+    write_text_file_atomic(path, out);
+}
+
+bool load_sparse_index(const fs::path& path, std::size_t stored_samples,
+                       SparseAudioIndex& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < kSparseHeaderBytes ||
+        std::memcmp(data.data(), kSparseMagic, sizeof(kSparseMagic)) != 0 ||
+        get_u32(data, sizeof(kSparseMagic)) != static_cast<uint32_t>(SAMPLE_RATE))
+        return false;
+    std::size_t at = sizeof(kSparseMagic) + 4;
+    SparseAudioIndex index;
+    index.total_samples = get_u64(data, at);
+    const std::size_t hash_len = get_u32(data, at + 8);
+    const std::size_t count = get_u32(data, at + 12);
+    at += 16;
+    if (hash_len > kSparseMaxHash || data.size() != at + hash_len + 16 * count) return false;
+    index.audio_hash = data.substr(at, hash_len);
+    at += hash_len;
+
+    uint64_t stored = 0, end = 0;
+    index.pieces.reserve(count);
+    for (std::size_t i = 0; i < count; ++i, at += 16) {
+        const uint64_t start = get_u64(data, at), n = get_u64(data, at + 8);
+        // In order, non-overlapping, inside the recording.
+        if (n == 0 || start < end || start >= index.total_samples ||
+            n > index.total_samples - start)
+            return false;
+        index.pieces.push_back({start, n, stored});
+        stored += n;
+        end = start + n;
+    }
+    if (stored != stored_samples) return false;
+    out = std::move(index);
+    return true;
+}
+
+} // namespace recmeet
@@ -0,0 +1,103 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+#include "vad.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Speech-only archive (audio.archive_speech_only)
+// ---------------------------------------------------------------------------
+//
+// A finished meeting's audio can be archived as its speech alone: the VAD
+// regions, padded a little, stored back to back, and an index saved beside
+// it as sparse_YYYY-MM-DD_HH-MM.bin that maps each stored piece to where it
+// sat in the recording. AudioView, read_wav_float() and
+// get_audio_duration_seconds() read the index and serve the original
+// timeline, the dropped silence as zeros, so reprocess, --enroll and the
+// note's timestamps see the meeting they always did while disk use and
+// decode time follow speech time.
+//
+// The index also keeps the recording's hash_samples() from before the
+// silence was dropped, so stage-cache entries and the meeting manifest
+// written against the full recording still match it.
+
+/// Silence kept on each side of a speech region: enough that word onsets
+/// and trailing syllables the VAD clipped survive, and that the segments
+/// diarization and whisper cut stay the same.
+constexpr std::size_t SPARSE_PAD_SAMPLES = static_cast<std::size_t>(SAMPLE_RATE) / 2;
+
+struct SparsePiece {
+    uint64_t start;   ///< first sample in the recording
+    uint64_t n;       ///< samples
+    uint64_t offset;  ///< position of the piece in the stored audio
+};
+
+struct SparseAudioIndex {
+    uint64_t total_samples = 0;  ///< length of the recording
+    std::string audio_hash;      ///< hash_samples() of the recording; empty if unknown
+    std::vector<SparsePiece> pieces;
+
+    /// Samples in the stored audio.
+    uint64_t stored_samples() const {
+        return pieces.empty() ? 0 : pieces.back().offset + pieces.back().n;
+    }
+};
+
+/// `segments` (source order, as detect_speech() returns them) widened by
+/// `pad` on each side, clamped to [0, total) and merged where the padding
+/// meets, as the pieces of a speech-only archive of `total` samples.
+std::vector<SparsePiece> sparse_pieces(const std::vector<VadSegment>& segments,
+                                       std::size_t total,
+                                       std::size_t pad = SPARSE_PAD_SAMPLES);
+
+/// Path of the index for `audio_path`: the `audio_` prefix (if any) of the
+/// file stem is replaced by `sparse_`, in the same directory. The stem
+/// survives audio.archive re-encoding, so one index serves .wav, .flac and
+/// .opus alike.
+fs::path sparse_index_path(const fs::path& audio_path);
+
+/// Write `index` to `path`. Throws RecmeetError if it cannot be written.
+void save_sparse_index(const fs::path& path, const SparseAudioIndex& index);
+
+/// Load the index at `path` into `out`. False, leaving `out` untouched,
+/// when it is missing or malformed, or describes stored audio of other
+/// than `stored_samples` samples (the index of an interrupted compaction,
+/// beside the full recording).
+bool load_sparse_index(const fs::path& path, std::size_t stored_samples,
+                       SparseAudioIndex& out);
+
+/// Read samples [start, start + n) of the recording `index` describes into
+/// `out`: zeros outside the pieces, and `read_stored(pos, count, dst)` — the
+/// stored audio's samples [pos, pos + count) — inside them. Returns the
+/// samples written, clamped to the recording.
+template <typename ReadStored>
+std::size_t read_sparse(const SparseAudioIndex& index, std::size_t start, std::size_t n,
+                        float* out, ReadStored&& read_stored) {
+    const std::size_t total = static_cast<std::size_t>(index.total_samples);
+    if (start >= total) return 0;
+    n = std::min(n, total - start);
+    std::fill(out, out + n, 0.0f);
+    // First piece ending after `start`.
+    auto it = std::upper_bound(index.pieces.begin(), index.pieces.end(), start,
+                               [](std::size_t pos, const SparsePiece& p) {
+                                   return pos < p.start + p.n;
+                               });
+    for (; it != index.pieces.end() && it->start < start + n; ++it) {
+        const std::size_t a = std::max<std::size_t>(start, it->start);
+        const std::size_t b = std::min<std::size_t>(start + n, it->start + it->n);
+        if (a < b) read_stored(it->offset + (a - it->start), b - a, out + (a - start));
+    }
+    return n;
+}
+
+} // namespace recmeet
@@ -0,0 +1,321 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "speaker_ann.h"
+#include "sample_kernels.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace recmeet {
+
+namespace {
+
+constexpr char kMagic[8] = {'R', 'M', 'S', 'P', 'K', 'I', 'V', 'F'};
+constexpr uint32_t kByteOrder = 0x01020304;
+constexpr double kNormEps = 1e-9;
+constexpr int kTrainIterations = 8;
+constexpr std::size_t kTrainRowsPerList = 64;  ///< k-means sample cap, per list
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t count;
+};
+static_assert(sizeof(Header) == 24, "speakers.ivf header layout");
+
+struct Block {
+    uint32_t dim;
+    uint32_t nlist;
+    uint64_t trained_rows;
+};
+static_assert(sizeof(Block) == 16, "speakers.ivf block layout");
+
+double dot(const float* a, const float* b, std::size_t n) {
+    return sample_kernels().dot_f32(a, b, n);
+}
+
+// `raw` scaled to unit length into `out`; false for a (near) zero vector.
+bool normalize(const float* raw, std::size_t dim, float* out) {
+    const double norm = std::sqrt(dot(raw, raw, dim));
+    if (norm < kNormEps) return false;
+    for (std::size_t i = 0; i < dim; ++i) out[i] = static_cast<float>(raw[i] / norm);
+    return true;
+}
+
+// 8-bit codes of `unit`; returns the factor turning a code back into a value.
+float encode(const float* unit, std::size_t dim, int8_t* out) {
+    float max_abs = 0.0f;
+    for (std::size_t i = 0; i < dim; ++i) max_abs = std::max(max_abs, std::fabs(unit[i]));
+    if (max_abs == 0.0f) {
+        std::fill(out, out + dim, int8_t{0});
+        return 0.0f;
+    }
+    const float scale = max_abs / 127.0f;
+    for (std::size_t i = 0; i < dim; ++i)
+        out[i] = static_cast<int8_t>(std::lround(unit[i] / scale));
+    return scale;
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// speakers.ivf
+// ---------------------------------------------------------------------------
+
+std::vector<IvfQuantizer> read_speaker_ann(const fs::path& path) {
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw RecmeetError("Cannot open speaker ANN index: " + path.string());
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    auto bad = [&](const char* why) {
+        return RecmeetError("Invalid speaker ANN index " + path.string() + ": " + why);
+    };
+    if (bytes.size() < sizeof(Header)) throw bad("too short");
+    Header h;
+    std::memcpy(&h, bytes.data(), sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) throw bad("not a speakers.ivf file");
+    if (h.byte_order != kByteOrder) throw bad("written on a host of the other byte order");
+    if (h.version != SPEAKER_ANN_VERSION)
+        throw bad(("unsupported version " + std::to_string(h.version)).c_str());
+
+    std::vector<IvfQuantizer> out;
+    std::size_t pos = sizeof(Header);
+    for (uint64_t i = 0; i < h.count; ++i) {
+        if (bytes.size() - pos < sizeof(Block)) throw bad("truncated");
+        Block b;
+        std::memcpy(&b, bytes.data() + pos, sizeof(b));
+        pos += sizeof(b);
+        const uint64_t floats = uint64_t(b.dim) * b.nlist;
+        if (b.dim == 0 || b.nlist == 0 || floats > (bytes.size() - pos) / sizeof(float))
+            throw bad("truncated");
+        IvfQuantizer q;
+        q.dim = b.dim;
+        q.trained_rows = static_cast<std::size_t>(b.trained_rows);
+        q.centroids.resize(static_cast<std::size_t>(floats));
+        std::memcpy(q.centroids.data(), bytes.data() + pos, floats * sizeof(float));
+        pos += floats * sizeof(float);
+        out.push_back(std::move(q));
+    }
+    if (pos != bytes.size()) throw bad("trailing bytes");
+    return out;
+}
+
+void write_speaker_ann(const fs::path& path, const std::vector<IvfQuantizer>& quantizers) {
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = SPEAKER_ANN_VERSION;
+    h.byte_order = kByteOrder;
+    h.count = quantizers.size();
+
+    // Readers write this file too (it is a cache), so the temporary name
+    // must not collide between processes.
+    const fs::path tmp = path.string() + ".tmp." + std::to_string(::getpid());
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) throw RecmeetError("Cannot write speaker ANN index: " + tmp.string());
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        for (const auto& q : quantizers) {
+            const Block b{static_cast<uint32_t>(q.dim), static_cast<uint32_t>(q.nlist()),
+                          static_cast<uint64_t>(q.trained_rows)};
+            out.write(reinterpret_cast<const char*>(&b), sizeof(b));
+            out.write(reinterpret_cast<const char*>(q.centroids.data()),
+                      static_cast<std::streamsize>(b.dim * b.nlist * sizeof(float)));
+        }
+        out.flush();
+        if (!out) {
+            std::error_code ec;
+            fs::remove(tmp, ec);
+            throw RecmeetError("Write error: " + tmp.string());
+        }
+    }
+    fs::rename(tmp, path);
+}
+
+// ---------------------------------------------------------------------------
+// SpeakerIvf
+// ---------------------------------------------------------------------------
+
+std::size_t SpeakerIvf::nprobe() const {
+    return std::min(nlist(), std::max<std::size_t>(4, (nlist() + 7) / 8));
+}
+
+void SpeakerIvf::upsert(const std::string& name, const float* raw) {
+    std::vector<float> unit(dim_);
+    if (!normalize(raw, dim_, unit.data())) return;
+
+    std::size_t slot;
+    auto it = slot_of_.find(name);
+    if (it != slot_of_.end()) {
+        slot = it->second;
+        if (trained()) unfile(slot);
+    } else {
+        slot = names_.size();
+        names_.push_back(name);
+        rows_.resize(rows_.size() + dim_);
+        codes_.resize(codes_.size() + dim_);
+        scales_.push_back(0.0f);
+        list_of_.push_back(0);
+        slot_of_[name] = slot;
+    }
+    std::copy(unit.begin(), unit.end(), rows_.begin() + slot * dim_);
+    scales_[slot] = encode(unit.data(), dim_, codes_.data() + slot * dim_);
+    if (trained()) file(slot);
+}
+
+void SpeakerIvf::remove(const std::string& name) {
+    auto it = slot_of_.find(name);
+    if (it == slot_of_.end()) return;
+    if (trained()) unfile(it->second);
+    names_[it->second].clear();
+    slot_of_.erase(it);
+}
+
+std::size_t SpeakerIvf::nearest_list(const float* unit) const {
+    std::size_t best = 0;
+    double best_sim = -2.0;
+    for (std::size_t l = 0; l < nlist(); ++l) {
+        const double sim = dot(unit, centroids_.data() + l * dim_, dim_);
+        if (sim > best_sim) {
+            best_sim = sim;
+            best = l;
+        }
+    }
+    return best;
+}
+
+void SpeakerIvf::nearest_lists(const float* unit, std::size_t n,
+                               std::vector<std::size_t>& out) const {
+    std::vector<std::pair<double, std::size_t>> sims(nlist());
+    for (std::size_t l = 0; l < nlist(); ++l)
+        sims[l] = {dot(unit, centroids_.data() + l * dim_, dim_), l};
+    n = std::min(n, sims.size());
+    std::partial_sort(sims.begin(), sims.begin() + n, sims.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+    out.clear();
+    for (std::size_t i = 0; i < n; ++i) out.push_back(sims[i].second);
+}
+
+void SpeakerIvf::file(std::size_t slot) {
+    const std::size_t l = nearest_list(rows_.data() + slot * dim_);
+    lists_[l].push_back(static_cast<uint32_t>(slot));
+    list_of_[slot] = static_cast<uint32_t>(l);
+}
+
+void SpeakerIvf::unfile(std::size_t slot) {
+    auto& list = lists_[list_of_[slot]];
+    list.erase(std::remove(list.begin(), list.end(), static_cast<uint32_t>(slot)), list.end());
+}
+
+void SpeakerIvf::file_all() {
+    lists_.assign(nlist(), {});
+    for (const auto& [name, slot] : slot_of_) file(slot);
+}
+
+void SpeakerIvf::train() {
+    std::vector<std::size_t> live;
+    live.reserve(slot_of_.size());
+    for (const auto& [name, slot] : slot_of_) live.push_back(slot);
+    if (live.empty()) return;
+
+    const std::size_t n = live.size();
+    const std::size_t k = std::max<std::size_t>(
+        1, std::min(n, static_cast<std::size_t>(std::lround(std::sqrt(double(n))))));
+    // Rows are in name order, which says nothing about the voice, so an
+    // even stride is as good a sample (and seed) as a random one.
+    std::vector<std::size_t> sample;
+    const std::size_t cap = k * kTrainRowsPerList;
+    if (n > cap) {
+        for (std::size_t i = 0; i < cap; ++i) sample.push_back(live[i * n / cap]);
+    } else {
+        sample = live;
+    }
+
+    centroids_.assign(k * dim_, 0.0f);
+    for (std::size_t l = 0; l < k; ++l) {
+        const float* row = rows_.data() + sample[l * sample.size() / k] * dim_;
+        std::copy(row, row + dim_, centroids_.begin() + l * dim_);
+    }
+
+    std::vector<double> sums(k * dim_);
+    std::vector<std::size_t> counts(k);
+    for (int iter = 0; iter < kTrainIterations; ++iter) {
+        std::fill(sums.begin(), sums.end(), 0.0);
+        std::fill(counts.begin(), counts.end(), 0);
+        for (std::size_t slot : sample) {
+            const float* row = rows_.data() + slot * dim_;
+            const std::size_t l = nearest_list(row);
+            for (std::size_t d = 0; d < dim_; ++d) sums[l * dim_ + d] += row[d];
+            ++counts[l];
+        }
+        for (std::size_t l = 0; l < k; ++l) {
+            if (counts[l] == 0) continue;  // an empty list keeps its centroid
+            std::vector<float> mean(dim_);
+            for (std::size_t d = 0; d < dim_; ++d)
+                mean[d] = static_cast<float>(sums[l * dim_ + d]);
+            normalize(mean.data(), dim_, centroids_.data() + l * dim_);
+        }
+    }
+    trained_rows_ = n;
+    file_all();
+}
+
+void SpeakerIvf::set_quantizer(const IvfQuantizer& q) {
+    if (q.dim != dim_ || q.centroids.empty() || q.centroids.size() % dim_ != 0)
+        throw RecmeetError("Speaker ANN quantizer does not fit " + std::to_string(dim_) +
+                           "-dimensional embeddings");
+    centroids_ = q.centroids;
+    trained_rows_ = q.trained_rows;
+    file_all();
+}
+
+IvfQuantizer SpeakerIvf::quantizer() const {
+    IvfQuantizer q;
+    q.dim = dim_;
+    q.trained_rows = trained_rows_;
+    q.centroids = centroids_;
+    return q;
+}
+
+std::vector<SpeakerIvf::Hit> SpeakerIvf::search(const std::vector<float>& query,
+                                                std::size_t k) const {
+    std::vector<Hit> hits;
+    if (!trained() || k == 0 || query.size() != dim_) return hits;
+    std::vector<float> unit(dim_);
+    if (!normalize(query.data(), dim_, unit.data())) return hits;
+    std::vector<int8_t> code(dim_);
+    const float scale = encode(unit.data(), dim_, code.data());
+
+    std::vector<std::size_t> probe;
+    nearest_lists(unit.data(), nprobe(), probe);
+    const auto dot_s8 = sample_kernels().dot_s8;
+    std::vector<std::pair<float, uint32_t>> approx;
+    for (std::size_t l : probe)
+        for (uint32_t slot : lists_[l])
+            approx.push_back({dot_s8(code.data(), codes_.data() + slot * dim_, dim_) *
+                                  scale * scales_[slot], slot});
+
+    // Exact re-scoring of the best approximate candidates.
+    const std::size_t keep = std::min(k, approx.size());
+    std::partial_sort(approx.begin(), approx.begin() + keep, approx.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (std::size_t i = 0; i < keep; ++i) {
+        const uint32_t slot = approx[i].second;
+        hits.push_back({names_[slot],
+                        static_cast<float>(dot(unit.data(), rows_.data() + slot * dim_, dim_))});
+    }
+    std::stable_sort(hits.begin(), hits.end(),
+                     [](const Hit& a, const Hit& b) { return a.score > b.score; });
+    return hits;
+}
+
+} // namespace recmeet
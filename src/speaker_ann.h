@@ -0,0 +1,117 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Approximate voiceprint search (`speaker_id.ann`)
+// ---------------------------------------------------------------------------
+//
+// An inverted-file (IVF) index over L2-normalized embeddings of one size:
+// spherical k-means splits the rows into `nlist` lists, a query scans the
+// lists whose centroids are nearest it using 8-bit codes of the rows, and
+// the best candidates are re-scored exactly from the float rows. Only the
+// exact scores leave the index, so a hit scores what the brute-force
+// search would give it; what the index can do is miss the best row when it
+// sits in a list that was not probed.
+//
+// The trained centroids are persisted next to speakers.bin; the rows are
+// not (they come from the database, and are filed into the lists when
+// loaded).
+
+/// File name of the persisted centroids inside the database directory.
+inline constexpr const char* SPEAKER_ANN_FILE = "speakers.ivf";
+
+/// Current on-disk version of speakers.ivf.
+inline constexpr uint32_t SPEAKER_ANN_VERSION = 1;
+
+/// Below this many rows of one size, brute force is cheaper than probing
+/// and SpeakerIndex does not build an index.
+inline constexpr std::size_t SPEAKER_ANN_MIN_ROWS = 512;
+
+/// Trained coarse quantizer for one embedding size.
+struct IvfQuantizer {
+    std::size_t dim = 0;
+    std::size_t trained_rows = 0;  ///< rows the centroids were trained on
+    std::vector<float> centroids;  ///< nlist rows of dim, L2-normalized
+    std::size_t nlist() const { return dim ? centroids.size() / dim : 0; }
+};
+
+/// Read every quantizer in `path`. Throws RecmeetError if it cannot be
+/// read, or is not a speakers.ivf of this version and byte order.
+std::vector<IvfQuantizer> read_speaker_ann(const fs::path& path);
+
+/// Write `quantizers` to `path`, via a temporary file renamed into place.
+void write_speaker_ann(const fs::path& path, const std::vector<IvfQuantizer>& quantizers);
+
+/// The IVF index over one embedding size, one row per name. Not
+/// thread-safe; SpeakerIndex serializes updates against searches.
+class SpeakerIvf {
+public:
+    explicit SpeakerIvf(std::size_t dim) : dim_(dim) {}
+
+    std::size_t dim() const { return dim_; }
+    /// Rows currently indexed.
+    std::size_t size() const { return slot_of_.size(); }
+    bool trained() const { return !centroids_.empty(); }
+    std::size_t nlist() const { return centroids_.size() / (dim_ ? dim_ : 1); }
+    /// Lists a search scans: an eighth of them, at least 4.
+    std::size_t nprobe() const;
+
+    /// Index `raw` (dim() floats, any norm) under `name`, replacing that
+    /// name's row. A zero vector is ignored.
+    void upsert(const std::string& name, const float* raw);
+    void remove(const std::string& name);
+
+    /// Train the centroids on the current rows (spherical k-means, about
+    /// sqrt(size()) lists, deterministic) and file every row.
+    void train();
+    /// Use centroids trained earlier and file every row. Throws
+    /// RecmeetError when `q` is for another size or has no centroids.
+    void set_quantizer(const IvfQuantizer& q);
+    IvfQuantizer quantizer() const;
+    /// Rows the current centroids were trained on (0 before training).
+    std::size_t trained_rows() const { return trained_rows_; }
+
+    struct Hit {
+        std::string name;
+        float score = 0.0f;  ///< exact cosine similarity with the query
+    };
+
+    /// The up to `k` best rows for `query` (dim() floats, any norm) among
+    /// the nprobe() nearest lists, in descending exact score. Empty before
+    /// training or for a query of another size.
+    std::vector<Hit> search(const std::vector<float>& query, std::size_t k) const;
+
+private:
+    std::size_t nearest_list(const float* unit) const;
+    void nearest_lists(const float* unit, std::size_t n, std::vector<std::size_t>& out) const;
+    void file_all();
+    void file(std::size_t slot);
+    void unfile(std::size_t slot);
+
+    std::size_t dim_;
+    std::size_t trained_rows_ = 0;
+    std::vector<float> centroids_;              ///< nlist x dim, unit rows
+    std::vector<std::vector<uint32_t>> lists_;  ///< slots per list
+
+    // Row storage by slot; a removed row leaves its slot dead.
+    std::vector<std::string> names_;
+    std::vector<float> rows_;     ///< slots x dim, unit rows
+    std::vector<int8_t> codes_;   ///< slots x dim, rows_ * 127 / max|row|
+    std::vector<float> scales_;   ///< per slot: code -> row factor
+    std::vector<uint32_t> list_of_;  ///< per slot, valid once filed
+    std::map<std::string, std::size_t> slot_of_;
+};
+
+} // namespace recmeet
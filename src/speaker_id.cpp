@@ -3,12 +3,29 @@
 
 #include "speaker_id.h"
 #include "log.h"
+#include "model_cache.h"
+#include "onnx_provider.h"
+#include "speaker_ann.h"
+#include "speaker_store.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
 #include <chrono>
 #include <cstdio>
+#include <cstring>
+#include <exception>
 #include <fstream>
+#include <iomanip>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #if RECMEET_USE_SHERPA
 #include <sherpa-onnx/c-api/c-api.h>
@@ -46,20 +63,55 @@ static std::string escape_json(const std::string& s) {
     return out;
 }
 
-static std::string serialize_profile(const SpeakerProfile& p) {
+// "embedding_f16" / "embeddings_int8" and so on: the JSON key of an
+// embedding (or, with `plural`, a list of them) stored at `p`.
+static std::string embedding_key(EmbeddingPrecision p, bool plural) {
+    std::string key = plural ? "embeddings" : "embedding";
+    if (p != EmbeddingPrecision::F32) key += std::string("_") + embedding_precision_name(p);
+    return key;
+}
+
+// The base64 strings of the array following `key` in `json`, decoded.
+static std::vector<std::vector<float>> parse_encoded_list(const std::string& json,
+                                                          const std::string& key,
+                                                          EmbeddingPrecision p) {
+    std::vector<std::vector<float>> out;
+    auto pos = json.find("\"" + key + "\":");
+    if (pos == std::string::npos) return out;
+    auto start = json.find('[', pos);
+    auto end = start == std::string::npos ? start : json.find(']', start);
+    if (end == std::string::npos) return out;
+    for (pos = json.find('"', start); pos < end; pos = json.find('"', pos + 1)) {
+        auto close = json.find('"', pos + 1);
+        if (close == std::string::npos || close > end) break;
+        std::vector<float> emb;
+        if (decode_embedding(json.substr(pos + 1, close - pos - 1), p, emb) && !emb.empty())
+            out.push_back(std::move(emb));
+        pos = close;
+    }
+    return out;
+}
+
+static std::string serialize_profile(const SpeakerProfile& p,
+                                     EmbeddingPrecision precision = EmbeddingPrecision::F32) {
     std::ostringstream out;
+    out << std::setprecision(9);  // float32 round-trips exactly
     out << "{\n";
     out << "  \"name\": \"" << escape_json(p.name) << "\",\n";
     out << "  \"created\": \"" << escape_json(p.created) << "\",\n";
     out << "  \"updated\": \"" << escape_json(p.updated) << "\",\n";
-    out << "  \"embeddings\": [\n";
+    out << "  \"" << embedding_key(precision, true) << "\": [\n";
     for (size_t i = 0; i < p.embeddings.size(); ++i) {
-        out << "    [";
-        for (size_t j = 0; j < p.embeddings[i].size(); ++j) {
-            if (j > 0) out << ", ";
-            out << p.embeddings[i][j];
+        if (precision != EmbeddingPrecision::F32) {
+            out << "    \"" << encode_embedding(p.embeddings[i], precision) << "\"";
+        } else {
+            out << "    [";
+            for (size_t j = 0; j < p.embeddings[i].size(); ++j) {
+                if (j > 0) out << ", ";
+                out << p.embeddings[i][j];
+            }
+            out << "]";
         }
-        out << "]";
         if (i + 1 < p.embeddings.size()) out << ",";
         out << "\n";
     }
@@ -87,6 +139,13 @@ static bool parse_profile(const std::string& json, SpeakerProfile& out) {
 
     if (out.name.empty()) return false;
 
+    for (auto p : {EmbeddingPrecision::F16, EmbeddingPrecision::Int8}) {
+        if (json.find("\"" + embedding_key(p, true) + "\":") != std::string::npos) {
+            out.embeddings = parse_encoded_list(json, embedding_key(p, true), p);
+            return true;
+        }
+    }
+
     // Parse embeddings array: find "embeddings": [ then parse nested arrays
     auto emb_pos = json.find("\"embeddings\":");
     if (emb_pos == std::string::npos) return false;
@@ -135,75 +194,262 @@ fs::path default_speaker_db_dir() {
     return data_dir() / "speakers";
 }
 
-std::vector<SpeakerProfile> load_speaker_db(const fs::path& db_dir) {
-    std::vector<SpeakerProfile> profiles;
-    if (!fs::is_directory(db_dir)) return profiles;
+namespace {
 
-    for (const auto& entry : fs::directory_iterator(db_dir)) {
-        if (entry.path().extension() != ".json") continue;
+fs::path store_path(const fs::path& db_dir) {
+    return db_dir / SPEAKER_STORE_FILE;
+}
 
-        std::ifstream in(entry.path());
-        if (!in) continue;
+// Serializes writers of one database (CLI, daemon, recmeet-web) across
+// processes. Readers need no lock: speakers.bin is replaced by rename.
+class DbLock {
+public:
+    explicit DbLock(const fs::path& db_dir) {
+        const fs::path path = db_dir / ".speakers.lock";
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ < 0)
+            throw RecmeetError("Cannot lock speaker database: " + path.string() +
+                               " (" + std::strerror(errno) + ")");
+        while (::flock(fd_, LOCK_EX) < 0 && errno == EINTR) {}
+    }
+    ~DbLock() { ::close(fd_); }
+    DbLock(const DbLock&) = delete;
+    DbLock& operator=(const DbLock&) = delete;
+
+private:
+    int fd_ = -1;
+};
+
+std::vector<fs::path> json_profile_files(const fs::path& db_dir) {
+    std::vector<fs::path> files;
+    if (!fs::is_directory(db_dir)) return files;
+    for (const auto& entry : fs::directory_iterator(db_dir))
+        if (entry.path().extension() == ".json" && entry.is_regular_file())
+            files.push_back(entry.path());
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+// speakers.bin's profiles, or none when it does not exist yet.
+std::vector<SpeakerProfile> read_store(const fs::path& db_dir) {
+    if (!fs::exists(store_path(db_dir))) return {};
+    return SpeakerStore(store_path(db_dir)).profiles();
+}
 
+// Fold the <Name>.json profiles of the pre-speakers.bin layout (or
+// dropped in by hand) into `profiles`; a file replaces a stored profile of
+// the same name. Returns the files that parsed, for the caller to retire.
+std::vector<fs::path> merge_json_profiles(const fs::path& db_dir,
+                                          std::vector<SpeakerProfile>& profiles) {
+    std::vector<fs::path> imported;
+    for (const auto& path : json_profile_files(db_dir)) {
+        std::ifstream in(path);
+        if (!in) continue;
         std::ostringstream buf;
         buf << in.rdbuf();
 
         SpeakerProfile profile;
-        if (parse_profile(buf.str(), profile) && !profile.embeddings.empty())
-            profiles.push_back(std::move(profile));
+        if (!parse_profile(buf.str(), profile) || profile.embeddings.empty()) continue;
+        const size_t dim = profile.embeddings.front().size();
+        auto& embs = profile.embeddings;
+        const size_t before = embs.size();
+        embs.erase(std::remove_if(embs.begin(), embs.end(),
+                                  [&](const std::vector<float>& e) { return e.size() != dim; }),
+                   embs.end());
+        if (embs.size() != before)
+            log_warn("Speaker '%s': dropped %zu embedding(s) of another size",
+                     profile.name.c_str(), before - embs.size());
+
+        auto it = std::find_if(profiles.begin(), profiles.end(),
+                               [&](const SpeakerProfile& p) { return p.name == profile.name; });
+        if (it != profiles.end()) *it = std::move(profile);
+        else profiles.push_back(std::move(profile));
+        imported.push_back(path);
     }
+    return imported;
+}
 
+// The current database, with any JSON profiles migrated into speakers.bin
+// and moved to imported/. Call under DbLock.
+std::vector<SpeakerProfile> load_for_update(const fs::path& db_dir) {
+    auto profiles = read_store(db_dir);
+    const auto imported = merge_json_profiles(db_dir, profiles);
+    if (imported.empty()) return profiles;
+
+    write_speaker_store(store_path(db_dir), profiles);
+    const fs::path done = db_dir / "imported";
+    fs::create_directories(done);
+    for (const auto& path : imported)
+        fs::rename(path, done / path.filename());
+    log_info("Speaker database: imported %zu JSON profile(s) into %s",
+             imported.size(), store_path(db_dir).c_str());
+    return profiles;
+}
+
+void write_profiles(const fs::path& db_dir, const std::vector<SpeakerProfile>& profiles) {
+    if (profiles.empty()) {
+        fs::remove(store_path(db_dir));
+        return;
+    }
+    write_speaker_store(store_path(db_dir), profiles);
+}
+
+// Identity of speakers.bin as last seen. Writers replace it by rename, so
+// a new file always differs in inode or mtime.
+struct StoreStamp {
+    bool exists = false;
+    dev_t dev = 0;
+    ino_t ino = 0;
+    int64_t mtime_ns = 0;
+    off_t size = 0;
+
+    bool operator==(const StoreStamp& o) const {
+        return exists == o.exists && dev == o.dev && ino == o.ino &&
+               mtime_ns == o.mtime_ns && size == o.size;
+    }
+};
+
+StoreStamp store_stamp(const fs::path& db_dir) {
+    StoreStamp stamp;
+    struct stat st{};
+    if (::stat(store_path(db_dir).c_str(), &st) != 0) return stamp;
+    stamp.exists = true;
+    stamp.dev = st.st_dev;
+    stamp.ino = st.st_ino;
+    stamp.mtime_ns = int64_t(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    stamp.size = st.st_size;
+    return stamp;
+}
+
+#if RECMEET_USE_SHERPA
+struct CachedIndex {
+    StoreStamp stamp;
+    bool ann = false;
+    std::shared_ptr<SpeakerIndex> index;
+};
+std::mutex g_index_mu;
+std::map<std::string, CachedIndex> g_indexes;  // by db_dir
+#endif
+
+// After a write under DbLock: apply `update` to the cached SpeakerIndex of
+// `db_dir` if it matched speakers.bin as of `before`, and take the new
+// stamp. An index that was already behind stays behind and is reloaded by
+// the next acquire_speaker_index().
+template <class Update>
+void update_cached_index(const fs::path& db_dir, const StoreStamp& before, Update&& update) {
+#if RECMEET_USE_SHERPA
+    std::lock_guard<std::mutex> lock(g_index_mu);
+    auto it = g_indexes.find(db_dir.string());
+    if (it == g_indexes.end() || !(it->second.stamp == before)) return;
+    update(*it->second.index);
+    it->second.stamp = store_stamp(db_dir);
+#else
+    (void)db_dir;
+    (void)before;
+    (void)update;
+#endif
+}
+
+} // anonymous namespace
+
+std::vector<SpeakerProfile> load_speaker_db(const fs::path& db_dir) {
+    if (!fs::is_directory(db_dir)) return {};
+
+    if (!json_profile_files(db_dir).empty()) {
+        try {
+            DbLock lock(db_dir);
+            return load_for_update(db_dir);
+        } catch (const std::exception& e) {
+            // Read-only or damaged database: serve what can be read.
+            log_warn("Speaker database not migrated: %s", e.what());
+        }
+    }
+
+    std::vector<SpeakerProfile> profiles;
+    try {
+        profiles = read_store(db_dir);
+    } catch (const RecmeetError& e) {
+        log_warn("%s", e.what());
+    }
+    merge_json_profiles(db_dir, profiles);
     return profiles;
 }
 
 void save_speaker(const fs::path& db_dir, const SpeakerProfile& profile) {
     fs::create_directories(db_dir);
-    fs::path path = db_dir / (profile.name + ".json");
-    std::ofstream out(path);
-    if (!out)
-        throw RecmeetError("Cannot write speaker profile: " + path.string());
-    out << serialize_profile(profile);
+    DbLock lock(db_dir);
+    auto profiles = load_for_update(db_dir);
+    auto it = std::find_if(profiles.begin(), profiles.end(),
+                           [&](const SpeakerProfile& p) { return p.name == profile.name; });
+    if (it != profiles.end()) *it = profile;
+    else profiles.push_back(profile);
+    const StoreStamp before = store_stamp(db_dir);
+    write_profiles(db_dir, profiles);
+    update_cached_index(db_dir, before, [&](auto& index) { index.upsert(profile); });
 }
 
 bool remove_speaker(const fs::path& db_dir, const std::string& name) {
-    fs::path path = db_dir / (name + ".json");
-    return fs::remove(path);
+    if (!fs::is_directory(db_dir)) return false;
+    DbLock lock(db_dir);
+    auto profiles = load_for_update(db_dir);
+    auto it = std::find_if(profiles.begin(), profiles.end(),
+                           [&](const SpeakerProfile& p) { return p.name == name; });
+    if (it == profiles.end()) return false;
+    profiles.erase(it);
+    const StoreStamp before = store_stamp(db_dir);
+    write_profiles(db_dir, profiles);
+    update_cached_index(db_dir, before, [&](auto& index) { index.remove(name); });
+    return true;
 }
 
 int reset_speakers(const fs::path& db_dir) {
     if (!fs::is_directory(db_dir)) return 0;
-    int count = 0;
-    for (const auto& entry : fs::directory_iterator(db_dir)) {
-        if (entry.path().extension() == ".json") {
-            fs::remove(entry.path());
-            ++count;
-        }
-    }
-    return count;
+    DbLock lock(db_dir);
+    const auto profiles = load_for_update(db_dir);
+    const StoreStamp before = store_stamp(db_dir);
+    write_profiles(db_dir, {});
+    update_cached_index(db_dir, before, [](auto& index) { index.clear(); });
+    return static_cast<int>(profiles.size());
 }
 
 std::vector<std::string> list_speakers(const fs::path& db_dir) {
     std::vector<std::string> names;
     if (!fs::is_directory(db_dir)) return names;
 
-    for (const auto& entry : fs::directory_iterator(db_dir)) {
-        if (entry.path().extension() != ".json") continue;
-        names.push_back(entry.path().stem().string());
+    if (json_profile_files(db_dir).empty() && fs::exists(store_path(db_dir))) {
+        // Names only: nothing of the embedding matrix is touched.
+        try {
+            SpeakerStore store(store_path(db_dir));
+            for (size_t i = 0; i < store.size(); ++i) names.push_back(store.name(i));
+            return names;
+        } catch (const RecmeetError& e) {
+            log_warn("%s", e.what());
+            return names;
+        }
     }
+    for (const auto& p : load_speaker_db(db_dir)) names.push_back(p.name);
     std::sort(names.begin(), names.end());
     return names;
 }
 
+int export_speaker_json(const fs::path& db_dir, const fs::path& out_dir,
+                        EmbeddingPrecision precision) {
+    const auto profiles = load_speaker_db(db_dir);
+    fs::create_directories(out_dir);
+    for (const auto& p : profiles)
+        write_text_file(out_dir / (p.name + ".json"), serialize_profile(p, precision));
+    return static_cast<int>(profiles.size());
+}
+
 bool remove_embedding(const fs::path& db_dir, const std::string& name,
                       const std::vector<float>& embedding, float epsilon) {
-    if (embedding.empty()) return false;
+    if (embedding.empty() || !fs::is_directory(db_dir)) return false;
 
-    auto profiles = load_speaker_db(db_dir);
-    SpeakerProfile* found = nullptr;
-    for (auto& p : profiles) {
-        if (p.name == name) { found = &p; break; }
-    }
-    if (!found) return false;
+    DbLock lock(db_dir);
+    auto profiles = load_for_update(db_dir);
+    auto found = std::find_if(profiles.begin(), profiles.end(),
+                              [&](const SpeakerProfile& p) { return p.name == name; });
+    if (found == profiles.end()) return false;
 
     // Find embedding by L2 distance
     float threshold = epsilon * epsilon * static_cast<float>(embedding.size());
@@ -221,18 +467,24 @@ bool remove_embedding(const fs::path& db_dir, const std::string& name,
 
     found->embeddings.erase(it);
 
+    const StoreStamp before = store_stamp(db_dir);
     if (found->embeddings.empty()) {
-        remove_speaker(db_dir, name);
+        profiles.erase(found);
+        write_profiles(db_dir, profiles);
+        update_cached_index(db_dir, before, [&](auto& index) { index.remove(name); });
     } else {
         found->updated = iso_now();
-        save_speaker(db_dir, *found);
+        const SpeakerProfile changed = *found;
+        write_profiles(db_dir, profiles);
+        update_cached_index(db_dir, before, [&](auto& index) { index.upsert(changed); });
     }
     return true;
 }
 
 bool relabel_meeting_speaker(const fs::path& meeting_dir, int cluster_id,
                              const std::string& new_label, float confidence) {
-    auto speakers = load_meeting_speakers(meeting_dir);
+    EmbeddingPrecision precision;
+    auto speakers = load_meeting_speakers(meeting_dir, &precision);
     if (speakers.empty()) return false;
 
     bool found = false;
@@ -247,7 +499,8 @@ bool relabel_meeting_speaker(const fs::path& meeting_dir, int cluster_id,
     }
     if (!found) return false;
 
-    save_meeting_speakers(meeting_dir, speakers, derive_meeting_timestamp(meeting_dir));
+    save_meeting_speakers(meeting_dir, speakers, derive_meeting_timestamp(meeting_dir),
+                          precision);
     return true;
 }
 
@@ -255,7 +508,8 @@ bool relabel_meeting_speaker(const fs::path& meeting_dir, int cluster_id,
 // Per-meeting speaker data (speakers.json)
 // ---------------------------------------------------------------------------
 
-static std::string serialize_meeting_speakers(const std::vector<MeetingSpeaker>& speakers) {
+static std::string serialize_meeting_speakers(const std::vector<MeetingSpeaker>& speakers,
+                                              EmbeddingPrecision precision) {
     std::ostringstream out;
     out << "{\n  \"speakers\": [\n";
     for (size_t i = 0; i < speakers.size(); ++i) {
@@ -266,12 +520,17 @@ static std::string serialize_meeting_speakers(const std::vector<MeetingSpeaker>&
         out << "      \"identified\": " << (s.identified ? "true" : "false") << ",\n";
         out << "      \"duration_sec\": " << s.duration_sec << ",\n";
         out << "      \"confidence\": " << s.confidence << ",\n";
-        out << "      \"embedding\": [";
-        for (size_t j = 0; j < s.embedding.size(); ++j) {
-            if (j > 0) out << ", ";
-            out << s.embedding[j];
+        if (precision != EmbeddingPrecision::F32 && !s.embedding.empty()) {
+            out << "      \"" << embedding_key(precision, false) << "\": \""
+                << encode_embedding(s.embedding, precision) << "\"\n    }";
+        } else {
+            out << "      \"embedding\": [";
+            for (size_t j = 0; j < s.embedding.size(); ++j) {
+                if (j > 0) out << ", ";
+                out << s.embedding[j];
+            }
+            out << "]\n    }";
         }
-        out << "]\n    }";
         if (i + 1 < speakers.size()) out << ",";
         out << "\n";
     }
@@ -279,8 +538,10 @@ static std::string serialize_meeting_speakers(const std::vector<MeetingSpeaker>&
     return out.str();
 }
 
-static bool parse_meeting_speakers(const std::string& json, std::vector<MeetingSpeaker>& out) {
+static bool parse_meeting_speakers(const std::string& json, std::vector<MeetingSpeaker>& out,
+                                   EmbeddingPrecision& precision) {
     out.clear();
+    precision = EmbeddingPrecision::F32;
 
     // Find "speakers": [ array
     auto arr_pos = json.find("\"speakers\":");
@@ -377,6 +638,16 @@ static bool parse_meeting_speakers(const std::string& json, std::vector<MeetingS
                 }
             }
         }
+        for (auto p : {EmbeddingPrecision::F16, EmbeddingPrecision::Int8}) {
+            const std::string needle = "\"" + embedding_key(p, false) + "\": \"";
+            auto enc_pos = obj.find(needle);
+            if (enc_pos == std::string::npos) continue;
+            auto val_start = enc_pos + needle.size();
+            auto val_end = obj.find('"', val_start);
+            if (val_end != std::string::npos &&
+                decode_embedding(obj.substr(val_start, val_end - val_start), p, s.embedding))
+                precision = p;
+        }
 
         out.push_back(std::move(s));
         pos = obj_end + 1;
@@ -387,7 +658,8 @@ static bool parse_meeting_speakers(const std::string& json, std::vector<MeetingS
 
 void save_meeting_speakers(const fs::path& meeting_dir,
                            const std::vector<MeetingSpeaker>& speakers,
-                           const std::string& timestamp) {
+                           const std::string& timestamp,
+                           EmbeddingPrecision precision) {
     fs::create_directories(meeting_dir);
     fs::path path = timestamp.empty()
         ? meeting_dir / LEGACY_SPEAKERS_NAME
@@ -395,10 +667,12 @@ void save_meeting_speakers(const fs::path& meeting_dir,
     std::ofstream out(path);
     if (!out)
         throw RecmeetError("Cannot write speakers.json: " + path.string());
-    out << serialize_meeting_speakers(speakers);
+    out << serialize_meeting_speakers(speakers, precision);
 }
 
-std::vector<MeetingSpeaker> load_meeting_speakers(const fs::path& meeting_dir) {
+std::vector<MeetingSpeaker> load_meeting_speakers(const fs::path& meeting_dir,
+                                                  EmbeddingPrecision* precision) {
+    if (precision) *precision = EmbeddingPrecision::F32;
     fs::path path = find_speakers_file(meeting_dir);
     if (path.empty()) return {};
 
@@ -409,10 +683,105 @@ std::vector<MeetingSpeaker> load_meeting_speakers(const fs::path& meeting_dir) {
     buf << in.rdbuf();
 
     std::vector<MeetingSpeaker> speakers;
-    parse_meeting_speakers(buf.str(), speakers);
+    EmbeddingPrecision found;
+    parse_meeting_speakers(buf.str(), speakers, found);
+    if (precision) *precision = found;
     return speakers;
 }
 
+std::vector<DiarizeSegment> select_speaker_segments(const DiarizeResult& diar, int speaker_id,
+                                                    double max_speech_sec) {
+    std::vector<DiarizeSegment> segs;
+    double total = 0.0;
+    for (const auto& seg : diar.segments) {
+        if (seg.speaker != speaker_id || seg.end <= seg.start) continue;
+        segs.push_back(seg);
+        total += seg.end - seg.start;
+    }
+    if (max_speech_sec <= 0.0 || total <= max_speech_sec) return segs;
+
+    std::stable_sort(segs.begin(), segs.end(), [](const DiarizeSegment& a, const DiarizeSegment& b) {
+        return a.end - a.start > b.end - b.start;
+    });
+    std::vector<DiarizeSegment> picked;
+    double left = max_speech_sec;
+    for (auto seg : segs) {
+        if (left <= 0.0) break;
+        seg.end = std::min(seg.end, seg.start + left);
+        left -= seg.end - seg.start;
+        picked.push_back(seg);
+    }
+    std::sort(picked.begin(), picked.end(), [](const DiarizeSegment& a, const DiarizeSegment& b) {
+        return a.start < b.start;
+    });
+    return picked;
+}
+
+namespace {
+
+// Lower case, single spaces, no "(...)" note at the end.
+std::string participant_key(const std::string& name) {
+    std::string s = name;
+    if (!s.empty() && s.back() == ')') {
+        const auto open = s.rfind('(');
+        if (open != std::string::npos) s.erase(open);
+    }
+    std::string out;
+    for (char c : s) {
+        const unsigned char u = static_cast<unsigned char>(c);
+        if (std::isspace(u)) {
+            if (!out.empty() && out.back() != ' ') out.push_back(' ');
+        } else {
+            out.push_back(static_cast<char>(std::tolower(u)));
+        }
+    }
+    if (!out.empty() && out.back() == ' ') out.pop_back();
+    return out;
+}
+
+std::string first_word(const std::string& key) {
+    return key.substr(0, key.find(' '));
+}
+
+} // anonymous namespace
+
+std::vector<std::string> participant_profile_names(const std::vector<std::string>& participants,
+                                                   const std::vector<std::string>& enrolled) {
+    std::vector<std::string> keys;
+    keys.reserve(enrolled.size());
+    for (const auto& name : enrolled) keys.push_back(participant_key(name));
+
+    std::vector<std::string> out;
+    auto take = [&](size_t i) {
+        if (std::find(out.begin(), out.end(), enrolled[i]) == out.end())
+            out.push_back(enrolled[i]);
+    };
+    for (const auto& participant : participants) {
+        const std::string key = participant_key(participant);
+        if (key.empty()) continue;
+        auto exact = std::find(keys.begin(), keys.end(), key);
+        if (exact != keys.end()) {
+            take(static_cast<size_t>(exact - keys.begin()));
+            continue;
+        }
+        // "Alice" -> "Alice Smith", or "Alice Smith" -> "Alice": one candidate only.
+        const bool one_word = key.find(' ') == std::string::npos;
+        size_t found = keys.size();
+        int hits = 0;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            const bool enrolled_one_word = keys[i].find(' ') == std::string::npos;
+            const bool fits = one_word ? first_word(keys[i]) == key
+                                       : enrolled_one_word && first_word(key) == keys[i];
+            if (fits) {
+                found = i;
+                ++hits;
+            }
+        }
+        if (hits == 1) take(found);
+    }
+    return out;
+}
+
 // ---------------------------------------------------------------------------
 // Speaker embedding extraction and identification (sherpa-onnx)
 // ---------------------------------------------------------------------------
@@ -421,16 +790,23 @@ std::vector<MeetingSpeaker> load_meeting_speakers(const fs::path& meeting_dir) {
 
 SpeakerEmbeddingSession::SpeakerEmbeddingSession(const fs::path& model_path, int threads)
     : threads_(threads) {
-    int t = std::min(threads > 0 ? threads : default_thread_count(), 4);
-
-    SherpaOnnxSpeakerEmbeddingExtractorConfig cfg{};
-    cfg.model = model_path.c_str();
-    cfg.num_threads = t;
-    cfg.debug = 0;
-    cfg.provider = "cpu";
-
-    log_debug("SpeakerEmbeddingSession: creating sherpa extractor (threads=%d)", t);
-    extractor_ = SherpaOnnxCreateSpeakerEmbeddingExtractor(&cfg);
+    const int budget = threads > 0 ? threads : default_thread_count();
+    int t = std::min(budget, 4);
+    streams_ = std::max(1, budget / t);
+
+    std::string provider;
+    memory_.begin("speaker embedding", {model_path});
+    extractor_ = static_cast<const SherpaOnnxSpeakerEmbeddingExtractor*>(create_on_onnx_provider(
+        "SpeakerEmbeddingSession", provider, [&](const std::string& p) -> const void* {
+            SherpaOnnxSpeakerEmbeddingExtractorConfig cfg{};
+            cfg.model = model_path.c_str();
+            cfg.num_threads = t;
+            cfg.debug = 0;
+            cfg.provider = p.c_str();
+            log_debug("SpeakerEmbeddingSession: creating sherpa extractor (threads=%d, provider=%s)",
+                      t, p.c_str());
+            return SherpaOnnxCreateSpeakerEmbeddingExtractor(&cfg);
+        }));
     if (!extractor_)
         throw RecmeetError("Failed to create speaker embedding extractor");
 
@@ -440,6 +816,7 @@ SpeakerEmbeddingSession::SpeakerEmbeddingSession(const fs::path& model_path, int
         extractor_ = nullptr;
         throw RecmeetError("Speaker embedding extractor reported non-positive dim");
     }
+    memory_.finish();
 }
 
 SpeakerEmbeddingSession::~SpeakerEmbeddingSession() {
@@ -447,7 +824,8 @@ SpeakerEmbeddingSession::~SpeakerEmbeddingSession() {
 }
 
 SpeakerEmbeddingSession::SpeakerEmbeddingSession(SpeakerEmbeddingSession&& other) noexcept
-    : extractor_(other.extractor_), dim_(other.dim_), threads_(other.threads_) {
+    : extractor_(other.extractor_), dim_(other.dim_), threads_(other.threads_),
+      streams_(other.streams_), memory_(std::move(other.memory_)) {
     other.extractor_ = nullptr;
     other.dim_ = 0;
 }
@@ -458,38 +836,56 @@ SpeakerEmbeddingSession& SpeakerEmbeddingSession::operator=(SpeakerEmbeddingSess
         extractor_ = other.extractor_;
         dim_ = other.dim_;
         threads_ = other.threads_;
+        streams_ = other.streams_;
+        memory_ = std::move(other.memory_);
         other.extractor_ = nullptr;
         other.dim_ = 0;
     }
     return *this;
 }
 
+std::shared_ptr<SpeakerEmbeddingSession> acquire_embedding_session(
+    const fs::path& model_path, int threads) {
+    static ModelSlot<SpeakerEmbeddingSession> slot{"sherpa"};
+    return slot.get(model_path.string() + "#" + std::to_string(threads) + "#" + onnx_provider(), [&] {
+        return std::make_unique<SpeakerEmbeddingSession>(model_path, threads);
+    });
+}
+
 std::vector<float> extract_speaker_embedding(
     SpeakerEmbeddingSession& session,
     const float* samples, size_t num_samples,
     const DiarizeResult& diar, int speaker_id) {
+    return extract_speaker_embedding(session, MemorySampleSource(samples, num_samples),
+                                     diar, speaker_id);
+}
 
-    log_debug("speaker-id: extract_embedding ENTER (samples=%zu)", num_samples);
-    if (!session.handle())
-        throw RecmeetError("extract_speaker_embedding: empty (moved-from) session");
+namespace {
 
+// One stream fed `segs` of `audio` and embedded. Safe to run concurrently
+// on one extractor: sherpa keeps per-call state in the stream and ONNX
+// runtime's Run() is thread-safe.
+std::vector<float> embed_segments(const SpeakerEmbeddingSession& session,
+                                  const SampleSource& audio,
+                                  const std::vector<DiarizeSegment>& segs,
+                                  std::vector<float>& seg_buf) {
     auto* stream = SherpaOnnxSpeakerEmbeddingExtractorCreateStream(session.handle());
     if (!stream)
         throw RecmeetError("Failed to create embedding extractor stream");
 
-    for (const auto& seg : diar.segments) {
-        if (seg.speaker != speaker_id) continue;
-
+    const size_t num_samples = audio.size();
+    for (const auto& seg : segs) {
         auto start_sample = static_cast<size_t>(seg.start * SAMPLE_RATE);
         auto end_sample = static_cast<size_t>(seg.end * SAMPLE_RATE);
         if (start_sample >= num_samples) continue;
         if (end_sample > num_samples) end_sample = num_samples;
+        if (end_sample <= start_sample) continue;
 
-        auto n = static_cast<int32_t>(end_sample - start_sample);
-        if (n > 0) {
+        size_t n = 0;
+        const float* pcm = audio.view(start_sample, end_sample - start_sample, seg_buf, n);
+        if (n > 0)
             SherpaOnnxOnlineStreamAcceptWaveform(stream, SAMPLE_RATE,
-                                                  samples + start_sample, n);
-        }
+                                                  pcm, static_cast<int32_t>(n));
     }
     SherpaOnnxOnlineStreamInputFinished(stream);
 
@@ -505,11 +901,69 @@ std::vector<float> extract_speaker_embedding(
     }
 
     SherpaOnnxDestroyOnlineStream(stream);
-
-    log_debug("speaker-id: extract_embedding EXIT (dims=%d)", static_cast<int>(embedding.size()));
     return embedding;
 }
 
+} // anonymous namespace
+
+std::vector<float> extract_speaker_embedding(
+    SpeakerEmbeddingSession& session,
+    const SampleSource& audio,
+    const DiarizeResult& diar, int speaker_id,
+    double max_speech_sec) {
+
+    log_debug("speaker-id: extract_embedding ENTER (samples=%zu)", audio.size());
+    auto embeddings = extract_speaker_embeddings(
+        session, audio, {select_speaker_segments(diar, speaker_id, max_speech_sec)});
+    log_debug("speaker-id: extract_embedding EXIT (dims=%d)",
+              static_cast<int>(embeddings.front().size()));
+    return std::move(embeddings.front());
+}
+
+std::vector<std::vector<float>> extract_speaker_embeddings(
+    SpeakerEmbeddingSession& session,
+    const SampleSource& audio,
+    const std::vector<std::vector<DiarizeSegment>>& requests,
+    const std::function<void()>& on_request) {
+
+    if (!session.handle())
+        throw RecmeetError("extract_speaker_embedding: empty (moved-from) session");
+
+    std::vector<std::vector<float>> out(requests.size());
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr first_error;
+    std::mutex error_mu;
+
+    auto work = [&] {
+        std::vector<float> seg_buf;
+        while (!failed.load(std::memory_order_relaxed)) {
+            const size_t i = next.fetch_add(1);
+            if (i >= requests.size()) return;
+            try {
+                if (on_request) on_request();
+                out[i] = embed_segments(session, audio, requests[i], seg_buf);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mu);
+                if (!first_error) first_error = std::current_exception();
+                failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    };
+
+    const size_t n = std::min(requests.size(),
+                              static_cast<size_t>(session.parallel_streams()));
+    if (n > 1)
+        log_debug("speaker-id: %zu embeddings, %zu at once", requests.size(), n);
+    std::vector<std::thread> pool;
+    for (size_t w = 1; w < n; ++w) pool.emplace_back(work);
+    work();
+    for (auto& t : pool) t.join();
+    if (first_error) std::rethrow_exception(first_error);
+    return out;
+}
+
 std::vector<float> extract_speaker_embedding(
     const float* samples, size_t num_samples,
     const DiarizeResult& diar, int speaker_id,
@@ -518,135 +972,341 @@ std::vector<float> extract_speaker_embedding(
     return extract_speaker_embedding(session, samples, num_samples, diar, speaker_id);
 }
 
-IdentifyResult identify_speakers(
-    const float* samples, size_t num_samples,
-    const DiarizeResult& diar,
-    const std::vector<SpeakerProfile>& db,
-    const fs::path& model_path,
-    float threshold, int threads) {
-
-    IdentifyResult result;
-    if (diar.segments.empty()) return result;
+// ---------------------------------------------------------------------------
+// SpeakerIndex
+// ---------------------------------------------------------------------------
 
-    int t = std::min(threads > 0 ? threads : default_thread_count(), 4);
+namespace {
 
-    // Create embedding extractor
-    SherpaOnnxSpeakerEmbeddingExtractorConfig cfg{};
-    cfg.model = model_path.c_str();
-    cfg.num_threads = t;
-    cfg.debug = 0;
-    cfg.provider = "cpu";
+// Approximate candidates re-scored exactly per ANN search.
+constexpr size_t kAnnRerank = 16;
 
-    const auto* extractor = SherpaOnnxCreateSpeakerEmbeddingExtractor(&cfg);
-    if (!extractor) {
-        log_warn("Failed to create embedding extractor for speaker ID");
-        return result;
-    }
+} // anonymous namespace
 
-    int dim = SherpaOnnxSpeakerEmbeddingExtractorDim(extractor);
+SpeakerIndex::SpeakerIndex(const std::vector<SpeakerProfile>& db) {
+    for (const auto& profile : db) add_locked(profile);
+}
 
-    // Create speaker embedding manager and register enrolled speakers (if any)
-    const SherpaOnnxSpeakerEmbeddingManager* mgr = nullptr;
-    if (!db.empty()) {
-        mgr = SherpaOnnxCreateSpeakerEmbeddingManager(dim);
-        if (!mgr) {
-            SherpaOnnxDestroySpeakerEmbeddingExtractor(extractor);
-            log_warn("Failed to create speaker embedding manager");
-            return result;
+SpeakerIndex::SpeakerIndex(const std::vector<SpeakerProfile>& db, const fs::path& ann_path) {
+    std::map<int, size_t> rows;
+    for (const auto& profile : db) {
+        std::vector<int> seen;
+        for (const auto& emb : profile.embeddings) {
+            const int dim = static_cast<int>(emb.size());
+            if (dim == 0 || std::find(seen.begin(), seen.end(), dim) != seen.end()) continue;
+            seen.push_back(dim);
+            ++rows[dim];
+        }
+    }
+    for (const auto& [dim, count] : rows)
+        if (count >= SPEAKER_ANN_MIN_ROWS) ivfs_.emplace(dim, std::make_unique<SpeakerIvf>(dim));
+    for (const auto& profile : db) add_locked(profile);
+    if (ivfs_.empty()) return;
+
+    std::vector<IvfQuantizer> saved;
+    if (fs::exists(ann_path)) {
+        try {
+            saved = read_speaker_ann(ann_path);
+        } catch (const RecmeetError& e) {
+            log_warn("%s", e.what());
         }
-        log_debug("speaker-id: manager created");
+    }
+    bool trained = false;
+    for (auto& [dim, ivf] : ivfs_) {
+        auto q = std::find_if(saved.begin(), saved.end(), [&](const IvfQuantizer& s) {
+            return s.dim == ivf->dim() && ivf->size() <= 2 * s.trained_rows;
+        });
+        if (q != saved.end()) {
+            ivf->set_quantizer(*q);
+            continue;
+        }
+        log_info("Training speaker ANN index (%zu speakers, %d-dim)...", ivf->size(), dim);
+        ivf->train();
+        trained = true;
+    }
+    if (!trained) return;
+
+    // Keep the quantizers of sizes not indexed here (another model's
+    // enrollments, below the minimum for now).
+    std::vector<IvfQuantizer> out;
+    for (const auto& [dim, ivf] : ivfs_) out.push_back(ivf->quantizer());
+    for (auto& q : saved)
+        if (!ivfs_.count(static_cast<int>(q.dim))) out.push_back(std::move(q));
+    try {
+        write_speaker_ann(ann_path, out);
+    } catch (const std::exception& e) {
+        log_warn("Could not save speaker ANN index: %s", e.what());
+    }
+}
 
-        for (const auto& profile : db) {
-            for (const auto& emb : profile.embeddings) {
-                if (static_cast<int>(emb.size()) == dim) {
-                    SherpaOnnxSpeakerEmbeddingManagerAdd(mgr, profile.name.c_str(),
-                                                          emb.data());
-                }
+SpeakerIndex::~SpeakerIndex() {
+    for (const auto& [dim, mgr] : managers_) SherpaOnnxDestroySpeakerEmbeddingManager(mgr);
+}
+
+void SpeakerIndex::add_locked(const SpeakerProfile& profile) {
+    for (const auto& emb : profile.embeddings) {
+        if (emb.empty()) continue;
+        const int dim = static_cast<int>(emb.size());
+        auto it = managers_.find(dim);
+        if (it == managers_.end()) {
+            const auto* mgr = SherpaOnnxCreateSpeakerEmbeddingManager(dim);
+            if (!mgr) {
+                log_warn("Failed to create speaker embedding manager");
+                continue;
             }
+            it = managers_.emplace(dim, mgr).first;
+        }
+        SherpaOnnxSpeakerEmbeddingManagerAdd(it->second, profile.name.c_str(), emb.data());
+        auto& kept = profiles_[profile.name];
+        kept.name = profile.name;
+        kept.embeddings.push_back(emb);
+        auto& dims = dims_[profile.name];
+        if (std::find(dims.begin(), dims.end(), dim) == dims.end()) {
+            dims.push_back(dim);
+            // The manager keeps the first embedding added under a name, so
+            // that is the one the ANN index scores the profile by.
+            auto ivf = ivfs_.find(dim);
+            if (ivf != ivfs_.end()) ivf->second->upsert(profile.name, emb.data());
         }
     }
+}
 
-    // Collect unique speaker IDs from diarization
-    std::vector<int> speaker_ids;
-    for (const auto& seg : diar.segments) {
-        if (std::find(speaker_ids.begin(), speaker_ids.end(), seg.speaker)
-                == speaker_ids.end())
-            speaker_ids.push_back(seg.speaker);
+void SpeakerIndex::remove_locked(const std::string& name) {
+    auto it = dims_.find(name);
+    if (it == dims_.end()) return;
+    for (int dim : it->second) {
+        SherpaOnnxSpeakerEmbeddingManagerRemove(managers_.at(dim), name.c_str());
+        auto ivf = ivfs_.find(dim);
+        if (ivf != ivfs_.end()) ivf->second->remove(name);
     }
-    log_debug("speaker-id: identify ENTER (clusters=%zu)", speaker_ids.size());
+    dims_.erase(it);
+    profiles_.erase(name);
+}
 
-    // Track candidates for conflict resolution
-    std::vector<std::pair<int, std::string>> candidates;  // {speaker_id, name}
-    std::vector<float> candidate_scores;
-
-    // Extract embedding for each cluster and optionally match
-    for (int sid : speaker_ids) {
-        auto* stream = SherpaOnnxSpeakerEmbeddingExtractorCreateStream(extractor);
-        if (!stream) continue;
-
-        for (const auto& seg : diar.segments) {
-            if (seg.speaker != sid) continue;
-            auto start = static_cast<size_t>(seg.start * SAMPLE_RATE);
-            auto end = static_cast<size_t>(seg.end * SAMPLE_RATE);
-            if (start >= num_samples) continue;
-            if (end > num_samples) end = num_samples;
-            auto n = static_cast<int32_t>(end - start);
-            if (n > 0)
-                SherpaOnnxOnlineStreamAcceptWaveform(stream, SAMPLE_RATE,
-                                                      samples + start, n);
-        }
-        SherpaOnnxOnlineStreamInputFinished(stream);
-
-        if (SherpaOnnxSpeakerEmbeddingExtractorIsReady(extractor, stream)) {
-            const float* emb = SherpaOnnxSpeakerEmbeddingExtractorComputeEmbedding(
-                extractor, stream);
-            if (emb) {
-                // Preserve embedding before destroying the raw pointer
-                result.embeddings[sid] = std::vector<float>(emb, emb + dim);
-                result.scores[sid] = 0.0f;
-
-                // Match against enrolled speakers if DB is available
-                if (mgr) {
-                    const auto* best = SherpaOnnxSpeakerEmbeddingManagerGetBestMatches(
-                        mgr, emb, threshold, 1);
-                    if (best && best->count > 0 && best->matches[0].name) {
-                        candidates.push_back({sid, best->matches[0].name});
-                        candidate_scores.push_back(best->matches[0].score);
-                    }
-                    if (best)
-                        SherpaOnnxSpeakerEmbeddingManagerFreeBestMatches(best);
-                }
+void SpeakerIndex::upsert(const SpeakerProfile& profile) {
+    std::unique_lock<std::shared_mutex> lock(mu_);
+    remove_locked(profile.name);
+    add_locked(profile);
+}
 
-                SherpaOnnxSpeakerEmbeddingExtractorDestroyEmbedding(emb);
-            }
+void SpeakerIndex::remove(const std::string& name) {
+    std::unique_lock<std::shared_mutex> lock(mu_);
+    remove_locked(name);
+}
+
+void SpeakerIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(mu_);
+    for (const auto& [dim, mgr] : managers_) SherpaOnnxDestroySpeakerEmbeddingManager(mgr);
+    managers_.clear();
+    dims_.clear();
+    profiles_.clear();
+    ivfs_.clear();
+}
+
+size_t SpeakerIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mu_);
+    return dims_.size();
+}
+
+SpeakerIndex::Match SpeakerIndex::best_match(const std::vector<float>& embedding,
+                                             float threshold) const {
+    Match match;
+    std::shared_lock<std::shared_mutex> lock(mu_);
+    auto ivf = ivfs_.find(static_cast<int>(embedding.size()));
+    if (ivf != ivfs_.end() && ivf->second->trained()) {
+        const auto hits = ivf->second->search(embedding, kAnnRerank);
+        if (!hits.empty() && hits.front().score >= threshold) {
+            match.name = hits.front().name;
+            match.score = hits.front().score;
         }
+        return match;
+    }
+    auto it = managers_.find(static_cast<int>(embedding.size()));
+    if (it == managers_.end()) return match;
+    const auto* best = SherpaOnnxSpeakerEmbeddingManagerGetBestMatches(
+        it->second, embedding.data(), threshold, 1);
+    if (best && best->count > 0 && best->matches[0].name) {
+        match.name = best->matches[0].name;
+        match.score = best->matches[0].score;
+    }
+    if (best)
+        SherpaOnnxSpeakerEmbeddingManagerFreeBestMatches(best);
+    return match;
+}
 
-        SherpaOnnxDestroyOnlineStream(stream);
+size_t SpeakerIndex::ann_sizes() const {
+    std::shared_lock<std::shared_mutex> lock(mu_);
+    return ivfs_.size();
+}
+
+std::vector<std::string> SpeakerIndex::names() const {
+    std::shared_lock<std::shared_mutex> lock(mu_);
+    std::vector<std::string> out;
+    out.reserve(dims_.size());
+    for (const auto& [name, dims] : dims_) out.push_back(name);
+    return out;
+}
+
+std::unique_ptr<SpeakerIndex> SpeakerIndex::participants(
+    const std::vector<std::string>& participants) const {
+    std::vector<SpeakerProfile> picked;
+    {
+        std::shared_lock<std::shared_mutex> lock(mu_);
+        std::vector<std::string> enrolled;
+        enrolled.reserve(profiles_.size());
+        for (const auto& [name, profile] : profiles_) enrolled.push_back(name);
+        for (const auto& name : participant_profile_names(participants, enrolled))
+            picked.push_back(profiles_.at(name));
+    }
+    return std::make_unique<SpeakerIndex>(picked);
+}
+
+std::shared_ptr<SpeakerIndex> acquire_speaker_index(const fs::path& db_dir, bool ann) {
+    const std::string key = db_dir.string();
+    const bool pending = !json_profile_files(db_dir).empty();
+    // Taken before loading: a write landing in between only costs another
+    // reload on the next call.
+    const StoreStamp stamp = store_stamp(db_dir);
+    if (!pending) {
+        std::lock_guard<std::mutex> lock(g_index_mu);
+        auto it = g_indexes.find(key);
+        if (it != g_indexes.end() && it->second.stamp == stamp && it->second.ann == ann)
+            return it->second.index;
     }
 
-    // Resolve conflicts: if multiple clusters match the same name, pick highest score
+    auto db = load_speaker_db(db_dir);
+    auto index = ann ? std::make_shared<SpeakerIndex>(db, db_dir / SPEAKER_ANN_FILE)
+                     : std::make_shared<SpeakerIndex>(db);
+    log_debug("speaker-id: index loaded (%zu speakers, %zu ANN sizes)",
+              index->size(), index->ann_sizes());
+    // A load that migrated JSON profiles wrote speakers.bin itself; cache
+    // the index once a plain load can vouch for it.
+    if (!pending) {
+        std::lock_guard<std::mutex> lock(g_index_mu);
+        g_indexes[key] = {stamp, ann, index};
+    }
+    return index;
+}
+
+// ---------------------------------------------------------------------------
+// Identification
+// ---------------------------------------------------------------------------
+
+namespace {
+
+// Greedy conflict resolution: by descending score, each name goes to the
+// first cluster that claims it.
+void assign_candidates(const std::vector<std::pair<int, SpeakerIndex::Match>>& candidates,
+                       IdentifyResult& result) {
     std::vector<size_t> order(candidates.size());
     for (size_t i = 0; i < order.size(); ++i) order[i] = i;
-    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
-        return candidate_scores[a] > candidate_scores[b];
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return candidates[a].second.score > candidates[b].second.score;
     });
 
     std::map<std::string, bool> used_names;
     for (size_t idx : order) {
-        const auto& name = candidates[idx].second;
-        if (used_names.count(name)) continue;
-        int sid = candidates[idx].first;
-        result.names[sid] = name;
-        result.scores[sid] = candidate_scores[idx];
-        used_names[name] = true;
-        log_debug("speaker-id: matched cluster %d -> '%s' (score=%.3f)", sid, name.c_str(), candidate_scores[idx]);
+        const auto& [sid, match] = candidates[idx];
+        if (used_names.count(match.name)) continue;
+        result.names[sid] = match.name;
+        result.scores[sid] = match.score;
+        used_names[match.name] = true;
+        log_debug("speaker-id: matched cluster %d -> '%s' (score=%.3f)",
+                  sid, match.name.c_str(), match.score);
         log_info("Speaker %d identified as '%s' (score: %.3f)",
-                 sid, name.c_str(), candidate_scores[idx]);
+                 sid, match.name.c_str(), match.score);
+    }
+}
+
+// The meeting's participants first; the whole index only for a cluster
+// none of them scores `threshold` against.
+SpeakerIndex::Match match_cluster(const std::vector<float>& embedding, const SpeakerIndex& index,
+                                  const SpeakerIndex* participants, float threshold) {
+    if (participants && !participants->empty()) {
+        auto best = participants->best_match(embedding, threshold);
+        if (!best.name.empty()) return best;
     }
+    return index.best_match(embedding, threshold);
+}
 
-    if (mgr)
-        SherpaOnnxDestroySpeakerEmbeddingManager(mgr);
-    SherpaOnnxDestroySpeakerEmbeddingExtractor(extractor);
+} // anonymous namespace
+
+IdentifyResult identify_speakers(
+    const float* samples, size_t num_samples,
+    const DiarizeResult& diar,
+    const std::vector<SpeakerProfile>& db,
+    const fs::path& model_path,
+    float threshold, int threads) {
+    return identify_speakers(MemorySampleSource(samples, num_samples), diar,
+                             SpeakerIndex(db), model_path, threshold, threads);
+}
+
+IdentifyResult identify_speakers(
+    const SampleSource& audio,
+    const DiarizeResult& diar,
+    const std::vector<SpeakerProfile>& db,
+    const fs::path& model_path,
+    float threshold, int threads) {
+    return identify_speakers(audio, diar, SpeakerIndex(db), model_path, threshold, threads);
+}
+
+IdentifyResult identify_speakers(
+    const SampleSource& audio,
+    const DiarizeResult& diar,
+    const SpeakerIndex& index,
+    const fs::path& model_path,
+    float threshold, int threads,
+    const SpeakerIndex* participants) {
+
+    IdentifyResult result;
+    if (diar.segments.empty()) return result;
+
+    std::shared_ptr<SpeakerEmbeddingSession> session;
+    try {
+        session = acquire_embedding_session(model_path, threads);
+    } catch (const RecmeetError& e) {
+        log_warn("Failed to create embedding extractor for speaker ID: %s", e.what());
+        return result;
+    }
+    const bool match = !index.empty();
+
+    // Collect unique speaker IDs from diarization
+    std::vector<int> speaker_ids;
+    for (const auto& seg : diar.segments) {
+        if (std::find(speaker_ids.begin(), speaker_ids.end(), seg.speaker)
+                == speaker_ids.end())
+            speaker_ids.push_back(seg.speaker);
+    }
+    log_debug("speaker-id: identify ENTER (clusters=%zu)", speaker_ids.size());
+
+    // Extract every cluster's embedding in one batch (segments are pulled
+    // from the source one at a time), then optionally match.
+    std::vector<std::vector<DiarizeSegment>> requests;
+    requests.reserve(speaker_ids.size());
+    for (int sid : speaker_ids) requests.push_back(select_speaker_segments(diar, sid, 0.0));
+    std::vector<std::vector<float>> embeddings;
+    try {
+        embeddings = extract_speaker_embeddings(*session, audio, requests);
+    } catch (const RecmeetError& e) {
+        log_warn("Speaker embedding extraction failed: %s", e.what());
+        return result;
+    }
+
+    std::vector<std::pair<int, SpeakerIndex::Match>> candidates;
+    for (size_t i = 0; i < speaker_ids.size(); ++i) {
+        if (embeddings[i].empty()) continue;
+        const int sid = speaker_ids[i];
+        const auto& kept = result.embeddings[sid] = std::move(embeddings[i]);
+        result.scores[sid] = 0.0f;
+
+        // Match against enrolled speakers if DB is available
+        if (match) {
+            auto best = match_cluster(kept, index, participants, threshold);
+            if (!best.name.empty()) candidates.push_back({sid, std::move(best)});
+        }
+    }
+
+    assign_candidates(candidates, result);
 
     log_debug("speaker-id: identify EXIT (matched=%zu/%zu)", result.names.size(), speaker_ids.size());
     return result;
@@ -656,10 +1316,18 @@ IdentifyResult identify_speakers_with_centroids(
     const std::map<int, std::vector<float>>& centroids,
     const std::vector<SpeakerProfile>& db,
     float threshold) {
+    return identify_speakers_with_centroids(centroids, SpeakerIndex(db), threshold);
+}
+
+IdentifyResult identify_speakers_with_centroids(
+    const std::map<int, std::vector<float>>& centroids,
+    const SpeakerIndex& index,
+    float threshold,
+    const SpeakerIndex* participants) {
 
     IdentifyResult result;
     log_debug("speaker-id: identify_with_centroids ENTER (clusters=%zu, db=%zu)",
-              centroids.size(), db.size());
+              centroids.size(), index.size());
 
     // Derive embedding dimension from the first non-empty centroid (mirrors
     // re_identify_meeting's pattern). If all centroids are empty, return an
@@ -685,72 +1353,22 @@ IdentifyResult identify_speakers_with_centroids(
     }
 
     // No DB → nothing to match against; return centroids-only result.
-    if (db.empty()) {
+    if (index.empty()) {
         log_debug("speaker-id: identify_with_centroids EXIT (empty db, %zu centroids preserved)",
                   result.embeddings.size());
         return result;
     }
 
-    // Build manager sized to dim and register all DB profiles whose embedding
-    // size matches.
-    const auto* mgr = SherpaOnnxCreateSpeakerEmbeddingManager(dim);
-    if (!mgr) {
-        log_warn("Failed to create speaker embedding manager");
-        return result;
-    }
-    for (const auto& profile : db) {
-        for (const auto& emb : profile.embeddings) {
-            if (static_cast<int>(emb.size()) == dim) {
-                SherpaOnnxSpeakerEmbeddingManagerAdd(mgr, profile.name.c_str(),
-                                                     emb.data());
-            }
-        }
-    }
-
-    // For each centroid, query best match. Mirrors lines 597-620 of
-    // identify_speakers — manager normalizes both stored and query vectors
-    // internally so raw centroids are correct here.
-    std::vector<std::pair<int, std::string>> candidates;  // {cluster_id, name}
-    std::vector<float> candidate_scores;
-
-    for (const auto& kv : centroids) {
-        int cid = kv.first;
-        const auto& emb = kv.second;
+    // For each centroid, query best match. The manager normalizes both
+    // stored and query vectors internally so raw centroids are correct here.
+    std::vector<std::pair<int, SpeakerIndex::Match>> candidates;
+    for (const auto& [cid, emb] : centroids) {
         if (static_cast<int>(emb.size()) != dim) continue;
-
-        const auto* best = SherpaOnnxSpeakerEmbeddingManagerGetBestMatches(
-            mgr, emb.data(), threshold, 1);
-        if (best && best->count > 0 && best->matches[0].name) {
-            candidates.push_back({cid, best->matches[0].name});
-            candidate_scores.push_back(best->matches[0].score);
-        }
-        if (best)
-            SherpaOnnxSpeakerEmbeddingManagerFreeBestMatches(best);
-    }
-
-    // Conflict resolution — sort candidates by score desc, greedy-assign,
-    // skip names already taken. Mirrors lines 624-642 of identify_speakers.
-    std::vector<size_t> order(candidates.size());
-    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
-    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
-        return candidate_scores[a] > candidate_scores[b];
-    });
-
-    std::map<std::string, bool> used_names;
-    for (size_t idx : order) {
-        const auto& name = candidates[idx].second;
-        if (used_names.count(name)) continue;
-        int cid = candidates[idx].first;
-        result.names[cid] = name;
-        result.scores[cid] = candidate_scores[idx];
-        used_names[name] = true;
-        log_debug("speaker-id: matched cluster %d -> '%s' (score=%.3f)",
-                  cid, name.c_str(), candidate_scores[idx]);
-        log_info("Speaker %d identified as '%s' (score: %.3f)",
-                 cid, name.c_str(), candidate_scores[idx]);
+        auto best = match_cluster(emb, index, participants, threshold);
+        if (!best.name.empty()) candidates.push_back({cid, std::move(best)});
     }
 
-    SherpaOnnxDestroySpeakerEmbeddingManager(mgr);
+    assign_candidates(candidates, result);
 
     log_debug("speaker-id: identify_with_centroids EXIT (matched=%zu/%zu)",
               result.names.size(), centroids.size());
@@ -761,9 +1379,17 @@ std::vector<MeetingSpeaker> re_identify_meeting(
     const std::vector<MeetingSpeaker>& speakers,
     const std::vector<SpeakerProfile>& db,
     float threshold) {
+    if (speakers.empty() || db.empty()) return {};
+    return re_identify_meeting(speakers, SpeakerIndex(db), threshold);
+}
+
+std::vector<MeetingSpeaker> re_identify_meeting(
+    const std::vector<MeetingSpeaker>& speakers,
+    const SpeakerIndex& index,
+    float threshold) {
 
     log_debug("speaker-id: re_identify ENTER");
-    if (speakers.empty() || db.empty()) return {};
+    if (speakers.empty() || index.empty()) return {};
 
     // Infer embedding dimension from first non-empty meeting embedding
     int dim = 0;
@@ -775,17 +1401,6 @@ std::vector<MeetingSpeaker> re_identify_meeting(
     }
     if (dim == 0) return {};
 
-    // Create manager and register DB embeddings
-    const auto* mgr = SherpaOnnxCreateSpeakerEmbeddingManager(dim);
-    if (!mgr) return {};
-
-    for (const auto& profile : db) {
-        for (const auto& emb : profile.embeddings) {
-            if (static_cast<int>(emb.size()) == dim)
-                SherpaOnnxSpeakerEmbeddingManagerAdd(mgr, profile.name.c_str(), emb.data());
-        }
-    }
-
     // Collect candidates: match each non-manual speaker against DB
     struct Candidate {
         size_t index;      // index into speakers
@@ -801,17 +1416,11 @@ std::vector<MeetingSpeaker> re_identify_meeting(
         // Skip speakers with no/mismatched embedding
         if (s.embedding.empty() || static_cast<int>(s.embedding.size()) != dim) continue;
 
-        const auto* best = SherpaOnnxSpeakerEmbeddingManagerGetBestMatches(
-            mgr, s.embedding.data(), threshold, 1);
-        if (best && best->count > 0 && best->matches[0].name) {
-            candidates.push_back({i, best->matches[0].name, best->matches[0].score});
-        }
-        if (best)
-            SherpaOnnxSpeakerEmbeddingManagerFreeBestMatches(best);
+        auto best = index.best_match(s.embedding, threshold);
+        if (!best.name.empty())
+            candidates.push_back({i, std::move(best.name), best.score});
     }
 
-    SherpaOnnxDestroySpeakerEmbeddingManager(mgr);
-
     // Conflict resolution: sort by score descending, assign greedily
     std::sort(candidates.begin(), candidates.end(),
               [](const Candidate& a, const Candidate& b) { return a.score > b.score; });
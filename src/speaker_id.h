@@ -4,13 +4,18 @@
 #pragma once
 
 #include "diarize.h"
+#include "embedding_set.h"
 
+#include <functional>
 #include <map>
+#include <memory>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
 #if RECMEET_USE_SHERPA
 struct SherpaOnnxSpeakerEmbeddingExtractor;
+struct SherpaOnnxSpeakerEmbeddingManager;
 #endif
 
 namespace recmeet {
@@ -23,10 +28,18 @@ struct SpeakerProfile {
     std::string updated;   // ISO 8601
 };
 
-/// Load all speaker profiles from a directory of JSON files.
+// The database is <db_dir>/speakers.bin (speaker_store.h), memory-mapped
+// for reading. <Name>.json profiles found in db_dir (the layout before
+// speakers.bin, or files dropped in by hand) are migrated into it by the
+// next load or change and moved to <db_dir>/imported/; a JSON profile
+// replaces a stored one of the same name. Changes rewrite speakers.bin
+// under an flock() on <db_dir>/.speakers.lock.
+
+/// Load all speaker profiles, in name order.
 std::vector<SpeakerProfile> load_speaker_db(const fs::path& db_dir);
 
-/// Save a speaker profile to <db_dir>/<name>.json.
+/// Add or replace the profile named profile.name. Throws RecmeetError when
+/// it has no embeddings or mixes embedding sizes, or on a write error.
 void save_speaker(const fs::path& db_dir, const SpeakerProfile& profile);
 
 /// Remove a speaker profile from the database.
@@ -35,11 +48,19 @@ bool remove_speaker(const fs::path& db_dir, const std::string& name);
 /// Remove all speaker profiles from the database. Returns count removed.
 int reset_speakers(const fs::path& db_dir);
 
-/// List enrolled speaker names.
+/// List enrolled speaker names, sorted. Reads only the index.
 std::vector<std::string> list_speakers(const fs::path& db_dir);
 
+/// Write every profile to <out_dir>/<Name>.json in the legacy format, for
+/// inspection or for another recmeet's database. Returns the count. At F16
+/// or Int8 the embeddings are written as "embeddings_f16" / "embeddings_int8"
+/// (base64 strings, see encode_embedding()); --import-speakers reads all
+/// three forms.
+int export_speaker_json(const fs::path& db_dir, const fs::path& out_dir,
+                        EmbeddingPrecision precision = EmbeddingPrecision::F32);
+
 /// Remove a specific embedding from a speaker profile by L2 distance match.
-/// Deletes the profile file if no embeddings remain. Returns true if found and removed.
+/// Deletes the profile if no embeddings remain. Returns true if found and removed.
 bool remove_embedding(const fs::path& db_dir, const std::string& name,
                       const std::vector<float>& embedding, float epsilon = 1e-6f);
 
@@ -59,13 +80,19 @@ struct MeetingSpeaker {
 
 /// Save per-meeting speaker data to <meeting_dir>/speakers_<timestamp>.json.
 /// If timestamp is empty, falls back to the legacy filename `speakers.json`
-/// (used by older fixtures and migration paths).
+/// (used by older fixtures and migration paths). Embeddings are written at
+/// `precision`: a decimal "embedding" array at F32, else "embedding_f16" /
+/// "embedding_int8" (speaker_id.embedding_precision).
 void save_meeting_speakers(const fs::path& meeting_dir,
                            const std::vector<MeetingSpeaker>& speakers,
-                           const std::string& timestamp = "");
+                           const std::string& timestamp = "",
+                           EmbeddingPrecision precision = EmbeddingPrecision::F32);
 
-/// Load per-meeting speaker data from <meeting_dir>/speakers.json.
-std::vector<MeetingSpeaker> load_meeting_speakers(const fs::path& meeting_dir);
+/// Load per-meeting speaker data from <meeting_dir>/speakers.json. Any
+/// precision is read; `precision`, when given, receives the one the file was
+/// written at, so a rewrite (relabel, re-identify) keeps it.
+std::vector<MeetingSpeaker> load_meeting_speakers(const fs::path& meeting_dir,
+                                                  EmbeddingPrecision* precision = nullptr);
 
 /// Result of speaker identification with preserved embeddings.
 struct IdentifyResult {
@@ -74,6 +101,26 @@ struct IdentifyResult {
     std::map<int, float> scores;                  // cluster_id → confidence (0.0 if unmatched)
 };
 
+/// Most speech --enroll extracts a voiceprint from; past a minute, more
+/// audio barely moves the embedding.
+inline constexpr double ENROLL_MAX_SPEECH_SEC = 60.0;
+
+/// The segments of `speaker_id` an enrollment reads, in time order: all of
+/// them when they total at most `max_speech_sec` (or it is <= 0), otherwise
+/// the longest ones up to that total, the last cut to fit.
+std::vector<DiarizeSegment> select_speaker_segments(const DiarizeResult& diar, int speaker_id,
+                                                    double max_speech_sec);
+
+/// The enrolled names that a meeting's `participants`
+/// (parse_context_participant_names()) refer to, in participant order and
+/// each once. Names compare ignoring case, runs of spaces and a trailing
+/// "(...)" note. A participant with no equal name can still match by first
+/// name: "Alice" matches the one enrolled "Alice ..." and "Alice Smith"
+/// matches an enrolled "Alice". A short form that fits more than one
+/// enrolled name matches none.
+std::vector<std::string> participant_profile_names(const std::vector<std::string>& participants,
+                                                   const std::vector<std::string>& enrolled);
+
 #if RECMEET_USE_SHERPA
 
 /// RAII wrapper around `SherpaOnnxSpeakerEmbeddingExtractor`. Loads the
@@ -94,6 +141,11 @@ public:
     /// Embedding dimension reported by the loaded model. Cached at ctor.
     int dim() const noexcept { return dim_; }
 
+    /// Embeddings extract_speaker_embeddings() computes at once: the
+    /// session's thread budget over the (at most 4) threads ONNX runtime
+    /// uses per call, so a 16-thread session runs 4 calls side by side.
+    int parallel_streams() const noexcept { return streams_; }
+
     /// Opaque sherpa handle. Returns nullptr after a move-from.
     const SherpaOnnxSpeakerEmbeddingExtractor* handle() const noexcept { return extractor_; }
 
@@ -101,8 +153,89 @@ private:
     const SherpaOnnxSpeakerEmbeddingExtractor* extractor_ = nullptr;
     int dim_ = 0;
     int threads_ = 0;
+    int streams_ = 1;
+    ModelMemory memory_;
 };
 
+class SpeakerIvf;
+
+/// The enrolled speakers registered for matching: one sherpa-onnx
+/// SpeakerEmbeddingManager per embedding size, each profile added with the
+/// embeddings of that size. Every identification path matches against one,
+/// so a caller that keeps it (acquire_speaker_index()) registers the
+/// database once instead of on every call. Thread-safe: matches run
+/// concurrently, updates exclusively.
+class SpeakerIndex {
+public:
+    explicit SpeakerIndex(const std::vector<SpeakerProfile>& db);
+    /// Same, searching every embedding size with at least
+    /// SPEAKER_ANN_MIN_ROWS profiles through an approximate index
+    /// (speaker_ann.h). Each profile is indexed by the embedding its
+    /// manager scores it by, so a match scores the same; the index can only
+    /// miss. Centroids come from `ann_path` when they were trained on at
+    /// least half the current rows, and are written back when any had to be
+    /// trained. Later upserts are filed into the existing lists.
+    SpeakerIndex(const std::vector<SpeakerProfile>& db, const fs::path& ann_path);
+    ~SpeakerIndex();
+
+    SpeakerIndex(const SpeakerIndex&) = delete;
+    SpeakerIndex& operator=(const SpeakerIndex&) = delete;
+
+    /// Register `profile`, replacing the profile of the same name.
+    void upsert(const SpeakerProfile& profile);
+    /// Forget `name`; a no-op when it is not registered.
+    void remove(const std::string& name);
+    void clear();
+
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+
+    struct Match {
+        std::string name;  ///< empty when nothing scored `threshold`
+        float score = 0.0f;
+    };
+
+    /// Best enrolled speaker for `embedding` (raw or normalized; the manager
+    /// normalizes) among those registered with its size. Sizes with an ANN
+    /// index are searched through it instead.
+    Match best_match(const std::vector<float>& embedding, float threshold) const;
+
+    /// Embedding sizes searched through an ANN index.
+    size_t ann_sizes() const;
+
+    /// Registered names, in order.
+    std::vector<std::string> names() const;
+
+    /// An exact index of just the profiles `participants` name
+    /// (participant_profile_names()): the meeting's attendees, to match
+    /// clusters against before the whole database.
+    std::unique_ptr<SpeakerIndex> participants(const std::vector<std::string>& participants) const;
+
+private:
+    void add_locked(const SpeakerProfile& profile);
+    void remove_locked(const std::string& name);
+
+    mutable std::shared_mutex mu_;
+    std::map<int, const SherpaOnnxSpeakerEmbeddingManager*> managers_;  ///< by dim
+    std::map<std::string, std::vector<int>> dims_;  ///< name -> dims it is registered under
+    std::map<std::string, SpeakerProfile> profiles_;  ///< by name, for participants()
+    std::map<int, std::unique_ptr<SpeakerIvf>> ivfs_;  ///< by dim, ANN sizes only
+};
+
+/// The SpeakerIndex of `db_dir`, shared by every caller in the process (the
+/// daemon's postprocessing worker across jobs, each recmeet-web request).
+/// It is rebuilt only when speakers.bin changed on disk since it was
+/// loaded; save_speaker() and the other writers above update it in place.
+/// With `ann` (speaker_id.ann) the index searches large databases through
+/// an approximate index, its centroids kept as SPEAKER_ANN_FILE in `db_dir`.
+std::shared_ptr<SpeakerIndex> acquire_speaker_index(const fs::path& db_dir, bool ann = false);
+
+/// Build a SpeakerEmbeddingSession, or return the one left resident by an
+/// earlier job for the same model, thread count and onnx_provider() when
+/// the model cache is on (model_cache.h).
+std::shared_ptr<SpeakerEmbeddingSession> acquire_embedding_session(
+    const fs::path& model_path, int threads = 0);
+
 /// Extract a speaker embedding from audio segments belonging to a specific
 /// diarization cluster, reusing a pre-built session. Returns the raw
 /// (non-L2-normalized) embedding vector; callers comparing with cosine
@@ -112,6 +245,29 @@ std::vector<float> extract_speaker_embedding(
     const float* samples, size_t num_samples,
     const DiarizeResult& diar, int speaker_id);
 
+/// Same, reading only select_speaker_segments(diar, speaker_id,
+/// max_speech_sec) from `audio`, one segment at a time — with an AudioView,
+/// enrolling from a 3-hour meeting maps and converts a minute of it.
+std::vector<float> extract_speaker_embedding(
+    SpeakerEmbeddingSession& session,
+    const SampleSource& audio,
+    const DiarizeResult& diar, int speaker_id,
+    double max_speech_sec = 0.0);
+
+/// Extract one raw embedding per entry of `requests` — the segments of
+/// `audio` to embed together, e.g. select_speaker_segments() of a cluster —
+/// in request order; an entry that yields no embedding comes back empty.
+/// sherpa embeds one stream per call, so the batch runs as up to
+/// session.parallel_streams() concurrent calls on the session's one model,
+/// each reading its own segments. `on_request`, when set, runs before each
+/// request on the worker taking it (progress; throwing stops the batch and
+/// is rethrown once the workers have joined).
+std::vector<std::vector<float>> extract_speaker_embeddings(
+    SpeakerEmbeddingSession& session,
+    const SampleSource& audio,
+    const std::vector<std::vector<DiarizeSegment>>& requests,
+    const std::function<void()>& on_request = {});
+
 /// Extract a speaker embedding by constructing a one-shot session from the
 /// model path. Preserved for callers that don't need session reuse.
 std::vector<float> extract_speaker_embedding(
@@ -130,6 +286,28 @@ IdentifyResult identify_speakers(
     float threshold = 0.6f,
     int threads = 0);
 
+/// Same, pulling each cluster's segments from `audio` one at a time.
+IdentifyResult identify_speakers(
+    const SampleSource& audio,
+    const DiarizeResult& diar,
+    const std::vector<SpeakerProfile>& db,
+    const fs::path& model_path,
+    float threshold = 0.6f,
+    int threads = 0);
+
+/// Same, against an already-built index. The extractor comes from
+/// acquire_embedding_session(). With `participants`
+/// (SpeakerIndex::participants()), a cluster is matched against it first
+/// and against `index` only when no participant scores `threshold`.
+IdentifyResult identify_speakers(
+    const SampleSource& audio,
+    const DiarizeResult& diar,
+    const SpeakerIndex& index,
+    const fs::path& model_path,
+    float threshold = 0.6f,
+    int threads = 0,
+    const SpeakerIndex* participants = nullptr);
+
 /// Match pre-computed cluster centroids against enrolled speakers without
 /// instantiating an embedding extractor. Bypass entry point for the chunked
 /// diarization pipeline (T2.1), which has already extracted one centroid per
@@ -146,6 +324,12 @@ IdentifyResult identify_speakers_with_centroids(
     const std::vector<SpeakerProfile>& db,
     float threshold = 0.6f);
 
+IdentifyResult identify_speakers_with_centroids(
+    const std::map<int, std::vector<float>>& centroids,
+    const SpeakerIndex& index,
+    float threshold = 0.6f,
+    const SpeakerIndex* participants = nullptr);
+
 /// Re-identify meeting speakers against current DB using saved embeddings.
 /// Speakers with confidence == 1.0 (manually corrected) are preserved.
 /// Returns updated speaker list if anything changed, empty if unchanged.
@@ -153,6 +337,11 @@ std::vector<MeetingSpeaker> re_identify_meeting(
     const std::vector<MeetingSpeaker>& speakers,
     const std::vector<SpeakerProfile>& db,
     float threshold = 0.6f);
+
+std::vector<MeetingSpeaker> re_identify_meeting(
+    const std::vector<MeetingSpeaker>& speakers,
+    const SpeakerIndex& index,
+    float threshold = 0.6f);
 #endif
 
 /// Default speaker database directory.
@@ -0,0 +1,246 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "speaker_store.h"
+#include "speaker_id.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+namespace recmeet {
+
+namespace {
+
+constexpr char kMagic[8] = {'R', 'M', 'S', 'P', 'K', 'D', 'B', '\0'};
+constexpr uint32_t kByteOrder = 0x01020304;
+constexpr std::size_t kFloatAlign = 32;
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t count;
+    uint64_t index_off;
+    uint64_t strings_off;
+    uint64_t strings_len;
+    uint64_t floats_off;
+    uint64_t floats_len;  ///< in floats
+};
+static_assert(sizeof(Header) == 64, "speakers.bin header layout");
+
+bool in_range(uint64_t off, uint64_t len, uint64_t limit) {
+    return off <= limit && len <= limit - off;
+}
+
+} // anonymous namespace
+
+struct SpeakerStore::Entry {
+    uint32_t name_off, name_len;
+    uint32_t created_off, created_len;
+    uint32_t updated_off, updated_len;
+    uint32_t dim;
+    uint32_t count;
+    uint64_t first;  ///< index of the first float of row 0
+};
+
+SpeakerStore::SpeakerStore(const fs::path& path) {
+    static_assert(sizeof(Entry) == 40, "speakers.bin index layout");
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw RecmeetError("Cannot open speaker database: " + path.string() +
+                           " (" + std::strerror(errno) + ")");
+    struct stat st{};
+    if (::fstat(fd, &st) == 0 && st.st_size >= static_cast<off_t>(sizeof(Header))) {
+        map_len_ = static_cast<std::size_t>(st.st_size);
+        map_ = ::mmap(nullptr, map_len_, PROT_READ, MAP_SHARED, fd, 0);
+        if (map_ == MAP_FAILED) {
+            map_ = nullptr;
+            map_len_ = 0;
+        }
+    }
+    ::close(fd);
+
+    auto bad = [&](const char* why) {
+        if (map_) ::munmap(map_, map_len_);
+        map_ = nullptr;
+        return RecmeetError("Invalid speaker database " + path.string() + ": " + why);
+    };
+    if (!map_) throw bad("too short or not mappable");
+
+    const auto* base = static_cast<const uint8_t*>(map_);
+    Header h;
+    std::memcpy(&h, base, sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) throw bad("not a speakers.bin file");
+    if (h.byte_order != kByteOrder) throw bad("written on a host of the other byte order");
+    if (h.version != SPEAKER_STORE_VERSION)
+        throw bad(("unsupported version " + std::to_string(h.version)).c_str());
+
+    const uint64_t len = map_len_;
+    if (h.index_off % alignof(Entry) != 0 || h.count > len / sizeof(Entry) ||
+        !in_range(h.index_off, h.count * sizeof(Entry), len))
+        throw bad("index out of range");
+    if (!in_range(h.strings_off, h.strings_len, len)) throw bad("string table out of range");
+    if (h.floats_off % alignof(float) != 0 || h.floats_len > len / sizeof(float) ||
+        !in_range(h.floats_off, h.floats_len * sizeof(float), len))
+        throw bad("embedding matrix out of range");
+
+    count_ = static_cast<std::size_t>(h.count);
+    index_ = reinterpret_cast<const Entry*>(base + h.index_off);
+    strings_ = reinterpret_cast<const char*>(base + h.strings_off);
+    floats_ = reinterpret_cast<const float*>(base + h.floats_off);
+
+    for (std::size_t i = 0; i < count_; ++i) {
+        const Entry& e = index_[i];
+        if (e.name_len == 0 || !in_range(e.name_off, e.name_len, h.strings_len) ||
+            !in_range(e.created_off, e.created_len, h.strings_len) ||
+            !in_range(e.updated_off, e.updated_len, h.strings_len))
+            throw bad("profile string out of range");
+        if (e.dim == 0 || e.count == 0 ||
+            !in_range(e.first, uint64_t(e.dim) * e.count, h.floats_len))
+            throw bad("profile embeddings out of range");
+        if (i > 0 && !(name(i - 1) < name(i))) throw bad("index not sorted by name");
+    }
+}
+
+SpeakerStore::~SpeakerStore() {
+    if (map_) ::munmap(map_, map_len_);
+}
+
+const SpeakerStore::Entry& SpeakerStore::entry(std::size_t i) const { return index_[i]; }
+
+std::string SpeakerStore::str(uint32_t off, uint32_t len) const {
+    return std::string(strings_ + off, len);
+}
+
+std::string SpeakerStore::name(std::size_t i) const {
+    return str(entry(i).name_off, entry(i).name_len);
+}
+
+std::string SpeakerStore::created(std::size_t i) const {
+    return str(entry(i).created_off, entry(i).created_len);
+}
+
+std::string SpeakerStore::updated(std::size_t i) const {
+    return str(entry(i).updated_off, entry(i).updated_len);
+}
+
+std::size_t SpeakerStore::dim(std::size_t i) const { return entry(i).dim; }
+
+std::size_t SpeakerStore::embedding_count(std::size_t i) const { return entry(i).count; }
+
+const float* SpeakerStore::embedding(std::size_t i, std::size_t j) const {
+    return floats_ + entry(i).first + j * entry(i).dim;
+}
+
+long SpeakerStore::find(const std::string& name) const {
+    std::size_t lo = 0, hi = count_;
+    while (lo < hi) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        const Entry& e = entry(mid);
+        const int c = name.compare(0, std::string::npos, strings_ + e.name_off, e.name_len);
+        if (c == 0) return static_cast<long>(mid);
+        if (c < 0) hi = mid;
+        else lo = mid + 1;
+    }
+    return -1;
+}
+
+SpeakerProfile SpeakerStore::profile(std::size_t i) const {
+    SpeakerProfile p;
+    p.name = name(i);
+    p.created = created(i);
+    p.updated = updated(i);
+    p.embeddings.reserve(embedding_count(i));
+    for (std::size_t j = 0; j < embedding_count(i); ++j) {
+        const float* row = embedding(i, j);
+        p.embeddings.emplace_back(row, row + dim(i));
+    }
+    return p;
+}
+
+std::vector<SpeakerProfile> SpeakerStore::profiles() const {
+    std::vector<SpeakerProfile> out;
+    out.reserve(count_);
+    for (std::size_t i = 0; i < count_; ++i) out.push_back(profile(i));
+    return out;
+}
+
+void write_speaker_store(const fs::path& path, std::vector<SpeakerProfile> profiles) {
+    std::sort(profiles.begin(), profiles.end(),
+              [](const SpeakerProfile& a, const SpeakerProfile& b) { return a.name < b.name; });
+
+    std::vector<SpeakerStore::Entry> index(profiles.size());
+    std::string strings;
+    uint64_t floats_len = 0;
+    auto add_str = [&](const std::string& s, uint32_t& off, uint32_t& len) {
+        off = static_cast<uint32_t>(strings.size());
+        len = static_cast<uint32_t>(s.size());
+        strings += s;
+    };
+    for (std::size_t i = 0; i < profiles.size(); ++i) {
+        const SpeakerProfile& p = profiles[i];
+        if (p.name.empty())
+            throw RecmeetError("Speaker profile without a name");
+        if (i > 0 && p.name == profiles[i - 1].name)
+            throw RecmeetError("Duplicate speaker profile: " + p.name);
+        if (p.embeddings.empty() || p.embeddings.front().empty())
+            throw RecmeetError("Speaker profile has no embeddings: " + p.name);
+        const std::size_t dim = p.embeddings.front().size();
+        for (const auto& e : p.embeddings)
+            if (e.size() != dim)
+                throw RecmeetError("Speaker profile mixes embedding sizes: " + p.name);
+
+        auto& e = index[i];
+        add_str(p.name, e.name_off, e.name_len);
+        add_str(p.created, e.created_off, e.created_len);
+        add_str(p.updated, e.updated_off, e.updated_len);
+        e.dim = static_cast<uint32_t>(dim);
+        e.count = static_cast<uint32_t>(p.embeddings.size());
+        e.first = floats_len;
+        floats_len += uint64_t(dim) * p.embeddings.size();
+    }
+
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = SPEAKER_STORE_VERSION;
+    h.byte_order = kByteOrder;
+    h.count = index.size();
+    h.index_off = sizeof(Header);
+    h.strings_off = h.index_off + index.size() * sizeof(SpeakerStore::Entry);
+    h.strings_len = strings.size();
+    h.floats_off = (h.strings_off + h.strings_len + kFloatAlign - 1) / kFloatAlign * kFloatAlign;
+    h.floats_len = floats_len;
+
+    const fs::path tmp = path.string() + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out)
+            throw RecmeetError("Cannot write speaker database: " + tmp.string());
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(index.data()),
+                  static_cast<std::streamsize>(index.size() * sizeof(SpeakerStore::Entry)));
+        out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+        const std::string pad(h.floats_off - (h.strings_off + h.strings_len), '\0');
+        out.write(pad.data(), static_cast<std::streamsize>(pad.size()));
+        for (const auto& p : profiles)
+            for (const auto& e : p.embeddings)
+                out.write(reinterpret_cast<const char*>(e.data()),
+                          static_cast<std::streamsize>(e.size() * sizeof(float)));
+        out.flush();
+        if (!out) {
+            std::error_code ec;
+            fs::remove(tmp, ec);
+            throw RecmeetError("Write error: " + tmp.string());
+        }
+    }
+    fs::rename(tmp, path);
+}
+
+} // namespace recmeet
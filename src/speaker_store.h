@@ -0,0 +1,88 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+struct SpeakerProfile;
+
+/// File name of the binary speaker database inside the database directory.
+inline constexpr const char* SPEAKER_STORE_FILE = "speakers.bin";
+
+/// Current on-disk version of speakers.bin.
+inline constexpr uint32_t SPEAKER_STORE_VERSION = 1;
+
+/// Read-only, memory-mapped view of a speakers.bin file.
+///
+/// Layout (host byte order, checked against a marker in the header):
+///
+///   header   magic "RMSPKDB\0", version, byte-order marker, profile count,
+///            then the offsets and sizes of the three sections below
+///   index    one entry per profile, sorted by name: name/created/updated
+///            as (offset, length) into the string table, the embedding
+///            dimension and count, and the profile's first float
+///   strings  UTF-8 bytes, not terminated
+///   floats   one contiguous float32 matrix, 32-byte aligned; a profile's
+///            embeddings are `count` consecutive rows of `dim` floats
+///
+/// Every offset is checked against the file size at construction, so the
+/// accessors below never read past the mapping. The view is immutable;
+/// writers replace the file by rename, so an open view keeps the old one.
+class SpeakerStore {
+public:
+    /// Map `path`. Throws RecmeetError if it cannot be opened, or if it is
+    /// not a speakers.bin of this version and byte order.
+    explicit SpeakerStore(const fs::path& path);
+    ~SpeakerStore();
+
+    SpeakerStore(const SpeakerStore&) = delete;
+    SpeakerStore& operator=(const SpeakerStore&) = delete;
+
+    std::size_t size() const { return count_; }
+
+    std::string name(std::size_t i) const;
+    std::string created(std::size_t i) const;
+    std::string updated(std::size_t i) const;
+    std::size_t dim(std::size_t i) const;
+    std::size_t embedding_count(std::size_t i) const;
+    /// Row `j` of profile `i`: dim(i) floats inside the mapping.
+    const float* embedding(std::size_t i, std::size_t j) const;
+
+    /// Index of the profile named `name`, or -1.
+    long find(const std::string& name) const;
+
+    /// Profile `i` copied out of the mapping.
+    SpeakerProfile profile(std::size_t i) const;
+    /// Every profile, in name order.
+    std::vector<SpeakerProfile> profiles() const;
+
+private:
+    friend void write_speaker_store(const fs::path&, std::vector<SpeakerProfile>);
+
+    struct Entry;
+    const Entry& entry(std::size_t i) const;
+    std::string str(uint32_t off, uint32_t len) const;
+
+    void* map_ = nullptr;
+    std::size_t map_len_ = 0;
+    std::size_t count_ = 0;
+    const Entry* index_ = nullptr;
+    const char* strings_ = nullptr;
+    const float* floats_ = nullptr;
+};
+
+/// Write `profiles` to `path` as speakers.bin, via a temporary file renamed
+/// into place. Profiles are stored in name order; each must have at least
+/// one embedding, all of one size. Throws RecmeetError otherwise, or when
+/// the file cannot be written.
+void write_speaker_store(const fs::path& path, std::vector<SpeakerProfile> profiles);
+
+} // namespace recmeet
@@ -0,0 +1,622 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "stage_cache.h"
+#include "ipc_protocol.h"
+#include "log.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace recmeet {
+
+namespace {
+
+constexpr int64_t kStageCacheVersion = 1;
+constexpr const char* STAGE_PREFIX = "stage_";
+constexpr const char* MANIFEST_PREFIX = "manifest_";
+constexpr const char* MANIFEST_STAGE = "manifest";
+
+constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+std::string to_hex(uint64_t h) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(h));
+    return buf;
+}
+
+// Flat-object parse via the IPC parser, as config_from_json() does.
+bool parse_flat_json(const std::string& json, JsonMap& out) {
+    IpcMessage msg;
+    if (!parse_ipc_message("{\"id\":0,\"result\":" + json + "}", msg) ||
+        msg.type != IpcMessageType::Response)
+        return false;
+    out = std::move(msg.response.result);
+    return true;
+}
+
+int64_t to_ms(double seconds) { return static_cast<int64_t>(std::llround(seconds * 1000.0)); }
+
+std::string item_key(const char* item, size_t i, const char* field) {
+    return std::string(item) + std::to_string(i) + "_" + field;
+}
+
+// Exact float round trip as "v,v,..." — one flat string field.
+std::string encode_floats(const std::vector<float>& v) {
+    std::string out;
+    char buf[32];
+    for (size_t i = 0; i < v.size(); ++i) {
+        std::snprintf(buf, sizeof(buf), "%s%.9g", i ? "," : "", v[i]);
+        out += buf;
+    }
+    return out;
+}
+
+bool decode_floats(const std::string& s, std::vector<float>& out) {
+    const char* p = s.c_str();
+    while (*p) {
+        char* end = nullptr;
+        float f = std::strtof(p, &end);
+        if (end == p || (*end != ',' && *end != '\0')) return false;
+        out.push_back(f);
+        p = *end ? end + 1 : end;
+    }
+    return !out.empty();
+}
+
+#if RECMEET_USE_SHERPA
+// Segments as "start,end,speaker" joined by ';', times at full double
+// precision so stitching sees exactly what the chunk produced.
+std::string encode_segments(const DiarizeResult& diar) {
+    std::string out;
+    char buf[96];
+    for (const auto& seg : diar.segments) {
+        std::snprintf(buf, sizeof(buf), "%s%.17g,%.17g,%d",
+                      out.empty() ? "" : ";", seg.start, seg.end, seg.speaker);
+        out += buf;
+    }
+    return out;
+}
+
+bool decode_segments(const std::string& s, DiarizeResult& diar) {
+    const char* p = s.c_str();
+    while (*p) {
+        char* end = nullptr;
+        DiarizeSegment seg{};
+        seg.start = std::strtod(p, &end);
+        if (end == p || *end != ',') return false;
+        p = end + 1;
+        seg.end = std::strtod(p, &end);
+        if (end == p || *end != ',') return false;
+        p = end + 1;
+        seg.speaker = static_cast<int>(std::strtol(p, &end, 10));
+        if (end == p || (*end != ';' && *end != '\0')) return false;
+        p = *end ? end + 1 : end;
+        diar.segments.push_back(seg);
+    }
+    return true;
+}
+#endif
+
+void save_stage(const fs::path& path, const char* stage, const std::string& key, JsonMap m) {
+    m["version"] = kStageCacheVersion;
+    m["stage"] = std::string(stage);
+    m["key"] = key;
+    write_text_file_atomic(path, serialize_json_map(m) + "\n");
+}
+
+// Payload of the stage file at `path` when it was saved under `key`.
+// `key` null accepts the file whatever it was saved under.
+bool load_stage(const fs::path& path, const char* stage, const std::string* key, JsonMap& out) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::ostringstream buf;
+    buf << in.rdbuf();
+
+    JsonMap m;
+    if (!parse_flat_json(buf.str(), m) ||
+        json_val_as_int(m["version"]) != kStageCacheVersion ||
+        json_val_as_string(m["stage"]) != stage) {
+        log_warn("Stage cache %s is unreadable; recomputing", path.filename().c_str());
+        return false;
+    }
+    if (key && json_val_as_string(m["key"]) != *key) {
+        log_debug("stage_cache: %s is stale (inputs changed)", path.filename().c_str());
+        return false;
+    }
+    out = std::move(m);
+    return true;
+}
+
+} // anonymous namespace
+
+std::string hash_samples(const SampleSource& audio) {
+    constexpr size_t kBlock = 1 << 16;
+    uint64_t h = kFnvOffset;
+    std::vector<float> scratch;
+    const size_t total = audio.size();
+    for (size_t pos = 0; pos < total; pos += kBlock) {
+        size_t n = 0;
+        const float* p = audio.view(pos, kBlock, scratch, n);
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t bits;
+            std::memcpy(&bits, p + i, sizeof(bits));
+            h = (h ^ bits) * kFnvPrime;
+        }
+    }
+    return to_hex(h);
+}
+
+std::string hash_text(const std::string& text) {
+    uint64_t h = kFnvOffset;
+    for (unsigned char c : text)
+        h = (h ^ c) * kFnvPrime;
+    return to_hex(h);
+}
+
+std::string hash_file(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return {};
+    std::ostringstream buf;
+    buf << in.rdbuf();
+    return hash_text(buf.str());
+}
+
+StageKey& StageKey::add(const char* name, const std::string& value) {
+    // Length-prefixed, so no value can run into the next field.
+    text_ += name;
+    text_ += '=';
+    text_ += std::to_string(value.size());
+    text_ += ':';
+    text_ += value;
+    text_ += '\n';
+    return *this;
+}
+
+StageKey& StageKey::add(const char* name, double value) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.17g", value);
+    return add(name, std::string(buf));
+}
+
+StageKey& StageKey::add(const char* name, int value) {
+    return add(name, std::to_string(value));
+}
+
+fs::path meeting_manifest_path(const fs::path& audio_path) {
+    std::string stem = audio_path.stem().string();
+    const std::string prefix = AUDIO_PREFIX;
+    if (stem.compare(0, prefix.size(), prefix) == 0)
+        stem.erase(0, prefix.size());
+    return audio_path.parent_path() / (std::string(MANIFEST_PREFIX) + stem + ".json");
+}
+
+bool same_manifest_inputs(const MeetingManifest& a, const MeetingManifest& b) {
+    return a.audio_hash == b.audio_hash && a.transcript_key == b.transcript_key &&
+           a.diarization_key == b.diarization_key && a.summary_key == b.summary_key;
+}
+
+bool stat_manifest_audio(const fs::path& audio_path, uint64_t& bytes, int64_t& mtime) {
+    std::error_code ec;
+    const uintmax_t size = fs::file_size(audio_path, ec);
+    if (ec) return false;
+    const auto when = fs::last_write_time(audio_path, ec);
+    if (ec) return false;
+    bytes = static_cast<uint64_t>(size);
+    mtime = static_cast<int64_t>(when.time_since_epoch().count());
+    return true;
+}
+
+void save_meeting_manifest(const fs::path& path, const MeetingManifest& manifest) {
+    JsonMap m;
+    m["audio_hash"] = manifest.audio_hash;
+    m["audio_bytes"] = static_cast<int64_t>(manifest.audio_bytes);
+    m["audio_mtime"] = manifest.audio_mtime;
+    m["transcript_key"] = manifest.transcript_key;
+    m["diarization_key"] = manifest.diarization_key;
+    m["summary_key"] = manifest.summary_key;
+    m["note_path"] = manifest.note_path.string();
+    m["note_hash"] = manifest.note_hash;
+    save_stage(path, MANIFEST_STAGE, "", std::move(m));
+}
+
+bool load_meeting_manifest(const fs::path& path, MeetingManifest& out) {
+    JsonMap m;
+    if (!load_stage(path, MANIFEST_STAGE, nullptr, m)) return false;
+    MeetingManifest manifest;
+    manifest.audio_hash = json_val_as_string(m["audio_hash"]);
+    if (manifest.audio_hash.empty()) return false;
+    manifest.audio_bytes = static_cast<uint64_t>(json_val_as_int(m["audio_bytes"]));
+    manifest.audio_mtime = json_val_as_int(m["audio_mtime"]);
+    manifest.transcript_key = json_val_as_string(m["transcript_key"]);
+    manifest.diarization_key = json_val_as_string(m["diarization_key"]);
+    manifest.summary_key = json_val_as_string(m["summary_key"]);
+    manifest.note_path = json_val_as_string(m["note_path"]);
+    manifest.note_hash = json_val_as_string(m["note_hash"]);
+    out = std::move(manifest);
+    return true;
+}
+
+fs::path stage_cache_path(const fs::path& audio_path, const char* stage) {
+    std::string stem = audio_path.stem().string();
+    const std::string prefix = AUDIO_PREFIX;
+    if (stem.compare(0, prefix.size(), prefix) == 0)
+        stem.erase(0, prefix.size());
+    return audio_path.parent_path() /
+           (std::string(STAGE_PREFIX) + stage + "_" + stem + ".json");
+}
+
+void save_transcript_stage(const fs::path& path, const std::string& key,
+                           const TranscriptResult& result) {
+    JsonMap m;
+    m["language"] = result.language;
+    m["language_prob"] = static_cast<double>(result.language_prob);
+    m["segments"] = static_cast<int64_t>(result.segments.size());
+    for (size_t i = 0; i < result.segments.size(); ++i) {
+        const auto& seg = result.segments[i];
+        m[item_key("s", i, "start_ms")] = to_ms(seg.start);
+        m[item_key("s", i, "end_ms")] = to_ms(seg.end);
+        m[item_key("s", i, "text")] = seg.text;
+    }
+    save_stage(path, STAGE_TRANSCRIPT, key, std::move(m));
+}
+
+bool load_transcript_stage(const fs::path& path, const std::string& key,
+                           TranscriptResult& out) {
+    JsonMap m;
+    if (!load_stage(path, STAGE_TRANSCRIPT, &key, m)) return false;
+
+    TranscriptResult result{};
+    result.language = json_val_as_string(m["language"]);
+    result.language_prob = static_cast<float>(json_val_as_double(m["language_prob"]));
+    const int64_t n = json_val_as_int(m["segments"], -1);
+    if (n < 0) return false;
+    for (int64_t i = 0; i < n; ++i) {
+        auto text = m.find(item_key("s", i, "text"));
+        if (text == m.end()) {
+            log_warn("Stage cache %s is truncated; recomputing", path.filename().c_str());
+            return false;
+        }
+        result.segments.push_back({json_val_as_int(m[item_key("s", i, "start_ms")]) / 1000.0,
+                                   json_val_as_int(m[item_key("s", i, "end_ms")]) / 1000.0,
+                                   json_val_as_string(text->second)});
+    }
+    out = std::move(result);
+    return true;
+}
+
+void save_diarization_stage(const fs::path& path, const std::string& key,
+                            const DiarizeResult& diar,
+                            const std::map<int, std::vector<float>>& centroids) {
+    JsonMap m;
+    m["num_speakers"] = static_cast<int64_t>(diar.num_speakers);
+    m["segments"] = static_cast<int64_t>(diar.segments.size());
+    for (size_t i = 0; i < diar.segments.size(); ++i) {
+        const auto& seg = diar.segments[i];
+        m[item_key("s", i, "start_ms")] = to_ms(seg.start);
+        m[item_key("s", i, "end_ms")] = to_ms(seg.end);
+        m[item_key("s", i, "speaker")] = static_cast<int64_t>(seg.speaker);
+    }
+    m["centroids"] = static_cast<int64_t>(centroids.size());
+    size_t i = 0;
+    for (const auto& [cluster, centroid] : centroids) {
+        m[item_key("c", i, "cluster")] = static_cast<int64_t>(cluster);
+        m[item_key("c", i, "embedding")] = encode_floats(centroid);
+        ++i;
+    }
+    save_stage(path, STAGE_DIARIZATION, key, std::move(m));
+}
+
+namespace {
+
+bool decode_diarization(const fs::path& path, JsonMap& m, DiarizeResult& diar,
+                        std::map<int, std::vector<float>>& centroids) {
+    DiarizeResult result;
+    result.num_speakers = static_cast<int>(json_val_as_int(m["num_speakers"]));
+    const int64_t n = json_val_as_int(m["segments"], -1);
+    const int64_t nc = json_val_as_int(m["centroids"], -1);
+    bool ok = n >= 0 && nc >= 0;
+    for (int64_t i = 0; ok && i < n; ++i) {
+        auto speaker = m.find(item_key("s", i, "speaker"));
+        ok = speaker != m.end();
+        if (ok)
+            result.segments.push_back({json_val_as_int(m[item_key("s", i, "start_ms")]) / 1000.0,
+                                       json_val_as_int(m[item_key("s", i, "end_ms")]) / 1000.0,
+                                       static_cast<int>(json_val_as_int(speaker->second))});
+    }
+    std::map<int, std::vector<float>> clusters;
+    for (int64_t i = 0; ok && i < nc; ++i) {
+        auto cluster = m.find(item_key("c", i, "cluster"));
+        std::vector<float> embedding;
+        ok = cluster != m.end() &&
+             decode_floats(json_val_as_string(m[item_key("c", i, "embedding")]), embedding);
+        if (ok)
+            clusters[static_cast<int>(json_val_as_int(cluster->second))] = std::move(embedding);
+    }
+    if (!ok) {
+        log_warn("Stage cache %s is truncated; recomputing", path.filename().c_str());
+        return false;
+    }
+    diar = std::move(result);
+    centroids = std::move(clusters);
+    return true;
+}
+
+} // anonymous namespace
+
+bool load_diarization_stage(const fs::path& path, const std::string& key,
+                            DiarizeResult& diar,
+                            std::map<int, std::vector<float>>& centroids) {
+    JsonMap m;
+    return load_stage(path, STAGE_DIARIZATION, &key, m) &&
+           decode_diarization(path, m, diar, centroids);
+}
+
+bool load_saved_diarization_stage(const fs::path& path, DiarizeResult& diar,
+                                  std::map<int, std::vector<float>>& centroids) {
+    JsonMap m;
+    return load_stage(path, STAGE_DIARIZATION, nullptr, m) &&
+           decode_diarization(path, m, diar, centroids);
+}
+
+#if RECMEET_USE_SHERPA
+void put_diarized_chunk(JsonMap& m, const std::string& prefix, const DiarizedChunk& chunk) {
+    m[prefix + "pcm_start"]    = static_cast<int64_t>(chunk.extents.pcm_start_samples);
+    m[prefix + "pcm_end"]      = static_cast<int64_t>(chunk.extents.pcm_end_samples);
+    m[prefix + "num_speakers"] = static_cast<int64_t>(chunk.diar.num_speakers);
+    m[prefix + "segments"]     = encode_segments(chunk.diar);
+    m[prefix + "centroids"]    = static_cast<int64_t>(chunk.centroids.size());
+    size_t i = 0;
+    for (const auto& [speaker, centroid] : chunk.centroids) {
+        m[prefix + item_key("c", i, "speaker")]   = static_cast<int64_t>(speaker);
+        m[prefix + item_key("c", i, "embedding")] = encode_floats(centroid);
+        ++i;
+    }
+}
+
+bool get_diarized_chunk(JsonMap& m, const std::string& prefix, DiarizedChunk& out) {
+    DiarizedChunk c{};
+    auto pcm_end = m.find(prefix + "pcm_end");
+    const int64_t nc = json_val_as_int(m[prefix + "centroids"], -1);
+    bool ok = pcm_end != m.end() && nc >= 0 &&
+              decode_segments(json_val_as_string(m[prefix + "segments"]), c.diar);
+    for (int64_t i = 0; ok && i < nc; ++i) {
+        auto speaker = m.find(prefix + item_key("c", i, "speaker"));
+        std::vector<float> embedding;
+        ok = speaker != m.end() &&
+             decode_floats(json_val_as_string(m[prefix + item_key("c", i, "embedding")]),
+                           embedding);
+        if (ok)
+            c.centroids[static_cast<int>(json_val_as_int(speaker->second))] =
+                std::move(embedding);
+    }
+    if (!ok) return false;
+    c.extents.pcm_start_samples = static_cast<size_t>(json_val_as_int(m[prefix + "pcm_start"]));
+    c.extents.pcm_end_samples = static_cast<size_t>(json_val_as_int(pcm_end->second));
+    c.diar.num_speakers = static_cast<int>(json_val_as_int(m[prefix + "num_speakers"]));
+    out = std::move(c);
+    return true;
+}
+
+void save_clustering_stage(const fs::path& path, const std::string& key,
+                           const ClusteringStage& stage) {
+    JsonMap m;
+    m["audio"] = stage.audio_hash;
+    m["samples"] = static_cast<int64_t>(stage.samples);
+    m["chunked"] = stage.chunked;
+    m["chunks"] = static_cast<int64_t>(stage.chunks.size());
+    for (size_t i = 0; i < stage.chunks.size(); ++i)
+        put_diarized_chunk(m, "k" + std::to_string(i) + "_", stage.chunks[i]);
+    save_stage(path, STAGE_CLUSTERING, key, std::move(m));
+}
+
+bool load_clustering_stage(const fs::path& path, const std::string& key,
+                           ClusteringStage& out) {
+    JsonMap m;
+    if (!load_stage(path, STAGE_CLUSTERING, &key, m)) return false;
+
+    ClusteringStage stage;
+    stage.audio_hash = json_val_as_string(m["audio"]);
+    stage.samples = static_cast<size_t>(json_val_as_int(m["samples"]));
+    stage.chunked = json_val_as_bool(m["chunked"]);
+    const int64_t n = json_val_as_int(m["chunks"], -1);
+    bool ok = n > 0 && stage.samples > 0;
+    for (int64_t i = 0; ok && i < n; ++i) {
+        DiarizedChunk c;
+        ok = get_diarized_chunk(m, "k" + std::to_string(i) + "_", c);
+        if (ok) stage.chunks.push_back(std::move(c));
+    }
+    if (!ok) {
+        log_warn("Stage cache %s is truncated; recomputing", path.filename().c_str());
+        return false;
+    }
+    out = std::move(stage);
+    return true;
+}
+
+std::string clustering_stage_audio_hash(const fs::path& path) {
+    std::ifstream in(path);
+    if (!in) return {};
+    std::ostringstream buf;
+    buf << in.rdbuf();
+    JsonMap m;
+    if (!parse_flat_json(buf.str(), m) ||
+        json_val_as_int(m["version"]) != kStageCacheVersion ||
+        json_val_as_string(m["stage"]) != STAGE_CLUSTERING)
+        return {};
+    return json_val_as_string(m["audio"]);
+}
+#endif
+
+void save_summary_stage(const fs::path& path, const std::string& key,
+                        const std::string& summary,
+                        const std::vector<std::string>& speakers) {
+    JsonMap m;
+    m["summary"] = summary;
+    m["speakers"] = static_cast<int64_t>(speakers.size());
+    for (size_t i = 0; i < speakers.size(); ++i)
+        m["speaker_" + std::to_string(i)] = speakers[i];
+    save_stage(path, STAGE_SUMMARY, key, std::move(m));
+}
+
+bool load_summary_stage(const fs::path& path, const std::string& key,
+                        std::string& out, std::vector<std::string>* speakers) {
+    JsonMap m;
+    if (!load_stage(path, STAGE_SUMMARY, &key, m)) return false;
+    auto it = m.find("summary");
+    if (it == m.end()) return false;
+    std::string summary = json_val_as_string(it->second);
+    if (summary.empty()) return false;
+    std::vector<std::string> labels;
+    const int64_t n = json_val_as_int(m["speakers"]);
+    for (int64_t i = 0; i < n; ++i) {
+        auto label = m.find("speaker_" + std::to_string(i));
+        if (label == m.end()) return false;
+        labels.push_back(json_val_as_string(label->second));
+    }
+    out = std::move(summary);
+    if (speakers) *speakers = std::move(labels);
+    return true;
+}
+
+void save_summary_parts_stage(const fs::path& path, const std::string& key,
+                              const std::map<std::string, std::string>& responses) {
+    JsonMap m;
+    m["parts"] = static_cast<int64_t>(responses.size());
+    size_t i = 0;
+    for (const auto& [hash, response] : responses) {
+        m["hash_" + std::to_string(i)] = hash;
+        m["response_" + std::to_string(i)] = response;
+        ++i;
+    }
+    save_stage(path, STAGE_SUMMARY_PARTS, key, std::move(m));
+}
+
+bool load_summary_parts_stage(const fs::path& path, const std::string& key,
+                              std::map<std::string, std::string>& out) {
+    JsonMap m;
+    if (!load_stage(path, STAGE_SUMMARY_PARTS, &key, m)) return false;
+    std::map<std::string, std::string> responses;
+    const int64_t n = json_val_as_int(m["parts"]);
+    for (int64_t i = 0; i < n; ++i) {
+        auto hash = m.find("hash_" + std::to_string(i));
+        auto response = m.find("response_" + std::to_string(i));
+        if (hash == m.end() || response == m.end()) return false;
+        responses[json_val_as_string(hash->second)] = json_val_as_string(response->second);
+    }
+    out = std::move(responses);
+    return true;
+}
+
+namespace {
+
+void put_list(JsonMap& m, const char* name, const std::vector<std::string>& list) {
+    m[name] = static_cast<int64_t>(list.size());
+    for (size_t i = 0; i < list.size(); ++i)
+        m[std::string(name) + "_" + std::to_string(i)] = list[i];
+}
+
+bool get_list(JsonMap& m, const char* name, std::vector<std::string>& out) {
+    const int64_t n = json_val_as_int(m[name]);
+    for (int64_t i = 0; i < n; ++i) {
+        auto it = m.find(std::string(name) + "_" + std::to_string(i));
+        if (it == m.end()) return false;
+        out.push_back(json_val_as_string(it->second));
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+void save_note_stage(const fs::path& path, const NoteStage& stage) {
+    const MeetingData& d = stage.data;
+    JsonMap m;
+    m["date"] = d.date;
+    m["time"] = d.time;
+    m["summary"] = d.summary_text;
+    m["context"] = d.context_text;
+    m["note_dir"] = d.note_dir.string();
+    put_list(m, "action_items", d.action_items);
+    m["title"] = d.title;
+    m["description"] = d.description;
+    put_list(m, "tags", d.ai_tags);
+    put_list(m, "participants", d.participants);
+    m["duration_seconds"] = static_cast<int64_t>(d.duration_seconds);
+    m["whisper_model"] = d.whisper_model;
+    m["note_path"] = stage.note_path.string();
+
+    m["segments"] = static_cast<int64_t>(stage.segments.size());
+    m["diarized"] = !stage.speakers.empty();
+    for (size_t i = 0; i < stage.segments.size(); ++i) {
+        const auto& seg = stage.segments[i];
+        m[item_key("s", i, "start_ms")] = to_ms(seg.start);
+        m[item_key("s", i, "end_ms")] = to_ms(seg.end);
+        m[item_key("s", i, "text")] = seg.text;
+        if (i < stage.speakers.size())
+            m[item_key("s", i, "speaker")] = static_cast<int64_t>(stage.speakers[i]);
+    }
+    m["labels"] = static_cast<int64_t>(stage.labels.size());
+    size_t i = 0;
+    for (const auto& [speaker, label] : stage.labels) {
+        m[item_key("l", i, "speaker")] = static_cast<int64_t>(speaker);
+        m[item_key("l", i, "label")] = label;
+        ++i;
+    }
+    save_stage(path, STAGE_NOTE, "", std::move(m));
+}
+
+bool load_note_stage(const fs::path& path, NoteStage& out) {
+    JsonMap m;
+    if (!load_stage(path, STAGE_NOTE, nullptr, m)) return false;
+
+    NoteStage stage;
+    MeetingData& d = stage.data;
+    d.date = json_val_as_string(m["date"]);
+    d.time = json_val_as_string(m["time"]);
+    d.summary_text = json_val_as_string(m["summary"]);
+    d.context_text = json_val_as_string(m["context"]);
+    d.note_dir = json_val_as_string(m["note_dir"]);
+    d.title = json_val_as_string(m["title"]);
+    d.description = json_val_as_string(m["description"]);
+    d.duration_seconds = static_cast<int>(json_val_as_int(m["duration_seconds"]));
+    d.whisper_model = json_val_as_string(m["whisper_model"]);
+    stage.note_path = json_val_as_string(m["note_path"]);
+    bool ok = get_list(m, "action_items", d.action_items) && get_list(m, "tags", d.ai_tags) &&
+              get_list(m, "participants", d.participants);
+
+    const bool diarized = json_val_as_bool(m["diarized"]);
+    const int64_t n = json_val_as_int(m["segments"], -1);
+    ok = ok && n >= 0;
+    for (int64_t i = 0; ok && i < n; ++i) {
+        auto text = m.find(item_key("s", i, "text"));
+        auto speaker = m.find(item_key("s", i, "speaker"));
+        ok = text != m.end() && (!diarized || speaker != m.end());
+        if (!ok) break;
+        stage.segments.push_back({json_val_as_int(m[item_key("s", i, "start_ms")]) / 1000.0,
+                                  json_val_as_int(m[item_key("s", i, "end_ms")]) / 1000.0,
+                                  json_val_as_string(text->second)});
+        if (diarized) stage.speakers.push_back(static_cast<int>(json_val_as_int(speaker->second)));
+    }
+    const int64_t nl = json_val_as_int(m["labels"]);
+    for (int64_t i = 0; ok && i < nl; ++i) {
+        auto speaker = m.find(item_key("l", i, "speaker"));
+        auto label = m.find(item_key("l", i, "label"));
+        ok = speaker != m.end() && label != m.end();
+        if (ok)
+            stage.labels[static_cast<int>(json_val_as_int(speaker->second))] =
+                json_val_as_string(label->second);
+    }
+    if (!ok) {
+        log_warn("Stage cache %s is truncated", path.filename().c_str());
+        return false;
+    }
+    out = std::move(stage);
+    return true;
+}
+
+} // namespace recmeet
@@ -0,0 +1,206 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "diarize.h"
+#include "ipc_protocol.h"
+#include "note.h"
+#include "sample_source.h"
+#include "transcribe.h"
+#include "util.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Stage artifact cache (stage_<stage>_YYYY-MM-DD_HH-MM.json next to the audio)
+//
+// run_postprocessing() saves what each expensive stage produced — the raw
+// whisper segments, the diarization segments with their per-cluster
+// centroids, the summary — keyed by a hash of the stage's inputs: the audio
+// samples (or, for the summary, the transcript) plus the settings the stage
+// reads. A later pass over the same meeting (--reprocess, the web UI's
+// reprocess) reuses every stage whose key still matches and recomputes the
+// rest, so changing the summarizer or cluster_threshold re-runs only the
+// stages downstream of it. One file per stage; a recompute overwrites it.
+// VAD segments have their own index (vad.h).
+// ---------------------------------------------------------------------------
+
+/// Stage names, used in the file name.
+constexpr const char* STAGE_TRANSCRIPT = "transcript";
+constexpr const char* STAGE_DIARIZATION = "diarization";
+constexpr const char* STAGE_SUMMARY = "summary";
+constexpr const char* STAGE_CLUSTERING = "clustering";
+constexpr const char* STAGE_SUMMARY_PARTS = "summary_parts";
+constexpr const char* STAGE_NOTE = "note";
+
+/// Content hash of every sample of `audio` (FNV-1a 64 over the float
+/// bit patterns, 16 hex digits). Independent of the container, so a WAV and
+/// its lossless FLAC archive hash the same.
+std::string hash_samples(const SampleSource& audio);
+
+/// FNV-1a 64 of `text`, 16 hex digits.
+std::string hash_text(const std::string& text);
+
+/// hash_text() of the file at `path`; "" if it cannot be read.
+std::string hash_file(const fs::path& path);
+
+/// Builds a stage key from named inputs. add() order matters; numbers are
+/// formatted exactly so a changed threshold changes the key.
+class StageKey {
+public:
+    explicit StageKey(const std::string& stage) { add("stage", stage); }
+
+    StageKey& add(const char* name, const std::string& value);
+    StageKey& add(const char* name, const char* value) { return add(name, std::string(value)); }
+    StageKey& add(const char* name, double value);
+    StageKey& add(const char* name, int value);
+
+    /// Hash of everything added, 16 hex digits.
+    std::string digest() const { return hash_text(text_); }
+
+private:
+    std::string text_;
+};
+
+/// `<dir>/audio_<ts>.<ext>` -> `<dir>/stage_<stage>_<ts>.json`.
+fs::path stage_cache_path(const fs::path& audio_path, const char* stage);
+
+/// Raw whisper output, before speaker labels are merged in.
+void save_transcript_stage(const fs::path& path, const std::string& key,
+                           const TranscriptResult& result);
+bool load_transcript_stage(const fs::path& path, const std::string& key,
+                           TranscriptResult& out);
+
+/// Diarization segments plus the post-collapse centroid of each cluster
+/// (DiarizationOutput in pipeline.cpp), which speaker identification
+/// matches against the enrolled speakers.
+void save_diarization_stage(const fs::path& path, const std::string& key,
+                            const DiarizeResult& diar,
+                            const std::map<int, std::vector<float>>& centroids);
+bool load_diarization_stage(const fs::path& path, const std::string& key,
+                            DiarizeResult& diar,
+                            std::map<int, std::vector<float>>& centroids);
+/// Same, whatever key it was saved under: the diarization the meeting's
+/// current speaker labels came from. --enroll uses it so that picking
+/// "Speaker 2" means the Speaker_02 of the transcript, without hashing or
+/// re-diarizing the recording.
+bool load_saved_diarization_stage(const fs::path& path, DiarizeResult& diar,
+                                  std::map<int, std::vector<float>>& centroids);
+
+#if RECMEET_USE_SHERPA
+/// What diarization's sherpa pass produced, before stitching, the
+/// short-audio duration filter and collapse: the chunk-local segments and
+/// raw centroids of every chunk. The single-shot path stores one chunk
+/// covering the recording, with a centroid per cluster sherpa found. The
+/// settings those later steps read (stitch/collapse thresholds, speaker
+/// target, min_cluster_duration_sec) are not part of the key, so
+/// --recluster and --reprocess can redo them from here without the audio.
+struct ClusteringStage {
+    std::string audio_hash;  ///< hash_samples() of the recording
+    size_t samples = 0;      ///< its length, to re-plan the chunk extents
+    bool chunked = false;
+    std::vector<DiarizedChunk> chunks;
+};
+
+/// Segment times and centroids round-trip exactly.
+void save_clustering_stage(const fs::path& path, const std::string& key,
+                           const ClusteringStage& stage);
+bool load_clustering_stage(const fs::path& path, const std::string& key,
+                           ClusteringStage& out);
+
+/// The audio hash a clustering stage was saved for, or "" if `path` is
+/// missing or unreadable. --recluster keys every stage by it instead of
+/// hashing the recording again.
+std::string clustering_stage_audio_hash(const fs::path& path);
+
+/// One DiarizedChunk as flat fields named `<prefix><field>`: PCM extents,
+/// exact segments and centroids (the extents' core/offset are the caller's
+/// to re-plan). Shared with the live diarization file (live_diarize.h).
+void put_diarized_chunk(JsonMap& m, const std::string& prefix, const DiarizedChunk& chunk);
+/// False if a field is missing or malformed.
+bool get_diarized_chunk(JsonMap& m, const std::string& prefix, DiarizedChunk& out);
+#endif
+
+/// Summary text as the summarizer returned it (metadata block included),
+/// and the transcript's speaker labels it was written with, in order of
+/// first appearance (transcript_speakers()), so a relabelled meeting can
+/// rename them in place. `speakers` may be null when they are not wanted.
+void save_summary_stage(const fs::path& path, const std::string& key,
+                        const std::string& summary,
+                        const std::vector<std::string>& speakers = {});
+bool load_summary_stage(const fs::path& path, const std::string& key,
+                        std::string& out, std::vector<std::string>* speakers = nullptr);
+
+/// The map and merge responses of a map-reduce summary still in progress
+/// (SummaryCheckpoint), by hash_text() of their prompt, under the summary
+/// stage's key. Saved after every step and removed once the summary stage
+/// is written.
+void save_summary_parts_stage(const fs::path& path, const std::string& key,
+                              const std::map<std::string, std::string>& responses);
+bool load_summary_parts_stage(const fs::path& path, const std::string& key,
+                              std::map<std::string, std::string>& out);
+
+/// What a meeting's note was written from, saved by run_postprocessing()
+/// after the note: its inputs, and the whisper segments with the
+/// diarization speaker of each and the label each speaker was written
+/// with. rerender_meeting_note() (pipeline.h) rewrites the note from it
+/// after a speaker relabel without loading a model. Saved under no key,
+/// as it is never reused in place of a recompute.
+struct NoteStage {
+    MeetingData data;  ///< transcript_text and output_dir are not kept
+    std::vector<TranscriptSegment> segments;  ///< text without a speaker label
+    std::vector<int> speakers;                ///< per segment; empty without diarization
+    std::map<int, std::string> labels;        ///< speaker -> label in the note
+    fs::path note_path;
+};
+
+void save_note_stage(const fs::path& path, const NoteStage& stage);
+bool load_note_stage(const fs::path& path, NoteStage& out);
+
+/// What a meeting's note was written from (manifest_<ts>.json next to the
+/// audio), saved by run_postprocessing() after the note when the stage
+/// cache is on. A `--reprocess-batch --refresh` compares it with what the
+/// current config would use (expected_meeting_manifest()) to find the
+/// meetings worth redoing; the stage cache then redoes only their stale
+/// stages.
+struct MeetingManifest {
+    std::string audio_hash;       ///< hash_samples() of the recording
+    uint64_t audio_bytes = 0;     ///< the recording's size and mtime when it was
+    int64_t audio_mtime = 0;      ///< hashed, so a check can trust audio_hash
+    std::string transcript_key;   ///< transcript_stage_key()
+    std::string diarization_key;  ///< diarization_stage_key(); "" without diarization
+    /// summary_stage_key() over an empty transcript, i.e. the summary
+    /// settings alone (its transcript is covered by the two keys above);
+    /// "" without a summary.
+    std::string summary_key;
+    fs::path note_path;
+    std::string note_hash;        ///< hash_text() of the note as written
+};
+
+/// `<dir>/audio_<ts>.<ext>` -> `<dir>/manifest_<ts>.json`.
+fs::path meeting_manifest_path(const fs::path& audio_path);
+
+/// Whether two manifests name the same inputs: the audio hash and the
+/// three keys, not the note.
+bool same_manifest_inputs(const MeetingManifest& a, const MeetingManifest& b);
+
+/// `audio_path`'s size and mtime, as MeetingManifest records them; false
+/// if it cannot be stat'ed.
+bool stat_manifest_audio(const fs::path& audio_path, uint64_t& bytes, int64_t& mtime);
+
+void save_meeting_manifest(const fs::path& path, const MeetingManifest& manifest);
+bool load_meeting_manifest(const fs::path& path, MeetingManifest& out);
+
+// The save functions write through a temporary file renamed into place,
+// so a process killed mid-save leaves the previous file, and throw
+// RecmeetError if the file cannot be written. The
+// load functions return false — leaving their outputs untouched — if the
+// file is missing or malformed or was saved under a different key.
+
+} // namespace recmeet
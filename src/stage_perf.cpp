@@ -0,0 +1,288 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "stage_perf.h"
+#include "log.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <sstream>
+
+namespace recmeet {
+
+namespace {
+
+constexpr const char* PERF_PREFIX = "perf_";
+
+// Flat-object parse via the IPC parser, as config_from_json() does.
+bool parse_flat_json(const std::string& line, JsonMap& out) {
+    IpcMessage msg;
+    if (!parse_ipc_message("{\"id\":0,\"result\":" + line + "}", msg) ||
+        msg.type != IpcMessageType::Response)
+        return false;
+    out = std::move(msg.response.result);
+    return true;
+}
+
+std::string item_key(size_t i, const std::string& field) {
+    return "p" + std::to_string(i) + "_" + field;
+}
+
+double seconds(const timeval& tv) {
+    return static_cast<double>(tv.tv_sec) + tv.tv_usec / 1e6;
+}
+
+} // anonymous namespace
+
+double StagePerf::rtf() const {
+    return audio_sec > 0 ? wall_sec / audio_sec : 0.0;
+}
+
+double StagePerf::utilization() const {
+    if (cpu_sec < 0 || wall_sec <= 0 || threads <= 0) return 0.0;
+    return cpu_sec / (wall_sec * threads);
+}
+
+double process_cpu_seconds() {
+    rusage ru{};
+    if (::getrusage(RUSAGE_SELF, &ru) != 0) return 0.0;
+    return seconds(ru.ru_utime) + seconds(ru.ru_stime);
+}
+
+StageTimer::StageTimer(std::string stage, double audio, int n_threads)
+    : audio_sec(audio), threads(n_threads), stage_(std::move(stage)),
+      start_(std::chrono::steady_clock::now()), cpu_start_(process_cpu_seconds()),
+      rss_start_kb_(read_self_rss_kb()), hwm_start_kb_(read_self_peak_rss_kb()) {
+    if (perf_counters_enabled()) counters_ = std::make_shared<PerfCounterSet>();
+}
+
+StagePerf StageTimer::finish(bool cached) const {
+    StagePerf p;
+    p.stage = stage_;
+    p.wall_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    p.cpu_sec = std::max(0.0, process_cpu_seconds() - cpu_start_);
+    p.audio_sec = audio_sec;
+    p.threads = threads;
+    p.cached = cached;
+    const long hwm = read_self_peak_rss_kb();
+    p.peak_rss_kb = hwm > hwm_start_kb_ ? hwm : std::max(rss_start_kb_, read_self_rss_kb());
+    if (counters_) p.counters = counters_->read();
+    return p;
+}
+
+StagePerf release_stage_memory(const std::string& scope) {
+    StagePerf p;
+    p.stage = "release." + scope;
+    const auto start = std::chrono::steady_clock::now();
+    p.peak_rss_kb = read_self_rss_kb();
+    release_free_heap();
+    p.released_kb = std::max(0L, p.peak_rss_kb - read_self_rss_kb());
+    p.wall_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    log_info("Released %ld MB of freed heap (%s scope; RSS %ld -> %ld MB)",
+             p.released_kb / 1024, scope.c_str(), p.peak_rss_kb / 1024,
+             (p.peak_rss_kb - p.released_kb) / 1024);
+    return p;
+}
+
+std::vector<StagePerf> engine_perf_records(const std::map<std::string, EngineCounts>& engines) {
+    std::vector<StagePerf> out;
+    for (const auto& [name, tally] : engines) {
+        StagePerf p;
+        p.stage = "engine." + name;
+        p.wall_sec = tally.wall_sec;
+        p.calls = tally.calls;
+        p.counters = tally.counts;
+        out.push_back(std::move(p));
+    }
+    return out;
+}
+
+std::vector<StagePerf> thread_perf_records(const std::map<std::string, ThreadUse>& usage) {
+    std::vector<StagePerf> out;
+    for (const auto& [engine, use] : usage) {
+        if (use.leases == 0 || use.held_sec <= 0) continue;
+        StagePerf p;
+        p.stage = "threads." + engine;
+        p.calls = use.leases;
+        p.wall_sec = use.held_sec;
+        p.cpu_sec = use.cpu_sec;
+        p.threads = std::max(1, static_cast<int>(std::lround(use.thread_sec / use.held_sec)));
+        out.push_back(std::move(p));
+    }
+    return out;
+}
+
+std::string perf_counters_summary(const StagePerf& perf) {
+    const PerfCounts& c = perf.counters;
+    if (!c.any()) return "";
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), " IPC %.2f, %.1f%% cache / %.1f%% branch misses, ~%.0f MB/s",
+                  c.ipc(), c.cache_miss_rate() * 100, c.branch_miss_rate() * 100,
+                  c.miss_mb_per_sec(perf.wall_sec));
+    return buf;
+}
+
+JsonMap stage_perf_to_map(const StagePerf& perf) {
+    JsonMap m;
+    m["stage"] = perf.stage;
+    if (perf.index >= 0) m["index"] = static_cast<int64_t>(perf.index);
+    m["wall_sec"] = perf.wall_sec;
+    if (perf.cpu_sec >= 0) m["cpu_sec"] = perf.cpu_sec;
+    m["audio_sec"] = perf.audio_sec;
+    m["threads"] = static_cast<int64_t>(perf.threads);
+    m["peak_rss_kb"] = static_cast<int64_t>(perf.peak_rss_kb);
+    m["cached"] = perf.cached;
+    m["rtf"] = perf.rtf();
+    m["utilization"] = perf.utilization();
+    if (perf.calls > 0) m["calls"] = static_cast<int64_t>(perf.calls);
+    if (perf.released_kb > 0) m["released_kb"] = static_cast<int64_t>(perf.released_kb);
+    const PerfCounts& c = perf.counters;
+    if (c.any()) {
+        const std::pair<const char*, int64_t> counts[] = {
+            {"cycles", c.cycles},         {"instructions", c.instructions},
+            {"cache_refs", c.cache_refs}, {"cache_misses", c.cache_misses},
+            {"branches", c.branches},     {"branch_misses", c.branch_misses},
+        };
+        for (const auto& [key, n] : counts)
+            if (n >= 0) m[key] = n;
+        m["ipc"] = c.ipc();
+        m["cache_miss_rate"] = c.cache_miss_rate();
+        m["branch_miss_rate"] = c.branch_miss_rate();
+        m["miss_mb_per_sec"] = c.miss_mb_per_sec(perf.wall_sec);
+    }
+    return m;
+}
+
+bool stage_perf_from_map(const JsonMap& m, StagePerf& out) {
+    auto get = [&m](const char* key) {
+        auto it = m.find(key);
+        return it == m.end() ? JsonVal{} : it->second;
+    };
+    StagePerf p;
+    p.stage = json_val_as_string(get("stage"));
+    if (p.stage.empty()) return false;
+    p.index = static_cast<int>(json_val_as_int(get("index"), -1));
+    p.wall_sec = json_val_as_double(get("wall_sec"));
+    p.cpu_sec = json_val_as_double(get("cpu_sec"), -1.0);
+    p.audio_sec = json_val_as_double(get("audio_sec"));
+    p.threads = static_cast<int>(json_val_as_int(get("threads")));
+    p.peak_rss_kb = static_cast<long>(json_val_as_int(get("peak_rss_kb")));
+    p.cached = json_val_as_bool(get("cached"));
+    p.calls = static_cast<int>(json_val_as_int(get("calls")));
+    p.released_kb = static_cast<long>(json_val_as_int(get("released_kb")));
+    p.counters.cycles = json_val_as_int(get("cycles"), -1);
+    p.counters.instructions = json_val_as_int(get("instructions"), -1);
+    p.counters.cache_refs = json_val_as_int(get("cache_refs"), -1);
+    p.counters.cache_misses = json_val_as_int(get("cache_misses"), -1);
+    p.counters.branches = json_val_as_int(get("branches"), -1);
+    p.counters.branch_misses = json_val_as_int(get("branch_misses"), -1);
+    out = std::move(p);
+    return true;
+}
+
+fs::path perf_path(const fs::path& audio_path) {
+    std::string stem = audio_path.stem().string();
+    const std::string prefix = AUDIO_PREFIX;
+    if (stem.compare(0, prefix.size(), prefix) == 0)
+        stem.erase(0, prefix.size());
+    return audio_path.parent_path() / (std::string(PERF_PREFIX) + stem + ".json");
+}
+
+JsonMap perf_run_to_map(const PerfRun& run, const std::vector<StagePerf>& stages) {
+    JsonMap m;
+    m["version"] = run.version;
+    m["host"] = run.host;
+    m["meeting"] = run.meeting;
+    m["finished_unix"] = run.finished_unix;
+    m["whisper_model"] = run.whisper_model;
+    if (!run.llm_model.empty()) m["llm_model"] = run.llm_model;
+    m["attempt"] = static_cast<int64_t>(run.attempt);
+    m["wall_sec"] = run.wall_sec;
+    m["peak_rss_kb"] = static_cast<int64_t>(run.peak_rss_kb);
+    m["stages"] = static_cast<int64_t>(stages.size());
+    for (size_t i = 0; i < stages.size(); ++i)
+        for (auto& [field, val] : stage_perf_to_map(stages[i]))
+            m[item_key(i, field)] = val;
+    return m;
+}
+
+bool perf_run_from_map(const JsonMap& m, PerfRun& run, std::vector<StagePerf>& stages) {
+    auto get = [&m](const std::string& key) {
+        auto it = m.find(key);
+        return it == m.end() ? JsonVal{} : it->second;
+    };
+    const int64_t n = json_val_as_int(get("stages"), -1);
+    if (n < 0) return false;
+    PerfRun r;
+    r.version = json_val_as_string(get("version"));
+    r.host = json_val_as_string(get("host"));
+    r.meeting = json_val_as_string(get("meeting"));
+    r.finished_unix = json_val_as_int(get("finished_unix"));
+    r.whisper_model = json_val_as_string(get("whisper_model"));
+    r.llm_model = json_val_as_string(get("llm_model"));
+    r.attempt = static_cast<int>(json_val_as_int(get("attempt"), 1));
+    r.wall_sec = json_val_as_double(get("wall_sec"));
+    r.peak_rss_kb = static_cast<long>(json_val_as_int(get("peak_rss_kb")));
+
+    std::vector<StagePerf> out;
+    for (int64_t i = 0; i < n; ++i) {
+        const std::string prefix = item_key(static_cast<size_t>(i), "");
+        JsonMap item;
+        for (auto it = m.lower_bound(prefix); it != m.end() &&
+             it->first.compare(0, prefix.size(), prefix) == 0; ++it)
+            item[it->first.substr(prefix.size())] = it->second;
+        StagePerf p;
+        if (!stage_perf_from_map(item, p)) return false;
+        out.push_back(std::move(p));
+    }
+    run = std::move(r);
+    stages = std::move(out);
+    return true;
+}
+
+void save_meeting_perf(const fs::path& path, const PerfRun& run,
+                       const std::vector<StagePerf>& stages) {
+    write_text_file_atomic(path, serialize_json_map(perf_run_to_map(run, stages)) + "\n");
+}
+
+bool load_meeting_perf(const fs::path& path, PerfRun& run, std::vector<StagePerf>& stages) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::ostringstream buf;
+    buf << in.rdbuf();
+    JsonMap m;
+    return parse_flat_json(buf.str(), m) && perf_run_from_map(m, run, stages);
+}
+
+fs::path perf_history_path() {
+    return data_dir() / "perf_history.ndjson";
+}
+
+void append_perf_history(const fs::path& history, const PerfRun& run,
+                         const std::vector<StagePerf>& stages, size_t max_runs) {
+    std::deque<std::string> lines;
+    {
+        std::ifstream in(history);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty()) continue;
+            lines.push_back(std::move(line));
+            if (lines.size() >= max_runs) lines.pop_front();
+        }
+    }
+    lines.push_back(serialize_json_map(perf_run_to_map(run, stages)));
+    while (lines.size() > max_runs) lines.pop_front();
+
+    std::string body;
+    for (const auto& l : lines) body += l + "\n";
+    std::error_code ec;
+    fs::create_directories(history.parent_path(), ec);
+    write_text_file_atomic(history, body);
+}
+
+} // namespace recmeet
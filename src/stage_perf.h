@@ -0,0 +1,161 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "ipc_protocol.h"
+#include "perf_counters.h"
+#include "thread_budget.h"
+#include "util.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Stage performance records
+// ---------------------------------------------------------------------------
+//
+// run_postprocessing() times each stage it runs and reports a StagePerf as
+// the stage completes: "vad", "transcribe", "diarize", one "diarize_chunk"
+// per chunk a chunked pass computes, "identify", "summarize" and "note". A
+// daemon child relays each as a `stage.perf` event; the daemon files a
+// finished job's records as perf_<ts>.json beside its audio and appends them
+// to a rolling history (perf_history_path()), so throughput can be compared
+// across meetings, releases and hosts. Where a scope of run_postprocessing()
+// ends (the whisper model's, the audio view's, the summary's) a
+// `release.<scope>` record (release_stage_memory()) shows what handing the
+// freed heap back took off the RSS. With --perf-counters the records also
+// carry hardware counters (perf_counters.h), and one `engine.<name>` record
+// per engine sums its calls. One `threads.<engine>` record per engine that
+// leased from the thread budget (thread_budget.h) gives its leases, the
+// threads it held and its share of the CPU.
+
+struct StagePerf {
+    std::string stage;
+    int index = -1;            ///< chunk number of a "diarize_chunk"; -1 otherwise
+    double wall_sec = 0;
+    double cpu_sec = -1;       ///< user + system time of the process; -1 = not measured
+    double audio_sec = 0;      ///< audio the stage covered; 0 when it has none
+    int threads = 0;           ///< threads the stage was given; 0 = not applicable
+    long peak_rss_kb = 0;      ///< see StageTimer; a diarize_chunk's RSS as it finished
+    bool cached = false;       ///< loaded from the stage cache, not computed
+    int calls = 0;             ///< engine records: the calls summed; 0 otherwise
+    long released_kb = 0;      ///< release records: RSS the release returned; 0 otherwise
+    PerfCounts counters;       ///< --perf-counters; all -1 otherwise
+
+    /// Real-time factor, wall / audio. 0 without audio.
+    double rtf() const;
+    /// cpu / (wall * threads): 1.0 keeps every thread busy. 0 unless all
+    /// three are known.
+    double utilization() const;
+};
+
+using StagePerfCallback = std::function<void(const StagePerf&)>;
+
+/// User + system CPU time this process has used, in seconds.
+double process_cpu_seconds();
+
+/// Times one stage, from construction to finish().
+///
+/// CPU time is the whole process's, so a stage that overlaps another
+/// (diarization alongside transcription) is charged for both. The peak RSS
+/// is VmHWM when the stage raised it, else the larger RSS of its two ends:
+/// the high-water mark is never reset here, so the job's own peak report
+/// is unaffected. With perf counters on, the counters of every thread are
+/// read too (PerfScope::Process).
+class StageTimer {
+public:
+    explicit StageTimer(std::string stage, double audio_sec = 0, int threads = 0);
+
+    /// The record up to now; set `audio_sec` / `threads` first when they
+    /// are only known once the stage ran.
+    StagePerf finish(bool cached = false) const;
+
+    double audio_sec = 0;
+    int threads = 0;
+
+private:
+    std::string stage_;
+    std::chrono::steady_clock::time_point start_;
+    double cpu_start_;
+    long rss_start_kb_;
+    long hwm_start_kb_;
+    std::shared_ptr<PerfCounterSet> counters_;  // null with counters off
+};
+
+/// Return the heap the scope ending here freed to the kernel
+/// (release_free_heap()), as a `release.<scope>` record: `peak_rss_kb` is
+/// the RSS before the release, `released_kb` what it took off, `wall_sec`
+/// what the release cost. glibc keeps freed memory in its arenas, so
+/// without this a stage's scoped buffers still count in the next stage's
+/// RSS (and against the daemon's RSS limits).
+StagePerf release_stage_memory(const std::string& scope);
+
+/// `engine.<name>` records of the engine tallies (take_engine_counts()).
+std::vector<StagePerf> engine_perf_records(const std::map<std::string, EngineCounts>& engines);
+
+/// `threads.<engine>` records of the thread budget's tallies
+/// (take_thread_usage()): `calls` = leases, `wall_sec` = time held,
+/// `threads` = threads held on average, `cpu_sec` = its CPU share, so
+/// utilization() is the engine's.
+std::vector<StagePerf> thread_perf_records(const std::map<std::string, ThreadUse>& usage);
+
+/// " IPC 1.85, 3.2% cache / 0.4% branch misses, ~850 MB/s" for a log
+/// line; "" without counters.
+std::string perf_counters_summary(const StagePerf& perf);
+
+/// Flat object of one record: stage, index, the measured fields, rtf and
+/// utilization.
+JsonMap stage_perf_to_map(const StagePerf& perf);
+/// Read what stage_perf_to_map() wrote. False without a stage name.
+bool stage_perf_from_map(const JsonMap& m, StagePerf& out);
+
+/// `<dir>/audio_<ts>.<ext>` -> `<dir>/perf_<ts>.json`.
+fs::path perf_path(const fs::path& audio_path);
+
+/// What a job's records are filed under.
+struct PerfRun {
+    std::string version;        ///< RECMEET_VERSION of the daemon that ran it
+    std::string host;
+    std::string meeting;        ///< output directory name
+    int64_t finished_unix = 0;  ///< when the job completed
+    std::string whisper_model;
+    std::string llm_model;      ///< empty = HTTP provider or no summary
+    int attempt = 1;            ///< PostprocessJob::attempt
+    double wall_sec = 0;        ///< the whole job, child launch to exit
+    long peak_rss_kb = 0;       ///< the child's, from job.exit
+};
+
+/// One flat object: the run's fields, `stages`, and `p<i>_<field>` per
+/// record (the stage cache's item layout).
+JsonMap perf_run_to_map(const PerfRun& run, const std::vector<StagePerf>& stages);
+bool perf_run_from_map(const JsonMap& m, PerfRun& run, std::vector<StagePerf>& stages);
+
+/// Write perf_<ts>.json atomically. Throws RecmeetError on failure.
+void save_meeting_perf(const fs::path& path, const PerfRun& run,
+                       const std::vector<StagePerf>& stages);
+/// False when the file is missing or unreadable.
+bool load_meeting_perf(const fs::path& path, PerfRun& run, std::vector<StagePerf>& stages);
+
+/// Runs kept in the history file; the oldest are dropped beyond it.
+constexpr size_t PERF_HISTORY_MAX_RUNS = 500;
+
+/// `<data_dir>/perf_history.ndjson`: one perf_run_to_map() object per line,
+/// oldest first.
+fs::path perf_history_path();
+
+/// Append one run to `history`, keeping the newest `max_runs` lines.
+/// Rewritten atomically. Throws RecmeetError on failure.
+void append_perf_history(const fs::path& history, const PerfRun& run,
+                         const std::vector<StagePerf>& stages,
+                         size_t max_runs = PERF_HISTORY_MAX_RUNS);
+
+} // namespace recmeet
@@ -0,0 +1,195 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "streaming_mixer.h"
+#include "audio_mixer.h"
+#include "log.h"
+
+#include <algorithm>
+
+namespace recmeet {
+
+namespace {
+
+// Mix output is produced through a fixed scratch block; capture chunks are
+// 10-100 ms, so one block covers a whole append in practice.
+constexpr std::size_t kMixBlockSamples = 4096;
+
+// Compact the pending backlog once the consumed prefix is this large and
+// at least half the vector, so erase() cost stays amortized.
+constexpr std::size_t kCompactThreshold = 4096;
+
+} // anonymous namespace
+
+StreamingMixer::StreamingMixer(const fs::path& mixed_path, const fs::path& mic_stem,
+                               const fs::path& sources_path)
+    : mixed_(mixed_path), scratch_(kMixBlockSamples) {
+    if (!mic_stem.empty())
+        mic_ = std::make_unique<AudioSpool>(mic_stem);
+    if (!sources_path.empty()) {
+        sources_ = std::make_unique<AudioSpool>(sources_path, 2 * SPOOL_BLOCK_SAMPLES,
+                                                SPOOL_COMMIT_PERIOD, 2);
+        frames_.resize(2 * kMixBlockSamples);
+    }
+    pending_.reserve(kMixBlockSamples);
+}
+
+StreamingMixer::~StreamingMixer() {
+    try {
+        finish();
+    } catch (const std::exception& e) {
+        log_warn("mixer: %s", e.what());
+    }
+}
+
+void StreamingMixer::append_mic(const int16_t* samples, std::size_t n) {
+    append(true, samples, n);
+}
+
+void StreamingMixer::append_monitor(const int16_t* samples, std::size_t n) {
+    append(false, samples, n);
+}
+
+void StreamingMixer::on_mic_audio(const int16_t* samples, std::size_t n, void* mixer) {
+    static_cast<StreamingMixer*>(mixer)->append_mic(samples, n);
+}
+
+void StreamingMixer::on_monitor_audio(const int16_t* samples, std::size_t n, void* mixer) {
+    static_cast<StreamingMixer*>(mixer)->append_monitor(samples, n);
+}
+
+void StreamingMixer::append(bool is_mic, const int16_t* samples, std::size_t n) {
+    if (n == 0) return;
+    std::lock_guard lk(mtx_);
+    if (finished_) return;
+
+    if (is_mic) {
+        mic_samples_ += n;
+        if (mic_) mic_->append(samples, n);
+    } else {
+        monitor_samples_ += n;
+    }
+
+    // Pair the new samples with the other input's backlog, if any.
+    std::size_t avail = pending_.size() - pending_off_;
+    if (avail > 0 && pending_is_mic_ != is_mic) {
+        std::size_t k = std::min(n, avail);
+        const int16_t* p = pending_.data() + pending_off_;
+        if (is_mic) mix_out(samples, p, k);
+        else        mix_out(p, samples, k);
+        pending_off_ += k;
+        samples += k;
+        n -= k;
+        compact_pending();
+    }
+    if (n == 0) return;
+
+    // This input is now ahead: queue the remainder for the other side.
+    if (pending_off_ == pending_.size()) {
+        pending_.clear();
+        pending_off_ = 0;
+        pending_is_mic_ = is_mic;
+    }
+    pending_.insert(pending_.end(), samples, samples + n);
+
+    avail = pending_.size() - pending_off_;
+    if (avail > STREAM_MIX_MAX_SKEW) {
+        // The other capture has stalled. Treat it as silent for the excess
+        // so the backlog stays bounded; when it resumes it lines up with
+        // the current output position.
+        std::size_t excess = avail - STREAM_MIX_MAX_SKEW;
+        if (skew_filled_ == 0)
+            log_warn("mixer: %s input stalled; padding with silence",
+                     is_mic ? "monitor" : "mic");
+        pad_out(pending_is_mic_, pending_.data() + pending_off_, excess);
+        pending_off_ += excess;
+        skew_filled_ += excess;
+        compact_pending();
+    }
+}
+
+void StreamingMixer::mix_out(const int16_t* mic, const int16_t* monitor, std::size_t n) {
+    envelope_.add(mic, monitor, n);
+    while (n > 0) {
+        std::size_t k = std::min(n, scratch_.size());
+        mix_audio_block(mic, k, monitor, k, scratch_.data());
+        mixed_.append(scratch_.data(), k);
+        source_out(mic, monitor, k);
+        mic += k;
+        monitor += k;
+        n -= k;
+    }
+}
+
+void StreamingMixer::pad_out(bool is_mic, const int16_t* samples, std::size_t n) {
+    const int16_t* mic = is_mic ? samples : nullptr;
+    const int16_t* monitor = is_mic ? nullptr : samples;
+    envelope_.add(mic, monitor, n);
+    while (n > 0) {
+        std::size_t k = std::min(n, scratch_.size());
+        mix_audio_block(samples, k, nullptr, 0, scratch_.data());
+        mixed_.append(scratch_.data(), k);
+        source_out(mic, monitor, k);
+        if (mic) mic += k;
+        if (monitor) monitor += k;
+        samples += k;
+        n -= k;
+    }
+}
+
+void StreamingMixer::source_out(const int16_t* mic, const int16_t* monitor, std::size_t n) {
+    if (!sources_) return;
+    for (std::size_t i = 0; i < n; ++i) {
+        frames_[2 * i] = mic ? mic[i] : 0;
+        frames_[2 * i + 1] = monitor ? monitor[i] : 0;
+    }
+    sources_->append(frames_.data(), 2 * n);
+}
+
+void StreamingMixer::compact_pending() {
+    if (pending_off_ == pending_.size()) {
+        pending_.clear();
+        pending_off_ = 0;
+    } else if (pending_off_ >= kCompactThreshold && pending_off_ * 2 >= pending_.size()) {
+        pending_.erase(pending_.begin(), pending_.begin() + pending_off_);
+        pending_off_ = 0;
+    }
+}
+
+StreamingMixResult StreamingMixer::finish() {
+    std::lock_guard lk(mtx_);
+    if (finished_) return result_;
+    finished_ = true;
+
+    // Tail: whichever input ran longer is mixed against silence, exactly as
+    // mix_audio() zero-pads the shorter stream.
+    pad_out(pending_is_mic_, pending_.data() + pending_off_, pending_.size() - pending_off_);
+    pending_.clear();
+    pending_.shrink_to_fit();
+    pending_off_ = 0;
+
+    // Finalize every spool even if one fails, then report the first error.
+    std::string error;
+    auto close = [&error](AudioSpool& spool, SpooledAudio& out) {
+        try {
+            out = spool.finish();
+        } catch (const RecmeetError& e) {
+            if (error.empty()) error = e.what();
+        }
+    };
+    close(mixed_, result_.mixed);
+    if (mic_) close(*mic_, result_.mic);
+    if (sources_) close(*sources_, result_.sources);
+
+    result_.mic_samples = mic_samples_;
+    result_.monitor_samples = monitor_samples_;
+    result_.skew_filled = skew_filled_;
+    result_.envelope = envelope_.finish();
+    log_debug("mixer: finished (mic=%zu, monitor=%zu, mixed=%zu, skew-filled=%zu samples)",
+              mic_samples_, monitor_samples_, result_.mixed.samples, skew_filled_);
+    if (!error.empty())
+        throw RecmeetError(error);
+    return result_;
+}
+
+} // namespace recmeet
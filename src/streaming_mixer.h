@@ -0,0 +1,107 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "audio_spool.h"
+#include "channel_attribution.h"
+#include "util.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace recmeet {
+
+/// Maximum lead one input may build over the other before the lagging side
+/// is treated as silent for the excess — 5 s at 16 kHz. Bounds the mixer's
+/// backlog when one capture stalls; far above any real capture latency, so
+/// normal recordings stay sample-aligned exactly as mix_audio() aligns them.
+constexpr std::size_t STREAM_MIX_MAX_SKEW = SAMPLE_RATE * 5;
+
+/// Result of StreamingMixer::finish().
+struct StreamingMixResult {
+    SpooledAudio mixed;        ///< the mixed meeting audio
+    SpooledAudio mic;          ///< mic stem; empty unless requested
+    SpooledAudio sources;      ///< 2-channel mic / monitor file; empty unless requested
+    std::size_t mic_samples = 0;
+    std::size_t monitor_samples = 0;
+    std::size_t skew_filled = 0;  ///< samples padded with silence due to skew
+    ChannelEnvelope envelope;     ///< per-input levels, aligned with `mixed`
+};
+
+/// Dual-source mixer fed incrementally by the mic and monitor captures
+/// during recording. Each append averages whatever the other input already
+/// has pending (mix_audio_block semantics) and streams the result into a WAV
+/// spool, so stopping a recording only flushes the tail block instead of
+/// holding and mixing full-meeting buffers.
+///
+/// The mic is kept alongside the mix as the fallback output for when the
+/// monitor turns out to be unusable: as a mono stem at `mic_stem`, or — with
+/// `sources_path` (keep_sources) — as the left channel of one interleaved
+/// 2-channel file holding both inputs, sample-aligned as they were mixed
+/// (mic left, monitor right), written in the same pass instead of two more
+/// mono files. Either path may be empty.
+///
+/// `on_mic_audio` / `on_monitor_audio` are AudioChunkCallback-compatible;
+/// wire them with `set_batch_sink()` on the respective captures. They may be
+/// called concurrently from the two capture consumer threads.
+class StreamingMixer {
+public:
+    /// Opens all output spools. Throws RecmeetError on failure.
+    StreamingMixer(const fs::path& mixed_path, const fs::path& mic_stem,
+                   const fs::path& sources_path = {});
+    ~StreamingMixer();
+
+    StreamingMixer(const StreamingMixer&) = delete;
+    StreamingMixer& operator=(const StreamingMixer&) = delete;
+
+    void append_mic(const int16_t* samples, std::size_t n);
+    void append_monitor(const int16_t* samples, std::size_t n);
+
+    static void on_mic_audio(const int16_t* samples, std::size_t n, void* mixer);
+    static void on_monitor_audio(const int16_t* samples, std::size_t n, void* mixer);
+
+    /// The mixed-output spool, for readers trailing the recording (a
+    /// SpoolSampleSource). Valid for the mixer's lifetime.
+    const AudioSpool& mixed_spool() const { return mixed_; }
+
+    /// Mix out the remaining backlog against silence (the zero-pad rule of
+    /// mix_audio), finalize every spool, and return the handles. Call after
+    /// both captures have stopped. Idempotent. Throws RecmeetError if any
+    /// spool failed to write.
+    StreamingMixResult finish();
+
+private:
+    void append(bool is_mic, const int16_t* samples, std::size_t n);
+    void mix_out(const int16_t* mic, const int16_t* monitor, std::size_t n);
+    void pad_out(bool is_mic, const int16_t* samples, std::size_t n);
+    // n <= kMixBlockSamples; a null input is silent.
+    void source_out(const int16_t* mic, const int16_t* monitor, std::size_t n);
+    void compact_pending();
+
+    std::mutex mtx_;
+    AudioSpool mixed_;
+    std::unique_ptr<AudioSpool> mic_;
+    std::unique_ptr<AudioSpool> sources_;
+
+    // Samples from whichever input is currently ahead, not yet mixed. Only
+    // one side can be ahead at a time; `pending_off_` is the read cursor so
+    // partial consumption does not shift the whole vector.
+    std::vector<int16_t> pending_;
+    std::size_t pending_off_ = 0;
+    bool pending_is_mic_ = false;
+
+    std::vector<int16_t> scratch_;  // mix output block
+    std::vector<int16_t> frames_;   // interleaved sources block
+    ChannelEnvelopeBuilder envelope_;
+    std::size_t mic_samples_ = 0;
+    std::size_t monitor_samples_ = 0;
+    std::size_t skew_filled_ = 0;
+    bool finished_ = false;
+    StreamingMixResult result_;
+};
+
+} // namespace recmeet
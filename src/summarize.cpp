@@ -5,27 +5,44 @@
 #include "json_util.h"
 #include "http_client.h"
 #include "log.h"
+#include "model_cache.h"
+#include "model_memory.h"
+#include "perf_counters.h"
+#include "trace.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 
 #if RECMEET_USE_LLAMA
+#include "backend_bench.h"
+#include "backend_info.h"
+#include <gguf.h>
 #include <llama.h>
-#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #endif
 
 namespace recmeet {
 
-std::string build_user_prompt(const std::string& transcript, const std::string& context) {
-    std::ostringstream oss;
-    oss << "Summarize the following meeting transcript.\n\n";
+namespace {
 
+void append_context(std::ostringstream& oss, const std::string& context) {
     if (!context.empty()) {
         oss << "## Pre-Meeting Context\n\n" << context << "\n\n";
     }
+}
 
+void append_summary_format(std::ostringstream& oss) {
     oss << "## Metadata\n\n"
         << "At the very start of your response, before the section headings, "
         << "include these fields, one per line, in exactly this format:\n\n"
@@ -45,12 +62,538 @@ std::string build_user_prompt(const std::string& transcript, const std::string&
         << "### Open Questions\n"
         << "Bullet list of unresolved questions or topics deferred to a future meeting.\n\n"
         << "### Participants\n"
-        << "List of identifiable speakers/participants (if discernible from context).\n\n"
-        << "---\n\n## Transcript\n\n" << transcript;
+        << "List of identifiable speakers/participants (if discernible from context).\n\n";
+}
+
+// The headings a part's notes are kept under, so merged notes and the
+// final summary can be assembled section by section.
+void append_notes_format(std::ostringstream& oss) {
+    oss << "Use exactly these headings, and write 'None identified.' under any that "
+        << "has nothing:\n\n"
+        << "### Key Points\n"
+        << "### Decisions\n"
+        << "### Action Items\n"
+        << "Formatted as: **[Owner]** — task description (deadline if mentioned).\n"
+        << "### Open Questions\n"
+        << "### Participants\n\n"
+        << "Do not write a title, metadata or overview.\n\n";
+}
+
+void append_notes(std::ostringstream& oss, const std::vector<std::string>& notes,
+                  size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i)
+        oss << "### Notes " << (i - first + 1) << " of " << (last - first) << "\n\n"
+            << notes[i] << "\n\n";
+}
+
+// "Speaker_01" of "[00:05 - 00:09] Speaker_01: text"; empty when the line
+// has no label.
+std::string line_speaker(const std::string& line, size_t begin, size_t end) {
+    size_t at = begin;
+    if (at < end && line[at] == '[') {
+        at = line.find("] ", at);
+        if (at == std::string::npos || at >= end) return {};
+        at += 2;
+    }
+    const size_t colon = line.find(':', at);
+    if (colon == std::string::npos || colon >= end || colon - at > 64) return {};
+    return line.substr(at, colon - at);
+}
+
+} // anonymous namespace
+
+namespace {
+
+// Label of the line [begin, end) that a diarized transcript puts there:
+// line_speaker(), without the free text a plain line may have before a
+// colon (it follows the timestamp's space, so it starts with another).
+std::string line_label(const std::string& t, size_t begin, size_t end) {
+    std::string label = line_speaker(t, begin, end);
+    if (label.empty() || std::isspace(static_cast<unsigned char>(label[0]))) return {};
+    return label;
+}
+
+// Calls `fn(begin, end)` for each line of `t`, the newline excluded.
+template <typename Fn>
+void for_each_line(const std::string& t, Fn fn) {
+    for (size_t pos = 0; pos < t.size();) {
+        size_t nl = t.find('\n', pos);
+        if (nl == std::string::npos) nl = t.size();
+        fn(pos, nl);
+        pos = nl + 1;
+    }
+}
+
+bool word_byte(char c) {
+    const auto u = static_cast<unsigned char>(c);
+    return std::isalnum(u) || c == '_' || u >= 0x80;  // a UTF-8 name is one word
+}
+
+} // anonymous namespace
+
+std::vector<std::string> transcript_speakers(const std::string& transcript) {
+    std::vector<std::string> speakers;
+    for_each_line(transcript, [&](size_t begin, size_t end) {
+        std::string label = line_label(transcript, begin, end);
+        if (!label.empty() &&
+            std::find(speakers.begin(), speakers.end(), label) == speakers.end())
+            speakers.push_back(std::move(label));
+    });
+    return speakers;
+}
 
+std::string anonymize_speakers(const std::string& transcript) {
+    std::vector<std::string> speakers;
+    std::string out;
+    out.reserve(transcript.size());
+    for_each_line(transcript, [&](size_t begin, size_t end) {
+        const std::string label = line_label(transcript, begin, end);
+        if (label.empty()) {
+            out.append(transcript, begin, end - begin);
+        } else {
+            auto it = std::find(speakers.begin(), speakers.end(), label);
+            if (it == speakers.end()) it = speakers.insert(speakers.end(), label);
+            // line_speaker() found it right after the timestamp, if any.
+            const size_t at = transcript[begin] == '[' ? transcript.find("] ", begin) + 2 : begin;
+            out.append(transcript, begin, at - begin);
+            out += "#" + std::to_string(it - speakers.begin() + 1);
+            out.append(transcript, at + label.size(), end - at - label.size());
+        }
+        if (end < transcript.size()) out += '\n';
+    });
+    return out;
+}
+
+std::string rename_speakers(const std::string& text, const std::vector<std::string>& from,
+                            const std::vector<std::string>& to) {
+    const size_t n = std::min(from.size(), to.size());
+    // Longest first, so "Bob Smith" wins over "Bob".
+    std::vector<size_t> order;
+    for (size_t i = 0; i < n; ++i)
+        if (!from[i].empty() && from[i] != to[i]) order.push_back(i);
+    if (order.empty()) return text;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return from[a].size() > from[b].size(); });
+
+    std::string out;
+    out.reserve(text.size());
+    for (size_t pos = 0; pos < text.size();) {
+        bool replaced = false;
+        if (pos == 0 || !word_byte(text[pos - 1])) {
+            for (size_t i : order) {
+                const std::string& name = from[i];
+                const size_t after = pos + name.size();
+                if (text.compare(pos, name.size(), name) == 0 &&
+                    (after == text.size() || !word_byte(text[after]))) {
+                    out += to[i];
+                    pos = after;
+                    replaced = true;
+                    break;
+                }
+            }
+        }
+        if (!replaced) out += text[pos++];
+    }
+    return out;
+}
+
+namespace {
+
+// Seconds of a "[MM:SS" or "[HH:MM:SS" timestamp at `at`; -1 if none.
+double parse_line_time(const std::string& t, size_t at, size_t end) {
+    double sec = 0;
+    int fields = 0;
+    size_t i = at;
+    for (; i < end && fields < 3; ++fields) {
+        if (!std::isdigit(static_cast<unsigned char>(t[i]))) return -1;
+        double v = 0;
+        while (i < end && std::isdigit(static_cast<unsigned char>(t[i])))
+            v = v * 10 + (t[i++] - '0');
+        sec = sec * 60 + v;
+        if (i >= end || t[i] != ':') break;
+        ++i;
+    }
+    return fields >= 1 ? sec : -1;
+}
+
+// A word's letters and digits, lowercased, for comparing repeats.
+std::string fold_word(const std::string& w) {
+    std::string out;
+    for (char c : w) {
+        const auto u = static_cast<unsigned char>(c);
+        if (std::isalnum(u) || u >= 0x80) out += static_cast<char>(std::tolower(u));
+    }
+    return out;
+}
+
+bool filler_word(const std::string& folded) {
+    static const char* const kFillers[] = {"um", "umm", "uh", "uhh", "uhm", "erm", "hmm", "mm", "mhm"};
+    for (const char* f : kFillers)
+        if (folded == f) return true;
+    return false;
+}
+
+// One speaker turn being compacted.
+struct CompactTurn {
+    std::string stamp;    // "[MM:SS]" of its first line, or empty
+    double start = -1;    // its seconds, -1 without a timestamp
+    std::string label;    // speaker label, or empty
+    std::vector<std::string> words;
+    std::vector<std::string> folded;
+    size_t run = 0;         // repeats of the last word seen right after it
+    std::string last_line;  // folded text of its last line, for exact repeats
+};
+
+// Append `text`'s words to `turn`, leaving out fillers, whisper's
+// bracketed non-speech tags, a word said three or more times in a row
+// (kept once) and an immediately repeated phrase of 2-8 words.
+void append_words(CompactTurn& turn, const std::string& text, CompactionStats& stats) {
+    std::istringstream in(text);
+    std::string w;
+    while (in >> w) {
+        if (w.size() > 1 && (w.front() == '[' || w.front() == '(') &&
+            (w.back() == ']' || w.back() == ')')) {
+            ++stats.fillers;
+            continue;
+        }
+        std::string f = fold_word(w);
+        if (filler_word(f)) {
+            ++stats.fillers;
+            continue;
+        }
+        if (!f.empty() && !turn.folded.empty() && turn.folded.back() == f) {
+            if (++turn.run >= 2) {
+                // The third in a row: the doubled word goes too.
+                if (turn.run == 2) {
+                    turn.words.pop_back();
+                    turn.folded.pop_back();
+                    ++stats.repeats;
+                }
+                ++stats.repeats;
+                continue;
+            }
+        } else {
+            turn.run = 0;
+        }
+        turn.words.push_back(std::move(w));
+        turn.folded.push_back(std::move(f));
+        for (size_t len = 2; len <= 8 && 2 * len <= turn.folded.size(); ++len) {
+            const size_t tail = turn.folded.size() - len;
+            bool same = true;
+            for (size_t k = 0; k < len && same; ++k)
+                same = !turn.folded[tail + k].empty() &&
+                       turn.folded[tail + k] == turn.folded[tail - len + k];
+            if (!same) continue;
+            turn.words.resize(tail);
+            turn.folded.resize(tail);
+            turn.run = 0;
+            ++stats.repeats;
+            break;
+        }
+    }
+}
+
+void flush_turn(CompactTurn& turn, std::string& out, CompactionStats& stats) {
+    if (turn.words.empty() && turn.label.empty() && turn.stamp.empty()) return;
+    if (!turn.words.empty()) {
+        if (!turn.stamp.empty()) out += turn.stamp + " ";
+        if (!turn.label.empty()) out += turn.label + ": ";
+        for (size_t i = 0; i < turn.words.size(); ++i) {
+            if (i > 0) out += ' ';
+            out += turn.words[i];
+        }
+        out += '\n';
+        ++stats.turns;
+    }
+    turn = CompactTurn{};
+}
+
+} // anonymous namespace
+
+std::string compact_transcript(const std::string& transcript, CompactionStats* stats_out) {
+    CompactionStats stats;
+    stats.chars_in = transcript.size();
+    std::string out;
+    out.reserve(transcript.size());
+    CompactTurn turn;
+    for_each_line(transcript, [&](size_t begin, size_t end) {
+        ++stats.lines;
+        size_t at = begin;
+        std::string stamp;
+        double start = -1;
+        if (at < end && transcript[at] == '[') {
+            const size_t close = transcript.find("] ", at);
+            if (close != std::string::npos && close < end) {
+                start = parse_line_time(transcript, at + 1, close);
+                if (start >= 0) {
+                    const size_t dash = transcript.find(" - ", at);
+                    stamp = transcript.substr(at, (dash < close ? dash : close) - at) + "]";
+                    at = close + 2;
+                }
+            }
+        }
+        if (start < 0) {
+            // Not a segment line (a heading, a blank line): kept as it is.
+            flush_turn(turn, out, stats);
+            out.append(transcript, begin, end - begin);
+            if (end < transcript.size()) out += '\n';
+            return;
+        }
+        std::string label = line_label(transcript, begin, end);
+        if (!label.empty()) at += label.size() + 1;
+        const std::string text = transcript.substr(at, end - at);
+
+        if (label != turn.label || turn.stamp.empty() ||
+            (turn.start >= 0 && start - turn.start >= COMPACT_TURN_MAX_SEC)) {
+            flush_turn(turn, out, stats);
+            turn.stamp = stamp;
+            turn.start = start;
+            turn.label = label;
+        }
+        std::string folded;
+        std::istringstream words(text);
+        for (std::string w; words >> w;) folded += fold_word(w) + " ";
+        if (!folded.empty() && folded == turn.last_line) {
+            ++stats.repeats;
+            return;
+        }
+        turn.last_line = folded;
+        append_words(turn, text, stats);
+    });
+    flush_turn(turn, out, stats);
+    stats.chars_out = out.size();
+    if (stats_out) *stats_out = stats;
+    return out;
+}
+
+std::string build_user_prompt(const std::string& transcript, const std::string& context) {
+    std::ostringstream oss;
+    oss << "Summarize the following meeting transcript.\n\n";
+    append_context(oss, context);
+    append_summary_format(oss);
+    oss << "---\n\n## Transcript\n\n" << transcript;
     return oss.str();
 }
 
+std::string build_chunk_prompt(const std::string& chunk, size_t index, size_t count,
+                               const std::string& context) {
+    std::ostringstream oss;
+    oss << "The following is part " << index + 1 << " of " << count
+        << " of a meeting transcript. Write notes on this part only; they will be "
+        << "combined with the notes on the other parts into one summary.\n\n";
+    append_context(oss, context);
+    append_notes_format(oss);
+    oss << "---\n\n## Transcript (part " << index + 1 << " of " << count << ")\n\n" << chunk;
+    return oss.str();
+}
+
+std::string build_merge_prompt(const std::vector<std::string>& notes) {
+    std::ostringstream oss;
+    oss << "The following are notes on consecutive parts of one meeting, in order. "
+        << "Merge them into one set of notes, combining repeated points and keeping "
+        << "every decision and action item.\n\n";
+    append_notes_format(oss);
+    oss << "---\n\n";
+    append_notes(oss, notes, 0, notes.size());
+    return oss.str();
+}
+
+std::string build_reduce_prompt(const std::vector<std::string>& notes,
+                                const std::string& context) {
+    std::ostringstream oss;
+    oss << "Summarize the following meeting from notes on its consecutive parts, "
+        << "in order. The notes together cover the whole meeting.\n\n";
+    append_context(oss, context);
+    append_summary_format(oss);
+    oss << "---\n\n## Notes\n\n";
+    append_notes(oss, notes, 0, notes.size());
+    return oss.str();
+}
+
+std::string build_rolling_prompt(const std::string& previous, const std::string& new_text,
+                                 const std::string& context) {
+    std::ostringstream oss;
+    if (previous.empty()) {
+        oss << "The following is the start of a meeting that is still going on. Write "
+            << "notes on it; they will be updated as the meeting continues.\n\n";
+    } else {
+        oss << "The following are notes on a meeting that is still going on, and the "
+            << "transcript since they were written. Update the notes with the new "
+            << "transcript: add its points, revise decisions and action items it changes, "
+            << "drop open questions it settles, and keep each section short.\n\n";
+    }
+    append_context(oss, context);
+    append_notes_format(oss);
+    oss << "---\n\n";
+    if (!previous.empty()) oss << "## Notes so far\n\n" << previous << "\n\n";
+    oss << "## Transcript" << (previous.empty() ? "" : " since") << "\n\n" << new_text;
+    return oss.str();
+}
+
+std::string build_refine_prompt(const std::string& notes, const std::string& tail,
+                                const std::string& context) {
+    std::ostringstream oss;
+    oss << "Summarize the following meeting from notes taken while it ran and the "
+        << "transcript of its final part, which the notes do not cover yet. Together "
+        << "they cover the whole meeting.\n\n";
+    append_context(oss, context);
+    append_summary_format(oss);
+    oss << "---\n\n## Notes\n\n" << notes << "\n\n## Transcript (final part)\n\n"
+        << (tail.empty() ? "None.\n" : tail);
+    return oss.str();
+}
+
+std::vector<std::string> split_transcript(const std::string& transcript, size_t max_chars) {
+    std::vector<std::string> parts;
+    if (transcript.empty()) return parts;
+    if (max_chars == 0 || transcript.size() <= max_chars) {
+        parts.push_back(transcript);
+        return parts;
+    }
+
+    std::string cur;
+    size_t turn_at = 0;  // where the last change of speaker starts in `cur`
+    std::string last_speaker;
+    auto cut = [&](size_t at) {
+        parts.push_back(cur.substr(0, at));
+        cur.erase(0, at);
+        turn_at = 0;
+    };
+
+    size_t pos = 0;
+    while (pos < transcript.size()) {
+        size_t nl = transcript.find('\n', pos);
+        const size_t end = nl == std::string::npos ? transcript.size() : nl + 1;
+        const std::string speaker = line_speaker(transcript, pos, end);
+        const size_t len = end - pos;
+
+        while (!cur.empty() && cur.size() + len > max_chars)
+            cut(turn_at > max_chars / 2 ? turn_at : cur.size());
+        if (!speaker.empty() && speaker != last_speaker) {
+            if (!cur.empty()) turn_at = cur.size();
+            last_speaker = speaker;
+        }
+
+        if (len <= max_chars) {
+            cur.append(transcript, pos, len);
+        } else {
+            // One line longer than a part: split it at spaces.
+            size_t at = pos;
+            while (at < end) {
+                size_t stop = std::min(end, at + max_chars - cur.size());
+                if (stop < end) {
+                    const size_t space = transcript.rfind(' ', stop);
+                    if (space != std::string::npos && space > at) stop = space + 1;
+                }
+                cur.append(transcript, at, stop - at);
+                at = stop;
+                if (at < end) cut(cur.size());
+            }
+        }
+        pos = end;
+    }
+    if (!cur.empty()) parts.push_back(cur);
+    return parts;
+}
+
+namespace {
+
+std::atomic<SummaryCheckpoint*> g_summary_checkpoint{nullptr};
+
+} // anonymous namespace
+
+void set_summary_checkpoint(SummaryCheckpoint* checkpoint) {
+    g_summary_checkpoint.store(checkpoint);
+}
+
+std::string summarize_map_reduce(
+    const std::string& transcript, const std::string& context, size_t max_chars,
+    const std::function<std::string(const std::string&)>& complete, int parallel,
+    const std::function<std::string(const std::string&)>& final_complete) {
+    const auto& last = final_complete ? final_complete : complete;
+    const auto parts = split_transcript(transcript, max_chars);
+    if (parts.size() <= 1) return last(build_user_prompt(transcript, context));
+
+    // A map or merge step the checkpoint holds is not asked again.
+    SummaryCheckpoint* checkpoint = g_summary_checkpoint.load();
+    auto step = [&](const std::string& prompt) {
+        std::string response;
+        if (checkpoint && checkpoint->find(prompt, response)) return response;
+        response = complete(prompt);
+        if (checkpoint) checkpoint->put(prompt, response);
+        return response;
+    };
+
+    // Run `prompts` through `complete`, `parallel` at a time, in order.
+    auto run_all = [&](const std::vector<std::string>& prompts) {
+        std::vector<std::string> out(prompts.size());
+        std::atomic<size_t> next{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr first_error;
+        std::mutex error_mu;
+        auto work = [&] {
+            while (!failed.load(std::memory_order_relaxed)) {
+                const size_t i = next.fetch_add(1);
+                if (i >= prompts.size()) return;
+                try {
+                    out[i] = step(prompts[i]);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mu);
+                    if (!first_error) first_error = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);
+                    return;
+                }
+            }
+        };
+        const size_t n = std::min(prompts.size(), static_cast<size_t>(std::max(1, parallel)));
+        std::vector<std::thread> pool;
+        for (size_t w = 1; w < n; ++w) pool.emplace_back(work);
+        work();
+        for (auto& t : pool) t.join();
+        if (first_error) std::rethrow_exception(first_error);
+        return out;
+    };
+
+    log_info("Summary: map over %zu parts of up to %zu chars", parts.size(), max_chars);
+    std::vector<std::string> prompts;
+    for (size_t i = 0; i < parts.size(); ++i)
+        prompts.push_back(build_chunk_prompt(parts[i], i, parts.size(), context));
+    std::vector<std::string> notes = run_all(prompts);
+
+    // Merge consecutive notes until they fit one prompt. Every group but
+    // the last holds at least two, so each round shrinks the list.
+    auto total = [](const std::vector<std::string>& v) {
+        size_t n = 0;
+        for (const auto& x : v) n += x.size();
+        return n;
+    };
+    while (notes.size() > 1 && total(notes) > max_chars) {
+        std::vector<std::vector<std::string>> groups;
+        size_t group_chars = 0;
+        for (auto& note : notes) {
+            if (groups.empty() ||
+                (groups.back().size() >= 2 && group_chars + note.size() > max_chars)) {
+                groups.emplace_back();
+                group_chars = 0;
+            }
+            group_chars += note.size();
+            groups.back().push_back(std::move(note));
+        }
+        log_info("Summary: merging %zu notes into %zu", notes.size(), groups.size());
+        std::vector<std::string> merges;
+        for (const auto& g : groups)
+            if (g.size() > 1) merges.push_back(build_merge_prompt(g));
+        auto merged = run_all(merges);
+        notes.clear();
+        size_t m = 0;
+        for (auto& g : groups)
+            notes.push_back(g.size() > 1 ? std::move(merged[m++]) : std::move(g.front()));
+    }
+
+    log_info("Summary: reducing %zu notes", notes.size());
+    return last(build_reduce_prompt(notes, context));
+}
+
 namespace {
 
 const char* SYSTEM_PROMPT =
@@ -60,12 +603,49 @@ const char* SYSTEM_PROMPT =
 
 } // anonymous namespace
 
-std::string summarize_http(const std::string& transcript,
-                            const std::string& api_url,
-                            const std::string& api_key,
-                            const std::string& model,
-                            const std::string& context) {
-    std::string user_prompt = build_user_prompt(transcript, context);
+const char* summary_system_prompt() { return SYSTEM_PROMPT; }
+
+namespace {
+
+// The string value of the first `"content"` key in `json`; empty when it
+// is absent or not a string (`"content":null` in a role-only chunk).
+std::string content_field(const std::string& json) {
+    const auto key = json.find("\"content\"");
+    if (key == std::string::npos) return "";
+    size_t pos = key + 9;
+    while (pos < json.size() && (json[pos] == ' ' || json[pos] == ':')) ++pos;
+    if (pos >= json.size() || json[pos] != '"') return "";
+    return json_extract_string(json.substr(key), "content");
+}
+
+} // anonymous namespace
+
+std::string consume_sse_deltas(std::string& buffer, bool& done) {
+    std::string text;
+    size_t pos = 0, nl;
+    while (!done && (nl = buffer.find('\n', pos)) != std::string::npos) {
+        std::string line = buffer.substr(pos, nl - pos);
+        pos = nl + 1;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.compare(0, 5, "data:") != 0) continue;  // blank, comment or event:
+        size_t at = 5;
+        while (at < line.size() && line[at] == ' ') ++at;
+        if (line.compare(at, std::string::npos, "[DONE]") == 0)
+            done = true;
+        else
+            text += content_field(line.substr(at));
+    }
+    buffer.erase(0, pos);
+    return text;
+}
+
+namespace {
+
+std::string complete_http(const std::string& user_prompt,
+                          const std::string& api_url,
+                          const std::string& api_key,
+                          const std::string& model,
+                          const SummaryDeltaCallback& on_delta = nullptr) {
 
     // Build JSON request body
     std::ostringstream json;
@@ -76,8 +656,9 @@ std::string summarize_http(const std::string& transcript,
          << "{\"role\":\"user\",\"content\":\"" << json_escape(user_prompt) << "\"}"
          << "],"
          << "\"temperature\":0.3,"
-         << "\"max_tokens\":4096"
-         << "}";
+         << "\"max_tokens\":4096";
+    if (on_delta) json << ",\"stream\":true";
+    json << "}";
 
     log_info("Requesting summary from %s (model: %s)...", api_url.c_str(), model.c_str());
 
@@ -85,107 +666,545 @@ std::string summarize_http(const std::string& transcript,
         {"Authorization", "Bearer " + api_key},
     };
 
-    std::string response = http_post_json(api_url, json.str(), headers);
+    if (!on_delta) {
+        std::string response = http_post_json(api_url, json.str(), headers);
+
+        // Extract content from OpenAI-compatible response
+        std::string content = json_extract_string(response, "content");
+        if (content.empty())
+            throw RecmeetError("Empty summary response from API");
 
-    // Extract content from OpenAI-compatible response
-    std::string content = json_extract_string(response, "content");
+        return content;
+    }
+
+    std::string content, pending;
+    bool done = false;
+    const std::string response = http_post_json_stream(
+        api_url, json.str(), headers, [&](const char* data, size_t len) {
+            pending.append(data, len);
+            const std::string delta = consume_sse_deltas(pending, done);
+            if (!delta.empty()) {
+                content += delta;
+                on_delta(delta);
+            }
+        });
+    // A provider that ignores "stream" answers with one plain completion.
+    if (content.empty() && response.find("data:") == std::string::npos) {
+        content = json_extract_string(response, "content");
+        if (!content.empty()) on_delta(content);
+    }
     if (content.empty())
         throw RecmeetError("Empty summary response from API");
 
     return content;
 }
 
+} // anonymous namespace
+
+SummaryCompleter http_summary_completer(const std::string& api_url, const std::string& api_key,
+                                        const std::string& model) {
+    return [=](const std::string& p, const SummaryDeltaCallback& on_delta) {
+        return complete_http(p, api_url, api_key, model, on_delta);
+    };
+}
+
+std::string summarize_http(const std::string& transcript,
+                            const std::string& api_url,
+                            const std::string& api_key,
+                            const std::string& model,
+                            const std::string& context,
+                            int chunk_tokens,
+                            const SummaryDeltaCallback& on_delta) {
+    const int tokens = chunk_tokens > 0 ? chunk_tokens : HTTP_SUMMARY_CHUNK_TOKENS;
+    const size_t max_prompt_chars = static_cast<size_t>(tokens) * SUMMARY_CHARS_PER_TOKEN;
+    auto complete = [&](const std::string& p) {
+        return complete_http(p, api_url, api_key, model);
+    };
+    auto complete_streamed = [&](const std::string& p) {
+        return complete_http(p, api_url, api_key, model, on_delta);
+    };
+
+    std::string user_prompt = build_user_prompt(transcript, context);
+    if (user_prompt.size() <= max_prompt_chars)
+        return complete_streamed(user_prompt);
+
+    // Leave the instructions their room in every part's prompt.
+    const size_t overhead = std::max(build_chunk_prompt("", 99, 99, context).size(),
+                                     build_reduce_prompt({}, context).size());
+    const size_t max_chars = max_prompt_chars > 2 * overhead ? max_prompt_chars - overhead
+                                                             : max_prompt_chars / 2;
+    log_info("Transcript (~%zu tokens) exceeds one request (%d); summarizing in parts",
+             transcript.size() / SUMMARY_CHARS_PER_TOKEN, tokens);
+    return summarize_map_reduce(transcript, context, max_chars, complete,
+                                HTTP_SUMMARY_PARALLEL, complete_streamed);
+}
+
+uint32_t local_context_tokens(int prompt_tokens, int generation_tokens, uint32_t cap) {
+    const int64_t need = static_cast<int64_t>(std::max(prompt_tokens, 0)) +
+                         std::max(generation_tokens, 0);
+    const int64_t rounded = (need + 255) / 256 * 256;
+    return static_cast<uint32_t>(std::min<int64_t>(rounded, cap));
+}
+
+int fit_gpu_layers(int n_layers, uint64_t layer_bytes, uint64_t free_bytes,
+                   uint64_t reserve_bytes) {
+    if (n_layers <= 0 || layer_bytes == 0 || free_bytes <= reserve_bytes) return 0;
+    const uint64_t fit = (free_bytes - reserve_bytes) / layer_bytes;
+    return static_cast<int>(std::min<uint64_t>(fit, static_cast<uint64_t>(n_layers) + 1));
+}
+
 #if RECMEET_USE_LLAMA
-std::string summarize_local(const std::string& transcript,
-                             const fs::path& model_path,
-                             const std::string& context,
-                             int threads,
-                             bool use_mmap) {
-    log_info("Loading LLM model: %s (mmap: %s)",
-             model_path.filename().c_str(), use_mmap ? "on" : "off");
+namespace {
+
+// VRAM left to the backend for compute buffers and the driver when the
+// offload is sized automatically.
+constexpr uint64_t GPU_RESERVE_BYTES = 512ull << 20;
+
+// What sizing an offload needs from a GGUF, read from its metadata
+// without loading tensors.
+struct GgufShape {
+    int n_layers = 0;
+    uint32_t n_ctx_train = 0;
+    uint64_t kv_values_per_token = 0;  // per layer, K and V together
+    uint64_t file_bytes = 0;
+};
 
-    llama_backend_init();
+bool read_gguf_shape(const fs::path& path, GgufShape& shape) {
+    gguf_init_params params{};
+    params.no_alloc = true;
+    params.ctx = nullptr;
+    gguf_context* ctx = gguf_init_from_file(path.c_str(), params);
+    if (!ctx) return false;
+    auto u32 = [&](const std::string& key, uint32_t fallback) {
+        const int64_t id = gguf_find_key(ctx, key.c_str());
+        return id >= 0 && gguf_get_kv_type(ctx, id) == GGUF_TYPE_UINT32
+            ? gguf_get_val_u32(ctx, id) : fallback;
+    };
+    const int64_t arch_id = gguf_find_key(ctx, "general.architecture");
+    const std::string arch = arch_id >= 0 && gguf_get_kv_type(ctx, arch_id) == GGUF_TYPE_STRING
+        ? gguf_get_val_str(ctx, arch_id) : "";
+    if (!arch.empty()) {
+        shape.n_layers = static_cast<int>(u32(arch + ".block_count", 0));
+        shape.n_ctx_train = u32(arch + ".context_length", 0);
+        const uint32_t n_embd = u32(arch + ".embedding_length", 0);
+        const uint32_t n_head = u32(arch + ".attention.head_count", 0);
+        // A per-layer head count (an array) falls back to all heads.
+        const uint32_t n_head_kv = u32(arch + ".attention.head_count_kv", n_head);
+        const uint32_t head_dim = n_head ? n_embd / n_head : 0;
+        shape.kv_values_per_token = static_cast<uint64_t>(n_head_kv) *
+            (u32(arch + ".attention.key_length", head_dim) +
+             u32(arch + ".attention.value_length", head_dim));
+    }
+    gguf_free(ctx);
+    std::error_code ec;
+    shape.file_bytes = fs::file_size(path, ec);
+    return shape.n_layers > 0 && !ec;
+}
 
-    llama_model_params model_params = llama_model_default_params();
-    model_params.use_mmap = use_mmap;
-    llama_model* model = llama_model_load_from_file(model_path.c_str(), model_params);
-    if (!model) {
+// Layers of `model_path` to put on the GPU: `requested` when it is set,
+// else as many as fit the active device's free memory with their KV cells
+// at `ctx_cap` tokens of `kv_bytes_per_value`. 0 without a GPU device.
+int resolve_gpu_layers(const fs::path& model_path, int requested, uint32_t ctx_cap,
+                       double kv_bytes_per_value) {
+    if (requested == 0) return 0;
+    size_t free_bytes = 0, total_bytes = 0;
+    if (!active_gpu_memory(free_bytes, total_bytes)) {
+        log_info("LLM: no GPU device; running %s on the CPU", model_path.filename().c_str());
+        return 0;
+    }
+    if (requested > 0) return requested;
+    GgufShape shape;
+    if (!read_gguf_shape(model_path, shape)) {
+        log_warn("LLM: could not read %s metadata to size the GPU offload; running on the CPU",
+                 model_path.filename().c_str());
+        return 0;
+    }
+    const uint32_t n_ctx = shape.n_ctx_train ? std::min(shape.n_ctx_train, ctx_cap) : ctx_cap;
+    // The embedding and output tensors count as one more layer.
+    const uint64_t layer_bytes = shape.file_bytes / (shape.n_layers + 1) +
+        static_cast<uint64_t>(shape.kv_values_per_token * n_ctx * kv_bytes_per_value);
+    const int n = fit_gpu_layers(shape.n_layers, layer_bytes, free_bytes, GPU_RESERVE_BYTES);
+    log_info("LLM: offloading %d of %d layers of %s to the GPU (%zu of %zu MB free)", n,
+             shape.n_layers + 1, model_path.filename().c_str(), free_bytes >> 20,
+             total_bytes >> 20);
+    return n;
+}
+
+// A loaded llama model together with the backend reference it holds.
+class LlamaModel {
+public:
+    // `gpu_layers` layers go to the GPU backends; a load that fails with
+    // some there is retried on the CPU.
+    LlamaModel(const fs::path& model_path, bool use_mmap, int gpu_layers = 0) {
+        log_info("Loading LLM model: %s (mmap: %s, GPU layers: %d)",
+                 model_path.filename().c_str(), use_mmap ? "on" : "off", gpu_layers);
+        ensure_backends();
+        llama_backend_init();
+        llama_model_params model_params = llama_model_default_params();
+        model_params.use_mmap = use_mmap;
+        model_params.n_gpu_layers = gpu_layers;
+        memory_.begin("llama " + model_path.filename().string(), {model_path});
+        model_ = llama_model_load_from_file(model_path.c_str(), model_params);
+        if (!model_ && gpu_layers != 0) {
+            log_warn("Loading %s with %d GPU layers failed; loading it on the CPU",
+                     model_path.filename().c_str(), gpu_layers);
+            model_params.n_gpu_layers = 0;
+            model_ = llama_model_load_from_file(model_path.c_str(), model_params);
+        }
+        if (!model_) {
+            llama_backend_free();
+            throw RecmeetError("Failed to load LLM model: " + model_path.string());
+        }
+        memory_.finish();
+    }
+    ~LlamaModel() {
+        llama_model_free(model_);
         llama_backend_free();
-        throw RecmeetError("Failed to load LLM model: " + model_path.string());
     }
+    LlamaModel(const LlamaModel&) = delete;
+    LlamaModel& operator=(const LlamaModel&) = delete;
 
-    // Use model's native context size, capped to avoid OOM on CPU inference
-    constexpr uint32_t MAX_LOCAL_CTX = 32768;
-    constexpr int GENERATION_BUDGET = 4096;
+    llama_model* get() const { return model_; }
 
-    int32_t model_ctx = llama_model_n_ctx_train(model);
-    uint32_t n_ctx = std::min(static_cast<uint32_t>(model_ctx), MAX_LOCAL_CTX);
+    // Seq 0's KV cells after `tokens` were decoded: the chat-template head
+    // and system prompt every summary starts with. Kept only while the
+    // model is resident, so the next meeting prefills its transcript alone.
+    struct PrefixCache {
+        std::vector<llama_token> tokens;
+        std::vector<uint8_t> state;
+    };
+    std::mutex prefix_mu;
+    PrefixCache prefix;  // guarded by prefix_mu
 
-    llama_context_params ctx_params = llama_context_default_params();
-    ctx_params.n_ctx = n_ctx;
-    ctx_params.n_batch = n_ctx;  // allow full-prompt decode in a single batch
-    ctx_params.n_threads = threads > 0 ? threads : default_thread_count();
+private:
+    llama_model* model_ = nullptr;
+    ModelMemory memory_;
+};
 
-    llama_context* ctx = llama_init_from_model(model, ctx_params);
-    if (!ctx) {
-        llama_model_free(model);
-        llama_backend_free();
-        throw RecmeetError("Failed to create LLM context");
+// The LLM slot's model, for local_summary_prefix_tokens().
+std::mutex g_last_model_mu;
+std::weak_ptr<LlamaModel> g_last_model;  // guarded by g_last_model_mu
+
+// Cache key of a llama model: the offload as requested, not as resolved,
+// since the free VRAM it is resolved from shrinks once the model is loaded.
+std::string llama_model_key(const fs::path& model_path, bool use_mmap, int gpu_layers) {
+    return model_path.string() + (use_mmap ? "#mmap" : "") +
+           (gpu_layers != 0 ? "#gpu" + std::to_string(gpu_layers) : "");
+}
+
+// `gpu_layers` as in LlmMemoryProfile; `ctx_cap` and `kv_bytes_per_value`
+// size the KV cells an automatic offload leaves room for.
+std::shared_ptr<LlamaModel> acquire_llama_model(const fs::path& model_path, bool use_mmap,
+                                                int gpu_layers, uint32_t ctx_cap,
+                                                double kv_bytes_per_value) {
+    static ModelSlot<LlamaModel> slot{"llama"};
+    bool loaded = false;
+    auto model = slot.get(llama_model_key(model_path, use_mmap, gpu_layers), [&] {
+        loaded = true;
+        return std::make_unique<LlamaModel>(
+            model_path, use_mmap,
+            resolve_gpu_layers(model_path, gpu_layers, ctx_cap, kv_bytes_per_value));
+    });
+    if (!loaded)
+        log_info("LLM model already loaded: %s", model_path.filename().c_str());
+    {
+        std::lock_guard<std::mutex> lock(g_last_model_mu);
+        g_last_model = model;
     }
+    return model;
+}
 
-    uint32_t actual_ctx = llama_n_ctx(ctx);
-    log_info("Context: %u tokens (model native: %d, cap: %u)",
-            actual_ctx, model_ctx, MAX_LOCAL_CTX);
+// The speculative draft model has a slot of its own, so it stays resident
+// next to the main model instead of evicting it. Unless offload is off, it
+// takes as many layers as fit the memory the main model left.
+std::shared_ptr<LlamaModel> acquire_draft_model(const fs::path& model_path, bool use_mmap,
+                                                int gpu_layers, uint32_t ctx_cap,
+                                                double kv_bytes_per_value) {
+    static ModelSlot<LlamaModel> slot{"llama"};
+    const int requested = gpu_layers == 0 ? 0 : -1;
+    return slot.get(llama_model_key(model_path, use_mmap, requested), [&] {
+        return std::make_unique<LlamaModel>(
+            model_path, use_mmap,
+            resolve_gpu_layers(model_path, requested, ctx_cap, kv_bytes_per_value));
+    });
+}
 
-    // Build prompt using model's chat template
-    std::string user_prompt = build_user_prompt(transcript, context);
-    const char* tmpl = llama_model_chat_template(model, nullptr);
+} // anonymous namespace
 
-    llama_chat_message messages[] = {
-        {"system", SYSTEM_PROMPT},
-        {"user",   user_prompt.c_str()},
-    };
+size_t local_summary_prefix_tokens() {
+    std::shared_ptr<LlamaModel> model;
+    {
+        std::lock_guard<std::mutex> lock(g_last_model_mu);
+        model = g_last_model.lock();
+    }
+    if (!model) return 0;
+    std::lock_guard<std::mutex> lock(model->prefix_mu);
+    return model->prefix.tokens.size();
+}
+
+namespace {
+
+// Use model's native context size, capped to avoid OOM on CPU inference
+constexpr uint32_t MAX_LOCAL_CTX = 32768;
+constexpr int GENERATION_BUDGET = 4096;
+// Tokens the draft model proposes per target decode.
+constexpr int DRAFT_TOKENS = 8;
+// Prefill sizing when LlmMemoryProfile leaves it at 0.
+constexpr int DEFAULT_N_BATCH = 2048;
+constexpr int DEFAULT_N_UBATCH = 512;
+
+struct KvCacheType {
+    const char* name;
+    ggml_type type;
+    double bytes_per_value;  // including the block scales
+};
+
+constexpr KvCacheType KV_CACHE_TYPES[] = {
+    {"f16",  GGML_TYPE_F16,  2.0},
+    {"q8_0", GGML_TYPE_Q8_0, 34.0 / 32},
+    {"q4_0", GGML_TYPE_Q4_0, 18.0 / 32},
+};
+
+// memory.gpu_layers, or none when the offload is automatic and this model
+// measured faster on the CPU (llama_gpu_for()).
+int offload_layers(const fs::path& model_path, const LlmMemoryProfile& memory) {
+    if (memory.gpu_layers < 0 && memory.bench_backend && active_backend_is_gpu() &&
+        !llama_gpu_for(model_path)) {
+        log_info("LLM: %s runs faster on the CPU here; not offloading",
+                 model_path.filename().c_str());
+        return 0;
+    }
+    return memory.gpu_layers;
+}
+
+const KvCacheType& kv_cache_type(const std::string& name) {
+    for (const auto& t : KV_CACHE_TYPES)
+        if (name == t.name) return t;
+    log_warn("Unknown llm_kv_type \"%s\"; using f16", name.c_str());
+    return KV_CACHE_TYPES[0];
+}
+
+std::string token_piece(const llama_vocab* vocab, llama_token token) {
+    char buf[128];
+    int n = llama_token_to_piece(vocab, token, buf, sizeof(buf), 0, true);
+    return n > 0 ? std::string(buf, n) : std::string();
+}
+
+// Whether a draft's token IDs mean what the target's do: about the same
+// vocabulary size, and the same text for every ID both have past the
+// first few control tokens.
+bool vocab_compatible(const llama_vocab* target, const llama_vocab* draft) {
+    const int n_target = llama_vocab_n_tokens(target);
+    const int n_draft = llama_vocab_n_tokens(draft);
+    if (std::abs(n_target - n_draft) > 128) return false;
+    for (int id = 5; id < std::min(n_target, n_draft); ++id)
+        if (token_piece(target, id) != token_piece(draft, id)) return false;
+    return true;
+}
+
+// One llama context over the resident model, reused for every completion
+// of a summary: the single prompt, or each step of a map-reduce.
+class LocalSummarizer {
+public:
+    LocalSummarizer(const fs::path& model_path, bool use_mmap, int threads, int chunk_tokens,
+                    const fs::path& draft_path = {}, const LlmMemoryProfile& memory = {})
+        : kv_(&kv_cache_type(memory.kv_type)), gpu_layers_(offload_layers(model_path, memory)) {
+        // A chunk size bounds the context too: KV memory and the longest
+        // prefill scale with it.
+        max_ctx_ = MAX_LOCAL_CTX;
+        if (chunk_tokens > 0)
+            max_ctx_ = std::min(max_ctx_, static_cast<uint32_t>(chunk_tokens + GENERATION_BUDGET));
+        loaded_ = acquire_llama_model(model_path, use_mmap, gpu_layers_, max_ctx_,
+                                      kv_->bytes_per_value);
+        llama_model* model = loaded_->get();
+        model_ctx_ = llama_model_n_ctx_train(model);
+        max_ctx_ = std::min(static_cast<uint32_t>(model_ctx_), max_ctx_);
+        if (prompt_budget() < 256)
+            throw RecmeetError("LLM context too small: " + std::to_string(max_ctx_)
+                               + " tokens (need at least " + std::to_string(GENERATION_BUDGET + 256) + ")");
+
+        ctx_params_ = llama_context_default_params();
+        ctx_params_.n_threads = threads > 0 ? threads : default_thread_count();
+        ctx_params_.type_k = kv_->type;
+        ctx_params_.type_v = kv_->type;
+        // llama.cpp keeps a quantized V cache only with flash attention.
+        if (kv_->type != GGML_TYPE_F16)
+            ctx_params_.flash_attn_type = LLAMA_FLASH_ATTN_TYPE_ENABLED;
+        // A verify step decodes a token and its proposals in one call.
+        n_batch_ = std::max(memory.n_batch > 0 ? memory.n_batch : DEFAULT_N_BATCH,
+                            DRAFT_TOKENS + 1);
+        n_ubatch_ = std::max(1, std::min(memory.n_ubatch > 0 ? memory.n_ubatch
+                                                             : DEFAULT_N_UBATCH, n_batch_));
 
-    // First call with length=0 to get required buffer size
-    int32_t needed = llama_chat_apply_template(
-        tmpl, messages, 2, true, nullptr, 0);
-    if (needed < 0) {
+        vocab_ = llama_model_get_vocab(model);
+        tmpl_ = llama_model_chat_template(model, nullptr);
+        if (!draft_path.empty()) load_draft(draft_path, use_mmap);
+    }
+    ~LocalSummarizer() {
+        if (draft_ctx_) llama_free(draft_ctx_);
+        if (ctx_) llama_free(ctx_);
+    }
+    LocalSummarizer(const LocalSummarizer&) = delete;
+    LocalSummarizer& operator=(const LocalSummarizer&) = delete;
+
+    // Largest context this summary may use.
+    uint32_t max_context() const { return max_ctx_; }
+
+    // Create the contexts with room for `n_ctx` tokens (at most
+    // max_context()). Once per summarizer; complete() opens the largest
+    // if no caller sized it first.
+    void open(uint32_t n_ctx) {
+        if (ctx_) return;
+        n_ctx = std::min(n_ctx, max_ctx_);
+        ctx_params_.n_ctx = n_ctx;
+        ctx_params_.n_batch = std::min(static_cast<uint32_t>(n_batch_), n_ctx);
+        ctx_params_.n_ubatch = std::min(static_cast<uint32_t>(n_ubatch_), ctx_params_.n_batch);
+        new_context();
+
+        actual_ctx_ = llama_n_ctx(ctx_);
+        llama_model* model = loaded_->get();
+        const int n_head = std::max(1, llama_model_n_head(model));
+        const double kv_mb = 2.0 * llama_model_n_layer(model) * actual_ctx_ *
+                             llama_model_n_head_kv(model) *
+                             (llama_model_n_embd(model) / n_head) * kv_->bytes_per_value /
+                             (1024.0 * 1024.0);
+        log_info("Context: %u tokens (model native: %d, cap: %u), KV cache %s ~%.0f MB, "
+                 "batch %u/%u", actual_ctx_, model_ctx_, max_ctx_, kv_->name, kv_mb,
+                 ctx_params_.n_batch, ctx_params_.n_ubatch);
+        if (prompt_budget() < 256) {
+            llama_free(ctx_);
+            ctx_ = nullptr;
+            throw RecmeetError("LLM context too small: " + std::to_string(actual_ctx_)
+                               + " tokens (need at least " + std::to_string(GENERATION_BUDGET + 256) + ")");
+        }
+        if (draft_) {
+            draft_ctx_ = llama_init_from_model(draft_->get(), ctx_params_);
+            if (!draft_ctx_) {
+                log_warn("Failed to create draft model context; generating without it");
+                draft_.reset();
+            }
+        }
+    }
+
+    // Tokens a prompt may take, leaving room for the generation.
+    int prompt_budget() const {
+        return static_cast<int>(ctx_ ? actual_ctx_ : max_ctx_) - GENERATION_BUDGET;
+    }
+
+    std::vector<llama_token> tokenize(const std::string& text, size_t len, bool add_special) const {
+        std::vector<llama_token> tokens(len + 256);
+        int n = llama_tokenize(vocab_, text.c_str(), static_cast<int32_t>(len),
+                               tokens.data(), tokens.size(), add_special, true);
+        if (n < 0) {
+            tokens.resize(-n);
+            n = llama_tokenize(vocab_, text.c_str(), static_cast<int32_t>(len),
+                               tokens.data(), tokens.size(), add_special, true);
+        }
+        tokens.resize(std::max(n, 0));
+        return tokens;
+    }
+
+    // Build prompt using model's chat template
+    std::string render(const std::string& user_prompt) const {
+        llama_chat_message messages[] = {
+            {"system", SYSTEM_PROMPT},
+            {"user",   user_prompt.c_str()},
+        };
+
+        // First call with length=0 to get required buffer size
+        int32_t needed = llama_chat_apply_template(
+            tmpl_, messages, 2, true, nullptr, 0);
+        if (needed > 0) {
+            std::vector<char> buf(needed + 1);
+            llama_chat_apply_template(tmpl_, messages, 2, true, buf.data(), buf.size());
+            return std::string(buf.data(), needed);
+        }
         // Fallback: raw concatenation if template not recognized
-        log_warn("chat template not available, using raw prompt");
+        if (!warned_template_) {
+            log_warn("chat template not available, using raw prompt");
+            warned_template_ = true;
+        }
+        return std::string(SYSTEM_PROMPT) + "\n\n" + user_prompt;
     }
 
-    std::string prompt;
-    if (needed > 0) {
-        std::vector<char> buf(needed + 1);
-        llama_chat_apply_template(tmpl, messages, 2, true, buf.data(), buf.size());
-        prompt.assign(buf.data(), needed);
-    } else {
-        prompt = std::string(SYSTEM_PROMPT) + "\n\n" + user_prompt;
-    }
-
-    // Tokenize
-    const llama_vocab* vocab = llama_model_get_vocab(model);
-    int n_prompt = prompt.size() + 256;
-    std::vector<llama_token> tokens(n_prompt);
-    n_prompt = llama_tokenize(vocab, prompt.c_str(), prompt.size(),
-                              tokens.data(), tokens.size(), true, true);
-    if (n_prompt < 0) {
-        tokens.resize(-n_prompt);
-        n_prompt = llama_tokenize(vocab, prompt.c_str(), prompt.size(),
-                                  tokens.data(), tokens.size(), true, true);
-    }
-    tokens.resize(n_prompt);
-
-    // Truncate prompt to fit within context budget (prevents SIGABRT in llama_decode)
-    int max_prompt_tokens = static_cast<int>(actual_ctx) - GENERATION_BUDGET;
-    if (max_prompt_tokens < 256) {
-        llama_free(ctx);
-        llama_model_free(model);
-        llama_backend_free();
-        throw RecmeetError("LLM context too small: " + std::to_string(actual_ctx)
-                           + " tokens (need at least " + std::to_string(GENERATION_BUDGET + 256) + ")");
+    int count_prompt_tokens(const std::string& user_prompt) const {
+        const std::string prompt = render(user_prompt);
+        return static_cast<int>(tokenize(prompt, prompt.size(), true).size());
     }
 
+    std::string complete(const std::string& user_prompt,
+                         const SummaryDeltaCallback& on_delta = nullptr);
+
+private:
+    // A draft that cannot be used is reported and left out; the summary is
+    // the same without it, only slower.
+    void load_draft(const fs::path& draft_path, bool use_mmap) {
+        try {
+            draft_ = acquire_draft_model(draft_path, use_mmap, gpu_layers_, max_ctx_,
+                                         kv_->bytes_per_value);
+        } catch (const std::exception& e) {
+            log_warn("Draft model not loaded, generating without it: %s", e.what());
+            return;
+        }
+        if (!vocab_compatible(vocab_, llama_model_get_vocab(draft_->get()))) {
+            log_warn("Draft model %s does not share the LLM's vocabulary; not using it",
+                     draft_path.filename().c_str());
+            draft_.reset();
+            return;
+        }
+        log_info("Speculative decoding with draft model %s (%d tokens per step)",
+                 draft_path.filename().c_str(), DRAFT_TOKENS);
+    }
+
+    void new_context() {
+        ctx_ = llama_init_from_model(loaded_->get(), ctx_params_);
+        if (!ctx_)
+            throw RecmeetError("Failed to create LLM context");
+        used_ = false;
+    }
+
+    const KvCacheType* kv_;
+    const int gpu_layers_;
+    std::shared_ptr<LlamaModel> loaded_;
+    llama_context_params ctx_params_{};
+    llama_context* ctx_ = nullptr;
+    int32_t model_ctx_ = 0;
+    uint32_t max_ctx_ = 0;
+    uint32_t actual_ctx_ = 0;
+    int n_batch_ = DEFAULT_N_BATCH;
+    int n_ubatch_ = DEFAULT_N_UBATCH;
+    const llama_vocab* vocab_ = nullptr;
+    const char* tmpl_ = nullptr;
+    bool used_ = false;  // ctx_ holds cells from an earlier completion
+    mutable bool warned_template_ = false;
+    std::shared_ptr<LlamaModel> draft_;  // speculative draft, when usable
+    llama_context* draft_ctx_ = nullptr;
+};
+
+// Bytes of `s` up to its last complete UTF-8 character; a token piece can
+// end partway through one.
+size_t utf8_complete_length(const std::string& s) {
+    for (size_t back = 1; back <= 4 && back <= s.size(); ++back) {
+        const auto c = static_cast<unsigned char>(s[s.size() - back]);
+        if ((c & 0xC0) == 0x80) continue;  // continuation byte
+        const size_t need = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+        return need > back ? s.size() - back : s.size();
+    }
+    return s.size();
+}
+
+std::string LocalSummarizer::complete(const std::string& user_prompt,
+                                      const SummaryDeltaCallback& on_delta) {
+    open(max_ctx_);
+    const EngineCounterScope counters("llama_complete", PerfScope::Thread);
+    const std::string prompt = render(user_prompt);
+    std::vector<llama_token> tokens = tokenize(prompt, prompt.size(), true);
+    int n_prompt = static_cast<int>(tokens.size());
+
+    // Truncate prompt to fit within context budget (prevents SIGABRT in
+    // llama_decode). Map-reduce sizes its prompts to fit; this is the
+    // backstop for an estimate that came out short.
+    int max_prompt_tokens = prompt_budget();
     if (n_prompt > max_prompt_tokens) {
         log_warn("Prompt (%d tokens) exceeds context budget (%d tokens). "
                  "Truncating transcript to fit.", n_prompt, max_prompt_tokens);
@@ -193,6 +1212,18 @@ std::string summarize_local(const std::string& transcript,
         tokens.resize(n_prompt);
     }
 
+    // The tokens before the user message are the same for every meeting.
+    // Tokenized alone they can differ from the full prompt's at the seam,
+    // so the shared run is what is cached.
+    int n_prefix = 0;
+    const size_t user_at = prompt.find(user_prompt);
+    if (user_at != std::string::npos && user_at > 0) {
+        const auto head = tokenize(prompt, user_at, true);
+        const int n_head = static_cast<int>(head.size());
+        while (n_prefix < n_head && n_prefix < n_prompt - 1 && head[n_prefix] == tokens[n_prefix])
+            ++n_prefix;
+    }
+
     log_info("Prompt: %d tokens, generating summary...", n_prompt);
 
     // Helper: add a token to a batch
@@ -207,26 +1238,82 @@ std::string summarize_local(const std::string& transcript,
         b.n_tokens++;
     };
 
-    // Create batch and process prompt
-    llama_batch batch = llama_batch_init(std::max(n_prompt, 512), 0, 1);
-    batch.n_tokens = 0;
-    for (int i = 0; i < n_prompt; ++i)
-        batch_add(batch, tokens[i], i, 0, i == n_prompt - 1);
-
-    int decode_status = llama_decode(ctx, batch);
-    if (decode_status != 0) {
-        llama_batch_free(batch);
-        llama_free(ctx);
-        llama_model_free(model);
-        llama_backend_free();
-        if (decode_status == 1)
-            throw RecmeetError("LLM decode failed: no KV slot for batch (prompt: "
-                               + std::to_string(n_prompt) + " tokens, ctx: "
-                               + std::to_string(actual_ctx) + ")");
-        throw RecmeetError("LLM decode failed (status " + std::to_string(decode_status) + ")");
+    // Restore the system prompt's KV cells (replacing whatever an earlier
+    // completion left in seq 0), or decode them on their own and keep them
+    // for the next completion.
+    int n_past = 0;
+    {
+        std::lock_guard<std::mutex> lock(loaded_->prefix_mu);
+        const auto& cached = loaded_->prefix;
+        if (!cached.tokens.empty() && static_cast<int>(cached.tokens.size()) <= n_prefix &&
+            std::equal(cached.tokens.begin(), cached.tokens.end(), tokens.begin())) {
+            if (llama_state_seq_set_data(ctx_, cached.state.data(), cached.state.size(), 0)
+                    == cached.state.size()) {
+                n_past = static_cast<int>(cached.tokens.size());
+                log_info("Reusing cached system prompt (%d tokens)", n_past);
+            } else {
+                log_warn("Cached system prompt did not restore; decoding it again");
+            }
+        }
+    }
+    // Without a restore to replace them, an earlier completion's cells
+    // would still be in the context.
+    if (n_past == 0 && used_) {
+        llama_free(ctx_);
+        ctx_ = nullptr;
+        new_context();
+    }
+    used_ = true;
+
+    // Create batch and process prompt, n_batch tokens per decode call
+    // (llama.cpp splits each call into n_ubatch compute passes).
+    const size_t n_batch = ctx_params_.n_batch;
+    llama_batch batch = llama_batch_init(static_cast<int32_t>(n_batch), 0, 1);
+    // Decode seq[from, to) at those positions, with logits for the last
+    // token when `logits` is set.
+    auto decode_span = [&](llama_context* ctx, const std::vector<llama_token>& seq,
+                           size_t from, size_t to, bool logits) {
+        for (size_t at = from; at < to; at += n_batch) {
+            const size_t end = std::min(to, at + n_batch);
+            batch.n_tokens = 0;
+            for (size_t i = at; i < end; ++i)
+                batch_add(batch, seq[i], static_cast<llama_pos>(i), 0, logits && i + 1 == to);
+            const int status = llama_decode(ctx, batch);
+            if (status != 0) return status;
+        }
+        return 0;
+    };
+    auto decode_range = [&](int from, int to) {
+        int decode_status = decode_span(ctx_, tokens, from, to, to == n_prompt);
+        if (decode_status != 0) {
+            llama_batch_free(batch);
+            if (decode_status == 1)
+                throw RecmeetError("LLM decode failed: no KV slot for batch (prompt: "
+                                   + std::to_string(n_prompt) + " tokens, ctx: "
+                                   + std::to_string(actual_ctx_) + ")");
+            throw RecmeetError("LLM decode failed (status " + std::to_string(decode_status) + ")");
+        }
+    };
+
+    TraceSpan prefill("llm_prefill");
+    if (n_past == 0 && n_prefix > 0) {
+        decode_range(0, n_prefix);
+        LlamaModel::PrefixCache fresh;
+        fresh.tokens.assign(tokens.begin(), tokens.begin() + n_prefix);
+        fresh.state.resize(llama_state_seq_get_size(ctx_, 0));
+        fresh.state.resize(llama_state_seq_get_data(ctx_, fresh.state.data(),
+                                                    fresh.state.size(), 0));
+        if (!fresh.state.empty()) {
+            std::lock_guard<std::mutex> lock(loaded_->prefix_mu);
+            loaded_->prefix = std::move(fresh);
+        }
+        n_past = n_prefix;
     }
+    decode_range(n_past, n_prompt);
+    prefill.end();
 
     // Generate
+    TraceSpan generation("llm_generate");
     std::string result;
     int max_tokens = GENERATION_BUDGET;
 
@@ -234,34 +1321,237 @@ std::string summarize_local(const std::string& transcript,
     llama_sampler_chain_add(sampler, llama_sampler_init_temp(0.3f));
     llama_sampler_chain_add(sampler, llama_sampler_init_dist(0));
 
-    for (int i = 0; i < max_tokens; ++i) {
-        llama_token new_token = llama_sampler_sample(sampler, ctx, -1);
+    // Every token so far, prompt and generated; the draft model catches up
+    // on it before each proposal.
+    std::vector<llama_token> history = tokens;
+    size_t streamed = 0;
+    int generated = 0;
+    auto emit = [&](llama_token token) {
+        history.push_back(token);
+        ++generated;
+        const std::string piece = token_piece(vocab_, token);
+        if (piece.empty()) return;
+        result += piece;
+        const size_t ready = on_delta ? utf8_complete_length(result) : streamed;
+        if (ready > streamed) {
+            on_delta(result.substr(streamed, ready - streamed));
+            streamed = ready;
+        }
+    };
 
-        if (llama_vocab_is_eog(vocab, new_token))
-            break;
+    // Speculative decoding: the draft proposes a few tokens greedily, the
+    // target decodes them in one batch, and its own sample at each position
+    // is kept up to the first that differs from the proposal. Every token
+    // is still the target's sample, so the draft changes speed, not output.
+    llama_sampler* draft_sampler = nullptr;
+    size_t draft_past = 0;  // history tokens in the draft's KV cells
+    if (draft_ctx_) {
+        llama_memory_seq_rm(llama_get_memory(draft_ctx_), 0, -1, -1);
+        draft_sampler = llama_sampler_init_greedy();
+    }
+    std::vector<llama_token> drafted;
+    auto propose = [&](int n) {
+        drafted.clear();
+        if (decode_span(draft_ctx_, history, draft_past, history.size(), true) != 0)
+            return false;
+        draft_past = history.size();
+        for (int j = 0; j < n; ++j) {
+            llama_token d = llama_sampler_sample(draft_sampler, draft_ctx_, -1);
+            if (llama_vocab_is_eog(vocab_, d)) break;
+            drafted.push_back(d);
+            if (j + 1 == n) break;
+            batch.n_tokens = 0;
+            batch_add(batch, d, static_cast<llama_pos>(draft_past + j), 0, true);
+            if (llama_decode(draft_ctx_, batch) != 0) break;
+        }
+        return true;
+    };
 
-        char buf[128];
-        int n = llama_token_to_piece(vocab, new_token, buf, sizeof(buf), 0, true);
-        if (n > 0)
-            result.append(buf, n);
+    size_t n_drafted = 0, n_accepted = 0, n_steps = 0;
+    int n_cur = n_prompt;  // tokens in the target's KV cells
+    llama_token last = llama_sampler_sample(sampler, ctx_, -1);
+    while (!llama_vocab_is_eog(vocab_, last)) {
+        emit(last);
+        if (generated >= max_tokens) break;
+
+        drafted.clear();
+        const int room = std::min({DRAFT_TOKENS, max_tokens - generated - 1,
+                                   static_cast<int>(actual_ctx_) - n_cur - 1});
+        if (draft_sampler && room > 0 && !propose(room)) {
+            log_warn("Draft model decode failed; generating without it");
+            llama_sampler_free(draft_sampler);
+            draft_sampler = nullptr;
+            drafted.clear();
+        }
 
         batch.n_tokens = 0;
-        batch_add(batch, new_token, n_prompt + i, 0, true);
-        if (llama_decode(ctx, batch) != 0)
+        batch_add(batch, last, n_cur, 0, true);
+        for (size_t j = 0; j < drafted.size(); ++j)
+            batch_add(batch, drafted[j], n_cur + 1 + static_cast<int>(j), 0, true);
+        if (llama_decode(ctx_, batch) != 0)
             break;
+        ++n_steps;
+
+        size_t accepted = 0;
+        llama_token next = llama_sampler_sample(sampler, ctx_, 0);
+        while (accepted < drafted.size() && next == drafted[accepted] &&
+               generated < max_tokens) {
+            emit(next);
+            ++accepted;
+            next = llama_sampler_sample(sampler, ctx_, static_cast<int32_t>(accepted));
+        }
+        if (generated >= max_tokens) break;
+        n_cur += 1 + static_cast<int>(accepted);
+        if (!drafted.empty()) {
+            // Drop the cells of the rejected proposals, in both contexts.
+            llama_memory_seq_rm(llama_get_memory(ctx_), 0, n_cur, -1);
+            draft_past = std::min(draft_past + accepted, draft_past + drafted.size() - 1);
+            llama_memory_seq_rm(llama_get_memory(draft_ctx_), 0,
+                                static_cast<llama_pos>(draft_past), -1);
+            n_drafted += drafted.size();
+            n_accepted += accepted;
+        }
+        last = next;
+        trace_counter("llm_generated_tokens", generated);
     }
+    generation.end();
+
+    if (n_drafted > 0)
+        log_info("Speculative decoding: %zu of %zu drafted tokens accepted (%.0f%%), "
+                 "%.2f tokens per target decode",
+                 n_accepted, n_drafted, 100.0 * n_accepted / n_drafted,
+                 n_steps ? static_cast<double>(generated) / n_steps : 0.0);
+    if (draft_sampler) llama_sampler_free(draft_sampler);
 
     llama_sampler_free(sampler);
     llama_batch_free(batch);
-    llama_free(ctx);
-    llama_model_free(model);
-    llama_backend_free();
+    if (on_delta && result.size() > streamed) on_delta(result.substr(streamed));
 
     if (result.empty())
         throw RecmeetError("LLM produced no output");
 
     return result;
 }
+
+} // anonymous namespace
+
+std::string summarize_local(const std::string& transcript,
+                             const fs::path& model_path,
+                             const std::string& context,
+                             int threads,
+                             bool use_mmap,
+                             int chunk_tokens,
+                             const SummaryDeltaCallback& on_delta,
+                             const fs::path& draft_model_path,
+                             const LlmMemoryProfile& memory) {
+    // The context lives for this summary; the weights, and with them the
+    // system prompt's KV cells, may be reused across summaries.
+    LocalSummarizer llm(model_path, use_mmap, threads, chunk_tokens, draft_model_path, memory);
+    const int budget = chunk_tokens > 0 ? std::min(chunk_tokens, llm.prompt_budget())
+                                        : llm.prompt_budget();
+
+    // A prompt that fits whole gets a context sized to it; the parts of a
+    // map-reduce share one at the cap.
+    const std::string whole = build_user_prompt(transcript, context);
+    const int whole_tokens = llm.count_prompt_tokens(whole);
+    if (whole_tokens <= budget) {
+        llm.open(local_context_tokens(whole_tokens, GENERATION_BUDGET, llm.max_context()));
+        return llm.complete(whole, on_delta);
+    }
+    llm.open(llm.max_context());
+
+    // Size the parts in characters from this transcript's own density, with
+    // a tenth held back for the estimate; complete() still truncates a part
+    // that comes out long.
+    const int transcript_tokens = std::max<int>(
+        1, static_cast<int>(llm.tokenize(transcript, transcript.size(), false).size()));
+    const double chars_per_token =
+        static_cast<double>(transcript.size()) / transcript_tokens;
+    const int overhead = std::max(llm.count_prompt_tokens(build_chunk_prompt("", 99, 99, context)),
+                                  llm.count_prompt_tokens(build_reduce_prompt({}, context)));
+    const int room = std::max(256, budget - overhead);
+    const size_t max_chars = static_cast<size_t>(room * chars_per_token * 0.9);
+    log_info("Transcript (%d tokens) exceeds one prompt (%d); summarizing in parts",
+             transcript_tokens, budget);
+    return summarize_map_reduce(
+        transcript, context, max_chars, [&](const std::string& p) { return llm.complete(p); }, 1,
+        [&](const std::string& p) { return llm.complete(p, on_delta); });
+}
+
+SummaryCompleter local_summary_completer(const fs::path& model_path, int threads,
+                                         bool use_mmap, int chunk_tokens,
+                                         const fs::path& draft_model_path,
+                                         const LlmMemoryProfile& memory) {
+    // Shared by the copies of the completer; loaded by whichever call
+    // comes first.
+    struct State {
+        std::mutex mu;
+        std::unique_ptr<LocalSummarizer> llm;
+    };
+    auto state = std::make_shared<State>();
+    return [=](const std::string& p, const SummaryDeltaCallback& on_delta) {
+        std::lock_guard<std::mutex> lock(state->mu);
+        if (!state->llm)
+            state->llm = std::make_unique<LocalSummarizer>(model_path, use_mmap, threads,
+                                                           chunk_tokens, draft_model_path,
+                                                           memory);
+        return state->llm->complete(p, on_delta);
+    };
+}
+
+double time_llama_backend(const fs::path& model_path, bool use_gpu) {
+    constexpr int PROMPT_TOKENS = 256;
+    constexpr int GENERATED_TOKENS = 32;
+    constexpr uint32_t BENCH_CTX = 512;
+    const int layers = use_gpu ? resolve_gpu_layers(model_path, -1, BENCH_CTX, 2.0) : 0;
+    if (use_gpu && layers == 0)
+        throw RecmeetError("no layers of " + model_path.filename().string() + " fit the GPU");
+    LlamaModel model(model_path, true, layers);
+    llama_context_params params = llama_context_default_params();
+    params.n_ctx = BENCH_CTX;
+    params.n_batch = PROMPT_TOKENS;
+    params.n_ubatch = PROMPT_TOKENS;
+    params.n_threads = default_thread_count();
+    llama_context* ctx = llama_init_from_model(model.get(), params);
+    if (!ctx) throw RecmeetError("LLM benchmark: cannot create a context");
+
+    llama_batch batch = llama_batch_init(PROMPT_TOKENS, 0, 1);
+    auto decode = [&](int pos, int n) {
+        batch.n_tokens = n;
+        for (int i = 0; i < n; ++i) {
+            batch.token[i] = 0;
+            batch.pos[i] = pos + i;
+            batch.n_seq_id[i] = 1;
+            batch.seq_id[i][0] = 0;
+            batch.logits[i] = i + 1 == n;
+        }
+        return llama_decode(ctx, batch) == 0;
+    };
+    // A prefill, then tokens one at a time, as a summary spends its time.
+    auto pass = [&] {
+        llama_memory_seq_rm(llama_get_memory(ctx), 0, -1, -1);
+        if (!decode(0, PROMPT_TOKENS)) return false;
+        for (int i = 0; i < GENERATED_TOKENS; ++i)
+            if (!decode(PROMPT_TOKENS + i, 1)) return false;
+        return true;
+    };
+    const bool warm = pass();  // the first GPU pass also builds its pipelines
+    const auto t0 = std::chrono::steady_clock::now();
+    const bool ok = warm && pass();
+    const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    llama_batch_free(batch);
+    llama_free(ctx);
+    if (!ok) throw RecmeetError("LLM benchmark decode failed: " + model_path.filename().string());
+    return sec;
+}
+
+bool llama_gpu_for(const fs::path& model_path, bool cached_only) {
+    return choose_gpu_backend(model_path, active_device_signature(),
+                              [&model_path](bool gpu) {
+                                  return time_llama_backend(model_path, gpu);
+                              },
+                              cached_only);
+}
 #endif
 
 } // namespace recmeet
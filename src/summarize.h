@@ -7,6 +7,9 @@
 #include "api_models.h"
 #include "util.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -15,22 +18,245 @@ namespace recmeet {
 /// Build the user prompt for meeting summarization (exposed for testing).
 std::string build_user_prompt(const std::string& transcript, const std::string& context = "");
 
+/// The system prompt sent with every summary request.
+const char* summary_system_prompt();
+
+/// Speaker labels of `transcript`'s lines ("Alice" of
+/// "[00:05 - 00:09] Alice: text"), in order of first appearance.
+std::vector<std::string> transcript_speakers(const std::string& transcript);
+
+/// `transcript` with each line's speaker label replaced by its place in
+/// transcript_speakers() ("#1", "#2", ...): the same text for a meeting
+/// whose speakers were only renamed.
+std::string anonymize_speakers(const std::string& transcript);
+
+/// Longest stretch one compacted turn covers; a longer monologue gets a
+/// fresh timestamp marker every this many seconds.
+inline constexpr double COMPACT_TURN_MAX_SEC = 120.0;
+
+/// What compact_transcript() did.
+struct CompactionStats {
+    size_t lines = 0;      ///< input lines
+    size_t turns = 0;      ///< speaker turns written
+    size_t fillers = 0;    ///< filler words and non-speech tags dropped
+    size_t repeats = 0;    ///< repeated words, phrases and lines dropped
+    size_t chars_in = 0;
+    size_t chars_out = 0;
+};
+
+/// `transcript` shortened for a summary prompt: consecutive segment lines
+/// of one speaker become one turn, "[MM:SS] Speaker: text", marked with
+/// the start of its first line ("[MM:SS - MM:SS] Speaker: text" in,
+/// speaker optional). Fillers ("um", "uh") and bracketed non-speech tags
+/// are dropped. A line identical to the one before, a word said three or
+/// more times in a row and an immediately repeated phrase of 2-8 words
+/// are kept once. Lines without a timestamp pass through and end the
+/// turn.
+std::string compact_transcript(const std::string& transcript, CompactionStats* stats = nullptr);
+
+/// `text` with every whole-word `from[i]` replaced by `to[i]`, all in one
+/// pass, so swapping two names works. Names past the shorter list are left.
+std::string rename_speakers(const std::string& text, const std::vector<std::string>& from,
+                            const std::vector<std::string>& to);
+
+/// Receives the summary's text as it is generated, a piece at a time, on
+/// the summarizing thread. Pieces end on UTF-8 character boundaries;
+/// concatenated, they are the summary.
+using SummaryDeltaCallback = std::function<void(const std::string&)>;
+
+/// Take the complete lines of an OpenAI-compatible streamed chat
+/// completion (server-sent events) off the front of `buffer` and return
+/// the text their `data:` chunks add. Sets `done` at `data: [DONE]`. A
+/// partial last line stays in `buffer` for the next read. Exposed for
+/// testing.
+std::string consume_sse_deltas(std::string& buffer, bool& done);
+
+// ---------------------------------------------------------------------------
+// Map-reduce summarization
+// ---------------------------------------------------------------------------
+//
+// A transcript too long for one prompt is split into parts, each part is
+// summarized into notes under fixed headings (map), consecutive notes are
+// merged until they fit one prompt, and the final summary is written from
+// them with build_user_prompt()'s metadata and sections (reduce). No part
+// of the meeting is dropped, and no prompt is longer than a part.
+
+/// Characters per token assumed where no tokenizer is at hand (HTTP).
+inline constexpr size_t SUMMARY_CHARS_PER_TOKEN = 4;
+
+/// Prompt tokens an HTTP summary request may carry before the transcript
+/// is summarized in parts, when `summary.chunk_tokens` is 0.
+inline constexpr int HTTP_SUMMARY_CHUNK_TOKENS = 32000;
+
+/// HTTP requests a map or merge step keeps in flight.
+inline constexpr int HTTP_SUMMARY_PARALLEL = 4;
+
+/// Split `transcript` into consecutive parts of at most `max_chars`, at
+/// line (segment) boundaries, preferring the last change of speaker when
+/// it falls in the part's second half. A single line longer than a part is
+/// split at spaces. Concatenated, the parts are the transcript.
+std::vector<std::string> split_transcript(const std::string& transcript, size_t max_chars);
+
+/// Map step prompt: notes on part `index` (0-based) of `count`.
+std::string build_chunk_prompt(const std::string& chunk, size_t index, size_t count,
+                               const std::string& context = "");
+
+/// Merge step prompt: consecutive notes combined into one set.
+std::string build_merge_prompt(const std::vector<std::string>& notes);
+
+/// Reduce step prompt: the final summary from notes on every part, in the
+/// format build_user_prompt() asks for.
+std::string build_reduce_prompt(const std::vector<std::string>& notes,
+                                const std::string& context = "");
+
+/// Map-reduce `transcript` in parts of at most `max_chars`, sending every
+/// prompt through `complete` (user prompt -> response), up to `parallel`
+/// at a time for the map and merge steps. A transcript that fits one part
+/// gets the single build_user_prompt() call; map and merge steps the
+/// installed SummaryCheckpoint holds are skipped. The call whose response is
+/// the summary (that one, or the reduce) goes through `final_complete`
+/// instead when it is set, so only the summary itself is streamed. The
+/// first failure is rethrown.
+std::string summarize_map_reduce(
+    const std::string& transcript, const std::string& context, size_t max_chars,
+    const std::function<std::string(const std::string&)>& complete, int parallel = 1,
+    const std::function<std::string(const std::string&)>& final_complete = {});
+
+/// Map and merge responses summarize_map_reduce() may reuse instead of
+/// asking for them again, looked up by prompt. run_postprocessing()
+/// installs one backed by a stage file (stage_cache.h), so a long summary
+/// whose process was killed resumes at the first part it had not
+/// finished. find() and put() are called from the map's worker threads.
+class SummaryCheckpoint {
+public:
+    virtual ~SummaryCheckpoint() = default;
+    virtual bool find(const std::string& prompt, std::string& response) = 0;
+    virtual void put(const std::string& prompt, const std::string& response) = 0;
+};
+
+/// Install `checkpoint` for every later summarize_map_reduce() in this
+/// process; nullptr removes it. The caller keeps it alive until then.
+void set_summary_checkpoint(SummaryCheckpoint* checkpoint);
+
+// ---------------------------------------------------------------------------
+// Rolling summarization
+// ---------------------------------------------------------------------------
+//
+// While recording, RollingSummarizer (rolling_summary.h) folds each new
+// stretch of the live transcript into one set of notes. Postprocessing
+// then writes the summary from those notes and the transcript after them,
+// so its prompt stays about the same size however long the meeting ran.
+
+/// Rolling step prompt: `previous` notes (empty on the first step) with
+/// `new_text`, the transcript since, folded in under the map step's
+/// headings.
+std::string build_rolling_prompt(const std::string& previous, const std::string& new_text,
+                                 const std::string& context = "");
+
+/// Final summary from rolling `notes` on the meeting up to `tail`, the
+/// rest of the transcript, in the format build_user_prompt() asks for.
+std::string build_refine_prompt(const std::string& notes, const std::string& tail,
+                                const std::string& context = "");
+
+/// One completion of a user prompt under summary_system_prompt(), handing
+/// the response to `on_delta` as it is generated when that is set.
+using SummaryCompleter =
+    std::function<std::string(const std::string& user_prompt, const SummaryDeltaCallback& on_delta)>;
+
+/// A completer over an OpenAI-compatible API, as summarize_http() sends.
+SummaryCompleter http_summary_completer(const std::string& api_url, const std::string& api_key,
+                                        const std::string& model);
+
 /// Summarize a transcript using an HTTP API (Grok, OpenAI-compatible).
+/// A prompt over `chunk_tokens` (0 = HTTP_SUMMARY_CHUNK_TOKENS, estimated
+/// at SUMMARY_CHARS_PER_TOKEN) is map-reduced, HTTP_SUMMARY_PARALLEL
+/// requests at a time. With `on_delta`, the summary request is streamed
+/// (`"stream":true`) and its text handed over as it arrives.
 std::string summarize_http(const std::string& transcript,
                             const std::string& api_url,
                             const std::string& api_key,
                             const std::string& model = "grok-3",
-                            const std::string& context = "");
+                            const std::string& context = "",
+                            int chunk_tokens = 0,
+                            const SummaryDeltaCallback& on_delta = nullptr);
+
+/// Context tokens for a local summary whose prompt is `prompt_tokens`:
+/// room for the prompt and `generation_tokens` more, rounded up to a
+/// multiple of 256 and at most `cap`. A short meeting gets a short context,
+/// so its KV cache is sized to it rather than to the model's maximum.
+uint32_t local_context_tokens(int prompt_tokens, int generation_tokens, uint32_t cap);
+
+/// Layers of an `n_layers`-layer model that fit `free_bytes` of GPU memory
+/// when each costs `layer_bytes` (weights plus its KV cells) and
+/// `reserve_bytes` stay free for compute buffers. n_layers + 1 means the
+/// output layer fits as well, i.e. the whole model.
+int fit_gpu_layers(int n_layers, uint64_t layer_bytes, uint64_t free_bytes,
+                   uint64_t reserve_bytes);
+
+/// How a local summary's llama context spends memory.
+struct LlmMemoryProfile {
+    std::string kv_type = "f16";  ///< KV cache type: "f16", "q8_0" or "q4_0"
+    int n_batch = 0;              ///< prompt tokens per decode call (0 = 2048)
+    int n_ubatch = 0;             ///< tokens per compute pass (0 = 512)
+    /// Layers offloaded to the active GPU backend (backend_info.h): -1 = as
+    /// many as fit its free memory next to their KV cells, 0 = none. A draft
+    /// model fits what is left. Without a GPU device, or when the offloaded
+    /// load fails, the model runs on the CPU.
+    int gpu_layers = -1;
+    /// With gpu_layers -1, offload only when the GPU measured at least as
+    /// fast for this model (llama_gpu_for()). Config::backend_bench.
+    bool bench_backend = false;
+};
 
 #if RECMEET_USE_LLAMA
 /// Summarize a transcript using a local llama.cpp model.
 /// threads: number of CPU threads (0 = use default_thread_count()).
 /// use_mmap: use mmap for model loading (false = read into heap, avoids swap thrashing).
+/// chunk_tokens: prompt tokens past which the transcript is map-reduced, one
+/// part at a time on the same context; also caps the context at that plus
+/// the generation budget (0 = the model's context, up to 32768).
+/// on_delta: receives the summary's tokens as they are sampled.
+/// draft_model_path: a small GGUF sharing the model's vocabulary that
+/// proposes tokens for speculative decoding (empty = none). The output is
+/// still sampled from the model; a draft that fails to load or does not
+/// match is logged and skipped.
+/// memory: KV cache type and prefill batch sizes. An unknown KV type is
+/// logged and f16 used. The context is sized to a prompt that fits whole
+/// (local_context_tokens()), and to the cap for one that is map-reduced.
 std::string summarize_local(const std::string& transcript,
                              const fs::path& model_path,
                              const std::string& context = "",
                              int threads = 0,
-                             bool use_mmap = false);
+                             bool use_mmap = false,
+                             int chunk_tokens = 0,
+                             const SummaryDeltaCallback& on_delta = nullptr,
+                             const fs::path& draft_model_path = {},
+                             const LlmMemoryProfile& memory = {});
+
+/// A completer over a local model, with summarize_local()'s arguments. The
+/// model loads at the first call and stays loaded, with one context of
+/// `chunk_tokens` (0 = the model's, up to 32768) plus the generation
+/// budget reused by every call; a longer prompt is truncated.
+SummaryCompleter local_summary_completer(const fs::path& model_path, int threads = 0,
+                                         bool use_mmap = false, int chunk_tokens = 0,
+                                         const fs::path& draft_model_path = {},
+                                         const LlmMemoryProfile& memory = {});
+
+/// Tokens of system prompt the loaded model has cached for the next
+/// completion to restore instead of decoding (0 when none). It lives with
+/// the model, so across summaries only while the model cache is on
+/// (model_cache.h). Test seam.
+size_t local_summary_prefix_tokens();
+
+/// Seconds of one benchmark pass of `model_path`, a 256-token prefill and
+/// 32 generated tokens after one untimed pass, with as many layers as fit
+/// on the GPU or none. For choose_gpu_backend(). Throws RecmeetError.
+double time_llama_backend(const fs::path& model_path, bool use_gpu);
+
+/// Whether `model_path` should be offloaded to the active GPU: the cached
+/// benchmark's verdict (backend_bench.h), measured now unless
+/// `cached_only`. False without a GPU device.
+bool llama_gpu_for(const fs::path& model_path, bool cached_only = false);
 #endif
 
 } // namespace recmeet
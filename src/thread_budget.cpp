@@ -0,0 +1,141 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "thread_budget.h"
+#include "log.h"
+#include "stage_perf.h"
+#include "util.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+namespace recmeet {
+
+namespace {
+
+struct Held {
+    std::string engine;
+    int threads = 0;
+    double since = 0;           // steady seconds, last accounted
+};
+
+struct Budget {
+    std::mutex mu;
+    int limit = 0;              // 0 = default_thread_count()
+    int in_use = 0;
+    int next_id = 1;
+    std::map<int, Held> held;   // by lease id
+    std::map<std::string, ThreadUse> usage;
+    double cpu_mark = -1;       // process CPU when `held` last changed
+};
+
+Budget& budget() {
+    static Budget b;
+    return b;
+}
+
+double steady_seconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+int limit_locked(const Budget& b) {
+    return b.limit > 0 ? b.limit : default_thread_count();
+}
+
+// Charge the time and CPU since the last change to the leases held over
+// it. Caller holds b.mu.
+void account_locked(Budget& b) {
+    const double now = steady_seconds();
+    const double cpu = process_cpu_seconds();
+    const double cpu_delta = b.cpu_mark >= 0 ? std::max(0.0, cpu - b.cpu_mark) : 0.0;
+    b.cpu_mark = cpu;
+    for (auto& [id, h] : b.held) {
+        ThreadUse& u = b.usage[h.engine];
+        const double dt = now - h.since;
+        u.held_sec += dt;
+        u.thread_sec += dt * h.threads;
+        if (b.in_use > 0) u.cpu_sec += cpu_delta * h.threads / b.in_use;
+        h.since = now;
+    }
+}
+
+} // anonymous namespace
+
+void set_thread_budget(int threads) {
+    std::lock_guard<std::mutex> lock(budget().mu);
+    budget().limit = std::max(threads, 0);
+}
+
+int thread_budget() {
+    std::lock_guard<std::mutex> lock(budget().mu);
+    return limit_locked(budget());
+}
+
+int threads_in_use() {
+    std::lock_guard<std::mutex> lock(budget().mu);
+    return budget().in_use;
+}
+
+ThreadLease lease_threads(const char* engine, int want) {
+    Budget& b = budget();
+    want = std::max(want, 1);
+    ThreadLease lease;
+    int limit;
+    {
+        std::lock_guard<std::mutex> lock(b.mu);
+        account_locked(b);
+        limit = limit_locked(b);
+        lease.threads_ = std::max(1, std::min(want, limit - b.in_use));
+        lease.id_ = b.next_id++;
+        b.in_use += lease.threads_;
+        b.held[lease.id_] = Held{engine, lease.threads_, steady_seconds()};
+        ThreadUse& u = b.usage[engine];
+        ++u.leases;
+        u.peak_threads = std::max(u.peak_threads, lease.threads_);
+    }
+    if (lease.threads_ < want)
+        log_info("Thread budget: %s gets %d of the %d thread(s) it asked for (%d in use of %d)",
+                 engine, lease.threads_, want, threads_in_use(), limit);
+    return lease;
+}
+
+ThreadLease::ThreadLease(ThreadLease&& other) noexcept
+    : id_(other.id_), threads_(other.threads_) {
+    other.id_ = 0;
+    other.threads_ = 0;
+}
+
+ThreadLease& ThreadLease::operator=(ThreadLease&& other) noexcept {
+    if (this != &other) {
+        release();
+        id_ = other.id_;
+        threads_ = other.threads_;
+        other.id_ = 0;
+        other.threads_ = 0;
+    }
+    return *this;
+}
+
+void ThreadLease::release() {
+    if (id_ == 0) return;
+    Budget& b = budget();
+    std::lock_guard<std::mutex> lock(b.mu);
+    account_locked(b);
+    b.held.erase(id_);
+    b.in_use -= threads_;
+    id_ = 0;
+    threads_ = 0;
+}
+
+std::map<std::string, ThreadUse> take_thread_usage() {
+    Budget& b = budget();
+    std::lock_guard<std::mutex> lock(b.mu);
+    account_locked(b);
+    std::map<std::string, ThreadUse> out;
+    out.swap(b.usage);
+    return out;
+}
+
+} // namespace recmeet
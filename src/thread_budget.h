@@ -0,0 +1,83 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include <map>
+#include <string>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Process-wide CPU thread budget
+// ---------------------------------------------------------------------------
+//
+// whisper, the sherpa/onnxruntime sessions and llama each start their own
+// worker threads from the count they are handed. Before one does, it takes
+// a ThreadLease on this process's budget, and is given what it asked for
+// or what is left, whichever is less, but never less than one thread.
+// Work that overlaps then shares the budget instead of each engine sizing
+// itself for the whole machine. Examples are diarization beside a GPU
+// transcription, or the live transcriber, diarizer and rolling summary of
+// a recording.
+//
+// A lease never waits: an engine that arrives when the budget is spent
+// still runs, on one thread. The engines' own pools cannot be merged from
+// here, since sherpa-onnx builds a private onnxruntime environment per
+// model. Sizing every pool from one budget is what keeps them off each
+// other's cores.
+//
+// Leases are also tallied by engine. Process CPU time is shared among the
+// leases held while it was spent, in proportion to their threads, so each
+// engine's utilization (CPU / (held time × threads)) can be reported as a
+// `threads.<engine>` record (stage_perf.h).
+
+/// Threads leases may hold at once in this process. 0 =
+/// default_thread_count(). Leases already held keep their threads.
+void set_thread_budget(int threads);
+int thread_budget();
+
+/// Threads held by live leases.
+int threads_in_use();
+
+/// Threads `engine` was granted from the budget, returned when the lease
+/// is destroyed or released. Move-only.
+class ThreadLease {
+public:
+    ThreadLease() = default;
+    ~ThreadLease() { release(); }
+
+    ThreadLease(ThreadLease&& other) noexcept;
+    ThreadLease& operator=(ThreadLease&& other) noexcept;
+    ThreadLease(const ThreadLease&) = delete;
+    ThreadLease& operator=(const ThreadLease&) = delete;
+
+    /// Granted threads; 0 for an empty (moved-from or released) lease.
+    int threads() const { return threads_; }
+
+    void release();
+
+private:
+    friend ThreadLease lease_threads(const char* engine, int want);
+    int id_ = 0;
+    int threads_ = 0;
+};
+
+/// Lease up to `want` threads (at least 1) for `engine`, a literal such as
+/// "whisper" or "diarize". Logs when the budget cut the request.
+ThreadLease lease_threads(const char* engine, int want);
+
+/// One engine's leases since the last take_thread_usage().
+struct ThreadUse {
+    int leases = 0;
+    int peak_threads = 0;   ///< most threads one of its leases held
+    double held_sec = 0;    ///< wall time a lease of it was held; overlapping leases add up
+    double thread_sec = 0;  ///< granted threads x the time they were held
+    double cpu_sec = 0;     ///< its share of the process CPU time while held
+};
+
+/// The tallies since the last call, by engine, and reset them. A lease
+/// still held is counted up to now and keeps counting from here.
+std::map<std::string, ThreadUse> take_thread_usage();
+
+} // namespace recmeet
@@ -0,0 +1,211 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "trace.h"
+#include "json_util.h"
+#include "log.h"
+#include "util.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace recmeet {
+
+namespace trace_detail {
+std::atomic<bool> enabled{false};
+} // namespace trace_detail
+
+namespace {
+
+// A long run at debug granularity stays well under this; past it a
+// thread's events are dropped and counted rather than growing without end.
+constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+struct TraceEvent {
+    const char* name;
+    char ph;           // 'X' complete span, 'C' counter
+    int64_t ts_us;
+    int64_t dur_us;
+    int64_t index;     // span argument; -1 = none
+    double value;      // counter value
+};
+
+/// One thread's events. Its mutex is only contended while the trace is
+/// being written.
+struct ThreadEvents {
+    std::mutex mu;
+    int tid = 0;
+    std::string name;
+    uint64_t generation = 0;
+    std::vector<TraceEvent> events;
+    size_t dropped = 0;
+};
+
+std::mutex g_mu;  // guards the fields below
+std::vector<std::shared_ptr<ThreadEvents>> g_threads;
+fs::path g_out;
+std::atomic<uint64_t> g_generation{0};  // written under g_mu
+std::atomic<int64_t> g_epoch_ns{0};
+std::set<std::string> g_names;  // trace_completed() names; never erased
+
+int64_t steady_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ThreadEvents& thread_events() {
+    thread_local std::shared_ptr<ThreadEvents> mine = [] {
+        auto t = std::make_shared<ThreadEvents>();
+        t->tid = static_cast<int>(syscall(SYS_gettid));
+        char name[32] = {};
+        if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0) t->name = name;
+        std::lock_guard<std::mutex> lock(g_mu);
+        g_threads.push_back(t);
+        return t;
+    }();
+    return *mine;
+}
+
+void record(const TraceEvent& ev) {
+    ThreadEvents& t = thread_events();
+    std::lock_guard<std::mutex> lock(t.mu);
+    // Events left from an earlier trace are discarded on first touch.
+    const uint64_t gen = g_generation.load(std::memory_order_acquire);
+    if (t.generation != gen) {
+        t.events.clear();
+        t.dropped = 0;
+        t.generation = gen;
+    }
+    if (t.events.size() >= MAX_EVENTS_PER_THREAD) {
+        ++t.dropped;
+        return;
+    }
+    t.events.push_back(ev);
+}
+
+std::string format_double(double v) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.6g", v);
+    return buf;
+}
+
+} // anonymous namespace
+
+namespace trace_detail {
+
+int64_t now_us() {
+    return (steady_ns() - g_epoch_ns.load(std::memory_order_relaxed)) / 1000;
+}
+
+void record_span(const char* name, int64_t start_us, int64_t end_us, int64_t index) {
+    record({name, 'X', start_us, end_us - start_us, index, 0.0});
+}
+
+} // namespace trace_detail
+
+void trace_start(const fs::path& out) {
+    std::lock_guard<std::mutex> lock(g_mu);
+    const uint64_t gen = g_generation.load(std::memory_order_relaxed) + 1;
+    for (auto& t : g_threads) {
+        std::lock_guard<std::mutex> tl(t->mu);
+        t->events.clear();
+        t->dropped = 0;
+        t->generation = gen;
+    }
+    g_generation.store(gen, std::memory_order_release);
+    g_out = out;
+    g_epoch_ns.store(steady_ns(), std::memory_order_relaxed);
+    trace_detail::enabled.store(true, std::memory_order_release);
+    log_info("trace: recording to %s", out.c_str());
+}
+
+bool trace_stop() {
+    if (!trace_detail::enabled.exchange(false, std::memory_order_acq_rel)) return true;
+
+    std::lock_guard<std::mutex> lock(g_mu);
+    const int pid = static_cast<int>(getpid());
+    const std::string pid_s = std::to_string(pid);
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto add = [&](const std::string& obj) {
+        if (!first) out += ",\n";
+        out += obj;
+        first = false;
+    };
+    add("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + pid_s +
+        ",\"tid\":" + pid_s + ",\"args\":{\"name\":\"recmeet\"}}");
+
+    size_t n_events = 0, dropped = 0;
+    for (auto& t : g_threads) {
+        std::lock_guard<std::mutex> tl(t->mu);
+        if (t->generation != g_generation.load(std::memory_order_relaxed) ||
+            (t->events.empty() && t->dropped == 0))
+            continue;
+        const std::string ids = "\"pid\":" + pid_s + ",\"tid\":" + std::to_string(t->tid);
+        if (!t->name.empty())
+            add("{\"name\":\"thread_name\",\"ph\":\"M\"," + ids +
+                ",\"args\":{\"name\":\"" + json_escape(t->name) + "\"}}");
+        for (const auto& ev : t->events) {
+            std::string obj = "{\"name\":\"" + json_escape(ev.name) + "\",\"ph\":\"";
+            obj += ev.ph;
+            obj += "\",\"ts\":" + std::to_string(ev.ts_us) + "," + ids;
+            if (ev.ph == 'X') {
+                obj += ",\"cat\":\"recmeet\",\"dur\":" + std::to_string(ev.dur_us);
+                if (ev.index >= 0) obj += ",\"args\":{\"index\":" + std::to_string(ev.index) + "}";
+            } else {
+                obj += ",\"args\":{\"value\":" + format_double(ev.value) + "}";
+            }
+            add(obj + "}");
+        }
+        n_events += t->events.size();
+        dropped += t->dropped;
+        t->events.clear();
+        t->events.shrink_to_fit();
+        t->dropped = 0;
+    }
+    out += "\n]}\n";
+    // Threads that have exited hold the only other reference.
+    g_threads.erase(std::remove_if(g_threads.begin(), g_threads.end(),
+                                   [](const auto& t) { return t.use_count() == 1; }),
+                    g_threads.end());
+
+    try {
+        write_text_file_atomic(g_out, out);
+    } catch (const std::exception& e) {
+        log_warn("trace: could not write %s: %s", g_out.c_str(), e.what());
+        return false;
+    }
+    if (dropped > 0)
+        log_warn("trace: %zu events dropped past %zu per thread", dropped, MAX_EVENTS_PER_THREAD);
+    log_info("trace: wrote %zu events to %s", n_events, g_out.c_str());
+    return true;
+}
+
+void trace_counter(const char* name, double value) {
+    if (!trace_enabled()) return;
+    record({name, 'C', trace_detail::now_us(), 0, -1, value});
+}
+
+void trace_completed(const std::string& name, double wall_sec, int64_t index) {
+    if (!trace_enabled()) return;
+    const char* interned;
+    {
+        std::lock_guard<std::mutex> lock(g_mu);
+        interned = g_names.insert(name).first->c_str();
+    }
+    const int64_t end = trace_detail::now_us();
+    const int64_t dur = static_cast<int64_t>(wall_sec * 1e6);
+    record({interned, 'X', end - dur, dur, index, 0.0});
+}
+
+} // namespace recmeet
@@ -0,0 +1,94 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace recmeet {
+
+namespace fs = std::filesystem;
+
+// ---------------------------------------------------------------------------
+// Trace spans
+// ---------------------------------------------------------------------------
+//
+// `--trace-out FILE` records where a run spends its time as scoped spans
+// and counters, each stamped with its thread, and writes them as Chrome
+// trace-event JSON, which ui.perfetto.dev and chrome://tracing open.
+// While no trace is running a span costs one relaxed atomic load.
+//
+// Names must be string literals (or otherwise outlive the trace): only the
+// pointer is kept.
+
+namespace trace_detail {
+extern std::atomic<bool> enabled;
+int64_t now_us();
+void record_span(const char* name, int64_t start_us, int64_t end_us, int64_t index);
+} // namespace trace_detail
+
+/// Start recording; trace_stop() writes what was recorded to `out`.
+/// Restarts, discarding the events so far, when a trace is running.
+void trace_start(const fs::path& out);
+
+/// Stop recording and write the trace. False (with a warning logged) when
+/// it could not be written; a no-op returning true without a trace.
+bool trace_stop();
+
+inline bool trace_enabled() {
+    return trace_detail::enabled.load(std::memory_order_relaxed);
+}
+
+/// A counter track sample, e.g. tokens generated or clients connected.
+void trace_counter(const char* name, double value);
+
+/// A span of `wall_sec` ending now, for work timed elsewhere (a StagePerf
+/// record). The name is copied, so it need not be a literal.
+void trace_completed(const std::string& name, double wall_sec, int64_t index = -1);
+
+/// One span, from construction to end() or destruction. `index` is shown
+/// as the span's argument when >= 0 (a chunk or window number).
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name, int64_t index = -1)
+        : name_(name), index_(index),
+          start_us_(trace_enabled() ? trace_detail::now_us() : -1) {}
+    ~TraceSpan() { end(); }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    void end() {
+        if (start_us_ < 0) return;
+        if (trace_enabled())
+            trace_detail::record_span(name_, start_us_, trace_detail::now_us(), index_);
+        start_us_ = -1;
+    }
+
+private:
+    const char* name_;
+    int64_t index_;
+    int64_t start_us_;
+};
+
+/// Runs a trace for its lifetime when `out` is non-empty.
+class TraceSession {
+public:
+    explicit TraceSession(const fs::path& out) : active_(!out.empty()) {
+        if (active_) trace_start(out);
+    }
+    ~TraceSession() {
+        if (active_) trace_stop();
+    }
+
+    TraceSession(const TraceSession&) = delete;
+    TraceSession& operator=(const TraceSession&) = delete;
+
+private:
+    bool active_;
+};
+
+} // namespace recmeet
@@ -3,14 +3,25 @@
 
 #include "transcribe.h"
 #include "audio_file.h"
+#include "backend_info.h"
 #include "log.h"
+#include "model_cache.h"
+#include "perf_counters.h"
+#include "trace.h"
 
 #include <whisper.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
 #include <cstdio>
 #include <cmath>
+#include <exception>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <unistd.h>
 
 namespace recmeet {
@@ -41,12 +52,23 @@ std::string TranscriptResult::to_string() const {
 // WhisperModel
 // ---------------------------------------------------------------------------
 
-WhisperModel::WhisperModel(const fs::path& model_path) : path_(model_path) {
-    log_info("Loading whisper model: %s", path_.filename().c_str());
+WhisperModel::WhisperModel(const fs::path& model_path, bool use_gpu, int gpu_device)
+    : path_(model_path), gpu_device_(gpu_device) {
+    ensure_backends();
+    if (!use_gpu)
+        log_info("Loading whisper model: %s (CPU)", path_.filename().c_str());
+    else if (gpu_device > 0)
+        log_info("Loading whisper model: %s (GPU %d)", path_.filename().c_str(), gpu_device);
+    else
+        log_info("Loading whisper model: %s", path_.filename().c_str());
     whisper_context_params cparams = whisper_context_default_params();
+    cparams.use_gpu = use_gpu;
+    cparams.gpu_device = gpu_device;
+    memory_.begin("whisper " + path_.filename().string(), {path_});
     ctx_ = whisper_init_from_file_with_params(path_.c_str(), cparams);
     if (!ctx_)
         throw RecmeetError("Failed to load whisper model: " + path_.string());
+    memory_.finish();
 }
 
 WhisperModel::~WhisperModel() {
@@ -55,7 +77,8 @@ WhisperModel::~WhisperModel() {
 }
 
 WhisperModel::WhisperModel(WhisperModel&& other) noexcept
-    : ctx_(other.ctx_), path_(std::move(other.path_)) {
+    : ctx_(other.ctx_), path_(std::move(other.path_)), gpu_device_(other.gpu_device_),
+      memory_(std::move(other.memory_)) {
     other.ctx_ = nullptr;
 }
 
@@ -65,11 +88,123 @@ WhisperModel& WhisperModel::operator=(WhisperModel&& other) noexcept {
             whisper_free(ctx_);
         ctx_ = other.ctx_;
         path_ = std::move(other.path_);
+        gpu_device_ = other.gpu_device_;
+        memory_ = std::move(other.memory_);
         other.ctx_ = nullptr;
     }
     return *this;
 }
 
+namespace {
+
+std::shared_ptr<WhisperModel> acquire_from(ModelSlot<WhisperModel>& slot,
+                                           const fs::path& model_path, bool use_gpu) {
+    bool loaded = false;
+    auto model = slot.get(model_path.string() + (use_gpu ? "" : "#cpu"), [&] {
+        loaded = true;
+        return std::make_unique<WhisperModel>(model_path, use_gpu);
+    });
+    if (!loaded)
+        log_info("Whisper model already loaded: %s", model_path.filename().c_str());
+    return model;
+}
+
+} // anonymous namespace
+
+std::shared_ptr<WhisperModel> acquire_whisper_model(const fs::path& model_path,
+                                                    bool use_gpu) {
+    static ModelSlot<WhisperModel> slot{"whisper"};
+    return acquire_from(slot, model_path, use_gpu);
+}
+
+std::shared_ptr<WhisperModel> acquire_whisper_draft_model(const fs::path& model_path,
+                                                          bool use_gpu) {
+    static ModelSlot<WhisperModel> slot{"whisper"};
+    return acquire_from(slot, model_path, use_gpu);
+}
+
+double time_whisper_backend(const fs::path& model_path, bool use_gpu) {
+    // Prompt tokens decoded in one batch, then tokens generated one at a
+    // time: about what one window of speech costs the decoder.
+    constexpr int PROMPT_TOKENS = 64;
+    constexpr int GENERATED_TOKENS = 32;
+    WhisperModel model(model_path, use_gpu);
+    whisper_context* ctx = model.get();
+    const int threads = default_thread_count();
+    const std::vector<whisper_token> tokens(PROMPT_TOKENS, 0);
+    auto pass = [&] {
+        // A zeroed mel: the encoder costs the same whatever the audio.
+        if (whisper_set_mel(ctx, nullptr, 0, whisper_model_n_mels(ctx)) != 0 ||
+            whisper_encode(ctx, 0, threads) != 0 ||
+            whisper_decode(ctx, tokens.data(), PROMPT_TOKENS, 0, threads) != 0)
+            throw RecmeetError("whisper benchmark pass failed: " + model_path.filename().string());
+        for (int i = 0; i < GENERATED_TOKENS; ++i)
+            if (whisper_decode(ctx, tokens.data(), 1, PROMPT_TOKENS + i, threads) != 0)
+                throw RecmeetError("whisper benchmark pass failed: " +
+                                   model_path.filename().string());
+    };
+    pass();  // the first GPU pass also builds its pipelines
+    const auto t0 = std::chrono::steady_clock::now();
+    pass();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// ---------------------------------------------------------------------------
+// Repetition-loop watchdog
+// ---------------------------------------------------------------------------
+
+namespace {
+
+// Lower-cased ASCII letters and digits plus any non-ASCII bytes, so
+// "Thank you." and "thank you" compare equal.
+std::string normalize_word(const std::string& word) {
+    std::string out;
+    for (unsigned char c : word) {
+        if (c >= 0x80)
+            out += static_cast<char>(c);
+        else if (std::isalnum(c))
+            out += static_cast<char>(std::tolower(c));
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+bool RepetitionDetector::feed(const std::string& text) {
+    if (looped()) return true;
+
+    std::istringstream in(text);
+    std::string word;
+    while (in >> word) {
+        auto w = normalize_word(word);
+        if (!w.empty()) words_.push_back(std::move(w));
+    }
+    segment_end_.push_back(words_.size());
+
+    const size_t len = words_.size();
+    for (size_t n = 1; n <= REPEAT_MAX_NGRAM && n * REPEAT_MIN_COUNT <= len; ++n) {
+        // Back-to-back copies of the last n words, counting that one.
+        size_t copies = 1;
+        while ((copies + 1) * n <= len &&
+               std::equal(words_.end() - n, words_.end(),
+                          words_.end() - static_cast<std::ptrdiff_t>((copies + 1) * n)))
+            ++copies;
+        const size_t needed = std::max(REPEAT_MIN_COUNT, (REPEAT_MIN_WORDS + n - 1) / n);
+        if (copies >= needed) {
+            loop_word_ = len - copies * n + n;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t RepetitionDetector::segments_before_loop() const {
+    size_t n = 0;
+    while (n < segment_end_.size() && segment_end_[n] <= loop_word_)
+        ++n;
+    return n;
+}
+
 // ---------------------------------------------------------------------------
 // Transcription
 // ---------------------------------------------------------------------------
@@ -81,6 +216,16 @@ WhisperModel& WhisperModel::operator=(WhisperModel&& other) noexcept {
 struct TranscribeCallbackState {
     std::function<void(int)> on_progress;
     StopToken* stop = nullptr;
+    const std::atomic<bool>* abort = nullptr;  // set by a failing sibling worker
+};
+
+// One whisper_full call: the caller's hooks plus the repetition watchdog,
+// which sees each segment as whisper finishes it.
+struct DecodeWatch {
+    TranscribeCallbackState* cb = nullptr;
+    double offset_seconds = 0.0;
+    RepetitionDetector repeats;
+    std::vector<TranscriptSegment> segments;  // fed to `repeats` so far
 };
 
 static void whisper_progress_cb(whisper_context*, whisper_state*, int progress, void* user_data) {
@@ -90,15 +235,83 @@ static void whisper_progress_cb(whisper_context*, whisper_state*, int progress,
 }
 
 static bool whisper_abort_cb(void* user_data) {
-    auto* state = static_cast<TranscribeCallbackState*>(user_data);
-    return state && state->stop && state->stop->stop_requested();
+    auto* watch = static_cast<DecodeWatch*>(user_data);
+    if (!watch) return false;
+    if (watch->repeats.looped()) return true;
+    auto* state = watch->cb;
+    if (!state) return false;
+    if (state->abort && state->abort->load(std::memory_order_relaxed)) return true;
+    return state->stop && state->stop->stop_requested();
+}
+
+// Segment `i` of the last decode on `state` (nullptr: the context's own),
+// text trimmed.
+static TranscriptSegment read_segment(whisper_context* ctx, whisper_state* state, int i,
+                                      double offset_seconds) {
+    TranscriptSegment seg;
+    int64_t t0 = state ? whisper_full_get_segment_t0_from_state(state, i)
+                       : whisper_full_get_segment_t0(ctx, i);
+    int64_t t1 = state ? whisper_full_get_segment_t1_from_state(state, i)
+                       : whisper_full_get_segment_t1(ctx, i);
+    seg.start = t0 / 100.0 + offset_seconds;
+    seg.end   = t1 / 100.0 + offset_seconds;
+    seg.text  = state ? whisper_full_get_segment_text_from_state(state, i)
+                      : whisper_full_get_segment_text(ctx, i);
+    seg.no_speech_prob = state ? whisper_full_get_segment_no_speech_prob_from_state(state, i)
+                               : whisper_full_get_segment_no_speech_prob(ctx, i);
+
+    // Confidence over the text tokens; timestamps and other special
+    // tokens sort after EOT.
+    const whisper_token eot = whisper_token_eot(ctx);
+    const int n_tokens = state ? whisper_full_n_tokens_from_state(state, i)
+                               : whisper_full_n_tokens(ctx, i);
+    double logprob_sum = 0.0;
+    int text_tokens = 0;
+    for (int j = 0; j < n_tokens; ++j) {
+        whisper_token_data tok = state ? whisper_full_get_token_data_from_state(state, i, j)
+                                       : whisper_full_get_token_data(ctx, i, j);
+        if (tok.id >= eot) continue;
+        logprob_sum += tok.plog;
+        ++text_tokens;
+    }
+    seg.avg_logprob = text_tokens > 0
+        ? static_cast<float>(logprob_sum / text_tokens) : 0.0f;
+
+    // Trim leading/trailing whitespace in place
+    const size_t first = seg.text.find_first_not_of(" \t\n\r");
+    if (first != std::string::npos) {
+        seg.text.erase(seg.text.find_last_not_of(" \t\n\r") + 1);
+        seg.text.erase(0, first);
+    }
+    return seg;
+}
+
+static void whisper_new_segment_cb(whisper_context* ctx, whisper_state* state, int n_new,
+                                   void* user_data) {
+    auto* watch = static_cast<DecodeWatch*>(user_data);
+    if (watch->repeats.looped()) return;
+    const int n = whisper_full_n_segments_from_state(state);
+    for (int i = std::max(0, n - n_new); i < n; ++i) {
+        auto seg = read_segment(ctx, state, i, watch->offset_seconds);
+        if (seg.text.empty()) continue;
+        watch->segments.push_back(std::move(seg));
+        if (watch->repeats.feed(watch->segments.back().text)) return;
+    }
 }
 
 // ---------------------------------------------------------------------------
 // Core transcription (shared implementation)
 // ---------------------------------------------------------------------------
 
-static TranscriptResult transcribe_impl(whisper_context* ctx, const float* samples,
+/// Token cap per segment for the re-decode of a looping window: a loop can
+/// no longer fill a whole segment, and a shorter context leaves less of it
+/// to condition on.
+constexpr int REPEAT_RETRY_MAX_TOKENS = 32;
+
+// `state` selects the whisper_state to decode on; nullptr uses the
+// context's own. Concurrent calls on one context need distinct states.
+static TranscriptResult transcribe_impl(whisper_context* ctx, whisper_state* state,
+                                         const float* samples,
                                          size_t num_samples, double offset_seconds,
                                          const std::string& language, int threads,
                                          TranscribeCallbackState* cb_state,
@@ -130,49 +343,86 @@ static TranscriptResult transcribe_impl(whisper_context* ctx, const float* sampl
         wparams.detect_language = false;
     }
 
-    // Wire up progress + abort callbacks if provided
-    if (cb_state) {
-        if (cb_state->on_progress) {
-            wparams.progress_callback = whisper_progress_cb;
-            wparams.progress_callback_user_data = cb_state;
-        }
-        if (cb_state->stop) {
-            wparams.abort_callback = whisper_abort_cb;
-            wparams.abort_callback_user_data = cb_state;
+    // Wire up progress if provided; the abort and new-segment callbacks
+    // always run, for the repetition watchdog.
+    if (cb_state && cb_state->on_progress) {
+        wparams.progress_callback = whisper_progress_cb;
+        wparams.progress_callback_user_data = cb_state;
+    }
+
+    auto decode = [&](whisper_full_params params, DecodeWatch& watch) {
+        watch.cb = cb_state;
+        watch.offset_seconds = offset_seconds;
+        params.new_segment_callback = whisper_new_segment_cb;
+        params.new_segment_callback_user_data = &watch;
+        params.abort_callback = whisper_abort_cb;
+        params.abort_callback_user_data = &watch;
+        const TraceSpan span("whisper_full");
+        const EngineCounterScope counters("whisper_full", PerfScope::Thread);
+        return state
+            ? whisper_full_with_state(ctx, state, params, samples, static_cast<int>(num_samples))
+            : whisper_full(ctx, params, samples, static_cast<int>(num_samples));
+    };
+    auto cancelled = [&] {
+        return cb_state && cb_state->stop && cb_state->stop->stop_requested();
+    };
+
+    TranscriptResult result;
+    DecodeWatch watch;
+    int ret = decode(wparams, watch);
+
+    // A loop was caught and the decode stopped early: decode the window
+    // again without the previous text as context, sampling away from the
+    // greedy path, with short segments.
+    std::vector<TranscriptSegment> kept;
+    bool truncated = false;
+    if (watch.repeats.looped() && !cancelled()) {
+        ++result.repetition_aborts;
+        log_info("Whisper repetition loop near %s; re-decoding the window",
+                 format_timestamp(watch.segments.back().start).c_str());
+        whisper_full_params retry = wparams;
+        retry.no_context = true;
+        retry.temperature = 0.2f;
+        retry.temperature_inc = 0.2f;
+        retry.entropy_thold = 2.8f;
+        retry.max_tokens = REPEAT_RETRY_MAX_TOKENS;
+
+        DecodeWatch second;
+        ret = decode(retry, second);
+        if (second.repeats.looped() && !cancelled()) {
+            // Still looping: keep what came before the loop.
+            ++result.repetition_aborts;
+            log_warn("Whisper repetition loop persists near %s; dropping the rest of the window",
+                     format_timestamp(second.segments.back().start).c_str());
+            kept.assign(second.segments.begin(),
+                        second.segments.begin() +
+                            static_cast<std::ptrdiff_t>(second.repeats.segments_before_loop()));
+            truncated = true;
         }
     }
 
-    int ret = whisper_full(ctx, wparams, samples, static_cast<int>(num_samples));
-    if (ret != 0) {
+    if (!truncated && ret != 0) {
         // Distinguish cancellation from real failure
-        if (cb_state && cb_state->stop && cb_state->stop->stop_requested())
+        if (cancelled())
             throw RecmeetError("Cancelled");
         throw RecmeetError("Whisper transcription failed (code " + std::to_string(ret) + ")");
     }
 
     // Extract segments
-    TranscriptResult result;
-    int n_segments = whisper_full_n_segments(ctx);
-    for (int i = 0; i < n_segments; ++i) {
-        TranscriptSegment seg;
-        seg.start = whisper_full_get_segment_t0(ctx, i) / 100.0 + offset_seconds;
-        seg.end   = whisper_full_get_segment_t1(ctx, i) / 100.0 + offset_seconds;
-        seg.text  = whisper_full_get_segment_text(ctx, i);
-
-        // Trim leading/trailing whitespace
-        auto ltrim = seg.text.find_first_not_of(" \t\n\r");
-        if (ltrim != std::string::npos)
-            seg.text = seg.text.substr(ltrim);
-        auto rtrim = seg.text.find_last_not_of(" \t\n\r");
-        if (rtrim != std::string::npos)
-            seg.text = seg.text.substr(0, rtrim + 1);
-
-        if (!seg.text.empty())
-            result.segments.push_back(std::move(seg));
+    if (truncated) {
+        result.segments = std::move(kept);
+    } else {
+        int n_segments = state ? whisper_full_n_segments_from_state(state)
+                               : whisper_full_n_segments(ctx);
+        for (int i = 0; i < n_segments; ++i) {
+            auto seg = read_segment(ctx, state, i, offset_seconds);
+            if (!seg.text.empty())
+                result.segments.push_back(std::move(seg));
+        }
     }
 
     // Language detection
-    int lang_id = whisper_full_lang_id(ctx);
+    int lang_id = state ? whisper_full_lang_id_from_state(state) : whisper_full_lang_id(ctx);
     result.language = whisper_lang_str(lang_id);
     result.language_prob = 0.0f; // whisper.cpp doesn't expose per-segment lang probs easily
 
@@ -182,7 +432,7 @@ static TranscriptResult transcribe_impl(whisper_context* ctx, const float* sampl
 TranscriptResult transcribe(WhisperModel& model, const float* samples,
                             size_t num_samples, double offset_seconds,
                             const std::string& language, int threads) {
-    return transcribe_impl(model.get(), samples, num_samples, offset_seconds,
+    return transcribe_impl(model.get(), nullptr, samples, num_samples, offset_seconds,
                            language, threads, nullptr);
 }
 
@@ -192,11 +442,381 @@ TranscriptResult transcribe(WhisperModel& model, const float* samples,
     TranscribeCallbackState cb_state;
     cb_state.on_progress = opts.on_progress;
     cb_state.stop = opts.stop;
-    return transcribe_impl(model.get(), samples, num_samples, offset_seconds,
+    return transcribe_impl(model.get(), nullptr, samples, num_samples, offset_seconds,
                            opts.language, opts.threads, &cb_state,
                            opts.initial_prompt);
 }
 
+TranscriptResult transcribe(WhisperModel& model, const SampleSource& audio,
+                            size_t start, size_t n, const TranscribeOptions& opts) {
+    std::vector<float> scratch;
+    size_t got = 0;
+    const float* pcm = audio.view(start, n, scratch, got);
+    if (got == 0) return TranscriptResult{};  // window past the end: nothing to decode
+    return transcribe(model, pcm, got,
+                      static_cast<double>(start) / SAMPLE_RATE, opts);
+}
+
+// ---------------------------------------------------------------------------
+// Concurrent window transcription
+// ---------------------------------------------------------------------------
+
+int resolve_transcribe_workers(int workers, int threads, size_t windows) {
+    int t = threads > 0 ? threads : default_thread_count();
+    int w = workers > 0
+        ? workers
+        : std::min(TRANSCRIBE_MAX_AUTO_WORKERS, t / TRANSCRIBE_THREADS_PER_WORKER);
+    w = std::min(w, t);
+    if (windows < static_cast<size_t>(std::max(w, 1)))
+        w = static_cast<int>(windows);
+    return std::max(w, 1);
+}
+
+namespace {
+
+// RAII whisper_state; nullptr stands for the context's own state.
+struct WhisperStateHandle {
+    whisper_state* state = nullptr;
+    ~WhisperStateHandle() {
+        if (state) whisper_free_state(state);
+    }
+};
+
+// Overall progress across windows, weighted by window length. Fed from
+// every worker's whisper progress callback; reports only increases.
+class WindowProgress {
+public:
+    WindowProgress(std::vector<size_t> weights, std::function<void(int)> on_progress)
+        : on_progress_(std::move(on_progress)), pct_(weights.size(), 0),
+          weights_(std::move(weights)) {
+        for (size_t w : weights_) total_ += w;
+    }
+
+    void update(size_t window, int pct) {
+        if (!on_progress_ || total_ == 0) return;
+        std::lock_guard lk(mtx_);
+        pct_[window] = std::clamp(pct, 0, 100);
+        double done = 0.0;
+        for (size_t i = 0; i < pct_.size(); ++i)
+            done += static_cast<double>(weights_[i]) * pct_[i];
+        int overall = static_cast<int>(done / static_cast<double>(total_));
+        if (overall > last_) {
+            last_ = overall;
+            on_progress_(overall);
+        }
+    }
+
+private:
+    std::function<void(int)> on_progress_;
+    std::mutex mtx_;
+    std::vector<int> pct_;
+    std::vector<size_t> weights_;
+    size_t total_ = 0;
+    int last_ = -1;
+};
+
+// Decode one packed window on `state`. A single piece is transcribed
+// straight from the source (no copy); several are assembled into `buf`
+// with zeroed gaps and their timestamps mapped back afterwards.
+TranscriptResult transcribe_packed(whisper_context* ctx, whisper_state* state,
+                                   const SampleSource& audio, const PackedWindow& win,
+                                   std::vector<float>& buf, int threads,
+                                   const TranscribeOptions& opts,
+                                   TranscribeCallbackState* cb_state) {
+    if (win.pieces.empty()) return TranscriptResult{};
+    if (win.pieces.size() == 1) {
+        const auto& p = win.pieces[0];
+        size_t got = 0;
+        const float* pcm = audio.view(p.start, p.n, buf, got);
+        if (got == 0) return TranscriptResult{};
+        return transcribe_impl(ctx, state, pcm, got,
+                               static_cast<double>(p.start) / SAMPLE_RATE,
+                               opts.language, threads, cb_state, opts.initial_prompt);
+    }
+
+    buf.assign(win.length, 0.0f);
+    for (const auto& p : win.pieces)
+        audio.read(p.start, p.n, buf.data() + p.offset);
+    auto result = transcribe_impl(ctx, state, buf.data(), buf.size(), 0.0,
+                                  opts.language, threads, cb_state, opts.initial_prompt);
+    for (auto& seg : result.segments) {
+        seg.start = win.to_source_seconds(seg.start, false);
+        seg.end = std::max(seg.start, win.to_source_seconds(seg.end, true));
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+double PackedWindow::to_source_seconds(double t, bool is_end) const {
+    if (pieces.empty()) return t;
+    const double s = std::max(0.0, t) * SAMPLE_RATE;
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        const auto& p = pieces[i];
+        const double piece_end = static_cast<double>(p.offset + p.n);
+        if (s < static_cast<double>(p.offset)) {
+            // In the gap before piece i (i > 0, since piece 0 is at 0).
+            const auto& prev = pieces[i - 1];
+            return static_cast<double>(is_end ? prev.start + prev.n : p.start) / SAMPLE_RATE;
+        }
+        if (s < piece_end || (is_end && s == piece_end))
+            return (static_cast<double>(p.start) + (s - static_cast<double>(p.offset))) / SAMPLE_RATE;
+    }
+    const auto& last = pieces.back();
+    return static_cast<double>(last.start + last.n) / SAMPLE_RATE;
+}
+
+std::vector<PackedWindow> pack_windows(const std::vector<TranscribeWindow>& segments,
+                                       size_t max_window, size_t max_gap) {
+    std::vector<PackedWindow> out;
+    size_t prev_end = 0;
+    for (const auto& seg : segments) {
+        if (seg.n == 0) continue;
+        size_t gap = seg.start > prev_end ? std::min(seg.start - prev_end, max_gap) : 0;
+        if (out.empty() || out.back().length + gap + seg.n > max_window) {
+            out.emplace_back();
+            gap = 0;
+        }
+        auto& win = out.back();
+        win.pieces.push_back({seg.start, seg.n, win.length + gap});
+        win.length += gap + seg.n;
+        prev_end = seg.start + seg.n;
+    }
+    return out;
+}
+
+std::vector<PackedWindow> single_windows(const std::vector<TranscribeWindow>& segments) {
+    std::vector<PackedWindow> out;
+    out.reserve(segments.size());
+    for (const auto& seg : segments) {
+        PackedWindow pw;
+        pw.pieces.push_back({seg.start, seg.n, 0});
+        pw.length = seg.n;
+        out.push_back(std::move(pw));
+    }
+    return out;
+}
+
+TranscriptResult transcribe_windows(WhisperModel& model, const SampleSource& audio,
+                                    const std::vector<TranscribeWindow>& windows,
+                                    int workers, const TranscribeOptions& opts) {
+    return transcribe_windows(model, audio, single_windows(windows), workers, opts);
+}
+
+TranscriptResult transcribe_windows(WhisperModel& model, const SampleSource& audio,
+                                    const std::vector<PackedWindow>& windows,
+                                    int workers, const TranscribeOptions& opts) {
+    return transcribe_windows(std::vector<WhisperModel*>{&model}, audio, windows, workers, opts);
+}
+
+TranscriptResult transcribe_windows(const std::vector<WhisperModel*>& models,
+                                    const SampleSource& audio,
+                                    const std::vector<PackedWindow>& windows,
+                                    int workers, const TranscribeOptions& opts) {
+    TranscriptResult merged{};
+    for (auto& r : transcribe_each_window(models, audio, windows, workers, opts)) {
+        for (auto& seg : r.segments)
+            merged.segments.push_back(std::move(seg));
+        if (merged.language.empty())
+            merged.language = r.language;
+        merged.repetition_aborts += r.repetition_aborts;
+    }
+    merged.language_prob = 0.0f;
+    return merged;
+}
+
+std::vector<TranscriptResult> transcribe_each_window(WhisperModel& model,
+                                                     const SampleSource& audio,
+                                                     const std::vector<PackedWindow>& windows,
+                                                     int workers,
+                                                     const TranscribeOptions& opts) {
+    return transcribe_each_window(std::vector<WhisperModel*>{&model}, audio, windows, workers,
+                                  opts);
+}
+
+std::vector<TranscriptResult> transcribe_each_window(const std::vector<WhisperModel*>& models,
+                                                     const SampleSource& audio,
+                                                     const std::vector<PackedWindow>& windows,
+                                                     int workers,
+                                                     const TranscribeOptions& opts) {
+    if (windows.empty() || models.empty()) return {};
+
+    // Worker w decodes on copy w % n_models; no copy goes without one.
+    const size_t n_models = std::min(models.size(), windows.size());
+    const int threads = opts.threads > 0 ? opts.threads : default_thread_count();
+    const int per_model = std::max(
+        1, resolve_transcribe_workers(workers, threads, windows.size()) /
+               static_cast<int>(n_models));
+    const int n_workers = per_model * static_cast<int>(n_models);
+    const int per_worker = std::max(1, threads / n_workers);
+    log_debug("transcribe: %zu windows on %zu model(s) x %d worker(s) x %d threads",
+              windows.size(), n_models, per_model, per_worker);
+
+    // Extra states are allocated up front so an allocation failure is
+    // reported before any decoding starts. The first worker on each copy
+    // uses the context's own.
+    std::vector<WhisperStateHandle> states(static_cast<size_t>(n_workers));
+    for (size_t w = n_models; w < states.size(); ++w) {
+        states[w].state = whisper_init_state(models[w % n_models]->get());
+        if (!states[w].state)
+            throw RecmeetError("Failed to allocate whisper state for worker " +
+                               std::to_string(w));
+    }
+
+    // Per worker: windows, samples and seconds decoded.
+    struct WorkerLoad {
+        size_t windows = 0;
+        size_t samples = 0;
+        double seconds = 0.0;
+    };
+    std::vector<WorkerLoad> loads(states.size());
+
+    std::vector<size_t> weights;
+    weights.reserve(windows.size());
+    for (const auto& w : windows) weights.push_back(w.length);
+    WindowProgress progress(std::move(weights), opts.on_progress);
+    std::vector<TranscriptResult> results(windows.size());
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr first_error;
+    std::mutex error_mtx;
+
+    auto run = [&](size_t w) {
+        WhisperModel& model = *models[w % n_models];
+        std::vector<float> scratch;
+        for (;;) {
+            if (failed.load(std::memory_order_relaxed)) return;
+            if (opts.stop && opts.stop->stop_requested()) return;
+            size_t i = next.fetch_add(1);
+            if (i >= windows.size()) return;
+
+            TranscribeCallbackState cb_state;
+            cb_state.stop = opts.stop;
+            cb_state.abort = &failed;
+            if (opts.on_progress)
+                cb_state.on_progress = [&progress, i](int pct) { progress.update(i, pct); };
+            try {
+                const auto t0 = std::chrono::steady_clock::now();
+                results[i] = transcribe_packed(model.get(), states[w].state, audio,
+                                               windows[i], scratch, per_worker, opts,
+                                               &cb_state);
+                loads[w].windows++;
+                loads[w].samples += windows[i].length;
+                loads[w].seconds += std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - t0).count();
+                progress.update(i, 100);
+            } catch (...) {
+                std::lock_guard lk(error_mtx);
+                if (!first_error) first_error = std::current_exception();
+                failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    };
+
+    if (n_workers == 1) {
+        run(0);
+    } else {
+        std::vector<std::thread> pool;
+        for (size_t w = 1; w < states.size(); ++w)
+            pool.emplace_back(run, w);
+        run(0);
+        for (auto& t : pool) t.join();
+    }
+
+    // A cancelled run may also have recorded a sibling's "Cancelled" error;
+    // report the cancellation itself in either case.
+    if (opts.stop && opts.stop->stop_requested())
+        throw RecmeetError("Cancelled");
+    if (first_error)
+        std::rethrow_exception(first_error);
+
+    if (n_models > 1) {
+        for (size_t m = 0; m < n_models; ++m) {
+            WorkerLoad sum;
+            for (size_t w = m; w < loads.size(); w += n_models) {
+                sum.windows += loads[w].windows;
+                sum.samples += loads[w].samples;
+                sum.seconds = std::max(sum.seconds, loads[w].seconds);
+            }
+            const double audio_sec = static_cast<double>(sum.samples) / SAMPLE_RATE;
+            log_info("transcribe: GPU %d: %zu windows, %.0f s of audio in %.1f s (%.1fx real time)",
+                     models[m]->gpu_device(), sum.windows, audio_sec, sum.seconds,
+                     sum.seconds > 0 ? audio_sec / sum.seconds : 0.0);
+        }
+    }
+    return results;
+}
+
+// ---------------------------------------------------------------------------
+// Language pinning
+// ---------------------------------------------------------------------------
+
+std::vector<TranscribeWindow> leading_speech(const std::vector<TranscribeWindow>& windows,
+                                             size_t max_samples) {
+    std::vector<TranscribeWindow> out;
+    size_t total = 0;
+    for (const auto& w : windows) {
+        if (total >= max_samples) break;
+        if (w.n == 0) continue;
+        out.push_back({w.start, std::min(w.n, max_samples - total)});
+        total += out.back().n;
+    }
+    return out;
+}
+
+LanguageGuess detect_language(WhisperModel& model, const SampleSource& audio,
+                              const std::vector<TranscribeWindow>& windows,
+                              size_t max_samples, int threads) {
+    std::vector<float> pcm;
+    std::vector<float> scratch;
+    for (const auto& w : leading_speech(windows, std::min(max_samples, WHISPER_WINDOW_SAMPLES))) {
+        size_t got = 0;
+        const float* p = audio.view(w.start, w.n, scratch, got);
+        pcm.insert(pcm.end(), p, p + got);
+    }
+    LanguageGuess guess;
+    if (pcm.empty()) return guess;
+
+    const int n_threads = threads > 0 ? threads : default_thread_count();
+    whisper_context* ctx = model.get();
+    if (whisper_pcm_to_mel(ctx, pcm.data(), static_cast<int>(pcm.size()), n_threads) != 0)
+        throw RecmeetError("Whisper language detection failed (mel)");
+    std::vector<float> probs(static_cast<size_t>(whisper_lang_max_id()) + 1, 0.0f);
+    const int lang_id = whisper_lang_auto_detect(ctx, 0, n_threads, probs.data());
+    if (lang_id < 0)
+        throw RecmeetError("Whisper language detection failed (code " +
+                           std::to_string(lang_id) + ")");
+    guess.language = whisper_lang_str(lang_id);
+    guess.prob = probs[static_cast<size_t>(lang_id)];
+    return guess;
+}
+
+// ---------------------------------------------------------------------------
+// Two-pass transcription
+// ---------------------------------------------------------------------------
+
+bool draft_window_confident(const TranscriptResult& draft, float logprob_threshold) {
+    if (draft.segments.empty()) return false;
+    for (const auto& seg : draft.segments) {
+        if (seg.avg_logprob < logprob_threshold ||
+            seg.no_speech_prob > DRAFT_NO_SPEECH_THRESHOLD)
+            return false;
+    }
+    return true;
+}
+
+double DraftPassStats::full_estimate_sec() const {
+    if (redecoded_samples == 0) return -1.0;
+    return redecode_sec * static_cast<double>(samples) /
+           static_cast<double>(redecoded_samples);
+}
+
+double DraftPassStats::saved_sec() const {
+    const double full = full_estimate_sec();
+    return full < 0.0 ? 0.0 : full - draft_sec - redecode_sec;
+}
+
 TranscriptResult transcribe(WhisperModel& model, const fs::path& audio_path,
                             const std::string& language, int threads) {
     // Read audio as float32 [-1, 1]
@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include "model_memory.h"
+#include "sample_source.h"
 #include "util.h"
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -20,7 +23,10 @@ namespace recmeet {
 class WhisperModel {
 public:
     /// Load a GGUF model from disk.  Throws RecmeetError on failure.
-    explicit WhisperModel(const fs::path& model_path);
+    /// `use_gpu` false keeps whisper on the CPU backend even when a GPU
+    /// device enumerates (Config::whisper_gpu). `gpu_device` picks the GPU
+    /// (GpuDevice::index in backend_info.h).
+    explicit WhisperModel(const fs::path& model_path, bool use_gpu = true, int gpu_device = 0);
     ~WhisperModel();
 
     WhisperModel(const WhisperModel&) = delete;
@@ -31,12 +37,31 @@ public:
 
     whisper_context* get() const { return ctx_; }
     const fs::path& path() const { return path_; }
+    int gpu_device() const { return gpu_device_; }
 
 private:
     whisper_context* ctx_ = nullptr;
     fs::path path_;
+    int gpu_device_ = 0;
+    ModelMemory memory_;
 };
 
+/// Load `model_path`, or return the model left resident by an earlier job
+/// when the model cache is on (model_cache.h). Throws RecmeetError.
+std::shared_ptr<WhisperModel> acquire_whisper_model(const fs::path& model_path,
+                                                    bool use_gpu = true);
+
+/// Same, from a slot of its own, so a warm worker keeps the two-pass draft
+/// model resident next to the main one.
+std::shared_ptr<WhisperModel> acquire_whisper_draft_model(const fs::path& model_path,
+                                                          bool use_gpu = true);
+
+/// Seconds of one benchmark pass of `model_path` on the GPU or the CPU:
+/// an encoder run over a 30 s window, a 64-token prompt and 32 generated
+/// tokens, after one untimed pass. For choose_gpu_backend() in
+/// backend_bench.h. Throws RecmeetError.
+double time_whisper_backend(const fs::path& model_path, bool use_gpu);
+
 // ---------------------------------------------------------------------------
 // Transcript types
 // ---------------------------------------------------------------------------
@@ -45,17 +70,55 @@ struct TranscriptSegment {
     double start;  // seconds
     double end;
     std::string text;
+    float avg_logprob = 0.0f;     ///< mean log-probability of the text tokens
+    float no_speech_prob = 0.0f;  ///< whisper's no-speech probability for the segment
 };
 
 struct TranscriptResult {
     std::vector<TranscriptSegment> segments;
     std::string language;
     float language_prob;
+    int repetition_aborts = 0;  ///< decodes stopped by RepetitionDetector
 
     /// Format as timestamped text: "[MM:SS - MM:SS] text"
     std::string to_string() const;
 };
 
+// ---------------------------------------------------------------------------
+// Repetition-loop watchdog
+// ---------------------------------------------------------------------------
+
+/// Longest n-gram (in words) RepetitionDetector looks for.
+constexpr size_t REPEAT_MAX_NGRAM = 10;
+/// A loop repeats its n-gram at least this often...
+constexpr size_t REPEAT_MIN_COUNT = 3;
+/// ...and spans at least this many words, so a short emphatic "no, no, no"
+/// is not a loop but twelve of them are.
+constexpr size_t REPEAT_MIN_WORDS = 12;
+
+/// Watches whisper's segments as they are decoded for a hallucination loop
+/// (the same phrase over and over, typically on music or silence): the
+/// words so far end in one n-gram of 1..REPEAT_MAX_NGRAM words repeated
+/// back to back at least max(REPEAT_MIN_COUNT, REPEAT_MIN_WORDS / n)
+/// times. Words are compared lower-cased without punctuation.
+class RepetitionDetector {
+public:
+    /// Add the next segment's text. Returns true once a loop is found.
+    bool feed(const std::string& text);
+
+    bool looped() const { return loop_word_ != kNone; }
+
+    /// Leading segments that end before the loop's second copy — what is
+    /// kept when re-decoding cannot get rid of the loop.
+    size_t segments_before_loop() const;
+
+private:
+    static constexpr size_t kNone = static_cast<size_t>(-1);
+    std::vector<std::string> words_;
+    std::vector<size_t> segment_end_;  ///< words_ size after each segment
+    size_t loop_word_ = kNone;         ///< first word of the loop's second copy
+};
+
 // ---------------------------------------------------------------------------
 // Transcription options (progress + cancellation)
 // ---------------------------------------------------------------------------
@@ -88,6 +151,184 @@ TranscriptResult transcribe(WhisperModel& model, const float* samples,
                             size_t num_samples, double offset_seconds,
                             const TranscribeOptions& opts);
 
+/// Transcribe samples [start, start + n) of `audio` (clamped). Timestamps are
+/// relative to the start of the source. whisper_full needs one contiguous
+/// buffer, so only this window is converted to float, for the call's
+/// duration — bound `n` (e.g. by VAD segment) to bound the footprint.
+TranscriptResult transcribe(WhisperModel& model, const SampleSource& audio,
+                            size_t start, size_t n, const TranscribeOptions& opts);
+
+/// One window of a source to transcribe: samples [start, start + n).
+struct TranscribeWindow {
+    size_t start;
+    size_t n;
+};
+
+/// Several source ranges decoded by one whisper call: the pieces are laid
+/// out back to back in a single buffer, separated by short runs of silence,
+/// and whisper's timestamps are mapped back through to_source_seconds().
+/// Built by pack_windows().
+struct PackedWindow {
+    struct Piece {
+        size_t start;   ///< first sample in the source
+        size_t n;       ///< samples
+        size_t offset;  ///< position of the piece within the window
+    };
+    std::vector<Piece> pieces;
+    size_t length = 0;  ///< window samples, pieces plus gaps
+
+    /// Map a time in the window (seconds) to the source. A time that falls
+    /// in an inserted gap maps to the start of the next piece, or with
+    /// `is_end` to the end of the previous one; past the last piece it maps
+    /// to that piece's end.
+    double to_source_seconds(double t, bool is_end) const;
+};
+
+/// Whisper's encoder always runs over a 30 s mel window, however short the
+/// input; windows are packed up to this length.
+constexpr size_t WHISPER_WINDOW_SAMPLES = 30 * static_cast<size_t>(SAMPLE_RATE);
+
+/// Longest silence kept between packed segments. Enough for whisper to see
+/// a pause (and end a sentence) without spending the window on silence.
+constexpr size_t PACK_MAX_GAP_SAMPLES = static_cast<size_t>(SAMPLE_RATE) / 2;
+
+/// Greedily pack consecutive `segments` (in source order, non-overlapping)
+/// into windows of at most `max_window` samples. Each gap between segments
+/// becomes min(actual gap, max_gap) samples of silence. A segment longer
+/// than `max_window` gets a window of its own.
+std::vector<PackedWindow> pack_windows(const std::vector<TranscribeWindow>& segments,
+                                       size_t max_window = WHISPER_WINDOW_SAMPLES,
+                                       size_t max_gap = PACK_MAX_GAP_SAMPLES);
+
+/// One window per segment, unpacked: what transcribe_windows() decodes for
+/// TranscribeWindow input.
+std::vector<PackedWindow> single_windows(const std::vector<TranscribeWindow>& segments);
+
+/// Threads per worker below which the automatic worker count stops adding
+/// workers: whisper's decoder stops scaling well past a handful of threads
+/// per call, so a wide machine is better used by several concurrent calls.
+constexpr int TRANSCRIBE_THREADS_PER_WORKER = 4;
+
+/// Cap on the automatic worker count. Every worker beyond the first holds
+/// its own whisper_state (KV cache + compute buffers, tens to hundreds of
+/// MB depending on the model), so the default stays modest.
+constexpr int TRANSCRIBE_MAX_AUTO_WORKERS = 8;
+
+/// Number of concurrent whisper calls to use for `windows` windows with a
+/// budget of `threads` threads (0 = default_thread_count()). `workers` is
+/// the configured count; 0 = auto (threads / TRANSCRIBE_THREADS_PER_WORKER,
+/// capped at TRANSCRIBE_MAX_AUTO_WORKERS). Never more than one per window
+/// or per thread, never less than 1.
+int resolve_transcribe_workers(int workers, int threads, size_t windows);
+
+/// Transcribe each window of `audio` and return the segments of all of them
+/// in window order (timestamps relative to the source, as in the window
+/// overload above). Windows are taken from a shared queue by `workers`
+/// threads (see resolve_transcribe_workers), each running whisper on its
+/// own whisper_state over the one loaded model, with opts.threads split
+/// between them — the weights are never loaded twice.
+///
+/// opts.on_progress reports overall progress weighted by window length and
+/// may be called from any worker thread (calls are serialized). If any
+/// window fails, the remaining ones are aborted and the first error is
+/// rethrown; cancellation via opts.stop throws "Cancelled".
+TranscriptResult transcribe_windows(WhisperModel& model, const SampleSource& audio,
+                                    const std::vector<TranscribeWindow>& windows,
+                                    int workers, const TranscribeOptions& opts);
+
+/// Same, one whisper call per packed window; segment timestamps are mapped
+/// back to source positions. Segments come back in source order.
+TranscriptResult transcribe_windows(WhisperModel& model, const SampleSource& audio,
+                                    const std::vector<PackedWindow>& windows,
+                                    int workers, const TranscribeOptions& opts);
+
+/// Same, with the windows spread over several copies of one model, each
+/// loaded on its own GPU (Config::whisper_gpu_devices). The workers are
+/// split evenly between the copies, at least one each, and all of them
+/// take windows from the one queue, so a faster GPU decodes more of them.
+/// With more than one copy, each one's windows, audio and decode time are
+/// logged when the run finishes.
+TranscriptResult transcribe_windows(const std::vector<WhisperModel*>& models,
+                                    const SampleSource& audio,
+                                    const std::vector<PackedWindow>& windows,
+                                    int workers, const TranscribeOptions& opts);
+
+/// Same, but one result per window instead of the merged segments.
+std::vector<TranscriptResult> transcribe_each_window(WhisperModel& model,
+                                                     const SampleSource& audio,
+                                                     const std::vector<PackedWindow>& windows,
+                                                     int workers,
+                                                     const TranscribeOptions& opts);
+std::vector<TranscriptResult> transcribe_each_window(const std::vector<WhisperModel*>& models,
+                                                     const SampleSource& audio,
+                                                     const std::vector<PackedWindow>& windows,
+                                                     int workers,
+                                                     const TranscribeOptions& opts);
+
+// ---------------------------------------------------------------------------
+// Language pinning (Config::language_pin_sec)
+//
+// With no configured language every whisper call detects it anew, which
+// costs decoder work per window and lets the language flip between
+// windows. Instead it is detected once, on the first seconds of speech,
+// and passed as the language of every window.
+// ---------------------------------------------------------------------------
+
+/// Whisper's guess at the spoken language.
+struct LanguageGuess {
+    std::string language;  ///< whisper code, e.g. "en"; empty when there was no audio
+    float prob = 0.0f;     ///< probability whisper gave it
+};
+
+/// The first `max_samples` samples of speech in `windows`: a prefix of
+/// `windows` with the last one shortened to fit.
+std::vector<TranscribeWindow> leading_speech(const std::vector<TranscribeWindow>& windows,
+                                             size_t max_samples);
+
+/// Detect the language of the leading_speech() of `windows`, joined without
+/// their gaps, in one encoder pass (whisper looks at 30 s at most). Runs
+/// on the context's own state, so no other call may decode on `model`
+/// meanwhile. Throws RecmeetError if whisper fails.
+LanguageGuess detect_language(WhisperModel& model, const SampleSource& audio,
+                              const std::vector<TranscribeWindow>& windows,
+                              size_t max_samples, int threads = 0);
+
+// ---------------------------------------------------------------------------
+// Two-pass transcription (Config::whisper_draft_model)
+//
+// A small draft model decodes every window; the windows it was unsure of
+// are decoded again with the configured model, and its result replaces the
+// draft's.
+// ---------------------------------------------------------------------------
+
+/// Above this no-speech probability the draft is treated as unsure whether
+/// anything was said (whisper's own no_speech_thold default).
+constexpr float DRAFT_NO_SPEECH_THRESHOLD = 0.6f;
+
+/// Whether a draft window's result can be kept: it produced text and every
+/// segment has avg_logprob >= `logprob_threshold` and no_speech_prob <=
+/// DRAFT_NO_SPEECH_THRESHOLD. VAD found speech in every window, so an
+/// empty draft is not trusted either.
+bool draft_window_confident(const TranscriptResult& draft, float logprob_threshold);
+
+/// What a two-pass run did, for the log and the `transcribe.draft` event.
+struct DraftPassStats {
+    size_t windows = 0;            ///< windows decoded by the draft model
+    size_t redecoded = 0;          ///< of those, decoded again
+    size_t samples = 0;            ///< audio in all windows
+    size_t redecoded_samples = 0;  ///< audio in the re-decoded windows
+    double draft_sec = 0.0;        ///< wall time of the draft pass
+    double redecode_sec = 0.0;     ///< wall time of the re-decode pass
+
+    /// Projected wall time for decoding every window with the full model,
+    /// scaled from the re-decode pass by audio length; < 0 when nothing
+    /// was re-decoded (no measurement to scale from).
+    double full_estimate_sec() const;
+    /// full_estimate_sec() minus the time both passes took (negative when
+    /// two passes were slower); 0 when the estimate is unknown.
+    double saved_sec() const;
+};
+
 /// Convenience: load the model, transcribe, then free.
 /// Equivalent to constructing a temporary WhisperModel and calling the above.
 TranscriptResult transcribe(const fs::path& model_path, const fs::path& audio_path,
@@ -0,0 +1,118 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "transcript_store.h"
+#include "diarize.h"
+#include "util.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+namespace recmeet {
+
+namespace {
+
+// "[MM:SS - MM:SS] " as TranscriptResult::to_string() writes it; returns
+// its length.
+int format_span(char* buf, size_t size, double start, double end) {
+    const int s = static_cast<int>(start), e = static_cast<int>(end);
+    return std::snprintf(buf, size, "[%02d:%02d - %02d:%02d] ", s / 60, s % 60, e / 60, e % 60);
+}
+
+} // anonymous namespace
+
+TranscriptStore::TranscriptStore(const std::vector<TranscriptSegment>& segments) {
+    size_t bytes = 0;
+    for (const auto& seg : segments) bytes += seg.text.size();
+    arena_.reserve(bytes);
+    start_.reserve(segments.size());
+    end_.reserve(segments.size());
+    offset_.reserve(segments.size());
+    length_.reserve(segments.size());
+    avg_logprob_.reserve(segments.size());
+    no_speech_prob_.reserve(segments.size());
+    for (const auto& seg : segments)
+        add(seg.start, seg.end, seg.text, seg.avg_logprob, seg.no_speech_prob);
+}
+
+void TranscriptStore::add(double start, double end, std::string_view text, float avg_logprob,
+                          float no_speech_prob) {
+    const size_t first = text.find_first_not_of(" \t\n\r");
+    text = first == std::string_view::npos
+        ? std::string_view{} : text.substr(first, text.find_last_not_of(" \t\n\r") - first + 1);
+    if (arena_.size() + text.size() > std::numeric_limits<uint32_t>::max())
+        throw RecmeetError("Transcript exceeds 4 GB of text");
+    start_.push_back(start);
+    end_.push_back(end);
+    offset_.push_back(static_cast<uint32_t>(arena_.size()));
+    length_.push_back(static_cast<uint32_t>(text.size()));
+    avg_logprob_.push_back(avg_logprob);
+    no_speech_prob_.push_back(no_speech_prob);
+    arena_.append(text);
+}
+
+void TranscriptStore::set_speakers(std::vector<int> speakers, std::map<int, std::string> labels) {
+    speakers.resize(std::min(speakers.size(), size()));
+    for (int sid : speakers)
+        if (!labels.count(sid)) labels[sid] = format_speaker(sid);
+    speaker_ = std::move(speakers);
+    labels_ = std::move(labels);
+}
+
+std::string_view TranscriptStore::label(size_t i) const {
+    if (i >= speaker_.size()) return {};
+    return labels_.at(speaker_[i]);
+}
+
+size_t TranscriptStore::rendered_size(double min_start) const {
+    char buf[64];
+    size_t n = 0;
+    for (size_t i = 0; i < size(); ++i) {
+        if (start_[i] < min_start) continue;
+        n += static_cast<size_t>(format_span(buf, sizeof(buf), start_[i], end_[i])) +
+             length_[i] + 1;
+        if (i < speaker_.size()) n += labels_.at(speaker_[i]).size() + 2;
+    }
+    return n;
+}
+
+std::string TranscriptStore::render_from(double min_start) const {
+    std::string out;
+    out.reserve(rendered_size(min_start));
+    char buf[64];
+    for (size_t i = 0; i < size(); ++i) {
+        if (start_[i] < min_start) continue;
+        out.append(buf, static_cast<size_t>(format_span(buf, sizeof(buf), start_[i], end_[i])));
+        if (i < speaker_.size()) {
+            out += labels_.at(speaker_[i]);
+            out += ": ";
+        }
+        out.append(arena_, offset_[i], length_[i]);
+        out += '\n';
+    }
+    return out;
+}
+
+std::string TranscriptStore::render() const {
+    return render_from(-std::numeric_limits<double>::infinity());
+}
+
+std::string TranscriptStore::render_after(double after_sec) const {
+    // Live segments are stored to the millisecond.
+    return render_from(after_sec - 0.001);
+}
+
+std::vector<TranscriptSegment> TranscriptStore::segments() const {
+    std::vector<TranscriptSegment> out;
+    out.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        TranscriptSegment seg{start_[i], end_[i], std::string(text(i))};
+        seg.avg_logprob = avg_logprob_[i];
+        seg.no_speech_prob = no_speech_prob_[i];
+        out.push_back(std::move(seg));
+    }
+    return out;
+}
+
+} // namespace recmeet
@@ -0,0 +1,84 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "transcribe.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Transcript store
+// ---------------------------------------------------------------------------
+//
+// A meeting's transcript with all its text in one buffer. Each segment is an
+// offset and length into that buffer, and its times, confidence and speaker
+// sit in columns beside it. Speaker labels are a table, and "Label: " is
+// added only when the transcript is rendered, so labelling or relabelling a
+// meeting copies no text. A 4-hour meeting's segments are then a handful of
+// allocations instead of one std::string each, plus a labelled copy of each.
+//
+// render() gives TranscriptResult::to_string()'s format after
+// label_speakers(), "[MM:SS - MM:SS] Label: text" per line, into a string
+// allocated once at its final size.
+
+class TranscriptStore {
+public:
+    TranscriptStore() = default;
+    /// The segments' text, trimmed as add() trims it.
+    explicit TranscriptStore(const std::vector<TranscriptSegment>& segments);
+
+    /// Append a segment. Leading and trailing whitespace of `text` is
+    /// dropped; the store keeps what is left.
+    void add(double start, double end, std::string_view text, float avg_logprob = 0.0f,
+             float no_speech_prob = 0.0f);
+
+    /// Label segment i with speaker `speakers[i]`, named by `labels` or
+    /// format_speaker() when it has no entry. Segments past the end of
+    /// `speakers` stay unlabelled; an empty vector removes every label.
+    void set_speakers(std::vector<int> speakers, std::map<int, std::string> labels = {});
+
+    size_t size() const { return start_.size(); }
+    bool empty() const { return start_.empty(); }
+    double start(size_t i) const { return start_[i]; }
+    double end(size_t i) const { return end_[i]; }
+    std::string_view text(size_t i) const {
+        return std::string_view(arena_).substr(offset_[i], length_[i]);
+    }
+    /// The speaker of segment i, or -1 when it is unlabelled.
+    int speaker(size_t i) const { return i < speaker_.size() ? speaker_[i] : -1; }
+    /// The label render() puts before segment i's text; empty when unlabelled.
+    std::string_view label(size_t i) const;
+
+    /// Bytes of text in the buffer.
+    size_t text_bytes() const { return arena_.size(); }
+
+    /// The timestamped, labelled transcript.
+    std::string render() const;
+    /// render() of the segments that start at or after `after_sec`, as
+    /// transcript_after() selects them.
+    std::string render_after(double after_sec) const;
+
+    /// The segments without their labels, as the note stage keeps them.
+    std::vector<TranscriptSegment> segments() const;
+
+private:
+    /// Of the segments that start at or after `min_start`.
+    size_t rendered_size(double min_start) const;
+    std::string render_from(double min_start) const;
+
+    std::string arena_;
+    std::vector<double> start_, end_;
+    std::vector<uint32_t> offset_, length_;
+    std::vector<float> avg_logprob_, no_speech_prob_;
+    std::vector<int> speaker_;  ///< per segment; empty = unlabelled
+    std::map<int, std::string> labels_;
+};
+
+} // namespace recmeet
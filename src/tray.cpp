@@ -7,6 +7,7 @@
 #include "device_enum.h"
 #include "ipc_client.h"
 #include "ipc_protocol.h"
+#include "level_feed.h"
 #include "log.h"
 #include "notify.h"
 #include "api_models.h"
@@ -29,6 +30,7 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <filesystem>
@@ -87,6 +89,7 @@ struct TrayState {
     // Progress tracking
     int progress_percent = -1;
     std::string current_phase;
+    std::string summary_text;  // the summary so far, from summary.delta events
     GtkWidget* status_menu_item = nullptr;
 
     // cancel-recording-and-discard (Phase 2): tray "Cancel & Discard" menu
@@ -123,8 +126,12 @@ struct TrayState {
     // Phase 5.1 — Live captions overlay. The GtkWindow is created lazily on
     // the first `caption` event of a recording (or up-front on `record.start`
     // when captions were enabled in the params); destroyed on tray exit. The
-    // CaptionRenderState holds the rolling caption buffer; tick_id drives
-    // periodic auto-hide checks while a recording is active.
+    // CaptionRenderState holds the rolling caption buffer. Caption events
+    // only update it and queue one redraw on the label's frame clock
+    // (frame_cb), so a burst of partials between two frames costs a single
+    // relayout; `markup` is what the label shows, so an unchanged render
+    // skips the relayout altogether. tick_id expires the degraded banner
+    // and runs only while one is up.
     //
     // Phase 3 of captions-mid-recording-ipc-verb (rev 4) splits the original
     // `captions_enabled_for_recording` bit into three independent flags:
@@ -146,12 +153,24 @@ struct TrayState {
         GtkWidget* window = nullptr;
         GtkWidget* label  = nullptr;
         recmeet::CaptionRenderState state;
-        guint tick_id = 0;        // GLib timer for auto-hide ticks
+        std::string markup;       // applied to `label`
+        guint frame_cb = 0;       // pending frame-clock redraw
+        guint tick_id = 0;        // GLib timer expiring the degraded banner
         bool captions_enabled_for_recording = false;  // honored at record.start
         bool engine_started_for_this_recording = false;
         bool window_visible = false;
         bool start_pending = false;
     } cap;
+
+    // Live input meters in the indicator label while recording. The
+    // daemon publishes levels in shared memory (`levels.info`); the tick
+    // reads them without a syscall or any IPC traffic, and touches the
+    // label only when a meter moves.
+    struct {
+        recmeet::LevelFeedReader reader;
+        guint tick_id = 0;
+        std::string label;   // last label set
+    } levels;
 };
 
 static TrayState g_tray;
@@ -214,10 +233,52 @@ static void tray_reset_caption_session_state() {
         g_tray.cap.window_visible = false;
     }
     g_tray.cap.state.clear();
+    g_tray.cap.markup.clear();
     if (g_tray.cap.label)
         gtk_label_set_markup(GTK_LABEL(g_tray.cap.label), "");
 }
 
+// Peak level as one block character, 8 steps over -48..0 dBFS.
+static const char* level_block(float peak) {
+    static const char* const kBlocks[] = {"·", "▁", "▂", "▃", "▄", "▅", "▆", "▇", "█"};
+    if (peak <= 0) return kBlocks[0];
+    const double db = 20.0 * std::log10(peak);
+    const int step = static_cast<int>(std::lround((db + 48.0) / 6.0));
+    return kBlocks[std::clamp(step, 0, 8)];
+}
+
+static gboolean levels_tick(gpointer) {
+    std::string label;
+    for (LevelSource src : {LevelSource::Mic, LevelSource::Monitor}) {
+        LevelReading r;
+        if (!g_tray.levels.reader.read(src, r) || r.frames == 0) continue;
+        if (!label.empty()) label += "  ";
+        label += src == LevelSource::Mic ? "mic " : "mon ";
+        label += level_block(r.peak);
+    }
+    if (label != g_tray.levels.label) {
+        g_tray.levels.label = label;
+        app_indicator_set_label(g_tray.indicator, label.c_str(), "mic █  mon █");
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+static void levels_start() {
+    if (g_tray.levels.tick_id || !g_tray.levels.reader.is_open()) return;
+    g_tray.levels.tick_id = g_timeout_add(100, levels_tick, nullptr);
+}
+
+static void levels_stop() {
+    if (g_tray.levels.tick_id) {
+        g_source_remove(g_tray.levels.tick_id);
+        g_tray.levels.tick_id = 0;
+    }
+    if (!g_tray.levels.label.empty()) {
+        g_tray.levels.label.clear();
+        app_indicator_set_label(g_tray.indicator, "", "");
+    }
+}
+
 static void update_state(bool rec, bool pp, bool dl, bool reproc = false) {
     bool was_recording = g_tray.recording;
     g_tray.recording = rec;
@@ -238,6 +299,11 @@ static void update_state(bool rec, bool pp, bool dl, bool reproc = false) {
         tray_reset_caption_session_state();
     }
 
+    if (rec && !reproc)
+        levels_start();
+    else
+        levels_stop();
+
     if (!rec && !pp && !dl) {
         g_tray.progress_percent = -1;
         g_tray.current_phase.clear();
@@ -264,30 +330,43 @@ static void update_state(bool rec, bool pp, bool dl, bool reproc = false) {
 static void caption_overlay_apply_markup() {
     if (!g_tray.cap.label) return;
     std::string markup = g_tray.cap.state.to_label_markup();
-    if (markup.empty())
-        gtk_label_set_markup(GTK_LABEL(g_tray.cap.label), "");
-    else
-        gtk_label_set_markup(GTK_LABEL(g_tray.cap.label), markup.c_str());
+    // Setting the same markup still invalidates the label's layout.
+    if (markup == g_tray.cap.markup) return;
+    g_tray.cap.markup = std::move(markup);
+    gtk_label_set_markup(GTK_LABEL(g_tray.cap.label), g_tray.cap.markup.c_str());
+}
+
+static gboolean caption_overlay_frame(GtkWidget*, GdkFrameClock*, gpointer) {
+    g_tray.cap.frame_cb = 0;
+    caption_overlay_apply_markup();
+    return G_SOURCE_REMOVE;
 }
 
 static gboolean caption_overlay_tick(gpointer) {
     auto now = recmeet::CaptionRenderState::Clock::now();
-    if (!g_tray.cap.window) return G_SOURCE_CONTINUE;
+    if (!g_tray.cap.window) {
+        g_tray.cap.tick_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+    if (g_tray.cap.state.degraded_active(now)) return G_SOURCE_CONTINUE;
 
     // Expire degraded marker when its TTL passes. The state machine keeps
     // the reason string until explicitly cleared — `degraded("")` resets it
-    // and a re-apply of the markup drops the banner.
-    static bool last_degraded_active = false;
-    bool now_active = g_tray.cap.state.degraded_active(now);
-    if (last_degraded_active && !now_active) {
-        g_tray.cap.state.degraded("", now);   // clear marker
-        caption_overlay_apply_markup();
-    }
-    last_degraded_active = now_active;
+    // and a re-apply of the markup drops the banner. Nothing else in the
+    // overlay changes with time, so the timer stops until the next banner.
+    g_tray.cap.state.degraded("", now);   // clear marker
+    caption_overlay_apply_markup();
+    g_tray.cap.tick_id = 0;
 
     // Window stays shown for the whole recording — see Part B of live-captions-pivot-to-monitor.
 
-    return G_SOURCE_CONTINUE;
+    return G_SOURCE_REMOVE;
+}
+
+// 500ms tick while a degraded banner is up.
+static void caption_overlay_arm_tick() {
+    if (!g_tray.cap.tick_id)
+        g_tray.cap.tick_id = g_timeout_add(500, caption_overlay_tick, nullptr);
 }
 
 static void caption_overlay_create() {
@@ -323,11 +402,7 @@ static void caption_overlay_create() {
 
     g_tray.cap.window = win;
     g_tray.cap.label = label;
-
-    // 500ms tick — drives auto-hide and degraded-banner expiration.
-    if (!g_tray.cap.tick_id) {
-        g_tray.cap.tick_id = g_timeout_add(500, caption_overlay_tick, nullptr);
-    }
+    g_tray.cap.markup.clear();
 }
 
 // MUST stay idempotent on an already-shown popup: gtk_widget_show_all on
@@ -343,6 +418,20 @@ static void caption_overlay_show_with_markup() {
     gtk_widget_show_all(g_tray.cap.window);
 }
 
+// Caption events land here: the redraw waits for the overlay's next frame,
+// and every event before it folds into that one. An overlay that is not
+// mapped yet is shown and drawn at once, as caption_overlay_show_with_markup()
+// does — its frame clock does not tick until then.
+static void caption_overlay_queue_render() {
+    if (!g_tray.cap.window || !gtk_widget_get_mapped(g_tray.cap.window)) {
+        caption_overlay_show_with_markup();
+        return;
+    }
+    if (!g_tray.cap.frame_cb)
+        g_tray.cap.frame_cb = gtk_widget_add_tick_callback(
+            g_tray.cap.label, caption_overlay_frame, nullptr, nullptr);
+}
+
 static void caption_overlay_hide() {
     if (g_tray.cap.window)
         gtk_widget_hide(g_tray.cap.window);
@@ -354,10 +443,13 @@ static void caption_overlay_destroy() {
         g_tray.cap.tick_id = 0;
     }
     if (g_tray.cap.window) {
+        // Destroying the label drops its pending frame callback.
         gtk_widget_destroy(g_tray.cap.window);
         g_tray.cap.window = nullptr;
         g_tray.cap.label = nullptr;
     }
+    g_tray.cap.frame_cb = 0;
+    g_tray.cap.markup.clear();
     g_tray.cap.state.clear();
 }
 
@@ -369,6 +461,7 @@ static void handle_ipc_event(const IpcEvent& ev) {
         // Reset progress on phase change and update status label
         g_tray.current_phase = name;
         g_tray.progress_percent = -1;
+        g_tray.summary_text.clear();
         if (g_tray.status_menu_item) {
             std::string label = "Status: " + name + "...";
             // Capitalize first letter
@@ -389,6 +482,20 @@ static void handle_ipc_event(const IpcEvent& ev) {
                 label[8] = static_cast<char>(toupper(static_cast<unsigned char>(label[8])));
             gtk_menu_item_set_label(GTK_MENU_ITEM(g_tray.status_menu_item), label.c_str());
         }
+    } else if (ev.event == "summary.delta") {
+        // Show the line being written (its last 60 characters) in the status
+        // label; the note itself opens when the job completes.
+        g_tray.summary_text += json_val_as_string(ev.data.at("text"));
+        size_t end = g_tray.summary_text.find_last_not_of("\n");
+        if (end == std::string::npos || !g_tray.status_menu_item) return;
+        size_t start = g_tray.summary_text.rfind('\n', end);
+        start = start == std::string::npos ? 0 : start + 1;
+        std::string line = g_tray.summary_text.substr(start, end + 1 - start);
+        const glong chars = g_utf8_strlen(line.c_str(), -1);
+        if (chars > 60)
+            line = "…" + std::string(g_utf8_offset_to_pointer(line.c_str(), chars - 60));
+        std::string label = "Status: Summarizing: " + line;
+        gtk_menu_item_set_label(GTK_MENU_ITEM(g_tray.status_menu_item), label.c_str());
     } else if (ev.event == "state.changed") {
         auto err_it = ev.data.find("error");
         if (err_it != ev.data.end()) {
@@ -459,15 +566,16 @@ static void handle_ipc_event(const IpcEvent& ev) {
         g_tray.cap.state.update(text, is_partial,
                                 g_tray.cfg.caption_normalize_display);
         if (g_tray.cap.window_visible) {
-            caption_overlay_show_with_markup();
+            caption_overlay_queue_render();
         }
     } else if (ev.event == "caption.degraded") {
         if (!g_tray.recording) return;
         std::string reason = json_val_as_string(ev.data.at("reason"));
         g_tray.cap.state.degraded(reason);
         if (g_tray.cap.window_visible) {
-            caption_overlay_show_with_markup();
+            caption_overlay_queue_render();
         }
+        caption_overlay_arm_tick();
         // Phase 3: failure-revert path for an in-flight verb call. When the
         // daemon failed to construct the engine, it broadcasts
         // caption.degraded with reason="engine_error". If we had a verb in
@@ -519,6 +627,10 @@ static void handle_ipc_event(const IpcEvent& ev) {
                 caption_overlay_show_with_markup();
             }
         }
+    } else if (ev.event == "sources.changed") {
+        // A device came or went; the Mic and Monitor menus follow it.
+        refresh_sources();
+        build_menu();
     } else if (ev.event == "model.downloading") {
         std::string status = json_val_as_string(ev.data.at("status"));
         if (status == "downloading") {
@@ -593,8 +705,21 @@ static bool connect_to_daemon() {
 
     g_tray.ipc.set_event_callback(handle_ipc_event);
     g_tray.daemon_connected = true;
+    // Caption partials and progress are most of the tray's traffic.
+    g_tray.ipc.negotiate_framing(IpcFraming::MsgPack);
     setup_ipc_watch();
 
+    // The level feed is shared memory, so only a local daemon's is usable;
+    // one that predates `levels.info` leaves the meters off.
+    g_tray.levels.reader.close();
+    IpcResponse levels_resp;
+    IpcError levels_err;
+    if (!g_tray.ipc.is_remote() &&
+        g_tray.ipc.call("levels.info", levels_resp, levels_err, 2000) &&
+        json_val_as_int(levels_resp.result["version"]) == LEVEL_FEED_VERSION &&
+        !g_tray.levels.reader.open(json_val_as_string(levels_resp.result["shm"])))
+        log_warn("[tray] Cannot map the daemon's level feed");
+
     // Sync state
     IpcResponse resp;
     IpcError err;
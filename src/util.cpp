@@ -4,6 +4,7 @@
 #include "util.h"
 #include "log.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <chrono>
 #include <climits>
@@ -11,8 +12,13 @@
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <iomanip>
+#include <iterator>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 #include <sstream>
 #include <thread>
 #include <unistd.h>
@@ -34,17 +40,27 @@ fs::path models_dir() { return data_dir() / "models"; }
 fs::path find_audio_file(const fs::path& dir) {
     if (!fs::is_directory(dir)) return {};
 
-    // Prefer timestamped audio_YYYY-MM-DD_HH-MM.wav
+    // Prefer timestamped audio_YYYY-MM-DD_HH-MM.wav, then an archived
+    // .flac / .opus (audio.archive). The WAV wins while both exist — an
+    // archive is only complete once the WAV has been removed.
+    static constexpr const char* kExts[] = {".wav", ".flac", ".opus"};
+    fs::path best;
+    size_t best_rank = std::size(kExts);
     for (const auto& entry : fs::directory_iterator(dir)) {
         if (!entry.is_regular_file()) continue;
         const auto& name = entry.path().filename().string();
-        if (name.size() > 6 &&
-            name.compare(0, 6, AUDIO_PREFIX) == 0 &&
-            name.size() >= 4 &&
-            name.compare(name.size() - 4, 4, ".wav") == 0) {
-            return entry.path();
+        if (name.size() <= 6 || name.compare(0, 6, AUDIO_PREFIX) != 0) continue;
+        const std::string ext = entry.path().extension().string();
+        for (size_t rank = 0; rank < best_rank; ++rank) {
+            if (ext == kExts[rank]) {
+                best = entry.path();
+                best_rank = rank;
+                break;
+            }
         }
+        if (best_rank == 0) break;
     }
+    if (!best.empty()) return best;
 
     // Fall back to legacy audio.wav
     fs::path legacy = dir / LEGACY_AUDIO_NAME;
@@ -130,9 +146,9 @@ std::string derive_meeting_timestamp(const fs::path& dir) {
     return "";
 }
 
-OutputDir create_output_dir(const fs::path& base_dir) {
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
+OutputDir create_output_dir(const fs::path& base_dir, std::time_t when) {
+    auto time = when ? when
+                     : std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
     std::tm tm{};
     localtime_r(&time, &tm);
 
@@ -166,11 +182,90 @@ void write_text_file(const fs::path& path, const std::string& content) {
         throw RecmeetError("Write error: " + path.string());
 }
 
+void write_text_file_atomic(const fs::path& path, const std::string& content) {
+    fs::path tmp = path;
+    tmp += ".tmp";
+    write_text_file(tmp, content);
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        throw RecmeetError("Failed to replace file: " + path.string());
+    }
+}
+
 int default_thread_count() {
     unsigned n = std::thread::hardware_concurrency();
     return (n > 1) ? static_cast<int>(n - 1) : 1;
 }
 
+std::string host_name() {
+    char buf[256] = {};
+    if (gethostname(buf, sizeof(buf) - 1) != 0 || buf[0] == '\0')
+        return "localhost";
+    return buf;
+}
+
+std::string shell_quote(const std::string& s) {
+    std::string out = "'";
+    for (char c : s) out += c == '\'' ? std::string("'\\''") : std::string(1, c);
+    return out + "'";
+}
+
+std::string base64_encode(const std::string& data) {
+    static const char* const kAlphabet =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((data.size() + 2) / 3 * 4);
+    size_t i = 0;
+    for (; i + 2 < data.size(); i += 3) {
+        const uint32_t v = (uint32_t(uint8_t(data[i])) << 16) |
+                           (uint32_t(uint8_t(data[i + 1])) << 8) | uint8_t(data[i + 2]);
+        out += kAlphabet[v >> 18];
+        out += kAlphabet[(v >> 12) & 63];
+        out += kAlphabet[(v >> 6) & 63];
+        out += kAlphabet[v & 63];
+    }
+    if (i < data.size()) {
+        uint32_t v = uint32_t(uint8_t(data[i])) << 16;
+        if (i + 1 < data.size()) v |= uint32_t(uint8_t(data[i + 1])) << 8;
+        out += kAlphabet[v >> 18];
+        out += kAlphabet[(v >> 12) & 63];
+        out += i + 1 < data.size() ? kAlphabet[(v >> 6) & 63] : '=';
+        out += '=';
+    }
+    return out;
+}
+
+bool base64_decode(const std::string& text, std::string& out) {
+    auto value = [](char c) -> int {
+        if (c >= 'A' && c <= 'Z') return c - 'A';
+        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+        if (c >= '0' && c <= '9') return c - '0' + 52;
+        if (c == '+') return 62;
+        if (c == '/') return 63;
+        return -1;
+    };
+    if (text.size() % 4 != 0) return false;
+    out.clear();
+    out.reserve(text.size() / 4 * 3);
+    for (size_t i = 0; i < text.size(); i += 4) {
+        const bool last = i + 4 == text.size();
+        const int pad = last ? (text[i + 3] == '=') + (text[i + 2] == '=') : 0;
+        if (pad == 1 && text[i + 2] == '=') return false;
+        uint32_t v = 0;
+        for (int k = 0; k < 4 - pad; ++k) {
+            const int d = value(text[i + k]);
+            if (d < 0) return false;
+            v |= uint32_t(d) << (18 - 6 * k);
+        }
+        out += char(v >> 16);
+        if (pad < 2) out += char((v >> 8) & 0xff);
+        if (pad < 1) out += char(v & 0xff);
+    }
+    return true;
+}
+
 long read_self_rss_kb() {
     FILE* f = std::fopen("/proc/self/statm", "r");
     if (!f) return 0;
@@ -184,10 +279,103 @@ long read_self_rss_kb() {
     return pages_resident * page_kb;
 }
 
-size_t write_heartbeat_ndjson(int fd, long rss_kb) {
-    char buf[96];
-    int n = std::snprintf(buf, sizeof(buf),
-        "{\"event\":\"heartbeat\",\"data\":{\"rss_kb\":%ld}}\n", rss_kb);
+void release_free_heap() {
+#if defined(__GLIBC__)
+    // Every arena, the worker threads' too, and the free pages inside each
+    // heap (MADV_DONTNEED) rather than only its top (glibc >= 2.8).
+    malloc_trim(0);
+#endif
+}
+
+long read_self_peak_rss_kb() {
+    FILE* f = std::fopen("/proc/self/status", "r");
+    if (!f) return 0;
+    char line[128];
+    long kb = 0;
+    while (std::fgets(line, sizeof(line), f)) {
+        if (std::sscanf(line, "VmHWM: %ld kB", &kb) == 1) break;
+        kb = 0;
+    }
+    std::fclose(f);
+    return kb > 0 ? kb : 0;
+}
+
+bool reset_self_peak_rss() {
+    int fd = ::open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    const bool ok = ::write(fd, "5", 1) == 1;
+    ::close(fd);
+    return ok;
+}
+
+static long read_meminfo_kb(const char* format) {
+    FILE* f = std::fopen("/proc/meminfo", "r");
+    if (!f) return 0;
+    char line[128];
+    long kb = 0;
+    while (std::fgets(line, sizeof(line), f)) {
+        if (std::sscanf(line, format, &kb) == 1) break;
+        kb = 0;
+    }
+    std::fclose(f);
+    return kb > 0 ? kb : 0;
+}
+
+long read_mem_available_kb() {
+    return read_meminfo_kb("MemAvailable: %ld kB");
+}
+
+long read_mem_free_kb() {
+    return read_meminfo_kb("MemFree: %ld kB");
+}
+
+uint64_t parse_cgroup_memory_max(const char* text) {
+    if (!text || std::strncmp(text, "max", 3) == 0) return 0;
+    char* end = nullptr;
+    unsigned long long v = std::strtoull(text, &end, 10);
+    return (end == text) ? 0 : static_cast<uint64_t>(v);
+}
+
+uint64_t read_memory_ceiling_bytes() {
+    uint64_t ceiling = 0;
+    auto tighten = [&ceiling](uint64_t v) {
+        if (v > 0 && (ceiling == 0 || v < ceiling)) ceiling = v;
+    };
+
+    // cgroup v2: "0::/user.slice/.../recmeet-daemon.service". A limit on
+    // any ancestor applies too.
+    std::ifstream cg("/proc/self/cgroup");
+    std::string line;
+    while (std::getline(cg, line)) {
+        if (line.compare(0, 3, "0::") != 0) continue;
+        const std::string root = "/sys/fs/cgroup";
+        for (fs::path dir = fs::path(root + line.substr(3)).lexically_normal();
+             dir.string().size() > root.size() + 1; dir = dir.parent_path()) {
+            std::ifstream max(dir / "memory.max");
+            std::string body;
+            if (max && std::getline(max, body)) tighten(parse_cgroup_memory_max(body.c_str()));
+        }
+        break;
+    }
+
+    if (const char* s = std::getenv("RECMEET_RSS_LIMIT_MB"))
+        tighten(static_cast<uint64_t>(std::max(std::atol(s), 0L)) << 20);
+
+    const long pages = ::sysconf(_SC_PHYS_PAGES);
+    const long page_size = ::sysconf(_SC_PAGESIZE);
+    if (pages > 0 && page_size > 0)
+        tighten(static_cast<uint64_t>(pages) * static_cast<uint64_t>(page_size));
+    return ceiling;
+}
+
+size_t write_heartbeat_ndjson(int fd, long rss_kb, long peak_rss_kb) {
+    char buf[128];
+    int n = peak_rss_kb < 0
+        ? std::snprintf(buf, sizeof(buf),
+              "{\"event\":\"heartbeat\",\"data\":{\"rss_kb\":%ld}}\n", rss_kb)
+        : std::snprintf(buf, sizeof(buf),
+              "{\"event\":\"heartbeat\",\"data\":{\"rss_kb\":%ld,\"peak_rss_kb\":%ld}}\n",
+              rss_kb, peak_rss_kb);
     if (n <= 0 || static_cast<size_t>(n) >= sizeof(buf)) return 0;
     ssize_t written = 0;
     while (written < n) {
@@ -296,4 +484,11 @@ long parse_memory_property_line(const char* line) {
     return (end == eq) ? -1 : v;
 }
 
+bool pp_worker_should_retire(int jobs_done, int max_jobs, int exit_code,
+                             long rss_kb, int rss_limit_mb) {
+    if (exit_code != 0) return true;
+    if (jobs_done >= max_jobs) return true;
+    return rss_limit_mb > 0 && rss_kb > static_cast<long>(rss_limit_mb) * 1024L;
+}
+
 } // namespace recmeet
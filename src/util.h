@@ -5,6 +5,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <ctime>
 #include <filesystem>
 #include <stdexcept>
 #include <string>
@@ -30,6 +31,16 @@ class AudioValidationError : public RecmeetError {
     using RecmeetError::RecmeetError;
 };
 
+/// Postprocessing stopped early to finish in a fresh process (the memory
+/// governor, memory_governor.h). Everything done so far is in the stage
+/// cache; a daemon child exits with PP_EXIT_DEFERRED.
+class PostprocessDeferred : public RecmeetError {
+    using RecmeetError::RecmeetError;
+};
+
+/// Exit status of a postprocessing child that threw PostprocessDeferred.
+constexpr int PP_EXIT_DEFERRED = 3;
+
 // ---------------------------------------------------------------------------
 // Stop token — shared between signal handler, tray UI, and capture threads
 // ---------------------------------------------------------------------------
@@ -75,9 +86,15 @@ constexpr const char* CONTEXT_PREFIX = "context_";
 constexpr const char* LEGACY_CONTEXT_NAME = "context.json";
 constexpr const char* SPEAKERS_PREFIX = "speakers_";
 constexpr const char* LEGACY_SPEAKERS_NAME = "speakers.json";
+constexpr const char* VAD_PREFIX = "vad_";
+constexpr const char* ENVELOPE_PREFIX = "envelope_";
+constexpr const char* SPARSE_PREFIX = "sparse_";
+/// Mic and monitor of a dual-source recording, interleaved (--keep-sources).
+constexpr const char* SOURCES_NAME = "sources.wav";
 
 /// Find the audio file in a meeting directory.
-/// Prefers audio_YYYY-MM-DD_HH-MM.wav, falls back to audio.wav.
+/// Prefers audio_YYYY-MM-DD_HH-MM.wav, then the archived .flac / .opus form
+/// of it, then legacy audio.wav.
 /// Returns empty path if dir doesn't exist or no audio file found.
 fs::path find_audio_file(const fs::path& dir);
 
@@ -96,7 +113,7 @@ fs::path find_speakers_file(const fs::path& dir);
 ///   1. If dir.filename() matches the YYYY-MM-DD_HH-MM pattern, return it
 ///      (collision suffix `_N` stripped).
 ///   2. Otherwise, parse the discovered audio filename via find_audio_file()
-///      (strip "audio_" prefix and ".wav" suffix).
+///      (strip "audio_" prefix and the extension).
 ///   3. Otherwise, return "".
 std::string derive_meeting_timestamp(const fs::path& dir);
 
@@ -112,7 +129,8 @@ struct OutputDir {
 };
 
 /// Create timestamped output directory under base_dir, e.g. meetings/2026-02-20_14-30/
-OutputDir create_output_dir(const fs::path& base_dir);
+/// for the local time `when` (0 = now).
+OutputDir create_output_dir(const fs::path& base_dir, std::time_t when = 0);
 
 // ---------------------------------------------------------------------------
 // Default device pattern
@@ -127,6 +145,10 @@ constexpr const char* DEFAULT_DEVICE_PATTERN = "";
 /// Write text content to a file, throwing RecmeetError on failure.
 void write_text_file(const fs::path& path, const std::string& content);
 
+/// Same, through `<path>.tmp` renamed over `path`: a reader (or a process
+/// killed mid-write) sees the old file or the new one, never a torn one.
+void write_text_file_atomic(const fs::path& path, const std::string& content);
+
 // ---------------------------------------------------------------------------
 // Thread count helper
 // ---------------------------------------------------------------------------
@@ -134,6 +156,22 @@ void write_text_file(const fs::path& path, const std::string& content);
 /// Default thread count for inference engines: hardware_concurrency() - 1, minimum 1.
 int default_thread_count();
 
+/// This host's name (gethostname), or "localhost" if it cannot be read.
+std::string host_name();
+
+/// `s` single-quoted for /bin/sh, for commands run through popen().
+std::string shell_quote(const std::string& s);
+
+// ---------------------------------------------------------------------------
+// Base64 (RFC 4648, padded) — binary payloads in IPC string values
+// ---------------------------------------------------------------------------
+
+std::string base64_encode(const std::string& data);
+
+/// Decode `text` into `out`. False, leaving `out` unspecified, on a
+/// length that is not a multiple of 4 or a character outside the alphabet.
+bool base64_decode(const std::string& text, std::string& out);
+
 // ---------------------------------------------------------------------------
 // Process resident-set-size (Linux)
 // ---------------------------------------------------------------------------
@@ -143,12 +181,47 @@ int default_thread_count();
 /// Does not allocate beyond a fixed-size stack buffer in the underlying read.
 long read_self_rss_kb();
 
-/// Format a heartbeat NDJSON line for `rss_kb` into a stack buffer and write
-/// it to `fd` via raw write(2). Does not allocate, does not take the libc
+/// Read this process's peak resident set size (VmHWM in /proc/self/status)
+/// in kilobytes. Returns 0 when it cannot be read.
+long read_self_peak_rss_kb();
+
+/// Reset the peak read_self_peak_rss_kb() reports to the current RSS, by
+/// writing "5" to /proc/self/clear_refs. Lets a long-lived worker report
+/// each job's peak rather than its lifetime's. Returns false when the
+/// kernel does not allow it (the peak then keeps counting from start).
+bool reset_self_peak_rss();
+
+/// Hand heap memory the allocator is holding but no longer using back to
+/// the kernel (glibc malloc_trim). A long-lived process calls it between
+/// jobs so one meeting's freed buffers do not count against the next
+/// meeting's RSS. No-op on other C libraries.
+void release_free_heap();
+
+/// Read the host's MemAvailable in kilobytes from /proc/meminfo. Returns 0
+/// when the field cannot be read; callers treat 0 as "unknown".
+long read_mem_available_kb();
+
+/// Read the host's MemFree in kilobytes from /proc/meminfo: memory holding
+/// nothing at all, unlike MemAvailable, which counts page cache that could
+/// be dropped. Returns 0 when the field cannot be read.
+long read_mem_free_kb();
+
+/// Parse the body of a cgroup v2 `memory.max` file: the limit in bytes, or
+/// 0 for "max" (no limit) and malformed input. Pure parsing — no I/O.
+uint64_t parse_cgroup_memory_max(const char* text);
+
+/// The tightest memory ceiling this process runs under, in bytes: the
+/// smallest of its cgroup's and ancestors' `memory.max` (the unit's
+/// MemoryMax=), RECMEET_RSS_LIMIT_MB and physical RAM. 0 when none can be
+/// read.
+uint64_t read_memory_ceiling_bytes();
+
+/// Format a heartbeat NDJSON line for `rss_kb`, and `peak_rss_kb` when it is
+/// not negative, into a stack buffer and write it to `fd` via raw write(2). Does not allocate, does not take the libc
 /// stdio mutex - safe to call from a heartbeat thread under malloc-arena
 /// lock contention. Returns the number of bytes written, or 0 on format
 /// failure / partial write to a closed fd.
-size_t write_heartbeat_ndjson(int fd, long rss_kb);
+size_t write_heartbeat_ndjson(int fd, long rss_kb, long peak_rss_kb = -1);
 
 /// Write the canonical RSS-limit-exceeded stderr line to `fd` via raw
 /// write(2). The string is fixed and distinctive ("child RSS limit
@@ -172,4 +245,11 @@ std::pair<std::string, std::string> resolve_meeting_time(
 /// unit testing of the daemon's MemoryHigh restore path.
 long parse_memory_property_line(const char* line);
 
+/// Whether the daemon should replace its warm postprocessing worker after
+/// a job instead of handing it the next one: the job failed or was
+/// cancelled (`exit_code` != 0), the worker has run `max_jobs` jobs, or the
+/// job left it above `rss_limit_mb` (<= 0 = no limit). Pure; no I/O.
+bool pp_worker_should_retire(int jobs_done, int max_jobs, int exit_code,
+                             long rss_kb, int rss_limit_mb);
+
 } // namespace recmeet
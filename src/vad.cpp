@@ -4,6 +4,16 @@
 #include "vad.h"
 #include "log.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
 #if RECMEET_USE_SHERPA
 #include "model_manager.h"
 #include <sherpa-onnx/c-api/c-api.h>
@@ -11,12 +21,317 @@
 
 namespace recmeet {
 
+// ---------------------------------------------------------------------------
+// Speech-segment index
+// ---------------------------------------------------------------------------
+
+namespace {
+
+constexpr int kVadIndexVersion = 1;
+
+// Start of the number following "key": in a flat JSON object, or nullptr.
+const char* find_json_number(const std::string& json, const char* key) {
+    std::string needle = std::string("\"") + key + "\":";
+    auto pos = json.find(needle);
+    if (pos == std::string::npos) return nullptr;
+    return json.c_str() + pos + needle.size();
+}
+
+bool read_json_double(const std::string& json, const char* key, double& out) {
+    const char* p = find_json_number(json, key);
+    if (!p) return false;
+    char* end = nullptr;
+    out = std::strtod(p, &end);
+    return end != p;
+}
+
+// Floats are written with %.9g, which round-trips exactly, so the config
+// comparison on load can be exact too.
+bool config_matches(const std::string& json, const VadConfig& c) {
+    double threshold, min_silence, min_speech, max_speech, window;
+    if (!read_json_double(json, "threshold", threshold) ||
+        !read_json_double(json, "min_silence_duration", min_silence) ||
+        !read_json_double(json, "min_speech_duration", min_speech) ||
+        !read_json_double(json, "max_speech_duration", max_speech) ||
+        !read_json_double(json, "window_size", window))
+        return false;
+    return static_cast<float>(threshold) == c.threshold &&
+           static_cast<float>(min_silence) == c.min_silence_duration &&
+           static_cast<float>(min_speech) == c.min_speech_duration &&
+           static_cast<float>(max_speech) == c.max_speech_duration &&
+           static_cast<int>(window) == c.window_size;
+}
+
+// Parse "segments": [[start, end], ...] into sample ranges, rejecting any
+// range outside [0, audio_samples].
+bool parse_segments(const std::string& json, std::size_t audio_samples,
+                    std::vector<VadSegment>& out) {
+    auto key = json.find("\"segments\":");
+    if (key == std::string::npos) return false;
+    auto open = json.find('[', key);
+    if (open == std::string::npos) return false;
+
+    const char* p = json.c_str() + open + 1;
+    for (;;) {
+        while (*p == ' ' || *p == '\n' || *p == '\t' || *p == '\r' || *p == ',') ++p;
+        if (*p == ']') return true;
+        if (*p != '[') return false;
+        char* end = nullptr;
+        long long start = std::strtoll(p + 1, &end, 10);
+        if (end == p + 1 || *end != ',') return false;
+        p = end + 1;
+        long long stop = std::strtoll(p, &end, 10);
+        if (end == p) return false;
+        p = end;
+        while (*p == ' ') ++p;
+        if (*p != ']') return false;
+        ++p;
+        if (start < 0 || stop <= start || static_cast<std::size_t>(stop) > audio_samples)
+            return false;
+        out.push_back({static_cast<int32_t>(start), static_cast<int32_t>(stop),
+                       static_cast<double>(start) / SAMPLE_RATE,
+                       static_cast<double>(stop) / SAMPLE_RATE});
+    }
+}
+
+} // anonymous namespace
+
+fs::path vad_index_path(const fs::path& audio_path) {
+    std::string stem = audio_path.stem().string();
+    const std::string prefix = AUDIO_PREFIX;
+    if (stem.compare(0, prefix.size(), prefix) == 0)
+        stem.erase(0, prefix.size());
+    return audio_path.parent_path() / (std::string(VAD_PREFIX) + stem + ".json");
+}
+
+void save_vad_index(const fs::path& path, const VadResult& result,
+                    std::size_t audio_samples, const VadConfig& config) {
+    char head[512];
+    std::snprintf(head, sizeof(head),
+                  "{\n"
+                  "  \"version\": %d,\n"
+                  "  \"sample_rate\": %d,\n"
+                  "  \"audio_samples\": %zu,\n"
+                  "  \"threshold\": %.9g,\n"
+                  "  \"min_silence_duration\": %.9g,\n"
+                  "  \"min_speech_duration\": %.9g,\n"
+                  "  \"max_speech_duration\": %.9g,\n"
+                  "  \"window_size\": %d,\n"
+                  "  \"segments\": [",
+                  kVadIndexVersion, SAMPLE_RATE, audio_samples,
+                  config.threshold, config.min_silence_duration,
+                  config.min_speech_duration, config.max_speech_duration,
+                  config.window_size);
+
+    std::ostringstream out;
+    out << head;
+    for (std::size_t i = 0; i < result.segments.size(); ++i) {
+        const auto& seg = result.segments[i];
+        out << (i > 0 ? ",\n    [" : "\n    [")
+            << seg.start_sample << ", " << seg.end_sample << "]";
+    }
+    out << (result.segments.empty() ? "]\n}\n" : "\n  ]\n}\n");
+    write_text_file_atomic(path, out.str());
+}
+
+bool load_vad_index(const fs::path& path, std::size_t audio_samples,
+                    const VadConfig& config, VadResult& out) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::ostringstream buf;
+    buf << in.rdbuf();
+    const std::string json = buf.str();
+
+    double version = 0, rate = 0, samples = 0;
+    if (!read_json_double(json, "version", version) ||
+        static_cast<int>(version) != kVadIndexVersion ||
+        !read_json_double(json, "sample_rate", rate) ||
+        static_cast<int>(rate) != SAMPLE_RATE ||
+        !read_json_double(json, "audio_samples", samples) ||
+        static_cast<std::size_t>(samples) != audio_samples) {
+        log_debug("vad: ignoring index %s (different audio or version)", path.c_str());
+        return false;
+    }
+    if (!config_matches(json, config)) {
+        log_debug("vad: ignoring index %s (computed with different VAD settings)",
+                  path.c_str());
+        return false;
+    }
+
+    VadResult result;
+    if (!parse_segments(json, audio_samples, result.segments)) {
+        log_warn("VAD index %s is malformed; running VAD again", path.c_str());
+        return false;
+    }
+    result.total_audio_duration = static_cast<double>(audio_samples) / SAMPLE_RATE;
+    result.total_speech_duration = 0.0;
+    for (const auto& seg : result.segments)
+        result.total_speech_duration += seg.end - seg.start;
+    out = std::move(result);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Speech-only view
+// ---------------------------------------------------------------------------
+
+CompactedSampleSource::CompactedSampleSource(const SampleSource& audio,
+                                             const std::vector<VadSegment>& segments,
+                                             std::size_t max_gap)
+    : audio_(audio) {
+    const std::size_t total = audio.size();
+    for (const auto& seg : segments) {
+        std::size_t s = std::min(static_cast<std::size_t>(std::max(seg.start_sample, 0)), total);
+        std::size_t e = std::min(static_cast<std::size_t>(std::max(seg.end_sample, 0)), total);
+        if (!pieces_.empty()) {
+            Piece& last = pieces_.back();
+            const std::size_t last_end = last.start + last.n;
+            s = std::max(s, last_end);
+            if (e <= s) continue;
+            if (s - last_end <= max_gap) {
+                last.n = e - last.start;  // short silence stays in the piece
+                length_ = last.offset + last.n;
+                continue;
+            }
+            length_ += max_gap;
+        }
+        if (e <= s) continue;
+        pieces_.push_back({s, e - s, length_});
+        length_ += e - s;
+    }
+}
+
+std::size_t CompactedSampleSource::read(std::size_t start, std::size_t n, float* out) const {
+    if (start >= length_) return 0;
+    n = std::min(n, length_ - start);
+    std::fill(out, out + n, 0.0f);
+    // First piece ending after `start`.
+    auto it = std::upper_bound(pieces_.begin(), pieces_.end(), start,
+                               [](std::size_t pos, const Piece& p) {
+                                   return pos < p.offset + p.n;
+                               });
+    for (; it != pieces_.end() && it->offset < start + n; ++it) {
+        const std::size_t a = std::max(start, it->offset);
+        const std::size_t b = std::min(start + n, it->offset + it->n);
+        if (a < b)
+            audio_.read(it->start + (a - it->offset), b - a, out + (a - start));
+    }
+    return n;
+}
+
+std::size_t CompactedSampleSource::source_samples() const {
+    std::size_t n = 0;
+    for (const auto& p : pieces_) n += p.n;
+    return n;
+}
+
+std::vector<std::pair<double, double>>
+CompactedSampleSource::to_source_spans(double start, double end) const {
+    std::vector<std::pair<double, double>> spans;
+    const double sr = static_cast<double>(SAMPLE_RATE);
+    auto it = std::partition_point(pieces_.begin(), pieces_.end(), [&](const Piece& p) {
+        return (p.offset + p.n) / sr <= start;
+    });
+    for (; it != pieces_.end(); ++it) {
+        const Piece& p = *it;
+        const double p_start = p.offset / sr;
+        const double p_end = (p.offset + p.n) / sr;
+        if (p_start >= end) break;
+        const double a = std::max(start, p_start);
+        const double b = std::min(end, p_end);
+        if (a < b) {
+            const double shift = p.start / sr - p_start;
+            spans.emplace_back(a + shift, b + shift);
+        }
+    }
+    return spans;
+}
+
+// ---------------------------------------------------------------------------
+// Sharded VAD
+// ---------------------------------------------------------------------------
+
+// Past max_speech_duration + min_silence_duration a shard's detector keeps
+// listening this long more: the forced end of an over-long segment is not
+// exact.
+static constexpr float kVadShardTailSlackSecs = 5.0f;
+
+std::vector<VadShard> plan_vad_shards(std::size_t samples, const VadConfig& config,
+                                      int max_shards, std::size_t min_shard) {
+    const std::size_t ws = static_cast<std::size_t>(std::max(config.window_size, 1));
+    std::size_t n = 1;
+    if (max_shards > 1 && min_shard > 0)
+        n = std::max<std::size_t>(1, std::min<std::size_t>(max_shards, samples / min_shard));
+    if (n == 1) return {{0, 0, samples, samples}};
+
+    auto down = [ws](std::size_t s) { return s / ws * ws; };
+    auto up = [ws](std::size_t s) { return (s + ws - 1) / ws * ws; };
+    const std::size_t lead = up(VAD_SHARD_LEAD_SAMPLES);
+    const std::size_t tail = up(static_cast<std::size_t>(
+        (config.max_speech_duration + config.min_silence_duration + kVadShardTailSlackSecs) *
+        SAMPLE_RATE));
+
+    std::vector<VadShard> shards;
+    for (std::size_t i = 0; i < n; ++i) {
+        VadShard s;
+        s.start = i == 0 ? 0 : down(samples / n * i);
+        s.end = i + 1 == n ? samples : down(samples / n * (i + 1));
+        s.feed_start = s.start > lead ? s.start - lead : 0;
+        s.feed_end = i + 1 == n ? samples : std::min(samples, s.end + tail);
+        shards.push_back(s);
+    }
+    return shards;
+}
+
+VadResult merge_vad_shards(const std::vector<VadShard>& shards,
+                           const std::vector<std::vector<VadSegment>>& per_shard,
+                           std::size_t samples) {
+    VadResult out;
+    out.total_speech_duration = 0.0;
+    out.total_audio_duration = static_cast<double>(samples) / SAMPLE_RATE;
+    for (std::size_t i = 0; i < shards.size() && i < per_shard.size(); ++i) {
+        for (const auto& seg : per_shard[i]) {
+            const auto start = static_cast<std::size_t>(std::max(seg.start_sample, 0));
+            if (start < shards[i].start || start >= shards[i].end) continue;  // not this shard's
+            if (!out.segments.empty() && seg.start_sample <= out.segments.back().end_sample) {
+                // The neighbour's view of the same speech, across the cut.
+                auto& back = out.segments.back();
+                back.end_sample = std::max(back.end_sample, seg.end_sample);
+                continue;
+            }
+            out.segments.push_back(seg);
+        }
+    }
+    for (auto& seg : out.segments) {
+        seg.start = static_cast<double>(seg.start_sample) / SAMPLE_RATE;
+        seg.end = static_cast<double>(seg.end_sample) / SAMPLE_RATE;
+        out.total_speech_duration += seg.end - seg.start;
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// Silero VAD (sherpa-onnx)
+// ---------------------------------------------------------------------------
+
 #if RECMEET_USE_SHERPA
-VadResult detect_speech(const std::vector<float>& samples,
-                        const VadConfig& config, int threads) {
-    if (samples.empty())
-        throw RecmeetError("Cannot run VAD on empty audio");
 
+// Headroom over max_speech_duration for the detector's circular buffer: it
+// holds the speech region in progress plus a short lookback, never the
+// audio already classified, because pump() pops segments as they close.
+static constexpr float kVadBufferHeadroomSecs = 10.0f;
+
+struct StreamingVad::Impl {
+    const SherpaOnnxVoiceActivityDetector* vad = nullptr;
+    bool finished = false;
+
+    ~Impl() {
+        if (vad) SherpaOnnxDestroyVoiceActivityDetector(vad);
+    }
+};
+
+StreamingVad::StreamingVad(const SampleSource& audio, const VadConfig& config, int threads)
+    : impl_(std::make_unique<Impl>()), audio_(audio), config_(config) {
     fs::path model_path = ensure_vad_model();
 
     int t = threads > 0 ? threads : default_thread_count();
@@ -36,27 +351,28 @@ VadResult detect_speech(const std::vector<float>& samples,
     vad_cfg.provider = "cpu";
     vad_cfg.debug = 0;
 
-    float buf_secs = static_cast<float>(samples.size()) / SAMPLE_RATE + 1.0f;
-    const auto* vad = SherpaOnnxCreateVoiceActivityDetector(&vad_cfg, buf_secs);
-    if (!vad)
+    float buf_secs = config.max_speech_duration + kVadBufferHeadroomSecs;
+    impl_->vad = SherpaOnnxCreateVoiceActivityDetector(&vad_cfg, buf_secs);
+    if (!impl_->vad)
         throw RecmeetError("Failed to create sherpa-onnx VAD");
 
-    // Feed audio in window_size chunks
-    int32_t total = static_cast<int32_t>(samples.size());
-    int32_t ws = config.window_size;
-
-    for (int32_t offset = 0; offset + ws <= total; offset += ws) {
-        SherpaOnnxVoiceActivityDetectorAcceptWaveform(vad, samples.data() + offset, ws);
-    }
+    result_.total_speech_duration = 0.0;
+    result_.total_audio_duration = 0.0;
+}
 
-    // Flush remaining audio
-    SherpaOnnxVoiceActivityDetectorFlush(vad);
+StreamingVad::~StreamingVad() = default;
 
-    // Extract speech segments
-    VadResult result;
-    result.total_audio_duration = static_cast<double>(total) / SAMPLE_RATE;
-    result.total_speech_duration = 0.0;
+static void log_vad_summary(const VadResult& r, std::size_t shards) {
+    log_info("VAD: %.1fs speech in %.1fs audio (%zu segments, %.0f%% speech%s)",
+             r.total_speech_duration, r.total_audio_duration, r.segments.size(),
+             r.total_audio_duration > 0
+                 ? 100.0 * r.total_speech_duration / r.total_audio_duration
+                 : 0.0,
+             shards > 1 ? (", " + std::to_string(shards) + " shards").c_str() : "");
+}
 
+// Move every closed segment out of the detector into `result`.
+static void collect_segments(const SherpaOnnxVoiceActivityDetector* vad, VadResult& result) {
     while (!SherpaOnnxVoiceActivityDetectorEmpty(vad)) {
         const auto* seg = SherpaOnnxVoiceActivityDetectorFront(vad);
         if (seg) {
@@ -76,18 +392,119 @@ VadResult detect_speech(const std::vector<float>& samples,
         }
         SherpaOnnxVoiceActivityDetectorPop(vad);
     }
+}
 
-    SherpaOnnxDestroyVoiceActivityDetector(vad);
+std::size_t StreamingVad::pump() {
+    if (impl_->finished) return 0;
+    const std::size_t ws = static_cast<std::size_t>(config_.window_size);
+    const std::size_t avail = audio_.size();
+    const std::size_t before = fed_;
 
-    log_info("VAD: %.1fs speech in %.1fs audio (%zu segments, %.0f%% speech)",
-            result.total_speech_duration, result.total_audio_duration,
-            result.segments.size(),
-            result.total_audio_duration > 0
-                ? 100.0 * result.total_speech_duration / result.total_audio_duration
-                : 0.0);
+    // One window at a time: the detector copies what it keeps, so only
+    // `ws` samples are ever converted to float here.
+    while (fed_ + ws <= avail) {
+        std::size_t got = 0;
+        const float* w = audio_.view(fed_, ws, scratch_, got);
+        SherpaOnnxVoiceActivityDetectorAcceptWaveform(impl_->vad, w, static_cast<int32_t>(got));
+        fed_ += ws;
+    }
+    if (fed_ != before)
+        collect_segments(impl_->vad, result_);
+    return fed_ - before;
+}
+
+VadResult StreamingVad::finish() {
+    if (impl_->finished) return result_;
+    const std::size_t total = audio_.size();
+    if (total == 0)
+        throw RecmeetError("Cannot run VAD on empty audio");
+
+    pump();
+    // A trailing partial window is not fed, matching the batch pass.
+    SherpaOnnxVoiceActivityDetectorFlush(impl_->vad);
+    collect_segments(impl_->vad, result_);
+    impl_->finished = true;
+
+    result_.total_audio_duration = static_cast<double>(total) / SAMPLE_RATE;
+    if (!quiet_) log_vad_summary(result_, 1);
+    return result_;
+}
 
+namespace {
+
+// Samples [start, end) of `audio`, from 0.
+class SliceSampleSource : public SampleSource {
+public:
+    SliceSampleSource(const SampleSource& audio, std::size_t start, std::size_t end)
+        : audio_(audio), start_(start), n_(end - start) {}
+    std::size_t size() const override { return n_; }
+    std::size_t read(std::size_t start, std::size_t n, float* out) const override {
+        if (start >= n_) return 0;
+        return audio_.read(start_ + start, std::min(n, n_ - start), out);
+    }
+
+private:
+    const SampleSource& audio_;
+    std::size_t start_;
+    std::size_t n_;
+};
+
+} // anonymous namespace
+
+VadResult detect_speech_sharded(const SampleSource& audio, const VadConfig& config,
+                                int threads, std::size_t min_shard) {
+    const std::size_t samples = audio.size();
+    if (samples == 0)
+        throw RecmeetError("Cannot run VAD on empty audio");
+    const int t = threads > 0 ? threads : default_thread_count();
+    const std::vector<VadShard> plan = plan_vad_shards(samples, config, t, min_shard);
+    if (plan.size() == 1) {
+        StreamingVad vad(audio, config, t);
+        return vad.finish();
+    }
+
+    ensure_vad_model();  // once, before the shards look for it at the same time
+    std::vector<std::vector<VadSegment>> found(plan.size());
+    std::mutex error_mtx;
+    std::exception_ptr first_error;
+    auto run = [&](std::size_t i) {
+        try {
+            const VadShard& s = plan[i];
+            SliceSampleSource slice(audio, s.feed_start, s.feed_end);
+            StreamingVad vad(slice, config, 1);
+            vad.set_quiet(true);
+            found[i] = vad.finish().segments;
+            const auto shift = static_cast<int32_t>(s.feed_start);
+            for (auto& seg : found[i]) {
+                seg.start_sample += shift;
+                seg.end_sample += shift;
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lk(error_mtx);
+            if (!first_error) first_error = std::current_exception();
+        }
+    };
+    std::vector<std::thread> pool;
+    for (std::size_t i = 1; i < plan.size(); ++i) pool.emplace_back(run, i);
+    run(0);
+    for (auto& th : pool) th.join();
+    if (first_error) std::rethrow_exception(first_error);
+
+    VadResult result = merge_vad_shards(plan, found, samples);
+    log_vad_summary(result, plan.size());
     return result;
 }
+
+VadResult detect_speech(const SampleSource& audio,
+                        const VadConfig& config, int threads) {
+    return detect_speech_sharded(audio, config, threads);
+}
+
+VadResult detect_speech(const std::vector<float>& samples,
+                        const VadConfig& config, int threads) {
+    return detect_speech(MemorySampleSource(samples.data(), samples.size()),
+                         config, threads);
+}
 #endif
 
 } // namespace recmeet
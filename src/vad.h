@@ -3,9 +3,13 @@
 
 #pragma once
 
+#include "sample_source.h"
 #include "util.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <utility>
 #include <vector>
 
 namespace recmeet {
@@ -31,12 +35,194 @@ struct VadConfig {
     int window_size = 512;
 };
 
+// ---------------------------------------------------------------------------
+// Speech-only view (diarization.speech_only)
+// ---------------------------------------------------------------------------
+
+/// Longest silence kept between compacted speech regions: enough for the
+/// segmentation model to see a turn boundary, far shorter than the breaks
+/// it stands in for.
+constexpr std::size_t COMPACT_MAX_GAP_SAMPLES = static_cast<std::size_t>(SAMPLE_RATE) / 2;
+
+/// `audio` with the silence between VAD segments cut down to at most
+/// `max_gap` samples, so a consumer's cost follows speech time rather than
+/// wall time. Regions separated by no more than `max_gap` stay one piece,
+/// silence included; each longer gap becomes exactly `max_gap` samples of
+/// zeros. Times on the compacted timeline map back through
+/// to_source_spans(). `audio` must outlive this object.
+class CompactedSampleSource : public SampleSource {
+public:
+    struct Piece {
+        std::size_t start;   ///< first sample in the source
+        std::size_t n;       ///< samples
+        std::size_t offset;  ///< position of the piece in the compacted stream
+    };
+
+    /// `segments` in source order, non-overlapping (as detect_speech()
+    /// returns them); clamped to the source.
+    CompactedSampleSource(const SampleSource& audio, const std::vector<VadSegment>& segments,
+                          std::size_t max_gap = COMPACT_MAX_GAP_SAMPLES);
+
+    std::size_t size() const override { return length_; }
+    std::size_t read(std::size_t start, std::size_t n, float* out) const override;
+
+    const std::vector<Piece>& pieces() const { return pieces_; }
+
+    /// Source samples covered by the pieces.
+    std::size_t source_samples() const;
+
+    /// The parts of compacted span [start, end) seconds that fall in a
+    /// piece, as source spans in order. Nothing for a span entirely in an
+    /// inserted gap.
+    std::vector<std::pair<double, double>> to_source_spans(double start, double end) const;
+
+private:
+    const SampleSource& audio_;
+    std::vector<Piece> pieces_;
+    std::size_t length_ = 0;
+};
+
+// ---------------------------------------------------------------------------
+// Speech-segment index (vad_YYYY-MM-DD_HH-MM.json next to the audio)
+//
+// Written by the streaming VAD at the end of a recording, or after the
+// first VAD pass in postprocessing, so later passes (reprocess included)
+// skip detection. It records the audio length and the VadConfig it was
+// computed with and is only reused when both still match.
+// ---------------------------------------------------------------------------
+
+/// Path of the index for `audio_path`: the `audio_` prefix (if any) of the
+/// file stem is replaced by `vad_`, in the same directory.
+fs::path vad_index_path(const fs::path& audio_path);
+
+/// Write `result` as the index for audio of `audio_samples` samples.
+/// Throws RecmeetError if the file cannot be written.
+void save_vad_index(const fs::path& path, const VadResult& result,
+                    std::size_t audio_samples, const VadConfig& config);
+
+/// Load the index at `path` into `out`. Returns false — leaving `out`
+/// untouched — if the file is missing or malformed, or was computed for a
+/// different audio length or VadConfig.
+bool load_vad_index(const fs::path& path, std::size_t audio_samples,
+                    const VadConfig& config, VadResult& out);
+
+// ---------------------------------------------------------------------------
+// Sharded VAD (long audio, detect_speech())
+//
+// One Silero detector is sequential by nature, so a long reprocess spends
+// minutes in VAD on one core. detect_speech() instead cuts audio longer
+// than two VAD_MIN_SHARD_SAMPLES into shards run by independent detectors
+// on their own threads. A shard owns the segments that begin in its span.
+// Its detector starts VAD_SHARD_LEAD_SAMPLES early, so its state has
+// settled by the time the span begins, and runs on past the span until
+// any segment begun inside it has closed (max_speech_duration plus
+// min_silence_duration). Every cut is on the serial pass's window grid,
+// so each detector sees the same windows the serial one would: each
+// detector applies min_silence/min_speech as the serial pass does, and the
+// merge only drops the segments a shard does not own and joins the two
+// views of a segment that straddles a cut. Boundaries match the serial
+// pass to within a window.
+// ---------------------------------------------------------------------------
+
+/// Shortest shard detect_speech() cuts audio into.
+constexpr std::size_t VAD_MIN_SHARD_SAMPLES = static_cast<std::size_t>(SAMPLE_RATE) * 600;
+
+/// Audio a shard's detector hears before its own span.
+constexpr std::size_t VAD_SHARD_LEAD_SAMPLES = static_cast<std::size_t>(SAMPLE_RATE) * 5;
+
+struct VadShard {
+    std::size_t feed_start;  ///< first sample fed to the shard's detector
+    std::size_t start;       ///< owned span [start, end)
+    std::size_t end;
+    std::size_t feed_end;    ///< one past the last sample fed
+};
+
+/// At most `max_shards` shards over `samples`, each owning at least
+/// `min_shard` samples; a single shard over everything when the audio is
+/// too short for two. Every cut is a multiple of config.window_size.
+std::vector<VadShard> plan_vad_shards(std::size_t samples, const VadConfig& config,
+                                      int max_shards,
+                                      std::size_t min_shard = VAD_MIN_SHARD_SAMPLES);
+
+/// Join the shards' detections (`per_shard[i]` on the full timeline) into
+/// one result over `samples`: the segments each shard owns, in order, with
+/// any two that overlap across a cut joined.
+VadResult merge_vad_shards(const std::vector<VadShard>& shards,
+                           const std::vector<std::vector<VadSegment>>& per_shard,
+                           std::size_t samples);
+
 #if RECMEET_USE_SHERPA
+/// Incremental Silero VAD over a SampleSource that may still be growing
+/// (a SpoolSampleSource during recording). pump() feeds every complete
+/// window available so far and collects the segments the detector has
+/// closed; finish() feeds the rest, flushes and returns the full result.
+///
+/// Completed segments are popped as soon as they close, so the detector
+/// only ever buffers the speech region in progress (bounded by
+/// max_speech_duration) regardless of the audio length. Feeding happens
+/// window by window in sample order, so the result is identical to a
+/// single detect_speech() pass over the finished audio.
+///
+/// Not thread-safe: call pump() and finish() from one thread.
+class StreamingVad {
+public:
+    /// Load the model and create the detector. `audio` must outlive this
+    /// object. Throws RecmeetError on failure.
+    explicit StreamingVad(const SampleSource& audio,
+                          const VadConfig& config = {}, int threads = 0);
+    ~StreamingVad();
+
+    StreamingVad(const StreamingVad&) = delete;
+    StreamingVad& operator=(const StreamingVad&) = delete;
+
+    /// Feed all complete windows currently available. Returns the number
+    /// of samples consumed. Cheap when nothing new has arrived.
+    std::size_t pump();
+
+    /// Samples fed to the detector so far.
+    std::size_t samples_fed() const { return fed_; }
+
+    /// Speech segments closed so far, in order. Only ever appended to.
+    const std::vector<VadSegment>& segments() const { return result_.segments; }
+
+    /// Feed the remaining complete windows, flush the detector and return
+    /// every segment. Call once, after the source has stopped growing.
+    /// Throws RecmeetError if the source is empty.
+    VadResult finish();
+
+    /// Leave out finish()'s summary log line (one shard of a sharded pass).
+    void set_quiet(bool quiet) { quiet_ = quiet; }
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+    const SampleSource& audio_;
+    VadConfig config_;
+    std::size_t fed_ = 0;
+    bool quiet_ = false;
+    std::vector<float> scratch_;
+    VadResult result_;
+};
+
 /// Detect speech regions in audio samples using Silero VAD via sherpa-onnx.
 /// Takes float32 samples at 16kHz. Returns speech segments with sample-accurate boundaries.
-/// threads: number of CPU threads (0 = use default_thread_count()).
+/// threads: number of CPU threads (0 = use default_thread_count()); audio
+/// long enough is split into up to that many shards (see Sharded VAD).
 VadResult detect_speech(const std::vector<float>& samples,
                         const VadConfig& config = {}, int threads = 0);
+
+/// Same, pulling one VAD window at a time from `audio` — the recording is
+/// never converted to float as a whole.
+VadResult detect_speech(const SampleSource& audio,
+                        const VadConfig& config = {}, int threads = 0);
+
+/// detect_speech() with the shortest shard as a parameter:
+/// plan_vad_shards(audio.size(), config, threads, min_shard), one
+/// single-threaded detector per shard on its own thread, then
+/// merge_vad_shards(). With one shard it is the serial pass on `threads`.
+/// Throws RecmeetError on empty audio or when any shard's detector fails.
+VadResult detect_speech_sharded(const SampleSource& audio, const VadConfig& config,
+                                int threads, std::size_t min_shard = VAD_MIN_SHARD_SAMPLES);
 #endif
 
 } // namespace recmeet
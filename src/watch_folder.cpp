@@ -0,0 +1,237 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include "watch_folder.h"
+#include "audio_file.h"
+#include "audio_view.h"
+#include "log.h"
+#include "sample_kernels.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace recmeet {
+
+namespace {
+
+constexpr uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_MODIFY;
+
+// Kept as they are: find_audio_file() takes these, at any rate.
+constexpr const char* kNativeExts[] = {".wav", ".flac", ".opus"};
+// Decoded into the meeting's WAV on ingest.
+constexpr const char* kDecodedExts[] = {".ogg", ".oga", ".aiff", ".aif",
+                                        ".mp3", ".m4a", ".aac", ".wma"};
+
+// ingest_watch_file(): samples converted per AudioView read.
+constexpr std::size_t kDecodeBlock = 60 * SAMPLE_RATE;
+
+std::string lower_extension(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext;
+}
+
+bool is_native(const std::string& ext) {
+    return std::find_if(std::begin(kNativeExts), std::end(kNativeExts),
+                        [&](const char* e) { return ext == e; }) != std::end(kNativeExts);
+}
+
+int64_t steady_sec() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// rename(), or copy and remove across filesystems.
+void move_file(const fs::path& from, const fs::path& to) {
+    std::error_code ec;
+    fs::rename(from, to, ec);
+    if (!ec) return;
+    if (ec != std::errc::cross_device_link)
+        throw RecmeetError("Cannot move " + from.string() + " to " + to.string() + ": " +
+                           ec.message());
+    fs::copy_file(from, to, ec);
+    if (!ec) fs::remove(from, ec);
+    if (ec) {
+        std::error_code rm;
+        fs::remove(to, rm);
+        throw RecmeetError("Cannot move " + from.string() + " to " + to.string() + ": " +
+                           ec.message());
+    }
+}
+
+// Decode `file` (any rate, any format AudioView reads) into a 16 kHz mono WAV.
+void decode_to_wav(const fs::path& file, const fs::path& wav) {
+    AudioView view(file);
+    std::vector<int16_t> pcm(view.size());
+    std::vector<float> block;
+    for (std::size_t at = 0; at < pcm.size(); at += kDecodeBlock) {
+        const std::size_t n = std::min(kDecodeBlock, pcm.size() - at);
+        block.resize(n);
+        view.read(at, n, block.data());
+        sample_kernels().f32_to_s16(block.data(), pcm.data() + at, n);
+    }
+    const fs::path part = wav.string() + ".part";
+    write_wav(part, pcm);
+    fs::rename(part, wav);
+}
+
+} // anonymous namespace
+
+bool is_watch_candidate(const fs::path& path) {
+    const std::string name = path.filename().string();
+    if (name.empty() || name[0] == '.') return false;
+    const std::string ext = lower_extension(path);
+    return is_native(ext) ||
+           std::find_if(std::begin(kDecodedExts), std::end(kDecodedExts),
+                        [&](const char* e) { return ext == e; }) != std::end(kDecodedExts);
+}
+
+fs::path ingest_watch_file(const fs::path& file, const fs::path& output_dir) {
+    struct stat st{};
+    if (::stat(file.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+        throw RecmeetError("Watch folder file vanished: " + file.string());
+
+    const OutputDir out = create_output_dir(output_dir, st.st_mtim.tv_sec);
+    const std::string ext = lower_extension(file);
+    const std::string stem = std::string(AUDIO_PREFIX) + out.timestamp;
+    try {
+        if (is_native(ext)) {
+            move_file(file, out.path / (stem + ext));
+        } else {
+            decode_to_wav(file, out.path / (stem + ".wav"));
+            move_file(file, out.path / file.filename());
+        }
+    } catch (const std::exception& e) {
+        std::error_code ec;
+        fs::remove_all(out.path, ec);
+        throw RecmeetError("Cannot ingest " + file.string() + ": " + e.what());
+    }
+    return out.path;
+}
+
+// ---------------------------------------------------------------------------
+// WatchFolder
+// ---------------------------------------------------------------------------
+
+WatchFolder::WatchFolder(fs::path dir, int settle_sec, ReadyFn on_ready)
+    : dir_(std::move(dir)), settle_sec_(std::max(settle_sec, 0)),
+      on_ready_(std::move(on_ready)) {}
+
+WatchFolder::~WatchFolder() { stop(); }
+
+void WatchFolder::start() {
+    if (watcher_.joinable()) return;
+    stop_ = false;
+    inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ >= 0 && ::inotify_add_watch(inotify_fd_, dir_.c_str(), WATCH_MASK) < 0) {
+        ::close(inotify_fd_);
+        inotify_fd_ = -1;
+    }
+    if (inotify_fd_ < 0)
+        log_info("watch folder: polling %s every %ds", dir_.c_str(), kPollSec);
+    else
+        log_info("watch folder: watching %s (settle %ds)", dir_.c_str(), settle_sec_);
+    watcher_ = std::thread([this] { watch_loop(); });
+}
+
+void WatchFolder::stop() {
+    stop_ = true;
+    if (watcher_.joinable()) watcher_.join();
+    if (inotify_fd_ >= 0) ::close(inotify_fd_);
+    inotify_fd_ = -1;
+}
+
+std::vector<fs::path> WatchFolder::scan(int64_t now_sec) {
+    struct Ready {
+        int64_t mtime_ns;
+        fs::path path;
+    };
+    std::vector<Ready> ready;
+    std::lock_guard<std::mutex> lock(mu_);
+    std::map<std::string, Candidate> seen;
+    next_due_ = INT64_MAX;
+
+    std::error_code ec;
+    for (fs::directory_iterator it(dir_, ec), end; !ec && it != end; it.increment(ec)) {
+        const fs::path& path = it->path();
+        if (!is_watch_candidate(path)) continue;
+        struct stat st{};
+        if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) continue;
+        const std::string name = path.filename().string();
+        const auto size = static_cast<uint64_t>(st.st_size);
+        const int64_t mtime =
+            static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+
+        Candidate c;
+        auto prev = candidates_.find(name);
+        if (prev != candidates_.end() && prev->second.size == size &&
+            prev->second.mtime_ns == mtime) {
+            c = prev->second;
+        } else {
+            c.size = size;
+            c.mtime_ns = mtime;
+            c.since = now_sec;  // new, or still being written
+        }
+        if (!c.handed && size > 0) {
+            if (now_sec - c.since >= settle_sec_) {
+                c.handed = true;
+                ready.push_back({mtime, path});
+            } else {
+                next_due_ = std::min(next_due_, c.since + settle_sec_);
+            }
+        }
+        seen.emplace(name, c);
+    }
+    if (ec) log_warn("watch folder: cannot list %s (%s)", dir_.c_str(), ec.message().c_str());
+    candidates_ = std::move(seen);  // forget files that went away
+
+    std::sort(ready.begin(), ready.end(), [](const Ready& a, const Ready& b) {
+        return a.mtime_ns != b.mtime_ns ? a.mtime_ns < b.mtime_ns : a.path < b.path;
+    });
+    std::vector<fs::path> out;
+    out.reserve(ready.size());
+    for (auto& r : ready) out.push_back(std::move(r.path));
+    return out;
+}
+
+void WatchFolder::watch_loop() {
+    int64_t last_sweep = INT64_MIN / 2;  // sweep at once: files already waiting
+    while (!stop_) {
+        bool event = false;
+        if (inotify_fd_ >= 0) {
+            struct pollfd pfd{inotify_fd_, POLLIN, 0};
+            if (::poll(&pfd, 1, 250) > 0) {
+                alignas(struct inotify_event) char buf[4096];
+                while (::read(inotify_fd_, buf, sizeof(buf)) > 0) event = true;
+            }
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        }
+        const int64_t now = steady_sec();
+        const int period = inotify_fd_ >= 0 ? kInotifyPollSec : kPollSec;
+        int64_t due;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            due = next_due_;
+        }
+        if (!event && now < due && now - last_sweep < period) continue;
+        last_sweep = now;
+        const auto ready = scan(now);
+        if (ready.empty()) continue;
+        try {
+            on_ready_(ready);
+        } catch (const std::exception& e) {
+            log_error("watch folder: %s", e.what());
+        }
+    }
+}
+
+} // namespace recmeet
@@ -0,0 +1,112 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include "util.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace recmeet {
+
+// ---------------------------------------------------------------------------
+// Watch folder (postprocess.watch_dir)
+// ---------------------------------------------------------------------------
+//
+// Conference-room appliances and phones drop recordings onto a shared
+// folder. With postprocess.watch_dir set, the daemon watches it (inotify,
+// with a periodic scan as the safety net and the only mechanism where
+// inotify is unavailable) and ingests every audio file once it is
+// complete. An upload in progress, over SMB or scp, is still growing or
+// being touched, so a file counts as complete when its size and mtime have
+// not changed for postprocess.watch_settle_sec.
+//
+// Ingesting moves the file into a new meeting directory under output_dir,
+// named for the file's mtime like a recording of that minute (the watch
+// folder is an inbox: what is left in it is still to do). WAV, FLAC and
+// Opus become the meeting's `audio_<ts><ext>` as they are; anything else
+// is decoded once into `audio_<ts>.wav` so every tool that looks for a
+// meeting's audio finds it, and the original is kept beside it. The daemon queues the files that became ready together as
+// one group of batch-class jobs, oldest first: they run behind live
+// meetings and reprocess requests, back to back on the warm workers with
+// the same config, so the models stay loaded from one to the next.
+
+/// True for a file the watch folder ingests: a visible regular-file name
+/// with an audio extension validate_reprocess_input() can take (WAV, FLAC,
+/// Ogg/Opus, AIFF, and MP3/M4A/AAC/WMA through ffmpeg), case-insensitive.
+/// Hidden files and `.part`/`.tmp` uploads are skipped.
+bool is_watch_candidate(const fs::path& path);
+
+/// Move `file` into a new meeting directory under `output_dir` named for
+/// its mtime (create_output_dir()): as `audio_<ts><ext>` for .wav / .flac /
+/// .opus, otherwise under its own name after decoding it (AudioView) into
+/// `audio_<ts>.wav`. Falls back to copy-and-remove across filesystems.
+/// Returns the meeting directory; throws RecmeetError (the file stays where
+/// it was, and the meeting directory is removed).
+fs::path ingest_watch_file(const fs::path& file, const fs::path& output_dir);
+
+class WatchFolder {
+public:
+    /// Receives the files that became ready in one pass, oldest mtime
+    /// first. Called on the watcher thread.
+    using ReadyFn = std::function<void(const std::vector<fs::path>&)>;
+
+    WatchFolder(fs::path dir, int settle_sec, ReadyFn on_ready);
+    /// Stops watching.
+    ~WatchFolder();
+
+    WatchFolder(const WatchFolder&) = delete;
+    WatchFolder& operator=(const WatchFolder&) = delete;
+
+    /// Watch on a background thread: scan() on every inotify event, when a
+    /// pending file's settle time is up, and every kPollSec (every
+    /// kInotifyPollSec as a safety net while inotify works), handing what is
+    /// ready to `on_ready`.
+    void start();
+    void stop();
+
+    /// One pass at steady time `now_sec`: stat each candidate directly in
+    /// the folder and return those whose size and mtime are unchanged since
+    /// `settle_sec` ago (each is returned once while it stays put). Test
+    /// seam; the watcher thread calls it with the steady clock.
+    std::vector<fs::path> scan(int64_t now_sec);
+
+    const fs::path& dir() const { return dir_; }
+
+    /// Whether the watcher is using inotify rather than polling alone.
+    bool inotify_active() const { return inotify_fd_ >= 0; }
+
+    static constexpr int kPollSec = 5;
+    static constexpr int kInotifyPollSec = 60;
+
+private:
+    struct Candidate {
+        uint64_t size = 0;
+        int64_t mtime_ns = 0;
+        int64_t since = 0;     // steady seconds it has looked like this
+        bool handed = false;   // returned by scan(); not again while unchanged
+    };
+
+    void watch_loop();
+
+    const fs::path dir_;
+    const int settle_sec_;
+    const ReadyFn on_ready_;
+
+    std::mutex mu_;  // scan() state
+    std::map<std::string, Candidate> candidates_;  // by file name
+    int64_t next_due_ = INT64_MAX;  // earliest steady second one may be ready
+
+    int inotify_fd_ = -1;
+    std::thread watcher_;
+    std::atomic<bool> stop_{false};
+};
+
+} // namespace recmeet
@@ -1,20 +1,31 @@
 // Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
 // SPDX-License-Identifier: MIT OR Apache-2.0
 
+#include "audio_view.h"
 #include "config.h"
+#include "heavy_work.h"
 #include "ipc_client.h"
 #include "log.h"
+#include "meeting_index.h"
+#include "metrics.h"
+#include "pipeline.h"
+#include "reidentify_jobs.h"
 #include "speaker_id.h"
+#include "stage_cache.h"
 #include "util.h"
 #include "version.h"
 
 #include <httplib.h>
 
 #include <algorithm>
+#include <cmath>
 #include <csignal>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <ctime>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <sstream>
 
@@ -90,6 +101,55 @@ static int json_get_int(const std::string& body, const std::string& key, int def
     return std::atoi(body.c_str() + pos);
 }
 
+// ---------------------------------------------------------------------------
+// Conditional GET and paging
+// ---------------------------------------------------------------------------
+
+// Entity tag for `seed`: FNV-1a, since a tag only has to change with it.
+static std::string make_etag(const std::string& seed) {
+    uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : seed) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    char buf[24];
+    std::snprintf(buf, sizeof(buf), "\"%016llx\"", static_cast<unsigned long long>(h));
+    return buf;
+}
+
+// Tag the response with `etag` and ask clients to revalidate each use. True,
+// with a 304 and no body, when If-None-Match shows the client has it.
+static bool not_modified(const httplib::Request& req, httplib::Response& res,
+                         const std::string& etag) {
+    res.set_header("ETag", etag);
+    res.set_header("Cache-Control", "no-cache");
+    const auto inm = req.get_header_value("If-None-Match");
+    if (inm != "*" && inm.find(etag) == std::string::npos) return false;
+    res.status = 304;
+    return true;
+}
+
+// The request's query parameters in a stable order, for an entity tag.
+static std::string canonical_params(const httplib::Request& req) {
+    std::string out;
+    for (const auto& [k, v] : req.params) out += k + "=" + v + "&";
+    return out;
+}
+
+static std::string audio_mime_type(const fs::path& path) {
+    const auto ext = path.extension().string();
+    if (ext == ".wav") return "audio/wav";
+    if (ext == ".flac") return "audio/flac";
+    if (ext == ".ogg" || ext == ".opus") return "audio/ogg";
+    if (ext == ".mp3") return "audio/mpeg";
+    return "application/octet-stream";
+}
+
+static bool param_true(const httplib::Request& req, const char* key) {
+    const auto v = req.get_param_value(key);
+    return v == "1" || v == "true";
+}
+
 // ---------------------------------------------------------------------------
 // Path safety: validate meeting_dir is a simple name (no path traversal)
 // ---------------------------------------------------------------------------
@@ -118,7 +178,8 @@ static std::string speaker_profile_to_json(const SpeakerProfile& p) {
     return out.str();
 }
 
-static std::string speaker_profile_detail_to_json(const SpeakerProfile& p) {
+// `embeddings` adds the vectors themselves, which only tooling asks for.
+static std::string speaker_profile_detail_to_json(const SpeakerProfile& p, bool embeddings) {
     std::ostringstream out;
     out << "{";
     out << "\"name\":\"" << escape_json(p.name) << "\",";
@@ -126,24 +187,28 @@ static std::string speaker_profile_detail_to_json(const SpeakerProfile& p) {
     out << "\"created\":\"" << escape_json(p.created) << "\",";
     out << "\"updated\":\"" << escape_json(p.updated) << "\",";
     out << "\"embedding_dim\":" << (p.embeddings.empty() ? 0 : p.embeddings[0].size());
+    if (embeddings) {
+        out << ",\"embeddings\":[";
+        for (size_t i = 0; i < p.embeddings.size(); ++i) {
+            out << (i > 0 ? ",[" : "[");
+            for (size_t j = 0; j < p.embeddings[i].size(); ++j)
+                out << (j > 0 ? "," : "") << p.embeddings[i][j];
+            out << "]";
+        }
+        out << "]";
+    }
     out << "}";
     return out.str();
 }
 
-struct MeetingInfo {
-    std::string name;
-    bool has_speakers;
-    int speaker_count;
-    std::string date;
-};
-
 static std::string meeting_info_to_json(const MeetingInfo& m) {
     std::ostringstream out;
     out << "{";
     out << "\"name\":\"" << escape_json(m.name) << "\",";
     out << "\"has_speakers\":" << (m.has_speakers ? "true" : "false") << ",";
     out << "\"speaker_count\":" << m.speaker_count << ",";
-    out << "\"date\":\"" << escape_json(m.date) << "\"";
+    out << "\"date\":\"" << escape_json(m.date) << "\",";
+    out << "\"duration_sec\":" << m.duration_sec;
     out << "}";
     return out.str();
 }
@@ -162,53 +227,6 @@ static std::string meeting_speaker_to_json(const MeetingSpeaker& s) {
 }
 #endif
 
-// ---------------------------------------------------------------------------
-// Meeting discovery
-// ---------------------------------------------------------------------------
-
-static std::vector<MeetingInfo> discover_meetings(const fs::path& output_dir) {
-    std::vector<MeetingInfo> meetings;
-    if (!fs::is_directory(output_dir)) return meetings;
-
-    for (const auto& entry : fs::directory_iterator(output_dir)) {
-        if (!entry.is_directory()) continue;
-
-        auto audio_path = find_audio_file(entry.path());
-        if (audio_path.empty()) continue;
-
-        MeetingInfo info;
-        info.name = entry.path().filename().string();
-
-        auto spk_path = find_speakers_file(entry.path());
-        info.has_speakers = !spk_path.empty();
-        info.speaker_count = 0;
-
-#if RECMEET_USE_SHERPA
-        if (info.has_speakers) {
-            auto spks = load_meeting_speakers(entry.path());
-            info.speaker_count = static_cast<int>(spks.size());
-        }
-#endif
-
-        // Extract date from directory name (YYYY-MM-DD_HH-MM format)
-        auto dirname = info.name;
-        if (dirname.size() >= 10 && dirname[4] == '-' && dirname[7] == '-')
-            info.date = dirname.substr(0, 10);
-        else
-            info.date = "";
-
-        meetings.push_back(std::move(info));
-    }
-
-    // Sort by name descending (most recent first, since names are date-based)
-    std::sort(meetings.begin(), meetings.end(),
-              [](const MeetingInfo& a, const MeetingInfo& b) {
-                  return a.name > b.name;
-              });
-
-    return meetings;
-}
-
 // ---------------------------------------------------------------------------
 // Usage
 // ---------------------------------------------------------------------------
@@ -225,6 +243,7 @@ static void print_usage() {
         "  --web-root DIR       Static file directory\n"
         "  --config PATH        Config file path\n"
         "  --log-level LEVEL    none|error|warn|info (default: none)\n"
+        "  --metrics            Serve the daemon's metrics at /metrics (OpenMetrics)\n"
         "  --help               Show this message\n"
         "  --version            Show version\n"
     );
@@ -241,6 +260,7 @@ int main(int argc, char* argv[]) {
     std::string log_level_str;
     int port = -1;
     std::string bind_addr;
+    bool serve_metrics = false;
 
     for (int i = 1; i < argc; ++i) {
         auto arg = std::string(argv[i]);
@@ -274,6 +294,8 @@ int main(int argc, char* argv[]) {
             auto v = next();
             if (!v) { fprintf(stderr, "--log-level requires a value\n"); return 1; }
             log_level_str = v;
+        } else if (arg == "--metrics") {
+            serve_metrics = true;
         } else {
             fprintf(stderr, "Unknown option: %s\n", arg.c_str());
             print_usage();
@@ -322,15 +344,45 @@ int main(int argc, char* argv[]) {
     // Mutex for thread-safe speaker DB writes
     std::mutex speaker_mu;
 
+#if RECMEET_USE_SHERPA
+    // Batch re-identify jobs, run off the request threads
+    ReidentifyJobs reidentify_jobs(speaker_db_dir, output_dir, cfg.speaker_ann,
+                                   cfg.speaker_threshold, cfg.threads, speaker_mu);
+#endif
+
+    // Meeting listing, kept current off the request threads. Its generation
+    // restarts with the server, so meeting ETags also carry the start time.
+    MeetingIndex meeting_index(output_dir, meeting_index_cache_path());
+    const std::string etag_epoch = std::to_string(std::time(nullptr));
+
     // Create server
     httplib::Server server;
     g_server = &server;
 
+    // Heavy endpoints go through `gate`; the request pool keeps threads
+    // beyond its slots and queue for everything else.
+    HeavyWorkGate gate(static_cast<size_t>(cfg.web_heavy_workers),
+                       static_cast<size_t>(cfg.web_heavy_queue));
+    const size_t request_threads = web_request_threads(gate, CPPHTTPLIB_THREAD_POOL_COUNT);
+    server.new_task_queue = [request_threads] { return new httplib::ThreadPool(request_threads); };
+    auto heavy = [&gate](httplib::Server::Handler handler) {
+        return [&gate, handler = std::move(handler)](const httplib::Request& req,
+                                                     httplib::Response& res) {
+            if (gate.run([&] { handler(req, res); })) return;
+            const int retry = gate.retry_after_sec();
+            res.status = 429;
+            res.set_header("Retry-After", std::to_string(retry));
+            res.set_content(heavy_work_busy_json(retry), "application/json");
+        };
+    };
+
     // CORS headers for local dev
     server.set_default_headers({
         {"Access-Control-Allow-Origin", "*"},
         {"Access-Control-Allow-Methods", "GET, POST, DELETE, OPTIONS"},
-        {"Access-Control-Allow-Headers", "Content-Type"},
+        {"Access-Control-Allow-Headers", "Content-Type, If-None-Match, Range"},
+        {"Access-Control-Expose-Headers",
+         "ETag, X-Next-Cursor, Content-Range, Accept-Ranges, Retry-After"},
     });
 
     // OPTIONS preflight
@@ -338,22 +390,63 @@ int main(int argc, char* argv[]) {
         res.status = 204;
     });
 
-    // Health check
-    server.Get("/api/health", [](const httplib::Request&, httplib::Response& res) {
-        res.set_content(R"({"status":"ok"})", "application/json");
+    // Health check, with the heavy-work backlog
+    server.Get("/api/health", [&gate](const httplib::Request&, httplib::Response& res) {
+        const HeavyWorkStats st = gate.stats();
+        std::ostringstream out;
+        out << R"({"status":"ok","heavy_running":)" << st.running
+            << R"(,"heavy_waiting":)" << st.waiting
+            << R"(,"heavy_rejected":)" << st.rejected << "}";
+        res.set_content(out.str(), "application/json");
     });
 
+    // Prometheus scrape target (--metrics): the daemon's metrics.get.
+    if (serve_metrics) {
+        server.Get("/metrics", [](const httplib::Request&, httplib::Response& res) {
+            IpcClient client;
+            IpcResponse ipc_resp;
+            IpcError ipc_err;
+            if (!client.connect() ||
+                !client.call("metrics.get", {}, ipc_resp, ipc_err, 5000)) {
+                res.status = 503;
+                res.set_content("recmeet-daemon is not reachable\n", "text/plain");
+                return;
+            }
+            res.set_content(json_val_as_string(ipc_resp.result["text"]),
+                            OPENMETRICS_CONTENT_TYPE);
+        });
+    }
+
     // --- Speaker endpoints ---
 
-    server.Get("/api/speakers", [&](const httplib::Request&, httplib::Response& res) {
+    // ?q= filters by name, ?limit= pages; X-Next-Cursor carries the name to
+    // pass as ?cursor= for the next page.
+    server.Get("/api/speakers", [&](const httplib::Request& req, httplib::Response& res) {
         auto profiles = load_speaker_db(speaker_db_dir);
+        std::sort(profiles.begin(), profiles.end(),
+                  [](const SpeakerProfile& a, const SpeakerProfile& b) { return a.name < b.name; });
+        const auto text = req.get_param_value("q");
+        const auto cursor = req.get_param_value("cursor");
+        const size_t limit = static_cast<size_t>(std::max(0, std::atoi(
+            req.get_param_value("limit").c_str())));
         std::ostringstream out;
         out << "[";
-        for (size_t i = 0; i < profiles.size(); ++i) {
-            if (i > 0) out << ",";
-            out << speaker_profile_to_json(profiles[i]);
+        size_t n = 0;
+        const std::string* last = nullptr;
+        for (const auto& p : profiles) {
+            if (!cursor.empty() && p.name <= cursor) continue;
+            if (!text.empty() && p.name.find(text) == std::string::npos) continue;
+            if (limit > 0 && n == limit) {
+                res.set_header("X-Next-Cursor", *last);
+                break;
+            }
+            if (n++ > 0) out << ",";
+            out << speaker_profile_to_json(p);
+            last = &p.name;
         }
         out << "]";
+        if (not_modified(req, res, make_etag(out.str() + res.get_header_value("X-Next-Cursor"))))
+            return;
         res.set_content(out.str(), "application/json");
     });
 
@@ -367,7 +460,9 @@ int main(int argc, char* argv[]) {
         auto profiles = load_speaker_db(speaker_db_dir);
         for (const auto& p : profiles) {
             if (p.name == name) {
-                res.set_content(speaker_profile_detail_to_json(p), "application/json");
+                const auto body = speaker_profile_detail_to_json(p, param_true(req, "embeddings"));
+                if (not_modified(req, res, make_etag(body))) return;
+                res.set_content(body, "application/json");
                 return;
             }
         }
@@ -375,7 +470,7 @@ int main(int argc, char* argv[]) {
         res.set_content(json_error("speaker not found"), "application/json");
     });
 
-    server.Delete(R"(/api/speakers/(.+))", [&](const httplib::Request& req, httplib::Response& res) {
+    server.Delete(R"(/api/speakers/(.+))", heavy([&](const httplib::Request& req, httplib::Response& res) {
         auto name = req.matches[1].str();
         if (!is_safe_dirname(name)) {
             res.status = 400;
@@ -389,15 +484,15 @@ int main(int argc, char* argv[]) {
             res.status = 404;
             res.set_content(json_error("speaker not found"), "application/json");
         }
-    });
+    }));
 
-    server.Post("/api/speakers/reset", [&](const httplib::Request&, httplib::Response& res) {
+    server.Post("/api/speakers/reset", heavy([&](const httplib::Request&, httplib::Response& res) {
         std::lock_guard<std::mutex> lock(speaker_mu);
         int removed = reset_speakers(speaker_db_dir);
         res.set_content(json_ok_removed(removed), "application/json");
-    });
+    }));
 
-    server.Post("/api/speakers/enroll", [&](const httplib::Request& req, httplib::Response& res) {
+    server.Post("/api/speakers/enroll", heavy([&](const httplib::Request& req, httplib::Response& res) {
         auto name = json_get_str(req.body, "name");
         auto meeting_dir_name = json_get_str(req.body, "meeting_dir");
         int cluster_id = json_get_int(req.body, "cluster_id", -1);
@@ -497,10 +592,10 @@ int main(int argc, char* argv[]) {
         res.status = 501;
         res.set_content(json_error("enrollment requires sherpa-onnx support"), "application/json");
 #endif
-    });
+    }));
 
     // Remove a specific embedding from a speaker profile by index
-    server.Post(R"(/api/speakers/([^/]+)/remove-embedding)", [&](const httplib::Request& req, httplib::Response& res) {
+    server.Post(R"(/api/speakers/([^/]+)/remove-embedding)", heavy([&](const httplib::Request& req, httplib::Response& res) {
         auto name = req.matches[1].str();
         if (!is_safe_dirname(name)) {
             res.status = 400;
@@ -542,39 +637,14 @@ int main(int argc, char* argv[]) {
             res.set_content(R"({"ok":true,"remaining":)" +
                             std::to_string(found->embeddings.size()) + "}", "application/json");
         }
-    });
+    }));
 
-    // Batch re-identify all meetings against current speaker DB
+    // Batch re-identify all meetings against current speaker DB, as a
+    // background job; poll /api/jobs/<job_id> for progress.
     server.Post("/api/speakers/batch-reidentify", [&](const httplib::Request&, httplib::Response& res) {
 #if RECMEET_USE_SHERPA
-        std::lock_guard<std::mutex> lock(speaker_mu);
-        auto db = load_speaker_db(speaker_db_dir);
-        if (db.empty()) {
-            res.set_content(R"({"ok":true,"meetings_updated":0,"meetings_scanned":0})",
-                            "application/json");
-            return;
-        }
-
-        auto meetings = discover_meetings(output_dir);
-        int scanned = 0, updated = 0;
-
-        for (const auto& mtg : meetings) {
-            if (!mtg.has_speakers) continue;
-            auto meeting_path = output_dir / mtg.name;
-            auto spks = load_meeting_speakers(meeting_path);
-            if (spks.empty()) continue;
-            ++scanned;
-
-            auto result = re_identify_meeting(spks, db);
-            if (!result.empty()) {
-                save_meeting_speakers(meeting_path, result, derive_meeting_timestamp(meeting_path));
-                ++updated;
-            }
-        }
-
-        res.set_content(R"({"ok":true,"meetings_updated":)" + std::to_string(updated) +
-                        R"(,"meetings_scanned":)" + std::to_string(scanned) + "}",
-                        "application/json");
+        res.status = 202;
+        res.set_content(reidentify_status_json(reidentify_jobs.start()), "application/json");
 #else
         res.status = 501;
         res.set_content(json_error("batch re-identify requires sherpa-onnx support"),
@@ -582,10 +652,41 @@ int main(int argc, char* argv[]) {
 #endif
     });
 
+    server.Get(R"(/api/jobs/([0-9]+-[0-9]+))", [&](const httplib::Request& req, httplib::Response& res) {
+#if RECMEET_USE_SHERPA
+        ReidentifyJobStatus status;
+        if (reidentify_jobs.status(req.matches[1].str(), status)) {
+            res.set_content(reidentify_status_json(status), "application/json");
+            return;
+        }
+#else
+        (void)req;
+#endif
+        res.status = 404;
+        res.set_content(json_error("job not found"), "application/json");
+    });
+
     // --- Meeting endpoints ---
 
-    server.Get("/api/meetings", [&](const httplib::Request&, httplib::Response& res) {
-        auto meetings = discover_meetings(output_dir);
+    // Filters: ?q= (name substring), ?from=/?to= (YYYY-MM-DD), ?has_speakers=.
+    // ?limit= pages, with X-Next-Cursor naming the next page's ?cursor=. The
+    // ETag follows the index generation, so revalidating costs no listing.
+    server.Get("/api/meetings", [&](const httplib::Request& req, httplib::Response& res) {
+        const auto etag = make_etag(etag_epoch + "/" +
+                                    std::to_string(meeting_index.generation()) + "/" +
+                                    canonical_params(req));
+        if (not_modified(req, res, etag)) return;
+
+        MeetingQuery q;
+        q.cursor = req.get_param_value("cursor");
+        q.limit = static_cast<size_t>(std::max(0, std::atoi(req.get_param_value("limit").c_str())));
+        q.text = req.get_param_value("q");
+        q.from = req.get_param_value("from");
+        q.to = req.get_param_value("to");
+        if (req.has_param("has_speakers")) q.has_speakers = param_true(req, "has_speakers") ? 1 : 0;
+        std::string next;
+        auto meetings = select_meetings(meeting_index.list(), q, next);
+        if (!next.empty()) res.set_header("X-Next-Cursor", next);
         std::ostringstream out;
         out << "[";
         for (size_t i = 0; i < meetings.size(); ++i) {
@@ -626,8 +727,91 @@ int main(int argc, char* argv[]) {
 #endif
     });
 
+    // The recording, with Range support: cpp-httplib maps the file and writes
+    // each requested range straight from the mapping (416 past its end).
+    server.Get(R"(/api/meetings/([^/]+)/audio)", [&](const httplib::Request& req, httplib::Response& res) {
+        auto dir_name = req.matches[1].str();
+        if (!is_safe_dirname(dir_name)) {
+            res.status = 400;
+            res.set_content(json_error("invalid meeting directory name"), "application/json");
+            return;
+        }
+        auto audio_path = find_audio_file(output_dir / dir_name);
+        if (audio_path.empty()) {
+            res.status = 404;
+            res.set_content(json_error("no audio file found in meeting directory"), "application/json");
+            return;
+        }
+        res.set_header("Accept-Ranges", "bytes");
+        res.set_file_content(audio_path.string(), audio_mime_type(audio_path));
+    });
+
+    // Where one speaker talks: the cluster's segments from the meeting's
+    // saved diarization, each with the byte range to request from .../audio
+    // when the recording is plain PCM WAV, so a reviewer can audition the
+    // speaker without downloading the whole file.
+    server.Get(R"(/api/meetings/([^/]+)/speakers/([0-9]+)/segments)", [&](const httplib::Request& req, httplib::Response& res) {
+        auto dir_name = req.matches[1].str();
+        if (!is_safe_dirname(dir_name)) {
+            res.status = 400;
+            res.set_content(json_error("invalid meeting directory name"), "application/json");
+            return;
+        }
+        const int cluster_id = std::atoi(req.matches[2].str().c_str());
+        auto audio_path = find_audio_file(output_dir / dir_name);
+        if (audio_path.empty()) {
+            res.status = 404;
+            res.set_content(json_error("no audio file found in meeting directory"), "application/json");
+            return;
+        }
+        DiarizeResult diar;
+        std::map<int, std::vector<float>> centroids;
+        if (!load_saved_diarization_stage(stage_cache_path(audio_path, STAGE_DIARIZATION),
+                                          diar, centroids)) {
+            res.status = 404;
+            res.set_content(json_error("no saved diarization for this meeting"), "application/json");
+            return;
+        }
+        std::unique_ptr<AudioView> view;
+        try {
+            view = std::make_unique<AudioView>(audio_path);
+        } catch (const RecmeetError& e) {
+            res.status = 500;
+            res.set_content(json_error(e.what()), "application/json");
+            return;
+        }
+
+        std::ostringstream out;
+        out << "{\"cluster_id\":" << cluster_id
+            << ",\"audio\":\"" << escape_json(audio_path.filename().string())
+            << "\",\"seekable\":" << (view->mapped() ? "true" : "false") << ",\"segments\":[";
+        bool first_seg = true;
+        for (const auto& seg : diar.segments) {
+            if (seg.speaker != cluster_id) continue;
+            const auto s0 = static_cast<size_t>(std::llround(seg.start * SAMPLE_RATE));
+            const auto s1 = static_cast<size_t>(std::llround(seg.end * SAMPLE_RATE));
+            // The player seeks in the file as served: a speech-only archive's
+            // segments are given on its stored timeline.
+            double start = seg.start, end = seg.end;
+            if (view->sparse()) {
+                size_t a = 0, n = 0;
+                if (s1 <= s0 || !view->stored_range(s0, s1 - s0, a, n)) continue;
+                start = static_cast<double>(a) / SAMPLE_RATE;
+                end = static_cast<double>(a + n) / SAMPLE_RATE;
+            }
+            out << (first_seg ? "" : ",") << "{\"start\":" << start << ",\"end\":" << end;
+            first_seg = false;
+            uint64_t first = 0, last = 0;
+            if (s1 > s0 && view->byte_range(s0, s1 - s0, first, last))
+                out << ",\"range\":\"bytes=" << first << "-" << last << "\"";
+            out << "}";
+        }
+        out << "]}";
+        res.set_content(out.str(), "application/json");
+    });
+
     // Relabel a meeting speaker (correct misidentification)
-    server.Post(R"(/api/meetings/([^/]+)/speakers/relabel)", [&](const httplib::Request& req, httplib::Response& res) {
+    server.Post(R"(/api/meetings/([^/]+)/speakers/relabel)", heavy([&](const httplib::Request& req, httplib::Response& res) {
         auto dir_name = req.matches[1].str();
         if (!is_safe_dirname(dir_name)) {
             res.status = 400;
@@ -657,7 +841,8 @@ int main(int argc, char* argv[]) {
 
         std::lock_guard<std::mutex> lock(speaker_mu);
 
-        auto meeting_speakers = load_meeting_speakers(meeting_path);
+        EmbeddingPrecision precision;
+        auto meeting_speakers = load_meeting_speakers(meeting_path, &precision);
         if (meeting_speakers.empty()) {
             res.status = 404;
             res.set_content(json_error("no speakers.json in meeting directory"), "application/json");
@@ -702,7 +887,9 @@ int main(int argc, char* argv[]) {
         spk->label = new_label;
         spk->identified = true;
         spk->confidence = 1.0f;
-        save_meeting_speakers(meeting_path, meeting_speakers, derive_meeting_timestamp(meeting_path));
+        save_meeting_speakers(meeting_path, meeting_speakers, derive_meeting_timestamp(meeting_path),
+                              precision);
+        meeting_index.refresh(dir_name);
 
         res.set_content(R"({"ok":true,"old_label":")" + escape_json(old_label) + R"("})",
                         "application/json");
@@ -710,10 +897,45 @@ int main(int argc, char* argv[]) {
         res.status = 501;
         res.set_content(json_error("relabeling requires sherpa-onnx support"), "application/json");
 #endif
-    });
+    }));
+
+    // Rewrite a meeting's note with its current speaker labels (after a
+    // relabel), from the note stage — no model is loaded
+    server.Post(R"(/api/meetings/([^/]+)/rerender)", heavy([&](const httplib::Request& req, httplib::Response& res) {
+        auto dir_name = req.matches[1].str();
+        if (!is_safe_dirname(dir_name)) {
+            res.status = 400;
+            res.set_content(json_error("invalid meeting directory name"), "application/json");
+            return;
+        }
+
+        auto meeting_path = output_dir / dir_name;
+        if (!fs::is_directory(meeting_path)) {
+            res.status = 404;
+            res.set_content(json_error("meeting directory not found"), "application/json");
+            return;
+        }
+
+        try {
+            fs::path note;
+            {
+                std::lock_guard<std::mutex> lock(speaker_mu);
+                note = rerender_meeting_note(cfg, meeting_path);
+            }
+            meeting_index.refresh(dir_name);
+            res.set_content(R"({"ok":true,"note":")" + escape_json(note.string()) + R"("})",
+                            "application/json");
+        } catch (const RecmeetError& e) {
+            res.status = 409;
+            res.set_content(json_error(e.what()), "application/json");
+        } catch (const std::exception& e) {
+            res.status = 500;
+            res.set_content(json_error(e.what()), "application/json");
+        }
+    }));
 
     // Reprocess a meeting with num_speakers override
-    server.Post(R"(/api/meetings/([^/]+)/reprocess)", [&](const httplib::Request& req, httplib::Response& res) {
+    server.Post(R"(/api/meetings/([^/]+)/reprocess)", heavy([&](const httplib::Request& req, httplib::Response& res) {
         auto dir_name = req.matches[1].str();
         if (!is_safe_dirname(dir_name)) {
             res.status = 400;
@@ -773,6 +995,46 @@ int main(int argc, char* argv[]) {
             res.status = 502;
             res.set_content(json_error(std::string("daemon error: ") + e.what()), "application/json");
         }
+    }));
+
+    // Summary text as the daemon's postprocess job writes it, relayed from
+    // its summary.delta events as server-sent events (`event: delta`, data
+    // {"job_id","text"}); ends with `event: complete` when a job finishes.
+    server.Get("/api/summary/stream", [&](const httplib::Request&, httplib::Response& res) {
+        auto client = std::make_shared<IpcClient>();
+        if (!client->connect()) {
+            res.status = 502;
+            res.set_content(json_error("cannot connect to daemon — is it running?"), "application/json");
+            return;
+        }
+        res.set_header("Cache-Control", "no-cache");
+        res.set_chunked_content_provider("text/event-stream",
+            [client](size_t, httplib::DataSink& sink) {
+                bool finished = false;
+                client->set_event_callback([&](const IpcEvent& ev) {
+                    std::string msg;
+                    auto jit = ev.data.find("job_id");
+                    const int64_t job_id = jit != ev.data.end() ? json_val_as_int(jit->second) : 0;
+                    if (ev.event == "summary.delta") {
+                        msg = "event: delta\ndata: {\"job_id\":" + std::to_string(job_id) +
+                              ",\"text\":\"" + escape_json(json_val_as_string(ev.data.at("text"))) +
+                              "\"}\n\n";
+                    } else if (ev.event == "job.complete") {
+                        msg = "event: complete\ndata: {\"job_id\":" + std::to_string(job_id) +
+                              "}\n\n";
+                        finished = true;
+                    } else {
+                        return;
+                    }
+                    if (!sink.write(msg.data(), msg.size())) finished = true;
+                });
+                // Wake at least once a second to notice a closed browser tab.
+                client->read_events("", 1000);
+                if (!finished && !client->connected()) finished = true;
+                if (!finished && !sink.write(":\n\n", 3)) finished = true;
+                if (finished) sink.done();
+                return true;
+            });
     });
 
     // Serve meeting note as rendered HTML page
@@ -847,9 +1109,10 @@ int main(int argc, char* argv[]) {
         std::string content((std::istreambuf_iterator<char>(in)),
                              std::istreambuf_iterator<char>());
 
-        res.set_content("{\"path\":\"" + escape_json(note_path.filename().string()) +
-                        "\",\"content\":\"" + escape_json(content) + "\"}",
-                        "application/json");
+        const auto body = "{\"path\":\"" + escape_json(note_path.filename().string()) +
+                          "\",\"content\":\"" + escape_json(content) + "\"}";
+        if (not_modified(req, res, make_etag(body))) return;
+        res.set_content(body, "application/json");
     });
 
     // --- Static file serving (SPA) ---
@@ -871,6 +1134,10 @@ int main(int argc, char* argv[]) {
     fprintf(stderr, "  speaker db: %s\n", speaker_db_dir.string().c_str());
     fprintf(stderr, "  output dir: %s\n", output_dir.string().c_str());
 
+    meeting_index.start();
+    fprintf(stderr, "  meetings: %zu (%s)\n", meeting_index.list().size(),
+            meeting_index.inotify_active() ? "inotify" : "polling");
+
     if (!server.listen(cfg.web_bind, cfg.web_port)) {
         fprintf(stderr, "Failed to listen on %s:%d\n", cfg.web_bind.c_str(), cfg.web_port);
         return 1;
@@ -0,0 +1,63 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+// Where a benchmark result was measured, written beside the results by
+// BenchmarkResults (build/benchmark_results.json) and recmeet_microbench so
+// `recmeet-bench compare` can tell a regression from a change of host.
+
+#include "json_util.h"
+#include "sample_kernels.h"
+#include "version.h"
+
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <sys/utsname.h>
+#include <unistd.h>
+
+namespace recmeet {
+namespace test_helpers {
+
+/// The CPU model from /proc/cpuinfo ("model name" on x86, "Hardware" or
+/// the part number elsewhere); empty when it does not say.
+inline std::string bench_cpu_model() {
+    std::ifstream in("/proc/cpuinfo");
+    std::string line, fallback;
+    while (std::getline(in, line)) {
+        const auto colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        std::string key = line.substr(0, colon);
+        while (!key.empty() && (key.back() == ' ' || key.back() == '\t')) key.pop_back();
+        std::string val = line.substr(colon + 1);
+        while (!val.empty() && val.front() == ' ') val.erase(0, 1);
+        if (key == "model name") return val;
+        if (fallback.empty() && (key == "Hardware" || key == "CPU part")) fallback = val;
+    }
+    return fallback;
+}
+
+/// The "environment" object of a result file. `device` is the GPU the run
+/// used (active_device_signature()), empty for CPU-only benchmarks.
+inline std::string bench_environment_json(const std::string& device = "") {
+    char host[256] = {};
+    gethostname(host, sizeof(host) - 1);
+    struct utsname uts {};
+    uname(&uts);
+    auto field = [](const char* key, const std::string& val) {
+        return std::string("\"") + key + "\": \"" + json_escape(val) + "\"";
+    };
+    return "{" + field("git_sha", RECMEET_GIT_HASH) + ", " +
+           field("version", RECMEET_VERSION) + ", " +
+           field("host", host) + ", " +
+           field("kernel", uts.release) + ", " +
+           field("cpu", bench_cpu_model()) + ", " +
+           "\"cpu_threads\": " + std::to_string(std::thread::hardware_concurrency()) + ", " +
+           field("sample_kernels", sample_kernels().name) + ", " +
+           field("device", device.empty() ? "cpu" : device) + "}";
+}
+
+} // namespace test_helpers
+} // namespace recmeet
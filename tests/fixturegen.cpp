@@ -0,0 +1,81 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+//
+// recmeet_fixturegen — write a synthetic long-meeting WAV (long_fixture.h)
+// for runs that need one on disk, e.g. a 4-hour fixture for
+// `RECMEET_T2_1_FIXTURE=... make integration-t2-1`.
+//
+//   recmeet_fixturegen [--hours H] [--speakers N] [--overlap P]
+//                      [--pause-every MIN] [--seed S] [--source WAV]
+//                      [--rttm FILE] OUT.wav
+
+#include "long_fixture.h"
+#include "audio_file.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace recmeet;
+using namespace recmeet::test_helpers;
+
+namespace {
+
+void print_usage() {
+    fprintf(stderr,
+        "Usage: recmeet_fixturegen [OPTIONS] OUT.wav\n"
+        "\n"
+        "Write a synthetic multi-speaker meeting built from a short recording.\n"
+        "\n"
+        "Options:\n"
+        "  --hours H          Length (default: 1)\n"
+        "  --speakers N       Synthetic voices (default: 4)\n"
+        "  --overlap P        Chance a turn overlaps the last (default: 0.1)\n"
+        "  --pause-every MIN  A 20 s pause every MIN minutes; 0 = none (default: 15)\n"
+        "  --seed S           Schedule seed (default: 1)\n"
+        "  --source WAV       Source recording (default: assets/biden_trump_debate_2020.wav)\n"
+        "  --rttm FILE        Also write the turn schedule as RTTM\n"
+        "  -h, --help         Show this help\n");
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    LongFixtureSpec spec;
+    fs::path source = "assets/biden_trump_debate_2020.wav", rttm, out;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const bool has_val = i + 1 < argc;
+        if (arg == "-h" || arg == "--help") { print_usage(); return 0; }
+        else if (arg == "--hours" && has_val) spec.seconds = std::atof(argv[++i]) * 3600;
+        else if (arg == "--speakers" && has_val) spec.speakers = std::atoi(argv[++i]);
+        else if (arg == "--overlap" && has_val) spec.overlap_prob = std::atof(argv[++i]);
+        else if (arg == "--pause-every" && has_val) spec.pause_every_sec = std::atof(argv[++i]) * 60;
+        else if (arg == "--seed" && has_val) spec.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--source" && has_val) source = argv[++i];
+        else if (arg == "--rttm" && has_val) rttm = argv[++i];
+        else if (!arg.empty() && arg[0] != '-' && out.empty()) out = arg;
+        else {
+            fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            print_usage();
+            return 1;
+        }
+    }
+    if (out.empty() || spec.seconds <= 0 || spec.speakers < 1) {
+        print_usage();
+        return 1;
+    }
+
+    try {
+        const auto src = read_wav_float(source);
+        const auto fx = write_long_fixture_wav(out, src, spec);
+        if (!rttm.empty()) write_text_file_atomic(rttm, fixture_rttm(fx, out.stem().string()));
+        fprintf(stderr, "%s: %.2f h, %d speakers, %zu turns, %.0f s overlapped, %.0f s silent\n",
+                out.c_str(), spec.seconds / 3600, spec.speakers, fx.turns.size(),
+                fx.overlap_sec, fx.silence_sec);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "Error: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,236 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+// Synthetic long-meeting fixtures.
+//
+// The memory-containment claims (chunked diarization, spooled audio) are
+// about 4-hour meetings, and the only real long fixture is 60 minutes. This
+// builds meetings of any length from a short recording (the debate in
+// assets/): the source is cut into utterances at its pauses, and a turn
+// schedule replays them as `speakers` synthetic voices, each a fixed
+// resampling rate and gain, with controlled gaps, overlapping turns and
+// long pauses. The result streams to a sink block by block, so an 8-hour
+// fixture never has to exist in memory, and the schedule is returned as
+// ground truth.
+//
+// A synthetic speaker says utterances of every source voice; its identity
+// is the transform. That is enough to exercise clustering at scale, which
+// is what the scaling suite (test_scaling.cpp) measures — not diarization
+// accuracy.
+
+#include "audio_spool.h"
+#include "util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace recmeet {
+namespace test_helpers {
+
+struct LongFixtureSpec {
+    double seconds = 3600;
+    int speakers = 4;
+    double overlap_prob = 0.1;     ///< chance a turn starts before the last one ends
+    double max_overlap_sec = 1.5;  ///< how far it may start before
+    double min_gap_sec = 0.15;     ///< silence between turns that do not overlap
+    double max_gap_sec = 1.2;
+    double pause_every_sec = 900;  ///< a long pause this often; 0 = none
+    double pause_sec = 20;
+    uint32_t seed = 1;
+};
+
+struct FixtureTurn {
+    double start;  // seconds
+    double end;
+    int speaker;
+};
+
+struct LongFixture {
+    std::vector<FixtureTurn> turns;
+    size_t samples = 0;
+    double overlap_sec = 0;  ///< total time two turns overlap
+    double silence_sec = 0;  ///< total time no turn is active
+};
+
+/// [begin, end) sample ranges of `source` that are speech: runs of 20 ms
+/// frames above a tenth of the mean frame RMS, split where the quiet lasts
+/// 300 ms or more, kept when at least 0.8 s and cut to at most 12 s.
+inline std::vector<std::pair<size_t, size_t>> split_utterances(const std::vector<float>& source) {
+    constexpr size_t FRAME = SAMPLE_RATE / 50;
+    constexpr size_t MIN_LEN = SAMPLE_RATE * 8 / 10, MAX_LEN = SAMPLE_RATE * 12;
+    constexpr size_t QUIET_FRAMES = 15;
+    const size_t n_frames = source.size() / FRAME;
+    std::vector<float> rms(n_frames);
+    double mean = 0;
+    for (size_t f = 0; f < n_frames; ++f) {
+        double sum = 0;
+        for (size_t i = f * FRAME; i < (f + 1) * FRAME; ++i) sum += double(source[i]) * source[i];
+        rms[f] = static_cast<float>(std::sqrt(sum / FRAME));
+        mean += rms[f];
+    }
+    mean = n_frames ? mean / n_frames : 0;
+    const float threshold = static_cast<float>(std::max(1e-4, mean / 10));
+
+    std::vector<std::pair<size_t, size_t>> out;
+    auto emit = [&](size_t b, size_t e) {
+        for (; e - b >= MIN_LEN; b += MAX_LEN) {
+            out.push_back({b, std::min(e, b + MAX_LEN)});
+            if (e - b <= MAX_LEN) break;
+        }
+    };
+    size_t start = SIZE_MAX, last_voiced = 0, quiet = 0;
+    for (size_t f = 0; f < n_frames; ++f) {
+        if (rms[f] >= threshold) {
+            if (start == SIZE_MAX) start = f;
+            last_voiced = f;
+            quiet = 0;
+        } else if (start != SIZE_MAX && ++quiet >= QUIET_FRAMES) {
+            emit(start * FRAME, (last_voiced + 1) * FRAME);
+            start = SIZE_MAX;
+        }
+    }
+    if (start != SIZE_MAX) emit(start * FRAME, (last_voiced + 1) * FRAME);
+    return out;
+}
+
+/// Generate `spec.seconds` of meeting from `source` (16 kHz mono float),
+/// handing it to `sink` in order, in blocks. Throws RecmeetError when the
+/// source has no usable speech.
+inline LongFixture generate_long_fixture(const std::vector<float>& source,
+                                         const LongFixtureSpec& spec,
+                                         const std::function<void(const float*, size_t)>& sink) {
+    const auto utterances = split_utterances(source);
+    if (utterances.empty()) throw RecmeetError("Fixture source has no speech");
+    const int speakers = std::max(1, spec.speakers);
+
+    // Voice k reads the source at rate[k]: above 1 is higher and faster.
+    std::vector<double> rate(speakers), gain(speakers);
+    for (int k = 0; k < speakers; ++k) {
+        rate[k] = speakers == 1 ? 1.0 : 0.82 + 0.36 * k / (speakers - 1);
+        gain[k] = 0.9 - 0.15 * (k % 3);
+    }
+
+    std::mt19937 rng(spec.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<size_t> pick(0, utterances.size() - 1);
+    std::uniform_int_distribution<int> parts(1, 3);
+
+    LongFixture fx;
+    fx.samples = static_cast<size_t>(spec.seconds * SAMPLE_RATE);
+
+    // Mix accumulator over [origin, origin + acc.size()). Turn starts only
+    // move forward, so everything before the next start is final.
+    std::vector<float> acc;
+    size_t origin = 0;
+    auto flush = [&](size_t upto) {
+        upto = std::min(upto, fx.samples);
+        if (upto <= origin) return;
+        const size_t n = upto - origin;
+        if (acc.size() < n) acc.resize(n, 0.0f);
+        for (size_t i = 0; i < n; ++i) acc[i] = std::clamp(acc[i], -1.0f, 1.0f);
+        for (size_t i = 0; i < n; i += SAMPLE_RATE)
+            sink(acc.data() + i, std::min<size_t>(SAMPLE_RATE, n - i));
+        acc.erase(acc.begin(), acc.begin() + static_cast<std::ptrdiff_t>(n));
+        origin = upto;
+    };
+
+    int speaker = 0;
+    double t = 0, next_pause = spec.pause_every_sec > 0 ? spec.pause_every_sec : 1e300;
+    double prev_start = 0, prev_end = 0;
+    while (t < spec.seconds) {
+        if (t >= next_pause) {
+            t += spec.pause_sec;
+            next_pause += spec.pause_every_sec;
+            continue;
+        }
+        // Render the turn: 1-3 utterances, 100 ms apart, in this voice.
+        std::vector<float> turn;
+        for (int p = parts(rng); p > 0; --p) {
+            const auto [b, e] = utterances[pick(rng)];
+            const size_t len = static_cast<size_t>((e - b - 1) / rate[speaker]);
+            for (size_t i = 0; i < len; ++i) {
+                const double pos = b + i * rate[speaker];
+                const size_t j = static_cast<size_t>(pos);
+                const float frac = static_cast<float>(pos - j);
+                turn.push_back(static_cast<float>(gain[speaker]) *
+                               (source[j] * (1 - frac) + source[j + 1] * frac));
+            }
+            if (p > 1) turn.insert(turn.end(), SAMPLE_RATE / 10, 0.0f);
+        }
+
+        const size_t start = static_cast<size_t>(t * SAMPLE_RATE);
+        flush(start);
+        if (acc.size() < start - origin + turn.size()) acc.resize(start - origin + turn.size(), 0.0f);
+        for (size_t i = 0; i < turn.size(); ++i) acc[start - origin + i] += turn[i];
+
+        const double end = std::min(spec.seconds, t + double(turn.size()) / SAMPLE_RATE);
+        fx.turns.push_back({t, end, speaker});
+        if (t < prev_end) fx.overlap_sec += std::min(prev_end, end) - t;
+        else fx.silence_sec += t - prev_end;
+        prev_start = t;
+        prev_end = std::max(prev_end, end);
+
+        // The next turn: another voice, after a gap or — never before this
+        // turn's midpoint, so starts stay ordered — overlapping its end.
+        if (speakers > 1)
+            speaker = (speaker + 1 + static_cast<int>(unit(rng) * (speakers - 1))) % speakers;
+        if (unit(rng) < spec.overlap_prob) {
+            t = std::max((prev_start + end) / 2, end - unit(rng) * spec.max_overlap_sec);
+        } else {
+            t = end + spec.min_gap_sec + unit(rng) * (spec.max_gap_sec - spec.min_gap_sec);
+        }
+    }
+    fx.silence_sec += std::max(0.0, spec.seconds - prev_end);
+    flush(fx.samples);  // pads with silence when the schedule ended in a pause
+    return fx;
+}
+
+/// generate_long_fixture() into a 16-bit WAV at `path`, written as it is
+/// generated. Throws RecmeetError when the file cannot be written.
+inline LongFixture write_long_fixture_wav(const fs::path& path, const std::vector<float>& source,
+                                          const LongFixtureSpec& spec) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) throw RecmeetError("Cannot create fixture: " + path.string());
+    uint8_t header[SPOOL_WAV_HEADER_BYTES] = {};
+    std::fwrite(header, 1, sizeof(header), f);
+    std::vector<int16_t> pcm;
+    LongFixture fx;
+    try {
+        fx = generate_long_fixture(source, spec, [&](const float* s, size_t n) {
+            pcm.resize(n);
+            for (size_t i = 0; i < n; ++i) pcm[i] = static_cast<int16_t>(std::lrint(s[i] * 32767.0f));
+            if (std::fwrite(pcm.data(), sizeof(int16_t), n, f) != n)
+                throw RecmeetError("Cannot write fixture: " + path.string());
+        });
+    } catch (...) {
+        std::fclose(f);
+        throw;
+    }
+    build_spool_wav_header(header, uint64_t(fx.samples) * sizeof(int16_t));
+    const bool ok = std::fseek(f, 0, SEEK_SET) == 0 &&
+                    std::fwrite(header, 1, sizeof(header), f) == sizeof(header);
+    if (std::fclose(f) != 0 || !ok) throw RecmeetError("Cannot write fixture: " + path.string());
+    return fx;
+}
+
+/// The turns as RTTM, the usual diarization reference format.
+inline std::string fixture_rttm(const LongFixture& fx, const std::string& file_id) {
+    std::string out;
+    char line[160];
+    for (const auto& t : fx.turns) {
+        std::snprintf(line, sizeof(line), "SPEAKER %s 1 %.3f %.3f <NA> <NA> spk%02d <NA> <NA>\n",
+                      file_id.c_str(), t.start, t.end - t.start, t.speaker);
+        out += line;
+    }
+    return out;
+}
+
+} // namespace test_helpers
+} // namespace recmeet
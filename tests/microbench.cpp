@@ -0,0 +1,564 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+//
+// recmeet_microbench — timings of the pure-C++ hot functions on synthetic
+// inputs sized like a 1-minute, 1-hour and 4-hour meeting. Unlike the
+// [benchmark] cases in test_benchmark.cpp it needs no models or audio, so
+// it runs anywhere and its numbers compare across commits and hosts.
+//
+//   recmeet_microbench [--scale 1m|1h|4h]... [--filter SUBSTR]
+//                      [--samples N] [--min-sample-ms MS] [--json FILE]
+//
+// Each case is run once to warm up and to size a sample: enough back-to-back
+// iterations to take --min-sample-ms. Then --samples samples are timed and
+// summarised by their median and median absolute deviation, which a stray
+// preemption moves far less than the mean. Inputs come from a fixed seed,
+// so every run times identical work. The JSON results carry the git SHA
+// and host (bench_env.h) for `recmeet-bench compare`.
+
+#include "audio_mixer.h"
+#include "bench_env.h"
+#include "caption_format.h"
+#include "diarize.h"
+#include "ipc_protocol.h"
+#include "sample_kernels.h"
+#include "speaker_id.h"
+#include "speaker_store.h"
+#include "util.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace recmeet;
+
+namespace {
+
+constexpr uint32_t SEED = 20260314;
+constexpr int EMBEDDING_DIM = 192;
+
+struct Scale {
+    const char* name;
+    double seconds;
+    int speakers_in_db;  ///< speaker-database size the same scale stands for
+};
+
+const Scale SCALES[] = {
+    {"1m", 60, 8},
+    {"1h", 3600, 64},
+    {"4h", 4 * 3600, 256},
+};
+
+/// A prepared case: `run` does the timed work once and returns a value
+/// that depends on all of it, so the optimiser cannot drop any.
+struct Prepared {
+    std::function<size_t()> run;
+    size_t items = 0;
+    const char* unit = "items";
+};
+
+struct Case {
+    const char* name;
+    /// Empty `run` = not available at this scale or in this build.
+    std::function<Prepared(const Scale&, std::mt19937&)> prepare;
+};
+
+struct Result {
+    std::string name;
+    std::string scale;
+    std::string unit;
+    size_t items = 0;
+    size_t iterations = 0;  ///< per sample
+    std::vector<double> ns;  ///< per iteration, one entry per sample
+    double median = 0, mad = 0, min = 0, max = 0, mean = 0;
+};
+
+volatile size_t g_sink = 0;
+
+// --- Synthetic meeting data -------------------------------------------------
+
+std::vector<TranscriptSegment> make_transcript(double seconds, std::mt19937& rng) {
+    std::uniform_real_distribution<double> len(1.5, 6.5);
+    std::vector<TranscriptSegment> out;
+    for (double t = 0; t < seconds;) {
+        double end = std::min(seconds, t + len(rng));
+        out.push_back({t, end, "and so the next item on the agenda is the budget review", 0, 0});
+        t = end + 0.2;
+    }
+    return out;
+}
+
+DiarizeResult make_diarization(double seconds, int speakers, std::mt19937& rng) {
+    std::uniform_real_distribution<double> len(0.8, 12.0);
+    std::uniform_int_distribution<int> who(0, speakers - 1);
+    DiarizeResult d;
+    for (double t = 0; t < seconds;) {
+        double end = std::min(seconds, t + len(rng));
+        d.segments.push_back({t, end, who(rng)});
+        t = end;
+    }
+    d.num_speakers = speakers;
+    return d;
+}
+
+std::vector<float> unit_vector(std::mt19937& rng) {
+    std::normal_distribution<float> g(0.0f, 1.0f);
+    std::vector<float> v(EMBEDDING_DIM);
+    double norm = 0;
+    for (auto& x : v) {
+        x = g(rng);
+        norm += double(x) * x;
+    }
+    for (auto& x : v) x = static_cast<float>(x / std::sqrt(norm));
+    return v;
+}
+
+/// `base` plus Gaussian noise of `sigma` per component: another embedding
+/// of the same voice.
+std::vector<float> near(const std::vector<float>& base, float sigma, std::mt19937& rng) {
+    std::normal_distribution<float> g(0.0f, sigma);
+    std::vector<float> v = base;
+    for (auto& x : v) x += g(rng);
+    return v;
+}
+
+std::vector<int16_t> make_pcm(size_t n, std::mt19937& rng) {
+    std::uniform_int_distribution<int> s(-12000, 12000);
+    std::vector<int16_t> out(n);
+    for (auto& x : out) x = static_cast<int16_t>(s(rng));
+    return out;
+}
+
+size_t scale_samples(const Scale& s) {
+    return static_cast<size_t>(s.seconds * SAMPLE_RATE);
+}
+
+// --- Cases ------------------------------------------------------------------
+
+Prepared prep_merge_speakers(const Scale& s, std::mt19937& rng) {
+    auto transcript = std::make_shared<std::vector<TranscriptSegment>>(make_transcript(s.seconds, rng));
+    auto diar = std::make_shared<DiarizeResult>(make_diarization(s.seconds, 5, rng));
+    std::map<int, std::string> names = {{0, "Alice"}, {2, "Bob"}};
+    return {[=] { return merge_speakers(*transcript, *diar, names).size(); },
+            transcript->size(), "segments"};
+}
+
+#if RECMEET_USE_SHERPA
+Prepared prep_stitch_chunks(const Scale& s, std::mt19937& rng) {
+    DiarizeChunkConfig cfg;
+    auto extents = std::make_shared<std::vector<ChunkExtents>>(
+        plan_chunk_extents(scale_samples(s), cfg));
+    std::vector<std::vector<float>> voices;
+    for (int i = 0; i < 8; ++i) voices.push_back(unit_vector(rng));
+
+    auto results = std::make_shared<std::vector<DiarizeResult>>();
+    auto centroids = std::make_shared<std::vector<std::map<int, std::vector<float>>>>();
+    size_t segments = 0;
+    std::uniform_int_distribution<int> voice(0, static_cast<int>(voices.size()) - 1);
+    for (const auto& ext : *extents) {
+        const double len = double(ext.pcm_end_samples - ext.pcm_start_samples) / SAMPLE_RATE;
+        results->push_back(make_diarization(len, 5, rng));
+        segments += results->back().segments.size();
+        std::map<int, std::vector<float>> c;
+        for (int spk = 0; spk < 5; ++spk) c[spk] = near(voices[voice(rng)], 0.02f, rng);
+        centroids->push_back(std::move(c));
+    }
+    return {[=] {
+                return stitch_chunks(*results, *centroids, *extents, cfg, 0, false)
+                    .diar.segments.size();
+            },
+            segments, "segments"};
+}
+
+Prepared prep_apply_collapse(const Scale& s, std::mt19937& rng) {
+    // As many pre-merge speakers as a stitch of this length tends to leave,
+    // half of them a second registry entry for someone already present.
+    const int n_globals = s.seconds <= 60 ? 6 : s.seconds <= 3600 ? 24 : 48;
+    auto diar = std::make_shared<DiarizeResult>(make_diarization(s.seconds, n_globals, rng));
+    auto globals = std::make_shared<std::vector<GlobalEntry>>();
+    std::vector<float> voice;
+    for (int i = 0; i < n_globals; ++i) {
+        if (i % 2 == 0) voice = unit_vector(rng);
+        globals->push_back({i, near(voice, 0.03f, rng), 16000L * (10 + i)});
+    }
+    DiarizeChunkConfig cfg;
+    // apply_collapse works in place, so each iteration starts from a copy;
+    // the copy is a small part of the time.
+    return {[=] {
+                DiarizeResult d = *diar;
+                std::vector<GlobalEntry> g = *globals;
+                return static_cast<size_t>(
+                    apply_collapse(d, g, 0, cfg.collapse_threshold, false).num_speakers);
+            },
+            diar->segments.size(), "segments"};
+}
+#endif
+
+Prepared prep_mix_audio(const Scale& s, std::mt19937& rng) {
+    // A whole 4-hour mix needs 1.4 GB; recordings that long go through
+    // mix_audio_block (mix_audio_block_streamed below).
+    if (s.seconds > 3600) return {};
+    const size_t n = scale_samples(s);
+    auto a = std::make_shared<std::vector<int16_t>>(make_pcm(n, rng));
+    auto b = std::make_shared<std::vector<int16_t>>(make_pcm(n - SAMPLE_RATE / 2, rng));
+    return {[=] { return static_cast<size_t>(mix_audio(*a, *b)[n / 2]); }, n, "samples"};
+}
+
+Prepared prep_mix_audio_block(const Scale& s, std::mt19937& rng) {
+    // One minute of input mixed block by block over the whole length, as
+    // StreamingMixer does.
+    const size_t n = scale_samples(s);
+    const size_t block = 60 * SAMPLE_RATE;
+    auto a = std::make_shared<std::vector<int16_t>>(make_pcm(block, rng));
+    auto b = std::make_shared<std::vector<int16_t>>(make_pcm(block, rng));
+    auto out = std::make_shared<std::vector<int16_t>>(block);
+    return {[=] {
+                size_t acc = 0;
+                for (size_t done = 0; done < n; done += block) {
+                    const size_t len = std::min(block, n - done);
+                    mix_audio_block(a->data(), len, b->data(), len, out->data());
+                    acc += static_cast<uint16_t>((*out)[len - 1]);
+                }
+                return acc;
+            },
+            n, "samples"};
+}
+
+std::vector<IpcEvent> make_events(const Scale& s, std::mt19937& rng) {
+    // One caption partial per 100 ms, with a job progress event per second.
+    std::uniform_int_distribution<int> pct(0, 100);
+    const size_t n = static_cast<size_t>(s.seconds * 10);
+    std::vector<IpcEvent> out;
+    out.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        IpcEvent ev;
+        if (i % 10 == 9) {
+            ev.event = "job.progress";
+            ev.data["job_id"] = static_cast<int64_t>(42);
+            ev.data["phase"] = std::string("transcribing");
+            ev.data["percent"] = static_cast<int64_t>(pct(rng));
+        } else {
+            ev.event = "caption";
+            ev.data["text"] = std::string("so the next item on the agenda is \"the budget\"");
+            ev.data["is_partial"] = i % 20 != 0;
+            ev.data["source"] = std::string(i % 2 ? "mic" : "monitor");
+            ev.data["t0_ms"] = static_cast<int64_t>(i * 100);
+            ev.data["confidence"] = 0.87;
+        }
+        out.push_back(std::move(ev));
+    }
+    return out;
+}
+
+Prepared prep_ipc_serialize(const Scale& s, std::mt19937& rng) {
+    auto events = std::make_shared<std::vector<IpcEvent>>(make_events(s, rng));
+    return {[=] {
+                size_t bytes = 0;
+                for (const auto& ev : *events) bytes += serialize(ev).size();
+                return bytes;
+            },
+            events->size(), "messages"};
+}
+
+Prepared prep_ipc_parse(const Scale& s, std::mt19937& rng) {
+    auto lines = std::make_shared<std::vector<std::string>>();
+    for (const auto& ev : make_events(s, rng)) lines->push_back(serialize(ev));
+    return {[=] {
+                size_t fields = 0;
+                IpcMessage msg;
+                for (const auto& line : *lines)
+                    if (parse_ipc_message(line, msg)) fields += msg.event.data.size();
+                return fields;
+            },
+            lines->size(), "messages"};
+}
+
+std::vector<SpeakerProfile> make_profiles(int count, std::mt19937& rng) {
+    std::vector<SpeakerProfile> out;
+    for (int i = 0; i < count; ++i) {
+        SpeakerProfile p;
+        char name[32];
+        snprintf(name, sizeof(name), "Speaker %04d", i);
+        p.name = name;
+        p.created = p.updated = "2026-03-14T09:00:00Z";
+        const auto voice = unit_vector(rng);
+        for (int e = 0; e < 5; ++e) p.embeddings.push_back(near(voice, 0.02f, rng));
+        out.push_back(std::move(p));
+    }
+    return out;
+}
+
+fs::path bench_dir(const char* what, const Scale& s) {
+    fs::path dir = fs::temp_directory_path() /
+        ("recmeet_microbench_" + std::to_string(getpid())) / (std::string(what) + "_" + s.name);
+    fs::create_directories(dir);
+    return dir;
+}
+
+Prepared prep_speaker_store_write(const Scale& s, std::mt19937& rng) {
+    auto profiles = std::make_shared<std::vector<SpeakerProfile>>(
+        make_profiles(s.speakers_in_db, rng));
+    const fs::path path = bench_dir("store_write", s) / SPEAKER_STORE_FILE;
+    return {[=] {
+                write_speaker_store(path, *profiles);
+                return static_cast<size_t>(fs::file_size(path));
+            },
+            profiles->size(), "profiles"};
+}
+
+Prepared prep_load_speaker_db(const Scale& s, std::mt19937& rng) {
+    const fs::path dir = bench_dir("load_db", s);
+    write_speaker_store(dir / SPEAKER_STORE_FILE, make_profiles(s.speakers_in_db, rng));
+    return {[=] { return load_speaker_db(dir).size(); },
+            static_cast<size_t>(s.speakers_in_db), "profiles"};
+}
+
+Prepared prep_ring_drain(const Scale& s, std::mt19937& rng) {
+    // The caption engine's ring (2 s at 16 kHz) fed 100 ms at a time and
+    // drained into float at the same pace, crossing the wrap regularly.
+    constexpr size_t RING = 1 << 15, CHUNK = SAMPLE_RATE / 10;
+    auto ring = std::make_shared<std::vector<int16_t>>(make_pcm(RING, rng));
+    auto out = std::make_shared<std::vector<float>>(CHUNK);
+    const size_t n = scale_samples(s);
+    return {[=] {
+                size_t pos = 0;
+                float acc = 0;
+                for (size_t done = 0; done < n; done += CHUNK) {
+                    ring_s16_to_f32(ring->data(), RING - 1, pos, out->data(), CHUNK);
+                    pos += CHUNK;
+                    acc += (*out)[CHUNK - 1];
+                }
+                return static_cast<size_t>(acc * 1000);
+            },
+            n, "samples"};
+}
+
+Prepared prep_caption_render(const Scale& s, std::mt19937&) {
+    // A partial per 100 ms, finalised every 3 s.
+    const size_t n = static_cast<size_t>(s.seconds * 10);
+    return {[=] {
+                CaptionRenderState st;
+                const auto t0 = CaptionRenderState::Clock::now();
+                std::string text;
+                for (size_t i = 0; i < n; ++i) {
+                    if (i % 30 == 0) text.clear();
+                    text += " word";
+                    st.update(text, i % 30 != 29, true, t0 + std::chrono::milliseconds(i * 100));
+                }
+                return st.line_count();
+            },
+            n, "updates"};
+}
+
+const Case CASES[] = {
+    {"merge_speakers", prep_merge_speakers},
+#if RECMEET_USE_SHERPA
+    {"stitch_chunks", prep_stitch_chunks},
+    {"apply_collapse", prep_apply_collapse},
+#endif
+    {"mix_audio", prep_mix_audio},
+    {"mix_audio_block_streamed", prep_mix_audio_block},
+    {"ipc_serialize_event", prep_ipc_serialize},
+    {"ipc_parse_message", prep_ipc_parse},
+    {"write_speaker_store", prep_speaker_store_write},
+    {"load_speaker_db", prep_load_speaker_db},
+    {"caption_ring_drain", prep_ring_drain},
+    {"caption_render_update", prep_caption_render},
+};
+
+// --- Timing -----------------------------------------------------------------
+
+double time_ns(const std::function<size_t()>& run, size_t iterations) {
+    const auto start = std::chrono::steady_clock::now();
+    size_t acc = 0;
+    for (size_t i = 0; i < iterations; ++i) acc += run();
+    const auto end = std::chrono::steady_clock::now();
+    g_sink = g_sink + acc;
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+double median_of(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    const size_t n = v.size();
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+Result measure(const char* name, const Scale& s, const Prepared& p, int samples,
+               double min_sample_ns) {
+    Result r;
+    r.name = name;
+    r.scale = s.name;
+    r.unit = p.unit;
+    r.items = p.items;
+
+    const double warm = std::max(1.0, time_ns(p.run, 1));
+    r.iterations = static_cast<size_t>(std::max(1.0, std::ceil(min_sample_ns / warm)));
+    for (int i = 0; i < samples; ++i)
+        r.ns.push_back(time_ns(p.run, r.iterations) / static_cast<double>(r.iterations));
+
+    r.median = median_of(r.ns);
+    std::vector<double> dev;
+    for (double x : r.ns) dev.push_back(std::fabs(x - r.median));
+    r.mad = median_of(dev);
+    r.min = *std::min_element(r.ns.begin(), r.ns.end());
+    r.max = *std::max_element(r.ns.begin(), r.ns.end());
+    double sum = 0;
+    for (double x : r.ns) sum += x;
+    r.mean = sum / static_cast<double>(r.ns.size());
+    return r;
+}
+
+std::string format_duration(double ns) {
+    char buf[32];
+    if (ns >= 1e9) snprintf(buf, sizeof(buf), "%.3f s", ns / 1e9);
+    else if (ns >= 1e6) snprintf(buf, sizeof(buf), "%.3f ms", ns / 1e6);
+    else if (ns >= 1e3) snprintf(buf, sizeof(buf), "%.3f us", ns / 1e3);
+    else snprintf(buf, sizeof(buf), "%.0f ns", ns);
+    return buf;
+}
+
+std::string to_json(const std::vector<Result>& results, int samples, double min_sample_ms) {
+    const std::time_t now = std::time(nullptr);
+    std::tm tm{};
+    localtime_r(&now, &tm);
+    char ts[32];
+    strftime(ts, sizeof(ts), "%Y-%m-%dT%H:%M:%S", &tm);
+    std::string out = "{\"kind\":\"microbench\",\"timestamp\":\"" + std::string(ts) +
+                      "\",\"environment\":" +
+                      test_helpers::bench_environment_json() +
+                      ",\"samples\":" + std::to_string(samples) +
+           ",\"min_sample_ms\":" + serialize_json_val(min_sample_ms) + ",\"results\":[";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        JsonMap m;
+        m["name"] = r.name;
+        m["scale"] = r.scale;
+        m["unit"] = r.unit;
+        m["items"] = static_cast<int64_t>(r.items);
+        m["iterations"] = static_cast<int64_t>(r.iterations);
+        m["median_ns"] = r.median;
+        m["mad_ns"] = r.mad;
+        m["min_ns"] = r.min;
+        m["max_ns"] = r.max;
+        m["mean_ns"] = r.mean;
+        m["items_per_sec"] = r.median > 0 ? r.items * 1e9 / r.median : 0.0;
+        if (i) out += ",";
+        out += "\n" + serialize_json_map(m);
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+void print_usage() {
+    fprintf(stderr,
+        "Usage: recmeet_microbench [OPTIONS]\n"
+        "\n"
+        "Time recmeet's pure-C++ hot functions on synthetic 1-minute, 1-hour\n"
+        "and 4-hour inputs.\n"
+        "\n"
+        "Options:\n"
+        "  --scale S          Only scale S (1m, 1h, 4h); repeatable (default: all)\n"
+        "  --filter SUBSTR    Only cases whose name contains SUBSTR\n"
+        "  --samples N        Timed samples per case (default: 11)\n"
+        "  --min-sample-ms MS Minimum length of one sample (default: 50)\n"
+        "  --json FILE        Also write the results as JSON to FILE (- = stdout)\n"
+        "  --list             List the cases and exit\n"
+        "  -h, --help         Show this help\n");
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> scales, filters;
+    int samples = 11;
+    double min_sample_ms = 50;
+    std::string json_path;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") { print_usage(); return 0; }
+        if (arg == "--list") {
+            for (const auto& c : CASES) printf("%s\n", c.name);
+            return 0;
+        }
+        if (arg == "--scale" && i + 1 < argc) { scales.push_back(argv[++i]); continue; }
+        if (arg == "--filter" && i + 1 < argc) { filters.push_back(argv[++i]); continue; }
+        if (arg == "--samples" && i + 1 < argc) { samples = std::max(1, std::atoi(argv[++i])); continue; }
+        if (arg == "--min-sample-ms" && i + 1 < argc) { min_sample_ms = std::max(0.0, std::atof(argv[++i])); continue; }
+        if (arg == "--json" && i + 1 < argc) { json_path = argv[++i]; continue; }
+        fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+        print_usage();
+        return 1;
+    }
+    for (const auto& s : scales) {
+        if (std::none_of(std::begin(SCALES), std::end(SCALES),
+                         [&](const Scale& sc) { return s == sc.name; })) {
+            fprintf(stderr, "Unknown scale: %s (use 1m, 1h or 4h)\n", s.c_str());
+            return 1;
+        }
+    }
+
+    FILE* text = json_path == "-" ? stderr : stdout;
+    fprintf(text, "recmeet_microbench: %d samples of >= %.0f ms, kernels %s\n\n",
+            samples, min_sample_ms, sample_kernels().name);
+    fprintf(text, "%-26s %-5s %12s %12s %7s %16s\n",
+            "case", "scale", "median", "mad", "mad%", "throughput");
+
+    std::vector<Result> results;
+    int rc = 0;
+    for (const auto& c : CASES) {
+        if (!filters.empty() &&
+            std::none_of(filters.begin(), filters.end(), [&](const std::string& f) {
+                return std::strstr(c.name, f.c_str()) != nullptr;
+            }))
+            continue;
+        for (const auto& s : SCALES) {
+            if (!scales.empty() && std::find(scales.begin(), scales.end(), s.name) == scales.end())
+                continue;
+            std::mt19937 rng(SEED);
+            Prepared p;
+            try {
+                p = c.prepare(s, rng);
+                if (!p.run) continue;
+                Result r = measure(c.name, s, p, samples, min_sample_ms * 1e6);
+                fprintf(text, "%-26s %-5s %12s %12s %6.1f%% %10.3g %s/s\n", c.name, s.name,
+                        format_duration(r.median).c_str(), format_duration(r.mad).c_str(),
+                        r.median > 0 ? 100.0 * r.mad / r.median : 0.0,
+                        r.median > 0 ? r.items * 1e9 / r.median : 0.0, r.unit.c_str());
+                results.push_back(std::move(r));
+            } catch (const std::exception& e) {
+                fprintf(stderr, "%s %s: %s\n", c.name, s.name, e.what());
+                rc = 1;
+            }
+        }
+    }
+
+    std::error_code ec;
+    fs::remove_all(fs::temp_directory_path() / ("recmeet_microbench_" + std::to_string(getpid())), ec);
+
+    if (!json_path.empty()) {
+        const std::string json = to_json(results, samples, min_sample_ms);
+        if (json_path == "-") {
+            fputs(json.c_str(), stdout);
+        } else {
+            try {
+                write_text_file_atomic(json_path, json);
+            } catch (const std::exception& e) {
+                fprintf(stderr, "Cannot write %s: %s\n", json_path.c_str(), e.what());
+                return 1;
+            }
+        }
+    }
+    return rc;
+}
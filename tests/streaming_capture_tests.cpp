@@ -15,6 +15,7 @@
 #include "audio_capture.h"
 #include "audio_file.h"
 #include "audio_monitor.h"
+#include "capture_replay.h"
 #include "test_tmpdir.h"
 #include "util.h"
 
@@ -326,3 +327,167 @@ TEST_CASE("drain() returns full buffer regardless of callback state (no sample l
     expected.insert(expected.end(), chunk_d.begin(), chunk_d.end());
     CHECK(drained == expected);
 }
+
+// ---------------------------------------------------------------------------
+// 7. RT ring overflow: frames past the ring's depth are dropped (never
+//    blocked on) and counted; the streaming callback still sees every chunk.
+// ---------------------------------------------------------------------------
+
+TEST_CASE("PipeWireCapture: RT ring overflow drops and counts frames",
+          "[streaming-capture]") {
+    PipeWireCapture cap("test-source");
+    CaptureSink sink;
+    cap.set_audio_callback(&on_chunk, &sink);
+
+    // No pump thread runs without start(), so nothing drains the ring
+    // until drain() below — feed well past its ~8 s depth.
+    constexpr std::size_t CHUNK_N = 1024;
+    constexpr int N_CHUNKS = 160;  // 163840 samples > 131072-sample ring
+    auto chunk = make_chunk(CHUNK_N, 0);
+    for (int i = 0; i < N_CHUNKS; ++i)
+        cap._inject_for_test(chunk.data(), chunk.size());
+
+    auto st = cap.stats();
+    CHECK(st.callbacks == N_CHUNKS);
+    CHECK(sink.chunks.load() == N_CHUNKS);
+
+    auto drained = cap.drain();
+    CHECK(drained.size() + st.dropped_frames == CHUNK_N * N_CHUNKS);
+    CHECK(st.dropped_frames > 0);
+
+    // Once drained, the ring accepts audio again without further drops.
+    cap._inject_for_test(chunk.data(), chunk.size());
+    CHECK(cap.stats().dropped_frames == st.dropped_frames);
+    CHECK(cap.drain().size() == CHUNK_N);
+}
+
+// ---------------------------------------------------------------------------
+// 8. Tap: sees every batch sample on the consumer side without taking any
+//    from drain().
+// ---------------------------------------------------------------------------
+
+TEST_CASE("set_tap observes the batch stream without consuming it",
+          "[streaming-capture]") {
+    auto chunk = make_chunk(160, 0);
+
+    PipeWireCapture pw("test-source");
+    CaptureSink pw_tap;
+    pw.set_tap(&on_chunk, &pw_tap);
+    pw._inject_for_test(chunk.data(), chunk.size());
+    pw._inject_for_test(chunk.data(), chunk.size());
+    // The tap runs where the ring is drained, not on the RT path.
+    CHECK(pw_tap.total_samples.load() == 0);
+    CHECK(pw.drain().size() == 2 * chunk.size());
+    CHECK(pw_tap.total_samples.load() == 2 * chunk.size());
+
+    PulseMonitorCapture pa("test.monitor");
+    CaptureSink pa_tap;
+    pa.set_tap(&on_chunk, &pa_tap);
+    pa._inject_for_test(chunk.data(), chunk.size());
+    CHECK(pa_tap.chunks.load() == 1);
+    CHECK(pa.drain() == chunk);
+}
+
+// ---------------------------------------------------------------------------
+// 9. Replay sources: `replay:<wav>` feeds the WAV through the same delivery
+//    path as a device, on a jitter profile's schedule.
+// ---------------------------------------------------------------------------
+
+TEST_CASE("parse_replay_source: path, speed and jitter profile", "[streaming-capture]") {
+    CHECK(is_replay_source("replay:/m/a.wav"));
+    CHECK_FALSE(is_replay_source("alsa_input.usb-mic"));
+
+    ReplaySpec spec = parse_replay_source("replay:/m/a.wav");
+    CHECK(spec.wav == fs::path("/m/a.wav"));
+    CHECK(spec.speed == 1.0);
+    CHECK(spec.jitter == "pipewire");
+
+    spec = parse_replay_source("replay:/m/a.wav?speed=4&jitter=bluetooth");
+    CHECK(spec.speed == 4.0);
+    CHECK(spec.jitter == "bluetooth");
+
+    CHECK_THROWS_AS(parse_replay_source("replay:"), RecmeetError);
+    CHECK_THROWS_AS(parse_replay_source("replay:/a.wav?speed=0"), RecmeetError);
+    CHECK_THROWS_AS(parse_replay_source("replay:/a.wav?speed=fast"), RecmeetError);
+    CHECK_THROWS_AS(parse_replay_source("replay:/a.wav?rate=2"), RecmeetError);
+    CHECK_THROWS_AS(parse_replay_source("/a.wav"), RecmeetError);
+}
+
+TEST_CASE("Jitter profiles: built-ins keep real time, files round trip",
+          "[streaming-capture]") {
+    for (const char* name : {"steady", "pipewire", "bluetooth"}) {
+        INFO(name);
+        CHECK_THAT(builtin_jitter_profile(name).frames_per_sec(),
+                   Catch::Matchers::WithinAbs(SAMPLE_RATE, 1.0));
+    }
+    CHECK_THROWS_AS(builtin_jitter_profile("usb"), RecmeetError);
+
+    const fs::path path = tmp_dir() / "jitter_profile.txt";
+    JitterProfile p;
+    p.name = "recorded";
+    p.ticks = {{341, 0}, {341, 21300}, {342, 21400}};
+    save_jitter_profile(path, p);
+    const JitterProfile back = resolve_jitter_profile(path.string());
+    REQUIRE(back.ticks.size() == 3);
+    CHECK(back.ticks[1].frames == 341);
+    CHECK(back.ticks[2].interval_us == 21400);
+    fs::remove(path);
+    CHECK_THROWS_AS(load_jitter_profile(path), RecmeetError);
+}
+
+TEST_CASE("JitterRecorder: keeps callback sizes and spacing up to its capacity",
+          "[streaming-capture]") {
+    JitterRecorder rec(2);
+    rec.note(320);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    rec.note(341);
+    rec.note(342);  // past capacity: not kept
+    const JitterProfile p = rec.profile("mic");
+    REQUIRE(p.ticks.size() == 2);
+    CHECK(p.ticks[0].frames == 320);
+    CHECK(p.ticks[0].interval_us == 0);
+    CHECK(p.ticks[1].frames == 341);
+    CHECK(p.ticks[1].interval_us >= 2000);
+}
+
+TEST_CASE("Replay sources deliver the whole WAV through both capture classes",
+          "[streaming-capture]") {
+    const fs::path wav = tmp_dir() / "replay_source.wav";
+    const auto samples = make_chunk(SAMPLE_RATE / 2, 0);  // 0.5 s
+    write_wav(wav, samples);
+
+    auto wait_finished = [](const CaptureReplay* replay) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (replay && !replay->finished() && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return replay && replay->finished();
+    };
+
+    // 25 x 320 frames at 10x: ~50 ms.
+    PipeWireCapture pw("replay:" + wav.string() + "?speed=10&jitter=steady");
+    CaptureSink pw_sink;
+    pw.set_audio_callback(&on_chunk, &pw_sink);
+    pw.start();
+    REQUIRE(wait_finished(pw.replay()));
+    pw.stop();
+    const ReplayStats st = pw.replay()->stats();
+    CHECK(st.chunks == 25);
+    CHECK(st.samples == samples.size());
+    CHECK(st.audio_sec == 0.5);
+    CHECK(st.wall_sec > 0);
+    CHECK(pw_sink.chunks.load() == 25);
+    CHECK(pw.stats().dropped_frames == 0);
+    CHECK(pw.drain() == samples);
+
+    PulseMonitorCapture pa("replay:" + wav.string() + "?speed=10&jitter=bluetooth");
+    pa.start();
+    REQUIRE(wait_finished(pa.replay()));
+    pa.stop();
+    CHECK(pa.replay()->stats().chunks == 25);
+    CHECK(pa.drain() == samples);
+
+    // A missing WAV fails the start, as a missing device would.
+    PipeWireCapture missing("replay:" + (tmp_dir() / "absent.wav").string());
+    CHECK_THROWS_AS(missing.start(), RecmeetError);
+    fs::remove(wav);
+}
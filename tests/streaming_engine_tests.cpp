@@ -74,9 +74,15 @@ struct ResultSink {
 
 struct DegradedSink {
     std::atomic<std::size_t> count{0};
-    static void cb(CaptionDegradedReason, void* ud) {
+    std::atomic<std::size_t> int8_fallbacks{0};
+    std::atomic<std::size_t> finals_only{0};
+    static void cb(CaptionDegradedReason r, void* ud) {
         auto* s = static_cast<DegradedSink*>(ud);
         s->count.fetch_add(1, std::memory_order_acq_rel);
+        if (r == CaptionDegradedReason::Int8Fallback)
+            s->int8_fallbacks.fetch_add(1, std::memory_order_acq_rel);
+        if (r == CaptionDegradedReason::FinalsOnly)
+            s->finals_only.fetch_add(1, std::memory_order_acq_rel);
     }
 };
 
@@ -144,6 +150,92 @@ TEST_CASE("CaptionEngine: recognizer init/teardown", "[streaming-engine][caption
     CHECK(!eng.is_running());
 }
 
+TEST_CASE("CaptionEngine: warm recognizer is reused by the next start()",
+          "[streaming-engine][caption-model]") {
+    if (!sherpa_build()) return;
+    fs::path model_dir = streaming_model_dir_if_present();
+    if (model_dir.empty()) {
+        WARN("Streaming zipformer model not cached — skipping warm-start test");
+        return;
+    }
+    CaptionEngine::Options opts;
+    opts.model_dir = model_dir.string();
+    opts.num_threads = 1;
+    opts.keep_warm = true;
+    std::string err;
+    REQUIRE(CaptionEngine::prewarm(opts, &err));
+    CHECK(err.empty());
+
+    // Two starts in a row, each taking the recognizer the last one kept.
+    for (int i = 0; i < 2; ++i) {
+        CaptionEngine eng;
+        ResultSink rsink;
+        DegradedSink dsink;
+        REQUIRE(eng.start(opts, &ResultSink::cb, &rsink,
+                                &DegradedSink::cb, &dsink));
+        eng.stop();
+    }
+    CaptionEngine::drop_warm();
+    CaptionEngine::drop_warm();  // nothing left to drop
+}
+
+TEST_CASE("CaptionEngine: a decode behind its RTF budget switches to int8",
+          "[streaming-engine][caption-model]") {
+    if (!sherpa_build()) return;
+    fs::path model_dir = streaming_model_dir_if_present();
+    if (model_dir.empty()) {
+        WARN("Streaming zipformer model not cached — skipping int8 fallback test");
+        return;
+    }
+    bool has_int8 = false;
+    for (auto& e : fs::directory_iterator(model_dir))
+        has_int8 = has_int8 || e.path().filename().string().find(".int8.") != std::string::npos;
+    if (!has_int8) {
+        WARN("No int8 weights beside the cached model — skipping int8 fallback test");
+        return;
+    }
+    CaptionEngine eng;
+    CaptionEngine::Options opts;
+    opts.model_dir = model_dir.string();
+    opts.int8_fallback = true;
+    opts.int8_probe_ms = 300;
+    opts.int8_max_rtf = 1e-6;  // any real decode is "behind"
+    ResultSink rsink;
+    DegradedSink dsink;
+    REQUIRE(eng.start(opts, &ResultSink::cb, &rsink, &DegradedSink::cb, &dsink));
+    if (eng.stats().int8) {
+        // An earlier fallback in this process already picked int8.
+        eng.stop();
+        SUCCEED("model dir already fell back in this process");
+        return;
+    }
+
+    std::vector<int16_t> chunk(1600);
+    for (std::size_t i = 0; i < chunk.size(); ++i)
+        chunk[i] = static_cast<int16_t>((i * 31) & 0x3FFF);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    while (!eng.stats().int8 && std::chrono::steady_clock::now() < deadline) {
+        eng._push_samples_for_test(chunk.data(), chunk.size());
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    CaptionStats st = eng.stats();
+    CHECK(st.int8);
+    CHECK(st.decode_rtf > 0);
+    CHECK(dsink.int8_fallbacks.load() == 1);
+    // The int8 recognizer keeps decoding what follows.
+    for (int i = 0; i < 5; ++i) {
+        eng._push_samples_for_test(chunk.data(), chunk.size());
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    eng.stop();
+
+    // The next start loads the int8 weights directly.
+    CaptionEngine again;
+    REQUIRE(again.start(opts, &ResultSink::cb, &rsink, &DegradedSink::cb, &dsink));
+    CHECK(again.stats().int8);
+    again.stop();
+}
+
 // ===========================================================================
 // 2. Partial → final transition ([caption-model]).
 //    Stripped to a coarse shape check: feed audio long enough that the
@@ -274,6 +366,169 @@ TEST_CASE("CaptionEngine: drop-watermark rate-limit ≤ 1/s",
     CHECK(n <= 2);
 }
 
+// ===========================================================================
+// 4b. Event-driven wakeup: a feed chunk (1600 samples) wakes the worker at
+//     once, with the idle wait set far beyond the test's deadline; less than
+//     a chunk waits for more audio.
+// ===========================================================================
+TEST_CASE("CaptionEngine: a full feed chunk wakes the worker without polling",
+          "[streaming-engine]") {
+    if (!sherpa_build()) {
+        WARN("RECMEET_USE_SHERPA=OFF — skipping wakeup test");
+        return;
+    }
+    CaptionEngine eng;
+    CaptionEngine::Options opts;
+    opts._no_recognizer_for_test = true;  // model-free
+    opts.worker_poll_ms_override = 60000;
+    ResultSink rsink;
+    DegradedSink dsink;
+    REQUIRE(eng.start(opts, &ResultSink::cb, &rsink, &DegradedSink::cb, &dsink));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));  // worker waiting
+
+    std::vector<int16_t> part(1000, 0);
+    eng._push_samples_for_test(part.data(), part.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    CHECK(eng._ring_occupancy_for_test() == 1000);
+
+    eng._push_samples_for_test(part.data(), part.size());  // 2000 >= one chunk
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (eng._ring_occupancy_for_test() >= 1600 &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    CHECK(eng._ring_occupancy_for_test() < 1600);
+
+    // stop() ends the wait too, well before the 60 s idle timeout.
+    const auto t0 = std::chrono::steady_clock::now();
+    eng.stop();
+    CHECK(std::chrono::steady_clock::now() - t0 < std::chrono::seconds(2));
+}
+
+TEST_CASE("CaptionEngine: two sources each get a ring and a sink",
+          "[streaming-engine]") {
+    if (!sherpa_build()) {
+        WARN("RECMEET_USE_SHERPA=OFF — skipping multi-source test");
+        return;
+    }
+    CaptionEngine eng;
+    CHECK(eng.audio_sink(CaptionSource::Mic) == nullptr);  // not started
+    CaptionEngine::Options opts;
+    opts._no_recognizer_for_test = true;  // model-free
+    opts.worker_poll_ms_override = 60000;
+    opts.sources = {CaptionSource::Monitor, CaptionSource::Mic, CaptionSource::Monitor};
+    ResultSink rsink;
+    DegradedSink dsink;
+    REQUIRE(eng.start(opts, &ResultSink::cb, &rsink, &DegradedSink::cb, &dsink));
+    void* mic = eng.audio_sink(CaptionSource::Mic);
+    void* mon = eng.audio_sink(CaptionSource::Monitor);
+    REQUIRE(mic != nullptr);
+    REQUIRE(mon != nullptr);
+    CHECK(mic != mon);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));  // worker waiting
+
+    // The rings are separate: on_audio_chunk feeds the first source
+    // (monitor), each sink its own.
+    std::vector<int16_t> part(1000, 0);
+    CaptionEngine::on_audio_chunk(part.data(), part.size(), &eng);
+    CaptionEngine::on_source_audio(part.data(), 500, mic);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    CHECK(eng._ring_occupancy_for_test(CaptionSource::Monitor) == 1000);
+    CHECK(eng._ring_occupancy_for_test(CaptionSource::Mic) == 500);
+    CHECK(eng._ring_occupancy_for_test() == 1000);
+
+    // A full chunk on the mic alone wakes the worker, which drains both.
+    CaptionEngine::on_source_audio(part.data(), part.size(), mic);
+    CaptionEngine::on_source_audio(part.data(), part.size(), mic);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (eng._ring_occupancy_for_test(CaptionSource::Monitor) > 0 &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    CHECK(eng._ring_occupancy_for_test(CaptionSource::Monitor) == 0);
+    CHECK(eng._ring_occupancy_for_test(CaptionSource::Mic) < 1600);
+    eng.stop();
+    CHECK(eng.audio_sink(CaptionSource::Mic) == nullptr);
+}
+
+TEST_CASE("CaptionEngine: stats sample ring occupancy per pass",
+          "[streaming-engine]") {
+    CaptionEngine eng;
+    CHECK(eng.stats().ring_ms.count == 0);
+    if (!sherpa_build()) return;
+    CaptionEngine::Options opts;
+    opts._no_recognizer_for_test = true;  // model-free: no results, no latencies
+    opts.worker_poll_ms_override = 60000;
+    ResultSink rsink;
+    DegradedSink dsink;
+    REQUIRE(eng.start(opts, &ResultSink::cb, &rsink, &DegradedSink::cb, &dsink));
+    CHECK(eng.stats().ring_capacity_ms == 32768 * 1000 / 16000);
+
+    // 1600 samples = 100 ms queued when the woken worker samples the ring.
+    std::vector<int16_t> chunk(1600, 0);
+    eng._push_samples_for_test(chunk.data(), chunk.size());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (eng.stats().ring_ms.count == 0 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    CaptionStats st = eng.stats();
+    CHECK(st.ring_ms.count >= 1);
+    CHECK(st.ring_ms.max == 100);
+    CHECK(st.partial_ms.count == 0);
+    CHECK(st.final_ms.count == 0);
+    CHECK(st.decode_rtf >= 0);
+    CHECK_FALSE(st.int8);
+    CHECK(st.overload_tier == CaptionOverloadTier::Normal);
+    eng.stop();
+}
+
+TEST_CASE("CaptionOverloadPolicy: tiers rise with the backlog, fall once calm",
+          "[streaming-engine]") {
+    using T = CaptionOverloadTier;
+    CaptionOverloadPolicy p;
+    CHECK(p.update(0.1, false, 0) == T::Normal);
+    CHECK(p.update(0.3, false, 100) == T::FinalsOnly);
+    CHECK(p.update(0.2, false, 200) == T::FinalsOnly);  // not under kRecoverFill yet
+    CHECK(p.update(0.6, false, 300) == T::ReducedDecode);
+    CHECK(p.update(0.05, false, 400) == T::ReducedDecode);
+    CHECK(p.update(0.05, false, 2399) == T::ReducedDecode);
+    CHECK(p.update(0.05, false, 2400) == T::Normal);
+
+    // A drop is the last tier, and any backlog restarts the calm clock.
+    CHECK(p.update(0.0, true, 3000) == T::Dropping);
+    CHECK(p.update(0.0, false, 3100) == T::Dropping);
+    CHECK(p.update(0.2, false, 4000) == T::Dropping);
+    CHECK(p.update(0.0, false, 5200) == T::Dropping);
+    CHECK(p.update(0.0, false, 7200) == T::Normal);
+    CHECK(p.update(1.0, false, 7300) == T::Dropping);  // a full ring drops the next push
+}
+
+TEST_CASE("CaptionEngine: a backlog short of overrun suppresses partials first",
+          "[streaming-engine]") {
+    if (!sherpa_build()) {
+        WARN("RECMEET_USE_SHERPA=OFF — skipping overload-tier test");
+        return;
+    }
+    CaptionEngine eng;
+    CaptionEngine::Options opts;
+    opts._no_recognizer_for_test = true;  // model-free
+    opts.ring_capacity_override = 4096;   // wakes at 1600; 1200 waits for the poll
+    opts.worker_poll_ms_override = 200;
+    ResultSink rsink;
+    DegradedSink dsink;
+    REQUIRE(eng.start(opts, &ResultSink::cb, &rsink, &DegradedSink::cb, &dsink));
+
+    // 1200 of 4096 samples (29%) queued when the worker next looks.
+    std::vector<int16_t> chunk(1200, 0);
+    eng._push_samples_for_test(chunk.data(), chunk.size());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (dsink.count.load() == 0 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    CHECK(dsink.finals_only.load() == 1);
+    CHECK(dsink.count.load() == 1);
+    CHECK(eng.stats().overload_tier == CaptionOverloadTier::FinalsOnly);
+    eng.stop();
+}
+
 // ===========================================================================
 // 5. Thread cap honored — num_threads=4 -> effective is 2.
 // ===========================================================================
@@ -538,3 +793,14 @@ TEST_CASE("CaptionEngine: stub build reports clear error from start()",
     CHECK(eng.last_error() == "captions require RECMEET_USE_SHERPA=ON build");
     CHECK_FALSE(eng.is_running());
 }
+
+TEST_CASE("CaptionEngine: prewarm without a model fails with an error",
+          "[streaming-engine][caption-stub]") {
+    CaptionEngine::Options opts;
+    opts.model_dir = "/nonexistent";
+    std::string err;
+    CHECK_FALSE(CaptionEngine::prewarm(opts, &err));
+    CHECK_FALSE(err.empty());
+    CHECK_FALSE(CaptionEngine::prewarm(opts));
+    CaptionEngine::drop_warm();
+}
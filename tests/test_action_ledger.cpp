@@ -0,0 +1,96 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "action_ledger.h"
+#include "note.h"
+#include "test_tmpdir.h"
+
+#include <fstream>
+#include <sstream>
+
+using namespace recmeet;
+
+namespace {
+
+std::vector<std::string> read_lines(const fs::path& path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) lines.push_back(line);
+    return lines;
+}
+
+size_t count_containing(const std::vector<std::string>& lines, const std::string& what) {
+    size_t n = 0;
+    for (const auto& l : lines) n += l.find(what) != std::string::npos;
+    return n;
+}
+
+} // anonymous namespace
+
+TEST_CASE("parse_ledger_item: splits assignee and due date like the Go parser", "[action_ledger]") {
+    LedgerItem item;
+    REQUIRE(parse_ledger_item("**[Alice]** - Draft API migration plan by March 18", item));
+    CHECK(item.assignee == "Alice");
+    CHECK(item.text == "Draft API migration plan by March 18");
+    CHECK(item.due == "March 18");
+    CHECK_FALSE(item.done);
+
+    REQUIRE(parse_ledger_item("  Review budget allocation  ", item));
+    CHECK(item.assignee.empty());
+    CHECK(item.text == "Review budget allocation");
+    CHECK(item.due.empty());
+
+    CHECK_FALSE(parse_ledger_item("None identified", item));
+
+    CHECK(extract_due_date("Ship it, due 2026-03-20.") == "2026-03-20");
+    CHECK(extract_due_date("send the deck before Friday") == "Friday");
+    CHECK(extract_due_date("wrap up by end of week") == "end of week");
+    CHECK(extract_due_date("stand by Bob's desk") == "");
+}
+
+TEST_CASE("write_meeting_note: records its action items in the ledger", "[action_ledger]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_action_ledger");
+    fs::remove_all(tmp);
+    fs::create_directories(tmp);
+    const fs::path ledger = tmp / "data" / "action_items.ndjson";
+
+    NoteConfig cfg;
+    cfg.action_ledger = ledger;
+    MeetingData md;
+    md.date = "2026-03-15";
+    md.time = "14:30";
+    md.output_dir = tmp;
+    md.action_items = {"**[Alice]** - Draft the plan by March 18", "**[Bob]** - Book a room"};
+    const fs::path first = write_meeting_note(cfg, md);
+
+    md.time = "16:00";
+    md.action_items = {"None"};
+    const fs::path second = write_meeting_note(cfg, md);
+
+    auto lines = read_lines(ledger);
+    REQUIRE(lines.size() == 5);
+    CHECK(lines[0] == "{\"version\":1}");
+    CHECK(count_containing(lines, "\"kind\":\"note\"") == 2);
+    CHECK(count_containing(lines, "\"kind\":\"item\"") == 2);
+    CHECK(count_containing(lines, "\"due\":\"March 18\"") == 1);
+    CHECK(count_containing(lines, "\"assignee\":\"Bob\"") == 1);
+
+    // Rewriting a note replaces its records and keeps the other note's.
+    md.time = "14:30";
+    md.action_items = {"**[Carol]** - Send notes"};
+    REQUIRE(write_meeting_note(cfg, md) == first);
+    lines = read_lines(ledger);
+    CHECK(lines.size() == 4);
+    CHECK(count_containing(lines, "Alice") == 0);
+    CHECK(count_containing(lines, "\"assignee\":\"Carol\"") == 1);
+    CHECK(count_containing(lines, second.filename().string()) == 1);
+
+    // A ledger of another version is started over.
+    std::ofstream(ledger) << "{\"version\":99}\n{\"kind\":\"note\",\"note\":\"/x.md\"}\n";
+    write_meeting_note(cfg, md);
+    lines = read_lines(ledger);
+    CHECK(lines.size() == 3);
+    CHECK(count_containing(lines, "/x.md") == 0);
+    fs::remove_all(tmp);
+}
@@ -5,9 +5,11 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 #include "audio_file.h"
+#include "audio_mixer.h"
 #include "test_tmpdir.h"
 
 #include <cmath>
+#include <cstdlib>
 #include <fstream>
 #include <sndfile.h>
 
@@ -146,6 +148,66 @@ TEST_CASE("get_audio_duration_seconds: missing file returns 0", "[audio_file]")
     CHECK(get_audio_duration_seconds("/nonexistent/path.wav") == 0);
 }
 
+TEST_CASE("probe_audio: header and sampled levels", "[audio_file]") {
+    auto dir = tmp_dir();
+    fs::path wav = dir / "probe.wav";
+
+    // Two minutes of a quiet tone with a silent first half.
+    std::vector<int16_t> samples(SAMPLE_RATE * 120, 0);
+    for (std::size_t i = samples.size() / 2; i < samples.size(); ++i)
+        samples[i] = static_cast<int16_t>(8000 * std::sin(2.0 * M_PI * 440.0 * i / SAMPLE_RATE));
+    write_wav(wav, samples);
+
+    const AudioProbe p = probe_audio(wav);
+    CHECK(p.readable);
+    CHECK(p.format == "wav");
+    CHECK(p.sample_rate == SAMPLE_RATE);
+    CHECK(p.channels == 1);
+    CHECK(p.frames == samples.size());
+    CHECK_FALSE(p.sparse);
+    CHECK_THAT(p.duration_sec, WithinAbs(120.0, 1e-9));
+    CHECK(p.blocks_read == AUDIO_PROBE_BLOCKS);
+    CHECK(p.silent_blocks == AUDIO_PROBE_BLOCKS / 2);
+    CHECK_THAT(p.peak, WithinAbs(8000.0 / 32768, 1e-3));
+    CHECK_FALSE(p.silent());
+    CHECK_FALSE(p.clipping());
+
+    // Header only.
+    const AudioProbe header = probe_audio(wav, 0);
+    CHECK(header.readable);
+    CHECK(header.blocks_read == 0);
+    CHECK_THAT(header.duration_sec, WithinAbs(120.0, 1e-9));
+
+    fs::remove(wav);
+}
+
+TEST_CASE("probe_audio: silence, clipping and short files", "[audio_file]") {
+    auto dir = tmp_dir();
+    fs::path silent = dir / "probe_silent.wav";
+    write_wav(silent, std::vector<int16_t>(SAMPLE_RATE * 30, 0));
+    CHECK(probe_audio(silent).silent());
+
+    // A square wave at full scale, shorter than the sampled blocks: read whole.
+    fs::path loud = dir / "probe_loud.wav";
+    std::vector<int16_t> square(SAMPLE_RATE / 2);
+    for (std::size_t i = 0; i < square.size(); ++i) square[i] = (i / 40) % 2 ? 32767 : -32768;
+    write_wav(loud, square);
+    const AudioProbe p = probe_audio(loud);
+    CHECK(p.blocks_read == 2);
+    CHECK_FALSE(p.silent());
+    CHECK(p.clipping());
+    CHECK(p.peak == 1.0f);
+
+    CHECK_FALSE(probe_audio("/nonexistent/path.wav").readable);
+    fs::path junk = dir / "probe_junk.wav";
+    std::ofstream(junk) << "not audio";
+    CHECK_FALSE(probe_audio(junk).readable);
+
+    fs::remove(silent);
+    fs::remove(loud);
+    fs::remove(junk);
+}
+
 TEST_CASE("write_wav: empty samples creates valid header-only file", "[audio_file]") {
     auto dir = tmp_dir();
     fs::path wav = dir / "empty_samples.wav";
@@ -217,6 +279,35 @@ TEST_CASE("validate_reprocess_input: MP3 file gives ffmpeg hint", "[audio_file]"
     fs::remove(mp3);
 }
 
+TEST_CASE("decodes_through_ffmpeg: by extension", "[audio_file]") {
+    CHECK(decodes_through_ffmpeg("phone.m4a"));
+    CHECK(decodes_through_ffmpeg("call.MP3"));
+    CHECK(decodes_through_ffmpeg("memo.aac"));
+    CHECK(decodes_through_ffmpeg("old.wma"));
+    CHECK_FALSE(decodes_through_ffmpeg("audio.wav"));
+    CHECK_FALSE(decodes_through_ffmpeg("audio.flac"));
+}
+
+TEST_CASE("validate_reprocess_input: M4A is decoded through ffmpeg", "[audio_file]") {
+    if (!ffmpeg_available()) SKIP("ffmpeg not installed");
+    auto dir = tmp_dir();
+    fs::path m4a = dir / "phone.m4a";
+    const std::string cmd =
+        "ffmpeg -nostdin -v error -y -f lavfi -i sine=frequency=440:sample_rate=44100:duration=2"
+        " -ac 2 -c:a aac " + shell_quote(m4a.string());
+    REQUIRE(std::system(cmd.c_str()) == 0);
+
+    CHECK(validate_reprocess_input(m4a) == m4a);
+    CHECK(get_audio_duration_seconds(m4a) == 2);
+    FfmpegSampleSource src(m4a);
+    CHECK(src.sample_rate() == 44100);
+    // AAC may add a priming frame or trim one.
+    CHECK(src.size() + 1600 >= 2 * static_cast<std::size_t>(SAMPLE_RATE));
+    CHECK(src.size() <= 2 * static_cast<std::size_t>(SAMPLE_RATE) + 1600);
+
+    fs::remove(m4a);
+}
+
 TEST_CASE("validate_reprocess_input: unsupported format", "[audio_file]") {
     auto dir = tmp_dir();
     fs::path bad = dir / "test.xyz";
@@ -227,3 +318,133 @@ TEST_CASE("validate_reprocess_input: unsupported format", "[audio_file]") {
 
     fs::remove(bad);
 }
+
+TEST_CASE("mix_wav_files: matches in-memory mix_audio across blocks", "[audio_file]") {
+    auto dir = tmp_dir();
+    fs::path a = dir / "mix_a.wav";
+    fs::path b = dir / "mix_b.wav";
+    fs::path out = dir / "mix_out.wav";
+
+    // Unequal lengths spanning more than one 1 s mixing block.
+    std::vector<int16_t> sa(SAMPLE_RATE * 2 + 321), sb(SAMPLE_RATE + 17);
+    for (size_t i = 0; i < sa.size(); ++i)
+        sa[i] = static_cast<int16_t>(12000 * std::sin(2.0 * M_PI * 440.0 * i / SAMPLE_RATE));
+    for (size_t i = 0; i < sb.size(); ++i)
+        sb[i] = static_cast<int16_t>(9000 * std::sin(2.0 * M_PI * 220.0 * i / SAMPLE_RATE));
+    write_wav(a, sa);
+    write_wav(b, sb);
+
+    mix_wav_files(a, b, out);
+
+    auto expected = mix_audio(sa, sb);
+    auto got = read_wav_float(out);
+    REQUIRE(got.size() == expected.size());
+    for (size_t i = 0; i < got.size(); i += 997)
+        CHECK_THAT(got[i], WithinAbs(expected[i] / 32768.0, 0.0001));
+
+    fs::remove(a);
+    fs::remove(b);
+    fs::remove(out);
+}
+
+TEST_CASE("mix_wav_files: interleaved sources in the same pass", "[audio_file]") {
+    auto dir = tmp_dir();
+    fs::path a = dir / "src_a.wav", b = dir / "src_b.wav";
+    fs::path out = dir / "src_mix.wav", sources = dir / "sources.wav";
+    std::vector<int16_t> sa(SAMPLE_RATE + 500, 8000), sb(SAMPLE_RATE * 2 + 40, -4000);
+    write_wav(a, sa);
+    write_wav(b, sb);
+
+    mix_wav_files(a, b, out, nullptr, sources);
+
+    SF_INFO info = {};
+    SNDFILE* sf = sf_open(sources.c_str(), SFM_READ, &info);
+    REQUIRE(sf != nullptr);
+    CHECK(info.channels == 2);
+    CHECK(info.frames == static_cast<sf_count_t>(sb.size()));
+    sf_close(sf);
+
+    // Each channel comes back as its input, the shorter one zero-padded.
+    fs::path left = dir / "left.wav", right = dir / "right.wav";
+    extract_wav_channel(sources, 0, left, sa.size());
+    extract_wav_channel(sources, 1, right);
+    auto l = read_wav_float(left);
+    auto r = read_wav_float(right);
+    REQUIRE(l.size() == sa.size());
+    REQUIRE(r.size() == sb.size());
+    CHECK_THAT(l.back(), WithinAbs(8000 / 32768.0, 0.0001));
+    CHECK_THAT(r.front(), WithinAbs(-4000 / 32768.0, 0.0001));
+    CHECK_THROWS_AS(extract_wav_channel(sources, 2, left), RecmeetError);
+
+    for (const auto& p : {a, b, out, sources, left, right}) fs::remove(p);
+}
+
+TEST_CASE("archive_audio_file: FLAC is lossless and seekable", "[audio_file]") {
+    auto dir = tmp_dir();
+    fs::path wav = dir / "audio_2026-03-01_10-00.wav";
+    std::vector<int16_t> samples(SAMPLE_RATE * 3 + 77);
+    for (size_t i = 0; i < samples.size(); ++i)
+        samples[i] = static_cast<int16_t>(15000 * std::sin(2.0 * M_PI * 330.0 * i / SAMPLE_RATE));
+    write_wav(wav, samples);
+
+    fs::path flac = archive_audio_file(wav, AudioArchiveFormat::Flac);
+    CHECK(flac == dir / "audio_2026-03-01_10-00.flac");
+    CHECK_FALSE(fs::exists(wav));
+    CHECK_FALSE(fs::exists(dir / "audio_2026-03-01_10-00.flac.part"));
+    CHECK(find_audio_file(dir) == flac);
+
+    // Range decode matches the original samples exactly.
+    SndfileSampleSource src(flac);
+    REQUIRE(src.size() == samples.size());
+    const size_t start = SAMPLE_RATE * 2 + 5;
+    auto window = src.window(start, 1000);
+    REQUIRE(window.size() == 1000);
+    bool exact = true;
+    for (size_t i = 0; i < window.size(); ++i)
+        if (window[i] != samples[start + i] / 32768.0f) { exact = false; break; }
+    CHECK(exact);
+    CHECK(src.window(samples.size() - 10, 100).size() == 10);
+
+    // AudioView and reprocess validation accept the archive.
+    CHECK(validate_reprocess_input(dir) == flac);
+    fs::remove_all(dir);
+}
+
+TEST_CASE("archive_audio_file: Opus when libsndfile supports it", "[audio_file]") {
+    SF_INFO probe = {};
+    probe.samplerate = SAMPLE_RATE;
+    probe.channels = 1;
+    probe.format = SF_FORMAT_OGG | SF_FORMAT_OPUS;
+    if (!sf_format_check(&probe)) {
+        SUCCEED("libsndfile built without Opus");
+        return;
+    }
+
+    auto dir = tmp_dir();
+    fs::path wav = dir / "opus_src.wav";
+    std::vector<int16_t> samples(SAMPLE_RATE * 2);
+    for (size_t i = 0; i < samples.size(); ++i)
+        samples[i] = static_cast<int16_t>(12000 * std::sin(2.0 * M_PI * 440.0 * i / SAMPLE_RATE));
+    write_wav(wav, samples);
+
+    fs::path opus = archive_audio_file(wav, AudioArchiveFormat::Opus);
+    CHECK(opus.extension() == ".opus");
+    CHECK_FALSE(fs::exists(wav));
+    SndfileSampleSource src(opus);
+    CHECK(src.size() == samples.size());
+    CHECK(src.window(SAMPLE_RATE, 160).size() == 160);
+    fs::remove_all(dir);
+}
+
+TEST_CASE("archive_audio_file: wav is a no-op and names parse", "[audio_file]") {
+    AudioArchiveFormat fmt = AudioArchiveFormat::Flac;
+    CHECK(parse_audio_archive_format("wav", fmt));
+    CHECK(fmt == AudioArchiveFormat::Wav);
+    CHECK(parse_audio_archive_format("opus", fmt));
+    CHECK(fmt == AudioArchiveFormat::Opus);
+    CHECK_FALSE(parse_audio_archive_format("mp3", fmt));
+    CHECK(std::string(audio_archive_extension(AudioArchiveFormat::Flac)) == ".flac");
+
+    fs::path p = tmp_dir() / "untouched.wav";
+    CHECK(archive_audio_file(p, AudioArchiveFormat::Wav) == p);
+}
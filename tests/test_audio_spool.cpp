@@ -0,0 +1,165 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "audio_spool.h"
+#include "test_tmpdir.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+using namespace recmeet;
+
+static fs::path tmp_dir() {
+    fs::path dir = recmeet::test::tmp_path("recmeet_spool");
+    fs::create_directories(dir);
+    return dir;
+}
+
+static std::vector<uint8_t> read_bytes(const fs::path& p) {
+    std::ifstream in(p, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), {});
+}
+
+static uint32_t le32(const uint8_t* p) {
+    return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+}
+
+static uint64_t le64(const uint8_t* p) {
+    return uint64_t(le32(p)) | uint64_t(le32(p + 4)) << 32;
+}
+
+static constexpr std::size_t H = SPOOL_WAV_HEADER_BYTES;
+
+TEST_CASE("AudioSpool: empty spool is a valid zero-length WAV", "[audio_spool]") {
+    fs::path wav = tmp_dir() / "empty.wav";
+    AudioSpool spool(wav);
+    auto h = spool.finish();
+
+    CHECK(h.path == wav);
+    CHECK(h.samples == 0);
+    auto bytes = read_bytes(wav);
+    REQUIRE(bytes.size() == H);
+    CHECK(std::memcmp(bytes.data(), "RIFF", 4) == 0);
+    CHECK(std::memcmp(bytes.data() + 8, "WAVE", 4) == 0);
+    CHECK(std::memcmp(bytes.data() + 12, "JUNK", 4) == 0);
+    CHECK(std::memcmp(bytes.data() + 48, "fmt ", 4) == 0);
+    CHECK(std::memcmp(bytes.data() + 72, "data", 4) == 0);
+    CHECK(le32(bytes.data() + 4) == H - 8);
+    CHECK(le32(bytes.data() + 60) == SAMPLE_RATE);
+    CHECK(le32(bytes.data() + 76) == 0);
+    fs::remove(wav);
+}
+
+TEST_CASE("AudioSpool: samples round-trip across block boundaries", "[audio_spool]") {
+    fs::path wav = tmp_dir() / "blocks.wav";
+    // Small blocks so a handful of appends cross several boundaries and
+    // overrun the preallocated pool.
+    AudioSpool spool(wav, 7);
+
+    std::vector<int16_t> expected;
+    for (int chunk = 0; chunk < 20; ++chunk) {
+        std::vector<int16_t> buf(static_cast<std::size_t>(chunk % 5 + 1) * 3);
+        for (std::size_t i = 0; i < buf.size(); ++i)
+            buf[i] = static_cast<int16_t>((expected.size() + i) * 3 - 1000);
+        expected.insert(expected.end(), buf.begin(), buf.end());
+        spool.append(buf.data(), buf.size());
+    }
+    CHECK(spool.samples_appended() == expected.size());
+
+    auto h = spool.finish();
+    REQUIRE(h.samples == expected.size());
+    CHECK(h.duration_seconds() == static_cast<double>(expected.size()) / SAMPLE_RATE);
+
+    auto bytes = read_bytes(wav);
+    REQUIRE(bytes.size() == H + expected.size() * sizeof(int16_t));
+    CHECK(le32(bytes.data() + 76) == expected.size() * sizeof(int16_t));
+    CHECK(le32(bytes.data() + 4) == H - 8 + expected.size() * sizeof(int16_t));
+
+    std::vector<int16_t> got(expected.size());
+    std::memcpy(got.data(), bytes.data() + H, got.size() * sizeof(int16_t));
+    CHECK(got == expected);
+    fs::remove(wav);
+}
+
+TEST_CASE("AudioSpool: finish is idempotent and stops accepting samples", "[audio_spool]") {
+    fs::path wav = tmp_dir() / "idempotent.wav";
+    AudioSpool spool(wav);
+    std::vector<int16_t> buf(SAMPLE_RATE + 123, 42);
+    spool.append(buf.data(), buf.size());
+
+    auto first = spool.finish();
+    spool.append(buf.data(), buf.size());
+    auto second = spool.finish();
+
+    CHECK(first.samples == buf.size());
+    CHECK(second.samples == first.samples);
+    CHECK(fs::file_size(wav) == H + buf.size() * sizeof(int16_t));
+    fs::remove(wav);
+}
+
+TEST_CASE("AudioSpool: destructor finalizes an unfinished spool", "[audio_spool]") {
+    fs::path wav = tmp_dir() / "dtor.wav";
+    {
+        AudioSpool spool(wav);
+        std::vector<int16_t> buf(500, -7);
+        spool.append(buf.data(), buf.size());
+    }
+    auto bytes = read_bytes(wav);
+    REQUIRE(bytes.size() == H + 500 * sizeof(int16_t));
+    CHECK(le32(bytes.data() + 76) == 500 * sizeof(int16_t));
+    fs::remove(wav);
+}
+
+TEST_CASE("AudioSpool: unwritable path throws at construction", "[audio_spool]") {
+    fs::path wav = tmp_dir() / "no_such_dir" / "x.wav";
+    CHECK_THROWS_AS(AudioSpool(wav), RecmeetError);
+}
+
+TEST_CASE("AudioSpool: header is committed periodically while recording", "[audio_spool]") {
+    fs::path wav = tmp_dir() / "commit.wav";
+    AudioSpool spool(wav, 160, std::chrono::milliseconds(1));
+    std::vector<int16_t> buf(1600, 9);
+    spool.append(buf.data(), buf.size());
+
+    // Without finish(), the on-disk header must catch up on its own — this
+    // is what a killed process leaves behind.
+    uint32_t data_bytes = 0;
+    for (int i = 0; i < 100 && data_bytes < buf.size() * sizeof(int16_t); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        auto bytes = read_bytes(wav);
+        REQUIRE(bytes.size() >= H);
+        data_bytes = le32(bytes.data() + 76);
+        CHECK(bytes.size() >= H + data_bytes);  // never claims unwritten data
+    }
+    CHECK(data_bytes == buf.size() * sizeof(int16_t));
+    spool.finish();
+    fs::remove(wav);
+}
+
+TEST_CASE("build_spool_wav_header: switches to RF64 past the 32-bit limit", "[audio_spool]") {
+    uint8_t h[H];
+
+    const uint64_t max_riff_data = 0xFFFFFFFFull - (H - 8);
+    build_spool_wav_header(h, max_riff_data);
+    CHECK(std::memcmp(h, "RIFF", 4) == 0);
+    CHECK(std::memcmp(h + 12, "JUNK", 4) == 0);
+    CHECK(le32(h + 4) == 0xFFFFFFFFu);
+    CHECK(le32(h + 76) == max_riff_data);
+
+    const uint64_t big = 6ull * 1024 * 1024 * 1024;  // 6 GiB of PCM
+    build_spool_wav_header(h, big);
+    CHECK(std::memcmp(h, "RF64", 4) == 0);
+    CHECK(std::memcmp(h + 12, "ds64", 4) == 0);
+    CHECK(le32(h + 16) == 28);
+    CHECK(le32(h + 4) == 0xFFFFFFFFu);
+    CHECK(le32(h + 76) == 0xFFFFFFFFu);
+    CHECK(le64(h + 20) == big + H - 8);
+    CHECK(le64(h + 28) == big);
+    CHECK(le64(h + 36) == big / 2);
+    // fmt chunk is unchanged by the upgrade.
+    CHECK(std::memcmp(h + 48, "fmt ", 4) == 0);
+    CHECK(le32(h + 60) == SAMPLE_RATE);
+}
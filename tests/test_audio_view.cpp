@@ -0,0 +1,245 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "audio_view.h"
+#include "audio_file.h"
+#include "audio_spool.h"
+#include "sparse_audio.h"
+#include "test_tmpdir.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sndfile.h>
+
+using namespace recmeet;
+
+namespace {
+
+fs::path tmp_dir() {
+    fs::path dir = recmeet::test::tmp_path("recmeet_audio_view");
+    fs::create_directories(dir);
+    return dir;
+}
+
+std::vector<int16_t> sine(std::size_t n) {
+    std::vector<int16_t> v(n);
+    for (std::size_t i = 0; i < n; ++i)
+        v[i] = static_cast<int16_t>(20000 * std::sin(2.0 * M_PI * 440.0 * i / SAMPLE_RATE));
+    v[0] = -32768;
+    v[1] = 32767;
+    return v;
+}
+
+void put32(std::ofstream& out, uint32_t v) {
+    uint8_t b[4] = {uint8_t(v), uint8_t(v >> 8), uint8_t(v >> 16), uint8_t(v >> 24)};
+    out.write(reinterpret_cast<const char*>(b), 4);
+}
+
+void put16(std::ofstream& out, uint16_t v) {
+    uint8_t b[2] = {uint8_t(v), uint8_t(v >> 8)};
+    out.write(reinterpret_cast<const char*>(b), 2);
+}
+
+// Canonical 44-byte RIFF header claiming `claimed_bytes` of data, followed
+// by `pcm` (which may be shorter or longer than the claim).
+void write_raw_wav(const fs::path& p, const std::vector<int16_t>& pcm, uint32_t claimed_bytes) {
+    std::ofstream out(p, std::ios::binary);
+    out.write("RIFF", 4);
+    put32(out, 36 + claimed_bytes);
+    out.write("WAVEfmt ", 8);
+    put32(out, 16);
+    put16(out, 1);
+    put16(out, 1);
+    put32(out, SAMPLE_RATE);
+    put32(out, SAMPLE_RATE * 2);
+    put16(out, 2);
+    put16(out, 16);
+    out.write("data", 4);
+    put32(out, claimed_bytes);
+    out.write(reinterpret_cast<const char*>(pcm.data()), pcm.size() * sizeof(int16_t));
+}
+
+} // namespace
+
+TEST_CASE("AudioView: mapped S16LE matches read_wav_float", "[audio_view]") {
+    auto dir = tmp_dir();
+    fs::path wav = dir / "sine.wav";
+    write_wav(wav, sine(SAMPLE_RATE + 123));
+
+    auto expected = read_wav_float(wav);
+    AudioView view(wav);
+    CHECK(view.mapped());
+    REQUIRE(view.size() == expected.size());
+    CHECK(view.to_float() == expected);
+
+    // Windows are taken from the same mapping and clamp at the end.
+    auto w = view.window(1000, 500);
+    CHECK(std::equal(w.begin(), w.end(), expected.begin() + 1000));
+    CHECK(view.window(expected.size() - 10, 100).size() == 10);
+    CHECK(view.window(expected.size(), 100).empty());
+    fs::remove_all(dir);
+}
+
+TEST_CASE("AudioView: maps spool output past its JUNK chunk", "[audio_view]") {
+    auto dir = tmp_dir();
+    fs::path wav = dir / "spool.wav";
+    auto pcm = sine(5000);
+    {
+        AudioSpool spool(wav, 1024);
+        spool.append(pcm.data(), pcm.size());
+        spool.finish();
+    }
+
+    AudioView view(wav);
+    CHECK(view.mapped());
+    REQUIRE(view.size() == pcm.size());
+    std::vector<float> got(pcm.size());
+    CHECK(view.read(0, got.size(), got.data()) == pcm.size());
+    bool exact = true;
+    for (std::size_t i = 0; i < pcm.size(); ++i)
+        if (got[i] != pcm[i] / 32768.0f) { exact = false; break; }
+    CHECK(exact);
+    fs::remove_all(dir);
+}
+
+TEST_CASE("AudioView: data size is clamped to the bytes on disk", "[audio_view]") {
+    auto dir = tmp_dir();
+    fs::path wav = dir / "short.wav";
+    auto pcm = sine(800);
+    // Header claims twice what was written (e.g. a copy still in progress).
+    write_raw_wav(wav, pcm, static_cast<uint32_t>(pcm.size() * 4));
+
+    AudioView view(wav);
+    CHECK(view.mapped());
+    CHECK(view.size() == pcm.size());
+
+    // Byte ranges start past the 44-byte header and stop at the last sample.
+    uint64_t first = 0, last = 0;
+    REQUIRE(view.byte_range(10, 5, first, last));
+    CHECK(first == 44 + 20);
+    CHECK(last == 44 + 29);
+    REQUIRE(view.byte_range(790, 100, first, last));
+    CHECK(last == 44 + pcm.size() * 2 - 1);
+    CHECK_FALSE(view.byte_range(pcm.size(), 1, first, last));
+    fs::remove_all(dir);
+}
+
+TEST_CASE("AudioView: other formats are decoded on demand", "[audio_view]") {
+    auto dir = tmp_dir();
+    fs::path wav = dir / "float.wav";
+
+    SF_INFO info = {};
+    info.samplerate = SAMPLE_RATE;
+    info.channels = 1;
+    info.format = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+    SNDFILE* sf = sf_open(wav.c_str(), SFM_WRITE, &info);
+    REQUIRE(sf != nullptr);
+    std::vector<float> samples(1600);
+    for (std::size_t i = 0; i < samples.size(); ++i)
+        samples[i] = static_cast<float>(i) / samples.size() - 0.5f;
+    sf_write_float(sf, samples.data(), samples.size());
+    sf_close(sf);
+
+    AudioView view(wav);
+    CHECK_FALSE(view.mapped());
+    CHECK_FALSE(view.resampled());
+    CHECK(view.to_float() == read_wav_float(wav));
+    uint64_t first = 0, last = 0;
+    CHECK_FALSE(view.byte_range(0, 10, first, last));
+    fs::remove_all(dir);
+}
+
+TEST_CASE("AudioView: a 48 kHz stereo export is served at 16 kHz mono", "[audio_view]") {
+    auto dir = tmp_dir();
+    fs::path wav = dir / "export_48k.wav";
+
+    SF_INFO info = {};
+    info.samplerate = 48000;
+    info.channels = 2;
+    info.format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
+    SNDFILE* sf = sf_open(wav.c_str(), SFM_WRITE, &info);
+    REQUIRE(sf != nullptr);
+    std::vector<float> frames(2 * 48000);
+    for (std::size_t i = 0; i < 48000; ++i) {
+        const float v = static_cast<float>(0.4 * std::sin(2.0 * M_PI * 500.0 * i / 48000));
+        frames[2 * i] = v;
+        frames[2 * i + 1] = v;
+    }
+    sf_write_float(sf, frames.data(), frames.size());
+    sf_close(sf);
+
+    AudioView view(wav);
+    CHECK_FALSE(view.mapped());
+    CHECK(view.resampled());
+    REQUIRE(view.size() == static_cast<std::size_t>(SAMPLE_RATE));
+
+    const auto window = view.window(4000, 8000);
+    REQUIRE(window.size() == 8000);
+    double worst = 0;
+    for (std::size_t i = 0; i < window.size(); ++i) {
+        const double want = 0.4 * std::sin(2.0 * M_PI * 500.0 * (4000 + i) / SAMPLE_RATE);
+        worst = std::max(worst, std::fabs(window[i] - want));
+    }
+    CHECK(worst < 3e-3);
+    fs::remove_all(dir);
+}
+
+TEST_CASE("AudioView: speech-only archive reads on the original timeline", "[audio_view]") {
+    auto dir = tmp_dir();
+    fs::path wav = dir / "audio_2026-03-01_10-00.wav";
+    const auto pcm = sine(10 * SAMPLE_RATE);
+    write_wav(wav, pcm);
+    const auto full = read_wav_float(wav);
+
+    // Speech at 1-2 s and 6-7 s, padded to 0.5-2.5 s and 5.5-7.5 s.
+    SparseAudioIndex index;
+    index.total_samples = pcm.size();
+    index.audio_hash = "feedface";
+    index.pieces = sparse_pieces({{16000, 32000, 1.0, 2.0}, {96000, 112000, 6.0, 7.0}},
+                                 pcm.size());
+    compact_audio_file(wav, index);
+    CHECK(fs::exists(sparse_index_path(wav)));
+    CHECK_FALSE(fs::exists(dir / "audio_2026-03-01_10-00.wav.part"));
+
+    AudioView view(wav);
+    CHECK(view.sparse());
+    CHECK(view.original_hash() == "feedface");
+    REQUIRE(view.size() == pcm.size());
+    auto all = view.to_float();
+    CHECK(std::equal(all.begin() + 8000, all.begin() + 40000, full.begin() + 8000));
+    CHECK(std::equal(all.begin() + 88000, all.begin() + 120000, full.begin() + 88000));
+    CHECK(std::all_of(all.begin(), all.begin() + 8000, [](float s) { return s == 0.0f; }));
+    CHECK(std::all_of(all.begin() + 40000, all.begin() + 88000,
+                      [](float s) { return s == 0.0f; }));
+    // Byte ranges address the stored speech; silence has none.
+    uint64_t first = 0, last = 0;
+    CHECK_FALSE(view.byte_range(0, 100, first, last));
+    REQUIRE(view.byte_range(88000, 10, first, last));
+    CHECK(last - first + 1 == 10 * sizeof(int16_t));
+    uint64_t first0 = 0, last0 = 0;
+    REQUIRE(view.byte_range(8000, 1, first0, last0));
+    CHECK(first - first0 == 32000 * sizeof(int16_t));
+
+    CHECK(read_wav_float(wav) == all);
+    CHECK(get_audio_duration_seconds(wav) == 10);
+    CHECK(fs::file_size(wav) < 5 * SAMPLE_RATE * sizeof(int16_t));
+
+    // A stale index (the WAV replaced) is ignored.
+    write_wav(wav, pcm);
+    AudioView whole(wav);
+    CHECK_FALSE(whole.sparse());
+    CHECK(whole.to_float() == full);
+    fs::remove_all(dir);
+}
+
+TEST_CASE("AudioView: missing or empty file throws", "[audio_view]") {
+    auto dir = tmp_dir();
+    CHECK_THROWS_AS(AudioView(dir / "nope.wav"), RecmeetError);
+    fs::path empty = dir / "empty.wav";
+    std::ofstream(empty).close();
+    CHECK_THROWS_AS(AudioView(empty), RecmeetError);
+    fs::remove_all(dir);
+}
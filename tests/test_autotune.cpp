@@ -0,0 +1,95 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "autotune.h"
+#include "config.h"
+#include "test_tmpdir.h"
+
+using namespace recmeet;
+
+TEST_CASE("autotune_thread_candidates: spread over the host", "[autotune]") {
+    CHECK(autotune_thread_candidates(16) == std::vector<int>{4, 8, 15, 16});
+    CHECK(autotune_thread_candidates(4) == std::vector<int>{1, 2, 3, 4});
+    CHECK(autotune_thread_candidates(2) == std::vector<int>{1, 2});
+    CHECK(autotune_thread_candidates(0) == std::vector<int>{1});
+}
+
+TEST_CASE("pick_tuning: largest model that meets the target", "[autotune]") {
+    const std::vector<TuneTrial> trials = {
+        {"tiny", false, 4, 0.05},
+        {"tiny", false, 8, 0.04},
+        {"base", false, 8, 0.12},
+        {"small", false, 8, 0.40},
+        {"base", true, 7, 0.03},
+        {"small", true, 7, 0.08},
+        {"medium", true, 7, 0.30},
+    };
+    auto best = pick_tuning(trials, 0.25);
+    CHECK(best.model == "small");
+    CHECK(best.gpu);
+    CHECK(best.rtf == 0.08);
+
+    // Nothing meets the target: the fastest trial.
+    best = pick_tuning(trials, 0.01);
+    CHECK(best.model == "base");
+    CHECK(best.gpu);
+
+    // Among trials of one model, the fastest.
+    best = pick_tuning({{"base", false, 4, 0.2}, {"base", false, 8, 0.1}}, 0.25);
+    CHECK(best.threads == 8);
+}
+
+TEST_CASE("pick_tuning: a quantized variant competes with its original", "[autotune]") {
+    const std::vector<TuneTrial> trials = {
+        {"small", false, 8, 0.20},
+        {"medium", false, 8, 0.40},
+        {"medium-q5_0", false, 8, 0.22},
+        {"medium-q8_0", false, 8, 0.30},
+        {"large-v3-q5_0", false, 8, 0.60},
+    };
+    // medium meets the target only quantized, and outranks small.
+    auto best = pick_tuning(trials, 0.25);
+    CHECK(best.model == "medium-q5_0");
+
+    // Within a size, the fastest variant that meets the target.
+    best = pick_tuning(trials, 0.35);
+    CHECK(best.model == "medium-q5_0");
+    best = pick_tuning({{"base", false, 8, 0.05}, {"base-q8_0", false, 8, 0.04}}, 0.25);
+    CHECK(best.model == "base-q8_0");
+}
+
+TEST_CASE("tune profile: fills only keys config.yaml leaves unset", "[autotune][config]") {
+    fs::path dir = recmeet::test::tmp_path("recmeet_test_autotune");
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    TuneProfile profile;
+    profile.host = "testhost";
+    profile.whisper_model = "small";
+    profile.threads = 6;
+    profile.gpu = false;
+    profile.vad = true;
+    write_text_file(dir / "profile.yaml", tune_profile_yaml(profile));
+
+    // No config file: the profile replaces the defaults.
+    Config cfg = load_config(dir / "missing.yaml", dir / "profile.yaml");
+    CHECK(cfg.whisper_model == "small");
+    CHECK(cfg.threads == 6);
+    CHECK_FALSE(cfg.whisper_gpu);
+    CHECK(cfg.vad);
+
+    // Keys the user set win; the rest still come from the profile.
+    write_text_file(dir / "config.yaml",
+                    "transcription:\n  model: medium\n\ngeneral:\n  threads: 2\n");
+    cfg = load_config(dir / "config.yaml", dir / "profile.yaml");
+    CHECK(cfg.whisper_model == "medium");
+    CHECK(cfg.threads == 2);
+    CHECK_FALSE(cfg.whisper_gpu);
+
+    // An explicit path is read without any profile.
+    cfg = load_config(dir / "config.yaml");
+    CHECK(cfg.whisper_gpu);
+
+    fs::remove_all(dir);
+}
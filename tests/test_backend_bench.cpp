@@ -0,0 +1,108 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "backend_bench.h"
+#include "test_tmpdir.h"
+
+#include <fstream>
+#include <stdexcept>
+
+using namespace recmeet;
+
+namespace {
+
+fs::path write_model(const fs::path& dir, const std::string& name, const std::string& data) {
+    fs::create_directories(dir);
+    fs::path p = dir / name;
+    std::ofstream(p, std::ios::binary) << data;
+    return p;
+}
+
+} // anonymous namespace
+
+TEST_CASE("model_fingerprint: follows the content, not the name", "[backend_bench]") {
+    fs::path dir = recmeet::test::tmp_path("recmeet_test_bench_fp");
+    const std::string big(3 << 20, 'w');
+    const auto a = write_model(dir, "a.bin", big);
+    const auto b = write_model(dir, "b.bin", big);
+    CHECK(model_fingerprint(a) == model_fingerprint(b));
+    CHECK(model_fingerprint(a).size() == 64);
+
+    // A changed tail or a changed size is a different model.
+    std::string tail = big;
+    tail.back() = 'x';
+    CHECK(model_fingerprint(write_model(dir, "c.bin", tail)) != model_fingerprint(a));
+    CHECK(model_fingerprint(write_model(dir, "d.bin", big + "w")) != model_fingerprint(a));
+    CHECK(model_fingerprint(write_model(dir, "e.bin", "tiny")) !=
+          model_fingerprint(write_model(dir, "f.bin", "tinY")));
+    CHECK_THROWS_AS(model_fingerprint(dir / "missing.bin"), RecmeetError);
+    fs::remove_all(dir);
+}
+
+TEST_CASE("store_backend_bench: one entry per model and device", "[backend_bench]") {
+    fs::path dir = recmeet::test::tmp_path("recmeet_test_bench_store");
+    const fs::path file = dir / "backend_bench.ndjson";
+    BackendBench out;
+    CHECK_FALSE(find_backend_bench(file, "fp1", "Vulkan|iGPU|6.8", out));
+
+    store_backend_bench(file, {"tiny.bin", "fp1", "Vulkan|iGPU|6.8", 1.0, 2.0});
+    store_backend_bench(file, {"tiny.bin", "fp1", "Vulkan|dGPU|6.8", 1.0, 0.25});
+    store_backend_bench(file, {"tiny.bin", "fp1", "Vulkan|iGPU|6.8", 1.5, 0.5});  // replaces
+    REQUIRE(find_backend_bench(file, "fp1", "Vulkan|iGPU|6.8", out));
+    CHECK(out.model == "tiny.bin");
+    CHECK(out.cpu_sec == 1.5);
+    CHECK(out.gpu_sec == 0.5);
+    REQUIRE(find_backend_bench(file, "fp1", "Vulkan|dGPU|6.8", out));
+    CHECK(out.gpu_sec == 0.25);
+    CHECK_FALSE(find_backend_bench(file, "fp2", "Vulkan|iGPU|6.8", out));
+
+    std::ifstream in(file);
+    int lines = 0;
+    for (std::string l; std::getline(in, l);) ++lines;
+    CHECK(lines == 2);
+
+    CHECK(bench_prefers_gpu({"m", "fp", "d", 1.0, 0.4}));
+    CHECK(bench_prefers_gpu({"m", "fp", "d", 1.0, 1.0}));
+    CHECK_FALSE(bench_prefers_gpu({"m", "fp", "d", 1.0, 1.6}));
+    fs::remove_all(dir);
+}
+
+TEST_CASE("choose_gpu_backend: measures once per model and device", "[backend_bench]") {
+    fs::path dir = recmeet::test::tmp_path("recmeet_test_bench_choose");
+    const fs::path file = dir / "backend_bench.ndjson";
+    const auto model = write_model(dir, "ggml-tiny.bin", "fake whisper weights");
+    int timed = 0;
+    // The iGPU case: the CPU wins.
+    auto slow_gpu = [&timed](bool gpu) {
+        ++timed;
+        return gpu ? 2.0 : 1.0;
+    };
+
+    // No GPU device: the CPU, without measuring.
+    CHECK_FALSE(choose_gpu_backend(model, "", slow_gpu, false, file));
+    CHECK(timed == 0);
+    // Nothing cached yet and asked not to measure: the GPU, as before.
+    CHECK(choose_gpu_backend(model, "Vulkan|iGPU|6.8", slow_gpu, true, file));
+    CHECK(timed == 0);
+
+    CHECK_FALSE(choose_gpu_backend(model, "Vulkan|iGPU|6.8", slow_gpu, false, file));
+    CHECK(timed == 2);
+    CHECK_FALSE(choose_gpu_backend(model, "Vulkan|iGPU|6.8", slow_gpu, false, file));
+    CHECK_FALSE(choose_gpu_backend(model, "Vulkan|iGPU|6.8", slow_gpu, true, file));
+    CHECK(timed == 2);
+
+    // A new driver measures again.
+    CHECK(choose_gpu_backend(model, "Vulkan|iGPU|6.9", [&timed](bool gpu) {
+        ++timed;
+        return gpu ? 0.5 : 1.0;
+    }, false, file));
+    CHECK(timed == 4);
+
+    // A failed measurement keeps the GPU and is tried again next time.
+    auto failing = [](bool) -> double { throw std::runtime_error("no VRAM"); };
+    CHECK(choose_gpu_backend(model, "Vulkan|dGPU|6.8", failing, false, file));
+    BackendBench out;
+    CHECK_FALSE(find_backend_bench(file, model_fingerprint(model), "Vulkan|dGPU|6.8", out));
+    fs::remove_all(dir);
+}
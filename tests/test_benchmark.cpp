@@ -4,24 +4,34 @@
 #include <catch2/catch_test_macros.hpp>
 #include "test_helpers.h"
 #include "test_progress_phase.h"
+#include "caption_engine.h"
+#include "cpu_topology.h"
 #include "diarize.h"
 #include "speaker_id.h"
 #include "transcribe.h"
 #include "vad.h"
 #include "summarize.h"
+#include "model_cache.h"
 #include "model_manager.h"
 #include "audio_file.h"
 #include "util.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <fstream>
+#include <mutex>
+#include <random>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 using namespace recmeet;
 using namespace recmeet::test_helpers;
 
@@ -79,6 +89,7 @@ TEST_CASE("Transcribe debate audio with whisper base", "[benchmark]") {
     fprintf(stderr, "  WER: %.1f%%\n", wer * 100.0);
     fprintf(stderr, "  Time: %.1fs\n", secs);
 
+    const double audio_secs = probe_audio_duration_sec(audio_path).value_or(0.0);
     char buf[512];
     snprintf(buf, sizeof(buf),
         "\n      \"test\": \"whisper_transcription\","
@@ -87,8 +98,10 @@ TEST_CASE("Transcribe debate audio with whisper base", "[benchmark]") {
         "\n      \"ref_words\": %zu,"
         "\n      \"hyp_words\": %zu,"
         "\n      \"segments\": %zu,"
-        "\n      \"time_secs\": %.1f",
-        wer, ref_words.size(), hyp_words.size(), result.segments.size(), secs);
+        "\n      \"time_secs\": %.1f,"
+        "\n      \"rtf\": %.4f",
+        wer, ref_words.size(), hyp_words.size(), result.segments.size(), secs,
+        audio_secs > 0 ? secs / audio_secs : 0.0);
     BenchmarkResults::add(buf);
 
     CHECK(wer < 0.40);
@@ -442,6 +455,53 @@ TEST_CASE("SpeakerEmbeddingSession: back-to-back calls deterministic",
     }
 }
 
+// A batch run concurrently on one session (16 threads -> 4 calls at once)
+// must give every cluster the embedding a lone call gives it: the streams
+// share the extractor but nothing else.
+TEST_CASE("extract_speaker_embeddings: batch matches one call per cluster",
+          "[benchmark][t2-0b]") {
+    fs::path root = find_project_root();
+    if (root.empty())
+        SKIP("Project root with assets/ not found");
+
+    fs::path audio_path = root / "assets" / "biden_trump_debate_2020.wav";
+    if (!fs::exists(audio_path))
+        SKIP("Reference audio not found: " + audio_path.string());
+    if (!is_sherpa_model_cached())
+        SKIP("Sherpa diarization models not cached");
+
+    auto samples = read_wav_float(audio_path);
+    REQUIRE(!samples.empty());
+
+    auto diar = diarize(samples.data(), samples.size(), 3, 0, 1.18f);
+    REQUIRE(diar.num_speakers >= 2);
+
+    auto model_paths = ensure_sherpa_models();
+    SpeakerEmbeddingSession session(model_paths.embedding, 16);
+    CHECK(session.parallel_streams() == 4);
+
+    std::vector<std::vector<DiarizeSegment>> requests;
+    for (int sid = 0; sid < diar.num_speakers; ++sid)
+        requests.push_back(select_speaker_segments(diar, sid, 0.0));
+    requests.push_back({});  // nothing to embed
+    int started = 0;
+    std::mutex started_mu;
+    auto batch = extract_speaker_embeddings(
+        session, MemorySampleSource(samples.data(), samples.size()), requests, [&] {
+            std::lock_guard<std::mutex> lock(started_mu);
+            ++started;
+        });
+
+    REQUIRE(batch.size() == requests.size());
+    CHECK(started == static_cast<int>(requests.size()));
+    CHECK(batch.back().empty());
+    for (int sid = 0; sid < diar.num_speakers; ++sid) {
+        auto single = extract_speaker_embedding(
+            session, samples.data(), samples.size(), diar, sid);
+        CHECK(batch[sid] == single);
+    }
+}
+
 // `ComputeEmbedding` returns *raw* model output, not L2-normalized. T2.1's
 // stitching threshold (cosine similarity ≥ 0.6 on unit vectors) only holds
 // if callers normalize first — this test codifies the spike finding as an
@@ -502,33 +562,6 @@ TEST_CASE("extract_speaker_embedding: raw output not unit-norm",
 
 namespace {
 
-// Run `fn` while a background thread polls /proc/self/statm at 1 Hz and
-// tracks the running max. Returns (wall_clock_secs, peak_rss_kb).
-template <typename Fn>
-std::pair<double, long> measure_with_rss(Fn&& fn) {
-    std::atomic<bool> stop{false};
-    std::atomic<long> peak{0};
-    // Seed with the entry-point reading so we always report at least the
-    // current RSS, even if `fn` returns in under 1 second.
-    long seed = read_self_rss_kb();
-    peak.store(seed);
-    std::thread sampler([&]() {
-        while (!stop.load(std::memory_order_relaxed)) {
-            long now_kb = read_self_rss_kb();
-            long prev = peak.load(std::memory_order_relaxed);
-            while (now_kb > prev &&
-                   !peak.compare_exchange_weak(prev, now_kb)) {}
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-        }
-    });
-    auto t0 = std::chrono::steady_clock::now();
-    fn();
-    auto t1 = std::chrono::steady_clock::now();
-    stop.store(true);
-    sampler.join();
-    return {std::chrono::duration<double>(t1 - t0).count(), peak.load()};
-}
-
 // Simple 16 kHz mono synthetic audio: alternating sine wave + silence to
 // give the diarizer something to segment. Roughly mimics the structure of
 // the existing assets without bringing in a 30-min recording.
@@ -823,9 +856,303 @@ TEST_CASE("VAD+Whisper vs plain Whisper transcription", "[benchmark]") {
     // VAD should not significantly degrade WER
     CHECK(vad_wer < 0.50);
 }
+
+TEST_CASE("Parallel VAD-segment transcription vs sequential", "[benchmark]") {
+    fs::path root = find_project_root();
+    if (root.empty())
+        SKIP("Project root with assets/ not found");
+
+    fs::path audio_path = root / "assets" / "biden_trump_debate_2020.wav";
+    if (!fs::exists(audio_path))
+        SKIP("Reference audio not found: " + audio_path.string());
+    if (!is_whisper_model_cached("base"))
+        SKIP("Whisper base model not cached");
+    if (!is_vad_model_cached())
+        SKIP("Silero VAD model not cached");
+
+    auto samples = read_wav_float(audio_path);
+    REQUIRE(!samples.empty());
+    MemorySampleSource audio(samples.data(), samples.size());
+
+    auto vad_result = detect_speech(audio);
+    REQUIRE(!vad_result.segments.empty());
+    std::vector<TranscribeWindow> windows;
+    for (const auto& seg : vad_result.segments)
+        windows.push_back({static_cast<size_t>(seg.start_sample),
+                           static_cast<size_t>(seg.end_sample - seg.start_sample)});
+
+    WhisperModel model(ensure_whisper_model("base"));
+    TranscribeOptions opts;
+    opts.language = "en";
+    opts.threads = default_thread_count();
+    const int workers = std::max(2, resolve_transcribe_workers(0, opts.threads, windows.size()));
+
+    recmeet::test::PhaseEcho echo;
+    echo("transcribing (1 worker)");
+    auto t0 = std::chrono::steady_clock::now();
+    auto seq = transcribe_windows(model, audio, windows, 1, opts);
+    auto t1 = std::chrono::steady_clock::now();
+    echo("transcribing (parallel)");
+    int last_pct = -1;
+    bool monotonic = true;
+    opts.on_progress = [&](int pct) {
+        if (pct < last_pct) monotonic = false;
+        last_pct = pct;
+    };
+    auto par = transcribe_windows(model, audio, windows, workers, opts);
+    auto t2 = std::chrono::steady_clock::now();
+    echo("transcribing done");
+
+    double seq_secs = std::chrono::duration<double>(t1 - t0).count();
+    double par_secs = std::chrono::duration<double>(t2 - t1).count();
+    fprintf(stderr, "\n[benchmark] VAD segments: %zu, sequential %.1fs, "
+            "%d workers %.1fs (%.2fx)\n",
+            windows.size(), seq_secs, workers, par_secs, seq_secs / par_secs);
+
+    char buf[512];
+    snprintf(buf, sizeof(buf),
+        "\n      \"test\": \"parallel_vad_transcription\","
+        "\n      \"model\": \"base\","
+        "\n      \"workers\": %d,"
+        "\n      \"sequential_secs\": %.1f,"
+        "\n      \"parallel_secs\": %.1f",
+        workers, seq_secs, par_secs);
+    BenchmarkResults::add(buf);
+
+    // Results come back in timestamp order and agree with the sequential
+    // pass (thread-count differences may flip the odd token).
+    for (size_t i = 1; i < par.segments.size(); ++i)
+        CHECK(par.segments[i].start >= par.segments[i - 1].start);
+    std::string seq_text, par_text;
+    for (const auto& s : seq.segments) seq_text += s.text + " ";
+    for (const auto& s : par.segments) par_text += s.text + " ";
+    CHECK(compute_wer(tokenize_words(seq_text), tokenize_words(par_text)) < 0.05);
+    CHECK(monotonic);
+    CHECK(last_pct == 100);
+}
+
+TEST_CASE("Packed VAD windows vs per-segment transcription", "[benchmark]") {
+    fs::path root = find_project_root();
+    if (root.empty())
+        SKIP("Project root with assets/ not found");
+
+    fs::path audio_path = root / "assets" / "biden_trump_debate_2020.wav";
+    fs::path ref_path   = root / "assets" / "biden_trump_debate_2020.md";
+    if (!fs::exists(audio_path) || !fs::exists(ref_path))
+        SKIP("Reference audio/transcript not found under " + root.string());
+    if (!is_whisper_model_cached("base"))
+        SKIP("Whisper base model not cached");
+    if (!is_vad_model_cached())
+        SKIP("Silero VAD model not cached");
+
+    std::ifstream ref_file(ref_path);
+    std::string ref_md((std::istreambuf_iterator<char>(ref_file)),
+                        std::istreambuf_iterator<char>());
+    auto ref_words = tokenize_words(strip_reference_transcript(ref_md));
+    REQUIRE(!ref_words.empty());
+
+    auto samples = read_wav_float(audio_path);
+    REQUIRE(!samples.empty());
+    MemorySampleSource audio(samples.data(), samples.size());
+
+    auto vad_result = detect_speech(audio);
+    std::vector<TranscribeWindow> windows;
+    for (const auto& seg : vad_result.segments)
+        windows.push_back({static_cast<size_t>(seg.start_sample),
+                           static_cast<size_t>(seg.end_sample - seg.start_sample)});
+    auto packed = pack_windows(windows);
+    REQUIRE(!packed.empty());
+
+    WhisperModel model(ensure_whisper_model("base"));
+    TranscribeOptions opts;
+    opts.language = "en";
+
+    auto words_of = [](const TranscriptResult& r) {
+        std::string text;
+        for (const auto& s : r.segments) text += s.text + " ";
+        return tokenize_words(text);
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto per_seg = transcribe_windows(model, audio, windows, 1, opts);
+    auto t1 = std::chrono::steady_clock::now();
+    auto pack = transcribe_windows(model, audio, packed, 1, opts);
+    auto t2 = std::chrono::steady_clock::now();
+
+    double seg_secs = std::chrono::duration<double>(t1 - t0).count();
+    double pack_secs = std::chrono::duration<double>(t2 - t1).count();
+    double seg_wer = compute_wer(ref_words, words_of(per_seg));
+    double pack_wer = compute_wer(ref_words, words_of(pack));
+    fprintf(stderr, "\n[benchmark] %zu VAD segments -> %zu packed windows: "
+            "per-segment %.1fs (WER %.1f%%), packed %.1fs (WER %.1f%%, %.2fx)\n",
+            windows.size(), packed.size(), seg_secs, seg_wer * 100.0,
+            pack_secs, pack_wer * 100.0, seg_secs / pack_secs);
+
+    char buf[512];
+    snprintf(buf, sizeof(buf),
+        "\n      \"test\": \"packed_vad_windows\","
+        "\n      \"model\": \"base\","
+        "\n      \"segments\": %zu,"
+        "\n      \"windows\": %zu,"
+        "\n      \"per_segment_secs\": %.1f,"
+        "\n      \"packed_secs\": %.1f,"
+        "\n      \"per_segment_wer\": %.4f,"
+        "\n      \"packed_wer\": %.4f",
+        windows.size(), packed.size(), seg_secs, pack_secs, seg_wer, pack_wer);
+    BenchmarkResults::add(buf);
+
+    CHECK(packed.size() <= windows.size());
+    for (size_t i = 1; i < pack.segments.size(); ++i)
+        CHECK(pack.segments[i].start >= pack.segments[i - 1].start);
+    CHECK(pack_wer < seg_wer + 0.05);
+}
 #endif
 
+TEST_CASE("merge_speakers: interval index vs linear scan at 4-hour scale", "[benchmark]") {
+    // A 4-hour meeting: ~3 s whisper segments and ~4 s speaker turns, with
+    // the occasional overlapping turn a chunk boundary leaves behind.
+    constexpr double kMeetingSec = 4 * 3600.0;
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<double> turn(1.0, 7.0), word(1.0, 5.0);
+    std::uniform_int_distribution<int> speaker(0, 7), coin(0, 19);
+
+    DiarizeResult diar;
+    for (double t = 0.0; t < kMeetingSec;) {
+        const double start = coin(rng) == 0 ? t - 2.0 : t;
+        const double end = start + turn(rng);
+        diar.segments.push_back({start, end, speaker(rng)});
+        t = end;
+    }
+    std::vector<TranscriptSegment> transcript;
+    for (double t = 0.0; t < kMeetingSec;) {
+        const double end = t + word(rng);
+        transcript.push_back({t, end, "text"});
+        t = end;
+    }
+
+    // The previous O(T x D) implementation, kept here as the baseline.
+    auto linear = [&] {
+        std::vector<TranscriptSegment> out;
+        out.reserve(transcript.size());
+        for (const auto& seg : transcript) {
+            int best_speaker = 0;
+            double best_overlap = 0.0;
+            for (const auto& d : diar.segments) {
+                double overlap = std::min(seg.end, d.end) - std::max(seg.start, d.start);
+                if (overlap > best_overlap) {
+                    best_overlap = overlap;
+                    best_speaker = d.speaker;
+                }
+            }
+            TranscriptSegment o = seg;
+            o.text = format_speaker(best_speaker) + ": " + seg.text;
+            out.push_back(std::move(o));
+        }
+        return out;
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto baseline = linear();
+    auto t1 = std::chrono::steady_clock::now();
+    constexpr int kIndexedRuns = 10;
+    std::vector<TranscriptSegment> indexed;
+    for (int i = 0; i < kIndexedRuns; ++i) indexed = merge_speakers(transcript, diar);
+    auto t2 = std::chrono::steady_clock::now();
+
+    double linear_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double indexed_ms =
+        std::chrono::duration<double, std::milli>(t2 - t1).count() / kIndexedRuns;
+    fprintf(stderr, "\n[benchmark] merge_speakers, %zu transcript x %zu diarization segments: "
+            "linear %.1f ms, indexed %.2f ms (%.0fx)\n",
+            transcript.size(), diar.segments.size(), linear_ms, indexed_ms,
+            linear_ms / indexed_ms);
+
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+        "\n      \"test\": \"merge_speakers_4h\","
+        "\n      \"transcript_segments\": %zu,"
+        "\n      \"diarization_segments\": %zu,"
+        "\n      \"linear_ms\": %.2f,"
+        "\n      \"indexed_ms\": %.3f",
+        transcript.size(), diar.segments.size(), linear_ms, indexed_ms);
+    BenchmarkResults::add(buf);
+
+    REQUIRE(indexed.size() == baseline.size());
+    for (size_t i = 0; i < baseline.size(); ++i)
+        CHECK(indexed[i].text == baseline[i].text);
+    CHECK(indexed_ms < linear_ms);
+}
+
 #if RECMEET_USE_LLAMA
+// With the model cache on, the first summary leaves the system prompt's
+// KV cells with the resident model and the second restores them.
+TEST_CASE("summarize_local: resident model reuses the system prompt", "[benchmark]") {
+    fs::path llm_dir = models_dir() / "llama";
+    fs::path llm_model;
+    if (fs::is_directory(llm_dir)) {
+        for (const auto& entry : fs::directory_iterator(llm_dir)) {
+            if (entry.path().extension() == ".gguf") {
+                llm_model = entry.path();
+                break;
+            }
+        }
+    }
+    if (llm_model.empty())
+        SKIP("No LLM .gguf model found in " + llm_dir.string());
+
+    const std::string transcript =
+        "[00:00:01] Speaker_01: Let's ship the release on Friday.\n"
+        "[00:00:05] Speaker_02: Agreed, I'll write the notes by Thursday.\n";
+
+    set_model_cache_enabled(true);
+    auto first = summarize_local(transcript, llm_model);
+    const size_t cached = local_summary_prefix_tokens();
+    auto second = summarize_local(transcript + "[00:00:09] Speaker_01: Thanks.\n", llm_model);
+    CHECK(local_summary_prefix_tokens() == cached);
+    set_model_cache_enabled(false);
+
+    CHECK(!first.empty());
+    CHECK(!second.empty());
+    CHECK(cached > 0);
+}
+
+// RECMEET_BENCH_DRAFT_MODEL names a small GGUF of the same family as the
+// first model in the llama directory.
+TEST_CASE("summarize_local: a draft model speeds up generation", "[benchmark]") {
+    const char* draft = std::getenv("RECMEET_BENCH_DRAFT_MODEL");
+    if (!draft) SKIP("RECMEET_BENCH_DRAFT_MODEL not set");
+    fs::path llm_dir = models_dir() / "llama";
+    fs::path llm_model;
+    if (fs::is_directory(llm_dir)) {
+        for (const auto& entry : fs::directory_iterator(llm_dir)) {
+            if (entry.path().extension() == ".gguf" && entry.path() != fs::path(draft)) {
+                llm_model = entry.path();
+                break;
+            }
+        }
+    }
+    if (llm_model.empty())
+        SKIP("No LLM .gguf model found in " + llm_dir.string());
+
+    const std::string transcript =
+        "[00:00:01] Speaker_01: Let's ship the release on Friday.\n"
+        "[00:00:05] Speaker_02: Agreed, I'll write the notes by Thursday.\n"
+        "[00:00:09] Speaker_01: Marco owns the migration script.\n";
+
+    auto start = std::chrono::steady_clock::now();
+    auto plain = summarize_local(transcript, llm_model);
+    const double plain_s = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    auto drafted = summarize_local(transcript, llm_model, "", 0, false, 0, nullptr, draft);
+    const double draft_s = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    CHECK(!plain.empty());
+    CHECK(!drafted.empty());
+    WARN("plain " << plain_s << " s, with draft " << draft_s << " s");
+}
+
 TEST_CASE("Summarize reference transcript with local LLM", "[benchmark]") {
     fs::path root = find_project_root();
     if (root.empty())
@@ -976,3 +1303,132 @@ TEST_CASE("Full pipeline: whisper transcribe then LLM summarize", "[benchmark]")
     CHECK(summary.find("Participants") != std::string::npos);
 }
 #endif
+
+#if RECMEET_USE_SHERPA
+// ---------------------------------------------------------------------------
+// Caption latency beside a postprocessing load
+// ---------------------------------------------------------------------------
+//
+// The load stands in for a postprocessing child: a forked process with one
+// spinning thread per hardware thread, as whisper and ONNX run. Captions
+// are measured without it, beside it at normal priority, and beside it at
+// the SCHED_IDLE the daemon gives postprocessing while a meeting records
+// (cpu_topology.h). RECMEET_CPU_ISOLATION_SECS sets the audio per run
+// (default 30).
+
+namespace {
+
+pid_t start_cpu_load(int threads) {
+    const pid_t pid = fork();
+    if (pid == 0) {
+        auto spin = [] { for (volatile uint64_t x = 0;; x = x + 1) {} };
+        for (int i = 1; i < threads; ++i) std::thread(spin).detach();
+        spin();
+    }
+    for (int i = 0; pid > 0 && i < 200 && list_process_threads(pid).size() < size_t(threads); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return pid;
+}
+
+void stop_cpu_load(pid_t pid) {
+    if (pid <= 0) return;
+    kill(pid, SIGKILL);
+    waitpid(pid, nullptr, 0);
+}
+
+struct CaptionRun {
+    CaptionStats stats;
+    size_t overruns = 0;
+};
+
+// Feed `pcm` in 20 ms chunks at real-time pace, as the capture thread
+// would, then stop the engine and return its latencies.
+CaptionRun run_captions(const CaptionEngine::Options& opts, const std::vector<int16_t>& pcm) {
+    CaptionRun run;
+    CaptionEngine eng;
+    auto on_result = [](const CaptionResult&, void*) {};
+    auto on_degraded = [](CaptionDegradedReason, void* ud) { ++*static_cast<size_t*>(ud); };
+    REQUIRE(eng.start(opts, on_result, nullptr, on_degraded, &run.overruns));
+    constexpr size_t CHUNK = SAMPLE_RATE / 50;
+    auto next = std::chrono::steady_clock::now();
+    for (size_t off = 0; off < pcm.size(); off += CHUNK) {
+        CaptionEngine::on_audio_chunk(pcm.data() + off, std::min(CHUNK, pcm.size() - off), &eng);
+        next += std::chrono::milliseconds(20);
+        std::this_thread::sleep_until(next);
+    }
+    // Let the last chunk's results come out before reading.
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    run.stats = eng.stats();
+    eng.stop();
+    return run;
+}
+
+void add_caption_result(const char* test, const CaptionRun& r, int load_threads) {
+    fprintf(stderr, "  %-28s partial p50/p95 %4lld/%4lld ms, final p95 %4lld ms, "
+            "ring p95 %4lld ms, %zu overrun(s)\n", test,
+            (long long)r.stats.partial_ms.p50, (long long)r.stats.partial_ms.p95,
+            (long long)r.stats.final_ms.p95, (long long)r.stats.ring_ms.p95, r.overruns);
+    char buf[512];
+    snprintf(buf, sizeof(buf),
+        "\n      \"test\": \"%s\","
+        "\n      \"load_threads\": %d,"
+        "\n      \"partials\": %llu,"
+        "\n      \"partial_p50_ms\": %lld,"
+        "\n      \"partial_p95_ms\": %lld,"
+        "\n      \"final_p95_ms\": %lld,"
+        "\n      \"ring_p95_ms\": %lld,"
+        "\n      \"overruns\": %zu",
+        test, load_threads, (unsigned long long)r.stats.partial_ms.count,
+        (long long)r.stats.partial_ms.p50, (long long)r.stats.partial_ms.p95,
+        (long long)r.stats.final_ms.p95, (long long)r.stats.ring_ms.p95, r.overruns);
+    BenchmarkResults::add(buf);
+}
+
+} // anonymous namespace
+
+TEST_CASE("Caption latency beside a postprocessing load", "[benchmark][cpu-isolation]") {
+    fs::path root = find_project_root();
+    if (root.empty())
+        SKIP("Project root with assets/ not found");
+    fs::path audio_path = root / "assets" / "biden_trump_debate_2020.wav";
+    if (!fs::exists(audio_path))
+        SKIP("Reference audio not found: " + audio_path.string());
+    if (!is_caption_model_cached(""))
+        SKIP("Caption model not cached — run: ./build/recmeet --caption-model en-2023-06-26 --download-models");
+
+    double secs = 30;
+    if (const char* env = std::getenv("RECMEET_CPU_ISOLATION_SECS")) secs = std::max(5.0, std::atof(env));
+    const auto audio = read_wav_float(audio_path);
+    std::vector<int16_t> pcm(std::min(audio.size(), static_cast<size_t>(secs * SAMPLE_RATE)));
+    for (size_t i = 0; i < pcm.size(); ++i)
+        pcm[i] = static_cast<int16_t>(std::lrint(std::clamp(audio[i], -1.0f, 1.0f) * 32767.0f));
+
+    CaptionEngine::Options opts;
+    opts.model_dir = caption_model_dir("").string();
+    opts.keep_warm = true;  // one model load for the three runs
+    REQUIRE(CaptionEngine::prewarm(opts));
+    const int load_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    fprintf(stderr, "\n[benchmark] Caption latency beside %d spinning thread(s), %.0f s each:\n",
+            load_threads, pcm.size() / double(SAMPLE_RATE));
+    const CaptionRun idle = run_captions(opts, pcm);
+
+    pid_t load = start_cpu_load(load_threads);
+    REQUIRE(load > 0);
+    const CaptionRun loaded = run_captions(opts, pcm);
+
+    const CpuPriorityChange yielded_threads = set_process_cpu_priority(load, PpCpuPriority::Yield);
+    const CaptionRun yielded = run_captions(opts, pcm);
+    stop_cpu_load(load);
+    CaptionEngine::drop_warm();
+
+    add_caption_result("caption_latency_idle", idle, 0);
+    add_caption_result("caption_latency_load", loaded, load_threads);
+    add_caption_result("caption_latency_load_yield", yielded, load_threads);
+
+    CHECK(yielded_threads.threads == load_threads);
+    CHECK(idle.stats.partial_ms.count > 0);
+    // Yielding must leave captions no worse off than the unyielded load.
+    CHECK(yielded.stats.partial_ms.p95 <= loaded.stats.partial_ms.p95 + idle.stats.partial_ms.p95);
+}
+#endif
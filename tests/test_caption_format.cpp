@@ -116,6 +116,12 @@ TEST_CASE("format_caption_for_cli: normalize=false passes raw",
             == "[captions] (final)   HELLO WORLD");
 }
 
+TEST_CASE("format_caption_for_cli: source label precedes the text",
+          "[caption-format]") {
+    REQUIRE(format_caption_for_cli("HELLO", false, true, "monitor")
+            == "[captions] (final)   monitor: Hello");
+}
+
 TEST_CASE("format_caption_degraded_for_cli: prefix shape",
           "[caption-format]") {
     REQUIRE(format_caption_degraded_for_cli("buffer_overrun")
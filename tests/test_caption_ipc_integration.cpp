@@ -167,8 +167,9 @@ struct CaptionDaemonSim {
                     std::string text = r.text;
                     bool ip = r.is_partial;
                     int64_t ts = r.timestamp_ms;
-                    s->post([s, jid, text, ip, ts]() {
-                        s->broadcast(make_caption_event(jid, text, ip, ts));
+                    std::string source = caption_source_name(r.source);
+                    s->post([s, jid, text, ip, ts, source]() {
+                        s->broadcast(make_caption_event(jid, text, ip, ts, source));
                     });
                 };
                 hooks.on_degraded = +[](CaptionDegradedReason reason, void* ud) {
@@ -400,7 +401,7 @@ TEST_CASE("caption events received with correct job_id",
     REQUIRE(sim.hooks.on_result != nullptr);
 
     CaptionResult r1{"HELLO", true, 100};
-    CaptionResult r2{"HELLO WORLD", false, 350};
+    CaptionResult r2{"HELLO WORLD", false, 350, CaptionSource::Monitor};
     sim.hooks.on_result(r1, sim.hooks.result_ud);
     sim.hooks.on_result(r2, sim.hooks.result_ud);
 
@@ -412,6 +413,7 @@ TEST_CASE("caption events received with correct job_id",
         if (e.event != "caption") continue;
         ++seen;
         CHECK(json_val_as_int(e.data["job_id"]) == job_id);
+        CHECK(json_val_as_string(e.data["source"]) == (seen == 1 ? "mic" : "monitor"));
     }
     CHECK(seen == 2);
 
@@ -875,6 +877,39 @@ struct CaptionChannelTestFixture {
 
 } // anonymous namespace
 
+TEST_CASE_METHOD(CaptionChannelTestFixture,
+                 "published caption engine stats flatten into status fields",
+                 "[caption-ipc]") {
+    CaptionStats out;
+    CHECK_FALSE(caption_engine_stats(out));
+
+    CaptionEngine eng;  // not started: stats are all zero
+    publish_caption_engine(&eng);
+    REQUIRE(caption_engine_stats(out));
+    CHECK(out.partial_ms.count == 0);
+    publish_caption_engine(nullptr);
+    CHECK_FALSE(caption_engine_stats(out));
+
+    CaptionStats st;
+    st.partial_ms = {10, 180, 420, 900, 1200};
+    st.final_ms.count = 2;
+    st.ring_capacity_ms = 2048;
+    JsonMap data;
+    add_caption_stats(data, st);
+    CHECK(json_val_as_int(data["caption_partial_count"]) == 10);
+    CHECK(json_val_as_int(data["caption_partial_p50_ms"]) == 180);
+    CHECK(json_val_as_int(data["caption_partial_p95_ms"]) == 420);
+    CHECK(json_val_as_int(data["caption_partial_p99_ms"]) == 900);
+    CHECK(json_val_as_int(data["caption_partial_max_ms"]) == 1200);
+    CHECK(json_val_as_int(data["caption_final_count"]) == 2);
+    CHECK(data.count("caption_ring_p95_ms") == 1);
+    CHECK(json_val_as_int(data["caption_ring_capacity_ms"]) == 2048);
+
+    publish_caption_engine(&eng);
+    reset_caption_start_channel();
+    CHECK_FALSE(caption_engine_stats(out));
+}
+
 TEST_CASE_METHOD(CaptionChannelTestFixture,
                  "captions.start_engine returns NotRecording when idle",
                  "[caption-ipc]") {
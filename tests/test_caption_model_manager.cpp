@@ -20,6 +20,7 @@
 #include "test_tmpdir.h"
 #include "util.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
@@ -142,6 +143,39 @@ TEST_CASE("known_caption_models: includes default + small variants",
     CHECK(names.size() >= 2);
 }
 
+TEST_CASE("known_caption_models: each model has an int8 variant sharing its files",
+          "[caption-model-manager]") {
+    auto names = known_caption_models();
+    for (const char* base : {"en-2023-06-26", "en-small"}) {
+        const std::string variant = std::string(base) + "-int8";
+        CHECK(std::find(names.begin(), names.end(), variant) != names.end());
+        CHECK(caption_model_is_int8(variant));
+        CHECK_FALSE(caption_model_is_int8(base));
+        CHECK(caption_model_int8_variant(base) == variant);
+        CHECK(caption_model_int8_variant(variant) == variant);
+        CHECK(caption_model_dir(variant) == caption_model_dir(base));
+        CHECK(caption_model_size_hint(variant) == caption_model_size_hint(base));
+    }
+    CHECK(caption_model_int8_variant("") == "en-2023-06-26-int8");
+    CHECK(caption_model_int8_variant("not-a-real-model").empty());
+}
+
+TEST_CASE("is_caption_model_cached: an int8 variant needs the int8 weights",
+          "[caption-model-manager]") {
+    // Uses the real en-small directory; leave an operator's cached copy be.
+    if (fs::exists(caption_model_dir("en-small"))) {
+        SUCCEED("en-small directory exists on this host — skip");
+        return;
+    }
+    CaptionModelFixture fx("en-small");
+    CHECK(is_caption_model_cached("en-small"));
+    CHECK_FALSE(is_caption_model_cached("en-small-int8"));
+    for (const char* kind : {"encoder", "decoder", "joiner"})
+        CaptionModelFixture::write_file(
+            fx.dir / (std::string(kind) + "-epoch-99-avg-1.int8.onnx"), "fake-int8");
+    CHECK(is_caption_model_cached("en-small-int8"));
+}
+
 TEST_CASE("caption_model_size_hint: returns hint for known models",
           "[caption-model-manager]") {
     CHECK_FALSE(caption_model_size_hint("en-2023-06-26").empty());
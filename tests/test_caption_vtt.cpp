@@ -15,6 +15,7 @@
 #include "test_tmpdir.h"
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <filesystem>
@@ -25,6 +26,8 @@
 #include <thread>
 #include <vector>
 
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 using namespace recmeet;
@@ -120,6 +123,11 @@ TEST_CASE("format_vtt_cue: arrow-in-text is escaped", "[caption-vtt]") {
     REQUIRE(count_substr(body, "--&gt;") == 3);
 }
 
+TEST_CASE("format_vtt_cue: voice span names the source", "[caption-vtt]") {
+    std::string cue = format_vtt_cue(0, 500, "HELLO", "mic");
+    REQUIRE(cue == "00:00:00.000 --> 00:00:00.500\n<v mic>HELLO\n\n");
+}
+
 TEST_CASE("format_vtt_cue: empty text", "[caption-vtt]") {
     // Empty text still emits the timestamp header + a blank body line + the
     // terminator. Parsers tolerate this; in practice the daemon never
@@ -158,6 +166,41 @@ TEST_CASE("VttCueTimer: regression clamps to non-negative duration", "[caption-v
     REQUIRE(p.second == 800);
 }
 
+TEST_CASE("parse_vtt_timestamp: both WebVTT forms, garbage rejected", "[caption-vtt]") {
+    CHECK(parse_vtt_timestamp("00:00:01.240") == 1240);
+    CHECK(parse_vtt_timestamp("01:02:03.004") == 3723004);
+    CHECK(parse_vtt_timestamp("100:00:00.000") == 360000000);
+    CHECK(parse_vtt_timestamp("02:03.500") == 123500);
+    CHECK(parse_vtt_timestamp(format_vtt_timestamp(49900)) == 49900);
+    CHECK(parse_vtt_timestamp("") == -1);
+    CHECK(parse_vtt_timestamp("00:00:01") == -1);
+    CHECK(parse_vtt_timestamp("00:61:00.000") == -1);
+    CHECK(parse_vtt_timestamp("00:00:01.24") == -1);
+    CHECK(parse_vtt_timestamp("1:2:3:4.000") == -1);
+}
+
+TEST_CASE("parse_vtt_cues: reads back what the writer formats", "[caption-vtt]") {
+    std::string doc = "WEBVTT\n\n";
+    doc += format_vtt_cue(0, 1500, "Hello --> there", "mic");
+    doc += format_vtt_cue(1500, 2750, "Second cue");
+    doc += "cue-3\r\n00:00:03.000 --> 00:00:04.000 align:start\r\ntwo\r\nlines\r\n\r\n";
+    doc += "00:00:05.000 --> 00:00:06.000\n\n";   // no text
+    doc += "00:00:07.000 --> 00:00";               // truncated mid-write
+
+    auto cues = parse_vtt_cues(doc);
+    REQUIRE(cues.size() == 3);
+    CHECK(cues[0].start_ms == 0);
+    CHECK(cues[0].end_ms == 1500);
+    CHECK(cues[0].text == "Hello --> there");
+    CHECK(cues[0].voice == "mic");
+    CHECK(cues[1].text == "Second cue");
+    CHECK(cues[1].voice.empty());
+    CHECK(cues[2].start_ms == 3000);
+    CHECK(cues[2].end_ms == 4000);
+    CHECK(cues[2].text == "two lines");
+    CHECK(parse_vtt_cues("WEBVTT\n\n").empty());
+}
+
 // ===========================================================================
 // VttWriter behaviour
 // ===========================================================================
@@ -175,6 +218,7 @@ TEST_CASE("VttWriter: header lazily written on first final", "[caption-vtt]") {
         REQUIRE_FALSE(w._header_written_for_test());
 
         REQUIRE(w.append(0, 500, "HELLO WORLD", /*is_partial=*/false));
+        REQUIRE(w.flush());
         REQUIRE(fs::exists(vtt));
         REQUIRE(w.is_open());
         REQUIRE(w._header_written_for_test());
@@ -202,11 +246,13 @@ TEST_CASE("VttWriter: partials never persisted", "[caption-vtt]") {
     for (int i = 0; i < 5; ++i) {
         REQUIRE(w.append(i * 100, (i + 1) * 100, "PARTIAL", /*is_partial=*/true));
     }
+    REQUIRE(w.flush());
     REQUIRE_FALSE(fs::exists(vtt));
     REQUIRE_FALSE(w._header_written_for_test());
 
     // One final → file is created with header + the one cue.
     REQUIRE(w.append(0, 500, "FIRST FINAL", /*is_partial=*/false));
+    REQUIRE(w.flush());
     REQUIRE(fs::exists(vtt));
 
     std::string c = read_all(vtt);
@@ -315,8 +361,44 @@ TEST_CASE("VttWriter: explicit close() then dtor is safe (idempotent)",
 
     VttWriter w(vtt);
     REQUIRE(w.append(0, 500, "HELLO", false));
+    REQUIRE(w.flush());
     REQUIRE(w.is_open());
     w.close();
     REQUIRE_FALSE(w.is_open());
+    w.close();
+    CHECK_FALSE(w.append(500, 900, "LATE", false));
+    CHECK(read_all(vtt).find("Hello") != std::string::npos);
     // Dtor runs after close — must not fault.
 }
+
+TEST_CASE("VttWriter: a stalled sink never blocks append", "[caption-vtt]") {
+    auto dir = make_tmp_dir("stalled_sink");
+    fs::path vtt = dir / "captions.vtt";
+    // Opening a FIFO for writing blocks until it has a reader: the writer
+    // thread stalls as it would on a hung NFS mount.
+    REQUIRE(::mkfifo(vtt.c_str(), 0600) == 0);
+
+    VttWriter w(vtt, /*normalize_display=*/false);
+    const auto t0 = std::chrono::steady_clock::now();
+    std::size_t accepted = 0;
+    for (int i = 0; i < 400; ++i)
+        if (w.append(i * 100, i * 100 + 90, "CUE " + std::to_string(i), false)) ++accepted;
+    CHECK(std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(500));
+    // The queue, plus the batch the writer may have taken before stalling.
+    CHECK(accepted >= VttWriter::kMaxQueuedCues);
+    CHECK(accepted <= VttWriter::kMaxQueuedCues + 1);
+    CHECK(w.last_error().find("cue dropped") != std::string::npos);
+
+    // Unstall; close() writes everything accepted (< one pipe buffer).
+    int rd = ::open(vtt.c_str(), O_RDONLY | O_NONBLOCK);
+    REQUIRE(rd >= 0);
+    w.close();
+    std::string got;
+    char buf[4096];
+    ssize_t n;
+    while ((n = ::read(rd, buf, sizeof(buf))) > 0) got.append(buf, static_cast<size_t>(n));
+    ::close(rd);
+    CHECK(got.rfind("WEBVTT\n\n", 0) == 0);
+    CHECK(count_substr(got, "-->") == accepted);
+    CHECK(got.find("CUE 0\n") != std::string::npos);
+}
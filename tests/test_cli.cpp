@@ -241,6 +241,93 @@ TEST_CASE("parse_cli: default reset_speakers is false", "[cli]") {
     CHECK(cli.reset_speakers == false);
 }
 
+TEST_CASE("parse_cli: --export-speakers sets the output directory", "[cli]") {
+    CHECK(run_cli({"recmeet"}).export_speakers.empty());
+    auto cli = run_cli({"recmeet", "--export-speakers", "/tmp/spk-json"});
+    CHECK(cli.export_speakers == "/tmp/spk-json");
+}
+
+TEST_CASE("parse_cli: --rerender sets the meeting directory", "[cli]") {
+    CHECK(run_cli({"recmeet"}).rerender_dir.empty());
+    auto cli = run_cli({"recmeet", "--rerender", "meetings/2026-03-09_09-00"});
+    CHECK(cli.rerender_dir == "meetings/2026-03-09_09-00");
+}
+
+TEST_CASE("parse_cli: --trace-out names the trace file", "[cli]") {
+    CHECK(run_cli({"recmeet"}).trace_out.empty());
+    CHECK(run_cli({"recmeet", "--trace-out", "/tmp/run.json"}).trace_out == "/tmp/run.json");
+}
+
+TEST_CASE("parse_cli: --speaker-ann enables approximate speaker search", "[cli]") {
+    CHECK_FALSE(run_cli({"recmeet"}).cfg.speaker_ann);
+    CHECK(run_cli({"recmeet", "--speaker-ann"}).cfg.speaker_ann);
+    CHECK_FALSE(run_cli({"recmeet"}).cfg.speaker_participants_first);
+    CHECK(run_cli({"recmeet", "--speaker-participants"}).cfg.speaker_participants_first);
+    CHECK(run_cli({"recmeet"}).cfg.speaker_embedding_precision == "f32");
+    auto f16 = run_cli({"recmeet", "--embedding-precision", "f16"});
+    CHECK(f16.parse_error.empty());
+    CHECK(f16.cfg.speaker_embedding_precision == "f16");
+    CHECK(run_cli({"recmeet", "--embedding-precision", "fp8"}).parse_error.find(
+              "--embedding-precision") != std::string::npos);
+}
+
+TEST_CASE("parse_cli: --summary-chunk-tokens sets the map-reduce threshold", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.summary_chunk_tokens == 0);
+    CHECK(run_cli({"recmeet", "--summary-chunk-tokens", "6000"}).cfg.summary_chunk_tokens == 6000);
+}
+
+TEST_CASE("parse_cli: --no-summary-compact summarizes the transcript as written", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.summary_compact);
+    CHECK_FALSE(run_cli({"recmeet", "--no-summary-compact"}).cfg.summary_compact);
+}
+
+TEST_CASE("parse_cli: --llm-draft-model names the speculative draft", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.llm_draft_model.empty());
+    CHECK(run_cli({"recmeet", "--llm-draft-model", "/m/draft.gguf"}).cfg.llm_draft_model ==
+          "/m/draft.gguf");
+}
+
+TEST_CASE("parse_cli: --llm-kv-type, --llm-batch and --llm-ubatch set the memory profile",
+          "[cli]") {
+    auto defaults = run_cli({"recmeet"}).cfg;
+    CHECK(defaults.llm_kv_type == "f16");
+    CHECK(defaults.llm_batch == 0);
+    CHECK(defaults.llm_ubatch == 0);
+    auto r = run_cli({"recmeet", "--llm-kv-type", "q4_0", "--llm-batch", "1024",
+                      "--llm-ubatch", "256"});
+    CHECK(r.cfg.llm_kv_type == "q4_0");
+    CHECK(r.cfg.llm_batch == 1024);
+    CHECK(r.cfg.llm_ubatch == 256);
+}
+
+TEST_CASE("parse_cli: --llm-gpu-layers sets the llama offload", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.llm_gpu_layers == -1);
+    CHECK(run_cli({"recmeet", "--llm-gpu-layers", "0"}).cfg.llm_gpu_layers == 0);
+    CHECK(run_cli({"recmeet", "--llm-gpu-layers", "24"}).cfg.llm_gpu_layers == 24);
+}
+
+TEST_CASE("parse_cli: --caption-partial-hz sets the daemon's partial rate", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.caption_partial_hz == 10);
+    CHECK(run_cli({"recmeet", "--caption-partial-hz", "0"}).cfg.caption_partial_hz == 0);
+}
+
+TEST_CASE("parse_cli: --caption-threads and --no-caption-warm tune the recognizer", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.caption_threads == 1);
+    CHECK(run_cli({"recmeet"}).cfg.caption_keep_warm);
+    CHECK(run_cli({"recmeet", "--caption-threads", "2"}).cfg.caption_threads == 2);
+    CHECK_FALSE(run_cli({"recmeet", "--no-caption-warm"}).cfg.caption_keep_warm);
+}
+
+TEST_CASE("parse_cli: --caption-transcript takes the transcript from the captions", "[cli]") {
+    CHECK_FALSE(run_cli({"recmeet"}).cfg.caption_transcript);
+    CHECK(run_cli({"recmeet", "--caption-transcript"}).cfg.caption_transcript);
+}
+
+TEST_CASE("parse_cli: --rolling-summary-minutes sets the rolling interval", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.rolling_summary_minutes == 0);
+    CHECK(run_cli({"recmeet", "--rolling-summary-minutes", "5"}).cfg.rolling_summary_minutes == 5);
+}
+
 TEST_CASE("parse_cli: --log-level sets log level", "[cli]") {
     auto cli = run_cli({"recmeet", "--log-level", "info"});
     CHECK(cli.cfg.log_level_str == "info");
@@ -328,6 +415,188 @@ TEST_CASE("parse_cli: --context-text and --context-file can coexist", "[cli]") {
     CHECK(cli.cfg.context_file == "/tmp/agenda.txt");
 }
 
+TEST_CASE("parse_cli: --audio-archive sets the archive format", "[cli]") {
+    auto cli = run_cli({"recmeet", "--audio-archive", "flac"});
+    CHECK(cli.cfg.audio_archive == "flac");
+    CHECK(cli.parse_error.empty());
+}
+
+TEST_CASE("parse_cli: --audio-archive rejects unknown formats", "[cli]") {
+    auto cli = run_cli({"recmeet", "--audio-archive", "mp3"});
+    CHECK(cli.parse_error.find("--audio-archive") != std::string::npos);
+}
+
+TEST_CASE("parse_cli: --archive-speech-only sets archive_speech_only", "[cli]") {
+    CHECK(run_cli({"recmeet", "--archive-speech-only"}).cfg.archive_speech_only);
+    CHECK_FALSE(run_cli({"recmeet"}).cfg.archive_speech_only);
+}
+
+TEST_CASE("parse_cli: --pp-on-battery takes run, reduce or defer", "[cli]") {
+    auto cli = run_cli({"recmeet", "--pp-on-battery", "defer"});
+    CHECK(cli.cfg.pp_on_battery == "defer");
+    CHECK(cli.parse_error.empty());
+    cli = run_cli({"recmeet", "--pp-on-battery", "eco"});
+    CHECK(cli.parse_error.find("--pp-on-battery") != std::string::npos);
+}
+
+TEST_CASE("parse_cli: --diarize-provider takes auto, cpu, cuda or xnnpack", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.diarize_provider == "auto");
+    auto cli = run_cli({"recmeet", "--diarize-provider", "cuda"});
+    CHECK(cli.cfg.diarize_provider == "cuda");
+    CHECK(cli.parse_error.empty());
+    cli = run_cli({"recmeet", "--diarize-provider", "vulkan"});
+    CHECK(cli.parse_error.find("--diarize-provider") != std::string::npos);
+}
+
+TEST_CASE("parse_cli: --whisper-workers sets the worker count", "[cli]") {
+    auto cli = run_cli({"recmeet", "--whisper-workers", "4"});
+    CHECK(cli.cfg.whisper_workers == 4);
+    CHECK(cli.parse_error.empty());
+}
+
+TEST_CASE("parse_cli: --gpu-devices sets the GPU count", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.whisper_gpu_devices == 1);
+    auto cli = run_cli({"recmeet", "--gpu-devices", "0"});
+    CHECK(cli.cfg.whisper_gpu_devices == 0);
+    CHECK(cli.parse_error.empty());
+}
+
+TEST_CASE("parse_cli: --no-vad-pack disables segment packing", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.vad_pack);
+    CHECK_FALSE(run_cli({"recmeet", "--no-vad-pack"}).cfg.vad_pack);
+}
+
+TEST_CASE("parse_cli: --live-transcribe enables recording-time whisper", "[cli]") {
+    CHECK_FALSE(run_cli({"recmeet"}).cfg.live_transcribe);
+    CHECK(run_cli({"recmeet", "--live-transcribe"}).cfg.live_transcribe);
+    CHECK_FALSE(run_cli({"recmeet"}).cfg.live_diarize);
+    CHECK(run_cli({"recmeet", "--live-diarize"}).cfg.live_diarize);
+    CHECK_FALSE(run_cli({"recmeet"}).cfg.diarize_share_overlap);
+    CHECK(run_cli({"recmeet", "--diarize-share-overlap"}).cfg.diarize_share_overlap);
+    CHECK_FALSE(run_cli({"recmeet"}).cfg.diarize_speech_only);
+    CHECK(run_cli({"recmeet", "--diarize-speech-only"}).cfg.diarize_speech_only);
+    CHECK(run_cli({"recmeet"}).cfg.local_speaker.empty());
+    CHECK(run_cli({"recmeet", "--local-speaker", "Ann"}).cfg.local_speaker == "Ann");
+}
+
+TEST_CASE("parse_cli: two-pass transcription flags", "[cli]") {
+    auto cli = run_cli({"recmeet"});
+    CHECK(cli.cfg.whisper_draft_model.empty());
+    CHECK(cli.cfg.draft_logprob == -0.5f);
+
+    cli = run_cli({"recmeet", "--model", "medium", "--draft-model", "base",
+                   "--draft-logprob", "-0.8"});
+    CHECK(cli.cfg.whisper_model == "medium");
+    CHECK(cli.cfg.whisper_draft_model == "base");
+    CHECK(cli.cfg.draft_logprob == -0.8f);
+}
+
+TEST_CASE("parse_cli: --language-pin-sec", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.language_pin_sec == 30);
+    CHECK(run_cli({"recmeet", "--language-pin-sec", "0"}).cfg.language_pin_sec == 0);
+    CHECK(run_cli({"recmeet", "--language-pin-sec", "15"}).cfg.language_pin_sec == 15);
+}
+
+TEST_CASE("parse_cli: autotune and GPU flags", "[cli]") {
+    auto cli = run_cli({"recmeet"});
+    CHECK_FALSE(cli.autotune);
+    CHECK(cli.autotune_rtf == 0.25);
+
+    cli = run_cli({"recmeet", "--autotune", "--autotune-rtf", "0.5", "--no-gpu"});
+    CHECK(cli.autotune);
+    CHECK(cli.autotune_rtf == 0.5);
+    CHECK_FALSE(cli.cfg.whisper_gpu);
+}
+
+TEST_CASE("parse_cli: warm postprocessing worker flags", "[cli]") {
+    auto cli = run_cli({"recmeet"});
+    CHECK_FALSE(cli.pp_worker);
+    CHECK(cli.cfg.pp_worker_jobs == 8);
+    CHECK(cli.cfg.pp_worker_rss_mb == 6144);
+
+    cli = run_cli({"recmeet", "--pp-worker-jobs", "0", "--pp-worker-rss-mb", "3072"});
+    CHECK(cli.cfg.pp_worker_jobs == 0);
+    CHECK(cli.cfg.pp_worker_rss_mb == 3072);
+    CHECK(run_cli({"recmeet", "--pp-worker", "--no-daemon"}).pp_worker);
+}
+
+TEST_CASE("parse_cli: --no-pin-threads", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.pin_threads);
+    CHECK_FALSE(run_cli({"recmeet", "--no-pin-threads"}).cfg.pin_threads);
+}
+
+TEST_CASE("parse_cli: --no-backend-bench", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.backend_bench);
+    CHECK_FALSE(run_cli({"recmeet", "--no-backend-bench"}).cfg.backend_bench);
+}
+
+TEST_CASE("parse_cli: --hugepages and --caption-mlock", "[cli]") {
+    CHECK_FALSE(run_cli({"recmeet"}).cfg.model_hugepages);
+    CHECK_FALSE(run_cli({"recmeet"}).cfg.caption_mlock);
+    CHECK(run_cli({"recmeet", "--hugepages"}).cfg.model_hugepages);
+    CHECK(run_cli({"recmeet", "--caption-mlock"}).cfg.caption_mlock);
+}
+
+TEST_CASE("parse_cli: --no-caption-int8-fallback", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.caption_int8_fallback);
+    CHECK_FALSE(run_cli({"recmeet", "--no-caption-int8-fallback"}).cfg.caption_int8_fallback);
+}
+
+TEST_CASE("parse_cli: --perf-counters", "[cli]") {
+    CHECK_FALSE(run_cli({"recmeet"}).cfg.perf_counters);
+    CHECK(run_cli({"recmeet", "--perf-counters"}).cfg.perf_counters);
+}
+
+TEST_CASE("parse_cli: --no-stage-cache", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.stage_cache);
+    CHECK_FALSE(run_cli({"recmeet", "--no-stage-cache", "--reprocess", "/m"}).cfg.stage_cache);
+}
+
+TEST_CASE("parse_cli: --recluster reprocesses from the stage cache", "[cli]") {
+    CHECK_FALSE(run_cli({"recmeet"}).cfg.recluster);
+    auto cli = run_cli({"recmeet", "--recluster", "/m"});
+    CHECK(cli.parse_error.empty());
+    CHECK(cli.cfg.recluster);
+    CHECK(cli.cfg.reprocess_dir == "/m");
+
+    CHECK_FALSE(run_cli({"recmeet", "--recluster", "/m", "--no-stage-cache"})
+                    .parse_error.empty());
+    CHECK_FALSE(run_cli({"recmeet", "--recluster", "/m", "--no-diarize"})
+                    .parse_error.empty());
+}
+
+TEST_CASE("parse_cli: --diarize-sweep meetings and grid", "[cli]") {
+    auto cli = run_cli({"recmeet", "--diarize-sweep", "/m/a", "--diarize-sweep", "/m/b",
+                        "--sweep-cluster", "1.0,1.18", "--sweep-collapse", "0.5"});
+    CHECK(cli.parse_error.empty());
+    CHECK(cli.sweep_dirs == std::vector<std::string>{"/m/a", "/m/b"});
+    CHECK(cli.sweep_cluster == std::vector<float>{1.0f, 1.18f});
+    CHECK(cli.sweep_stitch.empty());
+    CHECK(cli.sweep_collapse == std::vector<float>{0.5f});
+
+    CHECK_FALSE(run_cli({"recmeet", "--diarize-sweep", "/m", "--sweep-stitch", "0.6,x"})
+                    .parse_error.empty());
+    CHECK_FALSE(run_cli({"recmeet", "--sweep-cluster", "1.0"}).parse_error.empty());
+}
+
+TEST_CASE("parse_cli: diarize overlap flags", "[cli]") {
+    auto cli = run_cli({"recmeet"});
+    CHECK(cli.cfg.diarize_overlap);
+    CHECK(cli.cfg.overlap_memory_mb == 10240);
+
+    cli = run_cli({"recmeet", "--no-diarize-overlap", "--overlap-memory-mb", "4096"});
+    CHECK_FALSE(cli.cfg.diarize_overlap);
+    CHECK(cli.cfg.overlap_memory_mb == 4096);
+    CHECK(cli.parse_error.empty());
+}
+
+TEST_CASE("parse_cli: --diarize-parallel", "[cli]") {
+    CHECK(run_cli({"recmeet"}).cfg.diarize_parallel_chunks == 0);
+    auto cli = run_cli({"recmeet", "--diarize-parallel", "1"});
+    CHECK(cli.cfg.diarize_parallel_chunks == 1);
+    CHECK(cli.parse_error.empty());
+}
+
 // ---------------------------------------------------------------------------
 // T2.2 Phase C — chunked-diarize CLI flags + M-5' validation
 // ---------------------------------------------------------------------------
@@ -335,6 +604,7 @@ TEST_CASE("parse_cli: --context-text and --context-file can coexist", "[cli]") {
 TEST_CASE("parse_cli: --diarize-chunk-minutes sets value", "[cli][t2-2]") {
     auto cli = run_cli({"recmeet", "--diarize-chunk-minutes", "10.0"});
     CHECK(cli.cfg.chunk_minutes == 10.0f);
+    CHECK_FALSE(cli.cfg.diarize_auto_chunk);
     CHECK(cli.parse_error.empty());
 }
 
@@ -355,6 +625,7 @@ TEST_CASE("parse_cli: chunked-diarize defaults are 15min / 30s / 0.6", "[cli][t2
     CHECK(cli.cfg.chunk_minutes == 15.0f);
     CHECK(cli.cfg.chunk_overlap_sec == 30.0f);
     CHECK(cli.cfg.stitch_threshold == 0.6f);
+    CHECK(cli.cfg.diarize_auto_chunk);
     CHECK(cli.parse_error.empty());
 }
 
@@ -433,12 +704,71 @@ TEST_CASE("parse_cli: --dry-run sets the flag",
     CHECK(cli.parse_error.empty());
 }
 
+TEST_CASE("parse_cli: --batch-daemons collects the cluster's addresses",
+          "[reprocess-batch][cli]") {
+    auto cli = run_cli({"recmeet",
+                         "--reprocess-batch", "/parent/dir",
+                         "--batch-daemons", "gpu1:9000,,gpu2:9000",
+                         "--batch-daemons", "gpu1:9000"});
+    CHECK(cli.parse_error.empty());
+    REQUIRE(cli.batch_daemons.size() == 3);
+    CHECK(cli.batch_daemons[0] == "gpu1:9000");
+    CHECK(cli.batch_daemons[1] == "gpu2:9000");
+    CHECK(cli.batch_daemons[2] == "gpu1:9000");
+
+    auto alone = run_cli({"recmeet", "--batch-daemons", "gpu1:9000"});
+    CHECK(alone.parse_error.find("--batch-daemons") != std::string::npos);
+}
+
+TEST_CASE("parse_cli: --refresh redoes out-of-date batch notes",
+          "[reprocess-batch][cli]") {
+    auto cli = run_cli({"recmeet", "--reprocess-batch", "/parent/dir", "--refresh"});
+    CHECK(cli.parse_error.empty());
+    CHECK(cli.cfg.reprocess_batch_refresh);
+    CHECK(run_cli({"recmeet", "--refresh"}).parse_error
+          == "--refresh needs --reprocess-batch DIR");
+}
+
+TEST_CASE("parse_cli: --jobs runs a standalone batch concurrently",
+          "[reprocess-batch][cli]") {
+    auto cli = run_cli({"recmeet", "--reprocess-batch", "/parent/dir", "--jobs", "4"});
+    CHECK(cli.parse_error.empty());
+    CHECK(cli.batch_jobs == 4);
+    CHECK(run_cli({"recmeet", "--reprocess-batch", "/parent/dir"}).batch_jobs == 1);
+
+    CHECK(run_cli({"recmeet", "--reprocess-batch", "/parent/dir", "--jobs", "0"})
+              .parse_error == "--jobs must be at least 1");
+    CHECK(run_cli({"recmeet", "--jobs", "2"}).parse_error
+          == "--jobs needs --reprocess-batch DIR");
+    CHECK(run_cli({"recmeet", "--reprocess-batch", "/parent/dir", "--jobs", "2",
+                   "--batch-daemons", "gpu1:9000"})
+              .parse_error.find("--batch-daemons") != std::string::npos);
+}
+
+TEST_CASE("parse_cli: --pipeline overlaps standalone batch stages",
+          "[reprocess-batch][cli]") {
+    auto cli = run_cli({"recmeet", "--reprocess-batch", "/parent/dir", "--pipeline"});
+    CHECK(cli.parse_error.empty());
+    CHECK(cli.batch_pipeline);
+    CHECK_FALSE(run_cli({"recmeet", "--reprocess-batch", "/parent/dir"}).batch_pipeline);
+
+    CHECK(run_cli({"recmeet", "--pipeline"}).parse_error
+          == "--pipeline needs --reprocess-batch DIR");
+    CHECK(run_cli({"recmeet", "--reprocess-batch", "/parent/dir", "--pipeline",
+                   "--jobs", "2"})
+              .parse_error.find("--jobs") != std::string::npos);
+    CHECK(run_cli({"recmeet", "--reprocess-batch", "/parent/dir", "--pipeline",
+                   "--no-stage-cache"})
+              .parse_error.find("stage cache") != std::string::npos);
+}
+
 TEST_CASE("parse_cli: config_json round-trips batch_mode",
           "[reprocess-batch][cli]") {
     Config cfg;
     cfg.batch_mode = true;
     cfg.reprocess_batch_dir = "/home/user/meetings";
     cfg.reprocess_batch_dry_run = true;
+    cfg.reprocess_batch_refresh = true;
 
     std::string json = config_to_json(cfg);
     Config loaded = config_from_json(json);
@@ -446,4 +776,5 @@ TEST_CASE("parse_cli: config_json round-trips batch_mode",
     CHECK(loaded.batch_mode == true);
     CHECK(loaded.reprocess_batch_dir == fs::path("/home/user/meetings"));
     CHECK(loaded.reprocess_batch_dry_run == true);
+    CHECK(loaded.reprocess_batch_refresh == true);
 }
@@ -28,6 +28,31 @@ TEST_CASE("save_config + load_config round-trip", "[config]") {
     cfg.monitor_source = "alsa_output.test.monitor";
     cfg.mic_only = true;
     cfg.keep_sources = true;
+    cfg.spool_capture = false;
+    cfg.audio_archive = "flac";
+    cfg.archive_speech_only = true;
+    cfg.whisper_workers = 3;
+    cfg.live_transcribe = true;
+    cfg.whisper_draft_model = "base";
+    cfg.draft_logprob = -0.8f;
+    cfg.clip_model = "";
+    cfg.language_pin_sec = 10;
+    cfg.whisper_gpu = false;
+    cfg.whisper_gpu_devices = 0;
+    cfg.vad_pack = false;
+    cfg.diarize_overlap = false;
+    cfg.overlap_memory_mb = 6144;
+    cfg.diarize_parallel_chunks = 2;
+    cfg.live_diarize = true;
+    cfg.diarize_share_overlap = true;
+    cfg.diarize_speech_only = true;
+    cfg.local_speaker = "John Suykerbuyk";
+    cfg.diarize_provider = "xnnpack";
+    cfg.speaker_ann = true;
+    cfg.speaker_participants_first = true;
+    cfg.speaker_embedding_precision = "int8";
+    cfg.web_heavy_workers = 3;
+    cfg.web_heavy_queue = 0;
     cfg.whisper_model = "small";
     cfg.language = "en";
     cfg.vocabulary = "John Suykerbuyk, PipeWire";
@@ -37,8 +62,36 @@ TEST_CASE("save_config + load_config round-trip", "[config]") {
     cfg.no_summary = true;
     cfg.llm_model = "/path/to/model.gguf";
     cfg.llm_mmap = true;
+    cfg.llm_draft_model = "/path/to/draft.gguf";
+    cfg.summary_chunk_tokens = 8000;
+    cfg.summary_compact = false;
+    cfg.llm_kv_type = "q8_0";
+    cfg.llm_batch = 1024;
+    cfg.llm_ubatch = 256;
+    cfg.llm_gpu_layers = 20;
+    cfg.rolling_summary_minutes = 10;
+    cfg.caption_partial_hz = 4;
+    cfg.caption_transcript = true;
+    cfg.caption_threads = 2;
+    cfg.caption_keep_warm = false;
+    cfg.caption_mlock = true;
+    cfg.caption_int8_fallback = false;
     cfg.cluster_threshold = 0.8f;
     cfg.threads = 12;
+    cfg.pin_threads = false;
+    cfg.backend_bench = false;
+    cfg.model_hugepages = true;
+    cfg.perf_counters = true;
+    cfg.pp_worker_jobs = 0;
+    cfg.pp_worker_rss_mb = 4096;
+    cfg.pp_max_jobs = 2;
+    cfg.pp_yield_to_recording = false;
+    cfg.pp_on_battery = "defer";
+    cfg.pp_battery_model = "tiny";
+    cfg.stage_cache = false;
+    cfg.remote_worker = "gpu-host:9876";
+    cfg.watch_dir = "/srv/room-recorders";
+    cfg.watch_settle_sec = 120;
     cfg.log_level_str = "info";
     cfg.log_dir = "/tmp/recmeet-test-logs";
     cfg.output_dir = "/tmp/meetings";
@@ -58,6 +111,9 @@ TEST_CASE("save_config + load_config round-trip", "[config]") {
     CHECK(content.find("monitor_source: \"alsa_output.test.monitor\"") != std::string::npos);
     CHECK(content.find("mic_only: true") != std::string::npos);
     CHECK(content.find("keep_sources: true") != std::string::npos);
+    CHECK(content.find("spool_capture: false") != std::string::npos);
+    CHECK(content.find("archive: flac") != std::string::npos);
+    CHECK(content.find("archive_speech_only: true") != std::string::npos);
     CHECK(content.find("model: small") != std::string::npos);
     CHECK(content.find("language: en") != std::string::npos);
     CHECK(content.find("vocabulary: \"John Suykerbuyk, PipeWire\"") != std::string::npos);
@@ -67,8 +123,22 @@ TEST_CASE("save_config + load_config round-trip", "[config]") {
     CHECK(content.find("disabled: true") != std::string::npos);
     CHECK(content.find("llm_model: \"/path/to/model.gguf\"") != std::string::npos);
     CHECK(content.find("llm_mmap: true") != std::string::npos);
+    CHECK(content.find("llm_draft_model: \"/path/to/draft.gguf\"") != std::string::npos);
+    CHECK(content.find("chunk_tokens: 8000") != std::string::npos);
+    CHECK(content.find("compact: false") != std::string::npos);
+    CHECK(content.find("llm_kv_type: q8_0") != std::string::npos);
+    CHECK(content.find("llm_batch: 1024") != std::string::npos);
+    CHECK(content.find("llm_ubatch: 256") != std::string::npos);
+    CHECK(content.find("llm_gpu_layers: 20") != std::string::npos);
+    CHECK(content.find("rolling_minutes: 10") != std::string::npos);
     CHECK(content.find("cluster_threshold: 0.8") != std::string::npos);
     CHECK(content.find("threads: 12") != std::string::npos);
+    CHECK(content.find("pin_threads: false") != std::string::npos);
+    CHECK(content.find("backend_bench: false") != std::string::npos);
+    CHECK(content.find("remote_worker: \"gpu-host:9876\"") != std::string::npos);
+    CHECK(content.find("watch_dir: \"/srv/room-recorders\"") != std::string::npos);
+    CHECK(content.find("watch_settle_sec: 120") != std::string::npos);
+    CHECK(content.find("on_battery: defer") != std::string::npos);
     CHECK(content.find("level: info") != std::string::npos);
     CHECK(content.find("directory: \"/tmp/recmeet-test-logs\"") != std::string::npos);
     CHECK(content.find("directory: \"/tmp/meetings\"") != std::string::npos);
@@ -82,6 +152,31 @@ TEST_CASE("save_config + load_config round-trip", "[config]") {
     CHECK(loaded.monitor_source == "alsa_output.test.monitor");
     CHECK(loaded.mic_only == true);
     CHECK(loaded.keep_sources == true);
+    CHECK(loaded.spool_capture == false);
+    CHECK(loaded.audio_archive == "flac");
+    CHECK(loaded.archive_speech_only);
+    CHECK(loaded.whisper_workers == 3);
+    CHECK(loaded.live_transcribe);
+    CHECK(loaded.whisper_draft_model == "base");
+    CHECK(loaded.draft_logprob == -0.8f);
+    CHECK(loaded.clip_model.empty());
+    CHECK(loaded.language_pin_sec == 10);
+    CHECK_FALSE(loaded.whisper_gpu);
+    CHECK(loaded.whisper_gpu_devices == 0);
+    CHECK_FALSE(loaded.vad_pack);
+    CHECK_FALSE(loaded.diarize_overlap);
+    CHECK(loaded.overlap_memory_mb == 6144);
+    CHECK(loaded.diarize_parallel_chunks == 2);
+    CHECK(loaded.live_diarize);
+    CHECK(loaded.diarize_share_overlap);
+    CHECK(loaded.diarize_speech_only);
+    CHECK(loaded.local_speaker == "John Suykerbuyk");
+    CHECK(loaded.diarize_provider == "xnnpack");
+    CHECK(loaded.speaker_ann);
+    CHECK(loaded.speaker_participants_first);
+    CHECK(loaded.speaker_embedding_precision == "int8");
+    CHECK(loaded.web_heavy_workers == 3);
+    CHECK(loaded.web_heavy_queue == 0);
     CHECK(loaded.whisper_model == "small");
     CHECK(loaded.language == "en");
     CHECK(loaded.vocabulary == "John Suykerbuyk, PipeWire");
@@ -91,8 +186,36 @@ TEST_CASE("save_config + load_config round-trip", "[config]") {
     CHECK(loaded.no_summary == true);
     CHECK(loaded.llm_model == "/path/to/model.gguf");
     CHECK(loaded.llm_mmap == true);
+    CHECK(loaded.llm_draft_model == "/path/to/draft.gguf");
+    CHECK(loaded.summary_chunk_tokens == 8000);
+    CHECK_FALSE(loaded.summary_compact);
+    CHECK(loaded.llm_kv_type == "q8_0");
+    CHECK(loaded.llm_batch == 1024);
+    CHECK(loaded.llm_ubatch == 256);
+    CHECK(loaded.llm_gpu_layers == 20);
+    CHECK(loaded.rolling_summary_minutes == 10);
+    CHECK(loaded.caption_partial_hz == 4);
+    CHECK(loaded.caption_transcript);
+    CHECK(loaded.caption_threads == 2);
+    CHECK_FALSE(loaded.caption_keep_warm);
+    CHECK(loaded.caption_mlock);
+    CHECK_FALSE(loaded.caption_int8_fallback);
     CHECK(loaded.cluster_threshold == 0.8f);
     CHECK(loaded.threads == 12);
+    CHECK_FALSE(loaded.pin_threads);
+    CHECK_FALSE(loaded.backend_bench);
+    CHECK(loaded.model_hugepages);
+    CHECK(loaded.perf_counters);
+    CHECK(loaded.pp_worker_jobs == 0);
+    CHECK(loaded.pp_worker_rss_mb == 4096);
+    CHECK(loaded.pp_max_jobs == 2);
+    CHECK_FALSE(loaded.pp_yield_to_recording);
+    CHECK(loaded.pp_on_battery == "defer");
+    CHECK(loaded.pp_battery_model == "tiny");
+    CHECK_FALSE(loaded.stage_cache);
+    CHECK(loaded.remote_worker == "gpu-host:9876");
+    CHECK(loaded.watch_dir == "/srv/room-recorders");
+    CHECK(loaded.watch_settle_sec == 120);
     CHECK(loaded.log_level_str == "info");
     CHECK(loaded.log_dir == "/tmp/recmeet-test-logs");
     CHECK(loaded.output_dir == "/tmp/meetings");
@@ -113,12 +236,65 @@ TEST_CASE("load_config: returns defaults when no file exists", "[config]") {
     CHECK(cfg.api_model == "grok-3");
     CHECK(cfg.mic_only == false);
     CHECK(cfg.keep_sources == false);
+    CHECK(cfg.spool_capture == true);
+    CHECK(cfg.audio_archive == "wav");
+    CHECK_FALSE(cfg.archive_speech_only);
+    CHECK(cfg.whisper_workers == 0);
+    CHECK_FALSE(cfg.live_transcribe);
+    CHECK(cfg.whisper_draft_model.empty());
+    CHECK(cfg.draft_logprob == -0.5f);
+    CHECK(cfg.clip_model == "base");
+    CHECK(cfg.language_pin_sec == 30);
+    CHECK(cfg.whisper_gpu);
+    CHECK(cfg.whisper_gpu_devices == 1);
+    CHECK(cfg.vad_pack);
+    CHECK(cfg.diarize_overlap);
+    CHECK(cfg.overlap_memory_mb == 10240);
+    CHECK(cfg.diarize_parallel_chunks == 0);
+    CHECK_FALSE(cfg.live_diarize);
+    CHECK_FALSE(cfg.diarize_share_overlap);
+    CHECK_FALSE(cfg.diarize_speech_only);
+    CHECK(cfg.local_speaker.empty());
+    CHECK(cfg.diarize_provider == "auto");
+    CHECK_FALSE(cfg.speaker_ann);
+    CHECK_FALSE(cfg.speaker_participants_first);
+    CHECK(cfg.speaker_embedding_precision == "f32");
+    CHECK(cfg.web_heavy_workers == 2);
+    CHECK(cfg.web_heavy_queue == 4);
     CHECK(cfg.no_summary == false);
     CHECK(cfg.llm_mmap == false);
+    CHECK(cfg.summary_chunk_tokens == 0);
+    CHECK(cfg.summary_compact);
+    CHECK(cfg.llm_draft_model.empty());
+    CHECK(cfg.llm_kv_type == "f16");
+    CHECK(cfg.llm_batch == 0);
+    CHECK(cfg.llm_ubatch == 0);
+    CHECK(cfg.llm_gpu_layers == -1);
+    CHECK(cfg.rolling_summary_minutes == 0);
+    CHECK(cfg.caption_partial_hz == 10);
+    CHECK_FALSE(cfg.caption_transcript);
+    CHECK(cfg.caption_threads == 1);
+    CHECK(cfg.caption_keep_warm);
+    CHECK_FALSE(cfg.caption_mlock);
+    CHECK(cfg.caption_int8_fallback);
     CHECK(cfg.diarize == true);
     CHECK(cfg.num_speakers == 0);
     CHECK(cfg.cluster_threshold == 1.18f);
     CHECK(cfg.threads == 0);
+    CHECK(cfg.pin_threads);
+    CHECK(cfg.backend_bench);
+    CHECK_FALSE(cfg.model_hugepages);
+    CHECK_FALSE(cfg.perf_counters);
+    CHECK(cfg.pp_worker_jobs == 8);
+    CHECK(cfg.pp_worker_rss_mb == 6144);
+    CHECK(cfg.pp_max_jobs == 1);
+    CHECK(cfg.pp_yield_to_recording);
+    CHECK(cfg.pp_on_battery == "reduce");
+    CHECK(cfg.pp_battery_model.empty());
+    CHECK(cfg.stage_cache);
+    CHECK(cfg.remote_worker.empty());
+    CHECK(cfg.watch_dir.empty());
+    CHECK(cfg.watch_settle_sec == 30);
     CHECK(cfg.vad == true);
     CHECK(cfg.vad_threshold == 0.5f);
     CHECK(cfg.vad_min_silence == 0.5f);
@@ -310,6 +486,7 @@ TEST_CASE("load_config: chunked-diarize defaults when keys absent",
     CHECK(cfg.chunk_minutes == 15.0f);
     CHECK(cfg.chunk_overlap_sec == 30.0f);
     CHECK(cfg.stitch_threshold == 0.6f);
+    CHECK(cfg.diarize_auto_chunk);
 }
 
 TEST_CASE("save_config + load_config: chunked-diarize fields round-trip",
@@ -342,6 +519,25 @@ TEST_CASE("save_config + load_config: chunked-diarize fields round-trip",
     CHECK(loaded.chunk_minutes == 12.5f);
     CHECK(loaded.chunk_overlap_sec == 45.0f);
     CHECK(loaded.stitch_threshold == 0.55f);
+    // An explicit window pins it, even though auto_chunk wasn't written.
+    CHECK_FALSE(loaded.diarize_auto_chunk);
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("save_config + load_config: auto_chunk off without a window",
+          "[config][t2-2]") {
+    fs::path dir = recmeet::test::tmp_path("recmeet_test_cfg_auto_chunk");
+    fs::remove_all(dir);
+    fs::path path = dir / "config.yaml";
+
+    Config cfg;
+    cfg.diarize_auto_chunk = false;
+    save_config(cfg, path);
+
+    Config loaded = load_config(path);
+    CHECK_FALSE(loaded.diarize_auto_chunk);
+    CHECK(loaded.chunk_minutes == 15.0f);
 
     fs::remove_all(dir);
 }
@@ -4,6 +4,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include "config_json.h"
+#include "config_reload.h"
 #include "test_tmpdir.h"
 
 #include <filesystem>
@@ -19,6 +20,30 @@ static Config make_test_config() {
     cfg.monitor_source = "alsa_output.test.monitor";
     cfg.mic_only = true;
     cfg.keep_sources = true;
+    cfg.spool_capture = false;
+    cfg.audio_archive = "opus";
+    cfg.archive_speech_only = true;
+    cfg.whisper_workers = 6;
+    cfg.live_transcribe = true;
+    cfg.whisper_draft_model = "tiny";
+    cfg.draft_logprob = -0.75f;
+    cfg.clip_model = "tiny.en";
+    cfg.language_pin_sec = 0;
+    cfg.whisper_gpu = false;
+    cfg.whisper_gpu_devices = 2;
+    cfg.vad_pack = false;
+    cfg.diarize_overlap = false;
+    cfg.overlap_memory_mb = 8192;
+    cfg.diarize_parallel_chunks = 3;
+    cfg.diarize_auto_chunk = false;
+    cfg.live_diarize = true;
+    cfg.diarize_share_overlap = true;
+    cfg.diarize_speech_only = true;
+    cfg.local_speaker = "Me";
+    cfg.diarize_provider = "cuda";
+    cfg.speaker_ann = true;
+    cfg.speaker_participants_first = true;
+    cfg.speaker_embedding_precision = "f16";
     cfg.whisper_model = "small";
     cfg.language = "en";
     cfg.vocabulary = "John Suykerbuyk, PipeWire";
@@ -28,6 +53,20 @@ static Config make_test_config() {
     cfg.no_summary = true;
     cfg.llm_model = "/path/to/model.gguf";
     cfg.llm_mmap = true;
+    cfg.llm_draft_model = "/path/to/draft.gguf";
+    cfg.summary_chunk_tokens = 12000;
+    cfg.summary_compact = false;
+    cfg.llm_kv_type = "q4_0";
+    cfg.llm_batch = 4096;
+    cfg.llm_ubatch = 128;
+    cfg.llm_gpu_layers = 0;
+    cfg.rolling_summary_minutes = 15;
+    cfg.caption_partial_hz = 0;
+    cfg.caption_transcript = true;
+    cfg.caption_threads = 2;
+    cfg.caption_keep_warm = false;
+    cfg.caption_mlock = true;
+    cfg.caption_int8_fallback = false;
     cfg.diarize = false;
     cfg.num_speakers = 3;
     cfg.cluster_threshold = 0.8f;
@@ -40,6 +79,20 @@ static Config make_test_config() {
     cfg.vad_min_speech = 0.15f;
     cfg.vad_max_speech = 20.0f;
     cfg.threads = 12;
+    cfg.pin_threads = false;
+    cfg.backend_bench = false;
+    cfg.model_hugepages = true;
+    cfg.perf_counters = true;
+    cfg.pp_worker_jobs = 3;
+    cfg.pp_worker_rss_mb = 2048;
+    cfg.pp_max_jobs = 4;
+    cfg.pp_yield_to_recording = false;
+    cfg.pp_on_battery = "run";
+    cfg.pp_battery_model = "base";
+    cfg.stage_cache = false;
+    cfg.remote_worker = "gpu-host:9876";
+    cfg.watch_dir = "/srv/room-recorders";
+    cfg.watch_settle_sec = 90;
     cfg.log_level_str = "info";
     cfg.log_dir = recmeet::test::tmp_path("recmeet-test-logs").string();
     cfg.output_dir = "/tmp/meetings";
@@ -47,6 +100,7 @@ static Config make_test_config() {
     cfg.context_file = "/tmp/context.txt";
     cfg.context_inline = "Subject: Weekly standup\nParticipants: Alice, Bob";
     cfg.reprocess_dir = "/tmp/meetings/2026-03-06_11-58";
+    cfg.recluster = true;
     cfg.note.domain = "engineering";
     cfg.note.tags = {"meeting", "standup", "engineering"};
     return cfg;
@@ -66,6 +120,30 @@ TEST_CASE("config_to_json + config_from_json round-trip", "[config_json]") {
     CHECK(loaded.monitor_source == original.monitor_source);
     CHECK(loaded.mic_only == original.mic_only);
     CHECK(loaded.keep_sources == original.keep_sources);
+    CHECK(loaded.spool_capture == original.spool_capture);
+    CHECK(loaded.audio_archive == original.audio_archive);
+    CHECK(loaded.archive_speech_only == original.archive_speech_only);
+    CHECK(loaded.whisper_workers == original.whisper_workers);
+    CHECK(loaded.live_transcribe == original.live_transcribe);
+    CHECK(loaded.whisper_draft_model == original.whisper_draft_model);
+    CHECK(loaded.draft_logprob == original.draft_logprob);
+    CHECK(loaded.clip_model == original.clip_model);
+    CHECK(loaded.language_pin_sec == original.language_pin_sec);
+    CHECK(loaded.whisper_gpu == original.whisper_gpu);
+    CHECK(loaded.whisper_gpu_devices == original.whisper_gpu_devices);
+    CHECK(loaded.vad_pack == original.vad_pack);
+    CHECK(loaded.diarize_overlap == original.diarize_overlap);
+    CHECK(loaded.overlap_memory_mb == original.overlap_memory_mb);
+    CHECK(loaded.diarize_parallel_chunks == original.diarize_parallel_chunks);
+    CHECK(loaded.diarize_auto_chunk == original.diarize_auto_chunk);
+    CHECK(loaded.live_diarize == original.live_diarize);
+    CHECK(loaded.diarize_share_overlap == original.diarize_share_overlap);
+    CHECK(loaded.diarize_speech_only == original.diarize_speech_only);
+    CHECK(loaded.local_speaker == original.local_speaker);
+    CHECK(loaded.diarize_provider == original.diarize_provider);
+    CHECK(loaded.speaker_ann == original.speaker_ann);
+    CHECK(loaded.speaker_participants_first == original.speaker_participants_first);
+    CHECK(loaded.speaker_embedding_precision == original.speaker_embedding_precision);
     CHECK(loaded.whisper_model == original.whisper_model);
     CHECK(loaded.language == original.language);
     CHECK(loaded.vocabulary == original.vocabulary);
@@ -75,6 +153,20 @@ TEST_CASE("config_to_json + config_from_json round-trip", "[config_json]") {
     CHECK(loaded.no_summary == original.no_summary);
     CHECK(loaded.llm_model == original.llm_model);
     CHECK(loaded.llm_mmap == original.llm_mmap);
+    CHECK(loaded.llm_draft_model == original.llm_draft_model);
+    CHECK(loaded.summary_chunk_tokens == original.summary_chunk_tokens);
+    CHECK(loaded.summary_compact == original.summary_compact);
+    CHECK(loaded.llm_kv_type == original.llm_kv_type);
+    CHECK(loaded.llm_batch == original.llm_batch);
+    CHECK(loaded.llm_ubatch == original.llm_ubatch);
+    CHECK(loaded.llm_gpu_layers == original.llm_gpu_layers);
+    CHECK(loaded.rolling_summary_minutes == original.rolling_summary_minutes);
+    CHECK(loaded.caption_partial_hz == original.caption_partial_hz);
+    CHECK(loaded.caption_transcript == original.caption_transcript);
+    CHECK(loaded.caption_threads == original.caption_threads);
+    CHECK(loaded.caption_keep_warm == original.caption_keep_warm);
+    CHECK(loaded.caption_mlock == original.caption_mlock);
+    CHECK(loaded.caption_int8_fallback == original.caption_int8_fallback);
     CHECK(loaded.diarize == original.diarize);
     CHECK(loaded.num_speakers == original.num_speakers);
     CHECK_THAT(loaded.cluster_threshold,
@@ -95,6 +187,20 @@ TEST_CASE("config_to_json + config_from_json round-trip", "[config_json]") {
     CHECK_THAT(loaded.vad_max_speech,
                Catch::Matchers::WithinAbs(original.vad_max_speech, 0.1));
     CHECK(loaded.threads == original.threads);
+    CHECK(loaded.pin_threads == original.pin_threads);
+    CHECK(loaded.backend_bench == original.backend_bench);
+    CHECK(loaded.model_hugepages == original.model_hugepages);
+    CHECK(loaded.perf_counters == original.perf_counters);
+    CHECK(loaded.pp_worker_jobs == original.pp_worker_jobs);
+    CHECK(loaded.pp_worker_rss_mb == original.pp_worker_rss_mb);
+    CHECK(loaded.pp_max_jobs == original.pp_max_jobs);
+    CHECK(loaded.pp_yield_to_recording == original.pp_yield_to_recording);
+    CHECK(loaded.pp_on_battery == original.pp_on_battery);
+    CHECK(loaded.pp_battery_model == original.pp_battery_model);
+    CHECK(loaded.stage_cache == original.stage_cache);
+    CHECK(loaded.remote_worker == original.remote_worker);
+    CHECK(loaded.watch_dir == original.watch_dir);
+    CHECK(loaded.watch_settle_sec == original.watch_settle_sec);
     CHECK(loaded.log_level_str == original.log_level_str);
     CHECK(loaded.log_dir == original.log_dir);
     CHECK(loaded.output_dir == original.output_dir);
@@ -102,6 +208,7 @@ TEST_CASE("config_to_json + config_from_json round-trip", "[config_json]") {
     CHECK(loaded.context_file == original.context_file);
     CHECK(loaded.context_inline == original.context_inline);
     CHECK(loaded.reprocess_dir == original.reprocess_dir);
+    CHECK(loaded.recluster == original.recluster);
     CHECK(loaded.note.domain == original.note.domain);
     REQUIRE(loaded.note.tags.size() == original.note.tags.size());
     CHECK(loaded.note.tags == original.note.tags);
@@ -297,3 +404,69 @@ TEST_CASE("config_to_json file round-trip (subprocess config transfer)", "[confi
     // Cleanup
     std::filesystem::remove(path);
 }
+
+TEST_CASE("plan_config_reload invalidates only the engines a change touches", "[config_json][config_reload]") {
+    const Config before;
+
+    SECTION("unrelated fields reload nothing") {
+        Config after = before;
+        after.note_dir = "/tmp/notes";
+        after.log_level_str = "debug";
+        after.caption_partial_hz = 2;
+        const auto plan = plan_config_reload(before, after);
+        CHECK(plan.changed == std::vector<std::string>{"caption_partial_hz", "log_level", "note_dir"});
+        CHECK(plan.engines.empty());
+        CHECK(plan.worker_kinds().empty());
+    }
+
+    SECTION("a model change invalidates its engine only") {
+        Config after = before;
+        after.whisper_model = "large-v3";
+        after.llm_gpu_layers = 12;
+        const auto plan = plan_config_reload(before, after);
+        CHECK(plan.engines == std::vector<std::string>{"whisper", "llama"});
+        CHECK(plan.worker_kinds() == std::vector<std::string>{"whisper", "llama"});
+        CHECK_FALSE(plan.invalidates("sherpa"));
+        CHECK_FALSE(plan.invalidates("captions"));
+
+        after = before;
+        after.caption_int8_fallback = !before.caption_int8_fallback;
+        CHECK(plan_config_reload(before, after).engines == std::vector<std::string>{"captions"});
+    }
+
+    SECTION("shared parameters invalidate every engine that loads with them") {
+        Config after = before;
+        after.whisper_gpu = !before.whisper_gpu;
+        auto plan = plan_config_reload(before, after);
+        CHECK(plan.engines == std::vector<std::string>{"clip", "whisper"});
+
+        after = before;
+        after.model_hugepages = !before.model_hugepages;
+        plan = plan_config_reload(before, after);
+        CHECK(plan.engines ==
+              std::vector<std::string>{"captions", "clip", "whisper", "sherpa", "llama"});
+        CHECK(plan.worker_kinds() == std::vector<std::string>{"whisper", "sherpa", "llama"});
+    }
+
+    SECTION("the response lists both") {
+        Config after = before;
+        after.threads = before.threads + 2;
+        after.output_dir = "/tmp/meetings";
+        JsonMap m;
+        add_config_reload(m, plan_config_reload(before, after));
+        CHECK(json_val_as_string(m["changed"]) == "output_dir,threads");
+        CHECK(json_val_as_string(m["invalidated"]) == "sherpa");
+    }
+}
+
+TEST_CASE("pp worker release lines round-trip and never parse a job path", "[config_json][config_reload]") {
+    const std::string line = pp_worker_release_line({"whisper", "llama"});
+    CHECK(line == "release whisper,llama");
+    std::vector<std::string> kinds;
+    REQUIRE(parse_pp_worker_release(line, kinds));
+    CHECK(kinds == std::vector<std::string>{"whisper", "llama"});
+
+    CHECK_FALSE(parse_pp_worker_release("/run/user/1000/recmeet/pp-7.json", kinds));
+    REQUIRE(parse_pp_worker_release("release ", kinds));
+    CHECK(kinds.empty());
+}
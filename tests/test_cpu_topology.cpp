@@ -0,0 +1,299 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "cpu_topology.h"
+#include "power_policy.h"
+#include "test_tmpdir.h"
+
+#include <sched.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace recmeet;
+
+namespace {
+
+void put(const fs::path& path, const std::string& body) {
+    fs::create_directories(path.parent_path());
+    std::ofstream(path) << body << "\n";
+}
+
+// A fake /sys: `cores` physical cores per package, `smt` threads each,
+// numbered core-major like the kernel; one NUMA node per package.
+fs::path fake_sys(const std::string& name, int packages, int cores, int smt) {
+    const fs::path root = recmeet::test::tmp_path("recmeet_cpu_topology") / name;
+    fs::remove_all(root);
+    const int per_package = cores * smt;
+    const int n = packages * per_package;
+    put(root / "devices/system/cpu/online", "0-" + std::to_string(n - 1));
+    for (int id = 0; id < n; ++id) {
+        const fs::path t = root / "devices/system/cpu" / ("cpu" + std::to_string(id)) / "topology";
+        const int package = id / per_package;
+        put(t / "core_id", std::to_string((id % per_package) % cores));
+        put(t / "physical_package_id", std::to_string(package));
+    }
+    if (packages > 1)
+        for (int p = 0; p < packages; ++p)
+            put(root / "devices/system/node" / ("node" + std::to_string(p)) / "cpulist",
+                std::to_string(p * per_package) + "-" + std::to_string((p + 1) * per_package - 1));
+    return root;
+}
+
+} // namespace
+
+TEST_CASE("parse_cpu_list: ranges and singles", "[cpu_topology]") {
+    CHECK(parse_cpu_list("0-3,8,10-11") == std::vector<int>{0, 1, 2, 3, 8, 10, 11});
+    CHECK(parse_cpu_list("5") == std::vector<int>{5});
+    CHECK(parse_cpu_list("3,1-2,2") == std::vector<int>{1, 2, 3});
+    CHECK(parse_cpu_list("x,4-2,7") == std::vector<int>{7});
+    CHECK(parse_cpu_list("").empty());
+}
+
+TEST_CASE("parse_cgroup_cpu_max: quota in CPUs", "[cpu_topology]") {
+    CHECK(parse_cgroup_cpu_max("400000 100000") == 4.0);
+    CHECK(parse_cgroup_cpu_max("150000 100000") == 1.5);
+    CHECK(parse_cgroup_cpu_max("max 100000") == 0.0);
+    CHECK(parse_cgroup_cpu_max("garbage") == 0.0);
+    CHECK(parse_cgroup_cpu_max("") == 0.0);
+}
+
+TEST_CASE("plan_cpu_placement: uniform host keeps its affinity", "[cpu_topology]") {
+    const CpuTopology topo = read_cpu_topology(fake_sys("uniform", 1, 8, 1));
+    REQUIRE(topo.cpus.size() == 8);
+    CHECK_FALSE(topo.hybrid());
+    CHECK(topo.node_count() == 1);
+
+    const CpuPlacement inf = plan_cpu_placement(topo, CpuClass::Inference);
+    CHECK(inf.threads == 7);  // a core left for the capture threads
+    CHECK(inf.cpus.empty());
+    CHECK(inf.node == -1);
+
+    const CpuPlacement light = plan_cpu_placement(topo, CpuClass::Light);
+    CHECK(light.threads == 2);
+    CHECK(light.cpus.empty());
+}
+
+TEST_CASE("plan_cpu_placement: one thread per core with SMT", "[cpu_topology]") {
+    const CpuTopology topo = read_cpu_topology(fake_sys("smt", 1, 4, 2));
+    REQUIRE(topo.cpus.size() == 8);
+    CHECK(topo.cpus[5].core == 1);
+    CHECK(plan_cpu_placement(topo, CpuClass::Inference).threads == 4);
+}
+
+TEST_CASE("plan_cpu_placement: hybrid CPU splits P- and E-cores", "[cpu_topology]") {
+    // 4 P-cores with SMT (cpu0-7), then 8 E-cores (cpu8-15).
+    const fs::path root = fake_sys("hybrid", 1, 12, 1);
+    put(root / "devices/system/cpu/online", "0-15");
+    for (int id = 0; id < 16; ++id) {
+        const fs::path t = root / "devices/system/cpu" / ("cpu" + std::to_string(id)) / "topology";
+        put(t / "core_id", std::to_string(id < 8 ? id / 2 : id - 4));
+        put(t / "physical_package_id", "0");
+    }
+    put(root / "devices/cpu_atom/cpus", "8-15");
+
+    const CpuTopology topo = read_cpu_topology(root);
+    CHECK(topo.hybrid());
+    CHECK_FALSE(topo.cpus[7].efficiency);
+    CHECK(topo.cpus[8].efficiency);
+
+    const CpuPlacement inf = plan_cpu_placement(topo, CpuClass::Inference);
+    CHECK(inf.threads == 4);
+    CHECK(inf.cpus == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7});
+
+    const CpuPlacement light = plan_cpu_placement(topo, CpuClass::Light);
+    CHECK(light.threads == 2);
+    CHECK(light.cpus == std::vector<int>{8, 9, 10, 11, 12, 13, 14, 15});
+}
+
+TEST_CASE("plan_cpu_placement: big.LITTLE by cpu_capacity", "[cpu_topology]") {
+    const fs::path root = fake_sys("biglittle", 1, 4, 1);
+    for (int id = 0; id < 4; ++id)
+        put(root / "devices/system/cpu" / ("cpu" + std::to_string(id)) / "cpu_capacity",
+            id < 2 ? "446" : "1024");
+    const CpuTopology topo = read_cpu_topology(root);
+    CHECK(topo.hybrid());
+    CHECK(plan_cpu_placement(topo, CpuClass::Inference).cpus == std::vector<int>{2, 3});
+    CHECK(plan_cpu_placement(topo, CpuClass::Light).cpus == std::vector<int>{0, 1});
+}
+
+TEST_CASE("plan_cpu_placement: dual socket stays on one node", "[cpu_topology]") {
+    const CpuTopology topo = read_cpu_topology(fake_sys("numa", 2, 6, 2));
+    REQUIRE(topo.cpus.size() == 24);
+    CHECK(topo.node_count() == 2);
+    CHECK(topo.cpus[12].node == 1);
+
+    const CpuPlacement inf = plan_cpu_placement(topo, CpuClass::Inference);
+    CHECK(inf.node == 0);
+    CHECK(inf.threads == 6);
+    REQUIRE(inf.cpus.size() == 12);
+    CHECK(inf.cpus.front() == 0);
+    CHECK(inf.cpus.back() == 11);
+
+    // The process may only use part of node 0: node 1 has more cores.
+    std::vector<int> allowed = {0, 1};
+    for (int id = 12; id < 24; ++id) allowed.push_back(id);
+    const CpuTopology masked = read_cpu_topology(fake_sys("numa", 2, 6, 2), allowed);
+    CHECK(masked.cpus.size() == 14);
+    CHECK(plan_cpu_placement(masked, CpuClass::Inference).node == 1);
+}
+
+TEST_CASE("plan_cpu_placement: cgroup quota caps the threads", "[cpu_topology]") {
+    CpuTopology topo = read_cpu_topology(fake_sys("quota", 1, 16, 1));
+    topo.quota_cpus = 2.5;
+    CHECK(plan_cpu_placement(topo, CpuClass::Inference).threads == 2);
+    topo.quota_cpus = 0.5;
+    CHECK(plan_cpu_placement(topo, CpuClass::Inference).threads == 1);
+    CHECK(plan_cpu_placement(topo, CpuClass::Light).threads == 1);
+}
+
+TEST_CASE("read_cpu_topology: falls back without sysfs", "[cpu_topology]") {
+    const CpuTopology topo = read_cpu_topology(
+        recmeet::test::tmp_path("recmeet_cpu_topology") / "missing");
+    CHECK_FALSE(topo.cpus.empty());
+    CHECK(plan_cpu_placement(topo, CpuClass::Inference).threads >= 1);
+}
+
+TEST_CASE("ScopedCpuPlacement: pins and restores the thread", "[cpu_topology]") {
+    const CpuTopology& host = host_cpu_topology();
+    REQUIRE_FALSE(host.cpus.empty());
+    {
+        CpuPlacement plan;
+        plan.cpus = {host.cpus.front().id};
+        const ScopedCpuPlacement pinned(plan);
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        REQUIRE(sched_getaffinity(0, sizeof(set), &set) == 0);
+        CHECK(CPU_COUNT(&set) == 1);
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    REQUIRE(sched_getaffinity(0, sizeof(set), &set) == 0);
+    CHECK(static_cast<size_t>(CPU_COUNT(&set)) == host.cpus.size());
+}
+
+TEST_CASE("pp_cpu_priority: yields only while recording", "[cpu_topology]") {
+    CHECK(pp_cpu_priority(true, true) == PpCpuPriority::Yield);
+    CHECK(pp_cpu_priority(true, false) == PpCpuPriority::Normal);
+    CHECK(pp_cpu_priority(false, true) == PpCpuPriority::Normal);
+    CHECK(std::string(pp_cpu_priority_name(PpCpuPriority::Yield)) == "yield");
+}
+
+TEST_CASE("read_power_state: system battery, mains and thermal trip points", "[cpu_topology]") {
+    const fs::path sys = recmeet::test::tmp_path("recmeet_cpu_topology") / "power";
+    fs::remove_all(sys);
+    CHECK_FALSE(read_power_state(sys).on_battery);  // a desktop: no supplies at all
+    CHECK(read_power_state(sys).battery_percent == -1);
+
+    const fs::path ps = sys / "class/power_supply";
+    put(ps / "AC/type", "Mains");
+    put(ps / "AC/online", "1");
+    put(ps / "BAT0/type", "Battery");
+    put(ps / "BAT0/status", "Charging");
+    put(ps / "BAT0/capacity", "64");
+    // A wireless mouse, discharging, is not the laptop's battery.
+    put(ps / "hidpp_battery_0/type", "Battery");
+    put(ps / "hidpp_battery_0/scope", "Device");
+    put(ps / "hidpp_battery_0/status", "Discharging");
+    put(ps / "hidpp_battery_0/capacity", "5");
+    PowerState s = read_power_state(sys);
+    CHECK_FALSE(s.on_battery);
+    CHECK(s.battery_percent == 64);
+
+    put(ps / "AC/online", "0");
+    put(ps / "BAT0/status", "Discharging");
+    s = read_power_state(sys);
+    CHECK(s.on_battery);
+    CHECK_FALSE(s.thermal_throttled);
+
+    // Passive trip point at 90 C; a disabled (0) one is ignored.
+    const fs::path tz = sys / "class/thermal/thermal_zone0";
+    put(tz / "trip_point_0_type", "passive");
+    put(tz / "trip_point_0_temp", "90000");
+    put(tz / "trip_point_1_type", "passive");
+    put(tz / "trip_point_1_temp", "0");
+    put(tz / "temp", "71000");
+    CHECK_FALSE(read_power_state(sys).thermal_throttled);
+    put(tz / "temp", "90500");
+    CHECK(read_power_state(sys).thermal_throttled);
+
+    // Only a critical trip point: throttled 15 C below it.
+    const fs::path acpi = sys / "class/thermal/thermal_zone1";
+    put(tz / "temp", "40000");
+    put(acpi / "trip_point_0_type", "critical");
+    put(acpi / "trip_point_0_temp", "105000");
+    put(acpi / "temp", "89000");
+    CHECK_FALSE(read_power_state(sys).thermal_throttled);
+    put(acpi / "temp", "91000");
+    CHECK(read_power_state(sys).thermal_throttled);
+    fs::remove_all(sys);
+}
+
+TEST_CASE("power_threads: reduced on battery, halved when throttled", "[cpu_topology]") {
+    BatteryPolicy policy = BatteryPolicy::Run;
+    REQUIRE(parse_battery_policy("defer", policy));
+    CHECK(policy == BatteryPolicy::Defer);
+    CHECK_FALSE(parse_battery_policy("eco", policy));
+    CHECK(std::string(battery_policy_name(BatteryPolicy::Reduce)) == "reduce");
+
+    PowerState ac, battery, hot;
+    battery.on_battery = true;
+    hot.thermal_throttled = true;
+    CHECK(power_threads(16, ac, BatteryPolicy::Reduce) == 16);
+    CHECK(power_threads(16, battery, BatteryPolicy::Run) == 16);
+    CHECK(power_threads(16, battery, BatteryPolicy::Reduce) == 4);
+    CHECK(power_threads(16, battery, BatteryPolicy::Defer) == 4);  // a job run anyway
+    CHECK(power_threads(16, hot, BatteryPolicy::Run) == 8);
+    PowerState both = battery;
+    both.thermal_throttled = true;
+    CHECK(power_threads(16, both, BatteryPolicy::Reduce) == 2);
+    CHECK(power_threads(2, both, BatteryPolicy::Reduce) == 1);
+
+    CHECK(power_defers(battery, BatteryPolicy::Defer));
+    CHECK_FALSE(power_defers(battery, BatteryPolicy::Reduce));
+    CHECK_FALSE(power_defers(ac, BatteryPolicy::Defer));
+    CHECK(power_reduced(battery, BatteryPolicy::Defer));
+    CHECK_FALSE(power_reduced(battery, BatteryPolicy::Run));
+}
+
+TEST_CASE("list_process_threads: numeric task entries, ascending", "[cpu_topology]") {
+    const fs::path proc = recmeet::test::tmp_path("recmeet_cpu_topology") / "proc";
+    fs::remove_all(proc);
+    for (const char* t : {"1203", "1200", "stat"})
+        fs::create_directories(proc / "1200" / "task" / t);
+    CHECK(list_process_threads(1200, proc) == std::vector<pid_t>{1200, 1203});
+    CHECK(list_process_threads(4242, proc).empty());
+}
+
+TEST_CASE("set_process_cpu_priority: every thread of the child moves", "[cpu_topology]") {
+    const pid_t child = fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        std::thread([] { for (;;) pause(); }).detach();
+        for (;;) pause();
+    }
+    for (int i = 0; i < 200 && list_process_threads(child).size() < 2; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    const std::vector<pid_t> tids = list_process_threads(child);
+    REQUIRE(tids.size() == 2);
+
+    const CpuPriorityChange yielded = set_process_cpu_priority(child, PpCpuPriority::Yield);
+    CHECK(yielded.threads == 2);
+    for (pid_t tid : tids) CHECK(sched_getscheduler(tid) == SCHED_IDLE);
+
+    if (can_restore_cpu_priority()) {
+        const CpuPriorityChange restored = set_process_cpu_priority(child, PpCpuPriority::Normal);
+        CHECK(restored.threads == 2);
+        CHECK(restored.refused == 0);
+        for (pid_t tid : tids) CHECK(sched_getscheduler(tid) == SCHED_OTHER);
+    }
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+}
@@ -89,3 +89,28 @@ TEST_CASE("detect_sources: non-matching pattern returns empty", "[device_enum][i
     // But all_sources should still be populated
     CHECK_FALSE(result.all.empty());
 }
+
+TEST_CASE("pick_sources: pattern, default source and first of each kind", "[device_enum]") {
+    const std::vector<AudioSource> all = {
+        {"alsa_input.usb-Headset", "USB Headset", false},
+        {"alsa_input.pci-Builtin", "Built-in Mic", false},
+        {"alsa_output.usb-Headset.monitor", "Monitor of USB Headset", true},
+        {"alsa_output.pci-Builtin.monitor", "Monitor of Built-in", false},  // by suffix
+    };
+
+    auto picked = pick_sources(all, "alsa_input.pci-Builtin", "");
+    CHECK(picked.mic == "alsa_input.pci-Builtin");
+    CHECK(picked.monitor == "alsa_output.usb-Headset.monitor");
+    CHECK(picked.all.size() == 4);
+
+    picked = pick_sources(all, "", "");
+    CHECK(picked.mic == "alsa_input.usb-Headset");
+
+    picked = pick_sources(all, "alsa_input.usb-Headset", "BUILTIN");
+    CHECK(picked.mic == "alsa_input.pci-Builtin");
+    CHECK(picked.monitor == "alsa_output.pci-Builtin.monitor");
+
+    picked = pick_sources(all, "", "no-such-device");
+    CHECK(picked.mic.empty());
+    CHECK(picked.monitor.empty());
+}
@@ -4,6 +4,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 #include "diarize.h"
+#include "onnx_provider.h"
 #include "util.h"
 #include "test_tmpdir.h"
 
@@ -12,6 +13,7 @@
 #include <filesystem>
 #include <fstream>
 #include <map>
+#include <random>
 #include <set>
 #include <sstream>
 #include <string>
@@ -54,6 +56,23 @@ TEST_CASE("merge_speakers: empty diarization assigns Speaker_01", "[diarize]") {
     CHECK(result[1].text == "Speaker_01: World");
 }
 
+TEST_CASE("assign_speakers + label_speakers: merge_speakers in two steps", "[diarize]") {
+    std::vector<TranscriptSegment> transcript = {
+        {0.0, 4.0, "First"},
+        {4.5, 9.0, "Second"},
+    };
+    DiarizeResult diar;
+    diar.segments = {{0.0, 4.2, 0}, {4.2, 10.0, 1}};
+
+    auto speakers = assign_speakers(transcript, diar);
+    CHECK(speakers == std::vector<int>{0, 1});
+    auto labelled = label_speakers(transcript, speakers, {{1, "Bob"}});
+    REQUIRE(labelled.size() == 2);
+    CHECK(labelled[0].text == "Speaker_01: First");
+    CHECK(labelled[1].text == "Bob: Second");
+    CHECK(labelled[1].text == merge_speakers(transcript, diar, {{1, "Bob"}})[1].text);
+}
+
 TEST_CASE("merge_speakers: correct assignment by overlap", "[diarize]") {
     std::vector<TranscriptSegment> transcript = {
         {0.0, 4.0, "First segment"},
@@ -148,6 +167,49 @@ TEST_CASE("merge_speakers: timestamps preserved through merge", "[diarize]") {
     CHECK(result[1].end == 8.9);
 }
 
+TEST_CASE("merge_speakers: matches a linear max-overlap scan", "[diarize]") {
+    // Overlapping turns (chunk-boundary duplicates), an out-of-order pair,
+    // exact ties and zero-length segments, against the O(T x D) definition.
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<double> len(0.0, 6.0);
+    std::uniform_int_distribution<int> speaker(0, 4);
+    std::uniform_int_distribution<int> coin(0, 3);
+
+    DiarizeResult diar;
+    double t = 0.0;
+    for (int i = 0; i < 400; ++i) {
+        const double start = coin(rng) == 0 ? t - len(rng) : t;  // some overlap back
+        const double end = start + (coin(rng) == 0 ? 2.0 : len(rng));
+        diar.segments.push_back({start, end, speaker(rng)});
+        t = std::max(t, end);
+    }
+    diar.segments.push_back({0.0, 2.0, 1});      // out of order
+    diar.segments.push_back({100.0, 340.0, 2});  // long turn over many others
+
+    std::vector<TranscriptSegment> transcript;
+    for (double s = -3.0; s < t + 5.0; s += 1.0 + len(rng) / 2) {
+        const double e = s + (coin(rng) == 0 ? 0.0 : len(rng));
+        transcript.push_back({s, e, "w"});
+    }
+
+    auto result = merge_speakers(transcript, diar);
+    REQUIRE(result.size() == transcript.size());
+    for (size_t i = 0; i < transcript.size(); ++i) {
+        const auto& seg = transcript[i];
+        int best_speaker = 0;
+        double best_overlap = 0.0;
+        for (const auto& d : diar.segments) {
+            double overlap = std::min(seg.end, d.end) - std::max(seg.start, d.start);
+            if (overlap > best_overlap) {
+                best_overlap = overlap;
+                best_speaker = d.speaker;
+            }
+        }
+        INFO("segment " << i << " [" << seg.start << ", " << seg.end << ")");
+        CHECK(result[i].text == format_speaker(best_speaker) + ": w");
+    }
+}
+
 // ===========================================================================
 // Short-audio min-cluster-duration filter (Phase A.3 follow-up to iter 194
 // diarize-overcount). Free-function tests so they run without sherpa.
@@ -722,6 +784,57 @@ TEST_CASE("diarize_chunked: invalid config throws RecmeetError",
     }
 }
 
+TEST_CASE("plan_chunk_overlap: neighbours cut a shared span into the same windows",
+          "[diarize][stitch]") {
+    DiarizeChunkConfig cfg;
+    cfg.overlap_seconds = 45.0f;
+    const auto extents = plan_chunk_extents(61 * 60 * SAMPLE_RATE + 1234, cfg);
+    REQUIRE(extents.size() == 5);
+    const auto width = static_cast<size_t>(OVERLAP_WINDOW_SEC * SAMPLE_RATE);
+
+    for (size_t i = 0; i + 1 < extents.size(); ++i) {
+        const ChunkOverlap a = plan_chunk_overlap(extents, i);
+        const ChunkOverlap b = plan_chunk_overlap(extents, i + 1);
+        CHECK(a.private_end == extents[i + 1].pcm_start_samples);
+        CHECK(b.private_begin == extents[i].pcm_end_samples);
+
+        // a's trailing windows are b's leading ones, inside both chunks.
+        std::vector<std::pair<size_t, size_t>> trailing, leading;
+        for (const auto& w : a.windows)
+            if (w.begin >= a.private_end) trailing.push_back({w.begin, w.end});
+        for (const auto& w : b.windows)
+            if (w.end <= b.private_begin) leading.push_back({w.begin, w.end});
+        REQUIRE(trailing.size() == 22);  // 45 s in 2 s windows, the tail in the last
+        CHECK(trailing == leading);
+        CHECK(trailing.front().first == extents[i + 1].pcm_start_samples);
+        CHECK(trailing.back().second == extents[i].pcm_end_samples);
+        CHECK(trailing.front().second - trailing.front().first == width);
+        CHECK(trailing.back().second - trailing.back().first < 2 * width);
+    }
+    const ChunkOverlap first = plan_chunk_overlap(extents, 0);
+    const ChunkOverlap last = plan_chunk_overlap(extents, extents.size() - 1);
+    CHECK(first.private_begin == 0);
+    CHECK(last.private_end == extents.back().pcm_end_samples);
+    CHECK(plan_chunk_overlap({extents[0]}, 0).windows.empty());
+}
+
+TEST_CASE("overlap_window_owners: the speaker covering most of a window",
+          "[diarize][stitch]") {
+    // Chunk PCM starts 10 s in; windows are global.
+    const ChunkExtents ext = make_extents(10.0, 100.0, 10.0, 90.0);
+    const DiarizeResult diar = make_chunk({
+        {0.0, 1.5, 0},   // 1.5 of [10, 12) s
+        {2.0, 2.8, 1},   // 0.8 of [12, 14) s: no majority
+        {4.0, 6.0, 2},   // all of [14, 16) s
+        {5.0, 6.0, 0},   // half of it, overlapping speaker 2
+    }, 3);
+    const auto at = [](double sec) { return static_cast<size_t>(sec * SAMPLE_RATE); };
+    const std::vector<OverlapWindow> windows = {
+        {at(10.0), at(12.0)}, {at(12.0), at(14.0)}, {at(14.0), at(16.0)}, {at(50.0), at(52.0)},
+    };
+    CHECK(overlap_window_owners(diar, ext, windows) == std::vector<int>{0, -1, 2, -1});
+}
+
 // ===========================================================================
 // Phase B.1/B.3 — `apply_collapse` shared helper coverage.
 //
@@ -1328,6 +1441,34 @@ TEST_CASE("dump_centroids_json: empty centroids still produces valid skeleton",
     std::filesystem::remove(tmp);
 }
 
+TEST_CASE("choose_onnx_provider: GPU when usable, XNNPACK on weak SIMD, else CPU", "[diarize]") {
+    const std::vector<std::string> cpu_only = {"CPUExecutionProvider"};
+    const std::vector<std::string> all = {"CUDAExecutionProvider", "XnnpackExecutionProvider",
+                                          "CPUExecutionProvider"};
+    OnnxHost nvidia;
+    nvidia.nvidia_device = true;
+    OnnxHost arm;
+    arm.weak_simd = true;
+    const OnnxHost avx2;
+
+    CHECK(choose_onnx_provider("auto", all, nvidia) == "cuda");
+    CHECK(choose_onnx_provider("auto", all, arm) == "xnnpack");
+    CHECK(choose_onnx_provider("auto", all, avx2) == "cpu");
+    CHECK(choose_onnx_provider("auto", cpu_only, nvidia) == "cpu");
+    // The CUDA EP without a device, or a device without the EP, is the CPU.
+    CHECK(choose_onnx_provider("cuda", all, avx2) == "cpu");
+    CHECK(choose_onnx_provider("cuda", cpu_only, nvidia) == "cpu");
+    // An explicit request goes where it can even on a host auto would not.
+    CHECK(choose_onnx_provider("xnnpack", all, avx2) == "xnnpack");
+    CHECK(choose_onnx_provider("xnnpack", cpu_only, arm) == "cpu");
+    CHECK(choose_onnx_provider("cpu", all, nvidia) == "cpu");
+
+    CHECK(valid_onnx_provider("auto"));
+    CHECK(valid_onnx_provider("xnnpack"));
+    CHECK_FALSE(valid_onnx_provider("vulkan"));
+    CHECK_FALSE(valid_onnx_provider(""));
+}
+
 #if RECMEET_USE_SHERPA
 TEST_CASE("stitch_chunks: dump path emits centroid JSON with compaction IDs",
           "[diarize][dump-centroids][t2-1]") {
@@ -0,0 +1,59 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "diarize_sweep.h"
+
+#include <cmath>
+
+using namespace recmeet;
+
+TEST_CASE("parse_sweep_values: comma-separated positive thresholds", "[diarize_sweep]") {
+    CHECK(parse_sweep_values("1.18") == std::vector<float>{1.18f});
+    CHECK(parse_sweep_values("0.9,1.0,1.18") == std::vector<float>{0.9f, 1.0f, 1.18f});
+    CHECK_THROWS_AS(parse_sweep_values(""), RecmeetError);
+    CHECK_THROWS_AS(parse_sweep_values("0.9,,1.0"), RecmeetError);
+    CHECK_THROWS_AS(parse_sweep_values("0.9,"), RecmeetError);
+    CHECK_THROWS_AS(parse_sweep_values("0.9,abc"), RecmeetError);
+    CHECK_THROWS_AS(parse_sweep_values("0.5x"), RecmeetError);
+    CHECK_THROWS_AS(parse_sweep_values("0"), RecmeetError);
+    CHECK_THROWS_AS(parse_sweep_values("-0.5"), RecmeetError);
+}
+
+TEST_CASE("expand_sweep_grid: cluster outermost, config fills empty lists",
+          "[diarize_sweep]") {
+    Config cfg;
+    cfg.cluster_threshold = 1.18f;
+    cfg.stitch_threshold = 0.6f;
+    cfg.collapse_threshold = 0.65f;
+
+    auto single = expand_sweep_grid({}, {}, {}, cfg);
+    REQUIRE(single.size() == 1);
+    CHECK(single[0].cluster_threshold == 1.18f);
+    CHECK(single[0].stitch_threshold == 0.6f);
+    CHECK(single[0].collapse_threshold == 0.65f);
+
+    auto grid = expand_sweep_grid({1.0f, 1.2f}, {}, {0.5f, 0.6f, 0.7f}, cfg);
+    REQUIRE(grid.size() == 6);
+    for (size_t i = 0; i < grid.size(); ++i) {
+        CHECK(grid[i].cluster_threshold == (i < 3 ? 1.0f : 1.2f));
+        CHECK(grid[i].stitch_threshold == 0.6f);
+        CHECK(grid[i].collapse_threshold == std::vector<float>{0.5f, 0.6f, 0.7f}[i % 3]);
+    }
+}
+
+TEST_CASE("centroid_similarity_stats: over distinct pairs", "[diarize_sweep]") {
+    CHECK(centroid_similarity_stats({}).pairs == 0);
+    CHECK(centroid_similarity_stats({{0, {1.0f, 0.0f}}}).pairs == 0);
+
+    auto stats = centroid_similarity_stats({
+        {0, {1.0f, 0.0f}},
+        {1, {0.0f, 1.0f}},
+        {2, {1.0f, 1.0f}},
+    });
+    CHECK(stats.pairs == 3);
+    CHECK(stats.min == Catch::Approx(0.0).margin(1e-12));
+    CHECK(stats.max == Catch::Approx(std::sqrt(0.5)));
+    CHECK(stats.mean == Catch::Approx(2.0 * std::sqrt(0.5) / 3.0));
+}
@@ -0,0 +1,167 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "embedding_set.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace recmeet;
+
+namespace {
+
+std::vector<float> random_embedding(std::size_t dim, std::mt19937& rng) {
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> v(dim);
+    for (auto& x : v) x = dist(rng);
+    return v;
+}
+
+// The sequential double-precision definition the stitcher used before.
+double reference_cosine(const std::vector<float>& a, const std::vector<float>& b) {
+    double dot = 0.0, na = 0.0, nb = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        dot += double(a[i]) * double(b[i]);
+        na += double(a[i]) * double(a[i]);
+        nb += double(b[i]) * double(b[i]);
+    }
+    return dot / (std::sqrt(na) * std::sqrt(nb));
+}
+
+} // namespace
+
+TEST_CASE("cosine_similarity: matches the sequential definition", "[embedding_set]") {
+    std::mt19937 rng(24);
+    for (std::size_t dim : {std::size_t(1), std::size_t(7), std::size_t(192), std::size_t(512)}) {
+        INFO("dim " << dim);
+        auto a = random_embedding(dim, rng);
+        auto b = random_embedding(dim, rng);
+        CHECK(cosine_similarity(a, b) == Catch::Approx(reference_cosine(a, b)).epsilon(1e-12));
+        CHECK(cosine_similarity(a, b) == cosine_similarity(b, a));
+        CHECK(cosine_similarity(a, a) == Catch::Approx(1.0).epsilon(1e-12));
+    }
+}
+
+TEST_CASE("cosine_similarity: degenerate operands compare as 0", "[embedding_set]") {
+    CHECK(cosine_similarity({}, {}) == 0.0);
+    CHECK(cosine_similarity({1.0f, 2.0f}, {1.0f, 2.0f, 3.0f}) == 0.0);
+    CHECK(cosine_similarity({0.0f, 0.0f}, {1.0f, 2.0f}) == 0.0);
+}
+
+TEST_CASE("EmbeddingSet: rows agree with cosine_similarity", "[embedding_set]") {
+    std::mt19937 rng(25);
+    constexpr std::size_t kDim = 193;  // not a multiple of the row padding
+    std::vector<std::vector<float>> rows;
+    EmbeddingSet set(kDim);
+    for (int i = 0; i < 6; ++i) {
+        rows.push_back(random_embedding(kDim, rng));
+        CHECK(set.add(rows.back()) == static_cast<std::size_t>(i));
+    }
+    REQUIRE(set.size() == 6);
+
+    rows[2] = random_embedding(kDim, rng);
+    set.set(2, rows[2]);
+
+    for (std::size_t i = 0; i < rows.size(); ++i)
+        for (std::size_t j = 0; j < rows.size(); ++j)
+            CHECK(set.cosine(i, j) == cosine_similarity(rows[i], rows[j]));
+
+    const auto query = random_embedding(kDim, rng);
+    std::vector<double> sims;
+    set.similarities(query, sims);
+    REQUIRE(sims.size() == rows.size());
+    for (std::size_t i = 0; i < rows.size(); ++i)
+        CHECK(sims[i] == cosine_similarity(query, rows[i]));
+}
+
+TEST_CASE("EmbeddingSet: a row of the wrong size keeps its index and compares as 0",
+          "[embedding_set]") {
+    EmbeddingSet set(3);
+    set.add({1.0f, 0.0f, 0.0f});
+    set.add({});
+    set.add({1.0f, 1.0f, 0.0f});
+    REQUIRE(set.size() == 3);
+    CHECK(set.cosine(0, 1) == 0.0);
+    CHECK(set.cosine(0, 2) == Catch::Approx(std::sqrt(0.5)));
+
+    std::vector<double> sims;
+    set.similarities({1.0f, 2.0f}, sims);
+    CHECK(sims == std::vector<double>{0.0, 0.0, 0.0});
+}
+
+TEST_CASE("embedding precision: names round-trip", "[embedding_set]") {
+    for (auto p : {EmbeddingPrecision::F32, EmbeddingPrecision::F16, EmbeddingPrecision::Int8}) {
+        EmbeddingPrecision parsed = EmbeddingPrecision::F32;
+        CHECK(parse_embedding_precision(embedding_precision_name(p), parsed));
+        CHECK(parsed == p);
+    }
+    EmbeddingPrecision parsed;
+    CHECK_FALSE(parse_embedding_precision("fp16", parsed));
+}
+
+TEST_CASE("encode_embedding: f16 and int8 round-trip within their step", "[embedding_set]") {
+    std::mt19937 rng(11);
+    auto v = random_embedding(192, rng);
+    v[0] = 0.0f;
+    v[1] = 1e-6f;  // an f16 subnormal
+    float max_abs = 0.0f;
+    for (float x : v) max_abs = std::max(max_abs, std::fabs(x));
+
+    std::vector<float> half, codes;
+    REQUIRE(decode_embedding(encode_embedding(v, EmbeddingPrecision::F16),
+                             EmbeddingPrecision::F16, half));
+    REQUIRE(decode_embedding(encode_embedding(v, EmbeddingPrecision::Int8),
+                             EmbeddingPrecision::Int8, codes));
+    REQUIRE(half.size() == v.size());
+    REQUIRE(codes.size() == v.size());
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        INFO("i = " << i);
+        CHECK(std::fabs(half[i] - v[i]) <= std::fabs(v[i]) / 2048.0f + 3e-8f);
+        CHECK(std::fabs(codes[i] - v[i]) <= max_abs / 254.0f * 1.0001f);
+    }
+    CHECK(half[0] == 0.0f);
+    CHECK(half[1] > 0.0f);
+
+    // Exactly representable values survive f16 unchanged.
+    std::vector<float> exact = {1.0f, -0.5f, 65504.0f, 0.099975586f}, back;
+    REQUIRE(decode_embedding(encode_embedding(exact, EmbeddingPrecision::F16),
+                             EmbeddingPrecision::F16, back));
+    CHECK(back == exact);
+
+    std::vector<float> out;
+    CHECK_FALSE(decode_embedding("not base64!", EmbeddingPrecision::F16, out));
+    CHECK_FALSE(decode_embedding(encode_embedding({1.0f}, EmbeddingPrecision::F16).substr(0, 2),
+                                 EmbeddingPrecision::Int8, out));
+}
+
+// The drift analysed in docs/ARCHITECTURE.md: pairs scattered around the
+// 0.6 identification threshold, both sides stored at reduced precision.
+TEST_CASE("encode_embedding: similarity drift near the 0.6 threshold", "[embedding_set]") {
+    std::mt19937 rng(12);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    for (std::size_t dim : {std::size_t(192), std::size_t(512)}) {
+        double worst_f16 = 0.0, worst_int8 = 0.0;
+        for (int t = 0; t < 200; ++t) {
+            auto a = random_embedding(dim, rng);
+            std::vector<float> b(dim);
+            for (std::size_t i = 0; i < dim; ++i) b[i] = 0.6f * a[i] + 0.8f * noise(rng);
+            const double exact = cosine_similarity(a, b);
+            for (auto p : {EmbeddingPrecision::F16, EmbeddingPrecision::Int8}) {
+                std::vector<float> qa, qb;
+                REQUIRE(decode_embedding(encode_embedding(a, p), p, qa));
+                REQUIRE(decode_embedding(encode_embedding(b, p), p, qb));
+                const double drift = std::fabs(cosine_similarity(qa, qb) - exact);
+                double& worst = p == EmbeddingPrecision::F16 ? worst_f16 : worst_int8;
+                worst = std::max(worst, drift);
+            }
+        }
+        INFO("dim " << dim << ": f16 " << worst_f16 << ", int8 " << worst_int8);
+        CHECK(worst_f16 < 2e-4);
+        CHECK(worst_int8 < 5e-3);
+    }
+}
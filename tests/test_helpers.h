@@ -4,6 +4,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <chrono>
 #include <fstream>
@@ -12,10 +13,16 @@
 #include <string>
 #include <filesystem>
 #include <system_error>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <sndfile.h>
 
+#include "backend_info.h"
+#include "bench_env.h"
+#include "util.h"
+
 namespace recmeet {
 
 namespace fs = std::filesystem;
@@ -24,6 +31,9 @@ namespace test_helpers {
 // ---------------------------------------------------------------------------
 // JSON results collector — accumulates entries, writes build/benchmark_results.json at exit
 // ---------------------------------------------------------------------------
+//
+// The file carries the git SHA, host and GPU it was measured on
+// (bench_env.h); `recmeet-bench compare` checks it against a baseline.
 
 struct BenchmarkResult {
     std::string json_fragment;  // pre-formatted JSON object body
@@ -33,6 +43,8 @@ class BenchmarkResults {
 public:
     static void add(const std::string& fragment) {
         if (!registered_) {
+            // Taken now: backends must not be loaded from an atexit handler.
+            environment_ = bench_environment_json(active_device_signature());
             std::atexit(write_json);
             registered_ = true;
         }
@@ -56,7 +68,8 @@ private:
         strftime(ts, sizeof(ts), "%Y-%m-%dT%H:%M:%S", &tm);
 
         std::ofstream out(out_path);
-        out << "{\n  \"timestamp\": \"" << ts << "\",\n  \"results\": [\n";
+        out << "{\n  \"kind\": \"benchmark\",\n  \"timestamp\": \"" << ts << "\",\n"
+            << "  \"environment\": " << environment_ << ",\n  \"results\": [\n";
         for (size_t i = 0; i < entries_.size(); ++i) {
             out << "    {" << entries_[i].json_fragment << "}";
             if (i + 1 < entries_.size()) out << ",";
@@ -79,9 +92,37 @@ private:
     }
 
     static inline std::vector<BenchmarkResult> entries_;
+    static inline std::string environment_;
     static inline bool registered_ = false;
 };
 
+/// Run `fn` while a background thread polls /proc/self/statm at 1 Hz and
+/// tracks the running max. Returns (wall_clock_secs, peak_rss_kb).
+template <typename Fn>
+std::pair<double, long> measure_with_rss(Fn&& fn) {
+    std::atomic<bool> stop{false};
+    std::atomic<long> peak{0};
+    // Seed with the entry-point reading so we always report at least the
+    // current RSS, even if `fn` returns in under 1 second.
+    long seed = read_self_rss_kb();
+    peak.store(seed);
+    std::thread sampler([&]() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            long now_kb = read_self_rss_kb();
+            long prev = peak.load(std::memory_order_relaxed);
+            while (now_kb > prev &&
+                   !peak.compare_exchange_weak(prev, now_kb)) {}
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    });
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    auto t1 = std::chrono::steady_clock::now();
+    stop.store(true);
+    sampler.join();
+    return {std::chrono::duration<double>(t1 - t0).count(), peak.load()};
+}
+
 /// Walk up from cwd to find the project root (contains CMakeLists.txt and assets/).
 inline fs::path find_project_root() {
     fs::path dir = fs::current_path();
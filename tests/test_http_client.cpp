@@ -6,7 +6,16 @@
 #include "test_tmpdir.h"
 #include "util.h"
 
+#include <arpa/inet.h>
+#include <atomic>
 #include <fstream>
+#include <iterator>
+#include <netinet/in.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
 
 using namespace recmeet;
 
@@ -72,3 +81,306 @@ TEST_CASE("http_post_json: throws for unsupported protocol", "[http_client]") {
         http_post_json("file:///tmp/test.txt", R"({"key":"val"})"),
         RecmeetError);
 }
+
+TEST_CASE("http_retryable_status: 429 and transient 5xx only", "[http_client]") {
+    CHECK(http_retryable_status(429));
+    CHECK(http_retryable_status(500));
+    CHECK(http_retryable_status(503));
+    CHECK_FALSE(http_retryable_status(501));
+    CHECK_FALSE(http_retryable_status(505));
+    CHECK_FALSE(http_retryable_status(200));
+    CHECK_FALSE(http_retryable_status(400));
+    CHECK_FALSE(http_retryable_status(401));
+}
+
+TEST_CASE("http_retry_delay_ms: exponential, capped, Retry-After wins", "[http_client]") {
+    CHECK(http_retry_delay_ms(0, 0) == HTTP_RETRY_BASE_MS);
+    CHECK(http_retry_delay_ms(1, 0) == 2 * HTTP_RETRY_BASE_MS);
+    CHECK(http_retry_delay_ms(2, 0) == 4 * HTTP_RETRY_BASE_MS);
+    CHECK(http_retry_delay_ms(40, 0) == HTTP_MAX_RETRY_DELAY_MS);
+    CHECK(http_retry_delay_ms(0, 3) == 3000);
+    CHECK(http_retry_delay_ms(0, 3600) == HTTP_MAX_RETRY_DELAY_MS);
+}
+
+namespace {
+
+// Loopback HTTP/1.1 server answering each request with the next status in
+// `statuses` (the last repeats), on keep-alive connections it counts.
+class ScriptedServer {
+public:
+    explicit ScriptedServer(std::vector<int> statuses) : statuses_(std::move(statuses)) {
+        fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ::bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        ::listen(fd_, 8);
+        socklen_t len = sizeof(addr);
+        ::getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread([this] { run(); });
+    }
+    ~ScriptedServer() {
+        stop_ = true;
+        ::shutdown(fd_, SHUT_RDWR);
+        // The client keeps its connection open for the next request.
+        if (int c = client_.load(); c >= 0) ::shutdown(c, SHUT_RDWR);
+        thread_.join();
+        ::close(fd_);
+    }
+
+    std::string url() const { return "http://127.0.0.1:" + std::to_string(port_) + "/v1"; }
+    int connections() const { return connections_; }
+    int requests() const { return requests_; }
+
+private:
+    void run() {
+        while (!stop_) {
+            int c = ::accept(fd_, nullptr, nullptr);
+            if (c < 0) return;
+            ++connections_;
+            client_ = c;
+            if (!stop_) serve(c);
+            client_ = -1;
+            ::close(c);
+        }
+    }
+
+    // Requests on one connection until the client closes it.
+    void serve(int c) {
+        std::string buf;
+        char chunk[4096];
+        for (;;) {
+            size_t head_end;
+            while ((head_end = buf.find("\r\n\r\n")) == std::string::npos) {
+                ssize_t n = ::recv(c, chunk, sizeof(chunk), 0);
+                if (n <= 0) return;
+                buf.append(chunk, n);
+            }
+            size_t body_len = 0;
+            const auto cl = buf.find("Content-Length: ");
+            if (cl != std::string::npos && cl < head_end)
+                body_len = std::stoul(buf.substr(cl + 16));
+            while (buf.size() < head_end + 4 + body_len) {
+                ssize_t n = ::recv(c, chunk, sizeof(chunk), 0);
+                if (n <= 0) return;
+                buf.append(chunk, n);
+            }
+            buf.erase(0, head_end + 4 + body_len);
+
+            const size_t i = static_cast<size_t>(requests_++);
+            const int status = statuses_[std::min(i, statuses_.size() - 1)];
+            const std::string body = "{\"n\":" + std::to_string(i) + "}";
+            const std::string resp = "HTTP/1.1 " + std::to_string(status) + " X\r\n" +
+                (status == 429 ? "Retry-After: 0\r\n" : "") +
+                "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+            if (::send(c, resp.data(), resp.size(), MSG_NOSIGNAL) < 0) return;
+        }
+    }
+
+    std::vector<int> statuses_;
+    int fd_ = -1;
+    int port_ = 0;
+    std::atomic<bool> stop_{false};
+    std::atomic<int> connections_{0};
+    std::atomic<int> requests_{0};
+    std::atomic<int> client_{-1};
+    std::thread thread_;
+};
+
+} // namespace
+
+TEST_CASE("http_post_json: retries 503 and 429, then returns the success", "[http_client]") {
+    ScriptedServer server({503, 429, 200});
+    CHECK(http_post_json(server.url(), R"({"k":1})") == R"({"n":2})");
+    CHECK(server.requests() == 3);
+}
+
+TEST_CASE("http_post_json: gives up after HTTP_MAX_ATTEMPTS", "[http_client]") {
+    ScriptedServer server({500});
+    CHECK_THROWS_AS(http_post_json(server.url(), "{}"), RecmeetError);
+    CHECK(server.requests() == HTTP_MAX_ATTEMPTS);
+}
+
+TEST_CASE("http_post_json: a client error is not retried", "[http_client]") {
+    ScriptedServer server({400, 200});
+    CHECK_THROWS_AS(http_post_json(server.url(), "{}"), RecmeetError);
+    CHECK(server.requests() == 1);
+}
+
+TEST_CASE("http_post_json: consecutive requests reuse one connection", "[http_client]") {
+    ScriptedServer server({200});
+    for (int i = 0; i < 3; ++i) http_post_json(server.url(), "{}");
+    CHECK(server.requests() == 3);
+    CHECK(server.connections() == 1);
+}
+
+TEST_CASE("http_post_json_stream: an error body is not streamed", "[http_client]") {
+    ScriptedServer server({503, 200});
+    std::string streamed;
+    auto body = http_post_json_stream(server.url(), "{}", {},
+                                      [&](const char* p, size_t n) { streamed.append(p, n); });
+    CHECK(body == R"({"n":1})");
+    CHECK(streamed == body);
+}
+
+namespace {
+
+// Loopback HTTP/1.1 server for one file: answers `Range: bytes=N-` with a
+// 206 unless `honor_range` is false, and cuts its first response off after
+// `cut_after` bytes of body (0 = never). One request per connection.
+class FileServer {
+public:
+    FileServer(std::string body, bool honor_range, size_t cut_after)
+        : body_(std::move(body)), honor_range_(honor_range), cut_after_(cut_after) {
+        fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ::bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        ::listen(fd_, 8);
+        socklen_t len = sizeof(addr);
+        ::getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread([this] { run(); });
+    }
+    ~FileServer() {
+        stop_ = true;
+        ::shutdown(fd_, SHUT_RDWR);
+        thread_.join();
+        ::close(fd_);
+    }
+
+    std::string url() const { return "http://127.0.0.1:" + std::to_string(port_) + "/m.bin"; }
+    std::vector<size_t> range_starts() const { return starts_; }  // after the run
+
+private:
+    void run() {
+        while (!stop_) {
+            int c = ::accept(fd_, nullptr, nullptr);
+            if (c < 0) return;
+            if (!stop_) serve(c);
+            ::close(c);
+        }
+    }
+
+    void serve(int c) {
+        std::string head;
+        char chunk[4096];
+        while (head.find("\r\n\r\n") == std::string::npos) {
+            ssize_t n = ::recv(c, chunk, sizeof(chunk), 0);
+            if (n <= 0) return;
+            head.append(chunk, n);
+        }
+        size_t start = 0;
+        const auto r = head.find("Range: bytes=");
+        if (r != std::string::npos) start = std::stoul(head.substr(r + 13));
+        starts_.push_back(start);
+        if (!honor_range_) start = 0;
+
+        const std::string part = body_.substr(start);
+        std::string resp = std::string(start > 0 ? "HTTP/1.1 206 Partial\r\n" : "HTTP/1.1 200 OK\r\n") +
+            "Content-Length: " + std::to_string(part.size()) + "\r\n" +
+            "Connection: close\r\n\r\n";
+        const bool cut = cut_after_ > 0 && requests_++ == 0;
+        resp += cut ? part.substr(0, cut_after_) : part;
+        ::send(c, resp.data(), resp.size(), MSG_NOSIGNAL);
+    }
+
+    std::string body_;
+    bool honor_range_;
+    size_t cut_after_;
+    int fd_ = -1;
+    int port_ = 0;
+    int requests_ = 0;
+    std::atomic<bool> stop_{false};
+    std::vector<size_t> starts_;
+    std::thread thread_;
+};
+
+std::string read_file(const fs::path& p) {
+    std::ifstream in(p, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+std::string pattern(size_t n) {
+    std::string s(n, '\0');
+    for (size_t i = 0; i < n; ++i) s[i] = static_cast<char>('a' + i % 26);
+    return s;
+}
+
+} // namespace
+
+TEST_CASE("http_download: a broken transfer resumes with a Range request", "[http_client]") {
+    const std::string body = pattern(200000);
+    fs::path file = tmp_dir() / "resume.part";
+    fs::remove(file);
+    std::vector<uint64_t> seen;
+    {
+        FileServer server(body, true, 50000);
+        auto got = http_download(server.url(), file.string(),
+                                 [&](uint64_t done, uint64_t) { seen.push_back(done); });
+        CHECK(got.bytes == body.size());
+        const auto starts = server.range_starts();
+        REQUIRE(starts.size() == 2);
+        CHECK(starts[0] == 0);
+        CHECK(starts[1] == 50000);
+    }
+    CHECK(read_file(file) == body);
+    REQUIRE_FALSE(seen.empty());
+    CHECK(seen.back() == body.size());
+    fs::remove(file);
+}
+
+TEST_CASE("http_download: keeps a partial file, or replaces it when ranges are ignored",
+          "[http_client]") {
+    const std::string body = pattern(30000);
+    fs::path file = tmp_dir() / "partial.part";
+    std::ofstream(file, std::ios::binary) << body.substr(0, 12345);
+    {
+        FileServer server(body, true, 0);
+        auto got = http_download(server.url(), file.string());
+        CHECK(got.fetched == body.size() - 12345);
+        CHECK(server.range_starts() == std::vector<size_t>{12345});
+    }
+    CHECK(read_file(file) == body);
+
+    std::ofstream(file, std::ios::binary) << "stale bytes";
+    {
+        FileServer server(body, false, 0);
+        http_download(server.url(), file.string());
+    }
+    CHECK(read_file(file) == body);
+    fs::remove(file);
+}
+
+TEST_CASE("http_download: on_data sees each byte with its offset in the file", "[http_client]") {
+    const std::string body = pattern(200000);
+    fs::path file = tmp_dir() / "tee.part";
+    std::ofstream(file, std::ios::binary) << body.substr(0, 1000);
+    std::string copy(body.size(), '\0');
+    uint64_t first = UINT64_MAX, covered = 0;
+    {
+        FileServer server(body, true, 50000);  // resumed, then cut and resumed again
+        http_download(server.url(), file.string(), nullptr,
+                      [&](uint64_t offset, const char* data, size_t n) {
+                          if (first == UINT64_MAX) first = offset;
+                          REQUIRE(offset + n <= copy.size());
+                          copy.replace(offset, n, data, n);
+                          covered += n;
+                      });
+    }
+    CHECK(first == 1000);  // the kept bytes are not handed over again
+    CHECK(covered == body.size() - 1000);
+    CHECK(copy.substr(1000) == body.substr(1000));
+
+    // An exception from on_data stops the download and comes back as is.
+    fs::remove(file);
+    FileServer server(body, true, 0);
+    CHECK_THROWS_AS(http_download(server.url(), file.string(), nullptr,
+                                  [](uint64_t, const char*, size_t) {
+                                      throw std::length_error("consumer gave up");
+                                  }),
+                    std::length_error);
+    fs::remove(file);
+}
@@ -162,6 +162,27 @@ TEST_CASE("IpcClient: read_events exits when callback closes connection", "[ipc_
     srv.join();
 }
 
+TEST_CASE("IpcClient: read_events disconnects when the server goes away", "[ipc_client]") {
+    unlink(TEST_SOCK);
+
+    IpcClient client(TEST_SOCK);
+    {
+        IpcServer server(TEST_SOCK);
+        REQUIRE(server.start());
+        std::thread srv([&server]() { server.run(); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        REQUIRE(client.connect());
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        server.stop();
+        srv.join();
+    }  // closes the client's socket
+
+    // A reader polling in a loop (recmeet-web's summary stream) stops on
+    // connected() instead of spinning on the hung-up socket.
+    CHECK_FALSE(client.read_events("", 3000));
+    CHECK_FALSE(client.connected());
+}
+
 TEST_CASE("daemon_running: returns false when no daemon", "[ipc_client]") {
     unlink(TEST_SOCK);
     CHECK_FALSE(daemon_running(TEST_SOCK));
@@ -219,3 +240,62 @@ TEST_CASE("IpcClient: set_address() updates address when disconnected", "[ipc_cl
     client.set_address("/tmp/other.sock");
     CHECK_FALSE(client.is_remote());
 }
+
+TEST_CASE("IpcClient: negotiate_framing() switches the connection to MessagePack",
+          "[ipc_client]") {
+    unlink(TEST_SOCK);
+
+    IpcServer server(TEST_SOCK);
+    server.on("slow", [&server](const IpcRequest& req, IpcResponse& resp, IpcError&) {
+        IpcEvent ev;
+        ev.event = "progress";
+        ev.data["pct"] = 50;
+        server.broadcast(ev);
+        resp.result["echo"] = json_val_as_string(req.params.at("text"));
+        return true;
+    });
+    REQUIRE(server.start());
+    std::thread srv([&server]() { server.run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    IpcClient binary(TEST_SOCK);
+    IpcClient text(TEST_SOCK);
+    REQUIRE(binary.connect());
+    REQUIRE(text.connect());
+    CHECK(binary.framing() == IpcFraming::Json);
+    REQUIRE(binary.negotiate_framing(IpcFraming::MsgPack));
+    CHECK(binary.framing() == IpcFraming::MsgPack);
+
+    int binary_events = 0, text_events = 0;
+    binary.set_event_callback([&](const IpcEvent& ev) {
+        if (ev.event == "progress" && json_val_as_int(ev.data.at("pct")) == 50) ++binary_events;
+    });
+    text.set_event_callback([&](const IpcEvent& ev) {
+        if (ev.event == "progress") ++text_events;
+    });
+
+    IpcResponse resp;
+    IpcError err;
+    JsonMap params;
+    params["text"] = std::string("caf\xc3\xa9 \"quoted\"\n");
+    REQUIRE(binary.call("slow", params, resp, err));
+    CHECK(json_val_as_string(resp.result["echo"]) == "caf\xc3\xa9 \"quoted\"\n");
+    CHECK(binary_events == 1);
+    // The NDJSON client on the same server gets the same broadcast.
+    CHECK(text.read_events("progress", 2000));
+    CHECK(text_events == 1);
+
+    // An unknown framing is declined; a reconnect starts on NDJSON again.
+    JsonMap hello;
+    hello["framing"] = std::string("cbor");
+    REQUIRE(text.call("hello", hello, resp, err));
+    CHECK(json_val_as_string(resp.result["framing"]) == "json");
+    CHECK(text.framing() == IpcFraming::Json);
+    binary.close_connection();
+    REQUIRE(binary.connect());
+    CHECK(binary.framing() == IpcFraming::Json);
+    REQUIRE(binary.call("slow", params, resp, err));
+
+    server.stop();
+    srv.join();
+}
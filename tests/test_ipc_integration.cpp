@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT OR Apache-2.0
 
 #include <catch2/catch_test_macros.hpp>
+#include "artifact_transfer.h"
 #include "ipc_server.h"
 #include "ipc_client.h"
 #include "ipc_protocol.h"
@@ -14,12 +15,16 @@
 #include <chrono>
 #include <memory>
 #include <condition_variable>
+#include <fstream>
 #include <mutex>
 #include <queue>
 #include <signal.h>
 #include <string>
 #include <thread>
 #include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
 #include <unistd.h>
 
 // Ignore SIGPIPE so writing to disconnected clients doesn't kill the process
@@ -2089,6 +2094,189 @@ TEST_CASE("TCP reconnect: server restart detected by client", "[ipc][integration
     srv2.join();
 }
 
+// ---------------------------------------------------------------------------
+// Artifact transfer (artifact_transfer.h)
+// ---------------------------------------------------------------------------
+
+namespace {
+
+// One request on a raw artifact-port connection; the header line back.
+std::string artifact_exchange(uint16_t port, const std::string& request) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in sa{};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &sa.sin_addr);
+    std::string line;
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&sa), sizeof(sa)) == 0 &&
+        write(fd, request.data(), request.size()) == static_cast<ssize_t>(request.size())) {
+        char c;
+        while (read(fd, &c, 1) == 1 && c != '\n') line += c;
+    }
+    close(fd);
+    return line;
+}
+
+std::string artifact_bytes(size_t n) {
+    std::string s(n, '\0');
+    uint32_t x = 12345;
+    for (auto& c : s) {
+        x = x * 1103515245u + 12345u;
+        c = static_cast<char>(x >> 16);
+    }
+    return s;
+}
+
+std::string file_bytes(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+} // anonymous namespace
+
+TEST_CASE("Artifact request lines round-trip and reject malformed input", "[ipc][artifact]") {
+    ArtifactRequest req{"abc123", 4096, 65536};
+    ArtifactRequest back;
+    REQUIRE(parse_artifact_request(format_artifact_request(req), back));
+    CHECK(back.token == "abc123");
+    CHECK(back.offset == 4096);
+    CHECK(back.length == 65536);
+
+    for (const char* bad : {"", "fetch abc 0", "fetch abc 0 0 0", "get abc 0 0",
+                            "fetch  0 0", "fetch abc -1 0", "fetch abc 0 1e3",
+                            "fetch abc 99999999999999999999 0"})
+        CHECK_FALSE(parse_artifact_request(bad, back));
+
+    CHECK(artifact_port_for(9090) == 9091);
+    CHECK(artifact_port_for(65535) == 0);
+}
+
+TEST_CASE("ArtifactServer grants only regular files under its roots", "[ipc][artifact]") {
+    const fs::path root = recmeet::test::tmp_path("artifact_roots");
+    fs::remove_all(root);
+    fs::create_directories(root / "meetings" / "2026-05-07_10-30");
+    fs::create_directories(root / "private");
+    write_text_file(root / "meetings" / "2026-05-07_10-30" / "transcript.txt", "hello");
+    write_text_file(root / "private" / "secret.txt", "no");
+    fs::create_symlink(root / "private" / "secret.txt", root / "meetings" / "link.txt");
+
+    ArtifactServer artifacts([&root] { return std::vector<fs::path>{root / "meetings", ""}; });
+    ArtifactGrant grant;
+    std::string error;
+    REQUIRE(artifacts.grant(root / "meetings" / "2026-05-07_10-30" / "transcript.txt",
+                            grant, error));
+    CHECK(grant.size == 5);
+    CHECK(grant.token.size() == 64);
+    CHECK(grant.version.rfind("5-", 0) == 0);
+
+    ArtifactGrant other;
+    REQUIRE(artifacts.grant(root / "meetings" / "2026-05-07_10-30" / "transcript.txt",
+                            other, error));
+    CHECK(other.token != grant.token);
+    CHECK(other.version == grant.version);
+
+    CHECK_FALSE(artifacts.grant(root / "private" / "secret.txt", other, error));
+    CHECK_FALSE(artifacts.grant(root / "meetings" / "link.txt", other, error));
+    CHECK_FALSE(artifacts.grant(root / "meetings" / ".." / "private" / "secret.txt", other, error));
+    CHECK_FALSE(artifacts.grant(root / "meetings" / "2026-05-07_10-30", other, error));
+    CHECK_FALSE(artifacts.grant(root / "meetings" / "missing.wav", other, error));
+    fs::remove_all(root);
+}
+
+TEST_CASE("fetch_artifact streams over the artifact port and resumes a partial file",
+          "[ipc][artifact]") {
+    const char* TCP_ADDR = "127.0.0.1:19879";
+    const fs::path root = recmeet::test::tmp_path("artifact_fetch");
+    fs::remove_all(root);
+    fs::create_directories(root / "meetings");
+    fs::create_directories(root / "local");
+    // Several windows of several chunks each, ending mid-chunk.
+    const std::string audio = artifact_bytes(2 * ARTIFACT_WINDOW_BYTES + ARTIFACT_CHUNK_BYTES / 3);
+    const fs::path remote = root / "meetings" / "audio.wav";
+    {
+        std::ofstream out(remote, std::ios::binary);
+        out.write(audio.data(), static_cast<std::streamsize>(audio.size()));
+    }
+
+    ArtifactServer artifacts([&root] { return std::vector<fs::path>{root / "meetings"}; });
+    REQUIRE(artifacts.start("127.0.0.1", 0));
+    REQUIRE(artifacts.port() != 0);
+    IpcServer server(TCP_ADDR);
+    register_artifact_methods(server, artifacts);
+    REQUIRE(server.start());
+    std::thread srv([&server]() { server.run(); });
+
+    IpcClient client(TCP_ADDR);
+    REQUIRE(client.connect());
+
+    // An interrupted earlier attempt left the first 3 MB, and one for an
+    // older version of the file is lying around too.
+    ArtifactGrant grant;
+    std::string error;
+    REQUIRE(artifacts.grant(remote, grant, error));
+    const fs::path dest = root / "local" / "audio.wav";
+    const fs::path part = root / "local" / ("audio.wav." + grant.version + ".part");
+    const size_t resumed = 3 * 1024 * 1024;
+    {
+        std::ofstream out(part, std::ios::binary);
+        out.write(audio.data(), resumed);
+    }
+    write_text_file(root / "local" / "audio.wav.1-1.part", "x");
+
+    std::vector<uint64_t> seen;
+    const uint64_t size = fetch_artifact(client, remote.string(), dest,
+                                         [&seen](uint64_t done, uint64_t) { seen.push_back(done); });
+    CHECK(size == audio.size());
+    CHECK(file_bytes(dest) == audio);
+    CHECK_FALSE(fs::exists(part));
+    CHECK_FALSE(fs::exists(root / "local" / "audio.wav.1-1.part"));
+    REQUIRE_FALSE(seen.empty());
+    CHECK(seen.front() == resumed);
+    CHECK(seen.back() == audio.size());
+    ArtifactStats st = artifacts.stats();
+    CHECK(st.bytes_sent == audio.size() - resumed);
+    CHECK(st.transfers == 2);  // two windows for the 5.1 MiB left
+
+    // The control connection still answers while files move elsewhere.
+    IpcResponse resp;
+    IpcError err;
+    CHECK_FALSE(client.call("artifact.open", {{"path", (root / "local" / "audio.wav").string()}},
+                            resp, err, 2000));
+    CHECK(err.code == static_cast<int>(IpcErrorCode::InvalidParams));
+    CHECK_THROWS_AS(fetch_artifact(client, (root / "nowhere.txt").string(), root / "x"),
+                    RecmeetError);
+
+    server.stop();
+    srv.join();
+    artifacts.stop();
+    fs::remove_all(root);
+}
+
+TEST_CASE("Artifact port refuses unknown tokens, bad ranges and changed files",
+          "[ipc][artifact]") {
+    const fs::path root = recmeet::test::tmp_path("artifact_refuse");
+    fs::remove_all(root);
+    fs::create_directories(root);
+    write_text_file(root / "note.md", "# Meeting\n");
+
+    ArtifactServer artifacts([&root] { return std::vector<fs::path>{root}; });
+    REQUIRE(artifacts.start("127.0.0.1", 0));
+    ArtifactGrant grant;
+    std::string error;
+    REQUIRE(artifacts.grant(root / "note.md", grant, error));
+
+    CHECK(artifact_exchange(artifacts.port(), "fetch nope 0 0\n") == "err unknown token");
+    CHECK(artifact_exchange(artifacts.port(), "hello\n") == "err bad request");
+    CHECK(artifact_exchange(artifacts.port(), "fetch " + grant.token + " 11 0\n") ==
+          "err offset past end");
+    CHECK(artifact_exchange(artifacts.port(), "fetch " + grant.token + " 10 0\n") == "ok 10");
+
+    write_text_file(root / "note.md", "# Meeting, edited\n");
+    CHECK(artifact_exchange(artifacts.port(), "fetch " + grant.token + " 0 0\n") == "err changed");
+    artifacts.stop();
+    fs::remove_all(root);
+}
+
 // ===========================================================================
 // Category: Context persistence (regression for the production bug where
 // context.json was never written for tray-driven recordings).
@@ -0,0 +1,364 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+// IPC load and fan-out harness: an IpcServer under N clients, a few of them
+// deliberately slow readers, fed synthetic caption and progress events at
+// fixed rates. Run with `make benchmark`; the workload is set from the
+// environment:
+//
+//   RECMEET_IPC_BENCH_CLIENTS      clients in all (default 64)
+//   RECMEET_IPC_BENCH_SLOW         of which slow readers (default 4)
+//   RECMEET_IPC_BENCH_SECONDS      run time per transport (default 2)
+//   RECMEET_IPC_BENCH_CAPTION_HZ   caption partials per second (default 200)
+//   RECMEET_IPC_BENCH_PROGRESS_HZ  progress events per second (default 20)
+//   RECMEET_IPC_BENCH_PARTIAL_HZ   server partial rate per client (default 0)
+
+#include <catch2/catch_test_macros.hpp>
+#include "ipc_server.h"
+#include "ipc_protocol.h"
+#include "latency_histogram.h"
+#include "test_tmpdir.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace recmeet;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Every final is followed by this many partials of the growing utterance.
+constexpr int kPartialsPerFinal = 20;
+// A slow reader takes this much every kSlowReadMs.
+constexpr size_t kSlowReadBytes = 512;
+constexpr int kSlowReadMs = 20;
+constexpr int kTcpPort = 19877;
+
+struct LoadConfig {
+    int clients = 64;
+    int slow = 4;
+    int seconds = 2;
+    int caption_hz = 200;
+    int progress_hz = 20;
+    int partial_hz = 0;
+};
+
+int env_int(const char* name, int def, int min) {
+    const char* v = std::getenv(name);
+    if (!v || !*v) return def;
+    return std::max(min, std::atoi(v));
+}
+
+LoadConfig load_config() {
+    LoadConfig c;
+    c.clients = env_int("RECMEET_IPC_BENCH_CLIENTS", c.clients, 1);
+    c.slow = std::min(env_int("RECMEET_IPC_BENCH_SLOW", c.slow, 0), c.clients - 1);
+    c.seconds = env_int("RECMEET_IPC_BENCH_SECONDS", c.seconds, 1);
+    c.caption_hz = env_int("RECMEET_IPC_BENCH_CAPTION_HZ", c.caption_hz, 1);
+    c.progress_hz = env_int("RECMEET_IPC_BENCH_PROGRESS_HZ", c.progress_hz, 0);
+    c.partial_hz = env_int("RECMEET_IPC_BENCH_PARTIAL_HZ", c.partial_hz, 0);
+    return c;
+}
+
+int64_t now_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now().time_since_epoch()).count();
+}
+
+double thread_cpu_sec() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+int connect_to(const std::string& addr) {
+    if (addr.find('/') != std::string::npos) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        struct sockaddr_un sa{};
+        sa.sun_family = AF_UNIX;
+        std::strncpy(sa.sun_path, addr.c_str(), sizeof(sa.sun_path) - 1);
+        if (connect(fd, reinterpret_cast<struct sockaddr*>(&sa), sizeof(sa)) < 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in sa{};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(kTcpPort);
+    inet_pton(AF_INET, "127.0.0.1", &sa.sin_addr);
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&sa), sizeof(sa)) < 0) {
+        close(fd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+// One simulated client: what it read and what that told it.
+struct LoadClient {
+    int fd = -1;
+    bool slow = false;
+    bool closed = false;   // the server hung up (backlog over the limit)
+    bool done = false;     // saw the end-of-run marker
+    std::string buf;
+    size_t captions = 0, finals = 0, progress = 0;
+};
+
+// Parse the complete lines in `c.buf`, recording each event's age.
+void consume(LoadClient& c, LatencyHistogram& hist, IpcMessage& msg) {
+    size_t pos = 0;
+    for (size_t nl; (nl = c.buf.find('\n', pos)) != std::string::npos; pos = nl + 1) {
+        std::string_view line(c.buf.data() + pos, nl - pos);
+        if (!parse_ipc_message(line, msg) || msg.type != IpcMessageType::Event) continue;
+        const IpcEvent& ev = msg.event;
+        if (ev.event == "bench.done") {
+            c.done = true;
+            continue;
+        }
+        auto it = ev.data.find("sent_us");
+        if (it != ev.data.end()) hist.record(now_us() - json_val_as_int(it->second));
+        if (ev.event == "caption") {
+            ++c.captions;
+            if (!json_val_as_bool(ev.data.at("is_partial"))) ++c.finals;
+        } else if (ev.event == "progress") {
+            ++c.progress;
+        }
+    }
+    c.buf.erase(0, pos);
+}
+
+struct LoadReport {
+    size_t captions_sent = 0, finals_sent = 0, progress_sent = 0;
+    size_t delivered = 0;          // events read by all clients
+    size_t fast_complete = 0;      // fast clients that got every final and progress
+    size_t slow_closed = 0;
+    double wall_sec = 0, cpu_sec = 0;
+    LatencySummary fast, slow;
+};
+
+LoadReport run_load(const std::string& addr, const LoadConfig& cfg) {
+    LoadReport rep;
+    IpcServer server(addr);
+    server.on("ping", [](const IpcRequest&, IpcResponse& resp, IpcError&) {
+        resp.result["pong"] = true;
+        return true;
+    });
+    REQUIRE(server.start());
+    server.set_partial_rate(cfg.partial_hz);
+    std::atomic<double> cpu{0};
+    std::thread srv([&] {
+        const double c0 = thread_cpu_sec();
+        server.run();
+        cpu.store(thread_cpu_sec() - c0);
+    });
+
+    std::vector<LoadClient> clients(static_cast<size_t>(cfg.clients));
+    for (size_t i = 0; i < clients.size(); ++i) {
+        clients[i].fd = connect_to(addr);
+        REQUIRE(clients[i].fd >= 0);
+        clients[i].slow = i < static_cast<size_t>(cfg.slow);
+    }
+    // Answered only after every earlier connection was accepted.
+    IpcRequest ping;
+    ping.id = 1;
+    ping.method = "ping";
+    const std::string wire = serialize(ping) + "\n";
+    LoadClient& last = clients.back();
+    REQUIRE(write(last.fd, wire.data(), wire.size()) == static_cast<ssize_t>(wire.size()));
+    {
+        struct pollfd p{last.fd, POLLIN, 0};
+        REQUIRE(poll(&p, 1, 5000) == 1);
+        char tmp[256];
+        REQUIRE(read(last.fd, tmp, sizeof(tmp)) > 0);
+    }
+
+    LatencyHistogram fast_hist, slow_hist;
+    std::atomic<bool> producing{true};
+
+    // Fast readers: one thread drains every socket as soon as it is readable.
+    std::thread fast_reader([&] {
+        IpcMessage msg;
+        std::vector<struct pollfd> pfds;
+        std::vector<LoadClient*> owners;
+        for (auto& c : clients)
+            if (!c.slow) {
+                pfds.push_back({c.fd, POLLIN, 0});
+                owners.push_back(&c);
+            }
+        size_t left = owners.size();
+        char buf[65536];
+        const auto deadline = Clock::now() + std::chrono::seconds(cfg.seconds + 30);
+        while (left > 0 && Clock::now() < deadline) {
+            if (poll(pfds.data(), pfds.size(), 100) <= 0) continue;
+            for (size_t i = 0; i < pfds.size(); ++i) {
+                if (!(pfds[i].revents & (POLLIN | POLLHUP))) continue;
+                LoadClient& c = *owners[i];
+                ssize_t n = read(c.fd, buf, sizeof(buf));
+                if (n <= 0) {
+                    c.closed = true;
+                    pfds[i].fd = -1;
+                    --left;
+                    continue;
+                }
+                c.buf.append(buf, static_cast<size_t>(n));
+                consume(c, fast_hist, msg);
+                if (c.done) {
+                    pfds[i].fd = -1;
+                    --left;
+                }
+            }
+        }
+    });
+
+    // Slow readers: a trickle per client, for as long as events are produced.
+    std::thread slow_reader([&] {
+        IpcMessage msg;
+        char buf[kSlowReadBytes];
+        while (producing.load()) {
+            for (auto& c : clients) {
+                if (!c.slow || c.closed) continue;
+                ssize_t n = recv(c.fd, buf, sizeof(buf), MSG_DONTWAIT);
+                if (n == 0) {
+                    c.closed = true;
+                } else if (n > 0) {
+                    c.buf.append(buf, static_cast<size_t>(n));
+                    consume(c, slow_hist, msg);
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(kSlowReadMs));
+        }
+    });
+
+    // Producer: captions and progress on one schedule, as a job's worker
+    // threads would post them.
+    const auto t0 = Clock::now();
+    const auto end = t0 + std::chrono::seconds(cfg.seconds);
+    const auto caption_step = std::chrono::nanoseconds(1000000000LL / cfg.caption_hz);
+    const auto progress_step = cfg.progress_hz > 0
+        ? std::chrono::nanoseconds(1000000000LL / cfg.progress_hz)
+        : std::chrono::nanoseconds(std::chrono::hours(1));
+    auto next_caption = t0, next_progress = t0;
+    std::string text;
+    while (true) {
+        const auto next = std::min(next_caption, next_progress);
+        if (next >= end) break;
+        std::this_thread::sleep_until(next);
+        if (next_caption <= next_progress) {
+            next_caption += caption_step;
+            const bool final = ++rep.captions_sent % kPartialsPerFinal == 0;
+            text += " word";
+            IpcEvent ev = make_caption_event(1, text, !final, now_us() / 1000, "mic");
+            ev.data["sent_us"] = now_us();
+            if (final) {
+                server.post_final("1:mic", std::move(ev));
+                ++rep.finals_sent;
+                text.clear();
+            } else {
+                server.post_partial("1:mic", std::move(ev));
+            }
+        } else {
+            next_progress += progress_step;
+            const double percent = static_cast<double>(++rep.progress_sent % 100);
+            const int64_t sent = now_us();
+            server.post([&server, percent, sent] {
+                IpcEvent ev;
+                ev.event = "progress";
+                ev.data["job_id"] = int64_t{1};
+                ev.data["phase"] = std::string("transcribing");
+                ev.data["percent"] = percent;
+                ev.data["sent_us"] = sent;
+                server.broadcast(ev);
+            });
+        }
+    }
+    // Everything before the marker reaches a fast client before it does.
+    server.post([&server] {
+        IpcEvent ev;
+        ev.event = "bench.done";
+        server.broadcast(ev);
+    });
+    fast_reader.join();
+    rep.wall_sec = std::chrono::duration<double>(Clock::now() - t0).count();
+    producing.store(false);
+    slow_reader.join();
+
+    server.stop();
+    srv.join();
+    rep.cpu_sec = cpu.load();
+
+    for (auto& c : clients) {
+        rep.delivered += c.captions + c.progress;
+        if (c.slow) {
+            if (c.closed) ++rep.slow_closed;
+        } else if (c.done && c.finals == rep.finals_sent && c.progress == rep.progress_sent) {
+            ++rep.fast_complete;
+        }
+        close(c.fd);
+    }
+    rep.fast = fast_hist.summary();
+    rep.slow = slow_hist.summary();
+    return rep;
+}
+
+void print_report(const char* transport, const LoadConfig& cfg, const LoadReport& r) {
+    fprintf(stderr,
+            "\n[benchmark] IpcServer load, %s: %d client(s) (%d slow), %ds, "
+            "%d captions/s, %d progress/s, partial rate %d Hz\n",
+            transport, cfg.clients, cfg.slow, cfg.seconds, cfg.caption_hz,
+            cfg.progress_hz, cfg.partial_hz);
+    fprintf(stderr, "  sent: %zu captions (%zu finals), %zu progress\n",
+            r.captions_sent, r.finals_sent, r.progress_sent);
+    fprintf(stderr, "  dispatch: %zu deliveries, %.0f/s\n", r.delivered,
+            static_cast<double>(r.delivered) / r.wall_sec);
+    fprintf(stderr, "  fast latency (us): n=%llu p50=%lld p95=%lld p99=%lld max=%lld\n",
+            static_cast<unsigned long long>(r.fast.count), static_cast<long long>(r.fast.p50),
+            static_cast<long long>(r.fast.p95), static_cast<long long>(r.fast.p99),
+            static_cast<long long>(r.fast.max));
+    fprintf(stderr, "  slow latency (us): n=%llu p50=%lld p95=%lld p99=%lld max=%lld, "
+            "%zu disconnected\n",
+            static_cast<unsigned long long>(r.slow.count), static_cast<long long>(r.slow.p50),
+            static_cast<long long>(r.slow.p95), static_cast<long long>(r.slow.p99),
+            static_cast<long long>(r.slow.max), r.slow_closed);
+    fprintf(stderr, "  server thread CPU: %.3fs (%.1f%% of one core)\n", r.cpu_sec,
+            100.0 * r.cpu_sec / r.wall_sec);
+}
+
+} // anonymous namespace
+
+TEST_CASE("IpcServer load: fan-out over a Unix socket with slow readers",
+          "[ipc_server][benchmark]") {
+    const LoadConfig cfg = load_config();
+    const std::string sock = test::tmp_path("recmeet_ipc_load.sock").string();
+    unlink(sock.c_str());
+    LoadReport r = run_load(sock, cfg);
+    print_report("unix", cfg, r);
+    // Slow readers may fall behind, but never hold up the others.
+    CHECK(r.fast_complete == static_cast<size_t>(cfg.clients - cfg.slow));
+    unlink(sock.c_str());
+}
+
+TEST_CASE("IpcServer load: fan-out over TCP with slow readers", "[ipc_server][benchmark]") {
+    const LoadConfig cfg = load_config();
+    LoadReport r = run_load("127.0.0.1:" + std::to_string(kTcpPort), cfg);
+    print_report("tcp", cfg, r);
+    CHECK(r.fast_complete == static_cast<size_t>(cfg.clients - cfg.slow));
+}
@@ -5,8 +5,23 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include "ipc_protocol.h"
 
+#include <chrono>
+#include <cstdio>
+
 using namespace recmeet;
 
+namespace {
+
+// Body of a single MessagePack frame, checking its length prefix.
+std::string msgpack_body(std::string wire) {
+    std::string body;
+    REQUIRE(take_ipc_frame(wire, IpcFraming::MsgPack, body) == IpcFrameStatus::Complete);
+    CHECK(wire.empty());
+    return body;
+}
+
+} // namespace
+
 // ---------------------------------------------------------------------------
 // Request round-trip
 // ---------------------------------------------------------------------------
@@ -193,10 +208,255 @@ TEST_CASE("IPC: parse rejects garbage input", "[ipc]") {
     CHECK_FALSE(parse_ipc_message("{}", msg)); // no known fields
 }
 
+TEST_CASE("IPC: nested values stay raw JSON text, numbers and reuse", "[ipc]") {
+    IpcMessage msg;
+    REQUIRE(parse_ipc_message(
+        R"({"id":4,"method":"m","params":{"list":[1,{"a":"]"}],"obj":{"k":"}"},)"
+        R"("big":123456789012345678901,"neg":-7,"exp":2E3}})", msg));
+    CHECK(msg.type == IpcMessageType::Request);
+    CHECK(json_val_as_string(msg.request.params["list"]) == R"([1,{"a":"]"}])");
+    CHECK(json_val_as_string(msg.request.params["obj"]) == R"({"k":"}"})");
+    // Past int64: kept as a double rather than failing.
+    CHECK(std::holds_alternative<double>(msg.request.params["big"]));
+    CHECK(json_val_as_int(msg.request.params["neg"]) == -7);
+    CHECK(json_val_as_double(msg.request.params["exp"]) == 2000.0);
+
+    // A reused IpcMessage starts over.
+    REQUIRE(parse_ipc_message(R"({"id":5,"method":"n","params":{"x":1}})", msg));
+    CHECK(msg.request.method == "n");
+    CHECK(msg.request.params.size() == 1);
+    REQUIRE(parse_ipc_message(R"({"event":"e","data":{"y":2}})", msg));
+    CHECK(msg.type == IpcMessageType::Event);
+    CHECK(msg.request.params.empty());
+
+    // A known member that is not an object is ignored; a broken one fails.
+    REQUIRE(parse_ipc_message(R"({"id":6,"result":[1,2]})", msg));
+    CHECK(msg.type == IpcMessageType::Response);
+    CHECK(msg.response.result.empty());
+    CHECK_FALSE(parse_ipc_message(R"({"id":6,"result":{"a":}})", msg));
+    CHECK_FALSE(parse_ipc_message(R"({"id":-})", msg));
+    CHECK_FALSE(parse_ipc_message(R"({"event":"e","data":{"s":"unterminated}})", msg));
+}
+
+TEST_CASE("next_ipc_frame: views messages in place", "[ipc]") {
+    const std::string buf = "{\"event\":\"a\"}\n{\"event\":\"b\"}\n{\"ev";
+    std::string_view rest = buf, body;
+    size_t used = 0;
+    REQUIRE(next_ipc_frame(rest, IpcFraming::Json, body, used) == IpcFrameStatus::Complete);
+    CHECK(body == "{\"event\":\"a\"}");
+    CHECK(body.data() == buf.data());
+    rest.remove_prefix(used);
+    REQUIRE(next_ipc_frame(rest, IpcFraming::Json, body, used) == IpcFrameStatus::Complete);
+    CHECK(body == "{\"event\":\"b\"}");
+    rest.remove_prefix(used);
+    CHECK(next_ipc_frame(rest, IpcFraming::Json, body, used) == IpcFrameStatus::Incomplete);
+    CHECK(rest == "{\"ev");
+}
+
+TEST_CASE("IPC parse: caption events out of a read buffer", "[ipc][benchmark]") {
+    // A second of 10 Hz partials from ten sources, with a final per source.
+    std::string stream;
+    size_t count = 0;
+    for (int i = 0; i < 110; ++i, ++count)
+        stream += encode_ipc_frame(
+            make_caption_event(42, "AND THEN WE SHOULD LOOK AT THE QUARTERLY NUMBERS " +
+                               std::to_string(i), i % 11 != 10, 183250 + i * 100, "mic"),
+            IpcFraming::Json);
+    constexpr int kReps = 2000;
+    fprintf(stderr, "\n[benchmark] parse %zu caption events x %d:\n", count, kReps);
+
+    // Each line copied out of the buffer and parsed into a new message.
+    size_t parsed = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < kReps; ++r) {
+        std::string buf = stream, body;
+        while (take_ipc_frame(buf, IpcFraming::Json, body) == IpcFrameStatus::Complete) {
+            IpcMessage msg;
+            parsed += parse_ipc_message(body, msg);
+        }
+    }
+    const double copy_ns = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - t0).count() * 1e9 / (count * kReps);
+    CHECK(parsed == count * kReps);
+
+    // In place, into one reused message, as IpcServer and IpcClient do.
+    parsed = 0;
+    IpcMessage msg;
+    t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < kReps; ++r) {
+        std::string_view rest = stream, body;
+        size_t used = 0;
+        while (next_ipc_frame(rest, IpcFraming::Json, body, used) == IpcFrameStatus::Complete) {
+            parsed += parse_ipc_message(body, msg);
+            rest.remove_prefix(used);
+        }
+    }
+    const double view_ns = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - t0).count() * 1e9 / (count * kReps);
+    CHECK(parsed == count * kReps);
+    fprintf(stderr, "  copied lines: %.0f ns per event\n  in place:     %.0f ns per event\n",
+            copy_ns, view_ns);
+}
+
 // ---------------------------------------------------------------------------
 // JsonVal helpers: type coercion / defaults
 // ---------------------------------------------------------------------------
 
+// ---------------------------------------------------------------------------
+// MessagePack framing
+// ---------------------------------------------------------------------------
+
+TEST_CASE("MessagePack: event encodes to the expected bytes", "[ipc]") {
+    IpcEvent ev;
+    ev.event = "x";
+    ev.data["n"] = int64_t{-1};
+    const std::string wire = encode_ipc_frame(ev, IpcFraming::MsgPack);
+    // fixmap(2) "event" "x" "data" fixmap(1) "n" -1
+    const std::string body = "\x82\xa5" "event" "\xa1" "x" "\xa4" "data" "\x81\xa1" "n" "\xff";
+    CHECK(wire == std::string("\0\0\0", 3) + static_cast<char>(body.size()) + body);
+    CHECK(encode_ipc_frame(ev, IpcFraming::Json) == serialize(ev) + "\n");
+}
+
+TEST_CASE("MessagePack: every message type round-trips", "[ipc]") {
+    IpcRequest req;
+    req.id = 7;
+    req.method = "record.start";
+    req.params["mic_source"] = std::string("alsa_input.\"usb\"\n");
+    req.params["channels"] = std::string("[1,2]");  // nested JSON stays a string
+    IpcMessage msg;
+    REQUIRE(parse_ipc_message(msgpack_body(encode_ipc_frame(req, IpcFraming::MsgPack)),
+                              IpcFraming::MsgPack, msg));
+    REQUIRE(msg.type == IpcMessageType::Request);
+    CHECK(msg.request.id == 7);
+    CHECK(msg.request.method == "record.start");
+    CHECK(msg.request.params == req.params);
+
+    IpcResponse resp;
+    resp.id = 8;
+    resp.result["ok"] = true;
+    resp.result["none"] = std::monostate{};
+    msg = {};
+    REQUIRE(parse_ipc_message(msgpack_body(encode_ipc_frame(resp, IpcFraming::MsgPack)),
+                              IpcFraming::MsgPack, msg));
+    REQUIRE(msg.type == IpcMessageType::Response);
+    CHECK(msg.response.id == 8);
+    CHECK(msg.response.result == resp.result);
+
+    IpcError err;
+    err.id = 9;
+    err.code = static_cast<int>(IpcErrorCode::InvalidParams);
+    err.message = std::string(300, 'e');  // str16
+    msg = {};
+    REQUIRE(parse_ipc_message(msgpack_body(encode_ipc_frame(err, IpcFraming::MsgPack)),
+                              IpcFraming::MsgPack, msg));
+    REQUIRE(msg.type == IpcMessageType::Error);
+    CHECK(msg.error.id == 9);
+    CHECK(msg.error.code == err.code);
+    CHECK(msg.error.message == err.message);
+
+    IpcEvent ev = make_caption_event(3, "HELLO WORLD", true, 1234, "mic");
+    msg = {};
+    REQUIRE(parse_ipc_message(msgpack_body(encode_ipc_frame(ev, IpcFraming::MsgPack)),
+                              IpcFraming::MsgPack, msg));
+    REQUIRE(msg.type == IpcMessageType::Event);
+    CHECK(msg.event.event == "caption");
+    CHECK(msg.event.data == ev.data);
+}
+
+TEST_CASE("MessagePack: integers keep their value at every width", "[ipc]") {
+    IpcEvent ev;
+    ev.event = "ints";
+    const int64_t values[] = {0, 127, 128, 255, 256, 65535, 65536, 4294967295LL,
+                              4294967296LL, INT64_MAX, -1, -32, -33, -128, -129,
+                              -32768, -32769, INT32_MIN, INT32_MIN - 1LL, INT64_MIN};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+        ev.data["v" + std::to_string(i)] = values[i];
+    ev.data["pi"] = 3.141592653589793;
+    ev.data["tiny"] = -1e-300;
+
+    IpcMessage msg;
+    REQUIRE(parse_ipc_message(msgpack_body(encode_ipc_frame(ev, IpcFraming::MsgPack)),
+                              IpcFraming::MsgPack, msg));
+    CHECK(msg.event.data == ev.data);
+}
+
+TEST_CASE("take_ipc_frame: waits for a whole frame, rejects an oversized one", "[ipc]") {
+    IpcEvent ev;
+    ev.event = "progress";
+    ev.data["percent"] = int64_t{40};
+    const std::string frame = encode_ipc_frame(ev, IpcFraming::MsgPack);
+
+    std::string buf, body;
+    for (size_t i = 0; i < frame.size(); ++i) {
+        CHECK(take_ipc_frame(buf, IpcFraming::MsgPack, body) == IpcFrameStatus::Incomplete);
+        buf += frame[i];
+    }
+    buf += frame;  // a second frame behind the first
+    CHECK(take_ipc_frame(buf, IpcFraming::MsgPack, body) == IpcFrameStatus::Complete);
+    CHECK(buf == frame);
+    CHECK(take_ipc_frame(buf, IpcFraming::MsgPack, body) == IpcFrameStatus::Complete);
+    CHECK(buf.empty());
+
+    buf = std::string("\x01\0\0\x01", 4);  // 16 MiB + 1
+    CHECK(take_ipc_frame(buf, IpcFraming::MsgPack, body) == IpcFrameStatus::Invalid);
+
+    buf = "{\"event\":\"a\"}\n\n{";
+    CHECK(take_ipc_frame(buf, IpcFraming::Json, body) == IpcFrameStatus::Complete);
+    CHECK(body == "{\"event\":\"a\"}");
+    CHECK(take_ipc_frame(buf, IpcFraming::Json, body) == IpcFrameStatus::Complete);
+    CHECK(body.empty());
+    CHECK(take_ipc_frame(buf, IpcFraming::Json, body) == IpcFrameStatus::Incomplete);
+    CHECK(buf == "{");
+}
+
+TEST_CASE("MessagePack: parse rejects truncated and malformed bodies", "[ipc]") {
+    IpcEvent ev = make_caption_event(1, "partial text", true, 5);
+    const std::string body = msgpack_body(encode_ipc_frame(ev, IpcFraming::MsgPack));
+    IpcMessage msg;
+    for (size_t n = 0; n < body.size(); ++n)
+        CHECK_FALSE(parse_ipc_message(body.substr(0, n), IpcFraming::MsgPack, msg));
+    CHECK_FALSE(parse_ipc_message(body + '\xc0', IpcFraming::MsgPack, msg));  // trailing byte
+    CHECK_FALSE(parse_ipc_message("\x80", IpcFraming::MsgPack, msg));        // no known fields
+    // A nested map inside `data`.
+    CHECK_FALSE(parse_ipc_message("\x82\xa5" "event" "\xa1" "x" "\xa4" "data" "\x81\xa1" "n" "\x80",
+                                  IpcFraming::MsgPack, msg));
+}
+
+TEST_CASE("ipc_framing_name / parse_ipc_framing", "[ipc]") {
+    IpcFraming f = IpcFraming::Json;
+    CHECK(parse_ipc_framing(ipc_framing_name(IpcFraming::MsgPack), f));
+    CHECK(f == IpcFraming::MsgPack);
+    CHECK(parse_ipc_framing("json", f));
+    CHECK(f == IpcFraming::Json);
+    CHECK_FALSE(parse_ipc_framing("cbor", f));
+    CHECK(f == IpcFraming::Json);
+}
+
+TEST_CASE("IPC framing: encode + parse cost of a caption partial", "[ipc][benchmark]") {
+    const IpcEvent ev = make_caption_event(
+        42, "AND THEN WE SHOULD LOOK AT THE QUARTERLY NUMBERS BEFORE", true, 183250, "mic");
+    constexpr int kIters = 200000;
+    fprintf(stderr, "\n[benchmark] caption partial, %d encode+parse round trips:\n", kIters);
+    for (IpcFraming framing : {IpcFraming::Json, IpcFraming::MsgPack}) {
+        size_t bytes = 0;
+        bool ok = true;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIters; ++i) {
+            std::string wire = encode_ipc_frame(ev, framing);
+            bytes = wire.size();
+            std::string body;
+            IpcMessage msg;
+            ok &= take_ipc_frame(wire, framing, body) == IpcFrameStatus::Complete &&
+                  parse_ipc_message(body, framing, msg);
+        }
+        const double secs = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t0).count();
+        CHECK(ok);
+        fprintf(stderr, "  %-7s %3zu bytes, %.0f ns per message\n", ipc_framing_name(framing),
+                bytes, secs * 1e9 / kIters);
+    }
+}
+
 TEST_CASE("json_val_as_string: returns default for non-string", "[ipc]") {
     CHECK(json_val_as_string(JsonVal{int64_t(42)}, "def") == "def");
     CHECK(json_val_as_string(JsonVal{true}, "def") == "def");
@@ -364,3 +624,26 @@ TEST_CASE("default_ipc_address: returns Unix transport", "[ipc]") {
     CHECK(addr.transport == IpcTransport::Unix);
     CHECK(addr.socket_path == default_socket_path());
 }
+
+TEST_CASE("make_clip_transcribed_event: result and failure shapes", "[ipc]") {
+    IpcMessage msg;
+    REQUIRE(parse_ipc_message(serialize(make_clip_transcribed_event(
+        7, "hello there", 12.5, 30.0, 840)), msg));
+    REQUIRE(msg.type == IpcMessageType::Event);
+    CHECK(msg.event.event == "clip.transcribed");
+    CHECK(json_val_as_int(msg.event.data["clip_id"]) == 7);
+    CHECK(json_val_as_string(msg.event.data["text"]) == "hello there");
+    CHECK(json_val_as_double(msg.event.data["start_sec"]) == 12.5);
+    CHECK(json_val_as_double(msg.event.data["duration_sec"]) == 30.0);
+    CHECK(json_val_as_int(msg.event.data["elapsed_ms"]) == 840);
+    CHECK(msg.event.data.count("error") == 0);
+
+    // A failure is still an event (its error sits in data), not an IpcError.
+    IpcMessage failed;
+    REQUIRE(parse_ipc_message(serialize(make_clip_failed_event(8, "model not found")), failed));
+    REQUIRE(failed.type == IpcMessageType::Event);
+    CHECK(failed.event.event == "clip.transcribed");
+    CHECK(json_val_as_int(failed.event.data["clip_id"]) == 8);
+    CHECK(json_val_as_string(failed.event.data["error"]) == "model not found");
+    CHECK(failed.event.data.count("text") == 0);
+}
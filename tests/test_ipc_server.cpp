@@ -12,6 +12,7 @@
 #include <string>
 #include <thread>
 #include <chrono>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <unistd.h>
@@ -241,6 +242,343 @@ TEST_CASE("IpcServer: post() wakes poll loop", "[ipc_server]") {
     CHECK(posted_ran);
 }
 
+namespace {
+
+IpcEvent caption(const std::string& text, bool is_partial) {
+    return make_caption_event(1, text, is_partial, 0, "mic");
+}
+
+// Next event on fd; its event name is empty when none arrived in time.
+IpcEvent read_event(int fd, int timeout_ms = 2000) {
+    IpcMessage msg;
+    if (!parse_ipc_message(read_line(fd, timeout_ms), msg) ||
+        msg.type != IpcMessageType::Event)
+        return {};
+    return msg.event;
+}
+
+} // anonymous namespace
+
+TEST_CASE("IpcServer: queued partials coalesce and a final supersedes them",
+          "[ipc_server]") {
+    unlink(test_sock().c_str());
+
+    IpcServer server(test_sock());
+    REQUIRE(server.start());
+    std::thread srv_thread([&server]() { server.run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    int client = connect_client(test_sock().c_str());
+    REQUIRE(client >= 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // Hold the poll thread so everything below lands in one tick.
+    std::atomic<bool> entered{false}, release{false};
+    auto hold = [&] {
+        entered = false;
+        release = false;
+        server.post([&] {
+            entered = true;
+            while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+        while (!entered) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    };
+
+    hold();
+    server.post_partial("1:mic", caption("HE", true));
+    server.post_partial("1:mic", caption("HELLO", true));
+    server.post_partial("1:monitor", caption("HI", true));
+    server.post_partial("1:mic", caption("HELLO THERE", true));
+    release = true;
+    IpcEvent first = read_event(client);
+    IpcEvent second = read_event(client);
+    CHECK(json_val_as_string(first.data["text"]) == "HELLO THERE");
+    CHECK(json_val_as_string(second.data["text"]) == "HI");
+
+    hold();
+    server.post_partial("1:mic", caption("GOOD", true));
+    server.post_final("1:mic", caption("GOOD BYE", false));
+    server.post_partial("1:mic", caption("SEE", true));
+    release = true;
+    IpcEvent fin = read_event(client);
+    CHECK(json_val_as_string(fin.data["text"]) == "GOOD BYE");
+    CHECK_FALSE(json_val_as_bool(fin.data["is_partial"]));
+    CHECK(json_val_as_string(read_event(client).data["text"]) == "SEE");
+
+    close(client);
+    server.stop();
+    srv_thread.join();
+}
+
+TEST_CASE("IpcServer: per-client partial rate and delta format", "[ipc_server]") {
+    unlink(test_sock().c_str());
+
+    IpcServer server(test_sock());
+    server.on("configure", [&server](const IpcRequest&, IpcResponse& resp, IpcError&) {
+        server.configure_partials(server.current_client(), 5, true);
+        resp.result["ok"] = true;
+        return true;
+    });
+    REQUIRE(server.start());
+    std::thread srv_thread([&server]() { server.run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    int fast = connect_client(test_sock().c_str());
+    int slow = connect_client(test_sock().c_str());
+    REQUIRE(fast >= 0);
+    REQUIRE(slow >= 0);
+    IpcRequest req;
+    req.id = 1;
+    req.method = "configure";
+    send_line(slow, serialize(req));
+    read_line(slow);
+
+    // The unconfigured client gets every partial, in full.
+    auto fast_gets = [&](const char* want) {
+        IpcEvent got = read_event(fast);
+        CHECK(json_val_as_string(got.data["text"]) == want);
+        CHECK(got.data.count("format") == 0);
+    };
+
+    server.post_partial("1:mic", caption("HELLO", true));
+    fast_gets("HELLO");
+    IpcEvent ev = read_event(slow);
+    CHECK(json_val_as_string(ev.data["format"]) == "delta");
+    CHECK(json_val_as_int(ev.data["keep"]) == 0);
+    CHECK(json_val_as_string(ev.data["text"]) == "HELLO");
+    const auto sent = std::chrono::steady_clock::now();
+
+    // Within the 200 ms interval: held, and only the newest goes out.
+    server.post_partial("1:mic", caption("HELLO WOR", true));
+    fast_gets("HELLO WOR");
+    server.post_partial("1:mic", caption("HELLO WORLD", true));
+    fast_gets("HELLO WORLD");
+    ev = read_event(slow);
+    CHECK(std::chrono::steady_clock::now() - sent >= std::chrono::milliseconds(150));
+    CHECK(json_val_as_int(ev.data["keep"]) == 5);
+    CHECK(json_val_as_string(ev.data["text"]) == " WORLD");
+
+    // A held partial is dropped by the final that follows it.
+    server.post_partial("1:mic", caption("HELLO WORLD AGAIN", true));
+    fast_gets("HELLO WORLD AGAIN");
+    server.post_final("1:mic", caption("HELLO WORLD AGAIN.", false));
+    fast_gets("HELLO WORLD AGAIN.");
+    ev = read_event(slow);
+    CHECK(json_val_as_string(ev.data["text"]) == "HELLO WORLD AGAIN.");
+    CHECK(ev.data.count("keep") == 0);
+    CHECK(read_event(slow, 400).event.empty());
+
+    close(fast);
+    close(slow);
+    server.stop();
+    srv_thread.join();
+}
+
+TEST_CASE("IpcServer: subscribed clients get only the events they asked for",
+          "[ipc_server]") {
+    unlink(test_sock().c_str());
+
+    IpcServer server(test_sock());
+    server.on("subscribe", [&server](const IpcRequest& req, IpcResponse& resp, IpcError&) {
+        std::vector<std::string> topics;
+        if (json_val_as_bool(req.params.at("jobs"))) topics = {"job.complete", "caption"};
+        server.subscribe(server.current_client(), topics,
+                         json_val_as_int(req.params.at("job_id")));
+        resp.result["ok"] = true;
+        return true;
+    });
+    REQUIRE(server.start());
+    std::thread srv_thread([&server]() { server.run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    int all = connect_client(test_sock().c_str());
+    int jobs = connect_client(test_sock().c_str());
+    int none = connect_client(test_sock().c_str());
+    REQUIRE(all >= 0);
+    REQUIRE(jobs >= 0);
+    REQUIRE(none >= 0);
+
+    auto subscribe = [](int fd, bool job_topics, int64_t job_id) {
+        IpcRequest req;
+        req.id = 1;
+        req.method = "subscribe";
+        req.params["jobs"] = job_topics;
+        req.params["job_id"] = job_id;
+        send_line(fd, serialize(req));
+        IpcMessage msg;
+        REQUIRE(parse_ipc_message(read_line(fd), msg));
+        CHECK(msg.type == IpcMessageType::Response);
+    };
+    subscribe(jobs, true, 2);
+    subscribe(none, false, 0);
+
+    auto event = [](const std::string& name, int64_t job_id) {
+        IpcEvent ev;
+        ev.event = name;
+        if (job_id > 0) ev.data["job_id"] = job_id;
+        return ev;
+    };
+    server.post([&] {
+        server.broadcast(event("state.changed", 0));
+        server.broadcast(event("job.complete", 1));
+        server.broadcast(event("caption.degraded", 2));
+        server.broadcast(event("captions", 2));  // not a "caption" sub-topic
+        server.broadcast(event("job.complete", 2));
+    });
+    server.post_partial("2:mic", make_caption_event(2, "HI", true, 0, "mic"));
+    server.post_partial("3:mic", make_caption_event(3, "NOT YOURS", true, 0, "mic"));
+    server.post([&] { server.broadcast(event("done", 0)); });
+
+    std::vector<std::string> got_all, got_jobs;
+    for (IpcEvent ev = read_event(all); ev.event != "done"; ev = read_event(all)) {
+        REQUIRE_FALSE(ev.event.empty());
+        got_all.push_back(ev.event);
+    }
+    CHECK(got_all.size() == 7);
+    // The filtered client sees its job's events and those without a job.
+    for (int i = 0; i < 3; ++i) got_jobs.push_back(read_event(jobs).event);
+    CHECK(got_jobs == std::vector<std::string>{"caption.degraded", "job.complete", "caption"});
+    CHECK(read_line(jobs, 200).empty());
+    CHECK(read_line(none, 200).empty());
+
+    close(all);
+    close(jobs);
+    close(none);
+    server.stop();
+    srv_thread.join();
+}
+
+TEST_CASE("IpcServer: a client that stops reading is dropped, not waited on",
+          "[ipc_server]") {
+    unlink(test_sock().c_str());
+
+    IpcServer server(test_sock());
+    server.on("ping", [](const IpcRequest&, IpcResponse& resp, IpcError&) {
+        resp.result["pong"] = true;
+        return true;
+    });
+    REQUIRE(server.start());
+    std::thread srv_thread([&server]() { server.run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    int stalled = connect_client(test_sock().c_str());
+    int live = connect_client(test_sock().c_str());
+    REQUIRE(stalled >= 0);
+    REQUIRE(live >= 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // More than kMaxClientBacklog plus the socket buffers; `live` reads
+    // each event, `stalled` never does.
+    const std::string blob(64 * 1024, 'x');
+    const size_t events = IpcServer::kMaxClientBacklog / blob.size() + 32;
+    size_t got = 0;
+    std::string carry;
+    char buf[65536];
+    for (size_t i = 0; i < events; ++i) {
+        server.post([&server, &blob] {
+            IpcEvent ev;
+            ev.event = "test.bulk";
+            ev.data["blob"] = blob;
+            server.broadcast(ev);
+        });
+        // read_line() goes a byte at a time; take whole chunks here.
+        size_t nl;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while ((nl = carry.find('\n')) == std::string::npos &&
+               std::chrono::steady_clock::now() < deadline) {
+            struct pollfd pfd = {live, POLLIN, 0};
+            if (poll(&pfd, 1, 50) <= 0) continue;
+            ssize_t n = read(live, buf, sizeof(buf));
+            if (n <= 0) break;
+            carry.append(buf, static_cast<size_t>(n));
+        }
+        if (nl == std::string::npos) break;
+        if (nl > blob.size()) ++got;
+        carry.erase(0, nl + 1);
+    }
+    CHECK(got == events);
+
+    // The loop still answers requests.
+    IpcRequest req;
+    req.id = 9;
+    req.method = "ping";
+    send_line(live, serialize(req));
+    IpcMessage msg;
+    REQUIRE(parse_ipc_message(read_line(live), msg));
+    CHECK(msg.type == IpcMessageType::Response);
+
+    // The stalled client was disconnected: drain it to EOF.
+    ssize_t n;
+    size_t drained = 0;
+    while ((n = read(stalled, buf, sizeof(buf))) > 0) drained += static_cast<size_t>(n);
+    CHECK(n == 0);
+    CHECK(drained < events * blob.size());
+
+    close(stalled);
+    close(live);
+    server.stop();
+    srv_thread.join();
+}
+
+TEST_CASE("IpcServer: event-dispatch throughput by client count", "[ipc_server][benchmark]") {
+    constexpr size_t kEvents = 1000;
+    fprintf(stderr, "\n[benchmark] IpcServer broadcast, %zu events:\n", kEvents);
+    for (size_t n_clients : {1, 16, 128}) {
+        unlink(test_sock().c_str());
+        IpcServer server(test_sock());
+        server.on("ping", [](const IpcRequest&, IpcResponse& resp, IpcError&) {
+            resp.result["pong"] = true;
+            return true;
+        });
+        REQUIRE(server.start());
+        std::thread srv_thread([&server]() { server.run(); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        std::vector<int> clients;
+        for (size_t i = 0; i < n_clients; ++i) {
+            int fd = connect_client(test_sock().c_str());
+            REQUIRE(fd >= 0);
+            clients.push_back(fd);
+        }
+        // Answered after every earlier connection was accepted.
+        IpcRequest req;
+        req.id = 1;
+        req.method = "ping";
+        send_line(clients.back(), serialize(req));
+        REQUIRE_FALSE(read_line(clients.back()).empty());
+
+        const auto t0 = std::chrono::steady_clock::now();
+        for (size_t e = 0; e < kEvents; ++e) {
+            server.post([&server, e] {
+                IpcEvent ev;
+                ev.event = "test.load";
+                ev.data["seq"] = static_cast<int64_t>(e);
+                server.broadcast(ev);
+            });
+        }
+        std::vector<struct pollfd> pfds;
+        for (int fd : clients) pfds.push_back({fd, POLLIN, 0});
+        std::vector<size_t> lines(n_clients, 0);
+        size_t done = 0;
+        char buf[65536];
+        const auto deadline = t0 + std::chrono::seconds(30);
+        while (done < n_clients && std::chrono::steady_clock::now() < deadline) {
+            if (poll(pfds.data(), pfds.size(), 100) <= 0) continue;
+            for (size_t i = 0; i < n_clients; ++i) {
+                if (!(pfds[i].revents & POLLIN)) continue;
+                ssize_t n = read(pfds[i].fd, buf, sizeof(buf));
+                for (ssize_t k = 0; k < n; ++k)
+                    if (buf[k] == '\n' && ++lines[i] == kEvents) ++done;
+            }
+        }
+        const double secs = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t0).count();
+        CHECK(done == n_clients);
+        fprintf(stderr, "  %3zu client(s): %.3fs, %.0f deliveries/s\n", n_clients, secs,
+                static_cast<double>(kEvents * n_clients) / secs);
+
+        for (int fd : clients) close(fd);
+        server.stop();
+        srv_thread.join();
+    }
+}
+
 // ---------------------------------------------------------------------------
 // TCP server tests
 // ---------------------------------------------------------------------------
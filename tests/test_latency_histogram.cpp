@@ -0,0 +1,60 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "latency_histogram.h"
+
+#include <cstdlib>
+
+using namespace recmeet;
+
+TEST_CASE("LatencyHistogram: buckets are contiguous and within 1/16", "[latency_histogram]") {
+    for (uint64_t v = 0; v < 8; ++v)
+        CHECK(LatencyHistogram::bucket_of(v) == v);
+    size_t prev = LatencyHistogram::bucket_of(7);
+    bool contiguous = true, close = true;
+    for (uint64_t v = 8; v < (uint64_t{1} << 16); ++v) {
+        const size_t b = LatencyHistogram::bucket_of(v);
+        contiguous = contiguous && (b == prev || b == prev + 1);
+        prev = b;
+        const int64_t mid = LatencyHistogram::bucket_value(b);
+        close = close && std::llabs(mid - static_cast<int64_t>(v)) * 16 <= static_cast<int64_t>(v);
+    }
+    CHECK(contiguous);
+    CHECK(close);
+    CHECK(LatencyHistogram::bucket_of(~uint64_t{0}) == LatencyHistogram::kBuckets - 1);
+}
+
+TEST_CASE("LatencyHistogram: percentiles of a known distribution", "[latency_histogram]") {
+    LatencyHistogram h;
+    CHECK(h.summary().count == 0);
+    CHECK(h.summary().p99 == 0);
+
+    // 1..1000 ms, once each.
+    for (int v = 1; v <= 1000; ++v) h.record(v);
+    LatencySummary s = h.summary();
+    CHECK(s.count == 1000);
+    CHECK(s.max == 1000);
+    CHECK(std::llabs(s.p50 - 500) <= 500 / 16);
+    CHECK(std::llabs(s.p95 - 950) <= 950 / 16);
+    CHECK(std::llabs(s.p99 - 990) <= 990 / 16);
+    CHECK(s.p99 <= s.max);
+
+    // A negative value (a clock step) counts as 0; reset clears everything.
+    h.record(-5);
+    CHECK(h.summary().count == 1001);
+    h.reset();
+    CHECK(h.summary().count == 0);
+    CHECK(h.summary().max == 0);
+}
+
+TEST_CASE("LatencyHistogram: a single outlier moves only the tail", "[latency_histogram]") {
+    LatencyHistogram h;
+    for (int i = 0; i < 99; ++i) h.record(200);
+    h.record(30000);
+    LatencySummary s = h.summary();
+    CHECK(std::llabs(s.p50 - 200) <= 200 / 16);
+    CHECK(std::llabs(s.p95 - 200) <= 200 / 16);
+    CHECK(std::llabs(s.p99 - 200) <= 200 / 16);
+    CHECK(s.max == 30000);
+}
@@ -0,0 +1,176 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "level_feed.h"
+#include "level_meter.h"
+#include "util.h"
+
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace recmeet;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+std::string feed_name(const char* tag) {
+    return LevelFeed::default_name() + "-test-" + tag;
+}
+
+std::vector<int16_t> sine(double hz, double amplitude, std::size_t n) {
+    std::vector<int16_t> out(n);
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = static_cast<int16_t>(std::lround(
+            amplitude * 32767.0 * std::sin(2 * 3.14159265358979323846 * hz * i / SAMPLE_RATE)));
+    return out;
+}
+
+std::size_t loudest_band(const LevelReading& r) {
+    std::size_t best = 0;
+    for (std::size_t b = 1; b < LEVEL_BANDS; ++b)
+        if (r.bands[b] > r.bands[best]) best = b;
+    return best;
+}
+
+} // namespace
+
+TEST_CASE("LevelFeed: a reader sees each source's latest reading", "[level_feed]") {
+    const std::string name = feed_name("roundtrip");
+    LevelFeedReader reader;
+    CHECK_FALSE(reader.open(name));
+    LevelReading got;
+    CHECK_FALSE(reader.read(LevelSource::Mic, got));
+
+    {
+        LevelFeed feed(name);
+        CHECK(feed.name() == name);
+        REQUIRE(reader.open(name));
+        REQUIRE(reader.read(LevelSource::Monitor, got));
+        CHECK(got.frames == 0);
+        CHECK(got.updated_ms == 0);
+
+        LevelReading r;
+        r.frames = 1600;
+        r.updated_ms = 42;
+        r.rms = 0.25f;
+        r.peak = 0.5f;
+        r.bands[3] = 0.125f;
+        feed.publish(LevelSource::Mic, r);
+        REQUIRE(reader.read(LevelSource::Mic, got));
+        CHECK(got.frames == 1600);
+        CHECK(got.updated_ms == 42);
+        CHECK(got.rms == 0.25f);
+        CHECK(got.peak == 0.5f);
+        CHECK(got.bands[3] == 0.125f);
+        REQUIRE(reader.read(LevelSource::Monitor, got));
+        CHECK(got.frames == 0);
+    }
+    // The writer unlinks the segment; a mapped reader keeps its view.
+    CHECK(reader.read(LevelSource::Mic, got));
+    LevelFeedReader late;
+    CHECK_FALSE(late.open(name));
+}
+
+TEST_CASE("LevelFeed: a reading is never torn by a concurrent publish", "[level_feed]") {
+    const std::string name = feed_name("seqlock");
+    LevelFeed feed(name);
+    LevelFeedReader reader;
+    REQUIRE(reader.open(name));
+
+    // Every field of reading k holds k.
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (uint64_t k = 1; k <= 200000; ++k) {
+            LevelReading r;
+            r.frames = k;
+            r.updated_ms = static_cast<int64_t>(k);
+            r.rms = r.peak = static_cast<float>(k);
+            for (auto& b : r.bands) b = static_cast<float>(k);
+            feed.publish(LevelSource::Mic, r);
+        }
+        done.store(true);
+    });
+    size_t reads = 0, torn = 0;
+    uint64_t last = 0;
+    bool backwards = false;
+    while (!done.load()) {
+        LevelReading r;
+        if (!reader.read(LevelSource::Mic, r)) continue;
+        ++reads;
+        bool same = r.updated_ms == static_cast<int64_t>(r.frames) &&
+                    r.rms == static_cast<float>(r.frames) && r.peak == r.rms;
+        for (float b : r.bands) same = same && b == r.rms;
+        if (!same) ++torn;
+        if (r.frames < last) backwards = true;
+        last = r.frames;
+    }
+    writer.join();
+    CHECK(reads > 0);
+    CHECK(torn == 0);
+    CHECK_FALSE(backwards);
+}
+
+TEST_CASE("LevelMeter: RMS, peak and spectrum of a sine", "[level_feed]") {
+    const std::string name = feed_name("meter");
+    LevelFeed feed(name);
+    LevelFeedReader reader;
+    REQUIRE(reader.open(name));
+
+    LevelReading got;
+    {
+        LevelMeter meter(&feed, LevelSource::Monitor);
+        // 1 kHz at half scale, in two pump-sized chunks.
+        auto tone = sine(1000.0, 0.5, 640);
+        meter.process(tone.data(), 320);
+        LevelMeter::on_audio(tone.data() + 320, 320, &meter);
+        REQUIRE(reader.read(LevelSource::Monitor, got));
+        CHECK(got.frames == 640);
+        CHECK(got.updated_ms > 0);
+        CHECK_THAT(got.rms, WithinAbs(0.5 / std::sqrt(2.0), 0.01));
+        CHECK_THAT(got.peak, WithinAbs(0.5, 0.01));
+        // 1 kHz is bin 16: band b spans bins [128^(b/16), 128^((b+1)/16)).
+        const std::size_t band = loudest_band(got);
+        CHECK(band == 9);
+        CHECK_THAT(got.bands[band], WithinAbs(0.5, 0.05));
+        CHECK(got.bands[0] < 0.01f);
+        CHECK(got.bands[LEVEL_BANDS - 1] < 0.01f);
+
+        // A low tone moves the energy down the spectrum.
+        auto low = sine(150.0, 0.5, 512);
+        meter.process(low.data(), low.size());
+        REQUIRE(reader.read(LevelSource::Monitor, got));
+        CHECK(got.frames == 1152);
+        CHECK(loudest_band(got) < 4);
+
+        // Silence reads as silence.
+        std::vector<int16_t> quiet(320, 0);
+        meter.process(quiet.data(), quiet.size());
+        REQUIRE(reader.read(LevelSource::Monitor, got));
+        CHECK(got.rms == 0.0f);
+        CHECK(got.peak == 0.0f);
+        CHECK(meter.last().frames == 1472);
+
+        meter.process(tone.data(), tone.size());
+        REQUIRE(reader.read(LevelSource::Monitor, got));
+        CHECK(got.peak > 0.4f);
+    }
+    // Destruction publishes silence, keeping the frame count.
+    REQUIRE(reader.read(LevelSource::Monitor, got));
+    CHECK(got.frames == 2112);
+    CHECK(got.rms == 0.0f);
+    CHECK(got.peak == 0.0f);
+    CHECK(got.bands[9] == 0.0f);
+    REQUIRE(reader.read(LevelSource::Mic, got));
+    CHECK(got.frames == 0);
+
+    // Without a feed the meter does nothing.
+    LevelMeter idle(nullptr, LevelSource::Mic);
+    auto tone = sine(1000.0, 0.5, 320);
+    idle.process(tone.data(), tone.size());
+    CHECK(idle.last().frames == 0);
+}
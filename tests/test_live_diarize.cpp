@@ -0,0 +1,111 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "live_diarize.h"
+#include "test_tmpdir.h"
+
+#include <fstream>
+
+using namespace recmeet;
+
+#if RECMEET_USE_SHERPA
+
+namespace {
+
+fs::path tmp_dir() {
+    fs::path dir = recmeet::test::tmp_path("recmeet_live_diarize");
+    fs::create_directories(dir);
+    return dir;
+}
+
+const LiveDiarizeKey kKey{15.0f, 30.0f, 1.18f};
+
+DiarizedChunk make_chunk(size_t start, size_t end) {
+    DiarizedChunk c{};
+    c.extents.pcm_start_samples = start;
+    c.extents.pcm_end_samples = end;
+    c.diar.segments = {{0.1 + 1.0 / 3.0, 4.25, 0}, {5.0, 9.87654321, 1}};
+    c.diar.num_speakers = 2;
+    c.centroids[0] = {0.1f, -0.2f, 1.0f / 3.0f};
+    c.centroids[1] = {0.5f, 0.25f, -1e-7f};
+    return c;
+}
+
+} // namespace
+
+TEST_CASE("live_diarization_path: sits next to the audio", "[live_diarize]") {
+    CHECK(live_diarization_path("/m/audio_2026-05-18_09-36.wav") ==
+          fs::path("/m/live_diarize_2026-05-18_09-36.ndjson"));
+    CHECK(live_diarization_path("/m/audio.wav") == fs::path("/m/live_diarize_audio.ndjson"));
+}
+
+TEST_CASE("live diarization: chunks round-trip exactly", "[live_diarize]") {
+    const fs::path path = tmp_dir() / "roundtrip.ndjson";
+    begin_live_diarization(path, kKey);
+    const auto a = make_chunk(0, 14640000);
+    const auto b = make_chunk(13920000, 28800000);
+    append_live_chunk(path, a);
+    append_live_chunk(path, b);
+
+    std::vector<DiarizedChunk> out;
+    REQUIRE(load_live_diarization(path, kKey, out));
+    REQUIRE(out.size() == 2);
+    CHECK(out[1].extents.pcm_start_samples == 13920000);
+    CHECK(out[1].extents.pcm_end_samples == 28800000);
+    CHECK(out[0].diar.num_speakers == 2);
+    REQUIRE(out[0].diar.segments.size() == 2);
+    CHECK(out[0].diar.segments[0].start == a.diar.segments[0].start);
+    CHECK(out[0].diar.segments[1].end == a.diar.segments[1].end);
+    CHECK(out[0].diar.segments[1].speaker == 1);
+    CHECK(out[0].centroids == a.centroids);
+}
+
+TEST_CASE("live diarization: other settings and torn lines", "[live_diarize]") {
+    const fs::path path = tmp_dir() / "torn.ndjson";
+    begin_live_diarization(path, kKey);
+    append_live_chunk(path, make_chunk(0, 100));
+    {
+        std::ofstream out(path, std::ios::app);
+        out << "{\"pcm_start\":50,\"pcm_end\":";  // crash mid-append
+    }
+
+    std::vector<DiarizedChunk> out;
+    REQUIRE(load_live_diarization(path, kKey, out));
+    CHECK(out.size() == 1);
+
+    LiveDiarizeKey other = kKey;
+    other.chunk_minutes = 20.0f;
+    CHECK_FALSE(load_live_diarization(path, other, out));
+    other = kKey;
+    other.cluster_threshold = 1.0f;
+    CHECK_FALSE(load_live_diarization(path, other, out));
+    other = kKey;
+    other.share_overlap = true;
+    CHECK_FALSE(load_live_diarization(path, other, out));
+    CHECK_FALSE(load_live_diarization(tmp_dir() / "missing.ndjson", kKey, out));
+}
+
+TEST_CASE("stable_chunk_count: leading chunks are final while recording",
+          "[live_diarize]") {
+    CHECK(stable_chunk_count(0) == 0);
+    CHECK(stable_chunk_count(1) == 0);
+    CHECK(stable_chunk_count(4) == 3);
+
+    // The stable chunks of a recording in progress are exactly the chunks
+    // the finished recording is cut into.
+    DiarizeChunkConfig cfg;
+    const size_t minute = 60 * SAMPLE_RATE;
+    const auto final_extents = plan_chunk_extents(181 * minute + 123, cfg);
+    for (size_t recorded = 10 * minute; recorded < 181 * minute; recorded += 7 * minute + 11) {
+        const auto partial = plan_chunk_extents(recorded, cfg);
+        for (size_t i = 0; i < stable_chunk_count(partial.size()); ++i) {
+            CHECK(partial[i].pcm_start_samples == final_extents[i].pcm_start_samples);
+            CHECK(partial[i].pcm_end_samples == final_extents[i].pcm_end_samples);
+            CHECK(partial[i].pcm_end_samples <= recorded);
+            CHECK(partial[i].core_end_sec == final_extents[i].core_end_sec);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,203 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "clip_transcribe.h"
+#include "live_transcribe.h"
+#include "test_tmpdir.h"
+
+#include <fstream>
+
+using namespace recmeet;
+
+namespace {
+
+fs::path tmp_dir() {
+    fs::path dir = recmeet::test::tmp_path("recmeet_live_transcribe");
+    fs::create_directories(dir);
+    return dir;
+}
+
+const LiveTranscriptKey kKey{"base", "en", "Alice, Bob"};
+
+LiveWindow make_window(size_t start, size_t n, std::vector<TranscriptSegment> segs) {
+    LiveWindow w;
+    w.window.pieces.push_back({start, n, 0});
+    w.window.length = n;
+    w.segments = std::move(segs);
+    w.language = "en";
+    return w;
+}
+
+} // namespace
+
+TEST_CASE("live_transcript_path: sits next to the audio", "[live_transcribe]") {
+    CHECK(live_transcript_path("/m/audio_2026-05-18_09-36.wav") ==
+          fs::path("/m/live_2026-05-18_09-36.ndjson"));
+    CHECK(live_transcript_path("/m/audio_2026-05-18_09-36.flac") ==
+          fs::path("/m/live_2026-05-18_09-36.ndjson"));
+    CHECK(live_transcript_path("/m/audio.wav") == fs::path("/m/live_audio.ndjson"));
+}
+
+TEST_CASE("live transcript: windows round-trip in order", "[live_transcribe]") {
+    auto dir = tmp_dir();
+    fs::path p = dir / "live.ndjson";
+
+    LiveWindow packed;
+    packed.window.pieces = {{16000, 32000, 0}, {56000, 8000, 40000}};
+    packed.window.length = 48000;
+    packed.segments = {{1.0, 2.5, " Hello, \"world\"."}, {3.5, 4.0, " Next\nline"}};
+    packed.language = "en";
+
+    begin_live_transcript(p, kKey);
+    append_live_window(p, packed);
+    append_live_window(p, make_window(100000, 16000, {}));
+
+    std::vector<LiveWindow> got;
+    REQUIRE(load_live_transcript(p, kKey, got));
+    REQUIRE(got.size() == 2);
+    REQUIRE(got[0].window.pieces.size() == 2);
+    CHECK(got[0].window.pieces[1].start == 56000);
+    CHECK(got[0].window.pieces[1].n == 8000);
+    CHECK(got[0].window.pieces[1].offset == 40000);
+    CHECK(got[0].window.length == 48000);
+    REQUIRE(got[0].segments.size() == 2);
+    CHECK(got[0].segments[0].start == 1.0);
+    CHECK(got[0].segments[0].end == 2.5);
+    CHECK(got[0].segments[0].text == " Hello, \"world\".");
+    CHECK(got[0].segments[1].text == " Next\nline");
+    CHECK(got[0].language == "en");
+    CHECK(got[1].segments.empty());
+
+    // begin_live_transcript truncates.
+    begin_live_transcript(p, kKey);
+    REQUIRE(load_live_transcript(p, kKey, got));
+    CHECK(got.empty());
+    fs::remove_all(dir);
+}
+
+TEST_CASE("live transcript: other settings or a missing file are not reused",
+          "[live_transcribe]") {
+    auto dir = tmp_dir();
+    fs::path p = dir / "live.ndjson";
+    std::vector<LiveWindow> got;
+    CHECK_FALSE(load_live_transcript(p, kKey, got));
+
+    begin_live_transcript(p, kKey);
+    append_live_window(p, make_window(0, 16000, {{0.0, 1.0, " hi"}}));
+    CHECK_FALSE(load_live_transcript(p, {"small", "en", "Alice, Bob"}, got));
+    CHECK_FALSE(load_live_transcript(p, {"base", "", "Alice, Bob"}, got));
+    CHECK_FALSE(load_live_transcript(p, {"base", "en", ""}, got));
+    fs::remove_all(dir);
+}
+
+TEST_CASE("live transcript: a torn last line is dropped", "[live_transcribe]") {
+    auto dir = tmp_dir();
+    fs::path p = dir / "live.ndjson";
+    begin_live_transcript(p, kKey);
+    append_live_window(p, make_window(0, 16000, {{0.0, 1.0, " one"}}));
+    append_live_window(p, make_window(20000, 16000, {{1.25, 2.0, " two"}}));
+    {
+        std::ofstream out(p, std::ios::app);
+        out << "{\"language\":\"en\",\"length\":16000,\"pieces\":\"40000+16";
+    }
+
+    std::vector<LiveWindow> got;
+    REQUIRE(load_live_transcript(p, kKey, got));
+    REQUIRE(got.size() == 2);
+    CHECK(got[1].segments[0].text == " two");
+    fs::remove_all(dir);
+}
+
+TEST_CASE("count_live_prefix: stops at the first differing window", "[live_transcribe]") {
+    std::vector<TranscribeWindow> segs = {
+        {0, 16000}, {20000, 16000}, {500000, 16000}, {900000, 16000}};
+    auto windows = single_windows(segs);
+
+    std::vector<LiveWindow> live = {make_window(0, 16000, {}), make_window(20000, 16000, {})};
+    CHECK(count_live_prefix(live, windows) == 2);
+    CHECK(count_live_prefix({}, windows) == 0);
+
+    live.push_back(make_window(500000, 8000, {}));  // different length
+    live.push_back(make_window(900000, 16000, {}));
+    CHECK(count_live_prefix(live, windows) == 2);
+
+    // More live windows than remain (e.g. a shorter re-run of VAD).
+    windows.resize(1);
+    CHECK(count_live_prefix(live, windows) == 1);
+}
+
+TEST_CASE("stable_window_count: packed windows stay fixed except the last",
+          "[live_transcribe]") {
+    CHECK(stable_window_count(0, true) == 0);
+    CHECK(stable_window_count(3, true) == 2);
+    CHECK(stable_window_count(3, false) == 3);
+
+    // Packing a longer list never changes the stable windows of a prefix.
+    std::vector<TranscribeWindow> segs;
+    for (size_t i = 0; i < 40; ++i)
+        segs.push_back({i * 3 * SAMPLE_RATE, static_cast<size_t>(2 * SAMPLE_RATE)});
+    auto full = pack_windows(segs);
+    for (size_t k = 1; k <= segs.size(); ++k) {
+        std::vector<TranscribeWindow> prefix(segs.begin(), segs.begin() + k);
+        auto part = pack_windows(prefix);
+        std::vector<LiveWindow> live;
+        for (size_t i = 0; i < stable_window_count(part.size(), true); ++i)
+            live.push_back({part[i], {}, ""});
+        CHECK(count_live_prefix(live, full) == live.size());
+    }
+}
+
+TEST_CASE("merge_live_prefix: live segments come first", "[live_transcribe]") {
+    std::vector<LiveWindow> live = {make_window(0, 16000, {{0.0, 1.0, " a"}}),
+                                    make_window(20000, 16000, {{1.25, 2.0, " b"}}),
+                                    make_window(40000, 16000, {{2.5, 3.0, " unused"}})};
+    TranscriptResult rest{};
+    rest.segments = {{3.0, 4.0, " c"}};
+    rest.language = "de";
+
+    auto merged = merge_live_prefix(live, 2, rest);
+    REQUIRE(merged.segments.size() == 3);
+    CHECK(merged.segments[0].text == " a");
+    CHECK(merged.segments[1].text == " b");
+    CHECK(merged.segments[2].text == " c");
+    CHECK(merged.language == "de");
+
+    // Everything decoded live: the language comes from the live windows.
+    merged = merge_live_prefix(live, 3, TranscriptResult{});
+    CHECK(merged.segments.size() == 3);
+    CHECK(merged.language == "en");
+}
+
+TEST_CASE("read_recording_tail: the last seconds of the published recording",
+          "[live_transcribe]") {
+    std::vector<float> out;
+    double start = -1;
+    CHECK_FALSE(read_recording_tail(5.0, out, start));
+
+    std::vector<float> pcm(10 * SAMPLE_RATE);
+    for (size_t i = 0; i < pcm.size(); ++i) pcm[i] = static_cast<float>(i);
+    {
+        ClipSourceTap tap(std::make_unique<MemorySampleSource>(pcm.data(), pcm.size()));
+        REQUIRE(read_recording_tail(2.0, out, start));
+        CHECK(out.size() == 2 * SAMPLE_RATE);
+        CHECK(start == 8.0);
+        CHECK(out.front() == static_cast<float>(8 * SAMPLE_RATE));
+        CHECK(out.back() == static_cast<float>(pcm.size() - 1));
+
+        // Asking for more than was recorded yields all of it.
+        REQUIRE(read_recording_tail(CLIP_MAX_SECONDS, out, start));
+        CHECK(out.size() == pcm.size());
+        CHECK(start == 0.0);
+    }
+    CHECK_FALSE(read_recording_tail(2.0, out, start));
+}
+
+TEST_CASE("clip_text: trims and joins segment text", "[live_transcribe]") {
+    TranscriptResult result;
+    result.segments = {{0, 2, " Hello there.", 0, 0},
+                       {2, 3, "   ", 0, 0},
+                       {3, 5, " How are you?\n", 0, 0}};
+    CHECK(clip_text(result) == "Hello there. How are you?");
+    CHECK(clip_text(TranscriptResult{}).empty());
+}
@@ -7,6 +7,9 @@
 
 #include <filesystem>
 #include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace recmeet;
 namespace fs = std::filesystem;
@@ -204,3 +207,79 @@ TEST_CASE("log rotation: purges old files by filename", "[log]") {
 
     fs::remove_all(tmp);
 }
+
+namespace {
+
+std::vector<std::string> read_log_lines(const fs::path& dir) {
+    std::vector<std::string> lines;
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        if (entry.path().extension() != ".log") continue;
+        std::ifstream in(entry.path());
+        for (std::string line; std::getline(in, line);) lines.push_back(line);
+    }
+    return lines;
+}
+
+} // anonymous namespace
+
+TEST_CASE("log: concurrent threads write whole lines in time order", "[log]") {
+    fs::path tmp = recmeet::test::tmp_path("recmeet_test_log_threads");
+    fs::remove_all(tmp);
+    log_init(LogLevel::DEBUG, tmp);
+
+    constexpr int kThreads = 8, kLines = 200;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+        threads.emplace_back([t] {
+            for (int i = 0; i < kLines; ++i) log_debug("thread %d line %d end", t, i);
+        });
+    for (auto& th : threads) th.join();
+    // The threads are gone; their records must still reach the file.
+    log_shutdown();
+
+    auto lines = read_log_lines(tmp);
+    REQUIRE(lines.size() == static_cast<size_t>(kThreads * kLines));
+    std::vector<int> next(kThreads, 0);
+    for (size_t i = 0; i < lines.size(); ++i) {
+        const auto& line = lines[i];
+        auto pos = line.find("] thread ");
+        REQUIRE(pos != std::string::npos);
+        int t = -1, n = -1;
+        REQUIRE(sscanf(line.c_str() + pos, "] thread %d line %d end", &t, &n) == 2);
+        REQUIRE(t >= 0);
+        REQUIRE(t < kThreads);
+        CHECK(n == next[t]++);  // each thread's lines in the order logged
+        if (i > 0) CHECK(lines[i - 1].substr(0, 23) <= line.substr(0, 23));
+    }
+    fs::remove_all(tmp);
+}
+
+TEST_CASE("log: a full ring drops records and says how many", "[log]") {
+    fs::path tmp = recmeet::test::tmp_path("recmeet_test_log_dropped");
+    fs::remove_all(tmp);
+    log_init(LogLevel::INFO, tmp);
+
+    // Far more than one thread's ring holds between two writer passes.
+    constexpr int kLines = 5000;
+    const std::string pad(1000, 'x');
+    for (int i = 0; i < kLines; ++i) log_info("burst %d %s", i, pad.c_str());
+    log_shutdown();
+
+    size_t written = 0;
+    unsigned long long dropped = 0;
+    for (const auto& line : read_log_lines(tmp)) {
+        auto pos = line.find("log: dropped ");
+        if (pos != std::string::npos) {
+            unsigned long long n = 0;
+            REQUIRE(sscanf(line.c_str() + pos, "log: dropped %llu", &n) == 1);
+            dropped += n;
+        } else {
+            CHECK(line.find("[INFO]") != std::string::npos);
+            CHECK(line.size() > pad.size());
+            ++written;
+        }
+    }
+    CHECK(dropped > 0);
+    CHECK(written + dropped == static_cast<size_t>(kLines));
+    fs::remove_all(tmp);
+}
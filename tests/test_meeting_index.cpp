@@ -0,0 +1,199 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "meeting_index.h"
+#include "audio_file.h"
+#include "speaker_id.h"
+#include "test_tmpdir.h"
+
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+using namespace recmeet;
+
+namespace {
+
+void make_meeting(const fs::path& dir) {
+    fs::create_directories(dir);
+    std::ofstream(dir / "audio.wav") << "RIFF";
+}
+
+std::vector<std::string> names(const MeetingIndex& index) {
+    std::vector<std::string> out;
+    for (const auto& m : index.list()) out.push_back(m.name);
+    return out;
+}
+
+} // anonymous namespace
+
+TEST_CASE("MeetingIndex: lists meetings newest first and follows rescans", "[meeting_index]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_meeting_index");
+    fs::remove_all(tmp);
+    make_meeting(tmp / "2026-03-07_10-00");
+    make_meeting(tmp / "2026-03-08_14-30");
+    fs::create_directories(tmp / "not-a-meeting");
+
+    MeetingIndex index(tmp);
+    CHECK(index.list().empty());
+    index.rescan();
+    CHECK(names(index) == std::vector<std::string>{"2026-03-08_14-30", "2026-03-07_10-00"});
+    CHECK(index.list()[0].date == "2026-03-08");
+    CHECK_FALSE(index.list()[0].has_speakers);
+    CHECK(index.scans() == 3);
+
+    // Nothing changed: every directory is only stat'ed.
+    const auto gen = index.generation();
+    index.rescan();
+    CHECK(index.scans() == 3);
+    CHECK(index.generation() == gen);
+
+    // A directory that gains its audio becomes a meeting; a removed one goes.
+    std::ofstream(tmp / "not-a-meeting" / "audio.wav") << "RIFF";
+    fs::remove_all(tmp / "2026-03-07_10-00");
+    index.rescan();
+    CHECK(names(index) == std::vector<std::string>{"not-a-meeting", "2026-03-08_14-30"});
+    CHECK(index.scans() == 4);
+    CHECK(index.generation() > gen);
+    fs::remove_all(tmp);
+}
+
+TEST_CASE("MeetingIndex: a saved index is reused across restarts", "[meeting_index]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_meeting_index_cache");
+    fs::remove_all(tmp);
+    const fs::path out = tmp / "meetings";
+    const fs::path cache = tmp / "web_meetings.ndjson";
+    const fs::path mtg = out / "2026-03-08_14-30";
+    make_meeting(mtg);
+    make_meeting(out / "2026-03-09_09-00");
+#if RECMEET_USE_SHERPA
+    save_meeting_speakers(mtg, {{0, "Alice", true, {0.1f}, 30.0f, 0.9f},
+                                {1, "Bob", true, {0.2f}, 20.0f, 0.8f}});
+#else
+    std::ofstream(mtg / "speakers.json") << "{}";
+#endif
+
+    {
+        MeetingIndex first(out, cache);
+        first.rescan();
+        CHECK(first.scans() == 2);
+    }
+    REQUIRE(fs::exists(cache));
+
+    MeetingIndex index(out, cache);
+    // Listed from the cache before touching the directory.
+    auto list = index.list();
+    REQUIRE(list.size() == 2);
+    CHECK(list[1].name == "2026-03-08_14-30");
+    CHECK(list[1].has_speakers);
+#if RECMEET_USE_SHERPA
+    CHECK(list[1].speaker_count == 2);
+#endif
+    index.rescan();
+    CHECK(index.scans() == 0);
+
+    // A speakers file rewritten in place is noticed by its own mtime.
+    const fs::path spk = find_speakers_file(mtg);
+    fs::last_write_time(spk, fs::last_write_time(spk) + std::chrono::seconds(5));
+    index.rescan();
+    CHECK(index.scans() == 1);
+
+    // A cache written for another output directory is ignored.
+    MeetingIndex other(tmp / "elsewhere", cache);
+    CHECK(other.list().empty());
+    fs::remove_all(tmp);
+}
+
+TEST_CASE("MeetingIndex: each meeting's length comes from its audio header", "[meeting_index]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_meeting_index_length");
+    fs::remove_all(tmp);
+    const fs::path out = tmp / "meetings";
+    const fs::path cache = tmp / "web_meetings.ndjson";
+    fs::create_directories(out / "2026-03-08_14-30");
+    write_wav(out / "2026-03-08_14-30" / "audio_2026-03-08_14-30.wav",
+              std::vector<int16_t>(SAMPLE_RATE * 7 / 2, 0));
+    make_meeting(out / "2026-03-09_09-00");  // no readable header
+
+    {
+        MeetingIndex first(out, cache);
+        first.rescan();
+        const auto list = first.list();
+        REQUIRE(list.size() == 2);
+        CHECK(list[0].duration_sec == 0);
+        CHECK(list[1].duration_sec == 3.5);
+    }
+    MeetingIndex index(out, cache);
+    REQUIRE(index.list().size() == 2);
+    CHECK(index.list()[1].duration_sec == 3.5);  // from the cache
+    CHECK(index.scans() == 0);
+    fs::remove_all(tmp);
+}
+
+TEST_CASE("MeetingIndex: the watcher picks up new meetings", "[meeting_index]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_meeting_index_watch");
+    fs::remove_all(tmp);
+    make_meeting(tmp / "2026-03-08_14-30");
+    fs::create_directories(tmp / "2026-03-09_09-00");
+
+    // Polling every second where inotify is not available.
+    MeetingIndex index(tmp);
+    index.start(1);
+    CHECK(index.list().size() == 1);
+
+    std::ofstream(tmp / "2026-03-09_09-00" / "audio.wav") << "RIFF";
+    make_meeting(tmp / "2026-03-10_11-00");
+    for (int i = 0; i < 100 && index.list().size() < 3; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(names(index) == std::vector<std::string>{
+        "2026-03-10_11-00", "2026-03-09_09-00", "2026-03-08_14-30"});
+
+    fs::remove_all(tmp / "2026-03-08_14-30");
+    for (int i = 0; i < 100 && index.list().size() > 2; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(index.list().size() == 2);
+    fs::remove_all(tmp);
+}
+
+TEST_CASE("select_meetings: filters and pages by cursor", "[meeting_index]") {
+    std::vector<MeetingInfo> all;
+    // In MeetingIndex::list() order: names descending.
+    for (const char* n : {"imported", "2026-03-12_09-00", "2026-03-11_15-00",
+                          "2026-03-11_09-00", "2026-03-10_09-00"}) {
+        MeetingInfo m;
+        m.name = n;
+        if (m.name[4] == '-') m.date = m.name.substr(0, 10);
+        m.has_speakers = m.name.find("09-00") != std::string::npos;
+        all.push_back(m);
+    }
+    auto pick = [&all](const MeetingQuery& q, std::string& next) {
+        std::vector<std::string> out;
+        for (const auto& m : select_meetings(all, q, next)) out.push_back(m.name);
+        return out;
+    };
+
+    std::string next;
+    MeetingQuery q;
+    CHECK(pick(q, next).size() == 5);
+    CHECK(next.empty());
+
+    q.limit = 2;
+    CHECK(pick(q, next) == std::vector<std::string>{"imported", "2026-03-12_09-00"});
+    CHECK(next == "2026-03-12_09-00");
+    q.cursor = next;
+    CHECK(pick(q, next) == std::vector<std::string>{"2026-03-11_15-00", "2026-03-11_09-00"});
+    q.cursor = next;
+    CHECK(pick(q, next) == std::vector<std::string>{"2026-03-10_09-00"});
+    CHECK(next.empty());
+
+    MeetingQuery f;
+    f.from = "2026-03-11";
+    f.to = "2026-03-11";
+    CHECK(pick(f, next) == std::vector<std::string>{"2026-03-11_15-00", "2026-03-11_09-00"});
+    f = MeetingQuery{};
+    f.has_speakers = 0;
+    CHECK(pick(f, next) == std::vector<std::string>{"imported", "2026-03-11_15-00"});
+    f.has_speakers = -1;
+    f.text = "import";
+    CHECK(pick(f, next) == std::vector<std::string>{"imported"});
+}
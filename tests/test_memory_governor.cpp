@@ -0,0 +1,168 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "memory_governor.h"
+#include "model_memory.h"
+
+#include <fstream>
+#include <sstream>
+
+#include <sys/mman.h>
+
+using namespace recmeet;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+constexpr uint64_t GB = 1ull << 30;
+
+MemorySample at(uint64_t rss, uint64_t ceiling, double some = 0, double full = 0) {
+    MemorySample s;
+    s.rss_bytes = rss;
+    s.ceiling_bytes = ceiling;
+    s.pressure.some_avg10 = some;
+    s.pressure.full_avg10 = full;
+    return s;
+}
+
+} // namespace
+
+TEST_CASE("parse_memory_pressure: reads both avg10 figures", "[memory_governor]") {
+    MemoryPressure p;
+    REQUIRE(parse_memory_pressure("some avg10=12.50 avg60=3.00 avg300=0.40 total=123456\n"
+                                  "full avg10=4.25 avg60=1.00 avg300=0.10 total=6789\n", p));
+    CHECK_THAT(p.some_avg10, WithinAbs(12.5, 1e-9));
+    CHECK_THAT(p.full_avg10, WithinAbs(4.25, 1e-9));
+
+    // Older kernels have no "full" line for the host.
+    REQUIRE(parse_memory_pressure("some avg10=0.00 avg60=0.00 avg300=0.00 total=0\n", p));
+    CHECK(p.some_avg10 == 0.0);
+    CHECK(p.full_avg10 == 0.0);
+
+    p.some_avg10 = 7;
+    CHECK_FALSE(parse_memory_pressure("", p));
+    CHECK_FALSE(parse_memory_pressure("max\n", p));
+    CHECK(p.some_avg10 == 7);
+}
+
+TEST_CASE("classify_memory: RSS share or PSI, whichever is worse", "[memory_governor]") {
+    CHECK(classify_memory(at(4 * GB, 12 * GB)) == MemoryLevel::Normal);
+    CHECK(classify_memory(at(9 * GB, 12 * GB)) == MemoryLevel::Tight);
+    CHECK(classify_memory(at(11 * GB, 12 * GB)) == MemoryLevel::Critical);
+    CHECK(classify_memory(at(1 * GB, 12 * GB, 15.0)) == MemoryLevel::Tight);
+    CHECK(classify_memory(at(1 * GB, 12 * GB, 40.0, 6.0)) == MemoryLevel::Critical);
+    // An unknown ceiling leaves PSI alone to decide.
+    CHECK(classify_memory(at(64 * GB, 0)) == MemoryLevel::Normal);
+    CHECK(classify_memory(at(64 * GB, 0, 20.0)) == MemoryLevel::Tight);
+    CHECK(std::string(memory_level_name(MemoryLevel::Critical)) == "critical");
+}
+
+TEST_CASE("memory_fits: stays below the critical share", "[memory_governor]") {
+    CHECK(memory_fits(at(4 * GB, 12 * GB), 5 * GB));
+    CHECK_FALSE(memory_fits(at(4 * GB, 12 * GB), 7 * GB));
+    CHECK_FALSE(memory_fits(at(11 * GB, 12 * GB), 0));
+    CHECK(memory_fits(at(64 * GB, 0), 64 * GB));
+}
+
+TEST_CASE("governed_threads: halves from tight on", "[memory_governor]") {
+    CHECK(governed_threads(8, MemoryLevel::Normal) == 8);
+    CHECK(governed_threads(8, MemoryLevel::Tight) == 4);
+    CHECK(governed_threads(7, MemoryLevel::Critical) == 3);
+    CHECK(governed_threads(1, MemoryLevel::Critical) == 1);
+    CHECK(governed_threads(0, MemoryLevel::Normal) == 1);
+}
+
+TEST_CASE("postprocess deferral: off unless a daemon child enables it", "[memory_governor]") {
+    CHECK_FALSE(postprocess_deferral_enabled());
+    set_postprocess_deferral(true);
+    CHECK(postprocess_deferral_enabled());
+    set_postprocess_deferral(false);
+    CHECK_FALSE(postprocess_deferral_enabled());
+}
+
+TEST_CASE("sample_memory: reads this process", "[memory_governor]") {
+    const MemorySample s = sample_memory();
+    CHECK(s.rss_bytes > 0);
+    CHECK(s.ceiling_bytes > 0);
+}
+
+TEST_CASE("parse_memory_maps: ranges and backing files", "[model_memory]") {
+    std::istringstream in(
+        "55d0c0000000-55d0c0200000 r-xp 00000000 fd:01 1234   /usr/bin/recmeet\n"
+        "7f0000000000-7f0040000000 rw-p 00000000 00:00 0 \n"
+        "7f1000000000-7f1010000000 r--p 00000000 fd:01 99     /home/u/models/ggml-base.bin\n"
+        "garbage\n");
+    const auto maps = parse_memory_maps(in);
+    REQUIRE(maps.size() == 3);
+    CHECK(maps[0].path == "/usr/bin/recmeet");
+    CHECK(maps[1].path.empty());
+    CHECK(maps[1].bytes() == (std::size_t(1) << 30));
+    CHECK(maps[2].start == 0x7f1000000000u);
+    CHECK(maps[2].path == "/home/u/models/ggml-base.bin");
+}
+
+TEST_CASE("model_regions: new large anonymous mappings and the model's files", "[model_memory]") {
+    const std::vector<MemoryRegion> before = {{0x1000, 0x200000, ""}};
+    const std::vector<MemoryRegion> after = {
+        {0x1000, 0x200000, ""},                        // existed before the load
+        {0x10000000, 0x20000000, ""},                  // weight buffer
+        {0x30000000, 0x30001000, ""},                  // small heap arena
+        {0x40000000, 0x48000000, "/m/model.gguf"},     // the model file
+        {0x50000000, 0x58000000, "/usr/lib/libfoo.so"} // someone else's file
+    };
+    const auto regions = model_regions(before, after, {"/m/model.gguf"});
+    REQUIRE(regions.size() == 2);
+    CHECK(regions[0].start == 0x10000000u);
+    CHECK(regions[1].path == "/m/model.gguf");
+}
+
+TEST_CASE("parse_smaps_coverage: sums entries inside the regions", "[model_memory]") {
+    std::istringstream in(
+        "10000000-20000000 rw-p 00000000 00:00 0\n"
+        "Size:             262144 kB\n"
+        "Rss:              200000 kB\n"
+        "AnonHugePages:    190464 kB\n"
+        "Locked:                0 kB\n"
+        "VmFlags: rd wr mr mw me ac hg\n"
+        "60000000-60100000 rw-p 00000000 00:00 0\n"
+        "Rss:                1024 kB\n"
+        "AnonHugePages:      1024 kB\n"
+        "40000000-48000000 r--p 00000000 fd:01 99 /m/model.gguf\n"
+        "Rss:              131072 kB\n"
+        "FilePmdMapped:     65536 kB\n"
+        "Locked:           131072 kB\n");
+    const std::vector<MemoryRegion> regions = {{0x10000000, 0x20000000, ""},
+                                               {0x40000000, 0x48000000, "/m/model.gguf"}};
+    const MemoryCoverage c = parse_smaps_coverage(in, regions);
+    CHECK(c.rss == (200000ull + 131072ull) * 1024);
+    CHECK(c.huge == (190464ull + 65536ull) * 1024);
+    CHECK(c.locked == 131072ull * 1024);
+}
+
+TEST_CASE("transparent_hugepage_mode: the bracketed setting", "[model_memory]") {
+    const fs::path root = fs::temp_directory_path() / "recmeet_test_thp";
+    fs::create_directories(root / "kernel/mm/transparent_hugepage");
+    std::ofstream(root / "kernel/mm/transparent_hugepage/enabled") << "always [madvise] never\n";
+    CHECK(transparent_hugepage_mode(root) == "madvise");
+    fs::remove_all(root);
+    CHECK(transparent_hugepage_mode(root).empty());
+}
+
+TEST_CASE("ModelMemory: finds the mapping a load makes", "[model_memory]") {
+    constexpr std::size_t size = 8u << 20;
+    ModelMemory memory;
+    memory.begin("test model", {}, true);
+    void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    REQUIRE(p != MAP_FAILED);
+    memory.finish();
+    const auto addr = reinterpret_cast<std::uintptr_t>(p);
+    bool found = false;
+    for (const auto& r : memory.regions())
+        found = found || (addr >= r.start && addr < r.end);
+    CHECK(found);
+    memory = ModelMemory{};
+    CHECK(memory.regions().empty());
+    ::munmap(p, size);
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "metrics.h"
+#include "util.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace recmeet;
+
+namespace {
+
+bool contains(const std::string& text, const std::string& needle) {
+    return text.find(needle) != std::string::npos;
+}
+
+} // namespace
+
+TEST_CASE("MetricCounter: sums every thread's updates", "[metrics]") {
+    MetricCounter c;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+        threads.emplace_back([&c] { for (int i = 0; i < 10000; ++i) c.add(); });
+    for (auto& t : threads) t.join();
+    c.add(5);
+    CHECK(c.value() == 80005);
+}
+
+TEST_CASE("MetricGauge: set and add", "[metrics]") {
+    MetricGauge g;
+    g.set(7);
+    g.add(-3);
+    CHECK(g.value() == 4);
+}
+
+TEST_CASE("MetricHistogram: cumulative buckets, count and sum", "[metrics]") {
+    MetricHistogram h({1.0, 5.0});
+    h.observe(0.5);
+    h.observe(1.0);   // at the bound belongs to it
+    h.observe(3.0);
+    h.observe(100.0);
+    const auto snap = h.snapshot();
+    REQUIRE(snap.cumulative.size() == 3);
+    CHECK(snap.cumulative[0] == 2);
+    CHECK(snap.cumulative[1] == 3);
+    CHECK(snap.cumulative[2] == 4);
+    CHECK(snap.count == 4);
+    CHECK(snap.sum == 104.5);
+}
+
+TEST_CASE("metric_label: escapes the value", "[metrics]") {
+    CHECK(metric_label("stage", "vad") == "stage=\"vad\"");
+    CHECK(metric_label("k", "a\"b\\c\nd") == "k=\"a\\\"b\\\\c\\nd\"");
+}
+
+TEST_CASE("MetricsRegistry: renders OpenMetrics text", "[metrics]") {
+    MetricsRegistry reg;
+    reg.counter("t_jobs", "Jobs.", metric_label("outcome", "ok")).add(3);
+    reg.gauge("t_depth", "Depth.").set(2);
+    auto& h = reg.histogram("t_seconds", "Time.", {0.5, 2}, metric_label("stage", "vad"));
+    h.observe(1.0);
+
+    // Same name and labels: the same series.
+    reg.counter("t_jobs", "Jobs.", metric_label("outcome", "ok")).add();
+
+    const std::string text = reg.render();
+    CHECK(contains(text, "# TYPE t_jobs counter\n# HELP t_jobs Jobs.\n"));
+    CHECK(contains(text, "t_jobs_total{outcome=\"ok\"} 4\n"));
+    CHECK(contains(text, "t_depth 2\n"));
+    CHECK(contains(text, "t_seconds_bucket{stage=\"vad\",le=\"0.5\"} 0\n"));
+    CHECK(contains(text, "t_seconds_bucket{stage=\"vad\",le=\"2.0\"} 1\n"));
+    CHECK(contains(text, "t_seconds_bucket{stage=\"vad\",le=\"+Inf\"} 1\n"));
+    CHECK(contains(text, "t_seconds_count{stage=\"vad\"} 1\n"));
+    CHECK(contains(text, "t_seconds_sum{stage=\"vad\"} 1.0\n"));
+    CHECK(text.size() >= 6);
+    CHECK(text.compare(text.size() - 6, 6, "# EOF\n") == 0);
+}
+
+TEST_CASE("MetricsRegistry: a name keeps its type", "[metrics]") {
+    MetricsRegistry reg;
+    reg.counter("t_x", "X.");
+    CHECK_THROWS_AS(reg.gauge("t_x", "X."), RecmeetError);
+}
@@ -0,0 +1,137 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "model_cache.h"
+#include "util.h"
+
+using namespace recmeet;
+
+namespace {
+
+struct FakeModel {
+    explicit FakeModel(int id, int* live) : id(id), live(live) { ++*live; }
+    ~FakeModel() { --*live; }
+    int id;
+    int* live;
+};
+
+// Restores the process-wide switch so test order does not matter.
+struct CacheEnabled {
+    explicit CacheEnabled(bool on) : was(model_cache_enabled()) { set_model_cache_enabled(on); }
+    ~CacheEnabled() { set_model_cache_enabled(was); }
+    bool was;
+};
+
+} // namespace
+
+TEST_CASE("ModelSlot: disabled cache loads every time", "[model_cache]") {
+    CacheEnabled off(false);
+    ModelSlot<FakeModel> slot;
+    int live = 0, loads = 0;
+    auto load = [&] { return std::make_unique<FakeModel>(++loads, &live); };
+    {
+        auto a = slot.get("base", load);
+        auto b = slot.get("base", load);
+        CHECK(a != b);
+        CHECK(live == 2);
+    }
+    // Nothing stays resident once callers let go.
+    CHECK(live == 0);
+    CHECK(slot.hits() == 0);
+}
+
+TEST_CASE("ModelSlot: enabled cache keeps the model per key", "[model_cache]") {
+    CacheEnabled on(true);
+    ModelSlot<FakeModel> slot;
+    int live = 0, loads = 0;
+    auto load = [&] { return std::make_unique<FakeModel>(++loads, &live); };
+
+    auto first = slot.get("base", load)->id;
+    CHECK(live == 1);  // resident after the caller dropped it
+    CHECK(slot.get("base", load)->id == first);
+    CHECK(loads == 1);
+    CHECK(slot.hits() == 1);
+
+    // A different key replaces the resident model.
+    auto other = slot.get("large", load);
+    CHECK(other->id != first);
+    CHECK(live == 1);
+
+    slot.clear();
+    CHECK(live == 1);  // still held by `other`
+    other.reset();
+    CHECK(live == 0);
+}
+
+TEST_CASE("ModelSlot: disabling the cache drops the resident model", "[model_cache]") {
+    ModelSlot<FakeModel> slot;
+    int live = 0, loads = 0;
+    auto load = [&] { return std::make_unique<FakeModel>(++loads, &live); };
+    {
+        CacheEnabled on(true);
+        slot.get("base", load);
+        CHECK(live == 1);
+    }
+    CacheEnabled off(false);
+    CHECK(live == 1);  // until the next load
+    slot.get("base", load);
+    CHECK(loads == 2);
+    CHECK(live == 0);
+}
+
+TEST_CASE("ModelSlot: a failed load leaves the slot empty", "[model_cache]") {
+    CacheEnabled on(true);
+    ModelSlot<FakeModel> slot;
+    int live = 0;
+    slot.get("base", [&] { return std::make_unique<FakeModel>(1, &live); });
+    CHECK_THROWS_AS(slot.get("broken", []() -> std::unique_ptr<FakeModel> {
+                        throw RecmeetError("load failed");
+                    }),
+                    RecmeetError);
+    // The old model was freed before the failed load; the next call loads again.
+    CHECK(live == 0);
+    int loads = 0;
+    slot.get("broken", [&] { ++loads; return std::make_unique<FakeModel>(2, &live); });
+    CHECK(loads == 1);
+}
+
+TEST_CASE("release_resident_models drops every slot's model", "[model_cache]") {
+    CacheEnabled on(true);
+    ModelSlot<FakeModel> a, b;
+    int live = 0, loads = 0;
+    auto load = [&] { return std::make_unique<FakeModel>(++loads, &live); };
+    a.get("base", load);
+    auto held = b.get("large", load);
+    CHECK(live == 2);
+
+    CHECK(release_resident_models() >= 2);
+    CHECK(live == 1);  // `held` keeps b's model alive for its caller
+    held.reset();
+    CHECK(live == 0);
+
+    // The next get() loads again.
+    a.get("base", load);
+    CHECK(loads == 3);
+    CHECK(a.hits() == 0);
+}
+
+TEST_CASE("release_resident_models(kind) leaves other kinds resident", "[model_cache]") {
+    CacheEnabled on(true);
+    ModelSlot<FakeModel> whisper{"whisper"}, llama{"llama"};
+    int live = 0, loads = 0;
+    auto load = [&] { return std::make_unique<FakeModel>(++loads, &live); };
+    whisper.get("base", load);
+    llama.get("qwen", load);
+    CHECK(live == 2);
+
+    CHECK(release_resident_models("whisper") == 1);
+    CHECK(live == 1);
+    CHECK(release_resident_models("whisper") == 0);
+
+    // The llama model is still warm; the whisper one loads again.
+    llama.get("qwen", load);
+    CHECK(llama.hits() == 1);
+    whisper.get("base", load);
+    CHECK(loads == 3);
+}
@@ -3,9 +3,17 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include "model_manager.h"
+#include "sha256.h"
 #include "test_tmpdir.h"
 
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <iterator>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 
 using namespace recmeet;
 
@@ -60,6 +68,43 @@ TEST_CASE("ensure_whisper_model: returns expected filename for each model", "[mo
     }
 }
 
+TEST_CASE("whisper model variants: sizes and weight types", "[model_manager]") {
+    CHECK(whisper_model_size("medium-q5_0") == "medium");
+    CHECK(whisper_model_size("large-v3") == "large-v3");
+    CHECK(whisper_model_size("large-v3-q5_0") == "large-v3");
+    CHECK(whisper_model_variant("base") == "f16");
+    CHECK(whisper_model_variant("small-q8_0") == "q8_0");
+    CHECK(whisper_model_variant("large-v3") == "f16");
+
+    const auto medium = whisper_model_variants("medium");
+    REQUIRE(medium.size() == 3);
+    CHECK(medium[0] == "medium");
+    CHECK(whisper_model_variants("nonexistent").empty());
+
+    const auto names = whisper_model_names();
+    CHECK(names.front() == "tiny");
+    CHECK(names.back() == "large-v3-q5_0");
+    for (const auto& m : list_cached_models())
+        if (m.category == "whisper") CHECK(m.variant == whisper_model_variant(m.name));
+}
+
+TEST_CASE("ensure_whisper_model: a quantized variant has its own file", "[model_manager]") {
+    fs::path model_dir = models_dir() / "whisper";
+    fs::create_directories(model_dir);
+    fs::path fake = model_dir / "ggml-medium-q5_0.bin";
+    bool existed = fs::exists(fake) && fs::file_size(fake) > 0;
+    if (!existed) {
+        std::ofstream out(fake, std::ios::binary);
+        out << "fake model data";
+    }
+
+    CHECK(is_whisper_model_cached("medium-q5_0"));
+    CHECK(ensure_whisper_model("medium-q5_0") == fake);
+    CHECK_THROWS_AS(ensure_whisper_model("medium-q4_k"), RecmeetError);
+
+    if (!existed) fs::remove(fake);
+}
+
 TEST_CASE("is_whisper_model_cached: returns false when model not present", "[model_manager]") {
     fs::path model_dir = models_dir() / "whisper";
     fs::path fake = model_dir / "ggml-tiny.bin";
@@ -129,3 +174,93 @@ TEST_CASE("ensure_llama_model: throws for missing model", "[model_manager]") {
     CHECK_THROWS_AS(ensure_llama_model("/nonexistent/path/model.gguf"), RecmeetError);
 }
 #endif
+
+TEST_CASE("parse_sha256sums: sha256sum lines, text and binary mode", "[model_manager]") {
+    const std::string a(64, 'a');
+    const std::string b = std::string(63, 'B') + "0";
+    auto sums = parse_sha256sums(a + "  ggml-base.bin\n" + b + " *silero_vad.onnx\r\n"
+                                 "not a digest  x.bin\n" + std::string(64, 'z') + "  bad.bin\n");
+    REQUIRE(sums.size() == 2);
+    CHECK(sums["ggml-base.bin"] == a);
+    CHECK(sums["silero_vad.onnx"] == std::string(63, 'b') + "0");
+}
+
+TEST_CASE("fetch_model_file: renames the verified download into place", "[model_manager]") {
+    fs::path dir = recmeet::test::tmp_path("recmeet_test_fetch");
+    fs::create_directories(dir);
+    fs::path src = dir / "model.bin";
+    std::ofstream(src, std::ios::binary) << "model weights";
+    fs::path dest = dir / "cached.bin";
+    fs::path part = dir / "cached.bin.part";
+    fetch_model_file("file://" + src.string(), dest, sha256_hex("model weights"));
+    REQUIRE(fs::exists(dest));
+    CHECK_FALSE(fs::exists(part));
+    {
+        std::ifstream in(dest, std::ios::binary);
+        std::string body((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        CHECK(body == "model weights");
+    }
+
+    // A download that does not match its pin is not kept, .part included.
+    fs::remove(dest);
+    std::ofstream(part, std::ios::binary) << "garbage";
+    CHECK_THROWS_AS(fetch_model_file("file://" + src.string(), dest, std::string(64, '0')),
+                    RecmeetError);
+    CHECK_FALSE(fs::exists(dest));
+    CHECK_FALSE(fs::exists(part));  // a mismatch discards the download
+    fs::remove_all(dir);
+}
+
+TEST_CASE("fetch_models_parallel: runs every fetch, bounded, and collects failures",
+          "[model_manager]") {
+    std::atomic<int> running{0}, peak{0}, ran{0};
+    auto busy = [&] {
+        const int now = ++running;
+        for (int p = peak; now > p && !peak.compare_exchange_weak(p, now);) {}
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        --running;
+        ++ran;
+    };
+    std::vector<ModelFetch> fetches;
+    for (int i = 0; i < 6; ++i) fetches.push_back({"m" + std::to_string(i), busy});
+    fetches.push_back({"broken", [] { throw RecmeetError("no such model"); }});
+
+    std::vector<std::string> done;
+    auto failed = fetch_models_parallel(fetches, 3,
+                                        [&](const std::string& label, const std::string&) {
+                                            done.push_back(label);
+                                        });
+    CHECK(ran == 6);
+    CHECK(peak > 1);
+    CHECK(peak <= 3);
+    CHECK(done.size() == fetches.size());
+    REQUIRE(failed.size() == 1);
+    CHECK(failed["broken"] == "no such model");
+
+    CHECK(fetch_models_parallel({}).empty());
+}
+
+TEST_CASE("fetch_models_parallel: workers report through the caller's progress callback",
+          "[model_manager]") {
+    fs::path dir = recmeet::test::tmp_path("recmeet_test_fetch_parallel");
+    fs::create_directories(dir);
+    std::vector<ModelFetch> fetches;
+    for (const char* name : {"a.bin", "b.bin", "c.bin"}) {
+        std::ofstream(dir / name, std::ios::binary) << std::string(4096, name[0]);
+        fetches.push_back({name, [&dir, name] {
+            fetch_model_file("file://" + (dir / name).string(), dir / (std::string("got-") + name));
+        }});
+    }
+    std::mutex mu;
+    std::set<std::string> reported;
+    {
+        const ScopedDownloadProgress progress([&](const std::string& file, uint64_t, uint64_t) {
+            std::lock_guard<std::mutex> lk(mu);
+            reported.insert(file);
+        });
+        CHECK(fetch_models_parallel(fetches, 3).empty());
+    }
+    CHECK(reported == std::set<std::string>{"a.bin", "b.bin", "c.bin"});
+    CHECK(fs::exists(dir / "got-c.bin"));
+    fs::remove_all(dir);
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "model_manager.h"
+#include "model_prefetch.h"
+#include "test_tmpdir.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+
+using namespace recmeet;
+
+TEST_CASE("plan_model_prefetch: in order, while the uncached bytes fit", "[model_prefetch]") {
+    const std::vector<PrefetchFile> files = {
+        {"whisper.bin", 600}, {"seg.onnx", 0}, {"llm.gguf", 900}, {"emb.onnx", 300}};
+    // The LLM does not fit after whisper; the smaller embedding still does.
+    CHECK(plan_model_prefetch(files, 1000) == std::vector<fs::path>{"whisper.bin", "emb.onnx"});
+    CHECK(plan_model_prefetch(files, 2000) ==
+          std::vector<fs::path>{"whisper.bin", "llm.gguf", "emb.onnx"});
+    // A file already cached is never chosen; no budget chooses nothing.
+    CHECK(plan_model_prefetch(files, 0).empty());
+    CHECK(plan_model_prefetch({{"seg.onnx", 0}}, 1000).empty());
+}
+
+TEST_CASE("uncached_file_bytes: a file just written is in the page cache", "[model_prefetch]") {
+    fs::path dir = recmeet::test::tmp_path("recmeet_test_prefetch");
+    fs::create_directories(dir);
+    fs::path file = dir / "model.bin";
+    std::ofstream(file, std::ios::binary) << std::string(1 << 20, 'm');
+    CHECK(uncached_file_bytes(file) < (1u << 20));
+    CHECK(uncached_file_bytes(dir / "missing.bin") == 0);
+
+    // A set stop flag reads nothing.
+    std::atomic<bool> stop{true};
+    CHECK(prefetch_model_files({file}, stop) == 0);
+    fs::remove_all(dir);
+}
+
+TEST_CASE("postprocess_model_files: cached models only, none for a remote worker",
+          "[model_prefetch]") {
+    fs::path model = models_dir() / "whisper" / "ggml-tiny.bin";
+    const bool made = !fs::exists(model);
+    if (made) {
+        fs::create_directories(model.parent_path());
+        std::ofstream(model, std::ios::binary) << "fake model data";
+    }
+
+    Config cfg;
+    cfg.whisper_model = "tiny";
+    cfg.whisper_draft_model = "nonexistent";  // unknown names are left out
+    cfg.llm_model = "no-such-model.gguf";
+    const auto files = postprocess_model_files(cfg);
+    REQUIRE_FALSE(files.empty());
+    CHECK(files.front() == model);
+    CHECK(std::count(files.begin(), files.end(), model) == 1);
+
+    cfg.remote_worker = "gpubox:9876";
+    CHECK(postprocess_model_files(cfg).empty());
+
+    if (made) fs::remove(model);
+}
@@ -127,6 +127,14 @@ TEST_CASE("parse_ndjson: heartbeat event with rss_kb round-trip", "[ndjson]") {
     CHECK(parse_ndjson_int(line, "rss_kb") == 1572864);
 }
 
+TEST_CASE("parse_ndjson: heartbeat peak_rss_kb does not shadow rss_kb", "[ndjson]") {
+    std::string line = R"({"event":"heartbeat","data":{"rss_kb":1024,"peak_rss_kb":4096}})";
+    CHECK(parse_ndjson_int(line, "rss_kb") == 1024);
+    CHECK(parse_ndjson_int(line, "peak_rss_kb") == 4096);
+    std::string old = R"({"event":"heartbeat","data":{"rss_kb":1024}})";
+    CHECK(parse_ndjson_int(old, "peak_rss_kb") == -1);
+}
+
 TEST_CASE("parse_ndjson: legacy heartbeat without rss_kb returns -1", "[ndjson]") {
     // Pre-T1A heartbeat format — daemon must treat missing rss_kb gracefully.
     std::string line = R"({"event":"heartbeat","data":{}})";
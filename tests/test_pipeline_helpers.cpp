@@ -5,9 +5,13 @@
 #include "pipeline.h"
 #include "audio_file.h"
 #include "model_manager.h"
+#include "speaker_id.h"
+#include "stage_cache.h"
 #include "test_tmpdir.h"
 
+#include <cstdlib>
 #include <fstream>
+#include <sstream>
 
 using namespace recmeet;
 
@@ -369,6 +373,15 @@ TEST_CASE("parse_context_participants: multiple Participants lines sum",
     CHECK(parse_context_participants(ctx) == 3);
 }
 
+TEST_CASE("parse_context_participant_names: the counted names, trimmed, in order",
+          "[pipeline][context-parser]") {
+    CHECK(parse_context_participant_names(
+              "Subject: Sync\nParticipants:  Alice Smith , Bob and Carol & Dan\n"
+              "Participant: Eve (maybe)") ==
+          std::vector<std::string>{"Alice Smith", "Bob", "Carol", "Dan", "Eve (maybe)"});
+    CHECK(parse_context_participant_names("Subject: Standup").empty());
+}
+
 TEST_CASE("parse_context_participants: singular form 'Participant:'",
           "[pipeline][context-parser]") {
     CHECK(parse_context_participants("Participant: Alice") == 1);
@@ -444,6 +457,367 @@ TEST_CASE(
     fs::remove_all(dir);
 }
 
+// ---------------------------------------------------------------------------
+// Overlapped diarization: memory estimate + gate
+// ---------------------------------------------------------------------------
+
+TEST_CASE("estimate_diarize_peak_bytes: grows with audio until the chunk threshold",
+          "[pipeline][diarize-overlap]") {
+    constexpr size_t MIN = 60 * SAMPLE_RATE;
+    const uint64_t five = estimate_diarize_peak_bytes(5 * MIN, 15.0f, 30.0f);
+    const uint64_t ten = estimate_diarize_peak_bytes(10 * MIN, 15.0f, 30.0f);
+    CHECK(five < ten);
+
+    // Above the threshold only one chunk is held, whatever the length.
+    const uint64_t one_hour = estimate_diarize_peak_bytes(60 * MIN, 15.0f, 30.0f);
+    const uint64_t four_hours = estimate_diarize_peak_bytes(240 * MIN, 15.0f, 30.0f);
+    CHECK(one_hour == four_hours);
+    CHECK(one_hour < estimate_diarize_peak_bytes(17 * MIN, 15.0f, 30.0f));
+    CHECK(estimate_diarize_peak_bytes(60 * MIN, 12.0f, 30.0f) < one_hour);
+
+    // Errs high against the measured chunked peak (4.4 GB on 60 min).
+    CHECK(one_hour < 6ull * 1024 * 1024 * 1024);
+    CHECK(one_hour > 2ull * 1024 * 1024 * 1024);
+}
+
+TEST_CASE("plan_diarize_chunking: window follows the memory ceiling",
+          "[pipeline][diarize-chunking]") {
+    constexpr uint64_t GB = 1ull << 30;
+
+    auto plan = plan_diarize_chunking(0);  // unknown: the fixed defaults
+    CHECK(plan.chunk_minutes == 15.0f);
+    CHECK(plan.overlap_sec == 30.0f);
+
+    plan = plan_diarize_chunking(8 * GB);
+    CHECK(plan.chunk_minutes == 10.0f);
+    CHECK(plan.overlap_sec == 20.0f);
+    plan = plan_diarize_chunking(14 * GB);
+    CHECK(plan.chunk_minutes == 25.0f);
+    CHECK(plan.overlap_sec == 50.0f);
+    plan = plan_diarize_chunking(64 * GB);
+    CHECK(plan.chunk_minutes == 60.0f);
+    CHECK(plan.overlap_sec == 60.0f);
+    CHECK(plan_diarize_chunking(1 * GB).chunk_minutes == 5.0f);
+
+    // Every plan satisfies the M-5' spacing invariant and fits its half.
+    for (uint64_t gb : {1, 2, 4, 8, 12, 16, 32, 64, 256}) {
+        plan = plan_diarize_chunking(gb * GB);
+        CHECK(plan.chunk_minutes * 60.0f > plan.overlap_sec + 60.0f);
+        if (gb >= 4)
+            CHECK(estimate_diarize_peak_bytes(600 * 60 * 16000, plan.chunk_minutes,
+                                              plan.overlap_sec) <= gb * GB / 2);
+    }
+}
+
+TEST_CASE("plan_diarize_overlap: gated on device, threads and memory",
+          "[pipeline][diarize-overlap]") {
+    constexpr uint64_t GB = 1ull << 30;
+
+    auto plan = plan_diarize_overlap(true, true, 16, 3 * GB, 2 * GB, 20 * GB, 10 * GB);
+    CHECK(plan.overlap);
+    CHECK(plan.whisper_threads == 4);
+    CHECK(plan.diarize_threads == 12);
+
+    plan = plan_diarize_overlap(true, true, 3, 3 * GB, 2 * GB, 0, 10 * GB);
+    CHECK(plan.overlap);  // MemAvailable unknown: budget alone decides
+    CHECK(plan.whisper_threads == 1);
+    CHECK(plan.diarize_threads == 2);
+
+    CHECK_FALSE(plan_diarize_overlap(false, true, 16, 3 * GB, 2 * GB, 20 * GB, 10 * GB).overlap);
+    CHECK_FALSE(plan_diarize_overlap(true, false, 16, 3 * GB, 2 * GB, 20 * GB, 10 * GB).overlap);
+    CHECK_FALSE(plan_diarize_overlap(true, true, 1, 3 * GB, 2 * GB, 20 * GB, 10 * GB).overlap);
+    CHECK_FALSE(plan_diarize_overlap(true, true, 16, 9 * GB, 2 * GB, 20 * GB, 10 * GB).overlap);
+    CHECK_FALSE(plan_diarize_overlap(true, true, 16, 3 * GB, 2 * GB, 2 * GB, 10 * GB).overlap);
+
+    // Sequential plans keep every thread for each stage.
+    plan = plan_diarize_overlap(true, false, 8, 3 * GB, 2 * GB, 20 * GB, 10 * GB);
+    CHECK(plan.whisper_threads == 8);
+    CHECK(plan.diarize_threads == 8);
+    CHECK(std::string(plan.reason) == "whisper runs on the CPU");
+}
+
+TEST_CASE("plan_transcribe_gpus: one copy per GPU with room and work for it",
+          "[pipeline][gpu]") {
+    constexpr uint64_t GB = 1ull << 30;
+    auto gpu = [](int index, uint64_t free_bytes, uint64_t total_bytes) {
+        GpuDevice d;
+        d.index = index;
+        d.description = "test GPU";
+        d.free_bytes = static_cast<size_t>(free_bytes);
+        d.total_bytes = static_cast<size_t>(total_bytes);
+        return d;
+    };
+    const std::vector<GpuDevice> gpus = {gpu(0, 8 * GB, 12 * GB), gpu(1, 6 * GB, 8 * GB),
+                                         gpu(2, 1 * GB, 8 * GB), gpu(3, 0, 0)};
+
+    CHECK(plan_transcribe_gpus(0, gpus, 3 * GB, 100) == std::vector<int>{0, 1, 3});
+    CHECK(plan_transcribe_gpus(2, gpus, 3 * GB, 100) == std::vector<int>{0, 1});
+    CHECK(plan_transcribe_gpus(1, gpus, 3 * GB, 100) == std::vector<int>{0});
+    // No more copies than windows.
+    CHECK(plan_transcribe_gpus(0, gpus, 3 * GB, 1) == std::vector<int>{0});
+    // GPU 2's 1 GB is enough for a small model.
+    CHECK(plan_transcribe_gpus(0, gpus, GB / 2, 100) == std::vector<int>{0, 1, 2, 3});
+    CHECK(plan_transcribe_gpus(0, {}, 3 * GB, 100).empty());
+}
+
+TEST_CASE("plan_diarize_parallel: capped by threads and memory budget",
+          "[pipeline][diarize-parallel]") {
+    constexpr uint64_t GB = 1ull << 30;
+
+    // A 14 GB budget over 1 GB resident holds two 6 GB chunks, not three.
+    CHECK(plan_diarize_parallel(0, 16, 6 * GB, 1 * GB, 0, 14 * GB) == 2);
+    CHECK(plan_diarize_parallel(0, 16, 4 * GB, 1 * GB, 0, 14 * GB) == 3);
+    // MemAvailable caps it too when known.
+    CHECK(plan_diarize_parallel(0, 16, 4 * GB, 1 * GB, 5 * GB, 14 * GB) == 1);
+    // Auto keeps at least two threads per chunk; an explicit count is a ceiling.
+    CHECK(plan_diarize_parallel(0, 4, 1 * GB, 0, 0, 14 * GB) == 2);
+    CHECK(plan_diarize_parallel(1, 16, 1 * GB, 0, 0, 14 * GB) == 1);
+    CHECK(plan_diarize_parallel(8, 4, 1 * GB, 0, 0, 14 * GB) == 4);
+    // Never below one, even over budget.
+    CHECK(plan_diarize_parallel(0, 16, 6 * GB, 12 * GB, 0, 10 * GB) == 1);
+    CHECK(plan_diarize_parallel(0, 1, 1 * GB, 0, 0, 14 * GB) == 1);
+}
+
+TEST_CASE("estimate_pp_footprint: grows with the audio and the models",
+          "[pipeline][pp-admission]") {
+    constexpr uint64_t GB = 1ull << 30;
+    Config cfg;
+    cfg.diarize = false;
+    cfg.threads = 6;
+    const size_t ten_min = 600 * SAMPLE_RATE;
+
+    PpFootprint fp = estimate_pp_footprint(cfg, ten_min, 2 * GB);
+    CHECK(fp.threads == 6);
+    CHECK(fp.model_bytes == 2 * GB);
+    CHECK(fp.bytes > 2 * GB);
+    CHECK(estimate_pp_footprint(cfg, 2 * ten_min, 2 * GB).bytes > fp.bytes);
+    CHECK(estimate_pp_footprint(cfg, ten_min, 4 * GB).bytes == fp.bytes + 2 * GB);
+
+    cfg.threads = 0;
+    CHECK(estimate_pp_footprint(cfg, ten_min, 0).threads == default_thread_count());
+
+#if RECMEET_USE_SHERPA
+    // Diarization adds its peak; a chunked recording only its chunk's.
+    cfg.diarize = true;
+    cfg.diarize_auto_chunk = false;
+    cfg.chunk_minutes = 15.0f;
+    cfg.chunk_overlap_sec = 30.0f;
+    const size_t two_hours = 7200 * SAMPLE_RATE;
+    const uint64_t long_diar = estimate_pp_footprint(cfg, two_hours, 0).bytes;
+    cfg.diarize = false;
+    const uint64_t long_plain = estimate_pp_footprint(cfg, two_hours, 0).bytes;
+    CHECK(long_diar - long_plain == estimate_diarize_peak_bytes(two_hours, 15.0f, 30.0f));
+    CHECK(long_diar - long_plain < estimate_diarize_peak_bytes(two_hours, 240.0f, 30.0f));
+#endif
+}
+
+TEST_CASE("admit_pp_job: memory budget, cores and job limit",
+          "[pipeline][pp-admission]") {
+    constexpr uint64_t GB = 1ull << 30;
+    PpFootprint job;
+    job.bytes = 6 * GB;
+    job.model_bytes = 3 * GB;
+    job.threads = 4;
+
+    // Nothing else in flight: always, even past the budget.
+    CHECK(admit_pp_job(job, PpLoad{}, false, 1, 10 * GB, 16));
+    PpFootprint huge = job;
+    huge.bytes = 40 * GB;
+    CHECK(admit_pp_job(huge, PpLoad{}, false, 1, 10 * GB, 16));
+
+    PpLoad running;
+    running.jobs = 1;
+    running.threads = 4;
+    running.bytes = 6 * GB;
+    // The job limit comes first.
+    CHECK_FALSE(admit_pp_job(job, running, false, 1, 0, 16));
+    // Two 6 GB jobs fit a 14 GB budget, not a 10 GB one.
+    CHECK(admit_pp_job(job, running, false, 2, 14 * GB, 16));
+    CHECK_FALSE(admit_pp_job(job, running, false, 2, 10 * GB, 16));
+    // Unknown budget: memory is not checked.
+    CHECK(admit_pp_job(job, running, false, 2, 0, 16));
+    // Threads must fit the cores too.
+    CHECK_FALSE(admit_pp_job(job, running, false, 2, 14 * GB, 6));
+    running.threads = 2;
+    CHECK(admit_pp_job(job, running, false, 2, 14 * GB, 6));
+
+    // An idle warm worker elsewhere holds its models: a cold slot counts
+    // them and leaves a job that does not fit beside them to that slot.
+    PpLoad idle;
+    idle.idle_warm = true;
+    idle.bytes = 3 * GB;
+    CHECK(admit_pp_job(job, idle, false, 2, 10 * GB, 16));
+    CHECK_FALSE(admit_pp_job(job, idle, false, 2, 8 * GB, 16));
+    CHECK(admit_pp_job(job, idle, true, 2, 8 * GB, 16));
+}
+
+TEST_CASE("pp_job_class: live recordings first, batch backlog last",
+          "[pipeline][pp-admission]") {
+    Config cfg;
+    CHECK(pp_job_class(cfg) == PpJobClass::Interactive);
+    cfg.reprocess_dir = "/tmp/meeting";
+    CHECK(pp_job_class(cfg) == PpJobClass::Reprocess);
+    cfg.batch_mode = true;
+    CHECK(pp_job_class(cfg) == PpJobClass::Batch);
+    CHECK(std::string(pp_job_class_name(PpJobClass::Batch)) == "batch");
+    CHECK(PpJobClass::Interactive < PpJobClass::Reprocess);
+    CHECK(PpJobClass::Reprocess < PpJobClass::Batch);
+
+    // Only an interactive job pauses, and only a batch one.
+    CHECK(pp_may_preempt(PpJobClass::Interactive, PpJobClass::Batch));
+    CHECK_FALSE(pp_may_preempt(PpJobClass::Interactive, PpJobClass::Reprocess));
+    CHECK_FALSE(pp_may_preempt(PpJobClass::Interactive, PpJobClass::Interactive));
+    CHECK_FALSE(pp_may_preempt(PpJobClass::Reprocess, PpJobClass::Batch));
+}
+
+TEST_CASE("pp_coalesce: one execution per meeting directory", "[pipeline][pp-admission]") {
+    CHECK(pp_coalesce(false, false, false) == PpCoalesce::Enqueue);
+    CHECK(pp_coalesce(true, false, false) == PpCoalesce::Queued);
+    CHECK(pp_coalesce(true, true, true) == PpCoalesce::Queued);
+    CHECK(pp_coalesce(false, true, true) == PpCoalesce::Running);
+    // Another mode while one runs waits its turn rather than running beside it.
+    CHECK(pp_coalesce(false, true, false) == PpCoalesce::Enqueue);
+}
+
+TEST_CASE("admit_pp_job: a paused job keeps its memory, not its threads",
+          "[pipeline][pp-admission]") {
+    constexpr uint64_t GB = 1ull << 30;
+    PpFootprint job;
+    job.bytes = 6 * GB;
+    job.threads = 8;
+
+    PpLoad paused;
+    paused.paused = 1;
+    paused.bytes = 6 * GB;
+    // Not a free pass: the paused job's memory is still resident...
+    CHECK(admit_pp_job(job, paused, false, 1, 14 * GB, 8));
+    CHECK_FALSE(admit_pp_job(job, paused, false, 1, 10 * GB, 8));
+    // ...but it does not count against the job limit or the cores.
+    CHECK(admit_pp_job(job, paused, false, 1, 0, 8));
+}
+
+TEST_CASE("stage keys: each stage follows only its own inputs", "[pipeline][stage_cache]") {
+    Config base;
+    const std::string audio = "0123456789abcdef";
+    const std::string transcript = transcript_stage_key(base, audio, "Alice");
+    const std::string diarization = diarization_stage_key(base, audio, "");
+    const std::string summary = summary_stage_key(base, "[00:00 - 00:05] hi", "");
+
+    Config cfg = base;
+    cfg.cluster_threshold = 0.9f;
+    CHECK(transcript_stage_key(cfg, audio, "Alice") == transcript);
+    CHECK(diarization_stage_key(cfg, audio, "") != diarization);
+
+    cfg = base;
+    cfg.api_model = "other-model";
+    cfg.threads = 3;
+    cfg.whisper_workers = 2;
+    CHECK(transcript_stage_key(cfg, audio, "Alice") == transcript);
+    CHECK(diarization_stage_key(cfg, audio, "") == diarization);
+    CHECK(summary_stage_key(cfg, "[00:00 - 00:05] hi", "") != summary);
+
+    cfg = base;
+    cfg.whisper_model = "small";
+    CHECK(transcript_stage_key(cfg, audio, "Alice") != transcript);
+    CHECK(transcript_stage_key(base, audio, "Bob") != transcript);
+    CHECK(transcript_stage_key(base, "fedcba9876543210", "Alice") != transcript);
+
+    // Language pinning matters only while the language is auto-detected.
+    cfg = base;
+    cfg.language_pin_sec = 0;
+    CHECK(transcript_stage_key(cfg, audio, "Alice") != transcript);
+    cfg.language = "en";
+    Config forced = base;
+    forced.language = "en";
+    CHECK(transcript_stage_key(cfg, audio, "Alice") == transcript_stage_key(forced, audio, "Alice"));
+
+    // A participants line moves the speaker target; a summary follows the
+    // transcript and context it would be prompted with.
+    CHECK(diarization_stage_key(base, audio, "Participants: Alice, Bob") != diarization);
+    CHECK(summary_stage_key(base, "[00:00 - 00:05] bye", "") != summary);
+    CHECK(summary_stage_key(base, "[00:00 - 00:05] hi", "Subject: x") != summary);
+
+    // Renaming speakers keeps the key; who spoke which line does not.
+    const std::string two = "[00:00 - 00:05] Speaker_01:  hi\n[00:05 - 00:09] Speaker_02:  yo\n";
+    CHECK(summary_stage_key(base, "[00:00 - 00:05] Alice:  hi\n[00:05 - 00:09] Bob:  yo\n", "") ==
+          summary_stage_key(base, two, ""));
+    CHECK(summary_stage_key(base, "[00:00 - 00:05] Alice:  hi\n[00:05 - 00:09] Alice:  yo\n",
+                            "") != summary_stage_key(base, two, ""));
+}
+
+TEST_CASE("load_caption_transcript: sidecar cues become time-ordered segments", "[pipeline]") {
+    auto dir = tmp_dir();
+    fs::path vtt = dir / "captions.vtt";
+    TranscriptResult r{};
+    CHECK_FALSE(load_caption_transcript(vtt, r));
+    std::ofstream(vtt) << "WEBVTT\n\n";
+    CHECK_FALSE(load_caption_transcript(vtt, r));
+
+    // Dual mode: the monitor's cue ended first but started later.
+    std::ofstream(vtt, std::ios::trunc)
+        << "WEBVTT\n\n"
+        << "00:00:02.000 --> 00:00:04.500\n<v monitor>Status is green.\n\n"
+        << "00:00:00.500 --> 00:00:05.000\n<v mic>Morning all.\n\n";
+    REQUIRE(load_caption_transcript(vtt, r));
+    CHECK(r.language == "en");
+    REQUIRE(r.segments.size() == 2);
+    CHECK(r.segments[0].start == 0.5);
+    CHECK(r.segments[0].end == 5.0);
+    CHECK(r.segments[0].text == " Morning all.");
+    CHECK(r.segments[1].start == 2.0);
+    CHECK(r.to_string() ==
+          "[00:00 - 00:05]  Morning all.\n[00:02 - 00:04]  Status is green.\n");
+    fs::remove_all(dir);
+}
+
+TEST_CASE("rerender_meeting_note: rewrites the note with relabelled speakers", "[pipeline]") {
+    auto dir = tmp_dir() / "rerender";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const fs::path data_home = dir / "data";
+    const char* saved_xdg = std::getenv("XDG_DATA_HOME");
+    const std::string saved = saved_xdg ? saved_xdg : "";
+    setenv("XDG_DATA_HOME", data_home.c_str(), 1);
+
+    const fs::path audio = dir / "audio_2026-03-10_12-00.wav";
+    std::ofstream(audio) << "RIFF";
+    CHECK_THROWS_AS(rerender_meeting_note(Config{}, dir), RecmeetError);
+
+    NoteStage stage;
+    stage.data.date = "2026-03-10";
+    stage.data.time = "12:00";
+    stage.data.summary_text = "## Overview\nSpeaker_02 will send the deck.\n";
+    stage.data.participants = {"Alice", "Speaker_02"};
+    stage.segments = {{0.0, 3.0, "Shall we start?"}, {3.0, 6.0, "I'll send the deck."}};
+    stage.speakers = {0, 1};
+    stage.labels = {{0, "Alice"}, {1, "Speaker_02"}};
+    save_note_stage(stage_cache_path(audio, STAGE_NOTE), stage);
+    save_meeting_speakers(dir, {{0, "Alice", true, {}, 3.0f, 0.9f},
+                                {1, "Bob", true, {}, 3.0f, 1.0f}},
+                          "2026-03-10_12-00");
+
+    const fs::path note = rerender_meeting_note(Config{}, dir);
+    std::ifstream in(note);
+    std::stringstream text;
+    text << in.rdbuf();
+    const std::string body = text.str();
+    CHECK(body.find("Bob: I'll send the deck.") != std::string::npos);
+    CHECK(body.find("Alice: Shall we start?") != std::string::npos);
+    CHECK(body.find("Bob will send the deck.") != std::string::npos);
+    CHECK(body.find("Speaker_02") == std::string::npos);
+
+    // The stage now records the new labels, so a second run renames nothing.
+    NoteStage after;
+    REQUIRE(load_note_stage(stage_cache_path(audio, STAGE_NOTE), after));
+    CHECK(after.labels.at(1) == "Bob");
+    CHECK(after.note_path == note);
+    CHECK(rerender_meeting_note(Config{}, dir) == note);
+
+    if (saved_xdg) setenv("XDG_DATA_HOME", saved.c_str(), 1);
+    else unsetenv("XDG_DATA_HOME");
+    fs::remove_all(dir);
+}
+
 TEST_CASE("run_postprocessing: transcribe minimal WAV with no summary/diarize", "[integration]") {
     ensure_whisper_model("tiny");
 
@@ -474,3 +848,29 @@ TEST_CASE("run_postprocessing: transcribe minimal WAV with no summary/diarize",
 
     fs::remove_all(dir);
 }
+
+#if RECMEET_USE_SHERPA
+TEST_CASE("cluster_diarization: short audio hands identification its centroids",
+          "[pipeline]") {
+    // Two distinct voices and a sub-3 s ghost cluster the duration filter
+    // drops; identification matches the survivors' diarize-pass centroids.
+    ClusteringStage stage;
+    stage.samples = 30 * SAMPLE_RATE;
+    DiarizedChunk whole{};
+    whole.extents = {0, stage.samples, 0.0, 30.0, 0.0};
+    whole.diar.segments = {{0.0, 12.0, 0}, {12.0, 24.0, 1}, {24.0, 25.0, 2}};
+    whole.diar.num_speakers = 3;
+    whole.centroids[0] = {1.0f, 0.0f, 0.0f, 0.0f};
+    whole.centroids[1] = {0.0f, 1.0f, 0.0f, 0.0f};
+    whole.centroids[2] = {0.0f, 0.0f, 1.0f, 0.0f};
+    stage.chunks.push_back(whole);
+
+    Config cfg;
+    PostprocessInput input;
+    const DiarizationOutput out = cluster_diarization(cfg, input, stage, "");
+    REQUIRE(out.diar.num_speakers == 2);
+    REQUIRE(out.centroids.size() == 2);
+    for (const auto& seg : out.diar.segments)
+        CHECK(out.centroids.count(seg.speaker) == 1);
+}
+#endif
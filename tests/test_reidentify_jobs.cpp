@@ -0,0 +1,112 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "reidentify_jobs.h"
+#include "speaker_id.h"
+#include "test_tmpdir.h"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace recmeet;
+
+TEST_CASE("reidentify_status_json: reports progress and errors", "[reidentify_jobs]") {
+    ReidentifyJobStatus s;
+    s.id = "1-2";
+    s.state = "failed";
+    s.error = "bad \"dir\"";
+    s.meetings_total = 3;
+    s.meetings_done = 2;
+    const auto json = reidentify_status_json(s);
+    CHECK(json.find(R"("job_id":"1-2")") != std::string::npos);
+    CHECK(json.find(R"("state":"failed")") != std::string::npos);
+    CHECK(json.find(R"("meetings_total":3)") != std::string::npos);
+    CHECK(json.find(R"("meetings_done":2)") != std::string::npos);
+    CHECK(json.find(R"("error":"bad \"dir\"")") != std::string::npos);
+
+    s.error.clear();
+    CHECK(reidentify_status_json(s).find("error") == std::string::npos);
+}
+
+#if RECMEET_USE_SHERPA
+
+TEST_CASE("ReidentifyJobs: re-identifies every meeting on a pool of workers",
+          "[reidentify_jobs]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_reid_jobs");
+    fs::remove_all(tmp);
+    const fs::path db = tmp / "speakers";
+    const fs::path out = tmp / "meetings";
+
+    SpeakerProfile alice;
+    alice.name = "Alice";
+    alice.created = alice.updated = "2026-01-01T00:00:00Z";
+    alice.embeddings = {{1.0f, 0.0f, 0.0f}};
+    save_speaker(db, alice);
+
+    // 24 meetings: even ones hold Alice's voice, odd ones someone else's.
+    for (int i = 0; i < 24; ++i) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "2026-03-%02d_10-00", i + 1);
+        const fs::path mtg = out / name;
+        fs::create_directories(mtg);
+        std::vector<float> emb = i % 2 ? std::vector<float>{0.0f, 0.0f, 1.0f}
+                                       : std::vector<float>{1.0f, 0.0f, 0.0f};
+        save_meeting_speakers(mtg, {{0, "Speaker_01", false, emb, 10.0f, 0.0f}});
+    }
+    fs::create_directories(out / "no-speakers");  // skipped, not counted
+
+    std::mutex write_mu;
+    ReidentifyJobs jobs(db, out, false, 0.6f, 4, write_mu);
+    const auto started = jobs.start();
+    CHECK_FALSE(started.id.empty());
+    jobs.wait(started.id);
+
+    ReidentifyJobStatus s;
+    REQUIRE(jobs.status(started.id, s));
+    CHECK(s.state == "done");
+    CHECK(s.meetings_total == 24);
+    CHECK(s.meetings_done == 24);
+    CHECK(s.meetings_scanned == 24);
+    CHECK(s.meetings_updated == 12);
+    CHECK(s.meetings_failed == 0);
+
+    auto first = load_meeting_speakers(out / "2026-03-01_10-00");
+    REQUIRE(first.size() == 1);
+    CHECK(first[0].label == "Alice");
+    CHECK(load_meeting_speakers(out / "2026-03-02_10-00")[0].label == "Speaker_01");
+
+    // A second pass finds nothing left to change, under a new ID.
+    const auto again = jobs.start();
+    CHECK(again.id != started.id);
+    jobs.wait(again.id);
+    REQUIRE(jobs.status(again.id, s));
+    CHECK(s.meetings_updated == 0);
+    CHECK(jobs.status(started.id, s));  // finished jobs stay queryable
+    CHECK_FALSE(jobs.status("0-0", s));
+
+    fs::remove_all(tmp);
+}
+
+TEST_CASE("ReidentifyJobs: an empty speaker database finishes with nothing scanned",
+          "[reidentify_jobs]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_reid_jobs_empty");
+    fs::remove_all(tmp);
+    fs::create_directories(tmp / "meetings" / "2026-03-01_10-00");
+    save_meeting_speakers(tmp / "meetings" / "2026-03-01_10-00",
+                          {{0, "Speaker_01", false, {1.0f, 0.0f}, 10.0f, 0.0f}});
+
+    std::mutex write_mu;
+    ReidentifyJobs jobs(tmp / "speakers", tmp / "meetings", false, 0.6f, 2, write_mu);
+    const auto id = jobs.start().id;
+    jobs.wait(id);
+    ReidentifyJobStatus s;
+    REQUIRE(jobs.status(id, s));
+    CHECK(s.state == "done");
+    CHECK(s.meetings_total == 0);
+    CHECK(s.meetings_scanned == 0);
+
+    fs::remove_all(tmp);
+}
+
+#endif // RECMEET_USE_SHERPA
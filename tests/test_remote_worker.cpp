@@ -0,0 +1,192 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "remote_worker.h"
+#include "ipc_server.h"
+#include "test_tmpdir.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace recmeet;
+
+namespace {
+
+void put(const fs::path& path, const std::string& body) {
+    fs::create_directories(path.parent_path());
+    std::ofstream(path, std::ios::binary) << body;
+}
+
+std::string slurp(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+// A meeting directory with audio larger than one chunk.
+fs::path fake_meeting(const std::string& name) {
+    const fs::path dir = recmeet::test::tmp_path("recmeet_remote_worker") / name;
+    fs::remove_all(dir);
+    std::string audio(REMOTE_CHUNK_BYTES + 1234, '\0');
+    for (size_t i = 0; i < audio.size(); ++i) audio[i] = static_cast<char>(i * 7);
+    put(dir / "audio_2026-01-02_10-00.wav", audio);
+    put(dir / "mic.wav", "raw");
+    put(dir / "sources.wav", "raw");
+    put(dir / "Meeting_2026-01-02_10-00.md", "# note");
+    put(dir / "perf_2026-01-02_10-00.json", "{}");
+    put(dir / "context_2026-01-02_10-00.json", "{\"context\":\"standup\"}");
+    return dir;
+}
+
+} // anonymous namespace
+
+TEST_CASE("remote_worker: job ids and file names", "[remote_worker]") {
+    CHECK(remote_job_id("gpu box", "/m/2026-01-02_10-00") == "gpu_box_2026-01-02_10-00");
+    CHECK(remote_job_id(".host", "/m/x") == "_host_x");
+    CHECK(remote_job_id_ok("laptop_2026-01-02_10-00"));
+    CHECK_FALSE(remote_job_id_ok(""));
+    CHECK_FALSE(remote_job_id_ok(".."));
+    CHECK_FALSE(remote_job_id_ok("a/b"));
+    CHECK_FALSE(remote_job_id_ok(std::string(129, 'a')));
+
+    CHECK(remote_file_name_ok("audio.wav"));
+    CHECK(remote_file_name_ok("speakers/alice.json"));
+    CHECK_FALSE(remote_file_name_ok("speakers/"));
+    CHECK_FALSE(remote_file_name_ok("speakers/a/b"));
+    CHECK_FALSE(remote_file_name_ok("../audio.wav"));
+    CHECK_FALSE(remote_file_name_ok(".hidden"));
+    CHECK_FALSE(remote_file_name_ok(""));
+}
+
+TEST_CASE("remote_worker: uploads inputs, not notes or raw captures", "[remote_worker]") {
+    const fs::path dir = fake_meeting("upload_list");
+    const fs::path db = dir.parent_path() / "upload_list_db";
+    fs::remove_all(db);
+    put(db / "alice.json", "{}");
+    put(db / ".lock", "");
+
+    Config cfg;
+    cfg.speaker_id = false;
+    auto files = remote_upload_files(cfg, dir);
+    REQUIRE(files.size() == 2);
+    CHECK(files[0].first == "audio_2026-01-02_10-00.wav");
+    CHECK(files[1].first == "context_2026-01-02_10-00.json");
+
+    cfg.speaker_id = true;
+    cfg.speaker_db = db;
+    files = remote_upload_files(cfg, dir);
+    REQUIRE(files.size() == 3);
+    CHECK(files[2].first == "speakers/alice.json");
+    CHECK(files[2].second == db / "alice.json");
+}
+
+TEST_CASE("remote_worker: job config drops this host's paths", "[remote_worker]") {
+    const fs::path dir = fake_meeting("job_config");
+    Config cfg;
+    cfg.remote_worker = "gpu:9000";
+    cfg.note_dir = "/notes";
+    cfg.speaker_db = "/db";
+    cfg.context_inline = "standup";
+    cfg.llm_model = "/models/local.gguf";
+    cfg.threads = 3;
+
+    Config job = remote_job_config(cfg, dir);
+    CHECK(job.remote_worker.empty());
+    CHECK(job.note_dir.empty());
+    CHECK(job.speaker_db.empty());
+    CHECK(job.context_inline == "standup");
+    CHECK(job.no_summary);
+
+    cfg.llm_model = "qwen";
+    CHECK_FALSE(remote_job_config(cfg, dir).no_summary);
+
+    const fs::path copy = dir.parent_path() / "job_config_copy";
+    fs::create_directories(copy / "speakers");
+    Config worker;
+    worker.threads = 16;
+    worker.whisper_gpu = false;
+    apply_worker_config(job, worker, copy);
+    CHECK(job.reprocess_dir == copy);
+    CHECK(job.speaker_db == copy / "speakers");
+    CHECK(job.threads == 16);
+    CHECK_FALSE(job.whisper_gpu);
+    CHECK(job.stage_cache);
+}
+
+TEST_CASE("remote_worker: offload uploads, runs and fetches the stages", "[remote_worker]") {
+    const fs::path dir = fake_meeting("offload");
+    const fs::path root = recmeet::test::tmp_path("recmeet_remote_worker") / "worker_root";
+    fs::remove_all(root);
+    const std::string sock = recmeet::test::tmp_path("recmeet_rw.sock").string();
+    unlink(sock.c_str());
+
+    std::mutex mu;
+    std::map<std::string, RemoteJobStatus> jobs;
+    Config seen;
+    WorkerHooks hooks;
+    hooks.run = [&](const std::string& id, Config cfg, const fs::path& job_dir, std::string&) {
+        std::lock_guard<std::mutex> lock(mu);
+        seen = cfg;
+        // The worker's stage, larger than a chunk, computed from the upload.
+        std::string stage = slurp(job_dir / "audio_2026-01-02_10-00.wav");
+        put(job_dir / "stage_transcript.json", stage);
+        put(job_dir / "note.md", "not fetched");
+        jobs[id].state = "done";
+        return true;
+    };
+    hooks.status = [&](const std::string& id) {
+        std::lock_guard<std::mutex> lock(mu);
+        return jobs.count(id) ? jobs[id] : RemoteJobStatus{};
+    };
+    hooks.cancel = [](const std::string&) {};
+
+    IpcServer server(sock);
+    register_worker_methods(server, root, hooks);
+    REQUIRE(server.start());
+    std::thread srv_thread([&server]() { server.run(); });
+
+    Config cfg;
+    cfg.speaker_id = false;
+    cfg.remote_worker = sock;
+    RemoteOffload opts;
+    opts.address = sock;
+    opts.job_id = remote_job_id("laptop", dir);
+    opts.poll_ms = 10;
+    std::vector<std::string> phases;
+    opts.on_progress = [&phases](const std::string& phase, int) {
+        if (phases.empty() || phases.back() != phase) phases.push_back(phase);
+    };
+
+    // Half of the audio is already there from an earlier, dropped upload.
+    const std::string audio = slurp(dir / "audio_2026-01-02_10-00.wav");
+    put(root / opts.job_id / "audio_2026-01-02_10-00.wav", audio.substr(0, 1000));
+
+    CHECK(offload_postprocessing(opts, cfg, dir) == 1);
+    CHECK(slurp(dir / "stage_transcript.json") == audio);
+    CHECK_FALSE(fs::exists(dir / "note.md"));
+    CHECK_FALSE(fs::exists(root / opts.job_id));  // released
+    CHECK(seen.context_inline.empty());
+    CHECK(seen.remote_worker.empty());
+    REQUIRE(phases.size() == 3);
+    CHECK(phases[0] == "uploading");
+    CHECK(phases[2] == "downloading");
+
+    // A stop request ends the offload and releases the worker's copy.
+    StopToken stop;
+    stop.request();
+    opts.stop = &stop;
+    CHECK_THROWS_AS(offload_postprocessing(opts, cfg, dir), RecmeetError);
+    CHECK_FALSE(fs::exists(root / opts.job_id));
+
+    server.stop();
+    srv_thread.join();
+
+    // Nothing listening.
+    opts.stop = nullptr;
+    CHECK_THROWS_AS(offload_postprocessing(opts, cfg, dir), RecmeetError);
+}
@@ -17,14 +17,19 @@
 #include "config.h"
 #include "model_manager.h"
 #include "reprocess_batch.h"
+#include "stage_cache.h"
 #include "test_tmpdir.h"
 #include "util.h"
 
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <thread>
 #include <unistd.h>
 #include <vector>
 
@@ -305,6 +310,46 @@ TEST_CASE("classify_batch_entries: per-meeting state is independent",
     fs::remove_all(scratch);
 }
 
+TEST_CASE("classify_batch_entries: probes each recording without decoding it",
+          "[reprocess-batch]") {
+    auto scratch = make_scratch_dir("probe");
+    fs::path parent = scratch / "meetings";
+    fs::path note_dir = scratch / "notes";
+    fs::create_directories(parent);
+
+    // Speech-like and silent recordings to process, one already noted.
+    fs::path tone = parent / "2026-07-01_10-00";
+    fs::create_directories(tone);
+    std::vector<int16_t> samples(SAMPLE_RATE * 5);
+    for (size_t i = 0; i < samples.size(); ++i)
+        samples[i] = static_cast<int16_t>(6000 * std::sin(0.2 * static_cast<double>(i)));
+    write_wav(tone / "audio_2026-07-01_10-00.wav", samples);
+    make_meeting_dir(parent, "2026-07-02_10-00", /*with_audio=*/true);
+    make_meeting_dir(parent, "2026-07-03_10-00", /*with_audio=*/true);
+    make_note(note_dir, "2026-07-03_10-00");
+    // An audio file whose header cannot be read: nothing to reprocess.
+    fs::path junk = parent / "2026-07-04_10-00";
+    fs::create_directories(junk);
+    std::ofstream(junk / "audio_2026-07-04_10-00.wav") << "not a recording";
+
+    Config cfg;
+    cfg.note_dir = note_dir;
+    auto entries = classify_batch_entries(parent, cfg);
+    REQUIRE(entries.size() == 4);
+    CHECK(entries[0].kind == BatchEntryKind::WillReprocess);
+    CHECK(entries[0].audio_seconds == 5.0);
+    CHECK_FALSE(entries[0].audio_silent);
+    CHECK(entries[1].kind == BatchEntryKind::WillReprocess);
+    CHECK(entries[1].audio_silent);
+    CHECK(entries[2].kind == BatchEntryKind::SkipNoteExists);
+    CHECK(entries[2].audio_seconds == 1.0);
+    CHECK_FALSE(entries[2].audio_silent);  // not sampled
+    CHECK(entries[3].kind == BatchEntryKind::SkipNoAudio);
+    CHECK(entries[3].audio_seconds == 0);
+
+    fs::remove_all(scratch);
+}
+
 // Test 6 — daemon disappearance.
 //
 // A real test of this path requires either:
@@ -421,3 +466,376 @@ TEST_CASE("SIGINT mid-iteration aborts current and stops loop",
     test_hooks::reset_batch_stop_requested();
     test_hooks::set_active_iter_stop(nullptr);
 }
+
+// Cluster mode — run_cluster_batch shares a queue between one thread per
+// node. The dispatch stub stands in for the daemon round trip.
+
+static std::vector<BatchEntry> make_cluster_entries(size_t n) {
+    std::vector<BatchEntry> entries(n);
+    for (size_t i = 0; i < n; ++i) {
+        entries[i].timestamp = "2026-01-0" + std::to_string(i + 1) + "_10-00";
+        entries[i].kind = BatchEntryKind::WillReprocess;
+    }
+    return entries;
+}
+
+static std::vector<const BatchEntry*> pointers_to(const std::vector<BatchEntry>& entries) {
+    std::vector<const BatchEntry*> out;
+    for (const auto& e : entries) out.push_back(&e);
+    return out;
+}
+
+TEST_CASE("run_cluster_batch: every meeting runs once across the nodes",
+          "[reprocess-batch]") {
+    const auto entries = make_cluster_entries(8);
+    std::atomic<int> calls{0};
+    auto result = run_cluster_batch(pointers_to(entries), {"a:1", "b:1"},
+        [&calls](const BatchEntry&, const std::string&) {
+            ++calls;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            Outcome o;
+            o.kind = Outcome::Kind::Ok;
+            o.duration_seconds = 0.005;
+            return o;
+        });
+    CHECK(calls == 8);
+    CHECK(result.items.size() == 8);
+    CHECK(result.not_started == 0);
+    REQUIRE(result.nodes.size() == 2);
+    CHECK(result.nodes[0].ok + result.nodes[1].ok == 8);
+    CHECK(result.nodes[0].ok > 0);
+    CHECK(result.nodes[1].ok > 0);
+}
+
+TEST_CASE("run_cluster_batch: an unreachable node's meeting is requeued",
+          "[reprocess-batch]") {
+    const auto entries = make_cluster_entries(5);
+    auto result = run_cluster_batch(pointers_to(entries), {"dead:1", "live:1"},
+        [](const BatchEntry&, const std::string& node) {
+            Outcome o;
+            if (node == "dead:1") {
+                o.kind = Outcome::Kind::DaemonUnreachable;
+            } else {
+                o.kind = Outcome::Kind::Ok;
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+            return o;
+        });
+    CHECK(result.not_started == 0);
+    REQUIRE(result.items.size() == 5);
+    for (const auto& item : result.items) CHECK(item.node == "live:1");
+    CHECK(result.nodes[0].lost);
+    CHECK(result.nodes[1].ok == 5);
+}
+
+TEST_CASE("run_cluster_batch: failures stay on their node; losing every node stops",
+          "[reprocess-batch]") {
+    const auto entries = make_cluster_entries(4);
+    auto failing = run_cluster_batch(pointers_to(entries), {"a:1"},
+        [](const BatchEntry&, const std::string&) {
+            Outcome o;
+            o.kind = Outcome::Kind::Failed;
+            return o;
+        });
+    CHECK(failing.nodes[0].failed == 4);
+    CHECK_FALSE(failing.nodes[0].lost);
+
+    auto lost = run_cluster_batch(pointers_to(entries), {"a:1", "b:1"},
+        [](const BatchEntry&, const std::string&) {
+            Outcome o;
+            o.kind = Outcome::Kind::DaemonUnreachable;
+            return o;
+        });
+    CHECK(lost.items.empty());
+    CHECK(lost.not_started == 4);
+    CHECK(lost.nodes[0].lost);
+    CHECK(lost.nodes[1].lost);
+}
+
+TEST_CASE("run_cluster_batch: stop ends the batch after the meetings in flight",
+          "[reprocess-batch]") {
+    const auto entries = make_cluster_entries(6);
+    std::atomic<bool> stop{false};
+    auto result = run_cluster_batch(pointers_to(entries), {"a:1"},
+        [&stop](const BatchEntry&, const std::string&) {
+            stop.store(true);
+            Outcome o;
+            o.kind = Outcome::Kind::Ok;
+            return o;
+        },
+        &stop);
+    CHECK(result.items.size() == 1);
+    CHECK(result.not_started == 5);
+}
+
+// Concurrent standalone mode — run_parallel_batch admits meetings by
+// footprint and reports them in order.
+
+TEST_CASE("run_parallel_batch: reports in work order whatever order they finish in",
+          "[reprocess-batch]") {
+    const auto entries = make_cluster_entries(6);
+    std::vector<PpFootprint> footprints(entries.size());
+    ParallelBatchLimits limits;
+    limits.jobs = 3;
+    limits.cores = 64;
+    std::atomic<int> running{0}, peak{0};
+    std::vector<size_t> order;
+    test_hooks::reset_batch_stop_requested();
+    auto outcomes = run_parallel_batch(pointers_to(entries), footprints, limits,
+        [&](const BatchEntry& e, StopToken&) {
+            const int now = ++running;
+            int seen = peak.load();
+            while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+            // Later meetings finish first.
+            const int day = e.timestamp[9] - '0';
+            std::this_thread::sleep_for(std::chrono::milliseconds(5 * (7 - day)));
+            --running;
+            Outcome o;
+            o.kind = Outcome::Kind::Ok;
+            o.note_path = e.timestamp;
+            return o;
+        },
+        nullptr,
+        [&order](size_t i, const Outcome&) { order.push_back(i); });
+    REQUIRE(outcomes.size() == 6);
+    for (size_t i = 0; i < outcomes.size(); ++i)
+        CHECK(outcomes[i].note_path == entries[i].timestamp);
+    CHECK(order == std::vector<size_t>{0, 1, 2, 3, 4, 5});
+    CHECK(peak.load() > 1);
+    CHECK(peak.load() <= 3);
+}
+
+TEST_CASE("run_parallel_batch: a meeting waits until its footprint fits",
+          "[reprocess-batch]") {
+    const auto entries = make_cluster_entries(4);
+    std::vector<PpFootprint> footprints(entries.size());
+    for (auto& fp : footprints) {
+        fp.bytes = 600ull << 20;
+        fp.threads = 2;
+    }
+    ParallelBatchLimits limits;
+    limits.jobs = 4;
+    limits.budget_bytes = 1000ull << 20;  // room for one at a time
+    limits.cores = 64;
+    std::atomic<int> running{0}, peak{0};
+    test_hooks::reset_batch_stop_requested();
+    auto dispatch = [&](const BatchEntry&, StopToken&) {
+        const int now = ++running;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        --running;
+        return Outcome{};
+    };
+    CHECK(run_parallel_batch(pointers_to(entries), footprints, limits, dispatch).size() == 4);
+    CHECK(peak.load() == 1);
+
+    // Two fit in memory, but their threads only fit the cores one at a time.
+    for (auto& fp : footprints) {
+        fp.bytes = 400ull << 20;
+        fp.threads = 6;
+    }
+    limits.cores = 8;
+    peak = 0;
+    CHECK(run_parallel_batch(pointers_to(entries), footprints, limits, dispatch).size() == 4);
+    CHECK(peak.load() == 1);
+
+    limits.cores = 12;
+    peak = 0;
+    CHECK(run_parallel_batch(pointers_to(entries), footprints, limits, dispatch).size() == 4);
+    CHECK(peak.load() == 2);
+}
+
+TEST_CASE("run_parallel_batch: SIGINT cancels every meeting in flight",
+          "[reprocess-batch]") {
+    const auto entries = make_cluster_entries(5);
+    std::vector<PpFootprint> footprints(entries.size());
+    ParallelBatchLimits limits;
+    limits.jobs = 2;
+    limits.cores = 64;
+    std::atomic<int> started{0};
+    test_hooks::reset_batch_stop_requested();
+
+    std::thread interrupter([&started] {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (started.load() < 2 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        test_hooks::test_batch_sigint_handler(SIGINT);
+    });
+    auto outcomes = run_parallel_batch(pointers_to(entries), footprints, limits,
+        [](const BatchEntry&, StopToken& iter_stop) {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (!iter_stop.stop_requested() && std::chrono::steady_clock::now() < deadline)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            Outcome o;
+            o.kind = iter_stop.stop_requested() ? Outcome::Kind::Cancelled : Outcome::Kind::Ok;
+            return o;
+        },
+        [&started](size_t) { ++started; });
+    interrupter.join();
+
+    REQUIRE(outcomes.size() == 2);
+    CHECK(outcomes[0].kind == Outcome::Kind::Cancelled);
+    CHECK(outcomes[1].kind == Outcome::Kind::Cancelled);
+    CHECK(test_hooks::batch_stop_requested());
+    test_hooks::reset_batch_stop_requested();
+}
+
+// Pipelined standalone mode — run_pipelined_batch runs each stage on its own
+// thread, a meeting apart, with stages sharing a resource taking turns.
+
+TEST_CASE("run_pipelined_batch: stages overlap across meetings, in order",
+          "[reprocess-batch]") {
+    const auto entries = make_cluster_entries(5);
+    std::mutex mu;
+    std::vector<std::vector<std::string>> seen(3);
+    std::atomic<int> running{0}, peak{0};
+    auto stage = [&](size_t s) {
+        return [&, s](const BatchEntry& e, StopToken&) {
+            const int now = ++running;
+            int p = peak.load();
+            while (now > p && !peak.compare_exchange_weak(p, now)) {}
+            {
+                std::lock_guard<std::mutex> lk(mu);
+                seen[s].push_back(e.timestamp);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            --running;
+            Outcome o;
+            o.kind = Outcome::Kind::Ok;
+            o.note_path = e.timestamp;
+            o.duration_seconds = 1.0;
+            return o;
+        };
+    };
+    std::vector<BatchStage> stages = {
+        {"transcribe", BATCH_RESOURCE_GPU, stage(0)},
+        {"diarize", BATCH_RESOURCE_CPU, stage(1)},
+        {"summarize", 0, stage(2)},
+    };
+    std::vector<size_t> started, done;
+    test_hooks::reset_batch_stop_requested();
+    auto outcomes = run_pipelined_batch(pointers_to(entries), stages,
+        [&started](size_t i) { started.push_back(i); },
+        [&done](size_t i, const Outcome&) { done.push_back(i); });
+
+    REQUIRE(outcomes.size() == 5);
+    std::vector<std::string> all;
+    for (const auto& e : entries) all.push_back(e.timestamp);
+    for (const auto& s : seen) CHECK(s == all);
+    for (size_t i = 0; i < outcomes.size(); ++i) {
+        CHECK(outcomes[i].kind == Outcome::Kind::Ok);
+        CHECK(outcomes[i].note_path == entries[i].timestamp);
+        CHECK(outcomes[i].duration_seconds == 3.0);  // the time of all three stages
+    }
+    CHECK(started == std::vector<size_t>{0, 1, 2, 3, 4});
+    CHECK(done == std::vector<size_t>{0, 1, 2, 3, 4});
+    CHECK(peak.load() > 1);
+}
+
+TEST_CASE("run_pipelined_batch: a shared resource takes turns, a failure skips the rest",
+          "[reprocess-batch]") {
+    const auto entries = make_cluster_entries(4);
+    std::atomic<int> running{0}, peak{0};
+    std::atomic<int> second_stage_runs{0};
+    auto work = [&](bool first) {
+        return [&, first](const BatchEntry& e, StopToken&) {
+            const int now = ++running;
+            int p = peak.load();
+            while (now > p && !peak.compare_exchange_weak(p, now)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            --running;
+            if (!first) ++second_stage_runs;
+            Outcome o;
+            o.kind = Outcome::Kind::Ok;
+            if (first && e.timestamp == entries[1].timestamp) {
+                o.kind = Outcome::Kind::Failed;
+                o.error_message = "no speech";
+            }
+            return o;
+        };
+    };
+    std::vector<BatchStage> stages = {
+        {"transcribe", BATCH_RESOURCE_CPU, work(true)},
+        {"diarize", BATCH_RESOURCE_CPU, work(false)},
+    };
+    test_hooks::reset_batch_stop_requested();
+    auto outcomes = run_pipelined_batch(pointers_to(entries), stages);
+
+    REQUIRE(outcomes.size() == 4);
+    CHECK(peak.load() == 1);
+    CHECK(second_stage_runs.load() == 3);
+    CHECK(outcomes[1].kind == Outcome::Kind::Failed);
+    CHECK(outcomes[1].error_message == "no speech");
+    CHECK(outcomes[0].kind == Outcome::Kind::Ok);
+    CHECK(outcomes[3].kind == Outcome::Kind::Ok);
+}
+
+// --refresh — a note is redone only when its manifest's inputs differ from
+// the current config's, and only while nobody has edited it.
+
+TEST_CASE("classify_batch_entries: --refresh follows the meeting manifest",
+          "[reprocess-batch]") {
+    auto scratch = make_scratch_dir("refresh");
+    fs::path parent = scratch / "meetings";
+    fs::path note_dir = scratch / "notes";
+    const std::string ts = "2026-07-01_10-00";
+    fs::path dir = make_meeting_dir(parent, ts, /*with_audio=*/true);
+    fs::path note = make_note(note_dir, ts);
+
+    Config cfg;
+    cfg.note_dir = note_dir;
+    cfg.speaker_id = false;
+    cfg.no_summary = true;
+    cfg.reprocess_batch_refresh = true;
+
+    // No manifest (a note from before manifests): left alone.
+    auto entries = classify_batch_entries(parent, cfg);
+    REQUIRE(entries.size() == 1);
+    CHECK(entries[0].kind == BatchEntryKind::SkipNoteExists);
+
+    // Written under the current config: up to date. The recorded stat
+    // matches, so the recording is not hashed again.
+    const fs::path audio = dir / ("audio_" + ts + ".wav");
+    MeetingManifest m = expected_meeting_manifest(cfg, dir, "0123456789abcdef");
+    REQUIRE(stat_manifest_audio(audio, m.audio_bytes, m.audio_mtime));
+    m.note_path = note;
+    m.note_hash = hash_file(note);
+    save_meeting_manifest(meeting_manifest_path(audio), m);
+    CHECK(classify_batch_entries(parent, cfg)[0].kind == BatchEntryKind::SkipNoteExists);
+
+    // A new whisper model changes the transcript key.
+    cfg.whisper_model = cfg.whisper_model == "base" ? "small" : "base";
+    CHECK(classify_batch_entries(parent, cfg)[0].kind == BatchEntryKind::WillRefresh);
+
+    // Without --refresh an existing note is never redone.
+    cfg.reprocess_batch_refresh = false;
+    CHECK(classify_batch_entries(parent, cfg)[0].kind == BatchEntryKind::SkipNoteExists);
+
+    // A note edited since it was written is kept.
+    cfg.reprocess_batch_refresh = true;
+    std::ofstream(note, std::ios::app) << "my own notes\n";
+    CHECK(classify_batch_entries(parent, cfg)[0].kind == BatchEntryKind::SkipNoteEdited);
+
+    CHECK(batch_entry_runs(BatchEntryKind::WillRefresh));
+    CHECK_FALSE(batch_entry_runs(BatchEntryKind::SkipNoteEdited));
+    fs::remove_all(scratch);
+}
+
+TEST_CASE("should_release_resident_models: worker limit and memory ceiling",
+          "[reprocess_batch]") {
+    constexpr uint64_t MB = 1ull << 20;
+    PpFootprint next;
+    next.bytes = 3000 * MB;
+    next.model_bytes = 2000 * MB;  // already resident: only 1000 MB more
+
+    // Under both limits: keep the models.
+    CHECK_FALSE(should_release_resident_models(4000 * MB, 6144 * MB, next, 8000 * MB));
+    // Past postprocess.worker_rss_mb, as a warm worker would be replaced.
+    CHECK(should_release_resident_models(6200 * MB, 6144 * MB, next, 16000 * MB));
+    // The next meeting's working set would not fit the ceiling.
+    CHECK(should_release_resident_models(4000 * MB, 6144 * MB, next, 4500 * MB));
+    // Unknown RSS or limits are not acted on.
+    CHECK_FALSE(should_release_resident_models(0, 1 * MB, next, 1 * MB));
+    CHECK_FALSE(should_release_resident_models(9000 * MB, 0, next, 0));
+}
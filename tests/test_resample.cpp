@@ -0,0 +1,106 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "resample.h"
+
+#include <cmath>
+#include <memory>
+
+using namespace recmeet;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+std::vector<float> tone(int rate, double hz, double seconds, double amp = 0.5) {
+    std::vector<float> v(static_cast<std::size_t>(rate * seconds));
+    for (std::size_t i = 0; i < v.size(); ++i)
+        v[i] = static_cast<float>(amp * std::sin(2.0 * M_PI * hz * i / rate));
+    return v;
+}
+
+std::vector<float> resample_all(const std::vector<float>& in, int rate) {
+    ResampledSampleSource src(std::make_unique<MemorySampleSource>(in), rate);
+    return src.to_float();
+}
+
+double rms(const float* p, std::size_t n) {
+    double sum = 0;
+    for (std::size_t i = 0; i < n; ++i) sum += static_cast<double>(p[i]) * p[i];
+    return std::sqrt(sum / n);
+}
+
+} // namespace
+
+TEST_CASE("PolyphaseResampler: ratios and output lengths", "[resample]") {
+    PolyphaseResampler cd(44100, SAMPLE_RATE);
+    CHECK(cd.up() == 160);
+    CHECK(cd.down() == 441);
+    CHECK(cd.output_length(44100) == 16000);
+    CHECK(cd.output_length(1) == 1);
+
+    PolyphaseResampler dvd(48000, SAMPLE_RATE);
+    CHECK(dvd.up() == 1);
+    CHECK(dvd.down() == 3);
+    CHECK(dvd.output_length(48001) == 16001);
+    CHECK(dvd.taps() % 2 == 0);
+
+    PolyphaseResampler phone(8000, SAMPLE_RATE);
+    CHECK(phone.up() == 2);
+    CHECK(phone.output_length(8000) == 16000);
+
+    CHECK_THROWS_AS(PolyphaseResampler(0, SAMPLE_RATE), RecmeetError);
+}
+
+TEST_CASE("PolyphaseResampler: tones in band survive, alias band is removed", "[resample]") {
+    for (int rate : {44100, 48000, 22050, 8000}) {
+        INFO("rate " << rate);
+        const auto out = resample_all(tone(rate, 1000, 1.0), rate);
+        REQUIRE(out.size() == SAMPLE_RATE);
+        // Away from the edges, the ideal 16 kHz tone.
+        double worst = 0;
+        for (std::size_t i = 1000; i < out.size() - 1000; ++i) {
+            const double want = 0.5 * std::sin(2.0 * M_PI * 1000 * i / SAMPLE_RATE);
+            worst = std::max(worst, std::fabs(out[i] - want));
+        }
+        CHECK(worst < 2e-3);
+    }
+
+    // 12 kHz is above the 8 kHz output Nyquist: it must not fold to 4 kHz.
+    const auto aliased = resample_all(tone(48000, 12000, 1.0), 48000);
+    CHECK(rms(aliased.data() + 1000, aliased.size() - 2000) < 1e-3);
+}
+
+TEST_CASE("PolyphaseResampler: DC passes at unity gain", "[resample]") {
+    const std::vector<float> dc(22050, 0.25f);
+    const auto out = resample_all(dc, 22050);
+    REQUIRE(out.size() == SAMPLE_RATE);
+    for (std::size_t i = 200; i < out.size() - 200; i += 97)
+        CHECK_THAT(out[i], WithinAbs(0.25, 1e-5));
+}
+
+TEST_CASE("ResampleStream matches ResampledSampleSource bit for bit", "[resample]") {
+    std::vector<float> in = tone(44100, 440, 3.3, 0.3);
+    for (std::size_t i = 0; i < in.size(); ++i)
+        in[i] += static_cast<float>(0.1 * std::sin(0.37 * i * i));  // broadband
+    const PolyphaseResampler r(44100, SAMPLE_RATE);
+
+    std::vector<float> streamed;
+    ResampleStream stream(r);
+    for (std::size_t at = 0, step = 1; at < in.size(); at += step, step = step * 3 % 4409 + 1)
+        stream.push(in.data() + at, std::min(step, in.size() - at), streamed);
+    stream.finish(streamed);
+
+    ResampledSampleSource src(std::make_unique<MemorySampleSource>(in.data(), in.size()), 44100);
+    REQUIRE(src.size() == r.output_length(in.size()));
+    REQUIRE(streamed.size() == src.size());
+    CHECK(src.to_float() == streamed);
+
+    // Any window reads what the whole-file conversion has there.
+    const auto window = src.window(12345, 777);
+    CHECK(std::equal(window.begin(), window.end(), streamed.begin() + 12345));
+    const auto tail = src.window(src.size() - 5, 100);
+    CHECK(tail.size() == 5);
+    CHECK(std::equal(tail.begin(), tail.end(), streamed.end() - 5));
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "rolling_summary.h"
+#include "test_tmpdir.h"
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+using namespace recmeet;
+
+namespace {
+
+fs::path tmp_dir() {
+    fs::path dir = recmeet::test::tmp_path("recmeet_rolling_summary");
+    fs::create_directories(dir);
+    return dir;
+}
+
+const LiveTranscriptKey kKey{"base", "en", ""};
+
+LiveWindow make_window(size_t start, std::vector<TranscriptSegment> segs) {
+    LiveWindow w;
+    w.window.pieces.push_back({start, 16000, 0});
+    w.window.length = 16000;
+    w.segments = std::move(segs);
+    w.language = "en";
+    return w;
+}
+
+} // namespace
+
+TEST_CASE("rolling_summary_path: sits next to the audio", "[rolling_summary]") {
+    CHECK(rolling_summary_path("/m/audio_2026-05-18_09-36.wav") ==
+          fs::path("/m/rolling_2026-05-18_09-36.json"));
+    CHECK(rolling_summary_path("/m/audio.flac") == fs::path("/m/rolling_audio.json"));
+}
+
+TEST_CASE("rolling summary: file round-trips; empty or foreign files are ignored",
+          "[rolling_summary]") {
+    auto dir = tmp_dir();
+    fs::path p = dir / "rolling.json";
+
+    save_rolling_summary(p, {12, 734.25, "### Key Points\n- \"Budget\" approved\n"});
+    RollingSummary got;
+    REQUIRE(load_rolling_summary(p, got));
+    CHECK(got.windows == 12);
+    CHECK(got.covered_sec == 734.25);
+    CHECK(got.notes == "### Key Points\n- \"Budget\" approved\n");
+    CHECK_FALSE(fs::exists(dir / "rolling.json.tmp"));
+
+    save_rolling_summary(p, {3, 10.0, ""});
+    CHECK_FALSE(load_rolling_summary(p, got));
+    std::ofstream(p, std::ios::trunc) << "{\"version\":99,\"notes\":\"x\"}\n";
+    CHECK_FALSE(load_rolling_summary(p, got));
+    std::ofstream(p, std::ios::trunc) << "{\"version\":1,\"notes\":";
+    CHECK_FALSE(load_rolling_summary(p, got));
+    CHECK_FALSE(load_rolling_summary(dir / "missing.json", got));
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("transcript_after: keeps the segments a rolling summary does not cover",
+          "[rolling_summary]") {
+    TranscriptResult r{};
+    r.segments = {{1.0, 4.5, " early"}, {4.5, 9.0, " edge"}, {70.0, 75.0, " late"}};
+    CHECK(transcript_after(r, 0.0) == r.to_string());
+    CHECK(transcript_after(r, 4.5) == "[00:04 - 00:09]  edge\n[01:10 - 01:15]  late\n");
+    CHECK(transcript_after(r, 100.0).empty());
+
+    std::vector<LiveWindow> live = {make_window(0, {{1.0, 4.5, " early"}}),
+                                    make_window(16000, {}),
+                                    make_window(32000, {{4.5, 9.0, " edge"}})};
+    CHECK(format_live_windows(live, 1, 3) == "[00:04 - 00:09]  edge\n");
+    CHECK(format_live_windows(live, 0, 9) == "[00:01 - 00:04]  early\n[00:04 - 00:09]  edge\n");
+}
+
+TEST_CASE("RollingSummarizer: folds new live windows into the notes", "[rolling_summary]") {
+    auto dir = tmp_dir();
+    const fs::path live_path = dir / "live.ndjson";
+    const fs::path path = dir / "rolling.json";
+    begin_live_transcript(live_path, kKey);
+    append_live_window(live_path, make_window(0, {{0.5, 3.0, " We ship Friday."}}));
+    save_rolling_summary(path, {99, 9999.0, "left by an earlier recording"});
+
+    std::mutex mu;
+    std::vector<std::string> prompts;
+    auto complete = [&](const std::string& prompt, const SummaryDeltaCallback& on_delta) {
+        CHECK_FALSE(on_delta);
+        std::lock_guard<std::mutex> lock(mu);
+        prompts.push_back(prompt);
+        return "notes " + std::to_string(prompts.size());
+    };
+
+    RollingSummarizer::Options opts;
+    opts.key = kKey;
+    opts.interval_sec = 1;
+    RollingSummarizer rolling(live_path, path, complete, opts);
+    CHECK_FALSE(fs::exists(path));
+
+    auto wait_steps = [&](size_t n) {
+        for (int i = 0; i < 50 && rolling.steps_done() < n; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return rolling.steps_done() >= n;
+    };
+    REQUIRE(wait_steps(1));
+    RollingSummary got;
+    REQUIRE(load_rolling_summary(path, got));
+    CHECK(got.windows == 1);
+    CHECK(got.covered_sec == 3.0);
+    CHECK(got.notes == "notes 1");
+
+    append_live_window(live_path, make_window(16000, {{4.0, 6.5, " Bob owns the demo."}}));
+    REQUIRE(wait_steps(2));
+    CHECK(rolling.stop() == 2);
+    CHECK(rolling.stop() == 2);
+
+    REQUIRE(load_rolling_summary(path, got));
+    CHECK(got.windows == 2);
+    CHECK(got.covered_sec == 6.5);
+    CHECK(got.notes == "notes 2");
+    std::lock_guard<std::mutex> lock(mu);
+    REQUIRE(prompts.size() == 2);
+    CHECK(prompts[0].find("We ship Friday.") != std::string::npos);
+    // The second step sends the notes so far and only the new windows.
+    CHECK(prompts[1].find("notes 1") != std::string::npos);
+    CHECK(prompts[1].find("Bob owns the demo.") != std::string::npos);
+    CHECK(prompts[1].find("We ship Friday.") == std::string::npos);
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,257 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "sample_kernels.h"
+#include "audio_mixer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace recmeet;
+
+namespace {
+
+std::vector<const SampleKernels*> available_variants() {
+    std::vector<const SampleKernels*> out;
+    for (KernelIsa isa : {KernelIsa::Scalar, KernelIsa::Sse42,
+                          KernelIsa::Avx2, KernelIsa::Neon}) {
+        if (const SampleKernels* k = sample_kernels_variant(isa))
+            out.push_back(k);
+    }
+    return out;
+}
+
+// Random int16 input seeded with the rails so saturation paths are hit.
+std::vector<int16_t> random_s16(std::size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(-32768, 32767);
+    std::vector<int16_t> v(n);
+    for (auto& s : v) s = static_cast<int16_t>(dist(rng));
+    if (n >= 4) {
+        v[0] = 32767;
+        v[1] = -32768;
+        v[2] = -1;
+        v[3] = 1;
+    }
+    return v;
+}
+
+// Odd length so every SIMD variant also runs its scalar tail.
+constexpr std::size_t N = 1000 + 13;
+
+} // namespace
+
+TEST_CASE("sample kernels: scalar variant is always available", "[sample_kernels]") {
+    const SampleKernels* k = sample_kernels_variant(KernelIsa::Scalar);
+    REQUIRE(k != nullptr);
+    CHECK(std::string(k->name) == "scalar");
+    CHECK(sample_kernels().name != nullptr);
+}
+
+TEST_CASE("sample kernels: mix_avg_s16 matches mix_audio's averaging rule", "[sample_kernels]") {
+    auto a = random_s16(N, 1);
+    auto b = random_s16(N, 2);
+    b[0] = 32767;   // max + max
+    b[1] = -32768;  // min + min
+    b[2] = 0;       // -1 / 2 -> 0 (truncation toward zero)
+    b[3] = 0;
+
+    std::vector<int16_t> expected(N);
+    for (std::size_t i = 0; i < N; ++i)
+        expected[i] = static_cast<int16_t>((int32_t(a[i]) + int32_t(b[i])) / 2);
+
+    for (const SampleKernels* k : available_variants()) {
+        INFO("variant " << k->name);
+        std::vector<int16_t> out(N);
+        k->mix_avg_s16(a.data(), b.data(), out.data(), N);
+        CHECK(out == expected);
+    }
+}
+
+TEST_CASE("sample kernels: add_sat_s16 saturates at the int16 rails", "[sample_kernels]") {
+    auto a = random_s16(N, 3);
+    auto b = random_s16(N, 4);
+
+    std::vector<int16_t> expected(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        int32_t s = int32_t(a[i]) + int32_t(b[i]);
+        expected[i] = static_cast<int16_t>(s > 32767 ? 32767 : (s < -32768 ? -32768 : s));
+    }
+
+    for (const SampleKernels* k : available_variants()) {
+        INFO("variant " << k->name);
+        std::vector<int16_t> out(N);
+        k->add_sat_s16(a.data(), b.data(), out.data(), N);
+        CHECK(out == expected);
+    }
+}
+
+TEST_CASE("sample kernels: s16_to_f32 is exact x/32768", "[sample_kernels]") {
+    auto in = random_s16(N, 5);
+    for (const SampleKernels* k : available_variants()) {
+        INFO("variant " << k->name);
+        std::vector<float> out(N);
+        k->s16_to_f32(in.data(), out.data(), N);
+        bool exact = true;
+        for (std::size_t i = 0; i < N; ++i)
+            if (out[i] != static_cast<float>(in[i]) / 32768.0f) { exact = false; break; }
+        CHECK(exact);
+    }
+}
+
+TEST_CASE("sample kernels: f32_to_s16 rounds half-even and clamps", "[sample_kernels]") {
+    std::mt19937 rng(6);
+    std::uniform_real_distribution<float> dist(-1.2f, 1.2f);
+    std::vector<float> in(N);
+    for (auto& x : in) x = dist(rng);
+    in[0] = 1.0f;                       // clamps to 32767
+    in[1] = -1.0f;                      // exactly -32768
+    in[2] = 0.5f / 32768.0f;            // 0.5 -> 0 (half to even)
+    in[3] = 1.5f / 32768.0f;            // 1.5 -> 2
+    in[4] = 1e9f;                       // far out of range
+    in[5] = -1e9f;
+
+    auto* scalar = sample_kernels_variant(KernelIsa::Scalar);
+    std::vector<int16_t> expected(N);
+    scalar->f32_to_s16(in.data(), expected.data(), N);
+    CHECK(expected[0] == 32767);
+    CHECK(expected[1] == -32768);
+    CHECK(expected[2] == 0);
+    CHECK(expected[3] == 2);
+    CHECK(expected[4] == 32767);
+    CHECK(expected[5] == -32768);
+
+    for (const SampleKernels* k : available_variants()) {
+        INFO("variant " << k->name);
+        std::vector<int16_t> out(N);
+        k->f32_to_s16(in.data(), out.data(), N);
+        CHECK(out == expected);
+    }
+}
+
+TEST_CASE("sample kernels: dot_f32 is bit-exact across variants", "[sample_kernels]") {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> a(N), b(N);
+    for (auto& x : a) x = dist(rng);
+    for (auto& x : b) x = dist(rng) * 1e3f;
+
+    // The documented lane layout, spelled out.
+    double l[4] = {0.0, 0.0, 0.0, 0.0};
+    const std::size_t body = N - N % 4;
+    for (std::size_t i = 0; i < body; ++i)
+        l[i % 4] += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+    double expected = (l[0] + l[1]) + (l[2] + l[3]);
+    for (std::size_t i = body; i < N; ++i)
+        expected += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+
+    for (const SampleKernels* k : available_variants()) {
+        INFO("variant " << k->name);
+        for (std::size_t n : {std::size_t(0), std::size_t(3), std::size_t(4), N}) {
+            INFO("n = " << n);
+            double ref = sample_kernels_variant(KernelIsa::Scalar)->dot_f32(a.data(), b.data(), n);
+            CHECK(k->dot_f32(a.data(), b.data(), n) == ref);
+        }
+        CHECK(k->dot_f32(a.data(), b.data(), N) == expected);
+    }
+}
+
+TEST_CASE("sample kernels: energy_s16 sums squares exactly and finds the peak",
+          "[sample_kernels]") {
+    auto in = random_s16(N, 8);
+    uint64_t expected_sum = 0;
+    uint32_t expected_peak = 0;
+    for (int16_t s : in) {
+        expected_sum += static_cast<uint64_t>(int64_t{s} * s);
+        expected_peak = std::max<uint32_t>(expected_peak, static_cast<uint32_t>(std::abs(int{s})));
+    }
+    REQUIRE(expected_peak == 32768);
+    // All at the negative rail: every pmaddwd lane is 2^31.
+    std::vector<int16_t> rail(64, -32768);
+
+    for (const SampleKernels* k : available_variants()) {
+        INFO("variant " << k->name);
+        uint64_t sum = 1;
+        uint32_t peak = 1;
+        k->energy_s16(in.data(), N, &sum, &peak);
+        CHECK(sum == expected_sum);
+        CHECK(peak == expected_peak);
+        k->energy_s16(in.data() + 4, 3, &sum, &peak);
+        CHECK(sum == static_cast<uint64_t>(int64_t{in[4]} * in[4] + int64_t{in[5]} * in[5] +
+                                           int64_t{in[6]} * in[6]));
+        k->energy_s16(rail.data(), rail.size(), &sum, &peak);
+        CHECK(sum == 64ull * 32768 * 32768);
+        CHECK(peak == 32768);
+        k->energy_s16(rail.data(), 0, &sum, &peak);
+        CHECK(sum == 0);
+        CHECK(peak == 0);
+    }
+}
+
+TEST_CASE("sample kernels: dot_s8 is exact across variants", "[sample_kernels]") {
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> dist(-128, 127);
+    std::vector<int8_t> a(N), b(N);
+    for (auto& x : a) x = static_cast<int8_t>(dist(rng));
+    for (auto& x : b) x = static_cast<int8_t>(dist(rng));
+    a[0] = b[0] = -128;  // the one product pmaddwd pairs can push to 2^15
+    a[1] = b[1] = -128;
+    int32_t expected = 0;
+    for (std::size_t i = 0; i < N; ++i) expected += int32_t{a[i]} * b[i];
+
+    for (const SampleKernels* k : available_variants()) {
+        INFO("variant " << k->name);
+        CHECK(k->dot_s8(a.data(), b.data(), N) == expected);
+        CHECK(k->dot_s8(a.data(), b.data(), 0) == 0);
+        CHECK(k->dot_s8(a.data() + 2, b.data() + 2, 7) ==
+              sample_kernels_variant(KernelIsa::Scalar)->dot_s8(a.data() + 2, b.data() + 2, 7));
+    }
+}
+
+TEST_CASE("sample kernels: f16_to_f32 converts every half exactly", "[sample_kernels]") {
+    std::vector<uint16_t> halves(65536);
+    for (std::size_t i = 0; i < halves.size(); ++i) halves[i] = static_cast<uint16_t>(i);
+    std::vector<float> expected(halves.size());
+    sample_kernels_variant(KernelIsa::Scalar)->f16_to_f32(halves.data(), expected.data(),
+                                                          halves.size());
+    CHECK(expected[0x3c00] == 1.0f);
+    CHECK(expected[0xc000] == -2.0f);
+    CHECK(expected[0x7bff] == 65504.0f);
+    CHECK(expected[0x0001] == std::ldexp(1.0f, -24));  // smallest subnormal
+    CHECK(expected[0x03ff] == std::ldexp(1023.0f, -24));
+    CHECK(std::isinf(expected[0x7c00]));
+    CHECK(std::isnan(expected[0x7e00]));
+
+    for (const SampleKernels* k : available_variants()) {
+        INFO("variant " << k->name);
+        std::vector<float> out(halves.size() - 3);  // leave a tail
+        k->f16_to_f32(halves.data(), out.data(), out.size());
+        std::size_t mismatches = 0;
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            if (std::isnan(expected[i]) ? !std::isnan(out[i])
+                                        : std::memcmp(&out[i], &expected[i], sizeof(float)) != 0)
+                ++mismatches;
+        }
+        CHECK(mismatches == 0);
+    }
+}
+
+TEST_CASE("sample kernels: zero-length calls are no-ops", "[sample_kernels]") {
+    int16_t s16 = 7;
+    float f32 = 7.0f;
+    for (const SampleKernels* k : available_variants()) {
+        INFO("variant " << k->name);
+        k->mix_avg_s16(&s16, &s16, &s16, 0);
+        k->add_sat_s16(&s16, &s16, &s16, 0);
+        k->s16_to_f32(&s16, &f32, 0);
+        k->f32_to_s16(&f32, &s16, 0);
+        CHECK(s16 == 7);
+        CHECK(f32 == 7.0f);
+    }
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "sample_ring.h"
+
+#include <thread>
+#include <vector>
+
+using namespace recmeet;
+
+TEST_CASE("SampleRing: capacity rounds up to a power of two", "[sample_ring]") {
+    CHECK(SampleRing(1).capacity() == 2);
+    CHECK(SampleRing(16).capacity() == 16);
+    CHECK(SampleRing(17).capacity() == 32);
+    CHECK(SampleRing(16000 * 8).capacity() == 131072);
+}
+
+TEST_CASE("SampleRing: push/pop preserves order across the wrap point", "[sample_ring]") {
+    SampleRing ring(8);
+    std::vector<int16_t> out(8);
+
+    int16_t a[] = {1, 2, 3, 4, 5, 6};
+    REQUIRE(ring.push(a, 6) == 6);
+    REQUIRE(ring.pop(out.data(), 4) == 4);
+    CHECK(out[0] == 1);
+    CHECK(out[3] == 4);
+
+    // Head is at 6, tail at 4: this push wraps.
+    int16_t b[] = {7, 8, 9, 10, 11};
+    REQUIRE(ring.push(b, 5) == 5);
+    CHECK(ring.size() == 7);
+
+    REQUIRE(ring.pop(out.data(), 8) == 7);
+    std::vector<int16_t> expected = {5, 6, 7, 8, 9, 10, 11};
+    out.resize(7);
+    CHECK(out == expected);
+    CHECK(ring.size() == 0);
+}
+
+TEST_CASE("SampleRing: full ring rejects incoming samples", "[sample_ring]") {
+    SampleRing ring(4);
+    int16_t a[] = {1, 2, 3};
+    int16_t b[] = {4, 5, 6};
+    CHECK(ring.push(a, 3) == 3);
+    CHECK(ring.push(b, 3) == 1);  // only one slot left
+    CHECK(ring.push(b, 3) == 0);
+
+    int16_t out[4] = {};
+    REQUIRE(ring.pop(out, 4) == 4);
+    CHECK(out[0] == 1);
+    CHECK(out[3] == 4);  // oldest data kept, overflow dropped
+}
+
+TEST_CASE("SampleRing: pop on empty ring returns zero", "[sample_ring]") {
+    SampleRing ring(4);
+    int16_t out[4];
+    CHECK(ring.pop(out, 4) == 0);
+}
+
+TEST_CASE("SampleRing: concurrent producer/consumer delivers every sample in order",
+          "[sample_ring]") {
+    SampleRing ring(256);
+    constexpr int TOTAL = 200000;
+
+    std::thread producer([&] {
+        int16_t chunk[37];
+        int next = 0;
+        while (next < TOTAL) {
+            int n = std::min(37, TOTAL - next);
+            for (int i = 0; i < n; ++i) chunk[i] = static_cast<int16_t>(next + i);
+            std::size_t off = 0;
+            while (off < static_cast<std::size_t>(n))
+                off += ring.push(chunk + off, n - off);
+            next += n;
+        }
+    });
+
+    std::vector<int16_t> got;
+    got.reserve(TOTAL);
+    int16_t buf[64];
+    while (got.size() < static_cast<std::size_t>(TOTAL)) {
+        std::size_t n = ring.pop(buf, 64);
+        got.insert(got.end(), buf, buf + n);
+    }
+    producer.join();
+
+    bool in_order = true;
+    for (int i = 0; i < TOTAL; ++i)
+        if (got[i] != static_cast<int16_t>(i)) { in_order = false; break; }
+    CHECK(in_order);
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "sample_source.h"
+#include "audio_spool.h"
+#include "test_tmpdir.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace recmeet;
+
+namespace {
+
+fs::path tmp_dir() {
+    fs::path dir = recmeet::test::tmp_path("recmeet_sample_source");
+    fs::create_directories(dir);
+    return dir;
+}
+
+} // namespace
+
+TEST_CASE("MemorySampleSource: borrowed buffer is viewed without copying", "[sample_source]") {
+    std::vector<float> buf{0.1f, 0.2f, 0.3f, 0.4f};
+    MemorySampleSource src(buf.data(), buf.size());
+    CHECK(src.size() == 4);
+    CHECK(src.data() == buf.data());
+
+    std::vector<float> scratch;
+    std::size_t n = 0;
+    const float* p = src.view(1, 10, scratch, n);
+    CHECK(p == buf.data() + 1);
+    CHECK(n == 3);
+    CHECK(scratch.empty());
+
+    src.view(4, 10, scratch, n);
+    CHECK(n == 0);
+    CHECK(src.window(2, 1) == std::vector<float>{0.3f});
+}
+
+TEST_CASE("MemorySampleSource: owns a moved-in vector", "[sample_source]") {
+    MemorySampleSource src(std::vector<float>{1.0f, -1.0f});
+    CHECK(src.size() == 2);
+    CHECK(src.to_float() == std::vector<float>{1.0f, -1.0f});
+    CHECK(src.duration_seconds() == 2.0 / SAMPLE_RATE);
+}
+
+TEST_CASE("SpoolSampleSource: reads a spool while it is still recording", "[sample_source]") {
+    auto dir = tmp_dir();
+    AudioSpool spool(dir / "live.wav", 160);
+    SpoolSampleSource src(spool);
+    CHECK(src.size() == 0);
+
+    std::vector<int16_t> pcm(1600);
+    for (std::size_t i = 0; i < pcm.size(); ++i)
+        pcm[i] = static_cast<int16_t>(i * 16 - 12800);
+    spool.append(pcm.data(), pcm.size());
+
+    // The writer thread flushes full blocks on its own timer.
+    for (int i = 0; i < 100 && src.size() < pcm.size(); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    REQUIRE(src.size() == pcm.size());
+
+    // Reads are not zero-copy: view() goes through the scratch buffer.
+    std::vector<float> scratch;
+    std::size_t n = 0;
+    const float* p = src.view(100, 500, scratch, n);
+    REQUIRE(n == 500);
+    CHECK(p == scratch.data());
+    bool exact = true;
+    for (std::size_t i = 0; i < n; ++i)
+        if (p[i] != pcm[100 + i] / 32768.0f) { exact = false; break; }
+    CHECK(exact);
+
+    spool.finish();
+    CHECK(src.window(0, pcm.size() * 2).size() == pcm.size());
+    fs::remove_all(dir);
+}
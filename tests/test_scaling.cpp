@@ -0,0 +1,321 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+//
+// Memory and time scaling against meeting length.
+//
+// `[long_fixture]` cases check the synthetic-meeting generator
+// (long_fixture.h) on a generated source; they need nothing installed.
+//
+// `[benchmark][scaling][slow]` runs the post-processing pipeline (VAD,
+// transcription, chunked diarization, note) on synthetic meetings of each
+// length in RECMEET_SCALING_HOURS (default "1,2,4"), built from the debate
+// audio, and records each stage's wall time and peak RSS
+// (PipelineResult::stages) into build/benchmark_results.json. It then
+// checks the curve measured, not an extrapolation of it:
+//   - peak RSS grows by at most RECMEET_SCALING_RSS_MB_PER_HOUR (default
+//     768) per extra hour of audio — the float copy of the audio is 230 MB
+//     an hour; chunked diarization itself should not grow at all;
+//   - no run of up to 4 hours peaks above 16 GB;
+//   - the whole run's real-time factor at the longest length is at most
+//     1.5x that at the shortest.
+// Lengths run shortest first: the kernel's high-water mark (VmHWM) is not
+// reset between runs, and a longer run raises it past the shorter ones.
+//
+//   make scaling    # under systemd-run, MemoryMax=16G, no swap
+//
+// RECMEET_SCALING_MODEL picks the whisper model (default "base").
+
+#include <catch2/catch_test_macros.hpp>
+#include "long_fixture.h"
+#include "test_helpers.h"
+#include "test_progress_phase.h"
+#include "test_tmpdir.h"
+#include "audio_file.h"
+#include "config.h"
+#include "model_manager.h"
+#include "pipeline.h"
+#include "util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace recmeet;
+using namespace recmeet::test_helpers;
+
+namespace {
+
+/// Two minutes of a stand-in source: bursts of tone-modulated noise
+/// (0.8-6 s) separated by 0.4-1.5 s of silence.
+std::vector<float> make_source() {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-0.3f, 0.3f), len(0.8f, 6.0f), gap(0.4f, 1.5f);
+    std::vector<float> out;
+    while (out.size() < 120u * SAMPLE_RATE) {
+        const size_t n = static_cast<size_t>(len(rng) * SAMPLE_RATE);
+        for (size_t i = 0; i < n; ++i)
+            out.push_back(noise(rng) * static_cast<float>(0.5 + 0.5 * std::sin(i * 0.002)));
+        out.insert(out.end(), static_cast<size_t>(gap(rng) * SAMPLE_RATE), 0.0f);
+    }
+    return out;
+}
+
+LongFixture generate_into(const std::vector<float>& source, const LongFixtureSpec& spec,
+                          std::vector<float>& out) {
+    out.clear();
+    return generate_long_fixture(source, spec, [&](const float* s, size_t n) {
+        out.insert(out.end(), s, s + n);
+    });
+}
+
+} // anonymous namespace
+
+TEST_CASE("split_utterances: finds the bursts of speech in the source", "[long_fixture]") {
+    const auto source = make_source();
+    const auto utts = split_utterances(source);
+    REQUIRE(!utts.empty());
+    for (const auto& [b, e] : utts) {
+        CHECK(e > b);
+        CHECK(e - b >= SAMPLE_RATE * 8 / 10);
+        CHECK(e - b <= 12u * SAMPLE_RATE);
+        CHECK(e <= source.size());
+    }
+    CHECK(split_utterances(std::vector<float>(10 * SAMPLE_RATE, 0.0f)).empty());
+}
+
+TEST_CASE("generate_long_fixture: exact length, streamed, deterministic", "[long_fixture]") {
+    const auto source = make_source();
+    LongFixtureSpec spec;
+    spec.seconds = 600;
+    spec.speakers = 5;
+    spec.pause_every_sec = 120;
+
+    std::vector<float> a, b;
+    size_t max_block = 0;
+    const auto fx = generate_long_fixture(source, spec, [&](const float* s, size_t n) {
+        max_block = std::max(max_block, n);
+        a.insert(a.end(), s, s + n);
+    });
+    CHECK(fx.samples == 600u * SAMPLE_RATE);
+    CHECK(a.size() == fx.samples);
+    CHECK(max_block <= static_cast<size_t>(SAMPLE_RATE));
+    CHECK(std::all_of(a.begin(), a.end(), [](float x) { return x >= -1.0f && x <= 1.0f; }));
+
+    generate_into(source, spec, b);
+    CHECK(a == b);
+    spec.seed = 2;
+    generate_into(source, spec, b);
+    CHECK(a != b);
+
+    std::set<int> speakers;
+    double last_start = -1;
+    for (const auto& t : fx.turns) {
+        speakers.insert(t.speaker);
+        CHECK(t.start > last_start);
+        CHECK(t.end > t.start);
+        CHECK(t.end <= spec.seconds);
+        last_start = t.start;
+    }
+    CHECK(speakers.size() == 5);
+    for (size_t i = 1; i < fx.turns.size(); ++i)
+        CHECK(fx.turns[i].speaker != fx.turns[i - 1].speaker);
+}
+
+TEST_CASE("generate_long_fixture: overlap and silence follow the spec", "[long_fixture]") {
+    const auto source = make_source();
+    std::vector<float> pcm;
+    LongFixtureSpec spec;
+    spec.seconds = 900;
+    spec.pause_every_sec = 0;
+
+    spec.overlap_prob = 0;
+    const auto none = generate_into(source, spec, pcm);
+    CHECK(none.overlap_sec == 0.0);
+
+    spec.overlap_prob = 0.5;
+    const auto half = generate_into(source, spec, pcm);
+    CHECK(half.overlap_sec > 30.0);
+    CHECK(half.silence_sec < none.silence_sec);
+
+    // Long pauses add their length to the silence.
+    spec.overlap_prob = 0;
+    spec.pause_every_sec = 300;
+    spec.pause_sec = 30;
+    const auto paused = generate_into(source, spec, pcm);
+    CHECK(paused.silence_sec > none.silence_sec + 45.0);
+    // The samples inside a pause are silent.
+    bool pause_silent = false;
+    for (size_t i = 1; i < paused.turns.size(); ++i) {
+        const auto& prev = paused.turns[i - 1];
+        const auto& cur = paused.turns[i];
+        if (cur.start - prev.end < 29.0) continue;
+        const auto b = static_cast<size_t>((prev.end + 0.5) * SAMPLE_RATE);
+        const auto e = static_cast<size_t>((cur.start - 0.5) * SAMPLE_RATE);
+        pause_silent = std::all_of(pcm.begin() + static_cast<std::ptrdiff_t>(b),
+                                   pcm.begin() + static_cast<std::ptrdiff_t>(e),
+                                   [](float x) { return x == 0.0f; });
+        break;
+    }
+    CHECK(pause_silent);
+}
+
+TEST_CASE("write_long_fixture_wav: a WAV of the generated samples", "[long_fixture]") {
+    const auto source = make_source();
+    LongFixtureSpec spec;
+    spec.seconds = 90;
+    const auto path = recmeet::test::tmp_path("fixture.wav");
+    const auto fx = write_long_fixture_wav(path, source, spec);
+
+    CHECK(fs::file_size(path) == SPOOL_WAV_HEADER_BYTES + fx.samples * sizeof(int16_t));
+    std::vector<float> expect;
+    generate_into(source, spec, expect);
+    const auto back = read_wav_float(path);
+    REQUIRE(back.size() == expect.size());
+    float worst = 0;
+    for (size_t i = 0; i < back.size(); ++i) worst = std::max(worst, std::fabs(back[i] - expect[i]));
+    CHECK(worst < 1e-3f);
+
+    const auto rttm = fixture_rttm(fx, "fixture");
+    CHECK(rttm.rfind("SPEAKER fixture 1 ", 0) == 0);
+    CHECK(static_cast<size_t>(std::count(rttm.begin(), rttm.end(), '\n')) == fx.turns.size());
+    fs::remove(path);
+}
+
+#if RECMEET_USE_SHERPA
+
+namespace {
+
+struct ScalingRun {
+    double hours = 0;
+    double wall_sec = 0;
+    long peak_kb = 0;
+    std::map<std::string, StagePerf> stages;  // diarize_chunk records folded into one
+};
+
+std::vector<double> scaling_hours() {
+    std::vector<double> out;
+    const char* env = std::getenv("RECMEET_SCALING_HOURS");
+    std::stringstream ss(env && *env ? env : "1,2,4");
+    for (std::string item; std::getline(ss, item, ',');)
+        if (double h = std::atof(item.c_str()); h > 0) out.push_back(h);
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+double env_double(const char* name, double def) {
+    const char* v = std::getenv(name);
+    return v && *v ? std::atof(v) : def;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Post-processing peak RSS and wall time stay bounded from 1 to N hours",
+          "[benchmark][scaling][slow]") {
+    const fs::path root = find_project_root();
+    if (root.empty()) SKIP("Project root with assets/ not found");
+    const fs::path source_path = root / "assets" / "biden_trump_debate_2020.wav";
+    if (!fs::exists(source_path)) SKIP("Source audio not found: " + source_path.string());
+    const char* model_env = std::getenv("RECMEET_SCALING_MODEL");
+    const std::string model = model_env && *model_env ? model_env : "base";
+    if (!is_whisper_model_cached(model))
+        SKIP("Whisper " + model + " model not cached — run: ./build/recmeet --download-models --model " + model);
+    if (!is_sherpa_model_cached())
+        SKIP("Sherpa diarization models not cached — run: ./build/recmeet --download-models");
+
+    const auto hours = scaling_hours();
+    REQUIRE(!hours.empty());
+    const auto source = read_wav_float(source_path);
+    recmeet::test::PhaseEcho echo;
+    std::vector<ScalingRun> runs;
+
+    for (double h : hours) {
+        const auto out_dir = recmeet::test::tmp_path("recmeet_scaling_" + std::to_string(int(h * 60)) + "m");
+        fs::remove_all(out_dir);
+        fs::create_directories(out_dir);
+        const fs::path audio_path = out_dir / "audio_2026-04-30_12-00.wav";
+
+        LongFixtureSpec spec;
+        spec.seconds = h * 3600;
+        spec.speakers = 4;
+        echo("generating " + std::to_string(h) + " h fixture");
+        const auto fx = write_long_fixture_wav(audio_path, source, spec);
+
+        Config cfg;
+        cfg.whisper_model = model;
+        cfg.language = "en";
+        cfg.diarize = true;
+        cfg.num_speakers = 0;
+        cfg.speaker_id = false;
+        cfg.vad = true;
+        cfg.no_summary = true;
+        cfg.stage_cache = false;
+        cfg.output_dir = out_dir;
+        cfg.output_dir_explicit = true;
+        cfg.note_dir = out_dir;
+
+        PostprocessInput input;
+        input.out_dir = out_dir;
+        input.audio_path = audio_path;
+
+        ScalingRun run;
+        run.hours = h;
+        echo("post-processing " + std::to_string(h) + " h");
+        auto [secs, peak_kb] = measure_with_rss([&] {
+            const auto result = run_postprocessing(cfg, input, echo);
+            for (const auto& p : result.stages) {
+                const std::string stage = p.stage;
+                auto [it, fresh] = run.stages.emplace(stage, p);
+                if (!fresh) {
+                    it->second.wall_sec += p.wall_sec;
+                    it->second.peak_rss_kb = std::max(it->second.peak_rss_kb, p.peak_rss_kb);
+                }
+            }
+        });
+        run.wall_sec = secs;
+        run.peak_kb = peak_kb;
+        for (const auto& [name, p] : run.stages) run.peak_kb = std::max(run.peak_kb, p.peak_rss_kb);
+        fprintf(stderr, "\n[benchmark] scaling %.2f h: %.0f s (rtf %.3f), peak RSS %ld MB\n",
+                h, run.wall_sec, run.wall_sec / spec.seconds, run.peak_kb / 1024);
+
+        std::string frag = "\n      \"test\": \"scaling_" + std::to_string(int(h * 60)) + "min\","
+                           "\n      \"model\": \"" + model + "\","
+                           "\n      \"audio_secs\": " + std::to_string(spec.seconds) + ","
+                           "\n      \"speakers\": " + std::to_string(spec.speakers) + ","
+                           "\n      \"turns\": " + std::to_string(fx.turns.size()) + ","
+                           "\n      \"total_secs\": " + std::to_string(run.wall_sec) + ","
+                           "\n      \"rtf\": " + std::to_string(run.wall_sec / spec.seconds) + ","
+                           "\n      \"peak_rss_kb\": " + std::to_string(run.peak_kb);
+        for (const auto& [name, p] : run.stages) {
+            frag += ",\n      \"" + name + "_secs\": " + std::to_string(p.wall_sec);
+            frag += ",\n      \"" + name + "_peak_kb\": " + std::to_string(p.peak_rss_kb);
+            fprintf(stderr, "  %.2f h %s: %.1f s, peak %ld MB\n", h, name.c_str(), p.wall_sec,
+                    p.peak_rss_kb / 1024);
+        }
+        BenchmarkResults::add(frag);
+        runs.push_back(std::move(run));
+        fs::remove_all(out_dir);
+    }
+
+    for (const auto& r : runs)
+        if (r.hours <= 4.0) CHECK(r.peak_kb < 16L * 1024 * 1024);
+    if (runs.size() < 2) return;
+
+    const auto& shortest = runs.front();
+    const auto& longest = runs.back();
+    const double per_hour_mb = double(longest.peak_kb - shortest.peak_kb) / 1024 /
+                               (longest.hours - shortest.hours);
+    INFO("peak RSS growth: " << per_hour_mb << " MB per audio hour");
+    CHECK(per_hour_mb <= env_double("RECMEET_SCALING_RSS_MB_PER_HOUR", 768));
+    const double rtf_short = shortest.wall_sec / (shortest.hours * 3600);
+    const double rtf_long = longest.wall_sec / (longest.hours * 3600);
+    INFO("rtf " << rtf_short << " at " << shortest.hours << " h, " << rtf_long << " at "
+         << longest.hours << " h");
+    CHECK(rtf_long <= 1.5 * rtf_short);
+}
+
+#endif // RECMEET_USE_SHERPA
@@ -0,0 +1,41 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "sha256.h"
+#include "test_tmpdir.h"
+
+#include <fstream>
+
+using namespace recmeet;
+
+TEST_CASE("sha256_hex: FIPS 180-4 test vectors", "[sha256]") {
+    CHECK(sha256_hex("") ==
+          "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    CHECK(sha256_hex("abc") ==
+          "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    CHECK(sha256_hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+          "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    CHECK(sha256_hex(std::string(1000000, 'a')) ==
+          "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST_CASE("Sha256: any split of the input gives the same digest", "[sha256]") {
+    const std::string text(1000, 'x');
+    for (size_t step : {1, 7, 63, 64, 65, 999}) {
+        Sha256 h;
+        for (size_t i = 0; i < text.size(); i += step)
+            h.update(text.data() + i, std::min(step, text.size() - i));
+        CHECK(h.hex_digest() == sha256_hex(text));
+    }
+}
+
+TEST_CASE("sha256_file: hashes the file, throws when it is missing", "[sha256]") {
+    fs::path dir = recmeet::test::tmp_path("recmeet_test_sha256");
+    fs::create_directories(dir);
+    fs::path file = dir / "abc.bin";
+    std::ofstream(file, std::ios::binary) << "abc";
+    CHECK(sha256_file(file) == sha256_hex("abc"));
+    CHECK_THROWS_AS(sha256_file(dir / "missing.bin"), RecmeetError);
+    fs::remove_all(dir);
+}
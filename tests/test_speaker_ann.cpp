@@ -0,0 +1,208 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "embedding_set.h"
+#include "speaker_ann.h"
+#include "speaker_id.h"
+#include "test_tmpdir.h"
+
+#include <cstring>
+#include <fstream>
+#include <random>
+
+using namespace recmeet;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+// `groups` voices of `per_group` rows each, scattered around random unit
+// directions — the shape an enrolled organization has.
+std::vector<std::vector<float>> clustered_rows(size_t groups, size_t per_group, size_t dim,
+                                               unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+    std::vector<std::vector<float>> rows;
+    for (size_t g = 0; g < groups; ++g) {
+        std::vector<float> center(dim);
+        for (auto& x : center) x = gauss(rng);
+        for (size_t i = 0; i < per_group; ++i) {
+            std::vector<float> row = center;
+            for (auto& x : row) x += 0.3f * gauss(rng);
+            rows.push_back(std::move(row));
+        }
+    }
+    return rows;
+}
+
+std::string row_name(size_t i) { return "spk" + std::to_string(i); }
+
+} // namespace
+
+TEST_CASE("SpeakerIvf: hits carry exact cosine scores, best first", "[speaker_ann]") {
+    const auto rows = clustered_rows(30, 20, 32, 7);
+    SpeakerIvf ivf(32);
+    for (size_t i = 0; i < rows.size(); ++i) ivf.upsert(row_name(i), rows[i].data());
+    CHECK(ivf.search(rows[0], 5).empty());  // not trained yet
+
+    ivf.train();
+    REQUIRE(ivf.trained());
+    CHECK(ivf.nlist() == 24);  // ~sqrt(600)
+    CHECK(ivf.nprobe() == 4);
+    CHECK(ivf.trained_rows() == 600);
+
+    size_t found = 0;
+    for (size_t i = 0; i < rows.size(); i += 7) {
+        auto query = rows[i];
+        query[0] += 0.05f;
+        const auto hits = ivf.search(query, 8);
+        REQUIRE_FALSE(hits.empty());
+        for (size_t h = 1; h < hits.size(); ++h) CHECK(hits[h - 1].score >= hits[h].score);
+        const size_t j = std::stoul(hits.front().name.substr(3));
+        CHECK_THAT(hits.front().score, WithinAbs(cosine_similarity(query, rows[j]), 1e-5));
+        if (j == i) ++found;
+    }
+    CHECK(found * 10 >= (rows.size() / 7 + 1) * 9);  // recall well above 90%
+
+    CHECK(ivf.search(std::vector<float>(31, 1.0f), 5).empty());
+    CHECK(ivf.search(std::vector<float>(32, 0.0f), 5).empty());
+}
+
+TEST_CASE("SpeakerIvf: upserts after training are filed, removals forgotten",
+          "[speaker_ann]") {
+    const auto rows = clustered_rows(10, 10, 16, 11);
+    SpeakerIvf ivf(16);
+    for (size_t i = 0; i < rows.size(); ++i) ivf.upsert(row_name(i), rows[i].data());
+    ivf.train();
+
+    std::vector<float> fresh(16, 0.0f);
+    fresh[3] = 5.0f;
+    ivf.upsert("New", fresh.data());
+    CHECK(ivf.size() == 101);
+    auto hits = ivf.search(fresh, 1);
+    REQUIRE(hits.size() == 1);
+    CHECK(hits[0].name == "New");
+    CHECK_THAT(hits[0].score, WithinAbs(1.0, 1e-6));
+
+    // Re-enrolling moves the row instead of duplicating it.
+    ivf.upsert("New", rows[5].data());
+    CHECK(ivf.size() == 101);
+    hits = ivf.search(rows[5], 2);
+    REQUIRE(hits.size() == 2);
+    CHECK(hits[0].score > 0.999f);
+    CHECK(hits[1].score > 0.999f);
+
+    ivf.remove("New");
+    ivf.remove("Nobody");
+    CHECK(ivf.size() == 100);
+    for (const auto& h : ivf.search(rows[5], 3)) CHECK(h.name != "New");
+}
+
+TEST_CASE("speakers.ivf: quantizers round-trip and reload into an index",
+          "[speaker_ann]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_spk_ann_file");
+    fs::remove_all(tmp);
+    fs::create_directories(tmp);
+    const fs::path path = tmp / SPEAKER_ANN_FILE;
+
+    const auto rows = clustered_rows(8, 8, 8, 3);
+    SpeakerIvf ivf(8);
+    for (size_t i = 0; i < rows.size(); ++i) ivf.upsert(row_name(i), rows[i].data());
+    ivf.train();
+    write_speaker_ann(path, {ivf.quantizer()});
+
+    const auto loaded = read_speaker_ann(path);
+    REQUIRE(loaded.size() == 1);
+    CHECK(loaded[0].dim == 8);
+    CHECK(loaded[0].trained_rows == 64);
+    CHECK(loaded[0].centroids == ivf.quantizer().centroids);
+
+    SpeakerIvf again(8);
+    for (size_t i = 0; i < rows.size(); ++i) again.upsert(row_name(i), rows[i].data());
+    again.set_quantizer(loaded[0]);
+    CHECK(again.search(rows[9], 3).front().name == ivf.search(rows[9], 3).front().name);
+    SpeakerIvf other(4);
+    CHECK_THROWS_AS(other.set_quantizer(loaded[0]), RecmeetError);
+
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    SECTION("unknown version") {
+        const uint32_t v = SPEAKER_ANN_VERSION + 1;
+        std::memcpy(&bytes[8], &v, sizeof(v));
+    }
+    SECTION("truncated centroids") {
+        bytes.resize(bytes.size() - sizeof(float));
+    }
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+    CHECK_THROWS_AS(read_speaker_ann(path), RecmeetError);
+    CHECK_THROWS_AS(read_speaker_ann(tmp / "missing.ivf"), RecmeetError);
+
+    fs::remove_all(tmp);
+}
+
+#if RECMEET_USE_SHERPA
+
+TEST_CASE("SpeakerIndex: ANN search matches the exact search above the minimum size",
+          "[speaker_ann][speaker_id]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_spk_ann_index");
+    fs::remove_all(tmp);
+    fs::create_directories(tmp);
+    const fs::path ann_path = tmp / SPEAKER_ANN_FILE;
+
+    const auto rows = clustered_rows(40, 16, 16, 5);
+    REQUIRE(rows.size() >= SPEAKER_ANN_MIN_ROWS);
+    std::vector<SpeakerProfile> db;
+    for (size_t i = 0; i < rows.size(); ++i) db.push_back({row_name(i), {rows[i]}, "", ""});
+
+    SpeakerIndex exact(db);
+    SpeakerIndex ann(db, ann_path);
+    CHECK(exact.ann_sizes() == 0);
+    REQUIRE(ann.ann_sizes() == 1);
+    REQUIRE(fs::exists(ann_path));
+
+    size_t agree = 0, total = 0;
+    for (size_t i = 0; i < rows.size(); i += 5, ++total) {
+        auto query = rows[i];
+        query[1] -= 0.05f;
+        const auto e = exact.best_match(query, 0.6f);
+        const auto a = ann.best_match(query, 0.6f);
+        if (!a.name.empty()) {
+            CHECK(a.score >= 0.6f);
+            CHECK_THAT(a.score, WithinAbs(cosine_similarity(
+                query, rows[std::stoul(a.name.substr(3))]), 1e-5));
+        }
+        if (a.name == e.name) ++agree;
+    }
+    CHECK(agree * 10 >= total * 9);
+    // Nothing enrolled is that close: no match, same as the exact search.
+    CHECK(ann.best_match(std::vector<float>(16, 1.0f), 0.99f).name.empty());
+
+    // Upserts land in the resident lists.
+    std::vector<float> fresh(16, 0.0f);
+    fresh[0] = 1.0f;
+    ann.upsert({"Fresh", {fresh}, "", ""});
+    CHECK(ann.best_match(fresh, 0.9f).name == "Fresh");
+    ann.remove("Fresh");
+    CHECK(ann.best_match(fresh, 0.99f).name.empty());
+
+    // A second load reuses the saved centroids instead of retraining.
+    const auto written = fs::last_write_time(ann_path);
+    SpeakerIndex reload(db, ann_path);
+    CHECK(reload.ann_sizes() == 1);
+    CHECK(fs::last_write_time(ann_path) == written);
+
+    // Small databases keep the exact search.
+    db.resize(SPEAKER_ANN_MIN_ROWS - 1);
+    fs::remove(ann_path);
+    SpeakerIndex small(db, ann_path);
+    CHECK(small.ann_sizes() == 0);
+    CHECK_FALSE(fs::exists(ann_path));
+
+    fs::remove_all(tmp);
+}
+
+#endif // RECMEET_USE_SHERPA
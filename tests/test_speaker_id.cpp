@@ -4,10 +4,13 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
 #include "speaker_id.h"
+#include "speaker_store.h"
 #include "test_tmpdir.h"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <iterator>
 
 using namespace recmeet;
 
@@ -47,7 +50,7 @@ TEST_CASE("speaker_id: save and load round-trip", "[speaker_id]") {
 
     save_speaker(tmp, p);
 
-    CHECK(fs::exists(tmp / "Alice.json"));
+    CHECK(fs::exists(tmp / SPEAKER_STORE_FILE));
 
     auto db = load_speaker_db(tmp);
     REQUIRE(db.size() == 1);
@@ -210,6 +213,41 @@ TEST_CASE("speaker_id: load skips malformed json", "[speaker_id]") {
 // MeetingSpeaker save/load tests (speakers.json)
 // ---------------------------------------------------------------------------
 
+TEST_CASE("select_speaker_segments: longest segments up to the cap, in time order",
+          "[speaker_id]") {
+    DiarizeResult diar;
+    diar.num_speakers = 2;
+    diar.segments = {{0.0, 10.0, 0}, {10.0, 12.0, 1}, {12.0, 40.0, 0},
+                     {40.0, 45.0, 0}, {45.0, 70.0, 0}, {70.0, 70.0, 0}};
+
+    auto all = select_speaker_segments(diar, 0, 0.0);
+    REQUIRE(all.size() == 4);  // the empty segment is dropped
+    CHECK(all[0].start == 0.0);
+    CHECK(select_speaker_segments(diar, 0, 1000.0).size() == 4);
+    CHECK(select_speaker_segments(diar, 1, 30.0).size() == 1);
+    CHECK(select_speaker_segments(diar, 7, 30.0).empty());
+
+    // 28 s and 25 s fit under 60 s; the 10 s segment is cut to the last 7 s.
+    auto capped = select_speaker_segments(diar, 0, 60.0);
+    REQUIRE(capped.size() == 3);
+    CHECK(capped[0].start == 0.0);
+    CHECK(capped[0].end == 7.0);
+    CHECK(capped[1].start == 12.0);
+    CHECK(capped[2].start == 45.0);
+}
+
+TEST_CASE("participant_profile_names: full names, then unambiguous first names",
+          "[speaker_id]") {
+    const std::vector<std::string> enrolled = {"Alice Smith", "Bob", "Carol Jones",
+                                               "Carol West", "dan  brown"};
+    CHECK(participant_profile_names({"alice smith", "Dan Brown (remote)", "Bob"}, enrolled) ==
+          std::vector<std::string>{"Alice Smith", "dan  brown", "Bob"});
+    CHECK(participant_profile_names({"Alice", "Bob Miller", "Bob"}, enrolled) ==
+          std::vector<std::string>{"Alice Smith", "Bob"});  // each once
+    CHECK(participant_profile_names({"Carol", "Eve", ""}, enrolled).empty());  // ambiguous, absent
+    CHECK(participant_profile_names({"Alice"}, {}).empty());
+}
+
 TEST_CASE("speaker_id: save/load meeting speakers round-trip", "[speaker_id]") {
     auto tmp = recmeet::test::tmp_path("recmeet_test_meeting_spk_rt");
     fs::remove_all(tmp);
@@ -273,6 +311,46 @@ TEST_CASE("speaker_id: meeting speakers embedding data preserved exactly", "[spe
     fs::remove_all(tmp);
 }
 
+TEST_CASE("speaker_id: meeting speakers at reduced precision round-trip", "[speaker_id]") {
+    auto root = recmeet::test::tmp_path("recmeet_test_meeting_spk_precision");
+    auto tmp = root / "2026-05-07_10-30";  // relabel derives the timestamp from it
+    std::vector<float> emb(192);
+    for (int i = 0; i < 192; ++i) emb[i] = std::sin(static_cast<float>(i)) * 0.3f;
+
+    for (auto p : {EmbeddingPrecision::F16, EmbeddingPrecision::Int8}) {
+        INFO(embedding_precision_name(p));
+        fs::remove_all(tmp);
+        save_meeting_speakers(tmp, {{0, "Test", true, emb, 10.0f, 0.95f},
+                                    {1, "Speaker_02", false, {}, 2.0f, 0.0f}},
+                              "2026-05-07_10-30", p);
+        std::ifstream in(tmp / "speakers_2026-05-07_10-30.json");
+        std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        CHECK(json.find(std::string("\"embedding_") + embedding_precision_name(p) + "\"") !=
+              std::string::npos);
+
+        EmbeddingPrecision found = EmbeddingPrecision::F32;
+        auto loaded = load_meeting_speakers(tmp, &found);
+        CHECK(found == p);
+        REQUIRE(loaded.size() == 2);
+        CHECK(loaded[0].label == "Test");
+        CHECK(loaded[0].confidence == Catch::Approx(0.95f));
+        CHECK(loaded[1].embedding.empty());
+        REQUIRE(loaded[0].embedding.size() == 192);
+        double max_err = 0.0;
+        for (int i = 0; i < 192; ++i)
+            max_err = std::max(max_err, double(std::fabs(loaded[0].embedding[i] - emb[i])));
+        CHECK(max_err < (p == EmbeddingPrecision::F16 ? 2e-4 : 0.3 / 254 + 1e-6));
+
+        // A relabel rewrites the file at the precision it was written at.
+        REQUIRE(relabel_meeting_speaker(tmp, 1, "Bob"));
+        auto relabeled = load_meeting_speakers(tmp, &found);
+        CHECK(found == p);
+        CHECK(relabeled[1].label == "Bob");
+        CHECK(relabeled[0].embedding == loaded[0].embedding);
+    }
+    fs::remove_all(root);
+}
+
 TEST_CASE("speaker_id: save meeting speakers to empty vector writes valid file", "[speaker_id]") {
     auto tmp = recmeet::test::tmp_path("recmeet_test_meeting_spk_empty");
     fs::remove_all(tmp);
@@ -851,6 +929,92 @@ TEST_CASE("identify_speakers_with_centroids: preserves raw (non-normalized) form
     CHECK(result.scores.at(0) == 0.0f);
 }
 
+// ---------------------------------------------------------------------------
+// SpeakerIndex tests
+// ---------------------------------------------------------------------------
+
+TEST_CASE("SpeakerIndex: upsert and remove change what matches", "[speaker_id]") {
+    SpeakerIndex index({{"Alice", {{1.0f, 0.0f, 0.0f}}, "", ""}});
+    CHECK(index.size() == 1);
+    CHECK(index.best_match({2.0f, 0.1f, 0.0f}, 0.5f).name == "Alice");
+    CHECK(index.best_match({0.0f, 1.0f, 0.0f}, 0.5f).name.empty());
+    CHECK(index.best_match({1.0f, 0.0f}, 0.5f).name.empty());  // no profile of that size
+
+    index.upsert({"Bob", {{0.0f, 1.0f, 0.0f}}, "", ""});
+    auto m = index.best_match({0.0f, 3.0f, 0.0f}, 0.5f);
+    CHECK(m.name == "Bob");
+    CHECK(m.score > 0.99f);
+
+    // Replacing Alice's voiceprint moves her match.
+    index.upsert({"Alice", {{0.0f, 0.0f, 1.0f}}, "", ""});
+    CHECK(index.size() == 2);
+    CHECK(index.best_match({1.0f, 0.0f, 0.0f}, 0.5f).name.empty());
+    CHECK(index.best_match({0.0f, 0.0f, 1.0f}, 0.5f).name == "Alice");
+
+    index.remove("Bob");
+    index.remove("Nobody");
+    CHECK(index.size() == 1);
+    CHECK(index.best_match({0.0f, 1.0f, 0.0f}, 0.5f).name.empty());
+
+    index.clear();
+    CHECK(index.empty());
+}
+
+TEST_CASE("SpeakerIndex: participants are matched before the whole database",
+          "[speaker_id]") {
+    // Alice and her look-alike Alicia, who is not in this meeting; Bob is.
+    const SpeakerIndex index({{"Alice", {{1.0f, 0.1f, 0.0f}}, "", ""},
+                              {"Alicia", {{1.0f, 0.0f, 0.0f}}, "", ""},
+                              {"Bob", {{0.0f, 1.0f, 0.0f}}, "", ""},
+                              {"Carol", {{0.0f, 0.0f, 1.0f}}, "", ""}});
+    CHECK(index.names() == std::vector<std::string>{"Alice", "Alicia", "Bob", "Carol"});
+    const auto participants = index.participants({"Alice", "Bob", "Dave"});
+    REQUIRE(participants->size() == 2);
+
+    const std::map<int, std::vector<float>> centroids = {
+        {0, {1.0f, 0.0f, 0.0f}},   // scores Alicia best, Alice above threshold
+        {1, {0.0f, 2.0f, 0.0f}},   // Bob
+        {2, {0.0f, 0.0f, 1.0f}}};  // Carol: absent, found in the full database
+    const auto full = identify_speakers_with_centroids(centroids, index, 0.6f);
+    CHECK(full.names.at(0) == "Alicia");
+    const auto first = identify_speakers_with_centroids(centroids, index, 0.6f,
+                                                        participants.get());
+    CHECK(first.names.at(0) == "Alice");
+    CHECK(first.names.at(1) == "Bob");
+    CHECK(first.names.at(2) == "Carol");
+}
+
+TEST_CASE("acquire_speaker_index: shared, updated in place, reloaded after outside writes",
+          "[speaker_id]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_spk_index_cache");
+    fs::remove_all(tmp);
+    save_speaker(tmp, {"Alice", {{1.0f, 0.0f}}, "", ""});
+
+    auto index = acquire_speaker_index(tmp);
+    CHECK(index->size() == 1);
+    CHECK(acquire_speaker_index(tmp) == index);
+
+    // This process's writes go straight into the resident index.
+    save_speaker(tmp, {"Bob", {{0.0f, 1.0f}}, "", ""});
+    CHECK(acquire_speaker_index(tmp) == index);
+    CHECK(index->best_match({0.0f, 1.0f}, 0.5f).name == "Bob");
+    CHECK(remove_speaker(tmp, "Alice"));
+    CHECK(acquire_speaker_index(tmp) == index);
+    CHECK(index->size() == 1);
+
+    // Another process replacing speakers.bin forces a reload.
+    write_speaker_store(tmp / SPEAKER_STORE_FILE, {{"Carol", {{1.0f, 1.0f}}, "", ""}});
+    auto reloaded = acquire_speaker_index(tmp);
+    CHECK(reloaded != index);
+    CHECK(reloaded->best_match({1.0f, 1.0f}, 0.5f).name == "Carol");
+    CHECK(reloaded->best_match({0.0f, 1.0f}, 0.9f).name.empty());
+
+    CHECK(reset_speakers(tmp) == 1);
+    CHECK(acquire_speaker_index(tmp)->empty());
+
+    fs::remove_all(tmp);
+}
+
 #endif // RECMEET_USE_SHERPA
 
 // ---------------------------------------------------------------------------
@@ -0,0 +1,190 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "speaker_id.h"
+#include "speaker_store.h"
+#include "test_tmpdir.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace recmeet;
+
+namespace {
+
+SpeakerProfile make_profile(const std::string& name, std::vector<std::vector<float>> embs) {
+    SpeakerProfile p;
+    p.name = name;
+    p.created = "2026-01-01T00:00:00Z";
+    p.updated = "2026-03-08T12:00:00Z";
+    p.embeddings = std::move(embs);
+    return p;
+}
+
+void write_legacy_json(const fs::path& path, const std::string& name,
+                       const std::string& embeddings) {
+    std::ofstream(path) << "{\n  \"name\": \"" << name << "\",\n"
+                        << "  \"created\": \"2026-01-01T00:00:00Z\",\n"
+                        << "  \"updated\": \"2026-01-02T00:00:00Z\",\n"
+                        << "  \"embeddings\": [\n    " << embeddings << "\n  ]\n}\n";
+}
+
+} // namespace
+
+TEST_CASE("SpeakerStore: round-trips profiles exactly, in name order", "[speaker_store]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_spk_store_rt");
+    fs::remove_all(tmp);
+    fs::create_directories(tmp);
+    const fs::path path = tmp / SPEAKER_STORE_FILE;
+
+    write_speaker_store(path, {make_profile("Zoe", {{0.1f, -0.2f, 1e-7f}}),
+                               make_profile("Al", {{1.0f, 2.0f}, {3.0f, 4.0f}})});
+
+    SpeakerStore store(path);
+    REQUIRE(store.size() == 2);
+    CHECK(store.name(0) == "Al");
+    CHECK(store.name(1) == "Zoe");
+    CHECK(store.created(1) == "2026-01-01T00:00:00Z");
+    CHECK(store.updated(1) == "2026-03-08T12:00:00Z");
+    CHECK(store.dim(0) == 2);
+    CHECK(store.embedding_count(0) == 2);
+    CHECK(store.embedding(0, 1)[1] == 4.0f);
+    CHECK(reinterpret_cast<std::uintptr_t>(store.embedding(0, 0)) % 32 == 0);
+
+    CHECK(store.find("Zoe") == 1);
+    CHECK(store.find("Al") == 0);
+    CHECK(store.find("Bob") == -1);
+
+    auto zoe = store.profile(1);
+    REQUIRE(zoe.embeddings.size() == 1);
+    CHECK(zoe.embeddings[0] == std::vector<float>{0.1f, -0.2f, 1e-7f});
+
+    fs::remove_all(tmp);
+}
+
+TEST_CASE("write_speaker_store: rejects profiles it cannot store", "[speaker_store]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_spk_store_reject");
+    fs::remove_all(tmp);
+    fs::create_directories(tmp);
+    const fs::path path = tmp / SPEAKER_STORE_FILE;
+
+    CHECK_THROWS_AS(write_speaker_store(path, {make_profile("A", {})}), RecmeetError);
+    CHECK_THROWS_AS(write_speaker_store(path, {make_profile("A", {{1.0f}, {1.0f, 2.0f}})}),
+                    RecmeetError);
+    CHECK_THROWS_AS(write_speaker_store(path, {make_profile("A", {{1.0f}}),
+                                               make_profile("A", {{2.0f}})}),
+                    RecmeetError);
+    CHECK_FALSE(fs::exists(path));
+
+    fs::remove_all(tmp);
+}
+
+TEST_CASE("SpeakerStore: malformed files throw instead of reading out of range",
+          "[speaker_store]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_spk_store_bad");
+    fs::remove_all(tmp);
+    fs::create_directories(tmp);
+    const fs::path path = tmp / SPEAKER_STORE_FILE;
+
+    std::ofstream(path) << "short";
+    CHECK_THROWS_AS(SpeakerStore(path), RecmeetError);
+    CHECK_THROWS_AS(SpeakerStore(tmp / "missing.bin"), RecmeetError);
+
+    write_speaker_store(path, {make_profile("Al", {{1.0f, 2.0f}})});
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    SECTION("unknown version") {
+        const uint32_t v = SPEAKER_STORE_VERSION + 1;
+        std::memcpy(&bytes[8], &v, sizeof(v));
+    }
+    SECTION("truncated matrix") {
+        bytes.resize(bytes.size() - sizeof(float));
+    }
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+    CHECK_THROWS_AS(SpeakerStore(path), RecmeetError);
+
+    fs::remove_all(tmp);
+}
+
+TEST_CASE("speaker_id: JSON profiles migrate into speakers.bin", "[speaker_store]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_spk_store_migrate");
+    fs::remove_all(tmp);
+    fs::create_directories(tmp);
+
+    save_speaker(tmp, make_profile("Alice", {{9.0f, 9.0f}}));
+    write_legacy_json(tmp / "Alice.json", "Alice", "[0.5, 0.25], [1, 2]");
+    write_legacy_json(tmp / "Bob.json", "Bob", "[3, 4], [5]");
+
+    auto db = load_speaker_db(tmp);
+    REQUIRE(db.size() == 2);
+    CHECK(db[0].name == "Alice");  // the JSON file replaces the stored profile
+    CHECK(db[0].embeddings == std::vector<std::vector<float>>{{0.5f, 0.25f}, {1.0f, 2.0f}});
+    CHECK(db[1].name == "Bob");
+    CHECK(db[1].embeddings.size() == 1);  // the short row is dropped
+
+    CHECK_FALSE(fs::exists(tmp / "Alice.json"));
+    CHECK(fs::exists(tmp / "imported" / "Bob.json"));
+    SpeakerStore store(tmp / SPEAKER_STORE_FILE);
+    CHECK(store.size() == 2);
+    CHECK(list_speakers(tmp) == std::vector<std::string>{"Alice", "Bob"});
+
+    fs::remove_all(tmp);
+}
+
+TEST_CASE("speaker_id: export writes JSON that imports back", "[speaker_store]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_spk_store_export");
+    auto out = recmeet::test::tmp_path("recmeet_test_spk_store_export_out");
+    auto back = recmeet::test::tmp_path("recmeet_test_spk_store_export_back");
+    fs::remove_all(tmp);
+    fs::remove_all(out);
+    fs::remove_all(back);
+
+    const auto carol = make_profile("Carol", {{0.123456789f, -3.3e-5f}, {1.0f / 3.0f, 2.0f}});
+    save_speaker(tmp, carol);
+    CHECK(export_speaker_json(tmp, out) == 1);
+    REQUIRE(fs::exists(out / "Carol.json"));
+
+    fs::create_directories(back);
+    fs::copy_file(out / "Carol.json", back / "Carol.json");
+    auto db = load_speaker_db(back);
+    REQUIRE(db.size() == 1);
+    CHECK(db[0].embeddings == carol.embeddings);
+    CHECK(db[0].updated == carol.updated);
+
+    fs::remove_all(tmp);
+    fs::remove_all(out);
+    fs::remove_all(back);
+}
+
+TEST_CASE("speaker_id: export at f16 imports back within a half's step", "[speaker_store]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_spk_store_export_f16");
+    auto out = recmeet::test::tmp_path("recmeet_test_spk_store_export_f16_out");
+    fs::remove_all(tmp);
+    fs::remove_all(out);
+
+    save_speaker(tmp, make_profile("Dana", {{0.5f, -0.1f, 3.0f}, {1.0f, 2.0f, -0.25f}}));
+    CHECK(export_speaker_json(tmp, out, EmbeddingPrecision::F16) == 1);
+    std::ifstream in(out / "Dana.json");
+    std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    CHECK(json.find("\"embeddings_f16\": [") != std::string::npos);
+    CHECK(json.find("\"embeddings\":") == std::string::npos);
+
+    fs::remove_all(tmp);
+    fs::create_directories(tmp);
+    fs::copy_file(out / "Dana.json", tmp / "Dana.json");
+    auto db = load_speaker_db(tmp);
+    REQUIRE(db.size() == 1);
+    REQUIRE(db[0].embeddings.size() == 2);
+    CHECK(db[0].embeddings[1] == std::vector<float>{1.0f, 2.0f, -0.25f});  // exact in f16
+    CHECK(std::fabs(db[0].embeddings[0][1] + 0.1f) < 1e-4f);
+
+    fs::remove_all(tmp);
+    fs::remove_all(out);
+}
@@ -0,0 +1,283 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "stage_cache.h"
+#include "test_tmpdir.h"
+
+#include <fstream>
+
+using namespace recmeet;
+
+namespace {
+
+fs::path tmp_dir() {
+    fs::path dir = recmeet::test::tmp_path("recmeet_stage_cache");
+    fs::create_directories(dir);
+    return dir;
+}
+
+} // namespace
+
+TEST_CASE("stage_cache_path: sits next to the audio", "[stage_cache]") {
+    CHECK(stage_cache_path("/m/audio_2026-05-18_09-36.wav", STAGE_TRANSCRIPT) ==
+          fs::path("/m/stage_transcript_2026-05-18_09-36.json"));
+    CHECK(stage_cache_path("/m/audio_2026-05-18_09-36.flac", STAGE_SUMMARY) ==
+          fs::path("/m/stage_summary_2026-05-18_09-36.json"));
+    CHECK(stage_cache_path("/m/audio.wav", STAGE_DIARIZATION) ==
+          fs::path("/m/stage_diarization_audio.json"));
+}
+
+TEST_CASE("meeting manifest: round-trips and compares by its inputs", "[stage_cache]") {
+    CHECK(meeting_manifest_path("/m/audio_2026-05-18_09-36.flac") ==
+          fs::path("/m/manifest_2026-05-18_09-36.json"));
+
+    const fs::path dir = tmp_dir();
+    const fs::path note = dir / "Meeting_2026-05-18_09-36.md";
+    std::ofstream(note) << "# note\n";
+    MeetingManifest m;
+    m.audio_hash = "00112233aabbccdd";
+    m.audio_bytes = 1234;
+    m.audio_mtime = 987654321012345;
+    m.transcript_key = "t";
+    m.diarization_key = "d";
+    m.summary_key = "s";
+    m.note_path = note;
+    m.note_hash = hash_file(note);
+    CHECK(m.note_hash == hash_text("# note\n"));
+    CHECK(hash_file(dir / "missing.md").empty());
+
+    const fs::path path = dir / "manifest_2026-05-18_09-36.json";
+    save_meeting_manifest(path, m);
+    MeetingManifest loaded;
+    REQUIRE(load_meeting_manifest(path, loaded));
+    CHECK(loaded.audio_bytes == 1234);
+    CHECK(loaded.audio_mtime == 987654321012345);
+    CHECK(loaded.note_path == note);
+    CHECK(loaded.note_hash == m.note_hash);
+    CHECK(same_manifest_inputs(loaded, m));
+
+    // A different note is not a different input; a different key is.
+    loaded.note_hash = "x";
+    CHECK(same_manifest_inputs(loaded, m));
+    loaded.summary_key = "s2";
+    CHECK_FALSE(same_manifest_inputs(loaded, m));
+
+    CHECK_FALSE(load_meeting_manifest(dir / "manifest_missing.json", loaded));
+    save_transcript_stage(path, "k", TranscriptResult{});  // not a manifest
+    CHECK_FALSE(load_meeting_manifest(path, loaded));
+}
+
+TEST_CASE("hash_samples: follows the samples, not the block layout", "[stage_cache]") {
+    std::vector<float> a(200000, 0.25f);
+    MemorySampleSource src(a.data(), a.size());
+    const std::string h = hash_samples(src);
+    CHECK(h.size() == 16);
+    CHECK(hash_samples(MemorySampleSource(std::vector<float>(a))) == h);
+
+    a[150000] = -0.25f;
+    CHECK(hash_samples(MemorySampleSource(a.data(), a.size())) != h);
+    CHECK(hash_samples(MemorySampleSource(a.data(), a.size() - 1)) != h);
+}
+
+TEST_CASE("StageKey: every input changes the digest", "[stage_cache]") {
+    auto key = [](const std::string& model, double threshold) {
+        return StageKey(STAGE_DIARIZATION).add("model", model).add("t", threshold).digest();
+    };
+    CHECK(key("base", 1.18) == key("base", 1.18));
+    CHECK(key("base", 1.18) != key("base", 1.19));
+    CHECK(key("base", 1.18) != key("small", 1.18));
+    // Values are length-prefixed, so fields cannot shift into each other.
+    CHECK(StageKey("s").add("a", "xy").add("b", "z").digest() !=
+          StageKey("s").add("a", "x").add("b", "yz").digest());
+    CHECK(StageKey(STAGE_SUMMARY).digest() != StageKey(STAGE_TRANSCRIPT).digest());
+}
+
+TEST_CASE("transcript stage: round-trips under its key", "[stage_cache]") {
+    fs::path p = tmp_dir() / "stage_transcript.json";
+    TranscriptResult r{};
+    r.segments = {{0.5, 2.25, " Hello, \"world\"."}, {3.0, 4.125, " Next\nline"}};
+    r.language = "en";
+    r.language_prob = 0.75f;
+    save_transcript_stage(p, "k1", r);
+
+    TranscriptResult got{};
+    REQUIRE(load_transcript_stage(p, "k1", got));
+    REQUIRE(got.segments.size() == 2);
+    CHECK(got.segments[0].start == 0.5);
+    CHECK(got.segments[1].end == 4.125);
+    CHECK(got.segments[0].text == " Hello, \"world\".");
+    CHECK(got.segments[1].text == " Next\nline");
+    CHECK(got.language == "en");
+    CHECK(got.language_prob == 0.75f);
+
+    // A different key is a miss and leaves the output alone.
+    TranscriptResult untouched{};
+    untouched.language = "keep";
+    CHECK_FALSE(load_transcript_stage(p, "k2", untouched));
+    CHECK(untouched.language == "keep");
+    CHECK_FALSE(load_transcript_stage(tmp_dir() / "missing.json", "k1", untouched));
+}
+
+TEST_CASE("diarization stage: segments and exact centroids round-trip", "[stage_cache]") {
+    fs::path p = tmp_dir() / "stage_diarization.json";
+    DiarizeResult diar;
+    diar.segments = {{0.0, 1.5, 0}, {1.5, 4.0, 1}, {4.0, 5.0, 0}};
+    diar.num_speakers = 2;
+    std::map<int, std::vector<float>> centroids = {
+        {0, {0.1f, -0.333333343f, 1e-7f}},
+        {1, {0.7f, 0.2f, -0.9f}},
+    };
+    save_diarization_stage(p, "k", diar, centroids);
+
+    DiarizeResult got_diar;
+    std::map<int, std::vector<float>> got_centroids;
+    REQUIRE(load_diarization_stage(p, "k", got_diar, got_centroids));
+    CHECK(got_diar.num_speakers == 2);
+    REQUIRE(got_diar.segments.size() == 3);
+    CHECK(got_diar.segments[1].start == 1.5);
+    CHECK(got_diar.segments[1].speaker == 1);
+    CHECK(got_centroids == centroids);
+    CHECK_FALSE(load_diarization_stage(p, "other", got_diar, got_centroids));
+
+    // Enrollment takes the saved diarization whatever its key.
+    DiarizeResult saved;
+    REQUIRE(load_saved_diarization_stage(p, saved, got_centroids));
+    CHECK(saved.segments.size() == 3);
+    CHECK_FALSE(load_saved_diarization_stage(tmp_dir() / "missing.json", saved, got_centroids));
+}
+
+#if RECMEET_USE_SHERPA
+TEST_CASE("clustering stage: chunks round-trip exactly", "[stage_cache]") {
+    fs::path p = tmp_dir() / "stage_clustering.json";
+    ClusteringStage stage;
+    stage.audio_hash = "0123456789abcdef";
+    stage.samples = 28800000;
+    stage.chunked = true;
+    for (size_t start : {size_t(0), size_t(13920000)}) {
+        DiarizedChunk c{};
+        c.extents.pcm_start_samples = start;
+        c.extents.pcm_end_samples = start + 14880000;
+        c.diar.segments = {{0.1 + 1.0 / 3.0, 4.25, 0}, {5.0, 9.87654321, 1}};
+        c.diar.num_speakers = 2;
+        c.centroids[0] = {0.1f, -0.333333343f, 1e-7f};
+        c.centroids[1] = {0.7f, 0.2f, -0.9f};
+        stage.chunks.push_back(std::move(c));
+    }
+    save_clustering_stage(p, "k", stage);
+    CHECK(clustering_stage_audio_hash(p) == "0123456789abcdef");
+
+    ClusteringStage got;
+    REQUIRE(load_clustering_stage(p, "k", got));
+    CHECK(got.audio_hash == stage.audio_hash);
+    CHECK(got.samples == stage.samples);
+    CHECK(got.chunked);
+    REQUIRE(got.chunks.size() == 2);
+    CHECK(got.chunks[1].extents.pcm_start_samples == 13920000);
+    CHECK(got.chunks[1].extents.pcm_end_samples == 28800000);
+    REQUIRE(got.chunks[0].diar.segments.size() == 2);
+    CHECK(got.chunks[0].diar.segments[0].start == stage.chunks[0].diar.segments[0].start);
+    CHECK(got.chunks[0].diar.segments[1].end == stage.chunks[0].diar.segments[1].end);
+    CHECK(got.chunks[0].diar.num_speakers == 2);
+    CHECK(got.chunks[1].centroids == stage.chunks[1].centroids);
+
+    CHECK_FALSE(load_clustering_stage(p, "other", got));
+    // Another stage's file has no clustering hash to trust.
+    fs::path d = tmp_dir() / "stage_diarization_as_clustering.json";
+    save_diarization_stage(d, "k", DiarizeResult{}, {});
+    CHECK(clustering_stage_audio_hash(d).empty());
+    CHECK(clustering_stage_audio_hash(tmp_dir() / "missing.json").empty());
+}
+#endif
+
+TEST_CASE("summary stage: round-trips; unreadable files are misses", "[stage_cache]") {
+    auto dir = tmp_dir();
+    fs::path p = dir / "stage_summary.json";
+    save_summary_stage(p, "k", "## Overview\nShort \"meeting\".");
+    std::string got;
+    REQUIRE(load_summary_stage(p, "k", got));
+    CHECK(got == "## Overview\nShort \"meeting\".");
+
+    // Saved by another stage: not a summary.
+    fs::path t = dir / "stage_transcript_as_summary.json";
+    save_transcript_stage(t, "k", TranscriptResult{});
+    CHECK_FALSE(load_summary_stage(t, "k", got));
+
+    fs::path torn = dir / "stage_torn.json";
+    std::ofstream(torn) << "{\"version\":1,\"stage\":\"summary\",\"key\":\"k\",\"summ";
+    CHECK_FALSE(load_summary_stage(torn, "k", got));
+    CHECK(got == "## Overview\nShort \"meeting\".");
+
+    std::vector<std::string> speakers = {"stale"};
+    REQUIRE(load_summary_stage(p, "k", got, &speakers));
+    CHECK(speakers.empty());
+    save_summary_stage(p, "k", "Alice agreed.", {"Alice", "Speaker_02"});
+    REQUIRE(load_summary_stage(p, "k", got, &speakers));
+    CHECK(got == "Alice agreed.");
+    CHECK(speakers == std::vector<std::string>{"Alice", "Speaker_02"});
+}
+
+TEST_CASE("note stage: round-trips the note's inputs and speaker-tagged segments",
+          "[stage_cache]") {
+    auto dir = tmp_dir();
+    fs::path p = dir / "stage_note.json";
+    NoteStage stage;
+    stage.data.date = "2026-05-18";
+    stage.data.time = "09:36";
+    stage.data.summary_text = "## Overview\nSpeaker_02 presented.";
+    stage.data.title = "Roadmap";
+    stage.data.participants = {"Alice", "Speaker_02"};
+    stage.data.action_items = {"**[Speaker_02]** - Send the deck"};
+    stage.data.duration_seconds = 95;
+    stage.data.note_dir = dir / "notes";
+    stage.segments = {{0.0, 2.5, " Hello."}, {2.5, 4.25, " Hi, \"all\"."}};
+    stage.speakers = {0, 1};
+    stage.labels = {{0, "Alice"}, {1, "Speaker_02"}};
+    stage.note_path = dir / "notes" / "Meeting_2026-05-18_09-36_Roadmap.md";
+    save_note_stage(p, stage);
+
+    NoteStage got;
+    REQUIRE(load_note_stage(p, got));
+    CHECK(got.data.summary_text == stage.data.summary_text);
+    CHECK(got.data.title == "Roadmap");
+    CHECK(got.data.participants == stage.data.participants);
+    CHECK(got.data.action_items == stage.data.action_items);
+    CHECK(got.data.duration_seconds == 95);
+    CHECK(got.data.note_dir == stage.data.note_dir);
+    REQUIRE(got.segments.size() == 2);
+    CHECK(got.segments[1].start == 2.5);
+    CHECK(got.segments[1].end == 4.25);
+    CHECK(got.segments[1].text == " Hi, \"all\".");
+    CHECK(got.speakers == stage.speakers);
+    CHECK(got.labels == stage.labels);
+    CHECK(got.note_path == stage.note_path);
+
+    // Without diarization the segments carry no speakers.
+    stage.speakers.clear();
+    stage.labels.clear();
+    save_note_stage(p, stage);
+    REQUIRE(load_note_stage(p, got));
+    CHECK(got.segments.size() == 2);
+    CHECK(got.speakers.empty());
+
+    save_summary_stage(dir / "stage_summary_as_note.json", "k", "Summary.");
+    CHECK_FALSE(load_note_stage(dir / "stage_summary_as_note.json", got));
+}
+
+TEST_CASE("summary parts stage: round-trips under the summary key", "[stage_cache]") {
+    auto dir = tmp_dir();
+    fs::path p = dir / "stage_summary_parts.json";
+    std::map<std::string, std::string> parts = {{hash_text("map 1"), "notes, \"one\""},
+                                                {hash_text("map 2"), "notes\ntwo"}};
+    save_summary_parts_stage(p, "k", parts);
+    CHECK_FALSE(fs::exists(dir / "stage_summary_parts.json.tmp"));
+    std::map<std::string, std::string> got;
+    REQUIRE(load_summary_parts_stage(p, "k", got));
+    CHECK(got == parts);
+
+    got.clear();
+    CHECK_FALSE(load_summary_parts_stage(p, "other", got));
+    CHECK(got.empty());
+    save_summary_stage(dir / "stage_summary_as_parts.json", "k", "Summary.");
+    CHECK_FALSE(load_summary_parts_stage(dir / "stage_summary_as_parts.json", "k", got));
+}
@@ -0,0 +1,258 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "stage_perf.h"
+#include "test_tmpdir.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace recmeet;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+fs::path tmp_dir() {
+    fs::path dir = recmeet::test::tmp_path("recmeet_stage_perf");
+    fs::create_directories(dir);
+    return dir;
+}
+
+StagePerf record(const std::string& stage, double wall, double cpu, double audio, int threads) {
+    StagePerf p;
+    p.stage = stage;
+    p.wall_sec = wall;
+    p.cpu_sec = cpu;
+    p.audio_sec = audio;
+    p.threads = threads;
+    p.peak_rss_kb = 2048;
+    return p;
+}
+
+std::vector<std::string> lines_of(const fs::path& path) {
+    std::ifstream in(path);
+    std::vector<std::string> out;
+    for (std::string line; std::getline(in, line);) out.push_back(line);
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("StagePerf: real-time factor and thread utilization", "[stage_perf]") {
+    const StagePerf p = record("transcribe", 30.0, 90.0, 600.0, 4);
+    CHECK_THAT(p.rtf(), WithinAbs(0.05, 1e-9));
+    CHECK_THAT(p.utilization(), WithinAbs(0.75, 1e-9));
+
+    // Unknown inputs read as 0, not as a division by zero.
+    CHECK(record("summarize", 12.0, 30.0, 0, 4).rtf() == 0.0);
+    CHECK(record("note", 0.1, 0.1, 0, 0).utilization() == 0.0);
+    CHECK(record("diarize_chunk", 10.0, -1, 900.0, 2).utilization() == 0.0);
+}
+
+TEST_CASE("StageTimer: measures wall and CPU time of the stage", "[stage_perf]") {
+    StageTimer timer("vad", 60.0, 1);
+    volatile double sink = 0;
+    for (int i = 0; i < 20000000; ++i) sink = sink + i * 0.5;
+    timer.threads = 2;
+    const StagePerf p = timer.finish(true);
+    CHECK(p.stage == "vad");
+    CHECK(p.wall_sec > 0);
+    CHECK(p.cpu_sec > 0);
+    CHECK(p.audio_sec == 60.0);
+    CHECK(p.threads == 2);
+    CHECK(p.cached);
+    CHECK(p.peak_rss_kb > 0);
+    CHECK(process_cpu_seconds() >= p.cpu_sec);
+}
+
+TEST_CASE("stage_perf_to_map: round trips one record", "[stage_perf]") {
+    StagePerf p = record("diarize_chunk", 41.5, -1, 900.0, 3);
+    p.index = 4;
+    p.cached = true;
+    const JsonMap m = stage_perf_to_map(p);
+    CHECK(m.count("cpu_sec") == 0);
+    CHECK(m.count("rtf") == 1);
+
+    StagePerf back;
+    REQUIRE(stage_perf_from_map(m, back));
+    CHECK(back.stage == "diarize_chunk");
+    CHECK(back.index == 4);
+    CHECK(back.wall_sec == 41.5);
+    CHECK(back.cpu_sec == -1);
+    CHECK(back.audio_sec == 900.0);
+    CHECK(back.threads == 3);
+    CHECK(back.peak_rss_kb == 2048);
+    CHECK(back.cached);
+
+    CHECK_FALSE(stage_perf_from_map(JsonMap{}, back));
+}
+
+TEST_CASE("release_stage_memory: freed heap leaves the RSS", "[stage_perf]") {
+    // 64 MB in blocks below the mmap threshold, all on the heap; one more
+    // block after them stays allocated so free() cannot just shrink the
+    // heap's top.
+    std::vector<char*> blocks;
+    blocks.reserve(1024);
+    for (int i = 0; i < 1024; ++i) {
+        char* b = static_cast<char*>(std::malloc(64 * 1024));
+        std::memset(b, 1, 64 * 1024);
+        blocks.push_back(b);
+    }
+    char* pin = static_cast<char*>(std::malloc(64 * 1024));
+    std::memset(pin, 1, 64 * 1024);
+    for (char* b : blocks) std::free(b);
+
+    const StagePerf p = release_stage_memory("test");
+    std::free(pin);
+    CHECK(p.stage == "release.test");
+    CHECK(p.peak_rss_kb > 0);
+    CHECK(p.released_kb <= p.peak_rss_kb);
+#if defined(__GLIBC__)
+    CHECK(p.released_kb > 32 * 1024);
+#endif
+
+    StagePerf back;
+    REQUIRE(stage_perf_from_map(stage_perf_to_map(p), back));
+    CHECK(back.released_kb == p.released_kb);
+}
+
+TEST_CASE("PerfCounts: ratios, sums and multiplexed scaling", "[stage_perf]") {
+    PerfCounts c;
+    CHECK_FALSE(c.any());
+    CHECK(c.ipc() == 0.0);
+    CHECK(c.miss_mb_per_sec(1.0) == 0.0);
+
+    c.cycles = 1000;
+    c.instructions = 2500;
+    c.cache_refs = 200;
+    c.cache_misses = 50;
+    CHECK(c.any());
+    CHECK_THAT(c.ipc(), WithinAbs(2.5, 1e-9));
+    CHECK_THAT(c.cache_miss_rate(), WithinAbs(0.25, 1e-9));
+    CHECK(c.branch_miss_rate() == 0.0);  // branches not counted
+    CHECK_THAT(c.miss_mb_per_sec(2.0), WithinAbs(50 * 64.0 / (1024 * 1024) / 2.0, 1e-12));
+
+    // A counter missing on one side takes the other's value.
+    PerfCounts more;
+    more.cycles = 500;
+    more.branches = 40;
+    c += more;
+    CHECK(c.cycles == 1500);
+    CHECK(c.instructions == 2500);
+    CHECK(c.branches == 40);
+    CHECK(c.branch_misses == -1);
+
+    CHECK(scale_perf_count(100, 10, 10) == 100);
+    CHECK(scale_perf_count(100, 10, 5) == 200);
+    CHECK(scale_perf_count(100, 10, 0) == -1);
+}
+
+TEST_CASE("perf counters: inert while the mode is off", "[stage_perf]") {
+    set_perf_counters(false);
+    take_engine_counts();
+    const PerfCounterSet set;
+    CHECK_FALSE(set.active());
+    CHECK_FALSE(set.read().any());
+    { const EngineCounterScope scope("whisper_full", PerfScope::Thread); }
+    CHECK(take_engine_counts().empty());
+    CHECK_FALSE(StageTimer("vad").finish().counters.any());
+}
+
+TEST_CASE("engine_perf_records: one record per engine, round trips", "[stage_perf]") {
+    std::map<std::string, EngineCounts> engines;
+    engines["whisper_full"].calls = 12;
+    engines["whisper_full"].wall_sec = 30.0;
+    engines["whisper_full"].counts.cycles = 4000;
+    engines["whisper_full"].counts.instructions = 6000;
+    engines["llama_complete"].calls = 1;
+
+    const auto records = engine_perf_records(engines);
+    REQUIRE(records.size() == 2);
+    CHECK(records[0].stage == "engine.llama_complete");
+    CHECK(records[1].stage == "engine.whisper_full");
+    CHECK(records[1].index == -1);
+    CHECK(records[1].calls == 12);
+    CHECK(perf_counters_summary(records[0]).empty());
+    CHECK(perf_counters_summary(records[1]).find("IPC 1.50") != std::string::npos);
+
+    const JsonMap m = stage_perf_to_map(records[1]);
+    CHECK(m.count("cache_misses") == 0);
+    CHECK_THAT(json_val_as_double(m.at("ipc")), WithinAbs(1.5, 1e-9));
+    StagePerf back;
+    REQUIRE(stage_perf_from_map(m, back));
+    CHECK(back.calls == 12);
+    CHECK(back.counters.cycles == 4000);
+    CHECK(back.counters.instructions == 6000);
+    CHECK(back.counters.cache_misses == -1);
+    CHECK(stage_perf_from_map(stage_perf_to_map(records[0]), back));
+    CHECK(back.calls == 1);
+    CHECK_FALSE(back.counters.any());
+}
+
+TEST_CASE("perf_path: sits next to the audio", "[stage_perf]") {
+    CHECK(perf_path("/m/audio_2026-05-18_09-36.wav") ==
+          fs::path("/m/perf_2026-05-18_09-36.json"));
+    CHECK(perf_path("/m/audio_2026-05-18_09-36.flac") ==
+          fs::path("/m/perf_2026-05-18_09-36.json"));
+}
+
+TEST_CASE("save_meeting_perf: round trips a job's records", "[stage_perf]") {
+    const fs::path path = tmp_dir() / "perf_2026-05-18_09-36.json";
+    PerfRun run;
+    run.version = "1.2.3";
+    run.host = "bench";
+    run.meeting = "2026-05-18_09-36";
+    run.finished_unix = 1779100000;
+    run.whisper_model = "base";
+    run.attempt = 2;
+    run.wall_sec = 321.0;
+    run.peak_rss_kb = 4096;
+    std::vector<StagePerf> stages;
+    for (int i = 0; i < 12; ++i)
+        stages.push_back(record(i == 11 ? "note" : "diarize_chunk", i + 1.0, i, 60.0, 2));
+    stages[3].index = 3;
+    save_meeting_perf(path, run, stages);
+
+    PerfRun got;
+    std::vector<StagePerf> got_stages;
+    REQUIRE(load_meeting_perf(path, got, got_stages));
+    CHECK(got.version == "1.2.3");
+    CHECK(got.host == "bench");
+    CHECK(got.meeting == "2026-05-18_09-36");
+    CHECK(got.finished_unix == 1779100000);
+    CHECK(got.whisper_model == "base");
+    CHECK(got.llm_model.empty());
+    CHECK(got.attempt == 2);
+    CHECK(got.wall_sec == 321.0);
+    CHECK(got.peak_rss_kb == 4096);
+    REQUIRE(got_stages.size() == 12);
+    // p1_ and p10_ / p11_ stay apart.
+    CHECK(got_stages[1].wall_sec == 2.0);
+    CHECK(got_stages[10].wall_sec == 11.0);
+    CHECK(got_stages[11].stage == "note");
+    CHECK(got_stages[3].index == 3);
+    CHECK(got_stages[0].index == -1);
+
+    CHECK_FALSE(load_meeting_perf(tmp_dir() / "missing.json", got, got_stages));
+}
+
+TEST_CASE("append_perf_history: keeps the newest runs", "[stage_perf]") {
+    const fs::path history = tmp_dir() / "history" / "perf_history.ndjson";
+    fs::remove_all(history.parent_path());
+    const std::vector<StagePerf> stages = {record("transcribe", 10.0, 30.0, 300.0, 4)};
+    for (int i = 0; i < 5; ++i) {
+        PerfRun run;
+        run.meeting = "m" + std::to_string(i);
+        append_perf_history(history, run, stages, 3);
+    }
+    const auto lines = lines_of(history);
+    REQUIRE(lines.size() == 3);
+    CHECK(lines[0].find("\"meeting\":\"m2\"") != std::string::npos);
+    CHECK(lines[2].find("\"meeting\":\"m4\"") != std::string::npos);
+    CHECK(lines[2].find("\"p0_stage\":\"transcribe\"") != std::string::npos);
+}
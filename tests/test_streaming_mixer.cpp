@@ -0,0 +1,276 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "streaming_mixer.h"
+#include "audio_mixer.h"
+#include "test_tmpdir.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+using namespace recmeet;
+
+namespace {
+
+fs::path tmp_dir() {
+    fs::path dir = recmeet::test::tmp_path("recmeet_stream_mix");
+    fs::create_directories(dir);
+    return dir;
+}
+
+// The spool writes a fixed-size header, so the PCM payload can be read
+// back without libsndfile.
+std::vector<int16_t> read_pcm(const fs::path& p) {
+    constexpr std::size_t H = SPOOL_WAV_HEADER_BYTES;
+    std::ifstream in(p, std::ios::binary);
+    std::vector<char> bytes(std::istreambuf_iterator<char>(in), {});
+    REQUIRE(bytes.size() >= H);
+    std::vector<int16_t> out((bytes.size() - H) / sizeof(int16_t));
+    std::memcpy(out.data(), bytes.data() + H, out.size() * sizeof(int16_t));
+    return out;
+}
+
+std::vector<int16_t> ramp(std::size_t n, int start, int step) {
+    std::vector<int16_t> v(n);
+    for (std::size_t i = 0; i < n; ++i)
+        v[i] = static_cast<int16_t>((start + static_cast<int>(i) * step) % 30000);
+    return v;
+}
+
+// Feed `src` to `append` in chunks of `chunk` samples starting at `pos`.
+template <typename F>
+void feed(F append, const std::vector<int16_t>& src, std::size_t& pos, std::size_t chunk) {
+    std::size_t n = std::min(chunk, src.size() - pos);
+    append(src.data() + pos, n);
+    pos += n;
+}
+
+} // namespace
+
+TEST_CASE("StreamingMixer: interleaved chunks match mix_audio", "[streaming_mixer]") {
+    auto dir = tmp_dir();
+    auto mic = ramp(5000, 100, 3);
+    auto mon = ramp(3200, -200, 7);
+
+    {
+        StreamingMixer mixer(dir / "mixed.wav", dir / "mic.wav");
+        // Uneven chunk sizes so each side repeatedly gets ahead of the other.
+        std::size_t mp = 0, np = 0;
+        while (mp < mic.size() || np < mon.size()) {
+            if (mp < mic.size())
+                feed([&](const int16_t* s, std::size_t n) { mixer.append_mic(s, n); }, mic, mp, 160);
+            if (np < mon.size())
+                feed([&](const int16_t* s, std::size_t n) { mixer.append_monitor(s, n); }, mon, np, 333);
+        }
+        auto r = mixer.finish();
+        CHECK(r.mic_samples == mic.size());
+        CHECK(r.monitor_samples == mon.size());
+        CHECK(r.mixed.samples == mic.size());
+        CHECK(r.sources.empty());
+        CHECK(r.skew_filled == 0);
+    }
+
+    CHECK(read_pcm(dir / "mixed.wav") == mix_audio(mic, mon));
+    CHECK(read_pcm(dir / "mic.wav") == mic);
+    CHECK_FALSE(fs::exists(dir / "monitor.wav"));
+    fs::remove_all(dir);
+}
+
+TEST_CASE("StreamingMixer: interleaved sources file written when requested", "[streaming_mixer]") {
+    auto dir = tmp_dir();
+    auto mic = ramp(1000, 1, 1);
+    auto mon = ramp(1500, 2, 2);
+
+    StreamingMixer mixer(dir / "mixed.wav", {}, dir / "sources.wav");
+    mixer.append_monitor(mon.data(), mon.size());
+    mixer.append_mic(mic.data(), mic.size());
+    auto r = mixer.finish();
+
+    CHECK(r.mic.empty());
+    CHECK_FALSE(fs::exists(dir / "mic.wav"));
+    CHECK(r.sources.channels == 2);
+    CHECK(r.sources.samples == mon.size());
+    CHECK(r.mic_samples == mic.size());
+    // Mic left, monitor right, aligned as mixed; the short mic is padded.
+    std::vector<int16_t> expected(2 * mon.size(), 0);
+    for (std::size_t i = 0; i < mon.size(); ++i) {
+        if (i < mic.size()) expected[2 * i] = mic[i];
+        expected[2 * i + 1] = mon[i];
+    }
+    CHECK(read_pcm(dir / "sources.wav") == expected);
+    CHECK(read_pcm(dir / "mixed.wav") == mix_audio(mic, mon));
+
+    uint8_t h[SPOOL_WAV_HEADER_BYTES];
+    std::ifstream in(dir / "sources.wav", std::ios::binary);
+    in.read(reinterpret_cast<char*>(h), sizeof(h));
+    CHECK(h[58] == 2);                 // channels
+    CHECK((h[68] | h[69] << 8) == 4);  // block align
+    fs::remove_all(dir);
+}
+
+TEST_CASE("StreamingMixer: stalled input is padded once skew exceeds the bound",
+          "[streaming_mixer]") {
+    auto dir = tmp_dir();
+    std::vector<int16_t> mic(STREAM_MIX_MAX_SKEW + 1000, 1000);
+
+    StreamingMixer mixer(dir / "mixed.wav", dir / "mic.wav");
+    mixer.append_mic(mic.data(), mic.size());
+    // The monitor resumes after the stall; it lines up with the output
+    // position, not with the start of the mic backlog.
+    std::vector<int16_t> mon(500, 3000);
+    mixer.append_monitor(mon.data(), mon.size());
+    auto r = mixer.finish();
+
+    CHECK(r.skew_filled == 1000);
+    auto mixed = read_pcm(dir / "mixed.wav");
+    REQUIRE(mixed.size() == mic.size());
+    CHECK(mixed[0] == 500);       // (1000 + 0) / 2 — padded region
+    CHECK(mixed[1000] == 2000);   // (1000 + 3000) / 2 — resumed monitor
+    CHECK(mixed[1499] == 2000);
+    CHECK(mixed[1500] == 500);    // tail zero-pad
+    fs::remove_all(dir);
+}
+
+TEST_CASE("StreamingMixer: concurrent producers and idempotent finish", "[streaming_mixer]") {
+    auto dir = tmp_dir();
+    constexpr std::size_t N = SAMPLE_RATE * 2;
+    std::vector<int16_t> mic(N, 200), mon(N, 400);
+
+    StreamingMixer mixer(dir / "mixed.wav", dir / "mic.wav");
+    std::thread t1([&] {
+        for (std::size_t i = 0; i < N; i += 160) mixer.append_mic(mic.data() + i, 160);
+    });
+    std::thread t2([&] {
+        for (std::size_t i = 0; i < N; i += 1600) mixer.append_monitor(mon.data() + i, 1600);
+    });
+    t1.join();
+    t2.join();
+
+    auto r1 = mixer.finish();
+    mixer.append_mic(mic.data(), 160);  // ignored after finish
+    auto r2 = mixer.finish();
+    CHECK(r1.mixed.samples == N);
+    CHECK(r2.mixed.samples == N);
+    CHECK(r2.mic_samples == N);
+
+    auto mixed = read_pcm(dir / "mixed.wav");
+    REQUIRE(mixed.size() == N);
+    CHECK(std::all_of(mixed.begin(), mixed.end(), [](int16_t s) { return s == 300; }));
+    fs::remove_all(dir);
+}
+
+TEST_CASE("StreamingMixer: channel envelope follows each input", "[streaming_mixer][channel_attribution]") {
+    auto dir = tmp_dir();
+    // Mic at -20 dBFS for a second, then quiet; the monitor the other way
+    // round, and half a frame shorter (padded like the mix).
+    std::vector<int16_t> mic(SAMPLE_RATE * 2, 0), mon(SAMPLE_RATE * 2 - 800, 0);
+    std::fill(mic.begin(), mic.begin() + SAMPLE_RATE, int16_t(3277));
+    std::fill(mon.begin() + SAMPLE_RATE, mon.end(), int16_t(-3277));
+
+    StreamingMixer mixer(dir / "mixed.wav", dir / "mic.wav");
+    std::size_t mp = 0, np = 0;
+    while (mp < mic.size() || np < mon.size()) {
+        if (mp < mic.size())
+            feed([&](const int16_t* s, std::size_t n) { mixer.append_mic(s, n); }, mic, mp, 480);
+        if (np < mon.size())
+            feed([&](const int16_t* s, std::size_t n) { mixer.append_monitor(s, n); }, mon, np, 1024);
+    }
+    const auto env = mixer.finish().envelope;
+
+    REQUIRE(env.frames() == 20);
+    REQUIRE(env.monitor.size() == 20);
+    CHECK(env.mic[0] == 80);
+    CHECK(env.mic[9] == 80);
+    CHECK(env.monitor[0] == 0);
+    CHECK(env.mic[10] == 0);
+    CHECK(env.monitor[10] == 80);
+    CHECK(env.monitor[19] == envelope_level(3277.0 * 3277.0 / 2));  // half the frame
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Channel envelope: sidecar path and round trip", "[channel_attribution]") {
+    auto dir = tmp_dir();
+    CHECK(channel_envelope_path("/m/audio_2026-01-02_03-04.wav") ==
+          fs::path("/m/envelope_2026-01-02_03-04.bin"));
+
+    ChannelEnvelope env;
+    env.mic = {0, 40, 80, 100};
+    env.monitor = {90, 10, 0, 5};
+    const fs::path path = dir / "envelope_x.bin";
+    save_channel_envelope(path, env);
+    ChannelEnvelope loaded;
+    REQUIRE(load_channel_envelope(path, loaded));
+    CHECK(loaded.mic == env.mic);
+    CHECK(loaded.monitor == env.monitor);
+
+    // Truncated or missing files are not loaded.
+    fs::resize_file(path, fs::file_size(path) - 1);
+    ChannelEnvelope untouched;
+    CHECK_FALSE(load_channel_envelope(path, untouched));
+    CHECK_FALSE(load_channel_envelope(dir / "missing.bin", untouched));
+    CHECK(untouched.frames() == 0);
+    fs::remove_all(dir);
+}
+
+TEST_CASE("local_speech_spans: mic-dominated stretches only", "[channel_attribution]") {
+    // 10 s: room tone on the mic (20) and a quiet monitor (10).
+    ChannelEnvelope env;
+    env.mic.assign(100, 20);
+    env.monitor.assign(100, 10);
+    auto set = [](std::vector<uint8_t>& v, size_t from, size_t to, uint8_t level) {
+        std::fill(v.begin() + from, v.begin() + to, level);
+    };
+    set(env.mic, 10, 30, 70);       // 1.0-3.0 s: local speech ...
+    set(env.mic, 18, 20, 20);       // ... with a 0.2 s breath, bridged
+    set(env.mic, 40, 45, 70);       // 4.0-4.5 s: too short
+    set(env.mic, 60, 80, 70);       // 6.0-8.0 s: both talk, mic not dominant
+    set(env.monitor, 60, 80, 65);
+    set(env.monitor, 85, 95, 75);   // 8.5-9.5 s: remote only
+
+    const auto spans = local_speech_spans(env);
+    REQUIRE(spans.size() == 1);
+    CHECK(spans[0].first == Catch::Approx(1.0));
+    CHECK(spans[0].second == Catch::Approx(3.0));
+
+    // A pause longer than the bridge splits the stretch, and the short
+    // burst at 4.0 s now joins the second half.
+    set(env.mic, 10, 40, 70);
+    set(env.mic, 20, 25, 20);
+    const auto split = local_speech_spans(env);
+    REQUIRE(split.size() == 2);
+    CHECK(split[0].first == Catch::Approx(1.0));
+    CHECK(split[0].second == Catch::Approx(2.0));
+    CHECK(split[1].first == Catch::Approx(2.5));
+    CHECK(split[1].second == Catch::Approx(4.5));
+
+    CHECK(local_speech_spans(ChannelEnvelope{}).empty());
+}
+
+TEST_CASE("subtract_spans cuts the local stretches out of segments", "[channel_attribution]") {
+    auto seg = [](double a, double b) {
+        return VadSegment{static_cast<int32_t>(a * SAMPLE_RATE),
+                          static_cast<int32_t>(b * SAMPLE_RATE), a, b};
+    };
+    const std::vector<VadSegment> segments = {seg(0, 4), seg(5, 6), seg(8, 12)};
+    const std::vector<std::pair<double, double>> spans = {{1, 2}, {3.9, 5.1}, {9, 13}};
+
+    const auto out = subtract_spans(segments, spans);
+    REQUIRE(out.size() == 4);
+    CHECK(out[0].start_sample == 0);
+    CHECK(out[0].end_sample == SAMPLE_RATE);
+    CHECK(out[1].start == Catch::Approx(2.0));
+    CHECK(out[1].end == Catch::Approx(3.9));
+    CHECK(out[2].start == Catch::Approx(5.1));
+    CHECK(out[2].end == Catch::Approx(6.0));
+    CHECK(out[3].start == Catch::Approx(8.0));
+    CHECK(out[3].end == Catch::Approx(9.0));
+
+    // Slivers under the minimum are dropped; no spans leaves them as is.
+    CHECK(subtract_spans({seg(0, 1)}, {{0.1, 1}}).empty());
+    CHECK(subtract_spans(segments, {}).size() == segments.size());
+}
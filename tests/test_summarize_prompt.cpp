@@ -4,6 +4,13 @@
 #include <catch2/catch_test_macros.hpp>
 #include "summarize.h"
 
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
 using namespace recmeet;
 
 TEST_CASE("build_user_prompt: contains all required section headings", "[summarize]") {
@@ -67,3 +74,325 @@ TEST_CASE("build_user_prompt: escapes correctly for JSON embedding", "[summarize
     // But should have escaped newline sequences
     CHECK(escaped.find("\\n") != std::string::npos);
 }
+
+namespace {
+
+std::string turn(int sec, const std::string& speaker, const std::string& text) {
+    char ts[48];
+    std::snprintf(ts, sizeof(ts), "[%02d:%02d - %02d:%02d] ", sec / 60, sec % 60,
+                  (sec + 4) / 60, (sec + 4) % 60);
+    return ts + speaker + ": " + text + "\n";
+}
+
+} // namespace
+
+TEST_CASE("split_transcript: parts fit, cover the transcript and end on lines", "[summarize]") {
+    std::string transcript;
+    for (int i = 0; i < 60; ++i)
+        transcript += turn(i * 5, i / 3 % 2 ? "Speaker_01" : "Speaker_02",
+                           "point number " + std::to_string(i) + " about the release");
+
+    // Three-line turns: every 500-char part has a change of speaker in its
+    // second half to cut at.
+    const auto parts = split_transcript(transcript, 500);
+    REQUIRE(parts.size() > 1);
+    std::string joined;
+    for (const auto& p : parts) {
+        CHECK(p.size() <= 500);
+        CHECK(p.back() == '\n');
+        joined += p;
+    }
+    CHECK(joined == transcript);
+
+    size_t at_turns = 0;
+    for (size_t i = 1; i < parts.size(); ++i) {
+        const auto& prev = parts[i - 1];
+        const auto last_line = prev.substr(prev.rfind('\n', prev.size() - 2) + 1);
+        const bool prev_one = last_line.find("Speaker_01") != std::string::npos;
+        const bool next_one = parts[i].find("Speaker_01") < parts[i].find('\n');
+        if (prev_one != next_one) ++at_turns;
+    }
+    CHECK(at_turns == parts.size() - 1);
+
+    CHECK(split_transcript(transcript, transcript.size()).size() == 1);
+    CHECK(split_transcript("", 100).empty());
+}
+
+TEST_CASE("split_transcript: a line longer than a part splits at spaces", "[summarize]") {
+    std::string line = "[00:00 - 09:59] Speaker_01:";
+    for (int i = 0; i < 50; ++i) line += " word" + std::to_string(i);
+    line += "\n";
+
+    const auto parts = split_transcript(line, 60);
+    REQUIRE(parts.size() > 1);
+    std::string joined;
+    for (const auto& p : parts) {
+        CHECK(p.size() <= 60);
+        joined += p;
+    }
+    CHECK(joined == line);
+    for (size_t i = 0; i + 1 < parts.size(); ++i) CHECK(parts[i].back() == ' ');
+}
+
+TEST_CASE("summarize_map_reduce: maps every part, merges, then reduces", "[summarize]") {
+    std::string transcript;
+    for (int i = 0; i < 40; ++i)
+        transcript += turn(i * 5, i % 2 ? "Speaker_01" : "Speaker_02",
+                           "item " + std::to_string(i));
+
+    std::mutex mu;
+    std::vector<std::string> seen;
+    auto complete = [&](const std::string& prompt) {
+        std::lock_guard<std::mutex> lock(mu);
+        seen.push_back(prompt);
+        if (prompt.find("## Transcript (part") != std::string::npos) return std::string(40, 'n');
+        if (prompt.find("Merge them") != std::string::npos) return std::string(40, 'm');
+        return std::string("Title: Done\n\n### Overview\nAll parts.");
+    };
+
+    // Short enough for one prompt: the single-shot prompt, unchanged.
+    auto single = summarize_map_reduce("short", "ctx", 1000, complete, 4);
+    REQUIRE(seen.size() == 1);
+    CHECK(seen[0] == build_user_prompt("short", "ctx"));
+    seen.clear();
+
+    auto parts = split_transcript(transcript, 200);
+    REQUIRE(parts.size() >= 6);
+    auto summary = summarize_map_reduce(transcript, "Agenda: release", 200, complete, 4);
+    CHECK(summary.find("### Overview") != std::string::npos);
+
+    size_t maps = 0, merges = 0, reduces = 0;
+    for (const auto& p : seen) {
+        if (p.find("## Transcript (part") != std::string::npos) {
+            ++maps;
+            CHECK(p.find("Agenda: release") != std::string::npos);
+        } else if (p.find("Merge them") != std::string::npos) {
+            ++merges;
+        } else {
+            ++reduces;
+            CHECK(p.find("## Metadata") != std::string::npos);
+            CHECK(p.find("## Notes") != std::string::npos);
+        }
+    }
+    CHECK(maps == parts.size());
+    CHECK(merges > 0);  // 40-char notes: six or more do not fit 200 chars together
+    CHECK(reduces == 1);
+    CHECK(seen.back().find("## Required Sections") != std::string::npos);
+}
+
+TEST_CASE("summarize_map_reduce: a failed part fails the summary", "[summarize]") {
+    std::string transcript;
+    for (int i = 0; i < 20; ++i) transcript += turn(i * 5, "Speaker_01", "item");
+    auto complete = [](const std::string& prompt) -> std::string {
+        if (prompt.find("part 2 of") != std::string::npos) throw RecmeetError("HTTP 500");
+        return "notes";
+    };
+    CHECK_THROWS_AS(summarize_map_reduce(transcript, "", 200, complete, 3), RecmeetError);
+}
+
+TEST_CASE("summarize_map_reduce: only the summary goes through final_complete", "[summarize]") {
+    std::string transcript;
+    for (int i = 0; i < 20; ++i) transcript += turn(i * 5, "Speaker_01", "item");
+    std::atomic<int> plain{0}, final{0};
+    auto complete = [&](const std::string&) {
+        ++plain;
+        return std::string("notes");
+    };
+    auto streamed = [&](const std::string& prompt) {
+        ++final;
+        CHECK(prompt.find("## Required Sections") != std::string::npos);
+        return std::string("Title: Done");
+    };
+    CHECK(summarize_map_reduce("short", "", 1000, complete, 1, streamed) == "Title: Done");
+    CHECK(plain == 0);
+    CHECK(final == 1);
+
+    CHECK(summarize_map_reduce(transcript, "", 200, complete, 2, streamed) == "Title: Done");
+    CHECK(plain == static_cast<int>(split_transcript(transcript, 200).size()));
+    CHECK(final == 2);
+}
+
+TEST_CASE("summarize_map_reduce: a checkpoint resumes after a failed part", "[summarize]") {
+    struct MemoryCheckpoint : SummaryCheckpoint {
+        std::mutex mu;
+        std::map<std::string, std::string> by_prompt;
+        bool find(const std::string& prompt, std::string& response) override {
+            std::lock_guard<std::mutex> lock(mu);
+            auto it = by_prompt.find(prompt);
+            if (it == by_prompt.end()) return false;
+            response = it->second;
+            return true;
+        }
+        void put(const std::string& prompt, const std::string& response) override {
+            std::lock_guard<std::mutex> lock(mu);
+            by_prompt[prompt] = response;
+        }
+    } checkpoint;
+
+    std::string transcript;
+    for (int i = 0; i < 20; ++i) transcript += turn(i * 5, "Speaker_01", "item");
+    const size_t parts = split_transcript(transcript, 200).size();
+    REQUIRE(parts >= 4);
+
+    std::atomic<int> calls{0};
+    bool fail = true;
+    auto complete = [&](const std::string& prompt) -> std::string {
+        if (fail && prompt.find("part 3 of") != std::string::npos) throw RecmeetError("killed");
+        ++calls;
+        return prompt.find("## Required Sections") != std::string::npos ? "Title: Done" : "notes";
+    };
+    set_summary_checkpoint(&checkpoint);
+    CHECK_THROWS_AS(summarize_map_reduce(transcript, "", 200, complete, 1), RecmeetError);
+    CHECK(checkpoint.by_prompt.size() == 2);
+
+    // Parts 1 and 2 come from the checkpoint; the rest and the reduce run.
+    fail = false;
+    calls = 0;
+    CHECK(summarize_map_reduce(transcript, "", 200, complete, 1) == "Title: Done");
+    CHECK(calls == static_cast<int>(parts - 2 + 1));
+    CHECK(checkpoint.by_prompt.size() == parts);
+    set_summary_checkpoint(nullptr);
+
+    calls = 0;
+    summarize_map_reduce(transcript, "", 200, complete, 1);
+    CHECK(calls == static_cast<int>(parts + 1));
+}
+
+TEST_CASE("build_rolling_prompt: first step, then notes plus the new transcript",
+          "[summarize]") {
+    const std::string first = build_rolling_prompt("", "[00:01 - 00:04] We ship Friday.\n",
+                                                   "Release sync");
+    CHECK(first.find("still going on") != std::string::npos);
+    CHECK(first.find("### Action Items") != std::string::npos);
+    CHECK(first.find("Release sync") != std::string::npos);
+    CHECK(first.find("We ship Friday.") != std::string::npos);
+    CHECK(first.find("## Notes so far") == std::string::npos);
+
+    const std::string next = build_rolling_prompt("- ship Friday", "[10:00 - 10:04] Slip it.\n");
+    CHECK(next.find("## Notes so far\n\n- ship Friday") != std::string::npos);
+    CHECK(next.find("## Transcript since\n\n[10:00 - 10:04] Slip it.") != std::string::npos);
+    CHECK(next.find("## Pre-Meeting Context") == std::string::npos);
+}
+
+TEST_CASE("build_refine_prompt: the summary format over notes and the tail", "[summarize]") {
+    const std::string p = build_refine_prompt("- ship Friday", "[30:00 - 30:04] Done.\n");
+    CHECK(p.find("## Required Sections") != std::string::npos);
+    CHECK(p.find("Title: <short descriptive meeting title") != std::string::npos);
+    CHECK(p.find("## Notes\n\n- ship Friday") != std::string::npos);
+    CHECK(p.find("## Transcript (final part)\n\n[30:00 - 30:04] Done.") != std::string::npos);
+    CHECK(build_refine_prompt("- x", "").find("(final part)\n\nNone.") != std::string::npos);
+}
+
+TEST_CASE("transcript_speakers / anonymize_speakers: labels by first appearance",
+          "[summarize]") {
+    const std::string t = "[00:00 - 00:04] Bob:  Hi: all.\n"
+                          "[00:04 - 00:08] Alice Wong:  Hello Bob.\n"
+                          "[00:08 - 00:09] Bob:  Ok.\n"
+                          "[00:09 - 00:10]  Note: no label here\n";
+    CHECK(transcript_speakers(t) == std::vector<std::string>{"Bob", "Alice Wong"});
+    CHECK(anonymize_speakers(t) == "[00:00 - 00:04] #1:  Hi: all.\n"
+                                   "[00:04 - 00:08] #2:  Hello Bob.\n"
+                                   "[00:08 - 00:09] #1:  Ok.\n"
+                                   "[00:09 - 00:10]  Note: no label here\n");
+    CHECK(anonymize_speakers("[00:00 - 00:04] Carol:  Hi.") == "[00:00 - 00:04] #1:  Hi.");
+    CHECK(transcript_speakers("[00:00 - 00:04]  plain text\n").empty());
+}
+
+TEST_CASE("rename_speakers: whole words, all at once", "[summarize]") {
+    const std::vector<std::string> from = {"Speaker_01", "Bob", "Bob Smith"};
+    const std::vector<std::string> to = {"Alice", "Speaker_01", "Robert"};
+    CHECK(rename_speakers("**[Speaker_01]** asks Bob; Bob Smith and Bobby agree.", from, to) ==
+          "**[Alice]** asks Speaker_01; Robert and Bobby agree.");
+    CHECK(rename_speakers("Speaker_010 stays", from, to) == "Speaker_010 stays");
+    CHECK(rename_speakers("Bob", {"Bob", "Ann"}, {"Ann", "Bob"}) == "Ann");
+    CHECK(rename_speakers("Ann and Bob", {"Bob", "Ann"}, {"Ann", "Bob"}) == "Bob and Ann");
+    CHECK(rename_speakers("Zoë spoke", {"Zoë"}, {"Zoe"}) == "Zoe spoke");
+    CHECK(rename_speakers("unchanged", {}, {}) == "unchanged");
+}
+
+TEST_CASE("consume_sse_deltas: joins content chunks across reads", "[summarize]") {
+    const std::string stream =
+        ": keep-alive\n\n"
+        "data: {\"choices\":[{\"delta\":{\"role\":\"assistant\",\"content\":null}}]}\n\n"
+        "data: {\"choices\":[{\"delta\":{\"content\":\"Title: \"}}]}\r\n\r\n"
+        "data: {\"choices\":[{\"delta\":{\"content\":\"Sync\\n\\n### \\\"Overview\\\"\"}}]}\n\n"
+        "data: {\"choices\":[{\"delta\":{},\"finish_reason\":\"stop\"}]}\n\n"
+        "data: [DONE]\n\n"
+        "data: {\"choices\":[{\"delta\":{\"content\":\"after done\"}}]}\n\n";
+
+    // Fed a few bytes at a time, as curl may hand it over.
+    std::string buffer, text;
+    bool done = false;
+    for (size_t at = 0; at < stream.size(); at += 7) {
+        buffer += stream.substr(at, 7);
+        text += consume_sse_deltas(buffer, done);
+    }
+    CHECK(done);
+    CHECK(text == "Title: Sync\n\n### \"Overview\"");
+
+    // A partial line waits for the rest.
+    buffer = "data: {\"content\":\"par";
+    done = false;
+    CHECK(consume_sse_deltas(buffer, done).empty());
+    CHECK(buffer == "data: {\"content\":\"par");
+    buffer += "tial\"}\n";
+    CHECK(consume_sse_deltas(buffer, done) == "partial");
+    CHECK(buffer.empty());
+    CHECK_FALSE(done);
+}
+
+TEST_CASE("local_context_tokens: sized to the prompt, rounded, capped", "[summarize]") {
+    CHECK(local_context_tokens(1000, 4096, 32768) == 5120);
+    CHECK(local_context_tokens(4, 4096, 32768) == 4352);
+    CHECK(local_context_tokens(1024, 1024, 32768) == 2048);
+    CHECK(local_context_tokens(30000, 4096, 32768) == 32768);
+    CHECK(local_context_tokens(100, 4096, 4096) == 4096);
+}
+
+TEST_CASE("fit_gpu_layers: partial offload when the model does not fit", "[summarize]") {
+    constexpr uint64_t MB = 1ull << 20;
+    // 32 layers of 140 MB on a 4 GB card with 512 MB held back.
+    CHECK(fit_gpu_layers(32, 140 * MB, 4096 * MB, 512 * MB) == 25);
+    CHECK(fit_gpu_layers(32, 140 * MB, 24576 * MB, 512 * MB) == 33);  // all of it
+    CHECK(fit_gpu_layers(32, 140 * MB, 512 * MB, 512 * MB) == 0);
+    CHECK(fit_gpu_layers(32, 0, 4096 * MB, 512 * MB) == 0);
+    CHECK(fit_gpu_layers(0, 140 * MB, 4096 * MB, 512 * MB) == 0);
+}
+
+TEST_CASE("compact_transcript: merges turns, drops fillers and repeats", "[summarize]") {
+    const std::string in =
+        "[00:00 - 00:04] Alice: Um, so we need to ship.\n"
+        "[00:04 - 00:08] Alice: I think I think the build is [BLANK_AUDIO] fine.\n"
+        "[00:08 - 00:09] Alice: I think I think the build is fine.\n"
+        "[00:09 - 00:12] Bob: uh yes yes yes yes.\n"
+        "[00:12 - 00:15] Bob: (laughs) Okay.\n";
+    CompactionStats stats;
+    const std::string out = compact_transcript(in, &stats);
+    CHECK(out == "[00:00] Alice: so we need to ship. I think the build is fine.\n"
+                 "[00:09] Bob: yes Okay.\n");
+    CHECK(stats.lines == 5);
+    CHECK(stats.turns == 2);
+    CHECK(stats.fillers == 4);
+    CHECK(stats.repeats > 0);
+    CHECK(stats.chars_in == in.size());
+    CHECK(stats.chars_out == out.size());
+}
+
+TEST_CASE("compact_transcript: long turns split, other lines pass through", "[summarize]") {
+    const std::string in =
+        "## Notes\n"
+        "[00:00 - 01:10] Alice: First part.\n"
+        "[01:10 - 02:10] Alice: Second part.\n"
+        "[02:10 - 02:20] Alice: Third part.\n"
+        "\n"
+        "[01:00:00 - 01:00:04] Later words.\n";
+    CHECK(compact_transcript(in) ==
+          "## Notes\n"
+          "[00:00] Alice: First part. Second part.\n"
+          "[02:10] Alice: Third part.\n"
+          "\n"
+          "[01:00:00] Later words.\n");
+    // Doubled words are kept: "that that" is often meant.
+    CHECK(compact_transcript("[00:00 - 00:02] A: I know that that works.\n") ==
+          "[00:00] A: I know that that works.\n");
+}
@@ -0,0 +1,91 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "thread_budget.h"
+#include "stage_perf.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace recmeet;
+
+namespace {
+
+// Restores the default budget and drops the tallies a case left.
+struct BudgetGuard {
+    explicit BudgetGuard(int threads) {
+        set_thread_budget(threads);
+        take_thread_usage();
+    }
+    ~BudgetGuard() {
+        set_thread_budget(0);
+        take_thread_usage();
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("lease_threads: overlapping engines share the budget", "[thread_budget]") {
+    BudgetGuard guard(8);
+    CHECK(thread_budget() == 8);
+
+    ThreadLease diarize = lease_threads("diarize", 6);
+    CHECK(diarize.threads() == 6);
+    ThreadLease whisper = lease_threads("whisper", 8);
+    CHECK(whisper.threads() == 2);  // what diarization left
+    CHECK(threads_in_use() == 8);
+
+    // A spent budget still grants one thread: engines never wait.
+    ThreadLease vad = lease_threads("vad", 4);
+    CHECK(vad.threads() == 1);
+    CHECK(threads_in_use() == 9);
+
+    vad.release();
+    CHECK(vad.threads() == 0);
+    diarize.release();
+    CHECK(threads_in_use() == 2);
+    CHECK(lease_threads("identify", 8).threads() == 6);
+    CHECK(threads_in_use() == 2);  // the temporary returned its threads
+
+    // Moving a lease moves its threads, not a second claim on them.
+    ThreadLease moved = std::move(whisper);
+    CHECK(moved.threads() == 2);
+    CHECK(whisper.threads() == 0);
+    CHECK(threads_in_use() == 2);
+    moved = ThreadLease{};
+    CHECK(threads_in_use() == 0);
+
+    CHECK(lease_threads("summarize", 0).threads() == 1);
+    set_thread_budget(0);
+    CHECK(thread_budget() == default_thread_count());
+}
+
+TEST_CASE("take_thread_usage: per-engine leases, threads and CPU share", "[thread_budget]") {
+    BudgetGuard guard(4);
+    {
+        const ThreadLease a = lease_threads("llama", 3);
+        const ThreadLease b = lease_threads("llama", 3);  // gets 1
+        const auto t0 = std::chrono::steady_clock::now();
+        volatile double sink = 0;
+        while (std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(50))
+            sink = sink + 1;
+    }
+    const auto usage = take_thread_usage();
+    REQUIRE(usage.count("llama") == 1);
+    const ThreadUse& u = usage.at("llama");
+    CHECK(u.leases == 2);
+    CHECK(u.peak_threads == 3);
+    CHECK(u.held_sec >= 0.09);        // two leases of ~50 ms
+    CHECK(u.thread_sec >= 4 * 0.045);  // 3 + 1 threads over them
+    CHECK(u.cpu_sec > 0.02);           // the busy loop, all of it theirs
+    CHECK(take_thread_usage().empty());
+
+    const auto records = thread_perf_records(usage);
+    REQUIRE(records.size() == 1);
+    CHECK(records[0].stage == "threads.llama");
+    CHECK(records[0].calls == 2);
+    CHECK(records[0].threads == 2);  // 4 thread-leases over 2 held
+    CHECK(records[0].utilization() > 0);
+    CHECK(records[0].utilization() <= 1.0);
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "trace.h"
+#include "test_tmpdir.h"
+
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <thread>
+
+using namespace recmeet;
+
+namespace {
+
+std::string read_file(const fs::path& path) {
+    std::ifstream in(path);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+size_t count(const std::string& s, const std::string& what) {
+    size_t n = 0;
+    for (size_t pos = s.find(what); pos != std::string::npos; pos = s.find(what, pos + 1)) ++n;
+    return n;
+}
+
+} // anonymous namespace
+
+TEST_CASE("trace: spans and counters are written as trace events", "[trace]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_trace");
+    fs::remove_all(tmp);
+    fs::create_directories(tmp);
+    const fs::path out = tmp / "run.json";
+
+    // Before the trace starts nothing is recorded, even when a span
+    // outlives trace_start().
+    CHECK_FALSE(trace_enabled());
+    TraceSpan early("early");
+    { TraceSpan ignored("ignored"); }
+    trace_counter("ignored_counter", 1);
+
+    trace_start(out);
+    CHECK(trace_enabled());
+    early.end();
+    {
+        TraceSpan outer("outer");
+        TraceSpan chunk("chunk", 3);
+        trace_counter("tokens", 42);
+    }
+    std::thread([] { TraceSpan worker("worker_span"); }).join();
+    trace_completed("stage_from_perf", 0.25);
+    REQUIRE(trace_stop());
+    CHECK_FALSE(trace_enabled());
+    { TraceSpan after("after_stop"); }
+
+    const std::string json = read_file(out);
+    CHECK(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+    CHECK(count(json, "\"name\":\"outer\",\"ph\":\"X\"") == 1);
+    CHECK(count(json, "\"args\":{\"index\":3}") == 1);
+    CHECK(count(json, "\"name\":\"tokens\",\"ph\":\"C\"") == 1);
+    CHECK(count(json, "\"args\":{\"value\":42}") == 1);
+    CHECK(count(json, "\"name\":\"stage_from_perf\"") == 1);
+    CHECK(count(json, "\"dur\":250000") == 1);
+    CHECK(count(json, "\"name\":\"process_name\"") == 1);
+    CHECK(json.find("early") == std::string::npos);
+    CHECK(json.find("ignored") == std::string::npos);
+    CHECK(json.find("after_stop") == std::string::npos);
+
+    // The worker's span carries its own thread ID.
+    auto tid_of = [&](const std::string& name) {
+        auto pos = json.find("\"name\":\"" + name + "\"");
+        REQUIRE(pos != std::string::npos);
+        pos = json.find("\"tid\":", pos);
+        return json.substr(pos, json.find_first_of(",}", pos) - pos);
+    };
+    CHECK(tid_of("worker_span") != tid_of("outer"));
+
+    // A second trace starts empty.
+    trace_start(out);
+    { TraceSpan second("second_run"); }
+    REQUIRE(trace_stop());
+    const std::string again = read_file(out);
+    CHECK(count(again, "\"name\":\"second_run\"") == 1);
+    CHECK(again.find("\"name\":\"outer\"") == std::string::npos);
+    CHECK(trace_stop());  // no trace running
+    fs::remove_all(tmp);
+}
@@ -3,6 +3,8 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include "transcribe.h"
+#include "transcript_store.h"
+#include "diarize.h"
 #include "pipeline.h"
 
 #include <type_traits>
@@ -133,3 +135,216 @@ TEST_CASE("vad_weighted_progress: past-end segment index", "[transcribe]") {
     // Index past end — all previous done
     CHECK(vad_weighted_progress(2, 0, seg_samples) == 100);
 }
+
+// ---------------------------------------------------------------------------
+// resolve_transcribe_workers
+// ---------------------------------------------------------------------------
+
+TEST_CASE("resolve_transcribe_workers: auto scales with the thread budget", "[transcribe]") {
+    CHECK(resolve_transcribe_workers(0, 1, 100) == 1);
+    CHECK(resolve_transcribe_workers(0, 7, 100) == 1);
+    CHECK(resolve_transcribe_workers(0, 8, 100) == 2);
+    CHECK(resolve_transcribe_workers(0, 32, 100) == TRANSCRIBE_MAX_AUTO_WORKERS);
+    CHECK(resolve_transcribe_workers(0, 256, 100) == TRANSCRIBE_MAX_AUTO_WORKERS);
+}
+
+TEST_CASE("resolve_transcribe_workers: explicit count is clamped", "[transcribe]") {
+    CHECK(resolve_transcribe_workers(3, 16, 100) == 3);
+    CHECK(resolve_transcribe_workers(12, 16, 100) == 12);  // explicit may exceed the auto cap
+    CHECK(resolve_transcribe_workers(8, 4, 100) == 4);     // at least one thread each
+    CHECK(resolve_transcribe_workers(8, 16, 2) == 2);      // no idle workers
+    CHECK(resolve_transcribe_workers(-1, 16, 100) == 4);      // negative = auto
+}
+
+TEST_CASE("resolve_transcribe_workers: never below one", "[transcribe]") {
+    CHECK(resolve_transcribe_workers(4, 16, 0) == 1);
+    CHECK(resolve_transcribe_workers(0, 16, 1) == 1);
+    CHECK(resolve_transcribe_workers(1, 1, 1) == 1);
+}
+
+// ---------------------------------------------------------------------------
+// pack_windows / PackedWindow
+// ---------------------------------------------------------------------------
+
+TEST_CASE("pack_windows: packs consecutive segments up to the window size", "[transcribe]") {
+    const size_t S = SAMPLE_RATE;
+    std::vector<TranscribeWindow> segs = {
+        {0, 2 * S},           // 0-2 s
+        {3 * S, 4 * S},       // 3-7 s: 1 s gap, packed as 0.5 s
+        {7 * S + 800, S},     // 50 ms gap kept as-is
+        {40 * S, 25 * S},     // 25 s: would push the first window past 30 s
+        {66 * S, 4 * S},
+    };
+    auto packed = pack_windows(segs);
+    REQUIRE(packed.size() == 2);
+
+    const auto& a = packed[0];
+    REQUIRE(a.pieces.size() == 3);
+    CHECK(a.pieces[0].offset == 0);
+    CHECK(a.pieces[1].offset == 2 * S + PACK_MAX_GAP_SAMPLES);
+    CHECK(a.pieces[2].offset == 6 * S + PACK_MAX_GAP_SAMPLES + 800);
+    CHECK(a.length == 7 * S + PACK_MAX_GAP_SAMPLES + 800);
+
+    const auto& b = packed[1];
+    REQUIRE(b.pieces.size() == 2);
+    CHECK(b.pieces[0].start == 40 * S);
+    CHECK(b.pieces[0].offset == 0);
+    CHECK(b.length == 29 * S + PACK_MAX_GAP_SAMPLES);
+    CHECK(b.length <= WHISPER_WINDOW_SAMPLES);
+}
+
+TEST_CASE("pack_windows: oversized and empty segments", "[transcribe]") {
+    const size_t S = SAMPLE_RATE;
+    auto packed = pack_windows({{0, 40 * S}, {41 * S, 0}, {42 * S, S}});
+    REQUIRE(packed.size() == 2);
+    CHECK(packed[0].length == 40 * S);  // alone, never split
+    CHECK(packed[1].pieces.size() == 1);
+    CHECK(pack_windows({}).empty());
+}
+
+TEST_CASE("PackedWindow: timestamps map back to the source", "[transcribe]") {
+    const size_t S = SAMPLE_RATE;
+    // Pieces at source 10-12 s and 20-21 s, laid out at 0-2 s and 2.5-3.5 s.
+    auto packed = pack_windows({{10 * S, 2 * S}, {20 * S, S}});
+    REQUIRE(packed.size() == 1);
+    const auto& w = packed[0];
+
+    CHECK(w.to_source_seconds(0.0, false) == 10.0);
+    CHECK(w.to_source_seconds(1.5, false) == 11.5);
+    CHECK(w.to_source_seconds(2.0, true) == 12.0);     // end of first piece
+    CHECK(w.to_source_seconds(2.2, false) == 20.0);    // gap -> next piece start
+    CHECK(w.to_source_seconds(2.2, true) == 12.0);     // gap -> previous piece end
+    CHECK(w.to_source_seconds(3.0, false) == 20.5);
+    CHECK(w.to_source_seconds(9.0, true) == 21.0);     // past the end
+}
+
+// ---------------------------------------------------------------------------
+// Two-pass transcription
+// ---------------------------------------------------------------------------
+
+TEST_CASE("draft_window_confident: every segment must clear both thresholds", "[transcribe]") {
+    TranscriptResult r{};
+    CHECK_FALSE(draft_window_confident(r, -0.5f));  // VAD found speech, draft found none
+
+    r.segments = {{0.0, 2.0, "Hello", -0.2f, 0.05f}, {2.0, 4.0, "there", -0.4f, 0.1f}};
+    CHECK(draft_window_confident(r, -0.5f));
+    CHECK_FALSE(draft_window_confident(r, -0.3f));
+
+    r.segments[1].no_speech_prob = 0.7f;
+    CHECK_FALSE(draft_window_confident(r, -0.5f));
+}
+
+TEST_CASE("DraftPassStats: projects the full-model time from the re-decode", "[transcribe]") {
+    DraftPassStats s;
+    s.windows = 10;
+    s.samples = 1000;
+    s.draft_sec = 20.0;
+    CHECK(s.full_estimate_sec() < 0.0);  // nothing re-decoded: no measurement
+    CHECK(s.saved_sec() == 0.0);
+
+    s.redecoded = 2;
+    s.redecoded_samples = 250;
+    s.redecode_sec = 30.0;
+    CHECK(s.full_estimate_sec() == 120.0);
+    CHECK(s.saved_sec() == 70.0);
+}
+
+TEST_CASE("leading_speech: takes speech up to the limit", "[transcribe]") {
+    const std::vector<TranscribeWindow> windows = {{100, 50}, {400, 0}, {500, 80}, {900, 30}};
+    auto lead = leading_speech(windows, 100);
+    REQUIRE(lead.size() == 2);
+    CHECK(lead[0].start == 100);
+    CHECK(lead[0].n == 50);
+    CHECK(lead[1].start == 500);  // empty window skipped
+    CHECK(lead[1].n == 50);       // shortened to fit
+
+    CHECK(leading_speech(windows, 1000).size() == 3);
+    CHECK(leading_speech(windows, 0).empty());
+    CHECK(leading_speech({}, 100).empty());
+}
+
+TEST_CASE("RepetitionDetector: finds a phrase looping across segments", "[transcribe]") {
+    RepetitionDetector d;
+    CHECK_FALSE(d.feed("Let's go over the budget first."));
+    CHECK_FALSE(d.feed("Thank you."));
+    CHECK_FALSE(d.feed("Thank you."));
+    // Twelve words of "thank you" in a row: six copies of the 2-gram.
+    CHECK_FALSE(d.feed("thank you thank you"));
+    CHECK(d.feed("Thank you, thank you."));
+    CHECK(d.looped());
+    // The first "Thank you." stays; the copies after it do not.
+    CHECK(d.segments_before_loop() == 2);
+    // Once looped, further text changes nothing.
+    CHECK(d.feed("Next item."));
+    CHECK(d.segments_before_loop() == 2);
+}
+
+TEST_CASE("RepetitionDetector: short repeats and varied speech are not loops", "[transcribe]") {
+    RepetitionDetector d;
+    CHECK_FALSE(d.feed("No, no, no, that's not what I meant."));
+    CHECK_FALSE(d.feed("We said the report, the report, the report is due Friday."));
+    CHECK_FALSE(d.feed("Okay. Okay. Okay."));
+    CHECK_FALSE(d.looped());
+    CHECK(d.segments_before_loop() == 3);
+
+    // A single word needs REPEAT_MIN_WORDS copies.
+    RepetitionDetector w;
+    std::string eleven;
+    for (int i = 0; i < 11; ++i) eleven += "la ";
+    CHECK_FALSE(w.feed(eleven));
+    CHECK(w.feed("La."));
+    CHECK(w.segments_before_loop() == 0);
+}
+
+// ---------------------------------------------------------------------------
+// TranscriptStore
+// ---------------------------------------------------------------------------
+
+TEST_CASE("TranscriptStore: spans into one buffer, trimmed", "[transcript_store]") {
+    TranscriptStore store;
+    store.add(0.0, 2.0, "  Hello there \n", -0.5f, 0.1f);
+    store.add(2.0, 4.0, "General Kenobi");
+    REQUIRE(store.size() == 2);
+    CHECK(store.text(0) == "Hello there");
+    CHECK(store.text(1) == "General Kenobi");
+    CHECK(store.text_bytes() == 25);
+    CHECK(store.speaker(0) == -1);
+    CHECK(store.label(0).empty());
+    const auto segs = store.segments();
+    CHECK(segs[0].text == "Hello there");
+    CHECK(segs[0].avg_logprob == -0.5f);
+    CHECK(segs[0].no_speech_prob == 0.1f);
+}
+
+TEST_CASE("TranscriptStore: render matches to_string after label_speakers", "[transcript_store]") {
+    std::vector<TranscriptSegment> segs = {
+        {0.0, 5.0, "Good morning."}, {5.0, 9.5, "Morning."}, {3725.0, 3731.0, "Bye."}};
+    const std::vector<int> speakers = {0, 1, 0};
+    const std::map<int, std::string> names = {{0, "Alice"}};
+
+    TranscriptStore store(segs);
+    TranscriptResult plain{};
+    plain.segments = segs;
+    CHECK(store.render() == plain.to_string());
+
+    store.set_speakers(speakers, names);
+    TranscriptResult labelled{};
+    labelled.segments = label_speakers(segs, speakers, names);
+    CHECK(store.render() == labelled.to_string());
+    CHECK(store.label(1) == "Speaker_02");
+    CHECK(store.render_after(5.0) ==
+          "[00:05 - 00:09] Speaker_02: Morning.\n[62:05 - 62:11] Alice: Bye.\n");
+
+    store.set_speakers({});
+    CHECK(store.render() == plain.to_string());
+}
+
+TEST_CASE("TranscriptStore: speakers for a prefix label only it", "[transcript_store]") {
+    TranscriptStore store(std::vector<TranscriptSegment>{{0, 1, "a"}, {1, 2, "b"}});
+    store.set_speakers({2, 3, 4});
+    CHECK(store.speaker(1) == 3);
+    CHECK(store.render() == "[00:00 - 00:01] Speaker_03: a\n[00:01 - 00:02] Speaker_04: b\n");
+    store.set_speakers({2});
+    CHECK(store.speaker(1) == -1);
+    CHECK(store.render() == "[00:00 - 00:01] Speaker_03: a\n[00:01 - 00:02] b\n");
+}
@@ -144,6 +144,39 @@ TEST_CASE("write_text_file: overwrites existing file", "[util]") {
     fs::remove_all(dir);
 }
 
+TEST_CASE("write_text_file_atomic: replaces the file and leaves no temp", "[util]") {
+    auto dir = recmeet::test::tmp_path("recmeet_test_write");
+    fs::create_directories(dir);
+    fs::path file = dir / "atomic.json";
+
+    write_text_file_atomic(file, "first");
+    write_text_file_atomic(file, "second");
+
+    std::ifstream in(file);
+    std::string content((std::istreambuf_iterator<char>(in)),
+                         std::istreambuf_iterator<char>());
+    CHECK(content == "second");
+    CHECK_FALSE(fs::exists(dir / "atomic.json.tmp"));
+    CHECK_THROWS_AS(write_text_file_atomic("/nonexistent/path/recmeet_test/a.json", "x"),
+                    RecmeetError);
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("base64: round trip and rejects malformed text", "[util]") {
+    CHECK(base64_encode("") == "");
+    CHECK(base64_encode("f") == "Zg==");
+    CHECK(base64_encode("fo") == "Zm8=");
+    CHECK(base64_encode("foo") == "Zm9v");
+    std::string binary;
+    for (int i = 0; i < 256; ++i) binary += static_cast<char>(i);
+    std::string out;
+    REQUIRE(base64_decode(base64_encode(binary), out));
+    CHECK(out == binary);
+    CHECK_FALSE(base64_decode("Zm9", out));
+    CHECK_FALSE(base64_decode("Zm9*", out));
+}
+
 TEST_CASE("write_text_file: throws for nonexistent directory", "[util]") {
     fs::path file = "/nonexistent/path/recmeet_test/output.txt";
     CHECK_THROWS_AS(write_text_file(file, "data"), RecmeetError);
@@ -281,6 +314,24 @@ TEST_CASE("find_audio_file: prefers timestamped over legacy", "[util]") {
     fs::remove_all(base);
 }
 
+TEST_CASE("find_audio_file: finds archived audio, preferring the WAV", "[util]") {
+    auto base = recmeet::test::tmp_path("recmeet_test_find_audio_archive");
+    fs::remove_all(base);
+    fs::create_directories(base);
+    std::ofstream(base / "audio_2026-02-21_09-41.opus") << "OggS";
+    CHECK(find_audio_file(base) == base / "audio_2026-02-21_09-41.opus");
+
+    std::ofstream(base / "audio_2026-02-21_09-41.flac") << "fLaC";
+    std::ofstream(base / "audio_2026-02-21_09-41.flac.part") << "fLaC";
+    CHECK(find_audio_file(base) == base / "audio_2026-02-21_09-41.flac");
+
+    // Mid-archive both exist: the WAV is still authoritative.
+    std::ofstream(base / "audio_2026-02-21_09-41.wav") << "RIFF";
+    CHECK(find_audio_file(base) == base / "audio_2026-02-21_09-41.wav");
+
+    fs::remove_all(base);
+}
+
 TEST_CASE("find_audio_file: empty directory returns empty", "[util]") {
     auto base = recmeet::test::tmp_path("recmeet_test_find_audio_empty");
     fs::remove_all(base);
@@ -515,6 +566,29 @@ TEST_CASE("write_heartbeat_ndjson: handles zero rss_kb (read failure)", "[util]"
     CHECK(line == "{\"event\":\"heartbeat\",\"data\":{\"rss_kb\":0}}\n");
 }
 
+TEST_CASE("write_heartbeat_ndjson: adds peak_rss_kb when given", "[util]") {
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+
+    CHECK(write_heartbeat_ndjson(fds[1], 12345, 67890) > 0);
+    ::close(fds[1]);
+
+    std::string line = read_pipe_to_string(fds[0]);
+    ::close(fds[0]);
+
+    CHECK(line == "{\"event\":\"heartbeat\",\"data\":{\"rss_kb\":12345,\"peak_rss_kb\":67890}}\n");
+}
+
+TEST_CASE("read_self_peak_rss_kb: at least the current RSS", "[util]") {
+    const long rss = read_self_rss_kb();
+    const long peak = read_self_peak_rss_kb();
+    if (rss == 0 || peak == 0) return;  // no /proc here
+    CHECK(peak >= rss);
+    // Reset or not (clear_refs can be refused), the peak stays readable.
+    reset_self_peak_rss();
+    CHECK(read_self_peak_rss_kb() > 0);
+}
+
 TEST_CASE("write_rss_limit_msg: writes distinctive marker line", "[util]") {
     int fds[2];
     REQUIRE(::pipe(fds) == 0);
@@ -562,6 +636,28 @@ TEST_CASE("parse_memory_property_line: malformed input", "[util][t1c]") {
     CHECK(parse_memory_property_line("garbage") == -1);
 }
 
+TEST_CASE("parse_cgroup_memory_max: bytes, max and malformed", "[util]") {
+    CHECK(parse_cgroup_memory_max("15032385536\n") == 15032385536ull);
+    CHECK(parse_cgroup_memory_max("max\n") == 0);
+    CHECK(parse_cgroup_memory_max("") == 0);
+    CHECK(parse_cgroup_memory_max(nullptr) == 0);
+}
+
+TEST_CASE("pp_worker_should_retire: job count, RSS and failures", "[util]") {
+    // Healthy worker under both limits is kept.
+    CHECK_FALSE(pp_worker_should_retire(1, 8, 0, 2L * 1024 * 1024, 6144));
+    // Job budget spent.
+    CHECK(pp_worker_should_retire(8, 8, 0, 1024, 6144));
+    CHECK(pp_worker_should_retire(1, 1, 0, 1024, 6144));
+    // Left resident above the RSS limit; exactly at it is still fine.
+    CHECK(pp_worker_should_retire(1, 8, 0, 6145L * 1024, 6144));
+    CHECK_FALSE(pp_worker_should_retire(1, 8, 0, 6144L * 1024, 6144));
+    CHECK_FALSE(pp_worker_should_retire(1, 8, 0, 64L * 1024 * 1024, 0));
+    // Failed or cancelled job.
+    CHECK(pp_worker_should_retire(1, 8, 1, 1024, 6144));
+    CHECK(pp_worker_should_retire(1, 8, 2, 1024, 6144));
+}
+
 // ---------------------------------------------------------------------------
 // [meeting-files] find_context_file / find_speakers_file / derive_meeting_timestamp
 // ---------------------------------------------------------------------------
@@ -4,8 +4,12 @@
 #include <catch2/catch_test_macros.hpp>
 #include "vad.h"
 #include "model_manager.h"
+#include "sparse_audio.h"
+#include "test_tmpdir.h"
 
+#include <algorithm>
 #include <cmath>
+#include <fstream>
 
 using namespace recmeet;
 
@@ -50,10 +54,287 @@ TEST_CASE("VadResult: empty segments", "[vad]") {
     CHECK(result.total_speech_duration == 0.0);
 }
 
+// ---------------------------------------------------------------------------
+// Speech-segment index — no model needed
+// ---------------------------------------------------------------------------
+
+namespace {
+
+fs::path vad_tmp_dir() {
+    fs::path dir = recmeet::test::tmp_path("recmeet_vad");
+    fs::create_directories(dir);
+    return dir;
+}
+
+VadResult sample_result() {
+    VadResult r;
+    r.segments.push_back({1600, 8000, 0.1, 0.5});
+    r.segments.push_back({16000, 40000, 1.0, 2.5});
+    r.total_speech_duration = 1.9;
+    r.total_audio_duration = 3.0;
+    return r;
+}
+
+} // namespace
+
+TEST_CASE("vad_index_path: replaces the audio_ prefix", "[vad]") {
+    CHECK(vad_index_path("/m/2026-03-01_10-00/audio_2026-03-01_10-00.wav") ==
+          fs::path("/m/2026-03-01_10-00/vad_2026-03-01_10-00.json"));
+    CHECK(vad_index_path("/m/x/audio_2026-03-01_10-00.flac") ==
+          fs::path("/m/x/vad_2026-03-01_10-00.json"));
+    CHECK(vad_index_path("/m/x/audio.wav") == fs::path("/m/x/vad_audio.json"));
+}
+
+TEST_CASE("save/load_vad_index: round trip", "[vad]") {
+    auto dir = vad_tmp_dir();
+    fs::path p = dir / "vad_test.json";
+    VadConfig cfg;
+    cfg.threshold = 0.35f;
+    save_vad_index(p, sample_result(), SAMPLE_RATE * 3, cfg);
+
+    VadResult got;
+    REQUIRE(load_vad_index(p, SAMPLE_RATE * 3, cfg, got));
+    REQUIRE(got.segments.size() == 2);
+    CHECK(got.segments[0].start_sample == 1600);
+    CHECK(got.segments[0].end_sample == 8000);
+    CHECK(got.segments[1].start == 1.0);
+    CHECK(got.segments[1].end == 2.5);
+    CHECK(got.total_audio_duration == 3.0);
+    CHECK(std::abs(got.total_speech_duration - 1.9) < 1e-9);
+
+    // An empty result round-trips too.
+    save_vad_index(p, VadResult{{}, 0.0, 3.0}, SAMPLE_RATE * 3, cfg);
+    REQUIRE(load_vad_index(p, SAMPLE_RATE * 3, cfg, got));
+    CHECK(got.segments.empty());
+    fs::remove_all(dir);
+}
+
+TEST_CASE("load_vad_index: rejects stale or malformed indexes", "[vad]") {
+    auto dir = vad_tmp_dir();
+    fs::path p = dir / "vad_test.json";
+    VadConfig cfg;
+    save_vad_index(p, sample_result(), SAMPLE_RATE * 3, cfg);
+
+    VadResult got;
+    got.total_audio_duration = -1.0;
+    CHECK_FALSE(load_vad_index(dir / "missing.json", SAMPLE_RATE * 3, cfg, got));
+    CHECK_FALSE(load_vad_index(p, SAMPLE_RATE * 3 + 1, cfg, got));  // audio changed
+
+    VadConfig other = cfg;
+    other.min_silence_duration = 0.75f;
+    CHECK_FALSE(load_vad_index(p, SAMPLE_RATE * 3, other, got));
+
+    // Segment past the end of the audio.
+    CHECK_FALSE(load_vad_index(p, 30000, cfg, got));
+
+    std::ofstream(p) << "{\"version\": 1, \"segments\": [[1, 2]";
+    CHECK_FALSE(load_vad_index(p, SAMPLE_RATE * 3, cfg, got));
+    CHECK(got.total_audio_duration == -1.0);  // untouched on failure
+    fs::remove_all(dir);
+}
+
 // ---------------------------------------------------------------------------
 // Integration tests — require RECMEET_USE_SHERPA and cached VAD model
 // ---------------------------------------------------------------------------
 
+namespace {
+
+VadSegment seg_at(int32_t start, int32_t end) {
+    return {start, end, start / 16000.0, end / 16000.0};
+}
+
+} // namespace
+
+TEST_CASE("CompactedSampleSource: speech back to back, long gaps cut", "[vad]") {
+    std::vector<float> audio(100);
+    for (size_t i = 0; i < audio.size(); ++i) audio[i] = static_cast<float>(i + 1);
+    MemorySampleSource src(audio.data(), audio.size());
+
+    // [10,20) and [22,30) are 2 apart: one piece. [60,70) is 30 past it and
+    // [95,120) runs off the end.
+    CompactedSampleSource speech(src, {seg_at(10, 20), seg_at(22, 30), seg_at(60, 70),
+                                       seg_at(95, 120)},
+                                 /*max_gap=*/4);
+    REQUIRE(speech.pieces().size() == 3);
+    CHECK(speech.pieces()[0].start == 10);
+    CHECK(speech.pieces()[0].n == 20);
+    CHECK(speech.pieces()[1].offset == 24);
+    CHECK(speech.pieces()[2].start == 95);
+    CHECK(speech.pieces()[2].n == 5);
+    CHECK(speech.size() == 20 + 4 + 10 + 4 + 5);
+    CHECK(speech.source_samples() == 35);
+
+    auto all = speech.to_float();
+    REQUIRE(all.size() == speech.size());
+    CHECK(all[0] == 11.0f);
+    CHECK(all[11] == 22.0f);   // the short silence is still there
+    CHECK(all[19] == 30.0f);
+    CHECK(all[20] == 0.0f);    // inserted gap
+    CHECK(all[24] == 61.0f);
+    CHECK(all[42] == 100.0f);
+
+    // A read straddling a gap, and one past the end.
+    std::vector<float> out(8, -1.0f);
+    CHECK(speech.read(18, 8, out.data()) == 8);
+    CHECK(out == std::vector<float>{29, 30, 0, 0, 0, 0, 61, 62});
+    CHECK(speech.read(speech.size(), 8, out.data()) == 0);
+}
+
+TEST_CASE("CompactedSampleSource: spans map back to the source, split at cuts", "[vad]") {
+    std::vector<float> audio(10 * 16000, 0.5f);
+    MemorySampleSource src(audio.data(), audio.size());
+    // 1-2 s and 6-7 s: one 4 s silence cut to 0.5 s.
+    CompactedSampleSource speech(src, {seg_at(16000, 32000), seg_at(96000, 112000)});
+    REQUIRE(speech.pieces().size() == 2);
+    CHECK(speech.size() == 2 * 16000 + COMPACT_MAX_GAP_SAMPLES);
+
+    auto spans = speech.to_source_spans(0.5, 2.0);
+    REQUIRE(spans.size() == 2);
+    CHECK(spans[0].first == 1.5);
+    CHECK(spans[0].second == 2.0);
+    CHECK(spans[1].first == 6.0);
+    CHECK(spans[1].second == 6.5);
+
+    CHECK(speech.to_source_spans(1.1, 1.4).empty());  // inside the inserted gap
+    spans = speech.to_source_spans(1.75, 9.0);
+    REQUIRE(spans.size() == 1);
+    CHECK(spans[0].first == 6.25);
+    CHECK(spans[0].second == 7.0);
+}
+
+TEST_CASE("sparse_pieces: speech padded, merged where the padding meets", "[vad]") {
+    // [10,20) and [26,30) are 6 apart, under twice the pad: one piece.
+    // [95,120) runs off the end; below, [1,3) is padded past 0.
+    auto pieces = sparse_pieces({seg_at(10, 20), seg_at(26, 30), seg_at(60, 70),
+                                 seg_at(95, 120)},
+                                100, /*pad=*/4);
+    REQUIRE(pieces.size() == 3);
+    CHECK(pieces[0].start == 6);
+    CHECK(pieces[0].n == 28);
+    CHECK(pieces[1].start == 56);
+    CHECK(pieces[1].n == 18);
+    CHECK(pieces[1].offset == 28);
+    CHECK(pieces[2].start == 91);
+    CHECK(pieces[2].n == 9);
+    CHECK(pieces[2].offset == 46);
+
+    CHECK(sparse_pieces({seg_at(1, 3)}, 100, 4)[0].start == 0);
+    CHECK(sparse_pieces({}, 100).empty());
+}
+
+TEST_CASE("read_sparse: stored pieces on the original timeline", "[vad]") {
+    SparseAudioIndex index;
+    index.total_samples = 40;
+    index.pieces = sparse_pieces({seg_at(5, 10), seg_at(30, 35)}, 40, 0);
+    std::vector<float> stored(index.stored_samples());
+    for (size_t i = 0; i < stored.size(); ++i) stored[i] = static_cast<float>(i + 1);
+    auto from_stored = [&](size_t pos, size_t n, float* dst) {
+        std::copy_n(stored.data() + pos, n, dst);
+    };
+
+    std::vector<float> out(12, -1.0f);
+    CHECK(read_sparse(index, 0, 12, out.data(), from_stored) == 12);
+    CHECK(out == std::vector<float>{0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 0, 0});
+    CHECK(read_sparse(index, 33, 12, out.data(), from_stored) == 7);  // clamped
+    CHECK(std::vector<float>(out.begin(), out.begin() + 7) ==
+          std::vector<float>{9, 10, 0, 0, 0, 0, 0});
+    CHECK(read_sparse(index, 40, 4, out.data(), from_stored) == 0);
+}
+
+TEST_CASE("save/load_sparse_index: round trip, stale or malformed rejected", "[vad]") {
+    CHECK(sparse_index_path("/m/x/audio_2026-03-01_10-00.flac") ==
+          fs::path("/m/x/sparse_2026-03-01_10-00.bin"));
+
+    auto dir = vad_tmp_dir();
+    fs::path p = dir / "sparse_test.bin";
+    SparseAudioIndex index;
+    index.total_samples = 5u * 3600 * SAMPLE_RATE;  // past 32 bits of bytes
+    index.audio_hash = "0123456789abcdef";
+    index.pieces = sparse_pieces({seg_at(16000, 32000), seg_at(96000, 112000)},
+                                 index.total_samples);
+    save_sparse_index(p, index);
+
+    SparseAudioIndex got;
+    REQUIRE(load_sparse_index(p, index.stored_samples(), got));
+    CHECK(got.total_samples == index.total_samples);
+    CHECK(got.audio_hash == index.audio_hash);
+    REQUIRE(got.pieces.size() == 2);
+    CHECK(got.pieces[1].start == index.pieces[1].start);
+    CHECK(got.pieces[1].n == index.pieces[1].n);
+    CHECK(got.pieces[1].offset == index.pieces[1].offset);
+
+    // The full recording beside the index of an interrupted compaction.
+    got.total_samples = 7;
+    CHECK_FALSE(load_sparse_index(p, index.total_samples, got));
+    CHECK_FALSE(load_sparse_index(dir / "missing.bin", 0, got));
+    std::ofstream(p, std::ios::binary) << "RMSPRS1";
+    CHECK_FALSE(load_sparse_index(p, 0, got));
+    CHECK(got.total_samples == 7);  // untouched on failure
+    fs::remove_all(dir);
+}
+
+TEST_CASE("plan_vad_shards: window-aligned spans that tile the audio", "[vad]") {
+    VadConfig cfg;
+    const std::size_t minute = 60 * SAMPLE_RATE;
+
+    auto one = plan_vad_shards(19 * minute, cfg, 8);  // under two shortest shards
+    REQUIRE(one.size() == 1);
+    CHECK(one[0].feed_start == 0);
+    CHECK(one[0].start == 0);
+    CHECK(one[0].end == 19 * minute);
+    CHECK(one[0].feed_end == 19 * minute);
+    CHECK(plan_vad_shards(90 * minute, cfg, 1).size() == 1);
+
+    const std::size_t samples = 90 * minute + 333;
+    auto shards = plan_vad_shards(samples, cfg, 4);
+    REQUIRE(shards.size() == 4);
+    CHECK(plan_vad_shards(samples, cfg, 16).size() == 9);  // 10-minute shards at least
+
+    const std::size_t tail = static_cast<std::size_t>(
+        (cfg.max_speech_duration + cfg.min_silence_duration) * SAMPLE_RATE);
+    CHECK(shards.front().start == 0);
+    CHECK(shards.back().end == samples);
+    CHECK(shards.back().feed_end == samples);
+    for (std::size_t i = 0; i < shards.size(); ++i) {
+        const auto& s = shards[i];
+        CHECK(s.feed_start % cfg.window_size == 0);
+        CHECK(s.start % cfg.window_size == 0);
+        CHECK(s.feed_start <= s.start);
+        CHECK(s.start < s.end);
+        CHECK(s.end <= s.feed_end);
+        if (i > 0) {
+            CHECK(s.start == shards[i - 1].end);
+            CHECK(s.start - s.feed_start >= VAD_SHARD_LEAD_SAMPLES);
+        }
+        if (i + 1 < shards.size()) {
+            CHECK(s.end % cfg.window_size == 0);
+            CHECK(s.feed_end % cfg.window_size == 0);
+            CHECK(s.feed_end - s.end > tail);
+        }
+    }
+}
+
+TEST_CASE("merge_vad_shards: owned segments only, straddlers joined", "[vad]") {
+    // Two shards cut at 1000; each detector heard 200 samples of the other.
+    const std::vector<VadShard> shards = {{0, 0, 1000, 1200}, {800, 1000, 2000, 2000}};
+    const std::vector<std::vector<VadSegment>> found = {
+        {seg_at(100, 300), seg_at(900, 1150), seg_at(1180, 1200)},  // last: starts in the tail
+        {seg_at(800, 850), seg_at(1000, 1160), seg_at(1500, 1900)},  // first: in the lead
+    };
+    VadResult r = merge_vad_shards(shards, found, 2000);
+    REQUIRE(r.segments.size() == 3);
+    CHECK(r.segments[0].start_sample == 100);
+    CHECK(r.segments[0].end_sample == 300);
+    CHECK(r.segments[1].start_sample == 900);  // both views of the speech at the cut
+    CHECK(r.segments[1].end_sample == 1160);
+    CHECK(r.segments[1].end == 1160 / 16000.0);
+    CHECK(r.segments[2].start_sample == 1500);
+    CHECK(std::abs(r.total_speech_duration - (200 + 260 + 400) / 16000.0) < 1e-12);
+    CHECK(r.total_audio_duration == 2000 / 16000.0);
+
+    CHECK(merge_vad_shards(shards, {{}, {}}, 2000).segments.empty());
+}
+
 #if RECMEET_USE_SHERPA
 #include "model_manager.h"
 #include "audio_file.h"
@@ -90,6 +371,97 @@ TEST_CASE("detect_speech: pure tone is not detected as speech", "[vad][integrati
     CHECK(result.total_audio_duration > 0.0);
 }
 
+namespace {
+
+// A source that exposes only the first `visible` samples, like a spool
+// still being written.
+class GrowingSource : public SampleSource {
+public:
+    explicit GrowingSource(const std::vector<float>& s) : s_(s) {}
+    std::size_t size() const override { return visible; }
+    std::size_t read(std::size_t start, std::size_t n, float* out) const override {
+        if (start >= visible) return 0;
+        n = std::min(n, visible - start);
+        std::copy(s_.begin() + start, s_.begin() + start + n, out);
+        return n;
+    }
+    std::size_t visible = 0;
+
+private:
+    const std::vector<float>& s_;
+};
+
+} // namespace
+
+TEST_CASE("StreamingVad: incremental feed matches detect_speech", "[vad][integration]") {
+    ensure_vad_model();
+
+    // Alternating noise bursts and silence, 337 samples short of a window
+    // multiple so the trailing partial window is exercised.
+    std::vector<float> audio(SAMPLE_RATE * 6 + 337, 0.0f);
+    uint32_t x = 12345;
+    for (std::size_t i = SAMPLE_RATE; i < audio.size(); ++i) {
+        if ((i / SAMPLE_RATE) % 2 == 0) continue;
+        x = x * 1664525u + 1013904223u;
+        audio[i] = 0.3f * (static_cast<float>(x >> 8) / 8388608.0f - 1.0f);
+    }
+
+    auto batch = detect_speech(audio);
+
+    GrowingSource src(audio);
+    StreamingVad vad(src);
+    std::size_t fed = 0;
+    while (src.visible < audio.size()) {
+        src.visible = std::min(audio.size(), src.visible + 3 * 1000 + 17);
+        fed += vad.pump();
+    }
+    CHECK(fed == vad.samples_fed());
+    CHECK(fed % 512 == 0);
+    auto streamed = vad.finish();
+
+    REQUIRE(streamed.segments.size() == batch.segments.size());
+    for (std::size_t i = 0; i < batch.segments.size(); ++i) {
+        CHECK(streamed.segments[i].start_sample == batch.segments[i].start_sample);
+        CHECK(streamed.segments[i].end_sample == batch.segments[i].end_sample);
+    }
+    CHECK(streamed.total_audio_duration == batch.total_audio_duration);
+    CHECK(vad.pump() == 0);  // finished
+}
+
+TEST_CASE("detect_speech_sharded: matches the serial pass within a window",
+          "[vad][integration]") {
+    ensure_vad_model();
+
+    // Four minutes of noise bursts of varying length and spacing, cut into
+    // 40-second shards so several bursts straddle a cut.
+    std::vector<float> audio(SAMPLE_RATE * 240 + 123, 0.0f);
+    uint32_t x = 777;
+    std::size_t pos = SAMPLE_RATE;
+    while (pos < audio.size()) {
+        x = x * 1664525u + 1013904223u;
+        const std::size_t burst = SAMPLE_RATE / 2 + (x >> 8) % (SAMPLE_RATE * 6);
+        for (std::size_t i = pos; i < std::min(audio.size(), pos + burst); ++i) {
+            x = x * 1664525u + 1013904223u;
+            audio[i] = 0.3f * (static_cast<float>(x >> 8) / 8388608.0f - 1.0f);
+        }
+        pos += burst + SAMPLE_RATE + (x >> 8) % (SAMPLE_RATE * 3);
+    }
+    const MemorySampleSource src(audio.data(), audio.size());
+    VadConfig cfg;
+
+    const VadResult serial = detect_speech_sharded(src, cfg, 1);
+    const VadResult sharded = detect_speech_sharded(src, cfg, 6, SAMPLE_RATE * 40);
+    REQUIRE_FALSE(serial.segments.empty());
+    REQUIRE(sharded.segments.size() == serial.segments.size());
+    for (std::size_t i = 0; i < serial.segments.size(); ++i) {
+        CHECK(std::abs(sharded.segments[i].start_sample - serial.segments[i].start_sample) <=
+              cfg.window_size);
+        CHECK(std::abs(sharded.segments[i].end_sample - serial.segments[i].end_sample) <=
+              cfg.window_size);
+    }
+    CHECK(sharded.total_audio_duration == serial.total_audio_duration);
+}
+
 TEST_CASE("detect_speech: real audio produces speech segments", "[vad][integration]") {
     ensure_vad_model();
 
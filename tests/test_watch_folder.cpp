@@ -0,0 +1,174 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#include <catch2/catch_test_macros.hpp>
+#include "watch_folder.h"
+#include "audio_file.h"
+#include "test_tmpdir.h"
+
+#include <sndfile.h>
+
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+
+using namespace recmeet;
+
+namespace {
+
+fs::path fresh_dir(const char* name) {
+    auto dir = recmeet::test::tmp_path(name);
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    return dir;
+}
+
+void write_bytes(const fs::path& path, std::size_t n) {
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    out << std::string(n, 'x');
+}
+
+std::size_t count_entries(const fs::path& dir) {
+    std::size_t n = 0;
+    for ([[maybe_unused]] const auto& e : fs::directory_iterator(dir)) ++n;
+    return n;
+}
+
+} // anonymous namespace
+
+TEST_CASE("is_watch_candidate: audio extensions, visible names only", "[watch_folder]") {
+    CHECK(is_watch_candidate("/inbox/room-4.wav"));
+    CHECK(is_watch_candidate("/inbox/Board Meeting.M4A"));
+    CHECK(is_watch_candidate("/inbox/call.mp3"));
+    CHECK(is_watch_candidate("/inbox/call.flac"));
+    CHECK(is_watch_candidate("/inbox/call.aiff"));
+    CHECK_FALSE(is_watch_candidate("/inbox/.room-4.wav"));   // rsync/scp temp
+    CHECK_FALSE(is_watch_candidate("/inbox/room-4.wav.part"));
+    CHECK_FALSE(is_watch_candidate("/inbox/notes.txt"));
+    CHECK_FALSE(is_watch_candidate("/inbox/room-4"));
+}
+
+TEST_CASE("WatchFolder::scan: ready once the size and mtime settle", "[watch_folder]") {
+    auto dir = fresh_dir("recmeet_test_watch_scan");
+    write_bytes(dir / "room.flac", 100);
+    write_bytes(dir / "empty.wav", 0);
+    write_bytes(dir / "notes.txt", 10);
+
+    WatchFolder watch(dir, 30, nullptr);
+    CHECK(watch.scan(1000).empty());
+    CHECK(watch.scan(1029).empty());
+    CHECK(watch.scan(1030) == std::vector<fs::path>{dir / "room.flac"});
+    CHECK(watch.scan(1100).empty());  // handed once
+
+    // Still uploading: every change restarts the clock.
+    write_bytes(dir / "phone.m4a", 10);
+    CHECK(watch.scan(1200).empty());
+    write_bytes(dir / "phone.m4a", 10);
+    CHECK(watch.scan(1220).empty());
+    CHECK(watch.scan(1249).empty());
+    CHECK(watch.scan(1250) == std::vector<fs::path>{dir / "phone.m4a"});
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("WatchFolder::scan: files ready together come oldest first", "[watch_folder]") {
+    auto dir = fresh_dir("recmeet_test_watch_order");
+    write_bytes(dir / "b.wav", 10);
+    write_bytes(dir / "a.wav", 10);
+    write_bytes(dir / "c.wav", 10);
+    const auto now = fs::last_write_time(dir / "a.wav");
+    fs::last_write_time(dir / "b.wav", now - std::chrono::hours(2));
+    fs::last_write_time(dir / "c.wav", now - std::chrono::hours(1));
+
+    WatchFolder watch(dir, 0, nullptr);
+    CHECK(watch.scan(5) ==
+          std::vector<fs::path>{dir / "b.wav", dir / "c.wav", dir / "a.wav"});
+
+    // A file that went away and came back is new again.
+    fs::remove(dir / "a.wav");
+    CHECK(watch.scan(6).empty());
+    write_bytes(dir / "a.wav", 10);
+    CHECK(watch.scan(7) == std::vector<fs::path>{dir / "a.wav"});
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("ingest_watch_file: a WAV/FLAC/Opus becomes the meeting's audio", "[watch_folder]") {
+    auto inbox = fresh_dir("recmeet_test_watch_ingest_in");
+    auto meetings = fresh_dir("recmeet_test_watch_ingest_out");
+    const fs::path file = inbox / "Room 4.FLAC";
+    write_bytes(file, 64);
+
+    const fs::path dir = ingest_watch_file(file, meetings);
+    CHECK(dir.parent_path() == meetings);
+    CHECK_FALSE(fs::exists(file));
+    const std::string ts = derive_meeting_timestamp(dir);
+    REQUIRE(ts.size() == 16);
+    CHECK(find_audio_file(dir) == dir / ("audio_" + ts + ".flac"));
+    CHECK(fs::file_size(dir / ("audio_" + ts + ".flac")) == 64);
+
+    fs::remove_all(inbox);
+    fs::remove_all(meetings);
+}
+
+TEST_CASE("ingest_watch_file: other formats are decoded to a 16 kHz WAV", "[watch_folder]") {
+    auto inbox = fresh_dir("recmeet_test_watch_decode_in");
+    auto meetings = fresh_dir("recmeet_test_watch_decode_out");
+    const fs::path file = inbox / "Board Room.aiff";
+
+    SF_INFO info = {};
+    info.samplerate = 44100;
+    info.channels = 2;
+    info.format = SF_FORMAT_AIFF | SF_FORMAT_PCM_16;
+    SNDFILE* sf = sf_open(file.c_str(), SFM_WRITE, &info);
+    REQUIRE(sf != nullptr);
+    std::vector<float> frames(2 * 44100);
+    for (std::size_t i = 0; i < 44100; ++i)
+        frames[2 * i] = frames[2 * i + 1] =
+            static_cast<float>(0.3 * std::sin(2.0 * M_PI * 440.0 * i / 44100));
+    sf_write_float(sf, frames.data(), frames.size());
+    sf_close(sf);
+
+    const fs::path dir = ingest_watch_file(file, meetings);
+    CHECK_FALSE(fs::exists(file));
+    CHECK(fs::exists(dir / "Board Room.aiff"));  // the original, kept
+    const fs::path audio = find_audio_file(dir);
+    CHECK(audio.extension() == ".wav");
+    CHECK(read_wav_float(audio).size() == static_cast<std::size_t>(SAMPLE_RATE));
+
+    // One that cannot be decoded stays in the inbox, with no meeting left.
+    const fs::path bad = inbox / "broken.aiff";
+    write_bytes(bad, 32);
+    const std::size_t before = count_entries(meetings);
+    CHECK_THROWS_AS(ingest_watch_file(bad, meetings), RecmeetError);
+    CHECK(fs::exists(bad));
+    CHECK(count_entries(meetings) == before);
+
+    fs::remove_all(inbox);
+    fs::remove_all(meetings);
+}
+
+TEST_CASE("WatchFolder: the watcher hands over files already waiting", "[watch_folder]") {
+    auto dir = fresh_dir("recmeet_test_watch_thread");
+    write_bytes(dir / "room.wav", 10);
+
+    std::mutex mu;
+    std::condition_variable cv;
+    std::vector<fs::path> got;
+    WatchFolder watch(dir, 0, [&](const std::vector<fs::path>& files) {
+        std::lock_guard<std::mutex> lock(mu);
+        got.insert(got.end(), files.begin(), files.end());
+        cv.notify_all();
+    });
+    watch.start();
+    {
+        std::unique_lock<std::mutex> lock(mu);
+        cv.wait_for(lock, std::chrono::seconds(5), [&] { return !got.empty(); });
+    }
+    watch.stop();
+    CHECK(got == std::vector<fs::path>{dir / "room.wav"});
+
+    fs::remove_all(dir);
+}
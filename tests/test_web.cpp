@@ -3,14 +3,23 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include "config.h"
+#include "heavy_work.h"
+#include "json_util.h"
+#include "reidentify_jobs.h"
 #include "speaker_id.h"
 #include "util.h"
 #include "test_tmpdir.h"
 
 #include <httplib.h>
 
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <thread>
+#include <vector>
 
 using namespace recmeet;
 
@@ -28,6 +37,9 @@ struct TestServer {
     fs::path output_dir;
     fs::path web_root;
     std::mutex speaker_mu;
+#if RECMEET_USE_SHERPA
+    std::unique_ptr<ReidentifyJobs> reidentify_jobs;
+#endif
 
     void setup_routes() {
         server.set_default_headers({
@@ -390,41 +402,34 @@ struct TestServer {
         });
 
         // Batch re-identify all meetings against current speaker DB
+#if RECMEET_USE_SHERPA
+        reidentify_jobs = std::make_unique<ReidentifyJobs>(
+            speaker_db_dir, output_dir, false, 0.6f, 2, speaker_mu);
+#endif
         server.Post("/api/speakers/batch-reidentify", [this](const httplib::Request&, httplib::Response& res) {
 #if RECMEET_USE_SHERPA
-            std::lock_guard<std::mutex> lock(speaker_mu);
-            auto db = load_speaker_db(speaker_db_dir);
-            if (db.empty()) {
-                res.set_content(R"({"ok":true,"meetings_updated":0,"meetings_scanned":0})",
-                                "application/json");
-                return;
-            }
-
-            int scanned = 0, updated = 0;
-            if (fs::is_directory(output_dir)) {
-                for (const auto& entry : fs::directory_iterator(output_dir)) {
-                    if (!entry.is_directory()) continue;
-                    if (find_speakers_file(entry.path()).empty()) continue;
-                    auto spks = load_meeting_speakers(entry.path());
-                    if (spks.empty()) continue;
-                    ++scanned;
-                    auto result = re_identify_meeting(spks, db);
-                    if (!result.empty()) {
-                        save_meeting_speakers(entry.path(), result, derive_meeting_timestamp(entry.path()));
-                        ++updated;
-                    }
-                }
-            }
-
-            res.set_content(R"({"ok":true,"meetings_updated":)" + std::to_string(updated) +
-                            R"(,"meetings_scanned":)" + std::to_string(scanned) + "}",
-                            "application/json");
+            res.status = 202;
+            res.set_content(reidentify_status_json(reidentify_jobs->start()), "application/json");
 #else
             res.status = 501;
             res.set_content(R"({"error":"batch re-identify requires sherpa-onnx"})", "application/json");
 #endif
         });
 
+        server.Get(R"(/api/jobs/([0-9]+-[0-9]+))", [this](const httplib::Request& req, httplib::Response& res) {
+#if RECMEET_USE_SHERPA
+            ReidentifyJobStatus status;
+            if (reidentify_jobs->status(req.matches[1].str(), status)) {
+                res.set_content(reidentify_status_json(status), "application/json");
+                return;
+            }
+#else
+            (void)req;
+#endif
+            res.status = 404;
+            res.set_content(R"({"error":"job not found"})", "application/json");
+        });
+
         // Static file serving
         if (!web_root.empty() && fs::is_directory(web_root)) {
             server.set_mount_point("/", web_root.string());
@@ -452,6 +457,28 @@ struct TestServer {
     }
 };
 
+#if RECMEET_USE_SHERPA
+// Start a batch re-identify job and poll it until it is no longer running;
+// returns the final status body.
+std::string run_batch_reidentify(httplib::Client& cli) {
+    auto res = cli.Post("/api/speakers/batch-reidentify", "", "application/json");
+    REQUIRE(res);
+    CHECK(res->status == 202);
+    const std::string id = json_extract_string(res->body, "job_id");
+    REQUIRE_FALSE(id.empty());
+    std::string body = res->body;
+    for (int i = 0; i < 500 && json_extract_string(body, "state") == "running"; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        auto poll = cli.Get("/api/jobs/" + id);
+        REQUIRE(poll);
+        REQUIRE(poll->status == 200);
+        body = poll->body;
+    }
+    CHECK(json_extract_string(body, "state") == "done");
+    return body;
+}
+#endif
+
 } // anonymous namespace
 
 // ---------------------------------------------------------------------------
@@ -999,6 +1026,132 @@ TEST_CASE("web: POST /api/speakers/:name/remove-embedding missing index returns
     fs::remove_all(tmp);
 }
 
+// ---------------------------------------------------------------------------
+// Heavy-work admission (heavy_work.h)
+// ---------------------------------------------------------------------------
+
+namespace {
+
+// Holds every task run through it until release().
+struct Latch {
+    std::mutex mu;
+    std::condition_variable cv;
+    bool open = false;
+    int entered = 0;
+
+    void hold() {
+        std::unique_lock<std::mutex> lock(mu);
+        ++entered;
+        cv.notify_all();
+        cv.wait(lock, [&] { return open; });
+    }
+    void wait_entered(int n) {
+        std::unique_lock<std::mutex> lock(mu);
+        cv.wait(lock, [&] { return entered >= n; });
+    }
+    void release() {
+        std::lock_guard<std::mutex> lock(mu);
+        open = true;
+        cv.notify_all();
+    }
+};
+
+void wait_for_waiting(const HeavyWorkGate& gate, size_t n) {
+    while (gate.stats().waiting < n) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+} // namespace
+
+TEST_CASE("HeavyWorkGate: queues up to its depth, then refuses", "[web]") {
+    HeavyWorkGate gate(1, 1);
+    Latch latch;
+    std::vector<int> order;
+    std::mutex order_mu;
+    auto record = [&](int id) {
+        std::lock_guard<std::mutex> lock(order_mu);
+        order.push_back(id);
+    };
+
+    std::thread running([&] { gate.run([&] { record(1); latch.hold(); }); });
+    latch.wait_entered(1);
+    std::thread queued([&] { CHECK(gate.run([&] { record(2); })); });
+    wait_for_waiting(gate, 1);
+
+    bool ran = false;
+    CHECK_FALSE(gate.run([&] { ran = true; }));
+    CHECK_FALSE(ran);
+    auto st = gate.stats();
+    CHECK(st.running == 1);
+    CHECK(st.waiting == 1);
+    CHECK(st.rejected == 1);
+    CHECK(gate.retry_after_sec() == 2);  // 1 s default times a backlog of 2
+
+    latch.release();
+    running.join();
+    queued.join();
+    CHECK(order == std::vector<int>{1, 2});
+    st = gate.stats();
+    CHECK(st.running == 0);
+    CHECK(st.completed == 2);
+    CHECK(gate.retry_after_sec() == 1);
+    CHECK(web_request_threads(gate, 8) == 8);
+    CHECK(web_request_threads(HeavyWorkGate(4, 16), 8) == 24);
+}
+
+TEST_CASE("HeavyWorkGate: a throwing task frees its slot", "[web]") {
+    HeavyWorkGate gate(1, 0);
+    CHECK_THROWS_AS(gate.run([] { throw std::runtime_error("boom"); }), std::runtime_error);
+    bool ran = false;
+    CHECK(gate.run([&] { ran = true; }));
+    CHECK(ran);
+}
+
+TEST_CASE("web: a saturated heavy endpoint answers 429 while fast paths still answer",
+          "[web]") {
+    HeavyWorkGate gate(1, 0);
+    Latch latch;
+    httplib::Server server;
+    server.new_task_queue = [&gate] {
+        return new httplib::ThreadPool(web_request_threads(gate, 2));
+    };
+    server.Get("/api/health", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content(R"({"status":"ok"})", "application/json");
+    });
+    server.Post("/api/heavy", [&](const httplib::Request&, httplib::Response& res) {
+        if (gate.run([&] { latch.hold(); res.set_content(R"({"ok":true})", "application/json"); }))
+            return;
+        const int retry = gate.retry_after_sec();
+        res.status = 429;
+        res.set_header("Retry-After", std::to_string(retry));
+        res.set_content(heavy_work_busy_json(retry), "application/json");
+    });
+    const int port = server.bind_to_any_port("127.0.0.1");
+    std::thread listener([&] { server.listen_after_bind(); });
+    server.wait_until_ready();
+
+    std::thread first([&] {
+        httplib::Client cli("127.0.0.1", port);
+        auto res = cli.Post("/api/heavy", "", "application/json");
+        CHECK((res && res->status == 200));
+    });
+    latch.wait_entered(1);
+
+    httplib::Client cli("127.0.0.1", port);
+    auto busy = cli.Post("/api/heavy", "", "application/json");
+    REQUIRE(busy);
+    CHECK(busy->status == 429);
+    CHECK(busy->get_header_value("Retry-After") == "1");
+    CHECK(busy->body.find("\"retry_after\":1") != std::string::npos);
+    auto health = cli.Get("/api/health");
+    REQUIRE(health);
+    CHECK(health->status == 200);
+
+    latch.release();
+    first.join();
+    server.stop();
+    listener.join();
+}
+
 // ---------------------------------------------------------------------------
 // Relabel endpoint tests
 // ---------------------------------------------------------------------------
@@ -1349,12 +1502,10 @@ TEST_CASE("web: POST batch-reidentify updates meetings after profile change", "[
     srv.start();
 
     auto cli = srv.client();
-    auto res = cli.Post("/api/speakers/batch-reidentify", "", "application/json");
-    REQUIRE(res);
-    CHECK(res->status == 200);
-    CHECK(res->body.find("\"ok\":true") != std::string::npos);
-    CHECK(res->body.find("\"meetings_scanned\":2") != std::string::npos);
-    CHECK(res->body.find("\"meetings_updated\":1") != std::string::npos);
+    const std::string body = run_batch_reidentify(cli);
+    CHECK(body.find("\"ok\":true") != std::string::npos);
+    CHECK(body.find("\"meetings_scanned\":2") != std::string::npos);
+    CHECK(body.find("\"meetings_updated\":1") != std::string::npos);
 
     // Verify meeting 1 was updated
     auto loaded1 = load_meeting_speakers(mtg1);
@@ -1383,11 +1534,9 @@ TEST_CASE("web: POST batch-reidentify empty DB returns 0 updated", "[web]") {
     srv.start();
 
     auto cli = srv.client();
-    auto res = cli.Post("/api/speakers/batch-reidentify", "", "application/json");
-    REQUIRE(res);
-    CHECK(res->status == 200);
-    CHECK(res->body.find("\"meetings_updated\":0") != std::string::npos);
-    CHECK(res->body.find("\"meetings_scanned\":0") != std::string::npos);
+    const std::string body = run_batch_reidentify(cli);
+    CHECK(body.find("\"meetings_updated\":0") != std::string::npos);
+    CHECK(body.find("\"meetings_scanned\":0") != std::string::npos);
 
     fs::remove_all(tmp);
 }
@@ -1410,10 +1559,8 @@ TEST_CASE("web: POST batch-reidentify no meetings returns 0 scanned", "[web]") {
     srv.start();
 
     auto cli = srv.client();
-    auto res = cli.Post("/api/speakers/batch-reidentify", "", "application/json");
-    REQUIRE(res);
-    CHECK(res->status == 200);
-    CHECK(res->body.find("\"meetings_scanned\":0") != std::string::npos);
+    const std::string body = run_batch_reidentify(cli);
+    CHECK(body.find("\"meetings_scanned\":0") != std::string::npos);
 
     fs::remove_all(tmp);
 }
@@ -1447,11 +1594,9 @@ TEST_CASE("web: POST batch-reidentify preserves manual labels", "[web]") {
     srv.start();
 
     auto cli = srv.client();
-    auto res = cli.Post("/api/speakers/batch-reidentify", "", "application/json");
-    REQUIRE(res);
-    CHECK(res->status == 200);
+    const std::string body = run_batch_reidentify(cli);
     // No changes since the label is manual
-    CHECK(res->body.find("\"meetings_updated\":0") != std::string::npos);
+    CHECK(body.find("\"meetings_updated\":0") != std::string::npos);
 
     // Verify manual label preserved
     auto loaded = load_meeting_speakers(mtg);
@@ -1462,6 +1607,25 @@ TEST_CASE("web: POST batch-reidentify preserves manual labels", "[web]") {
     fs::remove_all(tmp);
 }
 
+TEST_CASE("web: GET /api/jobs reports unknown jobs as 404", "[web]") {
+    auto tmp = recmeet::test::tmp_path("recmeet_test_web_job_unknown");
+    fs::remove_all(tmp);
+    fs::create_directories(tmp / "speakers");
+    fs::create_directories(tmp / "meetings");
+
+    TestServer srv;
+    srv.speaker_db_dir = tmp / "speakers";
+    srv.output_dir = tmp / "meetings";
+    srv.start();
+
+    auto cli = srv.client();
+    auto res = cli.Get("/api/jobs/1-999");
+    REQUIRE(res);
+    CHECK(res->status == 404);
+
+    fs::remove_all(tmp);
+}
+
 // ---------------------------------------------------------------------------
 // Integration: relabel + re-enroll workflow
 // ---------------------------------------------------------------------------
@@ -18,6 +18,7 @@ type AgentConfig struct {
 	BraveAPIKey       string // Brave Search API key
 	AnthropicKey      string // Anthropic API key
 	AnthropicBaseURL  string // Anthropic API base URL override (from ANTHROPIC_BASE_URL env var)
+	WebCacheDir       string // web_fetch/web_search result cache; empty = off
 }
 
 // LoadAgentConfig loads base config from the given path and overlays
@@ -32,6 +33,7 @@ func LoadAgentConfig(configPath string) (AgentConfig, error) {
 		Config:        base,
 		Model:         "claude-sonnet-4-6",
 		MaxIterations: 20,
+		WebCacheDir:   DefaultWebCacheDir(),
 	}
 
 	// Anthropic key: env var takes precedence, then config file
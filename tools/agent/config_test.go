@@ -14,11 +14,15 @@ func TestLoadAgentConfig_Defaults(t *testing.T) {
 	// known-empty temp dir so the test is hermetic and observes silent
 	// defaults regardless of the developer's actual config layout.
 	t.Setenv("XDG_CONFIG_HOME", t.TempDir())
+	t.Setenv("XDG_CACHE_HOME", "/tmp/cache-home")
 	cfg, err := LoadAgentConfig("")
 	if err != nil {
 		t.Fatalf("unexpected error: %v", err)
 	}
 
+	if cfg.WebCacheDir != "/tmp/cache-home/recmeet/web" {
+		t.Errorf("expected web cache under XDG_CACHE_HOME, got %s", cfg.WebCacheDir)
+	}
 	if cfg.Model != "claude-sonnet-4-6" {
 		t.Errorf("expected model claude-sonnet-4-6, got %s", cfg.Model)
 	}
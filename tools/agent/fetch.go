@@ -17,7 +17,9 @@ import (
 const maxFetchLen = 10000
 
 // WebFetchTool fetches a URL and extracts text content from the HTML.
-type WebFetchTool struct{}
+type WebFetchTool struct {
+	Cache *WebCache // extracted text by URL; nil = always fetch
+}
 
 func (t *WebFetchTool) Definition() ToolDefinition {
 	return ToolDefinition{
@@ -44,18 +46,36 @@ func (t *WebFetchTool) Execute(ctx context.Context, inputJSON []byte) (string, b
 		return "Error: url is required", true, nil
 	}
 
+	key := "fetch " + params.URL
+	cached := t.Cache.lookup(key)
+	if t.Cache.fresh(cached) {
+		return fetchResult(cached.Text)
+	}
+
 	req, err := http.NewRequestWithContext(ctx, http.MethodGet, params.URL, nil)
 	if err != nil {
 		return "", true, fmt.Errorf("create request: %w", err)
 	}
 	req.Header.Set("User-Agent", "recmeet-agent/1.0")
+	if cached != nil {
+		if cached.ETag != "" {
+			req.Header.Set("If-None-Match", cached.ETag)
+		}
+		if cached.LastModified != "" {
+			req.Header.Set("If-Modified-Since", cached.LastModified)
+		}
+	}
 
-	resp, err := http.DefaultClient.Do(req)
+	resp, err := webClient.Do(req)
 	if err != nil {
 		return fmt.Sprintf("Error fetching URL: %s", err), true, nil
 	}
-	defer resp.Body.Close()
+	defer drainClose(resp.Body)
 
+	if resp.StatusCode == http.StatusNotModified && cached != nil {
+		t.Cache.revalidated(cached, resp.Header)
+		return fetchResult(cached.Text)
+	}
 	if resp.StatusCode != http.StatusOK {
 		return fmt.Sprintf("HTTP %d fetching %s", resp.StatusCode, params.URL), true, nil
 	}
@@ -69,6 +89,11 @@ func (t *WebFetchTool) Execute(ctx context.Context, inputJSON []byte) (string, b
 	if len(text) > maxFetchLen {
 		text = text[:maxFetchLen]
 	}
+	t.Cache.storeResponse(key, text, resp.Header)
+	return fetchResult(text)
+}
+
+func fetchResult(text string) (string, bool, error) {
 	if text == "" {
 		return "(no text content found)", false, nil
 	}
@@ -8,7 +8,10 @@ import (
 	"encoding/json"
 	"fmt"
 	"log"
+	"sort"
 	"strings"
+	"sync"
+	"time"
 
 	anthropic "github.com/anthropics/anthropic-sdk-go"
 	"github.com/anthropics/anthropic-sdk-go/option"
@@ -42,23 +45,76 @@ func NewSDKClient(apiKey, baseURL string) AnthropicClient {
 	return &sdkClient{client: &client}
 }
 
+// Tool calls in one response run concurrently, at most maxParallelTools
+// at a time, each given toolTimeout to finish.
+const (
+	maxParallelTools = 4
+	toolTimeout      = 60 * time.Second
+)
+
+// Prompt caching: the tool definitions and the system prompt each end in a
+// cache breakpoint, and so does the newest user message (the initial
+// request, then each round of tool results). Every iteration re-sends the
+// whole conversation, so each one reads the prefix the previous one
+// wrote. Only the newest maxMessageBreakpoints message breakpoints are
+// kept, within the API's limit of four per request.
+const maxMessageBreakpoints = 2
+
+// TokenUsage totals the input and output tokens of a Run. Input excludes
+// the cached tokens, which are split into those read from and written to
+// the prompt cache.
+type TokenUsage struct {
+	Input      int64
+	CacheRead  int64
+	CacheWrite int64
+	Output     int64
+}
+
+func (u *TokenUsage) add(r anthropic.Usage) {
+	u.Input += r.InputTokens
+	u.CacheRead += r.CacheReadInputTokens
+	u.CacheWrite += r.CacheCreationInputTokens
+	u.Output += r.OutputTokens
+}
+
+func (u TokenUsage) String() string {
+	return fmt.Sprintf("input=%d cache_read=%d cache_write=%d output=%d",
+		u.Input, u.CacheRead, u.CacheWrite, u.Output)
+}
+
+// SerialTool is implemented by tools whose calls must not overlap others
+// in the same response, e.g. because they change files a later call may
+// read. Such a call waits for the calls before it, and the calls after it
+// wait for it.
+type SerialTool interface {
+	Serial() bool
+}
+
 // Loop runs the agentic tool-use loop against the Anthropic API.
 type Loop struct {
-	client   AnthropicClient
-	model    string
-	registry *ToolRegistry
-	maxIter  int
-	verbose  bool
+	client      AnthropicClient
+	model       string
+	registry    *ToolRegistry
+	maxIter     int
+	verbose     bool
+	parallel    int
+	toolTimeout time.Duration
+	usage       TokenUsage
 }
 
+// Usage returns the tokens used by the last Run.
+func (l *Loop) Usage() TokenUsage { return l.usage }
+
 // NewLoop creates a new agentic loop.
 func NewLoop(client AnthropicClient, model string, registry *ToolRegistry, maxIter int, verbose bool) *Loop {
 	return &Loop{
-		client:   client,
-		model:    model,
-		registry: registry,
-		maxIter:  maxIter,
-		verbose:  verbose,
+		client:      client,
+		model:       model,
+		registry:    registry,
+		maxIter:     maxIter,
+		verbose:     verbose,
+		parallel:    maxParallelTools,
+		toolTimeout: toolTimeout,
 	}
 }
 
@@ -68,8 +124,24 @@ func (l *Loop) Run(ctx context.Context, systemPrompt string, userMessage string)
 	messages := []anthropic.MessageParam{
 		anthropic.NewUserMessage(anthropic.NewTextBlock(userMessage)),
 	}
+	var breakpoints []*anthropic.CacheControlEphemeralParam
+	markCache := func(msg anthropic.MessageParam) {
+		if cc := lastBlockCacheControl(msg); cc != nil {
+			*cc = anthropic.NewCacheControlEphemeralParam()
+			breakpoints = append(breakpoints, cc)
+		}
+		if len(breakpoints) > maxMessageBreakpoints {
+			*breakpoints[0] = anthropic.CacheControlEphemeralParam{}
+			breakpoints = breakpoints[1:]
+		}
+	}
+	markCache(messages[0])
 
 	tools := l.buildToolDefs()
+	l.usage = TokenUsage{}
+	if l.verbose {
+		defer func() { log.Printf("[agent] total usage: %s", l.usage) }()
+	}
 
 	for iter := range l.maxIter {
 		if l.verbose {
@@ -84,7 +156,7 @@ func (l *Loop) Run(ctx context.Context, systemPrompt string, userMessage string)
 		}
 		if systemPrompt != "" {
 			params.System = []anthropic.TextBlockParam{
-				{Text: systemPrompt},
+				{Text: systemPrompt, CacheControl: anthropic.NewCacheControlEphemeralParam()},
 			}
 		}
 
@@ -93,8 +165,12 @@ func (l *Loop) Run(ctx context.Context, systemPrompt string, userMessage string)
 			return "", fmt.Errorf("API call failed: %w", err)
 		}
 
+		l.usage.add(resp.Usage)
 		if l.verbose {
 			log.Printf("[agent] stop_reason=%s, content_blocks=%d", resp.StopReason, len(resp.Content))
+			var u TokenUsage
+			u.add(resp.Usage)
+			log.Printf("[agent] usage: %s", u)
 		}
 
 		// Check for end_turn: extract text and return
@@ -108,40 +184,21 @@ func (l *Loop) Run(ctx context.Context, systemPrompt string, userMessage string)
 			assistantBlocks := contentToParamBlocks(resp.Content)
 			messages = append(messages, anthropic.NewAssistantMessage(assistantBlocks...))
 
-			// Execute each tool call and collect results
-			var toolResults []anthropic.ContentBlockParamUnion
+			// Execute the tool calls and collect results in block order
+			var calls []toolCall
 			for _, block := range resp.Content {
-				if block.Type != "tool_use" {
-					continue
+				if block.Type == "tool_use" {
+					calls = append(calls, toolCall{id: block.ID, name: block.Name, input: []byte(block.Input)})
 				}
-
-				toolName := block.Name
-				toolID := block.ID
-				inputJSON := []byte(block.Input)
-
-				if l.verbose {
-					log.Printf("[agent] tool_use: %s (id=%s)", toolName, toolID)
-				}
-
-				tool := l.registry.Get(toolName)
-				if tool == nil {
-					toolResults = append(toolResults,
-						anthropic.NewToolResultBlock(toolID, fmt.Sprintf("Unknown tool: %s", toolName), true))
-					continue
-				}
-
-				result, isError, err := tool.Execute(ctx, inputJSON)
-				if err != nil {
-					toolResults = append(toolResults,
-						anthropic.NewToolResultBlock(toolID, fmt.Sprintf("Tool error: %s", err), true))
-					continue
-				}
-
+			}
+			var toolResults []anthropic.ContentBlockParamUnion
+			for i, out := range l.executeTools(ctx, calls) {
 				toolResults = append(toolResults,
-					anthropic.NewToolResultBlock(toolID, result, isError))
+					anthropic.NewToolResultBlock(calls[i].id, out.text, out.isError))
 			}
 
 			messages = append(messages, anthropic.NewUserMessage(toolResults...))
+			markCache(messages[len(messages)-1])
 			continue
 		}
 
@@ -152,9 +209,108 @@ func (l *Loop) Run(ctx context.Context, systemPrompt string, userMessage string)
 	return "", fmt.Errorf("max iterations (%d) reached without completion", l.maxIter)
 }
 
-// buildToolDefs converts registered tools to Anthropic API tool definitions.
+type toolCall struct {
+	id    string
+	name  string
+	input []byte
+}
+
+type toolOutcome struct {
+	text    string
+	isError bool
+}
+
+// executeTools runs the calls of one response and returns their outcomes
+// in call order. Runs of calls to ordinary tools execute concurrently, at
+// most l.parallel at a time; a SerialTool call runs on its own between
+// them.
+func (l *Loop) executeTools(ctx context.Context, calls []toolCall) []toolOutcome {
+	out := make([]toolOutcome, len(calls))
+	workers := l.parallel
+	if workers < 1 {
+		workers = 1
+	}
+	sem := make(chan struct{}, workers)
+	var wg sync.WaitGroup
+	for i, c := range calls {
+		tool := l.registry.Get(c.name)
+		if s, ok := tool.(SerialTool); ok && s.Serial() {
+			wg.Wait()
+			out[i] = l.executeTool(ctx, tool, c)
+			continue
+		}
+		wg.Add(1)
+		sem <- struct{}{}
+		go func(i int, c toolCall) {
+			defer wg.Done()
+			defer func() { <-sem }()
+			out[i] = l.executeTool(ctx, tool, c)
+		}(i, c)
+	}
+	wg.Wait()
+	return out
+}
+
+// executeTool runs one call under the per-tool timeout. A tool that does
+// not return by then is reported as timed out; its result, if it ever
+// arrives, is discarded.
+func (l *Loop) executeTool(ctx context.Context, tool Tool, c toolCall) toolOutcome {
+	if l.verbose {
+		log.Printf("[agent] tool_use: %s (id=%s)", c.name, c.id)
+	}
+	if tool == nil {
+		return toolOutcome{fmt.Sprintf("Unknown tool: %s", c.name), true}
+	}
+
+	if l.toolTimeout > 0 {
+		var cancel context.CancelFunc
+		ctx, cancel = context.WithTimeout(ctx, l.toolTimeout)
+		defer cancel()
+	}
+	done := make(chan toolOutcome, 1)
+	go func() {
+		result, isError, err := tool.Execute(ctx, c.input)
+		if err != nil {
+			done <- toolOutcome{fmt.Sprintf("Tool error: %s", err), true}
+			return
+		}
+		done <- toolOutcome{result, isError}
+	}()
+	select {
+	case o := <-done:
+		return o
+	case <-ctx.Done():
+		if ctx.Err() == context.DeadlineExceeded {
+			return toolOutcome{fmt.Sprintf("Tool error: %s timed out after %s", c.name, l.toolTimeout), true}
+		}
+		return toolOutcome{fmt.Sprintf("Tool error: %s", ctx.Err()), true}
+	}
+}
+
+// lastBlockCacheControl returns the cache_control of msg's last block, if
+// that block type carries one.
+func lastBlockCacheControl(msg anthropic.MessageParam) *anthropic.CacheControlEphemeralParam {
+	if len(msg.Content) == 0 {
+		return nil
+	}
+	b := msg.Content[len(msg.Content)-1]
+	switch {
+	case b.OfText != nil:
+		return &b.OfText.CacheControl
+	case b.OfToolResult != nil:
+		return &b.OfToolResult.CacheControl
+	}
+	return nil
+}
+
+// buildToolDefs converts registered tools to Anthropic API tool definitions,
+// sorted by name so the cached prefix is the same from run to run, with a
+// cache breakpoint after the last.
 func (l *Loop) buildToolDefs() []anthropic.ToolUnionParam {
 	allTools := l.registry.All()
+	sort.Slice(allTools, func(i, j int) bool {
+		return allTools[i].Definition().Name < allTools[j].Definition().Name
+	})
 	defs := make([]anthropic.ToolUnionParam, 0, len(allTools))
 	for _, t := range allTools {
 		def := t.Definition()
@@ -180,6 +336,9 @@ func (l *Loop) buildToolDefs() []anthropic.ToolUnionParam {
 		}
 		defs = append(defs, anthropic.ToolUnionParam{OfTool: &tp})
 	}
+	if len(defs) > 0 {
+		defs[len(defs)-1].OfTool.CacheControl = anthropic.NewCacheControlEphemeralParam()
+	}
 	return defs
 }
 
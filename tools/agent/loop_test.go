@@ -6,7 +6,10 @@ package agent
 import (
 	"context"
 	"fmt"
+	"strings"
+	"sync/atomic"
 	"testing"
+	"time"
 
 	anthropic "github.com/anthropics/anthropic-sdk-go"
 	"github.com/syketech/recmeet-tools/testutil"
@@ -101,6 +104,73 @@ func TestLoop_UnknownTool(t *testing.T) {
 	}
 }
 
+// cacheCheckClient scripts responses and records, at call time, where the
+// request's cache breakpoints are.
+type cacheCheckClient struct {
+	MockAnthropicClient
+	marks [][]string
+}
+
+func (c *cacheCheckClient) CreateMessage(ctx context.Context, p anthropic.MessageNewParams) (*anthropic.Message, error) {
+	var marks []string
+	for _, s := range p.System {
+		if s.CacheControl.Type == "ephemeral" {
+			marks = append(marks, "system")
+		}
+	}
+	for _, tool := range p.Tools {
+		if tool.OfTool != nil && tool.OfTool.CacheControl.Type == "ephemeral" {
+			marks = append(marks, "tool:"+tool.OfTool.Name)
+		}
+	}
+	for i, m := range p.Messages {
+		if cc := lastBlockCacheControl(m); cc != nil && cc.Type == "ephemeral" {
+			marks = append(marks, fmt.Sprintf("message:%d", i))
+		}
+	}
+	c.marks = append(c.marks, marks)
+	resp, err := c.MockAnthropicClient.CreateMessage(ctx, p)
+	if resp != nil {
+		resp.Usage.InputTokens = 1
+		resp.Usage.CacheReadInputTokens = int64(100 * (c.calls - 1))
+	}
+	return resp, err
+}
+
+func TestLoop_PromptCacheBreakpoints(t *testing.T) {
+	toolUse := func() *anthropic.Message {
+		return testutil.BuildAnthropicToolUseMessage("echo_tool", map[string]any{}, "")
+	}
+	mock := &cacheCheckClient{MockAnthropicClient: MockAnthropicClient{
+		responses: []*anthropic.Message{toolUse(), toolUse(), toolUse(),
+			testutil.BuildAnthropicTextMessage("Done!")},
+	}}
+
+	reg := NewToolRegistry()
+	reg.Register(&echoTool{})
+	reg.Register(&WriteFileTool{})
+	loop := NewLoop(mock, "test-model", reg, 5, false)
+	if _, err := loop.Run(context.Background(), "system", "user"); err != nil {
+		t.Fatalf("unexpected error: %v", err)
+	}
+
+	// Tools and system always; then the newest two user messages.
+	want := []string{
+		"system tool:write_file message:0",
+		"system tool:write_file message:0 message:2",
+		"system tool:write_file message:2 message:4",
+		"system tool:write_file message:4 message:6",
+	}
+	for i, w := range want {
+		if got := strings.Join(mock.marks[i], " "); got != w {
+			t.Errorf("call %d breakpoints = %q, want %q", i+1, got, w)
+		}
+	}
+	if u := loop.Usage(); u.CacheRead != 600 || u.Input != 4 {
+		t.Errorf("usage = %s", u)
+	}
+}
+
 func TestLoop_MaxIterations(t *testing.T) {
 	// Always returns tool_use to exhaust iterations
 	infiniteToolUse := func() *anthropic.Message {
@@ -121,6 +191,136 @@ func TestLoop_MaxIterations(t *testing.T) {
 	}
 }
 
+// sleepTool sleeps for its input's "ms" and reports its name, tracking
+// how many of its calls overlap.
+type sleepTool struct {
+	name    string
+	serial  bool
+	running atomic.Int32
+	peak    atomic.Int32
+	log     *[]string
+	logMu   chan struct{}
+}
+
+func (s *sleepTool) Definition() ToolDefinition {
+	return ToolDefinition{Name: s.name, InputSchema: map[string]interface{}{"type": "object"}}
+}
+
+func (s *sleepTool) Serial() bool { return s.serial }
+
+func (s *sleepTool) Execute(ctx context.Context, inputJSON []byte) (string, bool, error) {
+	n := s.running.Add(1)
+	defer s.running.Add(-1)
+	for {
+		p := s.peak.Load()
+		if n <= p || s.peak.CompareAndSwap(p, n) {
+			break
+		}
+	}
+	var ms int
+	fmt.Sscanf(string(inputJSON), "%d", &ms)
+	if s.log != nil {
+		s.logMu <- struct{}{}
+		*s.log = append(*s.log, fmt.Sprintf("%s:%d", s.name, ms))
+		<-s.logMu
+	}
+	select {
+	case <-time.After(time.Duration(ms) * time.Millisecond):
+	case <-ctx.Done():
+		return "", true, ctx.Err()
+	}
+	return fmt.Sprintf("%s slept %d", s.name, ms), false, nil
+}
+
+func TestLoop_ToolsRunConcurrentlyInOrder(t *testing.T) {
+	slow := &sleepTool{name: "slow"}
+	reg := NewToolRegistry()
+	reg.Register(slow)
+	loop := NewLoop(nil, "test-model", reg, 5, false)
+
+	calls := []toolCall{
+		{id: "a", name: "slow", input: []byte("150")},
+		{id: "b", name: "slow", input: []byte("50")},
+		{id: "c", name: "missing"},
+		{id: "d", name: "slow", input: []byte("100")},
+	}
+	start := time.Now()
+	out := loop.executeTools(context.Background(), calls)
+	elapsed := time.Since(start)
+
+	want := []string{"slow slept 150", "slow slept 50", "Unknown tool: missing", "slow slept 100"}
+	for i, w := range want {
+		if out[i].text != w {
+			t.Errorf("result %d = %q, want %q", i, out[i].text, w)
+		}
+	}
+	if !out[2].isError {
+		t.Error("unknown tool should be an error result")
+	}
+	if elapsed >= 300*time.Millisecond {
+		t.Errorf("calls ran one after another: %v", elapsed)
+	}
+}
+
+func TestLoop_ToolParallelismBounded(t *testing.T) {
+	slow := &sleepTool{name: "slow"}
+	reg := NewToolRegistry()
+	reg.Register(slow)
+	loop := NewLoop(nil, "test-model", reg, 5, false)
+	loop.parallel = 2
+
+	var calls []toolCall
+	for i := 0; i < 6; i++ {
+		calls = append(calls, toolCall{id: fmt.Sprint(i), name: "slow", input: []byte("30")})
+	}
+	loop.executeTools(context.Background(), calls)
+	if p := slow.peak.Load(); p != 2 {
+		t.Errorf("peak concurrency %d, want 2", p)
+	}
+}
+
+func TestLoop_ToolTimeout(t *testing.T) {
+	reg := NewToolRegistry()
+	reg.Register(&sleepTool{name: "slow"})
+	loop := NewLoop(nil, "test-model", reg, 5, false)
+	loop.toolTimeout = 50 * time.Millisecond
+
+	out := loop.executeTools(context.Background(), []toolCall{
+		{id: "a", name: "slow", input: []byte("5000")},
+		{id: "b", name: "slow", input: []byte("1")},
+	})
+	if !out[0].isError || !strings.Contains(out[0].text, "context deadline exceeded") &&
+		!strings.Contains(out[0].text, "timed out") {
+		t.Errorf("expected a timeout, got %+v", out[0])
+	}
+	if out[1].isError || out[1].text != "slow slept 1" {
+		t.Errorf("fast call affected by the slow one: %+v", out[1])
+	}
+}
+
+func TestLoop_SerialToolIsABarrier(t *testing.T) {
+	var log []string
+	mu := make(chan struct{}, 1)
+	fast := &sleepTool{name: "read", log: &log, logMu: mu}
+	write := &sleepTool{name: "write", serial: true, log: &log, logMu: mu}
+	reg := NewToolRegistry()
+	reg.Register(fast)
+	reg.Register(write)
+	loop := NewLoop(nil, "test-model", reg, 5, false)
+
+	loop.executeTools(context.Background(), []toolCall{
+		{id: "1", name: "read", input: []byte("40")},
+		{id: "2", name: "write", input: []byte("10")},
+		{id: "3", name: "read", input: []byte("0")},
+	})
+	if strings.Join(log, ",") != "read:40,write:10,read:0" {
+		t.Errorf("serial tool overlapped its neighbours: %v", log)
+	}
+	if write.peak.Load() != 1 {
+		t.Errorf("serial tool ran concurrently")
+	}
+}
+
 // echoTool is a simple test tool that returns its input as a string.
 type echoTool struct{}
 
@@ -16,7 +16,8 @@ import (
 // WebSearchTool performs web searches via the Brave Search API.
 type WebSearchTool struct {
 	APIKey  string
-	BaseURL string // override for testing; empty = production
+	BaseURL string    // override for testing; empty = production
+	Cache   *WebCache // results by query for searchCacheTTL; nil = always search
 }
 
 func (t *WebSearchTool) Definition() ToolDefinition {
@@ -50,6 +51,10 @@ func (t *WebSearchTool) Execute(ctx context.Context, inputJSON []byte) (string,
 	}
 
 	reqURL := fmt.Sprintf("%s?q=%s&count=5", baseURL, url.QueryEscape(params.Query))
+	key := "search " + reqURL
+	if cached := t.Cache.lookup(key); t.Cache.fresh(cached) {
+		return cached.Text, false, nil
+	}
 	req, err := http.NewRequestWithContext(ctx, http.MethodGet, reqURL, nil)
 	if err != nil {
 		return "", true, fmt.Errorf("create request: %w", err)
@@ -57,11 +62,11 @@ func (t *WebSearchTool) Execute(ctx context.Context, inputJSON []byte) (string,
 	req.Header.Set("Accept", "application/json")
 	req.Header.Set("X-Subscription-Token", t.APIKey)
 
-	resp, err := http.DefaultClient.Do(req)
+	resp, err := webClient.Do(req)
 	if err != nil {
 		return fmt.Sprintf("Error: %s", err), true, nil
 	}
-	defer resp.Body.Close()
+	defer drainClose(resp.Body)
 
 	body, err := io.ReadAll(resp.Body)
 	if err != nil {
@@ -72,7 +77,11 @@ func (t *WebSearchTool) Execute(ctx context.Context, inputJSON []byte) (string,
 		return fmt.Sprintf("Brave API error (HTTP %d): %s", resp.StatusCode, string(body)), true, nil
 	}
 
-	return formatBraveResults(body)
+	result, isError, err := formatBraveResults(body)
+	if !isError && err == nil {
+		t.Cache.storeFor(key, result, searchCacheTTL)
+	}
+	return result, isError, err
 }
 
 type braveResponse struct {
@@ -129,6 +129,78 @@ func (t *SearchMeetingsTool) Execute(_ context.Context, inputJSON []byte) (strin
 	return sb.String(), false, nil
 }
 
+// SearchTranscriptsTool retrieves the transcript and summary passages most
+// relevant to a topic, so a workflow need not read whole meetings.
+type SearchTranscriptsTool struct {
+	NoteDir   string
+	OutputDir string
+}
+
+func (t *SearchTranscriptsTool) Definition() ToolDefinition {
+	return ToolDefinition{
+		Name:        "search_transcripts",
+		Description: "Find the passages of past meeting transcripts and summaries most relevant to a topic. Returns short excerpts with their meeting and timestamp; prefer this over get_meeting when looking for what was said about something.",
+		InputSchema: map[string]interface{}{
+			"type": "object",
+			"properties": map[string]interface{}{
+				"query":        map[string]interface{}{"type": "string", "description": "Topic or question to find passages about"},
+				"date_from":    map[string]interface{}{"type": "string", "description": "Start date (YYYY-MM-DD)"},
+				"date_to":      map[string]interface{}{"type": "string", "description": "End date (YYYY-MM-DD)"},
+				"participants": map[string]interface{}{"type": "string", "description": "Comma-separated participant names"},
+				"k":            map[string]interface{}{"type": "integer", "description": "Number of passages to return (default 8, max 20)"},
+			},
+			"required": []string{"query"},
+		},
+	}
+}
+
+func (t *SearchTranscriptsTool) Execute(_ context.Context, inputJSON []byte) (string, bool, error) {
+	var params struct {
+		Query        string `json:"query"`
+		DateFrom     string `json:"date_from"`
+		DateTo       string `json:"date_to"`
+		Participants string `json:"participants"`
+		K            int    `json:"k"`
+	}
+	if err := json.Unmarshal(inputJSON, &params); err != nil {
+		return "", true, fmt.Errorf("invalid input: %w", err)
+	}
+	if strings.TrimSpace(params.Query) == "" {
+		return "query is required", true, nil
+	}
+	if params.K <= 0 {
+		params.K = 8
+	}
+	if params.K > 20 {
+		params.K = 20
+	}
+
+	var parts []string
+	if params.Participants != "" {
+		for _, p := range strings.Split(params.Participants, ",") {
+			parts = append(parts, strings.TrimSpace(p))
+		}
+	}
+	passages, err := meetingdata.RetrievePassages(t.NoteDir, t.OutputDir, params.Query, params.K,
+		meetingdata.SearchFilters{DateFrom: params.DateFrom, DateTo: params.DateTo, Participants: parts})
+	if err != nil {
+		return fmt.Sprintf("Error searching transcripts: %s", err), true, nil
+	}
+	if len(passages) == 0 {
+		return "No relevant passages found.", false, nil
+	}
+
+	var sb strings.Builder
+	for i, p := range passages {
+		fmt.Fprintf(&sb, "## %d. %s (%s %s), %s", i+1, p.Title, p.Date, p.Time, p.Section)
+		if p.Start != "" {
+			fmt.Fprintf(&sb, " at %s", p.Start)
+		}
+		fmt.Fprintf(&sb, "\n%s\n\n", p.Text)
+	}
+	return sb.String(), false, nil
+}
+
 // GetMeetingTool retrieves full details of a specific meeting note.
 type GetMeetingTool struct {
 	NoteDir   string
@@ -170,7 +242,7 @@ func (t *GetMeetingTool) Execute(_ context.Context, inputJSON []byte) (string, b
 			if err != nil {
 				return fmt.Sprintf("Meeting found but no note: %s", err), true, nil
 			}
-			note, err := meetingdata.ParseNote(notePath)
+			note, err := meetingdata.CachedParseNote(notePath)
 			if err != nil {
 				return fmt.Sprintf("Error parsing note: %s", err), true, nil
 			}
@@ -90,6 +90,36 @@ func TestSearchMeetingsTool_NoResults(t *testing.T) {
 	}
 }
 
+func TestSearchTranscriptsTool(t *testing.T) {
+	noteDir := setupTestNotes(t)
+	t.Setenv("XDG_DATA_HOME", t.TempDir())
+
+	tool := &SearchTranscriptsTool{NoteDir: noteDir, OutputDir: ""}
+	input, _ := json.Marshal(map[string]interface{}{
+		"query": "API migration priority",
+		"k":     2,
+	})
+
+	result, isError, err := tool.Execute(context.Background(), input)
+	if err != nil {
+		t.Fatalf("unexpected error: %v", err)
+	}
+	if isError {
+		t.Errorf("unexpected tool error: %s", result)
+	}
+	if !strings.Contains(result, "Q1 Planning Session") || !strings.Contains(result, "migration") {
+		t.Errorf("expected a passage about the migration, got: %s", result)
+	}
+	if strings.Count(result, "## ") > 2 {
+		t.Errorf("expected at most 2 passages, got: %s", result)
+	}
+
+	input, _ = json.Marshal(map[string]interface{}{})
+	if _, isError, _ := tool.Execute(context.Background(), input); !isError {
+		t.Error("expected an error for a missing query")
+	}
+}
+
 func TestListActionItemsTool(t *testing.T) {
 	noteDir := setupTestNotes(t)
 
@@ -0,0 +1,249 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+package agent
+
+import (
+	"crypto/sha256"
+	"encoding/hex"
+	"encoding/json"
+	"io"
+	"net/http"
+	"os"
+	"path/filepath"
+	"strconv"
+	"strings"
+	"time"
+)
+
+// Web response cache.
+//
+// Prep workflows for a recurring meeting fetch the same company pages and
+// run the same searches week after week. WebCache keeps web_fetch's
+// extracted text and web_search's formatted results on disk, one JSON
+// file per request, so a repeated call costs no round trip and no search
+// API quota while its entry is fresh.
+//
+// A fetched page follows its HTTP caching headers: no-store is never kept,
+// max-age (else Expires, else a tenth of the time since Last-Modified, at
+// most heuristicMaxTTL) sets how long it is fresh, and no-cache keeps it
+// but revalidates every use. A stale entry carrying an ETag or
+// Last-Modified is revalidated with If-None-Match / If-Modified-Since; a
+// 304 reuses the stored text. Brave's responses say nothing useful about
+// caching, so search results are kept for searchCacheTTL. Entries unused
+// for webCacheMaxAge are removed when the cache is opened.
+
+const webCacheVersion = 1
+
+const (
+	searchCacheTTL  = 24 * time.Hour
+	heuristicMaxTTL = 24 * time.Hour
+	webCacheMaxAge  = 30 * 24 * time.Hour
+)
+
+// webClient is shared by web_fetch and web_search. Bodies are always read
+// to the end, so the parallel tool calls of a briefing reuse kept-alive
+// connections instead of a TCP and TLS handshake each.
+var webClient = &http.Client{Transport: newWebTransport()}
+
+func newWebTransport() *http.Transport {
+	t := http.DefaultTransport.(*http.Transport).Clone()
+	t.MaxIdleConnsPerHost = maxParallelTools
+	t.IdleConnTimeout = 90 * time.Second
+	return t
+}
+
+// drainClose reads what is left of a response body before closing it, so
+// that its connection can be reused.
+func drainClose(body io.ReadCloser) {
+	io.Copy(io.Discard, io.LimitReader(body, 1<<20))
+	body.Close()
+}
+
+// DefaultWebCacheDir is $XDG_CACHE_HOME/recmeet/web.
+func DefaultWebCacheDir() string {
+	if dir := os.Getenv("XDG_CACHE_HOME"); dir != "" {
+		return filepath.Join(dir, "recmeet", "web")
+	}
+	home, _ := os.UserHomeDir()
+	return filepath.Join(home, ".cache", "recmeet", "web")
+}
+
+type webCacheEntry struct {
+	Version      int    `json:"version"`
+	Key          string `json:"key"`
+	Text         string `json:"text"`
+	ETag         string `json:"etag,omitempty"`
+	LastModified string `json:"last_modified,omitempty"`
+	Expires      int64  `json:"expires"` // unix seconds; stale from then on
+}
+
+func (e *webCacheEntry) revalidatable() bool {
+	return e.ETag != "" || e.LastModified != ""
+}
+
+// WebCache is the on-disk cache of web tool results. A nil *WebCache
+// caches nothing. Writes are best effort: a cache that cannot be written
+// only costs the network calls it would have saved.
+type WebCache struct {
+	dir string
+	now func() time.Time
+}
+
+// OpenWebCache opens the cache in dir and removes its long-unused
+// entries. An empty dir disables caching (nil).
+func OpenWebCache(dir string) *WebCache {
+	if dir == "" {
+		return nil
+	}
+	c := &WebCache{dir: dir, now: time.Now}
+	entries, err := os.ReadDir(dir)
+	if err != nil {
+		return c
+	}
+	cutoff := c.now().Add(-webCacheMaxAge)
+	for _, de := range entries {
+		info, err := de.Info()
+		if err == nil && !de.IsDir() && info.ModTime().Before(cutoff) {
+			os.Remove(filepath.Join(dir, de.Name()))
+		}
+	}
+	return c
+}
+
+func (c *WebCache) path(key string) string {
+	sum := sha256.Sum256([]byte(key))
+	return filepath.Join(c.dir, hex.EncodeToString(sum[:])+".json")
+}
+
+// lookup returns the entry stored for key, fresh or stale, or nil.
+func (c *WebCache) lookup(key string) *webCacheEntry {
+	if c == nil {
+		return nil
+	}
+	p := c.path(key)
+	data, err := os.ReadFile(p)
+	if err != nil {
+		return nil
+	}
+	var e webCacheEntry
+	if json.Unmarshal(data, &e) != nil || e.Version != webCacheVersion || e.Key != key {
+		return nil
+	}
+	now := c.now()
+	os.Chtimes(p, now, now) // used: keep it past the next prune
+	return &e
+}
+
+func (c *WebCache) fresh(e *webCacheEntry) bool {
+	return c != nil && e != nil && c.now().Unix() < e.Expires
+}
+
+func (c *WebCache) put(e *webCacheEntry) {
+	e.Version = webCacheVersion
+	data, err := json.Marshal(e)
+	if err != nil || os.MkdirAll(c.dir, 0755) != nil {
+		return
+	}
+	tmp, err := os.CreateTemp(c.dir, ".web-*")
+	if err != nil {
+		return
+	}
+	_, werr := tmp.Write(data)
+	if cerr := tmp.Close(); werr != nil || cerr != nil || os.Rename(tmp.Name(), c.path(e.Key)) != nil {
+		os.Remove(tmp.Name())
+	}
+}
+
+// storeResponse keeps text as the result of key when the response's
+// headers allow it.
+func (c *WebCache) storeResponse(key, text string, h http.Header) {
+	if c == nil {
+		return
+	}
+	ttl, ok := responseFreshness(h, c.now())
+	if !ok {
+		return
+	}
+	e := &webCacheEntry{
+		Key:          key,
+		Text:         text,
+		ETag:         h.Get("ETag"),
+		LastModified: h.Get("Last-Modified"),
+		Expires:      c.now().Add(ttl).Unix(),
+	}
+	if ttl <= 0 && !e.revalidatable() {
+		return // could never be reused
+	}
+	c.put(e)
+}
+
+// revalidated renews e after a 304, whose headers may carry new
+// freshness and validators.
+func (c *WebCache) revalidated(e *webCacheEntry, h http.Header) {
+	if c == nil {
+		return
+	}
+	ttl, ok := responseFreshness(h, c.now())
+	if !ok {
+		os.Remove(c.path(e.Key))
+		return
+	}
+	if etag := h.Get("ETag"); etag != "" {
+		e.ETag = etag
+	}
+	if lm := h.Get("Last-Modified"); lm != "" {
+		e.LastModified = lm
+	}
+	e.Expires = c.now().Add(ttl).Unix()
+	c.put(e)
+}
+
+// storeFor keeps text as the result of key for ttl.
+func (c *WebCache) storeFor(key, text string, ttl time.Duration) {
+	if c == nil {
+		return
+	}
+	c.put(&webCacheEntry{Key: key, Text: text, Expires: c.now().Add(ttl).Unix()})
+}
+
+// responseFreshness is how long a response may be reused without
+// revalidation, and false when it must not be stored at all.
+func responseFreshness(h http.Header, now time.Time) (time.Duration, bool) {
+	maxAge, noCache := time.Duration(-1), false
+	for _, dir := range strings.Split(strings.ToLower(h.Get("Cache-Control")), ",") {
+		name, value, _ := strings.Cut(strings.TrimSpace(dir), "=")
+		switch name {
+		case "no-store":
+			return 0, false
+		case "no-cache":
+			noCache = true
+		case "max-age":
+			if n, err := strconv.ParseInt(strings.Trim(value, `"`), 10, 64); err == nil && n >= 0 {
+				maxAge = time.Duration(n) * time.Second
+			}
+		}
+	}
+	if noCache {
+		return 0, true
+	}
+	if maxAge >= 0 {
+		return maxAge, true
+	}
+
+	date := now
+	if d, err := http.ParseTime(h.Get("Date")); err == nil {
+		date = d
+	}
+	if exp := h.Get("Expires"); exp != "" {
+		t, err := http.ParseTime(exp)
+		if err != nil || !t.After(date) {
+			return 0, true // an invalid Expires means already expired
+		}
+		return t.Sub(date), true
+	}
+	if lm, err := http.ParseTime(h.Get("Last-Modified")); err == nil && lm.Before(date) {
+		return min(date.Sub(lm)/10, heuristicMaxTTL), true
+	}
+	return 0, true
+}
@@ -0,0 +1,222 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+package agent
+
+import (
+	"context"
+	"encoding/json"
+	"net/http"
+	"net/http/httptest"
+	"os"
+	"path/filepath"
+	"sync/atomic"
+	"testing"
+	"time"
+)
+
+// testWebCache opens a cache in a temp dir whose clock the test moves.
+func testWebCache(t *testing.T) (*WebCache, *time.Time) {
+	t.Helper()
+	now := time.Unix(1_800_000_000, 0)
+	c := OpenWebCache(t.TempDir())
+	c.now = func() time.Time { return now }
+	return c, &now
+}
+
+func fetchText(t *testing.T, tool *WebFetchTool, url string) string {
+	t.Helper()
+	input, _ := json.Marshal(map[string]string{"url": url})
+	result, isError, err := tool.Execute(context.Background(), input)
+	if err != nil || isError {
+		t.Fatalf("fetch %s: %q, %v", url, result, err)
+	}
+	return result
+}
+
+func TestResponseFreshness(t *testing.T) {
+	now := time.Date(2026, 3, 1, 12, 0, 0, 0, time.UTC)
+	cases := []struct {
+		name   string
+		header map[string]string
+		ttl    time.Duration
+		store  bool
+	}{
+		{"none", nil, 0, true},
+		{"no-store", map[string]string{"Cache-Control": "max-age=600, no-store"}, 0, false},
+		{"max-age", map[string]string{"Cache-Control": "public, max-age=600"}, 10 * time.Minute, true},
+		{"no-cache wins", map[string]string{"Cache-Control": "max-age=600, no-cache"}, 0, true},
+		{"max-age over Expires", map[string]string{
+			"Cache-Control": "max-age=60",
+			"Expires":       now.Add(time.Hour).Format(http.TimeFormat),
+		}, time.Minute, true},
+		{"Expires", map[string]string{
+			"Date":    now.Format(http.TimeFormat),
+			"Expires": now.Add(2 * time.Hour).Format(http.TimeFormat),
+		}, 2 * time.Hour, true},
+		{"invalid Expires", map[string]string{"Expires": "0"}, 0, true},
+		{"Last-Modified heuristic", map[string]string{
+			"Last-Modified": now.Add(-10 * time.Hour).Format(http.TimeFormat),
+		}, time.Hour, true},
+		{"heuristic capped", map[string]string{
+			"Last-Modified": now.Add(-1000 * time.Hour).Format(http.TimeFormat),
+		}, heuristicMaxTTL, true},
+	}
+	for _, tc := range cases {
+		h := http.Header{}
+		for k, v := range tc.header {
+			h.Set(k, v)
+		}
+		ttl, store := responseFreshness(h, now)
+		if ttl != tc.ttl || store != tc.store {
+			t.Errorf("%s: got (%v, %v), want (%v, %v)", tc.name, ttl, store, tc.ttl, tc.store)
+		}
+	}
+}
+
+func TestWebFetchTool_CacheMaxAge(t *testing.T) {
+	var hits atomic.Int32
+	server := httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		hits.Add(1)
+		w.Header().Set("Cache-Control", "max-age=60")
+		w.Write([]byte(`<html><body><p>Company page</p></body></html>`))
+	}))
+	defer server.Close()
+
+	cache, now := testWebCache(t)
+	tool := &WebFetchTool{Cache: cache}
+
+	if got := fetchText(t, tool, server.URL); got != "Company page" {
+		t.Errorf("first fetch: got %q", got)
+	}
+	if got := fetchText(t, tool, server.URL); got != "Company page" {
+		t.Errorf("cached fetch: got %q", got)
+	}
+	if hits.Load() != 1 {
+		t.Errorf("fresh entry should be served from the cache, server hit %d times", hits.Load())
+	}
+
+	*now = now.Add(61 * time.Second)
+	fetchText(t, tool, server.URL)
+	if hits.Load() != 2 {
+		t.Errorf("stale entry should be refetched, server hit %d times", hits.Load())
+	}
+}
+
+func TestWebFetchTool_CacheRevalidatesETag(t *testing.T) {
+	var full, notModified atomic.Int32
+	server := httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		w.Header().Set("ETag", `"v1"`)
+		w.Header().Set("Cache-Control", "no-cache")
+		if r.Header.Get("If-None-Match") == `"v1"` {
+			notModified.Add(1)
+			w.WriteHeader(http.StatusNotModified)
+			return
+		}
+		full.Add(1)
+		w.Write([]byte(`<html><body><p>Agenda v1</p></body></html>`))
+	}))
+	defer server.Close()
+
+	cache, _ := testWebCache(t)
+	tool := &WebFetchTool{Cache: cache}
+	fetchText(t, tool, server.URL)
+	if got := fetchText(t, tool, server.URL); got != "Agenda v1" {
+		t.Errorf("revalidated fetch: got %q", got)
+	}
+	if full.Load() != 1 || notModified.Load() != 1 {
+		t.Errorf("expected one full response and one 304, got %d and %d", full.Load(), notModified.Load())
+	}
+}
+
+func TestWebFetchTool_NoStoreIsNotCached(t *testing.T) {
+	var hits atomic.Int32
+	server := httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		hits.Add(1)
+		w.Header().Set("Cache-Control", "no-store, max-age=600")
+		w.Write([]byte(`<html><body><p>Private</p></body></html>`))
+	}))
+	defer server.Close()
+
+	cache, _ := testWebCache(t)
+	tool := &WebFetchTool{Cache: cache}
+	fetchText(t, tool, server.URL)
+	fetchText(t, tool, server.URL)
+	if hits.Load() != 2 {
+		t.Errorf("no-store response should not be cached, server hit %d times", hits.Load())
+	}
+}
+
+func TestWebSearchTool_CacheTTL(t *testing.T) {
+	var hits atomic.Int32
+	var failing atomic.Bool
+	server := httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		hits.Add(1)
+		if failing.Load() {
+			http.Error(w, "rate limited", http.StatusTooManyRequests)
+			return
+		}
+		w.Write([]byte(`{"web":{"results":[{"title":"Acme","url":"https://acme.example","description":"Acme Corp"}]}}`))
+	}))
+	defer server.Close()
+
+	cache, now := testWebCache(t)
+	tool := &WebSearchTool{APIKey: "k", BaseURL: server.URL, Cache: cache}
+	search := func(q string) (string, bool) {
+		input, _ := json.Marshal(map[string]string{"query": q})
+		result, isError, _ := tool.Execute(context.Background(), input)
+		return result, isError
+	}
+
+	first, _ := search("acme")
+	second, _ := search("acme")
+	if first != second || hits.Load() != 1 {
+		t.Errorf("repeated search should be served from the cache, server hit %d times", hits.Load())
+	}
+
+	// Errors are not kept: the next call after one asks again.
+	failing.Store(true)
+	if _, isError := search("other"); !isError {
+		t.Error("expected a tool error for HTTP 429")
+	}
+	failing.Store(false)
+	if _, isError := search("other"); isError || hits.Load() != 3 {
+		t.Errorf("failed search should not be cached, server hit %d times", hits.Load())
+	}
+
+	*now = now.Add(searchCacheTTL)
+	search("acme")
+	if hits.Load() != 4 {
+		t.Errorf("search past its TTL should be repeated, server hit %d times", hits.Load())
+	}
+}
+
+func TestOpenWebCache(t *testing.T) {
+	if OpenWebCache("") != nil {
+		t.Error("empty dir should disable the cache")
+	}
+	var nilCache *WebCache
+	if nilCache.lookup("fetch x") != nil || nilCache.fresh(nil) {
+		t.Error("nil cache should hold nothing")
+	}
+
+	dir := t.TempDir()
+	c := OpenWebCache(dir)
+	c.storeFor("search old", "old", time.Hour)
+	c.storeFor("search new", "new", time.Hour)
+	old := time.Now().Add(-webCacheMaxAge - time.Hour)
+	if err := os.Chtimes(c.path("search old"), old, old); err != nil {
+		t.Fatal(err)
+	}
+
+	c = OpenWebCache(dir)
+	if _, err := os.Stat(c.path("search old")); !os.IsNotExist(err) {
+		t.Error("entry unused for webCacheMaxAge should be pruned")
+	}
+	if e := c.lookup("search new"); e == nil || e.Text != "new" {
+		t.Errorf("recent entry should survive the prune, got %+v", e)
+	}
+	if files, _ := filepath.Glob(filepath.Join(dir, ".web-*")); len(files) != 0 {
+		t.Errorf("temp files left behind: %v", files)
+	}
+}
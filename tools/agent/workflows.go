@@ -86,28 +86,32 @@ func FollowUpWorkflow(ctx context.Context, cfg AgentConfig, notePath string, out
 
 func buildPrepRegistry(cfg AgentConfig) *ToolRegistry {
 	reg := NewToolRegistry()
+	cache := OpenWebCache(cfg.WebCacheDir)
 	reg.Register(&SearchMeetingsTool{NoteDir: cfg.NoteDir, OutputDir: cfg.OutputDir})
+	reg.Register(&SearchTranscriptsTool{NoteDir: cfg.NoteDir, OutputDir: cfg.OutputDir})
 	reg.Register(&GetMeetingTool{NoteDir: cfg.NoteDir, OutputDir: cfg.OutputDir})
 	reg.Register(&ListActionItemsTool{NoteDir: cfg.NoteDir, OutputDir: cfg.OutputDir})
 	reg.Register(&GetSpeakerProfilesTool{SpeakerDB: cfg.SpeakerDB})
 	if cfg.BraveAPIKey != "" {
-		reg.Register(&WebSearchTool{APIKey: cfg.BraveAPIKey})
+		reg.Register(&WebSearchTool{APIKey: cfg.BraveAPIKey, Cache: cache})
 	}
-	reg.Register(&WebFetchTool{})
+	reg.Register(&WebFetchTool{Cache: cache})
 	reg.Register(&WriteFileTool{})
 	return reg
 }
 
 func buildFollowUpRegistry(cfg AgentConfig, outputDir string) *ToolRegistry {
 	reg := NewToolRegistry()
+	cache := OpenWebCache(cfg.WebCacheDir)
 	reg.Register(&SearchMeetingsTool{NoteDir: cfg.NoteDir, OutputDir: cfg.OutputDir})
+	reg.Register(&SearchTranscriptsTool{NoteDir: cfg.NoteDir, OutputDir: cfg.OutputDir})
 	reg.Register(&GetMeetingTool{NoteDir: cfg.NoteDir, OutputDir: cfg.OutputDir})
 	reg.Register(&ListActionItemsTool{NoteDir: cfg.NoteDir, OutputDir: cfg.OutputDir})
 	reg.Register(&GetSpeakerProfilesTool{SpeakerDB: cfg.SpeakerDB})
 	if cfg.BraveAPIKey != "" {
-		reg.Register(&WebSearchTool{APIKey: cfg.BraveAPIKey})
+		reg.Register(&WebSearchTool{APIKey: cfg.BraveAPIKey, Cache: cache})
 	}
-	reg.Register(&WebFetchTool{})
+	reg.Register(&WebFetchTool{Cache: cache})
 	reg.Register(&WriteFileTool{})
 	return reg
 }
@@ -118,7 +122,9 @@ func buildPrepSystemPrompt(description string, participants []string, agendaURL
 Your job is to prepare comprehensive context for an upcoming meeting.
 
 You should:
-1. Search past meetings involving the participants to find relevant history
+1. Search past meetings involving the participants to find relevant history,
+   and use search_transcripts to pull the passages about the meeting's topics
+   rather than reading whole meetings with get_meeting
 2. Look up any open action items assigned to the participants
 3. If an agenda URL is provided, fetch and analyze it
 4. If web search is available, research the participants and relevant topics
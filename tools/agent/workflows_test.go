@@ -189,7 +189,7 @@ func TestBuildPrepRegistry(t *testing.T) {
 	reg := buildPrepRegistry(cfg)
 
 	// Should have all tools registered
-	expectedTools := []string{"search_meetings", "get_meeting", "list_action_items", "get_speaker_profiles", "web_search", "web_fetch", "write_file"}
+	expectedTools := []string{"search_meetings", "search_transcripts", "get_meeting", "list_action_items", "get_speaker_profiles", "web_search", "web_fetch", "write_file"}
 	for _, name := range expectedTools {
 		if reg.Get(name) == nil {
 			t.Errorf("expected tool %q to be registered", name)
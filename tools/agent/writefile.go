@@ -14,6 +14,10 @@ import (
 // WriteFileTool writes content to a file, creating parent directories as needed.
 type WriteFileTool struct{}
 
+// Serial keeps a write from overlapping other tool calls in the same
+// response, which may read the file.
+func (t *WriteFileTool) Serial() bool { return true }
+
 func (t *WriteFileTool) Definition() ToolDefinition {
 	return ToolDefinition{
 		Name:        "write_file",
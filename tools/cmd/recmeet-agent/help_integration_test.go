@@ -40,6 +40,7 @@ func TestAgentCLI_Help_Prep(t *testing.T) {
 		"--dry-run",
 		"--config",
 		"--max-iterations",
+		"--no-web-cache",
 	}
 	for _, f := range wantFlags {
 		if !strings.Contains(res.Stdout, f) {
@@ -64,6 +65,7 @@ func TestAgentCLI_Help_FollowUp(t *testing.T) {
 		"--dry-run",
 		"--config",
 		"--max-iterations",
+		"--no-web-cache",
 	}
 	for _, f := range wantFlags {
 		if !strings.Contains(res.Stdout, f) {
@@ -41,6 +41,7 @@ func prepCmd() *cobra.Command {
 		dryRun        bool
 		configPath    string
 		maxIterations int
+		noWebCache    bool
 	)
 
 	cmd := &cobra.Command{
@@ -61,6 +62,9 @@ func prepCmd() *cobra.Command {
 			if maxIterations > 0 {
 				cfg.MaxIterations = maxIterations
 			}
+			if noWebCache {
+				cfg.WebCacheDir = ""
+			}
 			if cfg.ContextDir == "" {
 				cfg.ContextDir = "."
 			}
@@ -95,6 +99,7 @@ func prepCmd() *cobra.Command {
 	cmd.Flags().BoolVar(&dryRun, "dry-run", false, "Print prompts without calling API")
 	cmd.Flags().StringVar(&configPath, "config", "", "Config file path")
 	cmd.Flags().IntVar(&maxIterations, "max-iterations", 0, "override max agent loop iterations (0 = use config default of 20)")
+	cmd.Flags().BoolVar(&noWebCache, "no-web-cache", false, "Fetch and search without the web result cache")
 
 	return cmd
 }
@@ -108,6 +113,7 @@ func followUpCmd() *cobra.Command {
 		dryRun        bool
 		configPath    string
 		maxIterations int
+		noWebCache    bool
 	)
 
 	cmd := &cobra.Command{
@@ -139,6 +145,9 @@ func followUpCmd() *cobra.Command {
 			if maxIterations > 0 {
 				cfg.MaxIterations = maxIterations
 			}
+			if noWebCache {
+				cfg.WebCacheDir = ""
+			}
 			if outputDir == "" {
 				outputDir = "."
 			}
@@ -161,6 +170,7 @@ func followUpCmd() *cobra.Command {
 	cmd.Flags().BoolVar(&dryRun, "dry-run", false, "Print prompts without calling API")
 	cmd.Flags().StringVar(&configPath, "config", "", "Config file path")
 	cmd.Flags().IntVar(&maxIterations, "max-iterations", 0, "override max agent loop iterations (0 = use config default of 20)")
+	cmd.Flags().BoolVar(&noWebCache, "no-web-cache", false, "Fetch and search without the web result cache")
 
 	return cmd
 }
@@ -0,0 +1,289 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+package main
+
+import (
+	"encoding/json"
+	"fmt"
+	"math"
+	"os"
+	"path/filepath"
+	"sort"
+	"strings"
+)
+
+// ResultFile is one benchmark run as written by the C++ benchmarks:
+// build/benchmark_results.json ("benchmark", from BenchmarkResults in
+// tests/test_helpers.h) or recmeet_microbench --json ("microbench").
+type ResultFile struct {
+	Kind        string           `json:"kind"`
+	Timestamp   string           `json:"timestamp"`
+	Environment map[string]any   `json:"environment"`
+	Results     []map[string]any `json:"results"`
+
+	path string
+}
+
+// LoadResultFile reads a result file. Files from before results carried a
+// kind are recognised by their shape.
+func LoadResultFile(path string) (*ResultFile, error) {
+	data, err := os.ReadFile(path)
+	if err != nil {
+		return nil, err
+	}
+	var rf ResultFile
+	if err := json.Unmarshal(data, &rf); err != nil {
+		return nil, fmt.Errorf("%s: %w", path, err)
+	}
+	if rf.Kind == "" && len(rf.Results) > 0 {
+		if _, ok := rf.Results[0]["test"]; ok {
+			rf.Kind = "benchmark"
+		} else if _, ok := rf.Results[0]["median_ns"]; ok {
+			rf.Kind = "microbench"
+		}
+	}
+	if rf.Kind == "" {
+		return nil, fmt.Errorf("%s: not a recmeet benchmark result file", path)
+	}
+	rf.path = path
+	return &rf, nil
+}
+
+func (rf *ResultFile) env(key string) string {
+	if v, ok := rf.Environment[key]; ok {
+		return fmt.Sprint(v)
+	}
+	return ""
+}
+
+// resultKey names a result so the same measurement is found in another run.
+func resultKey(kind string, r map[string]any) string {
+	str := func(k string) string {
+		if v, ok := r[k].(string); ok {
+			return v
+		}
+		return ""
+	}
+	if kind == "microbench" {
+		return str("name") + "/" + str("scale")
+	}
+	if m := str("model"); m != "" {
+		return str("test") + "/" + m
+	}
+	return str("test")
+}
+
+// Direction says which way a metric improves.
+type Direction int
+
+const (
+	Ignored Direction = iota
+	LowerIsBetter
+	HigherIsBetter
+)
+
+// metricDirection classifies a result field by name. Only throughput, time
+// (and RTF) and peak memory are compared; counts, ratios between two
+// measurements of the same run and quality scores are left out.
+func metricDirection(kind, name string) Direction {
+	if kind == "microbench" {
+		if name == "median_ns" {
+			return LowerIsBetter
+		}
+		return Ignored
+	}
+	switch {
+	case strings.HasSuffix(name, "_per_sec"), strings.HasPrefix(name, "throughput"):
+		return HigherIsBetter
+	case name == "rtf", strings.HasSuffix(name, "_rtf"),
+		strings.HasSuffix(name, "_secs"), strings.HasSuffix(name, "_sec"),
+		strings.HasSuffix(name, "_ms"), strings.HasSuffix(name, "_ns"),
+		strings.HasSuffix(name, "_peak_kb"), strings.HasSuffix(name, "_rss_kb"):
+		return LowerIsBetter
+	}
+	return Ignored
+}
+
+// Change is one metric of one result, compared.
+type Change struct {
+	Key      string
+	Metric   string
+	Baseline float64
+	Current  float64
+	Percent  float64 // positive = worse, whichever the direction
+	Noise    float64 // the change that counts as noise, in the metric's unit
+}
+
+// Comparison is CURRENT against BASELINE.
+type Comparison struct {
+	Regressions  []Change
+	Improvements []Change
+	Unchanged    int
+	Missing      []string // results in the baseline that the current run lacks
+	EnvNotes     []string // how the two environments differ
+}
+
+// CompareOptions set what counts as noise. A change is only reported when
+// it exceeds Threshold percent and, for microbench results, also
+// NoiseMADs times the two runs' median absolute deviations.
+type CompareOptions struct {
+	Threshold float64
+	NoiseMADs float64
+}
+
+// Compare reports the metrics of cur that moved beyond the noise against base.
+func Compare(base, cur *ResultFile, opt CompareOptions) (*Comparison, error) {
+	if base.Kind != cur.Kind {
+		return nil, fmt.Errorf("cannot compare %s results with %s results", cur.Kind, base.Kind)
+	}
+	c := &Comparison{}
+	for _, k := range []string{"host", "cpu", "device", "sample_kernels", "kernel"} {
+		if b, n := base.env(k), cur.env(k); b != n && b != "" && n != "" {
+			c.EnvNotes = append(c.EnvNotes, fmt.Sprintf("%s differs: %s (baseline) vs %s", k, b, n))
+		}
+	}
+
+	curByKey := map[string]map[string]any{}
+	for _, r := range cur.Results {
+		curByKey[resultKey(cur.Kind, r)] = r
+	}
+	for _, br := range base.Results {
+		key := resultKey(base.Kind, br)
+		cr, ok := curByKey[key]
+		if !ok {
+			c.Missing = append(c.Missing, key)
+			continue
+		}
+		metrics := make([]string, 0, len(br))
+		for m := range br {
+			metrics = append(metrics, m)
+		}
+		sort.Strings(metrics)
+		for _, m := range metrics {
+			dir := metricDirection(base.Kind, m)
+			if dir == Ignored {
+				continue
+			}
+			bv, ok1 := br[m].(float64)
+			cv, ok2 := cr[m].(float64)
+			if !ok1 || !ok2 || bv <= 0 {
+				continue
+			}
+			delta := cv - bv
+			if dir == HigherIsBetter {
+				delta = -delta
+			}
+			noise := bv * opt.Threshold / 100
+			if base.Kind == "microbench" {
+				bm, _ := br["mad_ns"].(float64)
+				cm, _ := cr["mad_ns"].(float64)
+				noise = math.Max(noise, opt.NoiseMADs*(bm+cm))
+			}
+			ch := Change{Key: key, Metric: m, Baseline: bv, Current: cv,
+				Percent: 100 * delta / bv, Noise: noise}
+			switch {
+			case delta > noise:
+				c.Regressions = append(c.Regressions, ch)
+			case -delta > noise:
+				c.Improvements = append(c.Improvements, ch)
+			default:
+				c.Unchanged++
+			}
+		}
+	}
+	return c, nil
+}
+
+// RecordPath is where Record stores rf under dir:
+// <dir>/<host>/<kind>-<timestamp>-<sha>.json.
+func RecordPath(dir string, rf *ResultFile) string {
+	host := rf.env("host")
+	if host == "" {
+		host = "unknown-host"
+	}
+	sha := rf.env("git_sha")
+	if sha == "" {
+		sha = "nosha"
+	}
+	ts := strings.NewReplacer(":", "", "-", "", "T", "-").Replace(rf.Timestamp)
+	if ts == "" {
+		ts = "undated"
+	}
+	return filepath.Join(dir, sanitize(host), fmt.Sprintf("%s-%s-%s.json", rf.Kind, sanitize(ts), sanitize(sha)))
+}
+
+func sanitize(s string) string {
+	return strings.Map(func(r rune) rune {
+		if r == '/' || r == '\\' || r == ' ' || r < 0x20 {
+			return '_'
+		}
+		return r
+	}, s)
+}
+
+// Record copies the result file at src into the history under dir and
+// returns where it went.
+func Record(dir, src string) (string, error) {
+	rf, err := LoadResultFile(src)
+	if err != nil {
+		return "", err
+	}
+	data, err := os.ReadFile(src)
+	if err != nil {
+		return "", err
+	}
+	dst := RecordPath(dir, rf)
+	if err := os.MkdirAll(filepath.Dir(dst), 0755); err != nil {
+		return "", err
+	}
+	tmp := dst + ".tmp"
+	if err := os.WriteFile(tmp, data, 0644); err != nil {
+		return "", err
+	}
+	return dst, os.Rename(tmp, dst)
+}
+
+// FindBaseline resolves a baseline argument: a result file as is, or in a
+// history directory the newest recorded file of cur's kind, preferring
+// cur's host and skipping cur's own commit.
+func FindBaseline(arg string, cur *ResultFile) (*ResultFile, error) {
+	st, err := os.Stat(arg)
+	if err != nil {
+		return nil, err
+	}
+	if !st.IsDir() {
+		return LoadResultFile(arg)
+	}
+	var sameHost, otherHost []*ResultFile
+	err = filepath.WalkDir(arg, func(p string, d os.DirEntry, err error) error {
+		if err != nil || d.IsDir() || !strings.HasSuffix(p, ".json") {
+			return err
+		}
+		rf, lerr := LoadResultFile(p)
+		if lerr != nil || rf.Kind != cur.Kind {
+			return nil
+		}
+		if sha := cur.env("git_sha"); sha != "" && rf.env("git_sha") == sha {
+			return nil
+		}
+		if rf.env("host") == cur.env("host") {
+			sameHost = append(sameHost, rf)
+		} else {
+			otherHost = append(otherHost, rf)
+		}
+		return nil
+	})
+	if err != nil {
+		return nil, err
+	}
+	pick := sameHost
+	if len(pick) == 0 {
+		pick = otherHost
+	}
+	if len(pick) == 0 {
+		return nil, fmt.Errorf("no %s baseline under %s", cur.Kind, arg)
+	}
+	sort.Slice(pick, func(i, j int) bool { return pick[i].Timestamp > pick[j].Timestamp })
+	return pick[0], nil
+}
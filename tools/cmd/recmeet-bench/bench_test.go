@@ -0,0 +1,174 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+package main
+
+import (
+	"bytes"
+	"os"
+	"path/filepath"
+	"strings"
+	"testing"
+)
+
+func writeFile(t *testing.T, dir, name, body string) string {
+	t.Helper()
+	p := filepath.Join(dir, name)
+	if err := os.WriteFile(p, []byte(body), 0644); err != nil {
+		t.Fatal(err)
+	}
+	return p
+}
+
+const microBase = `{"kind":"microbench","timestamp":"2026-03-14T09:00:00",
+"environment":{"git_sha":"aaa1111","host":"box","cpu":"Xeon","sample_kernels":"avx2","device":"cpu"},
+"results":[
+{"name":"merge_speakers","scale":"1h","median_ns":1000000,"mad_ns":10000,"items_per_sec":5},
+{"name":"mix_audio","scale":"1h","median_ns":2000000,"mad_ns":400000},
+{"name":"ipc_parse_message","scale":"1h","median_ns":3000000,"mad_ns":1000}
+]}`
+
+const microCur = `{"kind":"microbench","timestamp":"2026-03-15T09:00:00",
+"environment":{"git_sha":"bbb2222","host":"box","cpu":"Xeon","sample_kernels":"avx2","device":"cpu"},
+"results":[
+{"name":"merge_speakers","scale":"1h","median_ns":1300000,"mad_ns":10000,"items_per_sec":1},
+{"name":"mix_audio","scale":"1h","median_ns":2300000,"mad_ns":400000},
+{"name":"ipc_parse_message","scale":"1h","median_ns":2500000,"mad_ns":1000},
+{"name":"new_case","scale":"1h","median_ns":1,"mad_ns":0}
+]}`
+
+func TestCompareMicrobenchUsesMADs(t *testing.T) {
+	dir := t.TempDir()
+	base, err := LoadResultFile(writeFile(t, dir, "base.json", microBase))
+	if err != nil {
+		t.Fatal(err)
+	}
+	cur, err := LoadResultFile(writeFile(t, dir, "cur.json", microCur))
+	if err != nil {
+		t.Fatal(err)
+	}
+	c, err := Compare(base, cur, CompareOptions{Threshold: 5, NoiseMADs: 3})
+	if err != nil {
+		t.Fatal(err)
+	}
+	// merge_speakers: +30%, far beyond its MADs. mix_audio: +15%, but
+	// within 3x its 20% MADs. ipc_parse: -17%, an improvement.
+	if len(c.Regressions) != 1 || c.Regressions[0].Key != "merge_speakers/1h" {
+		t.Fatalf("regressions = %+v", c.Regressions)
+	}
+	if c.Regressions[0].Metric != "median_ns" {
+		t.Errorf("only median_ns is compared for microbench, got %s", c.Regressions[0].Metric)
+	}
+	if len(c.Improvements) != 1 || c.Improvements[0].Key != "ipc_parse_message/1h" {
+		t.Fatalf("improvements = %+v", c.Improvements)
+	}
+	if c.Unchanged != 1 {
+		t.Errorf("unchanged = %d, want 1", c.Unchanged)
+	}
+	if len(c.EnvNotes) != 0 {
+		t.Errorf("same host, got notes %v", c.EnvNotes)
+	}
+}
+
+func TestCompareBenchmarkMetrics(t *testing.T) {
+	dir := t.TempDir()
+	base, _ := LoadResultFile(writeFile(t, dir, "b.json", `{"timestamp":"2026-03-14T09:00:00","results":[
+{"test":"whisper_transcription","model":"base","time_secs":100.0,"rtf":0.10,"wer":0.20,"segments":50},
+{"test":"chunked_vs_single","single_peak_kb":1000000,"chunked_peak_kb":400000,"peak_rss_ratio":0.4}]}`))
+	cur, _ := LoadResultFile(writeFile(t, dir, "c.json", `{"kind":"benchmark","timestamp":"2026-03-15T09:00:00",
+"environment":{"host":"other","device":"Vulkan|RX|6.1"},"results":[
+{"test":"whisper_transcription","model":"base","time_secs":103.0,"rtf":0.12,"wer":0.40,"segments":90},
+{"test":"chunked_vs_single","single_peak_kb":1000000,"chunked_peak_kb":500000,"peak_rss_ratio":0.5}]}`))
+	if base == nil || cur == nil || base.Kind != "benchmark" {
+		t.Fatal("a file without kind but with test entries is a benchmark file")
+	}
+	c, err := Compare(base, cur, CompareOptions{Threshold: 5})
+	if err != nil {
+		t.Fatal(err)
+	}
+	got := map[string]bool{}
+	for _, r := range c.Regressions {
+		got[r.Key+" "+r.Metric] = true
+	}
+	want := []string{"whisper_transcription/base rtf", "chunked_vs_single chunked_peak_kb"}
+	if len(got) != len(want) {
+		t.Fatalf("regressions = %v, want %v", got, want)
+	}
+	for _, w := range want {
+		if !got[w] {
+			t.Errorf("missing regression %s in %v", w, got)
+		}
+	}
+	// time_secs +3% and single_peak_kb unchanged; wer, segments and the
+	// ratio are not compared.
+	if c.Unchanged != 2 {
+		t.Errorf("unchanged = %d, want 2", c.Unchanged)
+	}
+}
+
+func TestCompareRejectsMixedKinds(t *testing.T) {
+	dir := t.TempDir()
+	a, _ := LoadResultFile(writeFile(t, dir, "a.json", microBase))
+	b, _ := LoadResultFile(writeFile(t, dir, "b.json", `{"kind":"benchmark","results":[]}`))
+	if _, err := Compare(a, b, CompareOptions{}); err == nil {
+		t.Fatal("comparing microbench with benchmark results should fail")
+	}
+}
+
+func TestRecordAndFindBaseline(t *testing.T) {
+	dir := t.TempDir()
+	hist := filepath.Join(dir, "history")
+	basePath := writeFile(t, dir, "base.json", microBase)
+	dst, err := Record(hist, basePath)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if want := filepath.Join(hist, "box", "microbench-20260314-090000-aaa1111.json"); dst != want {
+		t.Errorf("recorded to %s, want %s", dst, want)
+	}
+	older := strings.Replace(strings.Replace(microBase, "2026-03-14", "2026-03-01", 1), "aaa1111", "ccc3333", 1)
+	if _, err := Record(hist, writeFile(t, dir, "older.json", older)); err != nil {
+		t.Fatal(err)
+	}
+	other := strings.Replace(strings.Replace(microBase, `"box"`, `"laptop"`, 1), "2026-03-14", "2026-03-20", 1)
+	if _, err := Record(hist, writeFile(t, dir, "other.json", other)); err != nil {
+		t.Fatal(err)
+	}
+
+	cur, _ := LoadResultFile(writeFile(t, dir, "cur.json", microCur))
+	base, err := FindBaseline(hist, cur)
+	if err != nil {
+		t.Fatal(err)
+	}
+	// Newest on the same host wins over a newer run elsewhere.
+	if base.env("git_sha") != "aaa1111" {
+		t.Errorf("baseline sha = %s, want aaa1111", base.env("git_sha"))
+	}
+
+	// A run is never its own baseline.
+	same, _ := LoadResultFile(basePath)
+	base, err = FindBaseline(hist, same)
+	if err != nil || base.env("git_sha") != "ccc3333" {
+		t.Errorf("baseline for aaa1111 = %v, %v; want ccc3333", base, err)
+	}
+}
+
+func TestRunCompareExitStatus(t *testing.T) {
+	dir := t.TempDir()
+	base := writeFile(t, dir, "base.json", microBase)
+	cur := writeFile(t, dir, "cur.json", microCur)
+	var out, errOut bytes.Buffer
+	if rc := run([]string{"compare", base, cur}, &out, &errOut); rc != 1 {
+		t.Fatalf("rc = %d, want 1 (a regression); stderr %s", rc, errOut.String())
+	}
+	if !strings.Contains(out.String(), "REGRESSED merge_speakers/1h median_ns") {
+		t.Errorf("output lacks the regression:\n%s", out.String())
+	}
+	out.Reset()
+	if rc := run([]string{"compare", "--threshold", "50", "--noise-mads", "0", base, cur}, &out, &errOut); rc != 0 {
+		t.Errorf("rc = %d with a 50%% threshold, want 0:\n%s", rc, out.String())
+	}
+	if rc := run([]string{"compare", base}, &out, &errOut); rc != 2 {
+		t.Errorf("rc = %d for a missing argument, want 2", rc)
+	}
+}
@@ -0,0 +1,140 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+// recmeet-bench keeps a history of benchmark results and compares a run
+// against it. Result files are build/benchmark_results.json from
+// `make benchmark` and build/microbench.json from `make microbench`; each
+// carries the git SHA, host, CPU and GPU it was measured on.
+//
+// Usage:
+//
+//	recmeet-bench record [--dir DIR] RESULT.json...
+//	recmeet-bench compare [--threshold PCT] [--noise-mads N] BASELINE RESULT.json
+//
+// BASELINE is a result file or a history directory (default layout
+// bench-results/history/<host>/), in which case the newest recorded run of
+// the same kind is used, preferring the same host. compare exits 1 when
+// any throughput, time/RTF or peak-RSS metric regressed beyond the noise.
+package main
+
+import (
+	"flag"
+	"fmt"
+	"io"
+	"math"
+	"os"
+)
+
+const defaultHistoryDir = "bench-results/history"
+
+func main() {
+	os.Exit(run(os.Args[1:], os.Stdout, os.Stderr))
+}
+
+func usage(w io.Writer) {
+	fmt.Fprintf(w, "Usage:\n"+
+		"  recmeet-bench record [--dir DIR] RESULT.json...\n"+
+		"  recmeet-bench compare [--threshold PCT] [--noise-mads N] BASELINE RESULT.json\n")
+}
+
+func run(args []string, stdout, stderr io.Writer) int {
+	if len(args) == 0 {
+		usage(stderr)
+		return 2
+	}
+	switch args[0] {
+	case "record":
+		return runRecord(args[1:], stdout, stderr)
+	case "compare":
+		return runCompare(args[1:], stdout, stderr)
+	case "-h", "--help", "help":
+		usage(stdout)
+		return 0
+	}
+	fmt.Fprintf(stderr, "recmeet-bench: unknown command %q\n", args[0])
+	usage(stderr)
+	return 2
+}
+
+func runRecord(args []string, stdout, stderr io.Writer) int {
+	fs := flag.NewFlagSet("record", flag.ContinueOnError)
+	fs.SetOutput(stderr)
+	dir := fs.String("dir", defaultHistoryDir, "history directory")
+	if err := fs.Parse(args); err != nil {
+		return 2
+	}
+	if fs.NArg() == 0 {
+		usage(stderr)
+		return 2
+	}
+	for _, src := range fs.Args() {
+		dst, err := Record(*dir, src)
+		if err != nil {
+			fmt.Fprintf(stderr, "recmeet-bench: %v\n", err)
+			return 2
+		}
+		fmt.Fprintf(stdout, "recorded %s -> %s\n", src, dst)
+	}
+	return 0
+}
+
+func runCompare(args []string, stdout, stderr io.Writer) int {
+	fs := flag.NewFlagSet("compare", flag.ContinueOnError)
+	fs.SetOutput(stderr)
+	threshold := fs.Float64("threshold", 5, "percent change below which a metric is unchanged")
+	mads := fs.Float64("noise-mads", 3, "microbench: also require a change larger than N times the summed MADs")
+	if err := fs.Parse(args); err != nil {
+		return 2
+	}
+	if fs.NArg() != 2 {
+		usage(stderr)
+		return 2
+	}
+	cur, err := LoadResultFile(fs.Arg(1))
+	if err != nil {
+		fmt.Fprintf(stderr, "recmeet-bench: %v\n", err)
+		return 2
+	}
+	base, err := FindBaseline(fs.Arg(0), cur)
+	if err != nil {
+		fmt.Fprintf(stderr, "recmeet-bench: %v\n", err)
+		return 2
+	}
+	c, err := Compare(base, cur, CompareOptions{Threshold: *threshold, NoiseMADs: *mads})
+	if err != nil {
+		fmt.Fprintf(stderr, "recmeet-bench: %v\n", err)
+		return 2
+	}
+
+	fmt.Fprintf(stdout, "%s: %s (%s) against baseline %s (%s)\n", cur.Kind,
+		orDash(cur.env("git_sha")), orDash(cur.Timestamp),
+		orDash(base.env("git_sha")), orDash(base.Timestamp))
+	for _, n := range c.EnvNotes {
+		fmt.Fprintf(stdout, "  note: %s\n", n)
+	}
+	printChanges(stdout, "REGRESSED", "worse", c.Regressions)
+	printChanges(stdout, "improved", "better", c.Improvements)
+	for _, k := range c.Missing {
+		fmt.Fprintf(stdout, "  missing   %s (in the baseline, not in this run)\n", k)
+	}
+	fmt.Fprintf(stdout, "%d regressed, %d improved, %d within noise (threshold %.1f%%)\n",
+		len(c.Regressions), len(c.Improvements), c.Unchanged, *threshold)
+	if len(c.Regressions) > 0 {
+		return 1
+	}
+	return 0
+}
+
+func printChanges(w io.Writer, label, word string, changes []Change) {
+	for _, ch := range changes {
+		fmt.Fprintf(w, "  %-9s %s %s: %.6g -> %.6g (%.1f%% %s, noise %.3g)\n",
+			label, ch.Key, ch.Metric, ch.Baseline, ch.Current, math.Abs(ch.Percent), word, ch.Noise)
+	}
+}
+
+func orDash(s string) string {
+	if s == "" {
+		return "-"
+	}
+	return s
+}
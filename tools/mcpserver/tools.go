@@ -94,21 +94,11 @@ func getMeetingHandler(cfg meetingdata.Config) server.ToolHandlerFunc {
 			return errorResult(err.Error()), nil
 		}
 
-		meetings, err := meetingdata.DiscoverMeetings(cfg.OutputDir)
+		found, err := meetingdata.LookupMeeting(cfg.OutputDir, dirName)
 		if err != nil {
-			return errorResult(fmt.Sprintf("discover meetings: %v", err)), nil
-		}
-
-		var info *meetingdata.MeetingInfo
-		for i := range meetings {
-			if meetings[i].DirName == dirName {
-				info = &meetings[i]
-				break
-			}
-		}
-		if info == nil {
 			return errorResult(fmt.Sprintf("meeting %q not found in %s", dirName, cfg.OutputDir)), nil
 		}
+		info := &found
 
 		type meetingDetail struct {
 			DirName  string                     `json:"dir_name"`
@@ -130,7 +120,7 @@ func getMeetingHandler(cfg meetingdata.Config) server.ToolHandlerFunc {
 
 		notePath, err := meetingdata.FindNoteForMeeting(*info, cfg.NoteDir)
 		if err == nil {
-			note, parseErr := meetingdata.ParseNote(notePath)
+			note, parseErr := meetingdata.CachedParseNote(notePath)
 			if parseErr == nil {
 				detail.Note = note
 			}
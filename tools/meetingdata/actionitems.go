@@ -12,6 +12,7 @@ type ActionItem struct {
 	Text        string
 	Done        bool
 	Assignee    string
+	Due         string `json:",omitempty"`
 	MeetingDate string
 	NotePath    string
 }
@@ -26,6 +27,15 @@ var (
 	checkboxRe = regexp.MustCompile(`^-\s*\[([ xX])\]\s*(.*)$`)
 	assigneeRe = regexp.MustCompile(`^\*\*\[([^\]]+)\]\*\*\s*[-:]\s*(.*)$`)
 	noneRe     = regexp.MustCompile(`(?i)^none\b`)
+	// dueRe matches the due date an item mentions. It, assigneeRe and
+	// noneRe match their counterparts in src/action_ledger.cpp, which
+	// records items as recmeet writes a note; keep them in step.
+	dueRe = regexp.MustCompile(`(?i)\b(?:by|before|due(?:\s+(?:by|on))?:?)\s+(` +
+		`\d{4}-\d{2}-\d{2}` +
+		`|(?:jan|feb|mar|apr|may|jun|jul|aug|sep|oct|nov|dec)[a-z]*\.?\s+\d{1,2}(?:st|nd|rd|th)?` +
+		`|(?:mon|tues|wednes|thurs|fri|satur|sun)day` +
+		`|end of (?:day|week|month|quarter)` +
+		`|eod|eow|tomorrow|next week)\b`)
 )
 
 func extractActionItems(body string) []ActionItem {
@@ -71,6 +81,9 @@ func extractActionItems(body string) []ActionItem {
 			item.Assignee = am[1]
 			item.Text = am[2]
 		}
+		if dm := dueRe.FindStringSubmatch(item.Text); dm != nil {
+			item.Due = dm[1]
+		}
 
 		items = append(items, item)
 	}
@@ -86,31 +99,12 @@ func ExtractActionItems(note *MeetingNote) []ActionItem {
 	return items
 }
 
+// ListAllActionItems lists the action items of every note under noteDir
+// and outputDir, in note order, from the action-item ledger (ledger.go).
 func ListAllActionItems(noteDir, outputDir string, filters ActionItemFilters) ([]ActionItem, error) {
-	paths, err := findNotePaths(noteDir, outputDir)
-	if err != nil {
-		return nil, err
-	}
-
-	var allItems []ActionItem
-	for _, p := range paths {
-		note, err := ParseNote(p)
-		if err != nil {
-			continue
-		}
-
-		items := ExtractActionItems(note)
-		for _, item := range items {
-			if !matchesItemFilters(item, filters) {
-				continue
-			}
-			allItems = append(allItems, item)
-			if filters.Limit > 0 && len(allItems) >= filters.Limit {
-				return allItems, nil
-			}
-		}
-	}
-	return allItems, nil
+	l := defaultActionLedger()
+	l.Reconcile(noteDir, outputDir)
+	return l.Items(filters), nil
 }
 
 func matchesItemFilters(item ActionItem, filters ActionItemFilters) bool {
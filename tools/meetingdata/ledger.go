@@ -0,0 +1,228 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+package meetingdata
+
+import (
+	"bufio"
+	"bytes"
+	"encoding/json"
+	"os"
+	"path/filepath"
+	"sync"
+)
+
+// Action-item ledger.
+//
+// $XDG_DATA_HOME/recmeet/action_items.ndjson records every action item of
+// every note, so listing open items reads one file instead of parsing the
+// archive. recmeet writes a note's records as it writes the note
+// (src/action_ledger.cpp documents the format); Reconcile picks up notes
+// written or edited by anything else by comparing each note's mtime and
+// size with its ledger record, and drops notes that are gone.
+
+const ledgerVersion = 1
+
+type ledgerRecord struct {
+	Kind     string `json:"kind"`
+	Note     string `json:"note"`
+	MTime    int64  `json:"mtime,omitempty"`
+	Size     int64  `json:"size,omitempty"`
+	Date     string `json:"date,omitempty"`
+	Text     string `json:"text,omitempty"`
+	Assignee string `json:"assignee,omitempty"`
+	Due      string `json:"due,omitempty"`
+	Done     bool   `json:"done,omitempty"`
+}
+
+type ledgerNote struct {
+	mtime int64
+	size  int64
+	date  string
+	items []ActionItem
+}
+
+// ActionLedger is the persistent list of action items across all notes.
+type ActionLedger struct {
+	mu    sync.Mutex
+	path  string
+	notes map[string]*ledgerNote
+	order []string // note paths as last reconciled, in walk order
+}
+
+// DefaultActionLedgerPath is $XDG_DATA_HOME/recmeet/action_items.ndjson.
+func DefaultActionLedgerPath() string {
+	return filepath.Join(filepath.Dir(DefaultSpeakerDB()), "action_items.ndjson")
+}
+
+// OpenActionLedger loads the ledger saved at path. A missing file or one
+// of another version gives an empty ledger; an empty path keeps it in
+// memory.
+func OpenActionLedger(path string) *ActionLedger {
+	l := &ActionLedger{path: path, notes: map[string]*ledgerNote{}}
+	if path != "" {
+		l.load()
+	}
+	return l
+}
+
+func (l *ActionLedger) load() {
+	f, err := os.Open(l.path)
+	if err != nil {
+		return
+	}
+	defer f.Close()
+	sc := bufio.NewScanner(f)
+	sc.Buffer(make([]byte, 64*1024), 16*1024*1024)
+	if !sc.Scan() {
+		return
+	}
+	var head struct {
+		Version int `json:"version"`
+	}
+	if json.Unmarshal(sc.Bytes(), &head) != nil || head.Version != ledgerVersion {
+		return
+	}
+	for sc.Scan() {
+		var r ledgerRecord
+		if json.Unmarshal(sc.Bytes(), &r) != nil || r.Note == "" {
+			continue
+		}
+		n := l.notes[r.Note]
+		if n == nil {
+			n = &ledgerNote{}
+			l.notes[r.Note] = n
+		}
+		switch r.Kind {
+		case "note":
+			n.mtime, n.size, n.date = r.MTime, r.Size, r.Date
+		case "item":
+			n.items = append(n.items, ActionItem{Text: r.Text, Done: r.Done,
+				Assignee: r.Assignee, Due: r.Due, MeetingDate: r.Date, NotePath: r.Note})
+		}
+	}
+}
+
+// Reconcile brings the ledger up to date with the notes under noteDir and
+// outputDir. It returns how many notes were (re-)parsed, and saves the
+// ledger when anything changed.
+func (l *ActionLedger) Reconcile(noteDir, outputDir string) (int, error) {
+	files := findNoteFiles(noteDir, outputDir)
+
+	l.mu.Lock()
+	defer l.mu.Unlock()
+
+	seen := make(map[string]bool, len(files))
+	l.order = l.order[:0]
+	var stale []noteFile
+	var stalePaths []string
+	for _, f := range files {
+		f.path = filepath.Clean(f.path)
+		if seen[f.path] {
+			continue
+		}
+		seen[f.path] = true
+		l.order = append(l.order, f.path)
+		if n := l.notes[f.path]; n == nil || n.mtime != f.mtime || n.size != f.size {
+			stale = append(stale, f)
+			stalePaths = append(stalePaths, f.path)
+		}
+	}
+	changed := len(stale) > 0
+	for i, note := range defaultCache.ParseAll(stalePaths) {
+		f := stale[i]
+		if note == nil {
+			delete(l.notes, f.path)
+			continue
+		}
+		l.notes[f.path] = &ledgerNote{mtime: f.mtime, size: f.size,
+			date: note.Frontmatter.Date, items: ExtractActionItems(note)}
+	}
+	for p := range l.notes {
+		if !seen[p] {
+			delete(l.notes, p)
+			changed = true
+		}
+	}
+	if changed && l.path != "" {
+		return len(stale), l.save()
+	}
+	return len(stale), nil
+}
+
+// Items returns the items passing filters, in note order as last
+// reconciled.
+func (l *ActionLedger) Items(filters ActionItemFilters) []ActionItem {
+	l.mu.Lock()
+	defer l.mu.Unlock()
+	var out []ActionItem
+	for _, p := range l.order {
+		n := l.notes[p]
+		if n == nil {
+			continue
+		}
+		for _, item := range n.items {
+			if !matchesItemFilters(item, filters) {
+				continue
+			}
+			out = append(out, item)
+			if filters.Limit > 0 && len(out) >= filters.Limit {
+				return out
+			}
+		}
+	}
+	return out
+}
+
+// save writes the ledger through a temporary file. Called with l.mu held.
+func (l *ActionLedger) save() error {
+	var buf bytes.Buffer
+	enc := json.NewEncoder(&buf)
+	enc.SetEscapeHTML(false)
+	enc.Encode(struct {
+		Version int `json:"version"`
+	}{ledgerVersion})
+	for _, p := range l.order {
+		n := l.notes[p]
+		if n == nil {
+			continue
+		}
+		enc.Encode(ledgerRecord{Kind: "note", Note: p, MTime: n.mtime, Size: n.size, Date: n.date})
+		for _, it := range n.items {
+			enc.Encode(ledgerRecord{Kind: "item", Note: p, Date: n.date, Text: it.Text,
+				Assignee: it.Assignee, Due: it.Due, Done: it.Done})
+		}
+	}
+
+	if err := os.MkdirAll(filepath.Dir(l.path), 0755); err != nil {
+		return err
+	}
+	tmp, err := os.CreateTemp(filepath.Dir(l.path), ".action_items-*")
+	if err != nil {
+		return err
+	}
+	if _, err := tmp.Write(buf.Bytes()); err != nil {
+		tmp.Close()
+		os.Remove(tmp.Name())
+		return err
+	}
+	if err := tmp.Close(); err != nil {
+		os.Remove(tmp.Name())
+		return err
+	}
+	if err := os.Rename(tmp.Name(), l.path); err != nil {
+		os.Remove(tmp.Name())
+		return err
+	}
+	return nil
+}
+
+var (
+	sharedLedgerOnce sync.Once
+	sharedLedger     *ActionLedger
+)
+
+func defaultActionLedger() *ActionLedger {
+	sharedLedgerOnce.Do(func() { sharedLedger = OpenActionLedger(DefaultActionLedgerPath()) })
+	return sharedLedger
+}
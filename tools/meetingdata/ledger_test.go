@@ -0,0 +1,98 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+package meetingdata
+
+import (
+	"fmt"
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+)
+
+func TestActionLedger_Reconcile(t *testing.T) {
+	tmp := t.TempDir()
+	notes := filepath.Join(tmp, "notes")
+	os.MkdirAll(notes, 0755)
+	ledgerPath := filepath.Join(tmp, "data", "action_items.ndjson")
+	src, _ := os.ReadFile("testdata/meeting_full.md")
+	full := filepath.Join(notes, "Meeting_2026-03-15_14-30_Q1_Planning.md")
+	os.WriteFile(full, src, 0644)
+
+	l := OpenActionLedger(ledgerPath)
+	if n, err := l.Reconcile(notes, ""); n != 1 || err != nil {
+		t.Fatalf("first reconcile: %d parsed, err %v", n, err)
+	}
+	open := l.Items(ActionItemFilters{Status: "open", Assignee: "alice"})
+	if len(open) != 1 || open[0].Due != "March 18" || open[0].MeetingDate != "2026-03-15" {
+		t.Fatalf("open items for Alice: %+v", open)
+	}
+
+	// Reopened, the ledger answers without parsing.
+	l = OpenActionLedger(ledgerPath)
+	if n, _ := l.Reconcile(notes, ""); n != 0 {
+		t.Errorf("unchanged note re-parsed")
+	}
+	if got := len(l.Items(ActionItemFilters{Status: "all"})); got != 4 {
+		t.Errorf("reloaded ledger has %d items, want 4", got)
+	}
+
+	// An edited note is parsed again.
+	edited := append(src, []byte("\n")...)
+	os.WriteFile(full, edited, 0644)
+	future := time.Now().Add(time.Minute)
+	os.Chtimes(full, future, future)
+	if n, _ := l.Reconcile(notes, ""); n != 1 {
+		t.Errorf("edited note: %d parsed, want 1", n)
+	}
+	os.Remove(full)
+	l.Reconcile(notes, "")
+	if got := l.Items(ActionItemFilters{}); len(got) != 0 {
+		t.Errorf("removed note's items still listed: %+v", got)
+	}
+}
+
+// Records as recmeet's C++ side writes them (src/action_ledger.cpp) are
+// used as they are while the note is unchanged.
+func TestActionLedger_ReadsRecordsWrittenByRecmeet(t *testing.T) {
+	tmp := t.TempDir()
+	note := filepath.Join(tmp, "Meeting_2026-04-01_10-00.md")
+	os.WriteFile(note, []byte("---\ndate: 2026-04-01\n---\n\n## Action Items\n\n- [ ] **[Bob]** - Book a room\n"), 0644)
+	st, _ := os.Stat(note)
+
+	ledgerPath := filepath.Join(tmp, "action_items.ndjson")
+	ledger := fmt.Sprintf("{\"version\":1}\n"+
+		"{\"date\":\"2026-04-01\",\"kind\":\"note\",\"mtime\":%d,\"note\":%q,\"size\":%d}\n"+
+		"{\"assignee\":\"Bob\",\"date\":\"2026-04-01\",\"done\":false,\"due\":\"Friday\",\"kind\":\"item\",\"note\":%q,\"text\":\"Book a room by Friday\"}\n",
+		st.ModTime().UnixNano(), note, st.Size(), note)
+	os.WriteFile(ledgerPath, []byte(ledger), 0644)
+
+	l := OpenActionLedger(ledgerPath)
+	if n, _ := l.Reconcile(tmp, ""); n != 0 {
+		t.Fatalf("note with a current ledger record was parsed")
+	}
+	items := l.Items(ActionItemFilters{Assignee: "Bob"})
+	if len(items) != 1 || items[0].Text != "Book a room by Friday" || items[0].Due != "Friday" ||
+		items[0].NotePath != note {
+		t.Errorf("items from the ledger: %+v", items)
+	}
+}
+
+func TestExtractActionItems_DueDates(t *testing.T) {
+	body := "## Action Items\n\n" +
+		"- [ ] Ship it, due 2026-03-20.\n" +
+		"- [ ] Send the deck before friday\n" +
+		"- [ ] Wrap up by end of week\n" +
+		"- [ ] Stand by Bob's desk\n"
+	want := []string{"2026-03-20", "friday", "end of week", ""}
+	items := extractActionItems(body)
+	if len(items) != len(want) {
+		t.Fatalf("got %d items", len(items))
+	}
+	for i, w := range want {
+		if items[i].Due != w {
+			t.Errorf("item %d due = %q, want %q", i, items[i].Due, w)
+		}
+	}
+}
@@ -54,10 +54,13 @@ func DiscoverMeetings(outputDir string) ([]MeetingInfo, error) {
 }
 
 func findAudioFile(dirPath, date, time string) (string, bool) {
-	// Prefer timestamped: audio_YYYY-MM-DD_HH-MM.wav
-	timestamped := filepath.Join(dirPath, fmt.Sprintf("audio_%s_%s.wav", date, time))
-	if _, err := os.Stat(timestamped); err == nil {
-		return timestamped, true
+	// Prefer timestamped: audio_YYYY-MM-DD_HH-MM.wav, then the compressed
+	// archive forms (audio.archive: flac|opus) that replace it.
+	for _, ext := range []string{".wav", ".flac", ".opus"} {
+		timestamped := filepath.Join(dirPath, fmt.Sprintf("audio_%s_%s%s", date, time, ext))
+		if _, err := os.Stat(timestamped); err == nil {
+			return timestamped, true
+		}
 	}
 
 	// Fallback: audio.wav
@@ -121,3 +124,24 @@ func MatchNotesToMeetings(meetings []MeetingInfo, noteDir string) []MeetingInfo
 	}
 	return meetings
 }
+
+// LookupMeeting returns the meeting in outputDir/dirName without listing
+// the whole output directory.
+func LookupMeeting(outputDir, dirName string) (MeetingInfo, error) {
+	m := meetingDirRe.FindStringSubmatch(dirName)
+	if m == nil || filepath.Base(dirName) != dirName {
+		return MeetingInfo{}, fmt.Errorf("not a meeting directory name: %q", dirName)
+	}
+	dirPath := filepath.Join(outputDir, dirName)
+	if st, err := os.Stat(dirPath); err != nil || !st.IsDir() {
+		return MeetingInfo{}, fmt.Errorf("meeting %q not found in %s", dirName, outputDir)
+	}
+	info := MeetingInfo{
+		DirName: dirName,
+		DirPath: dirPath,
+		Date:    m[1],
+		Time:    strings.ReplaceAll(m[2], "-", ":"),
+	}
+	info.AudioPath, info.HasAudio = findAudioFile(dirPath, m[1], m[2])
+	return info, nil
+}
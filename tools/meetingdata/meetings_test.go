@@ -65,6 +65,24 @@ func TestDiscoverMeetings(t *testing.T) {
 	}
 }
 
+func TestDiscoverMeetings_ArchivedAudio(t *testing.T) {
+	tmp := t.TempDir()
+	dir := filepath.Join(tmp, "2026-04-01_10-00")
+	os.MkdirAll(dir, 0755)
+	os.WriteFile(filepath.Join(dir, "audio_2026-04-01_10-00.flac"), []byte("flac"), 0644)
+
+	meetings, err := DiscoverMeetings(tmp)
+	if err != nil {
+		t.Fatalf("DiscoverMeetings: %v", err)
+	}
+	if len(meetings) != 1 || !meetings[0].HasAudio {
+		t.Fatalf("expected one meeting with archived audio, got %+v", meetings)
+	}
+	if filepath.Base(meetings[0].AudioPath) != "audio_2026-04-01_10-00.flac" {
+		t.Errorf("AudioPath = %q", meetings[0].AudioPath)
+	}
+}
+
 func TestDiscoverMeetings_Empty(t *testing.T) {
 	tmp := t.TempDir()
 	meetings, err := DiscoverMeetings(tmp)
@@ -92,6 +110,23 @@ func TestDiscoverMeetings_NoAudio(t *testing.T) {
 	}
 }
 
+func TestLookupMeeting(t *testing.T) {
+	tmp := setupMeetingDir(t)
+
+	info, err := LookupMeeting(tmp, "2026-03-15_14-30")
+	if err != nil {
+		t.Fatalf("LookupMeeting: %v", err)
+	}
+	if info.Date != "2026-03-15" || info.Time != "14:30" || !info.HasAudio {
+		t.Errorf("unexpected meeting: %+v", info)
+	}
+	for _, name := range []string{"2026-03-16_10-00", "not-a-meeting", "../2026-03-15_14-30"} {
+		if _, err := LookupMeeting(tmp, name); err == nil {
+			t.Errorf("LookupMeeting(%q) should fail", name)
+		}
+	}
+}
+
 func TestFindNoteForMeeting(t *testing.T) {
 	tmp := t.TempDir()
 	dir := filepath.Join(tmp, "2026-03-15_14-30")
@@ -0,0 +1,197 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+package meetingdata
+
+import (
+	"os"
+	"runtime"
+	"sync"
+)
+
+// Parsed-note cache.
+//
+// A single MCP session issues dozens of tool calls, and each used to
+// re-read and re-parse the notes it touched. NoteCache keeps parsed notes
+// for the life of the process, keyed by path and invalidated by size and
+// mtime, so a repeated call only stats the files. Notes parsed in bulk by
+// ParseAll are kept without their transcript, which is most of a note's
+// size and which only Parse callers (a single meeting's details) need.
+
+// maxParseWorkers bounds the goroutines parsing notes in parallel.
+const maxParseWorkers = 8
+
+type cachedNote struct {
+	mtime int64
+	size  int64
+	note  *MeetingNote
+	full  bool // note includes the transcript
+}
+
+// NoteCache is a concurrency-safe cache of parsed meeting notes.
+type NoteCache struct {
+	mu      sync.Mutex
+	entries map[string]*cachedNote
+	parses  int
+}
+
+// NewNoteCache returns an empty cache.
+func NewNoteCache() *NoteCache {
+	return &NoteCache{entries: map[string]*cachedNote{}}
+}
+
+var defaultCache = NewNoteCache()
+
+// CachedParseNote is ParseNote answered from the process-wide NoteCache.
+func CachedParseNote(path string) (*MeetingNote, error) {
+	return defaultCache.Parse(path)
+}
+
+// Parse returns the note at path, parsing it only when it is not cached or
+// changed on disk since it was. The result is the caller's to modify.
+func (c *NoteCache) Parse(path string) (*MeetingNote, error) {
+	st, err := os.Stat(path)
+	if err != nil {
+		c.forget(path)
+		return nil, err
+	}
+	if n := c.lookup(path, st, true); n != nil {
+		return n, nil
+	}
+	note, err := ParseNote(path)
+	if err != nil {
+		c.forget(path)
+		return nil, err
+	}
+	c.store(path, st, note, true)
+	return copyNote(note), nil
+}
+
+// ParseAll returns the notes at paths, in order, with nil for those that
+// cannot be read. Notes not cached are parsed by a bounded worker pool.
+// Returned notes have no transcript.
+func (c *NoteCache) ParseAll(paths []string) []*MeetingNote {
+	out := make([]*MeetingNote, len(paths))
+	stats := make([]os.FileInfo, len(paths))
+	var todo []int
+	for i, p := range paths {
+		st, err := os.Stat(p)
+		if err != nil {
+			c.forget(p)
+			continue
+		}
+		stats[i] = st
+		if out[i] = c.lookup(p, st, false); out[i] == nil {
+			todo = append(todo, i)
+		}
+	}
+
+	todoPaths := make([]string, len(todo))
+	for j, i := range todo {
+		todoPaths[j] = paths[i]
+	}
+	for j, note := range parseNotes(todoPaths) {
+		i := todo[j]
+		if note == nil {
+			c.forget(paths[i])
+			continue
+		}
+		note.Transcript = ""
+		c.store(paths[i], stats[i], note, false)
+		out[i] = copyNote(note)
+	}
+	return out
+}
+
+// Len is the number of cached notes.
+func (c *NoteCache) Len() int {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return len(c.entries)
+}
+
+// Parses is how many notes the cache has parsed. Test seam.
+func (c *NoteCache) Parses() int {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return c.parses
+}
+
+func (c *NoteCache) lookup(path string, st os.FileInfo, needFull bool) *MeetingNote {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	e := c.entries[path]
+	if e == nil || e.mtime != st.ModTime().UnixNano() || e.size != st.Size() ||
+		(needFull && !e.full) {
+		return nil
+	}
+	n := copyNote(e.note)
+	if !needFull {
+		n.Transcript = ""
+	}
+	return n
+}
+
+func (c *NoteCache) store(path string, st os.FileInfo, note *MeetingNote, full bool) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	c.parses++
+	if e := c.entries[path]; e != nil && e.full && !full &&
+		e.mtime == st.ModTime().UnixNano() && e.size == st.Size() {
+		return
+	}
+	c.entries[path] = &cachedNote{st.ModTime().UnixNano(), st.Size(), note, full}
+}
+
+func (c *NoteCache) forget(path string) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	delete(c.entries, path)
+}
+
+// copyNote copies a cached note deeply enough that the caller may modify
+// it: ExtractActionItems, for one, rewrites ActionItems in place.
+func copyNote(n *MeetingNote) *MeetingNote {
+	c := *n
+	c.ActionItems = append([]ActionItem(nil), n.ActionItems...)
+	c.Frontmatter.Tags = append([]string(nil), n.Frontmatter.Tags...)
+	c.Frontmatter.Participants = append([]string(nil), n.Frontmatter.Participants...)
+	return &c
+}
+
+// parseNotes parses paths on up to maxParseWorkers goroutines, returning
+// the notes in order with nil for those that fail.
+func parseNotes(paths []string) []*MeetingNote {
+	out := make([]*MeetingNote, len(paths))
+	workers := runtime.NumCPU()
+	if workers > maxParseWorkers {
+		workers = maxParseWorkers
+	}
+	if workers > len(paths) {
+		workers = len(paths)
+	}
+	if workers <= 1 {
+		for i, p := range paths {
+			out[i], _ = ParseNote(p)
+		}
+		return out
+	}
+
+	jobs := make(chan int)
+	var wg sync.WaitGroup
+	for w := 0; w < workers; w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for i := range jobs {
+				out[i], _ = ParseNote(paths[i])
+			}
+		}()
+	}
+	for i := range paths {
+		jobs <- i
+	}
+	close(jobs)
+	wg.Wait()
+	return out
+}
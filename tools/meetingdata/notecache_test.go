@@ -0,0 +1,75 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+package meetingdata
+
+import (
+	"fmt"
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+)
+
+func TestNoteCache_ParseAllAndInvalidate(t *testing.T) {
+	tmp := t.TempDir()
+	src, _ := os.ReadFile("testdata/meeting_full.md")
+	var paths []string
+	for i := 0; i < 20; i++ {
+		p := filepath.Join(tmp, fmt.Sprintf("Meeting_2026-03-%02d_10-00.md", i+1))
+		os.WriteFile(p, src, 0644)
+		paths = append(paths, p)
+	}
+	paths = append(paths, filepath.Join(tmp, "Meeting_missing.md"))
+
+	c := NewNoteCache()
+	notes := c.ParseAll(paths)
+	if len(notes) != 21 || notes[20] != nil {
+		t.Fatalf("expected 20 notes and a nil for the missing file")
+	}
+	for i, n := range notes[:20] {
+		if n == nil || n.Path != paths[i] {
+			t.Fatalf("note %d out of order: %+v", i, n)
+		}
+		if n.Transcript != "" {
+			t.Errorf("bulk-parsed note %d keeps its transcript", i)
+		}
+	}
+	if c.Parses() != 20 || c.Len() != 20 {
+		t.Errorf("parses %d, cached %d; want 20, 20", c.Parses(), c.Len())
+	}
+
+	// Answered from memory; callers' changes do not leak into the cache.
+	notes[0].ActionItems[0].Text = "changed"
+	notes = c.ParseAll(paths)
+	if c.Parses() != 20 {
+		t.Errorf("unchanged notes re-parsed: %d parses", c.Parses())
+	}
+	if notes[0].ActionItems[0].Text == "changed" {
+		t.Error("caller modified the cached note")
+	}
+
+	// A rewritten note is parsed again; the others are not.
+	future := time.Now().Add(time.Minute)
+	os.Chtimes(paths[3], future, future)
+	c.ParseAll(paths)
+	if c.Parses() != 21 {
+		t.Errorf("after touching one note: %d parses, want 21", c.Parses())
+	}
+
+	// Parse needs the transcript, so reads the note once more, then caches it.
+	full, err := c.Parse(paths[0])
+	if err != nil || full.Transcript == "" {
+		t.Fatalf("Parse: %v, transcript %q", err, full.Transcript)
+	}
+	c.Parse(paths[0])
+	c.ParseAll(paths[:1])
+	if c.Parses() != 22 {
+		t.Errorf("full note not reused: %d parses, want 22", c.Parses())
+	}
+
+	os.Remove(paths[1])
+	if _, err := c.Parse(paths[1]); err == nil || c.Len() != 19 {
+		t.Errorf("removed note: err %v, cached %d", err, c.Len())
+	}
+}
@@ -0,0 +1,340 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+package meetingdata
+
+import (
+	"encoding/json"
+	"math"
+	"os"
+	"path/filepath"
+	"sort"
+	"strings"
+	"sync"
+	"unicode"
+)
+
+// Note search index.
+//
+// SearchNotes used to read and parse every meeting note on every query,
+// which takes seconds once a note directory holds years of meetings. The
+// index keeps each note's searchable fields (title, summary, tags,
+// participants, date) and their weighted terms in a JSON file in the data
+// directory. Each query only stats the note files, re-parses those whose
+// size or mtime changed, drops those that are gone, and answers from an
+// in-memory inverted index ranked by BM25.
+
+const noteIndexVersion = 1
+
+// Term weights by field: a query word in a title says more about a
+// meeting than the same word somewhere in its summary.
+const (
+	weightTitle       = 3
+	weightTag         = 2
+	weightParticipant = 2
+	weightSummary     = 1
+)
+
+// DefaultNoteIndexPath is $XDG_DATA_HOME/recmeet/note_index.json.
+func DefaultNoteIndexPath() string {
+	return filepath.Join(filepath.Dir(DefaultSpeakerDB()), "note_index.json")
+}
+
+type indexedNote struct {
+	Path    string         `json:"path"`
+	ModTime int64          `json:"mtime"`
+	Size    int64          `json:"size"`
+	Note    MeetingNote    `json:"note"`
+	Terms   map[string]int `json:"terms"`
+	Length  int            `json:"length"`
+}
+
+type noteIndexFile struct {
+	Version int            `json:"version"`
+	Notes   []*indexedNote `json:"notes"`
+}
+
+type posting struct {
+	doc    int
+	weight int
+}
+
+// NoteIndex is a persistent inverted index over meeting notes.
+type NoteIndex struct {
+	mu       sync.Mutex
+	path     string
+	notes    map[string]*indexedNote
+	docs     []*indexedNote
+	terms    []string // sorted, for prefix lookup
+	postings map[string][]posting
+	avgLen   float64
+	built    bool
+}
+
+// OpenNoteIndex loads the index saved at path. A missing, unreadable or
+// outdated file gives an empty index; an empty path keeps it in memory.
+func OpenNoteIndex(path string) *NoteIndex {
+	ix := &NoteIndex{path: path, notes: map[string]*indexedNote{}}
+	if path == "" {
+		return ix
+	}
+	data, err := os.ReadFile(path)
+	if err != nil {
+		return ix
+	}
+	var f noteIndexFile
+	if json.Unmarshal(data, &f) != nil || f.Version != noteIndexVersion {
+		return ix
+	}
+	for _, n := range f.Notes {
+		if n != nil && n.Path != "" {
+			ix.notes[n.Path] = n
+		}
+	}
+	return ix
+}
+
+// Len is the number of indexed notes.
+func (ix *NoteIndex) Len() int {
+	ix.mu.Lock()
+	defer ix.mu.Unlock()
+	return len(ix.notes)
+}
+
+// Refresh brings the index up to date with the notes under noteDir and
+// outputDir. It returns how many notes were (re-)parsed, and saves the
+// index when anything changed.
+func (ix *NoteIndex) Refresh(noteDir, outputDir string) (int, error) {
+	files := findNoteFiles(noteDir, outputDir)
+
+	ix.mu.Lock()
+	defer ix.mu.Unlock()
+
+	seen := make(map[string]bool, len(files))
+	var stale []noteFile
+	var stalePaths []string
+	for _, f := range files {
+		seen[f.path] = true
+		old := ix.notes[f.path]
+		if old == nil || old.ModTime != f.mtime || old.Size != f.size {
+			stale = append(stale, f)
+			stalePaths = append(stalePaths, f.path)
+		}
+	}
+	parsed, changed := len(stale), len(stale) > 0
+	for i, note := range parseNotes(stalePaths) {
+		f := stale[i]
+		if note == nil {
+			delete(ix.notes, f.path)
+			continue
+		}
+		ix.notes[f.path] = newIndexedNote(note, f.mtime, f.size)
+	}
+	for p := range ix.notes {
+		if !seen[p] {
+			delete(ix.notes, p)
+			changed = true
+		}
+	}
+
+	if changed || !ix.built {
+		ix.build()
+	}
+	if changed && ix.path != "" {
+		return parsed, ix.save()
+	}
+	return parsed, nil
+}
+
+// Search returns the notes matching query and filters, best match first.
+// Every query word must start a word of the note's title, summary, tags or
+// participants. An empty query matches every note, most recent first.
+func (ix *NoteIndex) Search(query string, filters SearchFilters) []MeetingNote {
+	ix.mu.Lock()
+	defer ix.mu.Unlock()
+	if !ix.built {
+		ix.build()
+	}
+
+	scores := map[int]float64{}
+	words := tokenize(query)
+	if len(words) == 0 {
+		for i := range ix.docs {
+			scores[i] = 0
+		}
+	}
+	for qi, w := range words {
+		hit := map[int]float64{}
+		for t := sort.SearchStrings(ix.terms, w); t < len(ix.terms) &&
+			strings.HasPrefix(ix.terms[t], w); t++ {
+			term := ix.terms[t]
+			list := ix.postings[term]
+			idf := math.Log(1 + (float64(len(ix.docs))-float64(len(list))+0.5)/
+				(float64(len(list))+0.5))
+			for _, p := range list {
+				tf := float64(p.weight)
+				norm := 1.2 * (0.25 + 0.75*float64(ix.docs[p.doc].Length)/ix.avgLen)
+				hit[p.doc] += idf * tf * 2.2 / (tf + norm)
+			}
+		}
+		// Keep documents that matched every word so far.
+		for d, s := range hit {
+			if prev, ok := scores[d]; ok || qi == 0 {
+				scores[d] = prev + s
+			}
+		}
+		for d := range scores {
+			if _, ok := hit[d]; !ok {
+				delete(scores, d)
+			}
+		}
+	}
+
+	type ranked struct {
+		doc   *indexedNote
+		score float64
+	}
+	var out []ranked
+	for d, s := range scores {
+		n := ix.docs[d]
+		if matchesFilters(&n.Note, "", filters) {
+			out = append(out, ranked{n, s})
+		}
+	}
+	sort.Slice(out, func(i, j int) bool {
+		if out[i].score != out[j].score {
+			return out[i].score > out[j].score
+		}
+		a, b := out[i].doc.Note.Frontmatter, out[j].doc.Note.Frontmatter
+		if a.Date != b.Date {
+			return a.Date > b.Date
+		}
+		if a.Time != b.Time {
+			return a.Time > b.Time
+		}
+		return out[i].doc.Path < out[j].doc.Path
+	})
+	if filters.Limit > 0 && len(out) > filters.Limit {
+		out = out[:filters.Limit]
+	}
+	results := make([]MeetingNote, len(out))
+	for i, r := range out {
+		results[i] = r.doc.Note
+	}
+	return results
+}
+
+func newIndexedNote(note *MeetingNote, mtime, size int64) *indexedNote {
+	n := &indexedNote{Path: note.Path, ModTime: mtime, Size: size, Note: *note,
+		Terms: map[string]int{}}
+	// Search results carry the note's metadata and summary; the transcript
+	// is the bulk of a note and is read with ParseNote when needed.
+	n.Note.Transcript = ""
+	add := func(text string, weight int) {
+		for _, t := range tokenize(text) {
+			n.Terms[t] += weight
+			n.Length++
+		}
+	}
+	fm := note.Frontmatter
+	add(fm.Title, weightTitle)
+	add(strings.Join(fm.Tags, " "), weightTag)
+	add(strings.Join(fm.Participants, " "), weightParticipant)
+	add(note.SummaryText, weightSummary)
+	return n
+}
+
+// build inverts the per-note terms. Called with ix.mu held.
+func (ix *NoteIndex) build() {
+	ix.docs = ix.docs[:0]
+	for _, n := range ix.notes {
+		ix.docs = append(ix.docs, n)
+	}
+	sort.Slice(ix.docs, func(i, j int) bool { return ix.docs[i].Path < ix.docs[j].Path })
+
+	ix.postings = map[string][]posting{}
+	total := 0
+	for d, n := range ix.docs {
+		total += n.Length
+		for t, w := range n.Terms {
+			ix.postings[t] = append(ix.postings[t], posting{d, w})
+		}
+	}
+	ix.terms = ix.terms[:0]
+	for t := range ix.postings {
+		ix.terms = append(ix.terms, t)
+	}
+	sort.Strings(ix.terms)
+	ix.avgLen = 1
+	if len(ix.docs) > 0 && total > 0 {
+		ix.avgLen = float64(total) / float64(len(ix.docs))
+	}
+	ix.built = true
+}
+
+// save writes the index through a temporary file, so a concurrent reader
+// never sees half of it. Called with ix.mu held.
+func (ix *NoteIndex) save() error {
+	f := noteIndexFile{Version: noteIndexVersion, Notes: ix.docs}
+	data, err := json.Marshal(f)
+	if err != nil {
+		return err
+	}
+	if err := os.MkdirAll(filepath.Dir(ix.path), 0755); err != nil {
+		return err
+	}
+	tmp, err := os.CreateTemp(filepath.Dir(ix.path), ".note_index-*")
+	if err != nil {
+		return err
+	}
+	if _, err := tmp.Write(data); err != nil {
+		tmp.Close()
+		os.Remove(tmp.Name())
+		return err
+	}
+	if err := tmp.Close(); err != nil {
+		os.Remove(tmp.Name())
+		return err
+	}
+	if err := os.Rename(tmp.Name(), ix.path); err != nil {
+		os.Remove(tmp.Name())
+		return err
+	}
+	return nil
+}
+
+// tokenize lowercases text and splits it into words of letters and digits.
+func tokenize(text string) []string {
+	return strings.FieldsFunc(strings.ToLower(text), func(r rune) bool {
+		return !unicode.IsLetter(r) && !unicode.IsDigit(r)
+	})
+}
+
+type noteFile struct {
+	path  string
+	mtime int64
+	size  int64
+}
+
+func findNoteFiles(noteDir, outputDir string) []noteFile {
+	paths, _ := findNotePaths(noteDir, outputDir)
+	files := make([]noteFile, 0, len(paths))
+	for _, p := range paths {
+		st, err := os.Stat(p)
+		if err != nil {
+			continue
+		}
+		files = append(files, noteFile{p, st.ModTime().UnixNano(), st.Size()})
+	}
+	return files
+}
+
+var (
+	sharedIndexOnce sync.Once
+	sharedIndex     *NoteIndex
+)
+
+func defaultNoteIndex() *NoteIndex {
+	sharedIndexOnce.Do(func() { sharedIndex = OpenNoteIndex(DefaultNoteIndexPath()) })
+	return sharedIndex
+}
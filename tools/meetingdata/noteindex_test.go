@@ -0,0 +1,138 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+package meetingdata
+
+import (
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+)
+
+func writeNoteFixtures(t *testing.T, dir string) (full, simple string) {
+	t.Helper()
+	full = filepath.Join(dir, "2026", "03", "Meeting_2026-03-15_14-30_Q1_Planning.md")
+	simple = filepath.Join(dir, "2026", "03", "Meeting_2026-03-20_09-00_Quick_Sync.md")
+	os.MkdirAll(filepath.Dir(full), 0755)
+	for dst, src := range map[string]string{full: "testdata/meeting_full.md",
+		simple: "testdata/meeting_simple.md"} {
+		data, err := os.ReadFile(src)
+		if err != nil {
+			t.Fatal(err)
+		}
+		if err := os.WriteFile(dst, data, 0644); err != nil {
+			t.Fatal(err)
+		}
+	}
+	return full, simple
+}
+
+func titles(notes []MeetingNote) []string {
+	var out []string
+	for _, n := range notes {
+		out = append(out, n.Frontmatter.Title)
+	}
+	return out
+}
+
+func TestNoteIndex_IncrementalRefresh(t *testing.T) {
+	tmp := t.TempDir()
+	notes := filepath.Join(tmp, "notes")
+	indexPath := filepath.Join(tmp, "data", "note_index.json")
+	full, simple := writeNoteFixtures(t, notes)
+
+	ix := OpenNoteIndex(indexPath)
+	if n, err := ix.Refresh(notes, ""); err != nil || n != 2 {
+		t.Fatalf("first refresh: parsed %d, err %v", n, err)
+	}
+	if _, err := os.Stat(indexPath); err != nil {
+		t.Fatalf("index not saved: %v", err)
+	}
+	if n, _ := ix.Refresh(notes, ""); n != 0 {
+		t.Errorf("unchanged notes re-parsed: %d", n)
+	}
+
+	// A reopened index answers without parsing anything.
+	ix = OpenNoteIndex(indexPath)
+	if ix.Len() != 2 {
+		t.Fatalf("reloaded %d notes, want 2", ix.Len())
+	}
+	if n, _ := ix.Refresh(notes, ""); n != 0 {
+		t.Errorf("reloaded index re-parsed %d notes", n)
+	}
+	got := ix.Search("planning", SearchFilters{})
+	if len(got) != 1 || got[0].Frontmatter.Title != "Q1 Planning Session" {
+		t.Errorf("search after reload: %v", titles(got))
+	}
+	if got[0].SummaryText == "" || got[0].Transcript != "" {
+		t.Errorf("indexed note keeps summary, drops transcript: %q / %q",
+			got[0].SummaryText, got[0].Transcript)
+	}
+
+	// Only the rewritten note is parsed again; a removed one is dropped.
+	data, _ := os.ReadFile(simple)
+	os.WriteFile(simple, []byte(string(data)+"\n"), 0644)
+	future := time.Now().Add(time.Minute)
+	os.Chtimes(simple, future, future)
+	if n, _ := ix.Refresh(notes, ""); n != 1 {
+		t.Errorf("rewritten note: parsed %d, want 1", n)
+	}
+	os.Remove(full)
+	ix.Refresh(notes, "")
+	if ix.Len() != 1 || len(ix.Search("planning", SearchFilters{})) != 0 {
+		t.Errorf("removed note still indexed (%d notes)", ix.Len())
+	}
+}
+
+func TestNoteIndex_Ranking(t *testing.T) {
+	tmp := t.TempDir()
+	writeNoteFixtures(t, tmp)
+	ix := OpenNoteIndex("")
+	ix.Refresh(tmp, "")
+
+	cases := []struct {
+		query   string
+		filters SearchFilters
+		want    []string
+	}{
+		// Words match by prefix, and every word must match.
+		{"plan", SearchFilters{}, []string{"Q1 Planning Session"}},
+		{"API planning", SearchFilters{}, []string{"Q1 Planning Session"}},
+		{"planning nobody", SearchFilters{}, nil},
+		{"sync", SearchFilters{}, []string{"Quick Sync"}},
+		{"alice", SearchFilters{Participants: []string{"bob"}}, []string{"Q1 Planning Session"}},
+		// Without a query, most recent first.
+		{"", SearchFilters{}, []string{"Quick Sync", "Q1 Planning Session"}},
+		{"", SearchFilters{DateTo: "2026-03-16"}, []string{"Q1 Planning Session"}},
+		{"", SearchFilters{Limit: 1}, []string{"Quick Sync"}},
+	}
+	for _, c := range cases {
+		got := titles(ix.Search(c.query, c.filters))
+		if len(got) != len(c.want) {
+			t.Errorf("%q %+v: got %v, want %v", c.query, c.filters, got, c.want)
+			continue
+		}
+		for i := range got {
+			if got[i] != c.want[i] {
+				t.Errorf("%q %+v: got %v, want %v", c.query, c.filters, got, c.want)
+				break
+			}
+		}
+	}
+
+	// A word in the title outranks the same word in a summary.
+	for name, body := range map[string]string{
+		"Meeting_2026-04-01_10-00_A.md": "title: \"Budget review\"\ndate: 2026-04-01",
+		"Meeting_2026-04-02_10-00_B.md": "title: \"Vendor review\"\ndate: 2026-04-02",
+	} {
+		note := "---\n" + body + "\n---\n\n> [!summary] Meeting Summary\n" +
+			"> Numbers for the quarter, including the budget.\n>\n"
+		os.WriteFile(filepath.Join(tmp, name), []byte(note), 0644)
+	}
+	ix.Refresh(tmp, "")
+	got := titles(ix.Search("budget", SearchFilters{}))
+	if len(got) != 2 || got[0] != "Budget review" {
+		t.Errorf("budget: %v", got)
+	}
+}
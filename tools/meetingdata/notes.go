@@ -177,31 +177,14 @@ type SearchFilters struct {
 	Limit        int
 }
 
+// SearchNotes finds the meeting notes under noteDir and outputDir that
+// match query and filters, best match first, through the note index (see
+// noteindex.go). Results leave out the transcript; ParseNote reads it.
+// The index failing to save only costs the next query its re-parsing.
 func SearchNotes(noteDir, outputDir, query string, filters SearchFilters) ([]MeetingNote, error) {
-	paths, err := findNotePaths(noteDir, outputDir)
-	if err != nil {
-		return nil, err
-	}
-
-	queryLower := strings.ToLower(query)
-	var results []MeetingNote
-
-	for _, p := range paths {
-		note, err := ParseNote(p)
-		if err != nil {
-			continue
-		}
-
-		if !matchesFilters(note, queryLower, filters) {
-			continue
-		}
-
-		results = append(results, *note)
-		if filters.Limit > 0 && len(results) >= filters.Limit {
-			break
-		}
-	}
-	return results, nil
+	ix := defaultNoteIndex()
+	ix.Refresh(noteDir, outputDir)
+	return ix.Search(query, filters), nil
 }
 
 func matchesFilters(note *MeetingNote, query string, filters SearchFilters) bool {
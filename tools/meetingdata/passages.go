@@ -0,0 +1,409 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+package meetingdata
+
+import (
+	"encoding/gob"
+	"hash/fnv"
+	"math"
+	"os"
+	"path/filepath"
+	"regexp"
+	"sort"
+	"strconv"
+	"strings"
+	"sync"
+)
+
+// Transcript passage retrieval.
+//
+// The agent's prep and follow-up workflows used to pull whole notes into
+// the model context to find what was said about a topic. The passage
+// index splits each note's summary and transcript into short passages,
+// embeds each one, and keeps the vectors in the data directory, so a
+// workflow can ask for the few passages closest to a topic instead.
+// Like the note index it is brought up to date on every query by file
+// size and mtime, so a new note is searchable as soon as it is written.
+
+const passageIndexVersion = 1
+
+// Passage chunking: about passageWords words per passage, cut at
+// transcript line boundaries, repeating the last passageOverlap lines of a
+// passage at the start of the next so no exchange is split from its
+// context.
+const (
+	passageWords   = 120
+	passageOverlap = 1
+)
+
+// Embedder turns text into a fixed-length vector whose dot product with
+// another approximates their similarity. Name identifies the embedding,
+// so an index built by a different one is rebuilt rather than mixed.
+type Embedder interface {
+	Name() string
+	Embed(text string) []float32
+}
+
+// HashEmbedder embeds text without a model: its words and their character
+// trigrams are hashed into Dim signed buckets and the result normalised.
+// The trigrams let inflections and compounds ("migrate", "migration")
+// land near each other; it does not know synonyms. Trigrams are anchored
+// at the start of a word only, since shared endings ("-ing", "-ed") say
+// nothing about the topic.
+type HashEmbedder struct {
+	Dim int
+}
+
+func (h HashEmbedder) Name() string { return "hash-v1-" + strconv.Itoa(h.Dim) }
+
+func (h HashEmbedder) Embed(text string) []float32 {
+	v := make([]float32, h.Dim)
+	add := func(feature string, w float32) {
+		f := fnv.New32a()
+		f.Write([]byte(feature))
+		x := f.Sum32()
+		if x&0x80000000 != 0 {
+			w = -w
+		}
+		v[int(x&0x7fffffff)%h.Dim] += w
+	}
+	for _, word := range tokenize(text) {
+		if len(word) < 2 || stopWords[word] {
+			continue
+		}
+		add(word, 1)
+		r := []rune("^" + word)
+		for i := 0; i+3 <= len(r); i++ {
+			add(string(r[i:i+3]), 0.4)
+		}
+	}
+	var norm float64
+	for _, x := range v {
+		norm += float64(x) * float64(x)
+	}
+	if norm > 0 {
+		s := float32(1 / math.Sqrt(norm))
+		for i := range v {
+			v[i] *= s
+		}
+	}
+	return v
+}
+
+var stopWords = func() map[string]bool {
+	m := map[string]bool{}
+	for _, w := range strings.Fields(`a an and are as at be but by do for from
+		had has have he her his i if in is it its me my no not of on or our
+		she so that the their them then there they this to up us was we were
+		what when which who will with would you your yeah okay um uh like just
+		think know going get got can could should`) {
+		m[w] = true
+	}
+	return m
+}()
+
+// DefaultEmbedder is the embedder RetrievePassages uses.
+var DefaultEmbedder Embedder = HashEmbedder{Dim: 512}
+
+// minPassageScore drops passages whose similarity is within the noise of
+// hash collisions.
+const minPassageScore = 0.1
+
+// Passage is one retrieved stretch of a meeting note.
+type Passage struct {
+	NotePath string
+	Title    string
+	Date     string
+	Time     string
+	Section  string // "summary" or "transcript"
+	Start    string // transcript timestamp of the first line, if any
+	Text     string
+	Score    float64
+}
+
+type passageChunk struct {
+	Section string
+	Start   string
+	Text    string
+	Vec     []byte // int8 components, scaled by 127
+}
+
+type passageNote struct {
+	Path         string
+	ModTime      int64
+	Size         int64
+	Title        string
+	Date         string
+	Time         string
+	Participants []string
+	Chunks       []passageChunk
+}
+
+type passageIndexFile struct {
+	Version  int
+	Embedder string
+	Notes    []*passageNote
+}
+
+// PassageIndex is a persistent vector index over note passages.
+type PassageIndex struct {
+	mu       sync.Mutex
+	path     string
+	embedder Embedder
+	notes    map[string]*passageNote
+}
+
+// DefaultPassageIndexPath is $XDG_DATA_HOME/recmeet/passage_index.gob.
+func DefaultPassageIndexPath() string {
+	return filepath.Join(filepath.Dir(DefaultSpeakerDB()), "passage_index.gob")
+}
+
+// OpenPassageIndex loads the index saved at path. A missing or unreadable
+// file, or one built by another embedder, gives an empty index; an empty
+// path keeps it in memory.
+func OpenPassageIndex(path string, e Embedder) *PassageIndex {
+	px := &PassageIndex{path: path, embedder: e, notes: map[string]*passageNote{}}
+	if path == "" {
+		return px
+	}
+	f, err := os.Open(path)
+	if err != nil {
+		return px
+	}
+	defer f.Close()
+	var file passageIndexFile
+	if gob.NewDecoder(f).Decode(&file) != nil || file.Version != passageIndexVersion ||
+		file.Embedder != e.Name() {
+		return px
+	}
+	for _, n := range file.Notes {
+		if n != nil && n.Path != "" {
+			px.notes[n.Path] = n
+		}
+	}
+	return px
+}
+
+// Len is the number of indexed passages.
+func (px *PassageIndex) Len() int {
+	px.mu.Lock()
+	defer px.mu.Unlock()
+	total := 0
+	for _, n := range px.notes {
+		total += len(n.Chunks)
+	}
+	return total
+}
+
+// Refresh brings the index up to date with the notes under noteDir and
+// outputDir, embedding only new or changed notes. It returns how many
+// notes were (re-)read, and saves the index when anything changed.
+func (px *PassageIndex) Refresh(noteDir, outputDir string) (int, error) {
+	files := findNoteFiles(noteDir, outputDir)
+
+	px.mu.Lock()
+	defer px.mu.Unlock()
+
+	seen := make(map[string]bool, len(files))
+	var stale []noteFile
+	var stalePaths []string
+	for _, f := range files {
+		seen[f.path] = true
+		old := px.notes[f.path]
+		if old == nil || old.ModTime != f.mtime || old.Size != f.size {
+			stale = append(stale, f)
+			stalePaths = append(stalePaths, f.path)
+		}
+	}
+	changed := len(stale) > 0
+	for i, note := range parseNotes(stalePaths) {
+		f := stale[i]
+		if note == nil {
+			delete(px.notes, f.path)
+			continue
+		}
+		px.notes[f.path] = px.indexNote(note, f.mtime, f.size)
+	}
+	for p := range px.notes {
+		if !seen[p] {
+			delete(px.notes, p)
+			changed = true
+		}
+	}
+	if changed && px.path != "" {
+		return len(stale), px.save()
+	}
+	return len(stale), nil
+}
+
+// Retrieve returns the k passages most similar to query among the notes
+// passing filters (filters.Limit is ignored), best first.
+func (px *PassageIndex) Retrieve(query string, k int, filters SearchFilters) []Passage {
+	q := quantize(px.embedder.Embed(query))
+	filters.Limit = 0
+
+	px.mu.Lock()
+	defer px.mu.Unlock()
+
+	var out []Passage
+	for _, n := range px.notes {
+		meta := MeetingNote{Frontmatter: Frontmatter{Date: n.Date,
+			Participants: n.Participants}}
+		if !matchesFilters(&meta, "", filters) {
+			continue
+		}
+		for _, c := range n.Chunks {
+			s := dot(q, c.Vec)
+			if s < minPassageScore {
+				continue
+			}
+			out = append(out, Passage{NotePath: n.Path, Title: n.Title, Date: n.Date,
+				Time: n.Time, Section: c.Section, Start: c.Start, Text: c.Text, Score: s})
+		}
+	}
+	sort.Slice(out, func(i, j int) bool {
+		if out[i].Score != out[j].Score {
+			return out[i].Score > out[j].Score
+		}
+		if out[i].Date != out[j].Date {
+			return out[i].Date > out[j].Date
+		}
+		return out[i].NotePath < out[j].NotePath
+	})
+	if k > 0 && len(out) > k {
+		out = out[:k]
+	}
+	return out
+}
+
+var (
+	sharedPassagesOnce sync.Once
+	sharedPassages     *PassageIndex
+)
+
+// RetrievePassages refreshes the shared passage index for noteDir and
+// outputDir and returns the k passages most relevant to query. A failure
+// to save the index only costs the next query its re-embedding.
+func RetrievePassages(noteDir, outputDir, query string, k int, filters SearchFilters) ([]Passage, error) {
+	sharedPassagesOnce.Do(func() {
+		sharedPassages = OpenPassageIndex(DefaultPassageIndexPath(), DefaultEmbedder)
+	})
+	sharedPassages.Refresh(noteDir, outputDir)
+	return sharedPassages.Retrieve(query, k, filters), nil
+}
+
+func (px *PassageIndex) indexNote(note *MeetingNote, mtime, size int64) *passageNote {
+	fm := note.Frontmatter
+	n := &passageNote{Path: note.Path, ModTime: mtime, Size: size, Title: fm.Title,
+		Date: fm.Date, Time: fm.Time, Participants: fm.Participants}
+	add := func(section, start, text string) {
+		n.Chunks = append(n.Chunks, passageChunk{section, start, text,
+			quantize(px.embedder.Embed(fm.Title + "\n" + text))})
+	}
+	if note.SummaryText != "" {
+		add("summary", "", note.SummaryText)
+	}
+	for _, c := range chunkTranscript(note.Transcript) {
+		add("transcript", c.start, c.text)
+	}
+	return n
+}
+
+var transcriptTimeRe = regexp.MustCompile(`^\[(\d{1,2}:\d{2}(?::\d{2})?)\]`)
+
+type textChunk struct {
+	start string
+	text  string
+}
+
+// chunkTranscript splits a transcript into passages of about passageWords
+// words at line boundaries, overlapping by passageOverlap lines.
+func chunkTranscript(transcript string) []textChunk {
+	var lines []string
+	for _, l := range strings.Split(transcript, "\n") {
+		if l = strings.TrimSpace(l); l != "" {
+			lines = append(lines, l)
+		}
+	}
+	var out []textChunk
+	for begin := 0; begin < len(lines); {
+		end, words := begin, 0
+		for end < len(lines) && (words == 0 || words+len(strings.Fields(lines[end])) <= passageWords) {
+			words += len(strings.Fields(lines[end]))
+			end++
+		}
+		c := textChunk{text: strings.Join(lines[begin:end], "\n")}
+		if m := transcriptTimeRe.FindStringSubmatch(lines[begin]); m != nil {
+			c.start = m[1]
+		}
+		out = append(out, c)
+		if end == len(lines) {
+			break
+		}
+		next := end - passageOverlap
+		if next <= begin {
+			next = end
+		}
+		begin = next
+	}
+	return out
+}
+
+// quantize stores a unit vector as int8 components, a quarter of the
+// size of float32 at no loss that matters for ranking.
+func quantize(v []float32) []byte {
+	out := make([]byte, len(v))
+	for i, x := range v {
+		q := math.Round(float64(x) * 127)
+		if q > 127 {
+			q = 127
+		} else if q < -127 {
+			q = -127
+		}
+		out[i] = byte(int8(q))
+	}
+	return out
+}
+
+func dot(a, b []byte) float64 {
+	if len(a) != len(b) {
+		return 0
+	}
+	var s int32
+	for i := range a {
+		s += int32(int8(a[i])) * int32(int8(b[i]))
+	}
+	return float64(s) / (127 * 127)
+}
+
+// save writes the index through a temporary file. Called with px.mu held.
+func (px *PassageIndex) save() error {
+	file := passageIndexFile{Version: passageIndexVersion, Embedder: px.embedder.Name()}
+	for _, n := range px.notes {
+		file.Notes = append(file.Notes, n)
+	}
+	sort.Slice(file.Notes, func(i, j int) bool { return file.Notes[i].Path < file.Notes[j].Path })
+
+	if err := os.MkdirAll(filepath.Dir(px.path), 0755); err != nil {
+		return err
+	}
+	tmp, err := os.CreateTemp(filepath.Dir(px.path), ".passage_index-*")
+	if err != nil {
+		return err
+	}
+	if err := gob.NewEncoder(tmp).Encode(file); err != nil {
+		tmp.Close()
+		os.Remove(tmp.Name())
+		return err
+	}
+	if err := tmp.Close(); err != nil {
+		os.Remove(tmp.Name())
+		return err
+	}
+	if err := os.Rename(tmp.Name(), px.path); err != nil {
+		os.Remove(tmp.Name())
+		return err
+	}
+	return nil
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2026 John Suykerbuyk and SykeTech LTD
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+package meetingdata
+
+import (
+	"fmt"
+	"os"
+	"path/filepath"
+	"strings"
+	"testing"
+)
+
+func writeTranscriptNote(t *testing.T, dir, date, title string, lines []string) string {
+	t.Helper()
+	var sb strings.Builder
+	fmt.Fprintf(&sb, "---\ntitle: %q\ndate: %s\ntime: \"10:00\"\nparticipants:\n  - \"[[Alice]]\"\n---\n\n", title, date)
+	sb.WriteString("> [!abstract]- Full Transcript\n")
+	for _, l := range lines {
+		sb.WriteString("> " + l + "\n")
+	}
+	sb.WriteString(">\n")
+	p := filepath.Join(dir, "Meeting_"+date+"_10-00.md")
+	if err := os.WriteFile(p, []byte(sb.String()), 0644); err != nil {
+		t.Fatal(err)
+	}
+	return p
+}
+
+func TestChunkTranscript(t *testing.T) {
+	var lines []string
+	for i := 0; i < 30; i++ {
+		lines = append(lines, fmt.Sprintf("[00:%02d] Alice: %s", i, strings.Repeat("word ", 19)))
+	}
+	chunks := chunkTranscript(strings.Join(lines, "\n"))
+	if len(chunks) < 5 {
+		t.Fatalf("expected the transcript to be split, got %d chunks", len(chunks))
+	}
+	if chunks[0].start != "00:00" {
+		t.Errorf("first chunk start = %q", chunks[0].start)
+	}
+	for i := 1; i < len(chunks); i++ {
+		prev := strings.Split(chunks[i-1].text, "\n")
+		if !strings.HasPrefix(chunks[i].text, prev[len(prev)-1]) {
+			t.Errorf("chunk %d does not repeat the previous chunk's last line", i)
+		}
+		if n := len(strings.Fields(chunks[i].text)); n > passageWords {
+			t.Errorf("chunk %d has %d words", i, n)
+		}
+	}
+	if !strings.Contains(chunks[len(chunks)-1].text, "[00:29]") {
+		t.Error("last line lost")
+	}
+}
+
+func TestPassageIndex_RetrieveAndRefresh(t *testing.T) {
+	tmp := t.TempDir()
+	notes := filepath.Join(tmp, "notes")
+	os.MkdirAll(notes, 0755)
+	indexPath := filepath.Join(tmp, "data", "passage_index.gob")
+
+	writeTranscriptNote(t, notes, "2026-03-10", "Infra review", []string{
+		"[00:00] Alice: The database migration to the new cluster is scheduled.",
+		"[00:20] Bob: Migrating the replicas first keeps downtime low.",
+	})
+	writeTranscriptNote(t, notes, "2026-03-11", "Hiring sync", []string{
+		"[00:00] Alice: We interviewed three candidates for the frontend role.",
+		"[00:30] Carol: The second candidate had the strongest portfolio.",
+	})
+
+	px := OpenPassageIndex(indexPath, DefaultEmbedder)
+	if n, err := px.Refresh(notes, ""); n != 2 || err != nil {
+		t.Fatalf("first refresh: %d notes, err %v", n, err)
+	}
+
+	got := px.Retrieve("when do we migrate the databases", 1, SearchFilters{})
+	if len(got) != 1 || got[0].Title != "Infra review" || got[0].Start != "00:00" {
+		t.Fatalf("migration query: %+v", got)
+	}
+	got = px.Retrieve("candidates interviewed", 1, SearchFilters{})
+	if len(got) != 1 || got[0].Title != "Hiring sync" {
+		t.Fatalf("hiring query: %+v", got)
+	}
+	if got := px.Retrieve("database", 5, SearchFilters{DateFrom: "2026-03-11"}); len(got) != 0 {
+		t.Errorf("date filter ignored: %+v", got)
+	}
+
+	// Reopened: nothing re-embedded. A new note is picked up on refresh.
+	px = OpenPassageIndex(indexPath, DefaultEmbedder)
+	if px.Len() != 2 {
+		t.Fatalf("reloaded %d passages, want 2", px.Len())
+	}
+	if n, _ := px.Refresh(notes, ""); n != 0 {
+		t.Errorf("reloaded index re-read %d notes", n)
+	}
+	writeTranscriptNote(t, notes, "2026-03-12", "Budget", []string{
+		"[00:00] Dan: Cloud spend doubled after the cluster migration.",
+	})
+	if n, _ := px.Refresh(notes, ""); n != 1 {
+		t.Errorf("new note: re-read %d notes, want 1", n)
+	}
+	if got := px.Retrieve("cloud spend", 1, SearchFilters{}); len(got) != 1 || got[0].Title != "Budget" {
+		t.Errorf("new note not retrieved: %+v", got)
+	}
+
+	// An index built by a different embedder is not reused.
+	if px := OpenPassageIndex(indexPath, HashEmbedder{Dim: 64}); px.Len() != 0 {
+		t.Errorf("index reused across embedders")
+	}
+}
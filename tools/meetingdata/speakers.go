@@ -17,6 +17,10 @@ type SpeakerProfile struct {
 	Updated        string      `json:"updated"`
 	EmbeddingCount int         `json:"-"`
 	Embeddings     [][]float32 `json:"embeddings"`
+	// Exported with --embedding-precision f16 / int8: base64 strings,
+	// counted but never decoded here.
+	EmbeddingsF16  []string `json:"embeddings_f16,omitempty"`
+	EmbeddingsInt8 []string `json:"embeddings_int8,omitempty"`
 }
 
 type MeetingSpeaker struct {
@@ -56,8 +60,9 @@ func LoadSpeakerProfiles(dbDir string) ([]SpeakerProfile, error) {
 		if err := json.Unmarshal(data, &p); err != nil {
 			continue
 		}
-		p.EmbeddingCount = len(p.Embeddings)
-		p.Embeddings = nil // Don't expose raw embeddings via MCP
+		p.EmbeddingCount = len(p.Embeddings) + len(p.EmbeddingsF16) + len(p.EmbeddingsInt8)
+		// Don't expose raw embeddings via MCP
+		p.Embeddings, p.EmbeddingsF16, p.EmbeddingsInt8 = nil, nil, nil
 		profiles = append(profiles, p)
 	}
 	return profiles, nil
@@ -38,6 +38,20 @@ func TestLoadSpeakerProfiles(t *testing.T) {
 	}
 }
 
+func TestLoadSpeakerProfiles_ReducedPrecision(t *testing.T) {
+	tmp := t.TempDir()
+	os.WriteFile(filepath.Join(tmp, "Bob.json"),
+		[]byte(`{"name": "Bob", "embeddings_int8": ["AACAPwF/", "AACAPwGB"]}`), 0644)
+
+	profiles, err := LoadSpeakerProfiles(tmp)
+	if err != nil || len(profiles) != 1 {
+		t.Fatalf("LoadSpeakerProfiles: %v, %d profiles", err, len(profiles))
+	}
+	if p := profiles[0]; p.EmbeddingCount != 2 || p.EmbeddingsInt8 != nil {
+		t.Errorf("EmbeddingCount = %d, EmbeddingsInt8 = %v", p.EmbeddingCount, p.EmbeddingsInt8)
+	}
+}
+
 func TestLoadSpeakerProfiles_Empty(t *testing.T) {
 	tmp := t.TempDir()
 	profiles, err := LoadSpeakerProfiles(tmp)